@@ -133,8 +133,8 @@ double Action::perform(Particles *particles, uint32_t id_process) {
      * last collision a particle went through. */
     if ((process_type_ != ProcessType::Wall) &&
         (process_type_ != ProcessType::FluidizationNoRemoval)) {
-      p.set_history(p.get_history().collisions_per_particle + 1, id_process,
-                    process_type_, time_of_execution_, incoming_particles_);
+      p.set_history(p.collisions_per_particle() + 1, id_process, process_type_,
+                    time_of_execution_, incoming_particles_);
     }
   }
 
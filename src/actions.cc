@@ -0,0 +1,295 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/actions.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace smash {
+
+Actions& Actions::operator=(Actions&& other) noexcept {
+  if (this != &other) {
+    queue_ = other.queue_;
+    size_ = other.size_;
+    next_sequence_ = other.next_sequence_;
+    removed_ = other.removed_;
+    peak_occupancy_ = other.peak_occupancy_;
+    queued_ = std::move(other.queued_);
+    links_ = std::move(other.links_);
+    heap_ = std::move(other.heap_);
+    buckets_ = std::move(other.buckets_);
+    pending_ = std::move(other.pending_);
+    entries_in_buckets_ = other.entries_in_buckets_;
+    cursor_ = other.cursor_;
+    calendar_start_ = other.calendar_start_;
+    bucket_width_ = other.bucket_width_;
+    other.clear();
+  }
+  return *this;
+}
+
+ActionPtr Actions::pop() {
+  if (size_ == 0) {
+    throw std::runtime_error("Empty actions list!");
+  }
+  size_--;
+  ActionPtr act;
+  if (queue_ == ActionQueue::BinaryHeap) {
+    std::pop_heap(heap_.begin(), heap_.end(), later);
+    queued_[heap_.back().sequence] = nullptr;
+    act = std::move(heap_.back().action);
+    heap_.pop_back();
+  } else {
+    std::vector<Entry>& bucket = buckets_[cursor_];
+    queued_[bucket.back().sequence] = nullptr;
+    act = std::move(bucket.back().action);
+    bucket.pop_back();
+    entries_in_buckets_--;
+    settle_calendar();
+  }
+  drop_removed_front();
+  return act;
+}
+
+void Actions::insert(ActionList&& new_acts) {
+  const std::size_t n_before = heap_.size();
+  for (auto& a : new_acts) {
+    add(std::move(a));
+  }
+  if (queue_ == ActionQueue::Calendar) {
+    settle_calendar();
+  } else if (n_before < new_acts.size()) {
+    // Building the heap anew is cheaper than inserting many actions one by one
+    std::make_heap(heap_.begin(), heap_.end(), later);
+  } else {
+    for (auto it = heap_.begin() + n_before; it != heap_.end(); ++it) {
+      std::push_heap(heap_.begin(), it + 1, later);
+    }
+  }
+}
+
+void Actions::insert(ActionPtr&& action) {
+  add(std::move(action));
+  if (queue_ == ActionQueue::Calendar) {
+    settle_calendar();
+  } else {
+    std::push_heap(heap_.begin(), heap_.end(), later);
+  }
+}
+
+ActionList::size_type Actions::invalidate(const ParticleList& particles,
+                                          const Particles& current) {
+  ActionList::size_type n_removed = 0;
+  for (const ParticleData& p : particles) {
+    const auto it = links_.find(p.id());
+    if (it == links_.end()) {
+      continue;
+    }
+    // Forget the links to actions which are not queued anymore
+    std::vector<std::uint64_t>& sequences = it->second;
+    sequences.erase(
+        std::remove_if(sequences.begin(), sequences.end(),
+                       [&](std::uint64_t sequence) {
+                         const Action* action = queued_[sequence];
+                         if (action && action->is_valid(current)) {
+                           return false;
+                         }
+                         if (action) {
+                           queued_[sequence] = nullptr;
+                           n_removed++;
+                         }
+                         return true;
+                       }),
+        sequences.end());
+    if (sequences.empty()) {
+      links_.erase(it);
+    }
+  }
+  size_ -= n_removed;
+  removed_ += n_removed;
+  drop_removed_front();
+  compact();
+  return n_removed;
+}
+
+void Actions::clear() {
+  size_ = 0;
+  next_sequence_ = 0;
+  removed_ = 0;
+  peak_occupancy_ = 0;
+  queued_.clear();
+  links_.clear();
+  heap_.clear();
+  buckets_.clear();
+  pending_.clear();
+  entries_in_buckets_ = 0;
+  cursor_ = 0;
+}
+
+void Actions::add(ActionPtr&& action) {
+  const double time = action->time_of_execution();
+  for (const ParticleData& p : action->incoming_particles()) {
+    links_[p.id()].push_back(next_sequence_);
+  }
+  queued_.push_back(action.get());
+  Entry entry{time, next_sequence_++, std::move(action)};
+  size_++;
+  peak_occupancy_ = std::max(peak_occupancy_, size_ + removed_);
+  if (queue_ == ActionQueue::BinaryHeap) {
+    heap_.push_back(std::move(entry));
+  } else if (entries_in_buckets_ == 0) {
+    // The buckets are laid out anew anyway
+    pending_.push_back(std::move(entry));
+  } else {
+    put_into_calendar(std::move(entry), true);
+  }
+}
+
+void Actions::put_into_calendar(Entry&& entry, bool keep_sorted) {
+  const double position = (entry.time - calendar_start_) / bucket_width_;
+  if (position >= static_cast<double>(buckets_.size())) {
+    pending_.push_back(std::move(entry));
+    return;
+  }
+  /* Since the position grows monotonically with the time, the buckets are
+   * ordered among each other. Actions earlier than the current bucket belong
+   * to it, because all buckets before it are empty. */
+  const std::size_t i =
+      position > 0. ? std::max(static_cast<std::size_t>(position), cursor_)
+                    : cursor_;
+  std::vector<Entry>& bucket = buckets_[i];
+  if (i == cursor_ && keep_sorted) {
+    bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), entry, later),
+                  std::move(entry));
+  } else {
+    bucket.push_back(std::move(entry));
+  }
+  entries_in_buckets_++;
+}
+
+void Actions::settle_calendar() {
+  if (entries_in_buckets_ == 0) {
+    if (pending_.empty()) {
+      return;
+    }
+    /* Lay out one bucket per action, such that the earliest action is at the
+     * start of the first bucket and the latest one in the last bucket. */
+    const auto [earliest, latest] = std::minmax_element(
+        pending_.begin(), pending_.end(),
+        [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    const std::size_t n_buckets = pending_.size();
+    calendar_start_ = earliest->time;
+    bucket_width_ =
+        n_buckets > 1 ? (latest->time - earliest->time) / (n_buckets - 1) : 0.;
+    if (!(bucket_width_ > 0.)) {
+      bucket_width_ = 1.;
+    }
+    buckets_.resize(n_buckets);
+    for (std::vector<Entry>& bucket : buckets_) {
+      bucket.clear();
+    }
+    cursor_ = 0;
+    std::vector<Entry> to_distribute = std::move(pending_);
+    pending_.clear();
+    for (Entry& entry : to_distribute) {
+      put_into_calendar(std::move(entry), false);
+    }
+  } else if (!buckets_[cursor_].empty()) {
+    return;
+  }
+  while (buckets_[cursor_].empty()) {
+    cursor_++;
+  }
+  std::vector<Entry>& bucket = buckets_[cursor_];
+  std::sort(bucket.begin(), bucket.end(), later);
+}
+
+void Actions::drop_removed_front() {
+  if (queue_ == ActionQueue::BinaryHeap) {
+    while (!heap_.empty() && is_removed(heap_.front())) {
+      std::pop_heap(heap_.begin(), heap_.end(), later);
+      heap_.pop_back();
+      removed_--;
+    }
+    return;
+  }
+  while (entries_in_buckets_ > 0 && is_removed(buckets_[cursor_].back())) {
+    buckets_[cursor_].pop_back();
+    entries_in_buckets_--;
+    removed_--;
+    settle_calendar();
+  }
+}
+
+void Actions::compact() {
+  if (removed_ < min_compaction || removed_ <= size_) {
+    return;
+  }
+  drop_removed();
+}
+
+void Actions::shrink() {
+  if (removed_ < min_compaction) {
+    return;
+  }
+  drop_removed();
+  queued_.shrink_to_fit();
+  heap_.shrink_to_fit();
+  for (std::vector<Entry>& bucket : buckets_) {
+    bucket.shrink_to_fit();
+  }
+  pending_.shrink_to_fit();
+}
+
+std::size_t Actions::memory_usage() const {
+  std::size_t bytes = queued_.capacity() * sizeof(const Action*) +
+                      heap_.capacity() * sizeof(Entry) +
+                      pending_.capacity() * sizeof(Entry);
+  auto add_actions = [&bytes](const std::vector<Entry>& entries) {
+    for (const Entry& entry : entries) {
+      bytes += sizeof(Action) + entry.action->incoming_particles().capacity() *
+                                    sizeof(ParticleData);
+    }
+  };
+  add_actions(heap_);
+  add_actions(pending_);
+  for (const std::vector<Entry>& bucket : buckets_) {
+    bytes += bucket.capacity() * sizeof(Entry);
+    add_actions(bucket);
+  }
+  for (const auto& link : links_) {
+    bytes += sizeof(link) + link.second.capacity() * sizeof(std::uint64_t);
+  }
+  return bytes;
+}
+
+void Actions::drop_removed() {
+  auto removed = [this](const Entry& entry) { return is_removed(entry); };
+  if (queue_ == ActionQueue::BinaryHeap) {
+    heap_.erase(std::remove_if(heap_.begin(), heap_.end(), removed),
+                heap_.end());
+    std::make_heap(heap_.begin(), heap_.end(), later);
+  } else {
+    // The removal keeps the order, hence the current bucket stays sorted
+    entries_in_buckets_ = 0;
+    for (std::size_t i = cursor_; i < buckets_.size(); i++) {
+      std::vector<Entry>& bucket = buckets_[i];
+      bucket.erase(std::remove_if(bucket.begin(), bucket.end(), removed),
+                   bucket.end());
+      entries_in_buckets_ += bucket.size();
+    }
+    pending_.erase(std::remove_if(pending_.begin(), pending_.end(), removed),
+                   pending_.end());
+    settle_calendar();
+  }
+  removed_ = 0;
+}
+
+}  // namespace smash
@@ -0,0 +1,55 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/adaptivetimestep.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace smash {
+
+AdaptiveTimeStep::AdaptiveTimeStep(const AdaptiveTimeStepParameters &parameters)
+    : parameters_(parameters) {
+  if (!(parameters_.min_timestep > 0.) ||
+      !(parameters_.max_timestep >= parameters_.min_timestep)) {
+    throw std::invalid_argument(
+        "The bounds of the adaptive time step must be positive and the "
+        "maximum must not be smaller than the minimum.");
+  }
+  if (!(parameters_.max_growth_factor >= 1.)) {
+    throw std::invalid_argument(
+        "The growth factor of the adaptive time step must be at least 1.");
+  }
+  if (!(parameters_.interactions_per_particle > 0.) ||
+      !(parameters_.relative_density_change > 0.) ||
+      !(parameters_.potentials_safety_factor > 0.)) {
+    throw std::invalid_argument(
+        "The targets of the adaptive time step must be positive.");
+  }
+}
+
+double AdaptiveTimeStep::next_timestep(
+    double timestep, const TimeStepObservation &observed) const {
+  double next = parameters_.max_growth_factor * timestep;
+  if (observed.n_interactions > 0 && observed.n_particles > 0) {
+    const double interactions_per_particle =
+        static_cast<double>(observed.n_interactions) / observed.n_particles;
+    next = std::min(next, timestep * parameters_.interactions_per_particle /
+                              interactions_per_particle);
+  }
+  if (observed.relative_density_change > 0.) {
+    next = std::min(next, timestep * parameters_.relative_density_change /
+                              observed.relative_density_change);
+  }
+  next = std::min(next, parameters_.potentials_safety_factor *
+                            observed.min_time_scale);
+  return std::clamp(next, parameters_.min_timestep, parameters_.max_timestep);
+}
+
+}  // namespace smash
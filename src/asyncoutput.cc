@@ -0,0 +1,133 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/asyncoutput.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "smash/logging.h"
+
+namespace smash {
+
+OutputWriter::OutputWriter(std::size_t max_pending_calls)
+    : max_pending_calls_(max_pending_calls) {
+  if (max_pending_calls_ == 0) {
+    throw std::invalid_argument(
+        "The output writer has to accept at least one pending call.");
+  }
+  thread_ = std::thread([this]() { work(); });
+}
+
+OutputWriter::~OutputWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  call_available_.notify_one();
+  thread_.join();
+  if (exception_) {
+    try {
+      std::rethrow_exception(exception_);
+    } catch (const std::exception &e) {
+      logg[LOutput].error("Writing an output failed: ", e.what());
+    } catch (...) {
+      logg[LOutput].error("Writing an output failed.");
+    }
+  }
+}
+
+void OutputWriter::push(std::function<void()> call) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  call_done_.wait(lock, [this]() {
+    return exception_ || calls_.size() < max_pending_calls_;
+  });
+  rethrow_exception();
+  calls_.push_back(std::move(call));
+  call_available_.notify_one();
+}
+
+void OutputWriter::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  call_done_.wait(lock, [this]() {
+    return exception_ || (calls_.empty() && !busy_);
+  });
+  rethrow_exception();
+}
+
+void OutputWriter::rethrow_exception() {
+  if (exception_) {
+    std::exception_ptr exception = nullptr;
+    std::swap(exception, exception_);
+    std::rethrow_exception(exception);
+  }
+}
+
+void OutputWriter::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    call_available_.wait(lock, [this]() { return stop_ || !calls_.empty(); });
+    if (calls_.empty()) {
+      return;
+    }
+    std::function<void()> call = std::move(calls_.front());
+    calls_.pop_front();
+    busy_ = true;
+    lock.unlock();
+    std::exception_ptr exception = nullptr;
+    try {
+      call();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    // The copied arguments are released before the lock is taken again
+    call = nullptr;
+    lock.lock();
+    busy_ = false;
+    if (exception) {
+      // The outputs are broken, hence the pending calls are discarded
+      calls_.clear();
+      if (!exception_) {
+        exception_ = exception;
+      }
+    }
+    call_done_.notify_all();
+  }
+}
+
+AsyncOutput::AsyncOutput(std::unique_ptr<OutputInterface> target,
+                         OutputWriter &writer)
+    : BufferedOutput(*target),
+      owned_target_(std::move(target)),
+      writer_(writer) {}
+
+AsyncOutput::~AsyncOutput() {
+  try {
+    writer_.wait();
+  } catch (const std::exception &e) {
+    logg[LOutput].error("Writing an output failed: ", e.what());
+  } catch (...) {
+    logg[LOutput].error("Writing an output failed.");
+  }
+}
+
+void AsyncOutput::thermodynamics_output(
+    const GrandCanThermalizer &gc_thermalizer) {
+  writer_.wait();
+  owned_target_->thermodynamics_output(gc_thermalizer);
+}
+
+void AsyncOutput::enqueue_output_call(
+    std::function<void(OutputInterface &)> call) {
+  writer_.push([&target = *owned_target_, call = std::move(call)]() {
+    call(target);
+  });
+}
+
+}  // namespace smash
@@ -0,0 +1,203 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/binarymerge.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "smash/file.h"
+
+namespace smash {
+
+namespace {
+
+/// An event end line of a shard, as read from its index
+struct IndexRecord {
+  /// Number of the event
+  std::int32_t event_number;
+  /// Number of the ensemble
+  std::int32_t ensemble_number;
+  /// Offset of the bytes of the event in the shard
+  std::uint64_t offset;
+  /// Number of bytes of the event
+  std::uint64_t size;
+  /// Impact parameter of the event
+  double impact_parameter;
+  /// Whether the event is empty
+  char empty;
+  /// Position of the shard in the list of shards
+  std::size_t shard;
+};
+
+/// A shard opened for reading
+struct Shard {
+  /// The shard
+  std::ifstream file;
+  /// The header of the shard, up to the first event
+  std::string header;
+  /// The first 8 bytes of the index, i.e. magic number and versions
+  std::string index_header;
+};
+
+/**
+ * Read a value from a binary stream.
+ *
+ * \param[in] in The stream.
+ * \param[out] value The value.
+ * \return Whether the value could be read.
+ */
+template <typename T>
+bool read(std::istream &in, T &value) {
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+/**
+ * \param[in] path The shard.
+ * \param[in] what Description of the error.
+ * \return The error to be thrown.
+ */
+std::runtime_error shard_error(const std::filesystem::path &path,
+                               const std::string &what) {
+  return std::runtime_error("Cannot merge " + path.string() + ": " + what +
+                            ".");
+}
+
+/**
+ * Open a shard and read its header and index.
+ *
+ * \param[in] path The shard.
+ * \param[in] position Position of the shard in the list of shards.
+ * \param[inout] records The records of the index are appended here.
+ * \return The opened shard.
+ */
+Shard open_shard(const std::filesystem::path &path, std::size_t position,
+                 std::vector<IndexRecord> &records) {
+  Shard shard;
+  shard.file.open(path, std::ios::binary);
+  char magic[4];
+  std::uint16_t version, variant;
+  std::uint32_t length;
+  if (!shard.file || !shard.file.read(magic, 4) ||
+      std::memcmp(magic, "SMSH", 4) != 0 || !read(shard.file, version) ||
+      !read(shard.file, variant) || !read(shard.file, length)) {
+    throw shard_error(path, "not a SMASH binary file");
+  }
+  const std::size_t header_size = 12 + static_cast<std::size_t>(length);
+  shard.header.resize(header_size);
+  shard.file.seekg(0);
+  if (!shard.file.read(shard.header.data(), header_size)) {
+    throw shard_error(path, "truncated header");
+  }
+
+  std::filesystem::path index_path = path;
+  index_path += ".idx";
+  std::ifstream index(index_path, std::ios::binary);
+  shard.index_header.resize(8);
+  std::uint16_t index_version, format_version;
+  if (!index || !index.read(shard.index_header.data(), 8) ||
+      shard.index_header.compare(0, 4, "SMIX") != 0) {
+    throw shard_error(path, "missing or invalid event index");
+  }
+  std::memcpy(&index_version, shard.index_header.data() + 4, 2);
+  std::memcpy(&format_version, shard.index_header.data() + 6, 2);
+  if (index_version != 1 || format_version != version) {
+    throw shard_error(path, "unsupported event index version");
+  }
+  const auto file_size =
+      static_cast<std::uint64_t>(std::filesystem::file_size(path));
+  IndexRecord r{};
+  r.shard = position;
+  while (read(index, r.event_number) && read(index, r.ensemble_number) &&
+         read(index, r.offset) && read(index, r.size) &&
+         read(index, r.impact_parameter) && read(index, r.empty)) {
+    if (r.offset < header_size || r.offset + r.size > file_size) {
+      throw shard_error(path, "event index does not match the file");
+    }
+    records.push_back(r);
+  }
+  return shard;
+}
+
+}  // unnamed namespace
+
+std::size_t merge_binary_shards(
+    const std::vector<std::filesystem::path> &shards,
+    const std::filesystem::path &output) {
+  if (shards.empty()) {
+    throw std::runtime_error("No shards to merge were given.");
+  }
+  std::vector<IndexRecord> records;
+  std::vector<Shard> files;
+  for (std::size_t i = 0; i < shards.size(); i++) {
+    files.push_back(open_shard(shards[i], i, records));
+    if (files[i].header != files[0].header ||
+        files[i].index_header != files[0].index_header) {
+      throw shard_error(shards[i],
+                        "header differs from " + shards[0].string());
+    }
+  }
+  // The ensembles of an event are written by one thread in their order
+  std::stable_sort(records.begin(), records.end(),
+                   [](const IndexRecord &a, const IndexRecord &b) {
+                     return a.event_number < b.event_number;
+                   });
+  std::map<std::int32_t, std::size_t> shard_of_event;
+  for (const IndexRecord &r : records) {
+    const auto found = shard_of_event.emplace(r.event_number, r.shard);
+    if (found.first->second != r.shard) {
+      throw shard_error(shards[r.shard],
+                        "event " + std::to_string(r.event_number) +
+                            " is also found in " +
+                            shards[found.first->second].string());
+    }
+  }
+
+  std::filesystem::path index_path = output;
+  index_path += ".idx";
+  RenamingFilePtr merged(output, "wb");
+  RenamingFilePtr merged_index(index_path, "wb");
+  FILE *out = merged.get();
+  FILE *index = merged_index.get();
+  std::fwrite(files[0].header.data(), 1, files[0].header.size(), out);
+  std::fwrite(files[0].index_header.data(), 1, 8, index);
+  std::uint64_t offset = files[0].header.size();
+  std::vector<char> buffer(std::size_t(1) << 20);
+  for (const IndexRecord &r : records) {
+    std::ifstream &in = files[r.shard].file;
+    in.seekg(static_cast<std::streamoff>(r.offset));
+    for (std::uint64_t left = r.size; left > 0;) {
+      const std::size_t n = std::min<std::uint64_t>(left, buffer.size());
+      if (!in.read(buffer.data(), n)) {
+        throw shard_error(shards[r.shard], "truncated event");
+      }
+      if (std::fwrite(buffer.data(), 1, n, out) != n) {
+        throw std::runtime_error("Cannot write " + output.string() + ".");
+      }
+      left -= n;
+    }
+    std::fwrite(&r.event_number, sizeof(std::int32_t), 1, index);
+    std::fwrite(&r.ensemble_number, sizeof(std::int32_t), 1, index);
+    std::fwrite(&offset, sizeof(std::uint64_t), 1, index);
+    std::fwrite(&r.size, sizeof(std::uint64_t), 1, index);
+    std::fwrite(&r.impact_parameter, sizeof(double), 1, index);
+    std::fwrite(&r.empty, sizeof(char), 1, index);
+    offset += r.size;
+  }
+  return records.size();
+}
+
+}  // namespace smash
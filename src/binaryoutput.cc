@@ -9,13 +9,24 @@
 
 #include "smash/binaryoutput.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
+#include <stdexcept>
 #include <string>
 
+#ifdef SMASH_USE_ZSTD
+#include <zstd.h>
+#endif
+
 #include "smash/action.h"
+#include "smash/binaryreader.h"
 #include "smash/clock.h"
 #include "smash/config.h"
+#include "smash/logging.h"
 
 namespace smash {
 
@@ -24,7 +35,8 @@ static auto get_list_of_binary_quantities(const std::string &content,
                                           const OutputParameters &parameters);
 
 static auto get_binary_filename(const std::string &content,
-                                const std::vector<std::string> &quantities) {
+                                const std::vector<std::string> &quantities,
+                                int shard = -1) {
   std::string filename = content;
   if (content == "Particles" || content == "Collisions") {
     std::transform(filename.begin(), filename.end(), filename.begin(),
@@ -44,6 +56,9 @@ static auto get_binary_filename(const std::string &content,
   } else {
     filename += "_custom";
   }
+  if (shard >= 0) {
+    filename += "." + std::to_string(shard);
+  }
   return filename + ".bin";
 }
 
@@ -77,6 +92,60 @@ static auto get_binary_filename(const std::string &content,
  * \li len is the length of smash version string
  * \li smash_version is len chars that give information about the SMASH version.
  *
+ * **Compressed files**\n
+ * If a \ref key_output_particles_compression_level_ "Compression_Level" is
+ * given, the format version in the header is 11 and the header is followed by
+ * frames instead of blocks:
+ * \code
+ * uint32_t        uint32_t          compressed_size*char
+ * compressed_size uncompressed_size zstd_frame
+ * \endcode
+ * Every frame decompresses to the blocks of a file of version 10 described
+ * below. A frame is written at the end of every event and, for very large
+ * events, whenever its blocks exceed 64 MiB, but a block is never split between
+ * two frames. Hence, the frames can be decompressed independently of each
+ * other, and the sizes allow to skip to the next frame without decompressing.
+ *
+ * **Event index**\n
+ * If an \ref key_output_particles_event_index_ "Event_Index" is requested,
+ * the file \c <output>.bin.idx is written next to the output. It starts with
+ * \code
+ * 4*char        uint16_t       uint16_t
+ * magic_number, index_version, format_version
+ * \endcode
+ * where the magic number reads "SMIX", the index version is currently 1 and
+ * the format version is the one of the indexed file. It is followed by one
+ * record for every event end line in the output:
+ * \code
+ * int32_t      int32_t         uint64_t uint64_t double           char
+ * event_number ensemble_number offset   size     impact_parameter empty
+ * \endcode
+ * The blocks of the event are found in the \c size bytes starting at byte
+ * \c offset of the output. These are the bytes following the previous event
+ * end line, which, for several ensembles, include blocks of the other ensembles
+ * of the same event, identified by their ensemble number. In a compressed
+ * output, the bytes are complete frames. The records are flushed together with
+ * the output, such that the complete events of a truncated file are known.
+ *
+ * **Shards**\n
+ * With \ref key_output_sharded_writing_ "Sharded_Writing", every event thread
+ * writes its events to its own file, e.g. \c particles_custom.<thread>.bin,
+ * which is always indexed. The event numbers are the same as in a serial run.
+ * The shards are merged by the \c smash_merge executable, which is built next
+ * to \c smash:
+ * \verbatim
+ smash_merge -o particles_custom.bin particles_custom.*.bin
+ \endverbatim
+ * It copies the events in the order of their numbers without decoding them,
+ * such that the merged file and its index are identical to those written
+ * without sharding.
+ *
+ * **Reading**\n
+ * Uncompressed binary outputs can be read with smash::BinaryReader, which is
+ * also installed as the library \c smash_binary_reader without further
+ * dependencies. It maps the file into memory, takes the events from the event
+ * index if there is one and reads blocks and particle lines in place.
+ *
  * **Output block header**\n
  * At start of event, end of event or any other particle output:
  * \code
@@ -87,6 +156,25 @@ static auto get_binary_filename(const std::string &content,
  * \li \key ensemble_number: Number of the ensemble, starting with 0.
  * \li \c n_part_lines is the number of particle lines in the block that follows
  *
+ * At intermediate times with \ref key_output_particles_delta_encoding_
+ * "Delta_Encoding":
+ * \code
+ * char int32_t      int32_t         double uint32_t  uint32_t
+ * 'd'  event_number ensemble_number time   n_removed n_part_lines
+ * \endcode
+ * followed by the \c n_removed IDs (\c int32_t) of the particles removed
+ * since the previous block of the ensemble and by \c n_part_lines particle
+ * lines. The particle list at \c time is reconstructed from the one of the
+ * previous block: the removed particles are dropped, all other particles are
+ * moved on straight lines to \c time,
+ * \f$\vec{x} \to \vec{x} + \vec{p}/p_0\,(time - t)\f$ and \f$t \to time\f$,
+ * and the particles of the lines replace those of the same ID or are added.
+ * Hence, only the created particles and those which changed otherwise than
+ * by free streaming are written. Time and positions deviating by less than
+ * \f$10^{-9}\f$ fm from free streaming are taken as free streaming. The
+ * order of the reconstructed particles may differ from a complete list.
+ * smash::BinaryReader::ParticleState reconstructs the particle lists.
+ *
  * At interaction:
  * \code
  * char uint32_t uint32_t double  double  double  uint32_t
@@ -96,6 +184,27 @@ static auto get_binary_filename(const std::string &content,
  *
  * Block header is followed by \c nin + \c nout particle lines.
  *
+ * At interaction with \ref key_output_collisions_reference_incoming_
+ * "Reference_Incoming":
+ * \code
+ * char uint32_t uint32_t double  double  double  uint32_t
+ * 'r'  nin      nout     density xsection partial_xsection process_type
+ *      double uint32_t
+ *      time   n_in_lines
+ * \endcode
+ * followed by the \c nin IDs (\c int32_t) of the incoming particles, by
+ * \c n_in_lines particle lines of incoming particles and by \c nout particle
+ * lines of the outgoing particles. Only the incoming particles, which are not
+ * reconstructed from the previous blocks of the event, have a line, in the
+ * order of their IDs. The reconstructed line of an incoming particle is its
+ * last line in a \c 'p' block or as outgoing particle, moved on a straight
+ * line to \c time, the time of the interaction, as in a delta block. The same
+ * tolerance of \f$10^{-9}\f$ fm applies. A particle is reconstructed at most
+ * once, afterwards only its line as outgoing particle is used. Hence, the
+ * lines of all incoming particles are known without loss, while most of them
+ * take only 4 Bytes. smash::BinaryReader::CollisionState reconstructs the
+ * incoming particles.
+ *
  * **Particle line**
  * \code
  *        9*double          int32_t int32_t int32_t
@@ -199,17 +308,60 @@ static auto get_binary_filename(const std::string &content,
  * See also \ref doxypage_output_collisions_box_modus.
  **/
 
+#ifdef SMASH_USE_ZSTD
+/// Owner of the zstd context, which is reused for all frames.
+struct BinaryOutputBase::FrameCompressor {
+  /// Create the context.
+  explicit FrameCompressor(int level)
+      : context(ZSTD_createCCtx()), compression_level(level) {
+    if (!context) {
+      throw std::runtime_error("Creating the zstd context failed.");
+    }
+  }
+  /// A context cannot be copied.
+  FrameCompressor(const FrameCompressor &) = delete;
+  /// A context cannot be copied.
+  FrameCompressor &operator=(const FrameCompressor &) = delete;
+  /// Free the context.
+  ~FrameCompressor() { ZSTD_freeCCtx(context); }
+  /// The zstd context
+  ZSTD_CCtx *const context;
+  /// The zstd compression level
+  const int compression_level;
+  /// Buffer for the compressed frame
+  std::vector<char> compressed{};
+};
+#else
+/// Placeholder, compressed outputs are rejected without zstd.
+struct BinaryOutputBase::FrameCompressor {};
+#endif
+
 BinaryOutputBase::BinaryOutputBase(const std::filesystem::path &path,
                                    const std::string &mode,
                                    const std::string &name,
-                                   const std::vector<std::string> &quantities)
+                                   const std::vector<std::string> &quantities,
+                                   int compression_level, bool event_index)
     : OutputInterface(name), file_{path, mode}, formatter_(quantities) {
   if (quantities.empty()) {
     throw std::invalid_argument(
         "Empty quantities list passed to 'BinaryOutputBase' constructor.");
   }
+#ifdef SMASH_USE_ZSTD
+  if (compression_level < 0 || compression_level > ZSTD_maxCLevel()) {
+    throw std::invalid_argument(
+        "The compression level of the binary output has to be between 0 and " +
+        std::to_string(ZSTD_maxCLevel()) + ".");
+  }
+#else
+  if (compression_level != 0) {
+    throw std::invalid_argument(
+        "Compressed binary output requires SMASH to be built with zstd.");
+  }
+#endif
+  const bool compressed = compression_level > 0;
   std::fwrite("SMSH", 4, 1, file_.get());  // magic number
-  write(format_version_);                  // file format version number
+  // file format version number
+  write(compressed ? format_version_compressed_ : format_version_);
   std::uint16_t format_variant{};
   if (quantities == OutputDefaultQuantities::oscar2013) {
     format_variant = 0;
@@ -220,28 +372,108 @@ BinaryOutputBase::BinaryOutputBase(const std::filesystem::path &path,
   }
   write(format_variant);
   write(SMASH_VERSION);
+#ifdef SMASH_USE_ZSTD
+  // The header is never compressed
+  if (compressed) {
+    compressor_ = std::make_unique<FrameCompressor>(compression_level);
+  }
+#endif
+  if (event_index) {
+    std::filesystem::path index_path = path;
+    index_path += ".idx";
+    index_file_ = std::make_unique<RenamingFilePtr>(index_path, mode);
+    const std::uint16_t file_format_version =
+        compressed ? format_version_compressed_ : format_version_;
+    std::fwrite("SMIX", 4, 1, index_file_->get());  // magic number
+    std::fwrite(&index_version_, sizeof(std::uint16_t), 1, index_file_->get());
+    std::fwrite(&file_format_version, sizeof(std::uint16_t), 1,
+                index_file_->get());
+    event_offset_ = static_cast<std::uint64_t>(std::ftell(file_.get()));
+  }
 }
 
-// write functions:
-void BinaryOutputBase::write(const char c) {
-  std::fwrite(&c, sizeof(char), 1, file_.get());
+BinaryOutputBase::~BinaryOutputBase() {
+  if (compressor_ && !frame_.empty()) {
+    try {
+      write_frame();
+    } catch (const std::exception &e) {
+      logg[LOutput].error("Writing the last binary frame failed: ", e.what());
+    }
+  }
+}
+
+void BinaryOutputBase::begin_block(const char block_type) {
+  if (compressor_ && frame_.size() >= max_frame_size_) {
+    write_frame();
+  }
+  write(block_type);
 }
+
+void BinaryOutputBase::write_event_end(const EventLabel &event_label,
+                                       const EventInfo &event) {
+  begin_block('f');
+  write(event_label.event_number);
+  write(event_label.ensemble_number);
+  write(event.impact_parameter);
+  const char empty = event.empty_event;
+  write(empty);
+  if (compressor_ && !frame_.empty()) {
+    write_frame();
+  }
+  // Flush to disk
+  std::fflush(file_.get());
+
+  if (index_file_) {
+    const auto end = static_cast<std::uint64_t>(std::ftell(file_.get()));
+    const std::uint64_t size = end - event_offset_;
+    FILE *index = index_file_->get();
+    std::fwrite(&event_label.event_number, sizeof(std::int32_t), 1, index);
+    std::fwrite(&event_label.ensemble_number, sizeof(std::int32_t), 1, index);
+    std::fwrite(&event_offset_, sizeof(std::uint64_t), 1, index);
+    std::fwrite(&size, sizeof(std::uint64_t), 1, index);
+    std::fwrite(&event.impact_parameter, sizeof(double), 1, index);
+    std::fwrite(&empty, sizeof(char), 1, index);
+    std::fflush(index);
+    event_offset_ = end;
+  }
+}
+
+void BinaryOutputBase::write_frame() {
+#ifdef SMASH_USE_ZSTD
+  std::vector<char> &compressed = compressor_->compressed;
+  compressed.resize(ZSTD_compressBound(frame_.size()));
+  const std::size_t compressed_size = ZSTD_compressCCtx(
+      compressor_->context, compressed.data(), compressed.size(),
+      frame_.data(), frame_.size(), compressor_->compression_level);
+  if (ZSTD_isError(compressed_size)) {
+    throw std::runtime_error("Compressing a binary frame failed: " +
+                             std::string(ZSTD_getErrorName(compressed_size)));
+  }
+  const auto sizes = std::array<std::uint32_t, 2>{
+      smash::numeric_cast<std::uint32_t>(compressed_size),
+      smash::numeric_cast<std::uint32_t>(frame_.size())};
+  std::fwrite(sizes.data(), sizeof(std::uint32_t), 2, file_.get());
+  std::fwrite(compressed.data(), 1, compressed_size, file_.get());
+#endif
+  frame_.clear();
+}
+
+// write functions:
+void BinaryOutputBase::write(const char c) { write_bytes(&c, sizeof(char)); }
 void BinaryOutputBase::write(const ToBinary::type &chunk) {
-  std::fwrite(chunk.data(), sizeof(char), chunk.size(), file_.get());
+  write_bytes(chunk.data(), chunk.size());
 }
 
 void BinaryOutputBase::write(const std::string &s) {
   const auto size = smash::numeric_cast<uint32_t>(s.size());
-  std::fwrite(&size, sizeof(std::uint32_t), 1, file_.get());
-  std::fwrite(s.c_str(), s.size(), 1, file_.get());
+  write_bytes(&size, sizeof(std::uint32_t));
+  write_bytes(s.c_str(), s.size());
 }
 
-void BinaryOutputBase::write(const double x) {
-  std::fwrite(&x, sizeof(x), 1, file_.get());
-}
+void BinaryOutputBase::write(const double x) { write_bytes(&x, sizeof(x)); }
 
 void BinaryOutputBase::write(const FourVector &v) {
-  std::fwrite(v.begin(), sizeof(*v.begin()), 4, file_.get());
+  write_bytes(v.begin(), 4 * sizeof(*v.begin()));
 }
 
 void BinaryOutputBase::write(const Particles &particles) {
@@ -260,165 +492,373 @@ void BinaryOutputBase::write_particledata(const ParticleData &p) {
   write(formatter_.single_particle_data(p));
 }
 
+/**
+ * Largest deviation [fm] of the time and position of a particle from free
+ * streaming, which is neglected in a delta block. The positions of the
+ * propagation in several time steps differ from the ones of a single step by
+ * rounding errors.
+ */
+static constexpr double free_streaming_tolerance = 1e-9;
+
+/**
+ * \param[in] streamed The particle line of the previous block, moved to the
+ *            current time with BinaryReader::free_stream().
+ * \param[in] line The current particle line.
+ * \return Whether the current line can be reconstructed by free streaming.
+ */
+static bool is_free_streamed(const ToBinary::type &streamed,
+                             const ToBinary::type &line) {
+  // The time and position come first, all other quantities must not change
+  constexpr std::size_t position_size = 4 * sizeof(double);
+  if (std::memcmp(streamed.data() + position_size, line.data() + position_size,
+                  line.size() - position_size) != 0) {
+    return false;
+  }
+  std::array<double, 4> a, b;
+  std::memcpy(a.data(), streamed.data(), position_size);
+  std::memcpy(b.data(), line.data(), position_size);
+  for (int i = 0; i < 4; i++) {
+    if (!(std::abs(a[i] - b[i]) <= free_streaming_tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 BinaryOutputCollisions::BinaryOutputCollisions(
     const std::filesystem::path &path, std::string name,
-    const OutputParameters &out_par, const std::vector<std::string> &quantities)
-    : BinaryOutputBase(path / get_binary_filename(name, quantities), "wb", name,
-                       quantities),
-      print_start_end_(out_par.coll_printstartend) {}
+    const OutputParameters &out_par, const std::vector<std::string> &quantities,
+    int shard)
+    : BinaryOutputBase(path / get_binary_filename(name, quantities, shard),
+                       "wb", name, quantities,
+                       name == "Collisions" ? out_par.coll_compression : 0,
+                       shard >= 0 ||
+                           (name == "Collisions" && out_par.coll_event_index)),
+      print_start_end_(out_par.coll_printstartend),
+      reference_incoming_(name == "Collisions" &&
+                          out_par.coll_reference_incoming) {
+  if (reference_incoming_ && quantities != OutputDefaultQuantities::oscar2013 &&
+      quantities != OutputDefaultQuantities::oscar2013extended) {
+    throw std::invalid_argument(
+        "Referencing the incoming particles of the binary collisions output "
+        "requires the OSCAR 2013 or extended OSCAR 2013 quantities.");
+  }
+}
 
 void BinaryOutputCollisions::at_eventstart(const Particles &particles,
                                            const EventLabel &event_label,
                                            const EventInfo &) {
-  const char pchar = 'p';
   if (print_start_end_) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
-    write(event_label.event_number);
-    write(event_label.ensemble_number);
-    write(particles.size());
-    write(particles);
+    write_particles_block(particles, event_label);
   }
 }
 
 void BinaryOutputCollisions::at_eventend(const Particles &particles,
                                          const EventLabel &event_label,
                                          const EventInfo &event) {
-  const char pchar = 'p';
   if (print_start_end_) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
-    write(event_label.event_number);
-    write(event_label.ensemble_number);
-    write(particles.size());
-    write(particles);
+    write_particles_block(particles, event_label);
   }
+  // A reader reconstructs the particles of every event on its own
+  known_lines_.clear();
 
-  // Event end line
-  const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
+  write_event_end(event_label, event);
+}
+
+void BinaryOutputCollisions::write_particles_block(
+    const Particles &particles, const EventLabel &event_label) {
+  begin_block('p');
   write(event_label.event_number);
   write(event_label.ensemble_number);
-  write(event.impact_parameter);
-  const char empty = event.empty_event;
-  write(empty);
-
-  // Flush to disk
-  std::fflush(file_.get());
+  write(particles.size());
+  if (!reference_incoming_) {
+    write(particles);
+    return;
+  }
+  for (const ParticleData &p : particles) {
+    ToBinary::type line = particle_line(p);
+    write(line);
+    known_lines_[p.id()] = std::move(line);
+  }
 }
 
 void BinaryOutputCollisions::at_interaction(const Action &action,
                                             const double density) {
-  const char ichar = 'i';
-  std::fwrite(&ichar, sizeof(char), 1, file_.get());
+  if (reference_incoming_) {
+    write_compact_interaction(action, density);
+    return;
+  }
+  begin_block('i');
   write(action.incoming_particles().size());
   write(action.outgoing_particles().size());
-  std::fwrite(&density, sizeof(double), 1, file_.get());
-  const double weight = action.get_total_weight();
-  std::fwrite(&weight, sizeof(double), 1, file_.get());
-  const double partial_weight = action.get_partial_weight();
-  std::fwrite(&partial_weight, sizeof(double), 1, file_.get());
-  const auto type = static_cast<uint32_t>(action.get_type());
-  std::fwrite(&type, sizeof(uint32_t), 1, file_.get());
+  write(density);
+  write(action.get_total_weight());
+  write(action.get_partial_weight());
+  write(static_cast<uint32_t>(action.get_type()));
   write(action.incoming_particles());
   write(action.outgoing_particles());
 }
 
+void BinaryOutputCollisions::write_compact_interaction(const Action &action,
+                                                       double density) {
+  const double time = action.time_of_execution();
+  const ParticleList &incoming = action.incoming_particles();
+  const ParticleList &outgoing = action.outgoing_particles();
+  incoming_lines_.clear();
+  std::size_t n_lines = 0;
+  for (const ParticleData &p : incoming) {
+    ToBinary::type line = particle_line(p);
+    const auto found = known_lines_.find(p.id());
+    bool referenced = false;
+    if (found != known_lines_.end()) {
+      // The reader streams the kept line to the time of the interaction
+      BinaryReader::free_stream(found->second.data(), time);
+      referenced = is_free_streamed(found->second, line);
+      known_lines_.erase(found);
+    }
+    if (!referenced) {
+      incoming_lines_.insert(incoming_lines_.end(), line.begin(), line.end());
+      n_lines++;
+    }
+  }
+
+  begin_block('r');
+  write(incoming.size());
+  write(outgoing.size());
+  write(density);
+  write(action.get_total_weight());
+  write(action.get_partial_weight());
+  write(static_cast<uint32_t>(action.get_type()));
+  write(time);
+  write(n_lines);
+  for (const ParticleData &p : incoming) {
+    write(p.id());
+  }
+  write(incoming_lines_);
+  for (const ParticleData &p : outgoing) {
+    ToBinary::type line = particle_line(p);
+    write(line);
+    known_lines_[p.id()] = std::move(line);
+  }
+}
+
 BinaryOutputParticles::BinaryOutputParticles(
     const std::filesystem::path &path, std::string name,
-    const OutputParameters &out_par, const std::vector<std::string> &quantities)
-    : BinaryOutputBase(path / get_binary_filename(name, quantities), "wb", name,
-                       quantities),
-      only_final_(out_par.part_only_final) {}
+    const OutputParameters &out_par, const std::vector<std::string> &quantities,
+    int shard)
+    : BinaryOutputBase(path / get_binary_filename(name, quantities, shard),
+                       "wb", name, quantities, out_par.part_compression,
+                       shard >= 0 || out_par.part_event_index),
+      only_final_(out_par.part_only_final),
+      delta_encoding_(out_par.part_delta_encoding &&
+                      out_par.part_only_final == OutputOnlyFinal::No) {
+  if (delta_encoding_ && quantities != OutputDefaultQuantities::oscar2013 &&
+      quantities != OutputDefaultQuantities::oscar2013extended) {
+    throw std::invalid_argument(
+        "Delta encoding of the binary particles output requires the OSCAR "
+        "2013 or extended OSCAR 2013 quantities.");
+  }
+}
 
 void BinaryOutputParticles::at_eventstart(const Particles &particles,
                                           const EventLabel &event_label,
                                           const EventInfo &) {
-  const char pchar = 'p';
   if (only_final_ == OutputOnlyFinal::No) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
-    write(event_label.event_number);
-    write(event_label.ensemble_number);
-    write(particles.size());
-    write(particles);
+    write_particles_block(particles, event_label);
   }
 }
 
 void BinaryOutputParticles::at_eventend(const Particles &particles,
                                         const EventLabel &event_label,
                                         const EventInfo &event) {
-  const char pchar = 'p';
   if (!(event.empty_event && only_final_ == OutputOnlyFinal::IfNotEmpty)) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    begin_block('p');
     write(event_label.event_number);
     write(event_label.ensemble_number);
     write(particles.size());
     write(particles);
   }
+  delta_states_.erase(event_label.ensemble_number);
 
-  // Event end line
-  const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
-  write(event_label.event_number);
-  write(event_label.ensemble_number);
-  write(event.impact_parameter);
-  const char empty = event.empty_event;
-  write(empty);
-
-  // Flush to disk
-  std::fflush(file_.get());
+  write_event_end(event_label, event);
 }
 
-void BinaryOutputParticles::at_intermediate_time(const Particles &particles,
-                                                 const std::unique_ptr<Clock> &,
-                                                 const DensityParameters &,
-                                                 const EventLabel &event_label,
-                                                 const EventInfo &) {
-  const char pchar = 'p';
+void BinaryOutputParticles::at_intermediate_time(
+    const Particles &particles, const std::unique_ptr<Clock> &clock,
+    const DensityParameters &, const EventLabel &event_label,
+    const EventInfo &) {
   if (only_final_ == OutputOnlyFinal::No) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
-    write(event_label.event_number);
-    write(event_label.ensemble_number);
-    write(particles.size());
+    if (delta_encoding_ && clock) {
+      write_delta_block(particles, event_label, clock->current_time());
+    } else {
+      write_particles_block(particles, event_label);
+    }
+  }
+}
+
+void BinaryOutputParticles::write_particles_block(
+    const Particles &particles, const EventLabel &event_label) {
+  begin_block('p');
+  write(event_label.event_number);
+  write(event_label.ensemble_number);
+  write(particles.size());
+  if (!delta_encoding_) {
     write(particles);
+    return;
+  }
+  auto &state = delta_states_[event_label.ensemble_number];
+  state.clear();
+  for (const ParticleData &p : particles) {
+    ToBinary::type line = particle_line(p);
+    write(line);
+    state[p.id()] = DeltaLine{std::move(line), false};
+  }
+}
+
+void BinaryOutputParticles::write_delta_block(const Particles &particles,
+                                              const EventLabel &event_label,
+                                              double time) {
+  auto &state = delta_states_[event_label.ensemble_number];
+  delta_lines_.clear();
+  std::size_t n_lines = 0;
+  for (const ParticleData &p : particles) {
+    ToBinary::type line = particle_line(p);
+    const auto found = state.find(p.id());
+    if (found != state.end()) {
+      DeltaLine &known = found->second;
+      known.present = true;
+      // The reader keeps the streamed line, such that no deviation adds up
+      BinaryReader::free_stream(known.line.data(), time);
+      if (is_free_streamed(known.line, line)) {
+        continue;
+      }
+      known.line = line;
+    } else {
+      state.emplace(p.id(), DeltaLine{line, true});
+    }
+    delta_lines_.insert(delta_lines_.end(), line.begin(), line.end());
+    n_lines++;
+  }
+  std::vector<std::int32_t> removed;
+  for (auto it = state.begin(); it != state.end();) {
+    if (it->second.present) {
+      it->second.present = false;
+      ++it;
+    } else {
+      removed.push_back(it->first);
+      it = state.erase(it);
+    }
+  }
+  std::sort(removed.begin(), removed.end());
+
+  begin_block('d');
+  write(event_label.event_number);
+  write(event_label.ensemble_number);
+  write(time);
+  write(removed.size());
+  write(n_lines);
+  for (std::int32_t id : removed) {
+    write(id);
   }
+  write(delta_lines_);
 }
 
 BinaryOutputInitialConditions::BinaryOutputInitialConditions(
     const std::filesystem::path &path, std::string name,
-    const std::vector<std::string> &quantities)
+    const std::vector<std::string> &quantities, double slab_width)
     : BinaryOutputBase(path / get_binary_filename(name, quantities), "wb", name,
-                       quantities) {}
+                       quantities),
+      slab_width_(slab_width) {
+  if (slab_width < 0.0) {
+    throw std::invalid_argument(
+        "The slab width of the initial conditions output must not be "
+        "negative.");
+  }
+  if (slab_width > 0.0) {
+    std::filesystem::path index_path =
+        path / get_binary_filename(name, quantities);
+    index_path += ".slabs";
+    slab_index_ = std::make_unique<RenamingFilePtr>(index_path, "wb");
+    const std::uint16_t index_version = 1;
+    std::fwrite("SMSL", 4, 1, slab_index_->get());  // magic number
+    std::fwrite(&index_version, sizeof(std::uint16_t), 1, slab_index_->get());
+    std::fwrite(&slab_width_, sizeof(double), 1, slab_index_->get());
+    std::fflush(slab_index_->get());
+  }
+}
 
 void BinaryOutputInitialConditions::at_eventstart(const Particles &,
-                                                  const EventLabel &,
-                                                  const EventInfo &) {}
+                                                  const EventLabel &event_label,
+                                                  const EventInfo &) {
+  event_label_ = event_label;
+  slab_number_ = 0;
+}
 
 void BinaryOutputInitialConditions::at_eventend(
     [[maybe_unused]] const Particles &particles, const EventLabel &event_label,
     const EventInfo &event) {
-  // Event end line
-  const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
-  write(event_label.event_number);
-  write(event_label.ensemble_number);
-  write(event.impact_parameter);
-  const char empty = event.empty_event;
-  write(empty);
+  write_slab();
+  write_event_end(event_label, event);
+}
 
-  // Flush to disk
-  std::fflush(file_.get());
+void BinaryOutputInitialConditions::at_intermediate_time(
+    const Particles &, const std::unique_ptr<Clock> &clock,
+    const DensityParameters &, const EventLabel &, const EventInfo &) {
+  if (slab_index_ && clock &&
+      clock->current_time() >= (slab_number_ + 1) * slab_width_) {
+    write_slab();
+  }
 }
 
 void BinaryOutputInitialConditions::at_interaction(const Action &action,
                                                    const double) {
   if (action.get_type() == ProcessType::Fluidization ||
       action.get_type() == ProcessType::FluidizationNoRemoval) {
-    const char pchar = 'p';
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
-    write(action.incoming_particles().size());
-    write(action.incoming_particles());
+    if (!slab_index_) {
+      begin_block('p');
+      write(action.incoming_particles().size());
+      write(action.incoming_particles());
+      return;
+    }
+    /* The actions are performed in the order of their times, hence a later
+     * slab completes the current one. */
+    const auto slab_number = static_cast<std::int64_t>(
+        std::floor(action.time_of_execution() / slab_width_));
+    if (slab_number > slab_number_) {
+      write_slab();
+      slab_number_ = slab_number;
+    }
+    slab_.insert(slab_.end(), action.incoming_particles().begin(),
+                 action.incoming_particles().end());
   }
 }
 
+void BinaryOutputInitialConditions::write_slab() {
+  if (slab_.empty()) {
+    return;
+  }
+  const auto offset = static_cast<std::uint64_t>(std::ftell(file_.get()));
+  begin_block('p');
+  write(slab_.size());
+  write(slab_);
+  std::fflush(file_.get());
+  // The slab is on disk before it is announced in the index
+  const auto size =
+      static_cast<std::uint64_t>(std::ftell(file_.get())) - offset;
+  const auto n_particles = smash::numeric_cast<std::uint32_t>(slab_.size());
+  const std::array<double, 2> times = {slab_number_ * slab_width_,
+                                       (slab_number_ + 1) * slab_width_};
+  FILE *index = slab_index_->get();
+  std::fwrite(&event_label_.event_number, sizeof(std::int32_t), 1, index);
+  std::fwrite(&event_label_.ensemble_number, sizeof(std::int32_t), 1, index);
+  std::fwrite(&n_particles, sizeof(std::uint32_t), 1, index);
+  std::fwrite(times.data(), sizeof(double), 2, index);
+  std::fwrite(&offset, sizeof(std::uint64_t), 1, index);
+  std::fwrite(&size, sizeof(std::uint64_t), 1, index);
+  std::fflush(index);
+  slab_.clear();
+}
+
 static auto get_list_of_binary_quantities(const std::string &content,
                                           const std::string &format,
                                           const OutputParameters &parameters) {
@@ -466,19 +906,20 @@ static auto get_list_of_binary_quantities(const std::string &content,
 
 std::unique_ptr<OutputInterface> create_binary_output(
     const std::string &format, const std::string &content,
-    const std::filesystem::path &path, const OutputParameters &out_par) {
+    const std::filesystem::path &path, const OutputParameters &out_par,
+    int shard) {
   const auto quantities =
       get_list_of_binary_quantities(content, format, out_par);
   if (content == "Particles") {
     return std::make_unique<BinaryOutputParticles>(path, content, out_par,
-                                                   quantities);
+                                                   quantities, shard);
   } else if (content == "Collisions" || content == "Dileptons" ||
              content == "Photons") {
     return std::make_unique<BinaryOutputCollisions>(path, content, out_par,
-                                                    quantities);
+                                                    quantities, shard);
   } else if (content == "Initial_Conditions") {
-    return std::make_unique<BinaryOutputInitialConditions>(path, content,
-                                                           quantities);
+    return std::make_unique<BinaryOutputInitialConditions>(
+        path, content, quantities, out_par.ic_slab_width);
   } else {
     throw std::invalid_argument("Binary output not available for '" + content +
                                 "' content.");
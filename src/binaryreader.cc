@@ -0,0 +1,442 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/binaryreader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace smash {
+
+namespace {
+
+/// Thrown if the file ends within a block
+struct TruncatedBlock : std::runtime_error {
+  TruncatedBlock() : std::runtime_error("The file ends within a block.") {}
+};
+
+/// Size of an event end line in bytes
+constexpr std::size_t event_end_size =
+    1 + 2 * sizeof(std::int32_t) + sizeof(double) + sizeof(char);
+
+/**
+ * Copy a value from the given position of the bytes and step over it.
+ *
+ * \param[in] bytes The bytes.
+ * \param[inout] position Position of the value.
+ * \param[out] value The value.
+ * \throw TruncatedBlock if the bytes end within the value.
+ */
+template <typename T>
+void read(std::string_view bytes, std::size_t &position, T &value) {
+  if (bytes.size() - position < sizeof(value)) {
+    throw TruncatedBlock();
+  }
+  std::memcpy(&value, bytes.data() + position, sizeof(value));
+  position += sizeof(value);
+}
+
+/**
+ * Step over the given number of bytes.
+ *
+ * \param[in] bytes The bytes.
+ * \param[inout] position The position.
+ * \param[in] n_bytes Number of bytes.
+ * \throw TruncatedBlock if the bytes end before.
+ */
+void skip(std::string_view bytes, std::size_t &position,
+          std::uint64_t n_bytes) {
+  if (bytes.size() - position < n_bytes) {
+    throw TruncatedBlock();
+  }
+  position += n_bytes;
+}
+
+/**
+ * Read the header of a block, except of its type, and step to the next block.
+ *
+ * \param[in] bytes The bytes.
+ * \param[inout] position Position behind the type of the block.
+ * \param[in] type Type of the block.
+ * \param[in] line_size Size of a particle line.
+ * \param[out] block The header and particle lines of the block.
+ * \throw std::runtime_error if the block is invalid.
+ */
+void read_block(std::string_view bytes, std::size_t &position, char type,
+                std::size_t line_size, BinaryReader::Block &block) {
+  block.type = type;
+  std::uint32_t n_particles;
+  if (type == 'p') {
+    read(bytes, position, block.event_number);
+    read(bytes, position, block.ensemble_number);
+    read(bytes, position, n_particles);
+    block.n_incoming = 0;
+  } else if (type == 'd') {
+    read(bytes, position, block.event_number);
+    read(bytes, position, block.ensemble_number);
+    read(bytes, position, block.time);
+    read(bytes, position, block.n_removed);
+    read(bytes, position, n_particles);
+    block.removed_ids = bytes.data() + position;
+    skip(bytes, position, block.n_removed * sizeof(std::int32_t));
+    block.n_incoming = 0;
+  } else if (type == 'i') {
+    std::uint32_t n_outgoing;
+    read(bytes, position, block.n_incoming);
+    read(bytes, position, n_outgoing);
+    read(bytes, position, block.density);
+    read(bytes, position, block.cross_section);
+    read(bytes, position, block.partial_cross_section);
+    read(bytes, position, block.process_type);
+    n_particles = block.n_incoming + n_outgoing;
+  } else if (type == 'r') {
+    std::uint32_t n_outgoing;
+    read(bytes, position, block.n_incoming_ids);
+    read(bytes, position, n_outgoing);
+    read(bytes, position, block.density);
+    read(bytes, position, block.cross_section);
+    read(bytes, position, block.partial_cross_section);
+    read(bytes, position, block.process_type);
+    read(bytes, position, block.time);
+    read(bytes, position, block.n_incoming);
+    if (block.n_incoming > block.n_incoming_ids) {
+      throw std::runtime_error("More incoming lines than incoming particles.");
+    }
+    block.incoming_ids = bytes.data() + position;
+    skip(bytes, position, block.n_incoming_ids * sizeof(std::int32_t));
+    n_particles = block.n_incoming + n_outgoing;
+  } else {
+    throw std::runtime_error(std::string("Unexpected block '") + type + "'.");
+  }
+  const char *lines = bytes.data() + position;
+  skip(bytes, position, std::uint64_t(n_particles) * line_size);
+  block.particles = BinaryReader::Particles(lines, n_particles, line_size);
+}
+
+}  // unnamed namespace
+
+BinaryReader::Event::iterator::iterator(std::string_view content,
+                                        std::size_t position,
+                                        std::size_t line_size)
+    : content_(content), position_(position), line_size_(line_size) {
+  read_block();
+}
+
+BinaryReader::Event::iterator &BinaryReader::Event::iterator::operator++() {
+  position_ = next_position_;
+  read_block();
+  return *this;
+}
+
+void BinaryReader::Event::iterator::read_block() {
+  if (position_ >= content_.size()) {
+    return;
+  }
+  next_position_ = position_ + 1;
+  smash::read_block(content_, next_position_, content_[position_], line_size_,
+                    block_);
+}
+
+void BinaryReader::ParticleState::apply(const Block &block) {
+  if (block.type == 'p') {
+    const char *begin = block.particles.data();
+    lines_.assign(begin, begin + block.particles.size() * line_size_);
+    line_of_id_.clear();
+    for (std::size_t i = 0; i < block.particles.size(); i++) {
+      line_of_id_[block.particles[i].id()] = i;
+    }
+    return;
+  }
+  if (block.type != 'd') {
+    return;
+  }
+  if (block.n_removed > 0) {
+    for (std::size_t i = 0; i < block.n_removed; i++) {
+      line_of_id_.erase(block.removed_id(i));
+    }
+    // Close the gaps of the removed lines, keeping the order of the others
+    std::size_t n_kept = 0;
+    for (std::size_t i = 0; i < lines_.size() / line_size_; i++) {
+      char *line = lines_.data() + i * line_size_;
+      auto found = line_of_id_.find(Particle(line).id());
+      if (found == line_of_id_.end() || found->second != i) {
+        continue;
+      }
+      if (n_kept != i) {
+        std::memcpy(lines_.data() + n_kept * line_size_, line, line_size_);
+      }
+      found->second = n_kept++;
+    }
+    lines_.resize(n_kept * line_size_);
+  }
+  for (std::size_t offset = 0; offset < lines_.size(); offset += line_size_) {
+    free_stream(lines_.data() + offset, block.time);
+  }
+  for (Particle line : block.particles) {
+    const char *bytes = line.data();
+    const auto found =
+        line_of_id_.emplace(line.id(), lines_.size() / line_size_);
+    if (found.second) {
+      lines_.insert(lines_.end(), bytes, bytes + line_size_);
+    } else {
+      std::memcpy(lines_.data() + found.first->second * line_size_, bytes,
+                  line_size_);
+    }
+  }
+}
+
+void BinaryReader::CollisionState::apply(const Block &block) {
+  if (block.type == 'p') {
+    keep(block.particles);
+    return;
+  }
+  if (block.type == 'i') {
+    const Particles incoming = block.incoming();
+    incoming_.assign(incoming.data(),
+                     incoming.data() + incoming.size() * line_size_);
+    for (Particle line : incoming) {
+      known_lines_.erase(line.id());
+    }
+  } else if (block.type == 'r') {
+    incoming_.resize(block.n_incoming_ids * line_size_);
+    const Particles lines = block.incoming();
+    std::size_t n_lines = 0;
+    for (std::size_t i = 0; i < block.n_incoming_ids; i++) {
+      const std::int32_t id = block.incoming_id(i);
+      char *incoming = incoming_.data() + i * line_size_;
+      const auto found = known_lines_.find(id);
+      // The written lines are in the order of the IDs
+      if (n_lines < lines.size() && lines[n_lines].id() == id) {
+        std::memcpy(incoming, lines[n_lines++].data(), line_size_);
+      } else if (found != known_lines_.end()) {
+        std::memcpy(incoming, found->second.data(), line_size_);
+        free_stream(incoming, block.time);
+      } else {
+        throw std::runtime_error("The incoming particle " + std::to_string(id) +
+                                 " of an interaction is not known.");
+      }
+      if (found != known_lines_.end()) {
+        known_lines_.erase(found);
+      }
+    }
+  } else {
+    return;
+  }
+  keep(block.outgoing());
+}
+
+void BinaryReader::CollisionState::keep(const Particles &lines) {
+  for (Particle line : lines) {
+    const char *bytes = line.data();
+    known_lines_[line.id()].assign(bytes, bytes + line_size_);
+  }
+}
+
+void BinaryReader::free_stream(char *line, double time) {
+  double t, x[3], p0, p[3];
+  std::memcpy(&t, line, sizeof(double));
+  std::memcpy(x, line + 8, 3 * sizeof(double));
+  std::memcpy(&p0, line + 40, sizeof(double));
+  std::memcpy(p, line + 48, 3 * sizeof(double));
+  const double dt = time - t;
+  for (int i = 0; i < 3; i++) {
+    x[i] += p[i] / p0 * dt;
+  }
+  std::memcpy(line, &time, sizeof(double));
+  std::memcpy(line + 8, x, 3 * sizeof(double));
+}
+
+BinaryReader::BinaryReader(const std::filesystem::path &path,
+                           std::size_t custom_line_size) {
+  const int fd = open(path.native().c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open binary file \"" + path.native() +
+                             "\".");
+  }
+  struct stat file_status;
+  if (fstat(fd, &file_status) != 0) {
+    close(fd);
+    throw std::runtime_error("Could not read size of binary file \"" +
+                             path.native() + "\".");
+  }
+  size_ = static_cast<std::size_t>(file_status.st_size);
+  if (size_ > 0) {
+    void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Could not map binary file \"" +
+                               path.native() + "\" into memory.");
+    }
+    data_ = static_cast<const char *>(mapping);
+  }
+  // The mapping stays valid after the file is closed
+  close(fd);
+
+  std::filesystem::path index_path = path;
+  index_path += ".idx";
+  try {
+    const std::size_t header_size = read_header(custom_line_size);
+    if (std::filesystem::exists(index_path)) {
+      read_index(index_path, header_size);
+    } else {
+      find_events(header_size);
+    }
+  } catch (const std::runtime_error &e) {
+    // The destructor is not called for a throwing constructor
+    unmap();
+    throw std::runtime_error("Invalid binary file \"" + path.native() +
+                             "\": " + e.what());
+  } catch (...) {
+    unmap();
+    throw;
+  }
+}
+
+BinaryReader::~BinaryReader() { unmap(); }
+
+void BinaryReader::unmap() {
+  if (data_) {
+    munmap(const_cast<char *>(data_), size_);
+    data_ = nullptr;
+  }
+}
+
+std::size_t BinaryReader::read_header(std::size_t custom_line_size) {
+  const std::string_view file{data_, size_};
+  std::size_t position = 0;
+  char magic_number[4];
+  read(file, position, magic_number);
+  if (std::string_view(magic_number, sizeof(magic_number)) != "SMSH") {
+    throw std::runtime_error("It is not a SMASH binary file.");
+  }
+  read(file, position, format_version_);
+  if (format_version_ != 10) {
+    throw std::runtime_error(
+        "Only uncompressed files of format version 10 can be mapped.");
+  }
+  read(file, position, format_variant_);
+  if (format_variant_ == 0) {
+    line_size_ = oscar2013_line_size;
+  } else if (format_variant_ == 1) {
+    line_size_ = oscar2013_extended_line_size;
+  } else if (custom_line_size > 0) {
+    line_size_ = custom_line_size;
+  } else {
+    throw std::invalid_argument(
+        "The size of the lines of custom quantities has to be given.");
+  }
+  std::uint32_t version_length;
+  read(file, position, version_length);
+  smash_version_ = file.substr(position, version_length);
+  skip(file, position, version_length);
+  return position;
+}
+
+void BinaryReader::read_index(const std::filesystem::path &index_path,
+                              std::size_t header_size) {
+  std::ifstream index(index_path, std::ios::binary);
+  char magic_number[4];
+  std::uint16_t index_version, format_version;
+  if (!index || !index.read(magic_number, 4) ||
+      std::string_view(magic_number, 4) != "SMIX" ||
+      !index.read(reinterpret_cast<char *>(&index_version), 2) ||
+      !index.read(reinterpret_cast<char *>(&format_version), 2)) {
+    throw std::runtime_error("The event index is invalid.");
+  }
+  if (index_version != 1 || format_version != format_version_) {
+    throw std::runtime_error("The event index version is not supported.");
+  }
+  constexpr std::size_t record_size = 2 * sizeof(std::int32_t) +
+                                      2 * sizeof(std::uint64_t) +
+                                      sizeof(double) + sizeof(char);
+  char record[record_size];
+  while (index.read(record, record_size)) {
+    std::int32_t event_number, ensemble_number;
+    std::uint64_t offset, size;
+    double impact_parameter;
+    std::memcpy(&event_number, record, 4);
+    std::memcpy(&ensemble_number, record + 4, 4);
+    std::memcpy(&offset, record + 8, 8);
+    std::memcpy(&size, record + 16, 8);
+    std::memcpy(&impact_parameter, record + 24, 8);
+    if (offset < header_size || size < event_end_size ||
+        offset + size > size_ ||
+        data_[offset + size - event_end_size] != 'f') {
+      throw std::runtime_error("The event index does not match the file.");
+    }
+    events_.emplace_back(std::string_view(data_ + offset,
+                                          size - event_end_size),
+                         line_size_, event_number, ensemble_number,
+                         impact_parameter, record[32] != 0);
+  }
+  indexed_ = true;
+}
+
+void BinaryReader::find_events(std::size_t header_size) {
+  const std::string_view file{data_, size_};
+  std::size_t position = header_size, begin = header_size;
+  Block block;
+  try {
+    while (position < size_) {
+      const char type = file[position++];
+      if (type != 'f') {
+        read_block(file, position, type, line_size_, block);
+        continue;
+      }
+      const std::size_t end = position - 1;
+      std::int32_t event_number, ensemble_number;
+      double impact_parameter;
+      char empty;
+      read(file, position, event_number);
+      read(file, position, ensemble_number);
+      read(file, position, impact_parameter);
+      read(file, position, empty);
+      events_.emplace_back(file.substr(begin, end - begin), line_size_,
+                           event_number, ensemble_number, impact_parameter,
+                           empty != 0);
+      begin = position;
+    }
+  } catch (const TruncatedBlock &) {
+    // The file of an unfinished run ends within the incomplete event
+  }
+}
+
+void BinaryReader::prefetch(std::size_t i) const {
+  if (i >= events_.size() || events_[i].content().empty()) {
+    return;
+  }
+  // The advised range has to start at a page boundary
+  static const std::size_t page_size = sysconf(_SC_PAGESIZE);
+  const std::string_view content = events_[i].content();
+  const std::size_t begin = content.data() - data_;
+  const std::size_t page_begin = begin - begin % page_size;
+  madvise(const_cast<char *>(data_) + page_begin,
+          begin + content.size() - page_begin, MADV_WILLNEED);
+}
+
+void BinaryReader::for_each_event(
+    ThreadPool &pool,
+    const std::function<void(std::size_t, const Event &)> &function) const {
+  const std::size_t n_ahead = pool.size();
+  for (std::size_t i = 0; i < n_ahead; i++) {
+    prefetch(i);
+  }
+  pool.parallel_for(events_.size(), [&](std::size_t i) {
+    prefetch(i + n_ahead);
+    function(i, events_[i]);
+  });
+}
+
+}  // namespace smash
@@ -0,0 +1,95 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/blockpool.h"
+
+#include <array>
+#include <new>
+
+namespace smash {
+
+namespace {
+/// Number of different block sizes
+constexpr std::size_t number_of_sizes =
+    BlockPool::max_block_size / BlockPool::alignment;
+
+static_assert(BlockPool::max_block_size % BlockPool::alignment == 0,
+              "The block sizes have to be multiples of the alignment.");
+static_assert(BlockPool::chunk_size >= BlockPool::max_block_size,
+              "A chunk has to hold at least one block of every size.");
+
+/// A freed block, which stores the next freed block of the same size
+struct FreeBlock {
+  /// The next freed block of the same size
+  FreeBlock *next;
+};
+
+/// The pools of the calling thread
+struct ThreadPools {
+  /// The first freed block of every size
+  std::array<FreeBlock *, number_of_sizes> free_blocks{};
+  /// The beginning of the unused part of the current chunk
+  char *chunk_begin = nullptr;
+  /// The end of the current chunk
+  char *chunk_end = nullptr;
+};
+
+/// \return The pools of the calling thread.
+ThreadPools &thread_pools() {
+  static thread_local ThreadPools pools;
+  return pools;
+}
+
+/// \return The index of the block size for \p size.
+std::size_t size_index(std::size_t size) {
+  return size == 0 ? 0 : (size - 1) / BlockPool::alignment;
+}
+}  // namespace
+
+void *BlockPool::allocate(std::size_t size) {
+  if (size > max_block_size) {
+    return ::operator new(size);
+  }
+  ThreadPools &pools = thread_pools();
+  const std::size_t index = size_index(size);
+  FreeBlock *&free_block = pools.free_blocks[index];
+  if (free_block) {
+    FreeBlock *block = free_block;
+    free_block = block->next;
+    return block;
+  }
+  const std::size_t block_size = (index + 1) * alignment;
+  const std::size_t rest = pools.chunk_end - pools.chunk_begin;
+  if (rest < block_size) {
+    /* The rest of the previous chunk is too small for this block, but it can
+     * be handed out as a smaller one. */
+    if (rest > 0) {
+      deallocate(pools.chunk_begin, rest);
+    }
+    pools.chunk_begin = static_cast<char *>(::operator new(chunk_size));
+    pools.chunk_end = pools.chunk_begin + chunk_size;
+  }
+  void *block = pools.chunk_begin;
+  pools.chunk_begin += block_size;
+  return block;
+}
+
+void BlockPool::deallocate(void *block, std::size_t size) noexcept {
+  if (!block) {
+    return;
+  }
+  if (size > max_block_size) {
+    ::operator delete(block);
+    return;
+  }
+  FreeBlock *&free_block = thread_pools().free_blocks[size_index(size)];
+  free_block = new (block) FreeBlock{free_block};
+}
+
+}  // namespace smash
@@ -6,6 +6,7 @@
  */
 #include "smash/boxmodus.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -79,6 +80,14 @@ BoxModus::BoxModus(Configuration modus_config,
       muq_(modus_config.take(InputKeys::modi_box_chargeChemicalPotential)),
       account_for_resonance_widths_(
           modus_config.take(InputKeys::modi_box_accountResonanceWidths)),
+      thermal_mass_sampler_(
+          modus_config.take(InputKeys::modi_box_tabulateThermalMasses)
+              ? std::make_optional<ThermalMassSampler>(1.0 / temperature_)
+              : std::nullopt),
+      tabulate_quantum_momenta_(
+          modus_config.take(InputKeys::modi_box_tabulateQuantumMomenta)),
+      tabulate_thermal_momenta_(
+          modus_config.take(InputKeys::modi_box_tabulateThermalMomenta)),
       init_multipl_(
           use_thermal_
               ? std::map<PdgCode, int>()
@@ -103,17 +112,28 @@ BoxModus::BoxModus(Configuration modus_config,
   if (std::abs(length_ - parameters.box_length) > really_small) {
     throw std::runtime_error("Box length inconsistency");
   }
+  if (modus_config.take(InputKeys::modi_box_lazyWallCrossings) !=
+      parameters.lazy_wall_crossings) {
+    throw std::runtime_error("Lazy wall crossings inconsistency");
+  }
+  const int n_sampling_threads =
+      modus_config.take(InputKeys::modi_box_samplingThreads);
+  if (n_sampling_threads < 0) {
+    throw std::invalid_argument(
+        "The number of sampling threads cannot be negative.");
+  }
+  if (n_sampling_threads > 0) {
+    sampling_thread_pool_ = std::make_unique<ThreadPool>(n_sampling_threads);
+  }
 }
 
 double BoxModus::initial_conditions(Particles *particles,
                                     const ExperimentParameters &parameters) {
-  double momentum_radial = 0.0, mass = 0.0;
-  Angles phitheta;
   FourVector momentum_total(0, 0, 0, 0);
-  auto uniform_length = random::make_uniform_distribution(0.0, this->length_);
   const double T = this->temperature_;
   const double V = length_ * length_ * length_;
   /* Create NUMBER OF PARTICLES according to configuration, or thermal case */
+  std::vector<int> multiplicities;
   if (use_thermal_) {
     if (average_multipl_.empty()) {
       for (const ParticleType &ptype : ParticleType::list_all()) {
@@ -131,6 +151,7 @@ double BoxModus::initial_conditions(Particles *particles,
     for (const auto &mult : average_multipl_) {
       const int thermal_mult_int = random::poisson(mult.second);
       particles->create(thermal_mult_int, mult.first);
+      multiplicities.push_back(thermal_mult_int);
       nb_init += mult.second * mult.first.baryon_number();
       ns_init += mult.second * mult.first.strangeness();
       nq_init += mult.second * mult.first.charge();
@@ -142,51 +163,42 @@ double BoxModus::initial_conditions(Particles *particles,
   } else {
     for (const auto &p : init_multipl_) {
       particles->create(p.second * parameters.testparticles, p.first);
+      multiplicities.push_back(p.second * parameters.testparticles);
       logg[LBox].debug("Particle ", p.first, " initial multiplicity ",
                        p.second);
     }
   }
-  std::unique_ptr<QuantumSampling> quantum_sampling;
-  if (this->initial_condition_ == BoxInitialCondition::ThermalMomentaQuantum) {
-    quantum_sampling = std::make_unique<QuantumSampling>(init_multipl_, V, T);
+  // The sampler only depends on fixed parameters and is reused in all events
+  if (this->initial_condition_ == BoxInitialCondition::ThermalMomentaQuantum &&
+      !quantum_sampling_) {
+    quantum_sampling_ = std::make_unique<QuantumSampling>(
+        init_multipl_, V, T, tabulate_quantum_momenta_);
   }
-  for (ParticleData &data : *particles) {
-    /* Set MOMENTUM SPACE distribution */
-    if (this->initial_condition_ == BoxInitialCondition::PeakedMomenta) {
-      /* initial thermal momentum is the average 3T */
-      momentum_radial = 3.0 * T;
-      mass = data.pole_mass();
-    } else {
-      if (this->initial_condition_ ==
-          BoxInitialCondition::ThermalMomentaBoltzmann) {
-        /* thermal momentum according Maxwell-Boltzmann distribution */
-        mass = (!account_for_resonance_widths_)
-                   ? data.type().mass()
-                   : HadronGasEos::sample_mass_thermal(data.type(), 1.0 / T);
-        momentum_radial = sample_momenta_from_thermal(T, mass);
-      } else if (this->initial_condition_ ==
-                 BoxInitialCondition::ThermalMomentaQuantum) {
-        /*
-         * Sampling the thermal momentum according Bose/Fermi/Boltzmann
-         * distribution.
-         * We take the pole mass as the mass.
-         */
-        mass = data.type().mass();
-        momentum_radial = quantum_sampling->sample(data.pdgcode());
+  if (tabulate_thermal_momenta_ && !account_for_resonance_widths_ &&
+      initial_condition_ == BoxInitialCondition::ThermalMomentaBoltzmann &&
+      !thermal_momentum_sampler_) {
+    // One table per species
+    thermal_momentum_sampler_ = std::make_unique<ThermalMomentumSampler>(
+        ThermalMomentumSampler::Distribution::Thermal,
+        std::max<std::size_t>(multiplicities.size(), 1));
+  }
+  if (sampling_thread_pool_) {
+    if (thermal_mass_sampler_ && account_for_resonance_widths_ &&
+        initial_condition_ == BoxInitialCondition::ThermalMomentaBoltzmann) {
+      for (const ParticleData &data : *particles) {
+        thermal_mass_sampler_->prepare(data.type());
       }
     }
-    phitheta.distribute_isotropically();
-    logg[LBox].debug(data.type().name(), "(id ", data.id(),
-                     ") radial momentum ", momentum_radial, ", direction",
-                     phitheta);
-    data.set_4momentum(mass, phitheta.threevec() * momentum_radial);
+    sample_species_concurrently(
+        particles, multiplicities, *sampling_thread_pool_,
+        [this](ParticleData &data) { sample_phase_space(data); });
+  } else {
+    for (ParticleData &data : *particles) {
+      sample_phase_space(data);
+    }
+  }
+  for (const ParticleData &data : *particles) {
     momentum_total += data.momentum();
-
-    /* Set COORDINATE SPACE distribution */
-    ThreeVector pos{uniform_length(), uniform_length(), uniform_length()};
-    data.set_4position(FourVector(start_time_, pos));
-    /// Initialize formation time
-    data.set_formation_time(start_time_);
   }
 
   /* Make total 3-momentum of the box 0 and initialize an unpolarized spin
@@ -227,6 +239,54 @@ double BoxModus::initial_conditions(Particles *particles,
   return start_time_;
 }
 
+void BoxModus::sample_phase_space(ParticleData &data) {
+  double momentum_radial = 0.0, mass = 0.0;
+  Angles phitheta;
+  auto uniform_length = random::make_uniform_distribution(0.0, this->length_);
+  const double T = this->temperature_;
+  /* Set MOMENTUM SPACE distribution */
+  if (this->initial_condition_ == BoxInitialCondition::PeakedMomenta) {
+    /* initial thermal momentum is the average 3T */
+    momentum_radial = 3.0 * T;
+    mass = data.pole_mass();
+  } else {
+    if (this->initial_condition_ ==
+        BoxInitialCondition::ThermalMomentaBoltzmann) {
+      /* thermal momentum according Maxwell-Boltzmann distribution */
+      if (!account_for_resonance_widths_) {
+        mass = data.type().mass();
+      } else if (thermal_mass_sampler_) {
+        mass = thermal_mass_sampler_->sample(data.type());
+      } else {
+        mass = HadronGasEos::sample_mass_thermal(data.type(), 1.0 / T);
+      }
+      momentum_radial = thermal_momentum_sampler_
+                            ? thermal_momentum_sampler_->sample(T, mass)
+                            : sample_momenta_from_thermal(T, mass);
+    } else if (this->initial_condition_ ==
+               BoxInitialCondition::ThermalMomentaQuantum) {
+      /*
+       * Sampling the thermal momentum according Bose/Fermi/Boltzmann
+       * distribution.
+       * We take the pole mass as the mass.
+       */
+      mass = data.type().mass();
+      momentum_radial = quantum_sampling_->sample(data.pdgcode());
+    }
+  }
+  phitheta.distribute_isotropically();
+  logg[LBox].debug(data.type().name(), "(id ", data.id(),
+                   ") radial momentum ", momentum_radial, ", direction",
+                   phitheta);
+  data.set_4momentum(mass, phitheta.threevec() * momentum_radial);
+
+  /* Set COORDINATE SPACE distribution */
+  ThreeVector pos{uniform_length(), uniform_length(), uniform_length()};
+  data.set_4position(FourVector(start_time_, pos));
+  /// Initialize formation time
+  data.set_formation_time(start_time_);
+}
+
 int BoxModus::impose_boundary_conditions(Particles *particles,
                                          const OutputsList &output_list) {
   int wraps = 0;
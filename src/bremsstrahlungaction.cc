@@ -9,6 +9,9 @@
 
 #include "smash/bremsstrahlungaction.h"
 
+#include <iterator>
+#include <vector>
+
 #include "smash/crosssectionsbrems.h"
 #include "smash/outputinterface.h"
 #include "smash/random.h"
@@ -16,6 +19,8 @@
 namespace smash {
 static constexpr int LScatterAction = LogArea::ScatterAction::id;
 
+bool BremsstrahlungAction::grid_lookup_ = false;
+
 BremsstrahlungAction::BremsstrahlungAction(
     const ParticleList &in, const double time, const int n_frac_photons,
     const double hadronic_cross_section_input,
@@ -63,14 +68,25 @@ BremsstrahlungAction::bremsstrahlung_reaction_type(const ParticleList &in) {
 }
 
 void BremsstrahlungAction::perform_bremsstrahlung(const OutputsList &outputs) {
-  for (int i = 0; i < number_of_fractional_photons_; i++) {
-    generate_final_state();
+  auto write_photon = [&]() {
     for (const auto &output : outputs) {
       if (output->is_photon_output()) {
         // we do not care about the local density
         output->at_interaction(*this, 0.0);
       }
     }
+  };
+  if (number_of_fractional_photons_ < 1) {
+    return;
+  }
+  generate_final_state();
+  write_photon();
+  if (number_of_fractional_photons_ > 1) {
+    const Kinematics shared = kinematics();
+    for (int i = 1; i < number_of_fractional_photons_; i++) {
+      sample_photon(shared);
+      write_photon();
+    }
   }
 }
 
@@ -85,20 +101,30 @@ void BremsstrahlungAction::generate_final_state() {
     throw std::runtime_error("");
   }
 
+  outgoing_particles_ = collision_processes_bremsstrahlung_[0]->particle_list();
+  sample_photon(kinematics());
+}
+
+BremsstrahlungAction::Kinematics BremsstrahlungAction::kinematics() const {
+  const double k_max =
+      (sqrt_s() * sqrt_s() - 2 * outgoing_particles_[0].type().mass() * 2 *
+                                 outgoing_particles_[1].type().mass()) /
+      (2 * sqrt_s());
+  return {get_interaction_point(), k_max,
+          LorentzBoost(-total_momentum_of_outgoing_particles().velocity())};
+}
+
+void BremsstrahlungAction::sample_photon(const Kinematics &kin) {
   auto *proc = collision_processes_bremsstrahlung_[0].get();
 
   outgoing_particles_ = proc->particle_list();
   process_type_ = proc->get_type();
-  FourVector interaction_point = get_interaction_point();
 
   // Sample k and theta:
   // minimum cutoff for k to be in accordance with cross section calculations
   double delta_k;  // k-range
   double k_min = 0.001;
-  double k_max =
-      (sqrt_s() * sqrt_s() - 2 * outgoing_particles_[0].type().mass() * 2 *
-                                 outgoing_particles_[1].type().mass()) /
-      (2 * sqrt_s());
+  const double k_max = kin.k_max;
 
   if ((k_max - k_min) < 0.0) {
     // Make sure it is kinematically even possible to create a photon that is
@@ -133,9 +159,8 @@ void BremsstrahlungAction::generate_final_state() {
   for (auto &new_particle : outgoing_particles_) {
     // assuming decaying particles are always fully formed
     new_particle.set_formation_time(time_of_execution_);
-    new_particle.set_4position(interaction_point);
-    new_particle.boost_momentum(
-        -total_momentum_of_outgoing_particles().velocity());
+    new_particle.set_4position(kin.interaction_point);
+    new_particle.boost_momentum(kin.to_computational_frame);
   }
 
   // Set unpolarized spin vectors
@@ -171,8 +196,9 @@ void BremsstrahlungAction::sample_3body_phasespace() {
   phitheta.distribute_isotropically();
   outgoing_particles_[0].set_4momentum(m_a, pcm_pions * phitheta.threevec());
   outgoing_particles_[1].set_4momentum(m_b, -pcm_pions * phitheta.threevec());
-  outgoing_particles_[0].boost_momentum(beta_cm_pion_pair_photon);
-  outgoing_particles_[1].boost_momentum(beta_cm_pion_pair_photon);
+  const LorentzBoost to_cm_frame(beta_cm_pion_pair_photon);
+  outgoing_particles_[0].boost_momentum(to_cm_frame);
+  outgoing_particles_[1].boost_momentum(to_cm_frame);
 }
 
 void BremsstrahlungAction::add_dummy_hadronic_process(
@@ -325,37 +351,44 @@ std::pair<double, double> BremsstrahlungAction::brems_diff_cross_sections() {
 }
 
 void BremsstrahlungAction::create_interpolations() {
+  const auto table = [](const auto &values) {
+    return std::vector<double>(std::begin(values), std::end(values));
+  };
   // Read in tabularized values for sqrt(s), k and theta
-  std::vector<double> sqrts = BREMS_SQRTS;
-  std::vector<double> photon_momentum = BREMS_K;
-  std::vector<double> photon_angle = BREMS_THETA;
+  std::vector<double> sqrts = table(BREMS_SQRTS);
+  std::vector<double> photon_momentum = table(BREMS_K);
+  std::vector<double> photon_angle = table(BREMS_THETA);
 
   // Read in tabularized total cross sections
-  std::vector<double> sigma_pipi_pipi_opp = BREMS_PIPI_PIPI_OPP_SIG;
-  std::vector<double> sigma_pipi_pipi_same = BREMS_PIPI_PIPI_SAME_SIG;
-  std::vector<double> sigma_pipi0_pipi0 = BREMS_PIPI0_PIPI0_SIG;
-  std::vector<double> sigma_pipi_pi0pi0 = BREMS_PIPI_PI0PI0_SIG;
-  std::vector<double> sigma_pi0pi0_pipi = BREMS_PI0PI0_PIPI_SIG;
+  std::vector<double> sigma_pipi_pipi_opp = table(BREMS_PIPI_PIPI_OPP_SIG);
+  std::vector<double> sigma_pipi_pipi_same = table(BREMS_PIPI_PIPI_SAME_SIG);
+  std::vector<double> sigma_pipi0_pipi0 = table(BREMS_PIPI0_PIPI0_SIG);
+  std::vector<double> sigma_pipi_pi0pi0 = table(BREMS_PIPI_PI0PI0_SIG);
+  std::vector<double> sigma_pi0pi0_pipi = table(BREMS_PI0PI0_PIPI_SIG);
 
   // Read in tabularized differential cross sections dSigma/dk
-  std::vector<double> dsigma_dk_pipi_pipi_opp = BREMS_PIPI_PIPI_OPP_DIFF_SIG_K;
+  std::vector<double> dsigma_dk_pipi_pipi_opp =
+      table(BREMS_PIPI_PIPI_OPP_DIFF_SIG_K);
   std::vector<double> dsigma_dk_pipi_pipi_same =
-      BREMS_PIPI_PIPI_SAME_DIFF_SIG_K;
-  std::vector<double> dsigma_dk_pipi0_pipi0 = BREMS_PIPI0_PIPI0_DIFF_SIG_K;
-  std::vector<double> dsigma_dk_pipi_pi0pi0 = BREMS_PIPI_PI0PI0_DIFF_SIG_K;
-  std::vector<double> dsigma_dk_pi0pi0_pipi = BREMS_PI0PI0_PIPI_DIFF_SIG_K;
+      table(BREMS_PIPI_PIPI_SAME_DIFF_SIG_K);
+  std::vector<double> dsigma_dk_pipi0_pipi0 =
+      table(BREMS_PIPI0_PIPI0_DIFF_SIG_K);
+  std::vector<double> dsigma_dk_pipi_pi0pi0 =
+      table(BREMS_PIPI_PI0PI0_DIFF_SIG_K);
+  std::vector<double> dsigma_dk_pi0pi0_pipi =
+      table(BREMS_PI0PI0_PIPI_DIFF_SIG_K);
 
   // Read in tabularized differential cross sections dSigma/dtheta
   std::vector<double> dsigma_dtheta_pipi_pipi_opp =
-      BREMS_PIPI_PIPI_OPP_DIFF_SIG_THETA;
+      table(BREMS_PIPI_PIPI_OPP_DIFF_SIG_THETA);
   std::vector<double> dsigma_dtheta_pipi_pipi_same =
-      BREMS_PIPI_PIPI_SAME_DIFF_SIG_THETA;
+      table(BREMS_PIPI_PIPI_SAME_DIFF_SIG_THETA);
   std::vector<double> dsigma_dtheta_pipi0_pipi0 =
-      BREMS_PIPI0_PIPI0_DIFF_SIG_THETA;
+      table(BREMS_PIPI0_PIPI0_DIFF_SIG_THETA);
   std::vector<double> dsigma_dtheta_pipi_pi0pi0 =
-      BREMS_PIPI_PI0PI0_DIFF_SIG_THETA;
+      table(BREMS_PIPI_PI0PI0_DIFF_SIG_THETA);
   std::vector<double> dsigma_dtheta_pi0pi0_pipi =
-      BREMS_PI0PI0_PIPI_DIFF_SIG_THETA;
+      table(BREMS_PI0PI0_PIPI_DIFF_SIG_THETA);
 
   // Create interpolation objects containing linear interpolations for
   // total cross sections
@@ -374,37 +407,37 @@ void BremsstrahlungAction::create_interpolations() {
   // Create interpolation objects containing bicubic interpolations for
   // differential dSigma/dk
   pipi_pipi_opp_dsigma_dk_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_momentum, sqrts,
-                                                dsigma_dk_pipi_pipi_opp);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_momentum, sqrts, dsigma_dk_pipi_pipi_opp, grid_lookup_);
   pipi_pipi_same_dsigma_dk_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_momentum, sqrts,
-                                                dsigma_dk_pipi_pipi_same);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_momentum, sqrts, dsigma_dk_pipi_pipi_same, grid_lookup_);
   pipi0_pipi0_dsigma_dk_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_momentum, sqrts,
-                                                dsigma_dk_pipi0_pipi0);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_momentum, sqrts, dsigma_dk_pipi0_pipi0, grid_lookup_);
   pipi_pi0pi0_dsigma_dk_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_momentum, sqrts,
-                                                dsigma_dk_pipi_pi0pi0);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_momentum, sqrts, dsigma_dk_pipi_pi0pi0, grid_lookup_);
   pi0pi0_pipi_dsigma_dk_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_momentum, sqrts,
-                                                dsigma_dk_pi0pi0_pipi);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_momentum, sqrts, dsigma_dk_pi0pi0_pipi, grid_lookup_);
 
   // Create interpolation objects containing bicubic interpolations for
   // differential dSigma/dtheta
   pipi_pipi_opp_dsigma_dtheta_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                                dsigma_dtheta_pipi_pipi_opp);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_angle, sqrts, dsigma_dtheta_pipi_pipi_opp, grid_lookup_);
   pipi_pipi_same_dsigma_dtheta_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                                dsigma_dtheta_pipi_pipi_same);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_angle, sqrts, dsigma_dtheta_pipi_pipi_same, grid_lookup_);
   pipi0_pipi0_dsigma_dtheta_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                                dsigma_dtheta_pipi0_pipi0);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_angle, sqrts, dsigma_dtheta_pipi0_pipi0, grid_lookup_);
   pipi_pi0pi0_dsigma_dtheta_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                                dsigma_dtheta_pipi_pi0pi0);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_angle, sqrts, dsigma_dtheta_pipi_pi0pi0, grid_lookup_);
   pi0pi0_pipi_dsigma_dtheta_interpolation =
-      std::make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                                dsigma_dtheta_pi0pi0_pipi);
+      std::make_unique<InterpolateData2DSpline>(
+          photon_angle, sqrts, dsigma_dtheta_pi0pi0_pipi, grid_lookup_);
 }
 }  // namespace smash
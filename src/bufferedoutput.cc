@@ -0,0 +1,316 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/bufferedoutput.h"
+
+#include <atomic>
+#include <stdexcept>
+
+#include "smash/clock.h"
+#include "smash/density.h"
+#include "smash/energymomentumtensor.h"
+#include "smash/particles.h"
+#include "smash/performanceoutput.h"
+
+namespace smash {
+
+/**
+ * Construct the name giving an output the same flags as the given one.
+ *
+ * \param[in] target The output whose flags are to be reproduced.
+ * \return A name which is recognized by the OutputInterface constructor.
+ */
+static std::string name_with_same_flags(const OutputInterface &target) {
+  if (target.is_dilepton_output()) {
+    return "Dileptons";
+  } else if (target.is_photon_output()) {
+    return "Photons";
+  } else if (target.is_IC_output()) {
+    return "SMASH_IC";
+  }
+  return "Buffer";
+}
+
+/**
+ * Share a copy, whose memory is counted as long as it is used.
+ *
+ * \param[in] copy The copy.
+ * \param[in] bytes The memory used by the copy [bytes].
+ * \param[in] counter The memory counted for the copies of a buffered output.
+ * \return The shared copy, which subtracts its memory from the counter once it
+ *         is released.
+ */
+template <typename T>
+static std::shared_ptr<T> counted(
+    std::shared_ptr<T> copy, std::size_t bytes,
+    const std::shared_ptr<std::atomic<std::size_t>> &counter) {
+  counter->fetch_add(bytes, std::memory_order_relaxed);
+  T *pointer = copy.get();
+  return std::shared_ptr<T>(
+      pointer, [copy = std::move(copy), bytes, counter](T *) {
+        counter->fetch_sub(bytes, std::memory_order_relaxed);
+      });
+}
+
+/**
+ * Copy the particles of an ensemble, keeping their ids.
+ *
+ * \param[in] particles The particles to be copied.
+ * \param[in] counter The memory counted for the copies of the output.
+ * \return A shared copy, which can be captured by the buffered calls.
+ */
+static std::shared_ptr<const Particles> copy_of(
+    const Particles &particles,
+    const std::shared_ptr<std::atomic<std::size_t>> &counter) {
+  auto copy = std::make_shared<Particles>();
+  copy->copy_from(particles);
+  const std::size_t bytes = copy->memory_usage();
+  return counted(std::move(copy), bytes, counter);
+}
+
+/**
+ * Copy the particles of all ensembles, keeping their ids.
+ *
+ * \param[in] ensembles The particles to be copied.
+ * \param[in] counter The memory counted for the copies of the output.
+ * \return A shared copy, which can be captured by the buffered calls.
+ */
+static std::shared_ptr<const std::vector<Particles>> copy_of(
+    const std::vector<Particles> &ensembles,
+    const std::shared_ptr<std::atomic<std::size_t>> &counter) {
+  auto copy = std::make_shared<std::vector<Particles>>(ensembles.size());
+  std::size_t bytes = 0;
+  for (std::size_t i = 0; i < ensembles.size(); i++) {
+    (*copy)[i].copy_from(ensembles[i]);
+    bytes += (*copy)[i].memory_usage();
+  }
+  return counted(std::move(copy), bytes, counter);
+}
+
+/**
+ * Copy a lattice.
+ *
+ * \param[in] lattice The lattice to be copied.
+ * \param[in] counter The memory counted for the copies of the output.
+ * \return A shared copy, which can be captured by the buffered calls.
+ */
+template <typename T>
+static std::shared_ptr<RectangularLattice<T>> copy_of(
+    const RectangularLattice<T> &lattice,
+    const std::shared_ptr<std::atomic<std::size_t>> &counter) {
+  auto copy = std::make_shared<RectangularLattice<T>>(lattice);
+  const std::size_t bytes = sizeof(lattice) + copy->memory_usage();
+  return counted(std::move(copy), bytes, counter);
+}
+
+/**
+ * Create a clock standing still at the given time.
+ *
+ * \param[in] time The time to be returned by the clock.
+ * \return The clock.
+ */
+static std::unique_ptr<Clock> clock_at(double time) {
+  std::unique_ptr<Clock> clock =
+      std::make_unique<CustomClock>(std::vector<double>{});
+  clock->reset(time, false);
+  return clock;
+}
+
+BufferedOutput::BufferedOutput(OutputInterface &target)
+    : OutputInterface(name_with_same_flags(target)),
+      target_(target),
+      held_bytes_(std::make_shared<std::atomic<std::size_t>>(0)) {}
+
+void BufferedOutput::at_eventstart(const Particles &particles,
+                                   const EventLabel &event_label,
+                                   const EventInfo &event) {
+  enqueue_output_call([particles = copy_of(particles, held_bytes_), event_label,
+                       event](OutputInterface &output) {
+    output.at_eventstart(*particles, event_label, event);
+  });
+}
+
+void BufferedOutput::at_eventstart(const std::vector<Particles> &ensembles,
+                                   int event_number) {
+  enqueue_output_call([ensembles = copy_of(ensembles, held_bytes_),
+                       event_number](OutputInterface &output) {
+    output.at_eventstart(*ensembles, event_number);
+  });
+}
+
+void BufferedOutput::at_eventstart(
+    const int event_number, const ThermodynamicQuantity tq,
+    const DensityType dens_type, RectangularLattice<DensityOnLattice> lattice) {
+  auto copy = copy_of(lattice, held_bytes_);
+  enqueue_output_call([event_number, tq, dens_type,
+                       copy](OutputInterface &output) {
+    output.at_eventstart(event_number, tq, dens_type, *copy);
+  });
+}
+
+void BufferedOutput::at_eventstart(
+    const int event_number, const ThermodynamicQuantity tq,
+    const DensityType dens_type,
+    RectangularLattice<EnergyMomentumTensor> lattice) {
+  auto copy = copy_of(lattice, held_bytes_);
+  enqueue_output_call([event_number, tq, dens_type,
+                       copy](OutputInterface &output) {
+    output.at_eventstart(event_number, tq, dens_type, *copy);
+  });
+}
+
+void BufferedOutput::at_eventend(const ThermodynamicQuantity tq) {
+  enqueue_output_call(
+      [tq](OutputInterface &output) { output.at_eventend(tq); });
+}
+
+void BufferedOutput::at_eventend(const Particles &particles,
+                                 const EventLabel &event_label,
+                                 const EventInfo &event) {
+  enqueue_output_call([particles = copy_of(particles, held_bytes_), event_label,
+                       event](OutputInterface &output) {
+    output.at_eventend(*particles, event_label, event);
+  });
+}
+
+void BufferedOutput::at_eventend(const std::vector<Particles> &ensembles,
+                                 const int event_number) {
+  enqueue_output_call([ensembles = copy_of(ensembles, held_bytes_),
+                       event_number](OutputInterface &output) {
+    output.at_eventend(*ensembles, event_number);
+  });
+}
+
+void BufferedOutput::event_statistics_output(
+    const int event_number, const EventStatistics &statistics) {
+  enqueue_output_call([event_number, statistics](OutputInterface &output) {
+    output.event_statistics_output(event_number, statistics);
+  });
+}
+
+void BufferedOutput::at_interaction(const Action &action,
+                                    const double density) {
+  at_recorded_interaction(std::make_shared<const RecordedAction>(action),
+                          density);
+}
+
+void BufferedOutput::at_recorded_interaction(
+    const std::shared_ptr<const RecordedAction> &action, const double density) {
+  const std::size_t bytes = sizeof(RecordedAction) +
+                            (action->incoming_particles().capacity() +
+                             action->outgoing_particles().capacity()) *
+                                sizeof(ParticleData);
+  enqueue_output_call([action = counted(action, bytes, held_bytes_),
+                       density](OutputInterface &output) {
+    if (output.keeps_interactions()) {
+      output.at_recorded_interaction(action, density);
+    } else {
+      output.at_interaction(*action, density);
+    }
+  });
+}
+
+void BufferedOutput::at_intermediate_time(const Particles &particles,
+                                          const std::unique_ptr<Clock> &clock,
+                                          const DensityParameters &dens_param,
+                                          const EventLabel &event_label,
+                                          const EventInfo &event) {
+  enqueue_output_call([particles = copy_of(particles, held_bytes_),
+                       time = clock->current_time(), dens_param, event_label,
+                       event](OutputInterface &output) {
+    output.at_intermediate_time(*particles, clock_at(time), dens_param,
+                                event_label, event);
+  });
+}
+
+void BufferedOutput::at_intermediate_time(
+    const std::vector<Particles> &ensembles,
+    const std::unique_ptr<Clock> &clock, const DensityParameters &dens_param) {
+  enqueue_output_call([ensembles = copy_of(ensembles, held_bytes_),
+                       time = clock->current_time(),
+                       dens_param](OutputInterface &output) {
+    output.at_intermediate_time(*ensembles, clock_at(time), dens_param);
+  });
+}
+
+void BufferedOutput::thermodynamics_output(
+    const ThermodynamicQuantity tq, const DensityType dens_type,
+    RectangularLattice<DensityOnLattice> &lattice) {
+  auto copy = copy_of(lattice, held_bytes_);
+  enqueue_output_call([tq, dens_type, copy](OutputInterface &output) {
+    output.thermodynamics_output(tq, dens_type, *copy);
+  });
+}
+
+void BufferedOutput::thermodynamics_output(
+    const ThermodynamicQuantity tq, const DensityType dens_type,
+    RectangularLattice<EnergyMomentumTensor> &lattice) {
+  auto copy = copy_of(lattice, held_bytes_);
+  enqueue_output_call([tq, dens_type, copy](OutputInterface &output) {
+    output.thermodynamics_output(tq, dens_type, *copy);
+  });
+}
+
+void BufferedOutput::thermodynamics_lattice_output(
+    RectangularLattice<DensityOnLattice> &lattice, const double current_time) {
+  auto copy = copy_of(lattice, held_bytes_);
+  enqueue_output_call([copy, current_time](OutputInterface &output) {
+    output.thermodynamics_lattice_output(*copy, current_time);
+  });
+}
+
+void BufferedOutput::thermodynamics_lattice_output(
+    RectangularLattice<DensityOnLattice> &lattice, const double current_time,
+    const std::vector<Particles> &ensembles,
+    const DensityParameters &dens_param) {
+  auto copy = copy_of(lattice, held_bytes_);
+  enqueue_output_call([copy, current_time,
+                       ensembles = copy_of(ensembles, held_bytes_),
+                       dens_param](OutputInterface &output) {
+    output.thermodynamics_lattice_output(*copy, current_time, *ensembles,
+                                         dens_param);
+  });
+}
+
+void BufferedOutput::thermodynamics_lattice_output(
+    const ThermodynamicQuantity tq,
+    RectangularLattice<EnergyMomentumTensor> &lattice,
+    const double current_time) {
+  auto copy = copy_of(lattice, held_bytes_);
+  enqueue_output_call([tq, copy, current_time](OutputInterface &output) {
+    output.thermodynamics_lattice_output(tq, *copy, current_time);
+  });
+}
+
+void BufferedOutput::thermodynamics_output(const GrandCanThermalizer &) {
+  throw std::logic_error(
+      "The output of the forced thermalization cannot be buffered.");
+}
+
+void BufferedOutput::fields_output(
+    const std::string name1, const std::string name2,
+    RectangularLattice<std::pair<ThreeVector, ThreeVector>> &lattice) {
+  auto copy = copy_of(lattice, held_bytes_);
+  enqueue_output_call([name1, name2, copy](OutputInterface &output) {
+    output.fields_output(name1, name2, *copy);
+  });
+}
+
+void BufferedOutput::flush() {
+  flush(calls_);
+  calls_.clear();
+}
+
+void BufferedOutput::flush(const Calls &calls) const {
+  for (const auto &call : calls) {
+    call(target_);
+  }
+}
+
+}  // namespace smash
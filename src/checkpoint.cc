@@ -0,0 +1,54 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/checkpoint.h"
+
+#include <atomic>
+#include <fstream>
+
+namespace smash {
+
+namespace {
+/// Whether a checkpoint was requested, e.g. by a signal
+std::atomic<bool> checkpoint_requested{false};
+static_assert(std::atomic<bool>::is_always_lock_free,
+              "Checkpoints could not be requested from signal handlers.");
+}  // unnamed namespace
+
+void CheckpointWriter::write(const std::filesystem::path &file) const {
+  std::filesystem::path partial = file;
+  partial += ".partial";
+  {
+    std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+    if (!out.write(data_.data(), data_.size()) || !out.flush()) {
+      throw std::runtime_error("The checkpoint could not be written to " +
+                               partial.string() + ".");
+    }
+  }
+  std::filesystem::rename(partial, file);
+}
+
+CheckpointReader::CheckpointReader(const std::filesystem::path &file) {
+  std::ifstream in(file, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("The checkpoint " + file.string() +
+                             " could not be opened.");
+  }
+  data_.resize(std::filesystem::file_size(file));
+  if (!in.read(data_.data(), data_.size())) {
+    throw std::runtime_error("The checkpoint " + file.string() +
+                             " could not be read.");
+  }
+}
+
+void request_checkpoint() { checkpoint_requested.store(true); }
+
+bool take_checkpoint_request() { return checkpoint_requested.exchange(false); }
+
+}  // namespace smash
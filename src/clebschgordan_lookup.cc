@@ -7,8 +7,9 @@
 
 #include "smash/clebschgordan_lookup.h"
 
+#include <algorithm>
+#include <iterator>
 #include <numeric>
-#include <unordered_map>
 
 #include "gsl/gsl_sf_coupling.h"
 
@@ -40,15 +41,47 @@ double ClebschGordan::calculate_coefficient(const int j_a, const int j_b,
 
 double ClebschGordan::coefficient(const int j_a, const int j_b, const int j_c,
                                   const int m_a, const int m_b, const int m_c) {
+  const int n = n_table_isospins;
+  if (j_a >= 0 && j_a < n && j_b >= 0 && j_b < n && j_c >= 0 && j_c < n) {
+    // The z-components have to add up and to be allowed for their isospins.
+    if (m_c != m_a + m_b || std::abs(m_a) > j_a || std::abs(m_b) > j_b ||
+        (j_a + m_a) % 2 != 0 || (j_b + m_b) % 2 != 0) {
+      return 0.;
+    }
+    return dense_table[table_index(n, j_a, j_b, j_c, m_a, m_b)];
+  }
   const ThreeSpins spin_information = {j_a, j_b, j_c, m_a, m_b, m_c};
-  if (auto search = lookup_table.find(spin_information);
-      search != lookup_table.end()) {
-    return search->second;
-  } else {
-    double result = calculate_coefficient(j_a, j_b, j_c, m_a, m_b, m_c);
-    lookup_table.insert({spin_information, result});
-    return result;
+  const auto search = std::lower_bound(
+      std::begin(tabulated_coefficients), std::end(tabulated_coefficients),
+      spin_information, [](const TabulatedCoefficient &tabulated,
+                           const ThreeSpins &spins) {
+        return tabulated.spins < spins;
+      });
+  if (search != std::end(tabulated_coefficients) &&
+      search->spins == spin_information) {
+    return search->value;
+  }
+  return calculate_coefficient(j_a, j_b, j_c, m_a, m_b, m_c);
+}
+
+void ClebschGordan::create_table(const int max_isospin) {
+  const int n = 2 * max_isospin + 1;
+  std::vector<double> table(static_cast<std::size_t>(n) * n * n * n * n, 0.);
+  for (int j_a = 0; j_a < n; j_a++) {
+    for (int j_b = 0; j_b < n; j_b++) {
+      for (int j_c = std::abs(j_a - j_b); j_c <= std::min(j_a + j_b, n - 1);
+           j_c++) {
+        for (int m_a = -j_a; m_a <= j_a; m_a += 2) {
+          for (int m_b = -j_b; m_b <= j_b; m_b += 2) {
+            table[table_index(n, j_a, j_b, j_c, m_a, m_b)] =
+                coefficient(j_a, j_b, j_c, m_a, m_b, m_a + m_b);
+          }
+        }
+      }
+    }
   }
+  dense_table = std::move(table);
+  n_table_isospins = n;
 }
 
 }  // namespace smash
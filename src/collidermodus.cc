@@ -26,6 +26,7 @@
 #include "smash/icparameters.h"
 #include "smash/input_keys.h"
 #include "smash/logging.h"
+#include "smash/nuclearconfigurations.h"
 #include "smash/nucleus.h"
 #include "smash/random.h"
 
@@ -87,6 +88,20 @@ ColliderModus::ColliderModus(Configuration modus_config,
   }
   target_->set_label(BelongsTo::Target);
 
+  const bool tabulated_positions =
+      modus_cfg.take(InputKeys::modi_collider_tabulatedNucleonPositions);
+  projectile_->set_tabulated_positions(tabulated_positions);
+  target_->set_tabulated_positions(tabulated_positions);
+
+  const int pregenerated_configurations =
+      modus_cfg.take(InputKeys::modi_collider_pregeneratedConfigurations);
+  if (pregenerated_configurations < 0) {
+    throw std::invalid_argument(
+        "Input Error: The number of pre-generated configurations of the nuclei "
+        "must not be negative.");
+  }
+  pregenerated_configurations_ = pregenerated_configurations;
+
   // Get the Fermi-Motion input (off, on, frozen)
   fermi_motion_ = modus_cfg.take(InputKeys::modi_collider_fermiMotion);
   if (fermi_motion_ == FermiMotion::On) {
@@ -511,11 +526,6 @@ ColliderModus::create_alphaclustered_nucleus(Configuration &nucleus_cfg,
 
 double ColliderModus::initial_conditions(Particles *particles,
                                          const ExperimentParameters &) {
-  // Populate the nuclei with appropriately distributed nucleons.
-  // If deformed, this includes rotating the nucleus.
-  projectile_->arrange_nucleons();
-  target_->arrange_nucleons();
-
   // Use the total mandelstam variable to get the frame-dependent velocity for
   // each nucleus. Position a is projectile, position b is target.
   double v_a, v_b;
@@ -537,21 +547,39 @@ double ColliderModus::initial_conditions(Particles *particles,
     velocity_target_ = v_b;
   }
 
-  // Generate Fermi momenta if necessary
-  if (fermi_motion_ == FermiMotion::On ||
-      fermi_motion_ == FermiMotion::Frozen) {
-    // Frozen: Fermi momenta will be ignored during the propagation to
-    // avoid that the nuclei will fly apart.
-    projectile_->generate_fermi_momenta();
-    target_->generate_fermi_momenta();
-  } else if (fermi_motion_ == FermiMotion::Off) {
-  } else {
+  if (fermi_motion_ != FermiMotion::On &&
+      fermi_motion_ != FermiMotion::Frozen &&
+      fermi_motion_ != FermiMotion::Off) {
     throw std::invalid_argument("Invalid Fermi_Motion input.");
   }
+  /* Frozen: Fermi momenta will be ignored during the propagation to avoid that
+   * the nuclei will fly apart. */
+  const bool fermi_momenta = fermi_motion_ != FermiMotion::Off;
 
-  // Boost the nuclei to the appropriate velocity.
-  projectile_->boost(v_a);
-  target_->boost(v_b);
+  if (pregenerated_configurations_ > 0) {
+    // The nuclei belong to the background thread from now on.
+    if (!configurations_) {
+      configurations_ = std::make_unique<NuclearConfigurations>(
+          *projectile_, *target_, fermi_momenta, v_a, v_b,
+          pregenerated_configurations_, random::advance());
+    }
+    configurations_->take(projectile_nucleons_, target_nucleons_);
+  } else {
+    // Populate the nuclei with appropriately distributed nucleons.
+    // If deformed, this includes rotating the nucleus.
+    projectile_->arrange_nucleons();
+    target_->arrange_nucleons();
+
+    // Generate Fermi momenta if necessary
+    if (fermi_momenta) {
+      projectile_->generate_fermi_momenta();
+      target_->generate_fermi_momenta();
+    }
+
+    // Boost the nuclei to the appropriate velocity.
+    projectile_->boost(v_a);
+    target_->boost(v_b);
+  }
 
   // Shift the nuclei into starting positions. Contracted spheres with
   // nuclear radii should touch exactly at t=0. Modus starts at negative
@@ -570,12 +598,25 @@ double ColliderModus::initial_conditions(Particles *particles,
   const double phi =
       random_reaction_plane_ ? random::uniform(0.0, 2.0 * M_PI) : 0.0;
 
-  projectile_->shift(proj_z, +impact_ / 2.0, simulation_time);
-  target_->shift(targ_z, -impact_ / 2.0, simulation_time);
-
   // Put the particles in the nuclei into code particles.
-  projectile_->copy_particles(particles);
-  target_->copy_particles(particles);
+  if (pregenerated_configurations_ > 0) {
+    Nucleus::shift_nucleons(projectile_nucleons_.begin(),
+                            projectile_nucleons_.end(), proj_z, +impact_ / 2.0,
+                            simulation_time);
+    Nucleus::shift_nucleons(target_nucleons_.begin(), target_nucleons_.end(),
+                            targ_z, -impact_ / 2.0, simulation_time);
+    for (const ParticleData &nucleon : projectile_nucleons_) {
+      particles->insert(nucleon);
+    }
+    for (const ParticleData &nucleon : target_nucleons_) {
+      particles->insert(nucleon);
+    }
+  } else {
+    projectile_->shift(proj_z, +impact_ / 2.0, simulation_time);
+    target_->shift(targ_z, -impact_ / 2.0, simulation_time);
+    projectile_->copy_particles(particles);
+    target_->copy_particles(particles);
+  }
   rotate_reaction_plane(phi, particles);
   return simulation_time;
 }
@@ -0,0 +1,678 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/crosssectioncache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "smash/clebschgordan_lookup.h"
+#include "smash/tabulation.h"
+#include "smash/tabulationfile.h"
+
+namespace smash {
+
+namespace {
+/// Number of intervals between the nodes at which the isospin is checked
+constexpr std::size_t isospin_check_intervals = 16;
+
+/**
+ * \return The squared Clebsch-Gordan coefficient of two types coupling to the
+ *         given total isospin.
+ *
+ * \param[in] type_a The type of the first particle.
+ * \param[in] type_b The type of the second particle.
+ * \param[in] isospin Twice the total isospin.
+ */
+double isospin_weight(const ParticleType &type_a, const ParticleType &type_b,
+                      int isospin) {
+  const double cg = ClebschGordan::coefficient(
+      type_a.isospin(), type_b.isospin(), isospin, type_a.isospin3(),
+      type_b.isospin3(), type_a.isospin3() + type_b.isospin3());
+  return cg * cg;
+}
+
+/**
+ * Solve for the reduced cross sections of two multiplets, from the largest
+ * total isospin down. The pair of members of a total isospin only couples to
+ * the same and larger ones.
+ *
+ * \param[in] basis The pairs of members of the total isospins.
+ * \param[in] max_isospin Twice the largest total isospin.
+ * \param[in] basis_xs The cross sections of the pairs of members [mb].
+ * \param[out] reduced The reduced cross sections [mb].
+ */
+void reduce_isospin(
+    const std::vector<std::pair<const ParticleType *, const ParticleType *>>
+        &basis,
+    int max_isospin, const std::vector<double> &basis_xs,
+    std::vector<double> &reduced) {
+  for (std::size_t k = 0; k < basis.size(); k++) {
+    const auto [type_a, type_b] = basis[k];
+    double xs = basis_xs[k];
+    for (std::size_t l = 0; l < k; l++) {
+      xs -= isospin_weight(*type_a, *type_b, max_isospin - 2 * l) * reduced[l];
+    }
+    reduced[k] = xs / isospin_weight(*type_a, *type_b, max_isospin - 2 * k);
+  }
+}
+}  // unnamed namespace
+
+CrossSectionCache::CrossSectionCache(double tolerance, Evaluator evaluate,
+                                     double sqrts_spacing,
+                                     std::size_t number_of_nodes,
+                                     bool reduce_isospin)
+    : CrossSectionCache(tolerance, std::move(evaluate), nullptr, sqrts_spacing,
+                        number_of_nodes, reduce_isospin) {}
+
+CrossSectionCache::CrossSectionCache(double tolerance, Evaluator evaluate,
+                                     BatchEvaluator evaluate_batch,
+                                     double sqrts_spacing,
+                                     std::size_t number_of_nodes,
+                                     bool reduce_isospin)
+    : tolerance_(tolerance),
+      evaluate_(std::move(evaluate)),
+      evaluate_batch_(std::move(evaluate_batch)),
+      sqrts_spacing_(sqrts_spacing),
+      number_of_nodes_(number_of_nodes),
+      number_of_types_(ParticleType::list_all().size()),
+      reduce_isospin_(reduce_isospin),
+      number_of_multiplets_(IsoParticleType::list_all().size()) {
+  if (tolerance_ < 0.) {
+    throw std::invalid_argument(
+        "The tolerance of the cross section cache must not be negative.");
+  }
+  if (!(sqrts_spacing_ > 0.) || number_of_nodes_ < 2) {
+    throw std::invalid_argument(
+        "The cross section cache needs at least two nodes with a positive "
+        "distance.");
+  }
+  const std::size_t number_of_pairs =
+      number_of_types_ * (number_of_types_ + 1) / 2;
+  slots_ = std::make_unique<std::atomic<const Table *>[]>(number_of_pairs);
+  for (std::size_t i = 0; i < number_of_pairs; i++) {
+    slots_[i].store(nullptr, std::memory_order_relaxed);
+  }
+  if (reduce_isospin_) {
+    const std::size_t number_of_multiplet_pairs =
+        number_of_multiplets_ * (number_of_multiplets_ + 1) / 2;
+    multiplet_slots_ = std::make_unique<std::atomic<const MultipletTable *>[]>(
+        number_of_multiplet_pairs);
+    for (std::size_t i = 0; i < number_of_multiplet_pairs; i++) {
+      multiplet_slots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+}
+
+std::optional<double> CrossSectionCache::upper_bound(
+    const ParticleType &type_a, const ParticleType &type_b,
+    double sqrts) const {
+  const Lookup pair_lookup = lookup(type_a, type_b);
+  const double x = (sqrts - pair_lookup.table->first_sqrts) / sqrts_spacing_;
+  if (!(x >= 0.) || x >= static_cast<double>(number_of_nodes_ - 1)) {
+    return std::nullopt;
+  }
+  const std::size_t i = static_cast<std::size_t>(x);
+  const double xs = std::max(node(pair_lookup, i, type_a, type_b),
+                             node(pair_lookup, i + 1, type_a, type_b));
+  return xs * (1. + tolerance_);
+}
+
+std::optional<double> CrossSectionCache::upper_bound_up_to(
+    const ParticleType &type_a, const ParticleType &type_b,
+    double sqrts) const {
+  const Lookup pair_lookup = lookup(type_a, type_b);
+  const double x = (sqrts - pair_lookup.table->first_sqrts) / sqrts_spacing_;
+  if (!(x >= 0.) || x >= static_cast<double>(number_of_nodes_ - 1)) {
+    return std::nullopt;
+  }
+  const std::size_t last = static_cast<std::size_t>(x) + 1;
+  double xs = 0.;
+  for (std::size_t i = 0; i <= last; i++) {
+    xs = std::max(xs, node(pair_lookup, i, type_a, type_b));
+  }
+  return xs * (1. + tolerance_);
+}
+
+bool CrossSectionCache::is_isospin_reduced(const ParticleType &type_a,
+                                           const ParticleType &type_b) const {
+  return lookup(type_a, type_b).multiplets != nullptr;
+}
+
+CrossSectionCache::Lookup CrossSectionCache::lookup(
+    const ParticleType &type_a, const ParticleType &type_b) const {
+  const MultipletTable *multiplets = multiplet_table(type_a, type_b);
+  if (multiplets && multiplets->isospin_symmetric) {
+    return {&multiplets->reduced, multiplets};
+  }
+  return {&table(type_a, type_b), nullptr};
+}
+
+double CrossSectionCache::node(const Lookup &pair_lookup, std::size_t i,
+                               const ParticleType &type_a,
+                               const ParticleType &type_b) const {
+  return pair_lookup.multiplets
+             ? reduced_node(*pair_lookup.multiplets, i, type_a, type_b)
+             : node(*pair_lookup.table, i, type_a, type_b);
+}
+
+const CrossSectionCache::Table &CrossSectionCache::table(
+    const ParticleType &type_a, const ParticleType &type_b) const {
+  // The types are stored contiguously in the list of all types
+  const ParticleType *first_type = std::addressof(ParticleType::list_all()[0]);
+  std::size_t i_a = std::addressof(type_a) - first_type,
+              i_b = std::addressof(type_b) - first_type;
+  if (i_a > i_b) {
+    std::swap(i_a, i_b);
+  }
+  std::atomic<const Table *> &slot = slots_[i_b * (i_b + 1) / 2 + i_a];
+  const Table *found = slot.load(std::memory_order_acquire);
+  if (found) {
+    return *found;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Another thread may have created the table in the meantime
+  found = slot.load(std::memory_order_relaxed);
+  if (found) {
+    return *found;
+  }
+  auto created = std::make_unique<Table>();
+  created->first_sqrts = type_a.mass() + type_b.mass() + sqrts_spacing_;
+  created->nodes = std::make_unique<std::atomic<double>[]>(number_of_nodes_);
+  for (std::size_t i = 0; i < number_of_nodes_; i++) {
+    created->nodes[i].store(std::numeric_limits<double>::quiet_NaN(),
+                            std::memory_order_relaxed);
+  }
+  tables_.push_back(std::move(created));
+  slot.store(tables_.back().get(), std::memory_order_release);
+  return *tables_.back();
+}
+
+double CrossSectionCache::node(const Table &table, std::size_t i,
+                               const ParticleType &type_a,
+                               const ParticleType &type_b) const {
+  double xs = table.nodes[i].load(std::memory_order_relaxed);
+  if (std::isnan(xs)) {
+    xs = evaluate_pair(type_a, type_b, table.first_sqrts + i * sqrts_spacing_);
+    table.nodes[i].store(xs, std::memory_order_relaxed);
+  }
+  return xs;
+}
+
+const CrossSectionCache::MultipletTable *CrossSectionCache::multiplet_table(
+    const ParticleType &type_a, const ParticleType &type_b) const {
+  if (!reduce_isospin_) {
+    return nullptr;
+  }
+  std::atomic<const MultipletTable *> &slot = multiplet_slot(type_a, type_b);
+  const MultipletTable *found = slot.load(std::memory_order_acquire);
+  if (found) {
+    return found;
+  }
+  // The check evaluates cross sections, which is done without locking
+  std::unique_ptr<MultipletTable> created =
+      create_multiplet_table(*type_a.iso_multiplet(), *type_b.iso_multiplet());
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Another thread may have created the table in the meantime
+  found = slot.load(std::memory_order_relaxed);
+  if (found) {
+    return found;
+  }
+  multiplet_tables_.push_back(std::move(created));
+  slot.store(multiplet_tables_.back().get(), std::memory_order_release);
+  return multiplet_tables_.back().get();
+}
+
+std::atomic<const CrossSectionCache::MultipletTable *> &
+CrossSectionCache::multiplet_slot(const ParticleType &type_a,
+                                  const ParticleType &type_b) const {
+  // The multiplets are stored contiguously in the list of all multiplets
+  const IsoParticleType *first_multiplet = IsoParticleType::list_all().data();
+  std::size_t i_a = type_a.iso_multiplet() - first_multiplet,
+              i_b = type_b.iso_multiplet() - first_multiplet;
+  if (i_a > i_b) {
+    std::swap(i_a, i_b);
+  }
+  return multiplet_slots_[i_b * (i_b + 1) / 2 + i_a];
+}
+
+std::unique_ptr<CrossSectionCache::MultipletTable>
+CrossSectionCache::create_multiplet_table(
+    const IsoParticleType &multiplet_a,
+    const IsoParticleType &multiplet_b) const {
+  auto created = std::make_unique<MultipletTable>();
+  const ParticleTypePtrList states_a = multiplet_a.get_states(),
+                            states_b = multiplet_b.get_states();
+  const int isospin_a = multiplet_a.isospin(),
+            isospin_b = multiplet_b.isospin();
+  created->max_isospin = isospin_a + isospin_b;
+  const double mass_a = states_a[0]->mass(), mass_b = states_b[0]->mass();
+  created->reduced.first_sqrts = mass_a + mass_b + sqrts_spacing_;
+  // The members have to share the threshold and the isospin of the multiplet
+  auto alike = [](const ParticleTypePtrList &states, int isospin,
+                  double mass) {
+    return std::all_of(states.begin(), states.end(),
+                       [&](ParticleTypePtr state) {
+                         return state->mass() == mass &&
+                                state->isospin() == isospin;
+                       });
+  };
+  if (!alike(states_a, isospin_a, mass_a) ||
+      !alike(states_b, isospin_b, mass_b)) {
+    return created;
+  }
+  auto find_member = [](const ParticleTypePtrList &states, int isospin3) {
+    const auto found = std::find_if(
+        states.begin(), states.end(),
+        [&](ParticleTypePtr state) { return state->isospin3() == isospin3; });
+    return found == states.end() ? nullptr : std::addressof(**found);
+  };
+  for (int isospin = created->max_isospin;
+       isospin >= std::abs(isospin_a - isospin_b); isospin -= 2) {
+    // Both members couple to m_a + m_b = I with the larger one maximal
+    const int isospin3_a =
+        isospin_a >= isospin_b ? isospin_a : isospin - isospin_b;
+    const ParticleType *member_a = find_member(states_a, isospin3_a);
+    const ParticleType *member_b = find_member(states_b, isospin - isospin3_a);
+    if (!member_a || !member_b) {
+      return created;
+    }
+    created->basis.emplace_back(member_a, member_b);
+  }
+  const std::size_t n_isospins = created->basis.size();
+  created->reduced.nodes =
+      std::make_unique<std::atomic<double>[]>(number_of_nodes_ * n_isospins);
+  for (std::size_t i = 0; i < number_of_nodes_ * n_isospins; i++) {
+    created->reduced.nodes[i].store(std::numeric_limits<double>::quiet_NaN(),
+                                    std::memory_order_relaxed);
+  }
+  std::vector<double> basis_xs(n_isospins), reduced(n_isospins);
+  const std::size_t last = number_of_nodes_ - 1;
+  for (std::size_t check = 0; check <= isospin_check_intervals; check++) {
+    const std::size_t i = check * last / isospin_check_intervals;
+    const double sqrts = created->reduced.first_sqrts + i * sqrts_spacing_;
+    for (std::size_t k = 0; k < n_isospins; k++) {
+      basis_xs[k] = evaluate_pair(*created->basis[k].first,
+                                  *created->basis[k].second, sqrts);
+    }
+    reduce_isospin(created->basis, created->max_isospin, basis_xs, reduced);
+    for (std::size_t j_a = 0; j_a < states_a.size(); j_a++) {
+      // The pairs within one multiplet are unordered
+      const std::size_t first_b = &multiplet_a == &multiplet_b ? j_a : 0;
+      for (std::size_t j_b = first_b; j_b < states_b.size(); j_b++) {
+        const double direct = evaluate_pair(*states_a[j_a], *states_b[j_b],
+                                            sqrts);
+        double reconstructed = 0.;
+        for (std::size_t k = 0; k < n_isospins; k++) {
+          reconstructed += isospin_weight(*states_a[j_a], *states_b[j_b],
+                                          created->max_isospin - 2 * k) *
+                           reduced[k];
+        }
+        // Allow for the rounding of the reduction, also if both vanish
+        if (!(std::abs(direct - reconstructed) <=
+              1e-9 * std::abs(direct) + 1e-12)) {
+          return created;
+        }
+      }
+    }
+    for (std::size_t k = 0; k < n_isospins; k++) {
+      created->reduced.nodes[i * n_isospins + k].store(
+          reduced[k], std::memory_order_relaxed);
+    }
+  }
+  created->isospin_symmetric = true;
+  return created;
+}
+
+double CrossSectionCache::reduced_node(const MultipletTable &multiplets,
+                                       std::size_t i,
+                                       const ParticleType &type_a,
+                                       const ParticleType &type_b) const {
+  const std::size_t n_isospins = multiplets.basis.size();
+  std::atomic<double> *reduced = &multiplets.reduced.nodes[i * n_isospins];
+  bool evaluated = true;
+  for (std::size_t k = 0; k < n_isospins; k++) {
+    evaluated =
+        evaluated && !std::isnan(reduced[k].load(std::memory_order_relaxed));
+  }
+  if (!evaluated) {
+    const double sqrts = multiplets.reduced.first_sqrts + i * sqrts_spacing_;
+    std::vector<double> basis_xs(n_isospins), values(n_isospins);
+    for (std::size_t k = 0; k < n_isospins; k++) {
+      basis_xs[k] = evaluate_pair(*multiplets.basis[k].first,
+                                  *multiplets.basis[k].second, sqrts);
+    }
+    reduce_isospin(multiplets.basis, multiplets.max_isospin, basis_xs, values);
+    for (std::size_t k = 0; k < n_isospins; k++) {
+      reduced[k].store(values[k], std::memory_order_relaxed);
+    }
+  }
+  double xs = 0.;
+  for (std::size_t k = 0; k < n_isospins; k++) {
+    xs += isospin_weight(type_a, type_b, multiplets.max_isospin - 2 * k) *
+          reduced[k].load(std::memory_order_relaxed);
+  }
+  return xs;
+}
+
+double CrossSectionCache::evaluate_pair(const ParticleType &type_a,
+                                        const ParticleType &type_b,
+                                        double sqrts) const {
+  // Evaluate the pair in a fixed order, whichever order it was asked for
+  return &type_b < &type_a ? evaluate_(type_b, type_a, sqrts)
+                           : evaluate_(type_a, type_b, sqrts);
+}
+
+void CrossSectionCache::tabulate(const ParticleTypePtrList &types,
+                                 ThreadPool *pool) {
+  using TypePair = std::pair<const ParticleType *, const ParticleType *>;
+  // The pairs of types, grouped by their multiplets if the isospin is reduced
+  std::vector<std::vector<TypePair>> groups;
+  std::map<std::pair<const IsoParticleType *, const IsoParticleType *>,
+           std::size_t>
+      group_of_multiplets;
+  for (std::size_t i = 0; i < types.size(); i++) {
+    for (std::size_t j = i; j < types.size(); j++) {
+      const TypePair pair{std::addressof(*types[i]),
+                          std::addressof(*types[j])};
+      if (!reduce_isospin_) {
+        groups.push_back({pair});
+        continue;
+      }
+      const auto [found, inserted] = group_of_multiplets.emplace(
+          std::minmax(pair.first->iso_multiplet(),
+                      pair.second->iso_multiplet()),
+          groups.size());
+      if (inserted) {
+        groups.emplace_back();
+      }
+      groups[found->second].push_back(pair);
+    }
+  }
+  // The cross sections of a pair at the given nodes, in the order of node()
+  auto evaluate_nodes = [&](const ParticleType &type_a,
+                            const ParticleType &type_b,
+                            const std::vector<double> &sqrts,
+                            std::vector<double> &xs) {
+    if (&type_b < &type_a) {
+      evaluate_batch_(type_b, type_a, sqrts, xs);
+    } else {
+      evaluate_batch_(type_a, type_b, sqrts, xs);
+    }
+  };
+  auto tabulate_pair = [&](const ParticleType &type_a,
+                           const ParticleType &type_b) {
+    const Table &pair_table = table(type_a, type_b);
+    if (!evaluate_batch_) {
+      for (std::size_t i = 0; i < number_of_nodes_; i++) {
+        node(pair_table, i, type_a, type_b);
+      }
+      return;
+    }
+    std::vector<std::size_t> missing;
+    std::vector<double> sqrts;
+    for (std::size_t i = 0; i < number_of_nodes_; i++) {
+      if (std::isnan(pair_table.nodes[i].load(std::memory_order_relaxed))) {
+        missing.push_back(i);
+        sqrts.push_back(pair_table.first_sqrts + i * sqrts_spacing_);
+      }
+    }
+    if (missing.empty()) {
+      return;
+    }
+    std::vector<double> xs(sqrts.size());
+    evaluate_nodes(type_a, type_b, sqrts, xs);
+    for (std::size_t k = 0; k < missing.size(); k++) {
+      pair_table.nodes[missing[k]].store(xs[k], std::memory_order_relaxed);
+    }
+  };
+  // Only the pairs of members the reduced cross sections are obtained from
+  auto tabulate_multiplets = [&](const MultipletTable &multiplets) {
+    const auto [type_a, type_b] = multiplets.basis[0];
+    if (!evaluate_batch_) {
+      for (std::size_t i = 0; i < number_of_nodes_; i++) {
+        reduced_node(multiplets, i, *type_a, *type_b);
+      }
+      return;
+    }
+    const std::size_t n_isospins = multiplets.basis.size();
+    std::vector<std::size_t> missing;
+    std::vector<double> sqrts;
+    for (std::size_t i = 0; i < number_of_nodes_; i++) {
+      for (std::size_t k = 0; k < n_isospins; k++) {
+        if (std::isnan(multiplets.reduced.nodes[i * n_isospins + k].load(
+                std::memory_order_relaxed))) {
+          missing.push_back(i);
+          sqrts.push_back(multiplets.reduced.first_sqrts +
+                          i * sqrts_spacing_);
+          break;
+        }
+      }
+    }
+    if (missing.empty()) {
+      return;
+    }
+    std::vector<std::vector<double>> basis_xs(
+        n_isospins, std::vector<double>(sqrts.size()));
+    for (std::size_t k = 0; k < n_isospins; k++) {
+      evaluate_nodes(*multiplets.basis[k].first, *multiplets.basis[k].second,
+                     sqrts, basis_xs[k]);
+    }
+    std::vector<double> node_xs(n_isospins), reduced(n_isospins);
+    for (std::size_t m = 0; m < missing.size(); m++) {
+      for (std::size_t k = 0; k < n_isospins; k++) {
+        node_xs[k] = basis_xs[k][m];
+      }
+      reduce_isospin(multiplets.basis, multiplets.max_isospin, node_xs,
+                     reduced);
+      for (std::size_t k = 0; k < n_isospins; k++) {
+        multiplets.reduced.nodes[missing[m] * n_isospins + k].store(
+            reduced[k], std::memory_order_relaxed);
+      }
+    }
+  };
+  auto tabulate_group = [&](std::size_t g) {
+    const auto [type_a, type_b] = groups[g][0];
+    const MultipletTable *multiplets = multiplet_table(*type_a, *type_b);
+    if (multiplets && multiplets->isospin_symmetric) {
+      tabulate_multiplets(*multiplets);
+      return;
+    }
+    for (const auto &[member_a, member_b] : groups[g]) {
+      tabulate_pair(*member_a, *member_b);
+    }
+  };
+  if (pool) {
+    pool->parallel_for(groups.size(), tabulate_group);
+  } else {
+    for (std::size_t g = 0; g < groups.size(); g++) {
+      tabulate_group(g);
+    }
+  }
+}
+
+std::size_t CrossSectionCache::write(const std::filesystem::path &path) const {
+  const auto &types = ParticleType::list_all();
+  std::vector<Tabulation> tabulations;
+  std::vector<std::string> names;
+  for (std::size_t i_b = 0; i_b < number_of_types_; i_b++) {
+    for (std::size_t i_a = 0; i_a <= i_b; i_a++) {
+      const ParticleType &type_a = types[i_a], &type_b = types[i_b];
+      const Table *pair_table =
+          slots_[i_b * (i_b + 1) / 2 + i_a].load(std::memory_order_acquire);
+      const MultipletTable *multiplets =
+          reduce_isospin_ ? multiplet_slot(type_a, type_b).load(
+                                std::memory_order_acquire)
+                          : nullptr;
+      if (multiplets && multiplets->isospin_symmetric) {
+        pair_table = &multiplets->reduced;
+      } else {
+        multiplets = nullptr;
+      }
+      if (!pair_table) {
+        continue;
+      }
+      auto values = std::make_shared<std::vector<double>>(number_of_nodes_);
+      for (std::size_t i = 0; i < number_of_nodes_; i++) {
+        if (!multiplets) {
+          (*values)[i] = pair_table->nodes[i].load(std::memory_order_relaxed);
+          continue;
+        }
+        // Reconstructed without evaluating missing nodes, which stay NaN
+        const std::size_t n_isospins = multiplets->basis.size();
+        double xs = 0.;
+        for (std::size_t k = 0; k < n_isospins; k++) {
+          xs += isospin_weight(type_a, type_b,
+                               multiplets->max_isospin - 2 * k) *
+                pair_table->nodes[i * n_isospins + k].load(
+                    std::memory_order_relaxed);
+        }
+        (*values)[i] = xs;
+      }
+      // Only complete tables are written
+      if (std::any_of(values->begin(), values->end(),
+                      [](double xs) { return std::isnan(xs); })) {
+        continue;
+      }
+      const double *first_value = values->data();
+      tabulations.emplace_back(
+          std::move(values), first_value, number_of_nodes_,
+          pair_table->first_sqrts,
+          pair_table->first_sqrts + (number_of_nodes_ - 1) * sqrts_spacing_,
+          1. / sqrts_spacing_);
+      names.push_back(table_name(type_a, type_b));
+    }
+  }
+  std::vector<std::pair<std::string, const Tabulation *>> named;
+  for (std::size_t k = 0; k < tabulations.size(); k++) {
+    named.emplace_back(names[k], &tabulations[k]);
+  }
+  TabulationFile::write(path, types_hash(), named);
+  return tabulations.size();
+}
+
+std::size_t CrossSectionCache::read(const std::filesystem::path &path) {
+  const auto file = TabulationFile::open(path, types_hash());
+  if (!file) {
+    throw std::runtime_error("The cross section table " + path.string() +
+                             " cannot be read or was written for other "
+                             "particle types.");
+  }
+  const auto &types = ParticleType::list_all();
+  // The tables read of the pairs of members the reduced tables are obtained
+  // from
+  std::map<std::pair<const ParticleType *, const ParticleType *>,
+           std::vector<double>>
+      basis_values;
+  std::size_t n_read = 0;
+  for (std::size_t i_b = 0; i_b < number_of_types_; i_b++) {
+    for (std::size_t i_a = 0; i_a <= i_b; i_a++) {
+      const ParticleType &type_a = types[i_a], &type_b = types[i_b];
+      const Tabulation stored = file->find(table_name(type_a, type_b));
+      if (stored.is_empty()) {
+        continue;
+      }
+      const Lookup pair_lookup = lookup(type_a, type_b);
+      const double first_sqrts = pair_lookup.table->first_sqrts;
+      if (stored.size() != number_of_nodes_ ||
+          std::abs(stored.inv_dx() * sqrts_spacing_ - 1.) > 1e-12 ||
+          std::abs(stored.x_min() - first_sqrts) > 1e-9 * sqrts_spacing_) {
+        throw std::runtime_error("The cross section table " + path.string() +
+                                 " was written for other nodes.");
+      }
+      std::vector<double> values(number_of_nodes_);
+      for (std::size_t i = 0; i < number_of_nodes_; i++) {
+        values[i] = stored.get_value_step(first_sqrts + i * sqrts_spacing_);
+      }
+      const std::size_t last = number_of_nodes_ - 1;
+      for (const std::size_t i : {std::size_t{0}, last / 4, last / 2,
+                                  3 * last / 4, last}) {
+        const double sqrts = first_sqrts + i * sqrts_spacing_;
+        const double direct = evaluate_(type_a, type_b, sqrts);
+        const double tabulated = values[i];
+        if (!(std::abs(direct - tabulated) <= 1e-9 * std::abs(direct))) {
+          throw std::runtime_error(
+              "The cross section table " + path.string() + " does not match " +
+              type_a.name() + " + " + type_b.name() + " at sqrt(s) = " +
+              std::to_string(sqrts) + " GeV, it was written with other "
+              "decay modes or settings of the collision term.");
+        }
+      }
+      if (pair_lookup.multiplets) {
+        basis_values.emplace(
+            std::make_pair(std::addressof(type_a), std::addressof(type_b)),
+            std::move(values));
+      } else {
+        for (std::size_t i = 0; i < number_of_nodes_; i++) {
+          pair_lookup.table->nodes[i].store(values[i],
+                                            std::memory_order_relaxed);
+        }
+      }
+      n_read++;
+    }
+  }
+  for (const std::unique_ptr<MultipletTable> &multiplets :
+       multiplet_tables_) {
+    if (!multiplets->isospin_symmetric) {
+      continue;
+    }
+    const std::size_t n_isospins = multiplets->basis.size();
+    std::vector<const std::vector<double> *> basis_tables;
+    for (const auto &[member_a, member_b] : multiplets->basis) {
+      const auto found = basis_values.find(std::minmax(member_a, member_b));
+      if (found == basis_values.end()) {
+        break;
+      }
+      basis_tables.push_back(&found->second);
+    }
+    if (basis_tables.size() < n_isospins) {
+      continue;
+    }
+    std::vector<double> node_xs(n_isospins), reduced(n_isospins);
+    for (std::size_t i = 0; i < number_of_nodes_; i++) {
+      for (std::size_t k = 0; k < n_isospins; k++) {
+        node_xs[k] = (*basis_tables[k])[i];
+      }
+      reduce_isospin(multiplets->basis, multiplets->max_isospin, node_xs,
+                     reduced);
+      for (std::size_t k = 0; k < n_isospins; k++) {
+        multiplets->reduced.nodes[i * n_isospins + k].store(
+            reduced[k], std::memory_order_relaxed);
+      }
+    }
+  }
+  return n_read;
+}
+
+sha256::Hash CrossSectionCache::types_hash() {
+  sha256::Context context;
+  context.update("cross section tables 1\n");
+  for (const ParticleType &type : ParticleType::list_all()) {
+    // The masses and widths are written exactly
+    char properties[64];
+    std::snprintf(properties, sizeof(properties), " %a %a\n", type.mass(),
+                  type.width_at_pole());
+    context.update(type.pdgcode().string() + properties);
+  }
+  return context.finalize();
+}
+
+std::string CrossSectionCache::table_name(const ParticleType &type_a,
+                                          const ParticleType &type_b) {
+  return type_a.pdgcode().string() + " " + type_b.pdgcode().string();
+}
+
+}  // namespace smash
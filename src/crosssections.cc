@@ -114,28 +114,90 @@ static double effective_AQM_s(double mandelstam_s, double m1, double m2,
   return eff_sqrt_s * eff_sqrt_s;
 }
 
+std::vector<InteractionProfile> CrossSections::interaction_profiles_;
+
 CrossSections::CrossSections(const ParticleList& incoming_particles,
                              const double sqrt_s,
                              const std::pair<FourVector, FourVector> potentials)
     : incoming_particles_(incoming_particles),
       sqrt_s_(sqrt_s),
       potentials_(potentials),
-      is_BBbar_pair_(incoming_particles_[0].type().is_baryon() &&
-                     incoming_particles_[1].type().is_baryon() &&
-                     incoming_particles_[0].type().antiparticle_sign() ==
-                         -incoming_particles_[1].type().antiparticle_sign()),
-      is_NNbar_pair_(
-          incoming_particles_[0].type().is_nucleon() &&
-          incoming_particles_[1].pdgcode() ==
-              incoming_particles_[0].type().get_antiparticle()->pdgcode()) {}
+      profile_(interaction_profile(incoming_particles_[0].type(),
+                                   incoming_particles_[1].type())) {}
+
+InteractionProfile CrossSections::compute_interaction_profile(
+    const ParticleType& type_a, const ParticleType& type_b) {
+  const PdgCode pdg_a = type_a.pdgcode(), pdg_b = type_b.pdgcode();
+  const bool same_sign =
+      type_a.antiparticle_sign() == type_b.antiparticle_sign();
+  InteractionProfile profile;
+  profile.is_NN = type_a.is_nucleon() && type_b.is_nucleon() && same_sign;
+  profile.is_NNbar_any =
+      type_a.is_nucleon() && type_b.is_nucleon() && !same_sign;
+  profile.is_BBbar = type_a.is_baryon() && type_b.is_baryon() &&
+                     type_a.antiparticle_sign() == -type_b.antiparticle_sign();
+  profile.is_NNbar = type_a.is_nucleon() && pdg_b == pdg_a.get_antiparticle();
+  profile.is_Npi = (pdg_a.is_pion() && type_b.is_nucleon()) ||
+                   (type_a.is_nucleon() && pdg_b.is_pion());
+  profile.is_pipi = pdg_a.is_pion() && pdg_b.is_pion();
+  profile.is_KplusP =
+      ((pdg_a == pdg::K_p || pdg_a == pdg::K_z) && (pdg_b == pdg::p)) ||
+      ((pdg_b == pdg::K_p || pdg_b == pdg::K_z) && (pdg_a == pdg::p)) ||
+      ((pdg_a == -pdg::K_p || pdg_a == -pdg::K_z) && (pdg_b == -pdg::p)) ||
+      ((pdg_b == -pdg::K_p || pdg_b == -pdg::K_z) && (pdg_a == -pdg::p));
+  profile.is_AQM = (type_a.is_baryon() && type_b.is_baryon() && same_sign) ||
+                   (type_a.is_baryon() && type_b.is_meson()) ||
+                   (type_b.is_baryon() && type_a.is_meson()) ||
+                   (type_a.is_meson() && type_b.is_meson());
+  profile.has_deuteron_2to3 =
+      (type_a.is_deuteron() && (pdg_b.is_pion() || type_b.is_nucleon())) ||
+      (type_b.is_deuteron() && (pdg_a.is_pion() || type_a.is_nucleon()));
+  const auto is_A3_nucleus = [](const ParticleType& type) {
+    return type.is_nucleus() && std::abs(type.baryon_number()) == 3;
+  };
+  const auto is_catalyzer = [](const ParticleType& type) {
+    return type.is_pion() || type.is_nucleon();
+  };
+  /* The nucleus is the first type, unless only the second one is a nucleus,
+   * see two_to_four. */
+  profile.has_A3_nucleus_2to4 =
+      type_a.is_nucleus() ? is_A3_nucleus(type_a) && is_catalyzer(type_b)
+                          : is_A3_nucleus(type_b) && is_catalyzer(type_a);
+  profile.pole_mass_sum = type_a.mass() + type_b.mass();
+  return profile;
+}
+
+void CrossSections::create_interaction_profiles() {
+  const ParticleTypeList& types = ParticleType::list_all();
+  interaction_profiles_.clear();
+  interaction_profiles_.reserve(types.size() * types.size());
+  for (const ParticleType& type_a : types) {
+    for (const ParticleType& type_b : types) {
+      interaction_profiles_.push_back(
+          compute_interaction_profile(type_a, type_b));
+    }
+  }
+}
+
+InteractionProfile CrossSections::interaction_profile(
+    const ParticleType& type_a, const ParticleType& type_b) {
+  const ParticleTypeList& types = ParticleType::list_all();
+  const auto index_a = static_cast<std::size_t>(std::addressof(type_a) -
+                                                std::addressof(types[0]));
+  const auto index_b = static_cast<std::size_t>(std::addressof(type_b) -
+                                                std::addressof(types[0]));
+  const std::size_t n_types = types.size();
+  if (interaction_profiles_.size() != n_types * n_types ||
+      index_a >= n_types || index_b >= n_types) {
+    return compute_interaction_profile(type_a, type_b);
+  }
+  return interaction_profiles_[index_a * n_types + index_b];
+}
 
 CollisionBranchList CrossSections::generate_collision_list(
     const ScatterActionsFinderParameters& finder_parameters,
     StringProcess* string_process) const {
   CollisionBranchList process_list;
-  const ParticleType& t1 = incoming_particles_[0].type();
-  const ParticleType& t2 = incoming_particles_[1].type();
-
   double p_pythia = 0.;
   if (finder_parameters.strings_with_probability) {
     p_pythia = string_probability(finder_parameters);
@@ -144,9 +206,7 @@ CollisionBranchList CrossSections::generate_collision_list(
   /* Elastic collisions between two nucleons with sqrt_s below
    * low_snn_cut can not happen. */
   const bool reject_by_nucleon_elastic_cutoff =
-      t1.is_nucleon() && t2.is_nucleon() &&
-      t1.antiparticle_sign() == t2.antiparticle_sign() &&
-      sqrt_s_ < finder_parameters.low_snn_cut;
+      profile_.is_NN && sqrt_s_ < finder_parameters.low_snn_cut;
   bool incl_elastic =
       finder_parameters.included_2to2[IncludedReactions::Elastic];
   if (incl_elastic && !reject_by_nucleon_elastic_cutoff) {
@@ -185,22 +245,24 @@ CollisionBranchList CrossSections::generate_collision_list(
           (1. - p_pythia) * finder_parameters.scale_xs);
     }
     if (finder_parameters
-            .included_multi[IncludedMultiParticleReactions::Deuteron_3to2] ==
-        1) {
+                .included_multi[IncludedMultiParticleReactions::Deuteron_3to2] ==
+            1 &&
+        profile_.has_deuteron_2to3) {
       // 2->3 (deuterons only 2-to-3 reaction at the moment)
       append_list(process_list, two_to_three(),
                   (1. - p_pythia) * finder_parameters.scale_xs);
     }
     if (finder_parameters
-            .included_multi[IncludedMultiParticleReactions::A3_Nuclei_4to2] ==
-        1) {
+                .included_multi[IncludedMultiParticleReactions::A3_Nuclei_4to2] ==
+            1 &&
+        profile_.has_A3_nucleus_2to4) {
       // 2->4
       append_list(process_list, two_to_four(),
                   (1. - p_pythia) * finder_parameters.scale_xs);
     }
   }
   if (finder_parameters.nnbar_treatment == NNbarTreatment::TwoToFive &&
-      is_NNbar_pair_) {
+      profile_.is_NNbar) {
     // NNbar directly to 5 pions (2-to-5)
     process_list.emplace_back(NNbar_to_5pi(finder_parameters.scale_xs));
   }
@@ -209,7 +271,7 @@ CollisionBranchList CrossSections::generate_collision_list(
    * ρ → ππ and h₁(1170) → πρ, this gives a final state of 5 pions.
    * Only use in cases when detailed balance MUST happen, i.e. in a box! */
   if (finder_parameters.nnbar_treatment == NNbarTreatment::Resonances) {
-    if (is_NNbar_pair_) {
+    if (profile_.is_NNbar) {
       /* Has to be called after the other processes are already determined,
        * so that the sum of the cross sections includes all other processes. */
       process_list.emplace_back(NNbar_annihilation(sum_xs_of(process_list),
@@ -221,23 +283,49 @@ CollisionBranchList CrossSections::generate_collision_list(
   return process_list;
 }
 
-double CrossSections::parametrized_total(
-    const ScatterActionsFinderParameters& finder_parameters) const {
-  const PdgCode& pdg_a = incoming_particles_[0].type().pdgcode();
-  const PdgCode& pdg_b = incoming_particles_[1].type().pdgcode();
-  double total_xs = 0.;
-  if (pdg_a.is_baryon() && pdg_b.is_baryon() &&
-      sqrt_s_ > finder_parameters.low_snn_cut) {
+/**
+ * Helper function:
+ * Select the parametrization of the total cross section of a pair of
+ * incoming types, see CrossSections::parametrized_total. The branching on the
+ * types is done once, such that the parametrization can be evaluated at many
+ * energies in a loop without branches.
+ *
+ * \param[in] pdg_a PDG code of the first incoming type.
+ * \param[in] pdg_b PDG code of the second incoming type.
+ * \param[in] finder_parameters Parameters for collision finding.
+ * \param[in] use Callable, which is called with the parametrization, i.e. a
+ *            callable returning the total cross section for a given
+ *            \f$\sqrt{s}\f$, before the additional elastic cross section and
+ *            the scaling are applied.
+ * \return What \p use returns.
+ */
+template <typename F>
+static auto with_total_parametrization(
+    const PdgCode& pdg_a, const PdgCode& pdg_b,
+    const ScatterActionsFinderParameters& finder_parameters, F&& use) {
+  const double aqm_a = finder_parameters.AQM_scaling_factor(pdg_a);
+  const double aqm_b = finder_parameters.AQM_scaling_factor(pdg_b);
+  if (pdg_a.is_baryon() && pdg_b.is_baryon()) {
+    // Below the cut, no parametrization applies
+    const double low_snn_cut = finder_parameters.low_snn_cut;
     if (pdg_a.antiparticle_sign() == pdg_b.antiparticle_sign()) {
       // NN
-      total_xs = (pdg_a == pdg_b) ? pp_total(sqrt_s_ * sqrt_s_)
-                                  : np_total(sqrt_s_ * sqrt_s_);
-    } else {
-      // NNbar
-      total_xs = ppbar_total(sqrt_s_ * sqrt_s_);
-    }
-    total_xs *= finder_parameters.AQM_scaling_factor(pdg_a) *
-                finder_parameters.AQM_scaling_factor(pdg_b);
+      if (pdg_a == pdg_b) {
+        return use([=](double sqrts) {
+          return sqrts > low_snn_cut ? pp_total(sqrts * sqrts) * (aqm_a * aqm_b)
+                                     : 0.;
+        });
+      }
+      return use([=](double sqrts) {
+        return sqrts > low_snn_cut ? np_total(sqrts * sqrts) * (aqm_a * aqm_b)
+                                   : 0.;
+      });
+    }
+    // NNbar
+    return use([=](double sqrts) {
+      return sqrts > low_snn_cut ? ppbar_total(sqrts * sqrts) * (aqm_a * aqm_b)
+                                 : 0.;
+    });
   } else if ((pdg_a.is_baryon() && pdg_b.is_meson()) ||
              (pdg_a.is_meson() && pdg_b.is_baryon())) {
     const PdgCode& meson = pdg_a.is_meson() ? pdg_a : pdg_b;
@@ -248,25 +336,25 @@ double CrossSections::parametrized_total(
           (meson.code() == pdg::K_m && baryon.code() == -pdg::p) ||
           (meson.code() == pdg::Kbar_z && baryon.code() == -pdg::n)) {
         // K⁺p, K⁰n, and anti-processes
-        total_xs = kplusp_total(sqrt_s_ * sqrt_s_);
+        return use([](double sqrts) { return kplusp_total(sqrts * sqrts); });
       } else if ((meson.code() == pdg::K_p && baryon.code() == -pdg::p) ||
                  (meson.code() == pdg::K_z && baryon.code() == -pdg::n) ||
                  (meson.code() == pdg::K_m && baryon.code() == pdg::p) ||
                  (meson.code() == pdg::Kbar_z && baryon.code() == pdg::n)) {
         // K⁻p, K̅⁰n, and anti-processes
-        total_xs = kminusp_total(sqrt_s_ * sqrt_s_);
+        return use([](double sqrts) { return kminusp_total(sqrts * sqrts); });
       } else if ((meson.code() == pdg::K_p && baryon.code() == pdg::n) ||
                  (meson.code() == pdg::K_z && baryon.code() == pdg::p) ||
                  (meson.code() == pdg::K_m && baryon.code() == -pdg::n) ||
                  (meson.code() == pdg::Kbar_z && baryon.code() == -pdg::p)) {
         // K⁺n, K⁰p, and anti-processes
-        total_xs = kplusn_total(sqrt_s_ * sqrt_s_);
+        return use([](double sqrts) { return kplusn_total(sqrts * sqrts); });
       } else if ((meson.code() == pdg::K_p && baryon.code() == -pdg::n) ||
                  (meson.code() == pdg::K_z && baryon.code() == -pdg::p) ||
                  (meson.code() == pdg::K_m && baryon.code() == pdg::n) ||
                  (meson.code() == pdg::Kbar_z && baryon.code() == pdg::p)) {
         // K⁻n, K̅⁰p and anti-processes
-        total_xs = kminusn_total(sqrt_s_ * sqrt_s_);
+        return use([](double sqrts) { return kminusn_total(sqrts * sqrts); });
       }
     } else if (meson.is_pion() && baryon.is_nucleon()) {
       // π⁺(p,nbar), π⁻(n,pbar)
@@ -274,56 +362,110 @@ double CrossSections::parametrized_total(
            (baryon.code() == pdg::p || baryon.code() == -pdg::n)) ||
           (meson.code() == pdg::pi_m &&
            (baryon.code() == pdg::n || baryon.code() == -pdg::p))) {
-        total_xs = piplusp_total(sqrt_s_);
+        return use([](double sqrts) { return piplusp_total(sqrts); });
       } else if (meson.code() == pdg::pi_z) {
         // π⁰N
-        total_xs = 0.5 * (piplusp_total(sqrt_s_) + piminusp_total(sqrt_s_));
+        return use([](double sqrts) {
+          return 0.5 * (piplusp_total(sqrts) + piminusp_total(sqrts));
+        });
       } else {
         // π⁻(p,nbar), π⁺(n,pbar)
-        total_xs = piminusp_total(sqrt_s_);
+        return use([](double sqrts) { return piminusp_total(sqrts); });
       }
     } else {
       // M*+B* goes to AQM high energy π⁻p
-      total_xs = piminusp_high_energy(sqrt_s_ * sqrt_s_) *
-                 finder_parameters.AQM_scaling_factor(pdg_a) *
-                 finder_parameters.AQM_scaling_factor(pdg_b);
+      return use([=](double sqrts) {
+        return piminusp_high_energy(sqrts * sqrts) * aqm_a * aqm_b;
+      });
     }
   } else if (pdg_a.is_meson() && pdg_b.is_meson()) {
     if (pdg_a.is_pion() && pdg_b.is_pion()) {
       switch (pdg_a.isospin3() * pdg_b.isospin3() / 4) {
         // π⁺π⁻
         case -1:
-          total_xs = pipluspiminus_total(sqrt_s_);
-          break;
+          return use([](double sqrts) { return pipluspiminus_total(sqrts); });
         case 0:
           // π⁰π⁰
           if (pdg_a.isospin3() + pdg_b.isospin3() == 0) {
-            total_xs = pizeropizero_total(sqrt_s_);
+            return use([](double sqrts) { return pizeropizero_total(sqrts); });
           } else {
             // π⁺π⁰: similar to π⁺π⁻
-            total_xs = pipluspiminus_total(sqrt_s_);
+            return use(
+                [](double sqrts) { return pipluspiminus_total(sqrts); });
           }
-          break;
         // π⁺π⁺ goes to π⁻p AQM
         case 1:
-          total_xs = (2. / 3.) * piminusp_high_energy(sqrt_s_ * sqrt_s_);
-          break;
+          return use([](double sqrts) {
+            return (2. / 3.) * piminusp_high_energy(sqrts * sqrts);
+          });
         default:
           throw std::runtime_error("wrong isospin in ππ scattering");
       }
     } else {
       // M*+M* goes to AQM high energy π⁻p
-      total_xs = (2. / 3.) * piminusp_high_energy(sqrt_s_ * sqrt_s_) *
-                 finder_parameters.AQM_scaling_factor(pdg_a) *
-                 finder_parameters.AQM_scaling_factor(pdg_b);
+      return use([=](double sqrts) {
+        return (2. / 3.) * piminusp_high_energy(sqrts * sqrts) * aqm_a * aqm_b;
+      });
     }
   }
+  return use([](double) { return 0.; });
+}
+
+double CrossSections::parametrized_total(
+    const ScatterActionsFinderParameters& finder_parameters) const {
+  const double total_xs = with_total_parametrization(
+      incoming_particles_[0].type().pdgcode(),
+      incoming_particles_[1].type().pdgcode(), finder_parameters,
+      [this](auto parametrization) { return parametrization(sqrt_s_); });
   return (total_xs + finder_parameters.additional_el_xs) *
          finder_parameters.scale_xs;
 }
 
+std::vector<double> CrossSections::parametrized_total(
+    const ParticleType& type_a, const ParticleType& type_b,
+    const std::vector<double>& sqrts,
+    const ScatterActionsFinderParameters& finder_parameters) {
+  std::vector<double> total_xs(sqrts.size());
+  const double additional_el_xs = finder_parameters.additional_el_xs;
+  const double scale_xs = finder_parameters.scale_xs;
+  with_total_parametrization(
+      type_a.pdgcode(), type_b.pdgcode(), finder_parameters,
+      [&](auto parametrization) {
+        for (std::size_t i = 0; i < sqrts.size(); i++) {
+          total_xs[i] =
+              (parametrization(sqrts[i]) + additional_el_xs) * scale_xs;
+        }
+      });
+  return total_xs;
+}
+
 CollisionBranchPtr CrossSections::elastic(
     const ScatterActionsFinderParameters& finder_parameters) const {
+  return std::make_unique<CollisionBranch>(
+      incoming_particles_[0].type(), incoming_particles_[1].type(),
+      elastic_cross_section(finder_parameters), ProcessType::Elastic);
+}
+
+std::vector<double> CrossSections::elastic(
+    const ParticleType& type_a, const ParticleType& type_b,
+    const std::vector<double>& sqrts,
+    const ScatterActionsFinderParameters& finder_parameters) {
+  /* The parametrizations only depend on the energy and on the masses of the
+   * incoming particles, which are on the pole. */
+  ParticleData data_a{type_a}, data_b{type_b};
+  data_a.set_4momentum(type_a.mass(), 0., 0., 0.);
+  data_b.set_4momentum(type_b.mass(), 0., 0., 0.);
+  const ParticleList incoming{data_a, data_b};
+  std::vector<double> elastic_xs(sqrts.size());
+  for (std::size_t i = 0; i < sqrts.size(); i++) {
+    const CrossSections xs(incoming, sqrts[i], {});
+    elastic_xs[i] = xs.elastic_cross_section(finder_parameters);
+  }
+  return elastic_xs;
+}
+
+double CrossSections::elastic_cross_section(
+    const ScatterActionsFinderParameters& finder_parameters) const {
   double elastic_xs = 0.;
 
   if (finder_parameters.elastic_parameter >= 0.) {
@@ -336,11 +478,8 @@ CollisionBranchPtr CrossSections::elastic(
   /* when using a factor to scale the cross section and an additional
    * contribution to the elastic cross section, the contribution is added first
    * and then everything is scaled */
-  return std::make_unique<CollisionBranch>(
-      incoming_particles_[0].type(), incoming_particles_[1].type(),
-      (elastic_xs + finder_parameters.additional_el_xs) *
-          finder_parameters.scale_xs,
-      ProcessType::Elastic);
+  return (elastic_xs + finder_parameters.additional_el_xs) *
+         finder_parameters.scale_xs;
 }
 
 CollisionBranchList CrossSections::rare_two_to_two() const {
@@ -429,7 +568,7 @@ double CrossSections::nn_el() const {
   const double s = sqrt_s_ * sqrt_s_;
   const bool is_NN_pair = pdg_a.is_nucleon() && pdg_b.is_nucleon();
   if (is_NN_pair) {
-    if (is_BBbar_pair_) {
+    if (profile_.is_BBbar) {
       // npbar and ppbar
       sig_el = ppbar_elastic(s);
     } else {
@@ -439,7 +578,7 @@ double CrossSections::nn_el() const {
     // AQM - Additive Quark Model
     const double m1 = incoming_particles_[0].effective_mass();
     const double m2 = incoming_particles_[1].effective_mass();
-    if (is_BBbar_pair_) {
+    if (profile_.is_BBbar) {
       sig_el =
           ppbar_elastic(effective_AQM_s(s, m1, m2, nucleon_mass, nucleon_mass));
     } else {
@@ -877,7 +1016,7 @@ CollisionBranchList CrossSections::two_to_one() const {
   const double m2 = incoming_particles_[1].effective_mass();
   const double p_cm_sqr = pCM_sqr(sqrt_s_, m1, m2);
 
-  ParticleTypePtrList possible_resonances =
+  const ParticleTypePtrSpan possible_resonances =
       list_possible_resonances(&type_particle_a, &type_particle_b);
 
   // Find all the possible resonances
@@ -2516,7 +2655,7 @@ CollisionBranchList CrossSections::string_excitation(
   /* Determine if the initial state is a baryon-antibaryon pair,
    * which can annihilate. */
   bool can_annihilate = false;
-  if (is_BBbar_pair_) {
+  if (profile_.is_BBbar) {
     int n_q_types = 5;  // u, d, s, c, b
     for (int iq = 1; iq <= n_q_types; iq++) {
       std::array<int, 2> nquark;
@@ -2560,7 +2699,8 @@ CollisionBranchList CrossSections::string_excitation(
    * The way it is done here is not unique. I (ryu) think that at high energy
    * collision this is not an issue, but at sqrt_s < 10 GeV it may
    * matter. */
-  std::array<double, 3> xs = string_process->cross_sections_diffractive(
+  // The string process may be shared by several threads
+  std::array<double, 3> xs = string_process->shared_cross_sections_diffractive(
       pdgid[0], pdgid[1], std::sqrt(mandelstam_s));
   if (finder_parameters.use_AQM) {
     for (int ip = 0; ip < 3; ip++) {
@@ -3019,58 +3159,38 @@ double CrossSections::string_probability(
     return 0.;
   }
 
-  const ParticleType& t1 = incoming_particles_[0].type();
-  const ParticleType& t2 = incoming_particles_[1].type();
   const bool treat_BBbar_with_strings =
       (finder_parameters.nnbar_treatment == NNbarTreatment::Strings);
-  const bool is_NN_scattering =
-      t1.is_nucleon() && t2.is_nucleon() &&
-      t1.antiparticle_sign() == t2.antiparticle_sign();
+  const bool is_NN_scattering = profile_.is_NN;
   const bool is_BBbar_scattering =
-      (treat_BBbar_with_strings && is_BBbar_pair_ &&
+      (treat_BBbar_with_strings && profile_.is_BBbar &&
        finder_parameters.use_AQM) ||
-      (t1.is_nucleon() && t2.is_nucleon() &&
-       t1.antiparticle_sign() != t2.antiparticle_sign());
-  const bool is_Npi_scattering = (t1.pdgcode().is_pion() && t2.is_nucleon()) ||
-                                 (t1.is_nucleon() && t2.pdgcode().is_pion());
+      profile_.is_NNbar_any;
+  const bool is_Npi_scattering = profile_.is_Npi;
   /* True for baryon-baryon, anti-baryon-anti-baryon, baryon-meson,
    * anti-baryon-meson and meson-meson*/
-  const bool is_AQM_scattering =
-      finder_parameters.use_AQM &&
-      ((t1.is_baryon() && t2.is_baryon() &&
-        t1.antiparticle_sign() == t2.antiparticle_sign()) ||
-       ((t1.is_baryon() && t2.is_meson()) ||
-        (t2.is_baryon() && t1.is_meson())) ||
-       (t1.is_meson() && t2.is_meson()));
-  const double mass_sum =
-      incoming_particles_[0].pole_mass() + incoming_particles_[1].pole_mass();
+  const bool is_AQM_scattering = finder_parameters.use_AQM && profile_.is_AQM;
+  const double mass_sum = profile_.pole_mass_sum;
 
   if (!is_NN_scattering && !is_BBbar_scattering && !is_Npi_scattering &&
       !is_AQM_scattering) {
     return 0.;
-  } else if (is_NNbar_pair_ && !treat_BBbar_with_strings) {
+  } else if (profile_.is_NNbar && !treat_BBbar_with_strings) {
     return 0.;
   } else if (is_BBbar_scattering) {
     // BBbar only goes through strings, so there are no "window" considerations
     return 1.;
   } else {
-    /* true for K+ p and K0 p (+ antiparticles), which have special treatment
-     * to fit data */
-    const PdgCode pdg1 = t1.pdgcode(), pdg2 = t2.pdgcode();
-    const bool is_KplusP =
-        ((pdg1 == pdg::K_p || pdg1 == pdg::K_z) && (pdg2 == pdg::p)) ||
-        ((pdg2 == pdg::K_p || pdg2 == pdg::K_z) && (pdg1 == pdg::p)) ||
-        ((pdg1 == -pdg::K_p || pdg1 == -pdg::K_z) && (pdg2 == -pdg::p)) ||
-        ((pdg2 == -pdg::K_p || pdg2 == -pdg::K_z) && (pdg1 == -pdg::p));
     // where to start the AQM strings above mass sum
     double aqm_offset =
         finder_parameters.transition_high_energy.sqrts_add_lower;
-    if (is_KplusP) {
+    /* K+ p and K0 p (+ antiparticles) have special treatment to fit data */
+    if (profile_.is_KplusP) {
       /* for this specific case we have data. This corresponds to the point
        * where the AQM parametrization is smaller than the current 2to2
        * parametrization, which starts growing and diverges from exp. data */
       aqm_offset = finder_parameters.transition_high_energy.KN_offset;
-    } else if (pdg1.is_pion() && pdg2.is_pion()) {
+    } else if (profile_.is_pipi) {
       aqm_offset = finder_parameters.transition_high_energy.pipi_offset;
     }
     /* if we do not use the probability transition algorithm, this is always a
@@ -0,0 +1,520 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "smash/constants.h"
+#include "smash/crosssectionsphoton.h"
+#include "smash/file.h"
+#include "smash/filelock.h"
+#include "smash/logging.h"
+
+namespace smash {
+static constexpr int LCrossSections = LogArea::CrossSections::id;
+
+namespace {
+
+/// The analytic cross sections, from which the tables are computed
+using Analytic = CrosssectionsPhoton<ComputationMethod::Analytic>;
+
+/// Lowest tabulated \f$\sqrt{s}\f$ [GeV]
+constexpr double sqrts_min = 0.27;
+/// Step of the tabulated \f$\sqrt{s}\f$ [GeV]
+constexpr double sqrts_step = 0.01;
+/// Number of tabulated values of \f$\sqrt{s}\f$, up to 3 GeV
+constexpr std::size_t n_sqrts = 274;
+/// Lowest tabulated rho mass [GeV]
+constexpr double m_rho_min = 0.27;
+/// Step of the tabulated rho mass [GeV]
+constexpr double m_rho_step = 0.025;
+/// Number of tabulated rho masses, up to about 2 GeV
+constexpr std::size_t n_m_rho = 70;
+/// Number of tabulated values of t between its kinematic limits
+constexpr std::size_t n_t = 17;
+/// Deviation from the analytic value, which is always accepted [mb, mb/GeV^2]
+constexpr double absolute_accuracy = 1e-9;
+
+/// Magic number at the start of the stored tables
+constexpr char magic[4] = {'S', 'M', 'P', 'H'};
+/// Version of the layout of the stored tables
+constexpr std::uint32_t format_version = 1;
+
+/**
+ * A photon cross section, total or differential, on a regular grid in
+ * \f$\sqrt{s}\f$, the rho mass and the relative position of t between its
+ * kinematic limits.
+ */
+class PhotonTable {
+ public:
+  /**
+   * \param[in] rho_outgoing Whether the rho meson is outgoing, i.e. the
+   *            incoming particles are two pions, or incoming with a pion.
+   * \param[in] total Analytic total cross section.
+   */
+  PhotonTable(bool rho_outgoing, double (*total)(double, double))
+      : rho_outgoing_(rho_outgoing), n_t_(1), total_(total) {}
+
+  /**
+   * \param[in] rho_outgoing Whether the rho meson is outgoing, i.e. the
+   *            incoming particles are two pions, or incoming with a pion.
+   * \param[in] diff Analytic differential cross section.
+   */
+  PhotonTable(bool rho_outgoing, double (*diff)(double, double, double))
+      : rho_outgoing_(rho_outgoing), n_t_(n_t), diff_(diff) {}
+
+  /**
+   * Tabulate the analytic formula and check the interpolation at the center
+   * of every cell.
+   *
+   * \param[in] accuracy Largest accepted deviation relative to the largest
+   *            value at the corners of the cell.
+   */
+  void compute(double accuracy) {
+    values_.resize(n_sqrts * n_m_rho * n_t_);
+    for (std::size_t i = 0; i < n_sqrts; i++) {
+      for (std::size_t j = 0; j < n_m_rho; j++) {
+        for (std::size_t k = 0; k < n_t_; k++) {
+          values_[(i * n_m_rho + j) * n_t_ + k] = node_value(i, j, k);
+        }
+      }
+    }
+    analytic_cells_.assign((n_sqrts - 1) * (n_m_rho - 1) * n_t_cells(), 0);
+    for (std::size_t i = 0; i + 1 < n_sqrts; i++) {
+      for (std::size_t j = 0; j + 1 < n_m_rho; j++) {
+        // The cell is allowed if its corner closest to the threshold is.
+        if (!allowed(sqrts_min + i * sqrts_step,
+                     m_rho_min + (j + 1) * m_rho_step)) {
+          for (std::size_t k = 0; k < n_t_cells(); k++) {
+            analytic_cells_[cell(i, j, k)] = 1;
+          }
+          continue;
+        }
+        /* The deviation is measured relative to the largest value in t at the
+         * corners, since the differential cross sections cross zero. */
+        double scale = 0.;
+        for (std::size_t a = 0; a < 2; a++) {
+          for (std::size_t b = 0; b < 2; b++) {
+            const auto line =
+                values_.begin() + ((i + a) * n_m_rho + j + b) * n_t_;
+            for (auto value = line; value != line + n_t_; ++value) {
+              scale = std::max(scale, std::abs(*value));
+            }
+          }
+        }
+        const double sqrts = sqrts_min + (i + 0.5) * sqrts_step;
+        const double m_rho = m_rho_min + (j + 0.5) * m_rho_step;
+        for (std::size_t k = 0; k < n_t_cells(); k++) {
+          const double t =
+              n_t_ > 1 ? t_at(sqrts, m_rho, (k + 0.5) / (n_t_ - 1)) : 0.;
+          const double exact = analytic(sqrts * sqrts, t, m_rho);
+          const double approximation = interpolate(i, j, k, 0.5, 0.5, 0.5);
+          if (!(std::abs(approximation - exact) <=
+                accuracy * scale + absolute_accuracy)) {
+            analytic_cells_[cell(i, j, k)] = 1;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * \param[in] s Mandelstam-s [GeV^2]
+   * \param[in] t Mandelstam-t [GeV^2], ignored for a total cross section
+   * \param[in] m_rho Mass of participating rho-meson [GeV]
+   * \return The interpolated cross section, or the analytic one outside of
+   *         the grid or in a cell failing the check.
+   */
+  double operator()(double s, double t, double m_rho) const {
+    const double sqrts = std::sqrt(s);
+    const double x = (sqrts - sqrts_min) / sqrts_step;
+    const double y = (m_rho - m_rho_min) / m_rho_step;
+    if (!(x >= 0. && x < n_sqrts - 1 && y >= 0. && y < n_m_rho - 1)) {
+      return analytic(s, t, m_rho);
+    }
+    const auto i = static_cast<std::size_t>(x);
+    const auto j = static_cast<std::size_t>(y);
+    double z = 0.;
+    std::size_t k = 0;
+    if (n_t_ > 1) {
+      const auto range = t_range(sqrts, m_rho);
+      z = (t - range[1]) / (range[0] - range[1]) * (n_t_ - 1);
+      if (!(z >= 0. && z <= n_t_ - 1)) {
+        return analytic(s, t, m_rho);
+      }
+      k = std::min(static_cast<std::size_t>(z), n_t_ - 2);
+    }
+    if (analytic_cells_[cell(i, j, k)]) {
+      return analytic(s, t, m_rho);
+    }
+    return interpolate(i, j, k, x - i, y - j, z - k);
+  }
+
+  /// \return The tabulated values.
+  std::vector<double> &values() { return values_; }
+
+  /// \return Whether the analytic formula is used in each cell.
+  std::vector<std::uint8_t> &analytic_cells() { return analytic_cells_; }
+
+  /// \return The number of tabulated values.
+  std::size_t n_values() const { return n_sqrts * n_m_rho * n_t_; }
+
+  /// \return The number of cells.
+  std::size_t n_cells() const {
+    return (n_sqrts - 1) * (n_m_rho - 1) * n_t_cells();
+  }
+
+ private:
+  /// \return The number of cells in t direction.
+  std::size_t n_t_cells() const { return n_t_ > 1 ? n_t_ - 1 : 1; }
+
+  /// \return The index of the cell starting at the given indices.
+  std::size_t cell(std::size_t i, std::size_t j, std::size_t k) const {
+    return (i * (n_m_rho - 1) + j) * n_t_cells() + k;
+  }
+
+  /// \return Whether the process is kinematically possible.
+  bool allowed(double sqrts, double m_rho) const {
+    const double threshold = rho_outgoing_
+                                 ? std::max(m_rho, 2. * pion_mass)
+                                 : m_rho + pion_mass;
+    return sqrts > threshold + really_small;
+  }
+
+  /// \return The kinematic limits of t as given by get_t_range.
+  std::array<double, 2> t_range(double sqrts, double m_rho) const {
+    return rho_outgoing_
+               ? get_t_range(sqrts, pion_mass, pion_mass, m_rho, 0.)
+               : get_t_range(sqrts, pion_mass, m_rho, pion_mass, 0.);
+  }
+
+  /// \return The value of t at the relative position \p tau in its limits.
+  double t_at(double sqrts, double m_rho, double tau) const {
+    const auto range = t_range(sqrts, m_rho);
+    return range[1] + tau * (range[0] - range[1]);
+  }
+
+  /// \return The analytic cross section.
+  double analytic(double s, double t, double m_rho) const {
+    return diff_ ? diff_(s, t, m_rho) : total_(s, m_rho);
+  }
+
+  /// \return The analytic cross section at a grid point, 0 if not allowed.
+  double node_value(std::size_t i, std::size_t j, std::size_t k) const {
+    const double sqrts = sqrts_min + i * sqrts_step;
+    const double m_rho = m_rho_min + j * m_rho_step;
+    if (!allowed(sqrts, m_rho)) {
+      return 0.;
+    }
+    const double t =
+        n_t_ > 1 ? t_at(sqrts, m_rho, static_cast<double>(k) / (n_t_ - 1))
+                 : 0.;
+    return analytic(sqrts * sqrts, t, m_rho);
+  }
+
+  /**
+   * Interpolate linearly in all directions within a cell.
+   *
+   * \param[in] i, j, k Indices of the cell.
+   * \param[in] u, v, w Relative position within the cell.
+   * \return The interpolated value.
+   */
+  double interpolate(std::size_t i, std::size_t j, std::size_t k, double u,
+                     double v, double w) const {
+    const std::size_t dk = n_t_ > 1 ? 1 : 0;
+    const double weight_s[2] = {1. - u, u};
+    const double weight_m[2] = {1. - v, v};
+    double result = 0.;
+    for (std::size_t a = 0; a < 2; a++) {
+      for (std::size_t b = 0; b < 2; b++) {
+        const double *at = &values_[((i + a) * n_m_rho + j + b) * n_t_ + k];
+        result += weight_s[a] * weight_m[b] * ((1. - w) * at[0] + w * at[dk]);
+      }
+    }
+    return result;
+  }
+
+  /// Whether the rho meson is outgoing
+  bool rho_outgoing_;
+  /// Number of tabulated values of t, 1 for a total cross section
+  std::size_t n_t_;
+  /// Analytic total cross section, if tabulated
+  double (*total_)(double, double) = nullptr;
+  /// Analytic differential cross section, if tabulated
+  double (*diff_)(double, double, double) = nullptr;
+  /// Tabulated values, ordered by sqrt(s), rho mass and t
+  std::vector<double> values_;
+  /// Whether the analytic formula is used in a cell
+  std::vector<std::uint8_t> analytic_cells_;
+};
+
+/// The tabulated cross sections
+enum Channel : std::size_t {
+  pi_pi_rho0,
+  pi_pi0_rho,
+  pi0_rho0_pi0,
+  pi_rho0_pi,
+  pi_rho_pi0_rho_mediated,
+  pi_rho_pi0_omega_mediated,
+  pi0_rho_pi_rho_mediated,
+  pi0_rho_pi_omega_mediated,
+  diff_pi_pi_rho0,
+  diff_pi_pi0_rho,
+  diff_pi0_rho0_pi0,
+  diff_pi_rho0_pi,
+  diff_pi_rho_pi0_rho_mediated,
+  diff_pi_rho_pi0_omega_mediated,
+  diff_pi0_rho_pi_rho_mediated,
+  diff_pi0_rho_pi_omega_mediated,
+  n_channels
+};
+
+/// The tables of all channels, created by create_tables()
+std::vector<PhotonTable> tables;
+/// Hash identifying the stored tables
+sha256::Hash cache_hash;
+/// Directory of the stored tables, none if empty
+std::filesystem::path cache_path;
+
+/**
+ * Read the stored tables.
+ *
+ * \param[in] file The file of the tables.
+ * \param[in] accuracy Accuracy of the check of the interpolation.
+ * \return Whether the tables were stored for the same hash and accuracy.
+ */
+bool read_tables(const std::filesystem::path &file, double accuracy) {
+  std::ifstream in(file, std::ios::binary);
+  char file_magic[4];
+  std::uint32_t version;
+  sha256::Hash file_hash;
+  double file_accuracy;
+  std::uint64_t dimensions[3];
+  if (!in.read(file_magic, 4) || std::memcmp(file_magic, magic, 4) != 0 ||
+      !in.read(reinterpret_cast<char *>(&version), sizeof(version)) ||
+      version != format_version ||
+      !in.read(reinterpret_cast<char *>(file_hash.data()), file_hash.size()) ||
+      file_hash != cache_hash ||
+      !in.read(reinterpret_cast<char *>(&file_accuracy), sizeof(double)) ||
+      file_accuracy != accuracy ||
+      !in.read(reinterpret_cast<char *>(dimensions), sizeof(dimensions)) ||
+      dimensions[0] != n_sqrts || dimensions[1] != n_m_rho ||
+      dimensions[2] != n_t) {
+    return false;
+  }
+  for (PhotonTable &table : tables) {
+    table.values().resize(table.n_values());
+    table.analytic_cells().resize(table.n_cells());
+    if (!in.read(reinterpret_cast<char *>(table.values().data()),
+                 table.n_values() * sizeof(double)) ||
+        !in.read(reinterpret_cast<char *>(table.analytic_cells().data()),
+                 table.n_cells())) {
+      return false;
+    }
+  }
+  return in.peek() == std::ifstream::traits_type::eof();
+}
+
+/**
+ * Store the tables, such that no incomplete file is left behind.
+ *
+ * \param[in] file The file of the tables.
+ * \param[in] accuracy Accuracy of the check of the interpolation.
+ */
+void write_tables(const std::filesystem::path &file, double accuracy) {
+  RenamingFilePtr renaming_file(file, "wb");
+  FILE *out = renaming_file.get();
+  const std::uint64_t dimensions[3] = {n_sqrts, n_m_rho, n_t};
+  std::fwrite(magic, 1, 4, out);
+  std::fwrite(&format_version, sizeof(format_version), 1, out);
+  std::fwrite(cache_hash.data(), 1, cache_hash.size(), out);
+  std::fwrite(&accuracy, sizeof(double), 1, out);
+  std::fwrite(dimensions, sizeof(dimensions), 1, out);
+  for (PhotonTable &table : tables) {
+    std::fwrite(table.values().data(), sizeof(double), table.n_values(), out);
+    std::fwrite(table.analytic_cells().data(), 1, table.n_cells(), out);
+  }
+}
+
+}  // unnamed namespace
+
+void CrosssectionsPhoton<ComputationMethod::Lookup>::set_cache(
+    const sha256::Hash &hash, const std::filesystem::path &tabulations_path) {
+  cache_hash = hash;
+  cache_path = tabulations_path;
+}
+
+void CrosssectionsPhoton<ComputationMethod::Lookup>::create_tables(
+    double accuracy) {
+  if (!(accuracy > 0.)) {
+    throw std::invalid_argument(
+        "The accuracy of the photon cross section tables must be positive.");
+  }
+  tables.clear();
+  tables.reserve(n_channels);
+  tables.emplace_back(true, Analytic::xs_pi_pi_rho0);
+  tables.emplace_back(true, Analytic::xs_pi_pi0_rho);
+  tables.emplace_back(false, Analytic::xs_pi0_rho0_pi0);
+  tables.emplace_back(false, Analytic::xs_pi_rho0_pi);
+  tables.emplace_back(false, Analytic::xs_pi_rho_pi0_rho_mediated);
+  tables.emplace_back(false, Analytic::xs_pi_rho_pi0_omega_mediated);
+  tables.emplace_back(false, Analytic::xs_pi0_rho_pi_rho_mediated);
+  tables.emplace_back(false, Analytic::xs_pi0_rho_pi_omega_mediated);
+  tables.emplace_back(true, Analytic::xs_diff_pi_pi_rho0);
+  tables.emplace_back(true, Analytic::xs_diff_pi_pi0_rho);
+  tables.emplace_back(false, Analytic::xs_diff_pi0_rho0_pi0);
+  tables.emplace_back(false, Analytic::xs_diff_pi_rho0_pi);
+  tables.emplace_back(false, Analytic::xs_diff_pi_rho_pi0_rho_mediated);
+  tables.emplace_back(false, Analytic::xs_diff_pi_rho_pi0_omega_mediated);
+  tables.emplace_back(false, Analytic::xs_diff_pi0_rho_pi_rho_mediated);
+  tables.emplace_back(false, Analytic::xs_diff_pi0_rho_pi_omega_mediated);
+
+  /* Like for the resonance integrals, another process currently storing the
+   * tables is waited for, such that its tables are read afterwards. */
+  std::filesystem::path file;
+  std::unique_ptr<FileLock> lock;
+  if (!cache_path.empty()) {
+    std::filesystem::create_directories(cache_path);
+    lock = std::make_unique<FileLock>(cache_path / "photon_tables.lock");
+    if (lock->acquire_or_wait()) {
+      file = cache_path / "photon_cross_sections.bin";
+    }
+  }
+  if (!file.empty() && read_tables(file, accuracy)) {
+    logg[LCrossSections].info() << "Photon cross sections read from " << file;
+    return;
+  }
+  logg[LCrossSections].info("Tabulating photon cross sections...");
+  std::size_t n_cells = 0, n_analytic_cells = 0;
+  for (PhotonTable &table : tables) {
+    table.compute(accuracy);
+    n_cells += table.n_cells();
+    n_analytic_cells += std::count(table.analytic_cells().begin(),
+                                   table.analytic_cells().end(), 1);
+  }
+  logg[LCrossSections].info()
+      << "Photon cross sections are computed analytically in "
+      << n_analytic_cells << " of " << n_cells
+      << " cells, which are below threshold or inaccurate.";
+  if (!file.empty()) {
+    write_tables(file, accuracy);
+  }
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_pi_rho0(
+    const double s, const double m_rho) {
+  return tables[pi_pi_rho0](s, 0., m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_pi0_rho(
+    const double s, const double m_rho) {
+  return tables[pi_pi0_rho](s, 0., m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi0_rho0_pi0(
+    const double s, const double m_rho) {
+  return tables[pi0_rho0_pi0](s, 0., m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_rho0_pi(
+    const double s, const double m_rho) {
+  return tables[pi_rho0_pi](s, 0., m_rho);
+}
+
+// C13 + C15
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_rho_pi0(
+    const double s, const double m_rho) {
+  return cut_off(xs_pi_rho_pi0_rho_mediated(s, m_rho) +
+                 xs_pi_rho_pi0_omega_mediated(s, m_rho));
+}
+
+double
+CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_rho_pi0_rho_mediated(
+    const double s, const double m_rho) {
+  return tables[pi_rho_pi0_rho_mediated](s, 0., m_rho);
+}
+
+double
+CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_rho_pi0_omega_mediated(
+    const double s, const double m_rho) {
+  return tables[pi_rho_pi0_omega_mediated](s, 0., m_rho);
+}
+
+// C12 + C16
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi0_rho_pi(
+    const double s, const double m_rho) {
+  return cut_off(xs_pi0_rho_pi_rho_mediated(s, m_rho) +
+                 xs_pi0_rho_pi_omega_mediated(s, m_rho));
+}
+
+double
+CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi0_rho_pi_rho_mediated(
+    const double s, const double m_rho) {
+  return tables[pi0_rho_pi_rho_mediated](s, 0., m_rho);
+}
+
+double
+CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi0_rho_pi_omega_mediated(
+    const double s, const double m_rho) {
+  return tables[pi0_rho_pi_omega_mediated](s, 0., m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_diff_pi_pi_rho0(
+    const double s, const double t, const double m_rho) {
+  return tables[diff_pi_pi_rho0](s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_diff_pi_pi0_rho(
+    const double s, const double t, const double m_rho) {
+  return tables[diff_pi_pi0_rho](s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_diff_pi0_rho0_pi0(
+    const double s, const double t, const double m_rho) {
+  return tables[diff_pi0_rho0_pi0](s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_diff_pi_rho0_pi(
+    const double s, const double t, const double m_rho) {
+  return tables[diff_pi_rho0_pi](s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::
+    xs_diff_pi_rho_pi0_rho_mediated(const double s, const double t,
+                                    const double m_rho) {
+  return tables[diff_pi_rho_pi0_rho_mediated](s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::
+    xs_diff_pi_rho_pi0_omega_mediated(const double s, const double t,
+                                      const double m_rho) {
+  return tables[diff_pi_rho_pi0_omega_mediated](s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::
+    xs_diff_pi0_rho_pi_rho_mediated(const double s, const double t,
+                                    const double m_rho) {
+  return tables[diff_pi0_rho_pi_rho_mediated](s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::
+    xs_diff_pi0_rho_pi_omega_mediated(const double s, const double t,
+                                      const double m_rho) {
+  return tables[diff_pi0_rho_pi_omega_mediated](s, t, m_rho);
+}
+
+}  // namespace smash
@@ -6,10 +6,19 @@
  */
 #include "smash/customnucleus.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <map>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "smash/constants.h"
@@ -21,7 +30,195 @@
 namespace smash {
 static constexpr int LCollider = LogArea::Collider::id;
 
+namespace {
+
+/// Magic number at the start of the cache
+constexpr char cache_magic[4] = {'S', 'M', 'C', 'N'};
+/// Version of the layout of the cache
+constexpr std::uint32_t cache_version = 1;
+
+/**
+ * Layout of the start of the cache, which is followed by the nucleons.
+ * It identifies the list the cache was built for.
+ */
+struct CacheHeader {
+  /// Magic number
+  char magic[4];
+  /// Version of the layout
+  std::uint32_t version;
+  /// Size of the list in bytes
+  std::uint64_t list_size;
+  /// Modification time of the list
+  std::int64_t list_time;
+  /// Number of nucleons
+  std::uint64_t n_nucleons;
+};
+
+static_assert(std::is_trivially_copyable_v<Nucleoncustom>,
+              "The nucleons are stored in the cache as they are in memory.");
+static_assert(sizeof(CacheHeader) % alignof(Nucleoncustom) == 0,
+              "The nucleons in the cache have to be aligned.");
+
+/**
+ * \param[in] line A line of the external list.
+ * \return The nucleon given in the line.
+ * \throw std::runtime_error if the line cannot be read.
+ */
+Nucleoncustom parse_nucleon(const std::string& line) {
+  Nucleoncustom nucleon;
+  std::istringstream iss(line);
+  if (!(iss >> nucleon.x >> nucleon.y >> nucleon.z >> nucleon.spinprojection >>
+        nucleon.isospin)) {
+    throw std::runtime_error(
+        "SMASH could not read in a line from your initial nuclei input file."
+        "\nCheck if your file has the following format: x y z "
+        "spinprojection isospin");
+  }
+  return nucleon;
+}
+
+/**
+ * Parse all nucleons, which CustomNucleus::readfile would read from the list.
+ * A last line without a line break is skipped there when starting over, so
+ * it is also skipped here.
+ *
+ * \param[in] list The external list of nucleons.
+ * \return The nucleons.
+ */
+std::vector<Nucleoncustom> parse_list(const std::filesystem::path& list) {
+  std::ifstream infile(list);
+  std::vector<Nucleoncustom> nucleons;
+  std::string line;
+  while (std::getline(infile, line) && !infile.eof()) {
+    nucleons.push_back(parse_nucleon(line));
+  }
+  return nucleons;
+}
+
+/**
+ * Map the cache of a list, if it was built for the list as it is.
+ *
+ * \param[in] cache The cache.
+ * \param[in] list_size Size of the list in bytes.
+ * \param[in] list_time Modification time of the list.
+ * \param[out] n_nucleons Number of nucleons in the cache.
+ * \return The mapping, or nothing if the cache is missing or outdated.
+ */
+std::shared_ptr<const char> map_cache(const std::filesystem::path& cache,
+                                      std::uint64_t list_size,
+                                      std::int64_t list_time,
+                                      std::size_t& n_nucleons) {
+  const int fd = ::open(cache.native().c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat file_status;
+  CacheHeader header;
+  if (fstat(fd, &file_status) != 0 ||
+      ::read(fd, &header, sizeof(header)) !=
+          static_cast<ssize_t>(sizeof(header)) ||
+      std::memcmp(header.magic, cache_magic, 4) != 0 ||
+      header.version != cache_version || header.list_size != list_size ||
+      header.list_time != list_time || header.n_nucleons == 0 ||
+      static_cast<std::uint64_t>(file_status.st_size) !=
+          sizeof(header) + header.n_nucleons * sizeof(Nucleoncustom)) {
+    close(fd);
+    return nullptr;
+  }
+  const auto size = static_cast<std::size_t>(file_status.st_size);
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after the file is closed
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+  n_nucleons = header.n_nucleons;
+  return std::shared_ptr<const char>(
+      static_cast<const char*>(mapping),
+      [size](const char* data) { munmap(const_cast<char*>(data), size); });
+}
+
+/**
+ * Write the cache of a list, such that no incomplete cache is left behind.
+ *
+ * \param[in] cache The cache.
+ * \param[in] list_size Size of the list in bytes.
+ * \param[in] list_time Modification time of the list.
+ * \param[in] nucleons The nucleons of the list.
+ * \return Whether the cache could be written.
+ */
+bool write_cache(const std::filesystem::path& cache, std::uint64_t list_size,
+                 std::int64_t list_time,
+                 const std::vector<Nucleoncustom>& nucleons) {
+  std::filesystem::path unfinished = cache;
+  unfinished += ".unfinished";
+  std::ofstream out(unfinished, std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  CacheHeader header;
+  std::memcpy(header.magic, cache_magic, 4);
+  header.version = cache_version;
+  header.list_size = list_size;
+  header.list_time = list_time;
+  header.n_nucleons = nucleons.size();
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(nucleons.data()),
+            nucleons.size() * sizeof(Nucleoncustom));
+  out.close();
+  std::error_code error;
+  if (!out) {
+    std::filesystem::remove(unfinished, error);
+    return false;
+  }
+  std::filesystem::rename(unfinished, cache, error);
+  return !error;
+}
+
+}  // unnamed namespace
+
+CustomNucleusCache::CustomNucleusCache(const std::filesystem::path& list) {
+  std::error_code error;
+  const std::uint64_t list_size = std::filesystem::file_size(list, error);
+  if (error) {
+    throw std::runtime_error("Could not read the nuclei input file " +
+                             list.string() + ".");
+  }
+  const std::int64_t list_time =
+      std::filesystem::last_write_time(list).time_since_epoch().count();
+  const std::filesystem::path cache = cache_path(list);
+  mapping_ = map_cache(cache, list_size, list_time, size_);
+  if (!mapping_) {
+    parsed_ = parse_list(list);
+    if (parsed_.empty()) {
+      throw std::runtime_error("The nuclei input file " + list.string() +
+                               " holds no nucleon.");
+    }
+    if (write_cache(cache, list_size, list_time, parsed_)) {
+      mapping_ = map_cache(cache, list_size, list_time, size_);
+    }
+    if (!mapping_) {
+      logg[LCollider].warn("Could not write the binary cache ", cache.string(),
+                           ", the nuclei input file is kept in memory.");
+      data_ = parsed_.data();
+      size_ = parsed_.size();
+      return;
+    }
+    parsed_ = std::vector<Nucleoncustom>();
+  }
+  data_ = reinterpret_cast<const Nucleoncustom*>(mapping_.get() +
+                                                  sizeof(CacheHeader));
+}
+
+std::filesystem::path CustomNucleusCache::cache_path(
+    const std::filesystem::path& list) {
+  std::filesystem::path cache = list;
+  cache += ".bin";
+  return cache;
+}
+
 std::unique_ptr<std::ifstream> CustomNucleus::filestream_shared_ = nullptr;
+std::unique_ptr<CustomNucleusCache> CustomNucleus::cache_shared_ = nullptr;
 
 CustomNucleus::CustomNucleus(Configuration& config, int testparticles,
                              bool same_file) {
@@ -42,6 +239,9 @@ CustomNucleus::CustomNucleus(Configuration& config, int testparticles,
   const std::string particle_list_file_directory = config.take(file_dir_key);
   // Read in file name from config
   const std::string particle_list_file_name = config.take(filename_key);
+  const bool binary_cache = config.take(
+      is_projectile ? InputKeys::modi_collider_projectile_custom_binaryCache
+                    : InputKeys::modi_collider_target_custom_binaryCache);
 
   if (particles_.size() != 0) {
     throw std::runtime_error(
@@ -75,7 +275,17 @@ CustomNucleus::CustomNucleus(Configuration& config, int testparticles,
    */
   const std::string path =
       file_path(particle_list_file_directory, particle_list_file_name);
-  if (same_file && !filestream_shared_) {
+  if (binary_cache) {
+    if (same_file && !cache_shared_) {
+      cache_shared_ = std::make_unique<CustomNucleusCache>(path);
+      used_cache_ = &cache_shared_;
+    } else if (!same_file) {
+      cache_ = std::make_unique<CustomNucleusCache>(path);
+      used_cache_ = &cache_;
+    } else {
+      used_cache_ = &cache_shared_;
+    }
+  } else if (same_file && !filestream_shared_) {
     filestream_shared_ = std::make_unique<std::ifstream>(path);
     used_filestream_ = &filestream_shared_;
   } else if (!same_file) {
@@ -85,7 +295,7 @@ CustomNucleus::CustomNucleus(Configuration& config, int testparticles,
     used_filestream_ = &filestream_shared_;
   }
 
-  custom_nucleus_ = readfile(**used_filestream_);
+  custom_nucleus_ = read_next_nucleus();
   fill_from_list(custom_nucleus_);
   // Inherited from nucleus class (see nucleus.h)
   set_parameters_automatic();
@@ -123,7 +333,7 @@ ThreeVector CustomNucleus::distribute_nucleon() {
    * Therefore this if statement is implemented.
    */
   if (index_ >= custom_nucleus_.size()) {
-    custom_nucleus_ = readfile(**used_filestream_);
+    custom_nucleus_ = read_next_nucleus();
     fill_from_list(custom_nucleus_);
   }
   const auto& pos = custom_nucleus_.at(index_);
@@ -174,8 +384,6 @@ std::string CustomNucleus::file_path(const std::string& file_directory,
 
 std::vector<Nucleoncustom> CustomNucleus::readfile(
     std::ifstream& infile) const {
-  int proton_counter = 0;
-  int neutron_counter = 0;
   std::string line;
   std::vector<Nucleoncustom> custom_nucleus;
   // read in only A particles for one nucleus
@@ -187,21 +395,35 @@ std::vector<Nucleoncustom> CustomNucleus::readfile(
       infile.seekg(0, infile.beg);
       std::getline(infile, line);
     }
-    Nucleoncustom nucleon;
-    std::istringstream iss(line);
-    if (!(iss >> nucleon.x >> nucleon.y >> nucleon.z >>
-          nucleon.spinprojection >> nucleon.isospin)) {
-      throw std::runtime_error(
-          "SMASH could not read in a line from your initial nuclei input file."
-          "\nCheck if your file has the following format: x y z "
-          "spinprojection isospin");
-    }
+    custom_nucleus.push_back(parse_nucleon(line));
+  }
+  check_composition(custom_nucleus);
+  return custom_nucleus;
+}
+
+std::vector<Nucleoncustom> CustomNucleus::read_next_nucleus() {
+  if (!used_cache_) {
+    return readfile(**used_filestream_);
+  }
+  std::vector<Nucleoncustom> custom_nucleus;
+  custom_nucleus.reserve(number_of_nucleons_);
+  for (int i = 0; i < number_of_nucleons_; ++i) {
+    custom_nucleus.push_back((*used_cache_)->next());
+  }
+  check_composition(custom_nucleus);
+  return custom_nucleus;
+}
+
+void CustomNucleus::check_composition(
+    const std::vector<Nucleoncustom>& custom_nucleus) const {
+  int proton_counter = 0;
+  int neutron_counter = 0;
+  for (const Nucleoncustom& nucleon : custom_nucleus) {
     if (nucleon.isospin == 1) {
       proton_counter++;
     } else if (nucleon.isospin == 0) {
       neutron_counter++;
     }
-    custom_nucleus.push_back(nucleon);
   }
   if (proton_counter != number_of_protons_ ||
       neutron_counter != number_of_neutrons_) {
@@ -209,8 +431,6 @@ std::vector<Nucleoncustom> CustomNucleus::readfile(
         "Number of protons and/or neutrons in the nuclei input file does not "
         "correspond to the number specified in the config.\nCheck the config "
         "and your input file.");
-  } else {
-    return custom_nucleus;
   }
 }
 
@@ -9,6 +9,7 @@
 
 #include "smash/decayaction.h"
 
+#include "smash/decaychanneltable.h"
 #include "smash/decaymodes.h"
 #include "smash/logging.h"
 #include "smash/pdgcode.h"
@@ -41,7 +42,13 @@ bool DecayAction::sample_outgoing_particles() {
    * by calling function sample_2body_phasespace or sample_manybody_phasespace.
    */
   const DecayBranch *proc =
-      choose_channel<DecayBranch>(decay_channels_, total_width_);
+      channel_table_ ? channel_table_->sample(
+                           incoming_particles_[0].momentum().abs(),
+                           decay_channels_)
+                     : nullptr;
+  if (!proc) {
+    proc = choose_channel<DecayBranch>(decay_channels_, total_width_);
+  }
   outgoing_particles_ = proc->particle_list();
   // set positions of the outgoing particles
   for (auto &p : outgoing_particles_) {
@@ -81,13 +88,15 @@ void DecayAction::generate_final_state() {
   }
 
   const bool core_in_incoming = incoming_particles_[0].is_core();
+  const LorentzBoost to_computational_frame(
+      -total_momentum_of_outgoing_particles().velocity());
   // Set formation time.
   for (auto &p : outgoing_particles_) {
     logg[LDecayModes].debug("particle momenta in lrf ", p);
     // assuming decaying particles are always fully formed
     p.set_formation_time(time_of_execution_);
     // Boost to the computational frame
-    p.boost_momentum(-total_momentum_of_outgoing_particles().velocity());
+    p.boost_momentum(to_computational_frame);
     logg[LDecayModes].debug("particle momenta in comp ", p);
     if (core_in_incoming) {
       p.fluidize();
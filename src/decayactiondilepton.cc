@@ -85,9 +85,9 @@ void DecayActionDilepton::sample_manybody_phasespace() {
   l2.set_4momentum(mass_l2, -phitheta.threevec() * mom_lep);
 
   // Boost Dileptons back in parent particle rest frame
-  ThreeVector velocity_CM = dil_4mom.velocity();
-  l1.boost_momentum(-velocity_CM);
-  l2.boost_momentum(-velocity_CM);
+  const LorentzBoost to_parent_frame(-dil_4mom.velocity());
+  l1.boost_momentum(to_parent_frame);
+  l2.boost_momentum(to_parent_frame);
 }
 
 }  // namespace smash
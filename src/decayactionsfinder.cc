@@ -9,65 +9,180 @@
 
 #include "smash/decayactionsfinder.h"
 
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+
 #include "smash/constants.h"
 #include "smash/decayaction.h"
+#include "smash/decaychanneltable.h"
 #include "smash/decaymodes.h"
 #include "smash/fourvector.h"
+#include "smash/potential_globals.h"
 #include "smash/random.h"
 
 namespace smash {
 
+namespace {
+/// The hadronic width of a resonance with a given mass, once evaluated
+struct RememberedWidth {
+  /// Type of the resonance
+  const ParticleType *type = nullptr;
+  /// Mass of the resonance [GeV]
+  double mass = 0.;
+  /// Total hadronic width at this mass [GeV]
+  double width = 0.;
+};
+
+/// Number of hadronic widths remembered per thread
+constexpr std::size_t n_remembered_widths = 1 << 12;
+}  // unnamed namespace
+
+thread_local DecayTimes *DecayTimes::current_ = nullptr;
+
+void DecayTimes::clear() {
+  times_.clear();
+  queue_ = {};
+}
+
+void DecayTimes::forget_before(double time) {
+  while (!queue_.empty() && queue_.top().first < time) {
+    const auto [decay_time, id] = queue_.top();
+    queue_.pop();
+    // The resonance may have a later decay time for another momentum
+    auto found = times_.find(id);
+    if (found != times_.end() && found->second.time == decay_time) {
+      times_.erase(found);
+    }
+  }
+}
+
+std::optional<double> DecayTimes::find(const ParticleData &p) const {
+  auto found = times_.find(p.id());
+  if (found == times_.end() || found->second.momentum != p.momentum()) {
+    return std::nullopt;
+  }
+  return found->second.time;
+}
+
+void DecayTimes::remember(const ParticleData &p, double time) {
+  times_.insert_or_assign(p.id(), Entry{p.momentum(), time});
+  if (std::isfinite(time)) {
+    queue_.emplace(time, p.id());
+  }
+}
+
+/**
+ * Evaluate the total hadronic width of a particle.
+ *
+ * Without potentials, the width only depends on the type and the mass of the
+ * particle, which are only changed by an interaction. Hence, the widths are
+ * remembered per thread by type and mass, and only evaluated anew for
+ * particles whose mass changed. The remembered value is always the one which
+ * ParticleType::get_total_width returns.
+ *
+ * \param[in] p The unstable particle.
+ * \return The sum of the hadronic partial widths [GeV].
+ */
+static double hadronic_width(const ParticleData &p) {
+  const ParticleType &type = p.type();
+  const ParticleType *type_ptr = std::addressof(type);
+  // With potentials, the width depends on the position of the particle
+  if (UB_lat_pointer != nullptr || UI3_lat_pointer != nullptr) {
+    return type.get_total_width(p.momentum(), p.position().threevec(),
+                                WhichDecaymodes::Hadronic);
+  }
+  static thread_local std::array<RememberedWidth, n_remembered_widths>
+      remembered{};
+  const double mass = p.momentum().abs();
+  std::uint64_t bits;
+  std::memcpy(&bits, &mass, sizeof(bits));
+  bits ^= reinterpret_cast<std::uintptr_t>(type_ptr);
+  // Fibonacci hashing onto the 2^12 entries
+  RememberedWidth &entry = remembered[(bits * 0x9E3779B97F4A7C15ull) >> 52];
+  if (entry.type != type_ptr || entry.mass != mass) {
+    entry = {type_ptr, mass,
+             type.get_total_width(p.momentum(), p.position().threevec(),
+                                  WhichDecaymodes::Hadronic)};
+  }
+  return entry.width;
+}
+
 ActionList DecayActionsFinder::find_actions_in_cell(
-    const ParticleList &search_list, double dt, const double,
+    ParticleSpan search_list, double dt, const double,
     const std::vector<FourVector> &) const {
   ActionList actions;
   /* for short time steps this seems reasonable to expect
    * less than 10 decays in most time steps */
   actions.reserve(10);
+  // With potentials, the width changes with the position of the particle
+  DecayTimes *decay_times =
+      UB_lat_pointer == nullptr && UI3_lat_pointer == nullptr
+          ? DecayTimes::current()
+          : nullptr;
 
   for (const auto &p : search_list) {
     if (p.type().is_stable()) {
       continue;  // particle doesn't decay
     }
 
-    if (!decay_initial_particles_ &&
-        p.get_history().collisions_per_particle == 0) {
+    if (!decay_initial_particles_ && p.collisions_per_particle() == 0) {
       continue;
     }
 
-    DecayBranchList processes = p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic);
-    // total decay width (mass-dependent)
-    const double width = total_weight<DecayBranch>(processes);
+    double decay_time;
+    const std::optional<double> presampled =
+        decay_times ? decay_times->find(p) : std::nullopt;
+    if (presampled) {
+      decay_time = *presampled - p.position().x0();
+    } else {
+      /* total decay width (mass-dependent), the single branches are only
+       * needed if the particle decays */
+      const double width = hadronic_width(p);
 
-    // check if there are any (hadronic) decays
-    if (!(width > 0.0)) {
-      continue;
-    }
+      // check if there are any (hadronic) decays
+      if (!(width > 0.0)) {
+        if (decay_times) {
+          decay_times->remember(p, std::numeric_limits<double>::infinity());
+        }
+        continue;
+      }
 
-    constexpr double one_over_hbarc = 1. / hbarc;
-
-    /* The decay_time is sampled from an exponential distribution.
-     * Even though it may seem suspicious that it is sampled every
-     * timestep, it can be proven that this still overall obeys
-     * the exponential decay law.
-     */
-    double decay_time =
-        res_lifetime_factor_ * random::exponential<double>(
-                                   /* The clock goes slower in the rest
-                                    * frame of the resonance */
-                                   one_over_hbarc * p.inverse_gamma() * width);
-    /* If the particle is not yet formed, shift the decay time by the time it
-     * takes the particle to form */
-    if (p.xsec_scaling_factor() < 1.0) {
-      decay_time += p.formation_time() - p.position().x0();
+      constexpr double one_over_hbarc = 1. / hbarc;
+
+      /* The decay_time is sampled from an exponential distribution.
+       * Even though it may seem suspicious that it is sampled every
+       * timestep, it can be proven that this still overall obeys
+       * the exponential decay law.
+       */
+      decay_time = res_lifetime_factor_ *
+                   random::exponential<double>(
+                       /* The clock goes slower in the rest
+                        * frame of the resonance */
+                       one_over_hbarc * p.inverse_gamma() * width);
+      /* If the particle is not yet formed, shift the decay time by the time
+       * it takes the particle to form */
+      if (p.xsec_scaling_factor() < 1.0) {
+        decay_time += p.formation_time() - p.position().x0();
+      }
+      if (decay_times) {
+        decay_times->remember(p, p.position().x0() + decay_time);
+      }
     }
     if (decay_time < dt) {
       /* => decay_time ∈ [0, dt[
        * => the particle decays in this timestep. */
       auto act =
           std::make_unique<DecayAction>(p, decay_time, spin_interaction_type_);
-      act->add_decays(std::move(processes));
+      act->add_decays(p.type().get_partial_widths(
+          p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic));
+      // The tables do not know about the shift of the masses by potentials
+      if (pot_pointer == nullptr) {
+        act->set_channel_table(DecayChannelTable::find(p.type()));
+      }
       actions.emplace_back(std::move(act));
     }
   }
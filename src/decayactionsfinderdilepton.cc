@@ -9,12 +9,47 @@
 
 #include "smash/decayactionsfinderdilepton.h"
 
+#include <memory>
+#include <vector>
+
 #include "smash/constants.h"
 #include "smash/decayactiondilepton.h"
 #include "smash/decaymodes.h"
 
 namespace smash {
 
+DecayActionsFinderDilepton::DecayActionsFinderDilepton() {
+  dilepton_modes_.reserve(ParticleType::list_all().size());
+  for (const ParticleType &type : ParticleType::list_all()) {
+    dilepton_modes_.push_back(classify(type));
+  }
+}
+
+DecayActionsFinderDilepton::DileptonModes DecayActionsFinderDilepton::classify(
+    const ParticleType &type) {
+  size_t n_dilepton_modes = 0;
+  const auto &modes = type.decay_modes().decay_mode_list();
+  for (const auto &mode : modes) {
+    if (mode->type().is_dilepton_decay()) {
+      n_dilepton_modes++;
+    }
+  }
+  if (n_dilepton_modes == 0) {
+    return DileptonModes::None;
+  }
+  return n_dilepton_modes == modes.size() ? DileptonModes::Only
+                                          : DileptonModes::Some;
+}
+
+DecayActionsFinderDilepton::DileptonModes
+DecayActionsFinderDilepton::dilepton_modes(const ParticleType &type) const {
+  // The types are stored contiguously in the list of all types
+  const size_t index =
+      std::addressof(type) - std::addressof(ParticleType::list_all()[0]);
+  return index < dilepton_modes_.size() ? dilepton_modes_[index]
+                                        : classify(type);
+}
+
 void DecayActionsFinderDilepton::shine(const Particles &search_list,
                                        OutputInterface *output,
                                        double dt) const {
@@ -22,38 +57,62 @@ void DecayActionsFinderDilepton::shine(const Particles &search_list,
     return;
   }
   for (const auto &p : search_list) {
-    const auto n_all_modes =
-        p.type()
-            .get_partial_widths(p.momentum(), p.position().threevec(),
-                                WhichDecaymodes::All)
-            .size();
-    if (n_all_modes == 0) {
-      continue;
+    shine_particle(p, output, dt);
+  }
+}
+
+void DecayActionsFinderDilepton::shine(const ParticleData &p,
+                                       OutputInterface *output,
+                                       double dt) const {
+  if (output->is_dilepton_output()) {
+    shine_particle(p, output, dt);
+  }
+}
+
+void DecayActionsFinderDilepton::shine_particle(const ParticleData &p,
+                                                OutputInterface *output,
+                                                double dt) const {
+  /* If particle can only decay into dileptons or is stable, use shining only
+   * in find_final_actions and ignore them here, also core cannot shine */
+  if (dilepton_modes(p.type()) != DileptonModes::Some ||
+      p.type().is_stable() || p.is_core()) {
+    return;
+  }
+  /* The partial widths are written into a buffer of the thread, such that
+   * nothing is allocated unless a dilepton decay is open. */
+  static thread_local std::vector<double> widths;
+  p.type().get_partial_widths(p.momentum(), p.position().threevec(),
+                              WhichDecaymodes::All, widths);
+  const std::vector<DecayChannel> &channels = p.type().decay_modes().channels();
+  size_t n_all_modes = 0, n_dilepton_modes = 0;
+  for (size_t i = 0; i < channels.size(); i++) {
+    if (widths[i] > 0.) {
+      n_all_modes++;
+      n_dilepton_modes += channels[i].is_dilepton;
     }
+  }
+  // Also if the other decay modes are closed at the mass of the particle
+  if (n_dilepton_modes == 0 || n_dilepton_modes == n_all_modes) {
+    return;
+  }
 
-    const double inv_gamma = p.inverse_gamma();
-    DecayBranchList dil_modes = p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Dileptons);
+  const double inv_gamma = p.inverse_gamma();
 
-    /* If particle can only decay into dileptons or is stable, use shining only
-     * in find_final_actions and ignore them here, also core cannot shine */
-    if (dil_modes.size() == n_all_modes || p.type().is_stable() ||
-        p.is_core()) {
+  for (size_t i = 0; i < channels.size(); i++) {
+    if (!(widths[i] > 0.) || !channels[i].is_dilepton) {
       continue;
     }
+    // SHINING as described in \iref{Schmidt:2008hm}, chapter 2D
+    // If the formation time has not passed, the weight will be reduced
+    const double shining_weight =
+        dt * inv_gamma * widths[i] * p.xsec_scaling_factor() / hbarc;
 
-    for (DecayBranchPtr &mode : dil_modes) {
-      // SHINING as described in \iref{Schmidt:2008hm}, chapter 2D
-      // If the formation time has not passed, the weight will be reduced
-      const double shining_weight =
-          dt * inv_gamma * mode->weight() * p.xsec_scaling_factor() / hbarc;
-
-      if (shining_weight > 0.0) {  // decays that can happen
-        DecayActionDilepton act(p, 0., shining_weight);
-        act.add_decay(std::move(mode));
-        act.generate_final_state();
-        output->at_interaction(act, 0.0);
-      }
+    if (shining_weight > 0.0) {  // decays that can happen
+      DecayActionDilepton act(p, 0., shining_weight);
+      act.add_decay(
+          std::make_unique<DecayBranch>(*channels[i].type, widths[i]));
+      act.generate_final_state();
+      output->at_interaction(act, 0.0);
     }
   }
 }
@@ -66,24 +125,27 @@ void DecayActionsFinderDilepton::shine_final(const Particles &search_list,
   }
   for (const auto &p : search_list) {
     const ParticleType &t = p.type();
-    if (t.decay_modes().decay_mode_list().empty() ||
+    if (dilepton_modes(t) == DileptonModes::None ||
         (only_res && t.is_stable()) || p.is_core()) {
       continue;
     }
 
-    DecayBranchList dil_modes = t.get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Dileptons);
-
     // total decay width, also hadronic decays
-    const double width_tot = total_weight<DecayBranch>(t.get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::All));
+    static thread_local std::vector<double> widths;
+    const double width_tot = t.get_partial_widths(
+        p.momentum(), p.position().threevec(), WhichDecaymodes::All, widths);
+    const std::vector<DecayChannel> &channels = t.decay_modes().channels();
 
-    for (DecayBranchPtr &mode : dil_modes) {
-      const double shining_weight = mode->weight() / width_tot;
+    for (size_t i = 0; i < channels.size(); i++) {
+      if (!(widths[i] > 0.) || !channels[i].is_dilepton) {
+        continue;
+      }
+      const double shining_weight = widths[i] / width_tot;
 
       if (shining_weight > 0.0) {  // decays that can happen
         DecayActionDilepton act(p, 0., shining_weight);
-        act.add_decay(std::move(mode));
+        act.add_decay(
+            std::make_unique<DecayBranch>(*channels[i].type, widths[i]));
         act.generate_final_state();
         output->at_interaction(act, 0.0);
       }
@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/decaychanneltable.h"
+
+#include <cmath>
+#include <memory>
+
+#include "smash/decaymodes.h"
+#include "smash/decaytype.h"
+
+namespace smash {
+
+std::vector<std::optional<DecayChannelTable>>
+    DecayChannelTable::hadronic_tables_;
+
+DecayChannelTable::DecayChannelTable(const ParticleType &type,
+                                     WhichDecaymodes wh, int n_bins) {
+  const auto &mode_list = type.decay_modes().decay_mode_list();
+  for (const auto &mode : mode_list) {
+    modes_.push_back(&mode->type());
+  }
+  m_min_ = type.min_mass_kinematic();
+  const double m_max = type.mass() + 10. * type.width_at_pole();
+  inv_dm_ = n_bins / (m_max - m_min_);
+
+  std::vector<std::vector<double>> ratios;
+  for (int bin = 0; bin < n_bins; bin++) {
+    const double m = m_min_ + (bin + 0.5) / inv_dm_;
+    std::vector<double> weights(mode_list.size(), 0.);
+    double total = 0.;
+    for (std::size_t i = 0; i < mode_list.size(); i++) {
+      if (type.wanted_decaymode(mode_list[i]->type(), wh)) {
+        weights[i] = type.partial_width(m, mode_list[i].get());
+        total += weights[i];
+      }
+    }
+    if (total > 0.) {
+      bins_.emplace_back(random::alias_dist(weights));
+      for (double &w : weights) {
+        w /= total;
+      }
+    } else {
+      bins_.emplace_back(std::nullopt);
+    }
+    ratios.push_back(std::move(weights));
+  }
+
+  // Collapse the bins into one, if the branching ratios are the same in all.
+  bool mass_independent = bins_.front().has_value();
+  for (int bin = 1; bin < n_bins && mass_independent; bin++) {
+    for (std::size_t i = 0; i < mode_list.size(); i++) {
+      if (!bins_[bin] ||
+          std::abs(ratios[bin][i] - ratios[0][i]) > 1e-12 * ratios[0][i]) {
+        mass_independent = false;
+        break;
+      }
+    }
+  }
+  if (mass_independent) {
+    bins_.resize(1);
+  }
+}
+
+const DecayBranch *DecayChannelTable::sample(
+    double m, const DecayBranchList &channels) const {
+  std::size_t bin = 0;
+  if (!is_mass_independent()) {
+    const double x = (m - m_min_) * inv_dm_;
+    if (!(x >= 0. && x < bins_.size())) {
+      return nullptr;
+    }
+    bin = static_cast<std::size_t>(x);
+  }
+  if (!bins_[bin]) {
+    return nullptr;
+  }
+  const DecayType *mode = modes_[(*bins_[bin])()];
+  for (const auto &channel : channels) {
+    if (&channel->type() == mode) {
+      return channel.get();
+    }
+  }
+  return nullptr;
+}
+
+void DecayChannelTable::create_tables(int n_bins) {
+  hadronic_tables_.clear();
+  for (const ParticleType &type : ParticleType::list_all()) {
+    if (type.is_stable()) {
+      hadronic_tables_.emplace_back(std::nullopt);
+    } else {
+      hadronic_tables_.emplace_back(
+          DecayChannelTable(type, WhichDecaymodes::Hadronic, n_bins));
+    }
+  }
+}
+
+const DecayChannelTable *DecayChannelTable::find(const ParticleType &type) {
+  const auto index = static_cast<std::size_t>(
+      std::addressof(type) - std::addressof(ParticleType::list_all()[0]));
+  if (index >= hadronic_tables_.size() || !hadronic_tables_[index]) {
+    return nullptr;
+  }
+  return &*hadronic_tables_[index];
+}
+
+}  // namespace smash
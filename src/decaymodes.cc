@@ -9,12 +9,16 @@
 
 #include "smash/decaymodes.h"
 
+#include <typeinfo>
 #include <vector>
 
 #include "smash/clebschgordan.h"
 #include "smash/constants.h"
+#include "smash/decaytype.h"
+#include "smash/formfactors.h"
 #include "smash/inputfunctions.h"
 #include "smash/isoparticletype.h"
+#include "smash/kinematics.h"
 #include "smash/logging.h"
 #include "smash/stringfunctions.h"
 
@@ -26,6 +30,47 @@ std::vector<DecayModes> *DecayModes::all_decay_modes = nullptr;
 /// Global pointer to the decay types list
 std::vector<DecayTypePtr> *all_decay_types = nullptr;
 
+/**
+ * \return \f$\rho(m)\f$ of a decay into two stable daughters, as
+ * TwoBodyDecayStable::rho.
+ *
+ * \param[in] m Mass of the decaying particle [GeV].
+ * \param[in] mass_a Mass of the first daughter [GeV].
+ * \param[in] mass_b Mass of the second daughter [GeV].
+ * \param[in] L Angular momentum of the decay.
+ */
+static double rho_two_body_stable(double m, double mass_a, double mass_b,
+                                  int L) {
+  const double p_ab = pCM(m, mass_a, mass_b);
+  return p_ab / m * blatt_weisskopf_sqr(p_ab, L);
+}
+
+double DecayChannel::width(double m0, double m) const {
+  switch (shape) {
+    case Shape::TwoBodyStable:
+      return m <= threshold ? 0.
+                            : width_at_pole *
+                                  rho_two_body_stable(m, mass_a, mass_b,
+                                                      angular_momentum) /
+                                  rho_at_pole;
+    case Shape::TwoBodyDilepton: {
+      if (m <= threshold) {
+        return 0.;
+      }
+      // Like TwoBodyDecayDilepton::width, with the lepton mass mass_a
+      const double ml_to_m_sqr = (mass_a / m) * (mass_a / m);
+      const double m0_to_m_cubed = (m0 / m) * (m0 / m) * (m0 / m);
+      return width_at_pole * m0_to_m_cubed * std::sqrt(1. - 4. * ml_to_m_sqr) *
+             (1. + 2. * ml_to_m_sqr);
+    }
+    case Shape::Constant:
+      return m < threshold ? 0. : width_at_pole;
+    case Shape::Other:
+      break;
+  }
+  return m < threshold ? 0. : type->width(m0, width_at_pole, m);
+}
+
 void DecayModes::add_mode(ParticleTypePtr mother, double ratio, int L,
                           ParticleTypePtrList particle_types) {
   DecayType *type = get_decay_type(mother, particle_types, L);
@@ -54,6 +99,13 @@ DecayType *DecayModes::get_decay_type(ParticleTypePtr mother,
   }
 
   // if the type does not exist yet, create a new one
+  return create_decay_type(mother, particle_types, L);
+}
+
+DecayType *DecayModes::create_decay_type(ParticleTypePtr mother,
+                                         ParticleTypePtrList particle_types,
+                                         int L) {
+  assert(all_decay_types != nullptr);
   switch (particle_types.size()) {
     case 2:
       if (is_dilepton(particle_types[0]->pdgcode(),
@@ -160,7 +212,7 @@ static int min_angular_momentum(int s0, int s1, int s2, int s3) {
   return min_L / 2;
 }
 
-void DecayModes::load_decaymodes(const std::string &input) {
+void DecayModes::reset_decaymodes() {
   // create the DecayType vector first, then it outlives the DecayModes vector,
   // which references the DecayType objects.
   static std::vector<DecayTypePtr> decaytypes;
@@ -173,6 +225,51 @@ void DecayModes::load_decaymodes(const std::string &input) {
   decaymodes.clear();  // in case an exception was thrown and should try again
   decaymodes.resize(ParticleType::list_all().size());
   all_decay_modes = &decaymodes;
+}
+
+void DecayModes::create_channel_tables() {
+  const ParticleTypeList &types = ParticleType::list_all();
+  for (std::size_t i = 0; i < types.size(); i++) {
+    const ParticleType &mother = types[i];
+    DecayModes &modes = (*all_decay_modes)[i];
+    modes.channels_.clear();
+    modes.channels_.reserve(modes.decay_modes_.size());
+    for (const DecayBranchPtr &branch : modes.decay_modes_) {
+      const DecayType &type = branch->type();
+      const ParticleTypePtrList &daughters = type.particle_types();
+      DecayChannel channel{&type,
+                           DecayChannel::Shape::Other,
+                           type.is_dilepton_decay(),
+                           type.angular_momentum(),
+                           branch->threshold(),
+                           mother.width_at_pole() * branch->weight(),
+                           daughters[0]->mass(),
+                           daughters[1]->mass(),
+                           0.};
+      // The derived types overriding the widths are not evaluated here
+      if (typeid(type) == typeid(TwoBodyDecayStable)) {
+        channel.shape = DecayChannel::Shape::TwoBodyStable;
+        channel.rho_at_pole =
+            rho_two_body_stable(mother.mass(), channel.mass_a, channel.mass_b,
+                                channel.angular_momentum);
+      } else if (typeid(type) == typeid(TwoBodyDecayDilepton)) {
+        channel.shape = DecayChannel::Shape::TwoBodyDilepton;
+      } else if (typeid(type) == typeid(ThreeBodyDecay)) {
+        channel.shape = DecayChannel::Shape::Constant;
+      }
+      modes.channels_.push_back(channel);
+    }
+  }
+}
+
+const std::vector<DecayTypePtr> &DecayModes::list_all_decay_types() {
+  assert(all_decay_types != nullptr);
+  return *all_decay_types;
+}
+
+void DecayModes::load_decaymodes(const std::string &input) {
+  reset_decaymodes();
+  std::vector<DecayModes> &decaymodes = *all_decay_modes;
 
   const IsoParticleType *isotype_mother = nullptr;
   ParticleTypePtrList mother_states;
@@ -479,6 +576,11 @@ void DecayModes::load_decaymodes(const std::string &input) {
       }
     }
   }
+  create_channel_tables();
+  // The normalization of the spectral functions depends on the decay modes
+  ParticleType::normalize_spectral_functions();
+  create_resonance_table();
+
   if (total_large_renormalized > 0) {
     logg[LDecayModes].warn(
         "Branching ratios of ", total_large_renormalized,
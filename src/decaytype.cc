@@ -140,12 +140,12 @@ double TwoBodyDecaySemistable::get_Lambda() {
 
 /// Number of tabulation points.
 constexpr size_t num_tab_pts = 200;
-static /*thread_local (see #3075)*/ Integrator integrate;
+static thread_local Integrator integrate;
 
 double TwoBodyDecaySemistable::rho(double mass) const {
-  if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
+  /* The tabulation is lazily created by the first thread needing it, while
+   * other threads asking for it in the meantime wait for it to be ready. */
+  std::call_once(tabulation_created_, [this]() {
     const ParticleTypePtr res = particle_types_[1];
     const double tabulation_interval = std::max(2., 10. * res->width_at_pole());
     const double m_stable = particle_types_[0]->mass();
@@ -158,7 +158,7 @@ double TwoBodyDecaySemistable::rho(double mass) const {
             return integrand_rho_Manley_1res(sqrts, m, m_stable, res, L_);
           });
         });
-  }
+  });
   return tabulation_->get_value_linear(mass);
 }
 
@@ -194,12 +194,11 @@ double TwoBodyDecayUnstable::get_Lambda() {
   return 0.6;
 }
 
-static /*thread_local*/ Integrator2d integrate2d(1E7);
+static thread_local Integrator2d integrate2d(1E7);
 
 double TwoBodyDecayUnstable::rho(double mass) const {
-  if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
+  // See TwoBodyDecaySemistable::rho about the lazy initialization
+  std::call_once(tabulation_created_, [this]() {
     const ParticleTypePtr r1 = particle_types_[0];
     const ParticleTypePtr r2 = particle_types_[1];
     const double m1_min = r1->min_mass_kinematic();
@@ -220,7 +219,7 @@ double TwoBodyDecayUnstable::rho(double mass) const {
                                     .value();
           return result;
         });
-  }
+  });
   return tabulation_->get_value_linear(mass);
 }
 
@@ -451,7 +450,8 @@ double ThreeBodyDecayDilepton::width(double, double G0, double m) const {
     return G0;
   }
 
-  if (!tabulation_) {
+  // See TwoBodyDecaySemistable::rho about the lazy initialization
+  std::call_once(tabulation_created_, [this]() {
     int non_lepton_position = -1;
     for (int i = 0; i < 3; ++i) {
       if (!particle_types_[i]->is_lepton()) {
@@ -482,7 +482,7 @@ double ThreeBodyDecayDilepton::width(double, double G0, double m) const {
                            })
               .value();
         });
-  }
+  });
 
   return tabulation_->get_value_linear(m, Extrapolation::Const);
 }
@@ -50,12 +50,13 @@ DeformedNucleus::DeformedNucleus(Configuration &config, int nTest,
 }
 
 ThreeVector DeformedNucleus::distribute_nucleon() {
+  if (density_table_) {
+    return density_table_->sample();
+  }
   double a_radius;
   Angles a_direction;
   // Set a sensible maximum bound for radial sampling.
-  double radius_max =
-      Nucleus::get_nuclear_radius() / Nucleus::get_diffusiveness() +
-      Nucleus::get_nuclear_radius() * Nucleus::get_diffusiveness();
+  double radius_max = max_radius();
 
   // Sample the distribution.
   do {
@@ -71,6 +72,16 @@ ThreeVector DeformedNucleus::distribute_nucleon() {
   return a_direction.threevec() * a_radius;
 }
 
+void DeformedNucleus::set_tabulated_positions(bool tabulated) {
+  if (tabulated && gamma_ == 0.) {
+    density_table_ = NucleonDensityTable::find(
+        Nucleus::get_nuclear_radius(), Nucleus::get_diffusiveness(), beta2_,
+        beta3_, beta4_, max_radius());
+  } else {
+    density_table_ = nullptr;
+  }
+}
+
 void DeformedNucleus::set_deformation_parameters_automatic() {
   // Set the deformation parameters
   // reference for U, Pb, Au, Cu: \iref{Moller:1993ed}
@@ -35,30 +35,94 @@ double density_factor(const ParticleType &type, DensityType dens_type) {
   }
 }
 
-std::pair<double, ThreeVector> unnormalized_smearing_factor(
-    const ThreeVector &r, const FourVector &p, const double m_inv,
-    const DensityParameters &dens_par, const bool compute_gradient) {
-  const double r_sqr = r.sqr();
-  // Distance from particle to point of interest > r_cut
-  if (r_sqr > dens_par.r_cut_sqr()) {
-    return std::make_pair(0.0, ThreeVector(0.0, 0.0, 0.0));
+void SmearedParticles::clear() {
+  smeared_.clear();
+  updates_since_rebuild_ = 0;
+}
+
+bool SmearedParticles::changed(const ParticleData &smeared,
+                               const ParticleData &current) const {
+  return smeared.pdgcode() != current.pdgcode() ||
+         smeared.collisions_per_particle() !=
+             current.collisions_per_particle() ||
+         (smeared.position().threevec() - current.position().threevec())
+                 .abs() > tolerance_ ||
+         (smeared.velocity() - current.velocity()).abs() > tolerance_;
+}
+
+bool SmearedParticles::find_changes(const std::vector<Particles> &ensembles) {
+  removed_.clear();
+  added_.clear();
+  added_ensembles_.clear();
+  gone_.clear();
+  if (rebuild_interval_ <= 0 || updates_since_rebuild_ >= rebuild_interval_ ||
+      smeared_.size() != ensembles.size()) {
+    return false;
   }
+  update_++;
+  std::size_t n_particles = 0;
+  for (std::size_t ens = 0; ens < ensembles.size(); ens++) {
+    for (const ParticleData &part : ensembles[ens]) {
+      n_particles++;
+      auto found = smeared_[ens].find(part.id());
+      if (found == smeared_[ens].end()) {
+        added_.push_back(&part);
+        added_ensembles_.push_back(ens);
+        continue;
+      }
+      found->second.seen = update_;
+      if (changed(found->second.data, part)) {
+        removed_.push_back(&found->second.data);
+        added_.push_back(&part);
+        added_ensembles_.push_back(ens);
+      }
+    }
+    for (const auto &[id, smeared] : smeared_[ens]) {
+      if (smeared.seen != update_) {
+        removed_.push_back(&smeared.data);
+        gone_.emplace_back(ens, id);
+      }
+    }
+  }
+  // Smearing all particles is at most as expensive then
+  return removed_.size() + added_.size() < n_particles;
+}
 
-  const FourVector u = p * m_inv;
-  const double u_r_scalar = r * u.threevec();
-  const double r_rest_sqr = r_sqr + u_r_scalar * u_r_scalar;
+void SmearedParticles::remember_changes() {
+  for (const auto &[ens, id] : gone_) {
+    smeared_[ens].erase(id);
+  }
+  for (std::size_t i = 0; i < added_.size(); i++) {
+    smeared_[added_ensembles_[i]].insert_or_assign(
+        added_[i]->id(), Smeared{*added_[i], update_});
+  }
+  removed_.clear();
+  added_.clear();
+  added_ensembles_.clear();
+  gone_.clear();
+  updates_since_rebuild_++;
+}
 
-  // Lorentz contracted distance from particle to point of interest > r_cut
-  if (r_rest_sqr > dens_par.r_cut_sqr()) {
-    return std::make_pair(0.0, ThreeVector(0.0, 0.0, 0.0));
+void SmearedParticles::remember(const std::vector<Particles> &ensembles) {
+  removed_.clear();
+  added_.clear();
+  added_ensembles_.clear();
+  gone_.clear();
+  updates_since_rebuild_ = 0;
+  update_++;
+  smeared_.resize(ensembles.size());
+  for (std::size_t ens = 0; ens < ensembles.size(); ens++) {
+    smeared_[ens].clear();
+    for (const ParticleData &part : ensembles[ens]) {
+      smeared_[ens].insert({part.id(), {part, update_}});
+    }
   }
-  const double sf = std::exp(-r_rest_sqr * dens_par.two_sig_sqr_inv()) * u.x0();
-  const ThreeVector sf_grad = compute_gradient
-                                  ? sf * (r + u.threevec() * u_r_scalar) *
-                                        dens_par.two_sig_sqr_inv() * 2.0
-                                  : ThreeVector(0.0, 0.0, 0.0);
+}
 
-  return std::make_pair(sf, sf_grad);
+std::pair<double, ThreeVector> unnormalized_smearing_factor(
+    const ThreeVector &r, const FourVector &p, const double m_inv,
+    const DensityParameters &dens_par, const bool compute_gradient) {
+  return unnormalized_smearing_factor(r, p * m_inv, dens_par, compute_gradient);
 }
 
 /// \copydoc smash::current_eckart
@@ -86,7 +150,7 @@ current_eckart_impl(const ThreeVector &r, const T &plist,
   for (const auto &p : plist) {
     if (par.only_participants()) {
       // if this conditions holds, the hadron is a spectator
-      if (p.get_history().collisions_per_particle == 0) {
+      if (p.collisions_per_particle() == 0) {
         continue;
       }
     }
@@ -182,6 +246,64 @@ current_eckart(const ThreeVector &r, const Particles &plist,
   return current_eckart_impl(r, plist, par, dens_type, compute_gradient,
                              smearing);
 }
+std::tuple<double, FourVector, ThreeVector, ThreeVector, FourVector, FourVector,
+           FourVector, FourVector>
+current_eckart(const ThreeVector &r, const ParticlesView &plist,
+               const DensityParameters &par, DensityType dens_type,
+               bool compute_gradient, bool smearing) {
+  return current_eckart_impl(r, plist, par, dens_type, compute_gradient,
+                             smearing);
+}
+
+namespace {
+/**
+ * Computes the gradients of the rest frame density on the lattice from the
+ * current and its derivatives.
+ *
+ * \param[inout] lat The lattice of DensityOnLattice type, whose currents and
+ *              their derivatives are already computed
+ */
+void compute_rest_frame_density_gradients(
+    RectangularLattice<DensityOnLattice> *lat) {
+  for (auto &node : *lat) {
+    // the rest frame density
+    double rho = node.rho();
+    const int sgn = rho > 0 ? 1 : -1;
+    if (std::abs(rho) < very_small_double) {
+      rho = sgn * very_small_double;
+    }
+
+    // the computational frame j^mu
+    const FourVector jmu = node.jmu_net();
+    // computational frame array of derivatives of j^mu
+    const std::array<FourVector, 4> djmu_dxnu = node.djmu_dxnu();
+
+    const double drho_dt =
+        (1 / rho) *
+        (jmu.x0() * djmu_dxnu[0].x0() - jmu.x1() * djmu_dxnu[0].x1() -
+         jmu.x2() * djmu_dxnu[0].x2() - jmu.x3() * djmu_dxnu[0].x3());
+
+    const double drho_dx =
+        (1 / rho) *
+        (jmu.x0() * djmu_dxnu[1].x0() - jmu.x1() * djmu_dxnu[1].x1() -
+         jmu.x2() * djmu_dxnu[1].x2() - jmu.x3() * djmu_dxnu[1].x3());
+
+    const double drho_dy =
+        (1 / rho) *
+        (jmu.x0() * djmu_dxnu[2].x0() - jmu.x1() * djmu_dxnu[2].x1() -
+         jmu.x2() * djmu_dxnu[2].x2() - jmu.x3() * djmu_dxnu[2].x3());
+
+    const double drho_dz =
+        (1 / rho) *
+        (jmu.x0() * djmu_dxnu[3].x0() - jmu.x1() * djmu_dxnu[3].x1() -
+         jmu.x2() * djmu_dxnu[3].x2() - jmu.x3() * djmu_dxnu[3].x3());
+
+    const FourVector drho_dxnu = {drho_dt, drho_dx, drho_dy, drho_dz};
+
+    node.overwrite_drho_dxnu(drho_dxnu);
+  }
+}
+}  // namespace
 
 void update_lattice(
     RectangularLattice<DensityOnLattice> *lat,
@@ -190,7 +312,8 @@ void update_lattice(
     RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
     const LatticeUpdate update, const DensityType dens_type,
     const DensityParameters &par, const std::vector<Particles> &ensembles,
-    const double time_step, const bool compute_gradient) {
+    const double time_step, const bool compute_gradient,
+    ThreadPool *thread_pool, SmearedParticles *smeared) {
   // Do not proceed if lattice does not exists/update not required
   if (lat == nullptr || lat->when_update() != update) {
     return;
@@ -214,7 +337,7 @@ void update_lattice(
   }
 
   update_lattice_accumulating_ensembles(lat, update, dens_type, par, ensembles,
-                                        compute_gradient);
+                                        compute_gradient, thread_pool, smeared);
 
   // calculate the gradients for finite difference derivatives
   if (par.derivatives() == DerivativesMode::FiniteDifference) {
@@ -238,45 +361,43 @@ void update_lattice(
 
   // calculate gradients of rest frame density
   if (par.rho_derivatives() == RestFrameDensityDerivativesMode::On) {
-    for (auto &node : *lat) {
-      // the rest frame density
-      double rho = node.rho();
-      const int sgn = rho > 0 ? 1 : -1;
-      if (std::abs(rho) < very_small_double) {
-        rho = sgn * very_small_double;
-      }
-
-      // the computational frame j^mu
-      const FourVector jmu = node.jmu_net();
-      // computational frame array of derivatives of j^mu
-      const std::array<FourVector, 4> djmu_dxnu = node.djmu_dxnu();
-
-      const double drho_dt =
-          (1 / rho) *
-          (jmu.x0() * djmu_dxnu[0].x0() - jmu.x1() * djmu_dxnu[0].x1() -
-           jmu.x2() * djmu_dxnu[0].x2() - jmu.x3() * djmu_dxnu[0].x3());
-
-      const double drho_dx =
-          (1 / rho) *
-          (jmu.x0() * djmu_dxnu[1].x0() - jmu.x1() * djmu_dxnu[1].x1() -
-           jmu.x2() * djmu_dxnu[1].x2() - jmu.x3() * djmu_dxnu[1].x3());
-
-      const double drho_dy =
-          (1 / rho) *
-          (jmu.x0() * djmu_dxnu[2].x0() - jmu.x1() * djmu_dxnu[2].x1() -
-           jmu.x2() * djmu_dxnu[2].x2() - jmu.x3() * djmu_dxnu[2].x3());
-
-      const double drho_dz =
-          (1 / rho) *
-          (jmu.x0() * djmu_dxnu[3].x0() - jmu.x1() * djmu_dxnu[3].x1() -
-           jmu.x2() * djmu_dxnu[3].x2() - jmu.x3() * djmu_dxnu[3].x3());
-
-      const FourVector drho_dxnu = {drho_dt, drho_dx, drho_dy, drho_dz};
+    compute_rest_frame_density_gradients(lat);
+  }
+}  // void update_lattice()
 
-      node.overwrite_drho_dxnu(drho_dxnu);
+void update_lattices(
+    const std::array<RectangularLattice<DensityOnLattice> *, 2> &lats,
+    RectangularLattice<FourVector> *old_jmu,
+    RectangularLattice<FourVector> *new_jmu,
+    RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
+    const LatticeUpdate update, const std::array<DensityType, 2> &dens_types,
+    const DensityParameters &par, const std::vector<Particles> &ensembles,
+    const double time_step, const bool compute_gradient,
+    ThreadPool *thread_pool, const std::array<SmearedParticles *, 2> &smeared) {
+  if (lats[0] == nullptr || lats[1] == nullptr ||
+      par.derivatives() == DerivativesMode::FiniteDifference ||
+      !lats[0]->identical_to_lattice(lats[1]) ||
+      lats[0]->when_update() != lats[1]->when_update()) {
+    for (std::size_t k = 0; k < lats.size(); k++) {
+      update_lattice(lats[k], old_jmu, new_jmu, four_grad_lattice, update,
+                     dens_types[k], par, ensembles, time_step,
+                     compute_gradient, thread_pool, smeared[k]);
     }
-  }  // if (par.rho_derivatives() == RestFrameDensityDerivatives::On){
-}  // void update_lattice()
+    return;
+  }
+  // Do not proceed if update not required
+  if (lats[0]->when_update() != update) {
+    return;
+  }
+  update_lattices_accumulating_ensembles(lats, update, dens_types, par,
+                                         ensembles, compute_gradient,
+                                         thread_pool, smeared[0]);
+  if (par.rho_derivatives() == RestFrameDensityDerivativesMode::On) {
+    for (RectangularLattice<DensityOnLattice> *lat : lats) {
+      compute_rest_frame_density_gradients(lat);
+    }
+  }
+}
 
 std::ostream &operator<<(std::ostream &os, DensityType dens_type) {
   switch (dens_type) {
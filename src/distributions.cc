@@ -8,6 +8,7 @@
  */
 #include "smash/distributions.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -251,4 +252,79 @@ double sample_momenta_IC_ES(const double temperature) {
   return momentum_radial;
 }
 
+double ThermalMomentumSampler::sample(double temperature, double mass) {
+  return sample(*table(temperature, mass));
+}
+
+void ThermalMomentumSampler::sample(double temperature, double mass,
+                                    std::vector<double> &momenta) {
+  const std::shared_ptr<const Table> t = table(temperature, mass);
+  for (double &momentum : momenta) {
+    momentum = sample(*t);
+  }
+}
+
+double ThermalMomentumSampler::sample(const Table &t) {
+  const double u = random::uniform(0.0, static_cast<double>(n_quantiles_));
+  const std::size_t k = std::min(static_cast<std::size_t>(u), n_quantiles_ - 1);
+  return t.quantiles[k] + (u - k) * (t.quantiles[k + 1] - t.quantiles[k]);
+}
+
+std::shared_ptr<const ThermalMomentumSampler::Table>
+ThermalMomentumSampler::table(double temperature, double mass) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = tables_.begin(); it != tables_.end(); ++it) {
+      if ((*it)->temperature == temperature && (*it)->mass == mass) {
+        tables_.splice(tables_.begin(), tables_, it);
+        return tables_.front();
+      }
+    }
+  }
+  // Tabulated without the lock, a pair tabulated twice at once is kept twice
+  auto created = std::make_shared<Table>();
+  created->temperature = temperature;
+  created->mass = mass;
+  const double max_kinetic_energy = 40.0 * temperature;
+  const double max_momentum =
+      std::sqrt(max_kinetic_energy * (max_kinetic_energy + 2.0 * mass));
+  // Cumulative distribution on a fine grid, integrated with the trapezoidal
+  // rule
+  const double dp = max_momentum / n_momentum_intervals_;
+  std::vector<double> cdf(n_momentum_intervals_ + 1, 0.0);
+  double previous_density = 0.0;
+  for (std::size_t i = 1; i <= n_momentum_intervals_; i++) {
+    const double p = dp * i;
+    const double energy = std::sqrt(p * p + mass * mass);
+    // Relative to the threshold, such that heavy particles do not underflow
+    double density = p * p * std::exp(-(energy - mass) / temperature);
+    if (distribution_ == Distribution::NonEquilibriumMass) {
+      density *= p;
+    }
+    cdf[i] = cdf[i - 1] + 0.5 * (previous_density + density);
+    previous_density = density;
+  }
+  // Invert it at equally spaced fractions, linearly within the grid intervals
+  std::vector<double> &quantiles = created->quantiles;
+  quantiles.resize(n_quantiles_ + 1);
+  quantiles[0] = 0.0;
+  quantiles[n_quantiles_] = max_momentum;
+  std::size_t i = 1;
+  for (std::size_t k = 1; k < n_quantiles_; k++) {
+    const double target = cdf.back() * k / n_quantiles_;
+    while (i < n_momentum_intervals_ && cdf[i] < target) {
+      i++;
+    }
+    const double dcdf = cdf[i] - cdf[i - 1];
+    const double fraction = dcdf > 0.0 ? (target - cdf[i - 1]) / dcdf : 0.0;
+    quantiles[k] = dp * (i - 1 + fraction);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  tables_.push_front(created);
+  if (tables_.size() > capacity_) {
+    tables_.pop_back();
+  }
+  return created;
+}
+
 }  // namespace smash
@@ -17,10 +17,11 @@ namespace smash {
 static constexpr int LFluidization = LogArea::HyperSurfaceCrossing::id;
 
 ActionList DynamicFluidizationFinder::find_actions_in_cell(
-    const ParticleList &search_list, double dt,
+    ParticleSpan search_list, double dt,
     [[maybe_unused]] const double gcell_vol,
     [[maybe_unused]] const std::vector<FourVector> &beam_momentum) const {
   ActionList actions;
+  LandauEnergyDensities energy_densities;
 
   for (const ParticleData &p : search_list) {
     const double t0 = p.position().x0();
@@ -41,7 +42,7 @@ ActionList DynamicFluidizationFinder::find_actions_in_cell(
     if (!is_process_fluidizable(p.get_history())) {
       continue;
     }
-    if (above_threshold(p)) {
+    if (above_threshold(p, energy_densities)) {
       double time_until = (1 - p.xsec_scaling_factor() <= really_small)
                               ? 0
                               : std::max(fluidization_time - t0, 0.);
@@ -54,24 +55,40 @@ ActionList DynamicFluidizationFinder::find_actions_in_cell(
 
 bool DynamicFluidizationFinder::above_threshold(
     const ParticleData &pdata) const {
-  EnergyMomentumTensor Tmunu;
-  // value_at returns false if pdata is out of bounds
-  const bool inside =
-      energy_density_lattice_.value_at(pdata.position().threevec(), Tmunu);
-  if (inside) {
-    // If the particle is not in the map, the background evaluates to 0
-    const double background =
-        background_.count(pdata.id()) ? background_.at(pdata.id()) : 0;
-    const double e_den_particles =
-        Tmunu.boosted(Tmunu.landau_frame_4velocity())[0];
-    if (e_den_particles + background >=
-        energy_density_threshold_ + pdata.pole_mass() * smearing_kernel_at_0_) {
-      logg[LFluidization].debug()
-          << "Fluidize " << pdata.id() << " with " << e_den_particles << "+"
-          << background << " GeV/fm^3 at " << pdata.position().x0()
-          << " fm, formed at " << pdata.formation_time() << " fm";
-      return true;
-    }
+  LandauEnergyDensities energy_densities;
+  return above_threshold(pdata, energy_densities);
+}
+
+bool DynamicFluidizationFinder::above_threshold(
+    const ParticleData &pdata, LandauEnergyDensities &energy_densities) const {
+  // node_at returns nullptr if pdata is out of bounds
+  const EnergyMomentumTensor *Tmunu =
+      energy_density_lattice_.node_at(pdata.position().threevec());
+  if (!Tmunu) {
+    return false;
+  }
+  // If the particle is not in the map, the background evaluates to 0
+  const auto in_background = background_.find(pdata.id());
+  const double background =
+      in_background != background_.end() ? in_background->second : 0;
+  const double threshold = energy_density_threshold_ +
+                           pdata.pole_mass() * smearing_kernel_at_0_ -
+                           background;
+  if ((*Tmunu)[0] < threshold) {
+    return false;
+  }
+  auto cell = energy_densities.find(Tmunu);
+  if (cell == energy_densities.end()) {
+    const double e_rest = Tmunu->boosted(Tmunu->landau_frame_4velocity())[0];
+    cell = energy_densities.emplace(Tmunu, e_rest).first;
+  }
+  const double e_den_particles = cell->second;
+  if (e_den_particles >= threshold) {
+    logg[LFluidization].debug()
+        << "Fluidize " << pdata.id() << " with " << e_den_particles << "+"
+        << background << " GeV/fm^3 at " << pdata.position().x0()
+        << " fm, formed at " << pdata.formation_time() << " fm";
+    return true;
   }
   return false;
 }
@@ -127,7 +144,7 @@ ActionList DynamicFluidizationFinder::find_final_actions(
     }
   } else {
     for (auto &original : search_list) {
-      if (original.get_history().collisions_per_particle == 0) {
+      if (original.collisions_per_particle() == 0) {
         // Spectators are not propagated back.
         continue;
       }
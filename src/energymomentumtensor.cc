@@ -9,8 +9,10 @@
 
 #include "smash/energymomentumtensor.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 
 #include "Eigen/Dense"
 
@@ -20,7 +22,16 @@
 namespace smash {
 static constexpr int LTmn = LogArea::Tmn::id;
 
-FourVector EnergyMomentumTensor::landau_frame_4velocity() const {
+namespace {
+/**
+ * Find the Landau frame 4-velocity by diagonalizing \f$T^{\mu}_{\nu}\f$ as a
+ * general matrix, which also reports unphysical eigenvalues.
+ *
+ * \param[in] Tmn Components of the energy-momentum tensor
+ * \return 4-velocity with lower index
+ */
+FourVector landau_frame_by_diagonalization(
+    const EnergyMomentumTensor::tmn_type &Tmn) {
   using Eigen::Matrix4d;
   using Eigen::Vector4d;
   /* We want to solve the generalized eigenvalue problem
@@ -40,10 +51,10 @@ FourVector EnergyMomentumTensor::landau_frame_4velocity() const {
   Matrix4d A;
   // A = T_{\mu}^{\nu} = g_{\mu \mu'} T^{\mu' \nu}
   // clang-format off
-  A <<  Tmn_[0],  Tmn_[1],  Tmn_[2],  Tmn_[3],
-       -Tmn_[1], -Tmn_[4], -Tmn_[5], -Tmn_[6],
-       -Tmn_[2], -Tmn_[5], -Tmn_[7], -Tmn_[8],
-       -Tmn_[3], -Tmn_[6], -Tmn_[8], -Tmn_[9];
+  A <<  Tmn[0],  Tmn[1],  Tmn[2],  Tmn[3],
+       -Tmn[1], -Tmn[4], -Tmn[5], -Tmn[6],
+       -Tmn[2], -Tmn[5], -Tmn[7], -Tmn[8],
+       -Tmn[3], -Tmn[6], -Tmn[8], -Tmn[9];
   // clang-format on
 
   logg[LTmn].debug("Looking for Landau frame for T_{mu}^{nu} ", A);
@@ -109,6 +120,197 @@ FourVector EnergyMomentumTensor::landau_frame_4velocity() const {
   return u;
 }
 
+/// Number of Newton iterations after which the diagonalization is used instead
+constexpr int max_landau_iterations = 100;
+
+/**
+ * Newton step for the energy density, relative to the energy density, below
+ * which it is converged.
+ */
+constexpr double landau_accuracy = 1e-15;
+
+/**
+ * Number of power iterations refining the 4-velocity, such that also its small
+ * components are accurate to a few ulp.
+ */
+constexpr int landau_refinements = 3;
+
+/// Number of tensors whose Landau frames are found together
+constexpr std::size_t landau_block = 64;
+
+/**
+ * Find the Landau frame 4-velocities of up to \p block tensors without
+ * diagonalizing them numerically.
+ *
+ * The 4-velocity \f$u_\mu\f$ solves \f$(T^{\mu\nu} - e g^{\mu\nu}) u_\nu = 0\f$
+ * with the largest root \f$e\f$ of \f$\det(T^{\mu\nu} - \lambda g^{\mu\nu})\f$,
+ * the energy density. The other roots are the negative pressures
+ * \f$-p_i \le 0\f$. The quartic is written down from the principal minors of
+ * \f$T^{\mu\nu}\f$ and its largest root found by Newton's method, which
+ * converges monotonically when started from above. The Rayleigh quotient
+ * \f$u_\mu T^{\mu\nu} u_\nu\f$ of any 4-velocity is such a start, here the
+ * one of the direction of the energy flow \f$T^{0\mu}\f$. Then \f$u_\nu\f$ is
+ * proportional to any row of the adjugate of \f$T^{\mu\nu} - e g^{\mu\nu}\f$.
+ * Finally, it is refined by a few power iterations with
+ * \f$T^{\mu}_{\nu} + c\,\delta^{\mu}_{\nu}\f$ and \f$c = \sum p_i / 2\f$,
+ * every one of which reduces the error by at least a factor 3.
+ *
+ * The components of the tensors are stored contiguously, such that the steps
+ * are vectorized across the tensors.
+ *
+ * \tparam block Maximal number of tensors
+ * \param[in] first First of the tensors
+ * \param[in] n Number of tensors
+ * \param[out] found Whether a time-like 4-velocity was found, for every
+ *             tensor.
+ * \return 4-velocities with lower index, which are only valid if found.
+ */
+template <std::size_t block>
+std::array<FourVector, block> landau_frames_in_closed_form(
+    const EnergyMomentumTensor *first, const std::size_t n,
+    std::array<bool, block> &found) {
+  using Column = std::array<double, block>;
+  std::array<Column, 10> T;
+  // Coefficients of e^4 - a3 e^3 - a2 e^2 - a1 e - a0 = 0
+  Column a3, a2, a1, a0;
+  // Energy density and whether its Newton iteration is converged
+  Column e;
+  std::array<bool, block> done;
+  for (std::size_t k = 0; k < n; k++) {
+    for (std::size_t i = 0; i < 10; i++) {
+      T[i][k] = first[k][i];
+    }
+    const double t00 = T[0][k], t01 = T[1][k], t02 = T[2][k], t03 = T[3][k],
+                 t11 = T[4][k], t12 = T[5][k], t13 = T[6][k], t22 = T[7][k],
+                 t23 = T[8][k], t33 = T[9][k];
+    // 2x2 minors of the rows 0, 1 and of the rows 2, 3
+    const double s0 = t00 * t11 - t01 * t01, s1 = t00 * t12 - t01 * t02,
+                 s2 = t00 * t13 - t01 * t03, s3 = t01 * t12 - t11 * t02,
+                 s4 = t01 * t13 - t11 * t03, s5 = t02 * t13 - t12 * t03;
+    const double c0 = t02 * t13 - t03 * t12, c1 = t02 * t23 - t03 * t22,
+                 c2 = t02 * t33 - t03 * t23, c3 = t12 * t23 - t13 * t22,
+                 c4 = t12 * t33 - t13 * t23, c5 = t22 * t33 - t23 * t23;
+    // Principal 2x2 minors of the spatial block
+    const double m12 = t11 * t22 - t12 * t12, m13 = t11 * t33 - t13 * t13;
+    // Principal 3x3 minors without the index 3, 2, 1 and 0
+    const double d3 = t22 * s0 - t12 * s1 + t02 * s3;
+    const double d2 = t33 * s0 - t13 * s2 + t03 * s4;
+    const double d1 = t00 * c5 - t02 * c2 + t03 * c1;
+    const double d0 = t11 * c5 - t12 * c4 + t13 * c3;
+    a3[k] = t00 - t11 - t22 - t33;
+    a2[k] = s0 + (t00 * t22 - t02 * t02) + (t00 * t33 - t03 * t03) - m12 -
+            m13 - c5;
+    a1[k] = d1 + d2 + d3 - d0;
+    a0[k] = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    // Rayleigh quotient of the energy flow
+    const double flow_sqr = t00 * t00 - t01 * t01 - t02 * t02 - t03 * t03;
+    const double f1 = t00 * t01 - t11 * t01 - t12 * t02 - t13 * t03;
+    const double f2 = t00 * t02 - t12 * t01 - t22 * t02 - t23 * t03;
+    const double f3 = t00 * t03 - t13 * t01 - t23 * t02 - t33 * t03;
+    const double f0 = t00 * t00 - t01 * t01 - t02 * t02 - t03 * t03;
+    e[k] = (t00 * f0 - t01 * f1 - t02 * f2 - t03 * f3) / flow_sqr;
+    // Without a time-like energy flow, the diagonalization is used instead
+    done[k] = !(flow_sqr > 0. && t00 > 0.);
+    found[k] = !done[k];
+  }
+  for (int iteration = 0; iteration < max_landau_iterations; iteration++) {
+    bool all_done = true;
+    for (std::size_t k = 0; k < n; k++) {
+      if (done[k]) {
+        continue;
+      }
+      const double x = e[k];
+      const double p = (((x - a3[k]) * x - a2[k]) * x - a1[k]) * x - a0[k];
+      const double dp = ((4. * x - 3. * a3[k]) * x - 2. * a2[k]) * x - a1[k];
+      const double step = p / dp;
+      e[k] = x - step;
+      done[k] = !(std::abs(step) > landau_accuracy * e[k]);
+      all_done &= done[k];
+    }
+    if (all_done) {
+      break;
+    }
+  }
+  std::array<FourVector, block> result;
+  for (std::size_t k = 0; k < n; k++) {
+    found[k] = found[k] && done[k] && e[k] > 0.;
+    const double t00 = T[0][k], t01 = T[1][k], t02 = T[2][k], t03 = T[3][k],
+                 t11 = T[4][k], t12 = T[5][k], t13 = T[6][k], t22 = T[7][k],
+                 t23 = T[8][k], t33 = T[9][k];
+    // Diagonal of T^{\mu\nu} - e g^{\mu\nu}
+    const double n11 = t11 + e[k], n22 = t22 + e[k], n33 = t33 + e[k];
+    // First row of the adjugate
+    double u[4] = {
+        n11 * (n22 * n33 - t23 * t23) - t12 * (t12 * n33 - t23 * t13) +
+            t13 * (t12 * t23 - n22 * t13),
+        -(t01 * (n22 * n33 - t23 * t23) - t12 * (t02 * n33 - t23 * t03) +
+          t13 * (t02 * t23 - n22 * t03)),
+        t01 * (t12 * n33 - t23 * t13) - n11 * (t02 * n33 - t23 * t03) +
+            t13 * (t02 * t13 - t12 * t03),
+        -(t01 * (t12 * t23 - n22 * t13) - n11 * (t02 * t23 - n22 * t03) +
+          t12 * (t02 * t13 - t12 * t03))};
+    const double shift = 0.5 * std::max(e[k] - a3[k], 0.);
+    for (int refinement = 0; refinement <= landau_refinements; refinement++) {
+      const double norm_sqr =
+          u[0] * u[0] - u[1] * u[1] - u[2] * u[2] - u[3] * u[3];
+      if (!(norm_sqr > 0. && u[0] > 0.)) {
+        found[k] = false;
+        break;
+      }
+      const double inv_norm = 1. / std::sqrt(norm_sqr);
+      for (double &component : u) {
+        component *= inv_norm;
+      }
+      if (refinement == landau_refinements) {
+        break;
+      }
+      // (T^{\mu\nu} u_\nu + c u^\mu) with lowered index
+      const double w0 = t00 * u[0] + t01 * u[1] + t02 * u[2] + t03 * u[3];
+      const double w1 = t01 * u[0] + t11 * u[1] + t12 * u[2] + t13 * u[3];
+      const double w2 = t02 * u[0] + t12 * u[1] + t22 * u[2] + t23 * u[3];
+      const double w3 = t03 * u[0] + t13 * u[1] + t23 * u[2] + t33 * u[3];
+      u[0] = w0 + shift * u[0];
+      u[1] = -w1 + shift * u[1];
+      u[2] = -w2 + shift * u[2];
+      u[3] = -w3 + shift * u[3];
+    }
+    result[k] = FourVector(u[0], u[1], u[2], u[3]);
+  }
+  return result;
+}
+
+}  // unnamed namespace
+
+FourVector EnergyMomentumTensor::landau_frame_4velocity() const {
+  std::array<bool, 1> converged;
+  const FourVector u = landau_frames_in_closed_form(this, 1, converged)[0];
+  if (converged[0]) {
+    return u;
+  }
+  if (std::all_of(Tmn_.begin(), Tmn_.end(), [](double t) { return t == 0.; })) {
+    // Without any energy, the lab frame is taken as the Landau frame
+    return FourVector(1., 0., 0., 0.);
+  }
+  return landau_frame_by_diagonalization(Tmn_);
+}
+
+std::vector<FourVector> EnergyMomentumTensor::landau_frame_4velocities(
+    const EnergyMomentumTensor *tensors, std::size_t n) {
+  std::vector<FourVector> result;
+  result.reserve(n);
+  std::array<bool, landau_block> converged;
+  for (std::size_t first = 0; first < n; first += landau_block) {
+    const std::size_t block = std::min(landau_block, n - first);
+    const std::array<FourVector, landau_block> u =
+        landau_frames_in_closed_form(tensors + first, block, converged);
+    for (std::size_t k = 0; k < block; k++) {
+      const EnergyMomentumTensor &tensor = tensors[first + k];
+      result.push_back(converged[k] ? u[k] : tensor.landau_frame_4velocity());
+    }
+  }
+  return result;
+}
+
 EnergyMomentumTensor EnergyMomentumTensor::boosted(const FourVector &u) const {
   using Eigen::Matrix4d;
   Matrix4d A, L, R;
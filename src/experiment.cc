@@ -157,8 +157,10 @@ ExperimentParameters create_experiment_parameters(Configuration &config) {
   config.remove_all_entries_in_section_but_one(modus_chooser, {"Modi"});
 
   double box_length = -1.0;
+  bool lazy_wall_crossings = false;
   if (config.has_value(InputKeys::modi_box_length)) {
     box_length = config.read(InputKeys::modi_box_length);
+    lazy_wall_crossings = config.read(InputKeys::modi_box_lazyWallCrossings);
   }
   if (config.has_value(InputKeys::modi_listBox_length)) {
     box_length = config.read(InputKeys::modi_listBox_length);
@@ -320,6 +322,7 @@ ExperimentParameters create_experiment_parameters(Configuration &config) {
           low_snn_cut,
           potential_affect_threshold,
           box_length,
+          lazy_wall_crossings,
           maximum_cross_section,
           config.take(InputKeys::collTerm_fixedMinCellLength),
           scale_xs,
@@ -620,6 +623,16 @@ EventInfo fill_event_info(const std::vector<Particles> &ensembles,
   return event_info;
 }
 
+int64_t draw_seed_of_next_event() {
+  /* We have to be careful about the minimal integer, whose absolute value
+   * cannot be represented. */
+  int64_t r = random::advance();
+  while (r == INT64_MIN) {
+    r = random::advance();
+  }
+  return std::abs(r);
+}
+
 void validate_and_adjust_particle_list(ParticleList &particle_list) {
   static bool warn_mass_discrepancy = true;
   static bool warn_off_shell_particle = true;
@@ -657,4 +670,20 @@ void validate_and_adjust_particle_list(ParticleList &particle_list) {
   }
 }
 
+ParticleList particles_from_records(
+    const std::vector<ParticleRecord> &records) {
+  ParticleList particles;
+  particles.reserve(records.size());
+  for (const ParticleRecord &r : records) {
+    try {
+      particles.push_back(MemoryOutput::particle(r));
+    } catch (ParticleType::PdgNotFoundFailure &) {
+      logg[LExperiment].warn()
+          << "SMASH does not recognize pdg code " << r.pdg
+          << " of a handed over particle. This particle will be ignored.\n";
+    }
+  }
+  return particles;
+}
+
 }  // namespace smash
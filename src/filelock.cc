@@ -14,7 +14,13 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <system_error>
+#include <thread>
+
+#include "smash/logging.h"
+
 namespace smash {
+static constexpr int LMain = LogArea::Main::id;
 
 FileLock::FileLock(const std::filesystem::path& path)
     : path_(path), acquired_(false) {}
@@ -38,6 +44,31 @@ bool FileLock::acquire() {
   return true;
 }
 
+bool FileLock::acquire_or_wait(std::chrono::seconds max_age) {
+  // The lock files are small and on shared file systems, so they are polled
+  constexpr std::chrono::milliseconds poll_interval(500);
+  bool waiting = false;
+  while (!acquire()) {
+    std::error_code error;
+    const auto created = std::filesystem::last_write_time(path_, error);
+    if (error) {
+      // The lock was released in the meantime
+      continue;
+    }
+    const auto age = decltype(created)::clock::now() - created;
+    if (age > max_age) {
+      return false;
+    }
+    if (!waiting) {
+      logg[LMain].info() << "Waiting for another process to release "
+                         << path_.filename() << "...";
+      waiting = true;
+    }
+    std::this_thread::sleep_for(poll_interval);
+  }
+  return true;
+}
+
 FileLock::~FileLock() {
   if (acquired_) {
     std::filesystem::remove(path_);
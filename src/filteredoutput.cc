@@ -0,0 +1,107 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/filteredoutput.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "smash/action.h"
+
+namespace smash {
+
+/// \return Whether the value is in the closed interval.
+static bool is_in(double value, const std::array<double, 2> &range) {
+  return range[0] <= value && value <= range[1];
+}
+
+FilteredOutput::FilteredOutput(std::unique_ptr<OutputInterface> target,
+                               std::string name,
+                               const OutputFilterParameters &filter)
+    : OutputInterface(std::move(name)),
+      target_(std::move(target)),
+      filter_(filter) {
+  for (const auto &range : {filter_.rapidity_range, filter_.pt_range}) {
+    if (range && !((*range)[0] <= (*range)[1])) {
+      throw std::invalid_argument(
+          "The ranges of an output filter must not be empty.");
+    }
+  }
+}
+
+bool FilteredOutput::selects(const ParticleData &p) const {
+  if (!filter_.pdg_codes.empty() &&
+      std::find(filter_.pdg_codes.begin(), filter_.pdg_codes.end(),
+                p.pdgcode()) == filter_.pdg_codes.end()) {
+    return false;
+  }
+  if (filter_.rapidity_range && !is_in(p.rapidity(), *filter_.rapidity_range)) {
+    return false;
+  }
+  if (filter_.pt_range) {
+    const FourVector &mom = p.momentum();
+    const double pt = std::sqrt(mom.x1() * mom.x1() + mom.x2() * mom.x2());
+    if (!is_in(pt, *filter_.pt_range)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FilteredOutput::selects(const Action &action) const {
+  if (!filter_.process_types.empty() &&
+      std::find(filter_.process_types.begin(), filter_.process_types.end(),
+                static_cast<int>(action.get_type())) ==
+          filter_.process_types.end()) {
+    return false;
+  }
+  auto is_selected = [this](const ParticleData &p) { return selects(p); };
+  return std::any_of(action.incoming_particles().begin(),
+                     action.incoming_particles().end(), is_selected) ||
+         std::any_of(action.outgoing_particles().begin(),
+                     action.outgoing_particles().end(), is_selected);
+}
+
+const Particles &FilteredOutput::selected(const Particles &particles) {
+  selected_.copy_from(particles,
+                      [this](const ParticleData &p) { return selects(p); });
+  return selected_;
+}
+
+void FilteredOutput::at_eventstart(const Particles &particles,
+                                   const EventLabel &event_label,
+                                   const EventInfo &event) {
+  target_->at_eventstart(selected(particles), event_label, event);
+}
+
+void FilteredOutput::at_eventend(const Particles &particles,
+                                 const EventLabel &event_label,
+                                 const EventInfo &event) {
+  target_->at_eventend(selected(particles), event_label, event);
+}
+
+void FilteredOutput::at_intermediate_time(const Particles &particles,
+                                          const std::unique_ptr<Clock> &clock,
+                                          const DensityParameters &dens_param,
+                                          const EventLabel &event_label,
+                                          const EventInfo &event) {
+  target_->at_intermediate_time(selected(particles), clock, dens_param,
+                                event_label, event);
+}
+
+void FilteredOutput::at_interaction(const Action &action,
+                                    const double density) {
+  if (selects(action)) {
+    target_->at_interaction(action, density);
+  }
+}
+
+}  // namespace smash
@@ -15,16 +15,24 @@
 namespace smash {
 
 FourVector FourVector::lorentz_boost(const ThreeVector& v) const {
-  const double velocity_squared = v.sqr();
+  return LorentzBoost(v)(*this);
+}
 
-  const double gamma =
-      velocity_squared < 1. ? 1. / std::sqrt(1. - velocity_squared) : 0;
+LorentzBoost::LorentzBoost(const ThreeVector& v) : v_(v) {
+  const double velocity_squared = v.sqr();
+  gamma_ = velocity_squared < 1. ? 1. / std::sqrt(1. - velocity_squared) : 0;
+  gamma_ratio_ = gamma_ / (gamma_ + 1);
+}
 
+FourVector LorentzBoost::operator()(const FourVector& x) const {
   // this is used four times in the Vector:
-  const double xprime_0 = gamma * (this->x0() - this->threevec() * v);
+  const double xprime_0 = gamma_ * (x.x0() - x.threevec() * v_);
   // this is the part of the space-like components that is always the same:
-  const double constantpart = gamma / (gamma + 1) * (xprime_0 + this->x0());
-  return FourVector(xprime_0, this->threevec() - v * constantpart);
+  const double constantpart = gamma_ratio_ * (xprime_0 + x.x0());
+  // subtract from all four components at once and replace the time after
+  FourVector xprime = x - FourVector(0., v_ * constantpart);
+  xprime.set_x0(xprime_0);
+  return xprime;
 }
 
 bool FourVector::operator==(const FourVector& a) const {
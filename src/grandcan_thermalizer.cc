@@ -9,6 +9,8 @@
 
 #include <time.h>
 
+#include <map>
+
 #include "smash/angles.h"
 #include "smash/forwarddeclarations.h"
 #include "smash/logging.h"
@@ -39,46 +41,71 @@ void ThermLatticeNode::add_particle(const ParticleData &part, double factor) {
   nq_ += static_cast<double>(part.type().charge()) * factor;
 }
 
-void ThermLatticeNode::compute_rest_frame_quantities(HadronGasEos &eos) {
+ThermLatticeNode &ThermLatticeNode::operator+=(const ThermLatticeNode &other) {
+  Tmu0_ += other.Tmu0_;
+  nb_ += other.nb_;
+  ns_ += other.ns_;
+  nq_ += other.nq_;
+  return *this;
+}
+
+void ThermLatticeNode::compute_rest_frame_quantities(
+    const HadronGasEos &table_eos, HadronGasEos &solver_eos,
+    const std::array<double, 4> &previous_solution) {
   /// \todo(oliiny): use Newton's method instead of these iterations
-  const int max_iter = 50;
   v_ = ThreeVector(0.0, 0.0, 0.0);
-  double e_previous_step = 0.0;
-  const double tolerance = 5.e-4;
+  double change = 0.0;
   int iter;
-  for (iter = 0; iter < max_iter; iter++) {
-    e_previous_step = e_;
-    e_ = Tmu0_.x0() - Tmu0_.threevec() * v_;
-    if (std::abs(e_ - e_previous_step) < tolerance) {
+  for (iter = 0; iter < max_rest_frame_iterations_; iter++) {
+    change = update_rest_frame_energy_density();
+    if (change < rest_frame_tolerance_) {
       break;
     }
-    const double gamma_inv = std::sqrt(1.0 - v_.sqr());
     EosTable::table_element tabulated;
-    eos.from_table(tabulated, e_, gamma_inv * nb_, nq_);
-    if (!eos.is_tabulated() || tabulated.p < 0.0) {
-      auto T_mub_mus_muq =
-          eos.solve_eos(e_, gamma_inv * nb_, gamma_inv * ns_, nq_);
-      T_ = T_mub_mus_muq[0];
-      mub_ = T_mub_mus_muq[1];
-      mus_ = T_mub_mus_muq[2];
-      muq_ = T_mub_mus_muq[3];
-      p_ = HadronGasEos::pressure(T_, mub_, mus_, muq_);
-    } else {
-      p_ = tabulated.p;
-      T_ = tabulated.T;
-      mub_ = tabulated.mub;
-      mus_ = tabulated.mus;
-      muq_ = tabulated.muq;
-    }
-    v_ = Tmu0_.threevec() / (Tmu0_.x0() + p_);
+    table_eos.from_table(tabulated, e_, rest_frame_nb(), nq_);
+    update_rest_frame(tabulated, solver_eos,
+                      iter == 0 ? previous_solution
+                                : std::array<double, 4>{T_, mub_, mus_, muq_});
   }
-  if (iter == max_iter) {
-    std::cout << "Warning from solver: max iterations exceeded."
-              << " Accuracy: " << std::abs(e_ - e_previous_step)
-              << " is less than tolerance " << tolerance << std::endl;
+  if (iter == max_rest_frame_iterations_) {
+    warn_rest_frame_not_converged(change);
   }
 }
 
+double ThermLatticeNode::update_rest_frame_energy_density() {
+  const double e_previous_step = e_;
+  e_ = Tmu0_.x0() - Tmu0_.threevec() * v_;
+  return std::abs(e_ - e_previous_step);
+}
+
+void ThermLatticeNode::update_rest_frame(
+    const EosTable::table_element &tabulated, HadronGasEos &solver_eos,
+    const std::array<double, 4> &start) {
+  if (tabulated.p < 0.0) {
+    const double gamma_inv = std::sqrt(1.0 - v_.sqr());
+    const auto T_mub_mus_muq = solver_eos.solve_eos_warm_start(
+        e_, gamma_inv * nb_, gamma_inv * ns_, nq_, start);
+    T_ = T_mub_mus_muq[0];
+    mub_ = T_mub_mus_muq[1];
+    mus_ = T_mub_mus_muq[2];
+    muq_ = T_mub_mus_muq[3];
+    p_ = HadronGasEos::pressure(T_, mub_, mus_, muq_);
+  } else {
+    p_ = tabulated.p;
+    T_ = tabulated.T;
+    mub_ = tabulated.mub;
+    mus_ = tabulated.mus;
+    muq_ = tabulated.muq;
+  }
+  v_ = Tmu0_.threevec() / (Tmu0_.x0() + p_);
+}
+
+void ThermLatticeNode::warn_rest_frame_not_converged(double change) {
+  std::cout << "Warning from solver: max iterations exceeded."
+            << " Accuracy: " << change << " is less than tolerance "
+            << rest_frame_tolerance_ << std::endl;
+}
+
 void ThermLatticeNode::set_rest_frame_quantities(double T0, double mub0,
                                                  double mus0, double muq0,
                                                  const ThreeVector v0) {
@@ -108,8 +135,10 @@ GrandCanThermalizer::GrandCanThermalizer(const std::array<double, 3> lat_sizes,
                                          bool periodicity, double e_critical,
                                          double t_start, double delta_t,
                                          ThermalizationAlgorithm algo,
-                                         bool BF_microcanonical)
-    : eos_typelist_(list_eos_particles()),
+                                         bool BF_microcanonical,
+                                         ThreadPool *thread_pool)
+    : eos_(true, false, thread_pool),
+      eos_typelist_(list_eos_particles()),
       N_sorts_(eos_typelist_.size()),
       e_crit_(e_critical),
       t_start_(t_start),
@@ -124,16 +153,42 @@ GrandCanThermalizer::GrandCanThermalizer(const std::array<double, 3> lat_sizes,
   cells_to_sample_.resize(50000);
   mult_sort_.resize(N_sorts_);
   mult_int_.resize(N_sorts_);
+  previous_solutions_.assign(lat_->size(), {0.0, 0.0, 0.0, 0.0});
 }
 
 void GrandCanThermalizer::update_thermalizer_lattice(
     const std::vector<Particles> &ensembles, const DensityParameters &dens_par,
-    bool ignore_cells_under_treshold) {
+    bool ignore_cells_under_treshold, ThreadPool *thread_pool) {
   const DensityType dens_type = DensityType::Hadron;
   const LatticeUpdate update = LatticeUpdate::EveryFixedInterval;
   update_lattice_accumulating_ensembles(lat_.get(), update, dens_type, dens_par,
-                                        ensembles, false);
-  for (auto &node : *lat_) {
+                                        ensembles, false, thread_pool);
+  const std::size_t n_nodes = lat_->size();
+  if (thread_pool == nullptr || thread_pool->size() < 2) {
+    update_rest_frames(0, n_nodes, ignore_cells_under_treshold, eos_);
+    return;
+  }
+  /* The solver of the equation of state has an internal state, hence every
+   * chunk of nodes uses its own one, while the table of eos_ is only read.
+   * The nodes do not depend on each other and every node starts the solver
+   * from its own previous solution, hence they are the same as in the serial
+   * loop. */
+  const std::size_t n_chunks = thread_pool->size();
+  thread_pool->parallel_for(n_chunks, [&](std::size_t chunk) {
+    HadronGasEos solver_eos(false, eos_.account_for_resonance_widths());
+    update_rest_frames(chunk * n_nodes / n_chunks,
+                       (chunk + 1) * n_nodes / n_chunks,
+                       ignore_cells_under_treshold, solver_eos);
+  });
+}
+
+void GrandCanThermalizer::update_rest_frames(std::size_t begin,
+                                             std::size_t end,
+                                             bool ignore_cells_under_treshold,
+                                             HadronGasEos &solver_eos) {
+  std::vector<std::size_t> iterated;
+  for (std::size_t i = begin; i < end; i++) {
+    ThermLatticeNode &node = (*lat_)[i];
     /* If energy density is definitely below e_crit -
        no need to find T, mu, etc. So if e = T00 - T0i*vi <=
        T00 + sum abs(T0i) < e_crit, no efforts are necessary. */
@@ -141,11 +196,55 @@ void GrandCanThermalizer::update_thermalizer_lattice(
         node.Tmu0().x0() + std::abs(node.Tmu0().x1()) +
                 std::abs(node.Tmu0().x2()) + std::abs(node.Tmu0().x3()) >=
             e_crit_) {
-      node.compute_rest_frame_quantities(eos_);
+      node.v_ = ThreeVector(0.0, 0.0, 0.0);
+      iterated.push_back(i);
     } else {
       node = ThermLatticeNode();
     }
   }
+  /* The nodes are iterated in lockstep, which is the same as iterating every
+   * node by itself with ThermLatticeNode::compute_rest_frame_quantities, but
+   * looks up the table for all nodes of an iteration at once. */
+  std::vector<std::size_t> active = iterated;
+  std::vector<double> changes(active.size());
+  std::vector<double> e(active.size()), nb(active.size()), nq(active.size());
+  std::vector<EosTable::table_element> tabulated(active.size());
+  for (int iter = 0;
+       iter < ThermLatticeNode::max_rest_frame_iterations_ && !active.empty();
+       iter++) {
+    std::size_t n_active = 0;
+    for (std::size_t k = 0; k < active.size(); k++) {
+      ThermLatticeNode &node = (*lat_)[active[k]];
+      const double change = node.update_rest_frame_energy_density();
+      if (change < ThermLatticeNode::rest_frame_tolerance_) {
+        continue;
+      }
+      active[n_active] = active[k];
+      changes[n_active] = change;
+      e[n_active] = node.e_;
+      nb[n_active] = node.rest_frame_nb();
+      nq[n_active] = node.nq_;
+      n_active++;
+    }
+    active.resize(n_active);
+    eos_.from_table(n_active, e.data(), nb.data(), nq.data(),
+                    tabulated.data());
+    for (std::size_t k = 0; k < n_active; k++) {
+      ThermLatticeNode &node = (*lat_)[active[k]];
+      node.update_rest_frame(
+          tabulated[k], solver_eos,
+          iter == 0 ? previous_solutions_[active[k]]
+                    : std::array<double, 4>{node.T_, node.mub_, node.mus_,
+                                            node.muq_});
+    }
+  }
+  for (std::size_t k = 0; k < active.size(); k++) {
+    ThermLatticeNode::warn_rest_frame_not_converged(changes[k]);
+  }
+  for (const std::size_t i : iterated) {
+    const ThermLatticeNode &node = (*lat_)[i];
+    previous_solutions_[i] = {node.T(), node.mub(), node.mus(), node.muq()};
+  }
 }
 
 ThreeVector GrandCanThermalizer::uniform_in_cell() const {
@@ -180,8 +279,9 @@ void GrandCanThermalizer::renormalize_momenta(
 
   double E = 0.0;
   double E_expected = required_total_momentum.abs();
+  const LorentzBoost to_generated_frame(beta_CM_generated);
   for (auto &particle : plist) {
-    particle.boost_momentum(beta_CM_generated);
+    particle.boost_momentum(to_generated_frame);
     E += particle.momentum().x0();
   }
   // Renorm. momenta by factor (1+a) to get the right energy, binary search
@@ -217,10 +317,11 @@ void GrandCanThermalizer::renormalize_momenta(
 
   logg[LGrandcanThermalizer].info("Renormalizing momenta by factor 1+a, a = ",
                                   a);
+  const LorentzBoost to_required_frame(-beta_CM_required);
   for (auto &particle : plist) {
     particle.set_4momentum(particle.type().mass(),
                            (1 + a) * particle.momentum().threevec());
-    particle.boost_momentum(-beta_CM_required);
+    particle.boost_momentum(to_required_frame);
   }
 }
 
@@ -249,30 +350,29 @@ void GrandCanThermalizer::sample_multinomial(HadronClass particle_class,
   }
 }
 
-void GrandCanThermalizer::sample_in_random_cell_BF_algo(ParticleList &plist,
-                                                        const double time,
-                                                        size_t type_index) {
-  N_in_cells_.clear();
-  N_total_in_cells_ = 0.0;
-  for (auto cell_index : cells_to_sample_) {
-    const ThermLatticeNode cell = (*lat_)[cell_index];
-    const double gamma = 1.0 / std::sqrt(1.0 - cell.v().sqr());
-    const double N_this_cell =
-        lat_cell_volume_ * gamma *
-        HadronGasEos::partial_density(*eos_typelist_[type_index], cell.T(),
-                                      cell.mub(), cell.mus(), cell.muq());
-    N_in_cells_.push_back(N_this_cell);
-    N_total_in_cells_ += N_this_cell;
+void GrandCanThermalizer::sample_in_random_cell_BF_algo(
+    ParticleList &plist, const double time, size_t type_index) const {
+  if (mult_int_[type_index] == 0) {
+    return;
+  }
+  const std::size_t n_cells = cells_to_sample_.size();
+  std::vector<double> N_in_cells(n_cells);
+  double N_total_in_cells = 0.0;
+  for (std::size_t k = 0; k < n_cells; k++) {
+    const double N_this_cell = lat_cell_volume_ * cell_gammas_[k] *
+                               cell_densities_[k * N_sorts_ + type_index];
+    N_in_cells[k] = N_this_cell;
+    N_total_in_cells += N_this_cell;
   }
 
   for (int i = 0; i < mult_int_[type_index]; i++) {
     // Choose random cell, probability = N_in_cell/N_total
-    double r = random::uniform(0.0, N_total_in_cells_);
+    double r = random::uniform(0.0, N_total_in_cells);
     double partial_sum = 0.0;
     int index_only_thermalized = -1;
     while (partial_sum < r) {
       index_only_thermalized++;
-      partial_sum += N_in_cells_[index_only_thermalized];
+      partial_sum += N_in_cells[index_only_thermalized];
     }
     const int cell_index = cells_to_sample_[index_only_thermalized];
     const ThermLatticeNode cell = (*lat_)[cell_index];
@@ -296,17 +396,29 @@ void GrandCanThermalizer::sample_in_random_cell_BF_algo(ParticleList &plist,
 }
 
 void GrandCanThermalizer::thermalize_BF_algo(QuantumNumbers &conserved_initial,
-                                             double time, int ntest) {
+                                             double time, int ntest,
+                                             ThreadPool *thread_pool) {
+  /* The densities do not change while sampling, hence they are computed once
+   * for all attempts and species */
+  const std::size_t n_cells = cells_to_sample_.size();
+  cell_gammas_.resize(n_cells);
+  cell_densities_.resize(n_cells * N_sorts_);
+  for_each_cell_to_sample(
+      [&](std::size_t k) {
+        const ThermLatticeNode cell = (*lat_)[cells_to_sample_[k]];
+        cell_gammas_[k] = 1.0 / std::sqrt(1.0 - cell.v().sqr());
+        for (size_t i = 0; i < N_sorts_; i++) {
+          cell_densities_[k * N_sorts_ + i] = HadronGasEos::partial_density(
+              *eos_typelist_[i], cell.T(), cell.mub(), cell.mus(), cell.muq());
+        }
+      },
+      thread_pool);
   std::fill(mult_sort_.begin(), mult_sort_.end(), 0.0);
-  for (auto cell_index : cells_to_sample_) {
-    const ThermLatticeNode cell = (*lat_)[cell_index];
-    const double gamma = 1.0 / std::sqrt(1.0 - cell.v().sqr());
+  for (std::size_t k = 0; k < n_cells; k++) {
     for (size_t i = 0; i < N_sorts_; i++) {
       // N_i = n u^mu dsigma_mu = (isochronous hypersurface) n * V * gamma
-      mult_sort_[i] +=
-          lat_cell_volume_ * gamma * ntest *
-          HadronGasEos::partial_density(*eos_typelist_[i], cell.T(), cell.mub(),
-                                        cell.mus(), cell.muq());
+      mult_sort_[i] += lat_cell_volume_ * cell_gammas_[k] * ntest *
+                       cell_densities_[k * N_sorts_ + i];
     }
   }
 
@@ -318,6 +430,18 @@ void GrandCanThermalizer::thermalize_BF_algo(QuantumNumbers &conserved_initial,
   random::BesselSampler bessel_sampler_B(mult_class(HadronClass::Baryon),
                                          mult_class(HadronClass::Antibaryon),
                                          conserved_initial.baryon_number());
+  /* The multiplicities of the classes are the same in all attempts, only the
+   * strangeness and charge left to the mesons change. Hence, the samplers are
+   * set up once for every difference of the numbers of mesons. */
+  std::map<int, random::BesselSampler> bessel_samplers_S, bessel_samplers_C;
+  auto bessel_sampler = [this](std::map<int, random::BesselSampler> &samplers,
+                               HadronClass positive, HadronClass negative,
+                               int difference) -> random::BesselSampler & {
+    return samplers
+        .try_emplace(difference, mult_class(positive), mult_class(negative),
+                     difference)
+        .first->second;
+  };
 
   while (true) {
     sampled_list_.clear();
@@ -335,11 +459,10 @@ void GrandCanThermalizer::thermalize_BF_algo(QuantumNumbers &conserved_initial,
 
     std::pair<int, int> NS_antiS;
     if (algorithm_ == ThermalizationAlgorithm::BiasedBF) {
-      random::BesselSampler bessel_sampler_S(
-          mult_class(HadronClass::PositiveSMeson),
-          mult_class(HadronClass::NegativeSMeson),
-          conserved_initial.strangeness() - S_sampled);
-      NS_antiS = bessel_sampler_S.sample();
+      NS_antiS = bessel_sampler(bessel_samplers_S, HadronClass::PositiveSMeson,
+                                HadronClass::NegativeSMeson,
+                                conserved_initial.strangeness() - S_sampled)
+                     .sample();
     } else if (algorithm_ == ThermalizationAlgorithm::UnbiasedBF) {
       NS_antiS = std::make_pair(
           random::poisson(mult_class(HadronClass::PositiveSMeson)),
@@ -360,11 +483,11 @@ void GrandCanThermalizer::thermalize_BF_algo(QuantumNumbers &conserved_initial,
 
     std::pair<int, int> NC_antiC;
     if (algorithm_ == ThermalizationAlgorithm::BiasedBF) {
-      random::BesselSampler bessel_sampler_C(
-          mult_class(HadronClass::PositiveQZeroSMeson),
-          mult_class(HadronClass::NegativeQZeroSMeson),
-          conserved_initial.charge() - ch_sampled);
-      NC_antiC = bessel_sampler_C.sample();
+      NC_antiC = bessel_sampler(bessel_samplers_C,
+                                HadronClass::PositiveQZeroSMeson,
+                                HadronClass::NegativeQZeroSMeson,
+                                conserved_initial.charge() - ch_sampled)
+                     .sample();
     } else if (algorithm_ == ThermalizationAlgorithm::UnbiasedBF) {
       NC_antiC = std::make_pair(
           random::poisson(mult_class(HadronClass::PositiveQZeroSMeson)),
@@ -381,8 +504,24 @@ void GrandCanThermalizer::thermalize_BF_algo(QuantumNumbers &conserved_initial,
         HadronClass::ZeroQZeroSMeson,
         random::poisson(mult_class(HadronClass::ZeroQZeroSMeson)));
 
-    for (size_t itype = 0; itype < N_sorts_; itype++) {
-      sample_in_random_cell_BF_algo(sampled_list_, time, itype);
+    if (thread_pool == nullptr || thread_pool->size() < 2) {
+      for (size_t itype = 0; itype < N_sorts_; itype++) {
+        sample_in_random_cell_BF_algo(sampled_list_, time, itype);
+      }
+    } else {
+      // Whichever thread samples a species, it uses the same random numbers
+      const random::Engine::result_type seed = random::advance();
+      std::vector<ParticleList> sampled_species(N_sorts_);
+      thread_pool->parallel_for(N_sorts_, [&](std::size_t itype) {
+        random::Engine species_stream = random::make_stream(
+            seed, random::StreamKind::ThermalizerSpecies, itype);
+        const random::ScopedEngine species_engine(species_stream);
+        sample_in_random_cell_BF_algo(sampled_species[itype], time, itype);
+      });
+      for (const ParticleList &species : sampled_species) {
+        sampled_list_.insert(sampled_list_.end(), species.begin(),
+                             species.end());
+      }
     }
     if (BF_enforce_microcanonical_) {
       double e_tot;
@@ -403,12 +542,12 @@ void GrandCanThermalizer::thermalize_BF_algo(QuantumNumbers &conserved_initial,
 
 void GrandCanThermalizer::thermalize_mode_algo(
     QuantumNumbers &conserved_initial, double time,
-    SpinInteractionType spin_interaction_type) {
+    SpinInteractionType spin_interaction_type, ThreadPool *thread_pool) {
   double energy = 0.0;
   int S_plus = 0, S_minus = 0, B_plus = 0, B_minus = 0, E_plus = 0, E_minus = 0;
   // Mode 1: sample until energy is conserved, take only strangeness < 0
   auto condition1 = [](int, int, int) { return true; };
-  compute_N_in_cells_mode_algo(condition1);
+  compute_N_in_cells_mode_algo(condition1, thread_pool);
   while (conserved_initial.momentum().x0() > energy ||
          S_plus < conserved_initial.strangeness()) {
     ParticleData p = sample_in_random_cell_mode_algo(time, condition1,
@@ -422,7 +561,7 @@ void GrandCanThermalizer::thermalize_mode_algo(
 
   // Mode 2: sample until strangeness is conserved
   auto condition2 = [](int S, int, int) { return (S < 0); };
-  compute_N_in_cells_mode_algo(condition2);
+  compute_N_in_cells_mode_algo(condition2, thread_pool);
   while (S_plus + S_minus > conserved_initial.strangeness()) {
     ParticleData p = sample_in_random_cell_mode_algo(time, condition2,
                                                      spin_interaction_type);
@@ -439,7 +578,7 @@ void GrandCanThermalizer::thermalize_mode_algo(
   QuantumNumbers conserved_remaining =
       conserved_initial - QuantumNumbers(sampled_list_);
   energy = 0.0;
-  compute_N_in_cells_mode_algo(condition3);
+  compute_N_in_cells_mode_algo(condition3, thread_pool);
   while (conserved_remaining.momentum().x0() > energy ||
          B_plus < conserved_remaining.baryon_number()) {
     ParticleData p = sample_in_random_cell_mode_algo(time, condition3,
@@ -453,7 +592,7 @@ void GrandCanThermalizer::thermalize_mode_algo(
 
   // Mode 4: sample non-strange anti-baryons
   auto condition4 = [](int S, int B, int) { return (S == 0) && (B < 0); };
-  compute_N_in_cells_mode_algo(condition4);
+  compute_N_in_cells_mode_algo(condition4, thread_pool);
   while (B_plus + B_minus > conserved_remaining.baryon_number()) {
     ParticleData p = sample_in_random_cell_mode_algo(time, condition4,
                                                      spin_interaction_type);
@@ -468,7 +607,7 @@ void GrandCanThermalizer::thermalize_mode_algo(
   auto condition5 = [](int S, int B, int) { return (S == 0) && (B == 0); };
   conserved_remaining = conserved_initial - QuantumNumbers(sampled_list_);
   energy = 0.0;
-  compute_N_in_cells_mode_algo(condition5);
+  compute_N_in_cells_mode_algo(condition5, thread_pool);
   while (conserved_remaining.momentum().x0() > energy ||
          E_plus < conserved_remaining.charge()) {
     ParticleData p = sample_in_random_cell_mode_algo(time, condition5,
@@ -484,7 +623,7 @@ void GrandCanThermalizer::thermalize_mode_algo(
   auto condition6 = [](int S, int B, int C) {
     return (S == 0) && (B == 0) && (C < 0);
   };
-  compute_N_in_cells_mode_algo(condition6);
+  compute_N_in_cells_mode_algo(condition6, thread_pool);
   while (E_plus + E_minus > conserved_remaining.charge()) {
     ParticleData p = sample_in_random_cell_mode_algo(time, condition6,
                                                      spin_interaction_type);
@@ -501,7 +640,7 @@ void GrandCanThermalizer::thermalize_mode_algo(
   };
   conserved_remaining = conserved_initial - QuantumNumbers(sampled_list_);
   energy = 0.0;
-  compute_N_in_cells_mode_algo(condition7);
+  compute_N_in_cells_mode_algo(condition7, thread_pool);
   while (conserved_remaining.momentum().x0() > energy) {
     ParticleData p = sample_in_random_cell_mode_algo(time, condition7,
                                                      spin_interaction_type);
@@ -510,9 +649,10 @@ void GrandCanThermalizer::thermalize_mode_algo(
   }
 }
 
-void GrandCanThermalizer::thermalize(
-    const Particles &particles, double time, int ntest,
-    SpinInteractionType spin_interaction_type) {
+void GrandCanThermalizer::thermalize(const Particles &particles, double time,
+                                     int ntest,
+                                     SpinInteractionType spin_interaction_type,
+                                     ThreadPool *thread_pool) {
   logg[LGrandcanThermalizer].info("Starting forced thermalization, time ", time,
                                   " fm");
   to_remove_.clear();
@@ -562,10 +702,11 @@ void GrandCanThermalizer::thermalize(
   switch (algorithm_) {
     case ThermalizationAlgorithm::BiasedBF:
     case ThermalizationAlgorithm::UnbiasedBF:
-      thermalize_BF_algo(conserved_initial, time, ntest);
+      thermalize_BF_algo(conserved_initial, time, ntest, thread_pool);
       break;
     case ThermalizationAlgorithm::ModeSampling:
-      thermalize_mode_algo(conserved_initial, time, spin_interaction_type);
+      thermalize_mode_algo(conserved_initial, time, spin_interaction_type,
+                           thread_pool);
       break;
     default:
       throw std::invalid_argument(
@@ -9,6 +9,7 @@
 
 #include "smash/grid.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "smash/algorithms.h"
@@ -118,18 +119,31 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
                   &min_and_length,
               const Particles &particles, double max_interaction_length,
               double timestep_duration, CellNumberLimitation limit,
-              const bool include_unformed_particles, CellSizeStrategy strategy)
-    : length_(min_and_length.second) {
+              const bool include_unformed_particles,
+              CellSizeStrategy strategy) {
+  rebuild(min_and_length, particles, max_interaction_length, timestep_duration,
+          limit, include_unformed_particles, strategy);
+}
+
+template <GridOptions O>
+void Grid<O>::rebuild(
+    const std::pair<std::array<double, 3>, std::array<double, 3>>
+        &min_and_length,
+    const Particles &particles, double max_interaction_length,
+    double timestep_duration, CellNumberLimitation limit,
+    const bool include_unformed_particles, CellSizeStrategy strategy) {
+  length_ = min_and_length.second;
   const auto min_position = min_and_length.first;
   const SizeType particle_count = particles.size();
+  // The storage of the previous build is reused
+  particles_.clear();
 
   // very simple setup for non-periodic boundaries and largest cellsize strategy
   if (O == GridOptions::Normal && strategy == CellSizeStrategy::Largest) {
     number_of_cells_ = {1, 1, 1};
     cell_volume_ = length_[0] * length_[1] * length_[2];
-    cells_.clear();
-    cells_.reserve(1);
-    cells_.emplace_back(particles.copy_to_vector());
+    particles_.insert(particles_.end(), particles.begin(), particles.end());
+    cell_offsets_ = {0, particles_.size()};
     return;
   }
 
@@ -219,19 +233,17 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
     number_of_cells_ = {1, 1, 1};
     cell_volume_ = length_[0] * length_[1] * length_[2];
     if (include_unformed_particles) {
-      cells_.clear();
-      cells_.reserve(1);
-      cells_.emplace_back(particles.copy_to_vector());
+      particles_.insert(particles_.end(), particles.begin(), particles.end());
     } else {
       // filter out the particles that can not interact
-      cells_.resize(1);
-      cells_.front().reserve(particles.size());
+      particles_.reserve(particles.size());
       std::copy_if(particles.begin(), particles.end(),
-                   std::back_inserter(cells_.front()),
+                   std::back_inserter(particles_),
                    [&](const ParticleData &p) {
                      return p.xsec_scaling_factor(timestep_duration) > 0.0;
                    });
     }
+    cell_offsets_ = {0, particles_.size()};
   } else {
     // construct a normal grid
 
@@ -246,8 +258,8 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
 
     // After the grid parameters are determined, we can start placing the
     // particles in cells.
-    cells_.resize(number_of_cells_[0] * number_of_cells_[1] *
-                  number_of_cells_[2]);
+    const SizeType n_cells =
+        number_of_cells_[0] * number_of_cells_[1] * number_of_cells_[2];
 
     // Returns the one-dimensional cell-index from the position vector inside
     // the grid.
@@ -262,14 +274,22 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
           numeric_cast<SizeType>(std::floor(
               (p.position()[3] - min_position[2]) * index_factor[2])));
     };
+    /* First determine the cell of every particle and count the particles per
+     * cell, then copy them in their original order into the ranges of the
+     * cells. */
+    std::vector<SizeType> &cell_of_particle = cell_of_particle_;
+    cell_of_particle.clear();
+    cell_of_particle.reserve(particles.size());
+    cell_offsets_.assign(n_cells + 1, 0);
     for (const auto &p : particles) {
       if (!include_unformed_particles &&
           (p.xsec_scaling_factor(timestep_duration) <= 0.0)) {
+        cell_of_particle.push_back(-1);
         continue;
       }
       const auto idx = cell_index_for(p);
 #ifndef NDEBUG
-      if (idx >= SizeType(cells_.size())) {
+      if (idx >= n_cells) {
         logg[LGrid].fatal(
             SMASH_SOURCE_LOCATION,
             "\nan out-of-bounds access would be necessary for the "
@@ -277,16 +297,38 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
             p,
             "\nfor a grid with the following parameters:\nmin: ", min_position,
             "\nlength: ", length_, "\ncells: ", number_of_cells_,
-            "\nindex_factor: ", index_factor, "\ncells_.size: ", cells_.size(),
+            "\nindex_factor: ", index_factor, "\nnumber of cells: ", n_cells,
             "\nrequested index: ", idx);
         throw std::runtime_error("out-of-bounds grid access on construction");
       }
 #endif
-      cells_[idx].push_back(p);
+      cell_of_particle.push_back(idx);
+      ++cell_offsets_[idx + 1];
+    }
+    for (SizeType idx = 0; idx < n_cells; ++idx) {
+      cell_offsets_[idx + 1] += cell_offsets_[idx];
+    }
+    std::vector<const ParticleData *> &ordered = ordered_;
+    ordered.resize(cell_offsets_.back());
+    std::vector<std::size_t> &next_in_cell = next_in_cell_;
+    next_in_cell.assign(cell_offsets_.begin(), cell_offsets_.end() - 1);
+    std::size_t i = 0;
+    for (const auto &p : particles) {
+      const SizeType idx = cell_of_particle[i++];
+      if (idx >= 0) {
+        ordered[next_in_cell[idx]++] = &p;
+      }
+    }
+    particles_.reserve(ordered.size());
+    for (const ParticleData *p : ordered) {
+      particles_.push_back(*p);
     }
   }
 
-  logg[LGrid].debug(cells_);
+  logg[LGrid].debug("cell offsets: ", cell_offsets_);
+  if constexpr (O == GridOptions::PeriodicBoundaries) {
+    build_ghost_cells();
+  }
 }
 
 template <GridOptions Options>
@@ -302,44 +344,45 @@ static const std::initializer_list<GridBase::SizeType> MINUS_ONE_ZERO_ONE{-1, 0,
                                                                           1};
 
 template <>
-/// Specialization of iterate_cells
-void Grid<GridOptions::Normal>::iterate_cells(
-    const std::function<void(const ParticleList &)> &search_cell_callback,
-    const std::function<void(const ParticleList &, const ParticleList &)>
+/// Specialization of iterate_cells_in_row
+void Grid<GridOptions::Normal>::iterate_cells_in_row(
+    std::size_t row,
+    const std::function<void(ParticleSpan)> &search_cell_callback,
+    const std::function<void(ParticleSpan, ParticleSpan)>
         &neighbor_cell_callback) const {
+  assert(row < number_of_rows());
   std::array<SizeType, 3> search_index;
   SizeType &x = search_index[0];
   SizeType &y = search_index[1];
   SizeType &z = search_index[2];
-  SizeType search_cell_index = 0;
-  for (z = 0; z < number_of_cells_[2]; ++z) {
-    for (y = 0; y < number_of_cells_[1]; ++y) {
-      for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
-        assert(search_cell_index == make_index(search_index));
-        assert(search_cell_index >= 0);
-        assert(search_cell_index < SizeType(cells_.size()));
-        const ParticleList &search = cells_[search_cell_index];
-        search_cell_callback(search);
-
-        const auto &dz_list = z == number_of_cells_[2] - 1 ? ZERO : ZERO_ONE;
-        const auto &dy_list = number_of_cells_[1] == 1 ? ZERO
-                              : y == 0                 ? ZERO_ONE
-                              : y == number_of_cells_[1] - 1
-                                  ? MINUS_ONE_ZERO
-                                  : MINUS_ONE_ZERO_ONE;
-        const auto &dx_list = number_of_cells_[0] == 1 ? ZERO
-                              : x == 0                 ? ZERO_ONE
-                              : x == number_of_cells_[0] - 1
-                                  ? MINUS_ONE_ZERO
-                                  : MINUS_ONE_ZERO_ONE;
-        for (SizeType dz : dz_list) {
-          for (SizeType dy : dy_list) {
-            for (SizeType dx : dx_list) {
-              const auto di = make_index(dx, dy, dz);
-              if (di > 0) {
-                neighbor_cell_callback(search, cells_[search_cell_index + di]);
-              }
-            }
+  y = static_cast<SizeType>(row % number_of_cells_[1]);
+  z = static_cast<SizeType>(row / number_of_cells_[1]);
+  SizeType search_cell_index = make_index(0, y, z);
+
+  const auto &dz_list = z == number_of_cells_[2] - 1 ? ZERO : ZERO_ONE;
+  const auto &dy_list = number_of_cells_[1] == 1 ? ZERO
+                        : y == 0                 ? ZERO_ONE
+                        : y == number_of_cells_[1] - 1
+                            ? MINUS_ONE_ZERO
+                            : MINUS_ONE_ZERO_ONE;
+  for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
+    assert(search_cell_index == make_index(search_index));
+    assert(search_cell_index >= 0);
+    assert(search_cell_index < number_of_cells());
+    const ParticleSpan search = cell(search_cell_index);
+    search_cell_callback(search);
+
+    const auto &dx_list = number_of_cells_[0] == 1 ? ZERO
+                          : x == 0                 ? ZERO_ONE
+                          : x == number_of_cells_[0] - 1
+                              ? MINUS_ONE_ZERO
+                              : MINUS_ONE_ZERO_ONE;
+    for (SizeType dz : dz_list) {
+      for (SizeType dy : dy_list) {
+        for (SizeType dx : dx_list) {
+          const auto di = make_index(dx, dy, dz);
+          if (di > 0) {
+            neighbor_cell_callback(search, cell(search_cell_index + di));
           }
         }
       }
@@ -365,17 +408,18 @@ struct NeighborLookup {
   NeedsToWrap wrap = NeedsToWrap::No;
 };
 
-template <>
-/// Specialization of iterate_cells
-void Grid<GridOptions::PeriodicBoundaries>::iterate_cells(
-    const std::function<void(const ParticleList &)> &search_cell_callback,
-    const std::function<void(const ParticleList &, const ParticleList &)>
-        &neighbor_cell_callback) const {
+template <GridOptions O>
+template <typename SearchVisitor, typename NeighborVisitor>
+void Grid<O>::walk_periodic_row(std::size_t row, SearchVisitor &&visit_search,
+                                NeighborVisitor &&visit_neighbor) const {
+  assert(row < number_of_rows());
   std::array<SizeType, 3> search_index;
   SizeType &x = search_index[0];
   SizeType &y = search_index[1];
   SizeType &z = search_index[2];
-  SizeType search_cell_index = 0;
+  y = static_cast<SizeType>(row % number_of_cells_[1]);
+  z = static_cast<SizeType>(row / number_of_cells_[1]);
+  SizeType search_cell_index = make_index(0, y, z);
 
   // defaults:
   std::array<NeighborLookup, 2> dz_list;
@@ -386,110 +430,215 @@ void Grid<GridOptions::PeriodicBoundaries>::iterate_cells(
   assert(number_of_cells_[1] >= 2);
   assert(number_of_cells_[0] >= 2);
 
-  for (z = 0; z < number_of_cells_[2]; ++z) {
-    dz_list[0].index = z;
-    dz_list[1].index = z + 1;
-    if (dz_list[1].index == number_of_cells_[2]) {
-      dz_list[1].index = 0;
-      // last z in the loop, so no need to reset wrap again
-      dz_list[1].wrap = NeedsToWrap::MinusLength;
+  dz_list[0].index = z;
+  dz_list[1].index = z + 1;
+  if (dz_list[1].index == number_of_cells_[2]) {
+    dz_list[1].index = 0;
+    dz_list[1].wrap = NeedsToWrap::MinusLength;
+  }
+  dy_list[0].index = y;
+  dy_list[1].index = y - 1;
+  dy_list[2].index = y + 1;
+  if (y == 0) {
+    dy_list[1] = dy_list[2];
+    dy_list[2].index = number_of_cells_[1] - 1;
+    dy_list[2].wrap = NeedsToWrap::PlusLength;
+  } else if (dy_list[2].index == number_of_cells_[1]) {
+    dy_list[2].index = 0;
+    dy_list[2].wrap = NeedsToWrap::MinusLength;
+  }
+  for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
+    dx_list[0].index = x;
+    dx_list[1].index = x - 1;
+    dx_list[2].index = x + 1;
+    dx_list[2].wrap = NeedsToWrap::No;
+    if (x == 0) {
+      dx_list[1] = dx_list[2];
+      dx_list[2].index = number_of_cells_[0] - 1;
+      dx_list[2].wrap = NeedsToWrap::PlusLength;
+    } else if (dx_list[2].index == number_of_cells_[0]) {
+      dx_list[2].index = 0;
+      dx_list[2].wrap = NeedsToWrap::MinusLength;
     }
-    for (y = 0; y < number_of_cells_[1]; ++y) {
-      dy_list[0].index = y;
-      dy_list[1].index = y - 1;
-      dy_list[2].index = y + 1;
-      dy_list[2].wrap = NeedsToWrap::No;
-      if (y == 0) {
-        dy_list[1] = dy_list[2];
-        dy_list[2].index = number_of_cells_[1] - 1;
-        dy_list[2].wrap = NeedsToWrap::PlusLength;
-      } else if (dy_list[2].index == number_of_cells_[1]) {
-        dy_list[2].index = 0;
-        dy_list[2].wrap = NeedsToWrap::MinusLength;
+
+    assert(search_cell_index == make_index(search_index));
+    assert(search_cell_index >= 0);
+    assert(search_cell_index < number_of_cells());
+    visit_search(search_cell_index);
+
+    auto virtual_search_index = search_index;
+    ThreeVector wrap_vector = {};  // no change
+    auto current_wrap_vector = wrap_vector;
+
+    for (const auto &dz : dz_list) {
+      if (dz.wrap == NeedsToWrap::MinusLength) {
+        // last dz in the loop, so no need to undo the wrap
+        wrap_vector[2] = -length_[2];
+        virtual_search_index[2] = -1;
       }
-      for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
-        dx_list[0].index = x;
-        dx_list[1].index = x - 1;
-        dx_list[2].index = x + 1;
-        dx_list[2].wrap = NeedsToWrap::No;
-        if (x == 0) {
-          dx_list[1] = dx_list[2];
-          dx_list[2].index = number_of_cells_[0] - 1;
-          dx_list[2].wrap = NeedsToWrap::PlusLength;
-        } else if (dx_list[2].index == number_of_cells_[0]) {
-          dx_list[2].index = 0;
-          dx_list[2].wrap = NeedsToWrap::MinusLength;
+      for (const auto &dy : dy_list) {
+        // only the last dy in dy_list can wrap
+        if (dy.wrap == NeedsToWrap::MinusLength) {
+          wrap_vector[1] = -length_[1];
+          virtual_search_index[1] = -1;
+        } else if (dy.wrap == NeedsToWrap::PlusLength) {
+          wrap_vector[1] = length_[1];
+          virtual_search_index[1] = number_of_cells_[1];
         }
-
-        assert(search_cell_index == make_index(search_index));
-        assert(search_cell_index >= 0);
-        assert(search_cell_index < SizeType(cells_.size()));
-        ParticleList search = cells_[search_cell_index];
-        search_cell_callback(search);
-
-        auto virtual_search_index = search_index;
-        ThreeVector wrap_vector = {};  // no change
-        auto current_wrap_vector = wrap_vector;
-
-        for (const auto &dz : dz_list) {
-          if (dz.wrap == NeedsToWrap::MinusLength) {
-            // last dz in the loop, so no need to undo the wrap
-            wrap_vector[2] = -length_[2];
-            virtual_search_index[2] = -1;
+        for (const auto &dx : dx_list) {
+          // only the last dx in dx_list can wrap
+          if (dx.wrap == NeedsToWrap::MinusLength) {
+            wrap_vector[0] = -length_[0];
+            virtual_search_index[0] = -1;
+          } else if (dx.wrap == NeedsToWrap::PlusLength) {
+            wrap_vector[0] = length_[0];
+            virtual_search_index[0] = number_of_cells_[0];
           }
-          for (const auto &dy : dy_list) {
-            // only the last dy in dy_list can wrap
-            if (dy.wrap == NeedsToWrap::MinusLength) {
-              wrap_vector[1] = -length_[1];
-              virtual_search_index[1] = -1;
-            } else if (dy.wrap == NeedsToWrap::PlusLength) {
-              wrap_vector[1] = length_[1];
-              virtual_search_index[1] = number_of_cells_[1];
-            }
-            for (const auto &dx : dx_list) {
-              // only the last dx in dx_list can wrap
-              if (dx.wrap == NeedsToWrap::MinusLength) {
-                wrap_vector[0] = -length_[0];
-                virtual_search_index[0] = -1;
-              } else if (dx.wrap == NeedsToWrap::PlusLength) {
-                wrap_vector[0] = length_[0];
-                virtual_search_index[0] = number_of_cells_[0];
-              }
-              assert(dx.index >= 0);
-              assert(dx.index < number_of_cells_[0]);
-              assert(dy.index >= 0);
-              assert(dy.index < number_of_cells_[1]);
-              assert(dz.index >= 0);
-              assert(dz.index < number_of_cells_[2]);
-              const auto neighbor_cell_index =
-                  make_index(dx.index, dy.index, dz.index);
-              assert(neighbor_cell_index >= 0);
-              assert(neighbor_cell_index < SizeType(cells_.size()));
-              if (neighbor_cell_index <= make_index(virtual_search_index)) {
-                continue;
-              }
-
-              if (wrap_vector != current_wrap_vector) {
-                logg[LGrid].debug("translating search cell by ",
-                                  wrap_vector - current_wrap_vector);
-                for_each(search, [&](ParticleData &p) {
-                  p = p.translated(wrap_vector - current_wrap_vector);
-                });
-                current_wrap_vector = wrap_vector;
-              }
-              neighbor_cell_callback(search, cells_[neighbor_cell_index]);
-            }
-            virtual_search_index[0] = search_index[0];
-            wrap_vector[0] = 0;
+          assert(dx.index >= 0);
+          assert(dx.index < number_of_cells_[0]);
+          assert(dy.index >= 0);
+          assert(dy.index < number_of_cells_[1]);
+          assert(dz.index >= 0);
+          assert(dz.index < number_of_cells_[2]);
+          const auto neighbor_cell_index =
+              make_index(dx.index, dy.index, dz.index);
+          assert(neighbor_cell_index >= 0);
+          assert(neighbor_cell_index < number_of_cells());
+          if (neighbor_cell_index <= make_index(virtual_search_index)) {
+            continue;
           }
-          virtual_search_index[1] = search_index[1];
-          wrap_vector[1] = 0;
+
+          ThreeVector translation;
+          if (wrap_vector != current_wrap_vector) {
+            translation = wrap_vector - current_wrap_vector;
+            current_wrap_vector = wrap_vector;
+          }
+          visit_neighbor(search_cell_index, neighbor_cell_index, translation,
+                         current_wrap_vector != ThreeVector());
         }
+        virtual_search_index[0] = search_index[0];
+        wrap_vector[0] = 0;
       }
+      virtual_search_index[1] = search_index[1];
+      wrap_vector[1] = 0;
+    }
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::build_ghost_cells() {
+  ghosts_.clear();
+  ghost_offsets_.resize(cell_offsets_.size());
+  /* The translations of a search cell are cumulative, like the ones of a copy
+   * translated along the walk, such that the ghosts have the same positions
+   * as such a copy. */
+  constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+  std::size_t latest_ghost = none;
+  const std::size_t n_rows = number_of_rows();
+  for (std::size_t row = 0; row < n_rows; ++row) {
+    walk_periodic_row(
+        row,
+        [&](SizeType search_cell_index) {
+          ghost_offsets_[search_cell_index] = ghosts_.size();
+          latest_ghost = none;
+        },
+        [&](SizeType search_cell_index, SizeType,
+            const ThreeVector &translation, bool) {
+          if (translation == ThreeVector()) {
+            return;
+          }
+          const std::size_t first = ghosts_.size();
+          const ParticleSpan search = cell(search_cell_index);
+          for (std::size_t i = 0; i < search.size(); i++) {
+            ghosts_.push_back(
+                (latest_ghost == none ? search[i] : ghosts_[latest_ghost + i])
+                    .translated(translation));
+          }
+          latest_ghost = first;
+        });
+  }
+  ghost_offsets_.back() = ghosts_.size();
+}
+
+template <>
+/// Specialization of iterate_cells_in_row
+void Grid<GridOptions::PeriodicBoundaries>::iterate_cells_in_row(
+    std::size_t row,
+    const std::function<void(ParticleSpan)> &search_cell_callback,
+    const std::function<void(ParticleSpan, ParticleSpan)>
+        &neighbor_cell_callback) const {
+  // Number of translations of the current search cell so far
+  std::size_t n_translations = 0;
+  walk_periodic_row(
+      row,
+      [&](SizeType search_cell_index) {
+        search_cell_callback(cell(search_cell_index));
+        n_translations = 0;
+      },
+      [&](SizeType search_cell_index, SizeType neighbor_cell_index,
+          const ThreeVector &translation, bool wrapped) {
+        if (translation != ThreeVector()) {
+          logg[LGrid].debug("translating search cell by ", translation);
+          ++n_translations;
+        }
+        neighbor_cell_callback(
+            wrapped ? ghost(search_cell_index, n_translations)
+                    : cell(search_cell_index),
+            cell(neighbor_cell_index));
+      });
+}
+
+template <GridOptions O>
+void Grid<O>::iterate_tiles(
+    std::size_t max_particles,
+    const std::function<void(const CellTile &)> &tile_callback) const {
+  const std::size_t n_rows = number_of_rows();
+  const std::size_t n_y = number_of_cells_[1];
+  // The particles of the rows [first, last)
+  auto row_particles = [&](std::size_t first, std::size_t last) {
+    last = std::min(last, n_rows);
+    first = std::min(first, last);
+    return cell_offsets_[last * number_of_cells_[0]] -
+           cell_offsets_[first * number_of_cells_[0]];
+  };
+  // The particles of the search rows [first, last) and their neighbor rows
+  auto tile_particles = [&](std::size_t first, std::size_t last) {
+    return row_particles(first, last + 1) +
+           row_particles(std::max(first + n_y - 1, last + 1), last + n_y + 1);
+  };
+  CellTile tile;
+  for (std::size_t first = 0; first < n_rows;) {
+    std::size_t last = first + 1;
+    while (last < n_rows && tile_particles(first, last + 1) <= max_particles) {
+      last++;
+    }
+    const std::size_t begin = cell_offsets_[first * number_of_cells_[0]];
+    const std::size_t end =
+        cell_offsets_[std::min(last + n_y + 1, n_rows) * number_of_cells_[0]];
+    tile.particles = {particles_.data() + begin, end - begin};
+    tile.visits.clear();
+    for (std::size_t row = first; row < last; row++) {
+      iterate_cells_in_row(
+          row,
+          [&tile](ParticleSpan search) {
+            tile.visits.push_back({search, std::nullopt});
+          },
+          [&tile](ParticleSpan search, ParticleSpan neighbors) {
+            tile.visits.push_back({search, neighbors});
+          });
     }
+    tile_callback(tile);
+    first = last;
   }
 }
 
+template void Grid<GridOptions::Normal>::iterate_tiles(
+    std::size_t max_particles,
+    const std::function<void(const CellTile &)> &tile_callback) const;
+template void Grid<GridOptions::PeriodicBoundaries>::iterate_tiles(
+    std::size_t max_particles,
+    const std::function<void(const CellTile &)> &tile_callback) const;
+
 template Grid<GridOptions::Normal>::Grid(
     const std::pair<std::array<double, 3>, std::array<double, 3>>
         &min_and_length,
@@ -502,4 +651,117 @@ template Grid<GridOptions::PeriodicBoundaries>::Grid(
     const Particles &particles, double max_interaction_length,
     double timestep_duration, CellNumberLimitation limit,
     const bool include_unformed_particles, CellSizeStrategy strategy);
+template void Grid<GridOptions::Normal>::rebuild(
+    const std::pair<std::array<double, 3>, std::array<double, 3>>
+        &min_and_length,
+    const Particles &particles, double max_interaction_length,
+    double timestep_duration, CellNumberLimitation limit,
+    const bool include_unformed_particles, CellSizeStrategy strategy);
+template void Grid<GridOptions::PeriodicBoundaries>::rebuild(
+    const std::pair<std::array<double, 3>, std::array<double, 3>>
+        &min_and_length,
+    const Particles &particles, double max_interaction_length,
+    double timestep_duration, CellNumberLimitation limit,
+    const bool include_unformed_particles, CellSizeStrategy strategy);
+
+void NeighborIndex::build(const Particles &particles, double cell_length,
+                          double period) {
+  if (!(cell_length > 0.)) {
+    throw std::invalid_argument(
+        "The cells of a neighbor index need a positive length.");
+  }
+  clear();
+  cell_length_ = cell_length;
+  if (period > 0.) {
+    n_periodic_cells_ = std::max<std::int64_t>(
+        1, static_cast<std::int64_t>(std::floor(period / cell_length)));
+    cell_length_ = period / n_periodic_cells_;
+  }
+  entries_.reserve(particles.size());
+  for (const ParticleData &p : particles) {
+    add({p});
+  }
+}
+
+void NeighborIndex::add(const ParticleList &particles) {
+  if (!is_built()) {
+    return;
+  }
+  for (const ParticleData &p : particles) {
+    const std::size_t i_entry = entries_.size();
+    entries_.push_back(p);
+    latest_entry_[p.id()] = i_entry;
+    cells_[cell_of(p.position().threevec())].push_back(i_entry);
+  }
+}
+
+void NeighborIndex::clear() {
+  cell_length_ = 0.;
+  n_periodic_cells_ = 0;
+  entries_.clear();
+  latest_entry_.clear();
+  cells_.clear();
+}
+
+std::size_t NeighborIndex::memory_usage() const {
+  std::size_t bytes =
+      entries_.capacity() * sizeof(ParticleData) +
+      latest_entry_.size() * sizeof(std::pair<const int, std::size_t>);
+  for (const auto &cell : cells_) {
+    bytes += sizeof(cell) + cell.second.capacity() * sizeof(std::size_t);
+  }
+  return bytes;
+}
+
+std::vector<const ParticleData *> NeighborIndex::neighbors(
+    const Particles &particles, const ParticleList &search_list) const {
+  std::vector<const ParticleData *> found;
+  for (const ParticleData &search : search_list) {
+    const CellIndex center = cell_of(search.position().threevec());
+    CellIndex cell;
+    for (cell[0] = center[0] - 1; cell[0] <= center[0] + 1; cell[0]++) {
+      for (cell[1] = center[1] - 1; cell[1] <= center[1] + 1; cell[1]++) {
+        for (cell[2] = center[2] - 1; cell[2] <= center[2] + 1; cell[2]++) {
+          const auto entries_in_cell = cells_.find(wrapped(cell));
+          if (entries_in_cell == cells_.end()) {
+            continue;
+          }
+          for (const std::size_t i_entry : entries_in_cell->second) {
+            const ParticleData &entry = entries_[i_entry];
+            // Skip copies of removed or since updated particles
+            if (latest_entry_.at(entry.id()) == i_entry &&
+                particles.is_valid(entry)) {
+              found.push_back(&particles.lookup(entry));
+            }
+          }
+        }
+      }
+    }
+  }
+  // Restore the storage order and drop the particles found more than once
+  std::sort(found.begin(), found.end(), std::less<const ParticleData *>());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  return found;
+}
+
+NeighborIndex::CellIndex NeighborIndex::cell_of(const ThreeVector &r) const {
+  CellIndex cell;
+  for (int i = 0; i < 3; i++) {
+    cell[i] = static_cast<std::int64_t>(std::floor(r[i] / cell_length_));
+  }
+  return wrapped(cell);
+}
+
+NeighborIndex::CellIndex NeighborIndex::wrapped(CellIndex cell) const {
+  if (n_periodic_cells_ > 0) {
+    for (std::int64_t &index : cell) {
+      index %= n_periodic_cells_;
+      if (index < 0) {
+        index += n_periodic_cells_;
+      }
+    }
+  }
+  return cell;
+}
+
 }  // namespace smash
@@ -9,14 +9,18 @@
 
 #include "smash/hadgas_eos.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <sstream>
 
 #include "gsl/gsl_sf_bessel.h"
 
 #include "smash/constants.h"
+#include "smash/filelock.h"
 #include "smash/integrate.h"
 #include "smash/interpolation.h"
 #include "smash/logging.h"
@@ -25,19 +29,55 @@
 namespace smash {
 static constexpr int LResonances = LogArea::Resonances::id;
 
+/// Hash of the particles and decay modes for which the tables are cached
+static sha256::Hash eos_cache_hash;
+/// Directory of the cached tables, empty if they are not cached
+static std::filesystem::path eos_cache_path;
+
 EosTable::EosTable(double de, double dnb, double dq, size_t n_e, size_t n_nb,
                    size_t n_q)
-    : de_(de), dnb_(dnb), dq_(dq), n_e_(n_e), n_nb_(n_nb), n_q_(n_q) {
-  table_.resize(n_e_ * n_nb_ * n_q_);
+    : de_(de), dnb_(dnb), dq_(dq), n_e_(n_e), n_nb_(n_nb), n_q_(n_q) {}
+
+void EosTable::set_cache(const sha256::Hash &hash,
+                         const std::filesystem::path &tabulations_path) {
+  eos_cache_hash = hash;
+  eos_cache_path = tabulations_path;
+}
+
+std::string EosTable::cache_file_name(bool account_for_widths) const {
+  std::stringstream parameters;
+  parameters << std::setprecision(17) << de_ << " " << dnb_ << " " << dq_
+             << " " << n_e_ << " " << n_nb_ << " " << n_q_ << " "
+             << account_for_widths;
+  sha256::Context hash_context;
+  hash_context.update(eos_cache_hash.data(), eos_cache_hash.size());
+  hash_context.update(parameters.str());
+  return "hadgas_eos_" + sha256::hash_to_string(hash_context.finalize()) +
+         ".dat";
 }
 
 void EosTable::compile_table(HadronGasEos &eos,
-                             const std::string &eos_savefile_name) {
+                             const std::string &eos_savefile_name,
+                             ThreadPool *thread_pool) {
+  std::string savefile_name = eos_savefile_name;
+  std::unique_ptr<FileLock> lock;
+  if (savefile_name.empty() && eos_cache_path.empty()) {
+    savefile_name = "hadgas_eos.dat";
+  } else if (savefile_name.empty()) {
+    /* Like for the resonance integrals, another process currently storing
+     * the table is waited for, such that its table is read afterwards. */
+    std::filesystem::create_directories(eos_cache_path);
+    lock = std::make_unique<FileLock>(eos_cache_path / "hadgas_eos.lock");
+    if (lock->acquire_or_wait()) {
+      const bool w = eos.account_for_resonance_widths();
+      savefile_name = (eos_cache_path / cache_file_name(w)).string();
+    }
+  }
   bool table_read_success = false, table_consistency = true;
-  if (std::filesystem::exists(eos_savefile_name)) {
-    std::cout << "Reading table from file " << eos_savefile_name << std::endl;
+  if (!savefile_name.empty() && std::filesystem::exists(savefile_name)) {
+    std::cout << "Reading table from file " << savefile_name << std::endl;
     std::ifstream file;
-    file.open(eos_savefile_name, std::ios::in);
+    file.open(savefile_name, std::ios::in);
     file >> de_ >> dnb_ >> dq_;
     file >> n_e_ >> n_nb_ >> n_q_;
     table_.resize(n_e_ * n_nb_ * n_q_);
@@ -98,51 +138,28 @@ finish_consistency_check:
 
   if (!table_read_success || !table_consistency) {
     std::cout << "Compiling an EoS table..." << std::endl;
-    const double ns = 0.0;
-    for (size_t ie = 0; ie < n_e_; ie++) {
-      std::cout << ie << "/" << n_e_ << "\r" << std::flush;
-      const double e = de_ * ie;
-      for (size_t inb = 0; inb < n_nb_; inb++) {
-        const double nb = dnb_ * inb;
-        for (size_t iq = 0; iq < n_q_; iq++) {
-          const double q = dq_ * iq;
-          // It is physically impossible to have energy density > nucleon
-          // mass*nb, therefore eqns have no solutions.
-          if (nb >= e || q >= e) {
-            table_[index(ie, inb, iq)] = {0.0, 0.0, 0.0, 0.0, 0.0};
-            continue;
-          }
-          // Take extrapolated (T, mub, mus, muq) as initial approximation
-          std::array<double, 4> init_approx;
-          if (inb >= 2) {
-            const table_element y = table_[index(ie, inb - 2, iq)];
-            const table_element x = table_[index(ie, inb - 1, iq)];
-            init_approx = {2.0 * x.T - y.T, 2.0 * x.mub - y.mub,
-                           2.0 * x.mus - y.mus, 2.0 * x.muq - y.muq};
-          } else if (iq >= 2) {
-            const table_element y = table_[index(ie, inb, iq - 2)];
-            const table_element x = table_[index(ie, inb, iq - 1)];
-            init_approx = {2.0 * x.T - y.T, 2.0 * x.mub - y.mub,
-                           2.0 * x.mus - y.mus, 2.0 * x.muq - y.muq};
-          } else {
-            init_approx = eos.solve_eos_initial_approximation(e, nb, q);
-          }
-          const std::array<double, 4> res =
-              eos.solve_eos(e, nb, ns, q, init_approx);
-          const double T = res[0];
-          const double mub = res[1];
-          const double mus = res[2];
-          const double muq = res[3];
-          const bool w = eos.account_for_resonance_widths();
-          table_[index(ie, inb, iq)] = {eos.pressure(T, mub, mus, muq, w), T,
-                                        mub, mus, muq};
-        }
+    table_.resize(n_e_ * n_nb_ * n_q_);
+    if (thread_pool == nullptr || thread_pool->size() < 2) {
+      for (size_t ie = 0; ie < n_e_; ie++) {
+        std::cout << ie << "/" << n_e_ << "\r" << std::flush;
+        compile_row(eos, ie);
       }
+    } else {
+      /* The solver has an internal state, hence every row uses its own one.
+       * The rows do not depend on each other, hence the table is the same as
+       * the one compiled serially. */
+      thread_pool->parallel_for(n_e_, [&](std::size_t ie) {
+        HadronGasEos solver_eos(false, eos.account_for_resonance_widths());
+        compile_row(solver_eos, ie);
+      });
+    }
+    if (savefile_name.empty()) {
+      return;
     }
     // Save table to file
-    std::cout << "Saving table to file " << eos_savefile_name << std::endl;
+    std::cout << "Saving table to file " << savefile_name << std::endl;
     std::ofstream file;
-    file.open(eos_savefile_name, std::ios::out);
+    file.open(savefile_name, std::ios::out);
     file << de_ << " " << dnb_ << " " << dq_ << std::endl;
     file << n_e_ << " " << n_nb_ << " " << n_q_ << std::endl;
     file << std::setprecision(7);
@@ -159,13 +176,55 @@ finish_consistency_check:
   }
 }
 
+void EosTable::compile_row(HadronGasEos &eos, size_t ie) {
+  const double ns = 0.0;
+  const double e = de_ * ie;
+  for (size_t inb = 0; inb < n_nb_; inb++) {
+    const double nb = dnb_ * inb;
+    for (size_t iq = 0; iq < n_q_; iq++) {
+      const double q = dq_ * iq;
+      // It is physically impossible to have energy density > nucleon
+      // mass*nb, therefore eqns have no solutions.
+      if (nb >= e || q >= e) {
+        table_[index(ie, inb, iq)] = {0.0, 0.0, 0.0, 0.0, 0.0};
+        continue;
+      }
+      // Take extrapolated (T, mub, mus, muq) as initial approximation
+      std::array<double, 4> init_approx;
+      if (inb >= 2) {
+        const table_element y = table_[index(ie, inb - 2, iq)];
+        const table_element x = table_[index(ie, inb - 1, iq)];
+        init_approx = {2.0 * x.T - y.T, 2.0 * x.mub - y.mub,
+                       2.0 * x.mus - y.mus, 2.0 * x.muq - y.muq};
+      } else if (iq >= 2) {
+        const table_element y = table_[index(ie, inb, iq - 2)];
+        const table_element x = table_[index(ie, inb, iq - 1)];
+        init_approx = {2.0 * x.T - y.T, 2.0 * x.mub - y.mub,
+                       2.0 * x.mus - y.mus, 2.0 * x.muq - y.muq};
+      } else {
+        init_approx = eos.solve_eos_initial_approximation(e, nb, q);
+      }
+      const std::array<double, 4> res =
+          eos.solve_eos(e, nb, ns, q, init_approx);
+      const double T = res[0];
+      const double mub = res[1];
+      const double mus = res[2];
+      const double muq = res[3];
+      const bool w = eos.account_for_resonance_widths();
+      table_[index(ie, inb, iq)] = {eos.pressure(T, mub, mus, muq, w), T,
+                                    mub, mus, muq};
+    }
+  }
+}
+
 void EosTable::get(EosTable::table_element &res, double e, double nb,
                    double q) const {
   const size_t ie = static_cast<size_t>(std::floor(e / de_));
   const size_t inb = static_cast<size_t>(std::floor(nb / dnb_));
   const size_t iq = static_cast<size_t>(std::floor(q / dq_));
 
-  if (ie >= n_e_ - 1 || inb >= n_nb_ - 1 || iq >= n_q_ - 1) {
+  if (table_.empty() || ie >= n_e_ - 1 || inb >= n_nb_ - 1 ||
+      iq >= n_q_ - 1) {
     res = {-1.0, -1.0, -1.0, -1.0, -1.0};
   } else {
     // 1st order interpolation
@@ -194,7 +253,15 @@ void EosTable::get(EosTable::table_element &res, double e, double nb,
   }
 }
 
-HadronGasEos::HadronGasEos(bool tabulate, bool account_for_width)
+void EosTable::get(size_t n, const double *e, const double *nb,
+                   const double *nq, EosTable::table_element *res) const {
+  for (size_t i = 0; i < n; i++) {
+    get(res[i], e[i], nb[i], nq[i]);
+  }
+}
+
+HadronGasEos::HadronGasEos(bool tabulate, bool account_for_width,
+                           ThreadPool *thread_pool)
     : x_(gsl_vector_alloc(n_equations_)),
       tabulate_(tabulate),
       account_for_resonance_widths_(account_for_width) {
@@ -211,7 +278,7 @@ HadronGasEos::HadronGasEos(bool tabulate, bool account_for_width)
         " table will be inconsistent anyways.");
   }
   if (tabulate_) {
-    eos_table_.compile_table(*this);
+    eos_table_.compile_table(*this, "", thread_pool);
   }
 }
 
@@ -503,6 +570,72 @@ double HadronGasEos::e_equation(double T, void *params) {
   return edens - energy_density(T, 0.0, 0.0, 0.0);
 }
 
+double ThermalMassSampler::sample(const ParticleType &ptype) {
+  if (ptype.is_stable()) {
+    return ptype.mass();
+  }
+  const Table &t = table(ptype);
+  const double u = random::uniform(0., t.cdf.back());
+  const size_t i = std::min<size_t>(
+      std::upper_bound(t.cdf.begin(), t.cdf.end(), u) - t.cdf.begin(),
+      n_intervals_);
+  const double dcdf = t.cdf[i] - t.cdf[i - 1];
+  const double fraction = dcdf > 0. ? (u - t.cdf[i - 1]) / dcdf : 0.5;
+  const double theta = t.theta_min + t.dtheta * (i - 1 + fraction);
+  return ptype.mass() + 0.5 * ptype.width_at_pole() * std::tan(theta);
+}
+
+void ThermalMassSampler::prepare(const ParticleType &ptype) {
+  if (!ptype.is_stable()) {
+    table(ptype);
+  }
+}
+
+const ThermalMassSampler::Table &ThermalMassSampler::table(
+    const ParticleType &ptype) {
+  // The types are stored contiguously in the list of all types
+  const size_t index =
+      std::addressof(ptype) - std::addressof(ParticleType::list_all()[0]);
+  if (tables_.size() <= index) {
+    tables_.resize(ParticleType::list_all().size());
+  }
+  if (tables_[index]) {
+    return *tables_[index];
+  }
+  // Same range of masses as in HadronGasEos::sample_mass_thermal
+  const double max_mass = 5.0;  // GeV
+  const double m0 = ptype.mass();
+  const double half_width = 0.5 * ptype.width_at_pole();
+  auto created = std::make_unique<Table>();
+  created->theta_min = std::atan((ptype.min_mass_spectral() - m0) / half_width);
+  created->dtheta =
+      (std::atan((max_mass - m0) / half_width) - created->theta_min) /
+      n_intervals_;
+  std::vector<double> density(n_intervals_ + 1);
+  {
+    // Allow underflows in exponentials
+    DisableFloatTraps guard(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
+    for (size_t i = 0; i <= n_intervals_; i++) {
+      const double theta = created->theta_min + created->dtheta * i;
+      const double cos_theta = std::cos(theta);
+      const double m = m0 + half_width * std::tan(theta);
+      const double thermal_factor =
+          m * m * std::exp(-beta_ * m) * gsl_sf_bessel_Kn_scaled(2, m * beta_);
+      // dm/dtheta = half_width / cos^2(theta)
+      density[i] = ptype.spectral_function(m) * thermal_factor * half_width /
+                   (cos_theta * cos_theta);
+    }
+  }
+  created->cdf.resize(n_intervals_ + 1);
+  created->cdf[0] = 0.0;
+  for (size_t i = 1; i <= n_intervals_; i++) {
+    created->cdf[i] =
+        created->cdf[i - 1] + 0.5 * (density[i - 1] + density[i]);
+  }
+  tables_[index] = std::move(created);
+  return *tables_[index];
+}
+
 std::array<double, 4> HadronGasEos::solve_eos_initial_approximation(double e,
                                                                     double nb,
                                                                     double nq) {
@@ -586,10 +719,51 @@ std::array<double, 4> HadronGasEos::solve_eos_initial_approximation(double e,
 std::array<double, 4> HadronGasEos::solve_eos(
     double e, double nb, double ns, double nq,
     std::array<double, 4> initial_approximation) {
-  int residual_status = GSL_SUCCESS;
   size_t iter = 0;
-
   struct rparams p = {e, nb, ns, nq, account_for_resonance_widths_};
+  const int residual_status = run_solver(p, initial_approximation, iter);
+
+  // Avoiding too low temperature
+  if (gsl_vector_get(solver_->x, 0) < minimal_temperature_) {
+    return {0.0, 0.0, 0.0, 0.0};
+  }
+
+  if (residual_status != GSL_SUCCESS) {
+    std::stringstream solver_parameters;
+    solver_parameters << "\nSolver run with "
+                      << "e = " << e << ", nb = " << nb << ", ns = " << ns
+                      << ", nq = " << nq
+                      << ", init. approx.: " << initial_approximation[0] << " "
+                      << initial_approximation[1] << " "
+                      << initial_approximation[2] << " "
+                      << initial_approximation[3] << std::endl;
+    logg[LResonances].warn(gsl_strerror(residual_status) +
+                           solver_parameters.str() + print_solver_state(iter));
+  }
+
+  return {gsl_vector_get(solver_->x, 0), gsl_vector_get(solver_->x, 1),
+          gsl_vector_get(solver_->x, 2), gsl_vector_get(solver_->x, 3)};
+}
+
+std::array<double, 4> HadronGasEos::solve_eos_warm_start(
+    double e, double nb, double ns, double nq,
+    const std::array<double, 4> &previous_solution) {
+  if (previous_solution[0] >= minimal_temperature_) {
+    size_t iter = 0;
+    struct rparams p = {e, nb, ns, nq, account_for_resonance_widths_};
+    if (run_solver(p, previous_solution, iter) == GSL_SUCCESS &&
+        gsl_vector_get(solver_->x, 0) >= minimal_temperature_) {
+      return {gsl_vector_get(solver_->x, 0), gsl_vector_get(solver_->x, 1),
+              gsl_vector_get(solver_->x, 2), gsl_vector_get(solver_->x, 3)};
+    }
+  }
+  return solve_eos(e, nb, ns, nq);
+}
+
+int HadronGasEos::run_solver(struct rparams &p,
+                             const std::array<double, 4> &initial_approximation,
+                             size_t &iter) {
+  int residual_status = GSL_SUCCESS;
   gsl_multiroot_function f = {&HadronGasEos::set_eos_solver_equations,
                               n_equations_, &p};
 
@@ -604,9 +778,8 @@ std::array<double, 4> HadronGasEos::solve_eos(
     const auto iterate_status = gsl_multiroot_fsolver_iterate(solver_);
     // std::cout << print_solver_state(iter);
 
-    // Avoiding too low temperature
-    if (gsl_vector_get(solver_->x, 0) < 0.015) {
-      return {0.0, 0.0, 0.0, 0.0};
+    if (gsl_vector_get(solver_->x, 0) < minimal_temperature_) {
+      break;
     }
 
     // check if solver is stuck
@@ -615,22 +788,7 @@ std::array<double, 4> HadronGasEos::solve_eos(
     }
     residual_status = gsl_multiroot_test_residual(solver_->f, tolerance_);
   } while (residual_status == GSL_CONTINUE && iter < 1000);
-
-  if (residual_status != GSL_SUCCESS) {
-    std::stringstream solver_parameters;
-    solver_parameters << "\nSolver run with "
-                      << "e = " << e << ", nb = " << nb << ", ns = " << ns
-                      << ", nq = " << nq
-                      << ", init. approx.: " << initial_approximation[0] << " "
-                      << initial_approximation[1] << " "
-                      << initial_approximation[2] << " "
-                      << initial_approximation[3] << std::endl;
-    logg[LResonances].warn(gsl_strerror(residual_status) +
-                           solver_parameters.str() + print_solver_state(iter));
-  }
-
-  return {gsl_vector_get(solver_->x, 0), gsl_vector_get(solver_->x, 1),
-          gsl_vector_get(solver_->x, 2), gsl_vector_get(solver_->x, 3)};
+  return residual_status;
 }
 
 std::string HadronGasEos::print_solver_state(size_t iter) const {
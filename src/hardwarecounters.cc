@@ -0,0 +1,153 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/hardwarecounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <utility>
+#endif
+
+namespace smash {
+
+namespace {
+#ifdef __linux__
+/// The perf events of the counters of one thread
+class CounterGroup {
+ public:
+  /// Open the events, those which fail are left out.
+  CounterGroup() {
+    fds_.fill(-1);
+    constexpr auto cache = [](std::uint64_t id, std::uint64_t result) {
+      return id | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+    };
+    const std::array<std::pair<std::uint32_t, std::uint64_t>,
+                     HardwareCounters::NEvents>
+        events = {{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE,
+             cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+            {PERF_TYPE_HW_CACHE,
+             cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        }};
+    int leader = -1;
+    for (std::size_t i = 0; i < events.size(); i++) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = events[i].first;
+      attr.config = events[i].second;
+      attr.disabled = leader < 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                         PERF_FORMAT_TOTAL_TIME_RUNNING;
+      // The calling thread on any CPU
+      const int fd = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+      if (fd < 0) {
+        continue;
+      }
+      fds_[i] = fd;
+      order_[n_open_++] = i;
+      if (leader < 0) {
+        leader = fd;
+      }
+    }
+    if (leader >= 0) {
+      ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    leader_ = leader;
+  }
+
+  /// Cannot be copied
+  CounterGroup(const CounterGroup &) = delete;
+  /// Cannot be copied
+  CounterGroup &operator=(const CounterGroup &) = delete;
+
+  /// Close the events.
+  ~CounterGroup() {
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  /// \return Which events are counted.
+  std::array<bool, HardwareCounters::NEvents> available() const {
+    std::array<bool, HardwareCounters::NEvents> result;
+    for (std::size_t i = 0; i < fds_.size(); i++) {
+      result[i] = fds_[i] >= 0;
+    }
+    return result;
+  }
+
+  /// \param[out] counts The counts, 0 for unavailable events.
+  void read(HardwareCounters::Counts &counts) const {
+    counts.fill(0);
+    if (leader_ < 0) {
+      return;
+    }
+    // Number of events, time enabled, time running and the values
+    std::array<std::uint64_t, 3 + HardwareCounters::NEvents> data;
+    const ssize_t size = ::read(leader_, data.data(), sizeof(data));
+    if (size < static_cast<ssize_t>((3 + n_open_) * sizeof(std::uint64_t)) ||
+        data[0] != n_open_ || data[2] == 0) {
+      return;
+    }
+    const double scale = static_cast<double>(data[1]) / data[2];
+    for (std::size_t i = 0; i < n_open_; i++) {
+      counts[order_[i]] = static_cast<int64_t>(scale * data[3 + i]);
+    }
+  }
+
+ private:
+  /// The file descriptors of the events, -1 for unavailable ones
+  std::array<int, HardwareCounters::NEvents> fds_;
+  /// The events in the order of the values read from the group
+  std::array<std::size_t, HardwareCounters::NEvents> order_{};
+  /// Number of open events
+  std::size_t n_open_ = 0;
+  /// The file descriptor of the group leader, -1 if no event is available
+  int leader_ = -1;
+};
+
+/// \return The counters of the calling thread, opened on the first call.
+const CounterGroup &thread_counters() {
+  thread_local const CounterGroup counters;
+  return counters;
+}
+#endif
+}  // unnamed namespace
+
+std::array<bool, HardwareCounters::NEvents> HardwareCounters::available() {
+#ifdef __linux__
+  return thread_counters().available();
+#else
+  return {};
+#endif
+}
+
+void HardwareCounters::read(Counts &counts) {
+#ifdef __linux__
+  thread_counters().read(counts);
+#else
+  counts.fill(0);
+#endif
+}
+
+}  // namespace smash
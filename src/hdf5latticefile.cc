@@ -0,0 +1,180 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/hdf5latticefile.h"
+
+#include <hdf5.h>
+
+#include <type_traits>
+
+namespace smash {
+
+static_assert(std::is_same_v<hid_t, std::int64_t>,
+              "The HDF5 identifiers are expected to be 64 bit integers.");
+
+/**
+ * \param[in] id Identifier returned by an HDF5 function.
+ * \param[in] what Description of the operation.
+ * \return The identifier.
+ * \throw std::runtime_error if the identifier signals an error.
+ */
+static hid_t checked(hid_t id, const char *what) {
+  if (id < 0) {
+    throw std::runtime_error(std::string("HDF5 lattice output: cannot ") +
+                             what + ".");
+  }
+  return id;
+}
+
+/**
+ * Attach a one-dimensional attribute to an HDF5 object.
+ *
+ * \param[in] object The object.
+ * \param[in] name Name of the attribute.
+ * \param[in] type HDF5 memory type of the values.
+ * \param[in] values Pointer to the values.
+ * \param[in] n Number of values.
+ */
+static void write_attribute(hid_t object, const char *name, hid_t type,
+                            const void *values, hsize_t n) {
+  const hid_t space = checked(H5Screate_simple(1, &n, nullptr), name);
+  const hid_t attribute = checked(
+      H5Acreate2(object, name, type, space, H5P_DEFAULT, H5P_DEFAULT), name);
+  const herr_t status = H5Awrite(attribute, type, values);
+  H5Aclose(attribute);
+  H5Sclose(space);
+  checked(status, name);
+}
+
+/**
+ * Create a dataset, which is extendible along its first dimension.
+ *
+ * \param[in] file The file.
+ * \param[in] name Name of the dataset.
+ * \param[in] slice Dimensions of one slice along the first dimension.
+ * \param[in] chunk_slices Number of slices per chunk.
+ * \param[in] compression_level Deflate level of the chunks, 0 to disable.
+ * \return The identifier of the dataset.
+ */
+static hid_t create_extendible(hid_t file, const char *name,
+                               const std::vector<std::size_t> &slice,
+                               hsize_t chunk_slices, int compression_level) {
+  std::vector<hsize_t> dims{0}, max_dims{H5S_UNLIMITED}, chunk{chunk_slices};
+  for (std::size_t n : slice) {
+    dims.push_back(n);
+    max_dims.push_back(n);
+    chunk.push_back(n);
+  }
+  const int rank = static_cast<int>(dims.size());
+  const hid_t space =
+      checked(H5Screate_simple(rank, dims.data(), max_dims.data()), name);
+  const hid_t properties = checked(H5Pcreate(H5P_DATASET_CREATE), name);
+  H5Pset_chunk(properties, rank, chunk.data());
+  if (compression_level > 0) {
+    H5Pset_deflate(properties, compression_level);
+  }
+  const hid_t dataset = H5Dcreate2(file, name, H5T_NATIVE_DOUBLE, space,
+                                   H5P_DEFAULT, properties, H5P_DEFAULT);
+  H5Pclose(properties);
+  H5Sclose(space);
+  return checked(dataset, name);
+}
+
+/**
+ * Append one slice to a dataset created by create_extendible().
+ *
+ * \param[in] dataset The dataset.
+ * \param[in] index Index of the new slice.
+ * \param[in] values The values of the slice.
+ */
+static void append_slice(hid_t dataset, hsize_t index, const double *values) {
+  const hid_t old_space = checked(H5Dget_space(dataset), "extend a dataset");
+  const int rank = H5Sget_simple_extent_ndims(old_space);
+  std::vector<hsize_t> dims(rank);
+  H5Sget_simple_extent_dims(old_space, dims.data(), nullptr);
+  H5Sclose(old_space);
+  dims[0] = index + 1;
+  checked(H5Dset_extent(dataset, dims.data()), "extend a dataset");
+  std::vector<hsize_t> start(rank, 0), count = dims;
+  start[0] = index;
+  count[0] = 1;
+  const hid_t space = checked(H5Dget_space(dataset), "extend a dataset");
+  H5Sselect_hyperslab(space, H5S_SELECT_SET, start.data(), nullptr,
+                      count.data(), nullptr);
+  const hid_t memory =
+      checked(H5Screate_simple(rank, count.data(), nullptr), "write data");
+  const herr_t status = H5Dwrite(dataset, H5T_NATIVE_DOUBLE, memory, space,
+                                 H5P_DEFAULT, values);
+  H5Sclose(memory);
+  H5Sclose(space);
+  checked(status, "write data");
+}
+
+Hdf5LatticeFile::Hdf5LatticeFile(const std::filesystem::path &filename,
+                                 const std::string &quantity, int quantity_id,
+                                 double version,
+                                 const std::array<int, 3> &nodes,
+                                 const std::array<double, 3> &spacing,
+                                 const std::array<double, 3> &origin,
+                                 const std::vector<std::size_t> &frame_shape,
+                                 int compression_level)
+    : frame_shape_(frame_shape) {
+  file_ = checked(H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+                            H5P_DEFAULT),
+                  "create the file");
+  try {
+    write_attribute(file_, "version", H5T_NATIVE_DOUBLE, &version, 1);
+    write_attribute(file_, "quantity_id", H5T_NATIVE_INT, &quantity_id, 1);
+    const hid_t string_type = H5Tcopy(H5T_C_S1);
+    H5Tset_size(string_type, quantity.size() + 1);
+    write_attribute(file_, "quantity", string_type, quantity.c_str(), 1);
+    H5Tclose(string_type);
+    write_attribute(file_, "nodes", H5T_NATIVE_INT, nodes.data(), 3);
+    write_attribute(file_, "spacing", H5T_NATIVE_DOUBLE, spacing.data(), 3);
+    write_attribute(file_, "origin", H5T_NATIVE_DOUBLE, origin.data(), 3);
+    data_ =
+        create_extendible(file_, "data", frame_shape_, 1, compression_level);
+    times_ = create_extendible(file_, "time", {}, 64, 0);
+  } catch (const std::runtime_error &) {
+    close();
+    throw;
+  }
+}
+
+Hdf5LatticeFile::~Hdf5LatticeFile() { close(); }
+
+void Hdf5LatticeFile::close() {
+  if (times_ >= 0) {
+    H5Dclose(times_);
+  }
+  if (data_ >= 0) {
+    H5Dclose(data_);
+  }
+  if (file_ >= 0) {
+    H5Fclose(file_);
+  }
+}
+
+void Hdf5LatticeFile::write_frame(double time) {
+  std::size_t size = 1;
+  for (std::size_t n : frame_shape_) {
+    size *= n;
+  }
+  if (frame_.size() != size) {
+    throw std::runtime_error(
+        "HDF5 lattice output: the number of values does not match the "
+        "lattice.");
+  }
+  append_slice(data_, n_frames_, frame_.data());
+  append_slice(times_, n_frames_, &time);
+  n_frames_++;
+  frame_.clear();
+}
+
+}  // namespace smash
@@ -64,6 +64,7 @@ void HepMcInterface::at_eventstart(const Particles& particles,
 
   // Clear event and mapping and set event number
   clear();
+  map_.reserve(particles.size());
 
   // Set header stuff on event
   ion_->impact_parameter = event.impact_parameter;
@@ -9,6 +9,13 @@
 
 #include "smash/hepmcoutput.h"
 
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
 #include "HepMC3/Print.h"
 #include "HepMC3/WriterAscii.h"
 
@@ -16,6 +23,10 @@
 #include "HepMC3/WriterRootTree.h"
 #endif
 
+#ifdef SMASH_USE_ZSTD
+#include <zstd.h>
+#endif
+
 namespace smash {
 // clang-format off
 /*!\Userguide
@@ -181,6 +192,23 @@ namespace smash {
  * In both cases, the HepMC output file ends with the line:
  * _HepMC::Asciiv3-END_EVENT_LISTING_, followed by an empty line.
  *
+ * \subsection output_hepmc_asciiv3_compressed_ Compressed ASCII HepMC Format
+ *
+ * If SMASH was built with zstd, the asciiv3 output can be compressed while it
+ * is written by setting the \ref key_output_particles_compression_level_
+ * "Compression_Level" key of the \key Particles or \key Collisions content
+ * to a positive zstd level. The file then gets the additional extension
+ * \c .zst, e.g. \c SMASH_HepMC_particles.asciiv3.zst, and can be decompressed
+ * with the \c zstd command line tool or read directly with the HepMC3
+ * \c ReaderGZ, if HepMC3 was built with zstd support. The ROOT Tree output is
+ * compressed by ROOT anyway and cannot be compressed further.
+ *
+ * The HepMC events are converted to text and written when they end, which can
+ * take a noticeable fraction of the run time of large events, especially if
+ * the output is compressed. With \ref key_output_asynchronous_writing_
+ * "Asynchronous_Writing" this work is done by a separate thread, while the
+ * next event is already simulated.
+ *
  * \section output_hepmc_root_ ROOT HepMC Format
  *
  * In this case the information about each event is inserted into a ROOT
@@ -251,17 +279,182 @@ namespace smash {
  **/
 
 // clang-format on
+
+#ifdef SMASH_USE_ZSTD
+/**
+ * A file stream, which compresses all characters into one zstd frame. The
+ * characters are collected in a buffer of the size recommended by zstd and
+ * compressed whenever it is full or the stream is flushed.
+ */
+class HepMcOutput::CompressedStream : public std::streambuf {
+ public:
+  /**
+   * Open the file and create the zstd context.
+   *
+   * \param[in] path Path of the file.
+   * \param[in] level The zstd compression level.
+   * \throw std::runtime_error if the file cannot be opened or the context
+   *        cannot be created.
+   */
+  CompressedStream(const std::filesystem::path &path, int level)
+      : file_(path, std::ios::binary),
+        context_(ZSTD_createCCtx()),
+        input_(ZSTD_CStreamInSize()),
+        output_(ZSTD_CStreamOutSize()) {
+    if (!file_ || !context_) {
+      ZSTD_freeCCtx(context_);
+      throw std::runtime_error("Opening the compressed HepMC output " +
+                               path.string() + " failed.");
+    }
+    ZSTD_CCtx_setParameter(context_, ZSTD_c_compressionLevel, level);
+    setp(input_.data(), input_.data() + input_.size());
+    // Errors of the buffer are passed on by the stream
+    stream_.exceptions(std::ios::badbit);
+  }
+  /// A context cannot be copied.
+  CompressedStream(const CompressedStream &) = delete;
+  /// A context cannot be copied.
+  CompressedStream &operator=(const CompressedStream &) = delete;
+  /// Free the context.
+  ~CompressedStream() { ZSTD_freeCCtx(context_); }
+
+  /// \return The stream writing to this buffer.
+  std::ostream &stream() { return stream_; }
+
+  /**
+   * Compress the remaining characters, end the frame and close the file. Later
+   * writes to the stream, e.g. if the HepMC writer is closed again when it is
+   * destroyed, are ignored.
+   *
+   * \throw std::runtime_error if compressing or writing fails.
+   */
+  void finish() {
+    compress(ZSTD_e_end);
+    stream_.exceptions(std::ios::goodbit);
+    stream_.setstate(std::ios::badbit);
+    file_.close();
+    if (!file_) {
+      throw std::runtime_error("Closing the compressed HepMC output failed.");
+    }
+  }
+
+ protected:
+  /**
+   * Compress the full buffer and put the character into the empty one.
+   *
+   * \param[in] c The character, which did not fit into the buffer.
+   * \return Anything but end of file, since a failure throws.
+   */
+  int_type overflow(int_type c) override {
+    compress(ZSTD_e_continue);
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  /// Compress and write everything, which was put into the stream so far.
+  int sync() override {
+    compress(ZSTD_e_flush);
+    file_.flush();
+    return file_ ? 0 : -1;
+  }
+
+ private:
+  /**
+   * Compress the characters in the buffer and write the compressed data to the
+   * file.
+   *
+   * \param[in] mode Whether zstd may keep data, has to flush it or has to end
+   *            the frame.
+   * \throw std::runtime_error if compressing or writing fails.
+   */
+  void compress(ZSTD_EndDirective mode) {
+    ZSTD_inBuffer in{input_.data(), static_cast<std::size_t>(pptr() - pbase()),
+                     0};
+    bool done = false;
+    while (!done) {
+      ZSTD_outBuffer out{output_.data(), output_.size(), 0};
+      const std::size_t remaining =
+          ZSTD_compressStream2(context_, &out, &in, mode);
+      if (ZSTD_isError(remaining)) {
+        throw std::runtime_error("Compressing the HepMC output failed: " +
+                                 std::string(ZSTD_getErrorName(remaining)));
+      }
+      file_.write(output_.data(), static_cast<std::streamsize>(out.pos));
+      if (!file_) {
+        throw std::runtime_error("Writing the compressed HepMC output failed.");
+      }
+      done = (mode == ZSTD_e_continue) ? in.pos == in.size : remaining == 0;
+    }
+    setp(input_.data(), input_.data() + input_.size());
+  }
+
+  /// The compressed file
+  std::ofstream file_;
+  /// The zstd context
+  ZSTD_CCtx *const context_;
+  /// Buffer of the characters, which are not compressed yet
+  std::vector<char> input_;
+  /// Buffer for the compressed data
+  std::vector<char> output_;
+  /// The stream writing to this buffer
+  std::ostream stream_{this};
+};
+#else
+/// Placeholder, compressed outputs are rejected without zstd.
+class HepMcOutput::CompressedStream {
+ public:
+  /// \throw std::logic_error always, since no object may be created.
+  CompressedStream(const std::filesystem::path &, int) {
+    throw std::logic_error("Compressed HepMC output requires zstd.");
+  }
+  /// \throw std::logic_error always, since no object exists.
+  std::ostream &stream() {
+    throw std::logic_error("Compressed HepMC output requires zstd.");
+  }
+  /// Nothing to do, since no object exists.
+  void finish() {}
+};
+#endif
+
 HepMcOutput::HepMcOutput(const std::filesystem::path &path, std::string name,
-                         const bool full_event, std::string HepMC3_output_type)
+                         const bool full_event, std::string HepMC3_output_type,
+                         int compression_level)
     : HepMcInterface(name, full_event),
-      filename_(path / (name + "." + HepMC3_output_type)) {
+      filename_(path / (name + "." + HepMC3_output_type +
+                        (compression_level > 0 ? ".zst" : ""))) {
   filename_unfinished_ = filename_;
   filename_unfinished_ += +".unfinished";
+#ifdef SMASH_USE_ZSTD
+  if (compression_level < 0 || compression_level > ZSTD_maxCLevel()) {
+    throw std::invalid_argument(
+        "The compression level of the HepMC output has to be between 0 and " +
+        std::to_string(ZSTD_maxCLevel()) + ".");
+  }
+#else
+  if (compression_level != 0) {
+    throw std::invalid_argument(
+        "Compressed HepMC output requires SMASH to be built with zstd.");
+  }
+#endif
+  if (compression_level > 0 && HepMC3_output_type != "asciiv3") {
+    throw std::invalid_argument(
+        "Only the HepMC_asciiv3 output can be compressed.");
+  }
 #ifdef SMASH_USE_HEPMC_ROOTIO
   if (HepMC3_output_type == "asciiv3") {
 #endif
-    output_file_ = std::make_unique<HepMC3::WriterAscii>(
-        filename_unfinished_.string(), event_.run_info());
+    if (compression_level > 0) {
+      compressed_stream_ = std::make_unique<CompressedStream>(
+          filename_unfinished_, compression_level);
+      output_file_ = std::make_unique<HepMC3::WriterAscii>(
+          compressed_stream_->stream(), event_.run_info());
+    } else {
+      output_file_ = std::make_unique<HepMC3::WriterAscii>(
+          filename_unfinished_.string(), event_.run_info());
+    }
     output_type_ = asciiv3;
 #ifdef SMASH_USE_HEPMC_ROOTIO
   } else {
@@ -275,6 +468,14 @@ HepMcOutput::~HepMcOutput() {
   logg[LOutput].debug() << "Renaming file " << filename_unfinished_ << " to "
                         << filename_ << std::endl;
   output_file_->close();
+  if (compressed_stream_) {
+    try {
+      compressed_stream_->finish();
+    } catch (const std::exception &e) {
+      logg[LOutput].error("Finishing the HepMC output failed: ", e.what());
+      return;
+    }
+  }
   std::filesystem::rename(filename_unfinished_, filename_);
 }
 
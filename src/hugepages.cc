@@ -0,0 +1,126 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/hugepages.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace smash {
+
+namespace {
+/// Whether huge pages are used for new arrays
+std::atomic<bool> use_huge_pages{false};
+/// Number of mapped arrays, such that other arrays are freed without locking
+std::atomic<std::size_t> n_mappings{0};
+/// Protects the mappings
+std::mutex mappings_mutex;
+/// The sizes of the mapped arrays [bytes]
+std::unordered_map<void *, std::size_t> mappings;
+
+#ifdef __linux__
+/**
+ * Map anonymous memory backed by huge pages.
+ *
+ * \param[in] size The size of the mapping, a multiple of the huge page size.
+ * \return The mapping, or null if huge pages are not available.
+ */
+void *map_huge_pages(std::size_t size) {
+  constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  // Pages reserved for hugetlbfs
+  void *block = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     flags | MAP_HUGETLB, -1, 0);
+  if (block != MAP_FAILED) {
+    return block;
+  }
+  // Transparent huge pages, for which the mapping has to be aligned
+  const std::size_t padded = size + HugePages::page_size;
+  void *padded_block =
+      mmap(nullptr, padded, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (padded_block == MAP_FAILED) {
+    return nullptr;
+  }
+  const auto begin = reinterpret_cast<std::uintptr_t>(padded_block);
+  const std::uintptr_t aligned =
+      (begin + HugePages::page_size - 1) / HugePages::page_size *
+      HugePages::page_size;
+  if (aligned > begin) {
+    munmap(padded_block, aligned - begin);
+  }
+  if (begin + padded > aligned + size) {
+    munmap(reinterpret_cast<void *>(aligned + size),
+           begin + padded - aligned - size);
+  }
+  block = reinterpret_cast<void *>(aligned);
+  // Without transparent huge pages, the mapping is still usable
+  madvise(block, size, MADV_HUGEPAGE);
+  return block;
+}
+#endif
+}  // unnamed namespace
+
+void HugePages::set_enabled(bool enabled) {
+  use_huge_pages.store(enabled, std::memory_order_relaxed);
+}
+
+bool HugePages::enabled() {
+  return use_huge_pages.load(std::memory_order_relaxed);
+}
+
+void *HugePages::allocate(std::size_t size) {
+#ifdef __linux__
+  if (enabled() && size >= page_size) {
+    const std::size_t mapped_size =
+        (size + page_size - 1) / page_size * page_size;
+    if (void *block = map_huge_pages(mapped_size)) {
+      std::lock_guard<std::mutex> lock(mappings_mutex);
+      mappings.emplace(block, mapped_size);
+      n_mappings.fetch_add(1, std::memory_order_relaxed);
+      return block;
+    }
+  }
+#endif
+  return ::operator new(size);
+}
+
+void HugePages::deallocate(void *block) noexcept {
+  if (block == nullptr) {
+    return;
+  }
+#ifdef __linux__
+  if (n_mappings.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(mappings_mutex);
+    const auto mapping = mappings.find(block);
+    if (mapping != mappings.end()) {
+      munmap(block, mapping->second);
+      mappings.erase(mapping);
+      n_mappings.fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+#endif
+  ::operator delete(block);
+}
+
+std::size_t HugePages::mapped_bytes() {
+  std::lock_guard<std::mutex> lock(mappings_mutex);
+  std::size_t bytes = 0;
+  for (const auto &mapping : mappings) {
+    bytes += mapping.second;
+  }
+  return bytes;
+}
+
+}  // namespace smash
@@ -9,6 +9,8 @@
 
 #include "smash/hypersurfacecrossingfinder.h"
 
+#include <algorithm>
+
 #include "smash/fluidizationaction.h"
 #include "smash/logging.h"
 
@@ -16,15 +18,15 @@ namespace smash {
 static constexpr int LHyperSurfaceCrossing = LogArea::HyperSurfaceCrossing::id;
 
 ActionList HyperSurfaceCrossActionsFinder::find_actions_in_cell(
-    const ParticleList &plist, double dt, const double,
+    ParticleSpan plist, double dt, const double,
     const std::vector<FourVector> &beam_momentum) const {
   ActionList actions;
 
+  const double tau_sqr = prop_time_ * prop_time_;
   for (const ParticleData &p : plist) {
-    ParticleData pdata_before_propagation = p;
-    ParticleData pdata_after_propagation = p;  // Will receive updated position
-    double t0 = p.position().x0();
-    double t_end = t0 + dt;  // Time at the end of timestep
+    const FourVector &position_before = p.position();
+    const double t0 = position_before.x0();
+    const double t_end = t0 + dt;  // Time at the end of timestep
 
     // We don't want to remove particles before the nuclei have interacted
     // because those would not yet be part of the newly-created medium.
@@ -35,6 +37,21 @@ ActionList HyperSurfaceCrossActionsFinder::find_actions_in_cell(
       continue;
     }
 
+    /* Only particles in a band of proper time around the hypersurface can
+     * cross it within the time step, which is checked before anything is
+     * propagated. Inside the light cone the proper time grows along the
+     * trajectory, so particles beyond the hypersurface have crossed it already.
+     * Since |v_z| < 1, |z| shrinks by less than dt, which bounds the proper
+     * time reachable at the end of the time step from above. */
+    const double z0 = std::fabs(position_before.x3());
+    if (t0 > z0 && t0 * t0 - z0 * z0 > tau_sqr) {
+      continue;
+    }
+    const double z_end_min = std::max(0.0, z0 - dt);
+    if (t_end * t_end - z_end_min * z_end_min < tau_sqr) {
+      continue;
+    }
+
     // For frozen Fermi motion:
     // Fermi momenta are only applied if particles interact. The particle
     // properties p.velocity() and p.momentum() already contain the values
@@ -49,7 +66,7 @@ ActionList HyperSurfaceCrossActionsFinder::find_actions_in_cell(
     const bool no_prior_interactions =
         (static_cast<uint64_t>(p.id()) <                  // particle from
          static_cast<uint64_t>(beam_momentum.size())) &&  // initial nucleus
-        (p.get_history().collisions_per_particle == 0);
+        (p.collisions_per_particle() == 0);
     ThreeVector v;
     if (no_prior_interactions) {
       const FourVector vbeam = beam_momentum[p.id()];
@@ -61,13 +78,11 @@ ActionList HyperSurfaceCrossActionsFinder::find_actions_in_cell(
     // propagate particles to position where they would be at the end of the
     // time step (after dt)
     const FourVector distance = FourVector(0.0, v * dt);
-    FourVector position = p.position() + distance;
-    position.set_x0(t_end);
-    // update coordinates to the position corresponding to t_end
-    pdata_after_propagation.set_4position(position);
+    FourVector position_after = position_before + distance;
+    position_after.set_x0(t_end);
 
-    bool hypersurface_is_crossed = crosses_hypersurface(
-        pdata_before_propagation, pdata_after_propagation, prop_time_);
+    bool hypersurface_is_crossed =
+        crosses_hypersurface(position_before, position_after, prop_time_);
 
     /*
        If rapidity or transverse momentum cut is to be employed; check if
@@ -101,7 +116,7 @@ ActionList HyperSurfaceCrossActionsFinder::find_actions_in_cell(
     if (hypersurface_is_crossed && is_within_y_cut && is_within_pT_cut) {
       // Get exact coordinates where hypersurface is crossed
       FourVector crossing_position = coordinates_on_hypersurface(
-          pdata_before_propagation, pdata_after_propagation, prop_time_);
+          position_before, position_after, p.velocity(), prop_time_);
 
       double time_until_crossing = crossing_position[0] - t0;
 
@@ -116,31 +131,29 @@ ActionList HyperSurfaceCrossActionsFinder::find_actions_in_cell(
 }
 
 bool HyperSurfaceCrossActionsFinder::crosses_hypersurface(
-    ParticleData &pdata_before_propagation,
-    ParticleData &pdata_after_propagation, const double tau) const {
+    const FourVector &position_before, const FourVector &position_after,
+    const double tau) const {
   bool hypersurface_is_crossed = false;
   const bool t_greater_z_before_prop =
-      (std::fabs(pdata_before_propagation.position().x0()) >
-               std::fabs(pdata_before_propagation.position().x3())
+      (std::fabs(position_before.x0()) > std::fabs(position_before.x3())
            ? true
            : false);
   const bool t_greater_z_after_prop =
-      (std::fabs(pdata_after_propagation.position().x0()) >
-               std::fabs(pdata_after_propagation.position().x3())
+      (std::fabs(position_after.x0()) > std::fabs(position_after.x3())
            ? true
            : false);
 
   if (t_greater_z_before_prop && t_greater_z_after_prop) {
     // proper time before and after propagation
-    const double tau_before = pdata_before_propagation.hyperbolic_time();
-    const double tau_after = pdata_after_propagation.hyperbolic_time();
+    const double tau_before = position_before.tau();
+    const double tau_after = position_after.tau();
 
     if (tau_before <= tau && tau <= tau_after) {
       hypersurface_is_crossed = true;
     }
   } else if (!t_greater_z_before_prop && t_greater_z_after_prop) {
     // proper time after propagation
-    const double tau_after = pdata_after_propagation.hyperbolic_time();
+    const double tau_after = position_after.tau();
     if (tau_after >= tau) {
       hypersurface_is_crossed = true;
     }
@@ -150,15 +163,15 @@ bool HyperSurfaceCrossActionsFinder::crosses_hypersurface(
 }
 
 FourVector HyperSurfaceCrossActionsFinder::coordinates_on_hypersurface(
-    ParticleData &pdata_before_propagation,
-    ParticleData &pdata_after_propagation, const double tau) const {
+    const FourVector &position_before, const FourVector &position_after,
+    const ThreeVector &velocity, const double tau) const {
   // find t and z at start of propagation
-  const double t1 = pdata_before_propagation.position().x0();
-  const double z1 = pdata_before_propagation.position().x3();
+  const double t1 = position_before.x0();
+  const double z1 = position_before.x3();
 
   // find t and z after propagation
-  const double t2 = pdata_after_propagation.position().x0();
-  const double z2 = pdata_after_propagation.position().x3();
+  const double t2 = position_after.x0();
+  const double z2 = position_after.x3();
 
   // find slope and intercept of linear function that describes propagation on
   // straight line
@@ -177,9 +190,8 @@ FourVector HyperSurfaceCrossActionsFinder::coordinates_on_hypersurface(
   assert(!(sol2 >= t1 && sol2 <= t2));
 
   // Propagate to point where hypersurface is crossed
-  const ThreeVector v = pdata_before_propagation.velocity();
-  const FourVector distance = FourVector(0.0, v * (sol1 - t1));
-  FourVector crossing_position = pdata_before_propagation.position() + distance;
+  const FourVector distance = FourVector(0.0, velocity * (sol1 - t1));
+  FourVector crossing_position = position_before + distance;
   crossing_position.set_x0(sol1);
 
   return crossing_position;
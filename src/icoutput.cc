@@ -152,7 +152,7 @@ void ICOutput::at_interaction(const Action &action, const double) {
 
   // Determine if particle is spectator:
   // Fulfilled if particle is initial nucleon, aka has no prior interactions
-  bool is_spectator = particle.get_history().collisions_per_particle == 0;
+  bool is_spectator = particle.collisions_per_particle() == 0;
 
   // write particle data excluding spectators
   if (!is_spectator) {
@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "blockpool.h"
 #include "lattice.h"
 #include "particles.h"
 #include "pauliblocking.h"
@@ -32,7 +33,7 @@ static constexpr int LAction = LogArea::Action::id;
  * wallcrossing or a thermalization.
  * (see derived classes).
  */
-class Action {
+class Action : public PoolAllocated {
  public:
   /**
    * Construct an action object with incoming particles and relative time.
@@ -10,11 +10,15 @@
 #ifndef SRC_INCLUDE_SMASH_ACTIONFINDERFACTORY_H_
 #define SRC_INCLUDE_SMASH_ACTIONFINDERFACTORY_H_
 
+#include <string>
 #include <vector>
 
+#include "action.h"
 #include "clock.h"
 #include "forwarddeclarations.h"
+#include "grid.h"
 #include "lattice.h"
+#include "particledata.h"
 #include "potentials.h"
 
 namespace smash {
@@ -41,7 +45,7 @@ class ActionFinderInterface {
    *         could possibly be executed in this time step.
    */
   virtual ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, const double gcell_vol,
+      ParticleSpan search_list, double dt, const double gcell_vol,
       const std::vector<FourVector> &beam_momentum) const = 0;
   /**
    * Abstract function for finding actions, given two lists of particles,
@@ -58,9 +62,37 @@ class ActionFinderInterface {
    *         could possibly be executed in this time step.
    */
   virtual ActionList find_actions_with_neighbors(
-      const ParticleList &search_list, const ParticleList &neighbors_list,
+      ParticleSpan search_list, ParticleSpan neighbors_list,
       double dt, const std::vector<FourVector> &beam_momentum) const = 0;
 
+  /**
+   * Find the actions of all visits of the cells of a grid tile, see
+   * Grid::iterate_tiles(). By default, find_actions_in_cell() and
+   * find_actions_with_neighbors() are called for each visit, finders may
+   * override this to share work among the cells of the tile.
+   *
+   * \param[in] tile The cells of a block of adjacent rows of the grid
+   * \param[in] dt duration of the current time step [fm]
+   * \param[in] gcell_vol volume of a grid cell [fm^3]
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   *            only necessary for frozen Fermi motion
+   * \param[out] found The actions found for every visit of the tile are
+   *             appended to the list with the same index.
+   */
+  virtual void find_actions_in_tile(
+      const CellTile &tile, double dt, double gcell_vol,
+      const std::vector<FourVector> &beam_momentum,
+      std::vector<ActionList> &found) const {
+    for (std::size_t i = 0; i < tile.visits.size(); i++) {
+      const CellTile::Visit &visit = tile.visits[i];
+      found[i] += visit.neighbors
+                      ? find_actions_with_neighbors(
+                            visit.search, *visit.neighbors, dt, beam_momentum)
+                      : find_actions_in_cell(visit.search, dt, gcell_vol,
+                                             beam_momentum);
+    }
+  }
+
   /**
    * Abstract function for finding actions between a list of particles and
    * the surrounding particles.
@@ -81,6 +113,27 @@ class ActionFinderInterface {
       const ParticleList &search_list, const Particles &surrounding_list,
       double dt, const std::vector<FourVector> &beam_momentum) const = 0;
 
+  /**
+   * Abstract function for finding actions between a list of particles and
+   * some of the surrounding particles, e.g. the ones found in the neighborhood
+   * of the particles with a NeighborIndex.
+   *
+   * \param[in] search_list a list of particles where each particle needs to be
+   *            tested for possible interactions with the surrounding particles
+   * \param[in] surrounding_list the particles that need to be tested against
+   *            particles in search_list for possible interaction, in the
+   *            order in which they are stored
+   * \param[in] dt duration of the current time step [fm]
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   *            only necessary for frozen Fermi motion
+   * \return The function returns a list (std::vector) of Action objects that
+   *         could possibly be executed in this time step.
+   */
+  virtual ActionList find_actions_with_surrounding_particles(
+      const ParticleList &search_list,
+      const std::vector<const ParticleData *> &surrounding_list, double dt,
+      const std::vector<FourVector> &beam_momentum) const = 0;
+
   /**
    * This abstract function finds 'final' actions (for cleaning up at the end
    * of the simulation, e.g. letting the remaining resonances decay).
@@ -89,6 +142,9 @@ class ActionFinderInterface {
    * \return The function returns a list (std::vector) of Action objects.
    */
   virtual ActionList find_final_actions(const Particles &search_list) const = 0;
+
+  /// \return The name of the finder, e.g. in the time profile.
+  virtual std::string name() const = 0;
 };
 
 }  // namespace smash
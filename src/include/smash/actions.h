@@ -7,13 +7,15 @@
 #ifndef SRC_INCLUDE_SMASH_ACTIONS_H_
 #define SRC_INCLUDE_SMASH_ACTIONS_H_
 
-#include <algorithm>
-#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "action.h"
 #include "forwarddeclarations.h"
+#include "particles.h"
 
 namespace smash {
 
@@ -22,65 +24,92 @@ namespace smash {
  *
  * The Actions class abstracts the storage and manipulation of actions.
  *
+ * The actions are ordered by their time of execution, which is stored next to
+ * every action, such that the order can be determined without accessing the
+ * actions themselves. Actions with equal times are returned in the order in
+ * which they were added. Two kinds of queues are available, see ActionQueue:
+ * a binary heap and a calendar queue. Both return the actions in exactly the
+ * same order.
+ *
+ * The calendar queue distributes the actions over buckets of equal width in
+ * time, where the number of buckets is the number of actions at the time the
+ * buckets are laid out. Only the bucket of the earliest actions is kept
+ * sorted, any other bucket is sorted when it is reached. Actions later than
+ * the last bucket are kept aside, and the buckets are laid out anew for them
+ * once all buckets have been emptied. Since the new actions found during the
+ * timestepless propagation are mostly few and close in time to the current
+ * one, inserting and popping them is cheaper than in a heap.
+ *
+ * The queued actions are linked to the ids of their incoming particles. Once
+ * an action has been performed, the actions which became invalid through it
+ * can be removed with invalidate() instead of staying in the queue until they
+ * are reached. Removed actions are marked and skipped, and the queue is
+ * compacted once the marked entries outnumber the queued actions.
+ *
  * \note
  * The Actions object cannot be copied, because it does not make sense
- * semantically. Move semantics make sense and can be implemented when needed.
+ * semantically, but it can be moved.
  */
 class Actions {
  public:
-  /// Default constructor, creating an empty Actions object.
-  Actions() {}
+  /// Default constructor, creating an empty binary heap of actions.
+  Actions() : Actions(ActionQueue::BinaryHeap) {}
+  /**
+   * Creates an empty Actions object.
+   *
+   * \param[in] queue The kind of queue in which the actions are stored.
+   */
+  explicit Actions(ActionQueue queue) : queue_(queue) {}
   /**
    * Creates a new Actions object from an ActionList.
    *
-   * The actions are stored in a heap and not sorted. The entries of
-   * the ActionList are rendered invalid by this constructor.
+   * The actions are stored in a heap or in the buckets of a calendar and not
+   * sorted. The entries of the ActionList are rendered invalid by this
+   * constructor.
    *
    * \param[in] action_list The ActionList from which to construct the Actions
    *                    object
+   * \param[in] queue The kind of queue in which the actions are stored.
    */
-  explicit Actions(ActionList&& action_list) : data_(std::move(action_list)) {
-    std::make_heap(data_.begin(), data_.end(), cmp);
+  explicit Actions(ActionList&& action_list,
+                   ActionQueue queue = ActionQueue::BinaryHeap)
+      : queue_(queue) {
+    insert(std::move(action_list));
   }
 
   /// Cannot be copied
   Actions(const Actions&) = delete;
   /// Cannot be copied
   Actions& operator=(const Actions&) = delete;
+  /// Move constructor, leaving \p other empty.
+  Actions(Actions&& other) noexcept { *this = std::move(other); }
+  /// Move assignment, leaving \p other empty.
+  Actions& operator=(Actions&& other) noexcept;
 
   /// \return whether the list of actions is empty.
-  bool is_empty() const { return data_.empty(); }
+  bool is_empty() const { return size_ == 0; }
 
   /**
    * Return the first action in the list and removes it from the list.
    *
    * \throw RuntimeError if the list is empty.
    */
-  ActionPtr pop() {
-    if (data_.empty()) {
-      throw std::runtime_error("Empty actions list!");
-    }
-    std::pop_heap(data_.begin(), data_.end(), cmp);
-    ActionPtr act = std::move(data_.back());
-    data_.pop_back();
-    return act;
-  }
+  ActionPtr pop();
 
   /// Return time of execution of earliest action
-  double earliest_time() const { return data_.front()->time_of_execution(); }
+  double earliest_time() const {
+    return queue_ == ActionQueue::BinaryHeap ? heap_.front().time
+                                             : buckets_[cursor_].back().time;
+  }
 
   /**
    * Insert a list of actions into this object.
    *
-   * They're inserted at the right places to keep the complete list a heap.
+   * They're inserted at the right places to keep the complete list ordered.
    *
    * \param[in] new_acts The actions that will be inserted.
    */
-  void insert(ActionList&& new_acts) {
-    for (auto& a : new_acts) {
-      insert(std::move(a));
-    }
-  }
+  void insert(ActionList&& new_acts);
 
   /**
    * Insert an action into this container.
@@ -89,48 +118,171 @@ class Actions {
    *
    * \param[in] action The action to insert.
    */
-  void insert(ActionPtr&& action) {
-    data_.push_back(std::move(action));
-    std::push_heap(data_.begin(), data_.end(), cmp);
-  }
+  void insert(ActionPtr&& action);
+
+  /**
+   * Remove the queued actions involving the given particles which are not
+   * valid anymore.
+   *
+   * The time order of the remaining actions is not changed, and the removed
+   * actions would have been found invalid when popped anyway.
+   *
+   * \param[in] particles The particles whose actions are checked, usually the
+   *            incoming particles of a performed action.
+   * \param[in] current The current particles of the ensemble.
+   * \return The number of removed actions.
+   */
+  ActionList::size_type invalidate(const ParticleList& particles,
+                                   const Particles& current);
 
   /// \return Number of actions.
-  ActionList::size_type size() const { return data_.size(); }
+  ActionList::size_type size() const { return size_; }
 
-  /// Delete all actions.
-  void clear() { data_.clear(); }
+  /**
+   * \return The maximal number of entries stored at the same time since the
+   * creation or the last clear(), including the ones of removed actions,
+   * which have not been compacted yet.
+   */
+  ActionList::size_type peak_occupancy() const { return peak_occupancy_; }
 
-  /// \return an iterator to the earliest action.
-  std::vector<ActionPtr>::const_reverse_iterator begin() const {
-    return data_.crbegin();
-  }
+  /// Delete all actions, keeping the kind of queue.
+  void clear();
 
-  /// \return an iterator to the place following the last action.
-  std::vector<ActionPtr>::const_reverse_iterator end() const {
-    return data_.crend();
-  }
+  /**
+   * Drop the entries of the removed actions, even if they do not outnumber
+   * the queued actions, and release the unused storage, e.g. if the memory is
+   * short. Nothing is done for fewer than min_compaction removed entries. The
+   * order of the queued actions is not changed.
+   */
+  void shrink();
+
+  /**
+   * \return An estimate of the memory used by the queue, including the
+   * entries of removed actions and the incoming particles of the stored
+   * actions, but not the further members of the actions [bytes].
+   */
+  std::size_t memory_usage() const;
+
+  /// \return The kind of queue in which the actions are stored.
+  ActionQueue queue() const { return queue_; }
 
  private:
+  /// An action together with the key by which the actions are ordered
+  struct Entry {
+    /// Time of execution of the action [fm]
+    double time;
+    /// Number of actions added before this one, to order equal times
+    std::uint64_t sequence;
+    /// The action
+    ActionPtr action;
+  };
+
   /**
-   * Compare two action pointer such that the maximum is the most recent
-   * action.
+   * Compare two entries such that the maximum is the most recent action.
    *
-   * \param[in] a First action
-   * \param[in] b Second action
+   * \param[in] a First entry
+   * \param[in] b Second entry
    * \return Whether the first action will be executed later than the second.
    */
-  static bool cmp(const ActionPtr& a, const ActionPtr& b) {
-    return a->time_of_execution() > b->time_of_execution();
+  static bool later(const Entry& a, const Entry& b) {
+    return a.time > b.time || (a.time == b.time && a.sequence > b.sequence);
+  }
+
+  /// Minimal number of removed entries for which the queue is compacted
+  static constexpr ActionList::size_type min_compaction = 64;
+
+  /**
+   * \return Whether the action of the stored entry has been removed.
+   *
+   * \param[in] entry The entry still stored in the heap or the calendar.
+   */
+  bool is_removed(const Entry& entry) const {
+    return queued_[entry.sequence] == nullptr;
   }
 
   /**
-   * Dynamic data.
+   * Add an entry for the action without restoring the heap property or the
+   * invariant of the calendar queue, see settle_calendar().
+   *
+   * \param[in] action The action to add.
+   */
+  void add(ActionPtr&& action);
+
+  /**
+   * Drop the entries of removed actions from the front of the queue, such
+   * that the earliest stored entry is a queued action.
+   */
+  void drop_removed_front();
+
+  /**
+   * Drop the entries of all removed actions, if they outnumber the queued
+   * actions.
+   */
+  void compact();
+
+  /// Drop the entries of all removed actions.
+  void drop_removed();
+
+  /**
+   * Put the entry into the bucket of its time, or aside if it is later than
+   * the last bucket.
+   *
+   * \param[in] entry The entry to be put into the calendar.
+   * \param[in] keep_sorted Whether the current bucket has to stay sorted,
+   *            which is not needed while the buckets are laid out.
+   */
+  void put_into_calendar(Entry&& entry, bool keep_sorted);
+
+  /**
+   * Make sure that the current bucket contains the earliest action and is
+   * sorted, if there are any actions at all. The buckets are laid out anew
+   * for the actions put aside, if all buckets are empty.
+   */
+  void settle_calendar();
+
+  /// The kind of queue in which the actions are stored
+  ActionQueue queue_;
+  /// Number of queued actions
+  ActionList::size_type size_ = 0;
+  /// Number of actions added so far, used to order actions with equal times
+  std::uint64_t next_sequence_ = 0;
+  /// Number of stored entries of removed actions
+  ActionList::size_type removed_ = 0;
+  /// Maximal number of stored entries, see peak_occupancy()
+  ActionList::size_type peak_occupancy_ = 0;
+  /**
+   * Every added action by its sequence number, as long as it is queued, or
+   * nullptr once it has been popped or removed
+   */
+  std::vector<const Action*> queued_;
+  /// Sequence numbers of the added actions by the ids of incoming particles
+  std::unordered_map<int, std::vector<std::uint64_t>> links_;
+
+  /**
+   * Entries of the binary heap.
    *
    * Vector is likely the best container type here. Because std::sort requires
    * random access iterators. Any linked data structure (e.g. list) thus
    * requires a less efficient sort algorithm.
    */
-  std::vector<ActionPtr> data_;
+  std::vector<Entry> heap_;
+
+  /**
+   * Buckets of the calendar queue. The current bucket is sorted such that the
+   * earliest action is at its back, the buckets after it are unsorted and the
+   * ones before it are empty.
+   */
+  std::vector<std::vector<Entry>> buckets_;
+  /// Entries later than the last bucket, or not put into any bucket yet
+  std::vector<Entry> pending_;
+  /// Number of entries in the buckets
+  ActionList::size_type entries_in_buckets_ = 0;
+  /// Index of the bucket containing the earliest action
+  std::size_t cursor_ = 0;
+  /// Start of the first bucket [fm]
+  double calendar_start_ = 0.;
+  /// Width in time of every bucket [fm]
+  double bucket_width_ = 1.;
 };
 
 }  // namespace smash
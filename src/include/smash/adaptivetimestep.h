@@ -0,0 +1,100 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_ADAPTIVETIMESTEP_H_
+#define SRC_INCLUDE_SMASH_ADAPTIVETIMESTEP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace smash {
+
+/**
+ * Parameters of the adaptive time step, see
+ * \ref doxypage_input_conf_general_ats.
+ */
+struct AdaptiveTimeStepParameters {
+  /// Smallest allowed time step [fm]
+  double min_timestep;
+  /// Largest allowed time step [fm]
+  double max_timestep;
+  /// Largest factor by which the time step may grow from one step to the next
+  double max_growth_factor;
+  /// Desired number of interactions per particle and time step
+  double interactions_per_particle;
+  /// Desired maximal change of the density on the lattice per time step,
+  /// relative to the maximal density
+  double relative_density_change;
+  /// Fraction of the time scale of the momentum change due to potentials
+  double potentials_safety_factor;
+};
+
+/**
+ * What was observed in one time step, to adapt the duration of the next one.
+ *
+ * Every quantity that is not available, e.g. because potentials are off, is
+ * left at its default value and then does not restrict the time step.
+ */
+struct TimeStepObservation {
+  /// Number of performed interactions, without wall crossings
+  std::uint64_t n_interactions = 0;
+  /// Number of particles in all ensembles
+  std::size_t n_particles = 0;
+  /// Largest change of the density on the lattice, relative to the largest
+  /// density
+  double relative_density_change = 0.;
+  /// Smallest time scale of the momentum change due to potentials [fm]
+  double min_time_scale = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * \ingroup logic
+ * The rule to adapt the time step to the evolution of the system.
+ *
+ * The next time step is the largest one for which the interaction rate, the
+ * change of the density and the momentum change due to potentials, as observed
+ * in the previous time step, stay below the desired amounts. Each
+ * contribution is scaled linearly with the duration. The time step may grow
+ * at most by the given factor per step, which avoids overshooting after a
+ * quiet step, but it shrinks right away. The result is limited by the given
+ * bounds.
+ */
+class AdaptiveTimeStep {
+ public:
+  /**
+   * Create the rule with the given parameters.
+   *
+   * \param[in] parameters Bounds and targets of the time step.
+   * \throw std::invalid_argument if the bounds are not positive or in the
+   *        wrong order, the growth factor is smaller than 1, or any target
+   *        is not positive.
+   */
+  explicit AdaptiveTimeStep(const AdaptiveTimeStepParameters &parameters);
+
+  /**
+   * \return The duration of the next time step [fm].
+   *
+   * \param[in] timestep The duration of the previous time step [fm].
+   * \param[in] observed What was observed in the previous time step.
+   */
+  double next_timestep(double timestep,
+                       const TimeStepObservation &observed) const;
+
+  /// \return The parameters of the rule.
+  const AdaptiveTimeStepParameters &parameters() const { return parameters_; }
+
+ private:
+  /// Bounds and targets of the time step
+  const AdaptiveTimeStepParameters parameters_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_ADAPTIVETIMESTEP_H_
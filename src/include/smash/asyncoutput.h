@@ -0,0 +1,163 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_ASYNCOUTPUT_H_
+#define SRC_INCLUDE_SMASH_ASYNCOUTPUT_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "bufferedoutput.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ * A thread writing the calls of asynchronous outputs.
+ *
+ * The calls are executed one after the other in the order in which they were
+ * pushed, such that every output receives its calls in the original order.
+ * Since a single thread executes the calls of all outputs, libraries used by
+ * several outputs (like ROOT) are never used concurrently.
+ *
+ * The number of pending calls is limited. If the limit is reached, push()
+ * waits until the writer caught up, such that the copied arguments waiting
+ * to be written do not use an unlimited amount of memory.
+ */
+class OutputWriter {
+ public:
+  /// Default maximal number of pending calls
+  static constexpr std::size_t default_max_pending_calls = 256;
+
+  /**
+   * Start the writer thread.
+   *
+   * \param[in] max_pending_calls Maximal number of calls which are pushed but
+   *            not executed yet, it must be positive.
+   * \throw std::invalid_argument if \p max_pending_calls is zero.
+   */
+  explicit OutputWriter(
+      std::size_t max_pending_calls = default_max_pending_calls);
+
+  /// A writer thread cannot be copied.
+  OutputWriter(const OutputWriter &) = delete;
+  /// A writer thread cannot be copied.
+  OutputWriter &operator=(const OutputWriter &) = delete;
+
+  /**
+   * Execute the pending calls and join the writer thread. An exception thrown
+   * by a call which was not passed on by push() or wait() is logged.
+   */
+  ~OutputWriter();
+
+  /**
+   * Append a call to the queue, waiting while the queue is full.
+   *
+   * \param[in] call The call to be executed by the writer thread.
+   * \throw Rethrows an exception thrown by a previous call.
+   */
+  void push(std::function<void()> call);
+
+  /**
+   * Wait until all pushed calls have been executed.
+   *
+   * \throw Rethrows an exception thrown by a previous call.
+   */
+  void wait();
+
+ private:
+  /// Loop run by the writer thread.
+  void work();
+
+  /**
+   * Rethrow the exception of a previous call, if any. The mutex has to be
+   * locked by the caller.
+   */
+  void rethrow_exception();
+
+  /// Maximal number of pending calls
+  const std::size_t max_pending_calls_;
+  /// Mutex protecting all the members below.
+  std::mutex mutex_;
+  /// Signals the writer that a call is available or that it shall stop.
+  std::condition_variable call_available_;
+  /// Signals waiting callers that a call was executed.
+  std::condition_variable call_done_;
+  /// The calls which have not been started yet
+  std::deque<std::function<void()>> calls_;
+  /// Whether the writer is executing a call.
+  bool busy_ = false;
+  /// Whether the writer shall finish.
+  bool stop_ = false;
+  /// The first exception thrown by a call, which was not rethrown yet.
+  std::exception_ptr exception_ = nullptr;
+  /// The writer thread, started after all other members are initialized.
+  std::thread thread_;
+};
+
+/**
+ * \ingroup output
+ * An output passing all calls to another output, which is written by an
+ * OutputWriter thread.
+ *
+ * The arguments are copied in the same way as by a BufferedOutput, which can
+ * be much faster than formatting and writing them. Hence, the simulation can
+ * carry on while the writer thread writes the output. Since the target output
+ * receives the same calls in the same order, its files do not change.
+ *
+ * The output of the forced thermalization cannot be copied. It is written
+ * directly after all pending calls have been executed.
+ */
+class AsyncOutput : public BufferedOutput {
+ public:
+  /**
+   * Take over an output to be written asynchronously.
+   *
+   * \param[in] target The output which is written by the writer thread.
+   * \param[in] writer The writer thread, which has to outlive this object.
+   */
+  AsyncOutput(std::unique_ptr<OutputInterface> target, OutputWriter &writer);
+
+  /// Wait for the pending calls, before the target output is destroyed.
+  ~AsyncOutput() override;
+
+  /**
+   * Write the output of the forced thermalization to the target output, after
+   * all pending calls have been executed.
+   *
+   * \param[in] gc_thermalizer The thermalizer to be written.
+   */
+  void thermodynamics_output(
+      const GrandCanThermalizer &gc_thermalizer) override;
+
+ protected:
+  /**
+   * Pass the call to the writer thread.
+   *
+   * \param[in] call The call, acting on the target output.
+   */
+  void enqueue_output_call(
+      std::function<void(OutputInterface &)> call) override;
+
+ private:
+  /// The output written by the writer thread
+  const std::unique_ptr<OutputInterface> owned_target_;
+  /// The writer thread
+  OutputWriter &writer_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_ASYNCOUTPUT_H_
@@ -0,0 +1,46 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BINARYMERGE_H_
+#define SRC_INCLUDE_SMASH_BINARYMERGE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * Merge the shards of a binary output, which the event threads wrote with
+ * \ref key_output_sharded_writing_ "Sharded_Writing", into one file.
+ *
+ * The events are found by the event indices of the shards and copied without
+ * decoding them, such that the merged file is identical to the one written by
+ * a serial run. The events are ordered by their number and the ensembles of an
+ * event keep their order. An index of the merged file is written next to it.
+ * Incomplete events at the end of a shard, which are not indexed, are left
+ * out.
+ *
+ * \param[in] shards The shards, each with its index next to it.
+ * \param[in] output The merged file.
+ * \return The number of merged event end lines, i.e. of events times
+ *         ensembles.
+ * \throw std::runtime_error if a shard or its index cannot be read, if the
+ *        headers of the shards differ or if an event is found in more than one
+ *        shard.
+ */
+std::size_t merge_binary_shards(
+    const std::vector<std::filesystem::path> &shards,
+    const std::filesystem::path &output);
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BINARYMERGE_H_
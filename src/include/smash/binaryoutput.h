@@ -9,9 +9,13 @@
 
 #ifndef SRC_INCLUDE_SMASH_BINARYOUTPUT_H_
 #define SRC_INCLUDE_SMASH_BINARYOUTPUT_H_
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "file.h"
@@ -36,12 +40,41 @@ class BinaryOutputBase : public OutputInterface {
    * \param[in] mode Is used to determine the file access mode.
    * \param[in] name Name of the output.
    * \param[in] quantities The list of quantities printed to the output.
+   * \param[in] compression_level The zstd compression level of the blocks,
+   *            0 for an uncompressed output.
+   * \param[in] event_index Whether to write the offsets of the events to an
+   *            index file next to the output.
    *
-   * \throw std::invalid_argument if the list of quantities is empty.
+   * \throw std::invalid_argument if the list of quantities is empty or if the
+   *        compression level is invalid or not supported by this build.
    */
   explicit BinaryOutputBase(const std::filesystem::path &path,
                             const std::string &mode, const std::string &name,
-                            const std::vector<std::string> &quantities);
+                            const std::vector<std::string> &quantities,
+                            int compression_level = 0,
+                            bool event_index = false);
+
+  /// Write the last frame of a compressed output.
+  ~BinaryOutputBase() override;
+
+  /**
+   * Write the character introducing a block. In a compressed output, the
+   * current frame is written beforehand if it is too large already, such that
+   * every frame contains complete blocks only.
+   *
+   * \param[in] block_type The character identifying the block.
+   */
+  void begin_block(const char block_type);
+
+  /**
+   * Write the event end line and flush the output to disk. In a compressed
+   * output, the blocks of the event are compressed and written as one frame.
+   * If requested, the event is added to the index file.
+   *
+   * \param[in] event_label Numbers of the event and the ensemble.
+   * \param[in] event Information about the event.
+   */
+  void write_event_end(const EventLabel &event_label, const EventInfo &event);
 
   /**
    * Write several bytes to the binary output. Meant to be used by the
@@ -79,25 +112,19 @@ class BinaryOutputBase : public OutputInterface {
    * Write integer (32 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::int32_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::int32_t x) { write_bytes(&x, sizeof(x)); }
 
   /**
    * Write unsigned integer (32 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::uint32_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::uint32_t x) { write_bytes(&x, sizeof(x)); }
 
   /**
    * Write unsigned integer (16 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::uint16_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::uint16_t x) { write_bytes(&x, sizeof(x)); }
 
   /**
    * Write a std::size_t to binary output.
@@ -123,16 +150,63 @@ class BinaryOutputBase : public OutputInterface {
    */
   void write_particledata(const ParticleData &p);
 
+  /**
+   * \param[in] p Particle data to be formatted.
+   * \return The particle line, as it would be written to the binary output.
+   */
+  ToBinary::type particle_line(const ParticleData &p) const {
+    return formatter_.single_particle_data(p);
+  }
+
   /// Binary particles output file path
   RenamingFilePtr file_;
 
  private:
+  /// The zstd compression of the frames, defined in the translation unit
+  struct FrameCompressor;
+
+  /**
+   * Write raw bytes to the file or, in a compressed output, to the current
+   * frame.
+   *
+   * \param[in] data The bytes to be written.
+   * \param[in] size The number of bytes.
+   */
+  void write_bytes(const void *data, std::size_t size) {
+    if (compressor_) {
+      const char *bytes = static_cast<const char *>(data);
+      frame_.insert(frame_.end(), bytes, bytes + size);
+    } else {
+      std::fwrite(data, size, 1, file_.get());
+    }
+  }
+
+  /// Compress the current frame and write it to the file.
+  void write_frame();
+
   /// Binary file format version number
   const uint16_t format_version_ = 10;
+  /// Binary file format version number of compressed files
+  const uint16_t format_version_compressed_ = 11;
+  /// Format version number of the index files
+  const uint16_t index_version_ = 1;
+  /**
+   * Size [bytes] above which a frame is written before the next block, even if
+   * the event did not end yet
+   */
+  static constexpr std::size_t max_frame_size_ = 1 << 26;
   /// Format variant number associated to the custom quantities case
   const uint16_t format_custom_ = 2;
   /// The output formatter
   OutputFormatter<ToBinary> formatter_;
+  /// The compressor of the frames, only set for a compressed output
+  std::unique_ptr<FrameCompressor> compressor_;
+  /// The blocks of the current frame, which are not compressed yet
+  std::vector<char> frame_;
+  /// The index file, only set if requested
+  std::unique_ptr<RenamingFilePtr> index_file_;
+  /// Offset [bytes] in the output file at which the current event starts
+  std::uint64_t event_offset_ = 0;
 };
 
 /**
@@ -156,10 +230,14 @@ class BinaryOutputCollisions : public BinaryOutputBase {
    * \param[in] name Name of the output.
    * \param[in] out_par A structure containing parameters of the output.
    * \param[in] quantities The list of quantities printed to the output.
+   * \param[in] shard Number of the shard written by an event thread, see
+   *            \ref key_output_sharded_writing_ "Sharded_Writing", or -1 if
+   *            the output is written to a single file. Shards are indexed.
    */
   BinaryOutputCollisions(const std::filesystem::path &path, std::string name,
                          const OutputParameters &out_par,
-                         const std::vector<std::string> &quantities);
+                         const std::vector<std::string> &quantities,
+                         int shard = -1);
 
   /**
    * Writes the initial particle information list of an event to the binary
@@ -189,9 +267,42 @@ class BinaryOutputCollisions : public BinaryOutputBase {
    */
   void at_interaction(const Action &action, const double density) override;
 
+  /// \return The event and interaction hooks, in which this output writes.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet().set(EventHooks).set(InteractionHooks);
+  }
+
  private:
+  /**
+   * Write the lines of the particles of an event start or end and keep them
+   * for the references of the incoming particles.
+   *
+   * \param[in] particles Current list of particles.
+   * \param[in] event_label Numbers of event and ensemble.
+   */
+  void write_particles_block(const Particles &particles,
+                             const EventLabel &event_label);
+
+  /**
+   * Write an interaction block, in which the incoming particles, whose lines
+   * follow from the kept ones by free streaming, are referenced by their ID.
+   *
+   * \param[in] action Action that holds the information of the interaction.
+   * \param[in] density Density at the interaction point.
+   */
+  void write_compact_interaction(const Action &action, double density);
+
   /// Write initial and final particles additonally to collisions?
   bool print_start_end_;
+  /// Whether the incoming particles are referenced by their ID
+  bool reference_incoming_;
+  /**
+   * The last written particle lines by their ID, as a reader keeps them,
+   * until the particles are incoming or the event ends
+   */
+  std::unordered_map<std::int32_t, ToBinary::type> known_lines_;
+  /// Buffer of the incoming particle lines of a compact interaction
+  ToBinary::type incoming_lines_;
 };
 
 /**
@@ -218,10 +329,14 @@ class BinaryOutputParticles : public BinaryOutputBase {
    * \param[in] name Name of the ouput.
    * \param[in] out_par A structure containing the parameters of the output.
    * \param[in] quantities The list of quantities printed to the output.
+   * \param[in] shard Number of the shard written by an event thread, see
+   *            \ref key_output_sharded_writing_ "Sharded_Writing", or -1 if
+   *            the output is written to a single file. Shards are indexed.
    */
   BinaryOutputParticles(const std::filesystem::path &path, std::string name,
                         const OutputParameters &out_par,
-                        const std::vector<std::string> &quantities);
+                        const std::vector<std::string> &quantities,
+                        int shard = -1);
 
   /**
    * Writes the initial particle information of an event to the binary output.
@@ -255,9 +370,56 @@ class BinaryOutputParticles : public BinaryOutputBase {
                             const EventLabel &event_label,
                             const EventInfo &event) override;
 
+  /// \return The event and intermediate time hooks, in which this output
+  /// writes.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet().set(EventHooks).set(IntermediateTimeHooks);
+  }
+
  private:
+  /**
+   * Write a block with all particles. With delta encoding, the particles are
+   * stored as the state of the ensemble, from which the next delta block
+   * starts.
+   *
+   * \param[in] particles Current list of particles.
+   * \param[in] event_label Numbers of event and ensemble.
+   */
+  void write_particles_block(const Particles &particles,
+                             const EventLabel &event_label);
+
+  /**
+   * Write a delta block with the particles which were created, removed or
+   * changed otherwise than by free streaming since the previous block of the
+   * ensemble.
+   *
+   * \param[in] particles Current list of particles.
+   * \param[in] event_label Numbers of event and ensemble.
+   * \param[in] time The current time [fm].
+   */
+  void write_delta_block(const Particles &particles,
+                         const EventLabel &event_label, double time);
+
+  /// A particle line as a reader reconstructs it from the blocks
+  struct DeltaLine {
+    /// The particle line
+    ToBinary::type line;
+    /// Whether the particle is in the current list
+    bool present;
+  };
+
   /// Whether final- or initial-state particles should be written.
   OutputOnlyFinal only_final_;
+  /// Whether the intermediate particle lists are written as delta blocks
+  bool delta_encoding_;
+  /**
+   * The particle lines of every ensemble by their ID, as a reader
+   * reconstructs them after the previous block
+   */
+  std::map<std::int32_t, std::unordered_map<std::int32_t, DeltaLine>>
+      delta_states_;
+  /// Buffer of the particle lines of a delta block
+  ToBinary::type delta_lines_;
 };
 
 /**
@@ -281,20 +443,28 @@ class BinaryOutputInitialConditions : public BinaryOutputBase {
    * \param[in] path Output path.
    * \param[in] name Name of the ouput.
    * \param[in] quantities The list of quantities printed to the output.
+   * \param[in] slab_width Width [fm] of the time slabs, in which the particles
+   *            crossing the hypersurface are collected, 0 to write every
+   *            crossing at once. With slabs, a slab index is written next to
+   *            the output.
+   *
+   * \throw std::invalid_argument if the slab width is negative.
    */
   BinaryOutputInitialConditions(const std::filesystem::path &path,
                                 std::string name,
-                                const std::vector<std::string> &quantities);
+                                const std::vector<std::string> &quantities,
+                                double slab_width = 0.0);
 
   /**
-   * Writes the initial particle information of an event to the binary output.
-   * Function unused for IC output. Needed since inherited.
+   * Remember the numbers of the event, which are written to the slab index.
+   * \param[in] event_label Number of event and ensemble.
    */
-  void at_eventstart(const Particles &, const EventLabel &,
+  void at_eventstart(const Particles &, const EventLabel &event_label,
                      const EventInfo &) override;
 
   /**
    * Writes the final particle information of an event to the binary output.
+   * The last slab of the event is written before.
    * \param[in] particles Current list of particles.
    * \param[in] event_label Number of event and ensemble.
    * \param[in] event Event info, see \ref event_info
@@ -302,13 +472,43 @@ class BinaryOutputInitialConditions : public BinaryOutputBase {
   void at_eventend(const Particles &particles, const EventLabel &event_label,
                    const EventInfo &event) override;
 
+  /**
+   * Writes the current slab if the given time is beyond its end, such that a
+   * slab is completed even if no later particle crosses the hypersurface.
+   * \param[in] clock The clock of the event.
+   */
+  void at_intermediate_time(const Particles &,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &, const EventLabel &,
+                            const EventInfo &) override;
+
   /**
    * Writes particles that are removed when crossing the hypersurface to the
    * output. Note that the particle information is written as a particle block,
-   * not as an interaction block.
+   * not as an interaction block. With slabs, the particles are collected until
+   * the slab is completed.
    * \param[in] action Action that holds the information of the interaction.
    */
   void at_interaction(const Action &action, const double) override;
+
+ private:
+  /**
+   * Write the particles of the current slab as one particle block, flush the
+   * output and add the slab to the slab index. Nothing is written for an
+   * empty slab.
+   */
+  void write_slab();
+
+  /// Width [fm] of the time slabs, 0 without slabs
+  const double slab_width_;
+  /// Numbers of the current event and ensemble
+  EventLabel event_label_{0, 0};
+  /// Number of the current slab, counted from time 0
+  std::int64_t slab_number_ = 0;
+  /// The particles of the current slab, which are not written yet
+  ParticleList slab_;
+  /// The slab index file, only set with slabs
+  std::unique_ptr<RenamingFilePtr> slab_index_;
 };
 
 /**
@@ -321,13 +521,16 @@ class BinaryOutputInitialConditions : public BinaryOutputBase {
  * \param[in] content The output content as string, e.g. \c "Particles"
  * \param[in] path The path to the output directory
  * \param[in] out_par The output parameters object containing output metadata
+ * \param[in] shard Number of the shard written by an event thread or -1, see
+ *            BinaryOutputParticles.
  *
  * \return A \c std::unique_ptr<OutputInterface> polymorphically initialised to
  * the correct binary output object.
  */
 std::unique_ptr<OutputInterface> create_binary_output(
     const std::string &format, const std::string &content,
-    const std::filesystem::path &path, const OutputParameters &out_par);
+    const std::filesystem::path &path, const OutputParameters &out_par,
+    int shard = -1);
 
 }  // namespace smash
 
@@ -0,0 +1,632 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BINARYREADER_H_
+#define SRC_INCLUDE_SMASH_BINARYREADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "smash/threadpool.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * A SMASH binary particles or collisions output, which is mapped into memory
+ * to be read by an analysis, see \ref doxypage_output_binary for the format.
+ *
+ * The events are found when the file is opened. If the event index
+ * \c <file>.idx written with \ref key_output_particles_event_index_
+ * "Event_Index" exists, they are taken from it without reading the file.
+ * Otherwise, the block headers of the file are read once. Blocks after the
+ * last event end line belong to an incomplete event and are left out, such
+ * that also the file of an unfinished run can be read.
+ *
+ * Nothing is copied from the file: the blocks and particle lines are read
+ * in place, when they are accessed, and stay valid as long as the reader.
+ * This class is also built as the library \c smash_binary_reader, which
+ * depends only on the C++ standard library and POSIX, such that analyses
+ * can read the outputs without linking SMASH. Compressed outputs cannot be
+ * mapped and are rejected.
+ */
+class BinaryReader {
+ public:
+  /// Size of an OSCAR 2013 particle line in bytes
+  static constexpr std::size_t oscar2013_line_size = 84;
+  /// Size of an extended OSCAR 2013 particle line in bytes
+  static constexpr std::size_t oscar2013_extended_line_size = 136;
+
+  /**
+   * A particle line of the file. The getters of the quantities are valid
+   * for OSCAR 2013 and, with the extended ones, for extended OSCAR 2013
+   * lines. Custom lines are read with get().
+   */
+  class Particle {
+   public:
+    /// \param[in] line Begin of the line in the file.
+    explicit Particle(const char *line) : line_(line) {}
+
+    /**
+     * \tparam T Type of the quantity.
+     * \param[in] offset Position of the quantity in the line in bytes.
+     * \return The quantity.
+     */
+    template <typename T>
+    T get(std::size_t offset) const {
+      T value;
+      // The lines are not aligned
+      std::memcpy(&value, line_ + offset, sizeof(T));
+      return value;
+    }
+
+    /// \return Begin of the line in the file.
+    const char *data() const { return line_; }
+
+    /// \return Time [fm]
+    double t() const { return get<double>(0); }
+    /// \return x coordinate [fm]
+    double x() const { return get<double>(8); }
+    /// \return y coordinate [fm]
+    double y() const { return get<double>(16); }
+    /// \return z coordinate [fm]
+    double z() const { return get<double>(24); }
+    /// \return Mass [GeV]
+    double mass() const { return get<double>(32); }
+    /// \return Energy [GeV]
+    double p0() const { return get<double>(40); }
+    /// \return x component of the momentum [GeV]
+    double px() const { return get<double>(48); }
+    /// \return y component of the momentum [GeV]
+    double py() const { return get<double>(56); }
+    /// \return z component of the momentum [GeV]
+    double pz() const { return get<double>(64); }
+    /// \return PDG code
+    std::int32_t pdg() const { return get<std::int32_t>(72); }
+    /// \return Id of the particle
+    std::int32_t id() const { return get<std::int32_t>(76); }
+    /// \return Charge
+    std::int32_t charge() const { return get<std::int32_t>(80); }
+    /// \return Number of collisions of an extended line
+    std::int32_t n_collisions() const { return get<std::int32_t>(84); }
+    /// \return Formation time of an extended line [fm]
+    double formation_time() const { return get<double>(88); }
+    /// \return Cross section scaling factor of an extended line
+    double xsec_scaling_factor() const { return get<double>(96); }
+    /// \return Id of the process which created the particle of an extended
+    ///         line
+    std::int32_t process_id_origin() const { return get<std::int32_t>(104); }
+    /// \return Type of the process which created the particle of an extended
+    ///         line
+    std::int32_t process_type_origin() const {
+      return get<std::int32_t>(108);
+    }
+    /// \return Time of the last collision of an extended line [fm]
+    double time_last_collision() const { return get<double>(112); }
+    /// \return PDG code of the first mother of an extended line
+    std::int32_t pdg_mother1() const { return get<std::int32_t>(120); }
+    /// \return PDG code of the second mother of an extended line
+    std::int32_t pdg_mother2() const { return get<std::int32_t>(124); }
+    /// \return Baryon number of an extended line
+    std::int32_t baryon_number() const { return get<std::int32_t>(128); }
+    /// \return Strangeness of an extended line
+    std::int32_t strangeness() const { return get<std::int32_t>(132); }
+
+   private:
+    /// Begin of the line in the file
+    const char *line_;
+  };
+
+  /// Consecutive particle lines of the file
+  class Particles {
+   public:
+    /// Iterator over the lines
+    class iterator {
+     public:
+      /// \cond
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Particle;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = Particle;
+      /// \endcond
+
+      /**
+       * \param[in] line Begin of the line.
+       * \param[in] line_size Size of a line in bytes.
+       */
+      iterator(const char *line, std::size_t line_size)
+          : line_(line), line_size_(line_size) {}
+      /// \return The line.
+      Particle operator*() const { return Particle(line_); }
+      /// Step to the next line. \return This iterator.
+      iterator &operator++() {
+        line_ += line_size_;
+        return *this;
+      }
+      /// \param[in] other Iterator. \return Whether both are equal.
+      bool operator==(const iterator &other) const {
+        return line_ == other.line_;
+      }
+      /// \param[in] other Iterator. \return Whether both differ.
+      bool operator!=(const iterator &other) const {
+        return line_ != other.line_;
+      }
+
+     private:
+      /// Begin of the current line
+      const char *line_;
+      /// Size of a line in bytes
+      std::size_t line_size_;
+    };
+
+    /// No lines
+    Particles() = default;
+    /**
+     * \param[in] begin Begin of the first line.
+     * \param[in] size Number of lines.
+     * \param[in] line_size Size of a line in bytes.
+     */
+    Particles(const char *begin, std::size_t size, std::size_t line_size)
+        : begin_(begin), size_(size), line_size_(line_size) {}
+    /// \return Number of lines.
+    std::size_t size() const { return size_; }
+    /// \return Begin of the first line.
+    const char *data() const { return begin_; }
+    /// \return Whether there are no lines.
+    bool empty() const { return size_ == 0; }
+    /// \param[in] i Number of the line. \return The line.
+    Particle operator[](std::size_t i) const {
+      return Particle(begin_ + i * line_size_);
+    }
+    /**
+     * \param[in] first Number of the first line.
+     * \param[in] n Number of lines.
+     * \return The lines \f$[first, first + n)\f$ of these ones.
+     */
+    Particles subrange(std::size_t first, std::size_t n) const {
+      return Particles(begin_ + first * line_size_, n, line_size_);
+    }
+    /// \return Iterator to the first line.
+    iterator begin() const { return iterator(begin_, line_size_); }
+    /// \return Iterator behind the last line.
+    iterator end() const {
+      return iterator(begin_ + size_ * line_size_, line_size_);
+    }
+
+   private:
+    /// Begin of the first line
+    const char *begin_ = nullptr;
+    /// Number of lines
+    std::size_t size_ = 0;
+    /// Size of a line in bytes
+    std::size_t line_size_ = 0;
+  };
+
+  /// A particle, delta or interaction block of the file
+  struct Block {
+    /**
+     * \c 'p' for particles, \c 'd' for a delta, \c 'i' for an interaction
+     * and \c 'r' for an interaction with referenced incoming particles
+     */
+    char type = 'p';
+    /// Number of the event of a particle or delta block
+    std::int32_t event_number = 0;
+    /// Number of the ensemble of a particle or delta block
+    std::int32_t ensemble_number = 0;
+    /// Time of a delta block or of an interaction with references [fm]
+    double time = 0.;
+    /// Number of particles removed by a delta block
+    std::uint32_t n_removed = 0;
+    /// The IDs of the removed particles of a delta block, see removed_id()
+    const char *removed_ids = nullptr;
+    /**
+     * Number of the lines of incoming particles of an interaction. With
+     * references, these are only the incoming particles which are not
+     * referenced, see CollisionState.
+     */
+    std::uint32_t n_incoming = 0;
+    /// Number of incoming particles of an interaction with references
+    std::uint32_t n_incoming_ids = 0;
+    /**
+     * The IDs of all incoming particles of an interaction with references,
+     * see incoming_id()
+     */
+    const char *incoming_ids = nullptr;
+    /// Density at the interaction [fm^-3]
+    double density = 0.;
+    /// Total cross section of the interaction [mb]
+    double cross_section = 0.;
+    /// Partial cross section of the interaction [mb]
+    double partial_cross_section = 0.;
+    /// Process type of the interaction
+    std::uint32_t process_type = 0;
+    /// All particle lines of the block
+    Particles particles;
+
+    /// \return The incoming particles of an interaction.
+    Particles incoming() const { return particles.subrange(0, n_incoming); }
+    /// \return The outgoing particles of an interaction.
+    Particles outgoing() const {
+      return particles.subrange(n_incoming, particles.size() - n_incoming);
+    }
+    /**
+     * \param[in] i Number of the removed particle.
+     * \return The ID of the removed particle of a delta block.
+     */
+    std::int32_t removed_id(std::size_t i) const {
+      std::int32_t id;
+      std::memcpy(&id, removed_ids + i * sizeof(id), sizeof(id));
+      return id;
+    }
+    /**
+     * \param[in] i Number of the incoming particle.
+     * \return The ID of the incoming particle of an interaction with
+     *         references.
+     */
+    std::int32_t incoming_id(std::size_t i) const {
+      std::int32_t id;
+      std::memcpy(&id, incoming_ids + i * sizeof(id), sizeof(id));
+      return id;
+    }
+  };
+
+  /**
+   * The particles of an ensemble, reconstructed from its particle and delta
+   * blocks. A particle block sets all particles. A delta block removes the
+   * particles of the given IDs, moves all others on straight lines to its
+   * time with free_stream() and then replaces or adds the particles of its
+   * lines by their IDs. The order of the particles may differ from the one
+   * of a complete particle list at the same time.
+   *
+   * This works only for OSCAR 2013 and extended OSCAR 2013 particle lines,
+   * since only these are written as delta blocks.
+   */
+  class ParticleState {
+   public:
+    /// \param[in] line_size Size of a particle line in bytes.
+    explicit ParticleState(std::size_t line_size) : line_size_(line_size) {}
+
+    /**
+     * Update the particles with a block. Interaction blocks are ignored.
+     *
+     * \param[in] block The block.
+     */
+    void apply(const Block &block);
+
+    /// \return The particles, which are valid until the next block is applied.
+    Particles particles() const {
+      return Particles(lines_.data(), lines_.size() / line_size_, line_size_);
+    }
+
+   private:
+    /// Size of a particle line in bytes
+    std::size_t line_size_;
+    /// The particle lines
+    std::vector<char> lines_;
+    /// Number of the line of every particle ID
+    std::unordered_map<std::int32_t, std::size_t> line_of_id_;
+  };
+
+  /**
+   * The last lines of the particles of an event of a collisions output, from
+   * which the incoming particles of the interactions with references are
+   * reconstructed. A particle block adds its lines. An interaction block
+   * reconstructs its incoming particles: those with a line in the block are
+   * taken from it, the others are the kept lines of their IDs, moved on
+   * straight lines to the time of the interaction with free_stream(). Then
+   * the incoming particles are removed and the outgoing ones are added.
+   *
+   * The blocks of an event have to be applied in their order to a new state.
+   * This works only for OSCAR 2013 and extended OSCAR 2013 particle lines,
+   * since only these are referenced.
+   */
+  class CollisionState {
+   public:
+    /// \param[in] line_size Size of a particle line in bytes.
+    explicit CollisionState(std::size_t line_size) : line_size_(line_size) {}
+
+    /**
+     * Update the particles with a block. Delta blocks are ignored.
+     *
+     * \param[in] block The block.
+     * \throw std::runtime_error if an incoming particle is not known.
+     */
+    void apply(const Block &block);
+
+    /**
+     * \return The incoming particles of the last applied interaction block,
+     *         which are valid until the next block is applied.
+     */
+    Particles incoming() const {
+      return Particles(incoming_.data(), incoming_.size() / line_size_,
+                       line_size_);
+    }
+
+   private:
+    /**
+     * Keep the lines of particles.
+     *
+     * \param[in] lines The particle lines.
+     */
+    void keep(const Particles &lines);
+
+    /// Size of a particle line in bytes
+    std::size_t line_size_;
+    /// The last line of every particle ID
+    std::unordered_map<std::int32_t, std::vector<char>> known_lines_;
+    /// The incoming particle lines of the last interaction
+    std::vector<char> incoming_;
+  };
+
+  /**
+   * Move the particle of an OSCAR 2013 or extended OSCAR 2013 line on a
+   * straight line with its velocity to the given time. The writers of the
+   * delta blocks and of the referenced incoming particles, the ParticleState
+   * and the CollisionState use this function, such that they agree on the
+   * free-streaming particles.
+   *
+   * \param[inout] line The particle line.
+   * \param[in] time The time [fm].
+   */
+  static void free_stream(char *line, double time);
+
+  /**
+   * The blocks of the file up to an event end line. These are the blocks
+   * after the previous event end line, which, for several ensembles,
+   * include the blocks of the other ensembles of the same event.
+   */
+  class Event {
+   public:
+    /// Iterator over the blocks of an event
+    class iterator {
+     public:
+      /// \cond
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Block;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const Block *;
+      using reference = const Block &;
+      /// \endcond
+
+      /**
+       * Read the block at the given position.
+       *
+       * \param[in] content The blocks of the event.
+       * \param[in] position Position of the block, the size of \p content
+       *            for the end.
+       * \param[in] line_size Size of a particle line in bytes.
+       * \throw std::runtime_error if the block is invalid.
+       */
+      iterator(std::string_view content, std::size_t position,
+               std::size_t line_size);
+      /// \return The block.
+      const Block &operator*() const { return block_; }
+      /// \return The block.
+      const Block *operator->() const { return &block_; }
+      /**
+       * Read the next block.
+       *
+       * \return This iterator.
+       * \throw std::runtime_error if the block is invalid.
+       */
+      iterator &operator++();
+      /// \param[in] other Iterator. \return Whether both are equal.
+      bool operator==(const iterator &other) const {
+        return position_ == other.position_;
+      }
+      /// \param[in] other Iterator. \return Whether both differ.
+      bool operator!=(const iterator &other) const {
+        return position_ != other.position_;
+      }
+
+     private:
+      /**
+       * Read the block at the current position.
+       *
+       * \throw std::runtime_error if the block is invalid.
+       */
+      void read_block();
+
+      /// The blocks of the event
+      std::string_view content_;
+      /// Position of the current block
+      std::size_t position_;
+      /// Position of the next block
+      std::size_t next_position_ = 0;
+      /// Size of a particle line in bytes
+      std::size_t line_size_;
+      /// The current block
+      Block block_;
+    };
+
+    /**
+     * \param[in] content The blocks before the event end line.
+     * \param[in] line_size Size of a particle line in bytes.
+     * \param[in] event_number Number of the event.
+     * \param[in] ensemble_number Number of the ensemble.
+     * \param[in] impact_parameter Impact parameter [fm].
+     * \param[in] empty Whether there was no interaction between projectile
+     *            and target.
+     */
+    Event(std::string_view content, std::size_t line_size,
+          std::int32_t event_number, std::int32_t ensemble_number,
+          double impact_parameter, bool empty)
+        : content_(content),
+          line_size_(line_size),
+          event_number_(event_number),
+          ensemble_number_(ensemble_number),
+          impact_parameter_(impact_parameter),
+          empty_(empty) {}
+
+    /// \return Number of the event.
+    std::int32_t event_number() const { return event_number_; }
+    /// \return Number of the ensemble.
+    std::int32_t ensemble_number() const { return ensemble_number_; }
+    /// \return Impact parameter [fm].
+    double impact_parameter() const { return impact_parameter_; }
+    /// \return Whether there was no interaction between projectile and target.
+    bool empty() const { return empty_; }
+    /// \return The bytes of the blocks.
+    std::string_view content() const { return content_; }
+    /// \return Iterator to the first block.
+    iterator begin() const { return iterator(content_, 0, line_size_); }
+    /// \return Iterator behind the last block.
+    iterator end() const {
+      return iterator(content_, content_.size(), line_size_);
+    }
+
+   private:
+    /// The bytes of the blocks
+    std::string_view content_;
+    /// Size of a particle line in bytes
+    std::size_t line_size_;
+    /// Number of the event
+    std::int32_t event_number_;
+    /// Number of the ensemble
+    std::int32_t ensemble_number_;
+    /// Impact parameter
+    double impact_parameter_;
+    /// Whether there was no interaction between projectile and target
+    bool empty_;
+  };
+
+  /**
+   * Map the file into memory and find its events.
+   *
+   * \param[in] path Path to the file.
+   * \param[in] custom_line_size Size of a particle line in bytes, which is
+   *            only needed for custom quantities, because they are not
+   *            stored in the file.
+   * \throw std::runtime_error if the file cannot be opened or mapped, if it is
+   *        not a valid uncompressed SMASH binary output, or if its event index
+   *        does not match it.
+   * \throw std::invalid_argument if the file has custom quantities and no
+   *        line size is given.
+   */
+  explicit BinaryReader(const std::filesystem::path &path,
+                        std::size_t custom_line_size = 0);
+
+  /// A mapped file cannot be copied.
+  BinaryReader(const BinaryReader &) = delete;
+  /// A mapped file cannot be copied.
+  BinaryReader &operator=(const BinaryReader &) = delete;
+
+  /// Unmap the file.
+  ~BinaryReader();
+
+  /// \return The format version of the file.
+  std::uint16_t format_version() const { return format_version_; }
+  /**
+   * \return The format variant, i.e. 0 for OSCAR 2013, 1 for extended OSCAR
+   *         2013 and 2 for custom particle lines.
+   */
+  std::uint16_t format_variant() const { return format_variant_; }
+  /// \return The SMASH version which wrote the file.
+  std::string_view smash_version() const { return smash_version_; }
+  /// \return Size of a particle line in bytes.
+  std::size_t line_size() const { return line_size_; }
+  /// \return Whether the events were taken from the event index.
+  bool indexed() const { return indexed_; }
+
+  /// \return Number of complete events, i.e. of event end lines.
+  std::size_t size() const { return events_.size(); }
+  /**
+   * \param[in] i Number of the event in the file, starting at 0.
+   * \return The event, which is valid as long as this object.
+   */
+  const Event &operator[](std::size_t i) const { return events_[i]; }
+  /// \return Iterator to the first event.
+  std::vector<Event>::const_iterator begin() const { return events_.begin(); }
+  /// \return Iterator behind the last event.
+  std::vector<Event>::const_iterator end() const { return events_.end(); }
+
+  /**
+   * Ask the operating system to read the pages of an event in the background.
+   * Nothing happens, if there is no such event.
+   *
+   * \param[in] i Number of the event in the file, starting at 0.
+   */
+  void prefetch(std::size_t i) const;
+
+  /**
+   * Call a function for every event, using the threads of a pool. The events
+   * are handed out in the order of the file and the pages of the events
+   * which are handed out next are read in the background.
+   *
+   * \param[in] pool The threads.
+   * \param[in] function Function to be called with the number of the event
+   *            in the file and the event. It is called concurrently for
+   *            different events.
+   * \throw Rethrows the first exception thrown by \p function.
+   */
+  void for_each_event(
+      ThreadPool &pool,
+      const std::function<void(std::size_t, const Event &)> &function) const;
+
+ private:
+  /**
+   * Read the header of the file.
+   *
+   * \param[in] custom_line_size Size of a custom particle line.
+   * \return Size of the header in bytes.
+   * \throw std::runtime_error if the header is invalid.
+   */
+  std::size_t read_header(std::size_t custom_line_size);
+
+  /**
+   * Read the events from the event index.
+   *
+   * \param[in] index_path Path to the event index.
+   * \param[in] header_size Size of the header of the file in bytes.
+   * \throw std::runtime_error if the index is invalid or does not match.
+   */
+  void read_index(const std::filesystem::path &index_path,
+                  std::size_t header_size);
+
+  /**
+   * Find the events by reading the block headers of the file.
+   *
+   * \param[in] header_size Size of the header of the file in bytes.
+   * \throw std::runtime_error if a block is invalid.
+   */
+  void find_events(std::size_t header_size);
+
+  /// Unmap the file, if it is mapped.
+  void unmap();
+
+  /// Begin of the mapped file, \c nullptr for an empty file
+  const char *data_ = nullptr;
+  /// Size of the file in bytes
+  std::size_t size_ = 0;
+  /// Format version of the file
+  std::uint16_t format_version_ = 0;
+  /// Format variant of the file
+  std::uint16_t format_variant_ = 0;
+  /// The SMASH version which wrote the file
+  std::string_view smash_version_;
+  /// Size of a particle line in bytes
+  std::size_t line_size_ = 0;
+  /// Whether the events were taken from the event index
+  bool indexed_ = false;
+  /// The complete events of the file
+  std::vector<Event> events_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BINARYREADER_H_
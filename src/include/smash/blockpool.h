@@ -0,0 +1,134 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BLOCKPOOL_H_
+#define SRC_INCLUDE_SMASH_BLOCKPOOL_H_
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace smash {
+
+/**
+ * A pool of memory blocks for small objects which are created and destroyed in
+ * large numbers, such as actions and process branches.
+ *
+ * Blocks are grouped by their size, rounded up to a multiple of the block
+ * alignment, and cut from large chunks of memory. Freed blocks are kept in a
+ * list per size and handed out again by the next request of the same size,
+ * such that the objects found and discarded in every timestep reuse the same
+ * memory instead of calling the global allocator each time.
+ *
+ * The lists of free blocks belong to the calling thread, hence no locking is
+ * needed. A block may be freed by another thread than the one which allocated
+ * it, it then becomes available to the freeing thread. The chunks are never
+ * returned to the system, since blocks of a chunk may still be in use by any
+ * thread.
+ *
+ * Requests larger than max_block_size are passed to the global allocator.
+ */
+class BlockPool {
+ public:
+  /// Alignment of all blocks, as guaranteed by the global allocator [bytes]
+  static constexpr std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+  /// Largest size of the blocks taken from the pool [bytes]
+  static constexpr std::size_t max_block_size = 1024;
+  /// Size of the chunks from which the blocks are cut [bytes]
+  static constexpr std::size_t chunk_size = 64 * 1024;
+
+  /**
+   * Get a block of memory.
+   *
+   * \param[in] size Size of the block [bytes].
+   * \return A block of at least \p size bytes.
+   * \throw std::bad_alloc if no memory is available.
+   */
+  static void *allocate(std::size_t size);
+
+  /**
+   * Give back a block of memory.
+   *
+   * \param[in] block A block obtained from allocate().
+   * \param[in] size The size which was passed to allocate() [bytes].
+   */
+  static void deallocate(void *block, std::size_t size) noexcept;
+};
+
+/**
+ * Base class for classes whose objects are allocated from the BlockPool.
+ *
+ * The operators are also used for derived classes, for which the size of the
+ * actual object is passed to the operator delete, as long as the destructor
+ * is virtual.
+ */
+class PoolAllocated {
+ public:
+  /// \return A block for an object of the given \p size from the pool.
+  static void *operator new(std::size_t size) {
+    return BlockPool::allocate(size);
+  }
+  /// Give back the block of an object of the given \p size to the pool.
+  static void operator delete(void *block, std::size_t size) noexcept {
+    BlockPool::deallocate(block, size);
+  }
+};
+
+/**
+ * Allocator taking the memory of containers from the BlockPool.
+ *
+ * It is meant for containers which mostly hold few elements, like the lists
+ * of incoming and outgoing particles of actions, such that their storage is
+ * reused like the one of the actions themselves. Larger storage is passed to
+ * the global allocator by the pool. All instances are interchangeable.
+ *
+ * \tparam T The type of the elements.
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  /// The type of the elements
+  using value_type = T;
+
+  /// Create an allocator.
+  PoolAllocator() noexcept = default;
+  /// Create an allocator from one for another type of elements.
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &) noexcept {}  // NOLINT
+
+  /**
+   * \return Storage for \p n elements.
+   * \throw std::bad_array_new_length if the size overflows.
+   */
+  T *allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(BlockPool::allocate(n * sizeof(T)));
+  }
+  /// Give back the storage \p block of \p n elements.
+  void deallocate(T *block, std::size_t n) noexcept {
+    BlockPool::deallocate(block, n * sizeof(T));
+  }
+
+  /// \return Always true, since the memory of any instance can be freed.
+  template <typename U>
+  bool operator==(const PoolAllocator<U> &) const noexcept {
+    return true;
+  }
+  /// \return Always false, since the memory of any instance can be freed.
+  template <typename U>
+  bool operator!=(const PoolAllocator<U> &) const noexcept {
+    return false;
+  }
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BLOCKPOOL_H_
@@ -9,9 +9,13 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 
+#include "distributions.h"
 #include "forwarddeclarations.h"
+#include "hadgas_eos.h"
 #include "modusdefault.h"
+#include "quantumsampling.h"
 
 namespace smash {
 
@@ -109,19 +113,37 @@ class BoxModus : public ModusDefault {
             strategy};
   }
 
+  /// \copydoc smash::ModusDefault::update_grid
+  void update_grid(Grid<GridOptions::PeriodicBoundaries> &grid,
+                   const Particles &particles, double min_cell_length,
+                   double timestep_duration, CollisionCriterion crit,
+                   const bool include_unformed_particles,
+                   CellSizeStrategy strategy =
+                       CellSizeStrategy::Optimal) const {
+    CellNumberLimitation limit = CellNumberLimitation::ParticleNumber;
+    if (crit == CollisionCriterion::Stochastic) {
+      limit = CellNumberLimitation::None;
+    }
+    grid.rebuild({{0, 0, 0}, {length_, length_, length_}}, particles,
+                 min_cell_length, timestep_duration, limit,
+                 include_unformed_particles, strategy);
+  }
+
   /**
    * Creates GrandCanThermalizer. (Special Box implementation.)
    *
    * \param[in] conf configuration object
+   * \param[in] thread_pool Optional pool compiling the table of the equation
+   *            of state
    * \return unique pointer to created thermalizer class
    */
   std::unique_ptr<GrandCanThermalizer> create_grandcan_thermalizer(
-      Configuration &conf) const {
+      Configuration &conf, ThreadPool *thread_pool = nullptr) const {
     const std::array<double, 3> lat_size = {length_, length_, length_};
     const std::array<double, 3> origin = {0., 0., 0.};
     const bool periodicity = true;
     return std::make_unique<GrandCanThermalizer>(conf, lat_size, origin,
-                                                 periodicity);
+                                                 periodicity, thread_pool);
   }
 
   /// \copydoc smash::ModusDefault::max_timestep()
@@ -137,6 +159,14 @@ class BoxModus : public ModusDefault {
   double length() const { return length_; }
 
  private:
+  /**
+   * Sample the momentum and the position of an initial particle in the
+   * box.
+   *
+   * \param[inout] data The particle, whose type is already set.
+   */
+  void sample_phase_space(ParticleData &data);
+
   /// Initial momenta distribution: thermal or peaked momenta
   const BoxInitialCondition initial_condition_;
   /// Length of the cube's edge in fm
@@ -173,6 +203,27 @@ class BoxModus : public ModusDefault {
    * false -- simply use pole masses.
    */
   const bool account_for_resonance_widths_;
+  /**
+   * Sampler of the thermal masses of resonances from tabulated distributions,
+   * if requested instead of rejection sampling
+   */
+  std::optional<ThermalMassSampler> thermal_mass_sampler_;
+  /**
+   * Whether the quantum momentum distributions are sampled from tabulated
+   * inverse cumulative distributions
+   */
+  const bool tabulate_quantum_momenta_;
+  /// Sampler of the quantum momenta, created in the first event
+  std::unique_ptr<QuantumSampling> quantum_sampling_;
+  /**
+   * Whether the thermal momentum distributions are sampled from tabulated
+   * inverse cumulative distributions
+   */
+  const bool tabulate_thermal_momenta_;
+  /// Sampler of the tabulated thermal momenta, created in the first event
+  std::unique_ptr<ThermalMomentumSampler> thermal_momentum_sampler_;
+  /// Threads sampling the initial particles species by species, if requested
+  std::unique_ptr<ThreadPool> sampling_thread_pool_;
   /**
    * Particle multiplicities at initialization;
    * required if use_thermal_ is false
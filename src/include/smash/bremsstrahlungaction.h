@@ -44,7 +44,9 @@ class BremsstrahlungAction : public ScatterAction {
                        const SpinInteractionType spin_interaction_type =
                            SpinInteractionType::Off);
   /**
-   * Create the final state and write to output.
+   * Create the final states and write them to output, one after the other.
+   * The kinematics of the collision, which do not depend on the sampled
+   * photon, are computed only once for all fractional photons.
    *
    * \param[in] outputs List of all outputs. Does not have to be a specific
    *                      photon output, the function will take care of this.
@@ -138,7 +140,20 @@ class BremsstrahlungAction : public ScatterAction {
     return bremsstrahlung_reaction_type(in) != ReactionType::no_reaction;
   }
 
+  /**
+   * Choose how the differential cross sections are interpolated. This has to
+   * be called before the first bremsstrahlung action is created.
+   *
+   * \param[in] grid_lookup Whether the bicubic splines are evaluated with the
+   *                        constant-time grid lookup of
+   *                        InterpolateData2DSpline instead of by GSL.
+   */
+  static void set_grid_lookup(bool grid_lookup) { grid_lookup_ = grid_lookup; }
+
  private:
+  /// Whether the differential cross sections use the grid lookup
+  static bool grid_lookup_;
+
   /**
    * Holds the bremsstrahlung branch. As of now, this will always
    * hold only one branch.
@@ -173,6 +188,31 @@ class BremsstrahlungAction : public ScatterAction {
   /// Type of spin interaction to use
   const SpinInteractionType spin_interaction_type_;
 
+  /// Kinematics of the collision shared by all its fractional photons
+  struct Kinematics {
+    /// Point at which the photon is created
+    FourVector interaction_point;
+    /// Largest sampled photon momentum k [GeV]
+    double k_max;
+    /// Boost from the center of mass frame to the computational frame
+    LorentzBoost to_computational_frame;
+  };
+
+  /**
+   * Compute the kinematics of the collision, after the outgoing particles
+   * have been created.
+   *
+   * \return The kinematics shared by all fractional photons.
+   */
+  Kinematics kinematics() const;
+
+  /**
+   * Sample the final state of one photon and its weight.
+   *
+   * \param[in] kin The kinematics of the collision.
+   */
+  void sample_photon(const Kinematics &kin);
+
   /**
    * Create interpolation objects for tabularized cross sections:
    * total cross section, differential dSigma/dk, differential dSigma/dtheta
@@ -0,0 +1,274 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_BUFFEREDOUTPUT_H_
+#define SRC_INCLUDE_SMASH_BUFFEREDOUTPUT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "action.h"
+#include "outputinterface.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ * A copy of an already performed action, which only keeps the information
+ * needed by the outputs.
+ *
+ * Actions cannot be copied, hence the incoming and outgoing particles, the
+ * time, the process type and the weights of the original action are stored
+ * here, such that the action can be passed to an output after the original
+ * object has been destroyed.
+ */
+class RecordedAction : public Action {
+ public:
+  /**
+   * Record the given action.
+   *
+   * \param[in] action The performed action to be copied.
+   */
+  explicit RecordedAction(const Action &action)
+      : Action(action.incoming_particles(), action.outgoing_particles(),
+               action.time_of_execution(), action.get_type()),
+        total_weight_(action.get_total_weight()),
+        partial_weight_(action.get_partial_weight()) {}
+
+  /// \return The total weight of the recorded action.
+  double get_total_weight() const override { return total_weight_; }
+  /// \return The partial weight of the recorded action.
+  double get_partial_weight() const override { return partial_weight_; }
+
+  /// The final state is already known, hence nothing is done here.
+  void generate_final_state() override {}
+
+ protected:
+  /**
+   * Write information about the recorded action to the output stream.
+   *
+   * \param[out] out The ostream into which to output the action.
+   */
+  void format_debug_output(std::ostream &out) const override {
+    out << "Recorded action of " << incoming_particles_.size() << " to "
+        << outgoing_particles_.size() << " particles.";
+  }
+
+ private:
+  /// Total weight of the original action
+  const double total_weight_;
+  /// Partial weight of the original action
+  const double partial_weight_;
+};
+
+/**
+ * \ingroup output
+ * An output collecting the calls destined to another output.
+ *
+ * If parallel ensembles or events are evolved concurrently, the outputs cannot
+ * be written to directly, since the order of the calls would depend on the
+ * scheduling of the threads. Instead, every ensemble or event writes to its own
+ * buffered outputs, which are flushed to the actual outputs one after the other
+ * afterwards. In this way, the content of the output files does not depend on
+ * which thread evolved which ensemble or event.
+ *
+ * All arguments are copied when a call is buffered, such that the buffer does
+ * not depend on the lifetime of the original objects. The clock passed at
+ * intermediate times is replaced by a clock standing still at the time of the
+ * call, since outputs only use the current time.
+ *
+ * The buffered output has the same dilepton, photon and initial conditions
+ * flags as the output it is attached to, such that it can be used wherever the
+ * latter would have been used.
+ */
+class BufferedOutput : public OutputInterface {
+ public:
+  /**
+   * Create a buffer for the calls to be passed to the given output.
+   *
+   * \param[in] target The output which shall eventually receive the buffered
+   *            calls. It has to outlive the buffer.
+   */
+  explicit BufferedOutput(OutputInterface &target);
+
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_eventstart(const Particles &particles, const EventLabel &event_label,
+                     const EventInfo &event) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_eventstart(const std::vector<Particles> &ensembles,
+                     int event_number) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_eventstart(const int event_number, const ThermodynamicQuantity tq,
+                     const DensityType dens_type,
+                     RectangularLattice<DensityOnLattice> lattice) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_eventstart(const int event_number, const ThermodynamicQuantity tq,
+                     const DensityType dens_type,
+                     RectangularLattice<EnergyMomentumTensor> lattice) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_eventend(const ThermodynamicQuantity tq) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_eventend(const Particles &particles, const EventLabel &event_label,
+                   const EventInfo &event) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_eventend(const std::vector<Particles> &ensembles,
+                   const int event_number) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void event_statistics_output(const int event_number,
+                               const EventStatistics &statistics) override;
+
+  /**
+   * Store a copy of the interaction together with the density.
+   *
+   * \param[in] action The action to be buffered.
+   * \param[in] density The density at the interaction point.
+   */
+  void at_interaction(const Action &action, const double density) override;
+
+  /// \return True, since the buffered interactions are passed on later.
+  bool keeps_interactions() const override { return true; }
+
+  /**
+   * Store the shared copy of the interaction together with the density. When
+   * the buffer is flushed, it is shared further, if the target output keeps
+   * the interactions as well.
+   *
+   * \param[in] action The copy of the action to be buffered.
+   * \param[in] density The density at the interaction point.
+   */
+  void at_recorded_interaction(
+      const std::shared_ptr<const RecordedAction> &action,
+      const double density) override;
+
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param,
+                            const EventLabel &event_label,
+                            const EventInfo &event) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void at_intermediate_time(const std::vector<Particles> &ensembles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void thermodynamics_output(
+      const ThermodynamicQuantity tq, const DensityType dens_type,
+      RectangularLattice<DensityOnLattice> &lattice) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void thermodynamics_output(
+      const ThermodynamicQuantity tq, const DensityType dens_type,
+      RectangularLattice<EnergyMomentumTensor> &lattice) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void thermodynamics_lattice_output(
+      RectangularLattice<DensityOnLattice> &lattice,
+      const double current_time) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void thermodynamics_lattice_output(
+      RectangularLattice<DensityOnLattice> &lattice, const double current_time,
+      const std::vector<Particles> &ensembles,
+      const DensityParameters &dens_param) override;
+  /// Buffer the call of the corresponding OutputInterface method.
+  void thermodynamics_lattice_output(
+      const ThermodynamicQuantity tq,
+      RectangularLattice<EnergyMomentumTensor> &lattice,
+      const double current_time) override;
+
+  /**
+   * The state of the thermalizer cannot be copied, hence this output can not
+   * be buffered.
+   *
+   * \throw std::logic_error always.
+   */
+  void thermodynamics_output(
+      const GrandCanThermalizer &gc_thermalizer) override;
+
+  /// Buffer the call of the corresponding OutputInterface method.
+  void fields_output(
+      const std::string name1, const std::string name2,
+      RectangularLattice<std::pair<ThreeVector, ThreeVector>> &lattice)
+      override;
+
+  /// \return The number of buffered calls.
+  std::size_t size() const { return calls_.size(); }
+
+  /**
+   * \return The memory used by the copies made for the buffered calls, as
+   * long as they are not released [bytes].
+   */
+  std::size_t memory_usage() const override {
+    return held_bytes_->load(std::memory_order_relaxed);
+  }
+
+  /**
+   * \return The hooks to which the target subscribed, such that only calls
+   * reaching the target are buffered.
+   */
+  OutputHooksBitSet subscribed_hooks() const override {
+    return target_.subscribed_hooks();
+  }
+
+  /**
+   * Pass all buffered calls to the target output, in the order in which they
+   * were buffered, and clear the buffer.
+   */
+  void flush();
+
+  /// Calls of the output methods, each one acting on the given output
+  using Calls = std::vector<std::function<void(OutputInterface &)>>;
+
+  /**
+   * Take the buffered calls out of the buffer, such that they can be passed
+   * to the target output later, while the buffer collects further calls.
+   *
+   * \return The calls in the order in which they were buffered.
+   */
+  Calls take_calls() { return std::exchange(calls_, {}); }
+
+  /**
+   * Pass the given calls to the target output.
+   *
+   * \param[in] calls Calls taken out of this buffer before.
+   */
+  void flush(const Calls &calls) const;
+
+ protected:
+  /**
+   * Store a call, which eventually has to be applied to the target output.
+   *
+   * \param[in] call The call, acting on the given output.
+   */
+  virtual void enqueue_output_call(
+      std::function<void(OutputInterface &)> call) {
+    calls_.push_back(std::move(call));
+  }
+
+  /// \return The output to which the buffered calls are passed.
+  OutputInterface &target() const { return target_; }
+
+ private:
+  /// The output to which the buffered calls are eventually passed
+  OutputInterface &target_;
+  /**
+   * The memory used by the copies made for the buffered calls, which is
+   * shared by the copies, since they may outlive the buffer
+   */
+  std::shared_ptr<std::atomic<std::size_t>> held_bytes_;
+  /// The buffered calls, each one acting on the given output
+  Calls calls_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_BUFFEREDOUTPUT_H_
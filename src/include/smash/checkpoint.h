@@ -0,0 +1,201 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_CHECKPOINT_H_
+#define SRC_INCLUDE_SMASH_CHECKPOINT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * \brief Collects the state of a running simulation in binary form
+ *
+ * The values are appended one after the other as their bytes in memory, such
+ * that a checkpoint can only be read by the same build of SMASH which wrote
+ * it. The checkpoint is kept in memory and written to its file at once, see
+ * write.
+ */
+class CheckpointWriter {
+ public:
+  /**
+   * Append a value, which must be trivially copyable.
+   *
+   * \param[in] value The value.
+   */
+  template <typename T>
+  void put(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only trivially copyable values can be written as bytes.");
+    const auto *bytes = reinterpret_cast<const char *>(&value);
+    data_.append(bytes, sizeof(T));
+  }
+
+  /**
+   * Append a string, preceded by its length.
+   *
+   * \param[in] value The string.
+   */
+  void put(const std::string &value) {
+    put(static_cast<std::uint64_t>(value.size()));
+    data_.append(value);
+  }
+
+  /**
+   * Append the elements of a vector, preceded by their number.
+   *
+   * \param[in] values The vector.
+   */
+  template <typename T>
+  void put(const std::vector<T> &values) {
+    put(static_cast<std::uint64_t>(values.size()));
+    for (const T &value : values) {
+      put(value);
+    }
+  }
+
+  /**
+   * Write the checkpoint to the given file. It is first written next to it
+   * and then renamed, such that an interruption while writing does not
+   * destroy an earlier checkpoint.
+   *
+   * \param[in] file The file.
+   * \throw std::runtime_error if the file cannot be written.
+   */
+  void write(const std::filesystem::path &file) const;
+
+ private:
+  friend class CheckpointReader;
+
+  /// The bytes of the checkpoint
+  std::string data_;
+};
+
+/**
+ * \ingroup data
+ *
+ * \brief Reads the values of a checkpoint in the order they were written
+ */
+class CheckpointReader {
+ public:
+  /**
+   * Read the checkpoint from the given file.
+   *
+   * \param[in] file The file.
+   * \throw std::runtime_error if the file cannot be read.
+   */
+  explicit CheckpointReader(const std::filesystem::path &file);
+
+  /**
+   * Read a checkpoint kept in memory, e.g. a snapshot of an event.
+   *
+   * \param[in] checkpoint The checkpoint.
+   */
+  explicit CheckpointReader(const CheckpointWriter &checkpoint)
+      : data_(checkpoint.data_) {}
+
+  /**
+   * Read the next value.
+   *
+   * \param[out] value The value.
+   * \throw std::runtime_error if the checkpoint ends before the value.
+   */
+  template <typename T>
+  void get(T &value) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only trivially copyable values can be read as bytes.");
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+  }
+
+  /**
+   * Read the next string.
+   *
+   * \param[out] value The string.
+   * \throw std::runtime_error if the checkpoint ends before the string.
+   */
+  void get(std::string &value) {
+    std::uint64_t length;
+    get(length);
+    value.assign(take(length), length);
+  }
+
+  /**
+   * Read the next vector.
+   *
+   * \param[out] values The vector.
+   * \throw std::runtime_error if the checkpoint ends before the vector.
+   */
+  template <typename T>
+  void get(std::vector<T> &values) {
+    std::uint64_t size;
+    get(size);
+    values.resize(size);
+    for (T &value : values) {
+      get(value);
+    }
+  }
+
+  /// Read the next value of the given type. \see get
+  template <typename T>
+  T get() {
+    T value;
+    get(value);
+    return value;
+  }
+
+  /// \return Whether all values were read.
+  bool at_end() const { return position_ == data_.size(); }
+
+ private:
+  /**
+   * Hand out the next bytes.
+   *
+   * \param[in] n The number of bytes.
+   * \return The first of the bytes.
+   * \throw std::runtime_error if fewer bytes are left.
+   */
+  const char *take(std::uint64_t n) {
+    if (data_.size() - position_ < n) {
+      throw std::runtime_error("The checkpoint ends unexpectedly.");
+    }
+    const char *first = data_.data() + position_;
+    position_ += n;
+    return first;
+  }
+
+  /// The bytes of the checkpoint
+  std::string data_;
+  /// Position of the next value
+  std::size_t position_ = 0;
+};
+
+/**
+ * Ask the running experiment to write a checkpoint at the start of its next
+ * time step. This function is async-signal-safe, such that it can be called
+ * from a signal handler.
+ */
+void request_checkpoint();
+
+/**
+ * \return Whether a checkpoint was requested since the last call. The request
+ * is reset.
+ */
+bool take_checkpoint_request();
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_CHECKPOINT_H_
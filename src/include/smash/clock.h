@@ -18,6 +18,7 @@
 #include <stdexcept>
 #include <vector>
 
+#include "checkpoint.h"
 #include "logging.h"
 #include "numeric_cast.h"
 
@@ -109,6 +110,18 @@ class Clock {
    * \param[in] start_time starting time of the simulation
    */
   virtual void remove_times_in_past(double start_time) = 0;
+  /**
+   * Write the state of the clock to a checkpoint.
+   *
+   * \param[inout] checkpoint The checkpoint.
+   */
+  virtual void save(CheckpointWriter& checkpoint) const = 0;
+  /**
+   * Restore the state of the clock from a checkpoint written by save.
+   *
+   * \param[inout] checkpoint The checkpoint.
+   */
+  virtual void restore(CheckpointReader& checkpoint) = 0;
   /**
    * Advances the clock by one tick.
    *
@@ -336,6 +349,20 @@ class UniformClock : public Clock {
 
   void remove_times_in_past(double) override{};
 
+  void save(CheckpointWriter& checkpoint) const override {
+    checkpoint.put(counter_);
+    checkpoint.put(timestep_duration_);
+    checkpoint.put(reset_time_);
+    checkpoint.put(time_end_);
+  }
+
+  void restore(CheckpointReader& checkpoint) override {
+    checkpoint.get(counter_);
+    checkpoint.get(timestep_duration_);
+    checkpoint.get(reset_time_);
+    checkpoint.get(time_end_);
+  }
+
   /**
    * Advances the clock by an arbitrary timestep (multiple of 0.000001 fm).
    *
@@ -484,6 +511,18 @@ class CustomClock : public Clock {
         custom_times_.end());
   }
 
+  void save(CheckpointWriter& checkpoint) const override {
+    checkpoint.put(counter_);
+    checkpoint.put(custom_times_);
+    checkpoint.put(start_time_);
+  }
+
+  void restore(CheckpointReader& checkpoint) override {
+    checkpoint.get(counter_);
+    checkpoint.get(custom_times_);
+    checkpoint.get(start_time_);
+  }
+
  protected:
   /**
    * For the CustomClock, the internal time is basically by design the same as
@@ -21,6 +21,7 @@
 #include "icparameters.h"
 #include "interpolation.h"
 #include "modusdefault.h"
+#include "nuclearconfigurations.h"
 #include "nucleus.h"
 #include "pdgcode.h"
 
@@ -199,6 +200,17 @@ class ColliderModus : public ModusDefault {
    * at rest.
    **/
   std::unique_ptr<Nucleus> target_;
+  /// Number of configurations of the nuclei generated at once, none if zero
+  std::size_t pregenerated_configurations_ = 0;
+  /**
+   * Pre-generated configurations of the nuclei, which are started with the
+   * first event. It has to be destroyed before the nuclei it uses.
+   */
+  std::unique_ptr<NuclearConfigurations> configurations_;
+  /// Nucleons of the projectile taken from configurations_
+  std::vector<ParticleData> projectile_nucleons_;
+  /// Nucleons of the target taken from configurations_
+  std::vector<ParticleData> target_nucleons_;
   /**
    * Center-of-mass energy squared of the nucleus-nucleus collision.
    *
@@ -1224,9 +1224,32 @@ class Configuration {
       if (s == "Fixed") {
         return TimeStepMode::Fixed;
       }
-      throw IncorrectTypeInAssignment("The value for key \"" +
-                                      std::string(key_) +
-                                      "\" should be \"None\" or \"Fixed\".");
+      if (s == "Adaptive") {
+        return TimeStepMode::Adaptive;
+      }
+      throw IncorrectTypeInAssignment(
+          "The value for key \"" + std::string(key_) +
+          "\" should be \"None\", \"Fixed\" or \"Adaptive\".");
+    }
+
+    /**
+     * Set the kind of action queue from configuration values.
+     *
+     * \return ActionQueue.
+     * \throw IncorrectTypeInAssignment in case a queue that is not available
+     * is provided as a configuration value.
+     */
+    operator ActionQueue() const {
+      const std::string s = operator std::string();
+      if (s == "BinaryHeap") {
+        return ActionQueue::BinaryHeap;
+      }
+      if (s == "Calendar") {
+        return ActionQueue::Calendar;
+      }
+      throw IncorrectTypeInAssignment(
+          "The value for key \"" + std::string(key_) +
+          "\" should be \"BinaryHeap\" or \"Calendar\".");
     }
 
     /**
@@ -0,0 +1,401 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_CROSSSECTIONCACHE_H_
+#define SRC_INCLUDE_SMASH_CROSSSECTIONCACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "isoparticletype.h"
+#include "particletype.h"
+#include "sha256.h"
+#include "threadpool.h"
+
+namespace smash {
+
+/**
+ * Tabulated total cross sections of pairs of particle types, used to reject
+ * candidate pairs of the collision finder without evaluating all partial
+ * cross sections.
+ *
+ * For every unordered pair of types, the total cross section is tabulated on
+ * equidistant nodes in \f$\sqrt{s}\f$ above the threshold of the pair. The
+ * tables are created when a pair is looked up for the first time and every
+ * node is evaluated when it is needed for the first time. Since a node always
+ * takes the same value, the cache can be shared by several threads, which may
+ * at worst evaluate a node twice.
+ *
+ * Between two nodes, the cross section is estimated from above by the larger
+ * value at the two nodes, increased by a relative tolerance. This covers
+ * thresholds and steep rises of the cross section within one interval. The
+ * estimate is only meant to decide that a pair is too far apart to collide;
+ * the actions of the remaining pairs are constructed from the directly
+ * evaluated cross sections.
+ *
+ * The tables can be evaluated completely in advance, written to a file and
+ * read back by later runs, see write() and read().
+ *
+ * Optionally, the tables are kept for unordered pairs of isospin multiplets
+ * instead of types. For every total isospin \f$I\f$ of two multiplets, the
+ * isospin-reduced cross section \f$\sigma_I\f$ is tabulated, from which the
+ * cross section of two members is reconstructed when it is looked up,
+ * \f[\sigma(m_a, m_b) = \sum_I |\langle I_a m_a I_b m_b | I, m_a + m_b
+ * \rangle|^2 \sigma_I \,.\f]
+ * The reduced cross sections are obtained from the members coupling to
+ * \f$m_a + m_b = I\f$, one pair of members for every total isospin. Most
+ * pairs of types thereby share few tables. This only holds if the total cross
+ * sections conserve isospin, which is checked for every pair of multiplets by
+ * comparing the reconstructed to the evaluated cross sections of all members
+ * at a few nodes. Pairs of multiplets failing the check, or whose members
+ * differ in mass, keep a table for every pair of types.
+ */
+class CrossSectionCache {
+ public:
+  /**
+   * Function to evaluate the total cross section [mb] of two particle types at
+   * the given \f$\sqrt{s}\f$ [GeV].
+   */
+  using Evaluator = std::function<double(const ParticleType &,
+                                         const ParticleType &, double)>;
+
+  /**
+   * Function to evaluate the total cross sections [mb] of two particle types
+   * at many \f$\sqrt{s}\f$ [GeV] at once, which are written to the second
+   * vector of the same size.
+   */
+  using BatchEvaluator = std::function<void(
+      const ParticleType &, const ParticleType &, const std::vector<double> &,
+      std::vector<double> &)>;
+
+  /// Default distance of the nodes of the tables [GeV]
+  static constexpr double default_sqrts_spacing = 0.001;
+  /// Default number of nodes above the threshold of a pair
+  static constexpr std::size_t default_number_of_nodes = 5000;
+
+  /**
+   * Create an empty cache for the types in ParticleType::list_all().
+   *
+   * \param[in] tolerance Relative amount by which the tabulated cross
+   *            sections are increased to estimate them from above.
+   * \param[in] evaluate The function to evaluate the cross sections at the
+   *            nodes.
+   * \param[in] sqrts_spacing Distance of the nodes [GeV].
+   * \param[in] number_of_nodes Number of nodes of every table.
+   * \param[in] reduce_isospin Whether the tables are kept for pairs of isospin
+   *            multiplets where possible.
+   * \throw std::invalid_argument if \p tolerance is negative, \p sqrts_spacing
+   *        is not positive or fewer than two nodes are requested.
+   */
+  CrossSectionCache(double tolerance, Evaluator evaluate,
+                    double sqrts_spacing = default_sqrts_spacing,
+                    std::size_t number_of_nodes = default_number_of_nodes,
+                    bool reduce_isospin = false);
+
+  /**
+   * Create an empty cache for the types in ParticleType::list_all(), which
+   * evaluates all nodes of a table at once when the tables are tabulated in
+   * advance, see tabulate().
+   *
+   * \param[in] tolerance Relative amount by which the tabulated cross
+   *            sections are increased to estimate them from above.
+   * \param[in] evaluate The function to evaluate the cross sections at single
+   *            nodes.
+   * \param[in] evaluate_batch The function to evaluate the cross sections at
+   *            many nodes, which yields the same as \p evaluate.
+   * \param[in] sqrts_spacing Distance of the nodes [GeV].
+   * \param[in] number_of_nodes Number of nodes of every table.
+   * \param[in] reduce_isospin Whether the tables are kept for pairs of isospin
+   *            multiplets where possible.
+   * \throw std::invalid_argument like the constructor above.
+   */
+  CrossSectionCache(double tolerance, Evaluator evaluate,
+                    BatchEvaluator evaluate_batch,
+                    double sqrts_spacing = default_sqrts_spacing,
+                    std::size_t number_of_nodes = default_number_of_nodes,
+                    bool reduce_isospin = false);
+
+  /**
+   * Estimate the total cross section of two particle types from above.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   * \param[in] sqrts The center-of-mass energy of the pair [GeV].
+   * \return The estimate [mb], or nothing if \p sqrts is outside of the
+   *         tabulated range, which starts one node above the threshold.
+   */
+  std::optional<double> upper_bound(const ParticleType &type_a,
+                                    const ParticleType &type_b,
+                                    double sqrts) const;
+
+  /**
+   * Estimate the largest total cross section of two particle types at any
+   * \f$\sqrt{s}\f$ up to the given one from above. All nodes up to the given
+   * \f$\sqrt{s}\f$ are evaluated if needed.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   * \param[in] sqrts The largest center-of-mass energy of the pair [GeV].
+   * \return The estimate [mb], or nothing if \p sqrts is outside of the
+   *         tabulated range.
+   */
+  std::optional<double> upper_bound_up_to(const ParticleType &type_a,
+                                          const ParticleType &type_b,
+                                          double sqrts) const;
+
+  /// \return The relative tolerance of the estimates.
+  double tolerance() const { return tolerance_; }
+
+  /**
+   * \return Whether the cross sections of the given types are reconstructed
+   *         from the isospin-reduced cross sections of their multiplets. The
+   *         multiplets are checked if this has not been done yet.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  bool is_isospin_reduced(const ParticleType &type_a,
+                          const ParticleType &type_b) const;
+
+  /**
+   * Evaluate all nodes of the tables of all unordered pairs of the given
+   * types. Every pair is tabulated by one thread on its own, with the batch
+   * evaluator if there is one. Pairs sharing the table of their multiplets
+   * are tabulated together.
+   *
+   * \param[in] types The particle types.
+   * \param[in] pool The threads sharing the pairs. Without a pool, the pairs
+   *            are tabulated one after the other.
+   */
+  void tabulate(const ParticleTypePtrList &types, ThreadPool *pool);
+
+  /**
+   * Write all completely evaluated tables to a file, see TabulationFile. The
+   * file has a table for every pair of types, also if it is reconstructed
+   * from the table of the multiplets.
+   *
+   * \param[in] path The file.
+   * \return The number of written tables.
+   */
+  std::size_t write(const std::filesystem::path &path) const;
+
+  /**
+   * Take over the tables from a file written by write().
+   *
+   * The file is only accepted for the same particle types and the same nodes.
+   * Since the cross sections also depend on the decay modes and the settings
+   * of the collision term, a few nodes of every table read are compared to
+   * directly evaluated cross sections. The tables of the multiplets are
+   * obtained from the tables of the pairs of members they are reduced from.
+   *
+   * \param[in] path The file.
+   * \return The number of tables read.
+   * \throw std::runtime_error if the file cannot be read, was written for
+   *        other particle types or nodes, or a compared node differs.
+   */
+  std::size_t read(const std::filesystem::path &path);
+
+ private:
+  /// The tabulated cross sections of one pair of types
+  struct Table {
+    /// The center-of-mass energy of the first node [GeV]
+    double first_sqrts;
+    /// The cross sections at the nodes [mb], NaN if not evaluated yet
+    std::unique_ptr<std::atomic<double>[]> nodes;
+  };
+
+  /// The isospin-reduced cross sections of an unordered pair of multiplets
+  struct MultipletTable {
+    /**
+     * Whether the cross sections of the members are reconstructed from this
+     * table. Otherwise, every pair of members has a Table of its own.
+     */
+    bool isospin_symmetric = false;
+    /// Twice the largest total isospin of the multiplets
+    int max_isospin = 0;
+    /**
+     * The pair of members coupling to \f$m_a + m_b = I\f$ for every total
+     * isospin \f$I\f$, from the largest one down
+     */
+    std::vector<std::pair<const ParticleType *, const ParticleType *>> basis;
+    /**
+     * The reduced cross sections [mb] at the nodes, for all total isospins of
+     * a node next to each other in the order of the basis
+     */
+    Table reduced;
+  };
+
+  /// The table from which the cross sections of a pair of types are taken
+  struct Lookup {
+    /// The table of the pair, or the reduced table of its multiplets
+    const Table *table;
+    /// The multiplets if their reduced table is used, otherwise null
+    const MultipletTable *multiplets;
+  };
+
+  /**
+   * \return The table from which the cross sections of the given pair of
+   *         types are taken, which is created if needed.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  Lookup lookup(const ParticleType &type_a, const ParticleType &type_b) const;
+
+  /**
+   * \return The cross section of a pair at the given node of its table, which
+   *         is evaluated if needed.
+   *
+   * \param[in] pair_lookup The table of the pair.
+   * \param[in] i The index of the node.
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  double node(const Lookup &pair_lookup, std::size_t i,
+              const ParticleType &type_a, const ParticleType &type_b) const;
+
+  /**
+   * \return The table of the given pair of types, which is created if needed.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  const Table &table(const ParticleType &type_a,
+                     const ParticleType &type_b) const;
+
+  /**
+   * \return The cross section at the given node, which is evaluated if needed.
+   *
+   * \param[in] table The table of the pair.
+   * \param[in] i The index of the node.
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  double node(const Table &table, std::size_t i, const ParticleType &type_a,
+              const ParticleType &type_b) const;
+
+  /**
+   * \return The reduced table of the multiplets of the given types, which is
+   *         created and checked if needed, or null if the isospin is not
+   *         reduced.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  const MultipletTable *multiplet_table(const ParticleType &type_a,
+                                        const ParticleType &type_b) const;
+
+  /**
+   * \return The slot of the reduced table of the multiplets of the given
+   *         types.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  std::atomic<const MultipletTable *> &multiplet_slot(
+      const ParticleType &type_a, const ParticleType &type_b) const;
+
+  /**
+   * Create the reduced table of two multiplets and check at a few nodes
+   * whether the cross sections of all members are reconstructed from it.
+   *
+   * \param[in] multiplet_a The first multiplet.
+   * \param[in] multiplet_b The second multiplet.
+   * \return The table, with the checked nodes evaluated.
+   */
+  std::unique_ptr<MultipletTable> create_multiplet_table(
+      const IsoParticleType &multiplet_a,
+      const IsoParticleType &multiplet_b) const;
+
+  /**
+   * \return The cross section of a pair of members of two multiplets at the
+   *         given node, reconstructed from their reduced table. The reduced
+   *         cross sections at the node are evaluated if needed.
+   *
+   * \param[in] multiplets The reduced table of the multiplets.
+   * \param[in] i The index of the node.
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  double reduced_node(const MultipletTable &multiplets, std::size_t i,
+                      const ParticleType &type_a,
+                      const ParticleType &type_b) const;
+
+  /**
+   * \return The cross section of a pair of types at the given
+   *         \f$\sqrt{s}\f$ [GeV], evaluated for the pair in a fixed order.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   * \param[in] sqrts The center-of-mass energy of the pair [GeV].
+   */
+  double evaluate_pair(const ParticleType &type_a, const ParticleType &type_b,
+                       double sqrts) const;
+
+  /**
+   * \return The hash of the properties of all particle types, for which the
+   *         tables in a file are valid.
+   */
+  static sha256::Hash types_hash();
+
+  /**
+   * \return The name of the table of a pair in a file.
+   *
+   * \param[in] type_a The type of the first particle.
+   * \param[in] type_b The type of the second particle.
+   */
+  static std::string table_name(const ParticleType &type_a,
+                                const ParticleType &type_b);
+
+  /// Relative tolerance of the estimates
+  const double tolerance_;
+  /// Function evaluating the cross sections at the nodes
+  const Evaluator evaluate_;
+  /// Function evaluating the cross sections at many nodes, may be empty
+  const BatchEvaluator evaluate_batch_;
+  /// Distance of the nodes [GeV]
+  const double sqrts_spacing_;
+  /// Number of nodes of every table
+  const std::size_t number_of_nodes_;
+  /// Number of particle types
+  const std::size_t number_of_types_;
+  /// Whether the tables are kept for pairs of multiplets where possible
+  const bool reduce_isospin_;
+  /// Number of isospin multiplets
+  const std::size_t number_of_multiplets_;
+  /**
+   * The table of every unordered pair of types, once it has been created.
+   * Tables are never removed, such that they can be read without locking.
+   */
+  std::unique_ptr<std::atomic<const Table *>[]> slots_;
+  /// The storage of the created tables
+  mutable std::vector<std::unique_ptr<Table>> tables_;
+  /**
+   * The reduced table of every unordered pair of multiplets, once it has been
+   * created. Tables are never removed, such that they can be read without
+   * locking.
+   */
+  std::unique_ptr<std::atomic<const MultipletTable *>[]> multiplet_slots_;
+  /// The storage of the created reduced tables
+  mutable std::vector<std::unique_ptr<MultipletTable>> multiplet_tables_;
+  /// Mutex protecting the creation of tables
+  mutable std::mutex mutex_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_CROSSSECTIONCACHE_H_
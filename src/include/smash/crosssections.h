@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "forwarddeclarations.h"
 #include "isoparticletype.h"
@@ -22,6 +23,40 @@
 
 namespace smash {
 
+/**
+ * The properties of a pair of particle types, which decide the processes
+ * considered for their collisions. They only depend on the types, hence they
+ * are tabulated once for all pairs, see
+ * CrossSections::create_interaction_profiles.
+ */
+struct InteractionProfile {
+  /// Whether both are nucleons or both are antinucleons
+  bool is_NN = false;
+  /// Whether one is a nucleon and the other one an antinucleon
+  bool is_NNbar_any = false;
+  /// Whether one is a baryon and the other one an antibaryon
+  bool is_BBbar = false;
+  /// Whether one is a nucleon and the other one its antiparticle
+  bool is_NNbar = false;
+  /// Whether one is a nucleon and the other one a pion
+  bool is_Npi = false;
+  /// Whether both are pions
+  bool is_pipi = false;
+  /// Whether one is a K+ or K0 and the other one a proton (or antiparticles)
+  bool is_KplusP = false;
+  /**
+   * Whether the additive quark model applies, i.e. for baryon-baryon (of the
+   * same sign), baryon-meson and meson-meson pairs
+   */
+  bool is_AQM = false;
+  /// Whether the 2-to-3 reactions of (anti-)deuterons are possible
+  bool has_deuteron_2to3 = false;
+  /// Whether the 2-to-4 reactions of nuclei with A = 3 are possible
+  bool has_A3_nucleus_2to4 = false;
+  /// Sum of the pole masses [GeV]
+  double pole_mass_sum = 0.;
+};
+
 /**
  * The cross section class assembels everything that is needed to
  * calculate the cross section and returns a list of all possible reactions
@@ -41,6 +76,28 @@ class CrossSections {
   CrossSections(const ParticleList& incoming_particles, double sqrt_s,
                 const std::pair<FourVector, FourVector> potentials);
 
+  /// The incoming particles are referenced, hence they cannot be temporary.
+  CrossSections(ParticleList&& incoming_particles, double sqrt_s,
+                const std::pair<FourVector, FourVector> potentials) = delete;
+
+  /**
+   * Tabulate the interaction profiles of all pairs of particle types, which
+   * are otherwise determined for every collision.
+   */
+  static void create_interaction_profiles();
+
+  /// Remove the table, such that the profiles are determined for every pair.
+  static void clear_interaction_profiles() { interaction_profiles_.clear(); }
+
+  /**
+   * \param[in] type_a First particle type.
+   * \param[in] type_b Second particle type.
+   * \return The interaction profile of the pair, from the table if it was
+   *         created.
+   */
+  static InteractionProfile interaction_profile(const ParticleType& type_a,
+                                                const ParticleType& type_b);
+
   /**
    * Generate a list of all possible collisions between the incoming particles
    * with the given c.m. energy and the calculated cross sections.
@@ -69,6 +126,24 @@ class CrossSections {
   double parametrized_total(
       const ScatterActionsFinderParameters& finder_parameters) const;
 
+  /**
+   * Evaluate the parametrized total cross section of a pair of types at many
+   * center-of-mass energies, e.g. to tabulate it. The parametrization is
+   * selected once for the pair, such that the energies are looped over
+   * without branching on the types.
+   *
+   * \param[in] type_a First particle type.
+   * \param[in] type_b Second particle type.
+   * \param[in] sqrts The center-of-mass energies [GeV].
+   * \param[in] finder_parameters Parameters for collision finding, containing
+   * cut for low energy NN interactions.
+   * \return The cross sections [mb] like parametrized_total() at the energies.
+   */
+  static std::vector<double> parametrized_total(
+      const ParticleType& type_a, const ParticleType& type_b,
+      const std::vector<double>& sqrts,
+      const ScatterActionsFinderParameters& finder_parameters);
+
   /**
    * Helper function:
    * Sum all cross sections of the given process list.
@@ -100,6 +175,23 @@ class CrossSections {
   CollisionBranchPtr elastic(
       const ScatterActionsFinderParameters& finder_parameters) const;
 
+  /**
+   * Evaluate the elastic cross section of a pair of types on their pole
+   * masses at many center-of-mass energies, like elastic(). The incoming
+   * particles are set up once for all energies.
+   *
+   * \param[in] type_a First particle type.
+   * \param[in] type_b Second particle type.
+   * \param[in] sqrts The center-of-mass energies [GeV].
+   * \param[in] finder_parameters parameters for collision finding, including
+   * cross section modifications from config file.
+   * \return The elastic cross sections [mb] at the energies.
+   */
+  static std::vector<double> elastic(
+      const ParticleType& type_a, const ParticleType& type_b,
+      const std::vector<double>& sqrts,
+      const ScatterActionsFinderParameters& finder_parameters);
+
   /**
    * Find all resonances that can be produced in a 2->1 collision of the two
    * input particles and the production cross sections of these resonances.
@@ -360,6 +452,16 @@ class CrossSections {
                                   double region_upper) const;
 
  private:
+  /**
+   * Determine the elastic cross section of this collision, see elastic().
+   *
+   * \param[in] finder_parameters parameters for collision finding, including
+   * cross section modifications from config file.
+   * \return The elastic cross section [mb].
+   */
+  double elastic_cross_section(
+      const ScatterActionsFinderParameters& finder_parameters) const;
+
   /**
    * Choose the appropriate parametrizations for given incoming particles and
    * return the (parametrized) elastic cross section.
@@ -583,8 +685,21 @@ class CrossSections {
     return pCM(sqrt_s_, m1, m2);
   }
 
+  /**
+   * Determine the interaction profile of a pair of particle types.
+   *
+   * \param[in] type_a First particle type.
+   * \param[in] type_b Second particle type.
+   * \return The interaction profile.
+   */
+  static InteractionProfile compute_interaction_profile(
+      const ParticleType& type_a, const ParticleType& type_b);
+
+  /// The profiles of all pairs of types, in the order of ParticleType::list_all
+  static std::vector<InteractionProfile> interaction_profiles_;
+
   /// List with data of scattering particles.
-  const ParticleList incoming_particles_;
+  const ParticleList& incoming_particles_;
 
   /// Total energy in the center-of-mass frame.
   const double sqrt_s_;
@@ -595,14 +710,8 @@ class CrossSections {
    */
   const std::pair<FourVector, FourVector> potentials_;
 
-  /**
-   * Whether incoming particles are a pair of a baryon and an antibaryon
-   * (could be different baryon types)
-   */
-  const bool is_BBbar_pair_;
-
-  /// Whether incoming particles are a nulecon-antinucleon pair (same isospin)
-  const bool is_NNbar_pair_;
+  /// The properties of the pair of incoming types
+  const InteractionProfile profile_;
 
   /**
    * Helper function:
@@ -10,7 +10,6 @@
 #ifndef SRC_INCLUDE_SMASH_CROSSSECTIONSBREMS_H_
 #define SRC_INCLUDE_SMASH_CROSSSECTIONSBREMS_H_
 
-#include <initializer_list>
 #include <memory>
 
 #include "interpolation.h"
@@ -21,7 +20,7 @@ namespace smash {
 // to define them only once
 
 /// Center-of-mass energy.
-const std::initializer_list<double> BREMS_SQRTS = {
+constexpr double BREMS_SQRTS[] = {
     0.3,  0.31, 0.32, 0.33, 0.34, 0.35, 0.36, 0.37, 0.38, 0.39, 0.4,  0.41,
     0.42, 0.43, 0.44, 0.45, 0.46, 0.47, 0.48, 0.49, 0.5,  0.51, 0.52, 0.53,
     0.54, 0.55, 0.56, 0.57, 0.58, 0.59, 0.6,  0.61, 0.62, 0.63, 0.64, 0.65,
@@ -47,7 +46,7 @@ const std::initializer_list<double> BREMS_SQRTS = {
     4.85, 4.88, 4.91, 4.94, 4.97, 5.0};
 
 /// photon momentum
-const std::initializer_list<double> BREMS_K = {
+constexpr double BREMS_K[] = {
     0.001,      0.00107227, 0.00114976, 0.00123285, 0.00132194, 0.00141747,
     0.00151991, 0.00162975, 0.00174753, 0.00187382, 0.00200923, 0.00215443,
     0.00231013, 0.00247708, 0.00265609, 0.00284804, 0.00305386, 0.00327455,
@@ -67,7 +66,7 @@ const std::initializer_list<double> BREMS_K = {
     0.811131,   0.869749,   0.932603,   1.0};
 
 /// theta angle with respect to collision axis of incoming pions
-const std::initializer_list<double> BREMS_THETA = {
+constexpr double BREMS_THETA[] = {
     0.0,      0.039767, 0.079534, 0.119301, 0.159068, 0.198835, 0.238602,
     0.278369, 0.318136, 0.357903, 0.39767,  0.437437, 0.477204, 0.516971,
     0.556738, 0.596505, 0.636272, 0.676039, 0.715806, 0.755573, 0.79534,
@@ -94,7 +93,7 @@ static std::unique_ptr<InterpolateData2DSpline>
 ///@}
 
 /// Total π+- + π-+ -> π+- + π-+ + γ cross section
-const std::initializer_list<double> BREMS_PIPI_PIPI_OPP_SIG = {
+constexpr double BREMS_PIPI_PIPI_OPP_SIG[] = {
     0.00747491, 0.0122921, 0.0176876, 0.0236189, 0.0301352, 0.0372133, 0.044843,
     0.05311,    0.0621347, 0.0720515, 0.0824852, 0.0940721, 0.106591,  0.120533,
     0.135286,   0.151444,  0.169051,  0.188232,  0.20997,   0.233411,  0.259348,
@@ -136,7 +135,7 @@ const std::initializer_list<double> BREMS_PIPI_PIPI_OPP_SIG = {
     52.6948,    53.6507,   54.7555,   55.6072};
 
 /// dSigma/dk for π+- + π-+ -> π+- + π-+ + γ
-const std::initializer_list<double> BREMS_PIPI_PIPI_OPP_DIFF_SIG_K = {
+constexpr double BREMS_PIPI_PIPI_OPP_DIFF_SIG_K[] = {
     8.21892,     7.55436,   7.08325,     6.5781,      6.09324,   5.63109,
     5.19069,     4.83512,   4.49386,     4.18069,     3.86107,   3.54472,
     3.26334,     3.06083,   2.81386,     2.59901,     2.42298,   2.21835,
@@ -4639,7 +4638,7 @@ const std::initializer_list<double> BREMS_PIPI_PIPI_OPP_DIFF_SIG_K = {
     15.6344,     13.7507,   12.4257,     10.3264,     9.03365,   7.02183};
 
 /// dSigma/dtheta for π+- + π-+ -> π+- + π-+ + γ
-const std::initializer_list<double> BREMS_PIPI_PIPI_OPP_DIFF_SIG_THETA = {
+constexpr double BREMS_PIPI_PIPI_OPP_DIFF_SIG_THETA[] = {
     0.0,         0.000205807, 0.000416519, 0.000634403, 0.00085428,
     0.00108768,  0.00132836,  0.00159196,  0.0018614,   0.00215746,
     0.00244745,  0.00275881,  0.00312114,  0.00345015,  0.00380256,
@@ -8974,7 +8973,7 @@ static std::unique_ptr<InterpolateData2DSpline>
 ///@}
 
 /// Total π+ + π+ -> π+ + π+ + γ or π- + π- -> π- + π- + γ cross section
-const std::initializer_list<double> BREMS_PIPI_PIPI_SAME_SIG = {
+constexpr double BREMS_PIPI_PIPI_SAME_SIG[] = {
     0.000969136, 0.00233271, 0.0044325, 0.00734116, 0.0111208, 0.0158084,
     0.0213911,   0.0279234,  0.0353036, 0.0436295,  0.052903,  0.0628584,
     0.0735025,   0.0850656,  0.0971299, 0.109618,   0.122981,  0.136364,
@@ -9022,7 +9021,7 @@ const std::initializer_list<double> BREMS_PIPI_PIPI_SAME_SIG = {
     14.9083,     15.4436,    15.9466,   16.4654,    16.9964,   17.5169};
 
 /// dSigma/dk for π+ + π+ -> π+ + π+ + γ or π- + π- -> π- + π- + γ
-const std::initializer_list<double> BREMS_PIPI_PIPI_SAME_DIFF_SIG_K = {
+constexpr double BREMS_PIPI_PIPI_SAME_DIFF_SIG_K[] = {
     1.13979,      1.04659,      0.979941,     0.908479,    0.83872,
     0.770901,     0.705981,     0.652866,     0.603964,    0.562142,
     0.518838,     0.476759,     0.44213,      0.407105,    0.372979,
@@ -14425,7 +14424,7 @@ const std::initializer_list<double> BREMS_PIPI_PIPI_SAME_DIFF_SIG_K = {
     1.12487,      0.339727,     -0.491037,    -1.1052,     -1.70282};
 
 /// dSigma/dtheta for π+ + π+ -> π+ + π+ + γ or π- + π- -> π- + π- + γ
-const std::initializer_list<double> BREMS_PIPI_PIPI_SAME_DIFF_SIG_THETA = {
+constexpr double BREMS_PIPI_PIPI_SAME_DIFF_SIG_THETA[] = {
     0.0,          1.85249e-05,  3.97272e-05,  6.58032e-05,  9.81839e-05,
     0.000138641,  0.000186201,  0.000244324,  0.0003192,    0.00039294,
     0.000486333,  0.000570778,  0.000665129,  0.00077228,   0.00086821,
@@ -18759,7 +18758,7 @@ static std::unique_ptr<InterpolateData2DSpline>
 ///@}
 
 /// Total π0 + π -> π0 + π + γ cross section
-const std::initializer_list<double> BREMS_PIPI0_PIPI0_SIG = {
+constexpr double BREMS_PIPI0_PIPI0_SIG[] = {
     0.000625976, 0.00116288, 0.00186253, 0.00273701, 0.00379631, 0.00504406,
     0.006494,    0.00815472, 0.010039,   0.0121276,  0.0144762,  0.0170627,
     0.0199012,   0.0230232,  0.0264171,  0.0301331,  0.0341527,  0.0386071,
@@ -18807,7 +18806,7 @@ const std::initializer_list<double> BREMS_PIPI0_PIPI0_SIG = {
     0.490871,    0.494447,   0.498399,   0.500296,   0.502299,   0.505274};
 
 /// dSigma/dk for π0 + π -> π0 + π + γ
-const std::initializer_list<double> BREMS_PIPI0_PIPI0_DIFF_SIG_K = {
+constexpr double BREMS_PIPI0_PIPI0_DIFF_SIG_K[] = {
     0.69421,    0.637282,   0.594194,  0.547993,   0.507123,   0.472114,
     0.438146,   0.409273,   0.380229,  0.351611,   0.322389,   0.295293,
     0.276473,   0.255512,   0.234847,  0.215564,   0.198408,   0.183088,
@@ -23310,7 +23309,7 @@ const std::initializer_list<double> BREMS_PIPI0_PIPI0_DIFF_SIG_K = {
     0.235914,   0.221734,   0.210735,  0.195509,   0.190677,   0.166373};
 
 /// dSigma/dtheta for π0 + π -> π0 + π + γ
-const std::initializer_list<double> BREMS_PIPI0_PIPI0_DIFF_SIG_THETA = {
+constexpr double BREMS_PIPI0_PIPI0_DIFF_SIG_THETA[] = {
     0.0,         1.00301e-05, 2.04946e-05, 3.2245e-05,  4.57177e-05,
     6.11699e-05, 8.02526e-05, 0.000100126, 0.00012491,  0.000152386,
     0.000184606, 0.000216611, 0.000254121, 0.000291598, 0.00033639,
@@ -27644,7 +27643,7 @@ static std::unique_ptr<InterpolateData2DSpline>
 ///@}
 
 /// Total π+- + π-+ -> π0 + π0 + γ cross section
-const std::initializer_list<double> BREMS_PIPI_PI0PI0_SIG = {
+constexpr double BREMS_PIPI_PI0PI0_SIG[] = {
     0.00457071, 0.00772885, 0.0114012, 0.0155544, 0.0201595, 0.0251539,
     0.0305346,  0.0363153,  0.0424065, 0.0488261, 0.0555363, 0.0624677,
     0.0696306,  0.0771624,  0.0848192, 0.0924929, 0.100567,  0.108471,
@@ -27692,7 +27691,7 @@ const std::initializer_list<double> BREMS_PIPI_PI0PI0_SIG = {
     5.16137,    5.2354,     5.3095,    5.38155,   5.45458,   5.53355};
 
 /// dSigma/dk for π+- + π-+ -> π0 + π0 + γ
-const std::initializer_list<double> BREMS_PIPI_PI0PI0_DIFF_SIG_K = {
+constexpr double BREMS_PIPI_PI0PI0_DIFF_SIG_K[] = {
     4.63982,   4.26381,   3.99964,   3.71637,   3.45268,   3.21065,   2.97426,
     2.76969,   2.56918,   2.37902,   2.21121,   2.05209,   1.9078,    1.76282,
     1.63289,   1.50499,   1.38945,   1.29125,   1.19324,   1.10437,   1.02,
@@ -31553,7 +31552,7 @@ const std::initializer_list<double> BREMS_PIPI_PI0PI0_DIFF_SIG_K = {
     1.30287};
 
 /// dSigma/dtheta for π+- + π-+ -> π0 + π0 + γ
-const std::initializer_list<double> BREMS_PIPI_PI0PI0_DIFF_SIG_THETA = {
+constexpr double BREMS_PIPI_PI0PI0_DIFF_SIG_THETA[] = {
     0.0,         8.56877e-07, 5.84503e-06, 1.89182e-05, 4.3739e-05,
     8.43243e-05, 0.000142596, 0.000221554, 0.000324059, 0.000448915,
     0.000604283, 0.000785765, 0.000985555, 0.00121326,  0.0014729,
@@ -35887,7 +35886,7 @@ static std::unique_ptr<InterpolateData2DSpline>
 ///@}
 
 /// Total π0 + π0 -> π+- + π-+ + γ cross section
-const std::initializer_list<double> BREMS_PI0PI0_PIPI_SIG = {
+constexpr double BREMS_PI0PI0_PIPI_SIG[] = {
     0.00374696, 0.0066083, 0.0100281, 0.0139631, 0.0183743, 0.0232446,
     0.0284963,  0.0341438, 0.0401092, 0.0464018, 0.0530097, 0.0598577,
     0.0669396,  0.0741965, 0.0817042, 0.089421,  0.0971026, 0.105136,
@@ -35935,7 +35934,7 @@ const std::initializer_list<double> BREMS_PI0PI0_PIPI_SIG = {
     4.50874,    4.57853,   4.6506,    4.71556,   4.78389,   4.84969};
 
 /// dSigma/dk for π0 + π0 -> π+- + π-+ + γ
-const std::initializer_list<double> BREMS_PI0PI0_PIPI_DIFF_SIG_K = {
+constexpr double BREMS_PI0PI0_PIPI_DIFF_SIG_K[] = {
     4.50973,     4.14627,     3.88822,      3.61153,     3.34296,
     3.08359,     2.83718,     2.64002,      2.44346,     2.25225,
     2.0735,      1.90341,     1.75753,      1.61906,     1.49943,
@@ -41338,7 +41337,7 @@ const std::initializer_list<double> BREMS_PI0PI0_PIPI_DIFF_SIG_K = {
     1.27668,     1.11712,     0.979815,     0.840532,    0.744596};
 
 /// dSigma/dtheta for π0 + π0 -> π+- + π-+ + γ
-const std::initializer_list<double> BREMS_PI0PI0_PIPI_DIFF_SIG_THETA = {
+constexpr double BREMS_PI0PI0_PIPI_DIFF_SIG_THETA[] = {
     0.0,         0.000182534, 0.000363326, 0.000541335, 0.000731229,
     0.000899997, 0.0010819,   0.00126029,  0.00142635,  0.00160006,
     0.00175408,  0.00192409,  0.00211212,  0.00227348,  0.00242262,
@@ -10,7 +10,10 @@
 #ifndef SRC_INCLUDE_SMASH_CROSSSECTIONSPHOTON_H_
 #define SRC_INCLUDE_SMASH_CROSSSECTIONSPHOTON_H_
 
+#include <filesystem>
+
 #include "kinematics.h"
+#include "sha256.h"
 
 namespace smash {
 /** Cross section after cut off.
@@ -31,10 +34,10 @@ namespace smash {
 double cut_off(const double sigma_mb);
 
 /**
- * Calculation method for the cross sections. It has only one member at the
- * moment. In the future there will be more options.
+ * Calculation method for the cross sections: either the analytic formulas are
+ * evaluated or their values are looked up in tables.
  */
-enum class ComputationMethod { Analytic };
+enum class ComputationMethod { Analytic, Lookup };
 
 template <ComputationMethod method>
 class CrosssectionsPhoton {};
@@ -152,6 +155,100 @@ class CrosssectionsPhoton<ComputationMethod::Analytic> {
   constexpr static double a1_mass = 1.26;
 };
 
+/**
+ * Class to look up the cross-section of a meson-meson to meson-photon process
+ * in tables of the analytic formulas. This template specialization has the
+ * same functions as the one for ComputationMethod::Analytic.
+ *
+ * Every cross section is tabulated on a regular grid in \f$\sqrt{s}\f$ and
+ * the rho mass and, for the differential ones, in t between its kinematic
+ * limits, and it is linearly interpolated. At the center of every cell of
+ * the grid the interpolation is compared to the analytic formula. Cells
+ * failing this check, e.g. close to the thresholds, as well as values outside
+ * the grid are computed with the analytic formula instead.
+ */
+template <>
+class CrosssectionsPhoton<ComputationMethod::Lookup> {
+ public:
+  /**
+   * Set where the tables are stored and read from by create_tables().
+   *
+   * \param[in] hash Hash of the SMASH version, particles and decay modes.
+   * \param[in] tabulations_path Tabulations directory, none if empty.
+   */
+  static void set_cache(const sha256::Hash &hash,
+                        const std::filesystem::path &tabulations_path);
+
+  /**
+   * Create the tables of all photon processes, which has to be done before
+   * any cross section is looked up. They are read from the tabulations
+   * directory given to set_cache() if they were stored there for the same
+   * hash and accuracy, and they are stored there otherwise.
+   *
+   * \param[in] accuracy Largest deviation of the interpolation from the
+   *            analytic formula relative to the largest value in a cell of
+   *            the tables, above which the formula is used in the cell.
+   * \throw std::invalid_argument if \p accuracy is not positive.
+   */
+  static void create_tables(double accuracy);
+
+  /** @name Total cross-section
+   * Total cross sections for given photon process, see the analytic ones.
+   *
+   * \param[in] s Mandelstam-s [GeV^2]
+   * \param[in] m_rho Mass of participating rho-meson [GeV]
+   * \returns photon cross-section [mb]
+   */
+  ///@{
+  static double xs_pi_pi_rho0(const double s, const double m_rho);
+  static double xs_pi_pi0_rho(const double s, const double m_rho);
+  static double xs_pi0_rho0_pi0(const double s, const double m_rho);
+  static double xs_pi_rho0_pi(const double s, const double m_rho);
+
+  static double xs_pi_rho_pi0(const double s, const double m_rho);
+  static double xs_pi_rho_pi0_rho_mediated(const double s, const double m_rho);
+  static double xs_pi_rho_pi0_omega_mediated(const double s,
+                                             const double m_rho);
+
+  static double xs_pi0_rho_pi(const double s, const double m_rho);
+  static double xs_pi0_rho_pi_rho_mediated(const double s, const double m_rho);
+  static double xs_pi0_rho_pi_omega_mediated(const double s,
+                                             const double m_rho);
+  ///@}
+
+  /** @name Differential cross-section
+   * Differential cross section for given photon process, see the analytic
+   * ones.
+   *
+   * \param[in] s Mandelstam-s [GeV^2]
+   * \param[in] t Mandelstam-t [GeV^2]
+   * \param[in] m_rho Mass of participating rho-meson [GeV]
+   * \returns photon cross-section [mb]
+   */
+  ///@{
+  static double xs_diff_pi_pi_rho0(const double s, const double t,
+                                   const double m_rho);
+  static double xs_diff_pi_pi0_rho(const double s, const double t,
+                                   const double m_rho);
+  static double xs_diff_pi0_rho0_pi0(const double s, const double t,
+                                     const double m_rho);
+  static double xs_diff_pi_rho0_pi(const double s, const double t,
+                                   const double m_rho);
+
+  static double xs_diff_pi_rho_pi0_rho_mediated(const double s, const double t,
+                                                const double m_rho);
+  static double xs_diff_pi_rho_pi0_omega_mediated(const double s,
+                                                  const double t,
+                                                  const double m_rho);
+
+  static double xs_diff_pi0_rho_pi_rho_mediated(const double s, const double t,
+                                                const double m_rho);
+  static double xs_diff_pi0_rho_pi_omega_mediated(const double s,
+                                                  const double t,
+                                                  const double m_rho);
+  ///@}
+};
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_CROSSSECTIONSPHOTON_H_
@@ -7,6 +7,8 @@
 #ifndef SRC_INCLUDE_SMASH_CUSTOMNUCLEUS_H_
 #define SRC_INCLUDE_SMASH_CUSTOMNUCLEUS_H_
 
+#include <cstddef>
+#include <filesystem>
 #include <fstream>
 #include <map>
 #include <memory>
@@ -34,6 +36,64 @@ struct Nucleoncustom {
   bool isospin;
 };
 
+/**
+ * Nucleons of an external list, which are mapped from a binary cache next to
+ * the list instead of being parsed line by line.
+ *
+ * The cache holds the nucleons of all lines of the list in one flat array, in
+ * the order in which CustomNucleus::readfile reads them from the text. It is
+ * rebuilt whenever the size or the modification time of the list differ from
+ * the ones it was built for. If the cache cannot be written, the parsed
+ * nucleons are kept in memory instead.
+ */
+class CustomNucleusCache {
+ public:
+  /**
+   * Map the cache of a list, building it first if necessary.
+   *
+   * \param[in] list The external list of nucleons.
+   * \throw std::runtime_error if the list cannot be read or holds no nucleon.
+   */
+  explicit CustomNucleusCache(const std::filesystem::path& list);
+  /// Cannot be copied
+  CustomNucleusCache(const CustomNucleusCache&) = delete;
+  /// Cannot be copied
+  CustomNucleusCache& operator=(const CustomNucleusCache&) = delete;
+
+  /**
+   * \param[in] list The external list of nucleons.
+   * \return The path of the cache of the list.
+   */
+  static std::filesystem::path cache_path(const std::filesystem::path& list);
+
+  /// \return The number of nucleons in the list.
+  std::size_t size() const { return size_; }
+  /**
+   * \param[in] i Index of a nucleon in the list.
+   * \return The nucleon.
+   */
+  const Nucleoncustom& operator[](std::size_t i) const { return data_[i]; }
+  /// \return The next nucleon, starting over at the end of the list.
+  const Nucleoncustom& next() {
+    if (position_ == size_) {
+      position_ = 0;
+    }
+    return data_[position_++];
+  }
+
+ private:
+  /// The mapped cache, which is unmapped with this object
+  std::shared_ptr<const char> mapping_;
+  /// The parsed nucleons, if the cache could not be written
+  std::vector<Nucleoncustom> parsed_;
+  /// The nucleons
+  const Nucleoncustom* data_ = nullptr;
+  /// Number of nucleons
+  std::size_t size_ = 0;
+  /// Index of the next nucleon
+  std::size_t position_ = 0;
+};
+
 /**
  * Inheriting from Nucleus-Class using modified Nucleon configurations.
  * Configurations are read in from external lists.
@@ -103,6 +163,29 @@ class CustomNucleus : public Nucleus {
   std::unique_ptr<std::ifstream> filestream_;
   /// Pointer to the used filestream pointer
   std::unique_ptr<std::ifstream>* used_filestream_;
+  /**
+   * Binary cache used instead of filestream_shared_ if projectile and target
+   * are read in from the same file.
+   */
+  static std::unique_ptr<CustomNucleusCache> cache_shared_;
+  /// Binary cache used instead of filestream_
+  std::unique_ptr<CustomNucleusCache> cache_;
+  /// Pointer to the used cache pointer, nullptr if the file is parsed
+  std::unique_ptr<CustomNucleusCache>* used_cache_ = nullptr;
+  /**
+   * Read the nucleons of the next nucleus, from the binary cache if it is
+   * used, otherwise from the file stream.
+   */
+  std::vector<Nucleoncustom> read_next_nucleus();
+  /**
+   * Check that the nucleons of one nucleus are the protons and neutrons
+   * specified in the config.
+   *
+   * \param[in] custom_nucleus The nucleons of one nucleus.
+   * \throw std::runtime_error if the numbers of protons or neutrons differ.
+   */
+  void check_composition(
+      const std::vector<Nucleoncustom>& custom_nucleus) const;
   /**
    * Number of nucleons per nucleus
    * Set initally to zero to be modified in the constructor.
@@ -51,6 +51,17 @@ class DecayAction : public Action {
    */
   void add_decay(DecayBranchPtr p);
 
+  /**
+   * Sample the decay channel from precomputed alias tables instead of the
+   * partial widths, if the tabulated channel is open.
+   *
+   * \param[in] table The tabulated branching ratios of the decaying type, or
+   *            nothing to always sample from the partial widths.
+   */
+  void set_channel_table(const DecayChannelTable* table) {
+    channel_table_ = table;
+  }
+
   /**
    * Generate the final state of the decay process.
    * Performs a decay of one particle to two or three particles.
@@ -186,6 +197,9 @@ class DecayAction : public Action {
   /// Angular momentum of the decay
   int L_ = 0;
 
+  /// Tabulated branching ratios used to sample the channel, if any
+  const DecayChannelTable* channel_table_ = nullptr;
+
  private:
   /// Spin interaction type
   SpinInteractionType spin_interaction_type_;
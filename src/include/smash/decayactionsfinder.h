@@ -10,13 +10,113 @@
 #ifndef SRC_INCLUDE_SMASH_DECAYACTIONSFINDER_H_
 #define SRC_INCLUDE_SMASH_DECAYACTIONSFINDER_H_
 
+#include <functional>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "actionfinderfactory.h"
+#include "fourvector.h"
 #include "input_keys.h"
 
 namespace smash {
 
+/**
+ * \ingroup action
+ * The decay times of the resonances of one ensemble, which are sampled once
+ * per momentum of a resonance instead of in every time step, see
+ * \ref key_CT_presample_decay_times_.
+ *
+ * The decay law has no memory, hence a decay time sampled for a resonance
+ * stays valid as long as its width and its Lorentz factor do not change,
+ * i.e. as long as its momentum does not change. The decay times are kept by
+ * the id of the resonance together with its momentum at sampling, and in a
+ * queue ordered by time, such that the times which have passed are forgotten
+ * without looking at the particles.
+ *
+ * The DecayActionsFinder uses the decay times installed for the calling thread
+ * with a DecayTimes::Scoped object, like the random engine of an ensemble.
+ */
+class DecayTimes {
+ public:
+  /// Forget all decay times, e.g. at the start of an event.
+  void clear();
+
+  /**
+   * Forget the decay times before the given time. Their resonances have
+   * decayed or changed since, or their decay action was discarded, in which
+   * case a new decay time is sampled.
+   *
+   * \param[in] time Current time [fm].
+   */
+  void forget_before(double time);
+
+  /**
+   * \param[in] p A resonance.
+   * \return Its decay time [fm], infinite if it cannot decay, or nothing if
+   *         none was sampled for its current momentum.
+   */
+  std::optional<double> find(const ParticleData &p) const;
+
+  /**
+   * Remember the decay time of a resonance with its current momentum.
+   *
+   * \param[in] p The resonance.
+   * \param[in] time Its decay time [fm], infinite if it cannot decay.
+   */
+  void remember(const ParticleData &p, double time);
+
+  /// \return The number of remembered decay times.
+  std::size_t size() const { return times_.size(); }
+
+  /// \return The decay times installed for the calling thread, if any.
+  static DecayTimes *current() { return current_; }
+
+  /// Installs decay times for the calling thread while it exists.
+  class Scoped {
+   public:
+    /**
+     * Install the given decay times.
+     *
+     * \param[in] decay_times The decay times used by the calling thread, none
+     *            if null. They have to outlive this object.
+     */
+    explicit Scoped(DecayTimes *decay_times) : previous_(current_) {
+      current_ = decay_times;
+    }
+    /// Cannot be copied
+    Scoped(const Scoped &) = delete;
+    /// Cannot be copied
+    Scoped &operator=(const Scoped &) = delete;
+    /// Restore the previous decay times of the calling thread.
+    ~Scoped() { current_ = previous_; }
+
+   private:
+    /// The decay times installed before
+    DecayTimes *previous_;
+  };
+
+ private:
+  /// The decay time of a resonance
+  struct Entry {
+    /// Momentum of the resonance when the time was sampled [GeV]
+    FourVector momentum;
+    /// Decay time [fm]
+    double time;
+  };
+
+  /// The decay times by the id of the resonance
+  std::unordered_map<int, Entry> times_;
+  /// The finite decay times with the id of their resonance, earliest first
+  std::priority_queue<std::pair<double, int>,
+                      std::vector<std::pair<double, int>>, std::greater<>>
+      queue_;
+  /// The decay times installed for the calling thread
+  static thread_local DecayTimes *current_;
+};
+
 /**
  * \ingroup action
  * A simple decay finder:
@@ -46,17 +146,21 @@ class DecayActionsFinder : public ActionFinderInterface {
   /**
    * Check the whole particle list for decays.
    *
+   * If decay times are installed for the calling thread, see DecayTimes, and
+   * the widths do not depend on the position, the decay time of a resonance is
+   * only sampled if none is known for its current momentum.
+   *
    * \param[in] search_list All particles in grid cell.
    * \param[in] dt Size of timestep [fm]
    * \return List with the found (Decay)Action objects.
    */
   ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, const double,
+      ParticleSpan search_list, double dt, const double,
       const std::vector<FourVector> &) const override;
 
   /// Ignore the neighbor searches for decays
   ActionList find_actions_with_neighbors(
-      const ParticleList &, const ParticleList &, double,
+      ParticleSpan, ParticleSpan, double,
       const std::vector<FourVector> &) const override {
     return {};
   }
@@ -67,6 +171,12 @@ class DecayActionsFinder : public ActionFinderInterface {
       const std::vector<FourVector> &) const override {
     return {};
   }
+  /// Ignore the surrounding searches for decays
+  ActionList find_actions_with_surrounding_particles(
+      const ParticleList &, const std::vector<const ParticleData *> &, double,
+      const std::vector<FourVector> &) const override {
+    return {};
+  }
 
   /**
    * Force all resonances to decay at the end of the simulation.
@@ -76,6 +186,9 @@ class DecayActionsFinder : public ActionFinderInterface {
    */
   ActionList find_final_actions(const Particles &search_list) const override;
 
+  /// \return The name of the finder in the time profile
+  std::string name() const override { return "decay finder"; }
+
   /// Multiplicative factor to be applied to resonance lifetimes
   const double res_lifetime_factor_ = 1.;
 
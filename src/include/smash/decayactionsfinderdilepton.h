@@ -10,6 +10,9 @@
 #ifndef SRC_INCLUDE_SMASH_DECAYACTIONSFINDERDILEPTON_H_
 #define SRC_INCLUDE_SMASH_DECAYACTIONSFINDERDILEPTON_H_
 
+#include <cstdint>
+#include <vector>
+
 #include "outputinterface.h"
 
 namespace smash {
@@ -29,8 +32,12 @@ namespace smash {
  */
 class DecayActionsFinderDilepton {
  public:
-  /// Initialize the finder
-  DecayActionsFinderDilepton() {}
+  /**
+   * Initialize the finder, classifying the decay modes of all particle types
+   * once, such that particles without dilepton decay modes are skipped
+   * without computing any widths.
+   */
+  DecayActionsFinderDilepton();
 
   /**
    * Check the whole particles list and print out possible dilepton decays.
@@ -42,6 +49,17 @@ class DecayActionsFinderDilepton {
   void shine(const Particles& search_list, OutputInterface* output,
              double dt) const;
 
+  /**
+   * Print out the possible dilepton decays of a single particle, which
+   * propagated freely for the given time, e.g. a particle which is propagated
+   * separately from the others.
+   *
+   * \param[in] p The particle.
+   * \param[in] output Pointer to the dilepton output.
+   * \param[in] dt Length of the free propagation of the particle [fm]
+   */
+  void shine(const ParticleData& p, OutputInterface* output, double dt) const;
+
   /**
    * Shine dileptons from resonances at the end of the simulation.
    *
@@ -56,6 +74,43 @@ class DecayActionsFinderDilepton {
    */
   void shine_final(const Particles& search_list, OutputInterface* output,
                    bool only_res = false) const;
+
+ private:
+  /// Which decay modes of a type are dilepton decays
+  enum class DileptonModes : uint8_t {
+    /// None, or the type has no decay modes at all
+    None,
+    /// Some, besides other decay modes
+    Some,
+    /// All decay modes
+    Only,
+  };
+
+  /**
+   * Print out the possible dilepton decays of a particle, without checking
+   * that the output is a dilepton output.
+   *
+   * \param[in] p The particle.
+   * \param[in] output Pointer to the dilepton output.
+   * \param[in] dt Length of the free propagation of the particle [fm]
+   */
+  void shine_particle(const ParticleData& p, OutputInterface* output,
+                      double dt) const;
+
+  /**
+   * \param[in] type A particle type.
+   * \return Which decay modes of the type are dilepton decays.
+   */
+  static DileptonModes classify(const ParticleType& type);
+
+  /**
+   * \param[in] type A particle type.
+   * \return Which decay modes of the type are dilepton decays.
+   */
+  DileptonModes dilepton_modes(const ParticleType& type) const;
+
+  /// Dilepton decay modes of all types, indexed like ParticleType::list_all()
+  std::vector<DileptonModes> dilepton_modes_;
 };
 
 }  // namespace smash
@@ -0,0 +1,100 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_DECAYCHANNELTABLE_H_
+#define SRC_INCLUDE_SMASH_DECAYCHANNELTABLE_H_
+
+#include <optional>
+#include <vector>
+
+#include "forwarddeclarations.h"
+#include "particletype.h"
+#include "random.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ *
+ * \brief Precomputed alias tables for sampling the decay channel of a type
+ *
+ * The branching ratios of a particle type are tabulated as alias tables in
+ * bins of the mass of the decaying particle, such that a decay channel is
+ * found with a single random number in a constant time, instead of summing
+ * and scanning the partial widths of all channels. If the branching ratios do
+ * not depend on the mass, a single table is used for all masses.
+ *
+ * Within a bin the branching ratios at the centre of the bin are used, the
+ * sampled channels are hence only approximately distributed like the partial
+ * widths at the actual mass. The mass dependence of the widths due to
+ * potentials is not tabulated, the tables must not be used with potentials.
+ */
+class DecayChannelTable {
+ public:
+  /**
+   * Tabulate the branching ratios of a type.
+   *
+   * \param[in] type The decaying type.
+   * \param[in] wh Which decay modes are tabulated.
+   * \param[in] n_bins Number of mass bins from the minimal kinematic mass up
+   *            to the pole mass plus ten widths.
+   */
+  DecayChannelTable(const ParticleType &type, WhichDecaymodes wh,
+                    int n_bins = 200);
+
+  /**
+   * Sample a decay channel.
+   *
+   * \param[in] m Mass of the decaying particle.
+   * \param[in] channels The decay modes with their partial widths at \p m, as
+   *            given by ParticleType::get_partial_widths.
+   * \return The sampled channel out of \p channels, or nothing if the mass is
+   *         not tabulated or the channel sampled from the table is closed at
+   *         \p m. The channel should then be chosen from the partial widths.
+   */
+  const DecayBranch *sample(double m, const DecayBranchList &channels) const;
+
+  /// \return Whether one table is used for all masses.
+  bool is_mass_independent() const { return bins_.size() == 1; }
+
+  /**
+   * Tabulate the hadronic decays of all unstable types, to be used by the
+   * DecayAction created by DecayActionsFinder::find_actions_in_cell.
+   *
+   * \param[in] n_bins Number of mass bins of every table.
+   */
+  static void create_tables(int n_bins = 200);
+
+  /// Remove the tables, such that the channels are sampled from the widths.
+  static void clear_tables() { hadronic_tables_.clear(); }
+
+  /**
+   * \param[in] type A particle type.
+   * \return The table of the hadronic decays of \p type, or nothing if the
+   *         tables were not created or the type is stable.
+   */
+  static const DecayChannelTable *find(const ParticleType &type);
+
+ private:
+  /// The decay modes labelled by the values of the alias tables
+  std::vector<const DecayType *> modes_;
+  /// Lower bound of the tabulated masses
+  double m_min_ = 0.;
+  /// Inverse width of a mass bin
+  double inv_dm_ = 0.;
+  /// The alias table of every mass bin, nothing if all channels are closed
+  std::vector<std::optional<random::alias_dist>> bins_;
+
+  /// The hadronic tables of all types, in the order of ParticleType::list_all
+  static std::vector<std::optional<DecayChannelTable>> hadronic_tables_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_DECAYCHANNELTABLE_H_
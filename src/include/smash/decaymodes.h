@@ -7,6 +7,7 @@
 #ifndef SRC_INCLUDE_SMASH_DECAYMODES_H_
 #define SRC_INCLUDE_SMASH_DECAYMODES_H_
 
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -16,6 +17,56 @@
 
 namespace smash {
 
+/**
+ * \ingroup data
+ *
+ * A decay mode of a particle type with all properties needed to evaluate its
+ * mass-dependent partial width.
+ *
+ * The channels of a type are stored contiguously, see DecayModes::channels(),
+ * and the widths of the most common decay types are evaluated from the
+ * precomputed values without calling DecayType::width.
+ */
+struct DecayChannel {
+  /// How the partial width depends on the mass of the decaying particle
+  enum class Shape : std::uint8_t {
+    /// Two stable daughters, see TwoBodyDecayStable
+    TwoBodyStable,
+    /// A lepton pair, see TwoBodyDecayDilepton
+    TwoBodyDilepton,
+    /// The partial width at the pole mass, see ThreeBodyDecay
+    Constant,
+    /// Evaluated by DecayType::width
+    Other,
+  };
+
+  /**
+   * Evaluate the partial width, like ParticleType::partial_width.
+   *
+   * \param[in] m0 Pole mass of the decaying particle [GeV].
+   * \param[in] m Actual mass of the decaying particle [GeV].
+   * \return The partial width at mass \p m [GeV].
+   */
+  double width(double m0, double m) const;
+
+  /// The decay type
+  const DecayType *type;
+  /// Shape of the mass dependence of the width
+  Shape shape;
+  /// Whether the decay produces a lepton pair
+  bool is_dilepton;
+  /// Angular momentum of the decay
+  int angular_momentum;
+  /// Sum of the minimal masses of the daughters [GeV]
+  double threshold;
+  /// Partial width at the pole mass of the decaying particle [GeV]
+  double width_at_pole;
+  /// Pole masses of the first two daughters [GeV]
+  double mass_a, mass_b;
+  /// \f$\rho(m_0)\f$ of a decay into two stable daughters, else 0
+  double rho_at_pole;
+};
+
 /**
  * \ingroup data
  *
@@ -62,6 +113,13 @@ class DecayModes {
   /// \return pass out the decay modes list
   const DecayBranchList &decay_mode_list() const { return decay_modes_; }
 
+  /**
+   * \return The decay modes with their properties for evaluating the widths,
+   *         in the order of decay_mode_list(). They are filled once all decay
+   *         modes are loaded, see create_channel_tables().
+   */
+  const std::vector<DecayChannel> &channels() const { return channels_; }
+
   /**
    * Loads the DecayModes map as described in the \p input string.
    *
@@ -97,6 +155,13 @@ class DecayModes {
   static DecayType *get_decay_type(ParticleTypePtr mother,
                                    ParticleTypePtrList particle_types, int L);
 
+  /**
+   * Fill the channels of the decay modes of all particle types from their
+   * decay branches. This has to be done after all decay modes are known and
+   * before any width is evaluated.
+   */
+  static void create_channel_tables();
+
   /// \ingroup exception
   struct InvalidDecay : public std::invalid_argument {
     using std::invalid_argument::invalid_argument;
@@ -122,9 +187,37 @@ class DecayModes {
    */
   DecayBranchList decay_modes_;
 
+  /// The decay modes in a flat representation, see channels()
+  std::vector<DecayChannel> channels_;
+
+  /**
+   * Create a new decay type, without looking for an existing one.
+   *
+   * \param[in] mother the decaying particle
+   * \param[in] particle_types the products of the decay
+   * \param[in] L the angular momentum
+   * \return the new DecayType object, appended to the list of all decay types
+   * \throw InvalidDecay if there are less than 2 or more than 3 products
+   */
+  static DecayType *create_decay_type(ParticleTypePtr mother,
+                                      ParticleTypePtrList particle_types,
+                                      int L);
+
+  /**
+   * Create empty lists of all decay types and of the decay modes of all
+   * particle types.
+   */
+  static void reset_decaymodes();
+
+  /// \return all decay types in the order they were created
+  static const std::vector<DecayTypePtr> &list_all_decay_types();
+
   /// allow ParticleType::decay_modes to access all_decay_modes
   friend const DecayModes &ParticleType::decay_modes() const;
 
+  /// allow the TypeCache to store and restore all decay types and modes
+  friend struct TypeCache;
+
   /**
    * A list of all DecayModes objects using the same indexing as
    * all_particle_types.
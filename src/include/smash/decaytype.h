@@ -9,6 +9,7 @@
 #define SRC_INCLUDE_SMASH_DECAYTYPE_H_
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "forwarddeclarations.h"
@@ -232,6 +233,9 @@ class TwoBodyDecaySemistable : public TwoBodyDecay {
 
   /// Tabulation of the resonance integrals.
   mutable std::unique_ptr<Tabulation> tabulation_;
+
+  /// Guard for the lazy and thread-safe creation of the tabulation.
+  mutable std::once_flag tabulation_created_;
 };
 
 /**
@@ -268,6 +272,9 @@ class TwoBodyDecayUnstable : public TwoBodyDecay {
 
   /// Tabulation of the resonance integrals.
   mutable std::unique_ptr<Tabulation> tabulation_;
+
+  /// Guard for the lazy and thread-safe creation of the tabulation.
+  mutable std::once_flag tabulation_created_;
 };
 
 /**
@@ -361,6 +368,9 @@ class ThreeBodyDecayDilepton : public ThreeBodyDecay {
   /// Tabulation of the resonance integrals.
   mutable std::unique_ptr<Tabulation> tabulation_;
 
+  /// Guard for the lazy and thread-safe creation of the tabulation.
+  mutable std::once_flag tabulation_created_;
+
   /// Type of the mother particle.
   ParticleTypePtr mother_;
 };
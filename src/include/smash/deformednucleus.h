@@ -66,6 +66,14 @@ class DeformedNucleus : public Nucleus {
    */
   ThreeVector distribute_nucleon() override;
 
+  /**
+   * Choose how the nucleon positions are sampled, the deformed density is
+   * tabulated only without triaxiality.
+   *
+   * \param[in] tabulated Whether the positions are drawn from tables.
+   */
+  void set_tabulated_positions(bool tabulated) override;
+
   /**
    * Sets the deformation parameters of the radius according to the current
    * mass number.
@@ -164,6 +172,12 @@ class DeformedNucleus : public Nucleus {
   inline double get_beta4() { return beta4_; }
 
  private:
+  /// \return The largest radius of the sampled nucleons [fm].
+  double max_radius() const {
+    return Nucleus::get_nuclear_radius() / Nucleus::get_diffusiveness() +
+           Nucleus::get_nuclear_radius() * Nucleus::get_diffusiveness();
+  }
+
   /// Deformation parameter for angular momentum l=2.
   double beta2_ = 0.0;
   /// Triaxiality parameter for angular momentum l=2.
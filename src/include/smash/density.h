@@ -9,9 +9,17 @@
 #ifndef SRC_INCLUDE_SMASH_DENSITY_H_
 #define SRC_INCLUDE_SMASH_DENSITY_H_
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <tuple>
+#include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -23,7 +31,9 @@
 #include "particledata.h"
 #include "particles.h"
 #include "pdgcode.h"
+#include "threadpool.h"
 #include "threevector.h"
+#include "workloadrecorder.h"
 
 namespace smash {
 static constexpr int LDensity = LogArea::Density::id;
@@ -137,6 +147,8 @@ class DensityParameters {
   double central_weight() const { return central_weight_; }
   /// \return Range of the triangular smearing, in units of lattice spacing
   double triangular_range() const { return triangular_range_; }
+  /// \return Gaussian smearing width [fm]
+  double sigma() const { return sig_; }
   /// \return Cut-off radius [fm]
   double r_cut() const { return r_cut_; }
   /// \return Squared cut-off radius [fm\f$^2\f$]
@@ -202,6 +214,44 @@ std::pair<double, ThreeVector> unnormalized_smearing_factor(
     const ThreeVector &r, const FourVector &p, const double m_inv,
     const DensityParameters &dens_par, const bool compute_gradient = false);
 
+/**
+ * Computes the same smearing factor as above from the four-velocity of the
+ * particle, such that the four-velocity is only computed once when the
+ * particle is smeared onto many points.
+ *
+ * \param[in] r vector from the particle to the point of interest [fm]
+ * \param[in] u four-velocity of the particle, \f$ p^\mu / m \f$
+ * \param[in] dens_par object containing precomputed parameters for
+ *            density calculation.
+ * \param[in] compute_gradient option, true - compute gradient, false - no
+ * \return (smearing factor, the gradient of the smearing factor or a zero
+ *         three vector)
+ */
+inline std::pair<double, ThreeVector> unnormalized_smearing_factor(
+    const ThreeVector &r, const FourVector &u,
+    const DensityParameters &dens_par, const bool compute_gradient) {
+  const double r_sqr = r.sqr();
+  // Distance from particle to point of interest > r_cut
+  if (r_sqr > dens_par.r_cut_sqr()) {
+    return std::make_pair(0.0, ThreeVector(0.0, 0.0, 0.0));
+  }
+
+  const double u_r_scalar = r * u.threevec();
+  const double r_rest_sqr = r_sqr + u_r_scalar * u_r_scalar;
+
+  // Lorentz contracted distance from particle to point of interest > r_cut
+  if (r_rest_sqr > dens_par.r_cut_sqr()) {
+    return std::make_pair(0.0, ThreeVector(0.0, 0.0, 0.0));
+  }
+  const double sf = std::exp(-r_rest_sqr * dens_par.two_sig_sqr_inv()) * u.x0();
+  const ThreeVector sf_grad = compute_gradient
+                                  ? sf * (r + u.threevec() * u_r_scalar) *
+                                        dens_par.two_sig_sqr_inv() * 2.0
+                                  : ThreeVector(0.0, 0.0, 0.0);
+
+  return std::make_pair(sf, sf_grad);
+}
+
 /**
  * Calculates Eckart rest frame density and 4-current of a given density type
  * and optionally the gradient of the density in an arbitary frame (grad j0),
@@ -267,6 +317,12 @@ std::tuple<double, FourVector, ThreeVector, ThreeVector, FourVector, FourVector,
 current_eckart(const ThreeVector &r, const Particles &plist,
                const DensityParameters &par, DensityType dens_type,
                bool compute_gradient, bool smearing);
+/// convenience overload of the above (ParticleList -> ParticlesView)
+std::tuple<double, FourVector, ThreeVector, ThreeVector, FourVector, FourVector,
+           FourVector, FourVector>
+current_eckart(const ThreeVector &r, const ParticlesView &plist,
+               const DensityParameters &par, DensityType dens_type,
+               bool compute_gradient, bool smearing);
 
 /**
  * A class for time-efficient (time-memory trade-off) calculation of density
@@ -305,6 +361,23 @@ class DensityOnLattice {
         djmu_dxnu_({FourVector(), FourVector(), FourVector(), FourVector()}),
         drho_dxnu_(FourVector()) {}
 
+  /**
+   * Add the contents of another node, e.g. of the same node of a lattice
+   * filled with other particles.
+   *
+   * \param[in] other The node to be added.
+   * \return The sum of both nodes.
+   */
+  DensityOnLattice &operator+=(const DensityOnLattice &other) {
+    jmu_pos_ += other.jmu_pos_;
+    jmu_neg_ += other.jmu_neg_;
+    for (int k = 0; k < 4; k++) {
+      djmu_dxnu_[k] += other.djmu_dxnu_[k];
+    }
+    drho_dxnu_ += other.drho_dxnu_;
+    return *this;
+  }
+
   /**
    * Adds particle to 4-current: \f$j^{\mu} += p^{\mu}/p^0 \cdot factor \f$.
    * Two private class members jmu_pos_ and jmu_neg_ indicating the 4-current
@@ -318,7 +391,20 @@ class DensityOnLattice {
    *            proton - with factor 1) times the smearing factor.
    */
   void add_particle(const ParticleData &part, double FactorTimesSf) {
-    const FourVector part_four_velocity = FourVector(1.0, part.velocity());
+    add_particle(FourVector(1.0, part.velocity()), FactorTimesSf);
+  }
+
+  /**
+   * Adds particle to 4-current as above, given \f$p^{\mu}/p^0\f$ of the
+   * particle, which is then only computed once per particle if it is added to
+   * many nodes.
+   *
+   * \param[in] part_four_velocity \f$p^{\mu}/p^0\f$ of the particle.
+   * \param[in] FactorTimesSf particle contribution to given density type
+   *            times the smearing factor.
+   */
+  void add_particle(const FourVector &part_four_velocity,
+                    double FactorTimesSf) {
     if (FactorTimesSf > 0.0) {
       jmu_pos_ += part_four_velocity * FactorTimesSf;
     } else {
@@ -326,6 +412,24 @@ class DensityOnLattice {
     }
   }
 
+  /**
+   * Removes a particle, which was added with the same arguments before, from
+   * the 4-current. The contribution is subtracted from the current of the
+   * same charge it was added to.
+   *
+   * \param[in] part_four_velocity \f$p^{\mu}/p^0\f$ of the particle.
+   * \param[in] FactorTimesSf particle contribution to given density type
+   *            times the smearing factor.
+   */
+  void remove_particle(const FourVector &part_four_velocity,
+                       double FactorTimesSf) {
+    if (FactorTimesSf > 0.0) {
+      jmu_pos_ -= part_four_velocity * FactorTimesSf;
+    } else {
+      jmu_neg_ -= part_four_velocity * FactorTimesSf;
+    }
+  }
+
   /**
    * Adds particle to the time and spatial derivatives of the 4-current.
    * An array of four private 4-vectors djmu_dxnu_ indicating the derivatives
@@ -340,11 +444,27 @@ class DensityOnLattice {
    */
   void add_particle_for_derivatives(const ParticleData &part, double factor,
                                     ThreeVector sf_grad) {
-    const FourVector PartFourVelocity = FourVector(1.0, part.velocity());
+    const ThreeVector velocity = part.velocity();
+    add_particle_for_derivatives(factor * FourVector(1.0, velocity), velocity,
+                                 sf_grad);
+  }
+
+  /**
+   * Adds particle to the derivatives of the 4-current as above, given the
+   * quantities of the particle which are the same for all nodes.
+   *
+   * \param[in] weighted_four_velocity \f$p^{\mu}/p^0\f$ of the particle
+   *            times its contribution to the given density type.
+   * \param[in] velocity Velocity of the particle.
+   * \param[in] sf_grad Smearing factor of the gradients
+   */
+  void add_particle_for_derivatives(const FourVector &weighted_four_velocity,
+                                    const ThreeVector &velocity,
+                                    ThreeVector sf_grad) {
     for (int k = 1; k <= 3; k++) {
-      djmu_dxnu_[k] += factor * PartFourVelocity * sf_grad[k - 1];
+      djmu_dxnu_[k] += weighted_four_velocity * sf_grad[k - 1];
       djmu_dxnu_[0] -=
-          factor * PartFourVelocity * sf_grad[k - 1] * part.velocity()[k - 1];
+          weighted_four_velocity * sf_grad[k - 1] * velocity[k - 1];
     }
   }
 
@@ -510,6 +630,331 @@ class DensityOnLattice {
 /// Conveniency typedef for lattice of density
 typedef RectangularLattice<DensityOnLattice> DensityLattice;
 
+/**
+ * Remembers the particles smeared onto a lattice at its last update, such that
+ * the next update can subtract and re-add only the particles which changed
+ * since then instead of smearing all particles again, see
+ * update_lattices_accumulating_ensembles().
+ *
+ * A particle is smeared again if it is new, if it is gone, if its PDG code or
+ * number of collisions changed, if it moved by more than the tolerance in fm
+ * or if its velocity changed by more than the tolerance in units of c. The
+ * differences of the particles which are not smeared again, as well as the
+ * rounding errors of subtracting particles, accumulate on the lattice. Hence,
+ * the lattice is filled from scratch after a given number of incremental
+ * updates and whenever at least as many particles changed as there are
+ * particles, because smearing all of them is not more expensive then.
+ */
+class SmearedParticles {
+ public:
+  /**
+   * Create an empty record, such that the first update is a full one.
+   *
+   * \param[in] tolerance Largest change of the position [fm] and of the
+   *            velocity [c] of a particle which is not smeared again.
+   * \param[in] rebuild_interval Number of incremental updates between two
+   *            full ones. The updates are never incremental if it is not
+   *            positive.
+   */
+  SmearedParticles(double tolerance, int rebuild_interval)
+      : tolerance_(tolerance), rebuild_interval_(rebuild_interval) {}
+
+  /// Forget the smeared particles, such that the next update is a full one.
+  void clear();
+
+  /**
+   * Find the particles which have to be smeared again.
+   *
+   * \param[in] ensembles The current particles of every ensemble.
+   * \return Whether the lattice can be updated incrementally, i.e. by
+   *         subtracting removed() and adding added(). Otherwise, the lattice
+   *         has to be filled from scratch and remember() has to be called.
+   */
+  bool find_changes(const std::vector<Particles> &ensembles);
+
+  /// \return The particles to be subtracted, as they were smeared before.
+  const std::vector<const ParticleData *> &removed() const { return removed_; }
+
+  /// \return The particles to be smeared in their current state.
+  const std::vector<const ParticleData *> &added() const { return added_; }
+
+  /**
+   * Remember the changes found by find_changes(), after the lattice was
+   * updated incrementally. This invalidates removed() and added().
+   */
+  void remember_changes();
+
+  /**
+   * Remember all particles, after the lattice was filled from scratch.
+   *
+   * \param[in] ensembles The particles of every ensemble.
+   */
+  void remember(const std::vector<Particles> &ensembles);
+
+ private:
+  /// A smeared particle
+  struct Smeared {
+    /// The particle as it was smeared
+    ParticleData data;
+    /// The last update in which the particle was found
+    std::uint64_t seen;
+  };
+
+  /**
+   * \param[in] smeared A particle as it was smeared.
+   * \param[in] current The same particle in its current state.
+   * \return Whether the particle has to be smeared again.
+   */
+  bool changed(const ParticleData &smeared, const ParticleData &current) const;
+
+  /// Largest change of the position [fm] and velocity [c] which is ignored
+  const double tolerance_;
+  /// Number of incremental updates between two full ones
+  const int rebuild_interval_;
+  /// Number of incremental updates since the last full one
+  int updates_since_rebuild_ = 0;
+  /// Number of the current update, to find the particles which are gone
+  std::uint64_t update_ = 0;
+  /// The smeared particles of every ensemble by their id
+  std::vector<std::unordered_map<int, Smeared>> smeared_;
+  /// The particles to be subtracted
+  std::vector<const ParticleData *> removed_;
+  /// The particles to be added
+  std::vector<const ParticleData *> added_;
+  /// The ensemble of each particle to be added
+  std::vector<std::size_t> added_ensembles_;
+  /// The ensemble and id of each particle which is gone
+  std::vector<std::pair<std::size_t, int>> gone_;
+};
+
+/**
+ * Adds the contribution of a single particle to several lattices of the same
+ * geometry, each one for its own density type.
+ *
+ * The smearing weights only depend on the particle and the geometry, hence
+ * they are computed once per node and added to all lattices. Every lattice
+ * gets exactly the contributions it would get from add_particle_to_lattice().
+ *
+ * \param[inout] lats The lattices on which the content will be updated. They
+ *               must not be null and have to be identical in structure.
+ * \param[in] part The particle to be smeared onto the lattices
+ * \param[in] dens_types density types to be computed on the lattices
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] layers The layers of nodes the particle is smeared onto, all by
+ *            default.
+ * \param[in] remove Whether to subtract the contribution of the particle,
+ *            which was added before, instead of adding it.
+ * \tparam T LatticeType
+ * \tparam N Number of lattices
+ */
+template <typename T, std::size_t N>
+void add_particle_to_lattices(
+    const std::array<RectangularLattice<T> *, N> &lats,
+    const ParticleData &part, const std::array<DensityType, N> &dens_types,
+    const DensityParameters &par, const bool compute_gradient,
+    const LatticeLayers &layers = {}, const bool remove = false) {
+  if (par.only_participants()) {
+    // if this conditions holds, the hadron is a spectator
+    if (part.collisions_per_particle() == 0) {
+      return;
+    }
+  }
+  std::array<double, N> dens_factors;
+  std::array<bool, N> smeared;
+  bool smeared_to_any = false;
+  for (std::size_t k = 0; k < N; k++) {
+    dens_factors[k] = density_factor(part.type(), dens_types[k]);
+    smeared[k] = std::abs(dens_factors[k]) >= really_small;
+    smeared_to_any = smeared_to_any || smeared[k];
+  }
+  if (!smeared_to_any) {
+    return;
+  }
+  RectangularLattice<T> *lat = lats[0];
+  // the node of the k-th lattice at the same position as the given node
+  auto node_of = [&](std::size_t k, T &node) -> T & {
+    if constexpr (N == 1) {
+      return node;
+    } else {
+      if (k == 0) {
+        return node;
+      }
+      const std::size_t index = &node - &(*lat)[0];
+      return (*lats[k])[index];
+    }
+  };
+  // add or subtract the weighted contribution of the particle to a node
+  auto deposit = [&](T &node, const FourVector &four_velocity, double weight) {
+    if constexpr (std::is_same_v<T, DensityOnLattice>) {
+      if (remove) {
+        node.remove_particle(four_velocity, weight);
+      } else {
+        node.add_particle(four_velocity, weight);
+      }
+    } else {
+      node.add_particle(part, remove ? -weight : weight);
+    }
+  };
+  const FourVector p_mu = part.momentum();
+  const ThreeVector pos = part.position().threevec();
+
+  // act accordingly to which smearing is used
+  if (par.smearing() == SmearingMode::CovariantGaussian) {
+    // get the normalization factor for the covariant Gaussian smearing
+    const double norm_factor_gaus = par.norm_factor_sf();
+    // the derivatives are linear in the weights, unlike the current
+    const double derivatives_factor =
+        remove ? -norm_factor_gaus : norm_factor_gaus;
+    const double m = p_mu.abs();
+    if (unlikely(m < really_small)) {
+      logg[LDensity].warn("Gaussian smearing is undefined for momentum ",
+                          p_mu);
+      return;
+    }
+    const double m_inv = 1.0 / m;
+
+    /* The velocities of the particle are the same for all nodes, hence they
+     * are computed once here instead of at every node. */
+    const FourVector u = p_mu * m_inv;
+    const ThreeVector velocity = part.velocity();
+    const FourVector four_velocity(1.0, velocity);
+    // unweighted contributions to the densities
+    std::array<double, N> common_weights;
+    std::array<FourVector, N> weighted_four_velocities;
+    for (std::size_t k = 0; k < N; k++) {
+      common_weights[k] = dens_factors[k] * norm_factor_gaus;
+      weighted_four_velocities[k] = dens_factors[k] * four_velocity;
+    }
+    const bool gaussian_derivatives =
+        par.derivatives() == DerivativesMode::CovariantGaussian;
+    lat->iterate_in_cube(
+        pos, par.r_cut(), layers, [&](T &node, int ix, int iy, int iz) {
+          // find the weight for smearing
+          const ThreeVector r = lat->cell_center(ix, iy, iz);
+          const auto sf =
+              unnormalized_smearing_factor(pos - r, u, par, compute_gradient);
+          for (std::size_t k = 0; k < N; k++) {
+            if (!smeared[k]) {
+              continue;
+            }
+            T &node_k = node_of(k, node);
+            deposit(node_k, four_velocity, sf.first * common_weights[k]);
+            if (gaussian_derivatives) {
+              if constexpr (std::is_same_v<T, DensityOnLattice>) {
+                node_k.add_particle_for_derivatives(
+                    weighted_four_velocities[k], velocity,
+                    sf.second * derivatives_factor);
+              } else {
+                node_k.add_particle_for_derivatives(
+                    part, dens_factors[k], sf.second * derivatives_factor);
+              }
+            }
+          }
+        });
+  } else if (par.smearing() == SmearingMode::Discrete) {
+    // get the volume of the cell and weights for discrete smearing
+    const double V_cell = (lat->cell_sizes())[0] * (lat->cell_sizes())[1] *
+                          (lat->cell_sizes())[2];
+    // weights for coarse smearing
+    const double big = par.central_weight();
+    const double small = (1.0 - big) / 6.0;
+    // unweighted contributions to the densities
+    std::array<double, N> common_weights;
+    for (std::size_t k = 0; k < N; k++) {
+      common_weights[k] =
+          dens_factors[k] / (par.ntest() * par.nensembles() * V_cell);
+    }
+    const FourVector four_velocity(1.0, part.velocity());
+    lat->iterate_nearest_neighbors(
+        pos, layers, [&](T &node, int iterated_index, int center_index) {
+          for (std::size_t k = 0; k < N; k++) {
+            if (!smeared[k]) {
+              continue;
+            }
+            // the contribution to density is weighted depending on what node
+            // it is added to
+            const double weight =
+                common_weights[k] *
+                (iterated_index == center_index ? big : small);
+            deposit(node_of(k, node), four_velocity, weight);
+          }
+        });
+  } else if (par.smearing() == SmearingMode::Triangular) {
+    // get the radii for triangular smearing
+    const std::array<double, 3> triangular_radius = {
+        par.triangular_range() * (lat->cell_sizes())[0],
+        par.triangular_range() * (lat->cell_sizes())[1],
+        par.triangular_range() * (lat->cell_sizes())[2]};
+    const double prefactor_triangular =
+        1.0 /
+        (par.ntest() * par.nensembles() * triangular_radius[0] *
+         triangular_radius[0] * triangular_radius[1] * triangular_radius[1] *
+         triangular_radius[2] * triangular_radius[2]);
+    // unweighted contributions to the densities
+    std::array<double, N> common_weights;
+    for (std::size_t k = 0; k < N; k++) {
+      common_weights[k] = dens_factors[k] * prefactor_triangular;
+    }
+    const FourVector four_velocity(1.0, part.velocity());
+    const std::array<double, 3> &origin = lat->origin();
+    const std::array<double, 3> &cell_sizes = lat->cell_sizes();
+    // smearing weight along one axis, for the cell with the given index
+    auto axis_weight = [&](int axis, int index) {
+      const double center = origin[axis] + cell_sizes[axis] * (index + 0.5);
+      return triangular_radius[axis] - std::abs(center - pos[axis]);
+    };
+    /* The weights along y and z only change from one row of nodes to the next,
+     * hence they are only recomputed when the row changes. */
+    int current_iy = std::numeric_limits<int>::min();
+    int current_iz = std::numeric_limits<int>::min();
+    double weight_y = 0.0, weight_z = 0.0;
+    lat->iterate_in_rectangle(
+        pos, triangular_radius, layers, [&](T &node, int ix, int iy, int iz) {
+          if (iz != current_iz) {
+            current_iz = iz;
+            weight_z = axis_weight(2, iz);
+          }
+          if (iy != current_iy) {
+            current_iy = iy;
+            weight_y = axis_weight(1, iy);
+          }
+          const double weight_x = axis_weight(0, ix);
+          // add the contributions to the nodes
+          for (std::size_t k = 0; k < N; k++) {
+            if (!smeared[k]) {
+              continue;
+            }
+            const double weight =
+                common_weights[k] * weight_x * weight_y * weight_z;
+            deposit(node_of(k, node), four_velocity, weight);
+          }
+        });
+  }
+}
+
+/**
+ * Adds the contribution of a single particle to the lattice.
+ *
+ * \param[inout] lat The lattice on which the content will be updated
+ * \param[in] part The particle to be smeared onto the lattice
+ * \param[in] dens_type density type to be computed on the lattice
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \tparam T LatticeType
+ */
+template <typename T>
+void add_particle_to_lattice(RectangularLattice<T> *lat,
+                             const ParticleData &part,
+                             const DensityType dens_type,
+                             const DensityParameters &par,
+                             const bool compute_gradient) {
+  add_particle_to_lattices<T, 1>({lat}, part, {dens_type}, par,
+                                 compute_gradient);
+}
+
 /**
  * Updates the contents on the lattice.
  *
@@ -539,97 +984,177 @@ void update_lattice_with_list_of_particles(RectangularLattice<T> *lat,
     lat->reset();
   }
   for (const ParticleData &part : plist) {
-    if (par.only_participants()) {
-      // if this conditions holds, the hadron is a spectator
-      if (part.get_history().collisions_per_particle == 0) {
-        continue;
+    add_particle_to_lattice(lat, part, dens_type, par, compute_gradient);
+  }
+}
+
+/**
+ * Record the inputs of a lattice update to the workload of the run.
+ *
+ * \param[out] recorder The recorder of the workload.
+ * \param[in] lat The updated lattice.
+ * \param[in] dens_type The density type computed on the lattice.
+ * \param[in] par The smearing parameters.
+ * \param[in] ensembles The particles of each ensemble.
+ * \param[in] compute_gradient Whether the gradients are computed.
+ * \tparam T LatticeType
+ */
+template <typename T>
+void record_smearing(WorkloadRecorder &recorder,
+                     const RectangularLattice<T> &lat,
+                     const DensityType dens_type, const DensityParameters &par,
+                     const std::vector<Particles> &ensembles,
+                     const bool compute_gradient) {
+  WorkloadRecorder::Smearing smearing{lat.lattice_sizes(),
+                                      lat.n_cells(),
+                                      lat.origin(),
+                                      lat.periodic(),
+                                      dens_type,
+                                      compute_gradient,
+                                      par.sigma(),
+                                      par.r_cut() / par.sigma(),
+                                      par.ntest(),
+                                      par.derivatives(),
+                                      par.rho_derivatives(),
+                                      par.smearing(),
+                                      par.central_weight(),
+                                      par.triangular_range(),
+                                      par.only_participants(),
+                                      {}};
+  for (const Particles &particles : ensembles) {
+    std::vector<WorkloadRecorder::Particle> &ensemble =
+        smearing.ensembles.emplace_back();
+    ensemble.reserve(particles.size());
+    for (const ParticleData &part : particles) {
+      ensemble.push_back(WorkloadRecorder::Particle::of(part));
+    }
+  }
+  recorder.record(smearing);
+}
+
+/**
+ * Updates the contents of several lattices of the same geometry when ensembles
+ * are used, smearing every particle onto all of them at once, see
+ * add_particle_to_lattices().
+ *
+ * If a pool of threads is given, the lattices are split along z into layers
+ * of tiles, see RectangularLattice::tile_size, and every layer is filled by
+ * one task. Each task smears all particles close enough to its layer, but only
+ * onto the nodes of the layer. Hence, no node is written by two threads and
+ * every node gets the contributions of the particles in the same order as in
+ * the serial update. The result is therefore the same for any number of
+ * threads, without copies of the lattices.
+ *
+ * If a record of the smeared particles is given, the lattices are only
+ * updated by the particles which changed since the last update if possible,
+ * see SmearedParticles. This is done serially, since it touches few nodes,
+ * and requires that the lattices were only changed by the previous update.
+ *
+ * If the workload of the run is recorded, the particles are passed to the
+ * WorkloadRecorder, if the update is sampled.
+ *
+ * \param[inout] lats The lattices on which the content will be updated. They
+ *               must not be null, have to be identical in structure and
+ *               updated at the same times.
+ * \param[in] update tells if called for update at printout or at timestep
+ * \param[in] dens_types density types to be computed on the lattices
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] ensembles the particles vector for each ensemble
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] thread_pool Threads used to smear the particles concurrently,
+ *            if not null.
+ * \param[inout] smeared The particles smeared onto the lattices at their last
+ *               update, which are updated incrementally if not null.
+ * \tparam T LatticeType
+ * \tparam N Number of lattices
+ */
+template <typename T, std::size_t N>
+void update_lattices_accumulating_ensembles(
+    const std::array<RectangularLattice<T> *, N> &lats,
+    const LatticeUpdate update, const std::array<DensityType, N> &dens_types,
+    const DensityParameters &par, const std::vector<Particles> &ensembles,
+    const bool compute_gradient, ThreadPool *thread_pool = nullptr,
+    SmearedParticles *smeared = nullptr) {
+  // Do not proceed if update not required
+  if (lats[0]->when_update() != update) {
+    return;
+  }
+  WorkloadRecorder *recorder = WorkloadRecorder::active();
+  if (recorder != nullptr && recorder->sample(WorkloadRecorder::Smearings)) {
+    record_smearing(*recorder, *lats[0], dens_types[0], par, ensembles,
+                    compute_gradient);
+  }
+  if (smeared != nullptr && smeared->find_changes(ensembles)) {
+    for (const ParticleData *part : smeared->removed()) {
+      add_particle_to_lattices(lats, *part, dens_types, par, compute_gradient,
+                               {}, true);
+    }
+    for (const ParticleData *part : smeared->added()) {
+      add_particle_to_lattices(lats, *part, dens_types, par, compute_gradient);
+    }
+    smeared->remember_changes();
+    return;
+  }
+  if (smeared != nullptr) {
+    smeared->remember(ensembles);
+  }
+  for (RectangularLattice<T> *lat : lats) {
+    assert(lat->identical_to_lattice(lats[0]));
+    assert(lat->when_update() == update);
+    lat->reset();
+  }
+  if (thread_pool == nullptr || thread_pool->size() < 2) {
+    // The particles are smeared in place, without copying the ensembles
+    for (const Particles &particles : ensembles) {
+      for (const ParticleData &part : particles) {
+        add_particle_to_lattices(lats, part, dens_types, par, compute_gradient);
       }
     }
-    const double dens_factor = density_factor(part.type(), dens_type);
-    if (std::abs(dens_factor) < really_small) {
-      continue;
+    return;
+  }
+  std::vector<const ParticleData *> all_particles;
+  for (const Particles &particles : ensembles) {
+    for (const ParticleData &part : particles) {
+      all_particles.push_back(&part);
     }
-    const FourVector p_mu = part.momentum();
-    const ThreeVector pos = part.position().threevec();
-
-    // act accordingly to which smearing is used
-    if (par.smearing() == SmearingMode::CovariantGaussian) {
-      // get the normalization factor for the covariant Gaussian smearing
-      const double norm_factor_gaus = par.norm_factor_sf();
-      const double m = p_mu.abs();
-      if (unlikely(m < really_small)) {
-        logg[LDensity].warn("Gaussian smearing is undefined for momentum ",
-                            p_mu);
+  }
+  const RectangularLattice<T> &lat = *lats[0];
+  const int n_layers = lat.n_cells()[2];
+  const int tile_size = RectangularLattice<T>::tile_size;
+  const double dz = lat.cell_sizes()[2];
+  /* Largest distance along z of a particle to the center of a node it is
+   * smeared onto, plus one cell to be safe against rounding. Particles further
+   * away from a layer of a non-periodic lattice are skipped by its task. */
+  double reach = dz;
+  if (par.smearing() == SmearingMode::CovariantGaussian) {
+    reach += par.r_cut();
+  } else if (par.smearing() == SmearingMode::Triangular) {
+    reach += par.triangular_range() * dz;
+  } else {
+    reach += dz;
+  }
+  const std::size_t n_tasks = (n_layers + tile_size - 1) / tile_size;
+  thread_pool->parallel_for(n_tasks, [&](std::size_t task) {
+    const LatticeLayers layers{static_cast<int>(task) * tile_size,
+                               std::min(n_layers, (static_cast<int>(task) + 1) *
+                                                      tile_size)};
+    const double z_min = lat.origin()[2] + dz * (layers.begin + 0.5) - reach;
+    const double z_max = lat.origin()[2] + dz * (layers.end - 0.5) + reach;
+    for (const ParticleData *part : all_particles) {
+      const double z = part->position().x3();
+      if (!lat.periodic() && (z < z_min || z > z_max)) {
         continue;
       }
-      const double m_inv = 1.0 / m;
-
-      // unweighted contribution to density
-      const double common_weight = dens_factor * norm_factor_gaus;
-      lat->iterate_in_cube(
-          pos, par.r_cut(), [&](T &node, int ix, int iy, int iz) {
-            // find the weight for smearing
-            const ThreeVector r = lat->cell_center(ix, iy, iz);
-            const auto sf = unnormalized_smearing_factor(pos - r, p_mu, m_inv,
-                                                         par, compute_gradient);
-            node.add_particle(part, sf.first * common_weight);
-            if (par.derivatives() == DerivativesMode::CovariantGaussian) {
-              node.add_particle_for_derivatives(part, dens_factor,
-                                                sf.second * norm_factor_gaus);
-            }
-          });
-    } else if (par.smearing() == SmearingMode::Discrete) {
-      // get the volume of the cell and weights for discrete smearing
-      const double V_cell = (lat->cell_sizes())[0] * (lat->cell_sizes())[1] *
-                            (lat->cell_sizes())[2];
-      // weights for coarse smearing
-      const double big = par.central_weight();
-      const double small = (1.0 - big) / 6.0;
-      // unweighted contribution to density
-      const double common_weight =
-          dens_factor / (par.ntest() * par.nensembles() * V_cell);
-      lat->iterate_nearest_neighbors(
-          pos, [&](T &node, int iterated_index, int center_index) {
-            node.add_particle(
-                part, common_weight *
-                          // the contribution to density is weighted depending
-                          // on what node it is added to
-                          (iterated_index == center_index ? big : small));
-          });
-    } else if (par.smearing() == SmearingMode::Triangular) {
-      // get the radii for triangular smearing
-      const std::array<double, 3> triangular_radius = {
-          par.triangular_range() * (lat->cell_sizes())[0],
-          par.triangular_range() * (lat->cell_sizes())[1],
-          par.triangular_range() * (lat->cell_sizes())[2]};
-      const double prefactor_triangular =
-          1.0 /
-          (par.ntest() * par.nensembles() * triangular_radius[0] *
-           triangular_radius[0] * triangular_radius[1] * triangular_radius[1] *
-           triangular_radius[2] * triangular_radius[2]);
-      // unweighted contribution to density
-      const double common_weight = dens_factor * prefactor_triangular;
-      lat->iterate_in_rectangle(
-          pos, triangular_radius, [&](T &node, int ix, int iy, int iz) {
-            // compute the position of the node
-            const ThreeVector cell_center = lat->cell_center(ix, iy, iz);
-            // compute smearing weight
-            const double weight_x =
-                triangular_radius[0] - std::abs(cell_center[0] - pos[0]);
-            const double weight_y =
-                triangular_radius[1] - std::abs(cell_center[1] - pos[1]);
-            const double weight_z =
-                triangular_radius[2] - std::abs(cell_center[2] - pos[2]);
-            // add the contribution to the node
-            node.add_particle(part,
-                              common_weight * weight_x * weight_y * weight_z);
-          });
+      add_particle_to_lattices(lats, *part, dens_types, par, compute_gradient,
+                               layers);
     }
-  }
+  });
 }
 
 /**
- * Updates the contents on the lattice when ensembles are used.
+ * Updates the contents on the lattice when ensembles are used, see
+ * update_lattices_accumulating_ensembles().
  *
  * \param[out] lat The lattice on which the content will be updated
  * \param[in] update tells if called for update at printout or at timestep
@@ -638,23 +1163,25 @@ void update_lattice_with_list_of_particles(RectangularLattice<T> *lat,
  *            smearing parameters.
  * \param[in] ensembles the particles vector for each ensemble
  * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] thread_pool Threads used to smear the particles concurrently,
+ *            if not null.
+ * \param[inout] smeared The particles smeared onto the lattice at its last
+ *               update, which is updated incrementally if not null.
  * \tparam T LatticeType
  */
 template <typename T>
 void update_lattice_accumulating_ensembles(
     RectangularLattice<T> *lat, const LatticeUpdate update,
     const DensityType dens_type, const DensityParameters &par,
-    const std::vector<Particles> &ensembles, const bool compute_gradient) {
-  // Do not proceed if lattice does not exists/update not required
-  if (lat == nullptr || lat->when_update() != update) {
+    const std::vector<Particles> &ensembles, const bool compute_gradient,
+    ThreadPool *thread_pool = nullptr, SmearedParticles *smeared = nullptr) {
+  // Do not proceed if lattice does not exists
+  if (lat == nullptr) {
     return;
   }
-  lat->reset();
-  for (const Particles &particles : ensembles) {
-    update_lattice_with_list_of_particles(lat, update, dens_type, par,
-                                          particles.copy_to_vector(),
-                                          compute_gradient, false);
-  }
+  update_lattices_accumulating_ensembles<T, 1>(
+      {lat}, update, {dens_type}, par, ensembles, compute_gradient,
+      thread_pool, smeared);
 }
 
 /**
@@ -675,6 +1202,10 @@ void update_lattice_accumulating_ensembles(
  * \param[in] ensembles The particles vector for each ensemble
  * \param[in] time_step Time step used in the simulation
  * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] thread_pool Threads used to smear the particles concurrently,
+ *            if not null, see update_lattice_accumulating_ensembles().
+ * \param[inout] smeared The particles smeared onto the lattice at its last
+ *               update, which is updated incrementally if not null.
  */
 void update_lattice(
     RectangularLattice<DensityOnLattice> *lat,
@@ -683,7 +1214,51 @@ void update_lattice(
     RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
     const LatticeUpdate update, const DensityType dens_type,
     const DensityParameters &par, const std::vector<Particles> &ensembles,
-    const double time_step, const bool compute_gradient);
+    const double time_step, const bool compute_gradient,
+    ThreadPool *thread_pool = nullptr, SmearedParticles *smeared = nullptr);
+
+/**
+ * Updates the contents of two lattices of DensityOnLattice type in one pass
+ * over the particles, like two calls of update_lattice() would.
+ *
+ * The particles are smeared onto both lattices at once, see
+ * add_particle_to_lattices(). With finite difference derivatives, the
+ * auxiliary lattices can only hold the currents of one lattice, hence the
+ * lattices are updated one after the other then. The same happens if one of
+ * the lattices does not exist or is not identical in structure to the other.
+ *
+ * \param[out] lats The lattices of DensityOnLattice type on which the content
+ *             will be updated
+ * \param[in] old_jmu Auxiliary lattice, filled with current values at t0,
+ *            needed for calculating time derivatives
+ * \param[in] new_jmu Auxiliary lattice,filled with current values at t0 + dt,
+ *            needed for calculating time derivatives
+ * \param[in] four_grad_lattice Auxiliary lattice for calculating the
+ *            fourgradient of the current
+ * \param[in] update Tells if called for update at printout or at timestep
+ * \param[in] dens_types Density types to be computed on the lattices
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] ensembles The particles vector for each ensemble
+ * \param[in] time_step Time step used in the simulation
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] thread_pool Threads used to smear the particles concurrently,
+ *            if not null, see update_lattices_accumulating_ensembles().
+ * \param[inout] smeared The particles smeared onto the lattices at their last
+ *               update, one record for each lattice, which are updated
+ *               incrementally if not null. If both lattices are updated at
+ *               once, only the record of the first one is used.
+ */
+void update_lattices(
+    const std::array<RectangularLattice<DensityOnLattice> *, 2> &lats,
+    RectangularLattice<FourVector> *old_jmu,
+    RectangularLattice<FourVector> *new_jmu,
+    RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
+    const LatticeUpdate update, const std::array<DensityType, 2> &dens_types,
+    const DensityParameters &par, const std::vector<Particles> &ensembles,
+    const double time_step, const bool compute_gradient,
+    ThreadPool *thread_pool = nullptr,
+    const std::array<SmearedParticles *, 2> &smeared = {});
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_DENSITY_H_
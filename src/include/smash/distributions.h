@@ -7,6 +7,12 @@
 #ifndef SRC_INCLUDE_SMASH_DISTRIBUTIONS_H_
 #define SRC_INCLUDE_SMASH_DISTRIBUTIONS_H_
 
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace smash {
 
 /**
@@ -170,6 +176,95 @@ double sample_momenta_from_thermal(const double temperature, const double mass);
  * \return Radial momentum
  */
 double sample_momenta_IC_ES(const double temperature);
+
+/**
+ * \brief Sampler of radial momenta from tabulated thermal distributions
+ *
+ * The distribution of a pair of mass and temperature is integrated once on a
+ * fine grid of momenta and inverted at equally probable quantiles, between
+ * which the momentum is interpolated linearly. A draw then takes one random
+ * number and no loop, like QuantumSampling. The distribution is approximated
+ * on the scale of the distance of the quantiles and cut at a kinetic energy of
+ * 40 times the temperature.
+ *
+ * The tables of the most recently used pairs are kept, such that this pays off
+ * if many momenta are drawn for few pairs, e.g. for species with their pole
+ * masses at a common temperature. The sampler may be used from several
+ * threads at once.
+ */
+class ThermalMomentumSampler {
+ public:
+  /// The tabulated momentum distributions
+  enum class Distribution {
+    /// \f$p^2 e^{-E/T}\f$, see sample_momenta_from_thermal()
+    Thermal,
+    /// \f$p^3 e^{-E/T}\f$, see sample_momenta_non_eq_mass()
+    NonEquilibriumMass,
+  };
+
+  /**
+   * Create a sampler without any tables.
+   *
+   * \param[in] distribution The sampled distribution.
+   * \param[in] capacity Number of kept tables.
+   */
+  explicit ThermalMomentumSampler(Distribution distribution,
+                                  std::size_t capacity = 16)
+      : distribution_(distribution), capacity_(capacity) {}
+
+  /**
+   * \param[in] temperature Temperature \f$T\f$ [GeV]
+   * \param[in] mass Mass of the particle [GeV]
+   * \return A sampled radial momentum [GeV].
+   */
+  double sample(double temperature, double mass);
+
+  /**
+   * Sample many momenta at once, looking up the table only once.
+   *
+   * \param[in] temperature Temperature \f$T\f$ [GeV]
+   * \param[in] mass Mass of the particles [GeV]
+   * \param[out] momenta The sampled radial momenta [GeV], whose number is
+   *             the size of the given vector.
+   */
+  void sample(double temperature, double mass, std::vector<double> &momenta);
+
+ private:
+  /// Number of momentum intervals on which the distributions are integrated
+  static constexpr std::size_t n_momentum_intervals_ = 20000;
+  /// Number of equally probable intervals between the tabulated quantiles
+  static constexpr std::size_t n_quantiles_ = 2000;
+  /// The tabulated distribution of a pair of temperature and mass
+  struct Table {
+    /// Temperature [GeV]
+    double temperature;
+    /// Mass [GeV]
+    double mass;
+    /// The momenta [GeV] below which the fractions k / n_quantiles_ lie
+    std::vector<double> quantiles;
+  };
+  /**
+   * \return The table of the pair, which is created if needed.
+   *
+   * \param[in] temperature Temperature \f$T\f$ [GeV]
+   * \param[in] mass Mass of the particle [GeV]
+   */
+  std::shared_ptr<const Table> table(double temperature, double mass);
+  /**
+   * \param[in] t The table.
+   * \return A momentum interpolated between the quantiles [GeV].
+   */
+  static double sample(const Table &t);
+  /// The sampled distribution
+  const Distribution distribution_;
+  /// Number of kept tables
+  const std::size_t capacity_;
+  /// The kept tables, the most recently used first
+  std::list<std::shared_ptr<const Table>> tables_;
+  /// Guards tables_
+  std::mutex mutex_;
+};
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_DISTRIBUTIONS_H_
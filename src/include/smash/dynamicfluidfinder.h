@@ -12,6 +12,7 @@
 
 #include <limits>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "actionfinderfactory.h"
@@ -67,12 +68,12 @@ class DynamicFluidizationFinder : public ActionFinderInterface {
    * formation time.
    */
   ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, double gcell_vol,
+      ParticleSpan search_list, double dt, double gcell_vol,
       const std::vector<FourVector> &beam_momentum) const override;
 
   /// Ignore the neighbor search for fluidization
   ActionList find_actions_with_neighbors(
-      const ParticleList &, const ParticleList &, const double,
+      ParticleSpan, ParticleSpan, const double,
       const std::vector<FourVector> &) const override {
     return {};
   }
@@ -83,6 +84,12 @@ class DynamicFluidizationFinder : public ActionFinderInterface {
       const std::vector<FourVector> &) const override {
     return {};
   }
+  /// Ignore the surrounding searches for fluidization
+  ActionList find_actions_with_surrounding_particles(
+      const ParticleList &, const std::vector<const ParticleData *> &, double,
+      const std::vector<FourVector> &) const override {
+    return {};
+  }
 
   /**
    * Prepare corona particles left in the IC for the afterburner.
@@ -102,6 +109,9 @@ class DynamicFluidizationFinder : public ActionFinderInterface {
    */
   ActionList find_final_actions(const Particles &search_list) const override;
 
+  /// \return The name of the finder in the time profile
+  std::string name() const override { return "fluidization finder"; }
+
   /**
    * Determine if fluidization condition is satisfied.
    *
@@ -120,6 +130,29 @@ class DynamicFluidizationFinder : public ActionFinderInterface {
   bool is_process_fluidizable(const HistoryData &history) const;
 
  private:
+  /**
+   * Rest frame energy densities of the lattice cells looked up so far, such
+   * that the Landau frame of each cell is found only once per search.
+   */
+  using LandauEnergyDensities =
+      std::unordered_map<const EnergyMomentumTensor *, double>;
+
+  /**
+   * Determine if fluidization condition is satisfied, reusing the rest frame
+   * energy densities of cells already looked up.
+   *
+   * The energy density in the lab frame \f$T^{00}\f$ is never smaller than
+   * the one in the Landau frame, so cells where even \f$T^{00}\f$ is below
+   * the threshold are rejected without finding their Landau frame.
+   *
+   * \param[in] pdata Particle to be checked for fluidization.
+   * \param[in,out] energy_densities Rest frame energy densities of the cells
+   *                 looked up so far.
+   * \return Whether energy density around pdata is high enough.
+   */
+  bool above_threshold(const ParticleData &pdata,
+                       LandauEnergyDensities &energy_densities) const;
+
   /**
    * Lattice where energy momentum tensor is computed
    *
@@ -8,19 +8,33 @@
 #define SRC_INCLUDE_SMASH_EXPERIMENT_H_
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <future>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "actionfinderfactory.h"
 #include "actions.h"
+#include "adaptivetimestep.h"
+#include "asyncoutput.h"
 #include "bremsstrahlungaction.h"
+#include "bufferedoutput.h"
+#include "checkpoint.h"
 #include "chrono.h"
+#include "crosssections.h"
 #include "decayactionsfinder.h"
 #include "decayactionsfinderdilepton.h"
+#include "decaychanneltable.h"
 #include "dynamicfluidfinder.h"
 #include "energymomentumtensor.h"
 #include "fields.h"
@@ -28,6 +42,7 @@
 #include "fourvector.h"
 #include "grandcan_thermalizer.h"
 #include "grid.h"
+#include "hugepages.h"
 #include "hypersurfacecrossingfinder.h"
 #include "icparameters.h"
 #include "numeric_cast.h"
@@ -35,14 +50,20 @@
 #include "pauliblocking.h"
 #include "potential_globals.h"
 #include "potentials.h"
+#include "profiler.h"
 #include "propagation.h"
 #include "quantumnumbers.h"
+#include "random.h"
 #include "scatteractionphoton.h"
 #include "scatteractionsfinder.h"
 #include "stringprocess.h"
+#include "taskgraph.h"
 #include "thermalizationaction.h"
+#include "threadpool.h"
+#include "tracerecorder.h"
 // Output
 #include "binaryoutput.h"
+#include "filteredoutput.h"
 #ifdef SMASH_USE_HEPMC
 #include "hepmcoutput.h"
 #endif
@@ -51,14 +72,21 @@
 #endif
 #include "icoutput.h"
 #include "oscaroutput.h"
+#ifdef SMASH_USE_PARQUET
+#include "parquetoutput.h"
+#endif
 #include "thermodynamiclatticeoutput.h"
 #include "thermodynamicoutput.h"
 #ifdef SMASH_USE_ROOT
 #include "rootoutput.h"
 #endif
 #include "freeforallaction.h"
+#include "memoryoutput.h"
+#include "performanceoutput.h"
+#include "spectraoutput.h"
 #include "vtkoutput.h"
 #include "wallcrossingaction.h"
+#include "workloadrecorder.h"
 
 namespace std {
 /**
@@ -93,6 +121,98 @@ namespace smash {
 static constexpr int LMain = LogArea::Main::id;
 static constexpr int LInitialConditions = LogArea::InitialConditions::id;
 
+/**
+ * Counters of the actions performed during an event.
+ *
+ * The Experiment keeps one instance with the totals over all ensembles. If the
+ * ensembles are evolved concurrently, every ensemble has its own instance,
+ * which is added to the totals after each concurrent step.
+ */
+struct InteractionCounters {
+  /**
+   *  Total number of interactions for current timestep.
+   *  For timestepless mode the whole run time is considered as one timestep.
+   */
+  uint64_t interactions_total = 0;
+
+  /**
+   *  Total number of wall-crossings for current timestep.
+   *  For timestepless mode the whole run time is considered as one timestep.
+   */
+  uint64_t wall_actions_total = 0;
+
+  /**
+   *  Total number of Pauli-blockings for current timestep.
+   *  For timestepless mode the whole run time is considered as one timestep.
+   */
+  uint64_t total_pauli_blocked = 0;
+
+  /**
+   *  Total number of particles removed from the evolution in
+   *  hypersurface crossing actions.
+   */
+  uint64_t total_hypersurface_crossing_actions = 0;
+
+  /**
+   *  Total number of discarded interactions, because they were invalidated
+   *  before they could be performed.
+   */
+  uint64_t discarded_interactions_total = 0;
+
+  /**
+   *  Maximal number of entries of the action queue of one ensemble, including
+   *  the ones of invalidated actions which have not been dropped yet.
+   */
+  uint64_t max_queued_actions = 0;
+
+  /// Number of process types, which are used as indices of the counters
+  static constexpr std::size_t n_process_types =
+      static_cast<std::size_t>(ProcessType::Freeforall) + 1;
+
+  /// Number of performed actions of every process type, by its value
+  std::array<uint64_t, n_process_types> performed_by_type{};
+
+  /// Sum of the numbers of particles of the grids built for action finding
+  uint64_t grid_particles = 0;
+
+  /// Sum of the numbers of cells of the grids built for action finding
+  uint64_t grid_cells = 0;
+
+  /**
+   * Total energy removed from the system in hypersurface crossing actions.
+   */
+  double total_energy_removed = 0.0;
+
+  /**
+   * Total energy violation introduced by Pythia.
+   */
+  double total_energy_violated_by_Pythia = 0.0;
+
+  /**
+   * Add the counts of another instance to this one.
+   *
+   * \param[in] other The counters to be added.
+   * \return A reference to this instance.
+   */
+  InteractionCounters &operator+=(const InteractionCounters &other) {
+    interactions_total += other.interactions_total;
+    wall_actions_total += other.wall_actions_total;
+    total_pauli_blocked += other.total_pauli_blocked;
+    total_hypersurface_crossing_actions +=
+        other.total_hypersurface_crossing_actions;
+    discarded_interactions_total += other.discarded_interactions_total;
+    max_queued_actions = std::max(max_queued_actions, other.max_queued_actions);
+    for (std::size_t i = 0; i < n_process_types; i++) {
+      performed_by_type[i] += other.performed_by_type[i];
+    }
+    grid_particles += other.grid_particles;
+    grid_cells += other.grid_cells;
+    total_energy_removed += other.total_energy_removed;
+    total_energy_violated_by_Pythia += other.total_energy_violated_by_Pythia;
+    return *this;
+  }
+};
+
 /**
  * Non-template interface to Experiment<Modus>.
  *
@@ -140,6 +260,45 @@ class ExperimentBase {
    */
   virtual void run() = 0;
 
+  /// A range of event numbers, from the first to the one after the last
+  using EventRange = std::pair<int, int>;
+
+  /**
+   * Runs the events of the ranges handed out by the given function, until it
+   * hands out an empty range, e.g. to distribute the events of a run over
+   * several processes. The seeds are chained from event to event as in run(),
+   * such that every event is the same as in a run of all events.
+   *
+   * \param[in] next_range Function handing out the next range of events. The
+   *            ranges have to follow each other in increasing order. Events
+   *            beyond \ref key_gen_nevents_ "Nevents" are not run.
+   * \throw std::invalid_argument if the number of events is not fixed, or if
+   *        the events are forked, simulated concurrently or continued from a
+   *        checkpoint.
+   */
+  virtual void run_event_ranges(
+      const std::function<EventRange()> &next_range) = 0;
+
+  /**
+   * \return The time profile of the finished events, which is empty unless
+   *         profiling is switched on.
+   */
+  virtual const Profiler &profiler() const = 0;
+
+  /// \return Number of actions in the finished events, without wall crossings.
+  virtual uint64_t actions_performed() const = 0;
+
+  /**
+   * Continue an interrupted run from a checkpoint, see \ref
+   * key_gen_checkpoint_interval_. The next call of run() resumes the event of
+   * the checkpoint at the time step at which it was written.
+   *
+   * \param[in] file The checkpoint written by a run with the same
+   *            configuration and build.
+   * \throw std::runtime_error if the checkpoint does not match the experiment.
+   */
+  virtual void restore_checkpoint(const std::filesystem::path &file) = 0;
+
   /**
    * \ingroup exception
    * Exception class that is thrown if an invalid modus is requested from the
@@ -201,6 +360,17 @@ class Experiment : public ExperimentBase {
    */
   void run() override;
 
+  /// \copydoc ExperimentBase::run_event_ranges
+  void run_event_ranges(const std::function<EventRange()> &next_range) override;
+
+  /// \copydoc ExperimentBase::profiler
+  const Profiler &profiler() const override { return profiler_; }
+
+  /// \copydoc ExperimentBase::actions_performed
+  uint64_t actions_performed() const override { return actions_performed_; }
+
+  void restore_checkpoint(const std::filesystem::path &file) override;
+
   /**
    * Create a new Experiment.
    *
@@ -215,7 +385,9 @@ class Experiment : public ExperimentBase {
    * \param[in] output_path The directory where the output files are written.
    */
   explicit Experiment(Configuration &config,
-                      const std::filesystem::path &output_path);
+                      const std::filesystem::path &output_path)
+      : Experiment(config, output_path, nullptr,
+                   configuration_for_event_workers(config)) {}
 
   /**
    * This is called in the beginning of each event. It initializes particles
@@ -224,6 +396,22 @@ class Experiment : public ExperimentBase {
    */
   void initialize_new_event();
 
+  /**
+   * Start a new event with the given particles instead of sampling them
+   * according to the selected modus. Everything set up in the constructor,
+   * i.e. outputs, action finders, cross section tables and PYTHIA objects, is
+   * kept, such that a library user can evolve many events or successive
+   * stages of a hybrid model with one Experiment.
+   *
+   * The particles are adjusted as in run_time_evolution and the ones not at
+   * the same time are propagated back along straight lines to the earliest
+   * one, which is the start time of the event.
+   *
+   * \param[in] initial_particles The particles the event starts with.
+   * \throw std::runtime_error if more than one ensemble is used.
+   */
+  void initialize_new_event(ParticleList &&initial_particles);
+
   /**
    * Runs the time evolution of an event with fixed-size time steps or without
    * timesteps, from action to actions.
@@ -235,7 +423,9 @@ class Experiment : public ExperimentBase {
    * \param[in] add_plist A by-default empty particle list which is added to the
    *                      current particle content of the system
    * \param[in] remove_plist A by-default empty particle list which is removed
-   *                         from the current particle content of the system
+   *                         from the current particle content of the system.
+   *                         Particles keeping the id given to them by SMASH
+   *                         are found in constant time.
    *
    * \note
    * This function is meant to take over ownership of the to-be-added/removed
@@ -254,6 +444,61 @@ class Experiment : public ExperimentBase {
   /// Output at the end of an event
   void final_output();
 
+  /// \return The statistics about the work done in the current event so far.
+  EventStatistics event_statistics() const;
+
+  /**
+   * Measure the memory used by the subsystems and check it against the soft
+   * limit, see \ref key_gen_memory_limit_. If the limit is exceeded, the
+   * grids are dropped right away, the particles are compacted at the start of
+   * the next time step and the action queues are compacted early, until the
+   * memory is below the limit again. None of this changes the physics.
+   *
+   * \param[in] actions The action queues of the ensembles.
+   */
+  void measure_memory(const std::vector<Actions> &actions);
+
+  /**
+   * Add an output to the outputs created from the configuration, e.g. a
+   * MemoryOutput passing the particles to the caller. This is helpful if SMASH
+   * is used as a 3rd-party library. The output receives the same calls as the
+   * configured outputs, starting with the next event.
+   *
+   * \param[in] output The output to be added.
+   * \throw std::invalid_argument if \p output is null.
+   */
+  void add_output(std::unique_ptr<OutputInterface> output);
+
+  /**
+   * Sort the outputs by the hooks they subscribed to, see
+   * OutputInterface::subscribed_hooks, such that the hooks are called only for
+   * the subscribed outputs. This has to be repeated whenever outputs are
+   * added.
+   */
+  void subscribe_outputs();
+
+  /**
+   * Run the time evolution like run_time_evolution above, but take the
+   * particles to be added and removed as records, e.g. as passed on by a
+   * hydrodynamic code. Particles with an unknown PDG code are ignored.
+   *
+   * \param[in] t_end Time until run_time_evolution is run.
+   * \param[in] add_records The particles to be added.
+   * \param[in] remove_records The particles to be removed.
+   */
+  void run_time_evolution(const double t_end,
+                          const std::vector<ParticleRecord> &add_records,
+                          const std::vector<ParticleRecord> &remove_records);
+
+  /**
+   * Copy the particles of the first ensemble into the given records, reusing
+   * their storage, instead of copying the particles themselves. This is
+   * helpful if SMASH is used as a 3rd-party library.
+   *
+   * \param[out] records The records of the particles.
+   */
+  void fill_particle_records(std::vector<ParticleRecord> &records) const;
+
   /**
    * Provides external access to SMASH particles. This is helpful if SMASH
    * is used as a 3rd-party library.
@@ -275,6 +520,172 @@ class Experiment : public ExperimentBase {
   void increase_event_number();
 
  private:
+  /**
+   * Create a new Experiment, possibly as a worker of another one.
+   *
+   * \param[inout] config The Configuration object, see the public constructor.
+   * \param[in] output_path The directory where the output files are written.
+   * \param[in] primary If not null, the experiment is a worker simulating
+   *            some of the events of \p primary. It then passes all output to
+   *            buffers attached to the outputs of \p primary instead of
+   *            creating its own output files, apart from the shards of
+   *            \ref key_output_sharded_writing_ "Sharded_Writing".
+   * \param[in] worker_configuration The configuration from which the event
+   *            workers of this experiment are created, see
+   *            configuration_for_event_workers().
+   */
+  Experiment(Configuration &config, const std::filesystem::path &output_path,
+             const Experiment *primary,
+             const std::string &worker_configuration);
+
+  /**
+   * \param[in] config The configuration of the experiment, before any value
+   *            was taken from it.
+   * \return The configuration as YAML text if events are simulated
+   *         concurrently and an empty string otherwise.
+   */
+  static std::string configuration_for_event_workers(
+      const Configuration &config) {
+    return config.read(InputKeys::gen_eventThreads) > 1 ? config.to_string()
+                                                        : std::string{};
+  }
+
+  /**
+   * Simulate the event with the current event number and seed, from the
+   * initialization to the output at event end.
+   */
+  void run_event();
+
+  /**
+   * The random numbers drawn while an event was prepared ahead, see
+   * prepare_next_event().
+   */
+  struct PreparedEvent {
+    /// Seed of the prepared event
+    int64_t seed;
+    /// Seed of the event following the prepared one
+    int64_t next_seed;
+    /// Seed of the PYTHIA hadronization, if string fragmentation is on
+    int pythia_seed;
+    /// Start time of the prepared event
+    double start_time;
+    /// Random number engine after the initial conditions were sampled
+    random::Engine engine;
+  };
+
+  /**
+   * Initialize a new event with the particles placed in the ensembles by the
+   * given function, which is called after the ensembles have been emptied and
+   * the seeds set.
+   *
+   * \param[in] fill_ensembles Function filling the ensembles, which returns
+   *            the start time of the event.
+   * \param[in] prepared The random numbers drawn while preparing the event,
+   *            if it was prepared ahead.
+   */
+  void initialize_event_with(const std::function<double()> &fill_ensembles,
+                             const PreparedEvent *prepared = nullptr);
+
+  /**
+   * Sample the initial particles of the event with the seed of the next event
+   * on a separate thread, see \ref key_gen_prepare_next_event_. The event is
+   * taken over by the next call of initialize_new_event().
+   */
+  void prepare_next_event();
+
+  /**
+   * Pass the ensembles to the outputs at the start of an event.
+   *
+   * \param[in] E_mean_field Mean-field energy of the system at the start.
+   */
+  void output_event_start(double E_mean_field);
+
+  /**
+   * \return Why the events cannot be forked, or an empty string if they can.
+   */
+  std::string reason_against_forks() const;
+
+  /**
+   * Write the state of the running event which is needed to continue it,
+   * i.e. the clocks, the particles and the counters, but not the random
+   * number engines.
+   *
+   * \param[out] state Where the state is written to.
+   * \param[in] timesteps Number of time steps done so far in the current call
+   *            of run_time_evolution.
+   */
+  void save_event_state(CheckpointWriter &state, int timesteps) const;
+
+  /**
+   * Read the state of the running event written by save_event_state.
+   *
+   * \param[in] state Where the state is read from.
+   * \return The number of time steps done when the state was written.
+   */
+  int restore_event_state(CheckpointReader &state);
+
+  /**
+   * Continue the next fork of the event from its snapshot with new random
+   * number streams, see \ref key_gen_forks_per_event_.
+   */
+  void start_fork();
+
+  /**
+   * \return Why the state of the experiment cannot be written to a
+   * checkpoint, or an empty string if it can.
+   */
+  std::string reason_against_checkpoints() const;
+
+  /**
+   * Write the state of the running event to the checkpoint file. It is called
+   * at the beginning of a time step.
+   *
+   * \param[in] timesteps Number of time steps done so far in the current call
+   *            of run_time_evolution.
+   */
+  void write_checkpoint(int timesteps);
+
+  /**
+   * Simulate all events concurrently with the event workers.
+   *
+   * The events are handed out in batches with one event per experiment, this
+   * one included. Event numbers and seeds are assigned in the same order as in
+   * a serial run. After each batch, the buffered output of the workers is
+   * passed to the outputs in the order of the events. Sharded outputs are
+   * written by every experiment itself.
+   */
+  void run_events_concurrently();
+
+  /**
+   * Simulate all events concurrently with the event workers, every experiment
+   * taking the next event as soon as it has finished the previous one.
+   *
+   * The events are handed out in windows, within which the ones expected to
+   * take longest come first, see events_by_expected_duration(). The outputs
+   * of all experiments, this one included, are buffered and the calls of
+   * every finished event are passed to the outputs as soon as all events
+   * before it have been written. Sharded outputs are written by every
+   * experiment itself.
+   */
+  void run_events_longest_first();
+
+  /**
+   * Order the events such that the ones expected to take longest come first
+   * within windows of the given number of events. In the collider modus, the
+   * impact parameter of every event is drawn as in the event itself, from the
+   * random numbers following the given seed, and central events are expected
+   * to take longest. Otherwise, the order of the event numbers is kept.
+   *
+   * \param[in] seeds The seeds of all events.
+   * \param[in] window Number of events, which are ordered among each other.
+   * \return The event numbers in the order in which they are handed out.
+   */
+  std::vector<int> events_by_expected_duration(
+      const std::vector<int64_t> &seeds, int window);
+
+  /// Collect the statistics of the event workers and report on the run.
+  void finish_run();
+
   /**
    * Perform the given action.
    *
@@ -283,12 +694,15 @@ class Experiment : public ExperimentBase {
    * \param[in] include_pauli_blocking wheter to take Pauli blocking into
    *                                   account. Skipping Pauli blocking is
    *                                   useful for example for final decays.
+   * \param[in] final_state_generated Whether the final state of the action
+   *            was already generated, see perform_final_actions_concurrently().
    * \return False if the action is
    *                 rejected either due to invalidity or
    *                 Pauli-blocking, or true if it's accepted and performed.
    */
   bool perform_action(Action &action, int i_ensemble,
-                      bool include_pauli_blocking = true);
+                      bool include_pauli_blocking = true,
+                      bool final_state_generated = false);
   /**
    * Create a list of output files
    *
@@ -296,19 +710,33 @@ class Experiment : public ExperimentBase {
    * \param[in] content Content of the output (e.g. particles, collisions)
    * \param[in] output_path Path of the output file
    * \param[in] par Output options.(e.g. Extended)
+   * \param[in] shard Number of the shard of a binary output, which an event
+   *            thread writes itself, or -1.
    */
   void create_output(const std::string &format, const std::string &content,
                      const std::filesystem::path &output_path,
-                     const OutputParameters &par);
+                     const OutputParameters &par, int shard = -1);
 
   /**
    * Propagate all particles until time to_time without any interactions
    * and shine dileptons.
    *
    * \param[in] to_time Time at the end of propagation [fm]
-   * \param[in, out] particles Particles to be propagated
+   * \param[in] i_ensemble index of ensemble whose particles are propagated
+   */
+  void propagate_and_shine(double to_time, int i_ensemble);
+
+  /**
+   * Propagate a single particle until time to_time without any interactions
+   * and let it shine dileptons for the time it propagated. Nothing is done if
+   * it is not before to_time.
+   *
+   * \param[in] p A valid copy of the particle
+   * \param[in] to_time Time at the end of propagation [fm]
+   * \param[in] i_ensemble index of the ensemble of the particle
    */
-  void propagate_and_shine(double to_time, Particles &particles);
+  void propagate_and_shine(const ParticleData &p, double to_time,
+                           int i_ensemble);
 
   /**
    * Performs all the propagations and actions during a certain time interval
@@ -325,24 +753,207 @@ class Experiment : public ExperimentBase {
   void run_time_evolution_timestepless(Actions &actions, int i_ensemble,
                                        const double end_time_propagation);
 
+  /**
+   * Execute a task for all ensembles and merge the per-ensemble counters and
+   * outputs afterwards, if the ensembles are evolved concurrently.
+   *
+   * In the concurrent mode, each task draws random numbers from the engine of
+   * its ensemble, while the counters and outputs of the ensembles are merged
+   * in the order of the ensembles. Hence, the results do not depend on the
+   * number of threads.
+   *
+   * \param[in] task Function to be called with the index of each ensemble.
+   * \param[in] concurrently Whether the tasks may be run concurrently. If not,
+   *            the ensembles are treated one after the other by the calling
+   *            thread, e.g. if the tasks share some mutable state.
+   */
+  void for_each_ensemble(const std::function<void(int)> &task,
+                         bool concurrently = true);
+
+  /**
+   * Write the buffered outputs of the ensembles and add up their interaction
+   * counters, in the order of the ensembles, after they were evolved
+   * concurrently.
+   */
+  void merge_ensemble_results();
+
+  /**
+   * Search the actions in the cells of the given grid, distributing the rows
+   * of the grid over the threads of grid_thread_pool_.
+   *
+   * The actions found in each row are collected in a separate list and all
+   * lists are merged in the order of the rows into \p actions at the end,
+   * such that the heap is built only once. Each row draws random numbers from
+   * its own engine, seeded from the current engine, hence the result does not
+   * depend on the number of threads.
+   *
+   * \tparam GridType Type of the grid created by the modus.
+   * \param[in] grid The grid with the particles of one ensemble.
+   * \param[in] dt Duration of the current time step in fm.
+   * \param[out] actions The found actions, replacing previous content.
+   */
+  template <typename GridType>
+  void find_actions_in_rows_concurrently(const GridType &grid, double dt,
+                                         Actions &actions);
+
+  /**
+   * Perform the final actions of one ensemble, generating their final states
+   * on the threads of grid_thread_pool_.
+   *
+   * The final actions of one pass, e.g. the decays of all remaining
+   * resonances, involve different particles, such that their final states
+   * are independent. Each action draws random numbers from its own engine,
+   * seeded from the current engine, hence the result does not depend on the
+   * number of threads. The actions are then performed one after the other in
+   * the order of the queue, which updates the particles and writes the
+   * outputs as in the serial case.
+   *
+   * \param[in] actions The final actions, which are all performed.
+   * \param[in] i_ensemble Index of the ensemble of the actions.
+   */
+  void perform_final_actions_concurrently(Actions &actions, int i_ensemble);
+
+  /**
+   * \param[in] i_ensemble index of ensemble in which an action is performed
+   * \return The counters to be increased by actions of the given ensemble.
+   */
+  InteractionCounters &counters_of(int i_ensemble) {
+    return thread_pool_ ? ensemble_counters_[i_ensemble] : counters_;
+  }
+
+  /**
+   * \param[in] i_ensemble index of ensemble in which an action is performed
+   * \return The outputs to which interactions of the given ensemble are
+   *         passed. These are buffers if the ensembles are evolved
+   *         concurrently.
+   */
+  const OutputsList &outputs_of(int i_ensemble) const {
+    return thread_pool_ ? ensemble_outputs_[i_ensemble] : outputs_;
+  }
+
+  /**
+   * \param[in] list outputs_ or the buffers of an ensemble, which are in the
+   *            same order
+   * \param[in] output One of the outputs in the list
+   * \return The section of the time profile for the calls of the output.
+   */
+  Profiler::Section output_section(const OutputsList &list,
+                                   const OutputPtr &output) const {
+    return output_sections_[std::addressof(output) - list.data()];
+  }
+
+  /**
+   * \param[in] type The process type of an action
+   * \return The section of the time profile for performing the action.
+   */
+  Profiler::Section process_section(ProcessType type) const {
+    return process_sections_[static_cast<int>(type)];
+  }
+
+  /**
+   * \param[in] finder One of the action finders
+   * \return The section of the time profile for the search of the finder.
+   */
+  Profiler::Section finder_section(
+      const std::unique_ptr<ActionFinderInterface> &finder) const {
+    return finder_sections_[std::addressof(finder) - action_finders_.data()];
+  }
+
+  /**
+   * Determine the process id for the next action of the given ensemble.
+   *
+   * \param[in] i_ensemble index of ensemble in which the action is performed
+   * \return A positive id, unique within the event.
+   * \throw std::runtime_error if the id cannot be represented with 32 bits.
+   */
+  uint32_t next_process_id(int i_ensemble);
+
   /// Intermediate output during an event
   void intermediate_output();
 
+  /// Count the conserved quantities of each ensemble from its particles.
+  void recount_conserved_quantities();
+
+  /**
+   * Compare the conserved quantities of the system to the ones at the start of
+   * the event, unless they are not expected to be conserved because of
+   * potentials, string fragmentation, an expanding metric or the initial
+   * conditions output.
+   *
+   * \param[in] recount Whether the conserved quantities are counted from the
+   *            particles, else the ones kept up to date by the performed
+   *            actions are compared.
+   * \throw std::runtime_error if they are violated.
+   */
+  void check_conservation_laws(bool recount);
+
+  /**
+   * Check whether the system has frozen out, i.e. no action can be found any
+   * more until the end of the time evolution. This is the case if only
+   * stable particles are left, which do not approach each other, and neither
+   * the potentials, an expanding metric, the walls of a box, the
+   * thermalization or the initial conditions can change this. With the
+   * stochastic criterion, receding particles may still collide.
+   *
+   * The number of pairs to check grows quadratically with the number of
+   * particles, hence this is only done once no interaction happened for \ref
+   * key_gen_freeze_out_window_ "Freeze_Out_Window" time steps.
+   *
+   * \return Whether no action will be found any more.
+   */
+  bool frozen_out() const;
+
+  /**
+   * Set the duration of the next time step of the lab clock from what was
+   * observed in the time step which just ended, see AdaptiveTimeStep.
+   *
+   * \param[in] timestep Duration of the time step which just ended [fm].
+   * \param[in] n_interactions Number of interactions performed in it, without
+   *            wall crossings.
+   * \param[in] min_time_scale Smallest time scale of the momentum change due
+   *            to potentials in it [fm].
+   */
+  void adapt_timestep(double timestep, uint64_t n_interactions,
+                      double min_time_scale);
+
   /// Recompute potentials on lattices if necessary.
   void update_potentials();
 
+  /**
+   * Move and resize all lattices to cover the particles of all ensembles,
+   * keeping the cell sizes and the positions of the cell centers, see
+   * \ref key_lattice_resizing_interval_. The lattices are reset.
+   */
+  void resize_lattices();
+
+  /**
+   * \return The total mean field energy of the current baryon density
+   * lattice, see calculate_mean_field_energy. It is only computed again
+   * if the lattices changed since the last call.
+   */
+  double mean_field_energy();
+
   /**
    * Calculate the minimal size for the grid cells such that the
    * ScatterActionsFinder will find all collisions within the maximal
    * transverse distance (which is determined by the maximal cross section).
    *
    * \param[in] dt The current time step size [fm]
+   * \param[in] particles The particles of the ensemble put onto the grid. If
+   *            given and the dynamic cell size is enabled, the maximal
+   *            transverse distance is estimated from them.
    * \return The minimal required size of cells
    */
-  double compute_min_cell_length(double dt) const {
+  double compute_min_cell_length(double dt,
+                                 const Particles *particles = nullptr) const {
     if (parameters_.coll_crit == CollisionCriterion::Stochastic) {
       return parameters_.fixed_min_cell_length;
     }
+    if (particles && dynamic_cell_finder_) {
+      return std::sqrt(
+          4 * dt * dt +
+          dynamic_cell_finder_->max_transverse_distance_sqr(*particles));
+    }
     return std::sqrt(4 * dt * dt + max_transverse_distance_sqr_);
   }
 
@@ -395,6 +1006,12 @@ class Experiment : public ExperimentBase {
    */
   std::unique_ptr<PauliBlocker> pauli_blocker_;
 
+  /**
+   * The thread writing the outputs, if they are written asynchronously. It is
+   * declared before the outputs, such that it is destroyed after them.
+   */
+  std::unique_ptr<OutputWriter> output_writer_;
+
   /**
    * A list of output formaters. They will be called to write the state of the
    * particles to file.
@@ -407,11 +1024,47 @@ class Experiment : public ExperimentBase {
   /// The Photon output
   OutputPtr photon_output_;
 
+  /**
+   * Indices of the outputs in outputs_, and of their buffers of each ensemble,
+   * which subscribed to the event hooks, see OutputInterface::subscribed_hooks
+   */
+  std::vector<std::size_t> event_outputs_;
+
+  /**
+   * Indices of the outputs receiving the interactions, which subscribed to the
+   * interaction hooks, without the dilepton, photon and IC outputs
+   */
+  std::vector<std::size_t> interaction_outputs_;
+
+  /**
+   * Indices of the outputs receiving the fluidizations, which are those of
+   * interaction_outputs_ together with the IC outputs
+   */
+  std::vector<std::size_t> fluidization_outputs_;
+
+  /**
+   * Indices of the outputs which subscribed to the intermediate time hooks,
+   * without the dilepton, photon and IC outputs
+   */
+  std::vector<std::size_t> intermediate_time_outputs_;
+
+  /// Whether there is a photon output receiving the photons of interactions
+  bool has_photon_output_ = false;
+
   /**
    * Whether the projectile and the target collided.
-   * One value for each ensemble.
+   * One value for each ensemble. This is not a std::vector<bool>, because the
+   * values of different ensembles might be written concurrently.
+   */
+  std::vector<char> projectile_target_interact_;
+
+  /**
+   * Spatial indices of the particles of every ensemble, which are used to find
+   * the collision partners of outgoing particles in the timestepless
+   * propagation. They are only built while the actions of a timestep are
+   * performed and if the grid is used.
    */
-  std::vector<bool> projectile_target_interact_;
+  std::vector<NeighborIndex> neighbor_indices_;
 
   /**
    * The initial nucleons in the ColliderModus propagate with
@@ -625,38 +1278,233 @@ class Experiment : public ExperimentBase {
   /// This indicates whether to use time steps.
   const TimeStepMode time_step_mode_;
 
+  /// The kind of queue in which the actions of every ensemble are kept.
+  const ActionQueue action_queue_;
+
+  /// Fraction of holes above which the particles of an ensemble are compacted
+  const double particles_compaction_threshold_;
+
+  /// Number of time steps between reorderings of the particles, 0 for never
+  const int particles_reordering_interval_;
+
   /**
-   * Maximal distance at which particles can interact in case of the geometric
-   * criterion, squared
+   * Number of time steps without interactions after which the actions are no
+   * longer searched for, once the system has frozen out, 0 for never
    */
-  double max_transverse_distance_sqr_ = std::numeric_limits<double>::max();
+  const int freeze_out_window_;
+
+  /// Whether the time profiles are logged, see \ref key_gen_profiling_
+  const bool log_profile_;
 
   /**
-   * The conserved quantities of the system.
-   *
-   * This struct carries the sums of the single particle's various
-   * quantities as measured at the beginning of the evolution and can be
-   * used to regularly check if they are still good.
+   * Measures the time spent in the phases of the evolution, if profiling is
+   * switched on or the performance is written. The times of concurrent
+   * ensembles are summed up.
    */
-  QuantumNumbers conserved_initial_;
+  Profiler profiler_;
 
   /**
-   * The initial total mean field energy in the system.
-   * Note: will only be calculated if lattice is on.
+   * The trace of the profiled phases, if it is recorded, see
+   * \ref key_gen_trace_events_. The workers share it with the primary
+   * experiment, which writes it at the end of the run.
+   */
+  std::shared_ptr<TraceRecorder> trace_;
+
+  /// The file the trace is written to by the primary experiment
+  std::filesystem::path trace_path_;
+
+  /**
+   * The recorder of the inputs of the hot kernels of the primary experiment,
+   * if the workload is recorded, see \ref key_gen_workload_sampling_. It is
+   * the active WorkloadRecorder, to which the kernels of the workers record
+   * as well.
+   */
+  std::unique_ptr<WorkloadRecorder> workload_;
+
+  /// Whether the statistics of every event are passed to the outputs
+  bool write_event_statistics_ = false;
+
+  /**
+   * Soft limit of the memory used by the measured subsystems [bytes], 0 for
+   * none, see \ref key_gen_memory_limit_
+   */
+  std::size_t memory_limit_ = 0;
+
+  /// Whether the memory exceeded the limit at the latest measurement
+  bool memory_is_short_ = false;
+
+  /// Number of time steps between checkpoints, 0 for only on request
+  int checkpoint_interval_ = 0;
+
+  /// The file the checkpoints are written to
+  std::filesystem::path checkpoint_path_;
+
+  /**
+   * Number of time steps done in the interrupted call of run_time_evolution,
+   * if the next event is resumed from a checkpoint.
+   */
+  std::optional<int> resumed_timesteps_;
+
+  /// Number of events sharing the evolution of one initial state
+  int forks_per_event_ = 1;
+
+  /// Time from which on the events are forked
+  double fork_time_ = -std::numeric_limits<double>::infinity();
+
+  /// Snapshot of the running event at the fork time, once it is taken
+  std::optional<CheckpointWriter> fork_snapshot_;
+
+  /// Number of forks still to be continued from fork_snapshot_
+  int forks_left_ = 0;
+
+  /// Whether the next event is prepared while the current one is evolved
+  bool prepare_next_event_ = false;
+
+  /// The initial particles of the event being prepared, one per ensemble
+  std::vector<Particles> prepared_ensembles_;
+
+  /**
+   * The event being prepared on a separate thread. It is declared after all
+   * members used by the preparation, such that it is waited for before they
+   * are destroyed.
+   */
+  std::future<PreparedEvent> next_event_;
+
+  /// Number of subsystems whose memory is measured, see measure_memory()
+  static constexpr std::size_t n_memory_subsystems = 5;
+
+  /// Names of the subsystems whose memory is measured
+  static constexpr std::array<const char *, n_memory_subsystems>
+      memory_subsystems_ = {"particles", "actions", "grids", "lattices",
+                            "outputs"};
+
+  /// Memory of every subsystem at the latest measurement [bytes]
+  std::array<std::size_t, n_memory_subsystems> memory_current_{};
+
+  /// Maximal memory of every subsystem in the current event [bytes]
+  std::array<std::size_t, n_memory_subsystems> memory_peak_{};
+
+  /// Whether the memory has been measured in the current event
+  bool memory_measured_ = false;
+
+  /// The sections of the time profile for the fixed phases of a time step
+  struct ProfiledPhases {
+    /// Forced thermalization, including its actions
+    Profiler::Section thermalization;
+    /// Building the lattice of the dynamic fluidization
+    Profiler::Section fluidization_lattice;
+    /// Building the grids of the ensembles
+    Profiler::Section grid;
+    /// Propagation of the particles from action to action
+    Profiler::Section propagation;
+    /// Timestepless propagation of an ensemble, including its actions
+    Profiler::Section timestepless_propagation;
+    /// Building the Pauli blocking index and checking the actions
+    Profiler::Section pauli_blocking;
+    /// Updating the potentials on the lattices
+    Profiler::Section potentials;
+    /// Smearing the densities onto the lattices of the potentials
+    Profiler::Section smearing;
+    /// Updating the momenta according to the potentials
+    Profiler::Section momenta;
+  };
+
+  /// The sections of the fixed phases
+  ProfiledPhases profiled_phases_;
+
+  /// The section of every action finder, in the order of action_finders_
+  std::vector<Profiler::Section> finder_sections_;
+
+  /// The section of every output, in the order of outputs_
+  std::vector<Profiler::Section> output_sections_;
+
+  /// The section of the actions of every process type, by its value
+  std::vector<Profiler::Section> process_sections_;
+
+  /// The rule to adapt the time step, if the adaptive time step mode is used.
+  std::optional<AdaptiveTimeStep> adaptive_timestep_;
+
+  /**
+   * Net baryon density at the nodes of the lattice at the end of the previous
+   * time step, to measure its change for the adaptive time step.
+   */
+  std::vector<double> previous_baryon_densities_;
+
+  /// Type of the grid created by the modus
+  using EnsembleGrid = decltype(std::declval<const Modus &>().create_grid(
+      std::declval<const Particles &>(), 0., 0., CollisionCriterion{}, false));
+
+  /**
+   * The grid of every ensemble. It is kept between the time steps, such that
+   * its memory is reused when the particles are placed onto it anew.
+   */
+  std::vector<std::optional<EnsembleGrid>> grids_;
+
+  /**
+   * The decay times of the resonances of every ensemble, which are sampled
+   * once per momentum of a resonance. It is empty unless
+   * \ref key_CT_presample_decay_times_ is set.
+   */
+  std::vector<DecayTimes> decay_times_;
+
+  /**
+   * Maximal distance at which particles can interact in case of the geometric
+   * criterion, squared
+   */
+  double max_transverse_distance_sqr_ = std::numeric_limits<double>::max();
+
+  /**
+   * The finder estimating the cross sections of the particles present, if the
+   * cells of the grid are sized from them, see \ref key_CT_dynamic_cell_size_
+   * "Dynamic_Cell_Size"
+   */
+  const ScatterActionsFinder *dynamic_cell_finder_ = nullptr;
+
+  /// The finder of the scatterings, if any, see frozen_out()
+  const ScatterActionsFinder *scatter_finder_ = nullptr;
+
+  /**
+   * The conserved quantities of the system.
+   *
+   * This struct carries the sums of the single particle's various
+   * quantities as measured at the beginning of the evolution and can be
+   * used to regularly check if they are still good.
+   */
+  QuantumNumbers conserved_initial_;
+
+  /**
+   * The conserved quantities of each ensemble, which are updated by every
+   * performed action, such that checking them does not need to go through all
+   * particles. They are counted anew at the start of an event and at every
+   * intermediate output.
+   */
+  std::vector<QuantumNumbers> conserved_by_ensemble_;
+
+  /**
+   * The initial total mean field energy in the system.
+   * Note: will only be calculated if lattice is on.
    */
   double initial_mean_field_energy_;
 
+  /**
+   * The mean field energy of the current lattices, if it has been computed
+   * since the baryon density or the electromagnetic fields were last updated.
+   * Several outputs in the same time step thus share a single sum over the
+   * lattice.
+   */
+  std::optional<double> mean_field_energy_;
+
   /// system starting time of the simulation
   SystemTimePoint time_start_ = SystemClock::now();
 
   /// Type of density to be written to collision headers
   DensityType dens_type_ = DensityType::None;
 
-  /**
-   *  Total number of interactions for current timestep.
-   *  For timestepless mode the whole run time is considered as one timestep.
-   */
-  uint64_t interactions_total_ = 0;
+  /// Counters of the current event, summed over all ensembles.
+  InteractionCounters counters_{};
+
+  /// Number of actions in the finished events, without wall crossings
+  uint64_t actions_performed_ = 0;
 
   /**
    *  Total number of interactions for previous timestep.
@@ -665,44 +1513,98 @@ class Experiment : public ExperimentBase {
   uint64_t previous_interactions_total_ = 0;
 
   /**
-   *  Total number of wall-crossings for current timestep.
+   *  Total number of wall-crossings for previous timestep.
    *  For timestepless mode the whole run time is considered as one timestep.
    */
-  uint64_t wall_actions_total_ = 0;
+  uint64_t previous_wall_actions_total_ = 0;
 
   /**
-   *  Total number of wall-crossings for previous timestep.
-   *  For timestepless mode the whole run time is considered as one timestep.
+   * Pool of the threads evolving the ensembles concurrently. It is only
+   * created if more than one thread is requested.
    */
-  uint64_t previous_wall_actions_total_ = 0;
+  std::unique_ptr<ThreadPool> thread_pool_;
 
   /**
-   *  Total number of Pauli-blockings for current timestep.
-   *  For timestepless mode the whole run time is considered as one timestep.
+   * Whether the threads of thread_pool_, grid_thread_pool_ and
+   * lattice_thread_pool_ are pinned to CPUs
    */
-  uint64_t total_pauli_blocked_ = 0;
+  bool pin_threads_ = false;
 
   /**
-   *  Total number of particles removed from the evolution in
-   *  hypersurface crossing actions.
+   * Whether only the particles involved in the next action are propagated to
+   * its time, see \ref key_gen_lazy_propagation_
    */
-  uint64_t total_hypersurface_crossing_actions_ = 0;
+  bool lazy_propagation_ = false;
 
   /**
-   *  Total number of discarded interactions, because they were invalidated
-   *  before they could be performed.
+   * Random number engines of the ensembles, used if the ensembles are evolved
+   * concurrently. They are derived from the seed of the event.
    */
-  uint64_t discarded_interactions_total_ = 0;
+  std::vector<random::Engine> ensemble_engines_;
+
+  /// Counters of the single ensembles, used if they are evolved concurrently
+  std::vector<InteractionCounters> ensemble_counters_;
 
   /**
-   * Total energy removed from the system in hypersurface crossing actions.
+   * Buffers for the interactions destined to outputs_, one list per ensemble,
+   * used if the ensembles are evolved concurrently.
    */
-  double total_energy_removed_ = 0.0;
+  std::vector<OutputsList> ensemble_outputs_;
 
   /**
-   * Total energy violation introduced by Pythia.
+   * Number of process ids reserved by the concurrent steps of the current
+   * event. The ensembles use interleaved ids in a concurrent step, such that
+   * the ids are unique and do not depend on the order of execution.
+   */
+  uint64_t process_ids_reserved_ = 0;
+
+  /**
+   * Pool of the threads searching the rows of the grid concurrently. It is
+   * only created if more than one thread is requested.
+   */
+  std::unique_ptr<ThreadPool> grid_thread_pool_;
+
+  /**
+   * Pool of the threads smearing the particles onto the lattices and updating
+   * their momenta in the potentials. It is only created if more than one
+   * thread is requested.
+   */
+  std::unique_ptr<ThreadPool> lattice_thread_pool_;
+
+  /// Number of time steps between resizings of the lattices, 0 for never
+  int lattice_resizing_interval_ = 0;
+
+  /**
+   * The particles smeared onto the baryon, isospin and charge density lattices
+   * of the potentials at their last update, which are only created if the
+   * lattices are updated incrementally, see
+   * \ref key_lattice_incremental_update_interval_.
+   */
+  std::unique_ptr<SmearedParticles> smeared_B_, smeared_I3_, smeared_el_;
+
+  /// Origin of the configured lattice, to whose cells the lattices are aligned
+  std::array<double, 3> lattice_grid_origin_{};
+
+  /// Cell sizes of the configured lattice, kept when the lattices are resized
+  std::array<double, 3> lattice_cell_sizes_{};
+
+  /**
+   * Pool of the threads simulating events concurrently. It is only created if
+   * more than one thread is requested.
    */
-  double total_energy_violated_by_Pythia_ = 0.0;
+  std::unique_ptr<ThreadPool> event_thread_pool_;
+
+  /**
+   * Further experiments simulating events concurrently to this one, used if
+   * more than one event thread is requested.
+   */
+  std::vector<std::unique_ptr<Experiment>> event_workers_;
+
+  /**
+   * Whether concurrent events are handed out one by one, the ones expected to
+   * take longest first, instead of in batches
+   */
+  bool longest_events_first_ = false;
 
   /// This indicates whether kinematic cuts are enabled for the IC output
   bool kinematic_cuts_for_IC_output_ = false;
@@ -710,6 +1612,12 @@ class Experiment : public ExperimentBase {
   /// random seed for the next event.
   int64_t seed_ = -1;
 
+  /**
+   * Random seed of the current event, from which the random number streams of
+   * the concurrent tasks are derived.
+   */
+  int64_t event_seed_ = -1;
+
   /**
    * \ingroup logging
    * Writes the initial state for the Experiment to the output stream.
@@ -730,7 +1638,8 @@ template <typename Modus>
 void Experiment<Modus>::create_output(const std::string &format,
                                       const std::string &content,
                                       const std::filesystem::path &output_path,
-                                      const OutputParameters &out_par) {
+                                      const OutputParameters &out_par,
+                                      int shard) {
   // Disable output which do not properly work with multiple ensembles
   if (ensembles_.size() > 1) {
     auto abort_because_of = [](const std::string &s) {
@@ -759,6 +1668,9 @@ void Experiment<Modus>::create_output(const std::string &format,
   if (format == "VTK" && content == "Particles") {
     outputs_.emplace_back(
         std::make_unique<VtkOutput>(output_path, content, out_par));
+  } else if (format == "VTK_Binary" && content == "Particles") {
+    outputs_.emplace_back(
+        std::make_unique<VtkOutput>(output_path, content, out_par, true));
   } else if (format == "Root") {
 #ifdef SMASH_USE_ROOT
     if (content == "Initial_Conditions") {
@@ -777,7 +1689,15 @@ void Experiment<Modus>::create_output(const std::string &format,
               content == "Dileptons" || content == "Photons" ||
               content == "Initial_Conditions")) {
     outputs_.emplace_back(
-        create_binary_output(format, content, output_path, out_par));
+        create_binary_output(format, content, output_path, out_par, shard));
+  } else if (format == "Parquet" && content == "Particles") {
+#ifdef SMASH_USE_PARQUET
+    outputs_.emplace_back(
+        std::make_unique<ParquetOutput>(output_path, content, out_par));
+#else
+    logg[LExperiment].error(
+        "Parquet output requested, but Parquet support not compiled in");
+#endif
   } else if (format == "Oscar1999" || format == "Oscar2013") {
     outputs_.emplace_back(
         create_oscar_output(format, content, output_path, out_par));
@@ -790,16 +1710,35 @@ void Experiment<Modus>::create_output(const std::string &format,
   } else if (content == "Thermodynamics" && format == "ASCII") {
     outputs_.emplace_back(
         std::make_unique<ThermodynamicOutput>(output_path, content, out_par));
+  } else if (content == "Spectra" && format == "ASCII") {
+    outputs_.emplace_back(
+        std::make_unique<SpectraOutput>(output_path, content, out_par));
+  } else if (content == "Performance" && format == "ASCII") {
+    outputs_.emplace_back(
+        std::make_unique<PerformanceOutput>(output_path, content));
   } else if (content == "Thermodynamics" &&
              (format == "Lattice_ASCII" || format == "Lattice_Binary")) {
     printout_full_lattice_any_td_ = true;
     outputs_.emplace_back(std::make_unique<ThermodynamicLatticeOutput>(
         output_path, content, out_par, format == "Lattice_ASCII",
         format == "Lattice_Binary"));
+  } else if (content == "Thermodynamics" && format == "Lattice_HDF5") {
+#ifdef SMASH_USE_HDF5
+    printout_full_lattice_any_td_ = true;
+    outputs_.emplace_back(std::make_unique<ThermodynamicLatticeOutput>(
+        output_path, content, out_par, false, false, true));
+#else
+    logg[LExperiment].error(
+        "Lattice_HDF5 output requested, but HDF5 support not compiled in");
+#endif
   } else if (content == "Thermodynamics" && format == "VTK") {
     printout_lattice_td_ = true;
     outputs_.emplace_back(
         std::make_unique<VtkOutput>(output_path, content, out_par));
+  } else if (content == "Thermodynamics" && format == "VTK_Binary") {
+    printout_lattice_td_ = true;
+    outputs_.emplace_back(
+        std::make_unique<VtkOutput>(output_path, content, out_par, true));
   } else if (content == "Initial_Conditions" && format == "For_vHLLE") {
     if (IC_dynamic_) {
       throw std::invalid_argument(
@@ -814,7 +1753,8 @@ void Experiment<Modus>::create_output(const std::string &format,
     if (content == "Particles") {
       if ((format == "HepMC") || (format == "HepMC_asciiv3")) {
         outputs_.emplace_back(std::make_unique<HepMcOutput>(
-            output_path, "SMASH_HepMC_particles", false, "asciiv3"));
+            output_path, "SMASH_HepMC_particles", false, "asciiv3",
+            out_par.part_compression));
       } else if (format == "HepMC_treeroot") {
 #ifdef SMASH_USE_HEPMC_ROOTIO
         outputs_.emplace_back(std::make_unique<HepMcOutput>(
@@ -828,7 +1768,8 @@ void Experiment<Modus>::create_output(const std::string &format,
     } else if (content == "Collisions") {
       if ((format == "HepMC") || (format == "HepMC_asciiv3")) {
         outputs_.emplace_back(std::make_unique<HepMcOutput>(
-            output_path, "SMASH_HepMC_collisions", true, "asciiv3"));
+            output_path, "SMASH_HepMC_collisions", true, "asciiv3",
+            out_par.coll_compression));
       } else if (format == "HepMC_treeroot") {
 #ifdef SMASH_USE_HEPMC_ROOTIO
         outputs_.emplace_back(std::make_unique<HepMcOutput>(
@@ -852,6 +1793,9 @@ void Experiment<Modus>::create_output(const std::string &format,
   } else if (content == "Coulomb" && format == "VTK") {
     outputs_.emplace_back(
         std::make_unique<VtkOutput>(output_path, "Fields", out_par));
+  } else if (content == "Coulomb" && format == "VTK_Binary") {
+    outputs_.emplace_back(
+        std::make_unique<VtkOutput>(output_path, "Fields", out_par, true));
   } else if (content == "Rivet") {
 #ifdef SMASH_USE_RIVET
     // flag to ensure that the Rivet format has not been already assigned
@@ -900,7 +1844,9 @@ ExperimentParameters create_experiment_parameters(Configuration &config);
 
 template <typename Modus>
 Experiment<Modus>::Experiment(Configuration &config,
-                              const std::filesystem::path &output_path)
+                              const std::filesystem::path &output_path,
+                              const Experiment *primary,
+                              const std::string &worker_configuration)
     : parameters_(create_experiment_parameters(config)),
       density_param_(DensityParameters(parameters_)),
       modus_(std::invoke([&]() {
@@ -939,9 +1885,91 @@ Experiment<Modus>::Experiment(Configuration &config,
       IC_dynamic_(IC_switch_ ? (modus_.IC_parameters().type ==
                                 FluidizationType::Dynamic)
                              : false),
-      time_step_mode_(config.take(InputKeys::gen_timeStepMode)) {
+      time_step_mode_(config.take(InputKeys::gen_timeStepMode)),
+      action_queue_(config.take(InputKeys::gen_actionQueue)),
+      particles_compaction_threshold_(
+          config.take(InputKeys::gen_particlesCompactionThreshold)),
+      particles_reordering_interval_(
+          config.take(InputKeys::gen_particlesReorderingInterval)),
+      freeze_out_window_(config.take(InputKeys::gen_freezeOutWindow)),
+      log_profile_(config.take(InputKeys::gen_profiling)),
+      profiler_(log_profile_) {
   logg[LExperiment].info() << *this;
 
+  profiled_phases_ = {profiler_.section("thermalization"),
+                      profiler_.section("fluidization lattice"),
+                      profiler_.section("grid"),
+                      profiler_.section("propagation"),
+                      profiler_.section("timestepless propagation"),
+                      profiler_.section("Pauli blocking"),
+                      profiler_.section("potentials"),
+                      profiler_.section("smearing"),
+                      profiler_.section("momenta")};
+  if (config.take(InputKeys::gen_hardwareCounters) &&
+      !profiler_.count_hardware_events()) {
+    logg[LExperiment].warn(
+        "The hardware performance counters are not available, only the "
+        "times of the profiled phases are measured.");
+  }
+  process_sections_.resize(static_cast<int>(ProcessType::Freeforall) + 1);
+  for (int v = 0; v < static_cast<int>(process_sections_.size()); v++) {
+    if (is_valid_process_type(v)) {
+      std::ostringstream name;
+      name << static_cast<ProcessType>(v) << " actions";
+      process_sections_[v] = profiler_.section(name.str());
+    }
+  }
+
+  const int trace_events = config.take(InputKeys::gen_traceEvents);
+  if (trace_events < 0) {
+    throw std::invalid_argument("Trace_Events cannot be negative.");
+  }
+  if (primary) {
+    trace_ = primary->trace_;
+  } else if (trace_events > 0) {
+    trace_ = std::make_shared<TraceRecorder>(trace_events);
+    trace_path_ = output_path / "trace.json";
+  }
+  if (trace_) {
+    profiler_.record_to(trace_.get());
+  }
+
+  const int workload_sampling = config.take(InputKeys::gen_workloadSampling);
+  if (workload_sampling < 0) {
+    throw std::invalid_argument("Workload_Sampling cannot be negative.");
+  }
+  if (!primary && workload_sampling > 0) {
+    workload_ = std::make_unique<WorkloadRecorder>(
+        output_path / "workload.bin", workload_sampling);
+    WorkloadRecorder::set_active(workload_.get());
+  }
+
+  const double memory_limit = config.take(InputKeys::gen_memoryLimit);
+  if (memory_limit < 0.) {
+    throw std::invalid_argument("Memory_Limit cannot be negative.");
+  }
+  memory_limit_ = static_cast<std::size_t>(memory_limit * 1024 * 1024);
+  // Before the particles and the lattices grow
+  HugePages::set_enabled(config.take(InputKeys::gen_hugePages));
+
+  checkpoint_interval_ = config.take(InputKeys::gen_checkpointInterval);
+  if (checkpoint_interval_ < 0) {
+    throw std::invalid_argument("Checkpoint_Interval cannot be negative.");
+  }
+  checkpoint_path_ = output_path / "checkpoint.bin";
+
+  forks_per_event_ = config.take(InputKeys::gen_forksPerEvent);
+  if (forks_per_event_ < 1) {
+    throw std::invalid_argument("Forks_Per_Event has to be at least 1.");
+  }
+  if (config.has_value(InputKeys::gen_forkTime)) {
+    fork_time_ = config.take(InputKeys::gen_forkTime);
+  }
+
+  prepare_next_event_ = config.take(InputKeys::gen_prepareNextEvent);
+  pin_threads_ = config.take(InputKeys::gen_pinThreads);
+  lazy_propagation_ = config.take(InputKeys::gen_lazyPropagation);
+
   const bool user_wants_nevents = config.has_value(InputKeys::gen_nevents);
   const bool user_wants_min_nonempty =
       config.has_section(InputSections::g_minEnsembles);
@@ -991,6 +2019,16 @@ Experiment<Modus>::Experiment(Configuration &config,
         "The box modus can only be used with the fixed time step mode!");
   }
 
+  if (time_step_mode_ == TimeStepMode::Adaptive) {
+    adaptive_timestep_.emplace(AdaptiveTimeStepParameters{
+        config.take(InputKeys::gen_adaptiveTimeStep_minimumDeltaTime),
+        config.take(InputKeys::gen_adaptiveTimeStep_maximumDeltaTime),
+        config.take(InputKeys::gen_adaptiveTimeStep_maximumGrowthFactor),
+        config.take(InputKeys::gen_adaptiveTimeStep_interactionsPerParticle),
+        config.take(InputKeys::gen_adaptiveTimeStep_relativeDensityChange),
+        config.take(InputKeys::gen_adaptiveTimeStep_potentialsSafetyFactor)});
+  }
+
   logg[LExperiment].info("Using ", parameters_.testparticles,
                          " testparticles per particle.");
   logg[LExperiment].info("Using ", parameters_.n_ensembles,
@@ -1042,6 +2080,20 @@ Experiment<Modus>::Experiment(Configuration &config,
     n_fractional_photons_ =
         config.take(InputKeys::collTerm_photons_fractionalPhotons);
   }
+  if (bremsstrahlung_switch_) {
+    BremsstrahlungAction::set_grid_lookup(
+        config.take(InputKeys::collTerm_photons_bremsstrahlungGridLookup));
+  }
+  if (photons_switch_) {
+    const bool tabulated =
+        config.take(InputKeys::collTerm_photons_tabulatedCrossSections);
+    const double accuracy =
+        config.take(InputKeys::collTerm_photons_tabulationAccuracy);
+    if (tabulated) {
+      CrosssectionsPhoton<ComputationMethod::Lookup>::create_tables(accuracy);
+    }
+    ScatterActionPhoton::set_tabulated_cross_sections(tabulated);
+  }
   if (parameters_.two_to_one) {
     if (parameters_.res_lifetime_factor < 0.) {
       throw std::invalid_argument(
@@ -1054,28 +2106,43 @@ Experiment<Modus>::Experiment(Configuration &config,
           "inelastically (e.g. resonance chains), else SMASH is known to "
           "hang.");
     }
+    if (config.take(InputKeys::collTerm_aliasDecayChannels)) {
+      DecayChannelTable::create_tables();
+    } else {
+      DecayChannelTable::clear_tables();
+    }
     action_finders_.emplace_back(std::make_unique<DecayActionsFinder>(
         parameters_.res_lifetime_factor, parameters_.do_non_strong_decays,
         force_decays_, parameters_.spin_interaction_type));
+    if (config.take(InputKeys::collTerm_presampleDecayTimes)) {
+      decay_times_.resize(parameters_.n_ensembles);
+    }
   }
+  ParticleType::set_tabulated_mass_sampling(
+      config.take(InputKeys::collTerm_tabulatedResonanceMasses));
   bool no_coll = config.take(InputKeys::collTerm_noCollisions);
   if ((parameters_.two_to_one || parameters_.included_2to2.any() ||
        parameters_.included_multi.any() || parameters_.strings_switch) &&
       !no_coll) {
     parameters_.use_monash_tune_default =
         (modus_.is_collider() && modus_.sqrt_s_NN() >= 200.);
+    CrossSections::create_interaction_profiles();
     auto scat_finder =
         std::make_unique<ScatterActionsFinder>(config, parameters_);
     max_transverse_distance_sqr_ =
         scat_finder->max_transverse_distance_sqr(parameters_.testparticles);
     process_string_ptr_ = scat_finder->get_process_string_ptr();
+    if (scat_finder->dynamic_cell_size()) {
+      dynamic_cell_finder_ = scat_finder.get();
+    }
+    scatter_finder_ = scat_finder.get();
     action_finders_.emplace_back(std::move(scat_finder));
   } else {
     max_transverse_distance_sqr_ =
         parameters_.maximum_cross_section / M_PI * fm2_mb;
     process_string_ptr_ = NULL;
   }
-  if (modus_.is_box()) {
+  if (modus_.is_box() && !parameters_.lazy_wall_crossings) {
     action_finders_.emplace_back(
         std::make_unique<WallCrossActionsFinder>(parameters_.box_length));
   }
@@ -1133,6 +2200,9 @@ Experiment<Modus>::Experiment(Configuration &config,
               proper_time, rapidity_cut, pT_cut));
     }
   }
+  for (const auto &finder : action_finders_) {
+    finder_sections_.push_back(profiler_.section(finder->name()));
+  }
 
   if (config.has_section(InputSections::c_pauliBlocking)) {
     logg[LExperiment].info() << "Pauli blocking is ON.";
@@ -1217,6 +2287,16 @@ Experiment<Modus>::Experiment(Configuration &config,
    *          \ref doxypage_output_rivet for details.
    *    - Available formats:
    *          \ref doxypage_output_rivet.
+   * - \b Spectra:
+   *          Histograms of the final particles filled while SMASH runs, see
+   *          \ref doxypage_output_spectra for details.
+   *    - Available formats:
+   *          \ref doxypage_output_spectra.
+   * - \b Performance:
+   *          Statistics about the computational work done in every event, see
+   *          \ref doxypage_output_performance for details.
+   *    - Available formats:
+   *          \ref doxypage_output_performance.
    *
    * \attention At the moment, the \b Initial_Conditions and \b Rivet outputs
    * content as well as the \b HepMC format cannot be used <u>with multiple
@@ -1249,7 +2329,13 @@ Experiment<Modus>::Experiment(Configuration &config,
    *      - using \b "ASCII" as format, the \ref doxypage_output_thermodyn
    *        "standard thermodynamics output" is produced;
    *      - using \b "Lattice_ASCII", the \ref doxypage_output_thermodyn_lattice
-   *        "quantities on a lattice" are printed out.
+   *        "quantities on a lattice" are printed out. The same quantities are
+   *        written by \b "Lattice_Binary" and, if SMASH was built with HDF5,
+   *        by \b "Lattice_HDF5" to binary files.
+   *   - For `"Spectra"` content the \ref doxypage_output_spectra
+   *     "histograms of the final particles" are printed out.
+   *   - For `"Performance"` content the \ref doxypage_output_performance
+   *     "statistics of every event" are printed out as lines of JSON.
    * - \b "Binary" - a binary, not human-readable list of values.
    *   - The \ref doxypage_output_binary "binary output" is faster to read and
    *     write than text outputs and all floating point numbers are printed with
@@ -1273,6 +2359,11 @@ Experiment<Modus>::Experiment(Configuration &config,
    *   <a href="http://root.cern.ch">the ROOT software</a>
    *   - Even faster to read and write, requires less disk space
    *   - Format description: \ref doxypage_output_root
+   * - \b "Parquet" - columnar binary output in the
+   *   <a href="https://parquet.apache.org">Apache Parquet</a> format, only for
+   *   the `"Particles"` content
+   *   - Reading a few quantities does not require to read the whole file
+   *   - Format description: \ref doxypage_output_parquet
    * - \b "VTK" - text output suitable for an easy visualization using
    *   third-party software
    *   - There are many different programs that can open a VTK file, although
@@ -1284,6 +2375,10 @@ Experiment<Modus>::Experiment(Configuration &config,
    *     href=https://reference.wolfram.com/language/ref/format/VTK.html>Mathematica</a>.
    *   - For "Particles" content \ref doxypage_output_vtk
    *   - For "Thermodynamics" content \ref doxypage_output_vtk_lattice
+   * - \b "VTK_Binary" - the quantities of the \b "VTK" format in XML VTK files
+   *   with raw binary arrays, which are faster to write and read
+   *   - The lattice arrays can be compressed, see
+   *     \ref key_output_thermo_compression_level_ "Compression_Level".
    * - \b "HepMC_asciiv3", \b "HepMC_treeroot" - HepMC3 human-readble asciiv3 or
    *   Tree ROOT format see \ref doxypage_output_hepmc for details
    * - \b "YODA", \b "YODA-full" - compact ASCII text format used by the
@@ -1403,6 +2498,28 @@ Experiment<Modus>::Experiment(Configuration &config,
    * \n Custom particle quantities are also available; their usage is described
    * in \ref doxypage_output_binary.
    *
+   * With a positive \ref key_output_IC_slab_width_ "Slab_Width", the removed
+   * particles are collected in slabs of the computational frame time
+   * \f$[k w, (k+1) w)\f$, where \f$w\f$ is the slab width. Every slab is
+   * written as one 'p' block with the header above, once a particle crosses
+   * the hypersurface in a later slab, an intermediate output is written after
+   * its end or the event ends. Each written slab is announced in the file
+   * \c SMASH_IC_<quantities>.bin.slabs next to the output, which starts with
+   * \code
+   * 4*char        uint16_t       double
+   * magic_number, index_version, slab_width
+   * \endcode
+   * where the magic number reads "SMSL" and the index version is currently 1.
+   * It is followed by one record per slab:
+   * \code
+   * int32_t      int32_t         uint32_t     double     double   uint64_t uint64_t
+   * event_number ensemble_number n_part_lines slab_begin slab_end offset   size
+   * \endcode
+   * The block of the slab is found in the \c size bytes starting at byte
+   * \c offset of the output. A record is only written once its block is
+   * flushed to disk, such that a running hydrodynamics code can poll the index
+   * and read the completed slabs while SMASH continues.
+   *
    * <h3> ROOT output </h3>
    * The initial conditions output in shape of a list of all particles removed
    * from the SMASH evolution with a \c "Constant_Tau" fluidization criterion
@@ -1442,6 +2559,16 @@ Experiment<Modus>::Experiment(Configuration &config,
   dens_type_ = config.take(InputKeys::output_densityType);
   logg[LExperiment].debug()
       << "Density type printed to headers: " << dens_type_;
+  const bool asynchronous_writing =
+      config.take(InputKeys::output_asynchronousWriting);
+  const bool sharded_writing = config.take(InputKeys::output_shardedWriting);
+  std::optional<int> root_compression = std::nullopt;
+  if (config.has_value(InputKeys::output_rootCompression)) {
+    root_compression = config.take(InputKeys::output_rootCompression);
+  }
+  const int root_basket_size = config.take(InputKeys::output_rootBasketSize);
+  const int root_auto_flush = config.take(InputKeys::output_rootAutoFlush);
+  const int root_threads = config.take(InputKeys::output_rootThreads);
 
   /* Parse configuration about output contents and formats, doing all logical
    * checks about specified formats, creating all needed output objects. Note
@@ -1486,7 +2613,11 @@ Experiment<Modus>::Experiment(Configuration &config,
   auto abort_because_of_invalid_input_file = []() {
     throw std::invalid_argument("Invalid configuration input file.");
   };
-  const OutputParameters output_parameters(std::move(output_conf));
+  OutputParameters output_parameters(std::move(output_conf));
+  output_parameters.root_compression = root_compression;
+  output_parameters.root_basket_size = root_basket_size;
+  output_parameters.root_auto_flush = root_auto_flush;
+  output_parameters.root_threads = root_threads;
   for (std::size_t i = 0; i < output_contents.size(); ++i) {
     if (output_contents[i] == "Particles" ||
         output_contents[i] == "Collisions" ||
@@ -1501,8 +2632,9 @@ Experiment<Modus>::Experiment(Configuration &config,
       };
       const bool custom_ascii_requested = formats_contains("ASCII");
       const bool custom_binary_requested = formats_contains("Binary");
-      const bool custom_requested =
-          custom_ascii_requested || custom_binary_requested;
+      const bool custom_requested = custom_ascii_requested ||
+                                    custom_binary_requested ||
+                                    formats_contains("Parquet");
       const bool oscar2013_requested = formats_contains("Oscar2013");
       const bool oscar2013_bin_requested = formats_contains("Oscar2013_bin");
       const bool is_extended = (output_contents[i] == "Particles")
@@ -1516,9 +2648,9 @@ Experiment<Modus>::Experiment(Configuration &config,
           default_quantities;
       if (quantities_given_nonempty != custom_requested) {
         logg[LExperiment].fatal()
-            << "Non-empty \"Quantities\" and \"ASCII\"/\"Binary\" format have "
-            << "not been specified both for " << std::quoted(output_contents[i])
-            << " in config file.";
+            << "Non-empty \"Quantities\" and \"ASCII\"/\"Binary\"/\"Parquet\" "
+            << "format have not been specified both for "
+            << std::quoted(output_contents[i]) << " in config file.";
         abort_because_of_invalid_input_file();
       }
       if (custom_ascii_requested && oscar2013_requested &&
@@ -1583,9 +2715,48 @@ Experiment<Modus>::Experiment(Configuration &config,
   /* Repeat loop over output_contents here to create all outputs after having
    * validated all content specifications. This is more user-friendly. */
   std::size_t total_number_of_requested_formats = 0;
+  // The workers are created one after the other, the primary writes shard 0
+  const bool concurrent_events = primary || !worker_configuration.empty();
+  const int shard =
+      primary ? static_cast<int>(primary->event_workers_.size()) + 1 : 0;
   for (std::size_t i = 0; i < output_contents.size(); ++i) {
     for (const auto &format : list_of_formats[i]) {
-      create_output(format, output_contents[i], output_path, output_parameters);
+      const bool is_shard =
+          sharded_writing && concurrent_events &&
+          (format == "Binary" || format == "Oscar2013_bin") &&
+          (output_contents[i] == "Particles" ||
+           output_contents[i] == "Collisions" ||
+           output_contents[i] == "Dileptons" ||
+           output_contents[i] == "Photons");
+      output_sections_.push_back(profiler_.section(
+          output_contents[i] + " output (" + format + ")"));
+      if (output_contents[i] == "Performance") {
+        // The times of the phases are part of the statistics
+        write_event_statistics_ = true;
+        profiler_.enable();
+      }
+      if (primary && !is_shard) {
+        // Workers pass everything to the outputs of the primary experiment
+        outputs_.emplace_back(std::make_unique<BufferedOutput>(
+            *primary->outputs_[total_number_of_requested_formats]));
+      } else {
+        create_output(format, output_contents[i], output_path,
+                      output_parameters, is_shard ? shard : -1);
+        const bool is_hepmc = format == "HepMC" || format == "HepMC_asciiv3" ||
+                              format == "HepMC_treeroot";
+        const OutputFilterParameters *filter = nullptr;
+        if (output_contents[i] == "Particles") {
+          filter = &output_parameters.part_filter;
+        } else if (output_contents[i] == "Collisions") {
+          filter = &output_parameters.coll_filter;
+        }
+        // HepMC events need the complete list of particles
+        if (filter && filter->is_active() && !is_hepmc &&
+            outputs_.size() == total_number_of_requested_formats + 1) {
+          outputs_.back() = std::make_unique<FilteredOutput>(
+              std::move(outputs_.back()), output_contents[i], *filter);
+        }
+      }
       ++total_number_of_requested_formats;
     }
   }
@@ -1596,6 +2767,18 @@ Experiment<Modus>::Experiment(Configuration &config,
     abort_because_of_invalid_input_file();
   }
 
+  // Workers write to the outputs of the primary experiment, which are
+  // asynchronous already
+  if (asynchronous_writing && !primary && !outputs_.empty()) {
+    logg[LExperiment].info("Writing the outputs on a separate thread.");
+    output_writer_ = std::make_unique<OutputWriter>();
+    for (auto &output : outputs_) {
+      output =
+          std::make_unique<AsyncOutput>(std::move(output), *output_writer_);
+    }
+  }
+  subscribe_outputs();
+
   /* We can take away the Fermi motion flag, because the collider modus is
    * already initialized. We only need it when potentials are enabled, but we
    * always have to take it, otherwise SMASH will complain about unused
@@ -1765,6 +2948,47 @@ Experiment<Modus>::Experiment(Configuration &config,
           "need to set \"Automatic: False\".");
     }
     bool periodic = config.take(InputKeys::lattice_periodic, modus_.is_box());
+    const int n_lattice_threads = config.take(InputKeys::lattice_threads);
+    if (n_lattice_threads < 1) {
+      throw std::invalid_argument(
+          "The number of lattice threads must be positive.");
+    }
+    if (n_lattice_threads > 1) {
+      logg[LExperiment].info("Smearing onto the lattices with ",
+                             n_lattice_threads, " threads.");
+      lattice_thread_pool_ =
+          std::make_unique<ThreadPool>(n_lattice_threads, pin_threads_);
+    }
+    lattice_resizing_interval_ =
+        config.take(InputKeys::lattice_resizingInterval);
+    if (lattice_resizing_interval_ < 0) {
+      throw std::invalid_argument(
+          "The resizing interval of the lattice must not be negative.");
+    }
+    if (lattice_resizing_interval_ > 0 &&
+        (periodic || printout_lattice_td_ || printout_full_lattice_any_td_ ||
+         parameters_.derivatives_mode == DerivativesMode::FiniteDifference ||
+         parameters_.field_derivatives_mode == FieldDerivativesMode::Direct)) {
+      throw std::invalid_argument(
+          "The lattice can only be resized if it is not periodic, not used "
+          "for thermodynamic lattice outputs and no derivatives are computed "
+          "by finite differences.");
+    }
+    const int incremental_update_interval =
+        config.take(InputKeys::lattice_incrementalUpdateInterval);
+    const double incremental_update_tolerance =
+        config.take(InputKeys::lattice_incrementalUpdateTolerance);
+    if (incremental_update_interval < 0 || incremental_update_tolerance < 0) {
+      throw std::invalid_argument(
+          "The interval and the tolerance of the incremental lattice updates "
+          "must not be negative.");
+    }
+    if (incremental_update_interval > 0) {
+      for (auto *smeared : {&smeared_B_, &smeared_I3_, &smeared_el_}) {
+        *smeared = std::make_unique<SmearedParticles>(
+            incremental_update_tolerance, incremental_update_interval);
+      }
+    }
     const auto [l, n, origin] = [&config, automatic, this]() {
       if (!automatic) {
         return std::make_tuple<std::array<double, 3>, std::array<int, 3>,
@@ -1841,6 +3065,11 @@ Experiment<Modus>::Experiment(Configuration &config,
       }
     }();
 
+    lattice_grid_origin_ = origin;
+    for (int i = 0; i < 3; i++) {
+      lattice_cell_sizes_[i] = l[i] / n[i];
+    }
+
     logg[LExperiment].info()
         << "Lattice is ON. Origin = (" << origin[0] << "," << origin[1] << ","
         << origin[2] << "), sizes = (" << l[0] << "," << l[1] << "," << l[2]
@@ -1976,12 +3205,154 @@ Experiment<Modus>::Experiment(Configuration &config,
   if (config.has_section(InputSections::forcedThermalization)) {
     Configuration th_conf = config.extract_complete_sub_configuration(
         InputSections::forcedThermalization);
-    thermalizer_ = modus_.create_grandcan_thermalizer(th_conf);
+    thermalizer_ = modus_.create_grandcan_thermalizer(
+        th_conf, lattice_thread_pool_.get());
+  }
+
+  if (!(particles_compaction_threshold_ > 0.)) {
+    throw std::invalid_argument(
+        "The compaction threshold of the particles must be positive.");
+  }
+  if (particles_reordering_interval_ < 0) {
+    throw std::invalid_argument(
+        "The reordering interval of the particles must not be negative.");
+  }
+  if (freeze_out_window_ < 0) {
+    throw std::invalid_argument("The freeze-out window must not be negative.");
+  }
+  const int n_task_threads = config.take(InputKeys::gen_threads);
+  if (n_task_threads < 1) {
+    throw std::invalid_argument("The number of threads must be positive.");
+  }
+  const bool ensemble_threads_given =
+      config.has_value(InputKeys::gen_ensembleThreads);
+  const int n_threads =
+      ensemble_threads_given
+          ? config.take(InputKeys::gen_ensembleThreads)
+          : std::min(n_task_threads, parameters_.n_ensembles);
+  if (n_threads < 1 || n_threads > parameters_.n_ensembles) {
+    throw std::invalid_argument(
+        "The number of ensemble threads must be positive and not larger than "
+        "the number of ensembles.");
+  }
+  const int n_grid_threads = config.take(InputKeys::gen_gridThreads);
+  if (n_grid_threads < 1) {
+    throw std::invalid_argument("The number of grid threads must be positive.");
+  }
+  if (n_threads > 1 && n_grid_threads > 1) {
+    throw std::invalid_argument(
+        "Ensemble and grid threads cannot be used at the same time.");
+  }
+  const int n_event_threads = config.take(InputKeys::gen_eventThreads);
+  if (n_event_threads < 1) {
+    throw std::invalid_argument(
+        "The number of event threads must be positive.");
+  }
+  if (pin_threads_ && n_event_threads > 1) {
+    throw std::invalid_argument(
+        "Threads cannot be pinned if events are simulated concurrently.");
+  }
+  longest_events_first_ = config.take(InputKeys::gen_longestEventsFirst);
+  if (n_threads > 1 || n_grid_threads > 1 || n_event_threads > 1) {
+    /* Compute all lazily cached properties of the particle types before any
+     * thread is started, such that they are only read afterwards. */
+    for (const ParticleType &type : ParticleType::list_all()) {
+      type.min_mass_spectral();
+      type.isospin();
+    }
+  }
+  grids_.resize(parameters_.n_ensembles);
+  if (n_grid_threads > 1) {
+    logg[LExperiment].info("Searching the grid cells with ", n_grid_threads,
+                           " threads.");
+    grid_thread_pool_ =
+        std::make_unique<ThreadPool>(n_grid_threads, pin_threads_);
+  }
+  if (n_threads > 1) {
+    logg[LExperiment].info("Evolving the ensembles with ", n_threads,
+                           " threads.");
+    thread_pool_ = std::make_unique<ThreadPool>(n_threads, pin_threads_);
+    if (process_string_ptr_ != NULL) {
+      // Strings of different ensembles are fragmented by separate instances
+      process_string_ptr_->set_concurrent(true);
+    }
+    ensemble_engines_.resize(parameters_.n_ensembles);
+    ensemble_counters_.resize(parameters_.n_ensembles);
+    ensemble_outputs_.resize(parameters_.n_ensembles);
+    for (OutputsList &buffers : ensemble_outputs_) {
+      for (const auto &output : outputs_) {
+        buffers.emplace_back(std::make_unique<BufferedOutput>(*output));
+      }
+    }
   }
 
   /* Take the seed setting only after the configuration was stored to a file
    * in smash.cc */
   seed_ = config.take(InputKeys::gen_randomseed);
+
+  /* The event workers are further experiments created from the same
+   * configuration. Only their outputs differ, which are buffers attached to
+   * the outputs of this experiment. */
+  if (n_event_threads > 1 && primary == nullptr) {
+    assert(!worker_configuration.empty());
+    if (event_counting_ != EventCounting::FixedNumber || modus_.is_list() ||
+        thermalizer_) {
+      throw std::invalid_argument(
+          "Events can only be simulated concurrently for a fixed number of "
+          "events, without List modus and without forced thermalization.");
+    }
+    {
+      // Custom nuclei are read from a file stream shared by all experiments
+      Configuration worker_config(worker_configuration.c_str());
+      const bool custom_nuclei =
+          worker_config.has_section(InputSections::m_c_p_custom) ||
+          worker_config.has_section(InputSections::m_c_t_custom);
+      worker_config.clear();
+      if (custom_nuclei) {
+        throw std::invalid_argument(
+            "Events cannot be simulated concurrently with custom nuclei.");
+      }
+    }
+    logg[LExperiment].info("Simulating events with ", n_event_threads,
+                           " threads.");
+    for (int i = 1; i < n_event_threads; i++) {
+      Configuration worker_config(worker_configuration.c_str());
+      event_workers_.emplace_back(
+          new Experiment(worker_config, output_path, this, ""));
+      // Values used outside of the experiment are not needed by the workers
+      worker_config.clear();
+    }
+    event_thread_pool_ = std::make_unique<ThreadPool>(n_event_threads);
+  }
+
+  if (checkpoint_interval_ > 0) {
+    const std::string reason = reason_against_checkpoints();
+    if (!reason.empty()) {
+      throw std::invalid_argument("No checkpoints can be written " + reason +
+                                  ".");
+    }
+  }
+  if (forks_per_event_ > 1) {
+    const std::string reason = reason_against_forks();
+    if (!reason.empty()) {
+      throw std::invalid_argument("Events cannot be forked " + reason + ".");
+    }
+    if (fork_time_ >= end_time_) {
+      throw std::invalid_argument("Fork_Time has to be before End_Time.");
+    }
+  }
+  if (prepare_next_event_) {
+    if (!modus_.is_box() && !modus_.is_sphere() && !modus_.is_list()) {
+      throw std::invalid_argument(
+          "The next event can only be prepared in the box, sphere and list "
+          "modi.");
+    }
+    if (event_thread_pool_) {
+      throw std::invalid_argument(
+          "The next event cannot be prepared with concurrent events.");
+    }
+    prepared_ensembles_ = std::vector<Particles>(parameters_.n_ensembles);
+  }
 }
 
 /// String representing a horizontal line.
@@ -2058,56 +3429,119 @@ EventInfo fill_event_info(const std::vector<Particles> &ensembles,
                           bool projectile_target_interact,
                           bool kinematic_cut_for_SMASH_IC);
 
+/**
+ * Draw the seed of the next event from the random number engine. It has to be
+ * positive, so it can be entered in the config.
+ *
+ * \return The seed of the next event.
+ */
+int64_t draw_seed_of_next_event();
+
 template <typename Modus>
 void Experiment<Modus>::initialize_new_event() {
-  random::set_seed(seed_);
+  if (next_event_.valid()) {
+    const PreparedEvent prepared = next_event_.get();
+    if (prepared.seed == seed_) {
+      initialize_event_with(
+          [this, &prepared]() {
+            for (std::size_t i = 0; i < ensembles_.size(); i++) {
+              ensembles_[i].copy_from(prepared_ensembles_[i]);
+            }
+            return prepared.start_time;
+          },
+          &prepared);
+      return;
+    }
+    // The seed was changed since, e.g. by a checkpoint
+  }
+  initialize_event_with([this]() {
+    double start_time = -1.0;
+    // Sample impact parameter only once per all ensembles
+    // It should be the same for all ensembles
+    if (modus_.is_collider()) {
+      modus_.sample_impact();
+      logg[LExperiment].info("Impact parameter = ", modus_.impact_parameter(),
+                             " fm");
+    }
+    for (Particles &particles : ensembles_) {
+      start_time = modus_.initial_conditions(&particles, parameters_);
+    }
+    return start_time;
+  });
+}
+
+template <typename Modus>
+void Experiment<Modus>::prepare_next_event() {
+  next_event_ = std::async(std::launch::async, [this, seed = seed_]() {
+    // The random numbers are drawn as in initialize_event_with
+    random::set_seed(seed);
+    PreparedEvent prepared{seed, draw_seed_of_next_event(), 0, 0.0, {}};
+    if (process_string_ptr_ != NULL) {
+      prepared.pythia_seed =
+          random::uniform_int(1, maximum_rndm_seed_in_pythia);
+    }
+    for (Particles &particles : prepared_ensembles_) {
+      particles.reset();
+      prepared.start_time = modus_.initial_conditions(&particles, parameters_);
+    }
+    prepared.engine = random::engine;
+    return prepared;
+  });
+}
+
+template <typename Modus>
+void Experiment<Modus>::initialize_event_with(
+    const std::function<double()> &fill_ensembles,
+    const PreparedEvent *prepared) {
+  profiler_.start_event();
+  memory_peak_ = {};
+  memory_measured_ = false;
+  fork_snapshot_.reset();
+  forks_left_ = 0;
+  event_seed_ = seed_;
   logg[LExperiment].info() << "random number seed: " << seed_;
-  /* Set seed for the next event. It has to be positive, so it can be entered
-   * in the config.
-   *
-   * We have to be careful about the minimal integer, whose absolute value
-   * cannot be represented. */
-  int64_t r = random::advance();
-  while (r == INT64_MIN) {
-    r = random::advance();
-  }
-  seed_ = std::abs(r);
-  /* Set the random seed used in PYTHIA hadronization
-   * to be same with the SMASH one.
-   * In this way we ensure that the results are reproducible
-   * for every event if one knows SMASH random seed. */
-  if (process_string_ptr_ != NULL) {
-    process_string_ptr_->init_pythia_hadron_rndm();
+  if (prepared) {
+    // The random numbers were drawn in the same order while preparing
+    random::engine = prepared->engine;
+    seed_ = prepared->next_seed;
+    if (process_string_ptr_ != NULL) {
+      process_string_ptr_->init_pythia_hadron_rndm(prepared->pythia_seed);
+    }
+  } else {
+    random::set_seed(seed_);
+    // Set seed for the next event
+    seed_ = draw_seed_of_next_event();
+    /* Set the random seed used in PYTHIA hadronization
+     * to be same with the SMASH one.
+     * In this way we ensure that the results are reproducible
+     * for every event if one knows SMASH random seed. */
+    if (process_string_ptr_ != NULL) {
+      process_string_ptr_->init_pythia_hadron_rndm();
+    }
   }
 
   for (Particles &particles : ensembles_) {
     particles.reset();
   }
 
-  // Sample particles according to the initial conditions
-  double start_time = -1.0;
-
-  // Sample impact parameter only once per all ensembles
-  // It should be the same for all ensembles
-  if (modus_.is_collider()) {
-    modus_.sample_impact();
-    logg[LExperiment].info("Impact parameter = ", modus_.impact_parameter(),
-                           " fm");
-  }
-  for (Particles &particles : ensembles_) {
-    start_time = modus_.initial_conditions(&particles, parameters_);
-  }
+  const double start_time = fill_ensembles();
   /* For box modus make sure that particles are in the box. In principle, after
    * a correct initialization they should be, so this is just playing it safe.
    */
   for (Particles &particles : ensembles_) {
     modus_.impose_boundary_conditions(&particles, outputs_);
   }
+  if (thread_pool_ && thread_pool_->pinned()) {
+    // Move each ensemble to the memory of the thread which evolves it
+    thread_pool_->parallel_for(
+        ensembles_.size(), [this](std::size_t i) { ensembles_[i].relocate(); });
+  }
   // Reset the simulation clock
   double timestep = delta_time_startup_;
 
   switch (time_step_mode_) {
     case TimeStepMode::Fixed:
+    case TimeStepMode::Adaptive:
       break;
     case TimeStepMode::None:
       timestep = end_time_ - start_time;
@@ -2128,6 +3562,14 @@ void Experiment<Modus>::initialize_new_event() {
   clock_for_this_event =
       std::make_unique<UniformClock>(start_time, timestep, end_time_);
   parameters_.labclock = std::move(clock_for_this_event);
+  previous_baryon_densities_.clear();
+  // The particles of the previous event are not on the lattices anymore
+  for (SmearedParticles *smeared :
+       {smeared_B_.get(), smeared_I3_.get(), smeared_el_.get()}) {
+    if (smeared) {
+      smeared->clear();
+    }
+  }
 
   // Reset the output clock
   parameters_.outputclock->reset(start_time, true);
@@ -2140,17 +3582,25 @@ void Experiment<Modus>::initialize_new_event() {
 
   /* Save the initial conserved quantum numbers and total momentum in
    * the system for conservation checks */
-  conserved_initial_ = QuantumNumbers(ensembles_);
-  wall_actions_total_ = 0;
+  recount_conserved_quantities();
+  conserved_initial_ = QuantumNumbers();
+  for (const QuantumNumbers &conserved : conserved_by_ensemble_) {
+    conserved_initial_ += conserved;
+  }
+  counters_ = {};
   previous_wall_actions_total_ = 0;
-  interactions_total_ = 0;
   previous_interactions_total_ = 0;
-  discarded_interactions_total_ = 0;
-  total_pauli_blocked_ = 0;
   projectile_target_interact_.assign(parameters_.n_ensembles, false);
-  total_hypersurface_crossing_actions_ = 0;
-  total_energy_removed_ = 0.0;
-  total_energy_violated_by_Pythia_ = 0.0;
+  process_ids_reserved_ = 0;
+  // The ids of the particles start anew in every event
+  for (DecayTimes &decay_times : decay_times_) {
+    decay_times.clear();
+  }
+  // Each concurrently evolved ensemble has its own random number stream
+  for (std::size_t i = 0; i < ensemble_engines_.size(); i++) {
+    ensemble_engines_[i] =
+        random::make_stream(event_seed_, random::StreamKind::Ensemble, i);
+  }
   // Print output headers
   logg[LExperiment].info() << hline;
   logg[LExperiment].info() << "Time[fm]   Ekin[GeV]   E_MF[GeV]  ETotal[GeV]  "
@@ -2162,12 +3612,17 @@ void Experiment<Modus>::initialize_new_event() {
     // update_potentials();
     // if (parameters.outputclock->current_time() == 0.0 )
     // using the lattice is necessary
+    if (lattice_resizing_interval_ > 0) {
+      resize_lattices();
+    }
     if ((jmu_B_lat_ != nullptr)) {
+      mean_field_energy_.reset();
       update_lattice(jmu_B_lat_.get(), old_jmu_auxiliary_.get(),
                      new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
                      LatticeUpdate::EveryTimestep, DensityType::Baryon,
                      density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+                     parameters_.labclock->timestep_duration(), true,
+                     lattice_thread_pool_.get());
       // Because there was no lattice at t=-Delta_t, the time derivatives
       // drho_dt and dj^mu/dt at t=0 are huge, while they shouldn't be; we
       // overwrite the time derivative to zero by hand.
@@ -2175,8 +3630,7 @@ void Experiment<Modus>::initialize_new_event() {
         node.overwrite_drho_dt_to_zero();
         node.overwrite_djmu_dt_to_zero();
       }
-      E_mean_field = calculate_mean_field_energy(*potentials_, *jmu_B_lat_,
-                                                 EM_lat_.get(), parameters_);
+      E_mean_field = mean_field_energy();
     }
   }
   initial_mean_field_energy_ = E_mean_field;
@@ -2186,7 +3640,34 @@ void Experiment<Modus>::initialize_new_event() {
       initial_mean_field_energy_);
 
   // Output at event start
-  for (const auto &output : outputs_) {
+  output_event_start(E_mean_field);
+
+  /* In the ColliderModus, if Fermi motion is frozen, assign the beam momenta
+   * to the nucleons in both the projectile and the target. Every ensemble
+   * gets the same beam momenta, so no need to create beam_momenta_ vector
+   * for every ensemble.
+   */
+  if (modus_.is_collider() && modus_.fermi_motion() == FermiMotion::Frozen) {
+    for (ParticleData &particle : ensembles_[0]) {
+      const double m = particle.effective_mass();
+      double v_beam = 0.0;
+      if (particle.belongs_to() == BelongsTo::Projectile) {
+        v_beam = modus_.velocity_projectile();
+      } else if (particle.belongs_to() == BelongsTo::Target) {
+        v_beam = modus_.velocity_target();
+      }
+      const double gamma = 1.0 / std::sqrt(1.0 - v_beam * v_beam);
+      beam_momentum_.emplace_back(
+          FourVector(gamma * m, 0.0, 0.0, gamma * v_beam * m));
+    }  // loop over particles
+  }
+}
+
+template <typename Modus>
+void Experiment<Modus>::output_event_start(double E_mean_field) {
+  for (const std::size_t i : event_outputs_) {
+    const auto &output = outputs_[i];
+    const auto measured = profiler_.measure(output_section(outputs_, output));
     for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
       auto event_info = fill_event_info(
           ensembles_, E_mean_field, modus_.impact_parameter(), parameters_,
@@ -2233,36 +3714,21 @@ void Experiment<Modus>::initialize_new_event() {
       }
     }
   }
-
-  /* In the ColliderModus, if Fermi motion is frozen, assign the beam momenta
-   * to the nucleons in both the projectile and the target. Every ensemble
-   * gets the same beam momenta, so no need to create beam_momenta_ vector
-   * for every ensemble.
-   */
-  if (modus_.is_collider() && modus_.fermi_motion() == FermiMotion::Frozen) {
-    for (ParticleData &particle : ensembles_[0]) {
-      const double m = particle.effective_mass();
-      double v_beam = 0.0;
-      if (particle.belongs_to() == BelongsTo::Projectile) {
-        v_beam = modus_.velocity_projectile();
-      } else if (particle.belongs_to() == BelongsTo::Target) {
-        v_beam = modus_.velocity_target();
-      }
-      const double gamma = 1.0 / std::sqrt(1.0 - v_beam * v_beam);
-      beam_momentum_.emplace_back(
-          FourVector(gamma * m, 0.0, 0.0, gamma * v_beam * m));
-    }  // loop over particles
-  }
 }
 
 template <typename Modus>
 bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
-                                       bool include_pauli_blocking) {
+                                       bool include_pauli_blocking,
+                                       bool final_state_generated) {
+  // The process type is only known for sure once the final state is chosen
+  Profiler::Scope measured(profiler_, process_section(action.get_type()),
+                           i_ensemble);
   Particles &particles = ensembles_[i_ensemble];
+  InteractionCounters &counters = counters_of(i_ensemble);
   auto &incoming = action.incoming_particles();
   // Make sure to skip invalid and Pauli-blocked actions.
   if (!action.is_valid(particles)) {
-    discarded_interactions_total_++;
+    counters.discarded_interactions_total++;
     logg[LExperiment].debug(~einhard::DRed(), "✘ ", action,
                             " (discarded: invalid)");
     return false;
@@ -2286,16 +3752,22 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
       }
     }
   }
-  try {
-    action.generate_final_state();
-  } catch (Action::StochasticBelowEnergyThreshold &) {
-    return false;
+  if (!final_state_generated) {
+    try {
+      action.generate_final_state();
+    } catch (Action::StochasticBelowEnergyThreshold &) {
+      return false;
+    }
   }
   logg[LExperiment].debug("Process Type is: ", action.get_type());
-  if (include_pauli_blocking && pauli_blocker_ &&
-      action.is_pauli_blocked(ensembles_, *pauli_blocker_)) {
-    total_pauli_blocked_++;
-    return false;
+  measured.reassign(process_section(action.get_type()));
+  if (include_pauli_blocking && pauli_blocker_) {
+    const auto pauli_measured =
+        profiler_.measure(profiled_phases_.pauli_blocking);
+    if (action.is_pauli_blocked(ensembles_, *pauli_blocker_)) {
+      counters.total_pauli_blocked++;
+      return false;
+    }
   }
 
   // Prepare projectile_target_interact_, it's used for output
@@ -2314,23 +3786,38 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
     }
   }
 
-  /* Make sure to pick a non-zero integer, because 0 is reserved for "no
-   * interaction yet". */
-  const auto id_process = static_cast<uint32_t>(interactions_total_ + 1);
+  const uint32_t id_process = next_process_id(i_ensemble);
   // we perform the action and collect possible energy violations by Pythia
-  total_energy_violated_by_Pythia_ += action.perform(&particles, id_process);
+  counters.total_energy_violated_by_Pythia +=
+      action.perform(&particles, id_process);
+  conserved_by_ensemble_[i_ensemble] +=
+      QuantumNumbers(action.outgoing_particles()) - QuantumNumbers(incoming);
+  if (pauli_blocker_) {
+    pauli_blocker_->add_to_index(action.outgoing_particles(), i_ensemble);
+  }
+  if (!neighbor_indices_.empty()) {
+    neighbor_indices_[i_ensemble].add(action.outgoing_particles());
+  }
 
-  interactions_total_++;
+  counters.interactions_total++;
+  counters.performed_by_type[static_cast<std::size_t>(action.get_type())]++;
   if (action.get_type() == ProcessType::Wall) {
-    wall_actions_total_++;
+    counters.wall_actions_total++;
   }
   if (action.get_type() == ProcessType::Fluidization) {
-    total_hypersurface_crossing_actions_++;
-    total_energy_removed_ += action.incoming_particles()[0].momentum().x0();
+    counters.total_hypersurface_crossing_actions++;
+    counters.total_energy_removed +=
+        action.incoming_particles()[0].momentum().x0();
   }
+  // The IC outputs receive only the fluidizations
+  const std::vector<std::size_t> &receivers =
+      action.get_type() == ProcessType::Fluidization ||
+              action.get_type() == ProcessType::FluidizationNoRemoval
+          ? fluidization_outputs_
+          : interaction_outputs_;
   // Calculate Eckart rest frame density at the interaction point
   double rho = 0.0;
-  if (dens_type_ != DensityType::None) {
+  if (dens_type_ != DensityType::None && !receivers.empty()) {
     const FourVector r_interaction = action.get_interaction_point();
     constexpr bool compute_grad = false;
     const bool smearing = true;
@@ -2355,15 +3842,19 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
    * their x coordinates would be 0.1 and 9.9 fm and interaction point
    * position could be either at 10 fm or at 5 fm.
    */
-  for (const auto &output : outputs_) {
-    if (output->is_dilepton_output() || output->is_photon_output()) {
-      continue;
-    }
-    if (output->is_IC_output()) {
-      if (action.get_type() == ProcessType::Fluidization ||
-          action.get_type() == ProcessType::FluidizationNoRemoval) {
-        output->at_interaction(action, rho);
+  /* The buffered and asynchronous outputs keep a copy of the action, which
+   * is made once for all of them. */
+  std::shared_ptr<const RecordedAction> recorded_action;
+  const OutputsList &outputs = outputs_of(i_ensemble);
+  for (const std::size_t i : receivers) {
+    const auto &output = outputs[i];
+    const auto output_measured =
+        profiler_.measure(output_section(outputs, output));
+    if (output->keeps_interactions()) {
+      if (!recorded_action) {
+        recorded_action = std::make_shared<const RecordedAction>(action);
       }
+      output->at_recorded_interaction(recorded_action, rho);
     } else {
       output->at_interaction(action, rho);
     }
@@ -2373,8 +3864,8 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
   // Note: We rely here on the lazy evaluation of the arguments to if.
   // It may happen that in a wall-crossing-action sqrt_s raises an exception.
   // Therefore we first have to check if the incoming particles can undergo
-  // an em-interaction.
-  if (photons_switch_ &&
+  // an em-interaction. Without a photon output, there is nothing to produce.
+  if (photons_switch_ && has_photon_output_ &&
       ScatterActionPhoton::is_photon_reaction(action.incoming_particles()) &&
       ScatterActionPhoton::is_kinematically_possible(
           action.sqrt_s(), action.incoming_particles())) {
@@ -2400,10 +3891,10 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
     // Now add the actual photon reaction channel.
     photon_act.add_single_process();
 
-    photon_act.perform_photons(outputs_);
+    photon_act.perform_photons(outputs_of(i_ensemble));
   }
 
-  if (bremsstrahlung_switch_ &&
+  if (bremsstrahlung_switch_ && has_photon_output_ &&
       BremsstrahlungAction::is_bremsstrahlung_reaction(
           action.incoming_particles())) {
     /* Time in the action constructor is relative to
@@ -2430,7 +3921,7 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
     // Now add the actual bremsstrahlung reaction channel.
     brems_act.add_single_process();
 
-    brems_act.perform_bremsstrahlung(outputs_);
+    brems_act.perform_bremsstrahlung(outputs_of(i_ensemble));
   }
 
   logg[LExperiment].debug(~einhard::Green(), "✔ ", action);
@@ -2449,6 +3940,67 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
  */
 void validate_and_adjust_particle_list(ParticleList &particle_list);
 
+/**
+ * Create the particles of the given records, see MemoryOutput::particle.
+ * Records with an unknown PDG code are skipped and the user warned.
+ *
+ * \param[in] records The records of the particles.
+ * \return The particles.
+ */
+ParticleList particles_from_records(const std::vector<ParticleRecord> &records);
+
+template <typename Modus>
+void Experiment<Modus>::initialize_new_event(ParticleList &&initial_particles) {
+  if (ensembles_.size() > 1) {
+    throw std::runtime_error(
+        "Starting an event with given particles is only possible when one "
+        "ensemble is used.");
+  }
+  if (!initial_particles.empty()) {
+    validate_and_adjust_particle_list(initial_particles);
+  }
+  if (next_event_.valid()) {
+    // The event prepared with the same seed is not needed
+    next_event_.wait();
+    next_event_ = {};
+  }
+  initialize_event_with([this, &initial_particles]() {
+    double start_time = 0.0;
+    if (initial_particles.empty()) {
+      return start_time;
+    }
+    start_time = std::numeric_limits<double>::max();
+    double latest_time = std::numeric_limits<double>::lowest();
+    for (const ParticleData &p : initial_particles) {
+      start_time = std::min(start_time, p.position().x0());
+      latest_time = std::max(latest_time, p.position().x0());
+      ensembles_[0].insert(p);
+    }
+    if (latest_time - start_time > really_small) {
+      backpropagate_straight_line(&ensembles_[0], start_time);
+    }
+    return start_time;
+  });
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_time_evolution(
+    const double t_end, const std::vector<ParticleRecord> &add_records,
+    const std::vector<ParticleRecord> &remove_records) {
+  run_time_evolution(t_end, particles_from_records(add_records),
+                     particles_from_records(remove_records));
+}
+
+template <typename Modus>
+void Experiment<Modus>::fill_particle_records(
+    std::vector<ParticleRecord> &records) const {
+  records.clear();
+  records.reserve(ensembles_[0].size());
+  for (const ParticleData &data : ensembles_[0]) {
+    records.push_back(MemoryOutput::record(data));
+  }
+}
+
 template <typename Modus>
 void Experiment<Modus>::run_time_evolution(const double t_end,
                                            ParticleList &&add_plist,
@@ -2478,14 +4030,24 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
     }
     if (!remove_plist.empty()) {
       ParticleList found_particles_to_remove;
+      found_particles_to_remove.reserve(remove_plist.size());
       for (const auto &particle_to_remove : remove_plist) {
+        const auto is_particle_to_remove =
+            [&particle_to_remove, &action_time](const ParticleData &p) {
+              return are_particles_identical_at_given_time(particle_to_remove,
+                                                           p, action_time);
+            };
+        /* Particles handed out by SMASH before keep their id, hence they are
+         * found in constant time. Other ones are searched in the ensemble. */
+        const ParticleData *particle_with_id =
+            ensembles_[0].find(particle_to_remove.id());
+        if (particle_with_id && is_particle_to_remove(*particle_with_id)) {
+          found_particles_to_remove.push_back(*particle_with_id);
+          continue;
+        }
         const auto iterator_to_particle_to_be_removed_in_ensemble =
-            std::find_if(
-                ensembles_[0].begin(), ensembles_[0].end(),
-                [&particle_to_remove, &action_time](const ParticleData &p) {
-                  return are_particles_identical_at_given_time(
-                      particle_to_remove, p, action_time);
-                });
+            std::find_if(ensembles_[0].begin(), ensembles_[0].end(),
+                         is_particle_to_remove);
         if (iterator_to_particle_to_be_removed_in_ensemble !=
             ensembles_[0].end())
           found_particles_to_remove.push_back(
@@ -2538,97 +4100,290 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
     throw std::logic_error(
         "Experiment cannot evolve the system beyond End_Time.");
   }
+  /* Number of time steps done in this call, to reorder the particles and to
+   * write checkpoints. A resumed event continues the count of the interrupted
+   * call. */
+  int timesteps = resumed_timesteps_.value_or(0);
+  const int first_timestep = timesteps;
+  resumed_timesteps_.reset();
+  /* With lazy wall crossings, the particles which have left the box are put
+   * back before they are written out or put on the grid. These wall crossings
+   * are not written to the collisions output. */
+  const auto put_particles_back_into_box = [this]() {
+    if (parameters_.lazy_wall_crossings) {
+      for (Particles &particles : ensembles_) {
+        modus_.impose_boundary_conditions(&particles);
+      }
+    }
+  };
+  /* Once the system has frozen out, the grid is no longer created and no
+   * actions are searched for, while the particles are still propagated, shone
+   * and written out in every time step as before. */
+  bool frozen = false;
+  int quiet_timesteps = 0;
+  int freeze_out_window = freeze_out_window_;
   while (*(parameters_.labclock) < t_end) {
     const double dt = parameters_.labclock->timestep_duration();
     logg[LExperiment].debug("Timestepless propagation for next ", dt, " fm.");
+    const uint64_t interactions_before_timestep =
+        counters_.interactions_total - counters_.wall_actions_total;
+
+    const bool checkpoint_due = checkpoint_interval_ > 0 &&
+                                timesteps > first_timestep &&
+                                timesteps % checkpoint_interval_ == 0;
+    if (take_checkpoint_request() || checkpoint_due) {
+      write_checkpoint(timesteps);
+    }
+    if (forks_per_event_ > 1 && !fork_snapshot_ &&
+        parameters_.labclock->current_time() >= fork_time_) {
+      // The following events continue from here, see start_fork()
+      save_event_state(fork_snapshot_.emplace(), timesteps);
+      forks_left_ = forks_per_event_ - 1;
+      logg[LExperiment].info("Snapshot for ", forks_left_,
+                             " forks taken at t = ",
+                             parameters_.labclock->current_time(), " fm");
+    }
+
+    /* Close the holes left by removed particles, if there are many of them,
+     * and reorder the particles periodically. No copies of particles are kept
+     * from the previous time step, hence no copy is invalidated by the new
+     * indices. */
+    const bool reorder = particles_reordering_interval_ > 0 &&
+                         timesteps % particles_reordering_interval_ == 0;
+    const bool resize_lattices_now =
+        lattice_resizing_interval_ > 0 &&
+        timesteps % lattice_resizing_interval_ == 0;
+    ++timesteps;
+    for (Particles &particles : ensembles_) {
+      if (reorder) {
+        particles.sort_along_morton_curve();
+      } else if (memory_is_short_) {
+        particles.shrink_to_fit();
+      } else if (particles.hole_fraction() > particles_compaction_threshold_) {
+        particles.compact();
+      }
+    }
 
     // Perform forced thermalization if required
     if (thermalizer_ &&
         thermalizer_->is_time_to_thermalize(parameters_.labclock)) {
+      const auto measured = profiler_.measure(profiled_phases_.thermalization);
       const bool ignore_cells_under_treshold = true;
       // Thermodynamics in thermalizer is computed from all ensembles,
       // but thermalization actions act on each ensemble independently
-      thermalizer_->update_thermalizer_lattice(ensembles_, density_param_,
-                                               ignore_cells_under_treshold);
+      thermalizer_->update_thermalizer_lattice(
+          ensembles_, density_param_, ignore_cells_under_treshold,
+          lattice_thread_pool_.get());
       const double current_t = parameters_.labclock->current_time();
-      for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-        thermalizer_->thermalize(ensembles_[i_ens], current_t,
-                                 parameters_.testparticles);
-        ThermalizationAction th_act(*thermalizer_, current_t);
-        if (th_act.any_particles_thermalized()) {
-          perform_action(th_act, i_ens);
-        }
-      }
+      /* The thermalizer is shared, hence the ensembles are treated serially,
+       * while every ensemble may use the lattice threads for the sampling */
+      constexpr bool concurrently = false;
+      for_each_ensemble(
+          [&](int i_ens) {
+            thermalizer_->thermalize(
+                ensembles_[i_ens], current_t, parameters_.testparticles,
+                SpinInteractionType::Off, lattice_thread_pool_.get());
+            ThermalizationAction th_act(*thermalizer_, current_t);
+            if (th_act.any_particles_thermalized()) {
+              perform_action(th_act, i_ens);
+            }
+          },
+          concurrently);
     }
 
     if (IC_dynamic_) {
+      const auto measured =
+          profiler_.measure(profiled_phases_.fluidization_lattice);
       modus_.build_fluidization_lattice(parameters_.labclock->current_time(),
                                         ensembles_, density_param_);
     }
 
     std::vector<Actions> actions(parameters_.n_ensembles);
-    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-      actions[i_ens].clear();
-      if (ensembles_[i_ens].size() > 0 && action_finders_.size() > 0) {
+    const auto find_actions = [&](int i_ens) {
+      actions[i_ens] = Actions(action_queue_);
+      if (!frozen && ensembles_[i_ens].size() > 0 &&
+          action_finders_.size() > 0) {
         /* (1.a) Create grid. */
-        const double min_cell_length = compute_min_cell_length(dt);
+        const double min_cell_length =
+            compute_min_cell_length(dt, &ensembles_[i_ens]);
         logg[LExperiment].debug("Creating grid with minimal cell length ",
                                 min_cell_length);
         /* For the hyper-surface-crossing actions also unformed particles are
          * searched and therefore needed on the grid. */
         const bool include_unformed_particles = IC_switch_;
-        const auto &grid =
-            use_grid_ ? modus_.create_grid(ensembles_[i_ens], min_cell_length,
-                                           dt, parameters_.coll_crit,
-                                           include_unformed_particles)
-                      : modus_.create_grid(ensembles_[i_ens], min_cell_length,
-                                           dt, parameters_.coll_crit,
-                                           include_unformed_particles,
-                                           CellSizeStrategy::Largest);
+        const CellSizeStrategy strategy =
+            use_grid_ ? CellSizeStrategy::Optimal : CellSizeStrategy::Largest;
+        std::optional<EnsembleGrid> &stored_grid = grids_[i_ens];
+        {
+          const auto measured =
+              profiler_.measure(profiled_phases_.grid, i_ens);
+          if (stored_grid) {
+            modus_.update_grid(*stored_grid, ensembles_[i_ens],
+                               min_cell_length, dt, parameters_.coll_crit,
+                               include_unformed_particles, strategy);
+          } else {
+            stored_grid.emplace(modus_.create_grid(
+                ensembles_[i_ens], min_cell_length, dt, parameters_.coll_crit,
+                include_unformed_particles, strategy));
+          }
+        }
+        const EnsembleGrid &grid = *stored_grid;
+        counters_of(i_ens).grid_particles += ensembles_[i_ens].size();
+        counters_of(i_ens).grid_cells += grid.number_of_cells();
 
-        const double gcell_vol = grid.cell_volume();
         /* (1.b) Iterate over cells and find actions. */
-        grid.iterate_cells(
-            [&](const ParticleList &search_list) {
-              for (const auto &finder : action_finders_) {
-                actions[i_ens].insert(finder->find_actions_in_cell(
-                    search_list, dt, gcell_vol, beam_momentum_));
-              }
-            },
-            [&](const ParticleList &search_list,
-                const ParticleList &neighbors_list) {
-              for (const auto &finder : action_finders_) {
-                actions[i_ens].insert(finder->find_actions_with_neighbors(
-                    search_list, neighbors_list, dt, beam_momentum_));
-              }
-            });
+        if (grid_thread_pool_) {
+          find_actions_in_rows_concurrently(grid, dt, actions[i_ens]);
+          return;
+        }
+        DecayTimes *decay_times =
+            decay_times_.empty() ? nullptr : &decay_times_[i_ens];
+        if (decay_times) {
+          decay_times->forget_before(parameters_.labclock->current_time());
+        }
+        const DecayTimes::Scoped ensemble_decay_times(decay_times);
+        const double gcell_vol = grid.cell_volume();
+        /* The cells are searched in tiles of adjacent rows, whose particles
+         * and the kinematics stored by the finders fit into the L2 cache
+         * together. */
+        constexpr std::size_t tile_particles = 2048;
+        // The queue is set up once all actions of the time step are known
+        ActionList found;
+        std::vector<std::vector<ActionList>> found_by_finder(
+            action_finders_.size());
+        grid.iterate_tiles(tile_particles, [&](const CellTile &tile) {
+          for (std::size_t f = 0; f < action_finders_.size(); f++) {
+            const auto &finder = action_finders_[f];
+            const auto measured = profiler_.measure(finder_section(finder));
+            found_by_finder[f].clear();
+            found_by_finder[f].resize(tile.visits.size());
+            finder->find_actions_in_tile(tile, dt, gcell_vol, beam_momentum_,
+                                         found_by_finder[f]);
+          }
+          // Keep the order of the search cell by cell
+          for (std::size_t i = 0; i < tile.visits.size(); i++) {
+            for (std::vector<ActionList> &by_visit : found_by_finder) {
+              found += std::move(by_visit[i]);
+            }
+          }
+        });
+        actions[i_ens] = Actions(std::move(found), action_queue_);
       }
-    }
-
-    /* \todo (optimizations) Adapt timestep size here */
+    };
 
-    /* (2) Propagate from action to action until next output or timestep end */
+    /* The collision partners of outgoing particles are looked for in the
+     * adjacent cells only. Cells as large as the ones of the grid guarantee
+     * that every possible partner is found, if the displacement of the
+     * particles during the timestep is added. */
     const double end_timestep_time = parameters_.labclock->next_time();
-    while (next_output_time() < end_timestep_time) {
+    const bool use_neighbor_indices =
+        use_grid_ && parameters_.coll_crit != CollisionCriterion::Stochastic &&
+        !frozen;
+    const double neighbor_cell_length =
+        compute_min_cell_length(dt) +
+        std::max(end_timestep_time - parameters_.labclock->current_time(), 0.0);
+    if (use_neighbor_indices) {
+      neighbor_indices_.resize(parameters_.n_ensembles);
+    }
+    const auto build_neighbor_index = [&](int i_ens) {
+      neighbor_indices_[i_ens].build(
+          ensembles_[i_ens], neighbor_cell_length,
+          parameters_.lazy_wall_crossings ? parameters_.box_length : 0.);
+    };
+
+    /* (2) Propagate from action to action until next output or timestep end.
+     *     Pauli blocking needs all ensembles, which prevents evolving them
+     *     concurrently. */
+    const bool concurrently = !pauli_blocker_;
+    /* If nothing needs all ensembles before the end of the time step, every
+     * ensemble is propagated as soon as its own actions are found. */
+    const bool chain_ensembles =
+        thread_pool_ && concurrently &&
+        !(write_event_statistics_ || memory_limit_ > 0) &&
+        !(next_output_time() < end_timestep_time);
+    if (chain_ensembles) {
+      TaskGraph graph;
       for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-        run_time_evolution_timestepless(actions[i_ens], i_ens,
-                                        next_output_time());
+        // Whichever thread evolves the ensemble, it uses the ensemble's engine
+        const auto in_ensemble = [this, i_ens](auto &&task) {
+          return [this, i_ens, task]() {
+            const random::ScopedEngine ensemble_engine(
+                ensemble_engines_[i_ens]);
+            task(i_ens);
+          };
+        };
+        std::vector<TaskGraph::TaskId> found{
+            graph.add(in_ensemble(find_actions))};
+        if (use_neighbor_indices) {
+          // No random numbers are drawn, while the actions may be searched
+          found.push_back(
+              graph.add([&, i_ens]() { build_neighbor_index(i_ens); }));
+        }
+        graph.add(in_ensemble([&](int i) {
+                    run_time_evolution_timestepless(actions[i], i,
+                                                    end_timestep_time);
+                  }),
+                  found);
       }
-      ++(*parameters_.outputclock);
+      graph.run(thread_pool_.get());
+      merge_ensemble_results();
+    } else {
+      for_each_ensemble(find_actions);
+      if (pauli_blocker_ && !frozen) {
+        const auto measured =
+            profiler_.measure(profiled_phases_.pauli_blocking);
+        pauli_blocker_->update_index(
+            ensembles_,
+            end_timestep_time - parameters_.labclock->current_time());
+      }
+      if (use_neighbor_indices) {
+        for_each_ensemble(build_neighbor_index);
+      }
+      if (write_event_statistics_ || memory_limit_ > 0) {
+        measure_memory(actions);
+      }
+      while (next_output_time() < end_timestep_time) {
+        const double output_time = next_output_time();
+        for_each_ensemble(
+            [&](int i_ens) {
+              run_time_evolution_timestepless(actions[i_ens], i_ens,
+                                              output_time);
+            },
+            concurrently);
+        ++(*parameters_.outputclock);
 
-      intermediate_output();
+        put_particles_back_into_box();
+        intermediate_output();
+      }
+      for_each_ensemble(
+          [&](int i_ens) {
+            run_time_evolution_timestepless(actions[i_ens], i_ens,
+                                            end_timestep_time);
+          },
+          concurrently);
     }
-    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-      run_time_evolution_timestepless(actions[i_ens], i_ens, end_timestep_time);
+    put_particles_back_into_box();
+    if (pauli_blocker_) {
+      pauli_blocker_->clear_index();
     }
+    neighbor_indices_.clear();
 
     /* (3) Update potentials (if computed on the lattice) and
      *     compute new momenta according to equations of motion */
+    double min_time_scale = std::numeric_limits<double>::infinity();
     if (potentials_) {
-      update_potentials();
-      update_momenta(ensembles_, parameters_.labclock->timestep_duration(),
-                     *potentials_, FB_lat_.get(), FI3_lat_.get(), EM_lat_.get(),
-                     jmu_B_lat_.get());
+      if (resize_lattices_now) {
+        resize_lattices();
+      }
+      {
+        const auto measured = profiler_.measure(profiled_phases_.potentials);
+        update_potentials();
+      }
+      const auto measured = profiler_.measure(profiled_phases_.momenta);
+      min_time_scale = update_momenta(
+          ensembles_, parameters_.labclock->timestep_duration(), *potentials_,
+          FB_lat_.get(), FI3_lat_.get(), EM_lat_.get(), jmu_B_lat_.get(),
+          lattice_thread_pool_.get());
     }
 
     /* (4) Expand universe if non-minkowskian metric; updates
@@ -2640,6 +4395,13 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
     }
 
     ++(*parameters_.labclock);
+    if (adaptive_timestep_) {
+      adapt_timestep(dt,
+                     counters_.interactions_total -
+                         counters_.wall_actions_total -
+                         interactions_before_timestep,
+                     min_time_scale);
+    }
 
     /* (5) Check conservation laws.
      *
@@ -2647,12 +4409,26 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
      * fragmentation are off.  If potentials are on then momentum is conserved
      * only in average.  If string fragmentation is on, then energy and
      * momentum are only very roughly conserved in high-energy collisions. */
-    if (!potentials_ && !parameters_.strings_switch &&
-        metric_.mode_ == ExpansionMode::NoExpansion && !IC_switch_) {
-      std::string err_msg = conserved_initial_.report_deviations(ensembles_);
-      if (!err_msg.empty()) {
-        logg[LExperiment].error() << err_msg;
-        throw std::runtime_error("Violation of conserved quantities!");
+    constexpr bool recount = false;
+    check_conservation_laws(recount);
+
+    /* (6) Stop searching for actions once the system has frozen out. If it has
+     *     not, although nothing happened, wait twice as long before the next
+     *     check. */
+    if (freeze_out_window_ > 0 && !frozen) {
+      const bool quiet = counters_.interactions_total -
+                             counters_.wall_actions_total ==
+                         interactions_before_timestep;
+      quiet_timesteps = quiet ? quiet_timesteps + 1 : 0;
+      if (quiet_timesteps >= freeze_out_window) {
+        frozen = frozen_out();
+        if (frozen) {
+          logg[LExperiment].info("Frozen out at t = ",
+                                 parameters_.labclock->current_time(), " fm");
+        } else {
+          quiet_timesteps = 0;
+          freeze_out_window *= 2;
+        }
       }
     }
   }
@@ -2669,23 +4445,43 @@ void Experiment<Modus>::run_time_evolution(const double t_end,
 
   if (pauli_blocker_) {
     logg[LExperiment].info(
-        "Interactions: Pauli-blocked/performed = ", total_pauli_blocked_, "/",
-        interactions_total_ - wall_actions_total_);
+        "Interactions: Pauli-blocked/performed = ",
+        counters_.total_pauli_blocked, "/",
+        counters_.interactions_total - counters_.wall_actions_total);
   }
 }
 
 template <typename Modus>
-void Experiment<Modus>::propagate_and_shine(double to_time,
-                                            Particles &particles) {
+void Experiment<Modus>::propagate_and_shine(double to_time, int i_ensemble) {
+  const auto measured =
+      profiler_.measure(profiled_phases_.propagation, i_ensemble);
+  Particles &particles = ensembles_[i_ensemble];
   const double dt =
       propagate_straight_line(&particles, to_time, beam_momentum_);
   if (dilepton_finder_ != nullptr) {
-    for (const auto &output : outputs_) {
+    for (const auto &output : outputs_of(i_ensemble)) {
       dilepton_finder_->shine(particles, output.get(), dt);
     }
   }
 }
 
+template <typename Modus>
+void Experiment<Modus>::propagate_and_shine(const ParticleData &p,
+                                            double to_time, int i_ensemble) {
+  Particles &particles = ensembles_[i_ensemble];
+  ParticleData current = particles.lookup(p);
+  if (current.position().x0() >= to_time) {
+    return;
+  }
+  const double dt = propagate_straight_line(&current, to_time, beam_momentum_);
+  particles.update_particle(p, current);
+  if (dilepton_finder_ != nullptr) {
+    for (const auto &output : outputs_of(i_ensemble)) {
+      dilepton_finder_->shine(current, output.get(), dt);
+    }
+  }
+}
+
 /**
  * Make sure `interactions_total` can be represented as a 32-bit integer.
  * This is necessary for converting to a `id_process`. The latter is 32-bit
@@ -2700,13 +4496,140 @@ inline void check_interactions_total(uint64_t interactions_total) {
   }
 }
 
+template <typename Modus>
+uint32_t Experiment<Modus>::next_process_id(int i_ensemble) {
+  /* Make sure to pick a non-zero integer, because 0 is reserved for "no
+   * interaction yet". */
+  uint64_t ids_used = counters_.interactions_total;
+  if (thread_pool_) {
+    ids_used = process_ids_reserved_ +
+               ensemble_counters_[i_ensemble].interactions_total *
+                   parameters_.n_ensembles +
+               i_ensemble;
+  }
+  check_interactions_total(ids_used);
+  return static_cast<uint32_t>(ids_used + 1);
+}
+
+template <typename Modus>
+void Experiment<Modus>::for_each_ensemble(const std::function<void(int)> &task,
+                                          bool concurrently) {
+  if (thread_pool_ && concurrently) {
+    thread_pool_->parallel_for(ensembles_.size(), [&](std::size_t i) {
+      // Whichever thread evolves the ensemble, it uses the ensemble's engine
+      const random::ScopedEngine ensemble_engine(ensemble_engines_[i]);
+      task(static_cast<int>(i));
+    });
+  } else {
+    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
+      task(i_ens);
+    }
+  }
+  merge_ensemble_results();
+}
+
+template <typename Modus>
+void Experiment<Modus>::merge_ensemble_results() {
+  if (!thread_pool_) {
+    return;
+  }
+  // Merge the results of the ensembles in a fixed order
+  uint64_t max_interactions = 0;
+  for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
+    for (const auto &output : ensemble_outputs_[i_ens]) {
+      static_cast<BufferedOutput &>(*output).flush();
+    }
+    InteractionCounters &counters = ensemble_counters_[i_ens];
+    max_interactions = std::max(max_interactions, counters.interactions_total);
+    counters_ += counters;
+    counters = {};
+  }
+  process_ids_reserved_ += max_interactions * parameters_.n_ensembles;
+}
+
+template <typename Modus>
+template <typename GridType>
+void Experiment<Modus>::find_actions_in_rows_concurrently(
+    const GridType &grid, double dt, Actions &actions) {
+  const double gcell_vol = grid.cell_volume();
+  std::vector<ActionList> actions_in_row(grid.number_of_rows());
+  const random::Engine::result_type seed = random::advance();
+  grid_thread_pool_->parallel_for(actions_in_row.size(), [&](std::size_t row) {
+    // Whichever thread searches the row, it uses the same random numbers
+    random::Engine row_stream =
+        random::make_stream(seed, random::StreamKind::GridRow, row);
+    const random::ScopedEngine row_engine(row_stream);
+    ActionList &found = actions_in_row[row];
+    grid.iterate_cells_in_row(
+        row,
+        [&](ParticleSpan search_list) {
+          for (const auto &finder : action_finders_) {
+            const auto measured = profiler_.measure(finder_section(finder));
+            found += finder->find_actions_in_cell(search_list, dt, gcell_vol,
+                                                  beam_momentum_);
+          }
+        },
+        [&](ParticleSpan search_list, ParticleSpan neighbors_list) {
+          for (const auto &finder : action_finders_) {
+            const auto measured = profiler_.measure(finder_section(finder));
+            found += finder->find_actions_with_neighbors(
+                search_list, neighbors_list, dt, beam_momentum_);
+          }
+        });
+  });
+  ActionList all_found;
+  for (ActionList &found : actions_in_row) {
+    all_found += std::move(found);
+  }
+  actions = Actions(std::move(all_found), action_queue_);
+}
+
+template <typename Modus>
+void Experiment<Modus>::perform_final_actions_concurrently(Actions &actions,
+                                                           int i_ensemble) {
+  std::vector<ActionPtr> ordered;
+  ordered.reserve(actions.size());
+  while (!actions.is_empty()) {
+    ordered.push_back(actions.pop());
+  }
+  // Not a std::vector<bool>, since it is written concurrently
+  std::vector<char> generated(ordered.size(), false);
+  const random::Engine::result_type seed = random::advance();
+  grid_thread_pool_->parallel_for(ordered.size(), [&](std::size_t i) {
+    // Whichever thread generates the final state, it uses the same numbers
+    random::Engine action_stream =
+        random::make_stream(seed, random::StreamKind::FinalAction, i);
+    const random::ScopedEngine action_engine(action_stream);
+    try {
+      ordered[i]->generate_final_state();
+      generated[i] = true;
+    } catch (Action::StochasticBelowEnergyThreshold &) {
+    }
+  });
+  for (std::size_t i = 0; i < ordered.size(); i++) {
+    if (generated[i]) {
+      perform_action(*ordered[i], i_ensemble, false, true);
+    }
+  }
+}
+
 template <typename Modus>
 void Experiment<Modus>::run_time_evolution_timestepless(
     Actions &actions, int i_ensemble, const double end_time_propagation) {
+  const auto evolution_measured = profiler_.measure(
+      profiled_phases_.timestepless_propagation, i_ensemble);
   Particles &particles = ensembles_[i_ensemble];
   logg[LExperiment].debug(
       "Timestepless propagation: ", "Actions size = ", actions.size(),
       ", end time = ", end_time_propagation);
+  /* Only the particles involved in an action are propagated to its time, if
+   * the collision partners of its outgoing particles are known from the
+   * neighbor index and no other positions are needed before the end. */
+  const bool lazy = lazy_propagation_ && !neighbor_indices_.empty() &&
+                    !pauli_blocker_ && dens_type_ == DensityType::None;
+  // The decay times of the outgoing particles are remembered
+  const DecayTimes::Scoped ensemble_decay_times(
+      decay_times_.empty() ? nullptr : &decay_times_[i_ensemble]);
 
   // iterate over all actions
   while (!actions.is_empty()) {
@@ -2716,7 +4639,7 @@ void Experiment<Modus>::run_time_evolution_timestepless(
     // get next action
     ActionPtr act = actions.pop();
     if (!act->is_valid(particles)) {
-      discarded_interactions_total_++;
+      counters_of(i_ensemble).discarded_interactions_total++;
       logg[LExperiment].debug(~einhard::DRed(), "✘ ", act,
                               " (discarded: invalid)");
       continue;
@@ -2724,8 +4647,16 @@ void Experiment<Modus>::run_time_evolution_timestepless(
     logg[LExperiment].debug(~einhard::Green(), "✔ ", act,
                             ", action time = ", act->time_of_execution());
 
-    /* (1) Propagate to the next action. */
-    propagate_and_shine(act->time_of_execution(), particles);
+    /* (1) Propagate to the next action, lazily only its incoming particles. */
+    if (lazy) {
+      const auto measured =
+          profiler_.measure(profiled_phases_.propagation, i_ensemble);
+      for (const ParticleData &p : act->incoming_particles()) {
+        propagate_and_shine(p, act->time_of_execution(), i_ensemble);
+      }
+    } else {
+      propagate_and_shine(act->time_of_execution(), i_ensemble);
+    }
 
     /* (2) Perform action.
      *
@@ -2741,38 +4672,180 @@ void Experiment<Modus>::run_time_evolution_timestepless(
       continue;
     }
 
+    /* Actions which have become invalid are removed right away, instead of
+     * being discarded when they are reached. */
+    counters_of(i_ensemble).discarded_interactions_total +=
+        actions.invalidate(act->incoming_particles(), particles);
+    if (memory_is_short_) {
+      actions.shrink();
+    }
+
     /* (3) Update actions for newly-produced particles. */
 
     const double end_time_timestep = parameters_.labclock->next_time();
     // New actions are always search until the end of the current timestep
     const double time_left = end_time_timestep - act->time_of_execution();
     const ParticleList &outgoing_particles = act->outgoing_particles();
+    // Only the neighbors of the outgoing particles can collide with them
+    const bool use_index = !neighbor_indices_.empty();
+    const std::vector<const ParticleData *> neighbors =
+        use_index ? neighbor_indices_[i_ensemble].neighbors(particles,
+                                                            outgoing_particles)
+                  : std::vector<const ParticleData *>{};
+    if (lazy) {
+      // The collision times are found from the positions at the same time
+      const auto measured =
+          profiler_.measure(profiled_phases_.propagation, i_ensemble);
+      for (const ParticleData *neighbor : neighbors) {
+        propagate_and_shine(*neighbor, act->time_of_execution(), i_ensemble);
+      }
+    }
     // Grid cell volume set to zero, since there is no grid
     const double gcell_vol = 0.0;
     for (const auto &finder : action_finders_) {
+      const auto measured = profiler_.measure(finder_section(finder));
       // Outgoing particles can still decay, cross walls...
       actions.insert(finder->find_actions_in_cell(outgoing_particles, time_left,
                                                   gcell_vol, beam_momentum_));
       // ... and collide with other particles.
-      actions.insert(finder->find_actions_with_surrounding_particles(
-          outgoing_particles, particles, time_left, beam_momentum_));
+      actions.insert(
+          use_index ? finder->find_actions_with_surrounding_particles(
+                          outgoing_particles, neighbors, time_left,
+                          beam_momentum_)
+                    : finder->find_actions_with_surrounding_particles(
+                          outgoing_particles, particles, time_left,
+                          beam_momentum_));
+    }
+  }
+
+  InteractionCounters &counters = counters_of(i_ensemble);
+  counters.max_queued_actions =
+      std::max<uint64_t>(counters.max_queued_actions, actions.peak_occupancy());
+  if (lazy && dilepton_finder_ != nullptr) {
+    // Every particle shines for the time since it was propagated last
+    const auto measured =
+        profiler_.measure(profiled_phases_.propagation, i_ensemble);
+    for (const ParticleData &p : particles) {
+      propagate_and_shine(p, end_time_propagation, i_ensemble);
+    }
+  } else {
+    propagate_and_shine(end_time_propagation, i_ensemble);
+  }
+}
+
+template <typename Modus>
+void Experiment<Modus>::adapt_timestep(double timestep, uint64_t n_interactions,
+                                       double min_time_scale) {
+  TimeStepObservation observed;
+  observed.n_interactions = n_interactions;
+  for (const Particles &particles : ensembles_) {
+    observed.n_particles += particles.size();
+  }
+  observed.min_time_scale = min_time_scale;
+  /* The density on the lattice is only known at the end of every time step if
+   * it is updated for the potentials */
+  if (potentials_ && jmu_B_lat_) {
+    const std::size_t n_nodes = jmu_B_lat_->size();
+    if (previous_baryon_densities_.size() == n_nodes) {
+      double max_density = 0.0, max_change = 0.0;
+      for (std::size_t i = 0; i < n_nodes; i++) {
+        const double density = (*jmu_B_lat_)[i].rho();
+        max_density = std::max(max_density, std::abs(density));
+        max_change = std::max(
+            max_change, std::abs(density - previous_baryon_densities_[i]));
+      }
+      if (max_density > really_small) {
+        observed.relative_density_change = max_change / max_density;
+      }
     }
+    previous_baryon_densities_.resize(n_nodes);
+    for (std::size_t i = 0; i < n_nodes; i++) {
+      previous_baryon_densities_[i] = (*jmu_B_lat_)[i].rho();
+    }
+  }
+  const double next_timestep =
+      adaptive_timestep_->next_timestep(timestep, observed);
+  logg[LExperiment].debug("Adaptive time step: ", observed.n_interactions,
+                          " interactions, relative density change ",
+                          observed.relative_density_change,
+                          ", next time step ", next_timestep, " fm.");
+  static_cast<UniformClock &>(*parameters_.labclock)
+      .set_timestep_duration(next_timestep);
+}
 
-    check_interactions_total(interactions_total_);
+template <typename Modus>
+void Experiment<Modus>::recount_conserved_quantities() {
+  conserved_by_ensemble_.clear();
+  conserved_by_ensemble_.reserve(ensembles_.size());
+  for (const Particles &particles : ensembles_) {
+    conserved_by_ensemble_.emplace_back(particles);
   }
+}
 
-  propagate_and_shine(end_time_propagation, particles);
+template <typename Modus>
+void Experiment<Modus>::check_conservation_laws(bool recount) {
+  if (potentials_ || parameters_.strings_switch ||
+      metric_.mode_ != ExpansionMode::NoExpansion || IC_switch_) {
+    return;
+  }
+  if (recount) {
+    recount_conserved_quantities();
+  }
+  QuantumNumbers conserved_now;
+  for (const QuantumNumbers &conserved : conserved_by_ensemble_) {
+    conserved_now += conserved;
+  }
+  const std::string err_msg =
+      conserved_initial_.report_deviations(conserved_now);
+  if (!err_msg.empty()) {
+    logg[LExperiment].error() << err_msg;
+    throw std::runtime_error("Violation of conserved quantities!");
+  }
+}
+
+template <typename Modus>
+bool Experiment<Modus>::frozen_out() const {
+  // The following events have to continue from the snapshot at the fork time
+  const bool fork_pending = forks_per_event_ > 1 && !fork_snapshot_;
+  if (potentials_ || metric_.mode_ != ExpansionMode::NoExpansion ||
+      modus_.is_box() || thermalizer_ || IC_switch_ || fork_pending ||
+      parameters_.coll_crit == CollisionCriterion::Stochastic) {
+    return false;
+  }
+  const double dt = parameters_.labclock->timestep_duration();
+  for (const Particles &particles : ensembles_) {
+    for (const ParticleData &p : particles) {
+      if (!p.type().is_stable()) {
+        return false;
+      }
+    }
+    if (!scatter_finder_) {
+      continue;
+    }
+    /* Straight lines approach each other at a fixed time, hence the time
+     * until the closest approach of receding particles stays negative. */
+    const ParticleList list = particles.copy_to_vector();
+    for (auto p1 = list.begin(); p1 != list.end(); ++p1) {
+      for (auto p2 = std::next(p1); p2 != list.end(); ++p2) {
+        if (scatter_finder_->collision_time(*p1, *p2, dt, beam_momentum_) >=
+            0.) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
 }
 
 template <typename Modus>
 void Experiment<Modus>::intermediate_output() {
   const uint64_t wall_actions_this_interval =
-      wall_actions_total_ - previous_wall_actions_total_;
-  previous_wall_actions_total_ = wall_actions_total_;
-  const uint64_t interactions_this_interval = interactions_total_ -
+      counters_.wall_actions_total - previous_wall_actions_total_;
+  previous_wall_actions_total_ = counters_.wall_actions_total;
+  const uint64_t interactions_this_interval = counters_.interactions_total -
                                               previous_interactions_total_ -
                                               wall_actions_this_interval;
-  previous_interactions_total_ = interactions_total_;
+  previous_interactions_total_ = counters_.interactions_total;
   double E_mean_field = 0.0;
   /// Auxiliary variable to communicate the time in the computational frame
   /// at the functions printing the thermodynamics lattice output
@@ -2780,8 +4853,7 @@ void Experiment<Modus>::intermediate_output() {
   if (potentials_) {
     // using the lattice is necessary
     if ((jmu_B_lat_ != nullptr)) {
-      E_mean_field = calculate_mean_field_energy(*potentials_, *jmu_B_lat_,
-                                                 EM_lat_.get(), parameters_);
+      E_mean_field = mean_field_energy();
       /*
        * Mean field calculated in a box should remain approximately constant if
        * the system is in equilibrium, and so deviations from its original value
@@ -2816,16 +4888,46 @@ void Experiment<Modus>::intermediate_output() {
       ensembles_, interactions_this_interval, conserved_initial_, time_start_,
       parameters_.outputclock->current_time(), E_mean_field,
       initial_mean_field_energy_);
+  // Verify the conserved quantities kept up to date by the actions
+  constexpr bool recount = true;
+  check_conservation_laws(recount);
   const LatticeUpdate lat_upd = LatticeUpdate::AtOutput;
 
   // save evolution data
   if (!(modus_.is_box() && parameters_.outputclock->current_time() <
                                modus_.equilibration_time())) {
-    for (const auto &output : outputs_) {
-      if (output->is_dilepton_output() || output->is_photon_output() ||
-          output->is_IC_output()) {
-        continue;
+    /* The lattices of the thermodynamic outputs are filled once for all
+     * outputs. The lattices of the potentials are updated at every time step
+     * and not again here. */
+    if (printout_rho_eckart_) {
+      switch (dens_type_lattice_printout_) {
+        case DensityType::Baryon:
+          update_lattice_accumulating_ensembles(
+              jmu_B_lat_.get(), lat_upd, DensityType::Baryon, density_param_,
+              ensembles_, false, lattice_thread_pool_.get());
+          mean_field_energy_.reset();
+          break;
+        case DensityType::BaryonicIsospin:
+          update_lattice_accumulating_ensembles(
+              jmu_I3_lat_.get(), lat_upd, DensityType::BaryonicIsospin,
+              density_param_, ensembles_, false, lattice_thread_pool_.get());
+          break;
+        case DensityType::None:
+          break;
+        default:
+          update_lattice_accumulating_ensembles(
+              jmu_custom_lat_.get(), lat_upd, dens_type_lattice_printout_,
+              density_param_, ensembles_, false, lattice_thread_pool_.get());
       }
+    }
+    if (printout_tmn_ || printout_tmn_landau_ || printout_v_landau_) {
+      update_lattice_accumulating_ensembles(
+          Tmn_.get(), lat_upd, dens_type_lattice_printout_, density_param_,
+          ensembles_, false, lattice_thread_pool_.get());
+    }
+    for (const std::size_t i : intermediate_time_outputs_) {
+      const auto &output = outputs_[i];
+      const auto measured = profiler_.measure(output_section(outputs_, output));
       for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
         auto event_info = fill_event_info(
             ensembles_, E_mean_field, modus_.impact_parameter(), parameters_,
@@ -2844,18 +4946,12 @@ void Experiment<Modus>::intermediate_output() {
       if (printout_rho_eckart_) {
         switch (dens_type_lattice_printout_) {
           case DensityType::Baryon:
-            update_lattice_accumulating_ensembles(
-                jmu_B_lat_.get(), lat_upd, DensityType::Baryon, density_param_,
-                ensembles_, false);
             output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                           DensityType::Baryon, *jmu_B_lat_);
             output->thermodynamics_lattice_output(*jmu_B_lat_,
                                                   computational_frame_time);
             break;
           case DensityType::BaryonicIsospin:
-            update_lattice_accumulating_ensembles(
-                jmu_I3_lat_.get(), lat_upd, DensityType::BaryonicIsospin,
-                density_param_, ensembles_, false);
             output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                           DensityType::BaryonicIsospin,
                                           *jmu_I3_lat_);
@@ -2865,9 +4961,6 @@ void Experiment<Modus>::intermediate_output() {
           case DensityType::None:
             break;
           default:
-            update_lattice_accumulating_ensembles(
-                jmu_custom_lat_.get(), lat_upd, dens_type_lattice_printout_,
-                density_param_, ensembles_, false);
             output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                           dens_type_lattice_printout_,
                                           *jmu_custom_lat_);
@@ -2876,9 +4969,6 @@ void Experiment<Modus>::intermediate_output() {
         }
       }
       if (printout_tmn_ || printout_tmn_landau_ || printout_v_landau_) {
-        update_lattice_accumulating_ensembles(
-            Tmn_.get(), lat_upd, dens_type_lattice_printout_, density_param_,
-            ensembles_, false);
         if (printout_tmn_) {
           output->thermodynamics_output(ThermodynamicQuantity::Tmn,
                                         dens_type_lattice_printout_, *Tmn_);
@@ -2915,23 +5005,134 @@ void Experiment<Modus>::intermediate_output() {
   }
 }
 
+template <typename Modus>
+void Experiment<Modus>::resize_lattices() {
+  std::array<double, 3> min_position, max_position;
+  bool found_particles = false;
+  for (const Particles &particles : ensembles_) {
+    if (particles.size() == 0) {
+      continue;
+    }
+    const auto [ensemble_min, ensemble_length] =
+        GridBase::find_min_and_length(particles);
+    for (int i = 0; i < 3; i++) {
+      const double ensemble_max = ensemble_min[i] + ensemble_length[i];
+      min_position[i] = found_particles
+                            ? std::min(min_position[i], ensemble_min[i])
+                            : ensemble_min[i];
+      max_position[i] = found_particles
+                            ? std::max(max_position[i], ensemble_max)
+                            : ensemble_max;
+    }
+    found_particles = true;
+  }
+  if (!found_particles) {
+    return;
+  }
+  /* The lattice has to hold the whole smeared particles until it is resized
+   * again, while they move at most with the speed of light */
+  double smearing_range = *std::max_element(lattice_cell_sizes_.begin(),
+                                            lattice_cell_sizes_.end());
+  if (parameters_.smearing_mode == SmearingMode::CovariantGaussian) {
+    smearing_range = density_param_.r_cut();
+  } else if (parameters_.smearing_mode == SmearingMode::Triangular) {
+    smearing_range *= parameters_.triangular_range;
+  }
+  const double margin =
+      smearing_range +
+      lattice_resizing_interval_ * parameters_.labclock->timestep_duration();
+  std::array<double, 3> origin, length;
+  std::array<int, 3> n_cells;
+  for (int i = 0; i < 3; i++) {
+    const double cell = lattice_cell_sizes_[i];
+    // Shift by whole cells to keep the cell centers at the same positions
+    const double first_cell = std::floor(
+        (min_position[i] - margin - lattice_grid_origin_[i]) / cell);
+    origin[i] = lattice_grid_origin_[i] + first_cell * cell;
+    n_cells[i] = std::max(
+        1, numeric_cast<int>(
+               std::ceil((max_position[i] + margin - origin[i]) / cell)));
+    length[i] = n_cells[i] * cell;
+  }
+  logg[LExperiment].debug("Lattices resized: origin = (", origin[0], ",",
+                          origin[1], ",", origin[2], "), cells = (", n_cells[0],
+                          ",", n_cells[1], ",", n_cells[2], ")");
+  auto resize = [&](auto &lattice) {
+    if (lattice) {
+      lattice->reset_and_resize(length, origin, n_cells);
+    }
+  };
+  mean_field_energy_.reset();
+  resize(jmu_B_lat_);
+  resize(jmu_I3_lat_);
+  resize(jmu_el_lat_);
+  resize(UB_lat_);
+  resize(UI3_lat_);
+  resize(FB_lat_);
+  resize(FI3_lat_);
+  resize(EM_lat_);
+  resize(old_jmu_auxiliary_);
+  resize(new_jmu_auxiliary_);
+  resize(four_gradient_auxiliary_);
+  // The densities of the previous time step were on other nodes
+  previous_baryon_densities_.clear();
+  for (SmearedParticles *smeared :
+       {smeared_B_.get(), smeared_I3_.get(), smeared_el_.get()}) {
+    if (smeared) {
+      smeared->clear();
+    }
+  }
+}
+
+template <typename Modus>
+double Experiment<Modus>::mean_field_energy() {
+  if (!mean_field_energy_) {
+    mean_field_energy_ = calculate_mean_field_energy(
+        *potentials_, *jmu_B_lat_, EM_lat_.get(), parameters_);
+  }
+  return *mean_field_energy_;
+}
+
 template <typename Modus>
 void Experiment<Modus>::update_potentials() {
   if (potentials_) {
-    if (potentials_->use_symmetry() && jmu_I3_lat_ != nullptr) {
+    mean_field_energy_.reset();
+    const bool update_I3 =
+        potentials_->use_symmetry() && jmu_I3_lat_ != nullptr;
+    const bool update_B =
+        (potentials_->use_skyrme() || potentials_->use_symmetry()) &&
+        jmu_B_lat_ != nullptr;
+    if (update_I3 && update_B) {
+      // Both lattices are updated in a single pass over the particles
+      const auto measured = profiler_.measure(profiled_phases_.smearing);
+      update_lattices({jmu_I3_lat_.get(), jmu_B_lat_.get()},
+                      old_jmu_auxiliary_.get(), new_jmu_auxiliary_.get(),
+                      four_gradient_auxiliary_.get(),
+                      LatticeUpdate::EveryTimestep,
+                      {DensityType::BaryonicIsospin, DensityType::Baryon},
+                      density_param_, ensembles_,
+                      parameters_.labclock->timestep_duration(), true,
+                      lattice_thread_pool_.get(),
+                      {smeared_I3_.get(), smeared_B_.get()});
+    } else if (update_I3) {
+      const auto measured = profiler_.measure(profiled_phases_.smearing);
       update_lattice(jmu_I3_lat_.get(), old_jmu_auxiliary_.get(),
                      new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
                      LatticeUpdate::EveryTimestep, DensityType::BaryonicIsospin,
                      density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+                     parameters_.labclock->timestep_duration(), true,
+                     lattice_thread_pool_.get(), smeared_I3_.get());
     }
-    if ((potentials_->use_skyrme() || potentials_->use_symmetry()) &&
-        jmu_B_lat_ != nullptr) {
-      update_lattice(jmu_B_lat_.get(), old_jmu_auxiliary_.get(),
-                     new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
-                     LatticeUpdate::EveryTimestep, DensityType::Baryon,
-                     density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+    if (update_B) {
+      if (!update_I3) {
+        const auto measured = profiler_.measure(profiled_phases_.smearing);
+        update_lattice(jmu_B_lat_.get(), old_jmu_auxiliary_.get(),
+                       new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
+                       LatticeUpdate::EveryTimestep, DensityType::Baryon,
+                       density_param_, ensembles_,
+                       parameters_.labclock->timestep_duration(), true,
+                       lattice_thread_pool_.get(), smeared_B_.get());
+      }
       const size_t UBlattice_size = UB_lat_->size();
       for (size_t i = 0; i < UBlattice_size; i++) {
         auto jB = (*jmu_B_lat_)[i];
@@ -2965,10 +5166,14 @@ void Experiment<Modus>::update_potentials() {
       }
     }
     if (potentials_->use_coulomb()) {
-      update_lattice_accumulating_ensembles(
-          jmu_el_lat_.get(), LatticeUpdate::EveryTimestep, DensityType::Charge,
-          density_param_, ensembles_, true);
-      for (size_t i = 0; i < EM_lat_->size(); i++) {
+      {
+        const auto measured = profiler_.measure(profiled_phases_.smearing);
+        update_lattice_accumulating_ensembles(
+            jmu_el_lat_.get(), LatticeUpdate::EveryTimestep,
+            DensityType::Charge, density_param_, ensembles_, true,
+            lattice_thread_pool_.get(), smeared_el_.get());
+      }
+      auto compute_fields = [this](size_t i) {
         ThreeVector electric_field = {0., 0., 0.};
         ThreeVector position = jmu_el_lat_->cell_center(i);
         jmu_el_lat_->integrate_volume(electric_field,
@@ -2979,14 +5184,35 @@ void Experiment<Modus>::update_potentials() {
                                       Potentials::B_field_integrand,
                                       potentials_->coulomb_r_cut(), position);
         (*EM_lat_)[i] = std::make_pair(electric_field, magnetic_field);
+      };
+      const size_t n_nodes = EM_lat_->size();
+      if (lattice_thread_pool_ == nullptr || lattice_thread_pool_->size() < 2) {
+        for (size_t i = 0; i < n_nodes; i++) {
+          compute_fields(i);
+        }
+      } else {
+        /* The integrals only read the charge lattice and every node of the
+         * field lattice is written by one thread, hence the fields are the
+         * same as in the serial loop. */
+        const size_t n_chunks = lattice_thread_pool_->size();
+        lattice_thread_pool_->parallel_for(n_chunks, [&](size_t chunk) {
+          for (size_t i = chunk * n_nodes / n_chunks;
+               i < (chunk + 1) * n_nodes / n_chunks; i++) {
+            compute_fields(i);
+          }
+        });
       }
     }  // if ((potentials_->use_skyrme() || ...
     if (potentials_->use_vdf() && jmu_B_lat_ != nullptr) {
-      update_lattice(jmu_B_lat_.get(), old_jmu_auxiliary_.get(),
-                     new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
-                     LatticeUpdate::EveryTimestep, DensityType::Baryon,
-                     density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+      {
+        const auto measured = profiler_.measure(profiled_phases_.smearing);
+        update_lattice(jmu_B_lat_.get(), old_jmu_auxiliary_.get(),
+                       new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
+                       LatticeUpdate::EveryTimestep, DensityType::Baryon,
+                       density_param_, ensembles_,
+                       parameters_.labclock->timestep_duration(), true,
+                       lattice_thread_pool_.get(), smeared_B_.get());
+      }
       if (parameters_.field_derivatives_mode == FieldDerivativesMode::Direct) {
         update_fields_lattice(
             fields_lat_.get(), old_fields_auxiliary_.get(),
@@ -3024,12 +5250,14 @@ void Experiment<Modus>::do_final_interactions() {
   uint64_t interactions_old;
   do {
     actions_found = false;
-    interactions_old = interactions_total_;
-    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-      Actions actions;
+    interactions_old = counters_.interactions_total;
+    // Not a std::vector<bool>, since it might be written concurrently
+    std::vector<char> actions_found_in_ensemble(parameters_.n_ensembles, false);
+    for_each_ensemble([&](int i_ens) {
+      Actions actions(action_queue_);
       // Dileptons: shining of remaining resonances
       if (dilepton_finder_ != nullptr) {
-        for (const auto &output : outputs_) {
+        for (const auto &output : outputs_of(i_ens)) {
           dilepton_finder_->shine_final(ensembles_[i_ens], output.get(), true);
         }
       }
@@ -3038,15 +5266,21 @@ void Experiment<Modus>::do_final_interactions() {
         auto found_actions = finder->find_final_actions(ensembles_[i_ens]);
         if (!found_actions.empty()) {
           actions.insert(std::move(found_actions));
-          actions_found = true;
+          actions_found_in_ensemble[i_ens] = true;
         }
       }
       // Perform actions.
+      if (grid_thread_pool_ && actions.size() > 1) {
+        perform_final_actions_concurrently(actions, i_ens);
+      }
       while (!actions.is_empty()) {
         perform_action(*actions.pop(), i_ens, false);
       }
-    }
-    actions_performed = interactions_total_ > interactions_old;
+    });
+    actions_found = std::any_of(actions_found_in_ensemble.begin(),
+                                actions_found_in_ensemble.end(),
+                                [](char found) { return found != 0; });
+    actions_performed = counters_.interactions_total > interactions_old;
     // Throw an error if actions were found but not performed
     if (actions_found && !actions_performed) {
       throw std::runtime_error("Final actions were found but not performed.");
@@ -3072,15 +5306,14 @@ void Experiment<Modus>::final_output() {
   double E_mean_field = 0.0;
   if (likely(parameters_.labclock > 0)) {
     const uint64_t wall_actions_this_interval =
-        wall_actions_total_ - previous_wall_actions_total_;
-    const uint64_t interactions_this_interval = interactions_total_ -
+        counters_.wall_actions_total - previous_wall_actions_total_;
+    const uint64_t interactions_this_interval = counters_.interactions_total -
                                                 previous_interactions_total_ -
                                                 wall_actions_this_interval;
     if (potentials_) {
       // using the lattice is necessary
       if ((jmu_B_lat_ != nullptr)) {
-        E_mean_field = calculate_mean_field_energy(*potentials_, *jmu_B_lat_,
-                                                   EM_lat_.get(), parameters_);
+        E_mean_field = mean_field_energy();
       }
     }
     if (std::abs(parameters_.labclock->current_time() - end_time_) >
@@ -3100,9 +5333,11 @@ void Experiment<Modus>::final_output() {
     }
     if (IC_switch_ && (total_particles == 0)) {
       const double initial_system_energy_plus_Pythia_violations =
-          conserved_initial_.momentum().x0() + total_energy_violated_by_Pythia_;
+          conserved_initial_.momentum().x0() +
+          counters_.total_energy_violated_by_Pythia;
       const double fraction_of_total_system_energy_removed =
-          initial_system_energy_plus_Pythia_violations / total_energy_removed_;
+          initial_system_energy_plus_Pythia_violations /
+          counters_.total_energy_removed;
       // Verify there is no more energy in the system if all particles were
       // removed when crossing the hypersurface
       if (std::fabs(fraction_of_total_system_energy_removed - 1.) >
@@ -3112,7 +5347,7 @@ void Experiment<Modus>::final_output() {
             "were removed.\n"
             "E_remain = " +
             std::to_string((initial_system_energy_plus_Pythia_violations -
-                            total_energy_removed_)) +
+                            counters_.total_energy_removed)) +
             " [GeV]");
       } else {
         logg[LExperiment].info() << hline;
@@ -3120,28 +5355,32 @@ void Experiment<Modus>::final_output() {
             << "Time real: " << SystemClock::now() - time_start_;
         logg[LExperiment].info()
             << "Interactions before reaching hypersurface: "
-            << interactions_total_ - wall_actions_total_ -
-                   total_hypersurface_crossing_actions_;
+            << counters_.interactions_total - counters_.wall_actions_total -
+                   counters_.total_hypersurface_crossing_actions;
         logg[LExperiment].info()
             << "Total number of particles removed on hypersurface: "
-            << total_hypersurface_crossing_actions_;
+            << counters_.total_hypersurface_crossing_actions;
       }
     } else {
       const double precent_discarded =
-          interactions_total_ > 0
-              ? static_cast<double>(discarded_interactions_total_) * 100.0 /
-                    interactions_total_
+          counters_.interactions_total > 0
+              ? static_cast<double>(counters_.discarded_interactions_total) *
+                    100.0 / counters_.interactions_total
               : 0.0;
       std::stringstream msg_discarded;
       msg_discarded
-          << "Discarded interaction number: " << discarded_interactions_total_
-          << " (" << precent_discarded
+          << "Discarded interaction number: "
+          << counters_.discarded_interactions_total << " ("
+          << precent_discarded
           << "% of the total interaction number including wall crossings)";
 
       logg[LExperiment].info() << hline;
       logg[LExperiment].info()
           << "Time real: " << SystemClock::now() - time_start_;
       logg[LExperiment].debug() << msg_discarded.str();
+      logg[LExperiment].debug()
+          << "Maximal number of queued actions: "
+          << counters_.max_queued_actions;
 
       if (parameters_.coll_crit == CollisionCriterion::Stochastic &&
           precent_discarded > 1.0) {
@@ -3154,8 +5393,9 @@ void Experiment<Modus>::final_output() {
                "reducing the timestep size.";
       }
 
-      logg[LExperiment].info() << "Final interaction number: "
-                               << interactions_total_ - wall_actions_total_;
+      logg[LExperiment].info()
+          << "Final interaction number: "
+          << counters_.interactions_total - counters_.wall_actions_total;
     }
 
     // Check if there are unformed particles
@@ -3177,7 +5417,9 @@ void Experiment<Modus>::final_output() {
   // Keep track of how many ensembles had interactions
   count_nonempty_ensembles();
 
-  for (const auto &output : outputs_) {
+  for (const std::size_t i : event_outputs_) {
+    const auto &output = outputs_[i];
+    const auto measured = profiler_.measure(output_section(outputs_, output));
     for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
       auto event_info = fill_event_info(
           ensembles_, E_mean_field, modus_.impact_parameter(), parameters_,
@@ -3206,6 +5448,120 @@ void Experiment<Modus>::final_output() {
       output->at_eventend(ThermodynamicQuantity::j_QBS);
     }
   }
+
+  if (write_event_statistics_) {
+    const EventStatistics statistics = event_statistics();
+    for (const std::size_t i : event_outputs_) {
+      outputs_[i]->event_statistics_output(event_, statistics);
+    }
+  }
+}
+
+template <typename Modus>
+EventStatistics Experiment<Modus>::event_statistics() const {
+  EventStatistics statistics;
+  statistics.wall_time = profiler_.event_wall_time();
+  // The soft string processes share a section of the profile
+  std::set<Profiler::Section> string_sections;
+  for (std::size_t i = 0; i < InteractionCounters::n_process_types; i++) {
+    const uint64_t performed = counters_.performed_by_type[i];
+    if (performed == 0) {
+      continue;
+    }
+    const ProcessType type = static_cast<ProcessType>(i);
+    statistics.performed.emplace_back(type, performed);
+    if (is_string_soft_process(type) || type == ProcessType::StringHard) {
+      statistics.strings += performed;
+      string_sections.insert(process_section(type));
+    }
+  }
+  for (const Profiler::Section section : string_sections) {
+    statistics.string_time += profiler_.event_time(section);
+  }
+  statistics.discarded = counters_.discarded_interactions_total;
+  statistics.pauli_blocked = counters_.total_pauli_blocked;
+  if (counters_.grid_cells > 0) {
+    statistics.mean_cell_occupancy =
+        static_cast<double>(counters_.grid_particles) / counters_.grid_cells;
+  }
+  statistics.max_queued_actions = counters_.max_queued_actions;
+  statistics.phases = profiler_.event_totals();
+  if (memory_measured_) {
+    for (std::size_t i = 0; i < n_memory_subsystems; i++) {
+      statistics.memory.push_back(
+          {memory_subsystems_[i], memory_current_[i], memory_peak_[i]});
+    }
+  }
+  return statistics;
+}
+
+template <typename Modus>
+void Experiment<Modus>::measure_memory(const std::vector<Actions> &actions) {
+  std::array<std::size_t, n_memory_subsystems> bytes{};
+  for (const Particles &particles : ensembles_) {
+    bytes[0] += particles.memory_usage();
+  }
+  for (const Actions &queue : actions) {
+    bytes[1] += queue.memory_usage();
+  }
+  for (const std::optional<EnsembleGrid> &grid : grids_) {
+    if (grid) {
+      bytes[2] += grid->memory_usage();
+    }
+  }
+  for (const NeighborIndex &index : neighbor_indices_) {
+    bytes[2] += index.memory_usage();
+  }
+  const auto add_lattice = [&bytes](const auto &lattice) {
+    if (lattice) {
+      bytes[3] += lattice->memory_usage();
+    }
+  };
+  add_lattice(j_QBS_lat_);
+  add_lattice(jmu_B_lat_);
+  add_lattice(jmu_I3_lat_);
+  add_lattice(jmu_el_lat_);
+  add_lattice(fields_lat_);
+  add_lattice(jmu_custom_lat_);
+  add_lattice(UB_lat_);
+  add_lattice(UI3_lat_);
+  add_lattice(FB_lat_);
+  add_lattice(FI3_lat_);
+  add_lattice(EM_lat_);
+  add_lattice(Tmn_);
+  add_lattice(old_jmu_auxiliary_);
+  add_lattice(new_jmu_auxiliary_);
+  add_lattice(four_gradient_auxiliary_);
+  add_lattice(old_fields_auxiliary_);
+  add_lattice(new_fields_auxiliary_);
+  add_lattice(fields_four_gradient_auxiliary_);
+  for (const auto &output : outputs_) {
+    bytes[4] += output->memory_usage();
+  }
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < n_memory_subsystems; i++) {
+    memory_current_[i] = bytes[i];
+    memory_peak_[i] = std::max(memory_peak_[i], bytes[i]);
+    total += bytes[i];
+  }
+  memory_measured_ = true;
+  if (memory_limit_ == 0) {
+    return;
+  }
+  const bool was_short = memory_is_short_;
+  memory_is_short_ = total > memory_limit_;
+  if (memory_is_short_ && !was_short) {
+    logg[LExperiment].warn("The memory of ", total / (1024 * 1024),
+                           " MiB exceeds the limit of ",
+                           memory_limit_ / (1024 * 1024),
+                           " MiB, hence the memory is compacted.");
+  }
+  if (memory_is_short_) {
+    // The grids are built anew in the next time step
+    for (std::optional<EnsembleGrid> &grid : grids_) {
+      grid.reset();
+    }
+  }
 }
 
 template <typename Modus>
@@ -3248,21 +5604,483 @@ void Experiment<Modus>::increase_event_number() {
   event_++;
 }
 
+/// Version of the layout of the checkpoints
+constexpr std::uint32_t checkpoint_format_version = 1;
+
 template <typename Modus>
-void Experiment<Modus>::run() {
-  const auto &mainlog = logg[LMain];
-  for (event_ = 0; !is_finished(); event_++) {
-    mainlog.info() << "Event " << event_;
+std::string Experiment<Modus>::reason_against_forks() const {
+  if (potentials_) {
+    return "with potentials";
+  }
+  if (thermalizer_) {
+    return "with forced thermalization";
+  }
+  if (IC_switch_) {
+    return "with initial conditions for hybrid models";
+  }
+  if (event_thread_pool_) {
+    return "with concurrent events";
+  }
+  return {};
+}
 
+template <typename Modus>
+std::string Experiment<Modus>::reason_against_checkpoints() const {
+  if (!modus_.is_box() && !modus_.is_sphere()) {
+    return "outside of the box and sphere modi";
+  }
+  if (parameters_.strings_switch) {
+    return "with string fragmentation";
+  }
+  if (forks_per_event_ > 1) {
+    return "with forked events";
+  }
+  return reason_against_forks();
+}
+
+template <typename Modus>
+void Experiment<Modus>::save_event_state(CheckpointWriter &state,
+                                         int timesteps) const {
+  state.put(timesteps);
+  parameters_.labclock->save(state);
+  parameters_.outputclock->save(state);
+  for (const Particles &particles : ensembles_) {
+    particles.save(state);
+  }
+  state.put(conserved_initial_);
+  state.put(initial_mean_field_energy_);
+  state.put(counters_);
+  state.put(ensemble_counters_);
+  state.put(previous_interactions_total_);
+  state.put(previous_wall_actions_total_);
+  state.put(projectile_target_interact_);
+  state.put(process_ids_reserved_);
+  state.put(previous_baryon_densities_);
+}
+
+template <typename Modus>
+int Experiment<Modus>::restore_event_state(CheckpointReader &state) {
+  const int timesteps = state.get<int>();
+  parameters_.labclock->restore(state);
+  parameters_.outputclock->restore(state);
+  for (Particles &particles : ensembles_) {
+    particles.restore(state);
+  }
+  state.get(conserved_initial_);
+  state.get(initial_mean_field_energy_);
+  state.get(counters_);
+  state.get(ensemble_counters_);
+  state.get(previous_interactions_total_);
+  state.get(previous_wall_actions_total_);
+  state.get(projectile_target_interact_);
+  state.get(process_ids_reserved_);
+  state.get(previous_baryon_densities_);
+  mean_field_energy_.reset();
+  recount_conserved_quantities();
+  return timesteps;
+}
+
+template <typename Modus>
+void Experiment<Modus>::write_checkpoint(int timesteps) {
+  const std::string reason = reason_against_checkpoints();
+  if (!reason.empty()) {
+    logg[LExperiment].warn("No checkpoint is written ", reason, ".");
+    return;
+  }
+  const auto engine_state = [](const random::Engine &engine) {
+    std::ostringstream state;
+    state << engine;
+    return state.str();
+  };
+  CheckpointWriter checkpoint;
+  checkpoint.put(checkpoint_format_version);
+  checkpoint.put(static_cast<uint64_t>(ParticleType::list_all().size()));
+  checkpoint.put(parameters_.n_ensembles);
+  checkpoint.put(event_);
+  checkpoint.put(seed_);
+  checkpoint.put(event_seed_);
+  checkpoint.put(nonempty_ensembles_);
+  checkpoint.put(actions_performed_);
+  checkpoint.put(memory_is_short_);
+  checkpoint.put(engine_state(random::engine));
+  for (const random::Engine &engine : ensemble_engines_) {
+    checkpoint.put(engine_state(engine));
+  }
+  save_event_state(checkpoint, timesteps);
+  checkpoint.write(checkpoint_path_);
+  logg[LExperiment].info("Checkpoint of event ", event_, " at t = ",
+                         parameters_.labclock->current_time(),
+                         " fm written to ", checkpoint_path_);
+}
+
+template <typename Modus>
+void Experiment<Modus>::restore_checkpoint(const std::filesystem::path &file) {
+  const std::string reason = reason_against_checkpoints();
+  if (!reason.empty()) {
+    throw std::runtime_error("No checkpoint can be restored " + reason + ".");
+  }
+  const auto set_engine_state = [](random::Engine &engine,
+                                   const std::string &state) {
+    std::istringstream stream(state);
+    stream >> engine;
+  };
+  CheckpointReader checkpoint(file);
+  if (checkpoint.get<std::uint32_t>() != checkpoint_format_version ||
+      checkpoint.get<uint64_t>() != ParticleType::list_all().size() ||
+      checkpoint.get<int>() != parameters_.n_ensembles) {
+    throw std::runtime_error(
+        "The checkpoint " + file.string() +
+        " was written with a different build, particle list or number of "
+        "ensembles.");
+  }
+  checkpoint.get(event_);
+  checkpoint.get(seed_);
+  checkpoint.get(event_seed_);
+  checkpoint.get(nonempty_ensembles_);
+  checkpoint.get(actions_performed_);
+  checkpoint.get(memory_is_short_);
+  set_engine_state(random::engine, checkpoint.get<std::string>());
+  for (random::Engine &engine : ensemble_engines_) {
+    set_engine_state(engine, checkpoint.get<std::string>());
+  }
+  resumed_timesteps_ = restore_event_state(checkpoint);
+  if (!checkpoint.at_end()) {
+    throw std::runtime_error("The checkpoint " + file.string() +
+                             " has unexpected trailing data.");
+  }
+  logg[LExperiment].info("Resuming event ", event_, " at t = ",
+                         parameters_.labclock->current_time(), " fm from ",
+                         file);
+}
+
+template <typename Modus>
+void Experiment<Modus>::start_fork() {
+  profiler_.start_event();
+  memory_peak_ = {};
+  memory_measured_ = false;
+  const int fork = forks_per_event_ - forks_left_;
+  forks_left_--;
+  // The forks of an event have their own random number streams
+  random::engine =
+      random::make_stream(event_seed_, random::StreamKind::Fork, fork);
+  const int64_t fork_seed = draw_seed_of_next_event();
+  for (std::size_t i = 0; i < ensemble_engines_.size(); i++) {
+    ensemble_engines_[i] =
+        random::make_stream(fork_seed, random::StreamKind::Ensemble, i);
+  }
+  if (process_string_ptr_ != NULL) {
+    process_string_ptr_->init_pythia_hadron_rndm();
+  }
+  CheckpointReader snapshot(*fork_snapshot_);
+  resumed_timesteps_ = restore_event_state(snapshot);
+  logg[LExperiment].info("Fork ", fork, " of the event with seed ", event_seed_,
+                         " continues at t = ",
+                         parameters_.labclock->current_time(), " fm");
+  // Forks are not possible with potentials, so there is no mean-field energy
+  output_event_start(0.0);
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_event() {
+  logg[LMain].info() << "Event " << event_;
+
+  if (resumed_timesteps_) {
+    // The event was initialized by the interrupted run
+    profiler_.start_event();
+  } else if (forks_left_ > 0) {
+    start_fork();
+  } else {
     // Sample initial particles, start clock, some printout and book-keeping
     initialize_new_event();
+  }
+  const bool is_last_event = event_counting_ == EventCounting::FixedNumber &&
+                             event_ + 1 >= nevents_;
+  if (prepare_next_event_ && !next_event_.valid() && !is_last_event) {
+    prepare_next_event();
+  }
+
+  run_time_evolution(end_time_);
 
-    run_time_evolution(end_time_);
+  do_final_interactions();
 
-    do_final_interactions();
+  // Output at event end
+  final_output();
+
+  actions_performed_ +=
+      counters_.interactions_total - counters_.wall_actions_total;
+  if (log_profile_) {
+    logg[LExperiment].info(profiler_.finish_event());
+  } else if (profiler_.enabled()) {
+    profiler_.finish_event();
+  }
+}
+
+template <typename Modus>
+void Experiment<Modus>::add_output(std::unique_ptr<OutputInterface> output) {
+  if (!output) {
+    throw std::invalid_argument("A null output cannot be added.");
+  }
+  OutputInterface &target = *output;
+  outputs_.emplace_back(std::move(output));
+  output_sections_.push_back(
+      profiler_.section("output " + std::to_string(outputs_.size())));
+  // Concurrent ensembles and events pass their calls on through buffers
+  for (OutputsList &buffers : ensemble_outputs_) {
+    buffers.emplace_back(std::make_unique<BufferedOutput>(target));
+  }
+  for (const auto &worker : event_workers_) {
+    worker->add_output(std::make_unique<BufferedOutput>(target));
+  }
+  subscribe_outputs();
+}
 
-    // Output at event end
-    final_output();
+template <typename Modus>
+void Experiment<Modus>::subscribe_outputs() {
+  event_outputs_.clear();
+  interaction_outputs_.clear();
+  fluidization_outputs_.clear();
+  intermediate_time_outputs_.clear();
+  has_photon_output_ = false;
+  for (std::size_t i = 0; i < outputs_.size(); i++) {
+    const OutputInterface &output = *outputs_[i];
+    const OutputHooksBitSet hooks = output.subscribed_hooks();
+    has_photon_output_ = has_photon_output_ || output.is_photon_output();
+    if (hooks[EventHooks]) {
+      event_outputs_.push_back(i);
+    }
+    // The dileptons and photons reach their outputs through their own actions
+    if (output.is_dilepton_output() || output.is_photon_output()) {
+      continue;
+    }
+    if (hooks[InteractionHooks]) {
+      fluidization_outputs_.push_back(i);
+      if (!output.is_IC_output()) {
+        interaction_outputs_.push_back(i);
+      }
+    }
+    if (hooks[IntermediateTimeHooks] && !output.is_IC_output()) {
+      intermediate_time_outputs_.push_back(i);
+    }
+  }
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_events_concurrently() {
+  std::vector<Experiment *> experiments{this};
+  for (const auto &worker : event_workers_) {
+    experiments.push_back(worker.get());
+  }
+  const int batch_size = static_cast<int>(experiments.size());
+  int64_t seed = seed_;
+  for (int first_event = 0; first_event < nevents_;
+       first_event += batch_size) {
+    const int n_events = std::min(batch_size, nevents_ - first_event);
+    // The seeds are chained from event to event as in a serial run
+    for (int i = 0; i < n_events; i++) {
+      experiments[i]->event_ = first_event + i;
+      experiments[i]->seed_ = seed;
+      random::set_seed(seed);
+      seed = draw_seed_of_next_event();
+    }
+    event_thread_pool_->parallel_for(
+        n_events, [&](std::size_t i) { experiments[i]->run_event(); });
+    // This experiment has written directly to the outputs, as have all
+    // experiments to their shards
+    for (int i = 1; i < n_events; i++) {
+      for (const auto &output : experiments[i]->outputs_) {
+        if (auto *buffer = dynamic_cast<BufferedOutput *>(output.get())) {
+          buffer->flush();
+        }
+      }
+    }
+  }
+  event_ = nevents_;
+  seed_ = seed;
+}
+
+template <typename Modus>
+std::vector<int> Experiment<Modus>::events_by_expected_duration(
+    const std::vector<int64_t> &seeds, int window) {
+  std::vector<int> order(seeds.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (!modus_.is_collider()) {
+    return order;
+  }
+  std::vector<double> impact_parameters(seeds.size());
+  for (std::size_t i = 0; i < seeds.size(); i++) {
+    // The random numbers are drawn as in initialize_event_with
+    random::set_seed(seeds[i]);
+    draw_seed_of_next_event();
+    if (process_string_ptr_ != NULL) {
+      random::uniform_int(1, maximum_rndm_seed_in_pythia);
+    }
+    modus_.sample_impact();
+    impact_parameters[i] = modus_.impact_parameter();
+  }
+  /* The number of participants and hence the duration of an event decrease
+   * with the impact parameter for given nuclei. */
+  for (auto first = order.begin(); first != order.end();) {
+    const auto last = order.end() - first > window ? first + window
+                                                   : order.end();
+    std::stable_sort(first, last, [&impact_parameters](int a, int b) {
+      return impact_parameters[a] < impact_parameters[b];
+    });
+    first = last;
+  }
+  return order;
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_events_longest_first() {
+  std::vector<Experiment *> experiments{this};
+  for (const auto &worker : event_workers_) {
+    experiments.push_back(worker.get());
+  }
+  const int n_experiments = static_cast<int>(experiments.size());
+  // The seeds are chained from event to event as in a serial run
+  std::vector<int64_t> seeds(nevents_);
+  int64_t seed = seed_;
+  for (int64_t &event_seed : seeds) {
+    event_seed = seed;
+    random::set_seed(seed);
+    seed = draw_seed_of_next_event();
+  }
+  const std::vector<int> order =
+      events_by_expected_duration(seeds, 8 * n_experiments);
+
+  /* This experiment buffers its calls like the workers. The outputs of the
+   * workers which are no buffers are their shards, as are the outputs of this
+   * experiment at the same positions, which are written to directly. */
+  OutputsList targets = std::move(outputs_);
+  outputs_.clear();
+  for (std::size_t i = 0; i < targets.size(); i++) {
+    if (dynamic_cast<BufferedOutput *>(event_workers_[0]->outputs_[i].get())) {
+      outputs_.emplace_back(std::make_unique<BufferedOutput>(*targets[i]));
+    } else {
+      outputs_.emplace_back(std::move(targets[i]));
+    }
+  }
+
+  // The buffered calls of every event, which are written in event order
+  using EventCalls =
+      std::vector<std::pair<BufferedOutput *, BufferedOutput::Calls>>;
+  std::vector<std::optional<EventCalls>> finished(nevents_);
+  int next_to_write = 0;
+  std::mutex writing;
+  std::atomic<int> next_to_run{0};
+  event_thread_pool_->parallel_for(n_experiments, [&](std::size_t i) {
+    Experiment &experiment = *experiments[i];
+    for (int k = next_to_run++; k < nevents_; k = next_to_run++) {
+      const int event = order[k];
+      experiment.event_ = event;
+      experiment.seed_ = seeds[event];
+      experiment.run_event();
+      EventCalls calls;
+      for (const auto &output : experiment.outputs_) {
+        if (auto *buffer = dynamic_cast<BufferedOutput *>(output.get())) {
+          calls.emplace_back(buffer, buffer->take_calls());
+        }
+      }
+      std::lock_guard lock(writing);
+      finished[event] = std::move(calls);
+      for (; next_to_write < nevents_ && finished[next_to_write];
+           next_to_write++) {
+        for (const auto &[buffer, buffered_calls] : *finished[next_to_write]) {
+          buffer->flush(buffered_calls);
+        }
+        finished[next_to_write].reset();
+      }
+    }
+  });
+
+  for (std::size_t i = 0; i < outputs_.size(); i++) {
+    if (!targets[i]) {
+      targets[i] = std::move(outputs_[i]);
+    }
+  }
+  outputs_ = std::move(targets);
+  event_ = nevents_;
+  seed_ = seed;
+}
+
+template <typename Modus>
+void Experiment<Modus>::run() {
+  if (event_thread_pool_ && longest_events_first_) {
+    run_events_longest_first();
+  } else if (event_thread_pool_) {
+    run_events_concurrently();
+  } else {
+    // A run continued from a checkpoint starts with the interrupted event
+    if (!resumed_timesteps_) {
+      event_ = 0;
+    }
+    for (; !is_finished(); event_++) {
+      run_event();
+    }
+  }
+  finish_run();
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_event_ranges(
+    const std::function<EventRange()> &next_range) {
+  if (event_counting_ != EventCounting::FixedNumber || forks_per_event_ > 1 ||
+      event_thread_pool_ || resumed_timesteps_) {
+    throw std::invalid_argument(
+        "Ranges of events can only be run for a fixed number of events, "
+        "without forks, concurrent events and checkpoints.");
+  }
+  // The seed of the event following the ones run or skipped so far
+  int chained_event = 0;
+  int64_t chained_seed = seed_;
+  for (EventRange range = next_range(); range.first < range.second;
+       range = next_range()) {
+    if (range.first < chained_event) {
+      throw std::invalid_argument(
+          "The ranges of events have to follow each other in increasing "
+          "order.");
+    }
+    for (; chained_event < range.first; chained_event++) {
+      random::set_seed(chained_seed);
+      chained_seed = draw_seed_of_next_event();
+    }
+    seed_ = chained_seed;
+    const int last_event = std::min(range.second, nevents_);
+    for (event_ = range.first; event_ < last_event; event_++) {
+      run_event();
+    }
+    chained_event = event_;
+    chained_seed = seed_;
+  }
+  finish_run();
+}
+
+template <typename Modus>
+void Experiment<Modus>::finish_run() {
+  for (const auto &worker : event_workers_) {
+    actions_performed_ += worker->actions_performed_;
+  }
+  if (profiler_.enabled()) {
+    for (const auto &worker : event_workers_) {
+      profiler_.add_totals(worker->profiler_);
+    }
+    if (log_profile_) {
+      logg[LExperiment].info(profiler_.total_report());
+    }
+  }
+  if (!trace_path_.empty()) {
+    logg[LExperiment].info("Writing the trace of ", trace_->size(), " of ",
+                           trace_->n_recorded(), " spans to ", trace_path_);
+    trace_->write(trace_path_);
+  }
+  if (workload_) {
+    workload_->flush();
+    const auto n_recorded = workload_->n_recorded();
+    logg[LExperiment].info(
+        "Recorded ", n_recorded[WorkloadRecorder::Pairs], " pairs, ",
+        n_recorded[WorkloadRecorder::Smearings], " lattice updates and ",
+        n_recorded[WorkloadRecorder::Strings],
+        " string excitations to the workload.");
   }
 }
 
@@ -105,6 +105,12 @@ struct ExperimentParameters {
    */
   double box_length;
 
+  /**
+   * Whether the particles in the box are propagated beyond its walls until the
+   * end of the time step, instead of being put back by wall-crossing actions
+   */
+  bool lazy_wall_crossings;
+
   /**
    * The maximal cross section (in mb) for which it is guaranteed that all
    * collisions with this cross section will be found.
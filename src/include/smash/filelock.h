@@ -10,6 +10,7 @@
 #ifndef SRC_INCLUDE_SMASH_FILELOCK_H_
 #define SRC_INCLUDE_SMASH_FILELOCK_H_
 
+#include <chrono>
 #include <filesystem>
 
 #include "forwarddeclarations.h"
@@ -49,6 +50,25 @@ class FileLock {
    */
   bool acquire();
 
+  /** Acquire the file lock, waiting for another process holding it to
+   * release it.
+   *
+   * This lets concurrent processes cooperate on a cache: the first one
+   * acquires the lock and fills the cache, while the others wait for it and
+   * then read the cache instead of filling it themselves. A lock file older
+   * than \p max_age is considered to be left over by a process which stopped
+   * without releasing it, such that it is not waited for.
+   *
+   *  \param[in] max_age The age of the lock file after which the lock is not
+   *             waited for any more.
+   *  \return Whether the lock was acquired.
+   *
+   *  \throws std::runtime_error if called another time after acquiring the
+   *  lock or if the lockfile cannot be closed.
+   */
+  bool acquire_or_wait(
+      std::chrono::seconds max_age = std::chrono::hours(1));
+
  private:
   /// Path to the file lock.
   std::filesystem::path path_;
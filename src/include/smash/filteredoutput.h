@@ -0,0 +1,110 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_FILTEREDOUTPUT_H_
+#define SRC_INCLUDE_SMASH_FILTEREDOUTPUT_H_
+
+#include <memory>
+#include <string>
+
+#include "outputinterface.h"
+#include "outputparameters.h"
+#include "particles.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ * An output passing only the selected particles and interactions on to
+ * another output.
+ *
+ * It is placed in front of the format writers of the %Particles and
+ * Collisions contents, if a \ref input_output_filter_ "Filter" section is
+ * given. The particle lists passed on contain copies of the selected
+ * particles with unchanged ids, which are stored in a list reused for every
+ * call. An interaction is passed on unchanged, if its process type is selected
+ * and at least one of its incoming or outgoing particles is selected.
+ */
+class FilteredOutput : public OutputInterface {
+ public:
+  /**
+   * Create the filter in front of the given output.
+   *
+   * \param[in] target The output receiving the selected particles and
+   *            interactions.
+   * \param[in] name Name of the output content.
+   * \param[in] filter The selection.
+   * \throw std::invalid_argument if a range of the selection is empty.
+   */
+  FilteredOutput(std::unique_ptr<OutputInterface> target, std::string name,
+                 const OutputFilterParameters &filter);
+
+  /// Pass the selected initial particles of an event on.
+  void at_eventstart(const Particles &particles, const EventLabel &event_label,
+                     const EventInfo &event) override;
+  /// Pass the selected final particles of an event on.
+  void at_eventend(const Particles &particles, const EventLabel &event_label,
+                   const EventInfo &event) override;
+  /// Pass the selected particles at an intermediate time on.
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param,
+                            const EventLabel &event_label,
+                            const EventInfo &event) override;
+
+  /**
+   * Pass the interaction on, if it is selected.
+   *
+   * \param[in] action The performed action.
+   * \param[in] density The density at the interaction point.
+   */
+  void at_interaction(const Action &action, const double density) override;
+
+  /**
+   * \param[in] p The particle.
+   * \return Whether the particle is selected.
+   */
+  bool selects(const ParticleData &p) const;
+
+  /**
+   * \param[in] action The performed action.
+   * \return Whether the interaction is selected.
+   */
+  bool selects(const Action &action) const;
+
+  /// \return The memory kept by the target and the reused list [bytes].
+  std::size_t memory_usage() const override {
+    return target_->memory_usage() + selected_.memory_usage();
+  }
+
+  /// \return The hooks to which the target subscribed.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return target_->subscribed_hooks();
+  }
+
+ private:
+  /**
+   * Copy the selected particles into the reused list.
+   *
+   * \param[in] particles All particles.
+   * \return The selected particles.
+   */
+  const Particles &selected(const Particles &particles);
+
+  /// The output receiving the selected particles and interactions
+  std::unique_ptr<OutputInterface> target_;
+  /// The selection
+  const OutputFilterParameters filter_;
+  /// The selected particles of the last call
+  Particles selected_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_FILTEREDOUTPUT_H_
@@ -18,6 +18,8 @@
 #include <memory>
 #include <vector>
 
+#include "blockpool.h"
+
 namespace smash {
 
 class Action;
@@ -29,6 +31,7 @@ class CollisionBranch;
 class Configuration;
 class CrossSections;
 class DecayBranch;
+class DecayChannelTable;
 class DecayModes;
 class DecayType;
 class ExperimentBase;
@@ -40,13 +43,16 @@ class ModusDefault;
 class OutputInterface;
 class ParticleData;
 class Particles;
+class ParticlesView;
 class ParticleType;
 class ParticleTypePtr;
 class PdgCode;
+class RecordedAction;
 class ScatterActionsFinderParameters;
 class Tabulation;
 class ThreeVector;
 
+struct EventStatistics;
 struct ExperimentParameters;
 struct InitialConditionParameters;
 struct StringTransitionParameters;
@@ -119,6 +125,17 @@ enum class TimeStepMode : char {
   None,
   /// Use fixed time step.
   Fixed,
+  /// Adapt the time step to the evolution of the system.
+  Adaptive,
+};
+
+/// The kind of queue in which the actions of the timestepless propagation are
+/// kept. \see_key{key_gen_action_queue_}
+enum class ActionQueue {
+  /// A binary heap ordered by the time of execution.
+  BinaryHeap,
+  /// A calendar queue with buckets of equal width in time.
+  Calendar,
 };
 
 /**
@@ -375,7 +392,9 @@ using ActionList = build_vector_<ActionPtr>;
 using OutputPtr = build_unique_ptr_<OutputInterface>;
 using OutputsList = build_vector_<OutputPtr>;
 
-using ParticleList = build_vector_<ParticleData>;
+/* Particle lists mostly hold the few particles of an action, hence their
+ * storage is taken from the pool like the one of the actions. */
+using ParticleList = std::vector<ParticleData, PoolAllocator<ParticleData>>;
 using ParticleTypeList = build_vector_<ParticleType>;
 using ParticleTypePtrList = build_vector_<ParticleTypePtr>;
 using IsoParticleTypeList = build_vector_<IsoParticleType>;
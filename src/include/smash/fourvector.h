@@ -14,6 +14,10 @@
 
 #include "threevector.h"
 
+#if defined __AVX__
+#include <immintrin.h>
+#endif
+
 namespace smash {
 
 /**
@@ -304,10 +308,30 @@ class FourVector {
   const_iterator cend() const { return x_.cend(); }
 
  private:
-  /// internal storage of this vector's components
+#if defined __AVX__
+  /// \return The components in one AVX register.
+  __m256d load() const { return _mm256_loadu_pd(x_.data()); }
+  /**
+   * Replace the components.
+   *
+   * \param[in] x The new components in one AVX register.
+   */
+  void store(__m256d x) { _mm256_storeu_pd(x_.data(), x); }
+#endif
+
+  /**
+   * internal storage of this vector's components
+   *
+   * The storage is not aligned to 32 bytes, since this would leave gaps in
+   * ParticleData. With AVX, the components are loaded unaligned, which is as
+   * fast unless a vector straddles two cache lines.
+   */
   std::array<double, 4> x_;
 };
 
+static_assert(sizeof(FourVector) == 4 * sizeof(double),
+              "A FourVector has to fit into one AVX register.");
+
 // Definitions of previous inline functions
 
 double inline FourVector::x0(void) const { return x_[0]; }
@@ -358,10 +382,14 @@ bool inline FourVector::operator>=(const FourVector &a) const {
 }
 
 FourVector inline FourVector::operator+=(const FourVector &a) {
+#if defined __AVX__
+  store(_mm256_add_pd(load(), a.load()));
+#else
   this->x_[0] += a.x_[0];
   this->x_[1] += a.x_[1];
   this->x_[2] += a.x_[2];
   this->x_[3] += a.x_[3];
+#endif
   return *this;
 }
 
@@ -379,10 +407,14 @@ inline FourVector operator+(FourVector a, const FourVector &b) {
 }
 
 FourVector inline FourVector::operator-=(const FourVector &a) {
+#if defined __AVX__
+  store(_mm256_sub_pd(load(), a.load()));
+#else
   this->x_[0] -= a.x_[0];
   this->x_[1] -= a.x_[1];
   this->x_[2] -= a.x_[2];
   this->x_[3] -= a.x_[3];
+#endif
   return *this;
 }
 
@@ -400,10 +432,14 @@ inline FourVector operator-(FourVector a, const FourVector &b) {
 }
 
 FourVector inline FourVector::operator*=(const double &a) {
+#if defined __AVX__
+  store(_mm256_mul_pd(load(), _mm256_set1_pd(a)));
+#else
   this->x_[0] *= a;
   this->x_[1] *= a;
   this->x_[2] *= a;
   this->x_[3] *= a;
+#endif
   return *this;
 }
 
@@ -433,10 +469,14 @@ inline FourVector operator*(double b, FourVector a) {
 
 FourVector inline FourVector::operator/=(const double &a) {
   const double a_inv = 1.0 / a;
+#if defined __AVX__
+  store(_mm256_mul_pd(load(), _mm256_set1_pd(a_inv)));
+#else
   this->x_[0] *= a_inv;
   this->x_[1] *= a_inv;
   this->x_[2] *= a_inv;
   this->x_[3] *= a_inv;
+#endif
   return *this;
 }
 
@@ -454,12 +494,17 @@ inline FourVector operator/(FourVector a, const double &b) {
 }
 
 double inline FourVector::Dot(const FourVector &a) const {
+#if defined __AVX__
+  // The products are summed up in the same order as without AVX
+  alignas(32) double products[4];
+  _mm256_store_pd(products, _mm256_mul_pd(load(), a.load()));
+  return products[0] - products[1] - products[2] - products[3];
+#else
   return x_[0] * a.x_[0] - x_[1] * a.x_[1] - x_[2] * a.x_[2] - x_[3] * a.x_[3];
+#endif
 }
 
-double inline FourVector::sqr() const {
-  return x_[0] * x_[0] - x_[1] * x_[1] - x_[2] * x_[2] - x_[3] * x_[3];
-}
+double inline FourVector::sqr() const { return Dot(*this); }
 
 double inline FourVector::abs() const {
   if (this->sqr() > -really_small) {
@@ -490,6 +535,56 @@ void inline FourVector::reset() {
   this->x_[3] = 0.;
 }
 
+/**
+ * \ingroup data
+ *
+ * A Lorentz boost by a fixed velocity, which is applied to many four-vectors.
+ *
+ * The factors depending on the velocity alone are computed once, such that
+ * every boosted vector costs only a few products and sums. The results are
+ * identical to the ones of FourVector::lorentz_boost, which is implemented in
+ * terms of this class. The boost is not inlined, such that the compiler cannot
+ * contract its operations with the ones of the caller, which would change the
+ * results in the last digits.
+ */
+class LorentzBoost {
+ public:
+  /**
+   * \param[in] v Velocity vector by which the four-vectors are boosted.
+   */
+  explicit LorentzBoost(const ThreeVector &v);
+
+  /**
+   * \param[in] x A four-vector.
+   * \return The boosted four-vector, see FourVector::lorentz_boost.
+   */
+  FourVector operator()(const FourVector &x) const;
+
+  /**
+   * Boost all four-vectors of a range in place.
+   *
+   * \param[in] first Start of the range.
+   * \param[in] last End of the range.
+   */
+  template <typename Iterator>
+  void apply(Iterator first, Iterator last) const {
+    for (; first != last; ++first) {
+      *first = (*this)(*first);
+    }
+  }
+
+  /// \return The velocity of the boost.
+  const ThreeVector &velocity() const { return v_; }
+
+ private:
+  /// Velocity of the boost
+  ThreeVector v_;
+  /// Lorentz factor \f$\gamma\f$ of the velocity
+  double gamma_;
+  /// \f$\gamma / (\gamma + 1)\f$
+  double gamma_ratio_;
+};
+
 /**\ingroup logging
  * Writes the four components of the vector to the output stream.
  *
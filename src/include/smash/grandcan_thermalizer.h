@@ -7,6 +7,8 @@
 #ifndef SRC_INCLUDE_SMASH_GRANDCAN_THERMALIZER_H_
 #define SRC_INCLUDE_SMASH_GRANDCAN_THERMALIZER_H_
 
+#include <array>
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -21,6 +23,7 @@
 #include "lattice.h"
 #include "particledata.h"
 #include "quantumnumbers.h"
+#include "threadpool.h"
 
 namespace smash {
 
@@ -67,6 +70,14 @@ class ThermLatticeNode {
   void add_particle(const ParticleData& p, double factor);
   /// dummy function for update_lattice
   void add_particle_for_derivatives(const ParticleData&, double, ThreeVector) {}
+  /**
+   * Add the contributions of the particles added to another node, i.e. Tmu0,
+   * nb, ns and nq. Used by update_lattice to sum partial lattices.
+   *
+   * \param[in] other The node to be added.
+   * \return This node.
+   */
+  ThermLatticeNode& operator+=(const ThermLatticeNode& other);
   /**
    * Temperature, chemical potentials and rest frame velocity are
    * calculated given the hadron gas equation of state object
@@ -79,7 +90,28 @@ class ThermLatticeNode {
    * frame transformation is that it conserves energy and momentum, even
    * though the dissipative part of the energy-momentum tensor is neglected.
    */
-  void compute_rest_frame_quantities(HadronGasEos& eos);
+  void compute_rest_frame_quantities(HadronGasEos& eos) {
+    compute_rest_frame_quantities(eos, eos);
+  }
+  /**
+   * Calculates the same rest frame quantities as above, but takes the
+   * tabulated values and the solutions of the equation of state from
+   * different objects. Since the table is only read, several nodes can be
+   * computed concurrently with a solver per thread.
+   *
+   * \param[in] table_eos The equation of state providing the table.
+   * \param[in] solver_eos The equation of state used to solve for the
+   *            quantities outside of the table, with the same treatment of
+   *            the resonance widths as \p table_eos.
+   * \param[in] previous_solution T, mub, mus and muq [GeV] of this node at
+   *            an earlier time, which are the starting point of the solver.
+   *            A vanishing temperature means that there is none. Within the
+   *            iterations for the rest frame, the solver always starts from
+   *            the solution of the previous iteration.
+   */
+  void compute_rest_frame_quantities(
+      const HadronGasEos& table_eos, HadronGasEos& solver_eos,
+      const std::array<double, 4>& previous_solution = {0.0, 0.0, 0.0, 0.0});
   /**
    * Set all the rest frame quantities to some values, this is useful
    * for testing.
@@ -115,6 +147,37 @@ class ThermLatticeNode {
   double muq() const { return muq_; }
 
  private:
+  /// The thermalizer iterates the rest frames of many nodes at once
+  friend class GrandCanThermalizer;
+  /// Maximal number of iterations of compute_rest_frame_quantities()
+  static constexpr int max_rest_frame_iterations_ = 50;
+  /// Change of the energy density [GeV/fm^3] below which the rest frame is
+  /// found
+  static constexpr double rest_frame_tolerance_ = 5.e-4;
+  /**
+   * First half of an iteration of compute_rest_frame_quantities(): compute
+   * the energy density in the current rest frame.
+   *
+   * \return The absolute change of the energy density [GeV/fm^3].
+   */
+  double update_rest_frame_energy_density();
+  /// \return The net baryon density in the current rest frame [fm^-3].
+  double rest_frame_nb() const { return std::sqrt(1.0 - v_.sqr()) * nb_; }
+  /**
+   * Second half of an iteration of compute_rest_frame_quantities(): take the
+   * temperature, chemical potentials and pressure from the table or solve the
+   * equation of state for them, and update the velocity of the rest frame.
+   *
+   * \param[in] tabulated The tabulated values at e(), rest_frame_nb() and
+   *            nq(), with a negative pressure outside of the table.
+   * \param[in] solver_eos The equation of state to solve outside of the table.
+   * \param[in] start T, mub, mus and muq [GeV] to start the solver from.
+   */
+  void update_rest_frame(const EosTable::table_element& tabulated,
+                         HadronGasEos& solver_eos,
+                         const std::array<double, 4>& start);
+  /// Report that the rest frame was not found within the allowed iterations
+  static void warn_rest_frame_not_converged(double change);
   /// Four-momentum flow of the cell
   FourVector Tmu0_;
   /// Net baryon density of the cell in the computational frame
@@ -203,16 +266,20 @@ class GrandCanThermalizer {
    * \param[in] algo Choice of algorithm for the canonical sampling
    * \param[in] BF_microcanonical Enforce energy conservation in BF sampling
    *            algorithms or nor
+   * \param[in] thread_pool Optional pool compiling the table of the equation
+   *            of state, if it cannot be read from a file.
    */
   GrandCanThermalizer(const std::array<double, 3> lat_sizes,
                       const std::array<int, 3> n_cells,
                       const std::array<double, 3> origin, bool periodicity,
                       double e_critical, double t_start, double delta_t,
-                      ThermalizationAlgorithm algo, bool BF_microcanonical);
+                      ThermalizationAlgorithm algo, bool BF_microcanonical,
+                      ThreadPool* thread_pool = nullptr);
   /// \see GrandCanThermalizer Exactly the same but taking values from config
   GrandCanThermalizer(Configuration& conf,
                       const std::array<double, 3> lat_sizes,
-                      const std::array<double, 3> origin, bool periodicity)
+                      const std::array<double, 3> origin, bool periodicity,
+                      ThreadPool* thread_pool = nullptr)
       : GrandCanThermalizer(
             lat_sizes, conf.take(InputKeys::forcedThermalization_cellNumber),
             origin, periodicity,
@@ -220,7 +287,8 @@ class GrandCanThermalizer {
             conf.take(InputKeys::forcedThermalization_startTime),
             conf.take(InputKeys::forcedThermalization_timestep),
             conf.take(InputKeys::forcedThermalization_algorithm),
-            conf.take(InputKeys::forcedThermalization_microcanonical)) {}
+            conf.take(InputKeys::forcedThermalization_microcanonical),
+            thread_pool) {}
   /**
    * Check that the clock is close to n * period of thermalization, since
    * the thermalization only happens at these times
@@ -240,10 +308,14 @@ class GrandCanThermalizer {
    * \param[in] par Parameters necessary for density determination
    * \see DensityParameters
    * \param[in] ignore_cells_under_threshold Boolean that is true by default
+   * \param[in] thread_pool Optional pool on which the particles are smeared
+   *            and the rest frame quantities of the nodes are computed. The
+   *            lattice is the same as without a pool.
    */
   void update_thermalizer_lattice(const std::vector<Particles>& ensembles,
                                   const DensityParameters& par,
-                                  bool ignore_cells_under_threshold = true);
+                                  bool ignore_cells_under_threshold = true,
+                                  ThreadPool* thread_pool = nullptr);
   /// \return 3 vector uniformly sampled from the rectangular cell.
   ThreeVector uniform_in_cell() const;
   /**
@@ -277,9 +349,13 @@ class GrandCanThermalizer {
    * \param[in] time Current time in the simulation to become zero component of
    * sampled particles
    * \param[in] type_index Species that should be sampled
+   *
+   * The densities of the species in the cells are taken from
+   * cell_densities_. Only the random number engine of the calling thread is
+   * changed, hence several species can be sampled concurrently.
    */
   void sample_in_random_cell_BF_algo(ParticleList& plist, const double time,
-                                     size_t type_index);
+                                     size_t type_index) const;
   /**
    * Samples particles according to the BF algorithm by making use of the
    * \see sample_in_random_cell_BF_algo.
@@ -289,24 +365,35 @@ class GrandCanThermalizer {
    * of particles in the region to be thermalized
    * \param[in] time Current time of the simulation
    * \param[in] ntest Number of testparticles
+   * \param[in] thread_pool Optional pool on which the densities in the cells
+   *            are computed and the species are sampled in the cells.
    * \return Particle list with newly sampled particles according to
    * Becattini-Feroni algorithm
+   *
+   * The multiplicities of the species, which conserve the quantum numbers,
+   * are always sampled with the random number engine of the calling thread.
+   * With a pool of at least two threads, every species is then placed in the
+   * cells with its own random number stream, such that the sampled particles
+   * do not depend on the number of threads.
    */
   void thermalize_BF_algo(QuantumNumbers& conserved_initial, double time,
-                          int ntest);
+                          int ntest, ThreadPool* thread_pool = nullptr);
 
   // Functions for mode-sampling algorithm
 
   /**
    * Computes average number of particles in each cell for the mode algorithm.
    * \param[in] condition Specifies the current mode (1 to 7)
+   * \param[in] thread_pool Optional pool on which the cells are computed.
+   *            The numbers are the same as without a pool.
    */
   template <typename F>
-  void compute_N_in_cells_mode_algo(F&& condition) {
-    N_in_cells_.clear();
-    N_total_in_cells_ = 0.0;
-    for (auto cell_index : cells_to_sample_) {
-      const ThermLatticeNode cell = (*lat_)[cell_index];
+  void compute_N_in_cells_mode_algo(F&& condition,
+                                    ThreadPool* thread_pool = nullptr) {
+    const std::size_t n_cells = cells_to_sample_.size();
+    N_in_cells_.assign(n_cells, 0.0);
+    auto compute_cell = [&](std::size_t k) {
+      const ThermLatticeNode cell = (*lat_)[cells_to_sample_[k]];
       const double gamma = 1.0 / std::sqrt(1.0 - cell.v().sqr());
       double N_tot = 0.0;
       for (ParticleTypePtr i : eos_typelist_) {
@@ -317,7 +404,12 @@ class GrandCanThermalizer {
                                                  cell.mus(), 0.0);
         }
       }
-      N_in_cells_.push_back(N_tot);
+      N_in_cells_[k] = N_tot;
+    };
+    for_each_cell_to_sample(compute_cell, thread_pool);
+    // The total is summed in the order of the cells
+    N_total_in_cells_ = 0.0;
+    for (const double N_tot : N_in_cells_) {
       N_total_in_cells_ += N_tot;
     }
   }
@@ -392,10 +484,14 @@ class GrandCanThermalizer {
    * in the region to be thermalized
    * \param[in] time Current time of the simulation
    * \param[in] spin_interaction_type Type of spin interactions to be considered
+   * \param[in] thread_pool Optional pool on which the average numbers of
+   *            particles in the cells are computed. The particles are sampled
+   *            one after the other, hence they are the same as without a pool.
    */
   void thermalize_mode_algo(
       QuantumNumbers& conserved_initial, double time,
-      SpinInteractionType spin_interaction_type = SpinInteractionType::Off);
+      SpinInteractionType spin_interaction_type = SpinInteractionType::Off,
+      ThreadPool* thread_pool = nullptr);
   /**
    * Main thermalize function, that chooses the algorithm to follow
    * (BF or mode sampling).
@@ -403,10 +499,13 @@ class GrandCanThermalizer {
    * \param[in] time Current time of the simulation
    * \param[in] ntest number of testparticles
    * \param[in] spin_interaction_type Type of spin interactions to be considered
+   * \param[in] thread_pool Optional pool used by the sampling, see
+   *            thermalize_BF_algo and thermalize_mode_algo.
    */
   void thermalize(
       const Particles& particles, double time, int ntest,
-      SpinInteractionType spin_interaction_type = SpinInteractionType::Off);
+      SpinInteractionType spin_interaction_type = SpinInteractionType::Off,
+      ThreadPool* thread_pool = nullptr);
 
   /**
    * Generates standard output with information about the thermodynamic
@@ -460,14 +559,69 @@ class GrandCanThermalizer {
   double mult_class(const HadronClass cl) const {
     return mult_classes_[static_cast<size_t>(cl)];
   }
+  /**
+   * Compute the rest frame quantities of the given range of lattice nodes,
+   * like ThermLatticeNode::compute_rest_frame_quantities() for every node,
+   * starting the solver from the previous solutions of the nodes.
+   *
+   * \param[in] begin Index of the first node.
+   * \param[in] end Index after the last node.
+   * \param[in] ignore_cells_under_treshold Whether the nodes which are
+   *            definitely below the critical energy density are skipped.
+   * \param[in] solver_eos The equation of state solving outside of the table.
+   */
+  void update_rest_frames(std::size_t begin, std::size_t end,
+                          bool ignore_cells_under_treshold,
+                          HadronGasEos& solver_eos);
+  /**
+   * Applies a function to the indices of all cells in cells_to_sample_,
+   * distributing contiguous chunks over the threads of the pool if there is
+   * one with at least two threads.
+   *
+   * \param[in] func Function taking the index in cells_to_sample_.
+   * \param[in] thread_pool Optional pool executing the function.
+   */
+  template <typename F>
+  void for_each_cell_to_sample(F&& func, ThreadPool* thread_pool) const {
+    const std::size_t n_cells = cells_to_sample_.size();
+    if (thread_pool == nullptr || thread_pool->size() < 2) {
+      for (std::size_t k = 0; k < n_cells; k++) {
+        func(k);
+      }
+      return;
+    }
+    const std::size_t n_chunks = thread_pool->size();
+    thread_pool->parallel_for(n_chunks, [&](std::size_t chunk) {
+      for (std::size_t k = chunk * n_cells / n_chunks;
+           k < (chunk + 1) * n_cells / n_chunks; k++) {
+        func(k);
+      }
+    });
+  }
   /// Number of particles to be sampled in one cell
   std::vector<double> N_in_cells_;
+  /**
+   * Lorentz factor of the flow in every cell of cells_to_sample_, used by the
+   * BF algorithm
+   */
+  std::vector<double> cell_gammas_;
+  /**
+   * Partial density of every species in every cell of cells_to_sample_, with
+   * the species running fastest, used by the BF algorithm
+   */
+  std::vector<double> cell_densities_;
   /// Cells above critical energy density
   std::vector<size_t> cells_to_sample_;
   /// Hadron gas equation of state
-  HadronGasEos eos_ = HadronGasEos(true, false);
+  HadronGasEos eos_;
   /// The lattice on which the thermodynamic quantities are calculated
   std::unique_ptr<RectangularLattice<ThermLatticeNode>> lat_;
+  /**
+   * T, mub, mus and muq [GeV] of every node of the lattice at the last
+   * thermalization it was above the critical energy density, which are the
+   * starting points of the solver of the equation of state at the next one
+   */
+  std::vector<std::array<double, 4>> previous_solutions_;
   /// Particles to be removed after this thermalization step
   ParticleList to_remove_;
   /// Newly generated particles by thermalizer
@@ -12,11 +12,17 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "forwarddeclarations.h"
+#include "particledata.h"
 #include "particles.h"
 
 namespace smash {
@@ -69,17 +75,38 @@ class GridBase {
   /// A type to store the sizes
   typedef int SizeType;
 
- protected:
   /**
    * \return the minimum x,y,z coordinates and the largest dx,dy,dz distances of
    * the particles in \p particles.
    *
-   * \param[in] particles Particles in the system
+   * \param[in] particles Particles in the system, at least one
    */
   static std::pair<std::array<double, 3>, std::array<double, 3>>
   find_min_and_length(const Particles &particles);
 };
 
+/**
+ * The cells of a block of adjacent rows of a Grid, see Grid::iterate_tiles().
+ */
+struct CellTile {
+  /// A search cell alone or together with one of its neighbor cells
+  struct Visit {
+    /// The particles of the search cell
+    ParticleSpan search;
+    /// The particles of the neighbor cell, if a pair of cells is visited
+    std::optional<ParticleSpan> neighbors;
+  };
+
+  /**
+   * The particles of the grid from the first search cell up to the last
+   * neighbor cell of the tile, which are stored contiguously. The translated
+   * cells of a periodic grid are not part of it.
+   */
+  ParticleSpan particles;
+  /// The visits of the cells in the order of Grid::iterate_cells()
+  std::vector<Visit> visits;
+};
+
 /**
  * Abstracts a list of cells that partition the particles in the experiment into
  * regions of space that can interact / cannot interact.
@@ -89,6 +116,17 @@ class GridBase {
  * takes a list of ParticleData objects and sorts them in such a way that it is
  * easy to look only at lists of particles that have a chance of interacting.
  *
+ * The particles are copied once into a single list, ordered by the cell they
+ * belong to, and the cells are handed out as spans of this list. Hence, no
+ * list has to be allocated per cell when the grid is built. A grid can be
+ * rebuilt for the particles of the next timestep, reusing the storage of the
+ * previous build.
+ *
+ * For periodic boundaries, the copies of the search cells translated across
+ * the walls (the ghost cells) are made once when the grid is built and are
+ * kept in a single list as well, such that iterating over the cells does not
+ * copy or allocate anything.
+ *
  * \tparam Options This policy parameter determines whether ghost cells are
  * created to support periodic boundaries, or not.
  */
@@ -145,6 +183,50 @@ class Grid : public GridBase {
        const bool include_unformed_particles = false,
        CellSizeStrategy strategy = CellSizeStrategy::Optimal);
 
+  /**
+   * Places the given particles onto the grid anew, exactly like the
+   * corresponding constructor would. The memory allocated for the previous
+   * particles is reused.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration Duration of the timestep in fm.
+   * \param[in] limit Limitation of cell number.
+   * \param[in] include_unformed_particles include unformed particles from
+   *                                        the grid (worsens runtime).
+   * \param[in] strategy The strategy for determining the cell size.
+   */
+  void rebuild(const Particles &particles, double min_cell_length,
+               double timestep_duration, CellNumberLimitation limit,
+               const bool include_unformed_particles = false,
+               CellSizeStrategy strategy = CellSizeStrategy::Optimal) {
+    rebuild(find_min_and_length(particles), particles, min_cell_length,
+            timestep_duration, limit, include_unformed_particles, strategy);
+  }
+
+  /**
+   * Places the given particles onto a grid with the given minimum grid
+   * coordinates and grid length, exactly like the corresponding constructor
+   * would. The memory allocated for the previous particles is reused.
+   *
+   * \param[in] min_and_length A pair consisting of the three min coordinates
+   * and the three lengths.
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration Duration of the timestep in fm.
+   * \param[in] limit Limitation of cell number.
+   * \param[in] include_unformed_particles include unformed particles from
+   *                                        the grid (worsens runtime).
+   * \param[in] strategy The strategy for determining the cell size.
+   * \throws runtime_error if your box length is smaller than the grid length.
+   */
+  void rebuild(const std::pair<std::array<double, 3>, std::array<double, 3>>
+                   &min_and_length,
+               const Particles &particles, double min_cell_length,
+               double timestep_duration, CellNumberLimitation limit,
+               const bool include_unformed_particles = false,
+               CellSizeStrategy strategy = CellSizeStrategy::Optimal);
+
   /**
    * Iterates over all cells in the grid and calls the callback arguments with
    * a search cell and 0 to 13 neighbor cells.
@@ -162,8 +244,69 @@ class Grid : public GridBase {
    *                              be adjusted to wrap around the grid.
    */
   void iterate_cells(
-      const std::function<void(const ParticleList &)> &search_cell_callback,
-      const std::function<void(const ParticleList &, const ParticleList &)>
+      const std::function<void(ParticleSpan)> &search_cell_callback,
+      const std::function<void(ParticleSpan, ParticleSpan)>
+          &neighbor_cell_callback) const {
+    const std::size_t n_rows = number_of_rows();
+    for (std::size_t row = 0; row < n_rows; ++row) {
+      iterate_cells_in_row(row, search_cell_callback, neighbor_cell_callback);
+    }
+  }
+
+  /**
+   * Iterates over the cells of the grid like iterate_cells(), but hands them
+   * out in tiles of adjacent rows. Visiting the tiles and their visits in
+   * order is equivalent to calling iterate_cells().
+   *
+   * The neighbor cells of a row lie in the next row and in three rows of the
+   * next plane in z direction. The rows of a tile are chosen such that the
+   * particles of these rows together with the search rows are at most the
+   * given number, or a tile has a single row, and the data of the particles
+   * in a tile can be kept in the cache while its cells are searched.
+   *
+   * \param[in] max_particles The number of particles in the search rows and
+   *            their neighbor rows of a tile.
+   * \param[in] tile_callback A callable called with every tile.
+   */
+  void iterate_tiles(
+      std::size_t max_particles,
+      const std::function<void(const CellTile &)> &tile_callback) const;
+
+  /**
+   * \return the number of rows of the grid, i.e. the number of cells in y
+   * direction times the number of cells in z direction.
+   */
+  std::size_t number_of_rows() const {
+    return static_cast<std::size_t>(number_of_cells_[1]) * number_of_cells_[2];
+  }
+
+  /**
+   * Iterates over the cells of one row of the grid, i.e. over the cells with
+   * the same y and z index, in the same way as iterate_cells() does.
+   *
+   * The rows are numbered in the order in which iterate_cells() visits them,
+   * i.e. the row with y index \f$j\f$ and z index \f$k\f$ has the number
+   * \f$k N_y + j\f$. Iterating over all rows in increasing order is equivalent
+   * to calling iterate_cells().
+   *
+   * The grid is not modified by this function, hence different rows may be
+   * iterated over concurrently. If the results of the callbacks are stored per
+   * row and combined in increasing row order, they do not depend on the order
+   * in which the rows were processed.
+   *
+   * \param[in] row Number of the row, it has to be smaller than
+   *                number_of_rows().
+   * \param[in] search_cell_callback A callable called for/with every cell in
+   *                                 the row.
+   * \param[in] neighbor_cell_callback A callable called for/with every cell in
+   *                                   the row and adjacent cell combination.
+   *                                   For a periodic grid, the first argument
+   *                                   will be adjusted to wrap around the grid.
+   */
+  void iterate_cells_in_row(
+      std::size_t row,
+      const std::function<void(ParticleSpan)> &search_cell_callback,
+      const std::function<void(ParticleSpan, ParticleSpan)>
           &neighbor_cell_callback) const;
 
   /**
@@ -171,6 +314,24 @@ class Grid : public GridBase {
    */
   double cell_volume() const { return cell_volume_; }
 
+  /// \return the number of cells of the grid.
+  SizeType number_of_cells() const {
+    return static_cast<SizeType>(cell_offsets_.size()) - 1;
+  }
+
+  /**
+   * \return the memory used by the grid, including its copies of the particles
+   * and the ghost cells [bytes].
+   */
+  std::size_t memory_usage() const {
+    return (particles_.capacity() + ghosts_.capacity()) * sizeof(ParticleData) +
+           (cell_offsets_.capacity() + next_in_cell_.capacity() +
+            ghost_offsets_.capacity()) *
+               sizeof(std::size_t) +
+           cell_of_particle_.capacity() * sizeof(SizeType) +
+           ordered_.capacity() * sizeof(const ParticleData *);
+  }
+
  private:
   /**
    * \return the one-dimensional cell-index from the 3-dim index \p x, \p y, \p
@@ -186,8 +347,45 @@ class Grid : public GridBase {
     return make_index(idx[0], idx[1], idx[2]);
   }
 
+  /// \return the particles in the cell with the one-dimensional \p index.
+  ParticleSpan cell(SizeType index) const {
+    return {particles_.data() + cell_offsets_[index],
+            cell_offsets_[index + 1] - cell_offsets_[index]};
+  }
+
+  /**
+   * \return the ghost of the cell with the one-dimensional \p index in a
+   * periodic grid, after the cell has been translated \p n_translations times
+   * (at least once).
+   */
+  ParticleSpan ghost(SizeType index, std::size_t n_translations) const {
+    const std::size_t size = cell_offsets_[index + 1] - cell_offsets_[index];
+    const std::size_t first =
+        ghost_offsets_[index] + (n_translations - 1) * size;
+    return {ghosts_.data() + first, size};
+  }
+
+  /**
+   * Walks through the cells of one row of a periodic grid and their neighbor
+   * cells in the order of iterate_cells_in_row().
+   *
+   * \param[in] row Number of the row.
+   * \param[in] visit_search Called with the index of every search cell.
+   * \param[in] visit_neighbor Called with the index of the search cell, the
+   *            index of the neighbor cell, the translation by which the search
+   *            cell is moved further before it is paired with the neighbor
+   *            (zero if it stays where it is) and whether the search cell is
+   *            moved away from its original position.
+   */
+  template <typename SearchVisitor, typename NeighborVisitor>
+  void walk_periodic_row(std::size_t row, SearchVisitor &&visit_search,
+                         NeighborVisitor &&visit_neighbor) const;
+
+  /// Makes the ghost cells of a periodic grid from the particles on the grid.
+  void build_ghost_cells();
+
   /// The 3 lengths of the complete grid. Used for periodic boundary wrapping.
-  const std::array<double, 3> length_;
+  std::array<double, 3> length_;
 
   /// The volume of a single cell.
   double cell_volume_;
@@ -195,8 +393,120 @@ class Grid : public GridBase {
   /// The number of cells in x, y, and z direction.
   std::array<int, 3> number_of_cells_;
 
-  /// The cell storage.
-  std::vector<ParticleList> cells_;
+  /// The particles on the grid, ordered by the cell they belong to.
+  ParticleList particles_;
+
+  /**
+   * The position in particles_ of the first particle of every cell, followed
+   * by the number of particles on the grid.
+   */
+  std::vector<std::size_t> cell_offsets_;
+
+  /// The cell of every particle, only needed while the grid is built
+  std::vector<SizeType> cell_of_particle_;
+  /// The particles ordered by their cells, only needed while the grid is built
+  std::vector<const ParticleData *> ordered_;
+  /// The next free position of every cell, only needed while the grid is built
+  std::vector<std::size_t> next_in_cell_;
+
+  /**
+   * The translated copies of the cells of a periodic grid, ordered by the cell
+   * and then by the order in which the translations are needed
+   */
+  ParticleList ghosts_;
+  /**
+   * The position in ghosts_ of the first ghost of every cell, followed by the
+   * number of ghosts.
+   */
+  std::vector<std::size_t> ghost_offsets_;
+};
+
+/**
+ * A spatial index over the particles of one ensemble, which is kept up to date
+ * during the timestepless propagation.
+ *
+ * Unlike the Grid, which is rebuilt from the particles in every timestep, the
+ * index is built once at the beginning of the propagation and the outgoing
+ * particles of every performed action are added to it. Copies of the particles
+ * are stored, such that particles which were removed or updated since they
+ * were added are recognized and skipped. The positions in the index are the
+ * ones at the time the particles were added. Therefore, the cells have to be
+ * larger than the interaction length by the maximal displacement of a particle
+ * during the propagation.
+ *
+ * The candidates found in the index are returned in the order in which they
+ * are stored in the particles, such that looking for actions among them gives
+ * the same actions in the same order as looking among all particles.
+ *
+ * If the index is periodic, the cells wrap around a cube of the given period,
+ * such that particles near opposite walls of a box and particles which have
+ * left it are found as neighbors.
+ */
+class NeighborIndex {
+ public:
+  /**
+   * Index all particles in \p particles.
+   *
+   * \param[in] particles The particles of the ensemble to be indexed.
+   * \param[in] cell_length The length of the cells [fm]. It has to be at least
+   *            the maximal distance of two interacting particles plus the
+   *            maximal displacement of a particle during the propagation.
+   * \param[in] period Edge length of the periodic box [fm], the cells are
+   *            enlarged such that they divide it. Not periodic if zero.
+   * \throw std::invalid_argument if \p cell_length is not positive.
+   */
+  void build(const Particles &particles, double cell_length,
+             double period = 0.);
+
+  /**
+   * Add particles to the index, e.g. the outgoing particles of an action.
+   * Nothing is done if the index is not built.
+   *
+   * \param[in] particles The particles to be added.
+   */
+  void add(const ParticleList &particles);
+
+  /// Remove all particles from the index.
+  void clear();
+
+  /// \return Whether the index has been built and not cleared since.
+  bool is_built() const { return cell_length_ > 0.; }
+
+  /// \return An estimate of the memory used by the index [bytes].
+  std::size_t memory_usage() const;
+
+  /**
+   * Find the particles which are in the same or an adjacent cell as any of the
+   * particles in \p search_list.
+   *
+   * \param[in] particles The indexed particles in their current state.
+   * \param[in] search_list The particles whose neighbors are looked for.
+   * \return Pointers to the current state of the found particles, in the order
+   *         in which they are stored in \p particles.
+   */
+  std::vector<const ParticleData *> neighbors(
+      const Particles &particles, const ParticleList &search_list) const;
+
+ private:
+  /// A type for the integer coordinates of a cell
+  using CellIndex = std::array<std::int64_t, 3>;
+
+  /// \return The cell containing the position \p r.
+  CellIndex cell_of(const ThreeVector &r) const;
+
+  /// \return The periodic image of \p cell in a periodic index, else itself.
+  CellIndex wrapped(CellIndex cell) const;
+
+  /// The length of the cells, zero if the index is not built
+  double cell_length_ = 0.;
+  /// The number of cells along every axis of a periodic index, else zero
+  std::int64_t n_periodic_cells_ = 0;
+  /// Copies of the particles at the time they were added
+  ParticleList entries_;
+  /// The position in entries_ of the latest copy of every particle, by id
+  std::unordered_map<int, std::size_t> latest_entry_;
+  /// The positions in entries_ of the particles in every non-empty cell
+  std::map<CellIndex, std::vector<std::size_t>> cells_;
 };
 
 }  // namespace smash
@@ -10,6 +10,8 @@
 #define SRC_INCLUDE_SMASH_HADGAS_EOS_H_
 
 #include <array>
+#include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,6 +21,8 @@
 
 #include "constants.h"
 #include "particletype.h"
+#include "sha256.h"
+#include "threadpool.h"
 
 namespace smash {
 
@@ -39,8 +43,9 @@ class EosTable {
    * isospin projection density are assumed to be 0 (Note that the corresponding
    * chemical potential is still non-zero, because muB != 0).
    *
-   * After calling this constructor the table is allocated, but it is
-   * still empty. To compute values call compile_table.
+   * After calling this constructor the table is not allocated yet, such
+   * that an equation of state which is not tabulated does not pay for its
+   * memory. To allocate and compute the values call compile_table.
    *
    * \param[in] de step in energy density [GeV/fm^4]
    * \param[in] dnb step in net baryon density [GeV/fm^3]
@@ -71,12 +76,33 @@ class EosTable {
    * Computes the actual content of the table (for EosTable description see
    * documentation of the constructor).
    *
+   * The table is read from the file if it exists and is consistent with the
+   * particle table, otherwise it is computed and saved to the file. The
+   * rows of constant energy density are independent of each other, hence
+   * they are computed in parallel, each chunk with its own solver, if a
+   * pool with at least two threads is given.
+   *
    * \param[in] eos equation of state
    * \param[in] eos_savefile_name name of the file to save tabulated equation
-   *            of state
+   *            of state. If empty, the table is stored in the tabulations
+   *            directory given to set_cache(), identified by the hash of the
+   *            particles, decay modes and the table parameters, or in
+   *            hadgas_eos.dat if there is no such directory.
+   * \param[in] thread_pool Optional pool computing the rows of the table.
    */
   void compile_table(HadronGasEos& eos,
-                     const std::string& eos_savefile_name = "hadgas_eos.dat");
+                     const std::string& eos_savefile_name = "",
+                     ThreadPool* thread_pool = nullptr);
+  /**
+   * Store the tables compiled from now on in the given directory, like the
+   * tabulated resonance integrals.
+   *
+   * \param[in] hash Hash of the SMASH version, particles and decay modes.
+   * \param[in] tabulations_path Directory of the tabulations. If empty,
+   *            tables are saved to hadgas_eos.dat.
+   */
+  static void set_cache(const sha256::Hash& hash,
+                        const std::filesystem::path& tabulations_path);
   /**
    * Obtain interpolated p/T/muB/muS/muQ from the tabulated equation of state
    * given energy density, net baryon density and net charge density
@@ -84,15 +110,47 @@ class EosTable {
    * \param[in] e energy density
    * \param[in] nb net baryon density
    * \param[in] nq net charge density
-   * \param[out] res structure, that contains p/T/muB/muS/muQ
+   * \param[out] res structure, that contains p/T/muB/muS/muQ, which are all
+   *             -1 outside of the table or if the table was not compiled
    */
   void get(table_element& res, double e, double nb, double nq) const;
+  /**
+   * Obtain interpolated p/T/muB/muS/muQ at several points at once, with the
+   * same results as get() for each of them. The points are independent of
+   * each other, such that the loads of the neighbouring table elements of
+   * different points can overlap.
+   *
+   * \param[in] n number of points
+   * \param[in] e energy densities of the points
+   * \param[in] nb net baryon densities of the points
+   * \param[in] nq net charge densities of the points
+   * \param[out] res the values at the points
+   */
+  void get(size_t n, const double* e, const double* nb, const double* nq,
+           table_element* res) const;
 
  private:
   /// proper index in a 1d vector, where the 3d table is stored
   size_t index(size_t ie, size_t inb, size_t inq) const {
     return n_q_ * (ie * n_nb_ + inb) + inq;
   }
+  /**
+   * \return The name of the file in the tabulations directory storing this
+   *         table, which depends on the hash given to set_cache(), the steps
+   *         and numbers of steps of the table and the treatment of the
+   *         resonance widths.
+   *
+   * \param[in] account_for_widths Whether the resonance widths are taken
+   *            into account.
+   */
+  std::string cache_file_name(bool account_for_widths) const;
+  /**
+   * Compute the row of constant energy density of the table.
+   *
+   * \param[in] eos equation of state used for the solutions
+   * \param[in] ie index of the energy density
+   */
+  void compile_row(HadronGasEos& eos, size_t ie);
   /// Storage for the tabulated equation of state
   std::vector<table_element> table_;
   /// Step in energy density
@@ -140,8 +198,11 @@ class HadronGasEos {
    *             in thermalizer, this option has to be false. Also note that
    *             presently width account is not implemented for energy density
    *             calculation.
+   *  \param[in] thread_pool Optional pool compiling the table, if it is
+   *             tabulated and not read from a file.
    */
-  HadronGasEos(bool tabulate, bool account_for_widths);
+  HadronGasEos(bool tabulate, bool account_for_widths,
+               ThreadPool* thread_pool = nullptr);
   ~HadronGasEos();
 
   /**
@@ -323,6 +384,27 @@ class HadronGasEos {
     return solve_eos(e, nb, ns, nq, solve_eos_initial_approximation(e, nb, nq));
   }
 
+  /**
+   * Compute temperature and chemical potentials given energy-,
+   * net baryon-, net strangeness- and net charge density, starting from the
+   * solution of a similar state, like the same lattice node at the previous
+   * time step. Such a starting point is usually much closer to the solution
+   * than solve_eos_initial_approximation(), which is used instead if there is
+   * no previous solution or the solver does not converge from it.
+   *
+   * \param[in] e energy density [GeV/fm\f$^3\f$]
+   * \param[in] nb net baryon density [fm\f$^{-3}\f$]
+   * \param[in] ns net strangeness density [fm\f$^{-3}\f$]
+   * \param[in] nq net charge density [fm\f$^{-3}\f$]
+   * \param[in] previous_solution (T [GeV], mub [GeV], mus [GeV], muq [GeV])
+   *        of a similar state, or a vanishing temperature if there is none
+   * \return array of 4 values: temperature, baryon chemical potential,
+   *          strange chemical potential and charge chemical potential
+   */
+  std::array<double, 4> solve_eos_warm_start(
+      double e, double nb, double ns, double nq,
+      const std::array<double, 4>& previous_solution);
+
   /**
    * Compute a reasonable initial approximation for solve_eos.
    *
@@ -351,6 +433,12 @@ class HadronGasEos {
     eos_table_.get(res, e, nb, nq);
   }
 
+  /// Get the elements of eos table at several points, \see EosTable::get
+  void from_table(size_t n, const double* e, const double* nb, const double* nq,
+                  EosTable::table_element* res) const {
+    eos_table_.get(n, e, nb, nq, res);
+  }
+
   /// Check if a particle belongs to the EoS
   static bool is_eos_particle(const ParticleType& ptype) {
     return ptype.is_hadron() && !ptype.pdgcode().is_heavy_flavor();
@@ -419,6 +507,18 @@ class HadronGasEos {
   /// \see set_eos_solver_equations()
   static double e_equation(double T, void* params);
 
+  /**
+   * Iterate the solver of the EoS until it converges, gets stuck or the
+   * temperature falls below minimal_temperature_.
+   *
+   * \param[in] p The densities to solve for.
+   * \param[in] initial_approximation (T, mub, mus, muq) [GeV] to start from
+   * \param[out] iter The number of iterations.
+   * \return The status of the last residual test.
+   */
+  int run_solver(rparams& p, const std::array<double, 4>& initial_approximation,
+                 size_t& iter);
+
   /**
    * Helpful printout, useful for debugging if gnu equation solving goes crazy
    *
@@ -434,6 +534,9 @@ class HadronGasEos {
   /// Precision of equation solving
   static constexpr double tolerance_ = 1.e-8;
 
+  /// Temperature [GeV] below which the solver gives up
+  static constexpr double minimal_temperature_ = 0.015;
+
   /// Number of equations in the system of equations to be solved
   static constexpr size_t n_equations_ = 4;
 
@@ -458,6 +561,68 @@ class HadronGasEos {
   const bool account_for_resonance_widths_;
 };
 
+/**
+ * Samples the masses of resonances in a thermal medium of fixed temperature
+ * from tabulated inverse cumulative distributions, as an alternative to the
+ * rejection sampling of HadronGasEos::sample_mass_thermal(), whose
+ * acceptance is poor for broad resonances.
+ *
+ * The distribution \f$ dN/dm \sim A(m) m^2 K_2(m/T) \f$ of every type is
+ * tabulated when the type is sampled for the first time and reused for all
+ * further samples of that type. The masses are tabulated in the variable
+ * \f$\theta\f$ of the Cauchy distribution of the pole mass and width, \f$
+ * m = m_0 + \Gamma_0/2 \tan\theta \f$, such that the nodes are dense close
+ * to the pole also for narrow resonances. Within one interval, the
+ * distribution in \f$\theta\f$ is taken to be constant, which is the only
+ * approximation with respect to the rejection sampling.
+ */
+class ThermalMassSampler {
+ public:
+  /**
+   * Create a sampler without any tables.
+   *
+   * \param[in] beta inverse temperature 1/T [1/GeV]
+   */
+  explicit ThermalMassSampler(double beta) : beta_(beta) {}
+  /**
+   * Sample a mass, like HadronGasEos::sample_mass_thermal().
+   *
+   * \param[in] ptype the hadron sort, for which the mass is sampled
+   * \return sampled mass [GeV], the pole mass for stable particles
+   */
+  double sample(const ParticleType& ptype);
+  /**
+   * Create the table of a type in advance, after which sample() may be called
+   * for this type from several threads at once.
+   *
+   * \param[in] ptype the hadron sort, for which masses are sampled later
+   */
+  void prepare(const ParticleType& ptype);
+
+ private:
+  /// Number of intervals of every table
+  static constexpr size_t n_intervals_ = 1000;
+  /// The tabulated distribution of one type
+  struct Table {
+    /// The Cauchy variable at the first node
+    double theta_min;
+    /// The distance of the nodes in the Cauchy variable
+    double dtheta;
+    /// The unnormalized cumulative distribution at the nodes
+    std::vector<double> cdf;
+  };
+  /**
+   * \return The table of the given type, which is created if needed.
+   *
+   * \param[in] ptype the unstable hadron sort
+   */
+  const Table& table(const ParticleType& ptype);
+  /// Inverse temperature [1/GeV]
+  const double beta_;
+  /// The tables, indexed like ParticleType::list_all()
+  std::vector<std::unique_ptr<Table>> tables_;
+};
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_HADGAS_EOS_H_
@@ -0,0 +1,79 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_HARDWARECOUNTERS_H_
+#define SRC_INCLUDE_SMASH_HARDWARECOUNTERS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace smash {
+
+/**
+ * Reads hardware performance counters of the calling thread, which the
+ * Profiler attributes to its sections.
+ *
+ * On Linux, the counters are a group of events of perf_event_open(2), which
+ * is opened for every thread when it reads the counters for the first time
+ * and closed when the thread ends. Only the events of the user space of the
+ * thread itself are counted, which is allowed for unprivileged processes
+ * unless \c /proc/sys/kernel/perf_event_paranoid is larger than 2. Events
+ * which the CPU or a virtual machine does not support are left out. If no
+ * event is available, e.g. on other systems or in containers without access
+ * to the counters, nothing is counted.
+ *
+ * If the counters of the CPU are shared with other groups of events, the
+ * kernel multiplexes them, and the counts are scaled by the fraction of the
+ * time in which the group was counting.
+ */
+class HardwareCounters {
+ public:
+  /// The counted events
+  enum Event : std::size_t {
+    /// CPU cycles
+    Cycles,
+    /// Retired instructions
+    Instructions,
+    /// Misses of the last level cache
+    LLCMisses,
+    /// Misses of the translation lookaside buffer for data loads
+    DTLBMisses,
+    /// Mispredicted branches
+    BranchMisses,
+    /// Number of events
+    NEvents
+  };
+
+  /// Counts of all events, which stay 0 for unavailable ones
+  using Counts = std::array<int64_t, NEvents>;
+
+  /// The names of the events in the reports
+  static constexpr std::array<const char *, NEvents> names = {
+      "cycles", "instructions", "llc_misses", "dtlb_misses", "branch_misses"};
+
+  /**
+   * Open the counters of the calling thread, if this has not been done yet.
+   *
+   * \return Which events are counted for the calling thread.
+   */
+  static std::array<bool, NEvents> available();
+
+  /**
+   * Read the counts of the calling thread since its counters were opened,
+   * which is done on the first call.
+   *
+   * \param[out] counts The counts, 0 for unavailable events.
+   */
+  static void read(Counts &counts);
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_HARDWARECOUNTERS_H_
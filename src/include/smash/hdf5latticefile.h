@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_HDF5LATTICEFILE_H_
+#define SRC_INCLUDE_SMASH_HDF5LATTICEFILE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * \brief An HDF5 file holding one lattice quantity at all output times
+ *
+ * The values of one output time are collected with add() in the order of the
+ * binary lattice output and written as one slice of an extendible dataset by
+ * write_frame(), see \ref doxypage_output_thermodyn_lattice. The file is
+ * closed when the object is destroyed.
+ */
+class Hdf5LatticeFile {
+ public:
+  /**
+   * Create the file and its datasets.
+   *
+   * \param[in] filename Name of the file, an existing file is overwritten.
+   * \param[in] quantity Name of the quantity.
+   * \param[in] quantity_id Number of the quantity, as in the binary output.
+   * \param[in] version Version of the thermodynamic lattice output.
+   * \param[in] nodes Number of nodes along x, y and z.
+   * \param[in] spacing Size of the cells along x, y and z.
+   * \param[in] origin Origin of the lattice.
+   * \param[in] frame_shape Dimensions of the values of one output time.
+   * \param[in] compression_level Deflate level of the chunks, 0 to disable.
+   * \throw std::runtime_error if the file cannot be created.
+   */
+  Hdf5LatticeFile(const std::filesystem::path &filename,
+                  const std::string &quantity, int quantity_id, double version,
+                  const std::array<int, 3> &nodes,
+                  const std::array<double, 3> &spacing,
+                  const std::array<double, 3> &origin,
+                  const std::vector<std::size_t> &frame_shape,
+                  int compression_level);
+
+  /// Close the file.
+  ~Hdf5LatticeFile();
+
+  /// Cannot be copied
+  Hdf5LatticeFile(const Hdf5LatticeFile &) = delete;
+  /// Cannot be copied
+  Hdf5LatticeFile &operator=(const Hdf5LatticeFile &) = delete;
+
+  /**
+   * Add the next value of the current output time.
+   *
+   * \param[in] value The value.
+   */
+  void add(double value) { frame_.push_back(value); }
+
+  /**
+   * Append the added values as a new output time to the file.
+   *
+   * \param[in] time The output time.
+   * \throw std::runtime_error if the number of values does not match the
+   *        frame shape or writing fails.
+   */
+  void write_frame(double time);
+
+ private:
+  /// Close the datasets and the file, which are open.
+  void close();
+
+  /// Identifiers of the file and of the data and time datasets
+  std::int64_t file_ = -1, data_ = -1, times_ = -1;
+  /// Dimensions of the values of one output time
+  std::vector<std::size_t> frame_shape_;
+  /// Number of output times written
+  std::size_t n_frames_ = 0;
+  /// Values of the current output time
+  std::vector<double> frame_;
+};
+
+#ifndef SMASH_USE_HDF5
+inline Hdf5LatticeFile::Hdf5LatticeFile(const std::filesystem::path &,
+                                        const std::string &, int, double,
+                                        const std::array<int, 3> &,
+                                        const std::array<double, 3> &,
+                                        const std::array<double, 3> &,
+                                        const std::vector<std::size_t> &,
+                                        int) {
+  throw std::runtime_error(
+      "Lattice_HDF5 output requested, but HDF5 support not compiled in.");
+}
+inline Hdf5LatticeFile::~Hdf5LatticeFile() {}
+inline void Hdf5LatticeFile::write_frame(double) {}
+inline void Hdf5LatticeFile::close() {}
+#endif
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_HDF5LATTICEFILE_H_
@@ -11,9 +11,9 @@
 #ifndef SRC_INCLUDE_SMASH_HEPMCINTERFACE_H_
 #define SRC_INCLUDE_SMASH_HEPMCINTERFACE_H_
 
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <valarray>
 
@@ -132,8 +132,11 @@ class HepMcInterface : public OutputInterface {
     dcy = 2,   // Decay
     off = 100
   };
-  /** Type of mapping from SMASH ID to HepMC ID */
-  using IdMap = std::map<int, HepMC3::GenParticlePtr>;
+  /**
+   * Type of mapping from SMASH ID to HepMC ID. It is only used for lookups,
+   * hence a hash map, whose buckets are kept from one event to the next.
+   */
+  using IdMap = std::unordered_map<int, HepMC3::GenParticlePtr>;
   /** Counter of collitions per incoming particle */
   using CollCounter = std::valarray<int>;
   /** Clear before an event */
@@ -44,9 +44,15 @@ class HepMcOutput : public HepMcInterface {
    * \param[in] full_event Whether the full event or only final-state particles
                            are printed in the output
    * \param[in] HepMC3_output_type: "root" or "asciiv3"
+   * \param[in] compression_level The zstd compression level of the asciiv3
+   *            output, 0 if it is not compressed
+   *
+   * \throw std::invalid_argument if the compression level is invalid, not
+   *        supported by this build or requested for the ROOT output.
    */
   HepMcOutput(const std::filesystem::path &path, std::string name,
-              const bool full_event, std::string HepMC3_output_type);
+              const bool full_event, std::string HepMC3_output_type,
+              int compression_level = 0);
 
   /// Destructor renames file
   ~HepMcOutput();
@@ -66,6 +72,10 @@ class HepMcOutput : public HepMcInterface {
   const std::filesystem::path filename_;
   /// Filename of output as long as simulation is still running.
   std::filesystem::path filename_unfinished_;
+  /// The zstd compressed file stream, defined in the translation unit
+  class CompressedStream;
+  /// The stream of a compressed asciiv3 output, \c nullptr if uncompressed
+  std::unique_ptr<CompressedStream> compressed_stream_;
   /// Pointers to the base class of HepMC3 output files
   std::unique_ptr<HepMC3::Writer> output_file_;
   /// enum to identify the HepMC3 output type
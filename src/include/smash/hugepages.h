@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_HUGEPAGES_H_
+#define SRC_INCLUDE_SMASH_HUGEPAGES_H_
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace smash {
+
+/**
+ * Storage of large arrays, like the particles of an ensemble and the nodes of
+ * the lattices, which can be backed by huge pages of 2 MB, see
+ * \ref key_gen_huge_pages_ "Huge_Pages".
+ *
+ * These arrays are accessed at random, e.g. by the smearing and the stencils
+ * of the gradients, such that most accesses miss the translation lookaside
+ * buffer with pages of 4 kB. With huge pages, one entry of the buffer covers
+ * 512 times as much memory.
+ *
+ * If huge pages are enabled, arrays of at least one huge page are mapped from
+ * the pages reserved for hugetlbfs (see \c /proc/sys/vm/nr_hugepages) if
+ * available, and otherwise as anonymous memory aligned to huge pages, which is
+ * advised to be backed by transparent huge pages. If both fail, e.g. on other
+ * systems, and for smaller arrays, the global allocator is used. Huge pages
+ * never change the contents of the arrays.
+ */
+class HugePages {
+ public:
+  /// Size of a huge page [bytes]
+  static constexpr std::size_t page_size = 2 * 1024 * 1024;
+
+  /**
+   * Enable or disable huge pages for the arrays allocated afterwards.
+   *
+   * \param[in] enabled Whether huge pages are used.
+   */
+  static void set_enabled(bool enabled);
+
+  /// \return Whether huge pages are used for new arrays.
+  static bool enabled();
+
+  /**
+   * Get storage for an array.
+   *
+   * \param[in] size Size of the array [bytes].
+   * \return Storage of at least \p size bytes, aligned like the storage of the
+   *         global allocator.
+   * \throw std::bad_alloc if no memory is available.
+   */
+  static void *allocate(std::size_t size);
+
+  /**
+   * Give back the storage of an array.
+   *
+   * \param[in] block Storage obtained from allocate(), or null.
+   */
+  static void deallocate(void *block) noexcept;
+
+  /// \return The number of bytes currently mapped for huge pages.
+  static std::size_t mapped_bytes();
+
+  /// Deleter of arrays in storage from allocate(), e.g. for std::unique_ptr
+  struct Deleter {
+    /// Give back the storage \p block.
+    void operator()(void *block) const noexcept { deallocate(block); }
+  };
+};
+
+/**
+ * Allocator taking the storage of containers from HugePages, meant for the
+ * containers of large arrays. All instances are interchangeable.
+ *
+ * \tparam T The type of the elements.
+ */
+template <typename T>
+class HugePageAllocator {
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "The elements cannot be aligned more than by operator new.");
+
+ public:
+  /// The type of the elements
+  using value_type = T;
+
+  /// Create an allocator.
+  HugePageAllocator() noexcept = default;
+  /// Create an allocator from one for another type of elements.
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U> &) noexcept {}  // NOLINT
+
+  /**
+   * \return Storage for \p n elements.
+   * \throw std::bad_array_new_length if the size overflows.
+   */
+  T *allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(HugePages::allocate(n * sizeof(T)));
+  }
+  /// Give back the storage \p block of \p n elements.
+  void deallocate(T *block, std::size_t) noexcept {
+    HugePages::deallocate(block);
+  }
+
+  /// \return Always true, since the memory of any instance can be freed.
+  template <typename U>
+  bool operator==(const HugePageAllocator<U> &) const noexcept {
+    return true;
+  }
+  /// \return Always false, since the memory of any instance can be freed.
+  template <typename U>
+  bool operator!=(const HugePageAllocator<U> &) const noexcept {
+    return false;
+  }
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_HUGEPAGES_H_
@@ -49,12 +49,12 @@ class HyperSurfaceCrossActionsFinder : public ActionFinderInterface {
    * \return List of all found hypersurface crossings.
    */
   ActionList find_actions_in_cell(
-      const ParticleList &plist, double dt, const double,
+      ParticleSpan plist, double dt, const double,
       const std::vector<FourVector> &beam_momentum) const override;
 
   /// Ignore the neighbor searches for hypersurface crossing
   ActionList find_actions_with_neighbors(
-      const ParticleList &, const ParticleList &, double,
+      ParticleSpan, ParticleSpan, double,
       const std::vector<FourVector> &) const override {
     return {};
   }
@@ -65,10 +65,19 @@ class HyperSurfaceCrossActionsFinder : public ActionFinderInterface {
       const std::vector<FourVector> &) const override {
     return {};
   }
+  /// Ignore the surrounding searches for hypersurface crossing
+  ActionList find_actions_with_surrounding_particles(
+      const ParticleList &, const std::vector<const ParticleData *> &, double,
+      const std::vector<FourVector> &) const override {
+    return {};
+  }
 
   /// No final actions for hypersurface crossing
   ActionList find_final_actions(const Particles &) const override { return {}; }
 
+  /// \return The name of the finder in the time profile
+  std::string name() const override { return "hypersurface crossing finder"; }
+
   /**
    * Gives a warning if \p number_of_particles is not 0 and there are no
    * kinematic cuts. If this is the case, it may be that the end time set
@@ -104,28 +113,31 @@ class HyperSurfaceCrossActionsFinder : public ActionFinderInterface {
   /**
    * Determine whether particle crosses hypersurface within next timestep
    * during propagation
-   * \param[in] pdata_before_propagation Particle data at the beginning of time
+   * \param[in] position_before Particle position at the beginning of time
    *            step in question
-   * \param[in] pdata_after_propagation Particle data at the end of time step
+   * \param[in] position_after Particle position at the end of time step
    *            in question
    * \param[in] tau Proper time of the hypersurface that is tested
    * \return Does particle cross the hypersurface?
    */
-  bool crosses_hypersurface(ParticleData &pdata_before_propagation,
-                            ParticleData &pdata_after_propagation,
+  bool crosses_hypersurface(const FourVector &position_before,
+                            const FourVector &position_after,
                             const double tau) const;
 
   /**
    * Find the coordinates where particle crosses hypersurface
-   * \param[in] pdata_before_propagation Particle data at the beginning of time
+   * \param[in] position_before Particle position at the beginning of time
    *            in question
-   * \param[in] pdata_after_propagation Particle data at the end of time step
+   * \param[in] position_after Particle position at the end of time step
    *            in question
+   * \param[in] velocity Velocity with which the particle is propagated to the
+   *            crossing
    * \param[in] tau Proper time of the hypersurface that is crossed
    * \return Fourvector of the crossing position
    */
-  FourVector coordinates_on_hypersurface(ParticleData &pdata_before_propagation,
-                                         ParticleData &pdata_after_propagation,
+  FourVector coordinates_on_hypersurface(const FourVector &position_before,
+                                         const FourVector &position_after,
+                                         const ThreeVector &velocity,
                                          const double tau) const;
 };
 
@@ -24,6 +24,7 @@
 #include "forwarddeclarations.h"
 #include "key.h"
 #include "pdgcode.h"
+#include "pdgcode_constants.h"
 
 namespace smash {
 
@@ -78,6 +79,9 @@ struct InputSections {
   /// Subsection for the minimum-nonempty-ensembles mechanism
   inline static const Section g_minEnsembles =
       InputSections::general + "Minimum_Nonempty_Ensembles";
+  /// Subsection for the adaptive time step
+  inline static const Section g_adaptiveTimeStep =
+      InputSections::general + "Adaptive_Time_Step";
 
   /// Section for the lattice
   inline static const Section lattice{"Lattice"};
@@ -141,6 +145,9 @@ struct InputSections {
   /// Subsection for the output collisions content
   inline static const Section o_collisions =
       InputSections::output + "Collisions";
+  /// Subsection for the filter of the output collisions content
+  inline static const Section o_c_filter =
+      InputSections::o_collisions + "Filter";
   /// Subsection for the output Coulomb content
   inline static const Section o_coulomb = InputSections::output + "Coulomb";
   /// Subsection for the output dileptons content
@@ -150,12 +157,20 @@ struct InputSections {
       InputSections::output + "Initial_Conditions";
   /// Subsection for the output particles content
   inline static const Section o_particles = InputSections::output + "Particles";
+  /// Subsection for the filter of the output particles content
+  inline static const Section o_p_filter =
+      InputSections::o_particles + "Filter";
+  /// Subsection for the output performance content
+  inline static const Section o_performance =
+      InputSections::output + "Performance";
   /// Subsection for the output photons content
   inline static const Section o_photons = InputSections::output + "Photons";
   /// Subsection for the output Rivet content
   inline static const Section o_rivet = InputSections::output + "Rivet";
   /// Subsection for the output Rivet weights information
   inline static const Section o_r_weights = InputSections::o_rivet + "Weights";
+  /// Subsection for the output spectra content
+  inline static const Section o_spectra = InputSections::output + "Spectra";
   /// Subsection for the output thermodynamics content
   inline static const Section o_thermodynamics =
       InputSections::output + "Thermodynamics";
@@ -330,6 +345,32 @@ struct InputSections {
  * of non-empty events.
  */
 
+/*!\Userguide
+ * \page doxypage_input_conf_general_ats
+ *
+ * With <tt>\ref key_gen_time_step_mode_ "Time_Step_Mode"</tt> set to
+ * `"Adaptive"`, the evolution starts with time steps of
+ * <tt>\ref key_gen_delta_time_ "Delta_Time"</tt>, whose duration is adapted
+ * after every step. The next time step is the largest one for which the
+ * number of interactions per particle, the change of the net baryon density on
+ * the lattice and the momentum change due to potentials, as observed in the
+ * previous time step and scaled linearly with the duration, stay below the
+ * targets given in the optional `Adaptive_Time_Step` section. The time step is
+ * limited by the given bounds and grows at most by the given factor per step.
+ *
+ * Output times are not affected, since the output is written in between the
+ * actions of a time step. The adaptive time step cannot be used with the box
+ * modus or the stochastic collision criterion.
+ *\verbatim
+ General:
+     Time_Step_Mode: "Adaptive"
+     Delta_Time: 0.1
+     Adaptive_Time_Step:
+         Minimum_Delta_Time: 0.05
+         Maximum_Delta_Time: 2.0
+ \endverbatim
+ */
+
 /*!\Userguide
  * \page doxypage_input_conf_logging
  *
@@ -1230,7 +1271,64 @@ struct InputKeys {
 
   /*!\Userguide
    * \page doxypage_input_conf_general
-   * \optional_key_no_line{key_gen_delta_time_,Delta_Time,double,1.0}
+   * \optional_key_no_line{key_gen_action_queue_,Action_Queue,string,
+   * "BinaryHeap"}
+   *
+   * The kind of queue in which the found actions are kept, ordered by their
+   * time of execution, while the particles are propagated from action to
+   * action. Possible values:
+   * - `"BinaryHeap"` &rarr; A binary heap.
+   * - `"Calendar"` &rarr; A calendar queue, distributing the actions over
+   *   buckets of equal width in time. It avoids the logarithmic cost of the
+   *   heap and can be faster if many actions are found in every time step,
+   *   e.g. in dense boxes.
+   *
+   * Both queues perform the actions in exactly the same order, with actions
+   * at equal times being performed in the order in which they were found.
+   * Hence, the choice does not affect the results.
+   */
+  /**
+   * \see_key{key_gen_action_queue_}
+   */
+  inline static const Key<ActionQueue> gen_actionQueue{
+      InputSections::general + "Action_Queue", ActionQueue::BinaryHeap,
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_checkpoint_interval_,Checkpoint_Interval,int,0}
+   *
+   * Number of time steps after which the state of the running event is written
+   * to the file `checkpoint.bin` in the output directory, at the beginning of
+   * a time step. A checkpoint is also written at the beginning of the next
+   * time step if SMASH receives the `SIGUSR1` signal, e.g. shortly before the
+   * wall time limit of a batch job. Every checkpoint replaces the previous
+   * one. A run is continued from a checkpoint with the `--restart` command
+   * line option and the same configuration, see \ref
+   * doxypage_smash_invocation. With the same build of SMASH, the continued run
+   * reproduces the uninterrupted one bit by bit.
+   *
+   * The checkpoint holds the particles of all ensembles, the clocks, the
+   * states of the random number engines and the counters of the event. The
+   * outputs of the continued run start at the checkpoint, the earlier events
+   * and the start of the interrupted event are found in the outputs of the
+   * interrupted run. Checkpoints are only possible in the box and sphere
+   * modi, without potentials, string fragmentation, forced thermalization,
+   * initial conditions for hybrid models and concurrent events, whose states
+   * are not written.
+   *
+   * With the default value of 0, checkpoints are only written on request.
+   * Negative values are not allowed.
+   */
+  /**
+   * \see_key{key_gen_checkpoint_interval_}
+   */
+  inline static const Key<int> gen_checkpointInterval{
+      InputSections::general + "Checkpoint_Interval", 0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_delta_time_,Delta_Time,double,1.0}
    *
    * Fixed time step \unit{in fm} at which the collision-finding grid is
    * recreated, and, if potentials are on, momenta are updated according to the
@@ -1293,6 +1391,61 @@ struct InputKeys {
   inline static const Key<double> gen_smearingDiscreteWeight{
       InputSections::general + "Discrete_Weight", 1. / 3, {"2.1"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_ensemble_threads_,Ensemble_Threads,int,1}
+   *
+   * Number of threads used to evolve the parallel ensembles of an event
+   * concurrently. The creation of the grid, the search for actions and the
+   * timestepless propagation are then distributed over the ensembles, while
+   * the computation of densities and potentials couples them as usual at the
+   * end of each time step. The output is written in the same order as for a
+   * serial run, ensemble by ensemble, after each concurrent step.
+   *
+   * With the default value of 1, all ensembles are evolved one after the
+   * other. Larger values must not exceed the number of <tt>\ref
+   * key_gen_ensembles_ "Ensembles"</tt>. In this mode, each ensemble uses its
+   * own random number stream, which is derived at the beginning of every event
+   * from the random seed of the event. Hence, results do not depend on the
+   * number of threads, but they differ from those of a serial run with the
+   * same random seed. An exception are processes involving string
+   * fragmentation: they are performed one at a time, because the underlying
+   * PYTHIA objects are shared among the ensembles, and their results depend on
+   * the order in which the threads get to them. The same holds for the rare
+   * automatic adjustments of the bounds used to sample resonance masses.
+   *
+   * \note Pauli blocking needs the particles of all ensembles, hence, the
+   * timestepless propagation is not parallelized if it is enabled.
+   */
+  /**
+   * \see_key{key_gen_ensemble_threads_}
+   */
+  inline static const Key<int> gen_ensembleThreads{
+      InputSections::general + "Ensemble_Threads", 1, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_threads_,Threads,int,1}
+   *
+   * Number of threads executing the tasks of a time step, if <tt>\ref
+   * key_gen_ensemble_threads_ "Ensemble_Threads"</tt> is not given, which
+   * takes precedence. It is limited to the number of <tt>\ref
+   * key_gen_ensembles_ "Ensembles"</tt>.
+   *
+   * With more than one thread, the search for actions, the neighbor index of
+   * the collision partners and the timestepless propagation of every ensemble
+   * are dependent tasks. In time steps without intermediate output, each
+   * ensemble is then propagated as soon as its own actions are found, instead
+   * of waiting for the search in all ensembles. The results are the same as
+   * with the corresponding number of <tt>\ref key_gen_ensemble_threads_
+   * "Ensemble_Threads"</tt>.
+   */
+  /**
+   * \see_key{key_gen_threads_}
+   */
+  inline static const Key<int> gen_threads{InputSections::general + "Threads",
+                                           1, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_ensembles_,Ensembles,int,1}
@@ -1323,6 +1476,63 @@ struct InputKeys {
   inline static const Key<int> gen_ensembles{
       InputSections::general + "Ensembles", 1, {"2.1"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_event_threads_,Event_Threads,int,1}
+   *
+   * Number of events simulated concurrently within the same SMASH process.
+   * Each thread evolves its own copy of the experiment, while the particle
+   * types, decay modes and tabulated resonance integrals are shared among them.
+   * The events are handed out in batches of this size and the output of each
+   * batch is written by a single writer in the order of the event numbers,
+   * hence the output files look as if the events had been simulated one after
+   * the other.
+   *
+   * Event numbers and random seeds are assigned exactly as in a serial run.
+   * Hence, as far as the events are independent of each other, the results do
+   * not depend on the number of threads and they are identical to those of a
+   * serial run with the same random seed.
+   *
+   * With the default value of 1, the events are simulated one after the other.
+   * Larger values require a fixed number of events, i.e. the <tt>\ref
+   * key_gen_nevents_ "Nevents"</tt> key. They can neither be used in the
+   * `List` and `ListBox` modi nor with custom nuclei, which read the events
+   * one after the other from files, nor with the forced thermalization, whose
+   * output cannot be buffered.
+   */
+  /**
+   * \see_key{key_gen_event_threads_}
+   */
+  inline static const Key<int> gen_eventThreads{
+      InputSections::general + "Event_Threads", 1, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_longest_events_first_,Longest_Events_First,bool,
+   * false}
+   *
+   * Only used if events are simulated concurrently, see <tt>\ref
+   * key_gen_event_threads_ "Event_Threads"</tt>. Instead of handing out the
+   * events in batches of one event per thread, every thread takes the next
+   * event as soon as it has finished the previous one, such that no thread
+   * waits for the slowest event of a batch. In the `Collider` modus, the
+   * impact parameters of all events are drawn before the run, exactly as
+   * they will be drawn in the events. The events are then handed out in
+   * windows of eight events per thread, within which the most central events,
+   * which have the most participants and take longest, come first. Hence, the
+   * last events of the run are short and the threads finish at about the same
+   * time.
+   *
+   * The events, their seeds and the order of the events in the outputs are the
+   * same as without this option. The output of an event is kept in memory
+   * until all events with smaller numbers are written.
+   */
+  /**
+   * \see_key{key_gen_longest_events_first_}
+   */
+  inline static const Key<bool> gen_longestEventsFirst{
+      InputSections::general + "Longest_Events_First", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_expansion_rate_,Expansion_Rate,double,0.1}
@@ -1372,6 +1582,48 @@ struct InputKeys {
       FieldDerivativesMode::ChainRule,
       {"2.1"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_fork_time_,Fork_Time,double,start time of the event}
+   *
+   * Time \unit{in fm} at which the events are forked, if `Forks_Per_Event` is
+   * larger than 1. The snapshot of the event is taken at the beginning of the
+   * first time step at or after this time. By default, the events are forked
+   * right after their initial conditions. The fork time has to lie before the
+   * `End_Time`.
+   */
+  /**
+   * \see_key{key_gen_fork_time_}
+   */
+  inline static const Key<double> gen_forkTime{
+      InputSections::general + "Fork_Time", {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_forks_per_event_,Forks_Per_Event,int,1}
+   *
+   * Number of events which share the evolution of one initial state up to the
+   * `Fork_Time`. A snapshot of the event is kept in memory at that time, and
+   * the following events continue from it instead of sampling new initial
+   * conditions, each with its own random number streams. This saves the
+   * sampling of the initial conditions and the evolution before the fork for
+   * all but the first of these events, e.g. to collect rare probes emitted
+   * from the later stages at a lower cost.
+   *
+   * The forked events are counted in `Nevents` and numbered like all others.
+   * Only the first event of a group holds the interactions before the fork in
+   * the outputs, the outputs of the others start at the snapshot. The forks
+   * are not independent samples of the initial state and its early stage,
+   * which has to be accounted for in the statistical errors. Forks are not
+   * possible with potentials, forced thermalization, initial conditions for
+   * hybrid models and concurrent events.
+   */
+  /**
+   * \see_key{key_gen_forks_per_event_}
+   */
+  inline static const Key<int> gen_forksPerEvent{
+      InputSections::general + "Forks_Per_Event", 1, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_gauss_cutoff_in_sigma_,Gauss_Cutoff_In_Sigma,double,4.0}
@@ -1398,6 +1650,121 @@ struct InputKeys {
   inline static const Key<double> gen_smearingGaussianSigma{
       InputSections::general + "Gaussian_Sigma", 1.0, {"0.60"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_grid_threads_,Grid_Threads,int,1}
+   *
+   * Number of threads used to search for actions in the cells of the grid.
+   * The grid is split into rows of cells along the x direction, which are
+   * handed out to the threads one at a time, such that threads finishing their
+   * rows early pick up the remaining ones. The actions found in each row are
+   * collected separately and merged in the order of the rows at the end of the
+   * search. Each row draws random numbers from its own engine, seeded from the
+   * engine of the ensemble, hence the found actions do not depend on the number
+   * of threads, but they differ from those of a serial search with the same
+   * random seed.
+   *
+   * The same threads generate the final states of the decays of the remaining
+   * resonances at the end of the event, each decay with its own engine, before
+   * the decays are performed and written to the outputs in a fixed order.
+   *
+   * With the default value of 1, the cells are searched one after the other.
+   * This option can not be combined with more than one <tt>\ref
+   * key_gen_ensemble_threads_ "Ensemble_Threads"</tt>, since the ensembles
+   * would then already be searched concurrently.
+   */
+  /**
+   * \see_key{key_gen_grid_threads_}
+   */
+  inline static const Key<int> gen_gridThreads{
+      InputSections::general + "Grid_Threads", 1, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_lazy_propagation_,Lazy_Propagation,bool,false}
+   *
+   * Whether, in between the time steps, only the particles taking part in an
+   * action are propagated to its time, together with the particles close
+   * enough to collide with its outgoing particles, instead of all particles
+   * before every action. All particles are propagated to the end of every time
+   * step and to the output times, such that the results are the same up to
+   * rounding, but the propagation of large systems with many actions is much
+   * faster. Dileptons are shined by every particle for the time it propagated
+   * freely.
+   *
+   * This option has no effect without the grid (see \ref key_gen_use_grid_),
+   * with the stochastic collision criterion, with Pauli blocking or if the
+   * density is written to the collision output, since all of these need the
+   * positions of all particles at the time of every action.
+   */
+  /**
+   * \see_key{key_gen_lazy_propagation_}
+   */
+  inline static const Key<bool> gen_lazyPropagation{
+      InputSections::general + "Lazy_Propagation", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_lazy_tabulations_,Lazy_Tabulations,bool,false}
+   *
+   * Whether the integrals over the spectral functions of the resonances, which
+   * enter the cross sections of resonance production, are only tabulated when
+   * a cross section needs them for the first time. By default, all of them
+   * are tabulated before the first event, which takes a while whenever the
+   * particles or decay modes changed and no tabulations are found in the
+   * tabulations directory. Lazily computed tables are stored there as well.
+   * The tables are the same in both cases, hence so are the results.
+   */
+  /**
+   * \see_key{key_gen_lazy_tabulations_}
+   */
+  inline static const Key<bool> gen_lazyTabulations{
+      InputSections::general + "Lazy_Tabulations", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_memory_limit_,Memory_Limit,double,0.0}
+   *
+   * Soft limit in MiB of the memory used by the particles, the action queues,
+   * the grids, the lattices and the data kept by the outputs, which is
+   * measured once per time step. While the limit is exceeded, the grids are
+   * not kept between the time steps, the particles are compacted in every time
+   * step and the action queues drop the removed actions early. SMASH is not
+   * stopped if the memory stays above the limit. The measured memory is
+   * written in the \ref doxypage_output_performance "Performance" output as
+   * well. With the default value of 0, there is no limit. The limit does not
+   * change the physics.
+   */
+  /**
+   * \see_key{key_gen_memory_limit_}
+   */
+  inline static const Key<double> gen_memoryLimit{
+      InputSections::general + "Memory_Limit", 0.0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_huge_pages_,Huge_Pages,bool,false}
+   *
+   * Whether the storage of the particles of the ensembles and of the nodes of
+   * the lattices is backed by huge pages of 2 MB, once it takes at least one
+   * of them. These arrays are accessed at random by the smearing and the
+   * gradients of the potentials, such that huge pages avoid most misses of the
+   * translation lookaside buffer, see the `dtlb_misses` of \ref
+   * key_gen_hardware_counters_ "Hardware_Counters".
+   *
+   * The pages reserved for hugetlbfs in \c /proc/sys/vm/nr_hugepages are used
+   * if available, otherwise the storage is advised to be backed by transparent
+   * huge pages, which the kernel provides if
+   * \c /sys/kernel/mm/transparent_hugepage/enabled is not `never`. If neither
+   * is possible, e.g. on other systems than Linux, the storage is allocated as
+   * usual. Huge pages do not change the physics.
+   */
+  /**
+   * \see_key{key_gen_huge_pages_}
+   */
+  inline static const Key<bool> gen_hugePages{
+      InputSections::general + "Huge_Pages", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_metric_type_,Metric_Type,string,"NoExpansion"}
@@ -1417,6 +1784,175 @@ struct InputKeys {
       ExpansionMode::NoExpansion,
       {"1.1"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_particles_compaction_threshold_,
+   * Particles_Compaction_Threshold,double,1.0}
+   *
+   * Fraction of holes in the storage of the particles of an ensemble above
+   * which the holes are closed at the beginning of a time step. Holes are left
+   * by the particles which are removed in decays and collisions and, as long
+   * as they are not reused by new particles, they have to be skipped whenever
+   * the particles are iterated over. Compacting the storage keeps the ids and
+   * the order of the particles, but new particles are then appended behind the
+   * existing ones instead of filling the holes. This changes the order of the
+   * particles afterwards and hence the sequence of random numbers, but not the
+   * physics. A value of e.g. 0.25 is useful in long runs, in which the number
+   * of particles decreases and holes accumulate.
+   *
+   * The value has to be positive. With the default value of 1, the storage is
+   * never compacted.
+   */
+  /**
+   * \see_key{key_gen_particles_compaction_threshold_}
+   */
+  inline static const Key<double> gen_particlesCompactionThreshold{
+      InputSections::general + "Particles_Compaction_Threshold", 1.0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_particles_reordering_interval_,
+   * Particles_Reordering_Interval,int,0}
+   *
+   * Number of time steps after which the particles of every ensemble are
+   * reordered in memory along a Morton curve through the volume they occupy,
+   * at the beginning of a time step. Particles created in the course of the
+   * evolution are otherwise stored in the order of their creation, such that
+   * spatial neighbors are scattered in memory when the grid and the lattices
+   * are filled. The ids of the particles are kept, but the particles are
+   * iterated over and written to the outputs in the new order. This changes
+   * the sequence of random numbers, but not the physics, and the smeared
+   * densities change in the last digits.
+   *
+   * With the default value of 0, the particles are never reordered. Negative
+   * values are not allowed.
+   */
+  /**
+   * \see_key{key_gen_particles_reordering_interval_}
+   */
+  inline static const Key<int> gen_particlesReorderingInterval{
+      InputSections::general + "Particles_Reordering_Interval", 0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_freeze_out_window_,Freeze_Out_Window,int,0}
+   *
+   * Number of time steps without any interaction after which SMASH checks
+   * whether the system has frozen out, i.e. whether only stable particles are
+   * left which move away from each other. From then on, the grid is no longer
+   * created and no actions are searched for until the end time, while the
+   * particles are still propagated and written to the outputs as before, such
+   * that the outputs are identical. If the system has not frozen out, the
+   * next check is done after twice as many quiet time steps.
+   *
+   * The check is never successful with potentials, an expanding metric, the
+   * box modus, forced thermalization, initial conditions output, pending
+   * forks or the stochastic collision criterion. With the default value of 0,
+   * the actions are searched for until the end time. Negative values are not
+   * allowed.
+   */
+  /**
+   * \see_key{key_gen_freeze_out_window_}
+   */
+  inline static const Key<int> gen_freezeOutWindow{
+      InputSections::general + "Freeze_Out_Window", 0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_pin_threads_,Pin_Threads,bool,false}
+   *
+   * Whether the threads evolving the ensembles, searching the grid and
+   * smearing onto the lattices are bound to CPUs. The threads of each kind are
+   * spread evenly over the CPUs SMASH may run on, which can be restricted e.g.
+   * by `taskset` or `numactl`. A pinned thread always works on the same
+   * ensembles, grid rows and lattice tiles, and the storage of its ensembles
+   * is allocated by itself at the beginning of every event. On machines with
+   * several sockets, this keeps the memory of an ensemble on the NUMA node of
+   * the thread evolving it. The lattices shared by the ensembles are allocated
+   * once, their pages can be spread over the nodes with `numactl
+   * --interleave=all`. The results do not depend on this setting.
+   *
+   * Pinning is only supported on Linux and it cannot be combined with <tt>\ref
+   * key_gen_event_threads_ "Event_Threads"</tt>, since the threads of the
+   * concurrent events would be bound to the same CPUs.
+   */
+  /**
+   * \see_key{key_gen_pin_threads_}
+   */
+  inline static const Key<bool> gen_pinThreads{
+      InputSections::general + "Pin_Threads", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_prepare_next_event_,Prepare_Next_Event,bool,false}
+   *
+   * Whether the initial particles of the next event are sampled on a separate
+   * thread, while the current event is evolved. This takes the initial
+   * conditions off the critical path of short events. The results are the
+   * same as without preparation, since the next event is prepared with its
+   * own seed. Together with `Output: Asynchronous_Writing`, also the output of
+   * the finished event is written while the next one is evolved.
+   *
+   * The preparation is only possible in the box, sphere and list modi, whose
+   * state is not used during the evolution, and not with concurrent events.
+   */
+  /**
+   * \see_key{key_gen_prepare_next_event_}
+   */
+  inline static const Key<bool> gen_prepareNextEvent{
+      InputSections::general + "Prepare_Next_Event", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_profiling_,Profiling,bool,false}
+   *
+   * Whether the time spent in the phases of the evolution is measured and
+   * reported in the log, for every event and summed up over all events at the
+   * end of the run. The phases are the thermalization, the fluidization
+   * lattice, the building of the grid, the search of every action finder, the
+   * propagation, the timestepless propagation of an ensemble including its
+   * actions, the performing of the actions of every process type, the Pauli
+   * blocking, the potentials with the smearing of the densities onto their
+   * lattices, the update of the momenta and the callbacks of every output. The times of concurrently evolved ensembles or events are
+   * summed up, and the time of an action includes its output.
+   * Switching the profiling on does not change the physics.
+   */
+  /**
+   * \see_key{key_gen_profiling_}
+   */
+  inline static const Key<bool> gen_profiling{
+      InputSections::general + "Profiling", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_hardware_counters_,Hardware_Counters,bool,false}
+   *
+   * Whether the cycles, instructions, misses of the last level cache, misses
+   * of the data TLB and branch misses of the profiled phases are counted by
+   * the hardware performance counters of the CPU, as well as their times.
+   * The counts are reported next to the times of the phases in the \ref
+   * doxypage_output_performance "performance output" and in the benchmark
+   * report of the \c --benchmark command line option. This switches the
+   * profiling on, even if neither \ref key_gen_profiling_ "Profiling" nor the
+   * performance output are requested, but does not log the time profiles.
+   *
+   * The counters are only available on Linux, through \c perf_event_open(2),
+   * and count the events in the user space of the thread running a phase.
+   * Work that a phase hands over to a pool of threads, like the lattice
+   * threads, is not counted, unless the pool measures it in a phase of its
+   * own. If the counters are not available, e.g. since
+   * \c /proc/sys/kernel/perf_event_paranoid is larger than 2 or in a
+   * container without access to them, a warning is printed and only the
+   * times are measured. Events which the CPU does not support are left out of
+   * the reports. Reading the counters takes two system calls for every
+   * measured phase, which slows down runs with many short actions noticeably.
+   */
+  /**
+   * \see_key{key_gen_hardware_counters_}
+   */
+  inline static const Key<bool> gen_hardwareCounters{
+      InputSections::general + "Hardware_Counters", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_rfdd_mode_,Rest_Frame_Density_Derivatives_Mode,string,"Off"}
@@ -1443,6 +1979,25 @@ struct InputKeys {
           RestFrameDensityDerivativesMode::Off,
           {"2.1", "3.0", "3.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_shared_tabulations_,Shared_Tabulations,bool,false}
+   *
+   * Whether the tabulated integrals over the spectral functions of the
+   * resonances are kept in a single file <tt>resonance_integrals.bin</tt> in
+   * the tabulations directory, which is mapped into memory instead of being
+   * read. All SMASH processes on a node using the same file then share one
+   * copy of the tables in memory. The file is written by the first run, which
+   * needs a table missing in it, and is used only for the same particles and
+   * decay modes. The tables are the same as without this option. This has no
+   * effect if no tabulations directory is used.
+   */
+  /**
+   * \see_key{key_gen_shared_tabulations_}
+   */
+  inline static const Key<bool> gen_sharedTabulations{
+      InputSections::general + "Shared_Tabulations", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_smearing_mode_,Smearing_Mode,string,"Covariant
@@ -1502,6 +2057,23 @@ struct InputKeys {
       SmearingMode::CovariantGaussian,
       {"2.1"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_tabulation_threads_,Tabulation_Threads,int,1}
+   *
+   * Number of threads tabulating the integrals over the spectral functions of
+   * the resonances before the first event. Every table is computed by one
+   * thread on its own, hence the tables do not depend on the number of
+   * threads. With the default value of 1, the tables are computed one after
+   * the other. This has no effect with <tt>\ref key_gen_lazy_tabulations_
+   * "Lazy_Tabulations"</tt>.
+   */
+  /**
+   * \see_key{key_gen_tabulation_threads_}
+   */
+  inline static const Key<int> gen_tabulationThreads{
+      InputSections::general + "Tabulation_Threads", 1, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_testparticles_,Testparticles,int,1}
@@ -1542,6 +2114,9 @@ struct InputKeys {
    * - `"Fixed"`&rarr; Fixed-sized time steps at which collision-finding grid is
    *   created. More efficient for systems with many particles. The `Delta_Time`
    *   is provided by user.
+   * - `"Adaptive"` &rarr; Time steps starting with `Delta_Time`, whose size is
+   *   adapted after every step to the evolution of the system, see
+   *   \ref doxypage_input_conf_general_ats "adaptive time step".
    *
    * For `Delta_Time` explanation see \ref key_gen_delta_time_ "here".
    *
@@ -1556,6 +2131,23 @@ struct InputKeys {
   inline static const Key<TimeStepMode> gen_timeStepMode{
       InputSections::general + "Time_Step_Mode", TimeStepMode::Fixed, {"0.85"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_trace_events_,Trace_Events,int,0}
+   *
+   * Maximal number of spans of the profiled phases kept for the trace of the
+   * run, see \ref doxypage_output_trace. If positive, the phases are measured
+   * as for \ref key_gen_profiling_ "Profiling" and the latest spans are written
+   * to trace.json in the output directory at the end of the run. Every span
+   * takes a few dozen bytes. With the default value of 0, no trace is recorded.
+   * Recording the trace does not change the physics.
+   */
+  /**
+   * \see_key{key_gen_trace_events_}
+   */
+  inline static const Key<int> gen_traceEvents{
+      InputSections::general + "Trace_Events", 0, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_general
    * \optional_key{key_gen_triangular_range_,Triangular_Range,double,2.0}
@@ -1583,6 +2175,110 @@ struct InputKeys {
   inline static const Key<bool> gen_useGrid{
       InputSections::general + "Use_Grid", true, {"0.80"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_general
+   * \optional_key{key_gen_workload_sampling_,Workload_Sampling,int,0}
+   *
+   * Interval at which the inputs of the hot kernels are recorded to
+   * workload.bin in the output directory, see \ref doxypage_output_workload.
+   * If positive, every n-th pair checked for a collision, lattice update and
+   * string excitation is recorded, such that the kernels can be replayed with
+   * the species and energies of the run by \c smash_replay. Every recorded
+   * pair takes about 150 bytes, a lattice update about 70 bytes per particle.
+   * With the default value of 0, no workload is recorded. Recording the
+   * workload does not change the physics.
+   */
+  /**
+   * \see_key{key_gen_workload_sampling_}
+   */
+  inline static const Key<int> gen_workloadSampling{
+      InputSections::general + "Workload_Sampling", 0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general_ats
+   * \optional_key_no_line{key_gen_ats_ipp_,Interactions_Per_Particle,double,0.1}
+   *
+   * Desired number of interactions per particle in one time step. If more
+   * interactions were performed in the previous time step, the time step is
+   * shortened accordingly, and vice versa. Wall crossings are not counted.
+   */
+  /**
+   * \see_key{key_gen_ats_ipp_}
+   */
+  inline static const Key<double> gen_adaptiveTimeStep_interactionsPerParticle{
+      InputSections::g_adaptiveTimeStep + "Interactions_Per_Particle", 0.1,
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general_ats
+   * \optional_key{key_gen_ats_max_dt_,Maximum_Delta_Time,double,1.0}
+   *
+   * Largest time step \unit{in fm}. It is reached, e.g., late in the
+   * evolution, when the system is dilute.
+   */
+  /**
+   * \see_key{key_gen_ats_max_dt_}
+   */
+  inline static const Key<double> gen_adaptiveTimeStep_maximumDeltaTime{
+      InputSections::g_adaptiveTimeStep + "Maximum_Delta_Time", 1.0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general_ats
+   * \optional_key{key_gen_ats_max_growth_,Maximum_Growth_Factor,double,2.0}
+   *
+   * Largest factor by which the time step may grow from one step to the next.
+   * Shorter time steps are applied right away. It must not be smaller than 1.
+   */
+  /**
+   * \see_key{key_gen_ats_max_growth_}
+   */
+  inline static const Key<double> gen_adaptiveTimeStep_maximumGrowthFactor{
+      InputSections::g_adaptiveTimeStep + "Maximum_Growth_Factor", 2.0,
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general_ats
+   * \optional_key{key_gen_ats_min_dt_,Minimum_Delta_Time,double,0.01}
+   *
+   * Smallest time step \unit{in fm}, which is used even if the targets of the
+   * other keys would require shorter time steps.
+   */
+  /**
+   * \see_key{key_gen_ats_min_dt_}
+   */
+  inline static const Key<double> gen_adaptiveTimeStep_minimumDeltaTime{
+      InputSections::g_adaptiveTimeStep + "Minimum_Delta_Time", 0.01, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general_ats
+   * \optional_key{key_gen_ats_pot_safety_,Potentials_Safety_Factor,double,0.1}
+   *
+   * If potentials are used, the time step is at most this fraction of the
+   * smallest time scale \f$E/|\mathbf{F}|\f$ of the momentum change of the
+   * particles in the previous time step.
+   */
+  /**
+   * \see_key{key_gen_ats_pot_safety_}
+   */
+  inline static const Key<double> gen_adaptiveTimeStep_potentialsSafetyFactor{
+      InputSections::g_adaptiveTimeStep + "Potentials_Safety_Factor", 0.1,
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_general_ats
+   * \optional_key{key_gen_ats_rho_change_,Relative_Density_Change,double,0.1}
+   *
+   * Desired maximal change of the net baryon density on the lattice in one time
+   * step, relative to the largest density on the lattice. It is only used if
+   * the net baryon density is computed on a lattice, e.g. for potentials.
+   */
+  /**
+   * \see_key{key_gen_ats_rho_change_}
+   */
+  inline static const Key<double> gen_adaptiveTimeStep_relativeDensityChange{
+      InputSections::g_adaptiveTimeStep + "Relative_Density_Change", 0.1,
+      {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_logging
    * <hr>
@@ -2110,6 +2806,23 @@ struct InputKeys {
       0.0,
       {"2.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_alias_decay_channels_,Alias_Decay_Channels,bool,false}
+   *
+   * Whether the channel of a resonance decay is sampled from alias tables of
+   * the branching ratios, which are created at the start in bins of the mass
+   * of the resonance. A channel is then found in a constant time, but the
+   * branching ratios are only approximated by their values at the centre of
+   * the mass bin. Decays at the end of the simulation and decays in presence of
+   * potentials always use the exact partial widths.
+   */
+  /**
+   * \see_key{key_CT_alias_decay_channels_}
+   */
+  inline static const Key<bool> collTerm_aliasDecayChannels{
+      InputSections::collisionTerm + "Alias_Decay_Channels", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
    * \optional_key{key_CT_collision_criterion_,Collision_Criterion,string,"Covariant"}
@@ -2160,39 +2873,155 @@ struct InputKeys {
 
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
-   * \optional_key{key_CT_cs_scaling_,Cross_Section_Scaling,double,1.0}
+   * \optional_key{key_CT_cs_cache_,Cross_Section_Cache,bool,false}
    *
-   * Scale all cross sections by a global factor.
-   * \warning Most cross sections are constrained by experimental data. Scaling
-   * them will therefore lead to nonphysical results and is only meant for
-   * explorative studies.
+   * Whether to tabulate the total cross sections of pairs of stable particles
+   * in \f$\sqrt{s}\f$, in order to reject the pairs which are too far apart
+   * to collide without evaluating all their partial cross sections. The tables
+   * are filled while the collisions are searched and the cross sections of
+   * the actually constructed actions are always evaluated directly. With the
+   * stochastic criterion, no action is constructed for the pairs whose
+   * collision probability, estimated with the tabulated cross section, is
+   * below the drawn random number. The cache is not used with potentials.
+   * Pairs are rejected with an estimate of the cross section from above, whose
+   * margin is set by <tt>\ref key_CT_cs_cache_tolerance_
+   * "Cross_Section_Cache_Tolerance"</tt>. Where the total cross sections
+   * conserve isospin, which is checked at a few energies, the pairs of
+   * isospin multiplets share the tables of their isospin-reduced cross
+   * sections, from which the cross sections of their members are
+   * reconstructed with the Clebsch-Gordan coefficients.
    */
   /**
-   * \see_key{key_CT_cs_scaling_}
+   * \see_key{key_CT_cs_cache_}
    */
-  inline static const Key<double> collTerm_crossSectionScaling{
-      InputSections::collisionTerm + "Cross_Section_Scaling", 1.0, {"2.0"}};
+  inline static const Key<bool> collTerm_crossSectionCache{
+      InputSections::collisionTerm + "Cross_Section_Cache", false, {"3.4"}};
 
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
-   * \optional_key{key_CT_elastic_cross_section_,Elastic_Cross_Section,double,-1.0}
-   *
-   * If a non-negative value is given, it will override the parametrized
-   * elastic cross sections (which are energy-dependent) with a constant value
-   * \unit{in mb}. This constant elastic cross section is used for all
-   * collisions.
+   * \optional_key{key_CT_cs_cache_tolerance_,Cross_Section_Cache_Tolerance,
+   * double,0.05}
+   *
+   * Relative margin by which the tabulated cross sections are increased when
+   * pairs are rejected with the <tt>\ref key_CT_cs_cache_
+   * "Cross_Section_Cache"</tt>. Between two tabulated energies, the larger of
+   * the two cross sections is used. A larger tolerance rejects fewer pairs
+   * but makes it less likely that a pair is rejected whose directly evaluated
+   * cross section would be large enough for a collision. It must not be
+   * negative.
    */
   /**
-   * \see_key{key_CT_elastic_cross_section_}
+   * \see_key{key_CT_cs_cache_tolerance_}
    */
-  inline static const Key<double> collTerm_elasticCrossSection{
-      InputSections::collisionTerm + "Elastic_Cross_Section", -1.0, {"1.2"}};
+  inline static const Key<double> collTerm_crossSectionCacheTolerance{
+      InputSections::collisionTerm + "Cross_Section_Cache_Tolerance",
+      0.05,
+      {"3.4"}};
 
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
-   * \optional_key{key_CT_elastic_nn_cutoff_sqrts_,Elastic_NN_Cutoff_Sqrts,double,1.98}
+   * \optional_key{key_CT_cs_table_,Cross_Section_Table,string,""}
    *
-   * The elastic collisions between two nucleons with \f$\sqrt{s}\f$ below
+   * File from which the tables of the <tt>\ref key_CT_cs_cache_
+   * "Cross_Section_Cache"</tt>, which has to be enabled, are taken over at the
+   * start of the run instead of being filled while the collisions are
+   * searched. Such a file is written by the `--cross-section-table` option of
+   * the `smash` executable for all pairs of stable hadrons. It is only
+   * accepted for the same particle types, and a few tabulated cross sections
+   * of every pair are compared with directly evaluated ones, such that a file
+   * written with other decay modes or other settings of the collision term
+   * is rejected as well. By default, no file is read.
+   */
+  /**
+   * \see_key{key_CT_cs_table_}
+   */
+  inline static const Key<std::string> collTerm_crossSectionTable{
+      InputSections::collisionTerm + "Cross_Section_Table", "", {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_cs_scaling_,Cross_Section_Scaling,double,1.0}
+   *
+   * Scale all cross sections by a global factor.
+   * \warning Most cross sections are constrained by experimental data. Scaling
+   * them will therefore lead to nonphysical results and is only meant for
+   * explorative studies.
+   */
+  /**
+   * \see_key{key_CT_cs_scaling_}
+   */
+  inline static const Key<double> collTerm_crossSectionScaling{
+      InputSections::collisionTerm + "Cross_Section_Scaling", 1.0, {"2.0"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_dynamic_cell_size_,Dynamic_Cell_Size,bool,false}
+   *
+   * Whether the cells of the grid used to search for collisions are sized in
+   * every time step from the particles present in each ensemble, instead of
+   * from the <tt>\ref key_CT_max_cs_ "Maximum_Cross_Section"</tt>. For every
+   * pair of particle types present, the largest \f$\sqrt{s}\f$ of two of
+   * their particles is estimated from their largest energies and momenta,
+   * and the largest total cross section up to this energy is taken from the
+   * tables of the <tt>\ref key_CT_cs_cache_ "Cross_Section_Cache"</tt>,
+   * which has to be enabled. The cells are sized from the largest of these
+   * cross sections, increased by the <tt>\ref
+   * key_CT_dynamic_cell_size_safety_factor_
+   * "Dynamic_Cell_Size_Safety_Factor"</tt>, and never larger than with the
+   * maximum cross section. Smaller cells reduce the number of candidate
+   * pairs, while the same collisions are found.
+   *
+   * Like the cache, the estimate is only possible for stable particles with
+   * their pole masses and without potentials. Otherwise, e.g. as soon as
+   * resonances are present, the maximum cross section is used in that time
+   * step. The cells are not changed with the stochastic criterion.
+   */
+  /**
+   * \see_key{key_CT_dynamic_cell_size_}
+   */
+  inline static const Key<bool> collTerm_dynamicCellSize{
+      InputSections::collisionTerm + "Dynamic_Cell_Size", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_dynamic_cell_size_safety_factor_,
+   * Dynamic_Cell_Size_Safety_Factor,double,1.5}
+   *
+   * Factor by which the largest cross section estimated for the <tt>\ref
+   * key_CT_dynamic_cell_size_ "Dynamic_Cell_Size"</tt> and the <tt>\ref
+   * key_CT_stochastic_thinning_ "Stochastic_Thinning"</tt> is increased. It
+   * covers the energies closer to the threshold of a pair than the first
+   * tabulated one, where the cross section is not estimated. It must be at
+   * least 1.
+   */
+  /**
+   * \see_key{key_CT_dynamic_cell_size_safety_factor_}
+   */
+  inline static const Key<double> collTerm_dynamicCellSizeSafetyFactor{
+      InputSections::collisionTerm + "Dynamic_Cell_Size_Safety_Factor",
+      1.5,
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_elastic_cross_section_,Elastic_Cross_Section,double,-1.0}
+   *
+   * If a non-negative value is given, it will override the parametrized
+   * elastic cross sections (which are energy-dependent) with a constant value
+   * \unit{in mb}. This constant elastic cross section is used for all
+   * collisions.
+   */
+  /**
+   * \see_key{key_CT_elastic_cross_section_}
+   */
+  inline static const Key<double> collTerm_elasticCrossSection{
+      InputSections::collisionTerm + "Elastic_Cross_Section", -1.0, {"1.2"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_elastic_nn_cutoff_sqrts_,Elastic_NN_Cutoff_Sqrts,double,1.98}
+   *
+   * The elastic collisions between two nucleons with \f$\sqrt{s}\f$ below
    * the specified value (\unit{in GeV}) cannot happen.
    * - `Elastic_NN_Cutoff_Sqrts` < 1.88 &rarr;
    *   Below the threshold energy of the elastic collision, no effect.
@@ -2248,6 +3077,29 @@ struct InputKeys {
   inline static const Key<bool> collTerm_decayInitial{
       InputSections::collisionTerm + "Decay_Initial_Particles", true, {"3.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_presample_decay_times_,Presample_Decay_Times,bool,
+   * false}
+   *
+   * Sample the decay time of a resonance once, when it is found for the first
+   * time with its current momentum, and keep it until the resonance decays or
+   * its momentum changes, instead of sampling a new decay time in every time
+   * step. Since the exponential decay law has no memory, both give the same
+   * distribution of decay times, but the width of a resonance is only
+   * evaluated once per momentum and no decay actions are created for
+   * resonances which decay in later time steps. The decay times are kept per
+   * ensemble. With potentials, the widths depend on the position of the
+   * resonance and new decay times are sampled in every time step, as well as
+   * by the concurrent search of the grid with \ref key_gen_grid_threads_
+   * "Grid_Threads".
+   */
+  /**
+   * \see_key{key_CT_presample_decay_times_}
+   */
+  inline static const Key<bool> collTerm_presampleDecayTimes{
+      InputSections::collisionTerm + "Presample_Decay_Times", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
    * \optional_key{key_CT_included_2to2_,Included_2to2,list of strings,["All"]}
@@ -2551,6 +3403,37 @@ struct InputKeys {
       SpinInteractionType::Off,
       {"3.3"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_stochastic_thinning_,Stochastic_Thinning,bool,false}
+   *
+   * Whether the candidate pairs of the stochastic collision criterion are
+   * thinned in every cell, instead of drawing a random number for each pair.
+   * The collision probabilities of the pairs in a cell are bounded with the
+   * largest tabulated cross section of the pairs of types present, see <tt>
+   * \ref key_CT_dynamic_cell_size_ "Dynamic_Cell_Size"</tt>, and the two
+   * largest velocities. Only the pairs whose random number falls below this
+   * bound are picked and compared to their actual probability, such that the
+   * same collision rates are sampled, while dilute cells with small cross
+   * sections are searched in a time proportional to the number of picked
+   * pairs instead of the number of all pairs. The sequence of random numbers,
+   * and hence the individual events, differ from the search without thinning.
+   *
+   * This requires the <tt>\ref key_CT_cs_cache_ "Cross_Section_Cache"</tt>.
+   * The bound is increased by the <tt>\ref
+   * key_CT_dynamic_cell_size_safety_factor_
+   * "Dynamic_Cell_Size_Safety_Factor"</tt> and a warning is printed if the
+   * probability of a picked pair exceeds it. Like the cache, the bound is only
+   * possible for stable particles with their pole masses and without
+   * potentials. The pairs involving other particles are checked one by one,
+   * as are all pairs of a cell whose bound is not smaller than 1.
+   */
+  /**
+   * \see_key{key_CT_stochastic_thinning_}
+   */
+  inline static const Key<bool> collTerm_stochasticThinning{
+      InputSections::collisionTerm + "Stochastic_Thinning", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
    * \optional_key{key_CT_strings_,Strings,bool,
@@ -2597,6 +3480,30 @@ struct InputKeys {
   inline static const Key<bool> collTerm_stringsWithProbability{
       InputSections::collisionTerm + "Strings_with_Probability", true, {"1.3"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_collision_term
+   * \optional_key{key_CT_tabulated_resonance_masses_,Tabulated_Resonance_Masses,bool,false}
+   *
+   * How the mass of a resonance produced together with a stable particle, in
+   * a decay or a 2-to-2 scattering, is sampled.
+   * - `false` &rarr; By rejection from the spectral function times the phase
+   *   space, which is exact.
+   * - `true` &rarr; By inverting the cumulative distribution, which is
+   *   tabulated for every resonance, mass of the stable particle and angular
+   *   momentum, when it is needed first. This takes a single random number,
+   *   also for broad resonances near the threshold, but the distribution is
+   *   interpolated between tabulated values of \f$\sqrt{s}\f$. Above the pole
+   *   mass plus ten widths plus the mass of the stable particle, the rejection
+   *   sampling is used.
+   */
+  /**
+   * \see_key{key_CT_tabulated_resonance_masses_}
+   */
+  inline static const Key<bool> collTerm_tabulatedResonanceMasses{
+      InputSections::collisionTerm + "Tabulated_Resonance_Masses",
+      false,
+      {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_collision_term
    * \optional_key{key_CT_totXsStrategy_,Total_Cross_Section_Strategy,string,"TopDownMeasured"}
@@ -2700,6 +3607,29 @@ struct InputKeys {
           0.08,
           {"0.7.1"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_ct_pauliblocker
+   * \optional_key{key_CT_PB_occupancy_lattice_,Occupancy_Lattice,bool,false}
+   *
+   * Whether the phase-space densities are interpolated from a lattice in
+   * coordinate and momentum space, instead of summing up the contributions
+   * of the surrounding particles for every check. At the start of every time
+   * step, the baryons are deposited onto the nodes of the lattice with
+   * multilinear weights, and every phase-space density is interpolated from
+   * the 64 surrounding nodes. The nodes are spaced such that a particle is
+   * smeared over the same width as by the averaging spheres and the
+   * Gaussians. The lattice is not updated within the time step, i.e.
+   * particles produced or removed by actions are not taken into account,
+   * apart from the incoming particles of the checked action, which are
+   * disregarded exactly. This approximation makes Pauli blocking much
+   * cheaper in dense systems.
+   */
+  /**
+   * \see_key{key_CT_PB_occupancy_lattice_}
+   */
+  inline static const Key<bool> collTerm_pauliBlocking_occupancyLattice{
+      InputSections::c_pauliBlocking + "Occupancy_Lattice", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_ct_pauliblocker
    * \optional_key{key_CT_PB_spatial_averaging_radius_,Spatial_Averaging_Radius,double,1.86}
@@ -2945,6 +3875,46 @@ struct InputKeys {
       DefaultType::Dependent,
       {"1.4"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_ct_string_parameters
+   * \optional_key{key_CT_SP_preinit_pairs_,Preinitialized_Pairs,list of lists
+   * of PDG codes,[]}
+   *
+   * Pairs of incoming hadrons, for which the PYTHIA objects of the hard string
+   * routine are created and initialized at the start of the run instead of in
+   * the first hard string process of the pair. Every pair is given as a list
+   * of two PDG codes, e.g. `[[2212, 2212], [2212, -211]]`. As PYTHIA is only
+   * initialized for protons, neutrons, charged pions and their antiparticles,
+   * which all hadrons are mapped onto, any hadron can be specified. This
+   * removes the latency of the first high-energy collisions, which is
+   * noticeable in short runs.
+   */
+  /**
+   * \see_key{key_CT_SP_preinit_pairs_}
+   */
+  inline static const Key<std::vector<std::vector<PdgCode>>>
+      collTerm_stringParam_preinitializedPairs{
+          InputSections::c_stringParameters + "Preinitialized_Pairs",
+          std::vector<std::vector<PdgCode>>{},
+          {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_ct_string_parameters
+   * \optional_key{key_CT_SP_preinit_sqrts_,Preinitialization_Sqrts,double,10.0}
+   *
+   * The center-of-mass energy \unit{in GeV}, at which the PYTHIA objects of
+   * the pairs in <tt>\ref key_CT_SP_preinit_pairs_ "Preinitialized_Pairs"</tt>
+   * are initialized. The hard string routine otherwise initializes them at
+   * the energy of the first collision of the pair.
+   */
+  /**
+   * \see_key{key_CT_SP_preinit_sqrts_}
+   */
+  inline static const Key<double> collTerm_stringParam_preinitializationSqrts{
+      InputSections::c_stringParameters + "Preinitialization_Sqrts",
+      10.0,
+      {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_ct_string_parameters
    * \optional_key{key_CT_SP_probability_p_to_duu_,Prob_proton_to_d_uu,double,1./3}
@@ -3095,6 +4065,47 @@ struct InputKeys {
   inline static const Key<double> collTerm_stringParam_stringZBLeading{
       InputSections::c_stringParameters + "StringZ_B_Leading", 2.0, {"1.6"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_ct_string_parameters
+   * \optional_key{key_CT_SP_tabulate_diffractive_,Tabulate_Diffractive,bool,false}
+   *
+   * Whether to interpolate the single and double diffractive cross sections
+   * obtained from PYTHIA from tables instead of computing them for every pair
+   * of colliding hadrons. The tables are filled when a pair of the hadrons
+   * that PYTHIA is used for is needed for the first time. Their nodes are
+   * equidistant in \f$\ln\sqrt{s}\f$ with a relative distance of 0.1%, such
+   * that the deviations from the computed cross sections are tiny. However,
+   * the results are not identical to those without tables.
+   */
+  /**
+   * \see_key{key_CT_SP_tabulate_diffractive_}
+   */
+  inline static const Key<bool> collTerm_stringParam_tabulateDiffractive{
+      InputSections::c_stringParameters + "Tabulate_Diffractive",
+      false,
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_ct_string_parameters
+   * \optional_key{key_CT_SP_tabulated_lund_z_,Tabulated_Lund_Z,bool,false}
+   *
+   * How the lightcone momentum fraction of the hadrons fragmented off a string
+   * is sampled from the LUND fragmentation function.
+   * - `false` &rarr; By rejection, which is exact.
+   * - `true` &rarr; By inverting the cumulative distribution, which is
+   *   tabulated for every value of <tt>\ref key_CT_SP_stringz_a_
+   *   "StringZ_A"</tt> and <tt>\ref key_CT_SP_stringz_a_leading_
+   *   "StringZ_A_Leading"</tt>, when it is needed first. This takes a single
+   *   random number, but the distribution is interpolated between tabulated
+   *   values of \f$b m_T^2\f$. Outside of \f$10^{-3} \le b m_T^2 \le
+   *   10^2\f$, the rejection sampling is used.
+   */
+  /**
+   * \see_key{key_CT_SP_tabulated_lund_z_}
+   */
+  inline static const Key<bool> collTerm_stringParam_tabulatedLundZ{
+      InputSections::c_stringParameters + "Tabulated_Lund_Z", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_ct_string_parameters
    * \optional_key{key_CT_SP_use_monash_tune_,Use_Monash_Tune,bool,
@@ -3153,6 +4164,23 @@ struct InputKeys {
   inline static const Key<bool> collTerm_photons_bremsstrahlung{
       InputSections::c_photons + "Bremsstrahlung", false, {"1.8"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_ct_photons
+   * \optional_key{key_CT_photons_bremsstrahlung_grid_lookup_,
+   * Bremsstrahlung_Grid_Lookup,bool,false}
+   *
+   * Whether the tabulated differential cross sections of the bremsstrahlung
+   * processes are evaluated by a lookup of the grid intervals in constant time
+   * and SMASH's own evaluation of the bicubic spline, instead of by the GSL.
+   * The interpolation is the same up to rounding, but the sampled photons are
+   * not identical to the default. This is faster for many fractional photons.
+   */
+  /**
+   * \see_key{key_CT_photons_bremsstrahlung_grid_lookup_}
+   */
+  inline static const Key<bool> collTerm_photons_bremsstrahlungGridLookup{
+      InputSections::c_photons + "Bremsstrahlung_Grid_Lookup", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_ct_photons
    * \required_key{key_CT_photons_fractional_photons,Fractional_Photons,int}
@@ -3166,6 +4194,42 @@ struct InputKeys {
   inline static const Key<int> collTerm_photons_fractionalPhotons{
       InputSections::c_photons + "Fractional_Photons", {"1.8"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_ct_photons
+   * \optional_key{key_CT_photons_tabulated_cross_sections_,
+   * Tabulated_Cross_Sections,bool,false}
+   *
+   * Whether the total and differential cross sections of the 2-to-2 photon
+   * processes are interpolated in tables over \f$\sqrt{s}\f$, the mass of the
+   * \f$\rho\f$ meson and \f$t\f$ instead of evaluating the analytic formulas
+   * for every photon. The tables are created at start-up or read from the
+   * tabulations directory. In every cell of the tables, in which the
+   * interpolation deviates from the formulas by more than the \key
+   * Tabulation_Accuracy, the formulas are used. The sampled photons are hence
+   * not identical to the default.
+   */
+  /**
+   * \see_key{key_CT_photons_tabulated_cross_sections_}
+   */
+  inline static const Key<bool> collTerm_photons_tabulatedCrossSections{
+      InputSections::c_photons + "Tabulated_Cross_Sections", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_ct_photons
+   * \optional_key{key_CT_photons_tabulation_accuracy_,Tabulation_Accuracy,
+   * double,0.01}
+   *
+   * Largest deviation of the interpolated photon cross sections from the
+   * analytic formulas relative to the largest cross section in a cell of the
+   * tables, which is accepted for \key Tabulated_Cross_Sections. The
+   * deviation is checked at the center of every cell. It has to be positive.
+   */
+  /**
+   * \see_key{key_CT_photons_tabulation_accuracy_}
+   */
+  inline static const Key<double> collTerm_photons_tabulationAccuracy{
+      InputSections::c_photons + "Tabulation_Accuracy", 0.01, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_modi_collider
    *
@@ -3305,6 +4369,48 @@ struct InputKeys {
   inline static const Key<double> modi_collider_initialDistance{
       InputSections::m_collider + "Initial_Distance", 4.0, {"0.50"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_collider
+   * \optional_key{key_MC_tabulated_nucleon_positions_,Tabulated_Nucleon_Positions,bool,false}
+   *
+   * How the positions of the nucleons in Woods-Saxon and deformed nuclei are
+   * sampled.
+   * - `false` &rarr; By rejection from the nuclear density, which is exact.
+   * - `true` &rarr; By inverting the cumulative distributions of the radius
+   *   and, for deformed nuclei, of the polar angle, which are tabulated once
+   *   for every set of radius, diffusiveness and deformation parameters. The
+   *   densities are interpolated between the tabulated values. Deformed
+   *   nuclei with a non-zero triaxiality \f$\gamma\f$ are always sampled by
+   *   rejection.
+   */
+  /**
+   * \see_key{key_MC_tabulated_nucleon_positions_}
+   */
+  inline static const Key<bool> modi_collider_tabulatedNucleonPositions{
+      InputSections::m_collider + "Tabulated_Nucleon_Positions",
+      false,
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_collider
+   * \optional_key{key_MC_pregenerated_configurations_,Pregenerated_Configurations,int,0}
+   *
+   * Number of projectile and target configurations, which are generated at
+   * once ahead of the events using them. While the configurations of one batch
+   * are used, the next batch is generated on a background thread, overlapping
+   * with the evolution of the events. This includes the sampling of the
+   * nucleon positions, or their reading from file for custom nuclei, the Fermi
+   * momenta and the boost of the nuclei. Every batch uses its own random
+   * number stream, such that the results are reproducible for a given seed of
+   * the run, but a single event can no longer be reproduced from its own seed.
+   * With `0`, the nuclei are set up at the start of every event.
+   */
+  /**
+   * \see_key{key_MC_pregenerated_configurations_}
+   */
+  inline static const Key<int> modi_collider_pregeneratedConfigurations{
+      InputSections::m_collider + "Pregenerated_Configurations", 0, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_modi_C_proj_targ
    * \optional_key{key_MC_PT_diffusiveness_,Diffusiveness,double,</tt>\f$d(A)\f$<tt>}
@@ -3523,6 +4629,29 @@ struct InputKeys {
   inline static const Key<std::string> modi_collider_target_custom_fileName{
       InputSections::m_c_t_custom + "File_Name", {"1.6"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_C_proj_targ
+   * \optional_key_no_line{key_MC_PT_custom_binary_cache_,Binary_Cache,bool,false}
+   *
+   * Whether the external list is parsed once into a binary cache next to it,
+   * named like the list with the extension `.bin` appended. The cache holds
+   * the nucleons of all configurations as one flat array, which is mapped into
+   * memory instead of parsing the list line by line for every nucleus. The
+   * nuclei are the same as without the cache. The cache is rebuilt whenever
+   * the list changes, and if it cannot be written, the parsed list is kept in
+   * memory instead.
+   */
+  /**
+   * \see_key{key_MC_PT_custom_binary_cache_}
+   */
+  inline static const Key<bool> modi_collider_projectile_custom_binaryCache{
+      InputSections::m_c_p_custom + "Binary_Cache", false, {"3.4"}};
+  /**
+   * \see_key{key_MC_PT_custom_binary_cache_}
+   */
+  inline static const Key<bool> modi_collider_target_custom_binaryCache{
+      InputSections::m_c_t_custom + "Binary_Cache", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_modi_C_proj_targ
    * <hr>
@@ -4319,6 +5448,25 @@ struct InputKeys {
       SphereInitialCondition::ThermalMomentaBoltzmann,
       {"1.1"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_sphere
+   * \optional_key{key_MS_sampling_threads_,Sampling_Threads,int,0}
+   *
+   * Number of threads used to sample the momenta and positions of the initial
+   * particles. If positive, the particles of every species draw their random
+   * numbers from their own stream, which is seeded once per ensemble from the
+   * random engine, and the species are handed out to the threads one at a
+   * time. Hence the initial particles do not depend on the number of threads,
+   * but they differ from those sampled with the default value of 0, for which
+   * all particles are sampled one after the other from the random engine of
+   * the ensemble.
+   */
+  /**
+   * \see_key{key_MS_sampling_threads_}
+   */
+  inline static const Key<int> modi_sphere_samplingThreads{
+      InputSections::m_sphere + "Sampling_Threads", 0, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_modi_sphere
    * \optional_key{key_MS_strange_chem_pot_,Strange_Chemical_Potential,double,0.0}
@@ -4357,6 +5505,65 @@ struct InputKeys {
   inline static const Key<double> modi_sphere_heavyFlavorMultiplier{
       InputSections::m_sphere + "Heavy_Flavor_Multiplier", 0.0, {"3.3"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_sphere
+   * \optional_key{key_MS_tabulate_quantum_momenta_,Tabulate_Quantum_Momenta,bool,false}
+   *
+   * This key is considered only for the `"ThermalMomentaQuantum"` <tt>\ref
+   * key_MS_initial_cond_ "Initial_Condition"</tt>. If `true`, the
+   * momentum distribution of every species is tabulated once and the momenta
+   * are sampled by interpolating linearly between 2000 equally probable
+   * quantiles instead of by rejection sampling. This avoids the search for
+   * the maximum of the distributions and the rejected samples, but
+   * approximates the distribution on the scale of the distance of the
+   * quantiles.
+   */
+  /**
+   * \see_key{key_MS_tabulate_quantum_momenta_}
+   */
+  inline static const Key<bool> modi_sphere_tabulateQuantumMomenta{
+      InputSections::m_sphere + "Tabulate_Quantum_Momenta", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_sphere
+   * \optional_key{key_MS_tabulate_thermal_masses_,Tabulate_Thermal_Masses,bool,false}
+   *
+   * This key is considered only if the masses of the resonances are sampled
+   * from their spectral functions in a thermal medium, see <tt>\ref
+   * key_MS_account_res_widths_ "Account_Resonance_Widths"</tt>. If `true`,
+   * the thermal mass distribution of every resonance is tabulated once and
+   * the masses are sampled from the tabulated inverse cumulative distribution
+   * instead of by rejection sampling, which has a poor acceptance for broad
+   * resonances. The distribution is approximated as piecewise constant on
+   * 1000 intervals, which are dense close to the pole mass.
+   */
+  /**
+   * \see_key{key_MS_tabulate_thermal_masses_}
+   */
+  inline static const Key<bool> modi_sphere_tabulateThermalMasses{
+      InputSections::m_sphere + "Tabulate_Thermal_Masses", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_sphere
+   * \optional_key{key_MS_tabulate_thermal_momenta_,Tabulate_Thermal_Momenta,bool,false}
+   *
+   * This key is considered only for the `"thermal momenta"` and `"IC_Massive"`
+   * <tt>\ref key_MS_initial_cond_ "Initial_Condition"</tt>s.
+   * If `true`, the momentum distribution of every pair of mass and temperature
+   * is tabulated once and the momenta are sampled by interpolating linearly
+   * between 2000 equally probable quantiles instead of by rejection sampling.
+   * One table per species is kept for all events. The key is ignored if
+   * <tt>\ref key_MS_account_res_widths_ "Account_Resonance_Widths"</tt> is
+   * `true`, since the particles then do not have their pole masses.
+   * The distribution is approximated on the scale of the distance of the
+   * quantiles and cut at a kinetic energy of 40 times the temperature.
+   */
+  /**
+   * \see_key{key_MS_tabulate_thermal_momenta_}
+   */
+  inline static const Key<bool> modi_sphere_tabulateThermalMomenta{
+      InputSections::m_sphere + "Tabulate_Thermal_Momenta", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_modi_sphere
    * \optional_key{key_MS_use_thermal_mult_,Use_Thermal_Multiplicities,bool,false}
@@ -4607,6 +5814,37 @@ struct InputKeys {
   inline static const Key<double> modi_box_equilibrationTime{
       InputSections::m_box + "Equilibration_Time", -1.0, {"1.8"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_box
+   * \optional_key{key_MB_lazy_wall_crossings_,Lazy_Wall_Crossings,bool,false}
+   *
+   * If enabled, particles crossing a wall of the box are not put back into the
+   * box by wall-crossing actions. Instead, they are propagated beyond the wall
+   * until the end of the time step and are only then wrapped, while the
+   * distances of particles are measured between their closest periodic images
+   * in the meantime. The wall crossings hence do not appear in the collisions
+   * output, so enable this option only if they are not needed there.
+   */
+  /**
+   * \see_key{key_MB_lazy_wall_crossings_}
+   */
+  inline static const Key<bool> modi_box_lazyWallCrossings{
+      InputSections::m_box + "Lazy_Wall_Crossings", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_box
+   * \optional_key{key_MB_sampling_threads_,Sampling_Threads,int,0}
+   *
+   * See &nbsp;
+   * <tt>\ref key_MS_sampling_threads_
+   * "Sphere: Sampling_Threads"</tt>.
+   */
+  /**
+   * \see_key{key_MB_sampling_threads_}
+   */
+  inline static const Key<int> modi_box_samplingThreads{
+      InputSections::m_box + "Sampling_Threads", 0, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_modi_box
    * \optional_key{key_MB_strange_chem_pot_,Strange_Chemical_Potential,double,0.0}
@@ -4621,6 +5859,48 @@ struct InputKeys {
   inline static const Key<double> modi_box_strangeChemicalPotential{
       InputSections::m_box + "Strange_Chemical_Potential", 0.0, {"1.0"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_box
+   * \optional_key{key_MB_tabulate_quantum_momenta_,Tabulate_Quantum_Momenta,bool,false}
+   *
+   * See &nbsp;
+   * <tt>\ref key_MS_tabulate_quantum_momenta_
+   * "Sphere: Tabulate_Quantum_Momenta"</tt>.
+   */
+  /**
+   * \see_key{key_MB_tabulate_quantum_momenta_}
+   */
+  inline static const Key<bool> modi_box_tabulateQuantumMomenta{
+      InputSections::m_box + "Tabulate_Quantum_Momenta", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_box
+   * \optional_key{key_MB_tabulate_thermal_masses_,Tabulate_Thermal_Masses,bool,false}
+   *
+   * See &nbsp;
+   * <tt>\ref key_MS_tabulate_thermal_masses_
+   * "Sphere: Tabulate_Thermal_Masses"</tt>.
+   */
+  /**
+   * \see_key{key_MB_tabulate_thermal_masses_}
+   */
+  inline static const Key<bool> modi_box_tabulateThermalMasses{
+      InputSections::m_box + "Tabulate_Thermal_Masses", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_box
+   * \optional_key{key_MB_tabulate_thermal_momenta_,Tabulate_Thermal_Momenta,bool,false}
+   *
+   * See &nbsp;
+   * <tt>\ref key_MS_tabulate_thermal_momenta_
+   * "Sphere: Tabulate_Thermal_Momenta"</tt>.
+   */
+  /**
+   * \see_key{key_MB_tabulate_thermal_momenta_}
+   */
+  inline static const Key<bool> modi_box_tabulateThermalMomenta{
+      InputSections::m_box + "Tabulate_Thermal_Momenta", false, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_modi_box
    * \optional_key{key_MB_use_thermal_mult_,Use_Thermal_Multiplicities,bool,false}
@@ -4679,7 +5959,8 @@ struct InputKeys {
    *
    * Directory for the external particle lists. Although relative paths to the
    * execution directory should work, you are encouraged to <b>prefer absolute
-   * paths</b>.
+   * paths</b>. This key shall be omitted if
+   * <tt>\ref key_ML_stream_ "List: Stream"</tt> is used.
    */
   /**
    * \see_key{key_ML_file_dir_}
@@ -4692,7 +5973,8 @@ struct InputKeys {
    * \required_key{key_ML_filename_,Filename,string}
    *
    * External particle lists filename. This key shall be omitted if
-   * <tt>\ref key_ML_file_prefix_ "List: File_Prefix"</tt> is used. By using
+   * <tt>\ref key_ML_file_prefix_ "List: File_Prefix"</tt> or
+   * <tt>\ref key_ML_stream_ "List: Stream"</tt> is used. By using
    * this key, it is understood that all events to be processed are contained in
    * the given file, as this is the only one which will be read.
    */
@@ -4707,7 +5989,8 @@ struct InputKeys {
    * \required_key{key_ML_file_prefix_,File_Prefix,string}
    *
    * Prefix for the external particle lists file. This key shall be omitted if
-   * <tt>\ref key_ML_filename_ "List: Filename"</tt> is used.
+   * <tt>\ref key_ML_filename_ "List: Filename"</tt> or
+   * <tt>\ref key_ML_stream_ "List: Stream"</tt> is used.
    */
   /**
    * \see_key{key_ML_file_prefix_}
@@ -4798,6 +6081,58 @@ struct InputKeys {
           std::vector<std::string>{"ID", "charge"},
           {"3.3"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_list
+   * \optional_key{key_ML_file_format_,File_Format,string,"ASCII"}
+   *
+   * Format of the external particle lists files:
+   * - `"ASCII"` &rarr; Text files with one particle per line, whose events are
+   *   separated by lines containing <tt>" end "</tt> like the event end lines
+   *   of the OSCAR outputs.
+   * - `"Binary"` &rarr; Files with the layout of the uncompressed
+   *   \ref doxypage_output_binary "SMASH binary particles output" with OSCAR
+   *   2013 or extended OSCAR 2013 quantities. An event consists of all particle
+   *   blocks before an event end block and the particles are read without
+   *   parsing any text. The <tt>\ref key_ML_optional_quantities_
+   *   "Optional_Quantities"</tt> are taken from the particle lines and must be
+   *   part of them, where \c "proc_type" refers to the \c "proc_type_origin"
+   *   quantity.
+   */
+  /**
+   * \see_key{key_ML_file_format_}
+   */
+  inline static const Key<std::string> modi_list_fileFormat{
+      InputSections::m_list + "File_Format", "ASCII", {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_list
+   * \required_key{key_ML_stream_,Stream,string}
+   *
+   * Stream of external particle lists, which is read while the events are
+   * simulated instead of the files given by <tt>\ref key_ML_filename_
+   * "List: Filename"</tt> or <tt>\ref key_ML_file_prefix_
+   * "List: File_Prefix"</tt>. This way, the program producing the particle
+   * lists, e.g. a particlization sampler, and SMASH run concurrently without
+   * intermediate files. The value is
+   * - `"-"` &rarr; The standard input.
+   * - `"unix:<path>"` &rarr; The local stream socket at the given path, to
+   *   which SMASH connects.
+   * - Any other path &rarr; A named pipe (or file), which is opened when SMASH
+   *   starts and waits for its writer.
+   *
+   * The events are framed as in files of the given
+   * <tt>\ref key_ML_file_format_ "File_Format"</tt>. A few of them are read
+   * ahead in the background and the events are checked one by one when they
+   * are simulated. Hence, the simulation stops at the first event with more
+   * than 2 particles at the same position. The simulation also stops if the
+   * stream ends before the requested number of events has been read.
+   */
+  /**
+   * \see_key{key_ML_stream_}
+   */
+  inline static const Key<std::string> modi_list_stream{
+      InputSections::m_list + "Stream", {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_modi_listbox
    * \required_key{key_MLB_file_dir_,File_Directory,string}
@@ -4881,22 +6216,48 @@ struct InputKeys {
           {"3.3"}};
 
   /*!\Userguide
-   * \page doxypage_input_conf_output
-   *
-   * <h2> General output configuration parameters </h2>
-   *
-   * \optional_key_no_line{key_output_density_type_,Density_Type,string,"none"}
+   * \page doxypage_input_conf_modi_listbox
+   * \optional_key{key_MLB_file_format_,File_Format,string,"ASCII"}
    *
-   * Determines which kind of density is printed into the headers of the
-   * collision files. Possible values are:
-   * - `"hadron"` &rarr; Total hadronic density
-   * - `"baryon"` &rarr; Net baryon density
-   * - `"baryonic isospin"` &rarr; Baryonic isospin density
-   * - `"pion"` &rarr; Pion density
-   * - `"none"` &rarr; Do not calculate density, print 0.0
+   * See &nbsp;
+   * <tt>\ref key_ML_file_format_ "List: File_Format"</tt>.
    */
   /**
-   * \see_key{key_output_density_type_}
+   * \see_key{key_MLB_file_format_}
+   */
+  inline static const Key<std::string> modi_listBox_fileFormat{
+      InputSections::m_listBox + "File_Format", "ASCII", {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_modi_listbox
+   * \required_key{key_MLB_stream_,Stream,string}
+   *
+   * See &nbsp;
+   * <tt>\ref key_ML_stream_ "List: Stream"</tt>.
+   */
+  /**
+   * \see_key{key_MLB_stream_}
+   */
+  inline static const Key<std::string> modi_listBox_stream{
+      InputSections::m_listBox + "Stream", {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   *
+   * <h2> General output configuration parameters </h2>
+   *
+   * \optional_key_no_line{key_output_density_type_,Density_Type,string,"none"}
+   *
+   * Determines which kind of density is printed into the headers of the
+   * collision files. Possible values are:
+   * - `"hadron"` &rarr; Total hadronic density
+   * - `"baryon"` &rarr; Net baryon density
+   * - `"baryonic isospin"` &rarr; Baryonic isospin density
+   * - `"pion"` &rarr; Pion density
+   * - `"none"` &rarr; Do not calculate density, print 0.0
+   */
+  /**
+   * \see_key{key_output_density_type_}
    */
   inline static const Key<DensityType> output_densityType{
       InputSections::output + "Density_Type", DensityType::None, {"0.60"}};
@@ -4940,6 +6301,108 @@ struct InputKeys {
   inline static const Key<std::vector<double>> output_outputTimes{
       InputSections::output + "Output_Times", DefaultType::Dependent, {"1.7"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key{key_output_asynchronous_writing_,Asynchronous_Writing,bool,
+   * false}
+   *
+   * If enabled, all outputs are written by a separate thread, such that the
+   * simulation carries on while the particles are formatted and written to the
+   * files. The data is copied before being passed to the writer thread and the
+   * output files are identical to those written without this option. The
+   * number of calls waiting to be written is limited, such that a slow file
+   * system does not make SMASH use an unlimited amount of memory.
+   */
+  /**
+   * \see_key{key_output_asynchronous_writing_}
+   */
+  inline static const Key<bool> output_asynchronousWriting{
+      InputSections::output + "Asynchronous_Writing", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key{key_output_sharded_writing_,Sharded_Writing,bool,false}
+   *
+   * Only used if events are simulated concurrently, see
+   * <tt>\ref key_gen_event_threads_ "Event_Threads"</tt>. If enabled, every
+   * event thread writes the `Binary` and `Oscar2013_bin` outputs of the
+   * `Particles`, `Collisions`, `Dileptons` and `Photons` contents to its own
+   * indexed files, instead of passing them to the thread writing the files in
+   * event order. The shards are merged with the `smash_merge` executable, see
+   * \ref doxypage_output_binary. The other outputs are not affected.
+   */
+  /**
+   * \see_key{key_output_sharded_writing_}
+   */
+  inline static const Key<bool> output_shardedWriting{
+      InputSections::output + "Sharded_Writing", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key{key_output_root_compression_,Root_Compression,int,
+   * default of the ROOT installation}
+   *
+   * Compression setting of all \ref doxypage_output_root "ROOT outputs", given
+   * as <tt>100 * algorithm + level</tt> like in
+   * \c TFile::SetCompressionSettings, e.g. \c 101 for zlib at level 1, \c 404
+   * for LZ4 at level 4 or \c 505 for zstd at level 5. A level of \c 0
+   * disables the compression.
+   */
+  /**
+   * \see_key{key_output_root_compression_}
+   */
+  inline static const Key<int> output_rootCompression{
+      InputSections::output + "Root_Compression",
+      DefaultType::Dependent,
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key{key_output_root_basket_size_,Root_Basket_Size,int,32000}
+   *
+   * Size \unit{in bytes} of the buffer of every branch of the
+   * \ref doxypage_output_root "ROOT outputs", which is compressed and written
+   * as one basket when it is full. Larger baskets compress better and need
+   * fewer writes, but need more memory.
+   */
+  /**
+   * \see_key{key_output_root_basket_size_}
+   */
+  inline static const Key<int> output_rootBasketSize{
+      InputSections::output + "Root_Basket_Size", 32000, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key{key_output_root_auto_flush_,Root_Auto_Flush,int,-30000000}
+   *
+   * Autoflush setting of the trees of the \ref doxypage_output_root
+   * "ROOT outputs", see \c TTree::SetAutoFlush. A positive value flushes the
+   * baskets of all branches every given number of entries, a negative value
+   * whenever the given number of bytes has been filled and \c 0 disables the
+   * autoflush.
+   */
+  /**
+   * \see_key{key_output_root_auto_flush_}
+   */
+  inline static const Key<int> output_rootAutoFlush{
+      InputSections::output + "Root_Auto_Flush", -30000000, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key{key_output_root_threads_,Root_Threads,int,0}
+   *
+   * If positive, the implicit multithreading of ROOT is enabled with the given
+   * number of threads, which then compress the baskets of the
+   * \ref doxypage_output_root "ROOT outputs" in parallel. This requires ROOT
+   * to be built with implicit multithreading support. The content of the
+   * written trees does not change.
+   */
+  /**
+   * \see_key{key_output_root_threads_}
+   */
+  inline static const Key<int> output_rootThreads{
+      InputSections::output + "Root_Threads", 0, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_output
    * <hr>
@@ -5018,6 +6481,18 @@ struct InputKeys {
   /**
    * \see_key{key_output_content_format_}
    */
+  inline static const Key<std::vector<std::string>> output_spectra_format{
+      InputSections::o_spectra + "Format", std::vector<std::string>{}, {"3.4"}};
+  /**
+   * \see_key{key_output_content_format_}
+   */
+  inline static const Key<std::vector<std::string>> output_performance_format{
+      InputSections::o_performance + "Format",
+      std::vector<std::string>{},
+      {"3.4"}};
+  /**
+   * \see_key{key_output_content_format_}
+   */
   inline static const Key<std::vector<std::string>>
       output_thermodynamics_format{InputSections::o_thermodynamics + "Format",
                                    std::vector<std::string>{},
@@ -5038,8 +6513,8 @@ struct InputKeys {
    *
    * \optional_key_no_line{key_output_particles_extended_,Extended,bool,false}
    *
-   * &rArr; Ignored with `Oscar1999`, `ASCII`, `Binary`, `VTK`, `HepMC_asciiv3`
-   * and `HepMC_treeroot` formats.
+   * &rArr; Ignored with `Oscar1999`, `ASCII`, `Binary`, `VTK`, `VTK_Binary`,
+   * `HepMC_asciiv3` and `HepMC_treeroot` formats.
    * - `true` &rarr; Print extended information for each particle
    * - `false` &rarr; Regular output for each particle
    */
@@ -5054,10 +6529,10 @@ struct InputKeys {
    * \optional_key_no_line{key_output_particles_quantities_,Quantities,list of
    * strings,</tt><b>empty list</b><tt>}
    *
-   * &rArr; If using the `ASCII` or `Binary` format, a non-empty list must be
-   * specified. An error will be produced if a non-empty `Quantities` key is
-   * specified without including `ASCII` or `Binary` as format.
-   * See \ref doxypage_output_ascii for the possible values.
+   * &rArr; If using the `ASCII`, `Binary` or `Parquet` format, a non-empty list
+   * must be specified. An error will be produced if a non-empty `Quantities`
+   * key is specified without including `ASCII`, `Binary` or `Parquet` as
+   * format. See \ref doxypage_output_ascii for the possible values.
    */
   /**
    * \see_key{key_output_particles_quantities_}
@@ -5071,7 +6546,8 @@ struct InputKeys {
    * \page doxypage_input_conf_output
    * \optional_key_no_line{key_output_particles_only_final_,Only_Final,string,"Yes"}
    *
-   * &rArr; Ignored with `VTK`, `HepMC_asciiv3` and `HepMC_treeroot` formats.
+   * &rArr; Ignored with `VTK`, `VTK_Binary`, `HepMC_asciiv3` and
+   * `HepMC_treeroot` formats.
    * - `"Yes"` &rarr; Print only final particle list.
    * - `"IfNotEmpty"` &rarr; Print only final particle list, but only if event
    *   is not empty (i.e. any collisions happened between projectile and
@@ -5086,11 +6562,148 @@ struct InputKeys {
       OutputOnlyFinal::Yes,
       {"0.50"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_particles_compression_level_,
+   * Compression_Level,int,0}
+   *
+   * &rArr; Only used with the `Binary`, `Oscar2013_bin` and `HepMC_asciiv3`
+   * formats and only available if SMASH was built with zstd.
+   * - `0` &rarr; The output is not compressed.
+   * - Positive values &rarr; The output is compressed with the given zstd
+   *   level, see \ref doxypage_output_binary for the layout of the binary file
+   *   and \ref output_hepmc_asciiv3_compressed_ for the HepMC file. Low levels
+   *   like `1` or `3` are fast, while high levels reduce the size further at
+   *   the cost of much more time.
+   */
+  /**
+   * \see_key{key_output_particles_compression_level_}
+   */
+  inline static const Key<int> output_particles_compressionLevel{
+      InputSections::o_particles + "Compression_Level", 0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_particles_event_index_,Event_Index,bool,
+   * false}
+   *
+   * &rArr; Only used with the `Binary` and `Oscar2013_bin` formats.
+   * - `true` &rarr; The byte range of every event in the binary output is
+   *   written to an index file next to it, such that single events can be read
+   *   without parsing the previous ones. See \ref doxypage_output_binary for
+   *   the layout of the index.
+   * - `false` &rarr; No index file is written.
+   */
+  /**
+   * \see_key{key_output_particles_event_index_}
+   */
+  inline static const Key<bool> output_particles_eventIndex{
+      InputSections::o_particles + "Event_Index", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_particles_delta_encoding_,Delta_Encoding,
+   * bool,false}
+   *
+   * &rArr; Only used with the `Binary` and `Oscar2013_bin` formats with the
+   * OSCAR 2013 or extended OSCAR 2013 quantities and with \ref
+   * key_output_particles_only_final_ "Only_Final: No".
+   * - `true` &rarr; The particle lists at the output intervals are written as
+   *   delta blocks, which contain only the particles created, removed or
+   *   changed otherwise than by free streaming since the previous block of the
+   *   event. See \ref doxypage_output_binary for the layout of the blocks and
+   *   how the particle lists are reconstructed from them.
+   * - `false` &rarr; The complete particle lists are written.
+   */
+  /**
+   * \see_key{key_output_particles_delta_encoding_}
+   */
+  inline static const Key<bool> output_particles_deltaEncoding{
+      InputSections::o_particles + "Delta_Encoding", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_particles_events_per_row_group_,
+   * Events_Per_Row_Group,int,100}
+   *
+   * &rArr; Only used with the `Parquet` format.
+   *
+   * Number of events whose particles are written as one row group of the
+   * \ref doxypage_output_parquet "Parquet output". Larger row groups compress
+   * better, while smaller ones need less memory while writing and reading.
+   */
+  /**
+   * \see_key{key_output_particles_events_per_row_group_}
+   */
+  inline static const Key<int> output_particles_eventsPerRowGroup{
+      InputSections::o_particles + "Events_Per_Row_Group", 100, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * <h4> Filter section </h4>
+   * \anchor input_output_filter_
+   *
+   * The optional `Filter` section selects the particles, which are written to
+   * the output, such that a few species or a phase-space window of interest
+   * can be studied without writing and post-filtering all particles. A
+   * particle is written, if it fulfills all given conditions, while a missing
+   * key does not select anything. The ids of the written particles are not
+   * changed by the selection.
+   *
+   * &rArr; Ignored with `HepMC_asciiv3` and `HepMC_treeroot` formats, which
+   * need all particles of an event.
+   *
+   * \optional_key_no_line{key_output_particles_filter_pdg_codes_,PDG_Codes,
+   * list of PDG codes,</tt><b>all particles</b><tt>}
+   *
+   * Only the particles with one of the given PDG codes are written.
+   */
+  /**
+   * \see_key{key_output_particles_filter_pdg_codes_}
+   */
+  inline static const Key<std::vector<PdgCode>>
+      output_particles_filter_pdgCodes{InputSections::o_p_filter + "PDG_Codes",
+                                       DefaultType::Dependent,
+                                       {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_particles_filter_rapidity_range_,
+   * Rapidity_Range,list of two doubles,</tt><b>all rapidities</b><tt>}
+   *
+   * Only the particles whose rapidity is in the given interval
+   * \f$[y_\mathrm{min}, y_\mathrm{max}]\f$ are written.
+   */
+  /**
+   * \see_key{key_output_particles_filter_rapidity_range_}
+   */
+  inline static const Key<std::array<double, 2>>
+      output_particles_filter_rapidityRange{
+          InputSections::o_p_filter + "Rapidity_Range",
+          DefaultType::Dependent,
+          {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_particles_filter_pt_range_,Pt_Range,
+   * list of two doubles,</tt><b>all transverse momenta</b><tt>}
+   *
+   * Only the particles whose transverse momentum \unit{in GeV} is in the given
+   * interval \f$[p_{T,\mathrm{min}}, p_{T,\mathrm{max}}]\f$ are written.
+   */
+  /**
+   * \see_key{key_output_particles_filter_pt_range_}
+   */
+  inline static const Key<std::array<double, 2>>
+      output_particles_filter_ptRange{InputSections::o_p_filter + "Pt_Range",
+                                      DefaultType::Dependent,
+                                      {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_output
    * <hr>
    * <h3> &diams; Collisions </h3>
-   * &rArr; Format `VTK` not available
+   * &rArr; Formats `VTK` and `VTK_Binary` not available
    *
    * \optional_key_no_line{key_output_collisions_extended_,Extended,bool,false}
    *
@@ -5138,6 +6751,129 @@ struct InputKeys {
   inline static const Key<bool> output_collisions_printStartEnd{
       InputSections::o_collisions + "Print_Start_End", false, {"0.50"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_collisions_compression_level_,
+   * Compression_Level,int,0}
+   *
+   * See &nbsp;<tt>\ref key_output_particles_compression_level_
+   * "Particles: Compression_Level"</tt>.
+   */
+  /**
+   * \see_key{key_output_collisions_compression_level_}
+   */
+  inline static const Key<int> output_collisions_compressionLevel{
+      InputSections::o_collisions + "Compression_Level", 0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_collisions_event_index_,Event_Index,bool,
+   * false}
+   *
+   * See &nbsp;<tt>\ref key_output_particles_event_index_
+   * "Particles: Event_Index"</tt>.
+   */
+  /**
+   * \see_key{key_output_collisions_event_index_}
+   */
+  inline static const Key<bool> output_collisions_eventIndex{
+      InputSections::o_collisions + "Event_Index", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_collisions_reference_incoming_,
+   * Reference_Incoming,bool,false}
+   *
+   * &rArr; Only used with the `Binary` and `Oscar2013_bin` formats with the
+   * OSCAR 2013 or extended OSCAR 2013 quantities.
+   * - `true` &rarr; The interactions are written as compact blocks, in which
+   *   the incoming particles are referenced by their ID, if their lines follow
+   *   from the last written lines of the same particles by free streaming.
+   *   Only the other incoming particles and the outgoing particles are
+   *   written completely. See \ref doxypage_output_binary for the layout of
+   *   the blocks and how the incoming particles are reconstructed.
+   * - `false` &rarr; All incoming and outgoing particles are written
+   *   completely.
+   */
+  /**
+   * \see_key{key_output_collisions_reference_incoming_}
+   */
+  inline static const Key<bool> output_collisions_referenceIncoming{
+      InputSections::o_collisions + "Reference_Incoming", false, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * <h4> Filter section </h4>
+   *
+   * The `Filter` section works as the one of the \ref input_output_filter_
+   * "Particles content". An interaction is written, if its process type is
+   * selected and at least one of its incoming or outgoing particles is
+   * selected. All particles of a written interaction are written.
+   *
+   * \optional_key_no_line{key_output_collisions_filter_pdg_codes_,PDG_Codes,
+   * list of PDG codes,</tt><b>all particles</b><tt>}
+   *
+   * See &nbsp;<tt>\ref key_output_particles_filter_pdg_codes_
+   * "Particles: Filter: PDG_Codes"</tt>.
+   */
+  /**
+   * \see_key{key_output_collisions_filter_pdg_codes_}
+   */
+  inline static const Key<std::vector<PdgCode>>
+      output_collisions_filter_pdgCodes{InputSections::o_c_filter + "PDG_Codes",
+                                        DefaultType::Dependent,
+                                        {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_collisions_filter_rapidity_range_,
+   * Rapidity_Range,list of two doubles,</tt><b>all rapidities</b><tt>}
+   *
+   * See &nbsp;<tt>\ref key_output_particles_filter_rapidity_range_
+   * "Particles: Filter: Rapidity_Range"</tt>.
+   */
+  /**
+   * \see_key{key_output_collisions_filter_rapidity_range_}
+   */
+  inline static const Key<std::array<double, 2>>
+      output_collisions_filter_rapidityRange{
+          InputSections::o_c_filter + "Rapidity_Range",
+          DefaultType::Dependent,
+          {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_collisions_filter_pt_range_,Pt_Range,
+   * list of two doubles,</tt><b>all transverse momenta</b><tt>}
+   *
+   * See &nbsp;<tt>\ref key_output_particles_filter_pt_range_
+   * "Particles: Filter: Pt_Range"</tt>.
+   */
+  /**
+   * \see_key{key_output_collisions_filter_pt_range_}
+   */
+  inline static const Key<std::array<double, 2>>
+      output_collisions_filter_ptRange{InputSections::o_c_filter + "Pt_Range",
+                                       DefaultType::Dependent,
+                                       {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_collisions_filter_process_types_,
+   * Process_Types,list of integers,</tt><b>all process types</b><tt>}
+   *
+   * Only the interactions with one of the given process types are written, see
+   * \ref doxypage_output_process_types for the numbers of the process types.
+   */
+  /**
+   * \see_key{key_output_collisions_filter_process_types_}
+   */
+  inline static const Key<std::vector<int>>
+      output_collisions_filter_processTypes{
+          InputSections::o_c_filter + "Process_Types",
+          DefaultType::Dependent,
+          {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_output
    * <hr>
@@ -5250,6 +6986,24 @@ struct InputKeys {
           std::vector<std::string>{},
           {"3.3"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_IC_slab_width_,Slab_Width,double,0.0}
+   *
+   * &rArr; Only used with the `Binary` and `Oscar2013_bin` formats.
+   *
+   * If positive, the particles crossing the hypersurface are collected in
+   * slabs of this width \unit{in fm} of the computational frame time, and
+   * every completed slab is written as one particle block and announced in a
+   * slab index, see \ref doxypage_output_initial_conditions. This allows a
+   * hydrodynamics code to read the slabs while SMASH is still running.
+   */
+  /**
+   * \see_key{key_output_IC_slab_width_}
+   */
+  inline static const Key<double> output_initialConditions_slabWidth{
+      InputSections::o_initialConditions + "Slab_Width", 0.0, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_removed_keys
    *
@@ -5405,6 +7159,22 @@ struct InputKeys {
   inline static const Key<std::vector<std::string>> output_rivet_preloads{
       InputSections::o_rivet + "Preloads", DefaultType::Dependent, {"2.0.2"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_rivet_queue_size_,Queue_Size,int,0}
+   *
+   * If positive, the analyses run on a separate thread, while SMASH already
+   * simulates the next events. At most this many converted events wait for
+   * the analyses, beyond that SMASH waits before queueing the next one. By
+   * default, every event is analysed before the next one starts. The results
+   * do not depend on this key.
+   */
+  /**
+   * \see_key{key_output_rivet_queue_size_}
+   */
+  inline static const Key<int> output_rivet_queueSize{
+      InputSections::o_rivet + "Queue_Size", 0, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_output
    *
@@ -5501,11 +7271,119 @@ struct InputKeys {
    * \page doxypage_input_conf_output
    * <hr>
    * <h3> &diams; Coulomb </h3>
-   * &rArr; Only `VTK` format.
+   * &rArr; Only `VTK` and `VTK_Binary` formats.
    *
    * No content-specific output options, apart from the <tt>\ref
-   * key_output_content_format_ "Format"</tt> key which accept `["VTK"]` value
-   * only.
+   * key_output_content_format_ "Format"</tt> key which accepts the `"VTK"` and
+   * `"VTK_Binary"` values only.
+   */
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * <hr>
+   * <h3> &diams; Spectra </h3>
+   * &rArr; Only `ASCII` format.
+   *
+   * The spectra of the final particles are histogrammed while SMASH runs and
+   * written once at the end of the run, see \ref doxypage_output_spectra.
+   *
+   * \optional_key_no_line{key_output_spectra_pdg_codes_,PDG_Codes,
+   * list of PDG codes,[211\, -211\, 321\, -321\, 2212\, -2212]}
+   *
+   * The particle species, whose spectra are histogrammed.
+   */
+  /**
+   * \see_key{key_output_spectra_pdg_codes_}
+   */
+  inline static const Key<std::vector<PdgCode>> output_spectra_pdgCodes{
+      InputSections::o_spectra + "PDG_Codes",
+      std::vector<PdgCode>{pdg::pi_p, pdg::pi_m, pdg::K_p, pdg::K_m, pdg::p,
+                           -pdg::p},
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_spectra_rapidity_range_,Rapidity_Range,
+   * list of two doubles,[-4.0\, 4.0]}
+   *
+   * The rapidity interval of the \f$dN/dy\f$ histograms.
+   */
+  /**
+   * \see_key{key_output_spectra_rapidity_range_}
+   */
+  inline static const Key<std::array<double, 2>> output_spectra_rapidityRange{
+      InputSections::o_spectra + "Rapidity_Range",
+      std::array<double, 2>{{-4.0, 4.0}},
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_spectra_rapidity_bins_,Rapidity_Bins,int,
+   * 40}
+   *
+   * The number of bins of the \f$dN/dy\f$ histograms.
+   */
+  /**
+   * \see_key{key_output_spectra_rapidity_bins_}
+   */
+  inline static const Key<int> output_spectra_rapidityBins{
+      InputSections::o_spectra + "Rapidity_Bins", 40, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_spectra_pt_range_,Pt_Range,
+   * list of two doubles,[0.0\, 2.0]}
+   *
+   * The transverse momentum interval \unit{in GeV} of the \f$dN/dp_T\f$ and
+   * flow histograms.
+   */
+  /**
+   * \see_key{key_output_spectra_pt_range_}
+   */
+  inline static const Key<std::array<double, 2>> output_spectra_ptRange{
+      InputSections::o_spectra + "Pt_Range",
+      std::array<double, 2>{{0.0, 2.0}},
+      {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_spectra_pt_bins_,Pt_Bins,int,20}
+   *
+   * The number of bins of the \f$dN/dp_T\f$ and flow histograms.
+   */
+  /**
+   * \see_key{key_output_spectra_pt_bins_}
+   */
+  inline static const Key<int> output_spectra_ptBins{
+      InputSections::o_spectra + "Pt_Bins", 20, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * \optional_key_no_line{key_output_spectra_midrapidity_cut_,
+   * Midrapidity_Cut,double,0.5}
+   *
+   * Only the particles with \f$|y|\f$ below this value are histogrammed in
+   * the \f$dN/dp_T\f$ and flow histograms.
+   */
+  /**
+   * \see_key{key_output_spectra_midrapidity_cut_}
+   */
+  inline static const Key<double> output_spectra_midrapidityCut{
+      InputSections::o_spectra + "Midrapidity_Cut", 0.5, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
+   * <hr>
+   * <h3> &diams; Performance </h3>
+   * &rArr; Only `ASCII` format.
+   *
+   * The statistics about the computational work done in every event are
+   * written as a line of JSON at the end of the event, see
+   * \ref doxypage_output_performance. The profiling of the phases is switched
+   * on for that, without logging the time profiles unless
+   * \ref key_gen_profiling_ "Profiling" is switched on as well. No
+   * content-specific output options, apart from the <tt>\ref
+   * key_output_content_format_ "Format"</tt> key.
    */
 
   /*!\Userguide
@@ -5527,6 +7405,24 @@ struct InputKeys {
    * <b>About 3 and 4:</b> See \ref doxypage_output_thermodyn for
    * further information.
    *
+   * \optional_key_no_line{key_output_thermo_compression_level_,
+   * Compression_Level,int,0}
+   *
+   * &rArr; Only used with the `VTK_Binary` and `Lattice_HDF5` formats.
+   * - `0` &rarr; The output is not compressed.
+   * - `1` to `9` &rarr; The lattices are compressed with the given zlib
+   *   (deflate) level, see \ref doxypage_output_vtk_lattice and
+   *   \ref doxypage_output_thermodyn_lattice. Compressing `VTK_Binary` files
+   *   requires SMASH to be built with zlib.
+   */
+  /**
+   * \see_key{key_output_thermo_compression_level_}
+   */
+  inline static const Key<int> output_thermodynamics_compressionLevel{
+      InputSections::o_thermodynamics + "Compression_Level", 0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_output
    * \optional_key_no_line{key_output_thermo_only_part_,Only_Participants,bool,false}
    *
    * If set to `true`, only participants are included in the computation of the
@@ -5684,6 +7580,46 @@ struct InputKeys {
   inline static const Key<std::array<int, 3>> lattice_cellNumber{
       InputSections::lattice + "Cell_Number", DefaultType::Dependent, {"0.80"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_lattice
+   * \optional_key{key_lattice_incremental_update_interval_,
+   * Incremental_Update_Interval,int,0}
+   *
+   * Number of incremental updates of the density lattices of the potentials
+   * between two updates from scratch. An incremental update only subtracts
+   * and adds again the particles which were created, removed or changed by
+   * actions, or which moved or changed their velocity by more than \ref
+   * key_lattice_incremental_update_tolerance_ "Incremental_Update_Tolerance"
+   * since the last update. This is faster if most particles change little
+   * between two time steps, e.g. in a box, but the neglected changes and
+   * rounding errors accumulate on the lattice until the next update from
+   * scratch. If at least as many particles changed as there are particles,
+   * the lattice is updated from scratch right away. Incremental updates are
+   * serial, since they touch few nodes. With `0`, the lattices are always
+   * updated from scratch.
+   */
+  /**
+   * \see_key{key_lattice_incremental_update_interval_}
+   */
+  inline static const Key<int> lattice_incrementalUpdateInterval{
+      InputSections::lattice + "Incremental_Update_Interval", 0, {"3.4"}};
+
+  /*!\Userguide
+   * \page doxypage_input_conf_lattice
+   * \optional_key{key_lattice_incremental_update_tolerance_,
+   * Incremental_Update_Tolerance,double,0.01}
+   *
+   * Largest change of the position \unit{in fm} and of the velocity, in units
+   * of the speed of light, of a particle which is ignored by the incremental
+   * updates of the density lattices, see \ref
+   * key_lattice_incremental_update_interval_ "Incremental_Update_Interval".
+   */
+  /**
+   * \see_key{key_lattice_incremental_update_tolerance_}
+   */
+  inline static const Key<double> lattice_incrementalUpdateTolerance{
+      InputSections::lattice + "Incremental_Update_Tolerance", 0.01, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_lattice
    * \optional_key{key_lattice_origin_,Origin,list of 3 doubles,
@@ -5733,6 +7669,31 @@ struct InputKeys {
   inline static const Key<bool> lattice_potentialsAffectThreshold{
       InputSections::lattice + "Potentials_Affect_Thresholds", false, {"1.3"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_lattice
+   * \optional_key{key_lattice_resizing_interval_,Resizing_Interval,int,0}
+   *
+   * Number of time steps after which the lattice is moved and resized to cover
+   * the particles of all ensembles, keeping its cell sizes. The lattice then
+   * extends beyond the particles by the range of the smearing and by the
+   * distance light travels during this number of time steps. The new origin
+   * is shifted by whole cells, such that the cell centers stay at the same
+   * positions. The lattice is also fitted to the particles at the start of
+   * every event. The geometry given by the other keys only sets the cell
+   * sizes and the positions of the cell centers. With `0`, the lattice is
+   * never resized.
+   *
+   * Resizing is only possible for lattices which are not periodic and only
+   * used for the potentials. It cannot be combined with thermodynamic lattice
+   * outputs or with derivatives computed by finite differences in time, which
+   * need the values of the previous time step at the same nodes.
+   */
+  /**
+   * \see_key{key_lattice_resizing_interval_}
+   */
+  inline static const Key<int> lattice_resizingInterval{
+      InputSections::lattice + "Resizing_Interval", 0, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_lattice
    * \optional_key{key_lattice_sizes_,Sizes,list of 3 doubles,
@@ -5747,6 +7708,27 @@ struct InputKeys {
   inline static const Key<std::array<double, 3>> lattice_sizes{
       InputSections::lattice + "Sizes", DefaultType::Dependent, {"0.80"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_lattice
+   * \optional_key{key_lattice_threads_,Threads,int,1}
+   *
+   * Number of threads used to smear the particles onto the density lattices.
+   * The particles of all ensembles are split into one chunk per thread, which
+   * is smeared onto a separate copy of the lattice. The copies are summed node
+   * by node afterwards. All smearing modes are supported. The result does not
+   * depend on the scheduling of the threads, but the different order of the
+   * sums changes the last digits of the densities compared to a serial update.
+   * Each thread needs memory for a full copy of the lattice.
+   *
+   * The same threads update the momenta of the particles in the potentials,
+   * which gives the same result as the serial update.
+   */
+  /**
+   * \see_key{key_lattice_threads_}
+   */
+  inline static const Key<int> lattice_threads{
+      InputSections::lattice + "Threads", 1, {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_potentials
    * \optional_key{key_potentials_use_potentials_outside_lattice_,
@@ -5764,6 +7746,30 @@ struct InputKeys {
       true,
       {"3.1"}};
 
+  /*!\Userguide
+   * \page doxypage_input_conf_potentials
+   * \optional_key{key_potentials_tabulate_density_functions_,
+   * Tabulate_Density_Functions, bool, false}
+   *
+   * Whether to interpolate the powers of the densities in the Skyrme, symmetry
+   * and VDF potentials and in their derivatives in tables, instead of
+   * evaluating them for every lattice node and particle. The tables are created
+   * at the start with steps proportional to the density, which are refined
+   * until the relative error of the interpolation is below \f$10^{-6}\f$
+   * between \f$6\times 10^{-8}\f$ and \f$256\f$ times the (saturation)
+   * density. Outside of this range, the powers are evaluated exactly. This
+   * speeds up the filling of the potential lattices, especially with several
+   * terms of the VDF potential, at the price of results that differ from the
+   * exact evaluation in the last digits.
+   */
+  /**
+   * \see_key{key_potentials_tabulate_density_functions_}
+   */
+  inline static const Key<bool> potentials_tabulateDensityFunctions{
+      InputSections::potentials + "Tabulate_Density_Functions",
+      false,
+      {"3.4"}};
+
   /*!\Userguide
    * \page doxypage_input_conf_pot_skyrme
    * \required_key{key_potentials_skyrme_a_,Skyrme_A,double}
@@ -6042,12 +8048,16 @@ struct InputKeys {
       std::reference_wrapper<const Key<std::array<double, 2>>>,
       std::reference_wrapper<const Key<std::array<double, 3>>>,
       std::reference_wrapper<const Key<std::pair<double, double>>>,
+      std::reference_wrapper<const Key<std::vector<int>>>,
       std::reference_wrapper<const Key<std::vector<double>>>,
       std::reference_wrapper<const Key<std::vector<std::string>>>,
+      std::reference_wrapper<const Key<std::vector<PdgCode>>>,
+      std::reference_wrapper<const Key<std::vector<std::vector<PdgCode>>>>,
       std::reference_wrapper<const Key<std::set<ThermodynamicQuantity>>>,
       std::reference_wrapper<const Key<std::map<PdgCode, int>>>,
       std::reference_wrapper<const Key<std::map<std::string, std::string>>>,
       std::reference_wrapper<const Key<einhard::LogLevel>>,
+      std::reference_wrapper<const Key<ActionQueue>>,
       std::reference_wrapper<const Key<BoxInitialCondition>>,
       std::reference_wrapper<const Key<CalculationFrame>>,
       std::reference_wrapper<const Key<CollisionCriterion>>,
@@ -6083,21 +8093,51 @@ struct InputKeys {
       std::cref(gen_randomseed),
       std::cref(gen_minNonEmptyEnsembles_maximumEnsembles),
       std::cref(gen_minNonEmptyEnsembles_number),
+      std::cref(gen_actionQueue),
+      std::cref(gen_checkpointInterval),
       std::cref(gen_deltaTime),
       std::cref(gen_derivativesMode),
       std::cref(gen_smearingDiscreteWeight),
+      std::cref(gen_ensembleThreads),
+      std::cref(gen_threads),
       std::cref(gen_ensembles),
+      std::cref(gen_eventThreads),
+      std::cref(gen_longestEventsFirst),
       std::cref(gen_expansionRate),
       std::cref(gen_fieldDerivativesMode),
+      std::cref(gen_forkTime),
+      std::cref(gen_forksPerEvent),
+      std::cref(gen_freezeOutWindow),
       std::cref(gen_smearingGaussCutoffInSigma),
       std::cref(gen_smearingGaussianSigma),
+      std::cref(gen_gridThreads),
+      std::cref(gen_lazyPropagation),
+      std::cref(gen_lazyTabulations),
+      std::cref(gen_memoryLimit),
+      std::cref(gen_hugePages),
       std::cref(gen_metricType),
+      std::cref(gen_particlesCompactionThreshold),
+      std::cref(gen_particlesReorderingInterval),
+      std::cref(gen_pinThreads),
+      std::cref(gen_prepareNextEvent),
+      std::cref(gen_profiling),
+      std::cref(gen_hardwareCounters),
       std::cref(gen_restFrameDensityDerivativeMode),
+      std::cref(gen_sharedTabulations),
       std::cref(gen_smearingMode),
+      std::cref(gen_tabulationThreads),
       std::cref(gen_testparticles),
       std::cref(gen_timeStepMode),
+      std::cref(gen_traceEvents),
       std::cref(gen_smearingTriangularRange),
       std::cref(gen_useGrid),
+      std::cref(gen_workloadSampling),
+      std::cref(gen_adaptiveTimeStep_interactionsPerParticle),
+      std::cref(gen_adaptiveTimeStep_maximumDeltaTime),
+      std::cref(gen_adaptiveTimeStep_maximumGrowthFactor),
+      std::cref(gen_adaptiveTimeStep_minimumDeltaTime),
+      std::cref(gen_adaptiveTimeStep_potentialsSafetyFactor),
+      std::cref(gen_adaptiveTimeStep_relativeDensityChange),
       std::cref(log_default),
       std::cref(log_box),
       std::cref(log_collider),
@@ -6134,8 +8174,14 @@ struct InputKeys {
       std::cref(log_tmn),
       std::cref(version),
       std::cref(collTerm_additionalElasticCrossSection),
+      std::cref(collTerm_aliasDecayChannels),
       std::cref(collTerm_collisionCriterion),
+      std::cref(collTerm_crossSectionCache),
+      std::cref(collTerm_crossSectionCacheTolerance),
       std::cref(collTerm_crossSectionScaling),
+      std::cref(collTerm_crossSectionTable),
+      std::cref(collTerm_dynamicCellSize),
+      std::cref(collTerm_dynamicCellSizeSafetyFactor),
       std::cref(collTerm_elasticCrossSection),
       std::cref(collTerm_elasticNNCutoffSqrts),
       std::cref(collTerm_totXsStrategy),
@@ -6145,6 +8191,7 @@ struct InputKeys {
       std::cref(collTerm_ignoreDecayWidthAtTheEnd),
       std::cref(collTerm_includeDecaysAtTheEnd),
       std::cref(collTerm_decayInitial),
+      std::cref(collTerm_presampleDecayTimes),
       std::cref(collTerm_includedTwoToTwo),
       std::cref(collTerm_isotropic),
       std::cref(collTerm_maximumCrossSection),
@@ -6154,12 +8201,15 @@ struct InputKeys {
       std::cref(collTerm_onlyWarnForHighProbability),
       std::cref(collTerm_resonanceLifetimeModifier),
       std::cref(collTerm_spinInteractions),
+      std::cref(collTerm_stochasticThinning),
       std::cref(collTerm_strings),
       std::cref(collTerm_stringsWithProbability),
+      std::cref(collTerm_tabulatedResonanceMasses),
       std::cref(collTerm_twoToOne),
       std::cref(collTerm_useAQM),
       std::cref(collTerm_pauliBlocking_gaussianCutoff),
       std::cref(collTerm_pauliBlocking_momentumAveragingRadius),
+      std::cref(collTerm_pauliBlocking_occupancyLattice),
       std::cref(collTerm_pauliBlocking_spatialAveragingRadius),
       std::cref(collTerm_stringTrans_KNOffset),
       std::cref(collTerm_stringTrans_pipiOffset),
@@ -6177,6 +8227,8 @@ struct InputKeys {
       std::cref(collTerm_stringParam_quarkBeta),
       std::cref(collTerm_stringParam_popcornRate),
       std::cref(collTerm_stringParam_powerParticleFormation),
+      std::cref(collTerm_stringParam_preinitializedPairs),
+      std::cref(collTerm_stringParam_preinitializationSqrts),
       std::cref(collTerm_stringParam_probabilityPToDUU),
       std::cref(collTerm_stringParam_separateFragmentBaryon),
       std::cref(collTerm_stringParam_sigmaPerp),
@@ -6187,11 +8239,16 @@ struct InputKeys {
       std::cref(collTerm_stringParam_stringZALeading),
       std::cref(collTerm_stringParam_stringZB),
       std::cref(collTerm_stringParam_stringZBLeading),
+      std::cref(collTerm_stringParam_tabulateDiffractive),
+      std::cref(collTerm_stringParam_tabulatedLundZ),
       std::cref(collTerm_stringParam_useMonashTune),
       std::cref(collTerm_dileptons_decays),
       std::cref(collTerm_photons_twoToTwoScatterings),
       std::cref(collTerm_photons_bremsstrahlung),
+      std::cref(collTerm_photons_bremsstrahlungGridLookup),
       std::cref(collTerm_photons_fractionalPhotons),
+      std::cref(collTerm_photons_tabulatedCrossSections),
+      std::cref(collTerm_photons_tabulationAccuracy),
       std::cref(collTerm_HF_AQMbSuppression),
       std::cref(collTerm_HF_AQMcSuppression),
       std::cref(modi_collider_eKin),
@@ -6202,6 +8259,8 @@ struct InputKeys {
       std::cref(modi_collider_collisionWithinNucleus),
       std::cref(modi_collider_fermiMotion),
       std::cref(modi_collider_initialDistance),
+      std::cref(modi_collider_tabulatedNucleonPositions),
+      std::cref(modi_collider_pregeneratedConfigurations),
       std::cref(modi_collider_projectile_diffusiveness),
       std::cref(modi_collider_target_diffusiveness),
       std::cref(modi_collider_projectile_particles),
@@ -6220,6 +8279,8 @@ struct InputKeys {
       std::cref(modi_collider_target_custom_fileDirectory),
       std::cref(modi_collider_projectile_custom_fileName),
       std::cref(modi_collider_target_custom_fileName),
+      std::cref(modi_collider_projectile_custom_binaryCache),
+      std::cref(modi_collider_target_custom_binaryCache),
       std::cref(modi_collider_projectile_deformed_automatic),
       std::cref(modi_collider_target_deformed_automatic),
       std::cref(modi_collider_projectile_deformed_beta2),
@@ -6272,8 +8333,12 @@ struct InputKeys {
       std::cref(modi_sphere_baryonChemicalPotential),
       std::cref(modi_sphere_chargeChemicalPotential),
       std::cref(modi_sphere_initialCondition),
+      std::cref(modi_sphere_samplingThreads),
       std::cref(modi_sphere_strangeChemicalPotential),
       std::cref(modi_sphere_heavyFlavorMultiplier),
+      std::cref(modi_sphere_tabulateQuantumMomenta),
+      std::cref(modi_sphere_tabulateThermalMasses),
+      std::cref(modi_sphere_tabulateThermalMomenta),
       std::cref(modi_sphere_useThermalMultiplicities),
       std::cref(modi_sphere_jet_jetPdg),
       std::cref(modi_sphere_jet_jetMomentum),
@@ -6289,7 +8354,12 @@ struct InputKeys {
       std::cref(modi_box_baryonChemicalPotential),
       std::cref(modi_box_chargeChemicalPotential),
       std::cref(modi_box_equilibrationTime),
+      std::cref(modi_box_lazyWallCrossings),
+      std::cref(modi_box_samplingThreads),
       std::cref(modi_box_strangeChemicalPotential),
+      std::cref(modi_box_tabulateQuantumMomenta),
+      std::cref(modi_box_tabulateThermalMasses),
+      std::cref(modi_box_tabulateThermalMomenta),
       std::cref(modi_box_useThermalMultiplicities),
       std::cref(modi_box_jet_jetMomentum),
       std::cref(modi_box_jet_jetPdg),
@@ -6298,15 +8368,25 @@ struct InputKeys {
       std::cref(modi_list_filePrefix),
       std::cref(modi_list_shiftId),
       std::cref(modi_list_optionalQuantities),
+      std::cref(modi_list_fileFormat),
+      std::cref(modi_list_stream),
       std::cref(modi_listBox_fileDirectory),
       std::cref(modi_listBox_filename),
       std::cref(modi_listBox_filePrefix),
       std::cref(modi_listBox_length),
       std::cref(modi_listBox_shiftId),
       std::cref(modi_listBox_optionalQuantities),
+      std::cref(modi_listBox_fileFormat),
+      std::cref(modi_listBox_stream),
       std::cref(output_densityType),
       std::cref(output_outputInterval),
       std::cref(output_outputTimes),
+      std::cref(output_asynchronousWriting),
+      std::cref(output_shardedWriting),
+      std::cref(output_rootCompression),
+      std::cref(output_rootBasketSize),
+      std::cref(output_rootAutoFlush),
+      std::cref(output_rootThreads),
       std::cref(output_particles_format),
       std::cref(output_collisions_format),
       std::cref(output_dileptons_format),
@@ -6314,19 +8394,36 @@ struct InputKeys {
       std::cref(output_initialConditions_format),
       std::cref(output_rivet_format),
       std::cref(output_coulomb_format),
+      std::cref(output_spectra_format),
+      std::cref(output_performance_format),
       std::cref(output_thermodynamics_format),
       std::cref(output_particles_extended),
       std::cref(output_particles_quantities),
       std::cref(output_particles_onlyFinal),
+      std::cref(output_particles_compressionLevel),
+      std::cref(output_particles_eventIndex),
+      std::cref(output_particles_deltaEncoding),
+      std::cref(output_particles_eventsPerRowGroup),
+      std::cref(output_particles_filter_pdgCodes),
+      std::cref(output_particles_filter_rapidityRange),
+      std::cref(output_particles_filter_ptRange),
       std::cref(output_collisions_extended),
       std::cref(output_collisions_quantities),
       std::cref(output_collisions_printStartEnd),
+      std::cref(output_collisions_compressionLevel),
+      std::cref(output_collisions_eventIndex),
+      std::cref(output_collisions_referenceIncoming),
+      std::cref(output_collisions_filter_pdgCodes),
+      std::cref(output_collisions_filter_rapidityRange),
+      std::cref(output_collisions_filter_ptRange),
+      std::cref(output_collisions_filter_processTypes),
       std::cref(output_dileptons_extended),
       std::cref(output_dileptons_quantities),
       std::cref(output_photons_extended),
       std::cref(output_photons_quantities),
       std::cref(output_initialConditions_extended),
       std::cref(output_initialConditions_quantities),
+      std::cref(output_initialConditions_slabWidth),
       std::cref(output_initialConditions_lowerBound),
       std::cref(output_initialConditions_properTime),
       std::cref(output_initialConditions_pTCut),
@@ -6337,12 +8434,20 @@ struct InputKeys {
       std::cref(output_rivet_logging),
       std::cref(output_rivet_paths),
       std::cref(output_rivet_preloads),
+      std::cref(output_rivet_queueSize),
       std::cref(output_rivet_weights_cap),
       std::cref(output_rivet_weights_deselect),
       std::cref(output_rivet_weights_nloSmearing),
       std::cref(output_rivet_weights_noMulti),
       std::cref(output_rivet_weights_nominal),
       std::cref(output_rivet_weights_select),
+      std::cref(output_spectra_pdgCodes),
+      std::cref(output_spectra_rapidityRange),
+      std::cref(output_spectra_rapidityBins),
+      std::cref(output_spectra_ptRange),
+      std::cref(output_spectra_ptBins),
+      std::cref(output_spectra_midrapidityCut),
+      std::cref(output_thermodynamics_compressionLevel),
       std::cref(output_thermodynamics_onlyParticipants),
       std::cref(output_thermodynamics_position),
       std::cref(output_thermodynamics_quantites),
@@ -6350,11 +8455,16 @@ struct InputKeys {
       std::cref(output_thermodynamics_type),
       std::cref(lattice_automatic),
       std::cref(lattice_cellNumber),
+      std::cref(lattice_incrementalUpdateInterval),
+      std::cref(lattice_incrementalUpdateTolerance),
       std::cref(lattice_origin),
       std::cref(lattice_periodic),
       std::cref(lattice_potentialsAffectThreshold),
+      std::cref(lattice_resizingInterval),
       std::cref(lattice_sizes),
+      std::cref(lattice_threads),
       std::cref(potentials_use_potentials_outside_lattice),
+      std::cref(potentials_tabulateDensityFunctions),
       std::cref(potentials_skyrme_skyrmeA),
       std::cref(potentials_skyrme_skyrmeB),
       std::cref(potentials_skyrme_skyrmeTau),
@@ -12,7 +12,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
@@ -71,6 +73,11 @@ class InterpolateDataLinear {
    * Piecewise linear interpolation is used.
    * Values outside the given samples will use the outmost linear
    * interpolation.
+   *
+   * The range of the samples is divided into uniform buckets, which know the
+   * linear interpolation at their lower edge. The interpolation for a value is
+   * then found from its bucket with few comparisons instead of a binary
+   * search, and it is the same as the one found by find_index().
    */
   InterpolateDataLinear(const std::vector<T>& x, const std::vector<T>& y);
   /**
@@ -79,13 +86,31 @@ class InterpolateDataLinear {
    *  \param x Interpolation argument.
    *  \return Interpolated value.
    */
-  T operator()(T x) const;
+  T operator()(T x) const { return f_[segment(x)](x); }
+
+  /**
+   * Calculate spline interpolation at many x.
+   *
+   *  \param x Interpolation arguments.
+   *  \return Interpolated values, the same as for every single argument.
+   */
+  std::vector<T> operator()(const std::vector<T>& x) const;
 
  private:
+  /**
+   * \param x0 Interpolation argument.
+   * \return Index of the linear interpolation used for \p x0.
+   */
+  size_t segment(T x0) const;
+
   /// x_i
   std::vector<T> x_;
   /// Piecewise linear interpolation using f(x_i)
   std::vector<InterpolateLinear<T>> f_;
+  /// Number of buckets per unit of x
+  T inv_bucket_width_;
+  /// Index of the linear interpolation at the lower edge of every bucket
+  std::vector<std::uint32_t> bucket_segment_;
 };
 
 template <typename T>
@@ -206,6 +231,28 @@ InterpolateDataLinear<T>::InterpolateDataLinear(const std::vector<T>& x,
     f_.emplace_back(
         InterpolateLinear<T>(x_[i], y_sorted[i], x_[i + 1], y_sorted[i + 1]));
   }
+  /* Buckets of half the smallest interval hold at most one sample each. Their
+   * number is limited for closely spaced samples, which then need a few more
+   * comparisons. */
+  const T range = x_.back() - x_.front();
+  T min_width = range;
+  for (size_t i = 1; i < n; i++) {
+    min_width = std::min(min_width, x_[i] - x_[i - 1]);
+  }
+  const T wanted_buckets = std::ceil(2 * range / min_width);
+  const size_t n_buckets = wanted_buckets < 4 * n
+                               ? static_cast<size_t>(wanted_buckets)
+                               : 4 * n;
+  inv_bucket_width_ = n_buckets / range;
+  bucket_segment_.resize(n_buckets);
+  size_t i = 0;
+  for (size_t bucket = 0; bucket < n_buckets; bucket++) {
+    const T edge = x_.front() + bucket / inv_bucket_width_;
+    while (i + 1 < f_.size() && x_[i + 1] < edge) {
+      i++;
+    }
+    bucket_segment_[bucket] = static_cast<std::uint32_t>(i);
+  }
 }
 
 /**
@@ -237,18 +284,42 @@ size_t find_index(const std::vector<T>& v, T x) {
 }
 
 template <typename T>
-T InterpolateDataLinear<T>::operator()(T x0) const {
-  // Find the piecewise linear interpolation corresponding to x0.
-  size_t i = find_index(x_, x0);
-  if (i >= f_.size()) {
-    // We don't have a linear interpolation beyond the last point in x_.
-    // Use the last linear interpolation instead.
-    i = f_.size() - 1;
+size_t InterpolateDataLinear<T>::segment(T x0) const {
+  const T position = (x0 - x_.front()) * inv_bucket_width_;
+  const size_t last_bucket = bucket_segment_.size() - 1;
+  const size_t bucket =
+      position > 0 ? (position < last_bucket ? static_cast<size_t>(position)
+                                             : last_bucket)
+                   : 0;
+  /* Move to the last sample strictly smaller than x0 like find_index. Beyond
+   * the last point in x_ there is no linear interpolation, so the last one is
+   * used instead. */
+  size_t i = bucket_segment_[bucket];
+  while (i > 0 && !(x_[i] < x0)) {
+    i--;
+  }
+  while (i + 1 < f_.size() && x_[i + 1] < x0) {
+    i++;
+  }
+  return i;
+}
+
+template <typename T>
+std::vector<T> InterpolateDataLinear<T>::operator()(
+    const std::vector<T>& x) const {
+  std::vector<T> y(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    y[i] = (*this)(x[i]);
   }
-  return f_[i](x0);
+  return y;
 }
 
-/// Represent a cubic spline interpolation.
+/**
+ * Represent a cubic spline interpolation.
+ *
+ * The spline is not modified when it is evaluated, such that one spline can be
+ * evaluated from several threads at the same time.
+ */
 class InterpolateDataSpline {
  public:
   /**
@@ -265,6 +336,11 @@ class InterpolateDataSpline {
   InterpolateDataSpline(const std::vector<double>& x,
                         const std::vector<double>& y);
 
+  /// The spline owns the GSL spline, hence it cannot be copied.
+  InterpolateDataSpline(const InterpolateDataSpline&) = delete;
+  /// The spline owns the GSL spline, hence it cannot be copied.
+  InterpolateDataSpline& operator=(const InterpolateDataSpline&) = delete;
+
   /// Destructor
   ~InterpolateDataSpline();
 
@@ -285,8 +361,6 @@ class InterpolateDataSpline {
   double first_y_;
   /// Last y value.
   double last_y_;
-  /// GSL iterator for interpolation lookups.
-  gsl_interp_accel* acc_;
   /// GSL spline.
   gsl_spline* spline_;
 };
@@ -10,12 +10,65 @@
 #ifndef SRC_INCLUDE_SMASH_INTERPOLATION2D_H_
 #define SRC_INCLUDE_SMASH_INTERPOLATION2D_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 #include "gsl/gsl_spline2d.h"
 
 namespace smash {
 
+/**
+ * Locate the interval of a sorted grid containing a value in constant time.
+ *
+ * The range of the grid is divided into uniform buckets narrower than the
+ * smallest interval of the grid, such that every bucket holds at most one
+ * grid point. The interval is then found from the bucket of the value with at
+ * most one comparison, instead of a binary search, and it is the same as the
+ * one found by a binary search. This works for any strictly increasing grid,
+ * also for piecewise uniform or logarithmic ones.
+ */
+class GridAxis {
+ public:
+  /**
+   * \param x Strictly increasing grid points, at least two.
+   * \throw std::runtime_error if the points are not strictly increasing.
+   */
+  explicit GridAxis(const std::vector<double>& x);
+
+  /**
+   * \param x Value within the range of the grid.
+   * \return Index i of the interval [x_i, x_{i+1}] containing \p x, the last
+   *         interval for the last point.
+   */
+  std::size_t interval(double x) const {
+    const double position = (x - x_.front()) * inv_bucket_width_;
+    std::size_t bucket = position > 0. ? static_cast<std::size_t>(position) : 0;
+    bucket = bucket < first_point_.size() ? bucket : first_point_.size() - 1;
+    std::size_t i = first_point_[bucket];
+    // Correct for the rounding of the bucket at its edges
+    while (i > 0 && x_[i] > x) {
+      i--;
+    }
+    while (i + 2 < x_.size() && x_[i + 1] <= x) {
+      i++;
+    }
+    return i;
+  }
+
+  /// \return The grid points.
+  const std::vector<double>& points() const { return x_; }
+
+ private:
+  /// The grid points
+  std::vector<double> x_;
+  /// Number of buckets per unit of x
+  double inv_bucket_width_;
+  /// Index of the interval at the lower edge of every bucket
+  std::vector<std::uint32_t> first_point_;
+};
+
 /// Represent a bicubic spline interpolation.
 class InterpolateData2DSpline {
  public:
@@ -25,15 +78,24 @@ class InterpolateData2DSpline {
    * \param x x-values.
    * \param y y-values.
    * \param z z-values
+   * \param grid_lookup Whether the interpolation is evaluated by the
+   *        GridAxis lookup of the intervals and the Hermite form of the
+   *        bicubic patches instead of by GSL.
    * \return The interpolation function.
    *
    * A bicubic spline interpolation is used.
    * Values outside the given samples will use the outmost sample
    * as a constant extrapolation.
+   *
+   * With \p grid_lookup the values and derivatives of the GSL spline at the
+   * grid points are stored, from which every bicubic patch is reconstructed.
+   * This is the same interpolation up to rounding, but it needs no binary
+   * search and no GSL accelerator, which is moreover not thread-safe.
    */
   InterpolateData2DSpline(const std::vector<double>& x,
                           const std::vector<double>& y,
-                          const std::vector<double>& z);
+                          const std::vector<double>& z,
+                          bool grid_lookup = false);
 
   /// Destructor
   ~InterpolateData2DSpline();
@@ -48,6 +110,27 @@ class InterpolateData2DSpline {
   double operator()(double xi, double yi) const;
 
  private:
+  /**
+   * Evaluate the Hermite form of the bicubic patch containing the point.
+   *
+   *  \param xi Interpolation argument in first dimension, within the grid.
+   *  \param yi Interpolation argument in second dimension, within the grid.
+   *  \return Interpolated value.
+   */
+  double evaluate_on_grid(double xi, double yi) const;
+
+  /// Value and derivatives of the spline at a grid point
+  struct Node {
+    /// Value
+    double z;
+    /// Derivative in x direction
+    double dz_dx;
+    /// Derivative in y direction
+    double dz_dy;
+    /// Mixed second derivative
+    double d2z_dxdy;
+  };
+
   /// First x value.
   double first_x_;
   /// Last x value.
@@ -63,6 +146,13 @@ class InterpolateData2DSpline {
   gsl_interp_accel* yacc_;
   /// GSL spline in 2D.
   gsl_spline2d* spline_;
+
+  /// Grid in x direction, only used with the grid lookup
+  std::optional<GridAxis> x_axis_;
+  /// Grid in y direction, only used with the grid lookup
+  std::optional<GridAxis> y_axis_;
+  /// Grid points ordered like the z-values, empty without the grid lookup
+  std::vector<Node> nodes_;
 };
 
 }  // namespace smash
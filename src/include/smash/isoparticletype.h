@@ -16,6 +16,7 @@
 #include "particletype.h"
 #include "sha256.h"
 #include "tabulation.h"
+#include "threadpool.h"
 
 namespace smash {
 
@@ -203,6 +204,13 @@ class IsoParticleType {
    */
   static void create_multiplet(const ParticleType &type);
 
+  /**
+   * Compute the minimal masses and the isospins of all particle types, which
+   * are otherwise computed on first use, before integrals are tabulated by
+   * several threads or while other threads use the particle types.
+   */
+  static void prepare_concurrent_tabulation();
+
   /**
    * Tabulate all relevant integrals.
    *
@@ -211,9 +219,18 @@ class IsoParticleType {
    *             reused or not.
    * \param tabulations_path The path to the directory where the tabulations are
    * cached.
+   * \param thread_pool If given, the integrals which are not cached are
+   * tabulated concurrently by its threads.
+   * \param lazy Whether every integral is only tabulated when it is looked up
+   * for the first time, instead of all of them right away.
+   * \param shared Whether the integrals are taken from a single TabulationFile
+   * in the tabulations directory, which is mapped into memory and shared with
+   * other processes, and whether this file is written if it is incomplete.
    */
   static void tabulate_integrals(sha256::Hash hash,
-                                 const std::filesystem::path &tabulations_path);
+                                 const std::filesystem::path &tabulations_path,
+                                 ThreadPool *thread_pool = nullptr,
+                                 bool lazy = false, bool shared = false);
 
   /**
    * Look up the tabulated resonance integral for the XX -> NR cross section.
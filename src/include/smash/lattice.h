@@ -10,15 +10,18 @@
 #ifndef SRC_INCLUDE_SMASH_LATTICE_H_
 #define SRC_INCLUDE_SMASH_LATTICE_H_
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <optional>
 #include <utility>
 #include <vector>
 
 #include "forwarddeclarations.h"
 #include "fourvector.h"
+#include "hugepages.h"
 #include "logging.h"
 #include "numeric_cast.h"
 #include "numerics.h"
@@ -41,6 +44,29 @@ enum class LatticeUpdate {
   EveryFixedInterval = 2,
 };
 
+/**
+ * A range of layers of cells of a lattice along the z direction, which
+ * restricts the nodes written by the iterating functions of
+ * RectangularLattice. By default, all layers are included.
+ *
+ * Several threads can write the same lattice concurrently, if each one is
+ * restricted to its own layers. The layers of different threads then have to
+ * consist of whole tiles, see RectangularLattice::tile_size, such that no tile
+ * is marked as occupied by two threads.
+ */
+struct LatticeLayers {
+  /// First layer (included)
+  int begin = 0;
+  /// Last layer (excluded)
+  int end = std::numeric_limits<int>::max();
+
+  /**
+   * \param[in] iz Index of the cell in z direction, inside the lattice.
+   * \return Whether the layer of the cell is in the range.
+   */
+  bool contain(int iz) const { return begin <= iz && iz < end; }
+};
+
 /**
  * A container class to hold all the arrays on the lattice and access them.
  * \tparam T The type of the contained values.
@@ -48,6 +74,9 @@ enum class LatticeUpdate {
 template <typename T>
 class RectangularLattice {
  public:
+  /// The storage of the nodes, backed by huge pages if enabled, see HugePages
+  using Storage = std::vector<T, HugePageAllocator<T>>;
+
   /**
    * Rectangular lattice constructor.
    *
@@ -77,6 +106,7 @@ class RectangularLattice {
         periodic_(per),
         when_update_(upd) {
     lattice_.resize(n_cells_[0] * n_cells_[1] * n_cells_[2]);
+    resize_tiles();
     logg[LLattice].debug(
         "Rectangular lattice created: sizes[fm] = (", lattice_sizes_[0], ",",
         lattice_sizes_[1], ",", lattice_sizes_[2], "), dims = (", n_cells_[0],
@@ -100,10 +130,64 @@ class RectangularLattice {
         cell_volume_(rl.cell_volume_),
         origin_(rl.origin_),
         periodic_(rl.periodic_),
-        when_update_(rl.when_update_) {}
+        when_update_(rl.when_update_),
+        n_tiles_(rl.n_tiles_),
+        occupied_tiles_(rl.occupied_tiles_) {}
 
-  /// Sets all values on lattice to zeros.
-  void reset() { std::fill(lattice_.begin(), lattice_.end(), T()); }
+  /// Sets all values on lattice to zeros and marks all tiles as unoccupied.
+  void reset() {
+    std::fill(lattice_.begin(), lattice_.end(), T());
+    std::fill(occupied_tiles_.begin(), occupied_tiles_.end(), false);
+  }
+
+  /**
+   * Number of cells along each side of the tiles, in which the lattice keeps
+   * track of the nodes it iterated over.
+   */
+  static constexpr int tile_size = 8;
+
+  /// \return Number of tiles of the lattice.
+  std::size_t n_tiles() const { return occupied_tiles_.size(); }
+
+  /**
+   * Checks whether any node of a tile was passed to a function by
+   * iterate_sublattice() (and hence iterate_in_cube() or
+   * iterate_in_rectangle()) or iterate_nearest_neighbors() since the last
+   * reset. Nodes accessed in any other way, e.g. by operator[], are not
+   * tracked. Hence, the nodes of an unoccupied tile are only known to be
+   * zero if the lattice was reset and then only filled by these functions.
+   *
+   * \param[in] tile Index of the tile, smaller than n_tiles().
+   * \return Whether the tile is occupied.
+   */
+  bool tile_occupied(std::size_t tile) const { return occupied_tiles_[tile]; }
+
+  /**
+   * Applies a function to all nodes of a tile, independent of whether the tile
+   * is occupied.
+   *
+   * \tparam F Type of the function. Arguments are the current node and its
+   * 1-dimensional index.
+   * \param[in] tile Index of the tile, smaller than n_tiles().
+   * \param[in] func Function acting on the nodes.
+   */
+  template <typename F>
+  void iterate_tile(std::size_t tile, F&& func) {
+    const int tx = tile % n_tiles_[0];
+    const int ty = (tile / n_tiles_[0]) % n_tiles_[1];
+    const int tz = tile / (n_tiles_[0] * n_tiles_[1]);
+    const int x_end = std::min(n_cells_[0], (tx + 1) * tile_size);
+    const int y_end = std::min(n_cells_[1], (ty + 1) * tile_size);
+    const int z_end = std::min(n_cells_[2], (tz + 1) * tile_size);
+    for (int iz = tz * tile_size; iz < z_end; iz++) {
+      for (int iy = ty * tile_size; iy < y_end; iy++) {
+        const std::size_t y_offset = n_cells_[0] * (iy + n_cells_[1] * iz);
+        for (int ix = tx * tile_size; ix < x_end; ix++) {
+          func(lattice_[ix + y_offset], ix + y_offset);
+        }
+      }
+    }
+  }
 
   /**
    * Checks if 3D index is out of lattice bounds.
@@ -171,9 +255,9 @@ class RectangularLattice {
   LatticeUpdate when_update() const { return when_update_; }
 
   /// Iterator of lattice.
-  using iterator = typename std::vector<T>::iterator;
+  using iterator = typename Storage::iterator;
   /// Const interator of lattice.
-  using const_iterator = typename std::vector<T>::const_iterator;
+  using const_iterator = typename Storage::const_iterator;
   /// \return First element of lattice.
   iterator begin() { return lattice_.begin(); }
   /// \return First element of lattice (const).
@@ -189,6 +273,9 @@ class RectangularLattice {
   /// \return Size of lattice.
   std::size_t size() const { return lattice_.size(); }
 
+  /// \return Memory allocated for the nodes of the lattice [bytes].
+  std::size_t memory_usage() const { return lattice_.capacity() * sizeof(T); }
+
   /**
    * Overwrite with a template value T at a given node
    */
@@ -336,74 +423,32 @@ class RectangularLattice {
     const double inv_2dx = 0.5 / cell_sizes_[0];
     const double inv_2dy = 0.5 / cell_sizes_[1];
     const double inv_2dz = 0.5 / cell_sizes_[2];
-    const int dix = 1;
     const int diy = n_cells_[0];
     const int diz = n_cells_[0] * n_cells_[1];
     const int d = diz * n_cells_[2];
+    const int last_ix = n_cells_[0] - 1;
+    const Stencil first_x = stencil(0, n_cells_[0], 1, diy);
+    const Stencil interior_x = stencil(1, n_cells_[0], 1, diy);
+    const Stencil last_x = stencil(last_ix, n_cells_[0], 1, diy);
 
     for (int iz = 0; iz < n_cells_[2]; iz++) {
       const int z_offset = diz * iz;
+      const Stencil sz = stencil(iz, n_cells_[2], diz, d);
       for (int iy = 0; iy < n_cells_[1]; iy++) {
         const int y_offset = diy * iy + z_offset;
-        for (int ix = 0; ix < n_cells_[0]; ix++) {
-          const int index = ix + y_offset;
-          if (unlikely(ix == 0)) {
-            (grad_lat)[index].set_x1(
-                periodic_
-                    ? (lattice_[index + dix] - lattice_[index + diy - dix]) *
-                          inv_2dx
-                    : (lattice_[index + dix] - lattice_[index]) * 2.0 *
-                          inv_2dx);
-          } else if (unlikely(ix == n_cells_[0] - 1)) {
-            (grad_lat)[index].set_x1(
-                periodic_
-                    ? (lattice_[index - diy + dix] - lattice_[index - dix]) *
-                          inv_2dx
-                    : (lattice_[index] - lattice_[index - dix]) * 2.0 *
-                          inv_2dx);
-          } else {
-            (grad_lat)[index].set_x1(
-                (lattice_[index + dix] - lattice_[index - dix]) * inv_2dx);
-          }
-
-          if (unlikely(iy == 0)) {
-            (grad_lat)[index].set_x2(
-                periodic_
-                    ? (lattice_[index + diy] - lattice_[index + diz - diy]) *
-                          inv_2dy
-                    : (lattice_[index + diy] - lattice_[index]) * 2.0 *
-                          inv_2dy);
-          } else if (unlikely(iy == n_cells_[1] - 1)) {
-            (grad_lat)[index].set_x2(
-                periodic_
-                    ? (lattice_[index - diz + diy] - lattice_[index - diy]) *
-                          inv_2dy
-                    : (lattice_[index] - lattice_[index - diy]) * 2.0 *
-                          inv_2dy);
-          } else {
-            (grad_lat)[index].set_x2(
-                (lattice_[index + diy] - lattice_[index - diy]) * inv_2dy);
-          }
-
-          if (unlikely(iz == 0)) {
-            (grad_lat)[index].set_x3(
-                periodic_
-                    ? (lattice_[index + diz] - lattice_[index + d - diz]) *
-                          inv_2dz
-                    : (lattice_[index + diz] - lattice_[index]) * 2.0 *
-                          inv_2dz);
-          } else if (unlikely(iz == n_cells_[2] - 1)) {
-            (grad_lat)[index].set_x3(
-                periodic_
-                    ? (lattice_[index - d + diz] - lattice_[index - diz]) *
-                          inv_2dz
-                    : (lattice_[index] - lattice_[index - diz]) * 2.0 *
-                          inv_2dz);
-          } else {
-            (grad_lat)[index].set_x3(
-                (lattice_[index + diz] - lattice_[index - diz]) * inv_2dz);
-          }
+        const Stencil sy = stencil(iy, n_cells_[1], diy, diz);
+        auto gradient = [&](int index, const Stencil& sx) {
+          return ThreeVector(difference_quotient(index, sx, inv_2dx),
+                             difference_quotient(index, sy, inv_2dy),
+                             difference_quotient(index, sz, inv_2dz));
+        };
+        /* The first and the last node of the row are treated separately, such
+         * that the loop over the interior of the row has no branches. */
+        grad_lat[y_offset] = gradient(y_offset, first_x);
+        for (int ix = 1; ix < last_ix; ix++) {
+          grad_lat[ix + y_offset] = gradient(ix + y_offset, interior_x);
         }
+        grad_lat[last_ix + y_offset] = gradient(last_ix + y_offset, last_x);
       }
     }
   }
@@ -435,82 +480,36 @@ class RectangularLattice {
     const double inv_2dx = 0.5 / cell_sizes_[0];
     const double inv_2dy = 0.5 / cell_sizes_[1];
     const double inv_2dz = 0.5 / cell_sizes_[2];
-    const int dix = 1;
     const int diy = n_cells_[0];
     const int diz = n_cells_[0] * n_cells_[1];
     const int d = diz * n_cells_[2];
+    const int last_ix = n_cells_[0] - 1;
+    const Stencil first_x = stencil(0, n_cells_[0], 1, diy);
+    const Stencil interior_x = stencil(1, n_cells_[0], 1, diy);
+    const Stencil last_x = stencil(last_ix, n_cells_[0], 1, diy);
 
     for (int iz = 0; iz < n_cells_[2]; iz++) {
       const int z_offset = diz * iz;
+      const Stencil sz = stencil(iz, n_cells_[2], diz, d);
       for (int iy = 0; iy < n_cells_[1]; iy++) {
         const int y_offset = diy * iy + z_offset;
-        for (int ix = 0; ix < n_cells_[0]; ix++) {
-          const int index = ix + y_offset;
-
-          // auxiliary vectors used for the calculation of gradients
-          FourVector grad_t_jmu(0.0, 0.0, 0.0, 0.0);
-          FourVector grad_x_jmu(0.0, 0.0, 0.0, 0.0);
-          FourVector grad_y_jmu(0.0, 0.0, 0.0, 0.0);
-          FourVector grad_z_jmu(0.0, 0.0, 0.0, 0.0);
+        const Stencil sy = stencil(iy, n_cells_[1], diy, diz);
+        auto fill = [&](int index, const Stencil& sx) {
+          std::array<FourVector, 4>& grad = grad_lat[index];
           // t direction
-          grad_t_jmu = (lattice_[index] - (old_lat)[index]) * (1.0 / time_step);
-          // x direction
-          if (unlikely(ix == 0)) {
-            grad_x_jmu =
-                periodic_
-                    ? (lattice_[index + dix] - lattice_[index + diy - dix]) *
-                          inv_2dx
-                    : (lattice_[index + dix] - lattice_[index]) * 2.0 * inv_2dx;
-          } else if (unlikely(ix == n_cells_[0] - 1)) {
-            grad_x_jmu =
-                periodic_
-                    ? (lattice_[index - diy + dix] - lattice_[index - dix]) *
-                          inv_2dx
-                    : (lattice_[index] - lattice_[index - dix]) * 2.0 * inv_2dx;
-          } else {
-            grad_x_jmu =
-                (lattice_[index + dix] - lattice_[index - dix]) * inv_2dx;
-          }
-          // y direction
-          if (unlikely(iy == 0)) {
-            grad_y_jmu =
-                periodic_
-                    ? (lattice_[index + diy] - lattice_[index + diz - diy]) *
-                          inv_2dy
-                    : (lattice_[index + diy] - lattice_[index]) * 2.0 * inv_2dy;
-          } else if (unlikely(iy == n_cells_[1] - 1)) {
-            grad_y_jmu =
-                periodic_
-                    ? (lattice_[index - diz + diy] - lattice_[index - diy]) *
-                          inv_2dy
-                    : (lattice_[index] - lattice_[index - diy]) * 2.0 * inv_2dy;
-          } else {
-            grad_y_jmu =
-                (lattice_[index + diy] - lattice_[index - diy]) * inv_2dy;
-          }
-          // z direction
-          if (unlikely(iz == 0)) {
-            grad_z_jmu =
-                periodic_
-                    ? (lattice_[index + diz] - lattice_[index + d - diz]) *
-                          inv_2dz
-                    : (lattice_[index + diz] - lattice_[index]) * 2.0 * inv_2dz;
-          } else if (unlikely(iz == n_cells_[2] - 1)) {
-            grad_z_jmu =
-                periodic_
-                    ? (lattice_[index - d + diz] - lattice_[index - diz]) *
-                          inv_2dz
-                    : (lattice_[index] - lattice_[index - diz]) * 2.0 * inv_2dz;
-          } else {
-            grad_z_jmu =
-                (lattice_[index + diz] - lattice_[index - diz]) * inv_2dz;
-          }
-          // fill
-          (grad_lat)[index][0] = grad_t_jmu;
-          (grad_lat)[index][1] = grad_x_jmu;
-          (grad_lat)[index][2] = grad_y_jmu;
-          (grad_lat)[index][3] = grad_z_jmu;
+          grad[0] = (lattice_[index] - (old_lat)[index]) * (1.0 / time_step);
+          // x, y and z directions
+          grad[1] = difference_quotient(index, sx, inv_2dx);
+          grad[2] = difference_quotient(index, sy, inv_2dy);
+          grad[3] = difference_quotient(index, sz, inv_2dz);
+        };
+        /* The first and the last node of the row are treated separately, such
+         * that the loop over the interior of the row has no branches. */
+        fill(y_offset, first_x);
+        for (int ix = 1; ix < last_ix; ix++) {
+          fill(ix + y_offset, interior_x);
         }
+        fill(last_ix + y_offset, last_x);
       }
     }
   }
@@ -552,6 +551,21 @@ class RectangularLattice {
    * \todo (oliiny): maybe 1-order interpolation instead of 0-order?
    */
   bool value_at(const ThreeVector& r, T& value) const {
+    const T* const cell = node_at(r);
+    value = cell ? *cell : T();
+    return cell != nullptr;
+  }
+
+  /**
+   * Finds the node of the cell containing the coordinate r, without copying
+   * its value. Nodes can thus be told apart, e.g. to reuse values derived
+   * from them.
+   *
+   * \param[in] r Position of interest.
+   * \return Pointer to the node of the cell containing r, or nullptr if r is
+   *         out of the lattice.
+   */
+  const T* node_at(const ThreeVector& r) const {
     const int ix =
         numeric_cast<int>(std::floor((r.x1() - origin_[0]) / cell_sizes_[0]));
     const int iy =
@@ -559,12 +573,9 @@ class RectangularLattice {
     const int iz =
         numeric_cast<int>(std::floor((r.x3() - origin_[2]) / cell_sizes_[2]));
     if (out_of_bounds(ix, iy, iz)) {
-      value = T();
-      return false;
-    } else {
-      value = node(ix, iy, iz);
-      return true;
+      return nullptr;
     }
+    return &node(ix, iy, iz);
   }
 
   /**
@@ -580,34 +591,32 @@ class RectangularLattice {
   template <typename F>
   void iterate_sublattice(const std::array<int, 3>& lower_bounds,
                           const std::array<int, 3>& upper_bounds, F&& func) {
+    iterate_sublattice(lower_bounds, upper_bounds, LatticeLayers{},
+                       std::forward<F>(func));
+  }
+
+  /**
+   * A sub-lattice iterator like above, which only calls the function on the
+   * cells in the given layers.
+   *
+   * \tparam F Type of the function. Arguments are the current node and the 3
+   * integer indices of the cell.
+   * \param[in] lower_bounds Starting numbers for iterating ix, iy, iz.
+   * \param[in] upper_bounds Ending numbers for iterating ix, iy, iz.
+   * \param[in] layers The layers of cells to be iterated.
+   * \param[in] func Function acting on the cells (such as taking value).
+   */
+  template <typename F>
+  void iterate_sublattice(const std::array<int, 3>& lower_bounds,
+                          const std::array<int, 3>& upper_bounds,
+                          const LatticeLayers& layers, F&& func) {
     logg[LLattice].debug(
         "Iterating sublattice with lower bound index (", lower_bounds[0], ",",
         lower_bounds[1], ",", lower_bounds[2], "), upper bound index (",
         upper_bounds[0], ",", upper_bounds[1], ",", upper_bounds[2], ")");
-
-    if (periodic_) {
-      for (int iz = lower_bounds[2]; iz < upper_bounds[2]; iz++) {
-        const int z_offset = positive_modulo(iz, n_cells_[2]) * n_cells_[1];
-        for (int iy = lower_bounds[1]; iy < upper_bounds[1]; iy++) {
-          const int y_offset =
-              n_cells_[0] * (positive_modulo(iy, n_cells_[1]) + z_offset);
-          for (int ix = lower_bounds[0]; ix < upper_bounds[0]; ix++) {
-            const int index = positive_modulo(ix, n_cells_[0]) + y_offset;
-            func(lattice_[index], ix, iy, iz);
-          }
-        }
-      }
-    } else {
-      for (int iz = lower_bounds[2]; iz < upper_bounds[2]; iz++) {
-        const int z_offset = iz * n_cells_[1];
-        for (int iy = lower_bounds[1]; iy < upper_bounds[1]; iy++) {
-          const int y_offset = n_cells_[0] * (iy + z_offset);
-          for (int ix = lower_bounds[0]; ix < upper_bounds[0]; ix++) {
-            func(lattice_[ix + y_offset], ix, iy, iz);
-          }
-        }
-      }
-    }
+    mark_occupied(lower_bounds, upper_bounds, layers);
+    visit_sublattice(*this, lower_bounds, upper_bounds, std::forward<F>(func),
+                     layers);
   }
 
   /**
@@ -625,6 +634,24 @@ class RectangularLattice {
    */
   template <typename F>
   void iterate_in_cube(const ThreeVector& point, const double r_cut, F&& func) {
+    iterate_in_cube(point, r_cut, LatticeLayers{}, std::forward<F>(func));
+  }
+
+  /**
+   * Iterates within a cube like above, but only over the cells in the given
+   * layers.
+   *
+   * \tparam F Type of the function. Arguments are the current node and the 3
+   * integer indices of the cell.
+   * \param[in] point Position, usually the position of particle [fm].
+   * \param[in] r_cut Maximum distance from the cell center to the
+   *            given position. [fm]
+   * \param[in] layers The layers of cells to be iterated.
+   * \param[in] func Function acting on the cells (such as taking value).
+   */
+  template <typename F>
+  void iterate_in_cube(const ThreeVector& point, const double r_cut,
+                       const LatticeLayers& layers, F&& func) {
     std::array<int, 3> l_bounds, u_bounds;
 
     /* Array holds value at the cell center: r_center = r_0 + (i+0.5)cell_size,
@@ -650,7 +677,7 @@ class RectangularLattice {
         }
       }
     }
-    iterate_sublattice(l_bounds, u_bounds, std::forward<F>(func));
+    iterate_sublattice(l_bounds, u_bounds, layers, std::forward<F>(func));
   }
 
   /**
@@ -663,17 +690,25 @@ class RectangularLattice {
    * \param[in] rcut size of the integration volume. In total the intgration
    *                 volume will be a cube with edge length 2*rcut
    * \param[in] point center of the integration volume
+   *
+   * The nodes are only read, hence several integrals over the same lattice
+   * can be computed concurrently.
    **/
   template <typename F>
   void integrate_volume(F& integral,
                         F (*integrand)(ThreeVector, T&, ThreeVector),
-                        const double rcut, const ThreeVector& point) {
-    iterate_in_rectangle(
-        point, {rcut, rcut, rcut},
-        [&point, &integral, &integrand, this](T value, int ix, int iy, int iz) {
-          ThreeVector pos = this->cell_center(ix, iy, iz);
-          integral += integrand(pos, value, point) * this->cell_volume_;
-        });
+                        const double rcut, const ThreeVector& point) const {
+    std::array<int, 3> l_bounds, u_bounds;
+    if (!rectangle_bounds(point, {rcut, rcut, rcut}, l_bounds, u_bounds)) {
+      return;
+    }
+    visit_sublattice(*this, l_bounds, u_bounds,
+                     [&point, &integral, &integrand, this](
+                         T value, int ix, int iy, int iz) {
+                       ThreeVector pos = this->cell_center(ix, iy, iz);
+                       integral +=
+                           integrand(pos, value, point) * this->cell_volume_;
+                     });
   }
   /**
    * Iterates only nodes whose cell centers lie not further than d_x in x-,
@@ -692,34 +727,30 @@ class RectangularLattice {
   template <typename F>
   void iterate_in_rectangle(const ThreeVector& point,
                             const std::array<double, 3>& rectangle, F&& func) {
-    std::array<int, 3> l_bounds, u_bounds;
-
-    /* Array holds value at the cell center: r_center = r_0 + (i+0.5)cell_size,
-     * where i is index in any direction. Therefore we want cells with condition
-     * (r[i]-rectangle[i])/csize - 0.5 < i < (r[i]+rectangle[i])/csize - 0.5,
-     * r[i] = r_center[i] - r_0[i]
-     */
-    for (int i = 0; i < 3; i++) {
-      l_bounds[i] = numeric_cast<int>(std::ceil(
-          (point[i] - origin_[i] - rectangle[i]) / cell_sizes_[i] - 0.5));
-      u_bounds[i] = numeric_cast<int>(std::ceil(
-          (point[i] - origin_[i] + rectangle[i]) / cell_sizes_[i] - 0.5));
-    }
+    iterate_in_rectangle(point, rectangle, LatticeLayers{},
+                         std::forward<F>(func));
+  }
 
-    if (!periodic_) {
-      for (int i = 0; i < 3; i++) {
-        if (l_bounds[i] < 0) {
-          l_bounds[i] = 0;
-        }
-        if (u_bounds[i] > n_cells_[i]) {
-          u_bounds[i] = n_cells_[i];
-        }
-        if (l_bounds[i] > n_cells_[i] || u_bounds[i] < 0) {
-          return;
-        }
-      }
+  /**
+   * Iterates within a rectangle like above, but only over the cells in the
+   * given layers.
+   *
+   * \tparam F Type of the function. Arguments are the current node and the 3
+   * integer indices of the cell.
+   * \param[in] point Position, usually the position of particle [fm].
+   * \param[in] rectangle Maximum distances in the x-, y-, and z-directions
+   * from the cell center to the given position. [fm]
+   * \param[in] layers The layers of cells to be iterated.
+   * \param[in] func Function acting on the cells (such as taking value).
+   */
+  template <typename F>
+  void iterate_in_rectangle(const ThreeVector& point,
+                            const std::array<double, 3>& rectangle,
+                            const LatticeLayers& layers, F&& func) {
+    std::array<int, 3> l_bounds, u_bounds;
+    if (rectangle_bounds(point, rectangle, l_bounds, u_bounds)) {
+      iterate_sublattice(l_bounds, u_bounds, layers, std::forward<F>(func));
     }
-    iterate_sublattice(l_bounds, u_bounds, std::forward<F>(func));
   }
 
   /**
@@ -735,6 +766,22 @@ class RectangularLattice {
    */
   template <typename F>
   void iterate_nearest_neighbors(const ThreeVector& point, F&& func) {
+    iterate_nearest_neighbors(point, LatticeLayers{}, std::forward<F>(func));
+  }
+
+  /**
+   * Iterates over the center cell and its nearest neighbors like above, but
+   * only over the cells in the given layers.
+   *
+   * \tparam F Type of the function. Arguments are the current node, its 1D
+   * index and the 1D index of the center cell.
+   * \param[in] point Position, usually the position of particle [fm].
+   * \param[in] layers The layers of cells to be iterated.
+   * \param[in] func Function acting on the cells (such as taking value).
+   */
+  template <typename F>
+  void iterate_nearest_neighbors(const ThreeVector& point,
+                                 const LatticeLayers& layers, F&& func) {
     // get the 3D indices of the cell containing the given point
     const int ix = numeric_cast<int>(
         std::floor((point.x1() - origin_[0]) / cell_sizes_[0]));
@@ -747,28 +794,25 @@ class RectangularLattice {
         "Iterating over nearest neighbors of the cell at ix = ", ix,
         ", iy = ", iy, ", iz = ", iz);
 
+    mark_occupied({ix - 1, iy - 1, iz - 1}, {ix + 2, iy + 2, iz + 2}, layers);
+
     // determine the 1D index of the center cell
     const int i = index1d(ix, iy, iz);
-    func(lattice_[i], i, i);
+    const int layer_size = n_cells_[0] * n_cells_[1];
+    auto visit = [&](int index) {
+      if (layers.contain(index / layer_size)) {
+        func(lattice_[index], index, i);
+      }
+    };
+    visit(i);
 
     // determine the indeces of nearby cells, perform function on them
-    int ileft = index_left(ix, iy, iz);
-    func(lattice_[ileft], ileft, i);
-
-    int iright = index_right(ix, iy, iz);
-    func(lattice_[iright], iright, i);
-
-    int idown = index_down(ix, iy, iz);
-    func(lattice_[idown], idown, i);
-
-    int iup = index_up(ix, iy, iz);
-    func(lattice_[iup], iup, i);
-
-    int ibackward = index_backward(ix, iy, iz);
-    func(lattice_[ibackward], ibackward, i);
-
-    int iforward = index_forward(ix, iy, iz);
-    func(lattice_[iforward], iforward, i);
+    visit(index_left(ix, iy, iz));
+    visit(index_right(ix, iy, iz));
+    visit(index_down(ix, iy, iz));
+    visit(index_up(ix, iy, iz));
+    visit(index_backward(ix, iy, iz));
+    visit(index_forward(ix, iy, iz));
   }
 
   /**
@@ -822,17 +866,20 @@ class RectangularLattice {
       lattice_sizes_ = *new_length;
     if (new_origin)
       origin_ = *new_origin;
-    if (new_cells)
+    if (new_cells) {
       n_cells_ = *new_cells;
+      lattice_.resize(n_cells_[0] * n_cells_[1] * n_cells_[2]);
+    }
     cell_sizes_ = {lattice_sizes_[0] / n_cells_[0],
                    lattice_sizes_[1] / n_cells_[1],
                    lattice_sizes_[2] / n_cells_[2]};
     cell_volume_ = cell_sizes_[0] * cell_sizes_[1] * cell_sizes_[2];
+    resize_tiles();
   }
 
  protected:
   /// The lattice itself, array containing physical quantities.
-  std::vector<T> lattice_;
+  Storage lattice_;
   /// Lattice sizes in x, y, z directions.
   std::array<double, 3> lattice_sizes_;
   /// Number of cells in x,y,z directions.
@@ -847,8 +894,214 @@ class RectangularLattice {
   const bool periodic_;
   /// When the lattice should be recalculated.
   const LatticeUpdate when_update_;
+  /// Number of tiles in x, y, z directions.
+  std::array<int, 3> n_tiles_;
+  /**
+   * Whether each tile is occupied, see tile_occupied(). The flags are stored
+   * in separate bytes, such that threads writing different tiles do not
+   * interfere.
+   */
+  std::vector<unsigned char> occupied_tiles_;
 
  private:
+  /**
+   * Offsets of the two nodes, whose difference gives the derivative along one
+   * direction at a node, relative to this node.
+   */
+  struct Stencil {
+    /// Offset of the node in positive direction
+    int plus;
+    /// Offset of the node in negative direction
+    int minus;
+    /// Whether the difference is one-sided, i.e. one of the nodes is the node
+    bool one_sided;
+  };
+
+  /**
+   * Finds the stencil along one direction, which is one-sided at the
+   * boundaries of a non-periodic lattice and wraps around the boundaries of a
+   * periodic one.
+   *
+   * \param[in] i Index of the node along the direction.
+   * \param[in] n Number of cells along the direction.
+   * \param[in] step Offset of the 1-dimensional index between neighbours.
+   * \param[in] period Offset of the 1-dimensional index of the lattice period.
+   * \return The stencil at the node.
+   */
+  Stencil stencil(int i, int n, int step, int period) const {
+    if (i == 0) {
+      return periodic_ ? Stencil{step, period - step, false}
+                       : Stencil{step, 0, true};
+    } else if (i == n - 1) {
+      return periodic_ ? Stencil{-period + step, -step, false}
+                       : Stencil{0, -step, true};
+    }
+    return Stencil{step, -step, false};
+  }
+
+  /**
+   * Computes the finite difference derivative at a node along one direction.
+   *
+   * \param[in] index 1-dimensional index of the node.
+   * \param[in] s The stencil at the node along the direction.
+   * \param[in] inv_2d Inverse of twice the cell size along the direction.
+   * \return The derivative.
+   */
+  T difference_quotient(int index, const Stencil& s, double inv_2d) const {
+    const T difference = lattice_[index + s.plus] - lattice_[index + s.minus];
+    return s.one_sided ? difference * 2.0 * inv_2d : difference * inv_2d;
+  }
+
+  /// Sets the number of tiles from the number of cells, all unoccupied.
+  void resize_tiles() {
+    for (int i = 0; i < 3; i++) {
+      n_tiles_[i] = (n_cells_[i] + tile_size - 1) / tile_size;
+    }
+    occupied_tiles_.assign(n_tiles_[0] * n_tiles_[1] * n_tiles_[2], false);
+  }
+
+  /**
+   * Determines the cells whose centers lie not further than the given
+   * distances from a point, see iterate_in_rectangle().
+   *
+   * \param[in] point Position [fm].
+   * \param[in] rectangle Maximum distances in the x-, y-, and z-directions
+   * from the cell center to the given position. [fm]
+   * \param[out] l_bounds Lower bounds of the cell indices (included).
+   * \param[out] u_bounds Upper bounds of the cell indices (excluded).
+   * \return Whether any cell of a non-periodic lattice is within the bounds.
+   */
+  bool rectangle_bounds(const ThreeVector& point,
+                        const std::array<double, 3>& rectangle,
+                        std::array<int, 3>& l_bounds,
+                        std::array<int, 3>& u_bounds) const {
+    /* Array holds value at the cell center: r_center = r_0 + (i+0.5)cell_size,
+     * where i is index in any direction. Therefore we want cells with condition
+     * (r[i]-rectangle[i])/csize - 0.5 < i < (r[i]+rectangle[i])/csize - 0.5,
+     * r[i] = r_center[i] - r_0[i]
+     */
+    for (int i = 0; i < 3; i++) {
+      l_bounds[i] = numeric_cast<int>(std::ceil(
+          (point[i] - origin_[i] - rectangle[i]) / cell_sizes_[i] - 0.5));
+      u_bounds[i] = numeric_cast<int>(std::ceil(
+          (point[i] - origin_[i] + rectangle[i]) / cell_sizes_[i] - 0.5));
+    }
+
+    if (!periodic_) {
+      for (int i = 0; i < 3; i++) {
+        if (l_bounds[i] < 0) {
+          l_bounds[i] = 0;
+        }
+        if (u_bounds[i] > n_cells_[i]) {
+          u_bounds[i] = n_cells_[i];
+        }
+        if (l_bounds[i] > n_cells_[i] || u_bounds[i] < 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Calls a function on every cell of a sub-lattice, like
+   * iterate_sublattice(), but without marking the tiles as occupied. The
+   * nodes are passed as const references if the lattice is const.
+   *
+   * \tparam Lattice The type of the lattice, possibly const.
+   * \tparam F Type of the function. Arguments are the current node and the 3
+   * integer indices of the cell.
+   * \param[in] lattice The lattice to be iterated.
+   * \param[in] lower_bounds Starting numbers for iterating ix, iy, iz.
+   * \param[in] upper_bounds Ending numbers for iterating ix, iy, iz.
+   * \param[in] func Function acting on the cells.
+   * \param[in] layers The layers of cells to be visited, which are those of
+   *            the cells inside of a periodic lattice.
+   */
+  template <typename Lattice, typename F>
+  static void visit_sublattice(Lattice& lattice,
+                               const std::array<int, 3>& lower_bounds,
+                               const std::array<int, 3>& upper_bounds,
+                               F&& func, const LatticeLayers& layers = {}) {
+    const std::array<int, 3>& n_cells = lattice.n_cells_;
+    if (lattice.periodic_) {
+      for (int iz = lower_bounds[2]; iz < upper_bounds[2]; iz++) {
+        const int layer = lattice.positive_modulo(iz, n_cells[2]);
+        if (!layers.contain(layer)) {
+          continue;
+        }
+        const int z_offset = layer * n_cells[1];
+        for (int iy = lower_bounds[1]; iy < upper_bounds[1]; iy++) {
+          const int y_offset =
+              n_cells[0] * (lattice.positive_modulo(iy, n_cells[1]) + z_offset);
+          for (int ix = lower_bounds[0]; ix < upper_bounds[0]; ix++) {
+            const int index =
+                lattice.positive_modulo(ix, n_cells[0]) + y_offset;
+            func(lattice.lattice_[index], ix, iy, iz);
+          }
+        }
+      }
+    } else {
+      const int z_begin = std::max(lower_bounds[2], layers.begin);
+      const int z_end = std::min(upper_bounds[2], layers.end);
+      for (int iz = z_begin; iz < z_end; iz++) {
+        const int z_offset = iz * n_cells[1];
+        for (int iy = lower_bounds[1]; iy < upper_bounds[1]; iy++) {
+          const int y_offset = n_cells[0] * (iy + z_offset);
+          for (int ix = lower_bounds[0]; ix < upper_bounds[0]; ix++) {
+            func(lattice.lattice_[ix + y_offset], ix, iy, iz);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Marks all tiles which contain cells within the given bounds as occupied.
+   * If the bounds of a periodic lattice extend beyond the lattice, all tiles
+   * along this direction are marked. Bounds outside of a non-periodic lattice
+   * are clipped.
+   *
+   * Along z, only the tiles within the given layers are marked.
+   *
+   * \param[in] lower_bounds Lower bounds of the cell indices (included).
+   * \param[in] upper_bounds Upper bounds of the cell indices (excluded).
+   * \param[in] layers The layers of cells whose tiles can be marked.
+   */
+  void mark_occupied(const std::array<int, 3>& lower_bounds,
+                     const std::array<int, 3>& upper_bounds,
+                     const LatticeLayers& layers) {
+    std::array<int, 3> first_tile, last_tile;
+    for (int i = 0; i < 3; i++) {
+      int lower = lower_bounds[i], upper = upper_bounds[i];
+      if (lower < 0 || upper > n_cells_[i]) {
+        if (periodic_ && lower < upper) {
+          lower = 0;
+          upper = n_cells_[i];
+        } else {
+          lower = std::max(lower, 0);
+          upper = std::min(upper, n_cells_[i]);
+        }
+      }
+      if (i == 2) {
+        lower = std::max(lower, layers.begin);
+        upper = std::min(upper, layers.end);
+      }
+      if (lower >= upper) {
+        return;
+      }
+      first_tile[i] = lower / tile_size;
+      last_tile[i] = (upper - 1) / tile_size;
+    }
+    for (int tz = first_tile[2]; tz <= last_tile[2]; tz++) {
+      for (int ty = first_tile[1]; ty <= last_tile[1]; ty++) {
+        for (int tx = first_tile[0]; tx <= last_tile[0]; tx++) {
+          occupied_tiles_[tx + n_tiles_[0] * (ty + n_tiles_[1] * tz)] = true;
+        }
+      }
+    }
+  }
+
   /**
    * Returns division modulo, which is always between 0 and n-1
    * i%n is not suitable, because it returns results from -(n-1) to n-1
@@ -48,6 +48,12 @@ Configuration setup_config_and_logging(
  * particles and decaymodes.
  * \param[in] version Current version of SMASH.
  * \param[in] tabulations_dir Path where tabulations should be stored.
+ *
+ * The number of threads, the laziness of the tabulation and the use of a shared
+ * file are taken from the
+ * \ref key_gen_tabulation_threads_ "Tabulation_Threads",
+ * \ref key_gen_lazy_tabulations_ "Lazy_Tabulations" and
+ * \ref key_gen_shared_tabulations_ "Shared_Tabulations" keys.
  */
 void initialize_particles_decays_and_tabulations(
     Configuration &configuration, const std::string &version,
@@ -59,19 +65,29 @@ void initialize_particles_decays_and_tabulations(
  * \param[in] configuration Fully-setup configuration i.e. including
  * particles and decaymodes.
  * \param[in] version Current version of SMASH.
+ * \param[in] tabulations_dir Path where the TypeCache of the particles and
+ * decay modes is read from or stored, none if empty.
  * \return hash of the version, particle list, and decay modes.
  */
 sha256::Hash initialize_particles_decays_and_return_hash(
-    Configuration &configuration, const std::string &version);
+    Configuration &configuration, const std::string &version,
+    const std::string &tabulations_dir = {});
 
 /**
  * Tabulate the resonance integrals.
  *
  * \param[in] hash Hash of the SMASH version, particle list, and decay modes.
  * \param[in] tabulations_dir Path where tabulations should be stored.
+ * \param[in] n_threads Number of threads tabulating the integrals.
+ * \param[in] lazy Whether every integral is only tabulated on first use.
+ * \param[in] shared Whether the integrals are kept in one memory-mapped file
+ * in the tabulations directory.
+ * \throw std::invalid_argument if \p n_threads is not positive.
  */
 void tabulate_resonance_integrals(const sha256::Hash &hash,
-                                  const std::string &tabulations_dir);
+                                  const std::string &tabulations_dir,
+                                  int n_threads = 1, bool lazy = false,
+                                  bool shared = false);
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_LIBRARY_H_
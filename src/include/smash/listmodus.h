@@ -10,12 +10,16 @@
 #include <cmath>
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "forwarddeclarations.h"
 #include "modusdefault.h"
+#include "particlelistfile.h"
+#include "particleliststream.h"
 
 namespace smash {
 
@@ -66,7 +70,8 @@ class ListModus : public ModusDefault {
    * \param[in] parameters Necessary because of templated usage in Experiment
    *
    * \throw InvalidEvents If more than 2 particles are at the same position in
-   *        any of the events.
+   *        any of the events. The events of a stream are only checked when
+   *        they are read in initial_conditions().
    */
   explicit ListModus(Configuration modus_config,
                      const ExperimentParameters &parameters);
@@ -86,6 +91,8 @@ class ListModus : public ModusDefault {
    * \return The starting time of the simulation
    *
    * \see read_particles_from_next_event_ for possible exceptions thrown.
+   * \throw InvalidEvents If more than 2 particles of an event read from a
+   *        stream are at the same position.
    */
   double initial_conditions(Particles *particles,
                             const ExperimentParameters &parameters);
@@ -165,17 +172,18 @@ class ListModus : public ModusDefault {
   void read_particles_from_next_event_(Particles &particles);
 
   /**
-   * Check if the given file has events left after the given position.
+   * Create the particles of the blocks of a binary event.
    *
-   * \param[in] filepath Path to file to be checked
-   * \param[in] last_position Stream position in file after which check is
-   *                          performed
-   * \return \c true if there is at least one event left, \c false otherwise
+   * \param[in] blocks The particle blocks of the event.
+   * \param particles The list of particles where the read information is
+   *                  stored
    *
-   * \throw runtime_error If file could not be read for whatever reason
+   * \throw invalid_argument If an optional quantity is not part of the
+   *                         particle lines of the current file, or if the
+   *                         listed charge of a particle does not correspond to
+   *                         its pdg charge
    */
-  bool file_has_events_(std::filesystem::path filepath,
-                        std::streampos last_position);
+  void read_binary_particles_(std::string_view blocks, Particles &particles);
 
   /**
    * Return the absolute path of the data file. If an integer is passed, the
@@ -192,13 +200,16 @@ class ListModus : public ModusDefault {
   std::filesystem::path file_path_(std::optional<int> file_id);
 
   /**
-   * Read the next event. Either from the current file if it has more events
-   * or from the next file (with \c file_id_ += 1)
+   * Read the next event. Either from the stream, from the current file if it
+   * has more events or from the next file (with \c file_id_ += 1). The pages
+   * of the following event are prefetched.
    *
-   * \return One event as string.
-   * \throw runtime_error If file could not be read for whatever reason.
+   * \return One event, which is valid as long as \c file_, or until the next
+   *         event of a stream is read.
+   * \throw runtime_error If file could not be read for whatever reason or if
+   *        the stream has ended.
    */
-  std::string next_event_();
+  ParticleListFile::Event next_event_();
 
   /**
    * Read and validate all events particles. At the moment this is done w.r.t.
@@ -260,11 +271,28 @@ class ListModus : public ModusDefault {
 
   /// Fields with optional quantities to be read
   std::vector<std::string> optional_fields_{};
+  /// Format of the particle list files
+  ParticleListFile::Format file_format_ = ParticleListFile::Format::ASCII;
   /// The unique id of the current event
   int event_id_;
 
-  /// Last read position in current file
-  std::streampos last_read_position_ = 0;
+  /**
+   * The current file, which is shared by copies of this object. Every copy
+   * reads the events independently.
+   */
+  std::shared_ptr<const ParticleListFile> file_ = nullptr;
+
+  /// Number of the next event in the current file
+  std::size_t next_event_in_file_ = 0;
+
+  /**
+   * The stream of events, if they are not read from files. It is shared by
+   * copies of this object, which read the events in turn.
+   */
+  std::shared_ptr<ParticleListStream> stream_ = nullptr;
+
+  /// The content of the current event of the stream
+  std::string stream_event_;
 
   /// Auxiliary flag to warn about mass-discrepancies only once per instance
   bool warn_about_mass_discrepancy_ = true;
@@ -369,6 +397,22 @@ class ListBoxModus : public ListModus {
             strategy};
   }
 
+  /// \copydoc smash::ModusDefault::update_grid
+  void update_grid(Grid<GridOptions::PeriodicBoundaries> &grid,
+                   const Particles &particles, double min_cell_length,
+                   double timestep_duration, CollisionCriterion crit,
+                   const bool include_unformed_particles,
+                   CellSizeStrategy strategy =
+                       CellSizeStrategy::Optimal) const {
+    CellNumberLimitation limit = CellNumberLimitation::ParticleNumber;
+    if (crit == CollisionCriterion::Stochastic) {
+      limit = CellNumberLimitation::None;
+    }
+    grid.rebuild({{0, 0, 0}, {length_, length_, length_}}, particles,
+                 min_cell_length, timestep_duration, limit,
+                 include_unformed_particles, strategy);
+  }
+
  private:
   /// Length of the cube's edge in fm
   const double length_;
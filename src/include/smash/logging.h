@@ -219,12 +219,27 @@ FormattingHelper<T> format(const T &value, const char *unit, int width = -1,
   return {value, width, precision, unit};
 }
 
+#ifndef SMASH_MINIMUM_LOG_LEVEL
+/**
+ * The least severe log level which can be enabled at runtime, set with the
+ * CMake option of the same name. Messages of less severe levels are removed at
+ * compile time, i.e. their formatting and the check of the runtime log level.
+ */
+#define SMASH_MINIMUM_LOG_LEVEL ALL
+#endif
+
+/// The least severe log level compiled into SMASH, see SMASH_MINIMUM_LOG_LEVEL
+inline constexpr einhard::LogLevel minimum_loglevel =
+    einhard::SMASH_MINIMUM_LOG_LEVEL;
+
+/// The logger of a log area, which drops messages below minimum_loglevel
+using Logger = einhard::Logger<minimum_loglevel>;
+
 /**
  * An array that stores all pre-configured Logger objects. The objects can be
  * accessed via the logger function.
  */
-extern std::array<einhard::Logger<>, std::tuple_size<LogArea::AreaTuple>::value>
-    logg;
+extern std::array<Logger, std::tuple_size<LogArea::AreaTuple>::value> logg;
 }  // namespace smash
 
 namespace YAML {
@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_LUNDZTABLE_H_
+#define SRC_INCLUDE_SMASH_LUNDZTABLE_H_
+
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * \brief Inverse cumulative distribution of the lightcone momentum fraction
+ * sampled from the LUND fragmentation function
+ *
+ * The fraction \f$z\f$ is distributed like
+ * \f[ f(z) = \frac{1}{z} (1 - z)^a \exp{ \left(- \frac{c}{z} \right) },
+ *     \quad c = b m_T^2 \f]
+ * which StringProcess::sample_zLund samples by rejection. Here the quantiles
+ * of \f$\ln z\f$ are tabulated for one value of \f$a\f$ at values of \f$c\f$,
+ * which are equidistant in \f$\ln c\f$, such that \f$z\f$ is drawn with a
+ * single random number by interpolating the quantiles linearly between the
+ * tabulated probabilities and in \f$\ln c\f$. The sampled fractions are hence distributed
+ * only approximately like the exact distribution.
+ *
+ * Only a few values of \f$a\f$ are used in a run, hence the tables are not
+ * interpolated in \f$a\f$. They are created when they are first needed and
+ * are shared by all threads.
+ */
+class LundZTable {
+ public:
+  /**
+   * Tabulate the quantiles of the distribution.
+   *
+   * \param[in] a Parameter \f$a\f$ of the fragmentation function.
+   * \param[in] n_c Number of tabulated values of \f$c\f$ between c_min and
+   *            c_max.
+   * \param[in] n_quantiles Number of tabulated quantiles minus one, see
+   *            probability().
+   */
+  explicit LundZTable(double a, int n_c = 256, int n_quantiles = 1024);
+
+  /**
+   * \param[in] c The product \f$b m_T^2\f$ [GeV\f$^2\f$ times the unit of b].
+   * \return A sampled lightcone momentum fraction, or NaN if \p c is outside
+   *         of the tabulated range.
+   */
+  double sample(double c) const;
+
+  /**
+   * \param[in] a Parameter \f$a\f$ of the fragmentation function.
+   * \return The table of the given parameter, which is created if it does not
+   *         exist yet.
+   */
+  static const LundZTable &find(double a);
+
+  /// Smallest tabulated value of \f$c\f$
+  static constexpr double c_min = 1e-3;
+  /// Largest tabulated value of \f$c\f$
+  static constexpr double c_max = 1e2;
+
+ private:
+  /**
+   * The quantiles are tabulated at the probabilities given by this function
+   * for equidistant arguments, which are closer to each other in the tails of
+   * the distribution, where it changes fastest in units of the quantiles.
+   *
+   * \param[in] v Argument between 0 and 1.
+   * \return \f$2v^2\f$ for \f$v < 1/2\f$, \f$1 - 2(1 - v)^2\f$ above.
+   */
+  static double probability(double v) {
+    return v < 0.5 ? 2. * v * v : 1. - 2. * (1. - v) * (1. - v);
+  }
+
+  /// Inverse distance of the tabulated values in \f$\ln c\f$
+  double inv_dlog_c_;
+  /// Number of tabulated values of \f$c\f$
+  int n_c_;
+  /// Number of tabulated quantiles minus one
+  int n_quantiles_;
+  /// The quantiles of \f$\ln z\f$ for all values of \f$c\f$
+  std::vector<double> quantiles_;
+
+  /// All tables created so far by their parameter \f$a\f$
+  static std::map<double, std::unique_ptr<const LundZTable>> tables_;
+  /// Protects the creation of tables
+  static std::shared_mutex tables_mutex_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_LUNDZTABLE_H_
@@ -0,0 +1,257 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_MEMORYOUTPUT_H_
+#define SRC_INCLUDE_SMASH_MEMORYOUTPUT_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "forwarddeclarations.h"
+#include "outputinterface.h"
+#include "processbranch.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ * The quantities of one particle, as copied by the MemoryOutput. The
+ * quantities correspond to those of the extended OSCAR 2013 output, see
+ * \ref doxypage_output_oscar_particles. Records can also be handed to
+ * Experiment::run_time_evolution to add or remove particles.
+ */
+struct ParticleRecord {
+  /// Position in the computational frame (fm)
+  double t, x, y, z;
+  /// Mass of the particle (GeV)
+  double mass;
+  /// Four-momentum in the computational frame (GeV)
+  double p0, px, py, pz;
+  /// Time at which the particle is fully formed (fm)
+  double formation_time;
+  /// Scaling factor of the cross sections of the particle
+  double xsec_scaling_factor;
+  /// Time of the last interaction of the particle (fm)
+  double time_last_collision;
+  /// Perturbative weight of the particle, 1 for non-perturbative particles
+  double perturbative_weight;
+  /// Unique ID of the particle
+  std::int32_t id;
+  /// PDG code of the particle
+  std::int32_t pdg;
+  /// Electric charge of the particle
+  std::int32_t charge;
+  /// Number of interactions of the particle
+  std::int32_t ncoll;
+  /// ID of the process, in which the particle was produced
+  std::int32_t proc_id_origin;
+  /// Type of the process, in which the particle was produced
+  ProcessType proc_type_origin;
+  /// PDG code of the first parent particle
+  std::int32_t pdg_mother1;
+  /// PDG code of the second parent particle
+  std::int32_t pdg_mother2;
+};
+
+/**
+ * \ingroup output
+ * A list of particles at a given stage of an event, as passed to the
+ * particles callback of the MemoryOutput.
+ */
+struct ParticleBlock {
+  /// The stages of an event, at which the particles are passed on
+  enum class Stage {
+    /// The initial particles of the event
+    EventStart,
+    /// The particles at an output time of the \ref
+    /// key_output_out_interval_ "Output_Interval"
+    Intermediate,
+    /// The final particles of the event
+    EventEnd,
+  };
+  /// Stage of the event
+  Stage stage;
+  /// Numbers of the event and ensemble
+  EventLabel event_label;
+  /// Time of the computational frame (fm)
+  double time;
+  /// Impact parameter of the event (fm), a dummy value outside collider modus
+  double impact_parameter;
+  /// Whether no interaction between projectile and target happened so far
+  bool empty_event;
+  /// The particles
+  std::vector<ParticleRecord> particles;
+};
+
+/**
+ * \ingroup output
+ * An interaction, as passed to the interaction callback of the MemoryOutput.
+ */
+struct InteractionRecord {
+  /// Number of the event
+  std::int32_t event_number;
+  /// Type of the interaction
+  ProcessType type;
+  /// Time of the interaction in the computational frame (fm)
+  double time;
+  /// Total weight, i.e. the total cross section (mb) or decay width (GeV)
+  double total_weight;
+  /// Partial weight of the chosen channel
+  double partial_weight;
+  /// Density at the interaction point, 0 if not calculated
+  double density;
+  /// The incoming particles
+  std::vector<ParticleRecord> incoming;
+  /// The outgoing particles
+  std::vector<ParticleRecord> outgoing;
+};
+
+/**
+ * \ingroup output
+ * \brief Output passing particles and interactions to user callbacks
+ *
+ * This output is meant for the use of SMASH as a library. It writes no file,
+ * but converts the particles into ParticleRecord objects and passes them to
+ * the given callbacks, such that the data can be processed further without a
+ * round trip to the disk. It is added to an experiment with
+ * Experiment::add_output.
+ *
+ * The records passed to a callback are stored in the output and are only
+ * valid during the call, since their storage is reused for the next call.
+ * The callbacks are called on the thread running the experiment, also if the
+ * ensembles or events are evolved concurrently.
+ */
+class MemoryOutput : public OutputInterface {
+ public:
+  /// Callback receiving a list of particles
+  using ParticlesCallback = std::function<void(const ParticleBlock &)>;
+  /// Callback receiving an interaction
+  using InteractionCallback = std::function<void(const InteractionRecord &)>;
+  /// Callback receiving a fluidized particle
+  using FluidizationCallback = std::function<void(const ParticleRecord &)>;
+
+  /**
+   * Create the output.
+   *
+   * \param[in] particles Called with the particles at the start and end of
+   *            every event and at every intermediate output time. It may be
+   *            empty, if the particles are not needed.
+   * \param[in] interaction Called with every interaction. It may be empty, if
+   *            the interactions are not needed.
+   * \param[in] name Name of the output.
+   */
+  explicit MemoryOutput(ParticlesCallback particles,
+                        InteractionCallback interaction = {},
+                        std::string name = "Memory");
+
+  /**
+   * Pass the initial particles of an event to the particles callback.
+   *
+   * \param[in] particles Current list of all particles.
+   * \param[in] event_label Numbers of the current event and ensemble.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void at_eventstart(const Particles &particles, const EventLabel &event_label,
+                     const EventInfo &event) override;
+
+  /**
+   * Pass the final particles of an event to the particles callback.
+   *
+   * \param[in] particles Current list of particles.
+   * \param[in] event_label Numbers of the current event and ensemble.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void at_eventend(const Particles &particles, const EventLabel &event_label,
+                   const EventInfo &event) override;
+
+  /**
+   * Pass the particles at an intermediate output time to the particles
+   * callback.
+   *
+   * \param[in] particles Current list of particles.
+   * \param[in] clock Clock of the output times.
+   * \param[in] dens_param Unused, needed since inherited.
+   * \param[in] event_label Numbers of the current event and ensemble.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param,
+                            const EventLabel &event_label,
+                            const EventInfo &event) override;
+
+  /**
+   * Pass an interaction to the interaction callback.
+   *
+   * \param[in] action The performed action.
+   * \param[in] density The density at the interaction point.
+   */
+  void at_interaction(const Action &action, const double density) override;
+
+  /**
+   * Pass every particle fluidized by a FluidizationAction to the given
+   * callback, one at a time, e.g. to stream them to a hydrodynamic code. This
+   * happens in addition to the interaction callback.
+   *
+   * \param[in] fluidization Called with every fluidized particle.
+   */
+  void set_fluidization_callback(FluidizationCallback fluidization) {
+    fluidization_callback_ = std::move(fluidization);
+  }
+
+  /**
+   * Copy the quantities of a particle.
+   *
+   * \param[in] data The particle.
+   * \return The record of the particle.
+   */
+  static ParticleRecord record(const ParticleData &data);
+
+  /**
+   * Create a particle from a record, the inverse of record(). The charge and
+   * the mass are given by the PDG code and the momentum, respectively.
+   *
+   * \param[in] r The record of the particle.
+   * \return The particle.
+   * \throw ParticleType::PdgNotFoundFailure if the PDG code is unknown.
+   */
+  static ParticleData particle(const ParticleRecord &r);
+
+ private:
+  /**
+   * Copy the particles into the reused block and pass it to the callback.
+   *
+   * \param[in] stage Stage of the event.
+   * \param[in] particles The particles.
+   * \param[in] event_label Numbers of the current event and ensemble.
+   * \param[in] event Event info, see \ref event_info
+   * \param[in] time Time of the computational frame.
+   */
+  void pass_particles(ParticleBlock::Stage stage, const Particles &particles,
+                      const EventLabel &event_label, const EventInfo &event,
+                      double time);
+
+  /// Callback receiving the particle lists
+  const ParticlesCallback particles_callback_;
+  /// Callback receiving the interactions
+  const InteractionCallback interaction_callback_;
+  /// Callback receiving the fluidized particles
+  FluidizationCallback fluidization_callback_;
+  /// The particle list passed to the callback, reused for every call
+  ParticleBlock block_{};
+  /// The interaction passed to the callback, reused for every call
+  InteractionRecord interaction_{};
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_MEMORYOUTPUT_H_
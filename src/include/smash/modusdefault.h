@@ -10,6 +10,7 @@
 #ifndef SRC_INCLUDE_SMASH_MODUSDEFAULT_H_
 #define SRC_INCLUDE_SMASH_MODUSDEFAULT_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
@@ -21,7 +22,10 @@
 #include "grid.h"
 #include "icparameters.h"
 #include "outputinterface.h"
+#include "particles.h"
 #include "potentials.h"
+#include "random.h"
+#include "threadpool.h"
 
 namespace smash {
 /**
@@ -168,14 +172,46 @@ class ModusDefault {
             strategy};
   }
 
+  /**
+   * Places the particles anew onto a grid created by create_grid, reusing its
+   * memory. The grid is the same as the one create_grid would return.
+   *
+   * \param[inout] grid The grid to be rebuilt.
+   * \param[in] particles The Particles object containing all particles of the
+   * currently running Experiment.
+   * \param[in] min_cell_length The minimal length of the grid cells.
+   * \param[in] timestep_duration Duration of the timestep.
+   * \param[in] crit Collision criterion (decides if cell number can be limited)
+   * \param[in] include_unformed_particles include unformed particles from
+   *                                        the grid
+   * \param[in] strategy The strategy to determine the cell size
+   *
+   * \see Grid::rebuild
+   */
+  void update_grid(Grid<GridOptions::Normal>& grid, const Particles& particles,
+                   double min_cell_length, double timestep_duration,
+                   CollisionCriterion crit,
+                   const bool include_unformed_particles,
+                   CellSizeStrategy strategy =
+                       CellSizeStrategy::Optimal) const {
+    CellNumberLimitation limit = CellNumberLimitation::ParticleNumber;
+    if (crit == CollisionCriterion::Stochastic) {
+      limit = CellNumberLimitation::None;
+    }
+    grid.rebuild(particles, min_cell_length, timestep_duration, limit,
+                 include_unformed_particles, strategy);
+  }
+
   /**
    * Creates GrandCanThermalizer
    *
    * \param[in] conf configuration object
+   * \param[in] thread_pool Optional pool compiling the table of the equation
+   *            of state
    * \return unique pointer to created thermalizer class
    */
   std::unique_ptr<GrandCanThermalizer> create_grandcan_thermalizer(
-      Configuration& conf) const {
+      Configuration& conf, ThreadPool* thread_pool = nullptr) const {
     /* Lattice is placed such that the center is 0,0,0.
        If one wants to have a central cell with center at 0,0,0 then
        number of cells should be odd (2k+1) in every direction.
@@ -185,7 +221,8 @@ class ModusDefault {
     const std::array<double, 3> origin = {-0.5 * l[0], -0.5 * l[1],
                                           -0.5 * l[2]};
     const bool periodicity = false;
-    return std::make_unique<GrandCanThermalizer>(conf, l, origin, periodicity);
+    return std::make_unique<GrandCanThermalizer>(conf, l, origin, periodicity,
+                                                 thread_pool);
   }
 
   /**
@@ -203,6 +240,47 @@ class ModusDefault {
   struct InvalidEnergy : public BadInput {
     using BadInput::BadInput;
   };
+
+ protected:
+  /**
+   * Sample the phase space of the initial particles with one random number
+   * stream per species, such that the particles do not depend on the number
+   * of threads. The seed of the streams is drawn from the engine of the
+   * calling thread.
+   *
+   * \param[inout] particles The particles, which were created one species
+   *                         after the other.
+   * \param[in] multiplicities Number of particles of every species, in the
+   *                           order in which they were created.
+   * \param[in] thread_pool The threads, on which the species are sampled.
+   * \param[in] sample Function sampling the momentum and the position of a
+   *                   single particle. It is called concurrently for
+   *                   different species.
+   */
+  static void sample_species_concurrently(
+      Particles* particles, const std::vector<int>& multiplicities,
+      ThreadPool& thread_pool,
+      const std::function<void(ParticleData&)>& sample) {
+    std::vector<ParticleData*> created;
+    created.reserve(particles->size());
+    for (ParticleData& data : *particles) {
+      created.push_back(&data);
+    }
+    std::vector<std::size_t> first(multiplicities.size() + 1, 0);
+    for (std::size_t i = 0; i < multiplicities.size(); i++) {
+      first[i + 1] = first[i] + multiplicities[i];
+    }
+    // Whichever thread samples a species, it uses the same random numbers
+    const random::Engine::result_type seed = random::advance();
+    thread_pool.parallel_for(multiplicities.size(), [&](std::size_t i) {
+      random::Engine species_stream =
+          random::make_stream(seed, random::StreamKind::InitialSpecies, i);
+      const random::ScopedEngine species_engine(species_stream);
+      for (std::size_t j = first[i]; j < first[i + 1]; j++) {
+        sample(*created[j]);
+      }
+    });
+  }
 };
 
 }  // namespace smash
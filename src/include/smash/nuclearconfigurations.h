@@ -0,0 +1,118 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_NUCLEARCONFIGURATIONS_H_
+#define SRC_INCLUDE_SMASH_NUCLEARCONFIGURATIONS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+#include "nucleus.h"
+#include "particledata.h"
+
+namespace smash {
+
+/**
+ * \ingroup initial
+ *
+ * \brief Batches of projectile and target configurations, which are generated
+ * ahead of the events using them
+ *
+ * While the configurations of one batch are handed out by take(), the next
+ * batch is generated on a background thread, such that the sampling (or the
+ * reading from file) of the nucleon positions and Fermi momenta overlaps with
+ * the evolution of the events. All configurations of a batch are boosted at
+ * once with Nucleus::boost_nucleons.
+ *
+ * The nuclei are used exclusively by the background thread during the
+ * lifetime of this object. Every batch draws its random numbers from its own
+ * stream, such that the configurations do not depend on the timing of the
+ * thread, but they no longer depend on the seeds of the single events.
+ */
+class NuclearConfigurations {
+ public:
+  /**
+   * Start generating the first batch.
+   *
+   * \param[in] projectile The projectile, which has to outlive this object.
+   * \param[in] target The target, which has to outlive this object.
+   * \param[in] fermi_momenta Whether Fermi momenta are generated.
+   * \param[in] v_projectile Velocity of the projectile.
+   * \param[in] v_target Velocity of the target.
+   * \param[in] batch_size Number of configurations in a batch.
+   * \param[in] seed Seed of the random number streams of the batches.
+   */
+  NuclearConfigurations(Nucleus &projectile, Nucleus &target,
+                        bool fermi_momenta, double v_projectile,
+                        double v_target, std::size_t batch_size,
+                        std::uint64_t seed);
+  /// Cannot be copied
+  NuclearConfigurations(const NuclearConfigurations &) = delete;
+  /// Cannot be copied
+  NuclearConfigurations &operator=(const NuclearConfigurations &) = delete;
+  /// Wait for the batch being generated.
+  ~NuclearConfigurations();
+
+  /**
+   * Hand out the next configuration, waiting for the next batch if the
+   * current one is used up.
+   *
+   * \param[out] projectile The boosted nucleons of the projectile.
+   * \param[out] target The boosted nucleons of the target.
+   */
+  void take(std::vector<ParticleData> &projectile,
+            std::vector<ParticleData> &target);
+
+ private:
+  /// The nucleons of all configurations of a batch, one after another
+  struct Batch {
+    /// Nucleons of the projectiles
+    std::vector<ParticleData> projectile;
+    /// Nucleons of the targets
+    std::vector<ParticleData> target;
+  };
+
+  /**
+   * \param[in] index Index of the batch, which identifies its random stream.
+   * \return The boosted configurations of the batch.
+   */
+  Batch generate(std::uint64_t index);
+
+  /// Start generating the next batch on a background thread.
+  void launch();
+
+  /// The projectile
+  Nucleus &projectile_;
+  /// The target
+  Nucleus &target_;
+  /// Whether Fermi momenta are generated
+  const bool fermi_momenta_;
+  /// Velocity of the projectile
+  const double v_projectile_;
+  /// Velocity of the target
+  const double v_target_;
+  /// Number of configurations in a batch
+  const std::size_t batch_size_;
+  /// Seed of the random number streams of the batches
+  const std::uint64_t seed_;
+  /// Number of batches started so far
+  std::uint64_t n_batches_ = 0;
+  /// The batch being handed out
+  Batch current_;
+  /// Index of the next configuration in current_
+  std::size_t position_;
+  /// The batch being generated
+  std::future<Batch> next_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_NUCLEARCONFIGURATIONS_H_
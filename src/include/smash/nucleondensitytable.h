@@ -0,0 +1,125 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_NUCLEONDENSITYTABLE_H_
+#define SRC_INCLUDE_SMASH_NUCLEONDENSITYTABLE_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "threevector.h"
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * \brief Inverse cumulative distributions of the nucleon positions in a
+ * (deformed) Woods-Saxon nucleus
+ *
+ * The nucleons are distributed like
+ * \f[ \frac{dN}{dr\,d\cos\theta\,d\phi} \propto \frac{r^2}{1 +
+ * \exp\left(\frac{r - R(\cos\theta)}{d}\right)}, \quad R(\cos\theta) = r_0
+ * \left(1 + \beta_2 Y_{20} + \beta_3 Y_{30} + \beta_4 Y_{40}\right) \f]
+ * between zero and a largest radius. The cumulative distributions of the
+ * radius at equidistant values of \f$\cos\theta\f$ and the marginal
+ * distribution of \f$\cos\theta\f$ are tabulated, the density is taken as
+ * constant between the tabulated points. They are inverted in a constant
+ * time from a guide table, which gives the first point to be searched for
+ * every range of probabilities. The radius is interpolated linearly between
+ * the two tabulated values of \f$\cos\theta\f$ around the sampled one. For a
+ * spherical nucleus only one radial distribution is tabulated. The sampled
+ * positions are distributed approximately like the exact density, which
+ * Nucleus::distribute_nucleon and DeformedNucleus::distribute_nucleon sample
+ * by rejection.
+ *
+ * The triaxial deformation \f$\gamma\f$ is not tabulated.
+ */
+class NucleonDensityTable {
+ public:
+  /**
+   * Tabulate the distributions of the nucleon positions.
+   *
+   * \param[in] radius Nuclear radius \f$r_0\f$ [fm].
+   * \param[in] diffusiveness Diffusiveness \f$d\f$ [fm].
+   * \param[in] beta2, beta3, beta4 Deformation parameters.
+   * \param[in] r_max Largest radius of the nucleons [fm].
+   */
+  NucleonDensityTable(double radius, double diffusiveness, double beta2,
+                      double beta3, double beta4, double r_max);
+
+  /// \return A sampled position of a nucleon [fm].
+  ThreeVector sample() const;
+
+  /**
+   * \param[in] radius Nuclear radius \f$r_0\f$ [fm].
+   * \param[in] diffusiveness Diffusiveness \f$d\f$ [fm].
+   * \param[in] beta2, beta3, beta4 Deformation parameters.
+   * \param[in] r_max Largest radius of the nucleons [fm].
+   * \return The table of the given nucleus, which is created if no nucleus
+   *         with the same parameters has been tabulated yet.
+   */
+  static std::shared_ptr<const NucleonDensityTable> find(
+      double radius, double diffusiveness, double beta2, double beta3,
+      double beta4, double r_max);
+
+ private:
+  /// A tabulated cumulative distribution and its inversion
+  class Distribution {
+   public:
+    /**
+     * \param[in] density Density between equidistant points, at least one
+     *            value has to be positive.
+     */
+    explicit Distribution(const std::vector<double> &density);
+
+    /**
+     * \param[in] u A probability.
+     * \return The quantile of \p u in units of the range of the points.
+     */
+    double quantile(double u) const;
+
+   private:
+    /// The normalized cumulative distribution at the points
+    std::vector<double> cumulative_;
+    /// The first point below every range of probabilities, see quantile
+    std::vector<std::size_t> guide_;
+  };
+
+  /// Number of tabulated radii
+  static constexpr int n_radii_ = 4096;
+  /// Number of tabulated values of \f$\cos\theta\f$ of a deformed nucleus
+  static constexpr int n_cos_ = 129;
+
+  /// Largest radius of the nucleons
+  double r_max_;
+  /**
+   * Distribution of \f$\cos\theta\f$ over the intervals between its
+   * tabulated values, nothing for a spherical nucleus
+   */
+  std::optional<Distribution> cos_;
+  /// Radial distribution at every tabulated value of \f$\cos\theta\f$
+  std::vector<Distribution> radial_;
+
+  /// Identifies a table by radius, diffusiveness, deformation and r_max
+  using Key = std::tuple<double, double, double, double, double, double>;
+  /// All tables created so far
+  static std::map<Key, std::shared_ptr<const NucleonDensityTable>> tables_;
+  /// Protects the tables
+  static std::mutex tables_mutex_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_NUCLEONDENSITYTABLE_H_
@@ -8,6 +8,7 @@
 #define SRC_INCLUDE_SMASH_NUCLEUS_H_
 
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -15,6 +16,7 @@
 #include "constants.h"
 #include "forwarddeclarations.h"
 #include "fourvector.h"
+#include "nucleondensitytable.h"
 #include "particledata.h"
 #include "threevector.h"
 
@@ -71,6 +73,16 @@ class Nucleus {
    */
   virtual ThreeVector distribute_nucleon();
 
+  /**
+   * Choose how distribute_nucleon samples the positions of the nucleons.
+   *
+   * \param[in] tabulated Whether the positions are drawn from the tabulated
+   *            inverse cumulative distributions of a NucleonDensityTable
+   *            instead of by rejection. A hard sphere is always sampled
+   *            directly.
+   */
+  virtual void set_tabulated_positions(bool tabulated);
+
   /**
    * Woods-Saxon distribution
    * \param[in] x the position at which to evaluate the function
@@ -110,7 +122,22 @@ class Nucleus {
    *
    * \param[in] beta_scalar velocity in z-direction used for boost.
    */
-  void boost(double beta_scalar);
+  void boost(double beta_scalar) {
+    boost_nucleons(particles_.begin(), particles_.end(), beta_scalar);
+  }
+
+  /**
+   * Boosts a range of nucleons like boost(double). The range may hold the
+   * nucleons of many configurations of a nucleus, such that all of them are
+   * boosted at once.
+   *
+   * \param[in] first Start of the range of nucleons.
+   * \param[in] last End of the range of nucleons.
+   * \param[in] beta_scalar velocity in z-direction used for boost.
+   */
+  static void boost_nucleons(std::vector<ParticleData>::iterator first,
+                             std::vector<ParticleData>::iterator last,
+                             double beta_scalar);
 
   /**
    * Adds particles from a map PDG code =>
@@ -133,7 +160,25 @@ class Nucleus {
    * \param[in] simulation_time set the time and formation_time of each
    * particle to this value.
    */
-  void shift(double z_offset, double x_offset, double simulation_time);
+  void shift(double z_offset, double x_offset, double simulation_time) {
+    shift_nucleons(particles_.begin(), particles_.end(), z_offset, x_offset,
+                   simulation_time);
+  }
+
+  /**
+   * Shifts a range of nucleons like shift(double, double, double).
+   *
+   * \param[in] first Start of the range of nucleons.
+   * \param[in] last End of the range of nucleons.
+   * \param[in] z_offset is the shift in z-direction
+   * \param[in] x_offset is the shift in x-direction
+   * \param[in] simulation_time set the time and formation_time of each
+   * particle to this value.
+   */
+  static void shift_nucleons(std::vector<ParticleData>::iterator first,
+                             std::vector<ParticleData>::iterator last,
+                             double z_offset, double x_offset,
+                             double simulation_time);
 
   /**
    * Rotates the nucleus using the three euler angles phi, theta and psi.
@@ -311,6 +356,9 @@ class Nucleus {
   /// Whether the nucleus should be rotated randomly.
   bool random_rotation_ = false;
 
+  /// Tabulated nucleon positions, if they are not sampled by rejection
+  std::shared_ptr<const NucleonDensityTable> density_table_;
+
  public:
   /// For iterators over the particle list:
   inline std::vector<ParticleData>::iterator begin() {
@@ -118,6 +118,19 @@ class OscarOutput : public OutputInterface {
                             const EventLabel &event_label,
                             const EventInfo &event) override;
 
+  /**
+   * \return The event hooks, and the interaction and intermediate time hooks
+   *         if the contents of this output include interactions or time steps.
+   */
+  OutputHooksBitSet subscribed_hooks() const override {
+    OutputHooksBitSet hooks;
+    hooks.set(EventHooks);
+    hooks.set(InteractionHooks,
+              Contents & (OscarInteractions | OscarParticlesIC));
+    hooks.set(IntermediateTimeHooks, Contents & OscarTimesteps);
+    return hooks;
+  }
+
  private:
   /**
    * Write single particle information line to output.
@@ -10,12 +10,17 @@
 #ifndef SRC_INCLUDE_SMASH_OUTPUTFORMATTER_H_
 #define SRC_INCLUDE_SMASH_OUTPUTFORMATTER_H_
 
+#include <cassert>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
 #include <functional>
 #include <map>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -48,49 +53,17 @@ struct ToASCII {
   /**
    * Converts a double with 6 digits of precision.
    *
-   * \note The usage of \c std::snprintf over \c std::ostringstream is because
-   * of performance reasons (in C++20 this will be replaced with \c std::format
-   * which is even better). The returned string is constructed from the buffer
-   * in a way to exclude the terminating null character from the buffer. The
-   * hard-coded buffer size should fit any number, but a couple of assert are
-   * used to possibly investigate unexpected behaviour.
-   *
-   * \warning Since the buffer size is needed twice, it makes sense to store it
-   * in a variable. However, cpplint complains if the variable name is not
-   * starting with \c k followed by CamelCase.
-   *
    * \param[in] value number to convert
    */
-  type as_double(double value) {
-    constexpr size_t kBufferSize = 13;
-    char buffer[kBufferSize];
-    const auto length = std::snprintf(buffer, kBufferSize, "%g", value);
-    assert(static_cast<size_t>(length) < kBufferSize);
-    assert(length > 0);
-    return std::string{buffer, buffer + length};
-  }
+  type as_double(double value) const { return format_double<6>(value); }
 
   /**
    * Converts a double with 9 digits of precision.
    *
-   * \see \c as_double for further information.
-   *
-   * \note The duplication of the code of the \c as_double method is done on
-   * purpose as naively extracting a function passing the \c std::snprintf
-   * format string as parameter would trigger a warning in compilation (the
-   * format has to be a literal in order to be checked by the compiler at
-   * compile time) and the effort to avoid this is not worth now, especially
-   * since this code will be changed anyhow when using C++20.
-   *
    * \param[in] value number to convert
    */
-  type as_precise_double(double value) {
-    constexpr size_t kBufferSize = 16;
-    char buffer[kBufferSize];
-    const auto length = std::snprintf(buffer, kBufferSize, "%.9g", value);
-    assert(static_cast<size_t>(length) < kBufferSize);
-    assert(length > 0);
-    return std::string{buffer, buffer + length};
+  type as_precise_double(double value) const {
+    return format_double<9>(value);
   }
 
   /**
@@ -100,6 +73,39 @@ struct ToASCII {
    * \param[inout] str string to be written
    */
   type as_string(const std::string& str) const { return str; }
+
+ private:
+  /**
+   * Converts a double like \c std::printf with the \c %g conversion and the
+   * given precision.
+   *
+   * \note If the standard library supports it, \c std::to_chars is used, which
+   * is much faster than \c std::snprintf and, by definition, produces the same
+   * characters. The hard-coded buffer size fits any number.
+   *
+   * \warning cpplint complains if the name of the buffer size variable is not
+   * starting with \c k followed by CamelCase.
+   *
+   * \tparam Precision number of significant digits
+   * \param[in] value number to convert
+   */
+  template <int Precision>
+  static type format_double(double value) {
+    constexpr size_t kBufferSize = 32;
+    char buffer[kBufferSize];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const auto result = std::to_chars(buffer, buffer + kBufferSize, value,
+                                      std::chars_format::general, Precision);
+    assert(result.ec == std::errc{});
+    return std::string{buffer, result.ptr};
+#else
+    const auto length =
+        std::snprintf(buffer, kBufferSize, "%.*g", Precision, value);
+    assert(static_cast<size_t>(length) < kBufferSize);
+    assert(length > 0);
+    return std::string{buffer, buffer + length};
+#endif
+  }
 };
 
 /**
@@ -260,8 +266,7 @@ class OutputFormatter {
         });
       } else if (quantity == "ncoll") {
         getters_.push_back([this](const ParticleData& in) {
-          return this->converter_.as_integer(
-              in.get_history().collisions_per_particle);
+          return this->converter_.as_integer(in.collisions_per_particle());
         });
       } else if (quantity == "form_time") {
         getters_.push_back([this](const ParticleData& in) {
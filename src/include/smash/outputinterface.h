@@ -10,6 +10,8 @@
 #ifndef SRC_INCLUDE_SMASH_OUTPUTINTERFACE_H_
 #define SRC_INCLUDE_SMASH_OUTPUTINTERFACE_H_
 
+#include <bitset>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
@@ -75,6 +77,25 @@ struct EventLabel {
   int32_t ensemble_number;
 };
 
+/**
+ * \ingroup output
+ *
+ * The groups of hooks of OutputInterface, to which an output subscribes, see
+ * OutputInterface::subscribed_hooks. Because std::bitset does not handle enum
+ * classes, this is a simple enum.
+ */
+enum OutputHooks {
+  /// at_eventstart, at_eventend and event_statistics_output
+  EventHooks = 0,
+  /// at_interaction and at_recorded_interaction
+  InteractionHooks = 1,
+  /// at_intermediate_time and the outputs of the thermodynamic lattices
+  IntermediateTimeHooks = 2,
+};
+
+/// The groups of hooks an output subscribes to, indexed by OutputHooks
+typedef std::bitset<3> OutputHooksBitSet;
+
 /**
  * \ingroup output
  *
@@ -171,11 +192,49 @@ class OutputInterface {
    */
   virtual void at_eventend(const std::vector<Particles> &, const int) {}
 
+  /**
+   * Output launched at event end, with the statistics about the work done in
+   * the event. Only called if an output of the performance is requested.
+   */
+  virtual void event_statistics_output(const int, const EventStatistics &) {}
+
   /**
    * Called whenever an action modified one or more particles.
    */
   virtual void at_interaction(const Action &, const double) {}
 
+  /**
+   * Whether the output keeps the interactions beyond the call of
+   * at_interaction. Such outputs receive a copy of the action through
+   * at_recorded_interaction instead, which is made once and shared by all of
+   * them.
+   */
+  virtual bool keeps_interactions() const { return false; }
+
+  /**
+   * The memory used by the data the output keeps until it is written, e.g.
+   * buffered copies of the particles [bytes]. Outputs writing directly report
+   * nothing.
+   */
+  virtual std::size_t memory_usage() const { return 0; }
+
+  /**
+   * The groups of hooks in which the output writes anything. The experiment
+   * calls only the hooks of the subscribed groups, and skips the work done
+   * just for the calls, like computing the density at the interaction point,
+   * if no output subscribed to them. By default, all hooks are subscribed.
+   */
+  virtual OutputHooksBitSet subscribed_hooks() const {
+    return OutputHooksBitSet().set();
+  }
+
+  /**
+   * Called instead of at_interaction for outputs which keep the interactions,
+   * with the shared copy of the action.
+   */
+  virtual void at_recorded_interaction(
+      const std::shared_ptr<const RecordedAction> &, const double) {}
+
   /**
    * Output launched after every N'th time-step. N is controlled by an option.
    */
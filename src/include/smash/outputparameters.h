@@ -7,7 +7,9 @@
 #ifndef SRC_INCLUDE_SMASH_OUTPUTPARAMETERS_H_
 #define SRC_INCLUDE_SMASH_OUTPUTPARAMETERS_H_
 
+#include <array>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -18,6 +20,8 @@
 #include "forwarddeclarations.h"
 #include "input_keys.h"
 #include "logging.h"
+#include "pdgcode.h"
+#include "pdgcode_constants.h"
 
 namespace smash {
 static constexpr int LExperiment = LogArea::Experiment::id;
@@ -53,6 +57,51 @@ struct RivetOutputParameters {
   bool ignore_beams{true};
   /// Whether any weight parameter was specified
   bool any_weight_parameter_was_given{false};
+  /// Maximum number of events waiting for the analyses, 0 to analyse at once
+  int queue_size{0};
+};
+
+/**
+ * Helper structure for OutputParameters in order to store and hand over the
+ * selection of the particles and interactions written by an output content.
+ * OutputParameters has one member of this type for the %Particles and one for
+ * the Collisions content.
+ */
+struct OutputFilterParameters {
+  /// Selected particle species, all species if empty
+  std::vector<PdgCode> pdg_codes{};
+  /// Selected interval of the rapidity, all rapidities if not set
+  std::optional<std::array<double, 2>> rapidity_range{std::nullopt};
+  /// Selected interval of the transverse momentum (GeV), all if not set
+  std::optional<std::array<double, 2>> pt_range{std::nullopt};
+  /// Selected process types of the interactions, all types if empty
+  std::vector<int> process_types{};
+
+  /// \return Whether anything is filtered out.
+  bool is_active() const {
+    return !pdg_codes.empty() || rapidity_range || pt_range ||
+           !process_types.empty();
+  }
+};
+
+/**
+ * Helper structure for OutputParameters in order to store and hand over the
+ * binning of the Spectra output. OutputParameters has one member of this type.
+ */
+struct SpectraOutputParameters {
+  /// Histogrammed particle species
+  std::vector<PdgCode> pdg_codes{pdg::pi_p, pdg::pi_m, pdg::K_p,
+                                 pdg::K_m,  pdg::p,    -pdg::p};
+  /// Interval of the rapidity histograms
+  std::array<double, 2> rapidity_range{{-4.0, 4.0}};
+  /// Number of bins of the rapidity histograms
+  int rapidity_bins{40};
+  /// Interval of the transverse momentum histograms (GeV)
+  std::array<double, 2> pt_range{{0.0, 2.0}};
+  /// Number of bins of the transverse momentum histograms
+  int pt_bins{20};
+  /// Maximal absolute rapidity of the transverse momentum histograms
+  double midrapidity_cut{0.5};
 };
 
 /**
@@ -71,13 +120,29 @@ struct OutputParameters {
         td_jQBS(false),
         td_smearing(true),
         td_only_participants(false),
+        td_compression(0),
         part_extended(false),
         part_only_final(OutputOnlyFinal::Yes),
+        part_compression(0),
+        part_event_index(false),
+        part_delta_encoding(false),
+        part_events_per_row_group(100),
         coll_extended(false),
         coll_printstartend(false),
+        coll_compression(0),
+        coll_event_index(false),
+        coll_reference_incoming(false),
         dil_extended(false),
         photons_extended(false),
         ic_extended(false),
+        ic_slab_width(0.0),
+        root_compression(std::nullopt),
+        root_basket_size(32000),
+        root_auto_flush(-30000000),
+        root_threads(0),
+        part_filter{},
+        coll_filter{},
+        spectra_parameters{},
         rivet_parameters{},
         quantities{} {}
 
@@ -110,6 +175,8 @@ struct OutputParameters {
       td_smearing = thermo_conf.take(InputKeys::output_thermodynamics_smearing);
       td_only_participants =
           thermo_conf.take(InputKeys::output_thermodynamics_onlyParticipants);
+      td_compression =
+          thermo_conf.take(InputKeys::output_thermodynamics_compressionLevel);
     }
 
     /* Unconditionally take quantities from the configuration file. This is
@@ -139,8 +206,73 @@ struct OutputParameters {
      * to the class member initial value. */
     part_extended = conf.take(InputKeys::output_particles_extended);
     part_only_final = conf.take(InputKeys::output_particles_onlyFinal);
+    part_compression = conf.take(InputKeys::output_particles_compressionLevel);
+    part_event_index = conf.take(InputKeys::output_particles_eventIndex);
+    part_delta_encoding = conf.take(InputKeys::output_particles_deltaEncoding);
+    part_events_per_row_group =
+        conf.take(InputKeys::output_particles_eventsPerRowGroup);
     coll_extended = conf.take(InputKeys::output_collisions_extended);
     coll_printstartend = conf.take(InputKeys::output_collisions_printStartEnd);
+    coll_compression = conf.take(InputKeys::output_collisions_compressionLevel);
+    coll_event_index = conf.take(InputKeys::output_collisions_eventIndex);
+    coll_reference_incoming =
+        conf.take(InputKeys::output_collisions_referenceIncoming);
+
+    if (conf.has_section(InputSections::o_p_filter)) {
+      auto filter_conf =
+          conf.extract_complete_sub_configuration(InputSections::o_p_filter);
+      if (filter_conf.has_value(InputKeys::output_particles_filter_pdgCodes)) {
+        part_filter.pdg_codes =
+            filter_conf.take(InputKeys::output_particles_filter_pdgCodes);
+      }
+      if (filter_conf.has_value(
+              InputKeys::output_particles_filter_rapidityRange)) {
+        part_filter.rapidity_range = make_optional<std::array<double, 2>>(
+            filter_conf.take(InputKeys::output_particles_filter_rapidityRange));
+      }
+      if (filter_conf.has_value(InputKeys::output_particles_filter_ptRange)) {
+        part_filter.pt_range = make_optional<std::array<double, 2>>(
+            filter_conf.take(InputKeys::output_particles_filter_ptRange));
+      }
+    }
+
+    if (conf.has_section(InputSections::o_c_filter)) {
+      auto filter_conf =
+          conf.extract_complete_sub_configuration(InputSections::o_c_filter);
+      if (filter_conf.has_value(InputKeys::output_collisions_filter_pdgCodes)) {
+        coll_filter.pdg_codes =
+            filter_conf.take(InputKeys::output_collisions_filter_pdgCodes);
+      }
+      if (filter_conf.has_value(
+              InputKeys::output_collisions_filter_rapidityRange)) {
+        coll_filter.rapidity_range =
+            make_optional<std::array<double, 2>>(filter_conf.take(
+                InputKeys::output_collisions_filter_rapidityRange));
+      }
+      if (filter_conf.has_value(InputKeys::output_collisions_filter_ptRange)) {
+        coll_filter.pt_range = make_optional<std::array<double, 2>>(
+            filter_conf.take(InputKeys::output_collisions_filter_ptRange));
+      }
+      if (filter_conf.has_value(
+              InputKeys::output_collisions_filter_processTypes)) {
+        coll_filter.process_types =
+            filter_conf.take(InputKeys::output_collisions_filter_processTypes);
+      }
+    }
+
+    if (conf.has_section(InputSections::o_spectra)) {
+      spectra_parameters.pdg_codes =
+          conf.take(InputKeys::output_spectra_pdgCodes);
+      spectra_parameters.rapidity_range =
+          conf.take(InputKeys::output_spectra_rapidityRange);
+      spectra_parameters.rapidity_bins =
+          conf.take(InputKeys::output_spectra_rapidityBins);
+      spectra_parameters.pt_range =
+          conf.take(InputKeys::output_spectra_ptRange);
+      spectra_parameters.pt_bins = conf.take(InputKeys::output_spectra_ptBins);
+      spectra_parameters.midrapidity_cut =
+          conf.take(InputKeys::output_spectra_midrapidityCut);
+    }
 
     if (conf.has_section(InputSections::o_dileptons)) {
       dil_extended = conf.take(InputKeys::output_dileptons_extended);
@@ -152,6 +284,7 @@ struct OutputParameters {
 
     if (conf.has_section(InputSections::o_initialConditions)) {
       ic_extended = conf.take(InputKeys::output_initialConditions_extended);
+      ic_slab_width = conf.take(InputKeys::output_initialConditions_slabWidth);
     }
 
     if (conf.has_section(InputSections::o_rivet)) {
@@ -195,6 +328,8 @@ struct OutputParameters {
       }
       rivet_parameters.ignore_beams =
           rivet_conf.take(InputKeys::output_rivet_ignoreBeams);
+      rivet_parameters.queue_size =
+          rivet_conf.take(InputKeys::output_rivet_queueSize);
       if (rivet_conf.has_section(InputSections::o_r_weights)) {
         rivet_parameters.any_weight_parameter_was_given = true;
         if (rivet_conf.has_value(InputKeys::output_rivet_weights_select)) {
@@ -263,18 +398,42 @@ struct OutputParameters {
    */
   bool td_only_participants;
 
+  /// zlib level of the binary lattice outputs, 0 if not compressed
+  int td_compression;
+
   /// Extended format for particles output
   bool part_extended;
 
   /// Print only final particles in event
   OutputOnlyFinal part_only_final;
 
+  /// zstd compression level of the binary particles output, 0 if uncompressed
+  int part_compression;
+
+  /// Write an event index next to the binary particles output
+  bool part_event_index;
+
+  /// Write the intermediate particle lists as delta blocks
+  bool part_delta_encoding;
+
+  /// Number of events in every row group of the Parquet particles output
+  int part_events_per_row_group;
+
   /// Extended format for collisions output
   bool coll_extended;
 
   /// Print initial and final particles in event into collision output
   bool coll_printstartend;
 
+  /// zstd compression level of the binary collisions output, 0 if uncompressed
+  int coll_compression;
+
+  /// Write an event index next to the binary collisions output
+  bool coll_event_index;
+
+  /// Reference the incoming particles of the binary collisions output by ID
+  bool coll_reference_incoming;
+
   /// Extended format for dilepton output
   bool dil_extended;
 
@@ -284,6 +443,30 @@ struct OutputParameters {
   /// Extended initial conditions output
   bool ic_extended;
 
+  /// Width [fm] of the time slabs of the binary initial conditions output
+  double ic_slab_width;
+
+  /// Compression setting of the ROOT outputs, the ROOT default if not set
+  std::optional<int> root_compression;
+
+  /// Basket size of the branches of the ROOT outputs in bytes
+  int root_basket_size;
+
+  /// Autoflush setting of the trees of the ROOT outputs
+  int root_auto_flush;
+
+  /// Number of threads of the implicit multithreading of ROOT, 0 if disabled
+  int root_threads;
+
+  /// Selection of the particles written by the particles output
+  OutputFilterParameters part_filter;
+
+  /// Selection of the interactions written by the collisions output
+  OutputFilterParameters coll_filter;
+
+  /// Binning of the spectra output
+  SpectraOutputParameters spectra_parameters;
+
   /// Rivet specfic parameters
   RivetOutputParameters rivet_parameters;
 
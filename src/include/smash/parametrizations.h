@@ -570,7 +570,7 @@ class KaonNucleonRatios {
                    const ParticleType& c, const ParticleType& d) const;
 };
 
-extern /*thread_local (see #3075)*/ KaonNucleonRatios kaon_nucleon_ratios;
+extern thread_local KaonNucleonRatios kaon_nucleon_ratios;
 
 /**
  * K- p <-> Kbar0 n cross section parametrization.
@@ -0,0 +1,157 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_PARQUETOUTPUT_H_
+#define SRC_INCLUDE_SMASH_PARQUETOUTPUT_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/file.h"
+#include "forwarddeclarations.h"
+#include "outputformatter.h"
+#include "outputinterface.h"
+#include "outputparameters.h"
+#include "parquet/arrow/writer.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * \brief <h2> SMASH particles output to an Apache Parquet file </h2>
+ *
+ * SMASH supports the columnar Parquet format (see https://parquet.apache.org)
+ * as an option, if the Apache Arrow C++ library with Parquet support was found
+ * when building SMASH.
+ *
+ * This class produces the file \c particles.parquet, with one column for every
+ * requested quantity, such that analyses reading only a few quantities do not
+ * need to read the whole file. See \ref doxypage_output_parquet for more
+ * information.
+ */
+class ParquetOutput : public OutputInterface {
+ public:
+  /**
+   * Construct the Parquet output.
+   *
+   * \param[in] path Output path.
+   * \param[in] name Name of the output, only "Particles" is supported.
+   * \param[in] out_par A structure containing parameters of the output.
+   *
+   * \throw std::invalid_argument if the content is not supported, the list of
+   *        quantities is empty or the number of events per row group is not
+   *        positive.
+   */
+  ParquetOutput(const std::filesystem::path &path, const std::string &name,
+                const OutputParameters &out_par);
+
+  /// Write the remaining rows and close the file.
+  ~ParquetOutput();
+
+  /**
+   * Writes the initial particle information of an event.
+   *
+   * \param[in] particles Current list of all particles.
+   * \param[in] event_label Numbers of the current event and ensemble.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void at_eventstart(const Particles &particles, const EventLabel &event_label,
+                     const EventInfo &event) override;
+
+  /**
+   * Writes the final particle information of an event. The rows are written
+   * as a row group to the file after the requested number of events.
+   *
+   * \param[in] particles Current list of particles.
+   * \param[in] event_label Numbers of the current event and ensemble.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void at_eventend(const Particles &particles, const EventLabel &event_label,
+                   const EventInfo &event) override;
+
+  /**
+   * Writes the particles at the intermediate output times.
+   *
+   * \param[in] particles Current list of particles.
+   * \param[in] clock Unused, needed since inherited.
+   * \param[in] dens_param Unused, needed since inherited.
+   * \param[in] event_label Numbers of the current event and ensemble.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param,
+                            const EventLabel &event_label,
+                            const EventInfo &event) override;
+
+  /// \return The event and intermediate time hooks, in which this output
+  /// writes.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet().set(EventHooks).set(IntermediateTimeHooks);
+  }
+
+ private:
+  /// The values of one column, which are not written yet.
+  struct Column {
+    /// Whether the column holds integers or doubles
+    bool is_integer;
+    /// The values of an integer column
+    std::vector<std::int32_t> integers{};
+    /// The values of a double column
+    std::vector<double> doubles{};
+  };
+
+  /**
+   * Append the rows of a block of particles to the columns.
+   *
+   * \param[in] particles The particles of the block.
+   * \param[in] event_label Numbers of the current event and ensemble.
+   */
+  void add_block(const Particles &particles, const EventLabel &event_label);
+
+  /// Write the buffered rows as one row group.
+  void write_row_group();
+
+  /// Filename of output
+  const std::filesystem::path filename_;
+  /// Filename of output as long as simulation is still running.
+  std::filesystem::path filename_unfinished_;
+  /// Whether final- or initial-state particles should be written.
+  const OutputOnlyFinal only_final_;
+  /// Number of events after which a row group is written
+  const int events_per_row_group_;
+  /// The formatter producing the values of the quantities
+  OutputFormatter<ToBinary> formatter_;
+  /**
+   * The columns, i.e. the event, ensemble and block numbers followed by the
+   * requested quantities
+   */
+  std::vector<Column> columns_;
+  /// The schema of the columns
+  std::shared_ptr<arrow::Schema> schema_;
+  /// The file the Parquet writer writes to
+  std::shared_ptr<arrow::io::FileOutputStream> file_;
+  /// The Parquet writer
+  std::unique_ptr<parquet::arrow::FileWriter> writer_;
+  /// Number of the next block of every ensemble in the current event
+  std::vector<std::int32_t> next_block_;
+  /// Number of buffered rows
+  std::int64_t n_rows_ = 0;
+  /// Number of events, whose rows are buffered
+  int n_events_ = 0;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_PARQUETOUTPUT_H_
@@ -0,0 +1,98 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_PARTICLECELLLIST_H_
+#define SRC_INCLUDE_SMASH_PARTICLECELLLIST_H_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "particledata.h"
+#include "threevector.h"
+
+namespace smash {
+
+/**
+ * \ingroup data
+ * A list of particles sorted into cubic cells, used to find the particles
+ * close to a given point without looping over all particles.
+ *
+ * The cells cover the bounding box of the particles and are at least as long
+ * as the given cutoff in every direction. Hence, all particles closer to a
+ * point than the cutoff are in the cell of the point or in one of its
+ * neighbouring cells. Like for the Grid, the number of cells per direction is
+ * limited to the cube root of the number of particles, such that dilute
+ * systems spread over a large volume do not need an excessive number of cells.
+ *
+ * The candidates of a point are returned in the order of the original list,
+ * such that sums over them are carried out in the same order as sums over all
+ * particles in which the distant particles are skipped.
+ */
+class ParticleCellList {
+ public:
+  /**
+   * Sort the particles into cells.
+   *
+   * \param[in] particles The particles to be sorted. The list has to outlive
+   *            the cell list and must not be changed in the meantime.
+   * \param[in] cutoff The distance [fm] up to which particles are guaranteed
+   *            to be found.
+   * \throw std::invalid_argument if the cutoff is not positive.
+   */
+  ParticleCellList(const ParticleList &particles, double cutoff);
+
+  /**
+   * Find the particles which might be closer to the given point than the
+   * cutoff.
+   *
+   * \param[in] r The point [fm].
+   * \param[out] candidates The candidates, in the order of the original list.
+   *             All particles closer to \p r than the cutoff are among them.
+   *             The previous content is discarded.
+   */
+  void find_candidates(const ThreeVector &r, ParticleList &candidates) const;
+
+  /// \return The number of cells in every direction.
+  const std::array<int, 3> &number_of_cells() const { return number_of_cells_; }
+
+ private:
+  /**
+   * \return The index of the given cell in the list of cells.
+   *
+   * \param[in] ix The index of the cell along x.
+   * \param[in] iy The index of the cell along y.
+   * \param[in] iz The index of the cell along z.
+   */
+  std::size_t cell_index(int ix, int iy, int iz) const {
+    return (static_cast<std::size_t>(iz) * number_of_cells_[1] + iy) *
+               number_of_cells_[0] +
+           ix;
+  }
+
+  /// The sorted particles
+  const ParticleList &particles_;
+  /// The minimal coordinates of the particles [fm]
+  std::array<double, 3> min_position_;
+  /// The inverse lengths of the cells [1/fm]
+  std::array<double, 3> index_factor_;
+  /// The number of cells in every direction
+  std::array<int, 3> number_of_cells_;
+  /**
+   * The position of the first particle of every cell in \ref
+   * particle_indices_, followed by the total number of particles
+   */
+  std::vector<std::size_t> cell_start_;
+  /// The indices of the particles in the list, sorted by cell
+  std::vector<std::size_t> particle_indices_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_PARTICLECELLLIST_H_
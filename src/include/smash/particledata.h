@@ -7,6 +7,7 @@
 #ifndef SRC_INCLUDE_SMASH_PARTICLEDATA_H_
 #define SRC_INCLUDE_SMASH_PARTICLEDATA_H_
 
+#include <cstddef>
 #include <limits>
 #include <utility>
 
@@ -136,11 +137,23 @@ class ParticleData {
    * \return id of particle's latest collision
    */
   uint32_t id_process() const { return history_.id_process; }
+  /**
+   * Get the number of collisions of the particle, which is zero only for
+   * initially present particles.
+   * \return collision counter of the particle
+   */
+  int32_t collisions_per_particle() const {
+    return history_.collisions_per_particle;
+  }
   /**
    * Get history information
    * \return particle history struct
    */
-  HistoryData get_history() const { return history_; }
+  HistoryData get_history() const {
+    return {history_.collisions_per_particle, history_.id_process,
+            static_cast<ProcessType>(process_type_),
+            history_.time_last_collision, history_.p1, history_.p2};
+  }
   /**
    * Set history_ from rvalue reference. Meant to be used only in
    * special situations e.g. in the ListModus, where a temporary HistoryData
@@ -148,7 +161,11 @@ class ParticleData {
    *
    * \param[in] history object to be moved from.
    */
-  void set_history(HistoryData &&history) { history_ = std::move(history); }
+  void set_history(HistoryData &&history) {
+    history_ = {history.time_last_collision, history.collisions_per_particle,
+                history.id_process, history.p1, history.p2};
+    process_type_ = static_cast<uint8_t>(history.process_type);
+  }
 
   /**
    * Store history information
@@ -176,6 +193,7 @@ class ParticleData {
    */
   void set_4momentum(const FourVector &momentum_vector) {
     momentum_ = momentum_vector;
+    inverse_energy_ = 1.0 / momentum_.x0();
   }
 
   /**
@@ -185,7 +203,7 @@ class ParticleData {
    * \param[in] mom the three-momentum of the particle [GeV]
    */
   void set_4momentum(double mass, const ThreeVector &mom) {
-    momentum_ = FourVector(std::sqrt(mass * mass + mom * mom), mom);
+    set_4momentum(FourVector(std::sqrt(mass * mass + mom * mom), mom));
   }
 
   /**
@@ -197,8 +215,8 @@ class ParticleData {
    * \param[in] pz z-component of the momentum [GeV]
    */
   void set_4momentum(double mass, double px, double py, double pz) {
-    momentum_ = FourVector(std::sqrt(mass * mass + px * px + py * py + pz * pz),
-                           px, py, pz);
+    set_4momentum(FourVector(
+        std::sqrt(mass * mass + px * px + py * py + pz * pz), px, py, pz));
   }
   /**
    * Set the momentum of the particle without modifying the energy.
@@ -207,6 +225,7 @@ class ParticleData {
    * \param[in] mom momentum 3-vector [GeV]
    */
   void set_3momentum(const ThreeVector &mom) {
+    // The energy and hence its inverse stay the same
     momentum_ = FourVector(momentum_.x0(), mom);
   }
 
@@ -315,10 +334,14 @@ class ParticleData {
   }
 
   /**
-   * Get the velocity 3-vector
+   * Get the velocity 3-vector. It is computed from the inverse of the energy,
+   * which is kept whenever the momentum is set, hence without a division but
+   * with the same result as FourVector::velocity.
    * \return 3-velocity of the particle
    */
-  ThreeVector velocity() const { return momentum_.velocity(); }
+  ThreeVector velocity() const {
+    return momentum_.threevec() * inverse_energy_;
+  }
 
   /**
    * Get the inverse of the gamma factor from the current velocity of the
@@ -327,8 +350,8 @@ class ParticleData {
    * \f[\frac{1}{\gamma}=\sqrt{1-v^2}\f]
    *
    * This functions is more efficient than calculating the gamma factor from
-   * \ref velocity, since the \ref velocity function must execute three
-   * divisions (for every space component of the momentum vector).
+   * \ref velocity, since it does not need the three components of the
+   * velocity.
    *
    * \returns inverse gamma factor
    */
@@ -340,9 +363,16 @@ class ParticleData {
    * Apply a full Lorentz boost of momentum and position
    * \param[in] v boost 3-velocity
    */
-  void boost(const ThreeVector &v) {
-    set_4momentum(momentum_.lorentz_boost(v));
-    set_4position(position_.lorentz_boost(v));
+  void boost(const ThreeVector &v) { boost(LorentzBoost(v)); }
+
+  /**
+   * Apply a full Lorentz boost of momentum and position, whose factors are
+   * shared with other particles boosted by the same velocity
+   * \param[in] lorentz the boost
+   */
+  void boost(const LorentzBoost &lorentz) {
+    set_4momentum(lorentz(momentum_));
+    set_4position(lorentz(position_));
   }
 
   /**
@@ -352,6 +382,15 @@ class ParticleData {
   void boost_momentum(const ThreeVector &v) {
     set_4momentum(momentum_.lorentz_boost(v));
   }
+
+  /**
+   * Apply a Lorentz-boost to only the momentum, whose factors are shared with
+   * other particles boosted by the same velocity
+   * \param[in] lorentz the boost
+   */
+  void boost_momentum(const LorentzBoost &lorentz) {
+    set_4momentum(lorentz(momentum_));
+  }
   /**
    * Get the (maximum positive) spin s of a particle in multiples of 1/2.
    * E.g. for a spin-1 particle s=2.
@@ -472,6 +511,7 @@ class ParticleData {
 
  private:
   friend class Particles;
+  friend class ParticlesView;
   /// Default constructor.
   ParticleData() = default;
 
@@ -483,7 +523,9 @@ class ParticleData {
    */
   void copy_to(ParticleData &dst) const {
     dst.history_ = history_;
+    dst.process_type_ = process_type_;
     dst.momentum_ = momentum_;
+    dst.inverse_energy_ = inverse_energy_;
     dst.position_ = position_;
     dst.spin_vector_ = spin_vector_;
     dst.formation_time_ = formation_time_;
@@ -520,10 +562,13 @@ class ParticleData {
    */
   ParticleTypePtr type_;
 
-  // this leaves us two Bytes padding to use for "free"
+  /* This leaves us four Bytes padding before the first FourVector to use for
+   * "free", which hold the flags below, the label of the nucleus and the type
+   * of the last process. */
   static_assert(sizeof(ParticleTypePtr) == 2, "");
   // make sure we don't exceed that space
-  static_assert(sizeof(bool) <= 2, "");
+  static_assert(2 * sizeof(bool) + sizeof(BelongsTo) + sizeof(uint8_t) <= 4,
+                "");
   /**
    * If \c true, the object is an entry in Particles::data_ and does not hold
    * valid particle data. Specifically iterations over Particles must skip
@@ -539,6 +584,15 @@ class ParticleData {
   // this trait.
   bool core_ = false;
 
+  /// is it part of projectile or target nuclei?
+  BelongsTo belongs_to_ = BelongsTo::Nothing;
+
+  /**
+   * Type of the last process, which is part of the history, but kept here in
+   * the padding, see get_history(). All process types fit into one Byte.
+   */
+  uint8_t process_type_ = static_cast<uint8_t>(ProcessType::None);
+
   /// momenta of the particle: x0, x1, x2, x3 as E, px, py, pz
   FourVector momentum_;
   /// position in space: x0, x1, x2, x3 as t, x, y, z
@@ -563,10 +617,76 @@ class ParticleData {
   double initial_xsec_scaling_factor_ = 1.0;
   /// Perturbative weight attributed to heavy flavor particles
   double perturbative_weight_ = 1.0;
-  /// history information
-  HistoryData history_;
-  /// is it part of projectile or target nuclei?
-  BelongsTo belongs_to_ = BelongsTo::Nothing;
+  /// Inverse of the energy of momentum_, see velocity()
+  double inverse_energy_ = std::numeric_limits<double>::infinity();
+  /**
+   * The history information except for the process type, ordered such that
+   * it takes 8 Bytes less than HistoryData, since ParticleData is copied into
+   * every action, grid cell and output buffer.
+   */
+  struct {
+    /// \see HistoryData::time_last_collision
+    double time_last_collision = smash_NaN<double>;
+    /// \see HistoryData::collisions_per_particle
+    int32_t collisions_per_particle = 0;
+    /// \see HistoryData::id_process
+    int32_t id_process = 0;
+    /// \see HistoryData::p1
+    PdgCode p1 = 0x0;
+    /// \see HistoryData::p2
+    PdgCode p2 = 0x0;
+  } history_;
+};
+
+/**
+ * \ingroup data
+ * A view of a contiguous range of particles, which does not own them.
+ *
+ * It is used to hand out parts of a larger list of particles, e.g. the cells
+ * of a Grid, without copying them. A ParticleList converts implicitly to a
+ * span of all its particles. The particles have to outlive the span.
+ */
+class ParticleSpan {
+ public:
+  /// Iterator over the particles of the span
+  using const_iterator = const ParticleData *;
+
+  /// Create an empty span.
+  ParticleSpan() = default;
+
+  /**
+   * Create a span of consecutive particles.
+   *
+   * \param[in] first The first particle of the span.
+   * \param[in] size The number of particles in the span.
+   */
+  ParticleSpan(const ParticleData *first, std::size_t size)
+      : first_(first), size_(size) {}
+
+  /**
+   * Create a span of all particles of a list.
+   *
+   * \param[in] list The particles of the span.
+   */
+  ParticleSpan(const ParticleList &list)  // NOLINT(runtime/explicit)
+      : first_(list.data()), size_(list.size()) {}
+
+  /// \return An iterator to the first particle.
+  const_iterator begin() const { return first_; }
+  /// \return An iterator past the last particle.
+  const_iterator end() const { return first_ + size_; }
+  /// \return The number of particles in the span.
+  std::size_t size() const { return size_; }
+  /// \return Whether the span contains no particles.
+  bool empty() const { return size_ == 0; }
+  /// \return The i-th particle of the span.
+  const ParticleData &operator[](std::size_t i) const { return first_[i]; }
+
+ private:
+  /// The first particle of the span
+  const ParticleData *first_ = nullptr;
+  /// The number of particles in the span
+  std::size_t size_ = 0;
 };
 
 /**
@@ -0,0 +1,131 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_PARTICLELISTFILE_H_
+#define SRC_INCLUDE_SMASH_PARTICLELISTFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup modus
+ * A file with external particle lists, which is mapped into memory.
+ *
+ * The file is scanned once when it is opened and the byte ranges of its
+ * events are stored, such that the events can be accessed without reading
+ * the file again.
+ *
+ * In an ASCII file, an event ends with a line containing \c " end ", like the
+ * event end lines of the OSCAR outputs. The text after the last such line is
+ * one more event, if it is not only whitespace. Hence, a file without event
+ * end lines contains one event.
+ *
+ * A binary file has the layout of the uncompressed SMASH binary particles
+ * output, see \ref doxypage_output_binary, with OSCAR 2013 or extended OSCAR
+ * 2013 particle lines. An event consists of the particle blocks before an
+ * event end block. The particle blocks after the last event end block are one
+ * more event.
+ *
+ * Internally this uses the POSIX \c mmap system call. The pages of the file
+ * are read by the operating system when they are first accessed and
+ * prefetch() asks it to read the pages of an event in the background.
+ */
+class ParticleListFile {
+ public:
+  /// The formats of the particle list files
+  enum class Format {
+    /// Text with one particle per line
+    ASCII,
+    /// SMASH binary particles output
+    Binary,
+  };
+
+  /// The content of one event
+  struct Event {
+    /**
+     * The lines of an ASCII event, excluding the event end line, or the
+     * particle blocks of a binary event
+     */
+    std::string_view content;
+    /// Line number of the first line of an ASCII event, starting at 1
+    int first_line;
+  };
+
+  /**
+   * Map the file into memory and find its events.
+   *
+   * \param[in] path Path to the file.
+   * \param[in] format Format of the file.
+   * \throw std::runtime_error if the file cannot be opened or mapped, or if a
+   *        binary file is not a valid uncompressed SMASH particles output
+   *        with OSCAR 2013 or extended OSCAR 2013 quantities.
+   */
+  explicit ParticleListFile(const std::filesystem::path &path,
+                            Format format = Format::ASCII);
+
+  /// A mapped file cannot be copied.
+  ParticleListFile(const ParticleListFile &) = delete;
+  /// A mapped file cannot be copied.
+  ParticleListFile &operator=(const ParticleListFile &) = delete;
+
+  /// Unmap the file.
+  ~ParticleListFile();
+
+  /// \return Number of events in the file.
+  std::size_t size() const { return events_.size(); }
+
+  /**
+   * \param[in] i Number of the event in the file, starting at 0.
+   * \return The content of the event, which is valid as long as this object.
+   */
+  const Event &operator[](std::size_t i) const { return events_[i]; }
+
+  /**
+   * Ask the operating system to read the pages of an event in the background.
+   * Nothing happens, if there is no such event.
+   *
+   * \param[in] i Number of the event in the file, starting at 0.
+   */
+  void prefetch(std::size_t i) const;
+
+  /**
+   * \return The format variant of a binary file, i.e. 0 for OSCAR 2013 and 1
+   *         for extended OSCAR 2013 particle lines.
+   */
+  std::uint16_t format_variant() const { return format_variant_; }
+
+ private:
+  /// Find the events of an ASCII file.
+  void index_ascii_events();
+
+  /**
+   * Read the header of a binary file and find its events.
+   *
+   * \throw std::runtime_error if the file is not valid.
+   */
+  void index_binary_events();
+
+  /// Begin of the mapped file, \c nullptr for an empty file
+  const char *data_ = nullptr;
+  /// Size of the file in bytes
+  std::size_t size_ = 0;
+  /// Format variant of a binary file
+  std::uint16_t format_variant_ = 0;
+  /// The events of the file
+  std::vector<Event> events_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_PARTICLELISTFILE_H_
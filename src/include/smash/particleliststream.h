@@ -0,0 +1,166 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_PARTICLELISTSTREAM_H_
+#define SRC_INCLUDE_SMASH_PARTICLELISTSTREAM_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "particlelistfile.h"
+
+namespace smash {
+
+/**
+ * \ingroup modus
+ * A stream of external particle lists, which is read while the events are
+ * simulated, e.g. from a program sampling the particles concurrently.
+ *
+ * The source is the standard input for \c "-", a local stream socket for
+ * \c "unix:<path>", to which the stream connects, and otherwise a file or
+ * named pipe. The events are framed like in a ParticleListFile of the same
+ * format.
+ *
+ * A background thread reads the events and keeps up to a given number of
+ * them in a queue, such that the next event is usually available when it is
+ * needed. If the queue is full, the thread waits and so does the writer of
+ * the stream once the buffer of the pipe or socket is full.
+ */
+class ParticleListStream {
+ public:
+  /// The content of one event
+  struct Event {
+    /**
+     * The lines of an ASCII event, excluding the event end line, or the
+     * particle blocks of a binary event
+     */
+    std::string content;
+    /// Line number of the first line of an ASCII event, starting at 1
+    int first_line;
+  };
+
+  /**
+   * Open the source and start reading its events in the background.
+   *
+   * \param[in] source The standard input for \c "-", a local stream socket
+   *            for \c "unix:<path>" and otherwise a file or named pipe.
+   * \param[in] format Format of the stream.
+   * \param[in] queue_size Largest number of events read ahead.
+   * \throw std::runtime_error if the source cannot be opened.
+   */
+  ParticleListStream(const std::string &source,
+                     ParticleListFile::Format format,
+                     std::size_t queue_size = 4);
+
+  /// A stream cannot be copied.
+  ParticleListStream(const ParticleListStream &) = delete;
+  /// A stream cannot be copied.
+  ParticleListStream &operator=(const ParticleListStream &) = delete;
+
+  /// Stop reading and close the source.
+  ~ParticleListStream();
+
+  /**
+   * Wait for the next event.
+   *
+   * \return The next event, or nothing at the end of the stream.
+   * \throw std::runtime_error if the stream cannot be read or if a binary
+   *        stream is not a valid uncompressed SMASH particles output with
+   *        OSCAR 2013 or extended OSCAR 2013 quantities.
+   */
+  std::optional<Event> next();
+
+  /**
+   * \return The format variant of a binary stream, i.e. 0 for OSCAR 2013 and 1
+   *         for extended OSCAR 2013 particle lines, once an event was returned.
+   */
+  std::uint16_t format_variant() const { return format_variant_; }
+
+  /// \return The source of the stream as given to the constructor.
+  const std::string &source() const { return source_; }
+
+ private:
+  /// Read the events of the source and queue them, executed by \c reader_.
+  void read_events();
+
+  /// Read the ASCII events.
+  void read_ascii_events();
+
+  /**
+   * Read the header and the events of a binary stream.
+   *
+   * \throw std::runtime_error if the stream is not valid.
+   */
+  void read_binary_events();
+
+  /**
+   * Append the next chunk of the source to \c buffer_.
+   *
+   * \return Whether anything was read, false at the end of the stream and
+   *         when the stream is stopped.
+   * \throw std::runtime_error if the source cannot be read.
+   */
+  bool read_chunk();
+
+  /**
+   * Read from the source until \c buffer_ holds the given number of bytes.
+   *
+   * \param[in] n_bytes Number of bytes needed.
+   * \return Whether the bytes are available.
+   */
+  bool fill(std::size_t n_bytes);
+
+  /**
+   * Queue an event, waiting while the queue is full.
+   *
+   * \param[in] event The event.
+   */
+  void push(Event event);
+
+  /// The source as given to the constructor
+  const std::string source_;
+  /// Format of the stream
+  const ParticleListFile::Format format_;
+  /// Largest number of queued events
+  const std::size_t queue_size_;
+  /// File descriptor of the source
+  int fd_ = -1;
+  /// Pipe to wake up the reader when the stream is stopped
+  int wake_pipe_[2] = {-1, -1};
+  /// Format variant of a binary stream
+  std::uint16_t format_variant_ = 0;
+  /// Bytes read from the source, which are not queued yet
+  std::string buffer_;
+
+  /// Protects the members below
+  std::mutex mutex_;
+  /// Signals changes of the queue and the end of reading
+  std::condition_variable changed_;
+  /// The events read ahead
+  std::deque<Event> queue_;
+  /// Whether the reader has finished
+  bool finished_ = false;
+  /// Whether the reader should stop
+  bool stopped_ = false;
+  /// The error which ended reading, if any
+  std::exception_ptr error_;
+  /// The thread reading the source
+  std::thread reader_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_PARTICLELISTSTREAM_H_
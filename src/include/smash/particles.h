@@ -7,10 +7,17 @@
 #ifndef SRC_INCLUDE_SMASH_PARTICLES_H_
 #define SRC_INCLUDE_SMASH_PARTICLES_H_
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "checkpoint.h"
+#include "hugepages.h"
 #include "macros.h"
 #include "particledata.h"
 #include "particletype.h"
@@ -108,6 +115,101 @@ class Particles {
    */
   void reset();
 
+  /**
+   * Replace the content of this object by copies of the particles in \p
+   * other. Contrarily to insert(), the ids of the particles are kept, as well
+   * as their order and the id counter of \p other.
+   *
+   * \param[in] other The particles to be copied.
+   */
+  void copy_from(const Particles &other);
+
+  /**
+   * Replace the content of this object by copies of the particles in \p other
+   * which are selected by \p keep. As in copy_from(const Particles &), the
+   * ids of the copied particles are kept, as well as their order and the id
+   * counter of \p other.
+   *
+   * \param[in] other The particles to be copied.
+   * \param[in] keep Whether a particle is copied.
+   */
+  void copy_from(const Particles &other,
+                 const std::function<bool(const ParticleData &)> &keep);
+
+  /**
+   * Write the particles and the holes between them to a checkpoint, such
+   * that the restored object hands out the same particles in the same order
+   * and fills the holes in the same order.
+   *
+   * \param[inout] checkpoint The checkpoint.
+   */
+  void save(CheckpointWriter &checkpoint) const;
+
+  /**
+   * Replace the content of this object by the particles saved in a
+   * checkpoint, which has to be written with the same particle types.
+   *
+   * \param[inout] checkpoint The checkpoint.
+   */
+  void restore(CheckpointReader &checkpoint);
+
+  /**
+   * \return The fraction of the used entries of the storage which are holes
+   * left by removed particles, 0 for an empty list.
+   */
+  double hole_fraction() const {
+    return data_size_ == 0 ? 0.
+                           : static_cast<double>(dirty_.size()) / data_size_;
+  }
+
+  /**
+   * Close the holes left by removed particles by moving the following
+   * particles to the front of the storage. The ids and the order of the
+   * particles are kept, such that iterating visits the same particles in the
+   * same order as before, without skipping holes.
+   *
+   * \note The particles get new indices, hence copies obtained before the
+   * compaction are no longer valid copies afterwards.
+   */
+  void compact();
+
+  /**
+   * Close the holes as in compact() and release the storage behind the last
+   * particle, e.g. if the memory is short.
+   *
+   * \note The particles are moved to a new storage, hence pointers to them
+   * are no longer valid afterwards.
+   */
+  void shrink_to_fit();
+
+  /**
+   * Move the particles to a newly allocated storage of the same capacity. The
+   * storage is first written by the calling thread, which places it on the
+   * NUMA node of this thread.
+   *
+   * \note Pointers to the particles are no longer valid afterwards.
+   */
+  void relocate();
+
+  /// \return The memory allocated for the particles [bytes].
+  std::size_t memory_usage() const {
+    return data_capacity_ * sizeof(ParticleData) +
+           (dirty_.capacity() + slots_.capacity()) * sizeof(unsigned);
+  }
+
+  /**
+   * Reorder the particles along a Morton (Z-order) curve through the box
+   * enclosing their positions, such that particles which are close in space
+   * are mostly also close in memory. The box is divided into \f$2^{10}\f$
+   * intervals per direction and particles in the same interval keep their
+   * relative order. The holes are closed as in compact() and the ids of the
+   * particles are kept.
+   *
+   * \note The particles get new indices, hence copies obtained before the
+   * reordering are no longer valid copies afterwards.
+   */
+  void sort_along_morton_curve();
+
   /**
    * Check whether the ParticleData copy is still a valid copy of the one
    * stored in the Particles object.
@@ -224,6 +326,32 @@ class Particles {
     return data_[old_state.index_];
   }
 
+  /**
+   * Find the particle with the given id in constant time.
+   *
+   * \param[in] id The id of the searched particle.
+   * \return The particle with the id or \c nullptr, if there is none.
+   */
+  const ParticleData *find(int id) const {
+    if (id < 0 || static_cast<std::size_t>(id) >= slots_.size() ||
+        slots_[id] >= data_size_) {
+      return nullptr;
+    }
+    const ParticleData &p = data_[slots_[id]];
+    return !p.hole_ && p.id() == id ? &p : nullptr;
+  }
+
+  /**
+   * Find the particle with the given id in constant time, for modifying it in
+   * place, e.g. its position. \see find(int) const
+   *
+   * \param[in] id The id of the searched particle.
+   * \return The particle with the id or \c nullptr, if there is none.
+   */
+  ParticleData *find(int id) {
+    return const_cast<ParticleData *>(std::as_const(*this).find(id));
+  }
+
   /**
    * \internal
    * Iterator type that skips over the holes in `data_`. It implements a
@@ -439,6 +567,9 @@ class Particles {
                                   const Particles &particles);
 
  private:
+  /// The view reads the storage of the particles directly
+  friend class ParticlesView;
+
   /**
    * Highest id of a given particle. The first particle added to data_ will
    * have id 0.
@@ -453,6 +584,22 @@ class Particles {
    * data_capacity_. This is enforced in DEBUG builds.
    */
   void increase_capacity(unsigned new_capacity);
+  /**
+   * \internal
+   * Move the particles to a new storage of the given capacity.
+   *
+   * \param[in] new_capacity new capacity which is expected to be larger than
+   * data_size_. This is enforced in DEBUG builds.
+   */
+  void reallocate(unsigned new_capacity);
+  /**
+   * \internal
+   * \return Storage of default constructed particles, which is backed by huge
+   *         pages if enabled, see HugePages.
+   * \param[in] capacity Number of particles.
+   */
+  static std::unique_ptr<ParticleData[], HugePages::Deleter> allocate(
+      unsigned capacity);
   /**
    * \internal
    * Ensure that the capacity of data_ is large enough to hold \p to_add more
@@ -479,6 +626,27 @@ class Particles {
    */
   inline void copy_in(ParticleData &to, const ParticleData &from);
 
+  /**
+   * \internal
+   * Store the index in data_ of the particle with the given id in slots_.
+   *
+   * \param[in] id The id of the particle, negative ids are ignored.
+   * \param[in] index The index of the particle in data_, or no_slot if the
+   *            particle was removed.
+   */
+  void set_slot(int id, unsigned index) {
+    if (id < 0) {
+      return;
+    }
+    if (static_cast<std::size_t>(id) >= slots_.size()) {
+      slots_.resize(id + 1, no_slot);
+    }
+    slots_[id] = index;
+  }
+
+  /// \internal Store the indices of all particles in slots_ anew.
+  void refill_slots();
+
   /**
    * \internal
    * The number of elements in data_ (including holes, but excluding entries
@@ -493,15 +661,187 @@ class Particles {
   /**
    * Points to a dynamically allocated array of ParticleData objects. The
    * allocated size is stored in data_capacity_ and the used range (starting
-   * from index 0) is stored in data_size_.
+   * from index 0) is stored in data_size_. Large arrays are backed by huge
+   * pages if enabled, see HugePages.
    */
-  std::unique_ptr<ParticleData[]> data_;
+  std::unique_ptr<ParticleData[], HugePages::Deleter> data_;
 
   /**
    * Stores the indexes in data_ that do not hold valid particle data and should
    * be reused when new particles are added.
    */
   std::vector<unsigned> dirty_;
+
+  /// The entry of slots_ of an id without a particle
+  static constexpr unsigned no_slot = std::numeric_limits<unsigned>::max();
+
+  /**
+   * The index in data_ of the particle of every id up to id_max_, or no_slot
+   * for removed particles. Since the ids are handed out one after the other,
+   * this is a dense map from the ids to the particles.
+   */
+  std::vector<unsigned> slots_;
+};
+
+/**
+ * \ingroup data
+ * A read-only view of the particles of one or several containers, which are
+ * iterated one after the other without copying them.
+ *
+ * The view keeps the contiguous storage of every container, which includes
+ * the holes of a Particles object, and skips the holes while iterating. Hence,
+ * the particles are visited in the same order as when iterating over the
+ * containers one by one, e.g. over all ensembles. The view does not own the
+ * particles and becomes invalid as soon as a particle is added to or removed
+ * from one of the containers.
+ */
+class ParticlesView {
+ public:
+  /// Forward iterator over the particles of the view.
+  class const_iterator {
+   public:
+    /// <b>Required by STL:</b> expose iterator_category
+    using iterator_category = std::forward_iterator_tag;
+    /// <b>Required by STL:</b> expose value_type
+    using value_type = ParticleData;
+    /// <b>Required by STL:</b> expose difference_type
+    using difference_type = std::ptrdiff_t;
+    /// <b>Required by STL:</b> expose pointer
+    using pointer = const ParticleData *;
+    /// <b>Required by STL:</b> expose reference
+    using reference = const ParticleData &;
+
+    /// Create the end iterator.
+    const_iterator() = default;
+
+    /**
+     * Create an iterator pointing to the first particle of the given ranges.
+     *
+     * \param[in] range The first range.
+     * \param[in] last_range The end of the ranges.
+     */
+    const_iterator(const ParticleSpan *range, const ParticleSpan *last_range)
+        : range_(range), last_range_(last_range) {
+      if (range_ != last_range_) {
+        ptr_ = range_->begin();
+        skip_holes();
+      }
+    }
+
+    /// \return The iterator to the next particle.
+    const_iterator &operator++() {
+      ++ptr_;
+      skip_holes();
+      return *this;
+    }
+    /// \return The iterator before the increment.
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      operator++();
+      return old;
+    }
+    /// \return The particle the iterator points to.
+    reference operator*() const { return *ptr_; }
+    /// \return A pointer to the particle the iterator points to.
+    pointer operator->() const { return ptr_; }
+    /// \return Whether both iterators point to the same particle.
+    bool operator==(const const_iterator &other) const {
+      return ptr_ == other.ptr_;
+    }
+    /// \return Whether the iterators point to different particles.
+    bool operator!=(const const_iterator &other) const {
+      return ptr_ != other.ptr_;
+    }
+
+   private:
+    /**
+     * Advance to the next particle which is not a hole, continuing with the
+     * next range at the end of a range. At the end of the last range, the
+     * iterator becomes equal to the end iterator.
+     */
+    void skip_holes() {
+      while (true) {
+        if (ptr_ == range_->end()) {
+          if (++range_ == last_range_) {
+            ptr_ = nullptr;
+            return;
+          }
+          ptr_ = range_->begin();
+        } else if (ptr_->hole_) {
+          ++ptr_;
+        } else {
+          return;
+        }
+      }
+    }
+
+    /// The range containing the current particle
+    const ParticleSpan *range_ = nullptr;
+    /// The end of the ranges
+    const ParticleSpan *last_range_ = nullptr;
+    /// The current particle, null at the end
+    const ParticleData *ptr_ = nullptr;
+  };
+
+  /**
+   * View the particles of a list.
+   *
+   * \param[in] list The particles to be viewed.
+   */
+  ParticlesView(const ParticleList &list)  // NOLINT(runtime/explicit)
+      : ranges_{ParticleSpan(list)}, size_(list.size()) {}
+
+  /**
+   * View the particles of a Particles object.
+   *
+   * \param[in] particles The particles to be viewed.
+   */
+  ParticlesView(const Particles &particles)  // NOLINT(runtime/explicit)
+      : size_(0) {
+    add(particles);
+  }
+
+  /**
+   * View the particles of all ensembles, one ensemble after the other.
+   *
+   * \param[in] ensembles The particles of every ensemble.
+   */
+  ParticlesView(const std::vector<Particles> &ensembles)  // NOLINT
+      : size_(0) {
+    ranges_.reserve(ensembles.size());
+    for (const Particles &particles : ensembles) {
+      add(particles);
+    }
+  }
+
+  /// \return An iterator to the first particle.
+  const_iterator begin() const {
+    return {ranges_.data(), ranges_.data() + ranges_.size()};
+  }
+  /// \return The end iterator.
+  const_iterator end() const { return {}; }
+  /// \return The number of particles in the view.
+  std::size_t size() const { return size_; }
+  /// \return Whether the view contains no particles.
+  bool empty() const { return size_ == 0; }
+
+ private:
+  /**
+   * Append the storage of the given particles to the ranges.
+   *
+   * \param[in] particles The particles to be added to the view.
+   */
+  void add(const Particles &particles) {
+    if (particles.size() > 0) {
+      ranges_.emplace_back(particles.data_.get(), particles.data_size_);
+      size_ += particles.size();
+    }
+  }
+
+  /// The contiguous ranges of the viewed particles, which may contain holes
+  std::vector<ParticleSpan> ranges_;
+  /// The number of viewed particles
+  std::size_t size_;
 };
 
 }  // namespace smash
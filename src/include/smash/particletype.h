@@ -333,6 +333,53 @@ class ParticleType {
   DecayBranchList get_partial_widths(const FourVector p, const ThreeVector x,
                                      WhichDecaymodes wh) const;
 
+  /**
+   * Get the same process branches as get_partial_widths, while counting all
+   * decay modes with a positive partial width in the same loop.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] x position of the decaying particle.
+   * \param[in] wh enum that decides which decaymodes are returned.
+   * \param[out] n_open_modes number of decay modes of any kind with a
+   *             positive partial width.
+   * \return a list of process branches, whose weights correspond to the
+   * actual partial widths.
+   */
+  DecayBranchList get_partial_widths(const FourVector p, const ThreeVector x,
+                                     WhichDecaymodes wh,
+                                     size_t &n_open_modes) const;
+
+  /**
+   * Get the mass-dependent partial decay widths of all decay modes without
+   * creating process branches, writing them into a buffer of the caller.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] x position of the decaying particle.
+   * \param[in] wh enum that decides which decaymodes are wanted.
+   * \param[out] widths The partial width of every decay mode in the order of
+   *             DecayModes::channels(), zero for the closed and unwanted
+   *             ones. The buffer is resized to the number of decay modes, such
+   *             that it does not allocate if it is reused.
+   * \return the sum of the partial widths, summed in the same order as by
+   * get_total_width.
+   */
+  double get_partial_widths(const FourVector &p, const ThreeVector &x,
+                            WhichDecaymodes wh,
+                            std::vector<double> &widths) const;
+
+  /**
+   * Get the sum of the mass-dependent partial decay widths, which are returned
+   * by get_partial_widths, without creating the process branches.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] x position of the decaying particle.
+   * \param[in] wh enum that decides which decaymodes are summed.
+   * \return the sum of the weights of the process branches, which
+   * get_partial_widths would return.
+   */
+  double get_total_width(const FourVector p, const ThreeVector x,
+                         WhichDecaymodes wh) const;
+
   /**
    * Get the mass-dependent partial width of a resonance with mass m,
    * decaying into two given daughter particles.
@@ -370,7 +417,9 @@ class ParticleType {
    * \return the value of the spectral function for this mass
    *
    * \note The normalization factor N ensures that the spectral function is
-   *       normalized to unity.
+   *       normalized to unity. It is computed by normalize_spectral_functions
+   *       when the decay modes are loaded, such that this function only reads
+   *       it and can be called concurrently.
    */
   double spectral_function(double m) const;
 
@@ -430,6 +479,19 @@ class ParticleType {
                                                     const double cms_energy,
                                                     int L = 0) const;
 
+  /**
+   * Choose how sample_resonance_mass samples the mass of a resonance produced
+   * with a stable particle.
+   *
+   * \param[in] tabulated Whether the mass is drawn from the tabulated inverse
+   *            cumulative distribution of a ResonanceMassTable, where it is
+   *            tabulated, instead of by rejection. The rejection sampling is
+   *            exact and the default.
+   */
+  static void set_tabulated_mass_sampling(bool tabulated) {
+    tabulated_mass_sampling_ = tabulated;
+  }
+
   /**
    * Prints out width and spectral function versus mass to the
    * standard output. This is useful for debugging and analysis.
@@ -539,6 +601,17 @@ class ParticleType {
    */
   static void create_type_list(const std::string &particles);
 
+  /**
+   * Initialize the global ParticleType list (list_all) from already
+   * constructed types, e.g. those of the TypeCache, and build the isospin
+   * multiplets. This function must only be called once.
+   *
+   * \param[in] types The particle types, including the antiparticles.
+   * \throw LoadFailure if there are duplicate PDG codes
+   * \throw runtime_error if this function is called more than once
+   */
+  static void create_type_list(ParticleTypeList types);
+
   /**
    * \param[in] rhs another ParticleType to compare to
    * \return whether the two ParticleType objects have the same PDG code.
@@ -572,6 +645,18 @@ class ParticleType {
    */
   static void check_consistency();
 
+  /**
+   * Compute the normalization factors of the spectral functions of all
+   * unstable particle types, discarding any previously computed ones. Since
+   * the normalization depends on the mass-dependent widths, this has to be
+   * called whenever the decay modes change and is done by
+   * DecayModes::load_decaymodes.
+   *
+   * Note that the particles and decay modes have to be initialized, otherwise
+   * calling this is undefined behavior.
+   */
+  static void normalize_spectral_functions();
+
   /**
    * Returns an object that acts like a pointer, except that it requires only 2
    * bytes and inhibits pointer arithmetics.
@@ -621,6 +706,29 @@ class ParticleType {
   };
 
  private:
+  /**
+   * Integrate the spectral function without normalization factor over its
+   * full domain.
+   *
+   * \return the normalization factor N of the spectral function
+   * \see spectral_function
+   */
+  double compute_norm_factor() const;
+
+  /**
+   * Calculate the mass-dependent partial widths of all wanted decay modes,
+   * which are larger than zero, and pass them to the given function.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] x position of the decaying particle.
+   * \param[in] wh enum that decides which decaymodes are wanted.
+   * \param[in] f Function called with the index, the type and the partial
+   *            width of every decay mode, in the order of the decay modes.
+   */
+  template <typename F>
+  void for_each_partial_width(const FourVector &p, const ThreeVector &x,
+                              WhichDecaymodes wh, F &&f) const;
+
   /// name of the particle
   std::string name_;
   /// pole mass of the particle
@@ -646,7 +754,10 @@ class ParticleType {
    */
   mutable double min_mass_spectral_;
   /** This normalization factor ensures that the spectral function is normalized
-   * to unity, when integrated over its full domain. */
+   * to unity, when integrated over its full domain. It is negative as long as
+   * it has not been computed.
+   * Mutable, because it is initialized by normalize_spectral_functions or at
+   * the first call of spectral_function, so it's logically const. */
   mutable double norm_factor_ = -1.;
   /// Charge of the particle; filled automatically from pdgcode_.
   int32_t charge_;
@@ -663,6 +774,9 @@ class ParticleType {
   /// Maximum factor for double-res mass sampling, cf. sample_resonance_masses.
   mutable double max_factor2_ = 1.;
 
+  /// Whether the masses are sampled from tables, cf. sample_resonance_mass.
+  inline static bool tabulated_mass_sampling_ = false;
+
   /**\ingroup logging
    * Writes all information about the particle type to the output stream.
    *
@@ -670,6 +784,9 @@ class ParticleType {
    * \param[in] type The ParticleType object to write into out
    */
   friend std::ostream &operator<<(std::ostream &out, const ParticleType &type);
+
+  /// The TypeCache stores and restores the normalization of the spectra.
+  friend struct TypeCache;
 };
 
 /**
@@ -760,23 +877,72 @@ class ParticleTypePtr {
   std::uint16_t index_ = 0xffff;
 };
 
+/**
+ * \ingroup data
+ * A view of consecutive particle types, e.g. the resonances of a pair of types
+ * in the table of list_possible_resonances, which does not own them.
+ */
+class ParticleTypePtrSpan {
+ public:
+  /// Iterator over the types of the span
+  using const_iterator = const ParticleTypePtr *;
+
+  /// Create an empty span.
+  ParticleTypePtrSpan() = default;
+
+  /**
+   * Create a span of consecutive types.
+   *
+   * \param[in] first The first type of the span.
+   * \param[in] size The number of types in the span.
+   */
+  ParticleTypePtrSpan(const ParticleTypePtr *first, std::size_t size)
+      : first_(first), size_(size) {}
+
+  /// \return An iterator to the first type.
+  const_iterator begin() const { return first_; }
+  /// \return An iterator past the last type.
+  const_iterator end() const { return first_ + size_; }
+  /// \return The number of types in the span.
+  std::size_t size() const { return size_; }
+  /// \return Whether the span contains no types.
+  bool empty() const { return size_ == 0; }
+  /// \return The i-th type of the span.
+  ParticleTypePtr operator[](std::size_t i) const { return first_[i]; }
+
+ private:
+  /// The first type of the span
+  const ParticleTypePtr *first_ = nullptr;
+  /// The number of types in the span
+  std::size_t size_ = 0;
+};
+
 inline ParticleTypePtr ParticleType::get_antiparticle() const {
   assert(has_antiparticle());
   return &find(pdgcode_.get_antiparticle());
 }
 
+/**
+ * Tabulate the possible resonances of all pairs of particle types for
+ * list_possible_resonances. This is done once the decay modes are loaded, see
+ * DecayModes::load_decaymodes, and the table is removed when the particle
+ * types are created again.
+ */
+void create_resonance_table();
+
 /**
  * Lists the possible resonances that decay into two particles.
  *
  * \param[in] type_a first incoming particle.
  * \param[in] type_b second incoming particle.
- * \return list of possible resonances.
+ * \return list of possible resonances, in the order of ParticleType::list_all.
+ *         It is empty if the table was not created.
  *
- * \note Internally, a `static std::map` is used as a caching mechanism and is
- * filled the first time this function is called, such that calling it again
- * just returns the same list.
+ * \note The lists of all pairs of types are stored one after the other in a
+ * table, see create_resonance_table, such that looking a pair up neither
+ * allocates nor locks. The order of the two types does not matter.
  */
-ParticleTypePtrList list_possible_resonances(const ParticleTypePtr type_a,
+ParticleTypePtrSpan list_possible_resonances(const ParticleTypePtr type_a,
                                              const ParticleTypePtr type_b);
 
 }  // namespace smash
@@ -10,6 +10,10 @@
 #ifndef SRC_INCLUDE_SMASH_PAULIBLOCKING_H_
 #define SRC_INCLUDE_SMASH_PAULIBLOCKING_H_
 
+#include <array>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "configuration.h"
@@ -34,6 +38,21 @@ namespace smash {
  * \iref{Gaitanos:2010fd}, section III B. Our implementation
  * mainly follows this article (and therefore GiBUU, see
  * http://gibuu.hepforge.org).
+ *
+ * Only particles closer than \f$r_r + r_c\f$ in coordinate space contribute
+ * to the phase-space density. To avoid looping over all particles for every
+ * estimate, the particles can be binned by species into cells in coordinate
+ * space with update_index(), such that only the neighbouring cells have to
+ * be visited. The index is kept up to date by passing the particles produced
+ * by every performed action to add_to_index(). Indexed particles which have
+ * been removed or changed afterwards are recognised and skipped, while their
+ * current position and momentum are used, such that the result is the same
+ * as without the index.
+ *
+ * Alternatively, the baryons can be deposited onto a lattice in coordinate
+ * and momentum space with update_index(), from which the phase-space density
+ * is interpolated at constant cost. This lattice is kept for the whole time
+ * step, see \ref key_CT_PB_occupancy_lattice_ "Occupancy_Lattice".
  */
 class PauliBlocker {
  public:
@@ -68,7 +87,96 @@ class PauliBlocker {
                          const PdgCode pdg,
                          const ParticleList &disregard) const;
 
+  /**
+   * Bin the particles of all ensembles by species into cells in coordinate
+   * space, which are used by phasespace_dens to find the contributing
+   * particles. A previous index is discarded. With the occupancy lattice, the
+   * baryons are deposited onto the lattice instead.
+   *
+   * The index is only used for estimates with the very same ensembles and
+   * until clear_index() is called. Particles can move in the meantime, as long
+   * as they do not move farther than the given displacement and the particles
+   * changed with actions are passed to add_to_index().
+   *
+   * \param[in] ensembles Current list of particles in all ensembles.
+   * \param[in] max_displacement Largest distance a particle can travel while
+   *            the index is used [fm], i.e. the time until clear_index() is
+   *            called divided by the speed of light.
+   */
+  void update_index(const std::vector<Particles> &ensembles,
+                    double max_displacement);
+
+  /**
+   * Add the particles updated or produced by an action to the index, such
+   * that they are found at their present position. Nothing is done if no index
+   * has been built or the occupancy lattice is used.
+   *
+   * \param[in] particles Valid copies of the particles after the action.
+   * \param[in] i_ensemble Index of the ensemble the particles belong to.
+   */
+  void add_to_index(const ParticleList &particles, int i_ensemble);
+
+  /// Discard the index, such that all particles are visited again.
+  void clear_index();
+
  private:
+  /// Integer coordinates of a cell of the index
+  using CellIndex = std::array<std::int64_t, 3>;
+
+  /// Particles of one ensemble binned by species and cell
+  struct EnsembleIndex {
+    /// Copies of the particles at the time they were added to the index
+    std::vector<ParticleData> entries;
+    /// Position in entries of the most recent copy of every particle id
+    std::unordered_map<int, std::size_t> latest_entry;
+    /// Positions in entries of the copies of each species in each cell
+    std::map<PdgCode, std::map<CellIndex, std::vector<std::size_t>>> cells;
+  };
+
+  /**
+   * Weight of a particle for the phase-space density at (r,p), without the
+   * normalization to the number of testparticles and ensembles.
+   *
+   * \param[in] part Particle which may contribute.
+   * \param[in] r Position at which the density is calculated.
+   * \param[in] p Momentum at which the density is calculated.
+   * \param[in] pdg Species for which the density is calculated.
+   * \param[in] disregard Particles that should not be counted.
+   * \return The contribution of the particle, zero if it does not contribute.
+   */
+  double weight(const ParticleData &part, const ThreeVector &r,
+                const ThreeVector &p, const PdgCode pdg,
+                const ParticleList &disregard) const;
+
+  /// \return The cell of the index containing the given position.
+  CellIndex cell_of(const ThreeVector &r) const;
+
+  /// Add a copy of the particle to the index of the given ensemble.
+  void add_entry(const ParticleData &part, EnsembleIndex &index);
+
+  /**
+   * Find the nodes of the occupancy lattice surrounding a point in phase
+   * space.
+   *
+   * \param[in] r Position of the point.
+   * \param[in] p Momentum of the point.
+   * \param[out] lower The lower node in every direction.
+   * \param[out] upper_weight The weight of the upper node in every direction.
+   * \return Whether the nodes are within the range of the lattice.
+   */
+  bool lattice_nodes(const ThreeVector &r, const ThreeVector &p,
+                     std::array<std::int64_t, 6> &lower,
+                     std::array<double, 6> &upper_weight) const;
+
+  /**
+   * Phase-space density interpolated from the occupancy lattice.
+   *
+   * \see phasespace_dens
+   */
+  double lattice_phasespace_dens(const ThreeVector &r, const ThreeVector &p,
+                                 const PdgCode pdg,
+                                 const ParticleList &disregard) const;
+
   /// Tabulate integrals for weights
   void init_weights();
 
@@ -95,6 +203,40 @@ class PauliBlocker {
 
   /// Weights: tabulated results of numerical integration
   std::array<double, 30> weights_;
+
+  /// Ensembles for which the index was built, nullptr if there is no index
+  const std::vector<Particles> *indexed_ensembles_ = nullptr;
+
+  /// Index of the particles of every ensemble
+  std::vector<EnsembleIndex> index_;
+
+  /// Edge length of the cells of the index, fm
+  double index_cell_size_ = 0.0;
+
+  /// Whether the phase-space density is interpolated from a lattice
+  bool occupancy_lattice_;
+
+  /// Distance of the nodes of the occupancy lattice in coordinate space, fm
+  double lattice_dr_;
+
+  /// Distance of the nodes of the occupancy lattice in momentum space, GeV
+  double lattice_dp_;
+
+  /// Baryons deposited onto the occupancy lattice
+  struct Deposit {
+    /// Species of the baryon
+    PdgCode pdg;
+    /// Position at the time it was deposited
+    ThreeVector r;
+    /// Momentum at the time it was deposited
+    ThreeVector p;
+  };
+
+  /// Summed weights of the baryons of every species at the occupied nodes
+  std::map<PdgCode, std::unordered_map<std::uint64_t, double>> occupancy_;
+
+  /// The deposited baryons by their id, which is unique within an ensemble
+  std::unordered_multimap<int, Deposit> deposits_;
 };
 }  // namespace smash
 
@@ -0,0 +1,111 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_PERFORMANCEOUTPUT_H_
+#define SRC_INCLUDE_SMASH_PERFORMANCEOUTPUT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "file.h"
+#include "outputinterface.h"
+#include "processbranch.h"
+#include "profiler.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * The memory used by a subsystem of the simulation, e.g. the particles of all
+ * ensembles.
+ */
+struct MemoryUsage {
+  /// The name of the subsystem
+  std::string subsystem;
+  /// Memory used at the latest measurement [bytes]
+  std::size_t current;
+  /// Maximal memory used at any measurement in the event [bytes]
+  std::size_t peak;
+};
+
+/**
+ * \ingroup output
+ *
+ * Statistics about the computational work done in an event, summed over all
+ * ensembles.
+ */
+struct EventStatistics {
+  /// Wall time of the event until its end output [s]
+  double wall_time = 0.0;
+  /// Numbers of the performed actions of the process types with any
+  std::vector<std::pair<ProcessType, uint64_t>> performed;
+  /// Number of actions discarded, because they were invalidated before
+  uint64_t discarded = 0;
+  /// Number of Pauli-blocked actions
+  uint64_t pauli_blocked = 0;
+  /// Number of performed string fragmentations
+  uint64_t strings = 0;
+  /// Time spent in performing string fragmentations [s]
+  double string_time = 0.0;
+  /// Mean number of particles per cell of the grids built in the event
+  double mean_cell_occupancy = 0.0;
+  /// Maximal number of entries of the action queue of one ensemble
+  uint64_t max_queued_actions = 0;
+  /// The times of the profiled phases of the event, ordered by time
+  std::vector<Profiler::Total> phases;
+  /// The memory used by the subsystems, if it is measured
+  std::vector<MemoryUsage> memory;
+};
+
+/**
+ * \ingroup output
+ *
+ * \brief Writes the work statistics of every event as a line of JSON
+ *
+ * The file can be read line by line while SMASH runs, e.g. to watch the
+ * performance of many production jobs, see \ref doxypage_output_performance.
+ */
+class PerformanceOutput : public OutputInterface {
+ public:
+  /**
+   * Create the output.
+   *
+   * \param[in] path Path of the output directory.
+   * \param[in] name Name of the output content.
+   */
+  PerformanceOutput(const std::filesystem::path &path,
+                    const std::string &name);
+
+  /**
+   * Write the statistics of an event.
+   *
+   * \param[in] event_number The number of the event.
+   * \param[in] statistics The statistics of the event.
+   */
+  void event_statistics_output(const int event_number,
+                               const EventStatistics &statistics) override;
+
+  /// \return The event hooks, since only the statistics are written.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet().set(EventHooks);
+  }
+
+ private:
+  /// Pointer to the output file
+  RenamingFilePtr file_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_PERFORMANCEOUTPUT_H_
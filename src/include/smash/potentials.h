@@ -21,6 +21,7 @@
 #include "density.h"
 #include "forwarddeclarations.h"
 #include "particledata.h"
+#include "powersumtable.h"
 #include "rootsolver.h"
 #include "threevector.h"
 
@@ -62,11 +63,10 @@ class Potentials {
    * \return ThreeVector gradient of the single particle energy in the
    * calculation frame in MeV/fm
    */
-  ThreeVector single_particle_energy_gradient(DensityLattice *jB_lattice,
-                                              const ThreeVector &position,
-                                              const ThreeVector &momentum,
-                                              double mass,
-                                              ParticleList &plist) const {
+  ThreeVector single_particle_energy_gradient(
+      DensityLattice *jB_lattice, const ThreeVector &position,
+      const ThreeVector &momentum, double mass,
+      const ParticlesView &plist) const {
     const std::array<double, 3> dr = (jB_lattice)
                                          ? jB_lattice->cell_sizes()
                                          : std::array<double, 3>{0.1, 0.1, 0.1};
@@ -199,9 +199,7 @@ class Potentials {
    * \return Skyrme potential \f[U_B=10^{-3}\times\frac{\rho}{|\rho|}
    *         (A\frac{\rho}{\rho_0}+B(\frac{\rho}{\rho_0})^\tau)\f] in GeV
    */
-  double skyrme_pot(const double baryon_density) const {
-    return skyrme_pot(baryon_density, skyrme_a_, skyrme_b_, skyrme_tau_);
-  }
+  double skyrme_pot(const double baryon_density) const;
 
   /**
    * Evaluates symmetry potential given baryon isospin density.
@@ -260,7 +258,7 @@ class Potentials {
    *         light (u, d) quark to the total quark number and \f$I_3\f$ is the
    *         third compnent of the isospin.
    */
-  double potential(const ThreeVector &r, const ParticleList &plist,
+  double potential(const ThreeVector &r, const ParticlesView &plist,
                    const ParticleType &acts_on) const;
 
   /**
@@ -472,7 +470,7 @@ class Potentials {
    *          \f$B_{I_3}\f$: the magnetic component of the symmetry force
    */
   virtual std::tuple<ThreeVector, ThreeVector, ThreeVector, ThreeVector>
-  all_forces(const ThreeVector &r, const ParticleList &plist) const;
+  all_forces(const ThreeVector &r, const ParticlesView &plist) const;
 
   /// \return Is Skyrme potential on?
   virtual bool use_skyrme() const { return use_skyrme_; }
@@ -516,6 +514,12 @@ class Potentials {
     return use_potentials_outside_lattice_;
   }
 
+  /**
+   * \return The parameters of the smearing used for the densities outside of
+   * the lattice
+   */
+  const DensityParameters &density_parameters() const { return param_; }
+
  private:
   /**
    * Struct that contains the gaussian smearing width \f$\sigma\f$,
@@ -601,6 +605,28 @@ class Potentials {
   /// Parameters of the VDF potential: exponents \f$b_i\f$
   std::vector<double> powers_;
 
+  /// Whether the powers of the densities are interpolated in tables
+  bool tabulate_density_functions_;
+  /// Table of \f$B x^\tau\f$ with \f$x = |\rho_B|/\rho_0\f$ in MeV
+  PowerSumTable skyrme_table_;
+  /// Table of the derivative \f$B \tau x^{\tau - 1}\f$ in MeV
+  PowerSumTable skyrme_derivative_table_;
+  /// Table of \f$S(x)\f$ with \f$x = \rho_B/\rho_0\f$ in MeV
+  PowerSumTable symmetry_S_table_;
+  /// Table of the derivative \f$S'(x)\f$ in MeV
+  PowerSumTable symmetry_S_derivative_table_;
+  /**
+   * Table of \f$\sum_i C_i y^{b_i - 2}\f$ with
+   * \f$y = |\rho_B|/\rho_{\rm sat}\f$ in GeV, which is \f$F_2\f$ of the VDF
+   * potential times \f$\rho_{\rm sat}\f$
+   */
+  PowerSumTable vdf_F2_table_;
+  /**
+   * Table of \f$\sum_i C_i (b_i - 2) y^{b_i - 3}\f$ in GeV, which is
+   * \f$F_1\f$ of the VDF potential times \f$\rho_{\rm sat}^2\f$
+   */
+  PowerSumTable vdf_F1_table_;
+
   /**
    * Calculate the derivative of the symmetry potential with respect to
    * the isospin density in GeV * fm^3
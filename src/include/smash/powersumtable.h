@@ -0,0 +1,109 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_POWERSUMTABLE_H_
+#define SRC_INCLUDE_SMASH_POWERSUMTABLE_H_
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * \brief Tabulation of a sum of powers \f$f(x) = \sum_i c_i x^{p_i}\f$
+ *
+ * The density dependent parts of the potentials are sums of powers of the
+ * density with non-integer exponents, which are evaluated on every lattice
+ * node and for every particle in each time step. Here they are tabulated for
+ * positive \f$x\f$ and interpolated linearly.
+ *
+ * Each interval \f$[2^{e-1}, 2^e)\f$ of the argument is divided into the same
+ * number of equidistant steps, so the grid is monotone and its spacing is
+ * proportional to \f$x\f$. The relative accuracy is the same for small and
+ * large arguments and the index of an argument is found from its binary
+ * exponent and mantissa without evaluating a logarithm. The number of steps is
+ * doubled until the interpolation error at the midpoints of all steps is below
+ * the given tolerance, relative to \f$\sum_i |c_i x^{p_i}|\f$. Arguments
+ * outside of the tabulated range and non-positive ones are evaluated exactly.
+ */
+class PowerSumTable {
+ public:
+  /// Default constructor of an empty table, which always evaluates exactly
+  PowerSumTable() = default;
+
+  /**
+   * Tabulate the sum of powers.
+   *
+   * \param[in] coeffs The coefficients \f$c_i\f$.
+   * \param[in] powers The exponents \f$p_i\f$.
+   * \param[in] tolerance Largest relative error of the interpolation.
+   * \param[in] min_exponent The smallest tabulated argument is
+   *            \f$2^{\rm min\_exponent}\f$.
+   * \param[in] max_exponent The largest tabulated argument is
+   *            \f$2^{\rm max\_exponent}\f$.
+   * \throw std::invalid_argument if the numbers of coefficients and exponents
+   *        differ, or if the tolerance cannot be reached.
+   */
+  PowerSumTable(std::vector<double> coeffs, std::vector<double> powers,
+                double tolerance = 1e-6, int min_exponent = -24,
+                int max_exponent = 8);
+
+  /**
+   * \param[in] x The argument.
+   * \return The interpolated sum of powers.
+   */
+  double operator()(double x) const {
+    int exponent;
+    const double mantissa = std::frexp(x, &exponent);
+    if (!(x > 0.) || exponent <= min_exponent_ || exponent > max_exponent_) {
+      return exact(x);
+    }
+    // The mantissa is in [0.5, 1)
+    const double t = (2. * mantissa - 1.) * steps_;
+    const int k = static_cast<int>(t);
+    const std::size_t i = (exponent - min_exponent_ - 1) * steps_ + k;
+    return values_[i] + (t - k) * (values_[i + 1] - values_[i]);
+  }
+
+  /**
+   * \param[in] x The argument.
+   * \return The exactly evaluated sum of powers.
+   */
+  double exact(double x) const;
+
+  /// \return The number of steps per interval \f$[2^{e-1}, 2^e)\f$.
+  int steps() const { return steps_; }
+
+ private:
+  /**
+   * \param[in] x The argument.
+   * \return The sum of the absolute values of the terms.
+   */
+  double magnitude(double x) const;
+
+  /// The coefficients of the terms
+  std::vector<double> coeffs_;
+  /// The exponents of the terms
+  std::vector<double> powers_;
+  /// The binary exponent of the smallest tabulated argument
+  int min_exponent_ = 0;
+  /// The binary exponent of the largest tabulated argument
+  int max_exponent_ = 0;
+  /// Number of steps per interval \f$[2^{e-1}, 2^e)\f$
+  int steps_ = 0;
+  /// The tabulated values
+  std::vector<double> values_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_POWERSUMTABLE_H_
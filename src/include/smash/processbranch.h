@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "blockpool.h"
 #include "decaytype.h"
 #include "forwarddeclarations.h"
 #include "particletype.h"
@@ -161,7 +162,7 @@ std::ostream &operator<<(std::ostream &os, ProcessType process_type);
  * deltaplus_decay_modes.push_back(branch);
  * \endcode
  */
-class ProcessBranch {
+class ProcessBranch : public PoolAllocated {
  public:
   /// Create a ProcessBranch without final states and weight.
   ProcessBranch() : branch_weight_(0.) {}
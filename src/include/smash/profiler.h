@@ -0,0 +1,330 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_PROFILER_H_
+#define SRC_INCLUDE_SMASH_PROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hardwarecounters.h"
+#include "tracerecorder.h"
+
+namespace smash {
+
+/**
+ * Measures the time spent in named sections of the code, e.g. the phases of
+ * the time evolution.
+ *
+ * The sections are added once by name, before any time is measured for them,
+ * and the time spent in a section is then measured by a Scope living as long
+ * as the section runs. The times of an event are summed up until
+ * finish_event() is called, which adds them to the totals of all events.
+ *
+ * A disabled profiler does not read the clock at all, such that a Scope only
+ * costs a branch. The times may be added from several threads at once, e.g.
+ * by parallel ensembles, and are then summed up over the threads. Sections may
+ * be nested, the time of the inner section is then part of the time of the
+ * outer one as well.
+ *
+ * The measured spans may be recorded by a TraceRecorder as well, such that the
+ * timeline of the run can be looked at. With enabled hardware counters, the
+ * HardwareCounters of the thread running a Scope are read at its begin and
+ * end as well, and the differences are added to the section. Work which a
+ * section hands over to other threads is only counted, if these threads
+ * measure it in sections of their own.
+ */
+class Profiler {
+ public:
+  /// The clock used for measuring
+  using Clock = std::chrono::steady_clock;
+  /// Identifies a section of the profiler
+  using Section = std::size_t;
+
+  /**
+   * Measures the time from its construction to its destruction for a section.
+   */
+  class Scope {
+   public:
+    /**
+     * Start measuring.
+     *
+     * \param[in] profiler The profiler, nothing is measured if it is disabled.
+     * \param[in] section The section for which the time is measured.
+     * \param[in] ensemble The ensemble of the span in the trace, -1 for none.
+     */
+    Scope(Profiler &profiler, Section section, int ensemble = -1)
+        : profiler_(profiler.enabled_ ? &profiler : nullptr),
+          section_(section),
+          ensemble_(ensemble) {
+      if (profiler_) {
+        if (profiler_->count_hardware_) {
+          HardwareCounters::read(start_counts_);
+        }
+        start_ = Clock::now();
+      }
+    }
+    /// Cannot be copied
+    Scope(const Scope &) = delete;
+    /// Cannot be copied
+    Scope &operator=(const Scope &) = delete;
+    /// Add the time since the construction to the section and the trace.
+    ~Scope() {
+      if (profiler_) {
+        const Clock::time_point end = Clock::now();
+        if (profiler_->count_hardware_) {
+          HardwareCounters::Counts counts;
+          HardwareCounters::read(counts);
+          for (std::size_t i = 0; i < counts.size(); i++) {
+            counts[i] -= start_counts_[i];
+          }
+          profiler_->add_counts(section_, counts);
+        }
+        profiler_->add(section_, end - start_);
+        if (profiler_->trace_) {
+          profiler_->trace_->record(profiler_->entries_[section_].name, start_,
+                                    end, ensemble_);
+        }
+      }
+    }
+
+    /**
+     * Count the time for another section, e.g. once it is known which kind of
+     * work is measured.
+     *
+     * \param[in] section The section for which the time is measured.
+     */
+    void reassign(Section section) { section_ = section; }
+
+   private:
+    /// The profiler, if it is enabled
+    Profiler *profiler_;
+    /// The section for which the time is measured
+    Section section_;
+    /// The ensemble of the span in the trace
+    int ensemble_;
+    /// The start of the measurement
+    Clock::time_point start_;
+    /// The hardware counters at the start of the measurement
+    HardwareCounters::Counts start_counts_;
+  };
+
+  /// \param[in] enabled Whether any time is measured.
+  explicit Profiler(bool enabled = false) : enabled_(enabled) {}
+
+  /// \return Whether any time is measured.
+  bool enabled() const { return enabled_; }
+
+  /// Start measuring, which must not be done while a Scope lives.
+  void enable() { enabled_ = true; }
+
+  /**
+   * Count the hardware events of the sections as well, which enables the
+   * profiler. This must not be done while a Scope lives.
+   *
+   * \return Whether any hardware event can be counted by the calling thread.
+   *         Otherwise, only the times are measured.
+   */
+  bool count_hardware_events();
+
+  /**
+   * Record the measured spans in a trace as well, which enables the profiler.
+   * This must not be done while a Scope lives.
+   *
+   * \param[in] trace The trace, which has to outlive the profiler.
+   */
+  void record_to(TraceRecorder *trace) {
+    trace_ = trace;
+    enabled_ = true;
+  }
+
+  /**
+   * Find a section by its name, or add it. This must not be called while a
+   * time is measured.
+   *
+   * \param[in] name The name of the section in the reports.
+   * \return The section.
+   */
+  Section section(const std::string &name);
+
+  /**
+   * \param[in] section The section to be measured.
+   * \param[in] ensemble The ensemble of the span in the trace, -1 for none.
+   * \return The scope measuring the section until it is destroyed.
+   */
+  Scope measure(Section section, int ensemble = -1) {
+    return Scope(*this, section, ensemble);
+  }
+
+  /**
+   * Add a time to a section. This may be called from several threads at once.
+   *
+   * \param[in] section The section.
+   * \param[in] duration The time spent in it.
+   */
+  void add(Section section, Clock::duration duration);
+
+  /**
+   * Add counts of the hardware events to a section. This may be called from
+   * several threads at once.
+   *
+   * \param[in] section The section.
+   * \param[in] counts The counts of the events in it.
+   */
+  void add_counts(Section section, const HardwareCounters::Counts &counts);
+
+  /// Reset the times of the event and start measuring its wall time.
+  void start_event();
+
+  /**
+   * Add the times of the event to the totals.
+   *
+   * \return The report of the event.
+   */
+  std::string finish_event();
+
+  /**
+   * Add the totals of another profiler, e.g. the one of a concurrent event.
+   * Its sections are matched by name, missing ones are added.
+   *
+   * \param[in] other The other profiler.
+   */
+  void add_totals(const Profiler &other);
+
+  /// \return The report of all events finished so far.
+  std::string total_report() const;
+
+  /// The time measured for a section
+  struct Total {
+    /// The name of the section
+    std::string name;
+    /// Time spent in the section [s]
+    double seconds;
+    /// Number of measurements of the section
+    int64_t calls;
+    /**
+     * The names and counts of the hardware events in the section, empty
+     * unless they are counted
+     */
+    std::vector<std::pair<std::string, int64_t>> counts{};
+  };
+
+  /**
+   * \return The sections measured in the finished events, ordered by their
+   *         times as in total_report().
+   */
+  std::vector<Total> totals() const;
+
+  /**
+   * \return The sections measured in the current event so far, ordered by
+   *         their times.
+   */
+  std::vector<Total> event_totals() const;
+
+  /**
+   * \param[in] section The section.
+   * \return Time spent in the section in the current event so far [s].
+   */
+  double event_time(Section section) const {
+    return 1e-9 * entries_[section].event_ns.load(std::memory_order_relaxed);
+  }
+
+  /// \return Wall time of the current event so far [s].
+  double event_wall_time() const {
+    return std::chrono::duration<double>(Clock::now() - event_start_).count();
+  }
+
+  /// \return Wall time of the finished events [s].
+  double total_wall_time() const { return 1e-9 * total_wall_ns_; }
+
+  /// \return Number of finished events.
+  int64_t n_events() const { return n_events_; }
+
+ private:
+  /// The times measured for a section
+  struct Entry {
+    /**
+     * \param[in] section_name The name of the section.
+     */
+    explicit Entry(std::string section_name) : name(std::move(section_name)) {}
+    /// The name of the section
+    std::string name;
+    /// Nanoseconds spent in the section during the current event
+    std::atomic<int64_t> event_ns{0};
+    /// Number of measurements of the section during the current event
+    std::atomic<int64_t> event_calls{0};
+    /// Counts of the hardware events during the current event
+    std::array<std::atomic<int64_t>, HardwareCounters::NEvents> event_counts{};
+    /// Nanoseconds spent in the section during the finished events
+    int64_t total_ns = 0;
+    /// Number of measurements of the section during the finished events
+    int64_t total_calls = 0;
+    /// Counts of the hardware events during the finished events
+    HardwareCounters::Counts total_counts{};
+  };
+
+  /**
+   * \param[in] title The title of the report.
+   * \param[in] wall_ns The wall time, to which the times are compared [ns].
+   * \param[in] times Nanoseconds spent in every section.
+   * \param[in] calls Number of measurements of every section.
+   * \return The sections with any measurement, ordered by their times.
+   */
+  std::string report(const std::string &title, int64_t wall_ns,
+                     const std::deque<int64_t> &times,
+                     const std::deque<int64_t> &calls) const;
+
+  /**
+   * \param[in] times Nanoseconds spent in every section.
+   * \param[in] calls Number of measurements of every section.
+   * \param[in] counts Counts of the hardware events of every section.
+   * \return The times of the sections with any measurement, ordered by them.
+   */
+  std::vector<Total> list(const std::deque<int64_t> &times,
+                          const std::deque<int64_t> &calls,
+                          const std::deque<HardwareCounters::Counts> &counts)
+      const;
+
+  /**
+   * \param[in] times Nanoseconds spent in every section.
+   * \param[in] calls Number of measurements of every section.
+   * \return The sections with any measurement, ordered by their times.
+   */
+  std::vector<Section> measured_sections(
+      const std::deque<int64_t> &times,
+      const std::deque<int64_t> &calls) const;
+
+  /// Whether any time is measured
+  bool enabled_;
+  /// Whether the hardware events are counted
+  bool count_hardware_ = false;
+  /// Which hardware events are counted
+  std::array<bool, HardwareCounters::NEvents> counted_events_{};
+  /// The trace recording the spans, if any
+  TraceRecorder *trace_ = nullptr;
+  /// The sections, which keep their addresses when sections are added
+  std::deque<Entry> entries_;
+  /// The start of the current event
+  Clock::time_point event_start_ = Clock::now();
+  /// Wall time of the finished events [ns]
+  int64_t total_wall_ns_ = 0;
+  /// Number of finished events
+  int64_t n_events_ = 0;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_PROFILER_H_
@@ -14,6 +14,7 @@
 #include "lattice.h"
 #include "particles.h"
 #include "potentials.h"
+#include "threadpool.h"
 
 namespace smash {
 
@@ -72,6 +73,20 @@ double calc_hubble(double time, const ExpansionProperties &metric);
 double propagate_straight_line(Particles *particles, double to_time,
                                const std::vector<FourVector> &beam_momentum);
 
+/**
+ * Propagates the position of a single particle on a straight line to a given
+ * moment, like the particles in
+ * propagate_straight_line(Particles *, double, const std::vector<FourVector> &).
+ *
+ * \param[inout] data The particle
+ * \param[in] to_time final time, not before the time of the particle [fm]
+ * \param[in] beam_momentum The beam momenta of the initial nucleons, if
+ *            "frozen Fermi motion" is on. [GeV]
+ * \return The time interval of the propagation.
+ */
+double propagate_straight_line(ParticleData *data, double to_time,
+                               const std::vector<FourVector> &beam_momentum);
+
 void backpropagate_straight_line(Particles *particles, double to_time);
 
 /**
@@ -103,13 +118,18 @@ void expand_space_time(Particles *particles,
  *            components of the symmetry force
  * \param[in] EM_lat Lattice for the electric and magnetic field
  * \param[in] jB_lat Lattice of the net baryon density
+ * \param[in] thread_pool Threads used to update the particles concurrently, if
+ *            not null. The particles of all ensembles are split into one chunk
+ *            per thread, the result is the same as for the serial update.
+ * \return The smallest time scale \f$E/|\mathbf{F}|\f$ of the momentum change
+ *         of the particles [fm], infinite if no particle is affected.
  */
-void update_momenta(
+double update_momenta(
     std::vector<Particles> &particles, double dt, const Potentials &pot,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FB_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FI3_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *EM_lat,
-    DensityLattice *jB_lat);
+    DensityLattice *jB_lat, ThreadPool *thread_pool = nullptr);
 
 }  // namespace smash
 #endif  // SRC_INCLUDE_SMASH_PROPAGATION_H_
@@ -225,6 +225,23 @@ class QuantumNumbers {
             baryon_number_ - rhs.baryon_number_};
   }
 
+  /**
+   * Add another set of QuantumNumbers entry-wise, e.g. the change of the
+   * conserved quantities by an action.
+   * \param rhs Right-hand side.
+   * \return This collection after the addition.
+   */
+  QuantumNumbers& operator+=(const QuantumNumbers& rhs) {
+    momentum_ += rhs.momentum_;
+    charge_ += rhs.charge_;
+    isospin3_ += rhs.isospin3_;
+    strangeness_ += rhs.strangeness_;
+    charmness_ += rhs.charmness_;
+    bottomness_ += rhs.bottomness_;
+    baryon_number_ += rhs.baryon_number_;
+    return *this;
+  }
+
   /**
    * Checks if the current particle list has still the same values and
    * reports about differences.
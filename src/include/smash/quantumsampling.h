@@ -11,6 +11,7 @@
 #define SRC_INCLUDE_SMASH_QUANTUMSAMPLING_H_
 
 #include <map>
+#include <vector>
 
 #include "gsl/gsl_multiroots.h"
 #include "gsl/gsl_vector.h"
@@ -37,9 +38,12 @@ class QuantumSampling {
    * \param[in] volume volume V in which the particles are sampled [fm^3],
    *            needed to calculate the density of the species
    * \param[in] temperature temperature T of the system [GeV]
+   * \param[in] tabulate Whether the momenta are sampled from tabulated
+   *            inverse cumulative distributions instead of by rejection
+   *            sampling, see sample().
    */
   QuantumSampling(const std::map<PdgCode, int>& initial_multiplicities,
-                  double volume, double temperature);
+                  double volume, double temperature, bool tabulate = false);
 
   /**
    * Struct object that holds the parameters relevant to finding the momentum
@@ -145,17 +149,41 @@ class QuantumSampling {
 
   /**
    * Sampling radial momenta of given particle species from Boltzmann, Bose, or
-   * Fermi distribution. This sampler uses the simplest rejection sampling.
+   * Fermi distribution. This sampler uses the simplest rejection sampling,
+   * unless the distributions are tabulated. Then the momentum is interpolated
+   * linearly between the tabulated quantiles, which takes one random number
+   * and no loop.
    * \param[in] pdg the pdg code of the sampled particle species
    * return the sampled momentum [GeV]
    */
   double sample(const PdgCode pdg);
 
  private:
+  /// Largest sampled momentum [GeV]
+  static constexpr double maximum_momentum_ = 10.0;
+  /// Number of momentum intervals on which the distributions are integrated
+  static constexpr size_t n_momentum_intervals_ = 20000;
+  /// Number of equally probable intervals between the tabulated quantiles
+  static constexpr size_t n_quantiles_ = 2000;
+  /**
+   * Tabulate the quantiles of the momentum distribution of a species.
+   * \param[in] mass (pole) mass m of the particle species [GeV]
+   * \param[in] effective_chemical_potential effective chemical potential mu of
+   *            the system [GeV]
+   * \param[in] statistics quantum statistics of the particles species
+   *            (+1 for Fermi, -1 for Bose, 0 for Boltzmann)
+   * \return The momenta [GeV] below which the fractions 0, 1/n_quantiles_,
+   *         ..., 1 of the particles are.
+   */
+  std::vector<double> tabulate_quantiles(double mass,
+                                         double effective_chemical_potential,
+                                         double statistics) const;
   /// Tabulated effective chemical potentials for every particle species
   std::map<PdgCode, double> effective_chemical_potentials_;
   /// Tabulated distribution function maxima for every particle species
   std::map<PdgCode, double> distribution_function_maximums_;
+  /// Tabulated quantiles of the momenta for every particle species, if any
+  std::map<PdgCode, std::vector<double>> momentum_quantiles_;
   /// Volume [fm^3] in which particles sre sampled
   const double volume_;
   /// Temperature [GeV]
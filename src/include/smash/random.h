@@ -10,9 +10,12 @@
 #ifndef SRC_INCLUDE_SMASH_RANDOM_H_
 #define SRC_INCLUDE_SMASH_RANDOM_H_
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <limits>
 #include <random>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -26,8 +29,82 @@ namespace random {
 /// The random number engine used is the Mersenne Twister.
 using Engine = std::mt19937_64;
 
-/// The engine that is used commonly by all distributions.
-extern /*thread_local (see #3075)*/ Engine engine;
+/**
+ * The engine that is used commonly by all distributions.
+ *
+ * Every thread has its own engine. Tasks which may run on any thread, like
+ * the evolution of one of the parallel ensembles, should use an engine created
+ * with make_stream() and install it with a ScopedEngine, such that their
+ * random numbers do not depend on the thread executing them.
+ */
+extern thread_local Engine engine;
+
+/// Identifies the kind of task using an independent random number stream.
+enum class StreamKind : uint32_t {
+  /// Evolution of one of the parallel ensembles of an event
+  Ensemble = 0,
+  /// Search for actions in one row of cells of the grid
+  GridRow = 1,
+  /// Placement of the particles of one species by the thermalizer
+  ThermalizerSpecies = 2,
+  /// Generation of one batch of pre-generated nuclear configurations
+  NuclearConfigurations = 3,
+  /// Sampling of the initial particles of one species in a box or sphere
+  InitialSpecies = 4,
+  /// Continuation of one of the forks of an event from its snapshot
+  Fork = 5,
+  /// Final state of one of the actions at the end of an event
+  FinalAction = 6,
+};
+
+/**
+ * Create the engine of an independent random number stream.
+ *
+ * A stream is identified by a seed, e.g. the seed of the event, and by the
+ * kind and the index of the task using it. The complete state of the engine is
+ * filled from these values via std::seed_seq, such that streams with different
+ * identifiers are statistically independent, while the same identifiers always
+ * yield the same random numbers, no matter on which thread and in which order
+ * the streams are used.
+ *
+ * \param[in] seed The seed from which all streams of a kind are derived.
+ * \param[in] kind The kind of task using the stream.
+ * \param[in] index The index of the task, e.g. the index of the ensemble.
+ * \return The engine of the stream.
+ */
+Engine make_stream(uint64_t seed, StreamKind kind, uint64_t index);
+
+/**
+ * Installs an engine as the engine of the calling thread for the lifetime of
+ * this object.
+ *
+ * The engine of the thread is swapped with the given one on construction and
+ * swapped back on destruction. Hence, the given engine has advanced by the
+ * drawn random numbers afterwards, and it can be installed again to continue
+ * the stream later on.
+ */
+class ScopedEngine {
+ public:
+  /**
+   * Install the given engine.
+   *
+   * \param[in,out] stream The engine to be used by the calling thread. It has
+   *                       to outlive this object.
+   */
+  explicit ScopedEngine(Engine &stream) : stream_(stream) {
+    std::swap(engine, stream_);
+  }
+  /// Cannot be copied
+  ScopedEngine(const ScopedEngine &) = delete;
+  /// Cannot be copied
+  ScopedEngine &operator=(const ScopedEngine &) = delete;
+  /// Restore the previous engine of the calling thread.
+  ~ScopedEngine() { std::swap(engine, stream_); }
+
+ private:
+  /// The installed engine, holding the previous one while installed
+  Engine &stream_;
+};
 
 /** Provides uniform random numbers on a fixed interval.
  *
@@ -164,18 +241,17 @@ T exponential(T lambda) {
  */
 template <typename T = double>
 T expo(T A, T x1, T x2) {
-  const T a1 = A * x1, a2 = A * x2;
-  const T a_min = std::log(std::numeric_limits<T>::min());
 #ifndef NDEBUG
-  assert(A > T(0.) && x1 >= x2 && a1 > a_min);
+  assert(A > T(0.) && x1 >= x2);
 #endif
-  const T r1 = std::exp(a1);
-  const T r2 = a2 > a_min ? std::exp(a2) : T(0.);  // prevent underflow
+  /* The cumulative distribution is inverted relative to x1, which takes a
+   * single exponential and cannot underflow for large A * (x1 - x2). */
+  const T range = std::expm1(A * (x2 - x1));
   T x;
   do {
     /* sample repeatedly until x is in the requested range
      * (it can get outside due to numerical errors, see issue #2959) */
-    x = std::log(uniform(r1, r2)) / A;
+    x = x1 + std::log1p(canonical<T>() * range) / A;
   } while (!(x <= x1 && x > x2));
   return x;
 }
@@ -290,6 +366,84 @@ class discrete_dist {
   std::discrete_distribution<> distribution;
 };
 
+/**
+ * Discrete distribution sampled by Walker's alias method.
+ *
+ * Setting up the distribution takes a time linear in the number of weights,
+ * but afterwards every sample takes a constant time and a single random
+ * number, independently of the number of weights. It is therefore preferable
+ * to discrete_dist, if the same weights are sampled many times.
+ */
+class alias_dist {
+ public:
+  /** Default alias distribution.
+   *
+   * Always draws 0.
+   */
+  alias_dist() : alias_dist(std::vector<double>{1.0}) {}
+
+  /** Construct from weight vector.
+   * \param weights Non-negative weights, P(i) is proportional to weights[i].
+   * \throws std::invalid_argument if no weight is positive.
+   */
+  explicit alias_dist(const std::vector<double> &weights)
+      : threshold_(weights.size()), alias_(weights.size()) {
+    const std::size_t n = weights.size();
+    double total = 0.;
+    for (double w : weights) {
+      total += w;
+    }
+    if (!(total > 0.)) {
+      throw std::invalid_argument("alias_dist needs a positive weight.");
+    }
+    /* Vose's construction: every column is filled up to the average weight,
+     * the missing part is taken from a column with more than average. */
+    std::vector<std::size_t> small, large;
+    for (std::size_t i = 0; i < n; i++) {
+      threshold_[i] = weights[i] * n / total;
+      alias_[i] = i;
+      (threshold_[i] < 1. ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+      const std::size_t s = small.back();
+      const std::size_t l = large.back();
+      small.pop_back();
+      alias_[s] = l;
+      threshold_[l] -= 1. - threshold_[s];
+      if (threshold_[l] < 1.) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+    // What is left over differs from 1 only by rounding
+    for (std::size_t i : large) {
+      threshold_[i] = 1.;
+    }
+    for (std::size_t i : small) {
+      threshold_[i] = 1.;
+    }
+  }
+
+  /** Draw a random number from the alias distribution.
+   * \return Sampled value
+   */
+  int operator()() const {
+    const double u = canonical() * threshold_.size();
+    const std::size_t i =
+        std::min(static_cast<std::size_t>(u), threshold_.size() - 1);
+    return static_cast<int>(u - i < threshold_[i] ? i : alias_[i]);
+  }
+
+  /// \return The number of possible values.
+  std::size_t size() const { return threshold_.size(); }
+
+ private:
+  /** Probability of drawing a column itself instead of its alias */
+  std::vector<double> threshold_;
+  /** The alias of every column */
+  std::vector<std::size_t> alias_;
+};
+
 /**
  * Draws a random number from a Cauchy distribution (sometimes also called
  * Lorentz or non-relativistic Breit-Wigner distribution) with the given
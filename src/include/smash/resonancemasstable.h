@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_RESONANCEMASSTABLE_H_
+#define SRC_INCLUDE_SMASH_RESONANCEMASSTABLE_H_
+
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <tuple>
+#include <vector>
+
+#include "particletype.h"
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * \brief Inverse cumulative distribution of the mass of a resonance, which is
+ * produced together with a stable particle
+ *
+ * The masses of the resonance are distributed like the spectral function
+ * times the phase space of the final state,
+ * \f[ A(m) \, p_{cm} \, B_L^2(p_{cm}) \f]
+ * between the minimal mass of the spectral function and \f$\sqrt{s}\f$ minus
+ * the mass of the stable particle. ParticleType::sample_resonance_mass samples
+ * this by rejection. Here the quantiles of the distribution are tabulated at
+ * equidistant values of \f$\sqrt{s}\f$ instead, in units of the allowed mass
+ * range, such that a mass is drawn with a single random number by
+ * interpolating the quantiles linearly in the probability and in
+ * \f$\sqrt{s}\f$. The sampled masses are hence distributed only
+ * approximately like the exact distribution.
+ *
+ * The tables are created when they are first needed and are shared by all
+ * threads.
+ */
+class ResonanceMassTable {
+ public:
+  /**
+   * Tabulate the quantiles of the mass distribution.
+   *
+   * \param[in] resonance Type of the resonance.
+   * \param[in] mass_stable Mass of the stable particle.
+   * \param[in] L Relative angular momentum of the final-state particles.
+   * \param[in] n_sqrts Number of tabulated values of \f$\sqrt{s}\f$, from
+   *            the threshold up to the pole mass plus ten widths plus the
+   *            mass of the stable particle.
+   * \param[in] n_quantiles Number of tabulated quantiles minus one.
+   */
+  ResonanceMassTable(const ParticleType &resonance, double mass_stable, int L,
+                     int n_sqrts = 100, int n_quantiles = 256);
+
+  /**
+   * \param[in] cms_energy The center-of-mass energy of the final state.
+   * \return A sampled mass of the resonance, or NaN if no distribution is
+   *         tabulated at \p cms_energy.
+   */
+  double sample(double cms_energy) const;
+
+  /**
+   * \param[in] resonance Type of the resonance.
+   * \param[in] mass_stable Mass of the stable particle.
+   * \param[in] L Relative angular momentum of the final-state particles.
+   * \return The table of the given final state, which is created if it does
+   *         not exist yet.
+   */
+  static const ResonanceMassTable &find(const ParticleType &resonance,
+                                        double mass_stable, int L);
+
+ private:
+  /// Mass of the stable particle
+  double mass_stable_;
+  /// Smallest mass of the resonance
+  double m_min_;
+  /// First tabulated value of \f$\sqrt{s}\f$
+  double sqrts_min_;
+  /// Inverse distance of the tabulated values of \f$\sqrt{s}\f$
+  double inv_dsqrts_;
+  /// Number of tabulated values of \f$\sqrt{s}\f$
+  int n_sqrts_;
+  /// Number of tabulated quantiles minus one
+  int n_quantiles_;
+  /**
+   * The quantiles in units of the allowed mass range for all values of
+   * \f$\sqrt{s}\f$, NaN where the distribution vanishes.
+   */
+  std::vector<double> quantiles_;
+
+  /// Identifies a table by the resonance, the stable mass and L
+  using Key = std::tuple<const ParticleType *, double, int>;
+  /// All tables created so far
+  static std::map<Key, std::unique_ptr<const ResonanceMassTable>> tables_;
+  /// Protects the creation of tables
+  static std::shared_mutex tables_mutex_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_RESONANCEMASSTABLE_H_
@@ -11,9 +11,14 @@
 #ifndef SRC_INCLUDE_SMASH_RIVETOUTPUT_H_
 #define SRC_INCLUDE_SMASH_RIVETOUTPUT_H_
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 
 #include "Rivet/AnalysisHandler.hh"
@@ -32,6 +37,11 @@ namespace smash {
  * as compared to writing the HepMC event to disk or pipe and then decoding
  * in Rivet.
  *
+ * With a positive queue size, copies of the converted events are analysed by
+ * a worker thread in the order of the events, while the simulation of the
+ * next events continues. The Rivet handler is only used by this thread once it
+ * is started, and the results are written after it is joined.
+ *
  * More details of the output format can be found in the User Guide.
  */
 class RivetOutput : public HepMcInterface {
@@ -44,6 +54,7 @@ class RivetOutput : public HepMcInterface {
    * \param[in] full_event Whether the full event or only final-state particles
    *                       are printed in the output
    * \param[in] rivet_par Rivet parameters from SMASH configuration
+   * \throw std::invalid_argument if the queue size is negative.
    */
   RivetOutput(const std::filesystem::path& path, std::string name,
               const bool full_event, const RivetOutputParameters& rivet_par);
@@ -58,6 +69,7 @@ class RivetOutput : public HepMcInterface {
    * \param[in] particles Current list of particles.
    * \param[in] event_label Event/ensemble numbers
    * \param[in] event Event info, see \ref event_info
+   * \throw Rethrows an exception of an earlier analysis on the worker thread.
    */
   void at_eventend(const Particles& particles, const EventLabel& event_label,
                    const EventInfo& event) override;
@@ -100,6 +112,19 @@ class RivetOutput : public HepMcInterface {
    */
   void setup(const RivetOutputParameters& params);
 
+  /**
+   * Let Rivet analyse an event, initialising it with the first one.
+   *
+   * \param[in] event The event.
+   */
+  void analyze(const HepMC3::GenEvent& event);
+
+  /**
+   * Loop of the worker thread, which analyses the queued events until the
+   * queue is empty and stop_ is set.
+   */
+  void analyze_queued_events();
+
   /**
    * A proxy object that wraps all Rivet::AnalysisHandler calls in an
    * environment where FP errors are disabled.
@@ -127,6 +152,20 @@ class RivetOutput : public HepMcInterface {
   std::filesystem::path filename_;
   /** Whether we need initialisation */
   bool need_init_;
+  /** Maximum number of queued events, 0 if the events are analysed at once */
+  const std::size_t queue_size_;
+  /** Events waiting for the analyses, in the order of the events */
+  std::deque<std::unique_ptr<HepMC3::GenEvent>> queue_;
+  /** Mutex protecting queue_, stop_ and worker_exception_ */
+  std::mutex mutex_;
+  /** Signals that an event was added to or taken from the queue */
+  std::condition_variable queue_changed_;
+  /** Whether the worker thread shall stop once the queue is empty */
+  bool stop_ = false;
+  /** Exception thrown by an analysis on the worker thread */
+  std::exception_ptr worker_exception_ = nullptr;
+  /** Thread analysing the queued events, if queue_size_ is positive */
+  std::thread worker_;
 };
 
 }  // namespace smash
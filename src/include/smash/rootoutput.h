@@ -10,6 +10,7 @@
 #ifndef SRC_INCLUDE_SMASH_ROOTOUTPUT_H_
 #define SRC_INCLUDE_SMASH_ROOTOUTPUT_H_
 
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -97,6 +98,23 @@ class RootOutput : public OutputInterface {
    */
   void at_interaction(const Action &action, const double density) override;
 
+  /**
+   * \return The memory of the per-particle buffers filling the trees, without
+   * the buffers of the trees kept by ROOT [bytes].
+   */
+  std::size_t memory_usage() const override;
+
+  /**
+   * \return The event and intermediate time hooks, and the interaction hooks
+   *         if collisions or initial conditions are written.
+   */
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet()
+        .set(EventHooks)
+        .set(IntermediateTimeHooks)
+        .set(InteractionHooks, write_collisions_ || write_initial_conditions_);
+  }
+
  private:
   /// Filename of output
   const std::filesystem::path filename_;
@@ -110,14 +128,14 @@ class RootOutput : public OutputInterface {
    * TFile takes ownership of all TTrees.
    * That's why TTree is not a unique pointer.
    */
-  TTree *particles_tree_;
+  TTree *particles_tree_ = nullptr;
   /**
    * TTree for collision output.
    *
    * TFile takes ownership of all TTrees.
    * That's why TTree is not a unique pointer.
    */
-  TTree *collisions_tree_;
+  TTree *collisions_tree_ = nullptr;
   /**
    * Writes particles to a tree defined by treename.
    * \param[in] particles Particles or ParticleList to be written to output.
@@ -142,12 +160,11 @@ class RootOutput : public OutputInterface {
   int current_ensemble_ = 0;
 
   /**
-   * Maximal buffer size.
-   * When the number of particles N exceeds the buffer size B, data is flushed
-   * to the ROOT file every B particles. This creates ceil(N/B) entries in the
-   * ROOT Tree at every output.
+   * Initial size of the per-particle buffers. The buffers grow when a block
+   * with more particles is written, such that every output block is one entry
+   * of the ROOT Tree.
    */
-  static const int max_buffer_size_;
+  static const int initial_buffer_size_;
 
   /** @name Buffer for filling TTree
    * See class documentation for definitions.
@@ -163,32 +180,30 @@ class RootOutput : public OutputInterface {
   double current_t_{};
   double impact_b_{};
   bool empty_event_{};
-  std::vector<int> id_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> pdgcode_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> charge_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<double> formation_time_ =
-      std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> time_last_collision_ =
-      std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> p0_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> px_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> py_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> pz_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> t_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> x_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> y_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<double> z_ = std::vector<double>(max_buffer_size_, 0.0);
+  std::vector<int> id_{};
+  std::vector<int> pdgcode_{};
+  std::vector<int> charge_{};
+  std::vector<double> formation_time_{};
+  std::vector<double> time_last_collision_{};
+  std::vector<double> p0_{};
+  std::vector<double> px_{};
+  std::vector<double> py_{};
+  std::vector<double> pz_{};
+  std::vector<double> t_{};
+  std::vector<double> x_{};
+  std::vector<double> y_{};
+  std::vector<double> z_{};
   double E_kinetic_tot_{};
   double E_fields_tot_{};
   double E_tot_{};
-  std::vector<int> coll_per_part_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<double> xsec_factor_ = std::vector<double>(max_buffer_size_, 0.0);
-  std::vector<int> proc_id_origin_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> proc_type_origin_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> pdg_mother1_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> pdg_mother2_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> baryon_number_ = std::vector<int>(max_buffer_size_, 0);
-  std::vector<int> strangeness_ = std::vector<int>(max_buffer_size_, 0);
+  std::vector<int> coll_per_part_{};
+  std::vector<double> xsec_factor_{};
+  std::vector<int> proc_id_origin_{};
+  std::vector<int> proc_type_origin_{};
+  std::vector<int> pdg_mother1_{};
+  std::vector<int> pdg_mother2_{};
+  std::vector<int> baryon_number_{};
+  std::vector<int> strangeness_{};
   int nin_{};
   int nout_{};
   double wgt_{};
@@ -227,12 +242,36 @@ class RootOutput : public OutputInterface {
   const bool coll_extended_;
   /// Whether extended ic output is on
   const bool ic_extended_;
+  /// Size of the baskets of every branch in bytes
+  const int basket_size_;
+  /// The autoflush setting of the trees, see TTree::SetAutoFlush
+  const int auto_flush_;
 
   /**
    * Basic initialization routine, creating the TTree objects
    * for particles and collisions.
    */
   void init_trees();
+
+  /**
+   * Call a function for every per-particle branch.
+   *
+   * \param[in] extended Whether to use the branches of the extended output
+   *            instead of the basic ones.
+   * \param[in] function Called with the name of the branch and its buffer,
+   *            which is a \c std::vector<int> or a \c std::vector<double>.
+   */
+  template <typename F>
+  void for_each_particle_buffer(bool extended, F &&function);
+
+  /**
+   * Make sure that the per-particle buffers hold the given number of particles.
+   * If they have to grow, the branches of the trees are told their new
+   * addresses.
+   *
+   * \param[in] n_particles Number of particles to be written.
+   */
+  void ensure_buffer_size(std::size_t n_particles);
 };
 
 }  // namespace smash
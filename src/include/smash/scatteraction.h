@@ -84,7 +84,22 @@ class ScatterAction : public Action {
    *
    * \return  squared distance \f$d^2_\mathrm{coll}\f$.
    */
-  double transverse_distance_sqr() const;
+  double transverse_distance_sqr() const {
+    return transverse_distance_sqr(incoming_particles_[0],
+                                   incoming_particles_[1]);
+  }
+
+  /**
+   * Calculate the transverse distance of two particles in their local rest
+   * frame, without constructing an action for them.
+   * \see transverse_distance_sqr()
+   *
+   * \param[in] p_a First particle.
+   * \param[in] p_b Second particle.
+   * \return  squared distance \f$d^2_\mathrm{coll}\f$.
+   */
+  static double transverse_distance_sqr(const ParticleData &p_a,
+                                        const ParticleData &p_b);
 
   /**
    * Calculate the transverse distance of the two incoming particles in their
@@ -93,7 +108,22 @@ class ScatterAction : public Action {
    *
    * \return squared distance  \f$d^2_\mathrm{coll}\f$.
    */
-  double cov_transverse_distance_sqr() const;
+  double cov_transverse_distance_sqr() const {
+    return cov_transverse_distance_sqr(incoming_particles_[0],
+                                       incoming_particles_[1]);
+  }
+
+  /**
+   * Calculate the covariant transverse distance of two particles, without
+   * constructing an action for them.
+   * \see cov_transverse_distance_sqr()
+   *
+   * \param[in] p_a First particle.
+   * \param[in] p_b Second particle.
+   * \return squared distance  \f$d^2_\mathrm{coll}\f$.
+   */
+  static double cov_transverse_distance_sqr(const ParticleData &p_a,
+                                            const ParticleData &p_b);
   /**
    * Determine the Mandelstam s variable,
    *
@@ -150,6 +180,22 @@ class ScatterAction : public Action {
   void add_all_scatterings(
       const ScatterActionsFinderParameters& finder_parameters);
 
+  /**
+   * Add all possible scattering subprocesses only when the final state is
+   * generated, instead of right away. This is only possible if the total cross
+   * section is parametrized, since it is then enough to decide whether the
+   * action happens. Many of the found actions are never performed, because one
+   * of their incoming particles interacts earlier, and their subprocesses are
+   * never built.
+   *
+   * \param[in] finder_parameters parameters for collision finding. They have
+   *            to outlive the action.
+   * \throw std::logic_error if the total cross section is not parametrized or
+   *        the subprocesses were already added.
+   */
+  void add_all_scatterings_when_needed(
+      const ScatterActionsFinderParameters& finder_parameters);
+
   /**
    * Given the incoming particles, assigns the correct parametrization of the
    * total cross section.
@@ -165,6 +211,7 @@ class ScatterAction : public Action {
    * \return list of possible collision channels.
    */
   const CollisionBranchList& collision_channels() {
+    add_deferred_scatterings();
     return collision_channels_;
   }
 
@@ -245,8 +292,12 @@ class ScatterAction : public Action {
   /// Perform an inelastic two-to-many-body scattering (more than 2)
   void two_to_many_scattering();
 
-  /// Creates the final states for string-processes after they are performed
-  void create_string_final_state();
+  /**
+   * Creates the final states for string-processes after they are performed
+   *
+   * \param[in] string_process The instance which performed the process.
+   */
+  void create_string_final_state(const StringProcess &string_process);
   /**
    * Todo(ryu): document better - it is not really UrQMD-based, isn't it?
    * Perform the UrQMD-based string excitation and decay
@@ -340,6 +391,15 @@ class ScatterAction : public Action {
   /// Lock for calling add_all_scatterings only once
   bool were_processes_added_ = false;
 
+  /**
+   * Parameters for collision finding, if the subprocesses are to be added
+   * when they are needed, and nullptr otherwise.
+   */
+  const ScatterActionsFinderParameters* deferred_finder_parameters_ = nullptr;
+
+  /// Add the subprocesses if this was deferred.
+  void add_deferred_scatterings();
+
   /// Warn about zero cross section only once per particle type pair
   static inline std::set<std::set<ParticleTypePtr>>
       warned_no_rescaling_available{};
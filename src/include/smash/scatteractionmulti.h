@@ -100,6 +100,16 @@ class ScatterActionMulti : public Action {
    */
   double calculate_I3(const double sqrts) const;
 
+  /**
+   * Look up the integral calculate_I3() in the ThreeBodyIntegralTable of the
+   * masses of the incoming particles, which is used for the reaction
+   * probabilities.
+   *
+   * \param[in] sqrts center of mass energy of incoming particles
+   * \return interpolated integral
+   */
+  double tabulated_I3(const double sqrts) const;
+
   /**
    * Calculate the parametrized 4-body relativistic phase space integral.
    *
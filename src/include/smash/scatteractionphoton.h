@@ -12,6 +12,7 @@
 
 #include <utility>
 
+#include "crosssectionsphoton.h"
 #include "scatteraction.h"
 
 namespace smash {
@@ -46,7 +47,9 @@ class ScatterActionPhoton : public ScatterAction {
                           SpinInteractionType::Off);
 
   /**
-   * Create the photon final state and write to output.
+   * Create the photon final states and write them to output, one after the
+   * other. The kinematics of the collision, which do not depend on the sampled
+   * photon, are computed only once for all fractional photons.
    *
    * \param[in] outputs List of all outputs. Does not have to be a specific
    *                     photon output, the function will take care of this.
@@ -183,7 +186,22 @@ class ScatterActionPhoton : public ScatterAction {
   static bool is_kinematically_possible(const double s_sqrt,
                                         const ParticleList &in);
 
+  /**
+   * Choose how the cross sections are computed. The tables have to be created
+   * by CrosssectionsPhoton<ComputationMethod::Lookup>::create_tables() before
+   * the first photon action is performed with them.
+   *
+   * \param[in] tabulated Whether the cross sections are interpolated in the
+   *                      tables instead of evaluating the analytic formulas.
+   */
+  static void set_tabulated_cross_sections(bool tabulated) {
+    tabulated_cross_sections_ = tabulated;
+  }
+
  private:
+  /// Whether the cross sections are interpolated in tables
+  static bool tabulated_cross_sections_;
+
   /**
    * Holds the photon branch. As of now, this will always
    * hold only one branch.
@@ -234,6 +252,46 @@ class ScatterActionPhoton : public ScatterAction {
   /// Type of spin interaction to use
   const SpinInteractionType spin_interaction_type_;
 
+  /// Kinematics of the collision shared by all its fractional photons
+  struct Kinematics {
+    /// Point at which the photon is created
+    FourVector middle_point;
+    /// Effective mass of the incoming pion [GeV]
+    double m1;
+    /// Effective mass of the other incoming particle [GeV]
+    double m2;
+    /// Mandelstam s [GeV^2]
+    double s;
+    /// Square root of Mandelstam s [GeV]
+    double sqrts;
+    /// Lower bound of the sampled Mandelstam t [GeV^2]
+    double t1;
+    /// Upper bound of the sampled Mandelstam t [GeV^2]
+    double t2;
+    /// Momentum of the incoming particles in the center of mass frame [GeV]
+    double pcm_in;
+    /// Momentum of the outgoing particles in the center of mass frame [GeV]
+    double pcm_out;
+    /// Boost from the center of mass frame to the computational frame
+    LorentzBoost to_computational_frame;
+  };
+
+  /**
+   * Compute the kinematics of the collision, after the outgoing particles
+   * have been created and the pion has been put first.
+   *
+   * \param[in] middle_point Point at which the photon is created.
+   * \return The kinematics shared by all fractional photons.
+   */
+  Kinematics kinematics(const FourVector &middle_point) const;
+
+  /**
+   * Sample the final state of one photon and its weight.
+   *
+   * \param[in] k The kinematics of the collision.
+   */
+  void sample_photon(const Kinematics &k);
+
   /**
    * Find the mass of the participating rho-particle.
    *
@@ -267,6 +325,17 @@ class ScatterActionPhoton : public ScatterAction {
    */
   double total_cross_section(MediatorType mediator = default_mediator_) const;
 
+  /**
+   * Calculate the total cross section of the photon process with the given
+   * computation method, see total_cross_section().
+   *
+   * \param[in] mediator Switch for determing which mediating particle to use
+   *
+   * \return Total cross section. [mb]
+   */
+  template <ComputationMethod method>
+  double total_cross_section_by(MediatorType mediator) const;
+
   /**
    * Compute the total cross corrected for form factors.
    *
@@ -292,6 +361,20 @@ class ScatterActionPhoton : public ScatterAction {
   double diff_cross_section(const double t, const double m_rho,
                             MediatorType mediator = default_mediator_) const;
 
+  /**
+   * Calculate the differential cross section of the photon process with the
+   * given computation method, see diff_cross_section().
+   *
+   * \param[in] t Mandelstam-t [GeV^2].
+   * \param[in] m_rho Mass of the incoming or outgoing rho-particle [GeV]
+   * \param[in] mediator Switch for determing which mediating particle to use
+   *
+   * \return Differential cross section. [mb/\f$GeV^2\f$]
+   */
+  template <ComputationMethod method>
+  double diff_cross_section_by(const double t, const double m_rho,
+                               MediatorType mediator) const;
+
   /**
    * Compute the differential cross section corrected for form factors
    *
@@ -10,15 +10,19 @@
 #ifndef SRC_INCLUDE_SMASH_SCATTERACTIONSFINDER_H_
 #define SRC_INCLUDE_SMASH_SCATTERACTIONSFINDER_H_
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <set>
 #include <vector>
 
 #include "action.h"
 #include "actionfinderfactory.h"
 #include "configuration.h"
+#include "crosssectioncache.h"
 #include "scatteraction.h"
 #include "scatteractionsfinderparameters.h"
+#include "workloadrecorder.h"
 
 namespace smash {
 
@@ -63,10 +67,64 @@ class ScatterActionsFinder : public ActionFinderInterface {
    *         to -1 if the two particles are not moving relative to each
    *         other.
    */
+  /**
+   * Momentum of a particle in the search for collisions with the geometric
+   * and covariant criteria. The initial nucleons are propagated with the beam
+   * momentum until they interact, if the Fermi motion is frozen.
+   *
+   * \param[in] data The particle.
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \return The beam momentum of an initial nucleon without prior
+   * interactions, the momentum of the particle otherwise.
+   * \throw std::runtime_error if the particle has a negative id
+   */
+  static const FourVector &search_momentum(
+      const ParticleData &data, const std::vector<FourVector> &beam_momentum) {
+    if (data.id() < 0) {
+      throw std::runtime_error("Invalid particle ID for Fermi motion");
+    }
+    const bool has_no_prior_interactions =
+        (static_cast<uint64_t>(data.id()) <                 // particle from
+         static_cast<uint64_t>(beam_momentum.size())) &&  // initial nucleus
+        (data.collisions_per_particle() == 0);
+    return has_no_prior_interactions ? beam_momentum[data.id()]
+                                     : data.momentum();
+  }
+
   inline double collision_time(
       const ParticleData &p1, const ParticleData &p2, double dt,
       const std::vector<FourVector> &beam_momentum) const {
-    if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic) {
+    switch (finder_parameters_.coll_crit) {
+      case CollisionCriterion::Geometric:
+        return collision_time_with<CollisionCriterion::Geometric>(
+            p1, p2, dt, beam_momentum);
+      case CollisionCriterion::Covariant:
+        return collision_time_with<CollisionCriterion::Covariant>(
+            p1, p2, dt, beam_momentum);
+      default:
+        return collision_time_with<CollisionCriterion::Stochastic>(
+            p1, p2, dt, beam_momentum);
+    }
+  }
+
+  /**
+   * Collision time of collision_time() for the given collision criterion.
+   *
+   * 	param Criterion The collision criterion of the run
+   * \param[in] p1 First incoming particle
+   * \param[in] p2 Second incoming particle
+   * \param[in] dt The maximum time interval at the current time step [fm]
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \return The time until the collision [fm], -1 if the two particles are
+   *         not moving relative to each other.
+   */
+  template <CollisionCriterion Criterion>
+  double collision_time_with(
+      const ParticleData &p1, const ParticleData &p2, double dt,
+      const std::vector<FourVector> &beam_momentum) const {
+    if constexpr (Criterion == CollisionCriterion::Stochastic) {
       return dt * random::uniform(0., 1.);
     } else {
       /*
@@ -76,26 +134,9 @@ class ScatterActionsFinder : public ActionFinderInterface {
        * corrected momentum. That is because the particles are propagated with
        * the beam momentum until they interact.
        */
-      if (p1.id() < 0 || p2.id() < 0) {
-        throw std::runtime_error("Invalid particle ID for Fermi motion");
-      }
-      const bool p1_has_no_prior_interactions =
-          (static_cast<uint64_t>(p1.id()) <                 // particle from
-           static_cast<uint64_t>(beam_momentum.size())) &&  // initial nucleus
-          (p1.get_history().collisions_per_particle == 0);
-
-      const bool p2_has_no_prior_interactions =
-          (static_cast<uint64_t>(p2.id()) <                 // particle from
-           static_cast<uint64_t>(beam_momentum.size())) &&  // initial nucleus
-          (p2.get_history().collisions_per_particle == 0);
-
-      const FourVector p1_mom = (p1_has_no_prior_interactions)
-                                    ? beam_momentum[p1.id()]
-                                    : p1.momentum();
-      const FourVector p2_mom = (p2_has_no_prior_interactions)
-                                    ? beam_momentum[p2.id()]
-                                    : p2.momentum();
-      if (finder_parameters_.coll_crit == CollisionCriterion::Covariant) {
+      const FourVector p1_mom = search_momentum(p1, beam_momentum);
+      const FourVector p2_mom = search_momentum(p2, beam_momentum);
+      if constexpr (Criterion == CollisionCriterion::Covariant) {
         /**
          * JAM collision times from the closest approach
          * in the two-particle center-of-mass-framem,
@@ -157,7 +198,7 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * \return A list of possible scatter actions
    */
   ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, const double gcell_vol,
+      ParticleSpan search_list, double dt, const double gcell_vol,
       const std::vector<FourVector> &beam_momentum) const override;
 
   /**
@@ -173,9 +214,25 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * \return A list of possible scatter actions
    */
   ActionList find_actions_with_neighbors(
-      const ParticleList &search_list, const ParticleList &neighbors_list,
+      ParticleSpan search_list, ParticleSpan neighbors_list,
       double dt, const std::vector<FourVector> &beam_momentum) const override;
 
+  /**
+   * Search for the collisions of all visits of the cells of a grid tile.
+   *
+   * With the geometric criterion, the kinematics of every cell of the tile
+   * are stored component-wise in single precision, see
+   * append_geometric_collisions(), when the cell is first paired with a
+   * search cell. Hence, they are computed once per tile instead of once for
+   * every pair of cells. The found actions are the same as with
+   * find_actions_in_cell() and find_actions_with_neighbors().
+   *
+   * \copydetails ActionFinderInterface::find_actions_in_tile
+   */
+  void find_actions_in_tile(const CellTile &tile, double dt, double gcell_vol,
+                            const std::vector<FourVector> &beam_momentum,
+                            std::vector<ActionList> &found) const override;
+
   /**
    * Search for all the possible secondary collisions between the outgoing
    * particles and the rest.
@@ -191,9 +248,32 @@ class ScatterActionsFinder : public ActionFinderInterface {
       const ParticleList &search_list, const Particles &surrounding_list,
       double dt, const std::vector<FourVector> &beam_momentum) const override;
 
+  /**
+   * Search for all the possible secondary collisions between the outgoing
+   * particles and the given surrounding particles.
+   *
+   * The same collisions as with the whole particle list are found, as long as
+   * \p surrounding_list contains all particles which can collide with the
+   * ones in \p search_list, in the order in which they are stored.
+   *
+   * \param[in] search_list A list of particles within the current cell
+   * \param[in] surrounding_list The potential collision partners
+   * \param[in] dt The maximum time interval at the current time step [fm]
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \return A list of possible scatter actions
+   */
+  ActionList find_actions_with_surrounding_particles(
+      const ParticleList &search_list,
+      const std::vector<const ParticleData *> &surrounding_list, double dt,
+      const std::vector<FourVector> &beam_momentum) const override;
+
   /// No scatterings should be found when the event is over.
   ActionList find_final_actions(const Particles &) const override { return {}; }
 
+  /// \return The name of the finder in the time profile
+  std::string name() const override { return "scatter finder"; }
+
   /**
    * If there is only one particle sort, no decays
    * (only elastic scatterings are possible),
@@ -229,12 +309,41 @@ class ScatterActionsFinder : public ActionFinderInterface {
            testparticles * fm2_mb * M_1_PI;
   }
 
+  /**
+   * Estimate the maximal distance over which the given particles of one
+   * ensemble can interact from above, with the largest cross section of the
+   * pairs of types present, see \ref key_CT_dynamic_cell_size_
+   * "Dynamic_Cell_Size".
+   *
+   * \param[in] particles The particles of the ensemble.
+   * \return Maximal transverse distance squared [fm\f$^{2}\f$]. It is
+   *         never larger than max_transverse_distance_sqr(int) and equal to
+   *         it if the dynamic cell size is disabled or the cross sections of
+   *         the particles cannot be estimated from the cache.
+   */
+  double max_transverse_distance_sqr(const Particles &particles) const;
+
+  /// \return Whether the cells of the grid are sized from the particles.
+  bool dynamic_cell_size() const { return dynamic_cell_size_; }
+
   /**
    * Prints out all the 2-> n (n > 1) reactions with non-zero cross-sections
    * between all possible pairs of particle types.
    */
   void dump_reactions() const;
 
+  /**
+   * Tabulate the total cross sections of all pairs of stable hadrons in the
+   * cross section cache and write the tables to a file, which can be read
+   * by later runs, see CrossSectionCache::read().
+   *
+   * \param[in] file The file.
+   * \param[in] pool The threads sharing the pairs, or nullptr.
+   * \throw std::logic_error if the cross section cache is not enabled.
+   */
+  void dump_cross_section_table(const std::filesystem::path &file,
+                                ThreadPool *pool);
+
   /**
    * Print out partial cross-sections of all processes that can occur in
    * the collision of a(mass = m_a) and b(mass = m_b).
@@ -265,6 +374,31 @@ class ScatterActionsFinder : public ActionFinderInterface {
   }
 
  private:
+  /**
+   * \param[in] p1 A particle.
+   * \param[in] p2 Another particle.
+   * \return The translation of \p p2 to its periodic image closest to \p p1,
+   *         if the wall crossings of the box are lazy, else zero.
+   */
+  ThreeVector closest_image_shift(const ParticleData &p1,
+                                  const ParticleData &p2) const;
+
+  /**
+   * Check for collisions between one surrounding particle and all particles of
+   * the search list, unless it is part of the search list itself.
+   *
+   * \param[in] search_list A list of particles within the current cell
+   * \param[in] p2 A particle from the surrounding list
+   * \param[in] dt The maximum time interval at the current time step [fm]
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \param[out] actions The list to which the found actions are appended
+   */
+  void append_collisions_with_surrounding_particle(
+      const ParticleList &search_list, const ParticleData &p2, double dt,
+      const std::vector<FourVector> &beam_momentum,
+      ActionList &actions) const;
+
   /**
    * Check for a single pair of particles (id_a, id_b) if a collision will
    * happen in the next timestep and create a corresponding Action object
@@ -286,11 +420,292 @@ class ScatterActionsFinder : public ActionFinderInterface {
    *
    * Note: gcell_vol is optional, since only find_actions_in_cell has (and
    * needs) this information for the stochastic collision criterion.
+   *
+   * The checked pairs are passed to the WorkloadRecorder, if the workload of
+   * the run is recorded.
    */
   ActionPtr check_collision_two_part(
       const ParticleData &data_a, const ParticleData &data_b, double dt,
       const std::vector<FourVector> &beam_momentum = {},
-      const double gcell_vol = 0.0) const;
+      const double gcell_vol = 0.0) const {
+    if (WorkloadRecorder *recorder = WorkloadRecorder::active()) {
+      recorder->record_pair(data_a, data_b, dt, gcell_vol);
+    }
+    return (this->*check_pair_)(data_a, data_b, dt, beam_momentum, gcell_vol);
+  }
+
+  /**
+   * check_collision_two_part() for the given configuration, which is fixed
+   * for the whole run. It is selected once in the constructor, such that the
+   * checks of the pairs do not branch on the configuration.
+   *
+   * 	param Criterion The collision criterion
+   * 	param WithinNucleus Whether collisions within the nuclei are allowed
+   * \see check_collision_two_part for the parameters.
+   */
+  template <CollisionCriterion Criterion, bool WithinNucleus>
+  ActionPtr check_pair(const ParticleData &data_a, const ParticleData &data_b,
+                       double dt, const std::vector<FourVector> &beam_momentum,
+                       const double gcell_vol) const;
+
+  /**
+   * The kinematics of collision partners in the search with the geometric
+   * criterion, in single precision and stored component-wise
+   */
+  struct GeometricPartners {
+    /// Positions relative to the first particle of the cell [fm]
+    std::vector<float> x, y, z;
+    /// Momenta of the search [GeV]
+    std::vector<float> px, py, pz, energy;
+    /// Whether the particles have invalid ids
+    std::vector<char> invalid;
+    /// The nuclei of untouched spectators, see spectator_nucleus()
+    std::vector<BelongsTo> nucleus;
+
+    /// Make room for the given number of particles.
+    void resize(std::size_t n) {
+      for (std::vector<float> *component : {&x, &y, &z, &px, &py, &pz,
+                                            &energy}) {
+        component->resize(n);
+      }
+      invalid.resize(n);
+      nucleus.resize(n);
+    }
+  };
+
+  /**
+   * Store the kinematics of the particles of a cell for the geometric search.
+   *
+   * \param[in] partners The particles of the cell
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \param[out] stored The storage, which is large enough
+   * \param[in] first The position of the first particle in the storage
+   */
+  void store_geometric_partners(ParticleSpan partners,
+                                const std::vector<FourVector> &beam_momentum,
+                                GeometricPartners &stored,
+                                std::size_t first) const;
+
+  /**
+   * Check pairs of particles for collisions with the geometric criterion,
+   * computing the collision times of one particle with all partners in a
+   * single loop first.
+   *
+   * The positions and momenta of the partners are stored component-wise in
+   * single precision, such that the collision times of \ref collision_time
+   * are computed without branches, which can be vectorized with twice as
+   * many pairs per instruction as in double precision. Only the pairs
+   * colliding within the time step are then checked with
+   * check_collision_two_part in double precision, in the same order as
+   * without this preselection. The preselection accepts the pairs within a
+   * bound of the rounding errors of the collision time and those with almost
+   * equal velocities, such that it never rejects a pair which
+   * check_collision_two_part would accept and the found actions are the
+   * same.
+   *
+   * \param[in] search_list The first particles of the pairs
+   * \param[in] partners The second particles of the pairs
+   * \param[in] same_list Whether both lists are the particles of one cell,
+   *            such that every pair is only checked once, with the smaller id
+   *            first
+   * \param[in] dt Maximum time interval within which a collision can happen
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \param[out] actions The list to which the found actions are appended
+   */
+  void append_geometric_collisions(ParticleSpan search_list,
+                                   ParticleSpan partners, bool same_list,
+                                   double dt,
+                                   const std::vector<FourVector> &beam_momentum,
+                                   ActionList &actions) const;
+
+  /**
+   * Check pairs of particles for collisions with the geometric criterion like
+   * above, with the stored kinematics of the partners.
+   *
+   * \param[in] search_list The first particles of the pairs
+   * \param[in] partners The second particles of the pairs
+   * \param[in] same_list Whether both lists are the particles of one cell
+   * \param[in] dt Maximum time interval within which a collision can happen
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \param[in] stored The stored kinematics of the partners
+   * \param[in] first The position of the first partner in the storage
+   * \param[out] actions The list to which the found actions are appended
+   */
+  void append_geometric_collisions(ParticleSpan search_list,
+                                   ParticleSpan partners, bool same_list,
+                                   double dt,
+                                   const std::vector<FourVector> &beam_momentum,
+                                   const GeometricPartners &stored,
+                                   std::size_t first,
+                                   ActionList &actions) const;
+
+  /**
+   * Check all pairs of particles in a cell for collisions with the stochastic
+   * criterion, rejecting pairs with the cross section cache before their
+   * actions are constructed.
+   *
+   * The relative velocities of the pairs are computed from the momenta of the
+   * particles in the cell, which are stored component-wise for this. The
+   * random numbers are drawn in the same order as for check_collision_two_part
+   * and an action is only constructed if the random number is below the
+   * collision probability estimated with the tabulated cross section. For
+   * these pairs, the probability with the directly evaluated cross section
+   * decides.
+   *
+   * With \ref key_CT_stochastic_thinning_ "Stochastic_Thinning", the pairs of
+   * particles with tabulated cross sections are sampled by
+   * append_thinned_stochastic_collisions() instead, if the bound of their
+   * probabilities is smaller than 1.
+   *
+   * \param[in] search_list A list of particles within one cell
+   * \param[in] dt Maximum time interval within which a collision can happen
+   * \param[in] gcell_vol volume of grid cell in which the collision is checked
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \param[out] actions The list to which the found actions are appended
+   */
+  void append_stochastic_collisions(
+      ParticleSpan search_list, double dt, const double gcell_vol,
+      const std::vector<FourVector> &beam_momentum, ActionList &actions) const;
+
+  /**
+   * Sample the candidate pairs of the particles in one cell by thinning, see
+   * \ref key_CT_stochastic_thinning_ "Stochastic_Thinning".
+   *
+   * The collision probabilities of all pairs are bounded by \f$B = \sigma_{\rm
+   * max} v_{\rm max} \Delta t / \Delta V\f$ with the largest tabulated cross
+   * section of the pairs of types present and the sum of the two largest
+   * velocities, which is not smaller than any relative velocity. The pairs
+   * whose random number is below \f$B\f$ are found by skipping a
+   * geometrically distributed number of pairs, and only for these the
+   * probability is evaluated and compared to the random number. This samples
+   * every pair with its exact probability in a time proportional to the
+   * expected number of candidates.
+   *
+   * \param[in] search_list The particles within one cell, all of them with
+   *            tabulated cross sections
+   * \param[in] prob_bound The bound \f$B < 1\f$ of the collision
+   *            probabilities of the pairs
+   * \param[in] dt Maximum time interval within which a collision can happen
+   * \param[in] gcell_vol volume of grid cell in which the collision is checked
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \param[out] actions The list to which the found actions are appended
+   */
+  void append_thinned_stochastic_collisions(
+      const std::vector<const ParticleData *> &search_list, double prob_bound,
+      double dt, const double gcell_vol,
+      const std::vector<FourVector> &beam_momentum, ActionList &actions) const;
+
+  /**
+   * Sample a candidate pair of the stochastic criterion with a random number
+   * drawn here and append its action if it collides.
+   *
+   * \param[in] data_a First incoming particle
+   * \param[in] data_b Second incoming particle
+   * \param[in] v_rel Relative velocity of the pair
+   * \param[in] prob_scale The range of the random number, which is 1 unless
+   *            the pair was preselected by thinning with this bound of the
+   *            probability
+   * \param[in] dt Maximum time interval within which a collision can happen
+   * \param[in] gcell_vol volume of grid cell in which the collision is checked
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \param[out] actions The list to which the found action is appended
+   */
+  void sample_stochastic_pair(const ParticleData &data_a,
+                              const ParticleData &data_b, double v_rel,
+                              double prob_scale, double dt,
+                              const double gcell_vol,
+                              const std::vector<FourVector> &beam_momentum,
+                              ActionList &actions) const;
+
+  /**
+   * \return Whether collisions of the two particles are banned, because they
+   * belong to the same nucleus and have not interacted yet.
+   *
+   * \param[in] data_a First incoming particle
+   * \param[in] data_b Second incoming particle
+   */
+  bool is_banned_within_nucleus(const ParticleData &data_a,
+                                const ParticleData &data_b) const;
+
+  /**
+   * \param[in] data The particle.
+   * \return The nucleus of an initial nucleon which did not interact yet, if
+   *         collisions within the nuclei are banned, BelongsTo::Nothing
+   *         otherwise. Two such spectators of the same nucleus cannot
+   *         collide.
+   */
+  BelongsTo spectator_nucleus(const ParticleData &data) const {
+    if (finder_parameters_.allow_collisions_within_nucleus ||
+        data.collisions_per_particle() != 0) {
+      return BelongsTo::Nothing;
+    }
+    return data.belongs_to();
+  }
+
+  /**
+   * Check whether the particles of a cell and its neighbors are spectators of
+   * one nucleus, such that no collisions among them can be found. In
+   * peripheral collisions, this is the case for most cells, which are then
+   * skipped without looking at any pair.
+   *
+   * Stochastic thinning samples the pairs with random numbers before the
+   * spectators are rejected, hence its cells are never skipped, such that
+   * the sequence of random numbers is kept.
+   *
+   * \param[in] search_list The particles of the cell.
+   * \param[in] neighbors_list The particles of the neighboring cells.
+   * \return Whether no collision can be found.
+   */
+  bool only_spectators_of_one_nucleus(ParticleSpan search_list,
+                                      ParticleSpan neighbors_list = {}) const;
+
+  /**
+   * Create the action of a candidate pair including its cross sections.
+   *
+   * \param[in] data_a First incoming particle
+   * \param[in] data_b Second incoming particle
+   * \param[in] time_until_collision Time until the collision [fm]
+   * \param[in] incoming_parametrized Whether the total cross section is
+   *            parametrized
+   * \return The action of the pair
+   */
+  ScatterActionPtr create_scatter_action(const ParticleData &data_a,
+                                         const ParticleData &data_b,
+                                         double time_until_collision,
+                                         bool incoming_parametrized) const;
+
+  /**
+   * \return The cross section of an action [fm\f$^2\f$], divided by the
+   * number of test particles and including the cross section scaling factors
+   * of the incoming particles.
+   *
+   * \param[in] act The action of the pair
+   * \param[in] time_until_collision Time until the collision [fm]
+   */
+  double scaled_cross_section(const ScatterAction &act,
+                              double time_until_collision) const;
+
+  /**
+   * Decide with the stochastic criterion whether a pair collides.
+   *
+   * \param[in] act The action of the pair
+   * \param[in] xs The scaled cross section of the pair [fm\f$^2\f$]
+   * \param[in] dt Maximum time interval within which a collision can happen
+   * \param[in] gcell_vol volume of grid cell in which the collision is checked
+   * \param[in] random_no Uniform random number in [0, 1)
+   * \return Whether the random number is below the collision probability
+   * \throw std::runtime_error if the probability is larger than 1, unless only
+   *        a warning is requested.
+   */
+  bool stochastic_collision_sampled(const ScatterAction &act, double xs,
+                                    double dt, const double gcell_vol,
+                                    double random_no) const;
 
   /**
    * Check for multiple i.e. more than 2 particles if a collision will happen in
@@ -310,6 +725,96 @@ class ScatterActionsFinder : public ActionFinderInterface {
   ActionPtr check_collision_multi_part(const ParticleList &plist, double dt,
                                        const double gcell_vol) const;
 
+  /**
+   * Check all combinations of particles in a cell for the included
+   * multi-particle reactions.
+   *
+   * The particles are first sorted into the species which take part in the
+   * 3-, 4- and 5-particle reactions, respectively, and ordered by id. Only the
+   * combinations of particles with increasing ids within each of these lists
+   * are checked, instead of all combinations of particles in the cell.
+   *
+   * \param[in] search_list A list of particles within one cell
+   * \param[in] dt Maximum time interval within which a collision can happen
+   * \param[in] gcell_vol volume of grid cell in which the collision is checked
+   * \param[out] actions The list to which the found actions are appended
+   */
+  void append_multi_particle_actions(ParticleSpan search_list, double dt,
+                                     const double gcell_vol,
+                                     ActionList &actions) const;
+
+  /**
+   * Determine whether the total cross section of two particles is taken from a
+   * parametrization, depending on the total cross section strategy.
+   *
+   * \param[in] type_a The type of the first particle
+   * \param[in] type_b The type of the second particle
+   * \return Whether the total cross section is parametrized
+   */
+  bool is_total_parametrized(const ParticleType &type_a,
+                             const ParticleType &type_b) const;
+
+  /**
+   * Evaluate the total cross section of two particles with their pole masses
+   * in the same way as for a candidate pair, to fill the cross section cache.
+   *
+   * \param[in] type_a The type of the first particle
+   * \param[in] type_b The type of the second particle
+   * \param[in] sqrts The center-of-mass energy of the pair [GeV]
+   * \return The total cross section [mb]
+   */
+  double total_cross_section(const ParticleType &type_a,
+                             const ParticleType &type_b, double sqrts) const;
+
+  /**
+   * Evaluate the total cross sections of two particles with their pole masses
+   * at many center-of-mass energies like total_cross_section(). Parametrized
+   * total cross sections are evaluated in one loop over the energies, see
+   * CrossSections::parametrized_total().
+   *
+   * \param[in] type_a The type of the first particle
+   * \param[in] type_b The type of the second particle
+   * \param[in] sqrts The center-of-mass energies of the pair [GeV]
+   * \param[out] xs The total cross sections [mb], one for every energy
+   */
+  void total_cross_sections(const ParticleType &type_a,
+                            const ParticleType &type_b,
+                            const std::vector<double> &sqrts,
+                            std::vector<double> &xs) const;
+
+  /**
+   * Estimate the cross section of a candidate pair from above with the cross
+   * section cache, including the number of test particles and the cross
+   * section scaling factors of the particles.
+   *
+   * The cache is only used for pairs of stable particles with their pole
+   * masses and without potentials on the lattice, since otherwise the cross
+   * section does not only depend on the types and \f$\sqrt{s}\f$.
+   *
+   * \param[in] data_a First incoming particle
+   * \param[in] data_b Second incoming particle
+   * \param[in] time_until_collision Time until the collision [fm]
+   * \return The estimated cross section [fm\f$^2\f$], or nothing if the cache
+   *         is not used or cannot be used for the pair.
+   */
+  std::optional<double> cross_section_upper_bound(
+      const ParticleData &data_a, const ParticleData &data_b,
+      double time_until_collision) const;
+
+  /**
+   * Estimate the largest cross section of any pair of the given particles from
+   * above, with the tabulated cross sections of the pairs of types present up
+   * to the largest \f$\sqrt{s}\f$ possible with the momenta of the particles.
+   *
+   * \param[in] particles The particles, which all need to have tabulated cross
+   *            sections, see cross_section_upper_bound().
+   * \return The estimated cross section including the cross section scaling
+   *         factors, but not the number of test particles [mb], or nothing if
+   *         the cache cannot be used for all pairs.
+   */
+  std::optional<double> max_cross_section_bound(
+      const std::vector<const ParticleData *> &particles) const;
+
   /// Struct collecting several parameters.
   ScatterActionsFinderParameters finder_parameters_;
   /// Class that deals with strings, interfacing Pythia.
@@ -322,8 +827,26 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * Ignored if negative.
    */
   const double box_length_;
+  /**
+   * Whether the particles may leave the box until the end of the time step,
+   * such that the surrounding particles are looked at in their closest
+   * periodic image.
+   */
+  const bool lazy_wall_crossings_;
   /// Parameter for formation time
   const double string_formation_time_;
+  /// Tabulated total cross sections, if enabled
+  std::unique_ptr<CrossSectionCache> xs_cache_;
+  /// Whether the cells of the grid are sized from the particles present
+  bool dynamic_cell_size_ = false;
+  /// Factor by which the estimated largest cross section is increased
+  double dynamic_cell_size_safety_factor_ = 1.;
+  /// Whether the candidate pairs of the stochastic criterion are thinned
+  bool stochastic_thinning_ = false;
+  /// The instance of check_pair() for the configuration of the run
+  ActionPtr (ScatterActionsFinder::*check_pair_)(
+      const ParticleData &, const ParticleData &, double,
+      const std::vector<FourVector> &, double) const = nullptr;
 };
 
 /**
@@ -0,0 +1,108 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_SPECTRAOUTPUT_H_
+#define SRC_INCLUDE_SMASH_SPECTRAOUTPUT_H_
+
+#include <array>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "file.h"
+#include "outputinterface.h"
+#include "outputparameters.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * \brief Histograms the spectra of the final particles while SMASH runs
+ *
+ * For every selected species, the rapidity and transverse momentum
+ * distributions and the flow coefficients \f$v_1\f$ to \f$v_3\f$ at
+ * midrapidity are accumulated over all events and ensembles. The histograms
+ * are written once, when the output is destroyed, see
+ * \ref doxypage_output_spectra.
+ */
+class SpectraOutput : public OutputInterface {
+ public:
+  /**
+   * Create the output.
+   *
+   * \param[in] path Path of the output directory.
+   * \param[in] name Name of the output content.
+   * \param[in] out_par Output parameters, of which the spectra parameters are
+   *            used.
+   * \throw std::invalid_argument if a number of bins is not positive or an
+   *        interval is empty.
+   */
+  SpectraOutput(const std::filesystem::path &path, const std::string &name,
+                const OutputParameters &out_par);
+
+  /// Write the histograms.
+  ~SpectraOutput();
+
+  /**
+   * Add the final particles of an event to the histograms.
+   *
+   * \param[in] particles The final particles of one ensemble.
+   * \param[in] event_label Unused, needed since inherited.
+   * \param[in] event Unused, needed since inherited.
+   */
+  void at_eventend(const Particles &particles, const EventLabel &event_label,
+                   const EventInfo &event) override;
+
+  /// \return The event hooks, since only the final particles are histogrammed.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet().set(EventHooks);
+  }
+
+  /// Number of flow coefficients \f$v_n\f$, which are histogrammed
+  static constexpr int number_of_harmonics = 3;
+
+  /// The histograms of one particle species
+  struct Histograms {
+    /// Counts of the rapidity bins
+    std::vector<double> dndy;
+    /// Counts of the transverse momentum bins at midrapidity
+    std::vector<double> dndpt;
+    /// Sums of \f$\cos(n\phi)\f$ of the transverse momentum bins
+    std::vector<std::array<double, number_of_harmonics>> cos_nphi;
+  };
+
+  /**
+   * \param[in] index Position of the species in the list of PDG codes.
+   * \return The histograms of the species.
+   */
+  const Histograms &histograms(std::size_t index) const {
+    return histograms_[index];
+  }
+
+  /// \return The number of events and ensembles added so far.
+  int number_of_blocks() const { return n_blocks_; }
+
+ private:
+  /// Write the histograms to the file.
+  void write();
+
+  /// Pointer to the output file
+  RenamingFilePtr file_;
+  /// The binning
+  const SpectraOutputParameters par_;
+  /// The histograms, in the order of the PDG codes
+  std::vector<Histograms> histograms_;
+  /// Number of events and ensembles added
+  int n_blocks_ = 0;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_SPECTRAOUTPUT_H_
@@ -12,9 +12,14 @@
 #include <cmath>
 #include <list>
 #include <map>
+#include <memory>
+#include <optional>
 
+#include "distributions.h"
 #include "forwarddeclarations.h"
+#include "hadgas_eos.h"
 #include "modusdefault.h"
+#include "quantumsampling.h"
 
 namespace smash {
 
@@ -81,6 +86,14 @@ class SphereModus : public ModusDefault {
   double radius() const { return radius_; }
 
  private:
+  /**
+   * Sample the momentum and the position of an initial particle in the
+   * sphere.
+   *
+   * \param[inout] data The particle, whose type is already set.
+   */
+  void sample_phase_space(ParticleData &data);
+
   /// Sphere radius (in fm)
   double radius_;
   /// Temperature for momentum distribution (in GeV)
@@ -119,6 +132,27 @@ class SphereModus : public ModusDefault {
    * - false -- simply use pole masses.
    */
   const bool account_for_resonance_widths_;
+  /**
+   * Sampler of the thermal masses of resonances from tabulated distributions,
+   * if requested instead of rejection sampling
+   */
+  std::optional<ThermalMassSampler> thermal_mass_sampler_;
+  /**
+   * Whether the quantum momentum distributions are sampled from tabulated
+   * inverse cumulative distributions
+   */
+  const bool tabulate_quantum_momenta_;
+  /// Sampler of the quantum momenta, created in the first event
+  std::unique_ptr<QuantumSampling> quantum_sampling_;
+  /**
+   * Whether the thermal momentum distributions are sampled from tabulated
+   * inverse cumulative distributions
+   */
+  const bool tabulate_thermal_momenta_;
+  /// Sampler of the tabulated thermal momenta, created in the first event
+  std::unique_ptr<ThermalMomentumSampler> thermal_momentum_sampler_;
+  /// Threads sampling the initial particles species by species, if requested
+  std::unique_ptr<ThreadPool> sampling_thread_pool_;
   /**
    * Particle multiplicities at initialization;
    * required if use_thermal_ is false
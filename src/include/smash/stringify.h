@@ -109,6 +109,16 @@ std::string to_string(SmearingMode mode);
  */
 std::string to_string(TimeStepMode mode);
 
+/**
+ * Convert an ActionQueue enum value to its corresponding string.
+ *
+ * \param[in] queue The ActionQueue enum value to convert.
+ *
+ * \return std::string Corresponding string representation.
+ * \throws std::invalid_argument If the enum value is unhandled.
+ */
+std::string to_string(ActionQueue queue);
+
 /**
  * Convert a BoxInitialCondition enum value to its corresponding string.
  *
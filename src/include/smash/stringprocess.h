@@ -10,8 +10,11 @@
 #ifndef SRC_INCLUDE_SMASH_STRINGPROCESS_H_
 #define SRC_INCLUDE_SMASH_STRINGPROCESS_H_
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -175,6 +178,31 @@ class StringProcess {
    */
   ParticleList final_state_;
 
+  /**
+   * Color or anti-color indices of the junction legs, which are traced by
+   * compose_string_junction(). It is kept such that its storage is reused.
+   */
+  std::vector<int> junction_legs_;
+
+  /**
+   * Indices of the junctions connected to the traced ones, which are moved
+   * by compose_string_junction(). It is kept such that its storage is reused.
+   */
+  std::vector<int> junctions_to_move_;
+
+  /**
+   * Fragments of the string which is currently hadronized, before they are
+   * appended to #final_state_. It is kept such that its storage is reused by
+   * all string processes of this object.
+   */
+  ParticleList intermediate_particles_;
+
+  /**
+   * Final-state particles of the hard string routine, which are not hadrons.
+   * It is kept such that its storage is reused.
+   */
+  ParticleList non_hadron_particles_;
+
   /**
    * Map containing PYTHIA objects for hard string routines.
    * Particle IDs are used as the keys to obtain the respective object.
@@ -186,6 +214,34 @@ class StringProcess {
   /// Map object to contain the different pythia objects
   pythia_map hard_map_;
 
+  /**
+   * PYTHIA object holding the settings and particle data common to all
+   * objects in #hard_map_. It is never initialized itself, but its databases
+   * are copied into every new entry of the map instead of reading them again
+   * from the XML files.
+   */
+  std::unique_ptr<Pythia8::Pythia> hard_template_;
+
+  /**
+   * Pairs of PDG ids used in PYTHIA, for which the objects in #hard_map_ are
+   * created in advance, also by the spare instances
+   */
+  std::vector<std::pair<int, int>> preinitialized_pairs_;
+
+  /// Center-of-mass energy at which the objects are created in advance [GeV]
+  double preinitialization_sqrts_ = 0.;
+
+  /**
+   * \return The PYTHIA object of the hard string routine for the given pair
+   * of PDG ids, which is created and initialized if it does not exist yet.
+   *
+   * \param[in] idAB The PDG ids used in PYTHIA for the incoming particles.
+   * \param[in] sqrts The center-of-mass energy [GeV], at which a new object is
+   *            initialized.
+   * \throw std::runtime_error if PYTHIA fails to initialize.
+   */
+  Pythia8::Pythia &hard_pythia(const std::pair<int, int> &idAB, double sqrts);
+
   /// PYTHIA object used in fragmentation
   std::unique_ptr<Pythia8::Pythia> pythia_hadron_;
 
@@ -204,6 +260,109 @@ class StringProcess {
    */
   Pythia8::Event event_intermediate_;
 
+  /**
+   * Further instances with the same parameters, created on demand if this
+   * object is checked out by several threads at the same time.
+   */
+  std::vector<std::unique_ptr<StringProcess>> spares_;
+
+  /// Spare instances which are currently not checked out
+  std::vector<StringProcess *> idle_spares_;
+
+  /// Whether this instance itself is currently checked out
+  bool checked_out_ = false;
+
+  /// Distance of the nodes of the diffractive tables in \f$\ln\sqrt{s}\f$
+  static constexpr double diffractive_log_sqrts_spacing_ = 0.001;
+
+  /// Number of nodes of every diffractive table
+  static constexpr int diffractive_table_size_ = 10000;
+
+  /// Number of PDG ids onto which pdg_map_for_pythia() maps all particles
+  static constexpr int n_pythia_ids_ = 8;
+
+  /// Tabulated diffractive cross sections of one pair of PDG ids
+  struct DiffractiveTable {
+    /// The center-of-mass energy of the first node, the threshold [GeV]
+    double first_sqrts;
+    /// The cross sections AB->AX, AB->XB and AB->XX at the nodes [mb]
+    std::vector<std::array<double, 3>> nodes;
+  };
+
+  /// Whether the diffractive cross sections are tabulated
+  bool tabulate_diffractive_ = false;
+
+  /// Whether the Lund z is sampled from tables, cf. sample_zLund.
+  inline static bool tabulated_lund_z_ = false;
+
+  /**
+   * The table of every ordered pair of PDG ids used in PYTHIA, once it has
+   * been created. Tables are never removed, such that they can be read
+   * without locking.
+   */
+  std::array<std::atomic<const DiffractiveTable *>,
+             n_pythia_ids_ * n_pythia_ids_>
+      diffractive_slots_;
+
+  /// The storage of the created diffractive tables
+  std::vector<std::unique_ptr<DiffractiveTable>> diffractive_tables_;
+
+  /// Mutex protecting the creation of diffractive tables
+  std::mutex diffractive_mutex_;
+
+  /**
+   * \return The index of a PDG id returned by pdg_map_for_pythia() in the
+   *         diffractive tables.
+   *
+   * \param[in] pdg The PDG id.
+   * \throw std::invalid_argument if \p pdg is not returned by
+   *        pdg_map_for_pythia().
+   */
+  static int pythia_id_index(int pdg);
+
+  /**
+   * \return The table of the given pair of PDG ids, which is created if
+   *         needed.
+   *
+   * \param[in] pdg_a PDG id used in PYTHIA of incoming particle A.
+   * \param[in] pdg_b PDG id used in PYTHIA of incoming particle B.
+   */
+  const DiffractiveTable &diffractive_table(int pdg_a, int pdg_b);
+
+  /**
+   * \return The center-of-mass energy [GeV], below which the diffractive cross
+   *         sections of the pair are constant.
+   *
+   * \param[in] pdg_a PDG id of incoming particle A.
+   * \param[in] pdg_b PDG id of incoming particle B.
+   */
+  double diffractive_threshold(int pdg_a, int pdg_b) const {
+    // This threshold magic is following Pythia. Todo(ryu): take care of this.
+    double sqrts_threshold = 2. * (1. + 1.0e-6);
+    /* In the case of mesons, the corresponding vector meson masses
+     * are used to evaluate the energy threshold. */
+    const int pdg_a_mod =
+        (std::abs(pdg_a) > 1000) ? pdg_a : 10 * (std::abs(pdg_a) / 10) + 3;
+    const int pdg_b_mod =
+        (std::abs(pdg_b) > 1000) ? pdg_b : 10 * (std::abs(pdg_b) / 10) + 3;
+    sqrts_threshold += pythia_hadron_->particleData.m0(pdg_a_mod) +
+                       pythia_hadron_->particleData.m0(pdg_b_mod);
+    return sqrts_threshold;
+  }
+
+  /// Whether the instances are used by several threads at the same time
+  bool concurrent_ = false;
+
+  /// Mutex protecting the bookkeeping of the checked out instances
+  std::mutex pool_mutex_;
+
+  /**
+   * Return a checked out instance to the pool.
+   *
+   * \param[in] process The instance to be returned.
+   */
+  void release(StringProcess *process);
+
  public:
   // clang-format off
 
@@ -290,6 +449,23 @@ class StringProcess {
                            double stringz_a, double stringz_b,
                            double string_sigma_T);
 
+  /**
+   * Create the PYTHIA objects of the hard string routine for the given pairs
+   * of incoming hadrons in advance, such that the first hard string processes
+   * do not have to wait for their initialization. The hadrons are mapped onto
+   * the PDG ids used in PYTHIA as in the hard string routine itself, and the
+   * objects are created for both orders of every pair. Spare instances
+   * created by checkout() afterwards do the same.
+   *
+   * \param[in] pairs The pairs of incoming hadrons.
+   * \param[in] sqrts The center-of-mass energy at which the objects are
+   *            initialized [GeV].
+   * \throw std::runtime_error if PYTHIA fails to initialize or a particle is
+   *        neither a hadron nor a lepton.
+   */
+  void preinitialize_hard_pythia(
+      const std::vector<std::pair<PdgCode, PdgCode>> &pairs, double sqrts);
+
   /**
    * Set PYTHIA random seeds to be desired values.
    * The value is recalculated such that it is allowed by PYTHIA.
@@ -297,9 +473,18 @@ class StringProcess {
    * \see smash::maximum_rndm_seed_in_pythia
    */
   void init_pythia_hadron_rndm() {
-    const int seed_new =
-        random::uniform_int(1, maximum_rndm_seed_in_pythia);
+    init_pythia_hadron_rndm(
+        random::uniform_int(1, maximum_rndm_seed_in_pythia));
+  }
 
+  /**
+   * Set the PYTHIA random seed to a value drawn beforehand, e.g. on the
+   * thread preparing the next event.
+   *
+   * \param[in] seed_new The seed, between 1 and
+   *            smash::maximum_rndm_seed_in_pythia.
+   */
+  void init_pythia_hadron_rndm(int seed_new) {
     pythia_hadron_->rndm.init(seed_new);
     logg[LPythia].debug("pythia_hadron_ : rndm is initialized with seed ",
                         seed_new);
@@ -318,16 +503,7 @@ class StringProcess {
    */
   std::array<double, 3> cross_sections_diffractive(int pdg_a, int pdg_b,
                                                    double sqrt_s) {
-    // This threshold magic is following Pythia. Todo(ryu): take care of this.
-    double sqrts_threshold = 2. * (1. + 1.0e-6);
-    /* In the case of mesons, the corresponding vector meson masses
-     * are used to evaluate the energy threshold. */
-    const int pdg_a_mod =
-        (std::abs(pdg_a) > 1000) ? pdg_a : 10 * (std::abs(pdg_a) / 10) + 3;
-    const int pdg_b_mod =
-        (std::abs(pdg_b) > 1000) ? pdg_b : 10 * (std::abs(pdg_b) / 10) + 3;
-    sqrts_threshold += pythia_hadron_->particleData.m0(pdg_a_mod) +
-                       pythia_hadron_->particleData.m0(pdg_b_mod);
+    const double sqrts_threshold = diffractive_threshold(pdg_a, pdg_b);
     /* Constant cross-section for sub-processes below threshold equal to
      * cross-section at the threshold. */
     if (sqrt_s < sqrts_threshold) {
@@ -338,6 +514,51 @@ class StringProcess {
             pythia_sigmatot_.sigmaXX()};
   }
 
+  /**
+   * Compute the diffractive cross sections like cross_sections_diffractive()
+   * on behalf of the threads sharing this object. They are either computed
+   * by an instance checked out for the calling thread or, if enabled by
+   * set_tabulate_diffractive(), interpolated from tables.
+   *
+   * The tables of a pair of PDG ids are filled when the pair is used for the
+   * first time. Their nodes are equidistant in \f$\ln\sqrt{s}\f$, starting
+   * at the threshold, below which the cross sections are constant. Above the
+   * last node, the cross sections are computed directly.
+   *
+   * \param[in] pdg_a PDG id used in PYTHIA of incoming particle A, as
+   *            returned by pdg_map_for_pythia()
+   * \param[in] pdg_b PDG id used in PYTHIA of incoming particle B, as
+   *            returned by pdg_map_for_pythia()
+   * \param[in] sqrt_s collision energy in the center of mass frame [GeV]
+   * \return array with single diffractive cross-sections AB->AX, AB->XB and
+   * double diffractive AB->XX.
+   */
+  std::array<double, 3> shared_cross_sections_diffractive(int pdg_a,
+                                                          int pdg_b,
+                                                          double sqrt_s);
+
+  /**
+   * Set whether shared_cross_sections_diffractive() interpolates the cross
+   * sections from tables.
+   *
+   * \param[in] tabulate Whether to tabulate the diffractive cross sections.
+   */
+  void set_tabulate_diffractive(bool tabulate) {
+    tabulate_diffractive_ = tabulate;
+  }
+
+  /**
+   * Choose how sample_zLund samples the lightcone momentum fraction.
+   *
+   * \param[in] tabulated Whether the fraction is drawn from the tabulated
+   *            inverse cumulative distribution of a LundZTable, where it is
+   *            tabulated, instead of by rejection. The rejection sampling is
+   *            exact and the default.
+   */
+  static void set_tabulated_lund_z(bool tabulated) {
+    tabulated_lund_z_ = tabulated;
+  }
+
   /**
    * \todo The following set_ functions are replaced with
    * constructor with arguments.
@@ -764,12 +985,17 @@ class StringProcess {
   int get_index_forward(bool find_forward, int np_end,
                         Pythia8::Event &event) {
     int iforward = 1;
+    if (event.size() - np_end <= 2) {
+      return iforward;
+    }
+    // The rapidity of the selected particle is only computed once
+    double y_quark_forward = event[iforward].y();
     for (int ip = 2; ip < event.size() - np_end; ip++) {
       const double y_quark_current = event[ip].y();
-      const double y_quark_forward = event[iforward].y();
       if ((find_forward && y_quark_current > y_quark_forward) ||
           (!find_forward && y_quark_current < y_quark_forward)) {
         iforward = ip;
+        y_quark_forward = y_quark_current;
       }
     }
     return iforward;
@@ -780,7 +1006,7 @@ class StringProcess {
    * which is called after the collision
    * \return ParticleList filled with the final state particles.
    */
-  ParticleList get_final_state() { return final_state_; }
+  ParticleList get_final_state() const { return final_state_; }
 
   /**
    * a function that clears the final state particle list
@@ -788,6 +1014,70 @@ class StringProcess {
    */
   void clear_final_state() { final_state_.clear(); }
 
+  /**
+   * An instance checked out for the exclusive use by one thread, which is
+   * returned to the pool on destruction.
+   */
+  class Lease {
+   public:
+    /**
+     * \param[in] pool The instance from which \p process was checked out.
+     * \param[in] process The checked out instance.
+     */
+    Lease(StringProcess &pool, StringProcess &process)
+        : pool_(&pool), process_(&process) {}
+    /// A lease cannot be copied, since the instance is used exclusively.
+    Lease(const Lease &) = delete;
+    /// A lease cannot be copied, since the instance is used exclusively.
+    Lease &operator=(const Lease &) = delete;
+    /// Return the instance to the pool.
+    ~Lease() { pool_->release(process_); }
+    /// \return The checked out instance.
+    StringProcess &operator*() const { return *process_; }
+    /// \return The checked out instance.
+    StringProcess *operator->() const { return process_; }
+
+   private:
+    /// The instance from which the lease was checked out
+    StringProcess *pool_;
+    /// The checked out instance
+    StringProcess *process_;
+  };
+
+  /**
+   * Check out an instance for the exclusive use by the calling thread. This is
+   * required around any use of this object, if it is shared by several
+   * threads. This includes both the computation of cross sections and the
+   * complete sequence of init(), next_*() and get_final_state().
+   *
+   * The instance is this object itself if it is not in use. Otherwise, a spare
+   * instance with the same parameters and its own PYTHIA objects is handed
+   * out, which is created if all spares are in use. Hence, the number of
+   * instances does not exceed the number of threads using them concurrently.
+   *
+   * \note The parameters set via the setters after the construction are only
+   * passed on to spare instances created afterwards.
+   *
+   * \return The lease of the checked out instance.
+   */
+  Lease checkout();
+
+  /**
+   * Set whether the instances are used by several threads at the same time.
+   *
+   * \param[in] concurrent Whether the instances are used concurrently.
+   */
+  void set_concurrent(bool concurrent) { concurrent_ = concurrent; }
+
+  /**
+   * \return Whether the instances are used by several threads at the same
+   * time. In this case the random number seed of the fragmentation has to be
+   * set before every collision from the random number engine of the calling
+   * thread, see init_pythia_hadron_rndm(), such that the result does not
+   * depend on which instance fragments which string.
+   */
+  bool is_concurrent() const { return concurrent_; }
+
   /**
    * compute the formation time and fill the arrays with final-state particles
    * as described in \iref{Andersson:1983ia}.
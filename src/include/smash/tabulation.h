@@ -12,6 +12,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "forwarddeclarations.h"
@@ -37,7 +38,7 @@ class Tabulation {
   /**
    * Construct an empty tabulation object.
    */
-  Tabulation() : values_({}), x_min_(0.0), x_max_(0.0), inv_dx_(0.0) {}
+  Tabulation() : x_min_(0.0), x_max_(0.0), inv_dx_(0.0) {}
 
   /**
    * Construct a new tabulation object.
@@ -53,10 +54,39 @@ class Tabulation {
   Tabulation(double x_min, double range, size_t num,
              std::function<double(double)> f);
 
+  /**
+   * Construct a tabulation object of values, which are owned by another
+   * object, e.g. a memory-mapped TabulationFile, without copying them.
+   *
+   * \param storage object, which keeps the values alive
+   * \param values pointer to the tabulated values
+   * \param n_values number of tabulated values
+   * \param x_min lower bound of tabulation domain
+   * \param x_max upper bound of tabulation domain
+   * \param inv_dx inverse step size
+   */
+  Tabulation(std::shared_ptr<const void> storage, const double* values,
+             size_t n_values, double x_min, double x_max, double inv_dx)
+      : storage_(std::move(storage)),
+        values_(values),
+        n_values_(n_values),
+        x_min_(x_min),
+        x_max_(x_max),
+        inv_dx_(inv_dx) {}
+
   /**
    * \returns whether the tabulation is empty.
    */
-  bool is_empty() const { return values_.empty(); }
+  bool is_empty() const { return n_values_ == 0; }
+
+  /// \returns the number of tabulated values.
+  size_t size() const { return n_values_; }
+
+  /// \returns the lower bound of the tabulation domain.
+  double x_min() const { return x_min_; }
+
+  /// \returns the inverse step size.
+  double inv_dx() const { return inv_dx_; }
 
   /**
    * Construct a tabulation object by reading binary data from a stream.
@@ -106,8 +136,17 @@ class Tabulation {
   void write(std::ofstream& stream, sha256::Hash hash) const;
 
  protected:
-  /// vector for storing tabulated values
-  std::vector<double> values_;
+  /**
+   * Keeps the tabulated values alive. They are shared by all copies of the
+   * tabulation, since they are never changed.
+   */
+  std::shared_ptr<const void> storage_;
+
+  /// tabulated values
+  const double* values_ = nullptr;
+
+  /// number of tabulated values
+  size_t n_values_ = 0;
 
   /// lower bound for tabulation
   double x_min_;
@@ -117,6 +156,9 @@ class Tabulation {
 
   /// inverse step size 1/dx
   double inv_dx_;
+
+  /// TabulationFile stores the values of tabulations
+  friend class TabulationFile;
 };
 
 /**
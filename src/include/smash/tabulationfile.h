@@ -0,0 +1,100 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_TABULATIONFILE_H_
+#define SRC_INCLUDE_SMASH_TABULATIONFILE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sha256.h"
+#include "tabulation.h"
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * \brief A file holding many tabulations, which is mapped into memory
+ *
+ * The values of every tabulation are stored as an array of doubles aligned to
+ * 64 bytes. The file is mapped read-only and shared, such that the Tabulation
+ * objects returned by find() wrap the values in the mapping without copying
+ * them. All processes on a node mapping the same file hence share the same
+ * physical pages of the page cache. The mapping stays valid as long as any of
+ * its tabulations exists.
+ *
+ * Internally this uses the POSIX \c mmap system call.
+ */
+class TabulationFile {
+ public:
+  /**
+   * Map a file written by write().
+   *
+   * \param[in] path The file.
+   * \param[in] hash Hash of the particle properties, for which the
+   *            tabulations are valid.
+   * \return The mapped file, or nothing if the file does not exist, is
+   *         damaged or was written for another hash.
+   */
+  static std::unique_ptr<TabulationFile> open(const std::filesystem::path &path,
+                                              const sha256::Hash &hash);
+
+  /**
+   * Write tabulations to a file, such that no incomplete file is left behind.
+   *
+   * \param[in] path The file.
+   * \param[in] hash Hash of the particle properties, for which the
+   *            tabulations are valid.
+   * \param[in] tabulations Names and tabulations to be stored.
+   */
+  static void write(
+      const std::filesystem::path &path, const sha256::Hash &hash,
+      const std::vector<std::pair<std::string, const Tabulation *>>
+          &tabulations);
+
+  /**
+   * \param[in] name Name of the tabulation.
+   * \return The tabulation wrapping the mapped values, empty if the file has
+   *         no tabulation of this name.
+   */
+  Tabulation find(const std::string &name) const;
+
+  /// \return The number of tabulations in the file.
+  std::size_t size() const { return entries_.size(); }
+
+ private:
+  /// Where the values of a tabulation are found in the file
+  struct Entry {
+    /// Offset of the values from the start of the file
+    std::size_t offset;
+    /// Number of values
+    std::size_t n_values;
+    /// Lower bound of the tabulation
+    double x_min;
+    /// Upper bound of the tabulation
+    double x_max;
+    /// Inverse step size
+    double inv_dx;
+  };
+
+  /// The mapping of the file, which is unmapped with its last user
+  std::shared_ptr<const char> mapping_;
+  /// The tabulations by name
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_TABULATIONFILE_H_
@@ -0,0 +1,85 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_TASKGRAPH_H_
+#define SRC_INCLUDE_SMASH_TASKGRAPH_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "threadpool.h"
+
+namespace smash {
+
+/**
+ * A set of tasks, some of which have to wait for others to be completed.
+ *
+ * The tasks are executed by the threads of a ThreadPool. A task is started as
+ * soon as all tasks it depends on are completed, such that independent chains
+ * of tasks, e.g. the action search and the propagation of the parallel
+ * ensembles, do not wait for each other. The tasks which are ready are started
+ * in the order in which they became ready.
+ *
+ * Every task can only depend on tasks added before it, hence the order in
+ * which the tasks are added is a valid order to execute them one after the
+ * other, which is done without a pool.
+ *
+ * \note The tasks must not call ThreadPool::parallel_for() on the pool
+ * executing the graph, since this would deadlock.
+ */
+class TaskGraph {
+ public:
+  /// Identifies a task of the graph
+  using TaskId = std::size_t;
+
+  /**
+   * Add a task.
+   *
+   * \param[in] task The function to be executed.
+   * \param[in] dependencies The tasks to be completed before \p task starts.
+   * \return The id of the new task.
+   * \throw std::invalid_argument if a dependency was not added before.
+   */
+  TaskId add(std::function<void()> task,
+             const std::vector<TaskId> &dependencies = {});
+
+  /// \return The number of tasks.
+  std::size_t size() const { return nodes_.size(); }
+
+  /**
+   * Execute all tasks and wait for their completion. The graph is kept, such
+   * that it can be run again.
+   *
+   * \param[in] pool The threads executing the tasks. Without a pool or with a
+   *            single thread, the tasks are executed by the calling thread in
+   *            the order in which they were added.
+   * \throw Rethrows the first exception caught in any task. The tasks which
+   *        did not start before are skipped.
+   */
+  void run(ThreadPool *pool) const;
+
+ private:
+  /// A task with the tasks waiting for it
+  struct Node {
+    /// The function to be executed
+    std::function<void()> task;
+    /// Number of tasks which have to be completed before this one
+    std::size_t n_dependencies = 0;
+    /// The tasks depending on this one
+    std::vector<TaskId> dependents;
+  };
+
+  /// The tasks in the order in which they were added
+  std::vector<Node> nodes_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_TASKGRAPH_H_
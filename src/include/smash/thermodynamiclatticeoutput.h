@@ -21,6 +21,7 @@
 #include "experimentparameters.h"
 #include "file.h"
 #include "forwarddeclarations.h"
+#include "hdf5latticefile.h"
 #include "logging.h"
 #include "outputinterface.h"
 #include "outputparameters.h"
@@ -51,11 +52,13 @@ class ThermodynamicLatticeOutput : public OutputInterface {
    * \param[in] out_par Parameters of output
    * \param[in] enable_ascii Bool (True or False) to enable ASCII format
    * \param[in] enable_binary Bool (True or False) to enable binary format
+   * \param[in] enable_hdf5 Bool (True or False) to enable HDF5 format
    */
   ThermodynamicLatticeOutput(const std::filesystem::path &path,
                              const std::string &name,
                              const OutputParameters &out_par,
-                             const bool enable_ascii, const bool enable_binary);
+                             const bool enable_ascii, const bool enable_binary,
+                             const bool enable_hdf5 = false);
   /// Default destructor
   ~ThermodynamicLatticeOutput();
   /**
@@ -137,6 +140,12 @@ class ThermodynamicLatticeOutput : public OutputInterface {
       RectangularLattice<EnergyMomentumTensor> &lattice,
       double current_time) override;
 
+  /// \return The event and intermediate time hooks, in which this output
+  /// writes.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet().set(EventHooks).set(IntermediateTimeHooks);
+  }
+
  private:
   /// Structure that holds all the information about what to printout
   const OutputParameters out_par_;
@@ -146,7 +155,8 @@ class ThermodynamicLatticeOutput : public OutputInterface {
    *
    * \param[in] description The description.
    * \param[in] event_number The event number.
-   * \param[in] type Flag for the file type: 'a' for ASCII, 'b' for Binary
+   * \param[in] type Flag for the file type: 'a' for ASCII, 'b' for Binary,
+   *            'h' for HDF5
    */
   std::string make_filename(const std::string &description,
                             const int event_number, const char type);
@@ -180,6 +190,16 @@ class ThermodynamicLatticeOutput : public OutputInterface {
   void write_therm_lattice_binary_header(std::shared_ptr<std::ofstream> file,
                                          const ThermodynamicQuantity &tq);
 
+  /**
+   * Creates the HDF5 file of a quantity, if the HDF5 format is enabled.
+   *
+   * \param[in] tq The quantity to be written, see ThermodynamicQuantity.
+   * \param[in] varname Name of the quantity and density type.
+   * \param[in] event_number The event number.
+   */
+  void open_hdf5_file(const ThermodynamicQuantity tq,
+                      const std::string &varname, const int event_number);
+
   /**
    * Convert a ThermodynamicQuantity into an int
    * \param[in] tq The quantity to be converted, see ThermodynamicQuantity.
@@ -198,6 +218,10 @@ class ThermodynamicLatticeOutput : public OutputInterface {
   std::map<ThermodynamicQuantity, std::shared_ptr<std::ofstream>>
       output_binary_files_;
 
+  /// map of output files for HDF5 format
+  std::map<ThermodynamicQuantity, std::unique_ptr<Hdf5LatticeFile>>
+      output_hdf5_files_;
+
   /// number of nodes in the lattice along the three axes
   std::array<int, 3> nodes_;
 
@@ -215,6 +239,9 @@ class ThermodynamicLatticeOutput : public OutputInterface {
   /// enable output type Binary
   bool enable_binary_;
 
+  /// enable output type HDF5
+  bool enable_hdf5_;
+
   /// enable output, of any kind (if False, the object does nothing)
   bool enable_output_;
 };
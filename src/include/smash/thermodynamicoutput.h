@@ -100,6 +100,12 @@ class ThermodynamicOutput : public OutputInterface {
                           const ThreeVector &line_start,
                           const ThreeVector &line_end, int n_points);
 
+  /// \return The event and intermediate time hooks, in which this output
+  /// writes.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet().set(EventHooks).set(IntermediateTimeHooks);
+  }
+
  private:
   /// Pointer to output file
   RenamingFilePtr file_;
@@ -0,0 +1,129 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_THREADPOOL_H_
+#define SRC_INCLUDE_SMASH_THREADPOOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smash {
+
+/**
+ * A fixed-size pool of worker threads executing indexed tasks.
+ *
+ * The pool is meant to distribute a number of independent units of work (e.g.
+ * the parallel ensembles of an event) among a given number of threads. The
+ * threads are created once at construction and reused for every call to
+ * parallel_for(), such that the overhead of a call is small compared to the
+ * work done in a timestep.
+ *
+ * The thread calling parallel_for() does not execute any task itself, but it
+ * waits until all tasks are done. This guarantees that thread-local state of
+ * the calling thread (e.g. its random number engine) is never touched by the
+ * tasks.
+ *
+ * If the threads are pinned, every worker thread is bound to its own CPU and
+ * executes the same indices in each call, see parallel_for(). Memory allocated
+ * and first written by a task then stays on the NUMA node of the CPU which
+ * works on it in later calls.
+ *
+ * \note Tasks must not call parallel_for() on the same pool, since this
+ * would deadlock.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Create a pool with the given number of worker threads.
+   *
+   * \param[in] n_threads Number of worker threads, it must be positive.
+   * \param[in] pinned Whether each worker thread is bound to one CPU. The
+   *            threads are spread evenly over the CPUs the process may run on,
+   *            such that consecutive threads share a socket if the CPUs of a
+   *            socket are numbered consecutively. Pinning is only supported
+   *            on Linux and ignored elsewhere.
+   * \throw std::invalid_argument if \p n_threads is not positive.
+   */
+  explicit ThreadPool(int n_threads, bool pinned = false);
+
+  /// Copying a pool of threads is not meaningful.
+  ThreadPool(const ThreadPool &) = delete;
+  /// Copying a pool of threads is not meaningful.
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// Stop and join all worker threads.
+  ~ThreadPool();
+
+  /// \return The number of worker threads.
+  int size() const { return static_cast<int>(workers_.size()); }
+
+  /// \return Whether the worker threads are pinned to CPUs.
+  bool pinned() const { return pinned_; }
+
+  /**
+   * Execute \p task for all indices in \f$[0, n)\f$ and wait for completion.
+   *
+   * Indices are handed out to the worker threads in increasing order, but the
+   * order in which tasks are completed is unspecified. If the threads are
+   * pinned, index \f$i\f$ is always executed by worker \f$i \bmod
+   * \mathrm{size()}\f$ instead of the next idle one. Hence, the tasks must
+   * not depend on each other and any result which has to be combined in a
+   * reproducible way has to be stored per index by the task itself.
+   *
+   * \param[in] n Number of tasks.
+   * \param[in] task Function to be called with the task index.
+   * \throw Rethrows the first exception caught in any task, after all tasks
+   *        have been processed.
+   */
+  void parallel_for(std::size_t n,
+                    const std::function<void(std::size_t)> &task);
+
+ private:
+  /**
+   * Loop run by every worker thread.
+   *
+   * \param[in] worker Number of the worker thread.
+   * \param[in] cpu CPU the thread is bound to, negative for none.
+   */
+  void work(std::size_t worker, int cpu);
+
+  /// The worker threads.
+  std::vector<std::thread> workers_;
+  /// Mutex protecting all the members below.
+  std::mutex mutex_;
+  /// Signals the workers that new tasks are available or that they shall stop.
+  std::condition_variable work_available_;
+  /// Signals the caller of parallel_for() that all tasks were completed.
+  std::condition_variable work_done_;
+  /// The function executed for each index of the current batch.
+  const std::function<void(std::size_t)> *task_ = nullptr;
+  /// Number of tasks of the current batch.
+  std::size_t n_tasks_ = 0;
+  /// Next index to be handed out to a worker.
+  std::size_t next_task_ = 0;
+  /// Next index to be handed out to each worker, if the threads are pinned.
+  std::vector<std::size_t> next_task_of_worker_;
+  /// Number of tasks of the current batch which have not been completed yet.
+  std::size_t pending_tasks_ = 0;
+  /// The first exception thrown by a task of the current batch, if any.
+  std::exception_ptr first_exception_ = nullptr;
+  /// Whether the workers shall finish.
+  bool stop_ = false;
+  /// Whether the worker threads are pinned to CPUs.
+  const bool pinned_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_THREADPOOL_H_
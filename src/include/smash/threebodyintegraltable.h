@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_THREEBODYINTEGRALTABLE_H_
+#define SRC_INCLUDE_SMASH_THREEBODYINTEGRALTABLE_H_
+
+#include <array>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace smash {
+
+/**
+ * Calculate the integral over the Dalitz plot of three particles,
+ * \f[I_3 = \int dm^2_{23}dm^2_{12} =
+ * \int^{(M-m_3)^2}_{(m_1+m_2)^2}[m^2_{23, max}- m^2_{23, min}]dm^2_{12}\f]
+ * with complete elliptic integrals, see PDG book (chapter Kinematics) for the
+ * definitions of the variables.
+ *
+ * \param[in] sqrts Total energy \f$M\f$ in the center-of-mass frame [GeV].
+ * \param[in] m1 Mass of the first particle [GeV].
+ * \param[in] m2 Mass of the second particle [GeV].
+ * \param[in] m3 Mass of the third particle [GeV].
+ * \return The integral [GeV^4], zero below the threshold.
+ */
+double three_body_integral(double sqrts, double m1, double m2, double m3);
+
+/**
+ * \ingroup data
+ *
+ * \brief Tabulation of the three-body phase-space integral of three masses
+ *
+ * The multi-particle reactions evaluate three_body_integral() for every
+ * candidate triplet, which needs four complete elliptic integrals. Here the
+ * integral is tabulated at equidistant values of the kinetic energy
+ * \f$\Delta = \sqrt{s} - m_1 - m_2 - m_3\f$ above the threshold and
+ * interpolated linearly. Close to the threshold the integral vanishes like
+ * \f$\Delta^2\f$, hence \f$I_3/\Delta^2\f$ is tabulated, which is smooth
+ * there. The value at the threshold is extrapolated quadratically from the
+ * next three ones. The relative error of the interpolation is below
+ * \f$10^{-4}\f$ for pions and nucleons. Above the tabulated range, the
+ * integral is calculated exactly.
+ *
+ * The tables are created when they are first needed and are shared by all
+ * threads.
+ */
+class ThreeBodyIntegralTable {
+ public:
+  /**
+   * Tabulate the integral.
+   *
+   * \param[in] m1 Mass of the first particle [GeV].
+   * \param[in] m2 Mass of the second particle [GeV].
+   * \param[in] m3 Mass of the third particle [GeV].
+   * \param[in] n_values Number of tabulated intervals.
+   * \param[in] delta_max Largest tabulated kinetic energy [GeV].
+   */
+  ThreeBodyIntegralTable(double m1, double m2, double m3, int n_values = 1000,
+                         double delta_max = 10.);
+
+  /**
+   * \param[in] sqrts Total energy in the center-of-mass frame [GeV].
+   * \return The interpolated integral [GeV^4].
+   */
+  double operator()(double sqrts) const;
+
+  /**
+   * \param[in] m1 Mass of the first particle [GeV].
+   * \param[in] m2 Mass of the second particle [GeV].
+   * \param[in] m3 Mass of the third particle [GeV].
+   * \return The table of the given masses, which is created if it does not
+   *         exist yet.
+   */
+  static const ThreeBodyIntegralTable &find(double m1, double m2, double m3);
+
+ private:
+  /// The masses of the particles
+  std::array<double, 3> masses_;
+  /// Sum of the masses
+  double threshold_;
+  /// Largest tabulated kinetic energy
+  double delta_max_;
+  /// Inverse distance of the tabulated kinetic energies
+  double inv_delta_;
+  /// \f$I_3/\Delta^2\f$ at the tabulated kinetic energies
+  std::vector<double> values_;
+
+  /// Identifies a table by the masses
+  using Key = std::array<double, 3>;
+  /// All tables created so far
+  static std::map<Key, std::unique_ptr<const ThreeBodyIntegralTable>> tables_;
+  /// Protects the creation of tables
+  static std::shared_mutex tables_mutex_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_THREEBODYINTEGRALTABLE_H_
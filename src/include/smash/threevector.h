@@ -289,25 +289,80 @@ double inline ThreeVector::get_theta() const {
   return (r > 0.) ? std::acos(x3() / r) : 0.;
 }
 
+/**
+ * \ingroup data
+ *
+ * A rotation by three Euler angles, which is applied to many vectors.
+ *
+ * The cosines and sines of the angles are computed once, such that rotating a
+ * vector costs no trigonometric functions. The results are identical to the
+ * ones of ThreeVector::rotate, which is implemented in terms of this class.
+ */
+class EulerRotation {
+ public:
+  /**
+   * \param[in] phi angle by which the first rotation is done about the z-axis.
+   * \param[in] theta angle by which the second rotation is done
+   *        about the rotated x-axis.
+   * \param[in] psi angle by which the third rotation is done
+   *        about the rotated z-axis.
+   * \see ThreeVector::rotate
+   */
+  EulerRotation(double phi, double theta, double psi)
+      : cos_phi_(std::cos(phi)),
+        sin_phi_(std::sin(phi)),
+        cos_theta_(std::cos(theta)),
+        sin_theta_(std::sin(theta)),
+        cos_psi_(std::cos(psi)),
+        sin_psi_(std::sin(psi)) {}
+
+  /**
+   * \param[in] v A vector.
+   * \return The rotated vector.
+   */
+  ThreeVector operator()(const ThreeVector &v) const {
+    const double x = v.x1(), y = v.x2(), z = v.x3();
+    return ThreeVector(
+        (cos_phi_ * cos_psi_ - sin_phi_ * cos_theta_ * sin_psi_) * x +
+            (-cos_phi_ * sin_psi_ - sin_phi_ * cos_theta_ * cos_psi_) * y +
+            (sin_phi_ * sin_theta_) * z,
+        (sin_phi_ * cos_psi_ + cos_phi_ * cos_theta_ * sin_psi_) * x +
+            (-sin_phi_ * sin_psi_ + cos_phi_ * cos_theta_ * cos_psi_) * y +
+            (-cos_phi_ * sin_theta_) * z,
+        (sin_theta_ * sin_psi_) * x + (sin_theta_ * cos_psi_) * y +
+            (cos_theta_)*z);
+  }
+
+  /**
+   * Rotate all vectors of a range in place.
+   *
+   * \param[in] first Start of the range.
+   * \param[in] last End of the range.
+   */
+  template <typename Iterator>
+  void apply(Iterator first, Iterator last) const {
+    for (; first != last; ++first) {
+      *first = (*this)(*first);
+    }
+  }
+
+ private:
+  /// Cosine of the angle phi
+  double cos_phi_;
+  /// Sine of the angle phi
+  double sin_phi_;
+  /// Cosine of the angle theta
+  double cos_theta_;
+  /// Sine of the angle theta
+  double sin_theta_;
+  /// Cosine of the angle psi
+  double cos_psi_;
+  /// Sine of the angle psi
+  double sin_psi_;
+};
+
 void inline ThreeVector::rotate(double phi, double theta, double psi) {
-  // Compute the cosine and sine for each angle.
-  const double cos_phi = std::cos(phi);
-  const double sin_phi = std::sin(phi);
-  const double cos_theta = std::cos(theta);
-  const double sin_theta = std::sin(theta);
-  const double cos_psi = std::cos(psi);
-  const double sin_psi = std::sin(psi);
-  // Get original coordinates.
-  std::array<double, 3> x_old = x_;
-  // Compute new coordinates.
-  x_[0] = (cos_phi * cos_psi - sin_phi * cos_theta * sin_psi) * x_old[0] +
-          (-cos_phi * sin_psi - sin_phi * cos_theta * cos_psi) * x_old[1] +
-          (sin_phi * sin_theta) * x_old[2];
-  x_[1] = (sin_phi * cos_psi + cos_phi * cos_theta * sin_psi) * x_old[0] +
-          (-sin_phi * sin_psi + cos_phi * cos_theta * cos_psi) * x_old[1] +
-          (-cos_phi * sin_theta) * x_old[2];
-  x_[2] = (sin_theta * sin_psi) * x_old[0] + (sin_theta * cos_psi) * x_old[1] +
-          (cos_theta)*x_old[2];
+  *this = EulerRotation(phi, theta, psi)(*this);
 }
 
 void inline ThreeVector::rotate_around_y(double theta) {
@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_TRACERECORDER_H_
+#define SRC_INCLUDE_SMASH_TRACERECORDER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace smash {
+
+/**
+ * Records the spans measured by one or several profilers as a timeline, which
+ * can be written in the Trace Event Format read by the Chrome tracing viewer
+ * and Perfetto.
+ *
+ * The spans are kept in a ring buffer of fixed capacity, such that the memory
+ * and the time for recording stay bounded. Once the buffer is full, the oldest
+ * spans are overwritten, hence the trace shows the end of the run. Spans may be
+ * recorded from several threads at once, every thread gets its own row in the
+ * timeline.
+ */
+class TraceRecorder {
+ public:
+  /// The clock used for the timeline
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \param[in] capacity The maximal number of spans kept.
+   * \throw std::invalid_argument if the capacity is not positive.
+   */
+  explicit TraceRecorder(std::size_t capacity);
+
+  /**
+   * Record a span. This may be called from several threads at once.
+   *
+   * \param[in] name The name of the span, which has to outlive the recorder.
+   * \param[in] start The start of the span.
+   * \param[in] end The end of the span.
+   * \param[in] ensemble The ensemble the span belongs to, -1 for none.
+   */
+  void record(const std::string &name, Clock::time_point start,
+              Clock::time_point end, int ensemble);
+
+  /// \return The number of spans kept.
+  std::size_t size() const;
+
+  /// \return The number of spans recorded, including overwritten ones.
+  uint64_t n_recorded() const;
+
+  /**
+   * Write the kept spans in the Trace Event Format, ordered by their start.
+   *
+   * \param[in] path The file to write to.
+   * \throw std::runtime_error if the file cannot be written.
+   */
+  void write(const std::filesystem::path &path) const;
+
+ private:
+  /// A recorded span
+  struct Span {
+    /// The name of the span
+    const std::string *name;
+    /// Start relative to the creation of the recorder [ns]
+    int64_t start_ns;
+    /// Duration [ns]
+    int64_t duration_ns;
+    /// The row of the thread in the timeline
+    int thread;
+    /// The ensemble the span belongs to, -1 for none
+    int ensemble;
+  };
+
+  /// Protects the buffer and the rows of the threads
+  mutable std::mutex mutex_;
+  /// The kept spans, a ring buffer once it is full
+  std::vector<Span> spans_;
+  /// The capacity of the ring buffer
+  const std::size_t capacity_;
+  /// Number of recorded spans, the next one is written at this modulo capacity
+  uint64_t n_recorded_ = 0;
+  /// The rows of the threads in the timeline, in the order of their first span
+  std::map<std::thread::id, int> threads_;
+  /// The origin of the timeline
+  const Clock::time_point origin_ = Clock::now();
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_TRACERECORDER_H_
@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_TYPECACHE_H_
+#define SRC_INCLUDE_SMASH_TYPECACHE_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "sha256.h"
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * \brief The particle types and decay modes as built from the input files
+ *
+ * Parsing the particles and decay modes, computing the Clebsch-Gordan factors
+ * of the isospin multiplets and normalizing the spectral functions takes a
+ * noticeable time at every start of SMASH. The result of these steps is held
+ * here in a plain form and stored in the tabulations directory, next to the
+ * tabulated resonance integrals. The file is only used, if it was written for
+ * the same hash of version, particles and decay modes. Restoring the types
+ * from it reproduces the tables of the text parsing bit by bit, including the
+ * order of all decay types.
+ */
+struct TypeCache {
+  /// A particle type
+  struct Type {
+    /// Name of the type
+    std::string name;
+    /// Pole mass
+    double mass;
+    /// Width at the pole
+    double width;
+    /// Whether the parity is positive
+    bool positive_parity;
+    /// PDG code as string
+    std::string pdgcode;
+    /// Normalization of the spectral function, negative if not computed
+    double norm_factor;
+  };
+  /// A decay type
+  struct Decay {
+    /// Index of the first mother type with this decay
+    std::uint32_t mother;
+    /// Angular momentum
+    std::int32_t angular_momentum;
+    /// Indices of the daughter types
+    std::vector<std::uint32_t> daughters;
+  };
+  /// A decay mode
+  struct Mode {
+    /// Index of the decay type
+    std::uint32_t decay;
+    /// Branching ratio
+    double weight;
+  };
+
+  /// All particle types, sorted by PDG code as in ParticleType::list_all
+  std::vector<Type> types;
+  /// All decay types, in the order they were created
+  std::vector<Decay> decays;
+  /// The decay modes of each particle type
+  std::vector<std::vector<Mode>> modes;
+
+  /**
+   * Take the global particle types and decay modes, which must have been
+   * created before.
+   *
+   * \return The cache of the types and decay modes.
+   */
+  static TypeCache from_tables();
+
+  /**
+   * Read a cache written by write().
+   *
+   * \param[in] file The file of the cache.
+   * \param[in] hash Hash of the version, particles and decay modes.
+   * \return The cache, or nothing if the file does not exist, is damaged or
+   *         was written for another hash.
+   */
+  static std::optional<TypeCache> read(const std::filesystem::path &file,
+                                       const sha256::Hash &hash);
+
+  /**
+   * Write the cache, such that no incomplete file is left behind.
+   *
+   * \param[in] file The file of the cache.
+   * \param[in] hash Hash of the version, particles and decay modes.
+   */
+  void write(const std::filesystem::path &file,
+             const sha256::Hash &hash) const;
+
+  /**
+   * Create the global particle types, isospin multiplets and decay modes,
+   * as ParticleType::create_type_list and DecayModes::load_decaymodes would.
+   */
+  void create_tables() const;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_TYPECACHE_H_
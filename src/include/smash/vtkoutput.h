@@ -11,10 +11,12 @@
 #define SRC_INCLUDE_SMASH_VTKOUTPUT_H_
 
 #include <filesystem>
+#include <ios>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "density.h"
 #include "forwarddeclarations.h"
@@ -26,6 +28,10 @@ namespace smash {
 /**
  * \ingroup output
  * SMASH output in a paraview format, intended for simple visualization.
+ *
+ * The files are written either in the legacy VTK text format or, with the
+ * `VTK_Binary` format, as XML VTK files with the arrays appended as raw binary
+ * data.
  */
 class VtkOutput : public OutputInterface {
  public:
@@ -35,9 +41,13 @@ class VtkOutput : public OutputInterface {
    * \param path Path to the output file.
    * \param name Name of the output.
    * \param out_par Additional information on the configured output.
+   * \param binary Whether XML VTK files with binary data are written.
+   *
+   * \throw std::invalid_argument if the output is compressed with an invalid
+   *        level or without zlib support.
    */
   VtkOutput(const std::filesystem::path &path, const std::string &name,
-            const OutputParameters &out_par);
+            const OutputParameters &out_par, bool binary = false);
   ~VtkOutput();
 
   /**
@@ -115,6 +125,12 @@ class VtkOutput : public OutputInterface {
       const std::string name1, const std::string name2,
       RectangularLattice<std::pair<ThreeVector, ThreeVector>> &lat) override;
 
+  /// \return The event and intermediate time hooks, in which this output
+  /// writes.
+  OutputHooksBitSet subscribed_hooks() const override {
+    return OutputHooksBitSet().set(EventHooks).set(IntermediateTimeHooks);
+  }
+
  private:
   /**
    * Write the given particles to the output.
@@ -123,6 +139,13 @@ class VtkOutput : public OutputInterface {
    */
   void write(const Particles &particles);
 
+  /**
+   * Write the given particles to an XML VTK file of an unstructured grid.
+   *
+   * \param particles The particles.
+   */
+  void write_binary(const Particles &particles);
+
   /**
    * Make a file name given a description and a counter.
    *
@@ -175,6 +198,63 @@ class VtkOutput : public OutputInterface {
   void write_vtk_vector(std::ofstream &file, RectangularLattice<T> &lat,
                         const std::string &varname, F &&function);
 
+  /**
+   * Finish the file of a lattice. Only the binary files are written here, from
+   * the arrays collected by write_vtk_scalar and write_vtk_vector.
+   *
+   * \param file Output file.
+   * \param lat Lattice corresponding to output.
+   */
+  template <typename T>
+  void finish_vtk_file(std::ofstream &file, RectangularLattice<T> &lat);
+
+  /// An array of an XML VTK file, which is appended as binary data
+  struct AppendedArray {
+    /// Element of the data set the array belongs to
+    std::string section;
+    /// Name of the array
+    std::string name;
+    /// VTK type of the values
+    std::string type;
+    /// Number of components per point or cell
+    int components;
+    /// The values
+    std::vector<char> bytes;
+  };
+
+  /**
+   * Add an array to the next binary file.
+   *
+   * \param section Element of the data set the array belongs to.
+   * \param name Name of the array.
+   * \param components Number of components per point or cell.
+   * \param values The values.
+   */
+  template <typename V>
+  void add_array(const std::string &section, const std::string &name,
+                 int components, const std::vector<V> &values);
+
+  /**
+   * Write an XML VTK file with the added arrays appended as binary data.
+   *
+   * \param file Output file.
+   * \param type Type of the data set.
+   * \param dataset_attributes Attributes of the data set element.
+   * \param piece_attributes Attributes of the piece element.
+   */
+  void write_appended(std::ofstream &file, const std::string &type,
+                      const std::string &dataset_attributes,
+                      const std::string &piece_attributes);
+
+  /**
+   * Encode an array with the size header of the appended data, compressing it
+   * if requested.
+   *
+   * \param array The array.
+   * \return The bytes to be appended.
+   */
+  std::vector<char> encode(const AppendedArray &array) const;
+
   /**
    * Create the key to access the \c vtk_output_counter_ map.
    *
@@ -214,6 +294,14 @@ class VtkOutput : public OutputInterface {
   bool is_thermodynamics_output_;
   /// Is the VTK output an output for fields
   bool is_fields_output_;
+  /// Whether XML VTK files with binary data are written
+  const bool binary_;
+  /// zlib level of the binary data, 0 if it is not compressed
+  const int compression_level_;
+  /// Mode in which the files are opened
+  const std::ios::openmode open_mode_;
+  /// The arrays of the next binary file
+  std::vector<AppendedArray> arrays_{};
 };
 
 }  // namespace smash
@@ -64,12 +64,12 @@ class WallCrossActionsFinder : public ActionFinderInterface {
    * \return List of all found wall crossings.
    */
   ActionList find_actions_in_cell(
-      const ParticleList &plist, double t_max, const double,
+      ParticleSpan plist, double t_max, const double,
       const std::vector<FourVector> &) const override;
 
   /// Ignore the neighbor searches for wall crossing
   ActionList find_actions_with_neighbors(
-      const ParticleList &, const ParticleList &, double,
+      ParticleSpan, ParticleSpan, double,
       const std::vector<FourVector> &) const override {
     return {};
   }
@@ -80,10 +80,19 @@ class WallCrossActionsFinder : public ActionFinderInterface {
       const std::vector<FourVector> &) const override {
     return {};
   }
+  /// Ignore the surrounding searches for wall crossing
+  ActionList find_actions_with_surrounding_particles(
+      const ParticleList &, const std::vector<const ParticleData *> &, double,
+      const std::vector<FourVector> &) const override {
+    return {};
+  }
 
   /// No final actions for wall crossing
   ActionList find_final_actions(const Particles &) const override { return {}; }
 
+  /// \return The name of the finder in the time profile
+  std::string name() const override { return "wall crossing finder"; }
+
  private:
   /// Periods in x,y,z directions in fm.
   const std::array<double, 3> l_;
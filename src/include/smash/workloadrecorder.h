@@ -0,0 +1,268 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_WORKLOADRECORDER_H_
+#define SRC_INCLUDE_SMASH_WORKLOADRECORDER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "forwarddeclarations.h"
+#include "fourvector.h"
+#include "particledata.h"
+#include "pdgcode.h"
+#include "processbranch.h"
+
+namespace smash {
+
+/**
+ * Records the inputs of the hot kernels during a run, such that the kernels
+ * can be replayed with the species and energies of production events, see
+ * \ref key_gen_workload_sampling_ "Workload_Sampling".
+ *
+ * Three kinds of inputs are recorded: the pairs of particles checked for a
+ * collision, which are also the inputs of the cross sections, the particles
+ * smeared onto a density lattice together with the geometry of the lattice
+ * and the smearing parameters, and the pairs of particles exciting strings.
+ * Every n-th input of each kind is kept, such that the recording takes a
+ * bounded fraction of the time of the run. The inputs may be recorded from
+ * several threads at once.
+ *
+ * The file starts with the four characters \c SMWL and the version of the
+ * format as a 16-bit integer, followed by the records in native byte order.
+ * Every record starts with a character for its kind: \c 'c' for a pair,
+ * \c 'l' for a lattice update and \c 's' for a string excitation.
+ */
+class WorkloadRecorder {
+ public:
+  /// The kinds of the recorded inputs
+  enum Kind : std::size_t {
+    /// Pairs checked for a collision
+    Pairs,
+    /// Lattice updates
+    Smearings,
+    /// String excitations
+    Strings,
+    /// Number of kinds
+    NKinds
+  };
+
+  /// The kinematics of a recorded particle
+  struct Particle {
+    /// Type of the particle
+    PdgCode pdgcode;
+    /// Position [fm]
+    FourVector position;
+    /// Momentum [GeV]
+    FourVector momentum;
+
+    /**
+     * \return The type and kinematics of a particle.
+     * \param[in] data The particle.
+     */
+    static Particle of(const ParticleData &data) {
+      return {data.pdgcode(), data.position(), data.momentum()};
+    }
+
+    /**
+     * \return A particle of the type with the kinematics, which has the given
+     *         id and no collision history.
+     * \param[in] id The id of the particle.
+     */
+    ParticleData to_particle_data(int id) const;
+  };
+
+  /// A pair of particles checked for a collision
+  struct Pair {
+    /// The particles
+    std::array<Particle, 2> particles;
+    /// Maximum time interval within which the collision can happen [fm]
+    double dt;
+    /// Volume of the grid cell for the stochastic criterion [fm\f$^3\f$]
+    double gcell_vol;
+  };
+
+  /// A pair of particles exciting a string
+  struct StringExcitation {
+    /// The particles
+    std::array<Particle, 2> particles;
+    /// The string process
+    ProcessType process;
+  };
+
+  /// The inputs of an update of a density lattice
+  struct Smearing {
+    /// Edge lengths of the lattice [fm]
+    std::array<double, 3> lattice_sizes;
+    /// Number of cells in each direction
+    std::array<int, 3> n_cells;
+    /// Origin of the lattice [fm]
+    std::array<double, 3> origin;
+    /// Whether the lattice is periodic
+    bool periodic;
+    /// The smeared density
+    DensityType density_type;
+    /// Whether the gradients are computed
+    bool compute_gradient;
+    /// Gaussian smearing width [fm]
+    double gaussian_sigma;
+    /// Cut-off of the Gaussian smearing in units of its width
+    double gauss_cutoff_in_sigma;
+    /// Testparticle number
+    int testparticles;
+    /// Mode of the derivatives
+    DerivativesMode derivatives_mode;
+    /// Mode of the rest frame density derivatives
+    RestFrameDensityDerivativesMode rho_derivatives_mode;
+    /// Smearing mode
+    SmearingMode smearing_mode;
+    /// Weight of the central cell in the discrete smearing
+    double discrete_weight;
+    /// Range of the triangular smearing in units of the lattice spacing
+    double triangular_range;
+    /// Whether only participants are smeared
+    bool only_participants;
+    /// The particles of each ensemble
+    std::vector<std::vector<Particle>> ensembles;
+  };
+
+  /// The inputs read from a file
+  struct Workload {
+    /// The pairs checked for a collision
+    std::vector<Pair> pairs;
+    /// The lattice updates
+    std::vector<Smearing> smearings;
+    /// The string excitations
+    std::vector<StringExcitation> strings;
+  };
+
+  /**
+   * Create the file and write its header.
+   *
+   * \param[in] path The file to write to.
+   * \param[in] interval Every interval-th input of each kind is recorded.
+   * \throw std::invalid_argument if the interval is not positive.
+   * \throw std::runtime_error if the file cannot be written.
+   */
+  WorkloadRecorder(const std::filesystem::path &path, int interval);
+
+  /// A recorder cannot be copied.
+  WorkloadRecorder(const WorkloadRecorder &) = delete;
+  /// A recorder cannot be copied.
+  WorkloadRecorder &operator=(const WorkloadRecorder &) = delete;
+
+  /// Stop recording, if this is the recorder of the run.
+  ~WorkloadRecorder();
+
+  /**
+   * Decide whether the next input of a kind is recorded, which is counted.
+   *
+   * \param[in] kind The kind of the input.
+   * \return Whether the input should be recorded.
+   */
+  bool sample(Kind kind) {
+    return seen_[kind].fetch_add(1, std::memory_order_relaxed) % interval_ ==
+           0;
+  }
+
+  /**
+   * Record a pair checked for a collision, if it is sampled.
+   *
+   * \param[in] data_a The first particle.
+   * \param[in] data_b The second particle.
+   * \param[in] dt Maximum time interval within which the collision can happen
+   * \param[in] gcell_vol Volume of the grid cell for the stochastic criterion
+   */
+  void record_pair(const ParticleData &data_a, const ParticleData &data_b,
+                   double dt, double gcell_vol);
+
+  /**
+   * Record a string excitation, if it is sampled.
+   *
+   * \param[in] incoming The two incoming particles.
+   * \param[in] process The string process.
+   */
+  void record_string(const ParticleList &incoming, ProcessType process);
+
+  /**
+   * Record a lattice update, which has to be sampled with sample() before,
+   * such that the particles are only copied if they are recorded.
+   *
+   * \param[in] smearing The inputs of the update.
+   */
+  void record(const Smearing &smearing);
+
+  /// \return The number of recorded inputs of each kind.
+  std::array<uint64_t, NKinds> n_recorded() const;
+
+  /// Write the buffered records to the file.
+  void flush();
+
+  /**
+   * Read the inputs recorded in a file.
+   *
+   * \param[in] path The file.
+   * \return The inputs in the order of the records.
+   * \throw std::runtime_error if the file cannot be read or is not a valid
+   *        workload.
+   */
+  static Workload read(const std::filesystem::path &path);
+
+  /**
+   * \return The recorder of the run, which the kernels pass their inputs to,
+   *         if it is recording.
+   */
+  static WorkloadRecorder *active() {
+    return active_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Set the recorder of the run.
+   *
+   * \param[in] recorder The recorder, null to stop recording.
+   */
+  static void set_active(WorkloadRecorder *recorder) {
+    active_.store(recorder, std::memory_order_relaxed);
+  }
+
+  /// The version of the format of the file
+  static constexpr std::uint16_t format_version = 1;
+
+ private:
+  /// Write the type and kinematics of a particle, the mutex has to be locked.
+  void write(const Particle &particle);
+
+  /// Write a value, the mutex has to be locked.
+  template <typename T>
+  void write(const T &value) {
+    file_.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  /// Record every interval-th input of each kind
+  const uint64_t interval_;
+  /// Number of inputs of each kind passed to sample()
+  std::array<std::atomic<uint64_t>, NKinds> seen_{};
+  /// Number of recorded inputs of each kind
+  std::array<uint64_t, NKinds> n_recorded_{};
+  /// Protects the file and the numbers of recorded inputs
+  mutable std::mutex mutex_;
+  /// The file
+  std::ofstream file_;
+  /// The recorder of the run
+  static std::atomic<WorkloadRecorder *> active_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_WORKLOADRECORDER_H_
@@ -32,14 +32,12 @@ InterpolateDataSpline::InterpolateDataSpline(const std::vector<double>& x,
   last_x_ = sorted_x.back();
   first_y_ = sorted_y.front();
   last_y_ = sorted_y.back();
-  acc_ = gsl_interp_accel_alloc();
   spline_ = gsl_spline_alloc(gsl_interp_cspline, N);
   gsl_spline_init(spline_, &(*sorted_x.begin()), &(*sorted_y.begin()), N);
 }
 
 InterpolateDataSpline::~InterpolateDataSpline() {
   gsl_spline_free(spline_);
-  gsl_interp_accel_free(acc_);
 }
 
 double InterpolateDataSpline::operator()(double xi) const {
@@ -50,8 +48,9 @@ double InterpolateDataSpline::operator()(double xi) const {
   if (xi > last_x_) {
     return last_y_;
   }
-  // cubic spline interpolation
-  return gsl_spline_eval(spline_, xi, acc_);
+  /* cubic spline interpolation, without an accelerator the interval is found
+   * by bisection and nothing is cached between calls */
+  return gsl_spline_eval(spline_, xi, nullptr);
 }
 
 }  // namespace smash
@@ -7,15 +7,45 @@
 
 #include "smash/interpolation2D.h"
 
+#include <algorithm>
+#include <cmath>
 #include <initializer_list>
 #include <iostream>
 #include <stdexcept>
 
 namespace smash {
 
+GridAxis::GridAxis(const std::vector<double>& x) : x_(x) {
+  if (x_.size() < 2) {
+    throw std::runtime_error("Need at least 2 points for a grid.");
+  }
+  double min_width = x_[1] - x_[0];
+  for (std::size_t i = 1; i < x_.size(); i++) {
+    if (!(x_[i] > x_[i - 1])) {
+      throw std::runtime_error("Grid points have to be strictly increasing.");
+    }
+    min_width = std::min(min_width, x_[i] - x_[i - 1]);
+  }
+  // Buckets of half the smallest interval hold at most one point each.
+  const double range = x_.back() - x_.front();
+  const auto n_buckets = static_cast<std::size_t>(std::ceil(2. * range /
+                                                            min_width));
+  inv_bucket_width_ = n_buckets / range;
+  first_point_.resize(n_buckets);
+  std::size_t i = 0;
+  for (std::size_t bucket = 0; bucket < n_buckets; bucket++) {
+    const double edge = x_.front() + bucket / inv_bucket_width_;
+    while (i + 2 < x_.size() && x_[i + 1] <= edge) {
+      i++;
+    }
+    first_point_[bucket] = static_cast<std::uint32_t>(i);
+  }
+}
+
 InterpolateData2DSpline::InterpolateData2DSpline(const std::vector<double>& x,
                                                  const std::vector<double>& y,
-                                                 const std::vector<double>& z) {
+                                                 const std::vector<double>& z,
+                                                 bool grid_lookup) {
   const size_t M = x.size();
   const size_t N = y.size();
 
@@ -49,6 +79,21 @@ InterpolateData2DSpline::InterpolateData2DSpline(const std::vector<double>& x,
   // Initialize bicubic spline interpolation
   spline_ = gsl_spline2d_alloc(gsl_interp2d_bicubic, M, N);
   gsl_spline2d_init(spline_, xa, ya, za, M, N);
+
+  if (grid_lookup) {
+    x_axis_.emplace(x);
+    y_axis_.emplace(y);
+    nodes_.resize(N * M);
+    for (size_t j = 0; j < N; j++) {
+      for (size_t i = 0; i < M; i++) {
+        nodes_[j * M + i] = {
+            z[j * M + i],
+            gsl_spline2d_eval_deriv_x(spline_, x[i], y[j], xacc_, yacc_),
+            gsl_spline2d_eval_deriv_y(spline_, x[i], y[j], xacc_, yacc_),
+            gsl_spline2d_eval_deriv_xy(spline_, x[i], y[j], xacc_, yacc_)};
+      }
+    }
+  }
 }
 
 InterpolateData2DSpline::~InterpolateData2DSpline() {
@@ -64,8 +109,44 @@ double InterpolateData2DSpline::operator()(double xi, double yi) const {
   yi = (yi < first_y_) ? first_y_ : yi;
   yi = (yi > last_y_) ? last_y_ : yi;
 
+  if (!nodes_.empty()) {
+    return evaluate_on_grid(xi, yi);
+  }
   // bicubic spline interpolation
   return gsl_spline2d_eval(spline_, xi, yi, xacc_, yacc_);
 }
 
+double InterpolateData2DSpline::evaluate_on_grid(double xi, double yi) const {
+  const std::vector<double>& x = x_axis_->points();
+  const std::vector<double>& y = y_axis_->points();
+  const size_t i = x_axis_->interval(xi);
+  const size_t j = y_axis_->interval(yi);
+  const double dx = x[i + 1] - x[i];
+  const double dy = y[j + 1] - y[j];
+  const double t = (xi - x[i]) / dx;
+  const double u = (yi - y[j]) / dy;
+
+  /* Cubic Hermite basis functions for the values at both ends of the
+   * interval and for the derivatives, the latter scaled by the width. */
+  const double t2 = t * t, t3 = t2 * t;
+  const double u2 = u * u, u3 = u2 * u;
+  const double value_t[2] = {2. * t3 - 3. * t2 + 1., -2. * t3 + 3. * t2};
+  const double slope_t[2] = {(t3 - 2. * t2 + t) * dx, (t3 - t2) * dx};
+  const double value_u[2] = {2. * u3 - 3. * u2 + 1., -2. * u3 + 3. * u2};
+  const double slope_u[2] = {(u3 - 2. * u2 + u) * dy, (u3 - u2) * dy};
+
+  const size_t M = x.size();
+  double result = 0.;
+  for (int b = 0; b < 2; b++) {
+    for (int a = 0; a < 2; a++) {
+      const Node& node = nodes_[(j + b) * M + i + a];
+      result += node.z * value_t[a] * value_u[b] +
+                node.dz_dx * slope_t[a] * value_u[b] +
+                node.dz_dy * value_t[a] * slope_u[b] +
+                node.d2z_dxdy * slope_t[a] * slope_u[b];
+    }
+  }
+  return result;
+}
+
 }  // namespace smash
@@ -7,11 +7,15 @@
 
 #include "smash/isoparticletype.h"
 
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 
 #include "smash/filelock.h"
 #include "smash/integrate.h"
 #include "smash/logging.h"
+#include "smash/tabulationfile.h"
 
 namespace smash {
 static constexpr int LParticleType = LogArea::ParticleType::id;
@@ -179,8 +183,10 @@ void IsoParticleType::create_multiplet(const ParticleType &type) {
   multiplet.add_state(type);
 }
 
-static Integrator integrate;
-static Integrator2d integrate2d;
+/* Every thread tabulating integrals, either in parallel or lazily while
+ * evolving ensembles, uses its own integrators. */
+static thread_local Integrator integrate;
+static thread_local Integrator2d integrate2d;
 
 /**
  * Tabulation of all N R integrals.
@@ -217,36 +223,80 @@ static std::unordered_map<std::string, Tabulation> DeltaR_tabulations;
  */
 static std::unordered_map<std::string, Tabulation> rhoR_tabulations;
 
+/// The kinds of resonance integrals, in the order of lazy_slots
+enum class IntegralKind { NR, piR, RK, DeltaR, rhoR };
+
+/// Number of kinds of resonance integrals
+static constexpr std::size_t n_integral_kinds = 5;
+
+/// Whether the integrals are tabulated on first use
+static bool lazy_tabulations = false;
+/// The hash of the particle properties for the lazily tabulated integrals
+static sha256::Hash lazy_hash;
+/// Directory of the lazily tabulated integrals, empty if they are not cached
+static std::filesystem::path lazy_dir;
+/// Lock of the tabulations directory, held while integrals may be tabulated
+static std::unique_ptr<FileLock> lazy_lock;
+/**
+ * The lazily tabulated integral of every kind and multiplet, once it was
+ * computed. Since a tabulation is never changed after it was stored, it is
+ * read without locking.
+ */
+static std::unique_ptr<std::atomic<const Tabulation *>[]> lazy_slots;
+/// Guards the lazy tabulation of integrals
+static std::mutex lazy_mutex;
+/// The memory-mapped file of all integrals, if it is used and valid
+static std::unique_ptr<TabulationFile> shared_file;
+
 static std::filesystem::path generate_tabulation_path(
     const std::filesystem::path &dir, const std::string &prefix,
     const std::string &res_name) {
   return dir / (prefix + res_name + ".bin");
 }
 
-inline void cache_integral(
-    std::unordered_map<std::string, Tabulation> &tabulations,
-    const std::filesystem::path &dir, sha256::Hash hash,
-    const IsoParticleType &part, const IsoParticleType &res,
-    const IsoParticleType *antires, bool unstable) {
+/**
+ * Read the tabulation of a resonance integral from the tabulations directory
+ * or compute it and store it there.
+ *
+ * \param[in] dir The tabulations directory, empty if nothing is cached.
+ * \param[in] hash The hash of the particle properties.
+ * \param[in] part The multiplet of the other particle.
+ * \param[in] res The multiplet of the resonance.
+ * \param[in] unstable Whether the other particle is unstable.
+ * \param[in] progress Whether the progress is printed.
+ * \return The tabulation.
+ */
+static Tabulation load_or_compute_integral(const std::filesystem::path &dir,
+                                           sha256::Hash hash,
+                                           const IsoParticleType &part,
+                                           const IsoParticleType &res,
+                                           bool unstable, bool progress) {
   constexpr double spacing = 2.0;
   constexpr double spacing2d = 3.0;
+  if (shared_file) {
+    Tabulation integral = shared_file->find(part.name_filtered_prime() +
+                                            res.name_filtered_prime());
+    if (!integral.is_empty()) {
+      return integral;
+    }
+  }
   const auto path = generate_tabulation_path(dir, part.name_filtered_prime(),
                                              res.name_filtered_prime());
   Tabulation integral;
   if (!dir.empty() && std::filesystem::exists(path)) {
     std::ifstream file(path.string());
     integral = Tabulation::from_file(file, hash);
-    if (!integral.is_empty()) {
+    if (!integral.is_empty() && progress) {
       // Only print message if the found tabulation was valid.
       std::cout << "Tabulation found at " << path.filename() << '\r'
                 << std::flush;
     }
   }
   if (integral.is_empty()) {
-    if (!dir.empty()) {
+    if (progress && !dir.empty()) {
       std::cout << "Caching tabulation to " << path.filename() << '\r'
                 << std::flush;
-    } else {
+    } else if (progress) {
       std::cout << "Calculating integral for " << part.name_filtered_prime()
                 << res.name_filtered_prime() << '\r' << std::flush;
     }
@@ -262,20 +312,73 @@ inline void cache_integral(
       integral.write(file, hash);
     }
   }
-  tabulations.emplace(std::make_pair(res.name(), integral));
-  if (antires != nullptr) {
-    tabulations.emplace(std::make_pair(antires->name(), integral));
+  return integral;
+}
+
+void IsoParticleType::prepare_concurrent_tabulation() {
+  for (const ParticleType &type : ParticleType::list_all()) {
+    type.min_mass_kinematic();
+    type.min_mass_spectral();
+    type.isospin();
   }
 }
 
 void IsoParticleType::tabulate_integrals(
-    sha256::Hash hash, const std::filesystem::path &tabulations_path) {
+    sha256::Hash hash, const std::filesystem::path &tabulations_path,
+    ThreadPool *thread_pool, bool lazy, bool shared) {
+  /* The shared file is written at once and atomically, hence it can be read
+   * without holding the lock. */
+  const std::filesystem::path shared_path =
+      tabulations_path / "resonance_integrals.bin";
+  const auto open_shared_file = [&]() {
+    shared_file = shared && !tabulations_path.empty()
+                      ? TabulationFile::open(shared_path, hash)
+                      : nullptr;
+  };
   // To avoid race conditions, make sure we are the only ones currently storing
   // tabulations. Otherwise, we ignore any stored tabulations and don't store
   // our results.
+  if (lazy) {
+    open_shared_file();
+    // The lock is held until the end of the run, when integrals may still be
+    // tabulated.
+    lazy_lock =
+        std::make_unique<FileLock>(tabulations_path / "tabulations.lock");
+    lazy_dir = lazy_lock->acquire() ? tabulations_path : "";
+    lazy_hash = hash;
+    const std::size_t n_slots = n_integral_kinds * iso_type_list.size();
+    lazy_slots = std::make_unique<std::atomic<const Tabulation *>[]>(n_slots);
+    for (std::size_t i = 0; i < n_slots; i++) {
+      lazy_slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+    prepare_concurrent_tabulation();
+    lazy_tabulations = true;
+    return;
+  }
+  /* Processes starting at the same time with the same particles cooperate:
+   * the first one tabulates and stores the integrals, while the others wait
+   * for it and then read its tables. Lazy tabulations cannot be waited for,
+   * since the lock is held until the end of the run. */
   FileLock lock(tabulations_path / "tabulations.lock");
-  const std::filesystem::path &dir = lock.acquire() ? tabulations_path : "";
-
+  const std::filesystem::path dir =
+      !tabulations_path.empty() && lock.acquire_or_wait() ? tabulations_path
+                                                          : "";
+  open_shared_file();
+
+  /// A resonance integral to be tabulated
+  struct Job {
+    /// The tabulations of the kind of integral
+    std::unordered_map<std::string, Tabulation> *tabulations;
+    /// The multiplet of the other particle
+    const IsoParticleType *part;
+    /// The multiplet of the resonance
+    const IsoParticleType *res;
+    /// The anti-multiplet of the resonance, sharing its tabulation
+    const IsoParticleType *antires;
+    /// Whether the other particle is unstable
+    bool unstable;
+  };
+  std::vector<Job> jobs;
   const auto nuc = IsoParticleType::try_find("N");
   const auto pion = IsoParticleType::try_find("π");
   const auto kaon = IsoParticleType::try_find("K");
@@ -285,28 +388,159 @@ void IsoParticleType::tabulate_integrals(
   for (const auto &res : IsoParticleType::list_baryon_resonances()) {
     const auto antires = res->anti_multiplet();
     if (nuc) {
-      cache_integral(NR_tabulations, dir, hash, *nuc, *res, antires, false);
+      jobs.push_back({&NR_tabulations, nuc, res, antires, false});
     }
     if (pion) {
-      cache_integral(piR_tabulations, dir, hash, *pion, *res, antires, false);
+      jobs.push_back({&piR_tabulations, pion, res, antires, false});
     }
     if (kaon) {
-      cache_integral(RK_tabulations, dir, hash, *kaon, *res, antires, false);
+      jobs.push_back({&RK_tabulations, kaon, res, antires, false});
     }
     if (delta) {
-      cache_integral(DeltaR_tabulations, dir, hash, *delta, *res, antires,
-                     true);
+      jobs.push_back({&DeltaR_tabulations, delta, res, antires, true});
     }
   }
   if (rho) {
-    cache_integral(rhoR_tabulations, dir, hash, *rho, *rho, nullptr, true);
+    jobs.push_back({&rhoR_tabulations, rho, rho, nullptr, true});
   }
   if (rho && h1) {
-    cache_integral(rhoR_tabulations, dir, hash, *rho, *h1, nullptr, true);
+    jobs.push_back({&rhoR_tabulations, rho, h1, nullptr, true});
+  }
+
+  std::vector<Tabulation> integrals(jobs.size());
+  if (thread_pool == nullptr || thread_pool->size() < 2) {
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+      integrals[i] = load_or_compute_integral(
+          dir, hash, *jobs[i].part, *jobs[i].res, jobs[i].unstable, true);
+    }
+  } else {
+    /* Every integral is tabulated by one thread on its own, hence the tables
+     * are the same as the ones tabulated serially. */
+    std::cout << "Tabulating " << jobs.size() << " integrals on "
+              << thread_pool->size() << " threads" << std::endl;
+    prepare_concurrent_tabulation();
+    thread_pool->parallel_for(jobs.size(), [&](std::size_t i) {
+      integrals[i] = load_or_compute_integral(
+          dir, hash, *jobs[i].part, *jobs[i].res, jobs[i].unstable, false);
+    });
+  }
+  if (shared && !dir.empty() &&
+      (!shared_file || shared_file->size() != jobs.size())) {
+    std::vector<std::pair<std::string, const Tabulation *>> named_integrals;
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+      named_integrals.emplace_back(
+          jobs[i].part->name_filtered_prime() +
+              jobs[i].res->name_filtered_prime(),
+          &integrals[i]);
+    }
+    std::cout << "Storing the tabulations in " << shared_path.filename()
+              << std::endl;
+    TabulationFile::write(shared_path, hash, named_integrals);
+  }
+  for (std::size_t i = 0; i < jobs.size(); i++) {
+    jobs[i].tabulations->emplace(jobs[i].res->name(), integrals[i]);
+    if (jobs[i].antires != nullptr) {
+      jobs[i].tabulations->emplace(jobs[i].antires->name(),
+                                   std::move(integrals[i]));
+    }
+  }
+
+  /* Bind the tabulations to the multiplets right away, such that they are only
+   * read afterwards, even if several ensembles are evolved concurrently. */
+  auto bind = [](std::unordered_map<std::string, Tabulation> &tabulations,
+                 const std::string &name, Tabulation *&tabulation) {
+    const auto found = tabulations.find(name);
+    if (found != tabulations.end()) {
+      tabulation = &found->second;
+    }
+  };
+  for (IsoParticleType &multiplet : iso_type_list) {
+    bind(NR_tabulations, multiplet.name(), multiplet.XS_NR_tabulation_);
+    bind(piR_tabulations, multiplet.name(), multiplet.XS_piR_tabulation_);
+    bind(RK_tabulations, multiplet.name(), multiplet.XS_RK_tabulation_);
+    bind(DeltaR_tabulations, multiplet.name(), multiplet.XS_DeltaR_tabulation_);
+    bind(rhoR_tabulations, multiplet.name(), multiplet.XS_rhoR_tabulation_);
   }
 }
 
+/**
+ * Look up a lazily tabulated resonance integral and tabulate it, if this is
+ * its first use. The anti-multiplet of a baryon resonance shares the
+ * tabulation of the resonance, as with the integrals tabulated in advance.
+ *
+ * \param[in] kind The kind of integral.
+ * \param[in] res The multiplet of the resonance.
+ * \return The tabulation.
+ * \throw ParticleNotFoundFailure if the other particle of the integral does
+ *        not exist.
+ */
+static const Tabulation &lazy_integral(IntegralKind kind,
+                                       const IsoParticleType &res) {
+  const auto index = std::addressof(res) - std::addressof(iso_type_list[0]);
+  std::atomic<const Tabulation *> &slot =
+      lazy_slots[static_cast<std::size_t>(kind) * iso_type_list.size() +
+                 index];
+  const Tabulation *found = slot.load(std::memory_order_acquire);
+  if (found) {
+    return *found;
+  }
+  std::lock_guard<std::mutex> guard(lazy_mutex);
+  // Another thread may have tabulated the integral in the meantime
+  found = slot.load(std::memory_order_relaxed);
+  if (found) {
+    return *found;
+  }
+  const IsoParticleType *tabulated = &res;
+  if (res.get_states()[0]->pdgcode().baryon_number() < 0 &&
+      res.has_anti_multiplet()) {
+    tabulated = res.anti_multiplet();
+  }
+  std::unordered_map<std::string, Tabulation> *tabulations = nullptr;
+  const IsoParticleType *part = nullptr;
+  bool unstable = false;
+  switch (kind) {
+    case IntegralKind::NR:
+      tabulations = &NR_tabulations;
+      part = &IsoParticleType::find("N");
+      break;
+    case IntegralKind::piR:
+      tabulations = &piR_tabulations;
+      part = &IsoParticleType::find("π");
+      break;
+    case IntegralKind::RK:
+      tabulations = &RK_tabulations;
+      part = &IsoParticleType::find("K");
+      break;
+    case IntegralKind::DeltaR:
+      tabulations = &DeltaR_tabulations;
+      part = &IsoParticleType::find("Δ");
+      unstable = true;
+      break;
+    case IntegralKind::rhoR:
+      tabulations = &rhoR_tabulations;
+      part = &IsoParticleType::find("ρ");
+      unstable = true;
+      break;
+  }
+  auto existing = tabulations->find(tabulated->name());
+  if (existing == tabulations->end()) {
+    logg[LParticleType].debug("Tabulating the integral of ", part->name(),
+                              " and ", tabulated->name());
+    existing = tabulations
+                   ->emplace(tabulated->name(),
+                             load_or_compute_integral(lazy_dir, lazy_hash,
+                                                      *part, *tabulated,
+                                                      unstable, false))
+                   .first;
+  }
+  slot.store(&existing->second, std::memory_order_release);
+  return existing->second;
+}
+
 double IsoParticleType::get_integral_NR(double sqrts) {
+  if (lazy_tabulations) {
+    return lazy_integral(IntegralKind::NR, *this).get_value_linear(sqrts);
+  }
   if (XS_NR_tabulation_ == nullptr) {
     const auto res = states_[0]->iso_multiplet();
     XS_NR_tabulation_ = &NR_tabulations.at(res->name());
@@ -315,6 +549,9 @@ double IsoParticleType::get_integral_NR(double sqrts) {
 }
 
 double IsoParticleType::get_integral_piR(double sqrts) {
+  if (lazy_tabulations) {
+    return lazy_integral(IntegralKind::piR, *this).get_value_linear(sqrts);
+  }
   if (XS_piR_tabulation_ == nullptr) {
     const auto res = states_[0]->iso_multiplet();
     XS_piR_tabulation_ = &piR_tabulations.at(res->name());
@@ -323,6 +560,9 @@ double IsoParticleType::get_integral_piR(double sqrts) {
 }
 
 double IsoParticleType::get_integral_RK(double sqrts) {
+  if (lazy_tabulations) {
+    return lazy_integral(IntegralKind::RK, *this).get_value_linear(sqrts);
+  }
   if (XS_RK_tabulation_ == nullptr) {
     const auto res = states_[0]->iso_multiplet();
     XS_RK_tabulation_ = &RK_tabulations.at(res->name());
@@ -331,6 +571,9 @@ double IsoParticleType::get_integral_RK(double sqrts) {
 }
 
 double IsoParticleType::get_integral_rhoR(double sqrts) {
+  if (lazy_tabulations) {
+    return lazy_integral(IntegralKind::rhoR, *this).get_value_linear(sqrts);
+  }
   if (XS_rhoR_tabulation_ == nullptr) {
     const auto res = states_[0]->iso_multiplet();
     XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
@@ -342,18 +585,27 @@ double IsoParticleType::get_integral_RR(IsoParticleType *type_res_2,
                                         double sqrts) {
   const auto res = states_[0]->iso_multiplet();
   if (type_res_2->states_[0]->is_Delta()) {
+    if (lazy_tabulations) {
+      return lazy_integral(IntegralKind::DeltaR, *res).get_value_linear(sqrts);
+    }
     if (XS_DeltaR_tabulation_ == nullptr) {
       XS_DeltaR_tabulation_ = &DeltaR_tabulations.at(res->name());
     }
     return XS_DeltaR_tabulation_->get_value_linear(sqrts);
   }
   if (type_res_2->name() == "ρ") {
+    if (lazy_tabulations) {
+      return lazy_integral(IntegralKind::rhoR, *res).get_value_linear(sqrts);
+    }
     if (XS_rhoR_tabulation_ == nullptr) {
       XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
     }
     return XS_rhoR_tabulation_->get_value_linear(sqrts);
   }
   if (type_res_2->name() == "h₁(1170)") {
+    if (lazy_tabulations) {
+      return lazy_integral(IntegralKind::rhoR, *res).get_value_linear(sqrts);
+    }
     if (XS_rhoR_tabulation_ == nullptr) {
       XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
     }
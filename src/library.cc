@@ -10,15 +10,20 @@
 #include "smash/library.h"
 
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 
 #include "smash/configuration.h"
 #include "smash/decaymodes.h"
+#include "smash/filelock.h"
 #include "smash/input_keys.h"
 #include "smash/inputfunctions.h"
 #include "smash/isoparticletype.h"
 #include "smash/logging.h"
 #include "smash/setup_particles_decaymodes.h"
 #include "smash/stringfunctions.h"
+#include "smash/typecache.h"
 
 namespace smash {
 static constexpr int LMain = LogArea::Main::id;
@@ -46,21 +51,26 @@ Configuration setup_config_and_logging(
 void initialize_particles_decays_and_tabulations(
     Configuration &configuration, const std::string &version,
     const std::string &tabulations_dir) {
-  const auto hash =
-      initialize_particles_decays_and_return_hash(configuration, version);
-  tabulate_resonance_integrals(hash, tabulations_dir);
+  const auto hash = initialize_particles_decays_and_return_hash(
+      configuration, version, tabulations_dir);
+  const int tabulation_threads =
+      configuration.take(InputKeys::gen_tabulationThreads);
+  const bool lazy_tabulations =
+      configuration.take(InputKeys::gen_lazyTabulations);
+  const bool shared_tabulations =
+      configuration.take(InputKeys::gen_sharedTabulations);
+  tabulate_resonance_integrals(hash, tabulations_dir, tabulation_threads,
+                               lazy_tabulations, shared_tabulations);
 }
 
 sha256::Hash initialize_particles_decays_and_return_hash(
-    Configuration &configuration, const std::string &version) {
+    Configuration &configuration, const std::string &version,
+    const std::string &tabulations_dir) {
   logg[LMain].trace(SMASH_SOURCE_LOCATION,
                     " create ParticleType and DecayModes");
   const std::string particles_string = configuration.take(InputKeys::particles);
   const std::string decaymodes_string =
       configuration.take(InputKeys::decaymodes);
-  ParticleType::create_type_list(particles_string);
-  DecayModes::load_decaymodes(decaymodes_string);
-  ParticleType::check_consistency();
 
   // Calculate a hash of the SMASH version, the particles and decaymodes.
   sha256::Context hash_context;
@@ -69,19 +79,57 @@ sha256::Hash initialize_particles_decays_and_return_hash(
   hash_context.update(decaymodes_string);
   const auto hash = hash_context.finalize();
   logg[LMain].info() << "Config hash: " << sha256::hash_to_string(hash);
+
+  const std::filesystem::path cache_path =
+      tabulations_dir.empty()
+          ? std::filesystem::path()
+          : std::filesystem::path(tabulations_dir) / "particle_types.bin";
+  const auto cache = cache_path.empty() ? std::nullopt
+                                        : TypeCache::read(cache_path, hash);
+  if (cache) {
+    logg[LMain].info() << "Particle types and decay modes read from "
+                       << cache_path;
+    cache->create_tables();
+  } else {
+    ParticleType::create_type_list(particles_string);
+    DecayModes::load_decaymodes(decaymodes_string);
+  }
+  ParticleType::check_consistency();
+  if (!cache && !cache_path.empty()) {
+    // Another run storing the same cache at the moment writes it for us.
+    std::filesystem::create_directories(cache_path.parent_path());
+    FileLock lock(cache_path.parent_path() / "particle_types.lock");
+    if (lock.acquire()) {
+      TypeCache::from_tables().write(cache_path, hash);
+    }
+  }
   return hash;
 }
 
 void tabulate_resonance_integrals(const sha256::Hash &hash,
-                                  const std::string &tabulations_dir) {
-  logg[LMain].info("Tabulating cross section integrals...");
+                                  const std::string &tabulations_dir,
+                                  int n_threads, bool lazy, bool shared) {
+  if (n_threads < 1) {
+    throw std::invalid_argument(
+        "The number of tabulation threads must be positive.");
+  }
+  if (lazy) {
+    logg[LMain].info("Cross section integrals are tabulated on first use.");
+  } else {
+    logg[LMain].info("Tabulating cross section integrals...");
+  }
   std::filesystem::path tabulations_path(tabulations_dir);
   if (!tabulations_path.empty()) {
     // Store tabulations on disk
     std::filesystem::create_directories(tabulations_path);
     logg[LMain].info() << "Tabulations path: " << tabulations_path;
   }
-  IsoParticleType::tabulate_integrals(hash, tabulations_path);
+  std::unique_ptr<ThreadPool> thread_pool;
+  if (n_threads > 1 && !lazy) {
+    thread_pool = std::make_unique<ThreadPool>(n_threads);
+  }
+  IsoParticleType::tabulate_integrals(hash, tabulations_path,
+                                      thread_pool.get(), lazy, shared);
 }
 
 static Configuration create_configuration(
@@ -9,15 +9,23 @@
 
 #include "smash/listmodus.h"
 
+#include <algorithm>
 #include <array>
+#include <cerrno>
+#include <cfloat>
+#include <charconv>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <list>
 #include <map>
+#include <set>
 #include <sstream>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -29,8 +37,10 @@
 #include "smash/fourvector.h"
 #include "smash/inputfunctions.h"
 #include "smash/logging.h"
+#include "smash/outputparameters.h"
 #include "smash/particledata.h"
 #include "smash/propagation.h"
+#include "smash/stringfunctions.h"
 #include "smash/threevector.h"
 #include "smash/wallcrossingaction.h"
 
@@ -49,9 +59,11 @@ ListModus::ListModus(Configuration modus_config,
    * is only one child and this approach is fine enough, although ugly.
    */
   const bool is_list =
-      modus_config.has_value(InputKeys::modi_list_fileDirectory);
+      modus_config.has_value(InputKeys::modi_list_fileDirectory) ||
+      modus_config.has_value(InputKeys::modi_list_stream);
   const bool is_list_box =
-      modus_config.has_value(InputKeys::modi_listBox_fileDirectory);
+      modus_config.has_value(InputKeys::modi_listBox_fileDirectory) ||
+      modus_config.has_value(InputKeys::modi_listBox_stream);
   if (is_list == is_list_box) {
     throw std::logic_error(
         "Unexpected error in ListModus constructor. Either List or ListBox "
@@ -59,16 +71,20 @@ ListModus::ListModus(Configuration modus_config,
   }
   Key<std::string> file_prefix_key = InputKeys::modi_list_filePrefix,
                    file_directory_key = InputKeys::modi_list_fileDirectory,
-                   filename_key = InputKeys::modi_list_filename;
+                   filename_key = InputKeys::modi_list_filename,
+                   stream_key = InputKeys::modi_list_stream;
   Key<int> shift_id_key = InputKeys::modi_list_shiftId;
   Key<std::vector<std::string>> optional_quantities_key =
       InputKeys::modi_list_optionalQuantities;
+  Key<std::string> file_format_key = InputKeys::modi_list_fileFormat;
   if (is_list_box) {
     file_prefix_key = InputKeys::modi_listBox_filePrefix;
     file_directory_key = InputKeys::modi_listBox_fileDirectory;
     filename_key = InputKeys::modi_listBox_filename;
+    stream_key = InputKeys::modi_listBox_stream;
     shift_id_key = InputKeys::modi_listBox_shiftId;
     optional_quantities_key = InputKeys::modi_listBox_optionalQuantities;
+    file_format_key = InputKeys::modi_listBox_fileFormat;
   }
 
   // Set the default values for the spin interaction type
@@ -77,10 +93,30 @@ ListModus::ListModus(Configuration modus_config,
   // Impose strict requirement on possible keys present in configuration file
   const bool file_prefix_used = modus_config.has_value(file_prefix_key);
   const bool filename_used = modus_config.has_value(filename_key);
-  if (file_prefix_used == filename_used) {
+  const bool stream_used = modus_config.has_value(stream_key);
+  if (file_prefix_used + filename_used + stream_used != 1) {
     throw std::invalid_argument(
-        "Either 'Filename' or 'File_Prefix' key must be used in 'Modi' section "
-        "in configuration file. Please, adjust your configuration file.");
+        "Exactly one of the 'Filename', 'File_Prefix' and 'Stream' keys must "
+        "be used in 'Modi' section in configuration file. Please, adjust your "
+        "configuration file.");
+  }
+  if (param.n_ensembles > 1) {
+    throw std::runtime_error("ListModus only makes sense with one ensemble");
+  }
+  optional_fields_ = modus_config.take(optional_quantities_key);
+  const std::string file_format = modus_config.take(file_format_key);
+  if (file_format == "Binary") {
+    file_format_ = ParticleListFile::Format::Binary;
+  } else if (file_format != "ASCII") {
+    throw std::invalid_argument("Unknown particle list file format '" +
+                                file_format + "'.");
+  }
+  if (stream_used) {
+    // The events of a stream can only be read once and are validated later
+    stream_ = std::make_shared<ParticleListStream>(
+        modus_config.take(stream_key), file_format_);
+    validate_optional_fields_();
+    return;
   }
   if (file_prefix_used) {
     particle_list_filename_or_prefix_ = modus_config.take(file_prefix_key);
@@ -89,16 +125,17 @@ ListModus::ListModus(Configuration modus_config,
     particle_list_filename_or_prefix_ = modus_config.take(filename_key);
   }
   particle_list_file_directory_ = modus_config.take(file_directory_key);
-  if (param.n_ensembles > 1) {
-    throw std::runtime_error("ListModus only makes sense with one ensemble");
-  }
-  optional_fields_ = modus_config.take(optional_quantities_key);
   validate_list_of_particles_of_all_events_();
   validate_optional_fields_();
 }
 
 /* console output on startup of List specific parameters */
 std::ostream &operator<<(std::ostream &out, const ListModus &m) {
+  if (m.stream_) {
+    out << "-- List Modus\nInput stream for external particle lists:\n"
+        << m.stream_->source() << "\n";
+    return out;
+  }
   out << "-- List Modus\nInput directory for external particle lists:\n"
       << m.particle_list_file_directory_ << "\n";
   return out;
@@ -266,6 +303,11 @@ void ListModus::insert_optional_quantities_to_(
 double ListModus::initial_conditions(Particles *particles,
                                      const ExperimentParameters &) {
   read_particles_from_next_event_(*particles);
+  if (stream_ && is_list_of_particles_invalid(*particles, event_id_)) {
+    throw InvalidEvents(
+        "More than 2 particles with the same 4-position have been found in "
+        "the same event.\nPlease, check your particles list stream.");
+  }
   if (particles->size() > 0) {
     backpropagate_to_same_time_if_needed_(*particles);
   } else {
@@ -276,45 +318,204 @@ double ListModus::initial_conditions(Particles *particles,
   return start_time_;
 }
 
-void ListModus::read_particles_from_next_event_(Particles &particles) {
-  std::string particle_list = next_event_();
-  const std::vector<Line> event_content = line_parser(particle_list);
-  if (event_content.empty()) {
-    if (verbose_) {
-      logg[LList].warn(
-          "Encountered empty event while reading input particle lists data, "
-          "which will result in empty events in the output file!");
+/**
+ * Cut the next whitespace separated field from a line.
+ *
+ * \param[in,out] line The rest of the line, the field is removed from it.
+ * \return The field, which is empty if the line has no fields left.
+ */
+static std::string_view next_field(std::string_view &line) {
+  constexpr std::string_view whitespace = " \t\r\v\f";
+  const std::size_t begin = line.find_first_not_of(whitespace);
+  if (begin == std::string_view::npos) {
+    line = {};
+    return {};
+  }
+  const std::size_t end = std::min(line.find_first_of(whitespace, begin),
+                                   line.size());
+  const std::string_view field = line.substr(begin, end - begin);
+  line.remove_prefix(end);
+  return field;
+}
+
+/**
+ * Convert a whole field to a number.
+ *
+ * \param[in] field The text of the field.
+ * \param[out] value The number, if the conversion succeeded.
+ * \return Whether the field is a valid number of the given type.
+ */
+template <typename T>
+static bool parse_field(std::string_view field, T &value) {
+  // Unlike the stream operators, std::from_chars does not accept a plus sign
+  if (field.size() > 1 && field[0] == '+' && field[1] != '-') {
+    field.remove_prefix(1);
+  }
+  const char *const end = field.data() + field.size();
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  const auto result = std::from_chars(field.data(), end, value);
+  return result.ec == std::errc{} && result.ptr == end;
+#else
+  if constexpr (std::is_integral_v<T>) {
+    const auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc{} && result.ptr == end;
+  } else {
+    // The floating point overloads of std::from_chars are not available
+    const std::string copy{field};
+    char *parsed_end = nullptr;
+    errno = 0;
+    value = std::strtod(copy.c_str(), &parsed_end);
+    return !copy.empty() && errno == 0 &&
+           parsed_end == copy.c_str() + copy.size();
+  }
+#endif
+}
+
+/**
+ * \return A string which is converted back to exactly the given number.
+ * \param[in] value The number to be converted.
+ */
+static std::string exact_string(double value) {
+  char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  return std::string{buffer, result.ptr};
+#else
+  const int length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+  return std::string{buffer, buffer + length};
+#endif
+}
+
+/// \return The value of the given type at the given position.
+template <typename T>
+static T read_binary(const char *position) {
+  T value;
+  std::memcpy(&value, position, sizeof(T));
+  return value;
+}
+
+void ListModus::read_binary_particles_(std::string_view blocks,
+                                       Particles &particles) {
+  // The ASCII and binary outputs use the same integer quantities
+  static const std::set<std::string> integer_quantities = {
+      "pdg", "ID", "charge", "ncoll", "proc_id_origin", "proc_type_origin",
+      "pdg_mother1", "pdg_mother2", "baryon_number", "strangeness"};
+  const std::vector<std::string> &quantities =
+      (stream_ ? stream_->format_variant() : file_->format_variant()) == 0
+          ? OutputDefaultQuantities::oscar2013
+          : OutputDefaultQuantities::oscar2013extended;
+  // Byte offsets of the quantities in a particle line
+  std::map<std::string, std::size_t> offsets;
+  std::size_t line_size = 0;
+  for (const std::string &quantity : quantities) {
+    offsets[quantity] = line_size;
+    line_size += integer_quantities.count(quantity) > 0 ? sizeof(std::int32_t)
+                                                        : sizeof(double);
+  }
+  // The optional quantities are taken from the particle lines
+  std::vector<std::pair<std::size_t, bool>> optional_columns;
+  for (const std::string &field : optional_fields_) {
+    const std::string quantity =
+        field == "proc_type" ? "proc_type_origin" : field;
+    if (offsets.count(quantity) == 0) {
+      throw std::invalid_argument("The optional quantity '" + field +
+                                  "' is not part of the binary particle "
+                                  "lists.");
+    }
+    optional_columns.emplace_back(offsets[quantity],
+                                  integer_quantities.count(quantity) > 0);
+  }
+  const std::size_t pdg_offset = offsets["pdg"];
+
+  std::vector<std::string> optional_quantities(optional_fields_.size());
+  // The layout of the blocks was checked when the file was mapped
+  const char *position = blocks.data();
+  const char *const end = blocks.data() + blocks.size();
+  bool event_is_empty = true;
+  while (position < end) {
+    // Skip the block type and the event and ensemble numbers
+    position += sizeof(char) + 2 * sizeof(std::int32_t);
+    const auto n_particles = read_binary<std::uint32_t>(position);
+    position += sizeof(std::uint32_t);
+    for (std::uint32_t i = 0; i < n_particles; i++, position += line_size) {
+      event_is_empty = false;
+      // The lines start with t, x, y, z, mass, p0, px, py and pz
+      std::array<double, 9> values;
+      std::memcpy(values.data(), position, sizeof(values));
+      for (std::size_t j = 0; j < optional_columns.size(); j++) {
+        const char *column = position + optional_columns[j].first;
+        optional_quantities[j] =
+            optional_columns[j].second
+                ? std::to_string(read_binary<std::int32_t>(column))
+                : exact_string(read_binary<double>(column));
+      }
+      const PdgCode pdgcode = PdgCode::from_decimal(
+          read_binary<std::int32_t>(position + pdg_offset));
+      logg[LList].debug("Particle ", pdgcode, " (x,y,z)= (", values[1], ", ",
+                        values[2], ", ", values[3], ")");
+      try_create_particle(particles, pdgcode, values[0], values[1], values[2],
+                          values[3], values[4], values[5], values[6],
+                          values[7], values[8], optional_quantities);
     }
+  }
+  if (event_is_empty && verbose_) {
+    logg[LList].warn(
+        "Encountered empty event while reading input particle lists data, "
+        "which will result in empty events in the output file!");
+  }
+}
+
+void ListModus::read_particles_from_next_event_(Particles &particles) {
+  const ParticleListFile::Event event = next_event_();
+  if (file_format_ == ParticleListFile::Format::Binary) {
+    read_binary_particles_(event.content, particles);
     return;
   }
-  for (const Line &line : event_content) {
-    std::istringstream lineinput(line.text);
+  std::string_view text = event.content;
+  bool event_is_empty = true;
+  std::vector<std::string> optional_quantities(optional_fields_.size());
+  for (int line_number = event.first_line; !text.empty(); line_number++) {
+    const std::size_t newline = std::min(text.find('\n'), text.size());
+    std::string_view line = text.substr(0, newline);
+    text.remove_prefix(std::min(newline + 1, text.size()));
+    // Comments are removed from the line
+    line = line.substr(0, line.find('#'));
+    std::string_view fields = line;
+    const std::string_view pdg_field = next_field(fields);
+    if (pdg_field.empty()) {
+      // Only whitespace (or nothing) on this line
+      continue;
+    }
+    event_is_empty = false;
+    int id;
     double t, x, y, z, mass, E, px, py, pz;
-    std::string pdg_string;
-    lineinput >> id >> t >> x >> y >> z >> mass >> E >> px >> py >> pz ;
-    pdg_string = std::to_string(id);
-    std::vector<std::string> optional_quantities(optional_fields_.size());
-    for (size_t i = 0; i < optional_fields_.size(); ++i) {
-      std::string opt{};
-      lineinput >> opt;
-      optional_quantities[i] = std::move(opt);
-    }    
-    
-
-    if (lineinput.fail()) {
+    bool is_valid = parse_field(pdg_field, id);
+    for (double *value : {&t, &x, &y, &z, &mass, &E, &px, &py, &pz}) {
+      is_valid = is_valid && parse_field(next_field(fields), *value);
+    }
+    for (std::string &quantity : optional_quantities) {
+      const std::string_view field = next_field(fields);
+      is_valid = is_valid && !field.empty();
+      quantity.assign(field);
+    }
+    if (!is_valid) {
       throw LoadFailure(
           build_error_string("While loading external particle lists data:\n"
                              "Failed to convert the input string to the "
                              "expected data types.",
-                             line));
+                             Line(line_number, trim(std::string(line)))));
     }
-    PdgCode pdgcode(pdg_string);
+    PdgCode pdgcode(std::to_string(id));
     logg[LList].debug("Particle ", pdgcode, " (x,y,z)= (", x, ", ", y, ", ", z,
                       ")");
-    charge = pdgcode.charge();
     try_create_particle(particles, pdgcode, t, x, y, z, mass, E, px, py, pz,
                         optional_quantities);
   }
+  if (event_is_empty && verbose_) {
+    logg[LList].warn(
+        "Encountered empty event while reading input particle lists data, "
+        "which will result in empty events in the output file!");
+  }
 }
 
 std::filesystem::path ListModus::file_path_(std::optional<int> file_id) {
@@ -344,17 +545,29 @@ std::filesystem::path ListModus::file_path_(std::optional<int> file_id) {
   return fpath;
 }
 
-std::string ListModus::next_event_() {
-  const std::filesystem::path fpath = file_path_(file_id_);
-  std::ifstream ifs{fpath};
-  ifs.seekg(last_read_position_);
+ParticleListFile::Event ListModus::next_event_() {
+  if (stream_) {
+    std::optional<ParticleListStream::Event> event = stream_->next();
+    if (!event) {
+      throw std::runtime_error(
+          "Attempt to read in next event in ListModus object but no further "
+          "data found in the provided stream. Please, check your setup.");
+    }
+    stream_event_ = std::move(event->content);
+    return {stream_event_, event->first_line};
+  }
 
-  if (!file_has_events_(fpath, last_read_position_)) {
+  if (!file_) {
+    file_ = std::make_shared<const ParticleListFile>(file_path_(file_id_),
+                                                   file_format_);
+    next_event_in_file_ = 0;
+  }
+
+  if (next_event_in_file_ >= file_->size()) {
     if (file_id_) {
       // Get next file and call this function recursively
       (*file_id_)++;
-      last_read_position_ = 0;
-      ifs.close();
+      file_ = nullptr;
       return next_event_();
     } else {
       throw std::runtime_error(
@@ -363,66 +576,11 @@ std::string ListModus::next_event_() {
     }
   }
 
-  // read one event. events marked by line # event end i in case of Oscar
-  // output. Assume one event per file for all other output formats
-  std::string event_string{};
-  const std::string needle = " end ";
-  std::string line{};
-  while (getline(ifs, line)) {
-    if (line.find(needle) == std::string::npos) {
-      event_string += line + "\n";
-    } else {
-      break;
-    }
-  }
-
-  if (!ifs.eof() && (ifs.fail() || ifs.bad())) {
-    if (verbose_) {
-      logg[LList].fatal() << "Error while reading "
-                          << fpath.filename().native();
-    }
-    throw std::runtime_error("Error while reading external particle list");
-  }
-  // save position for next event read
-  last_read_position_ = ifs.tellg();
-  ifs.close();
-
-  return event_string;
-}
-
-bool ListModus::file_has_events_(std::filesystem::path filepath,
-                                 std::streampos last_position) {
-  std::ifstream ifs{filepath};
-  std::string line;
-
-  // last event read read at end of file. we know this because errors are
-  // handled in next_event
-  if (last_position == -1) {
-    return false;
-  }
-  ifs.seekg(last_position);
-  // skip over comment lines, assume that a max. of four consecutive comment
-  // lines can occur
-  int skipped_lines = 0;
-  const int max_comment_lines = 4;
-  while (std::getline(ifs, line) && line[0] != '#' &&
-         skipped_lines++ < max_comment_lines) {
-  }
-
-  if (ifs.eof()) {
-    return false;
-  }
-
-  if (!ifs.good()) {
-    if (verbose_) {
-      logg[LList].fatal() << "Error while reading "
-                          << filepath.filename().native();
-    }
-    throw std::runtime_error("Error while reading external particle list");
-  }
-
-  ifs.close();
-  return true;
+  // Events are marked by lines like '# event end i' in case of Oscar output.
+  // Assume one event per file for all other output formats
+  const ParticleListFile::Event &event = (*file_)[next_event_in_file_++];
+  file_->prefetch(next_event_in_file_);
+  return event;
 }
 
 /* In this method, which is called from the constructor only, we "abuse" of the
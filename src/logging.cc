@@ -37,7 +37,7 @@ void set_default_loglevel(einhard::LogLevel level) {
  * \endcode
  * For further documentation see `logging.h`.
  */
-std::array<einhard::Logger<>, std::tuple_size<LogArea::AreaTuple>::value> logg;
+std::array<Logger, std::tuple_size<LogArea::AreaTuple>::value> logg;
 
 /**
  * \internal
@@ -0,0 +1,100 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/lundztable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include "smash/random.h"
+
+namespace smash {
+
+std::map<double, std::unique_ptr<const LundZTable>> LundZTable::tables_;
+std::shared_mutex LundZTable::tables_mutex_;
+
+LundZTable::LundZTable(double a, int n_c, int n_quantiles)
+    : inv_dlog_c_((n_c - 1) / std::log(c_max / c_min)),
+      n_c_(n_c),
+      n_quantiles_(n_quantiles),
+      quantiles_(n_c * (n_quantiles + 1)) {
+  /* The density of t = ln z is (1 - z)^a exp(-c (1/z - 1)), up to a factor,
+   * which is integrated with the midpoint rule on a finer grid in t. Below
+   * z = c / (c + 50), the exponential is smaller than exp(-50). */
+  const int n_steps = 4 * n_quantiles;
+  std::vector<double> cumulative(n_steps + 1);
+  for (int k = 0; k < n_c; k++) {
+    const double c = c_min * std::exp(k / inv_dlog_c_);
+    const double t_min = std::log(c / (c + 50.));
+    const double dt = -t_min / n_steps;
+    cumulative[0] = 0.;
+    for (int i = 0; i < n_steps; i++) {
+      const double t = t_min + (i + 0.5) * dt;
+      cumulative[i + 1] = cumulative[i] + std::pow(-std::expm1(t), a) *
+                                              std::exp(-c * std::expm1(-t));
+    }
+    // Invert the piecewise linear cumulative distribution.
+    double *row = &quantiles_[k * (n_quantiles + 1)];
+    const double total = cumulative[n_steps];
+    int i = 0;
+    for (int j = 0; j <= n_quantiles; j++) {
+      const double target = total * probability(double(j) / n_quantiles);
+      while (i < n_steps - 1 && cumulative[i + 1] < target) {
+        i++;
+      }
+      const double step = cumulative[i + 1] - cumulative[i];
+      const double fraction =
+          step > 0. ? std::clamp((target - cumulative[i]) / step, 0., 1.) : 0.;
+      row[j] = t_min + (i + fraction) * dt;
+    }
+  }
+}
+
+double LundZTable::sample(double c) const {
+  const double s = std::log(c / c_min) * inv_dlog_c_;
+  if (!(s >= 0.) || s >= n_c_ - 1) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  const auto k = static_cast<int>(s);
+  const double f_c = s - k;
+  const double p = random::canonical();
+  // Inverse of probability()
+  const double u =
+      (p < 0.5 ? std::sqrt(0.5 * p) : 1. - std::sqrt(0.5 - 0.5 * p)) *
+      n_quantiles_;
+  const int j = std::min(static_cast<int>(u), n_quantiles_ - 1);
+  const double f_u = u - j;
+  const double *lower = &quantiles_[k * (n_quantiles_ + 1) + j];
+  const double *upper = lower + n_quantiles_ + 1;
+  const double t_lower = lower[0] + f_u * (lower[1] - lower[0]);
+  const double t_upper = upper[0] + f_u * (upper[1] - upper[0]);
+  // Like the rejection sampling, never return a fraction of one
+  return std::min(std::exp(t_lower + f_c * (t_upper - t_lower)),
+                  std::nextafter(1., 0.));
+}
+
+const LundZTable &LundZTable::find(double a) {
+  {
+    std::shared_lock lock(tables_mutex_);
+    const auto found = tables_.find(a);
+    if (found != tables_.end()) {
+      return *found->second;
+    }
+  }
+  std::unique_lock lock(tables_mutex_);
+  auto &table = tables_[a];
+  if (!table) {
+    table = std::make_unique<const LundZTable>(a);
+  }
+  return *table;
+}
+
+}  // namespace smash
@@ -0,0 +1,144 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/memoryoutput.h"
+
+#include <utility>
+
+#include "smash/action.h"
+#include "smash/clock.h"
+#include "smash/particles.h"
+
+namespace smash {
+
+MemoryOutput::MemoryOutput(ParticlesCallback particles,
+                           InteractionCallback interaction, std::string name)
+    : OutputInterface(std::move(name)),
+      particles_callback_(std::move(particles)),
+      interaction_callback_(std::move(interaction)) {}
+
+ParticleRecord MemoryOutput::record(const ParticleData &data) {
+  const FourVector &x = data.position();
+  const FourVector &p = data.momentum();
+  const HistoryData history = data.get_history();
+  ParticleRecord r;
+  r.t = x.x0();
+  r.x = x.x1();
+  r.y = x.x2();
+  r.z = x.x3();
+  r.mass = data.effective_mass();
+  r.p0 = p.x0();
+  r.px = p.x1();
+  r.py = p.x2();
+  r.pz = p.x3();
+  r.formation_time = data.formation_time();
+  r.xsec_scaling_factor = data.xsec_scaling_factor();
+  r.time_last_collision = history.time_last_collision;
+  r.perturbative_weight = data.perturbative_weight();
+  r.id = data.id();
+  r.pdg = data.pdgcode().get_decimal();
+  r.charge = data.type().charge();
+  r.ncoll = history.collisions_per_particle;
+  r.proc_id_origin = history.id_process;
+  r.proc_type_origin = history.process_type;
+  r.pdg_mother1 = history.p1.get_decimal();
+  r.pdg_mother2 = history.p2.get_decimal();
+  return r;
+}
+
+ParticleData MemoryOutput::particle(const ParticleRecord &r) {
+  ParticleData data{ParticleType::find(PdgCode::from_decimal(r.pdg)), r.id};
+  data.set_4position(FourVector(r.t, r.x, r.y, r.z));
+  data.set_4momentum(FourVector(r.p0, r.px, r.py, r.pz));
+  data.set_formation_time(r.formation_time);
+  data.set_cross_section_scaling_factor(r.xsec_scaling_factor);
+  data.set_perturbative_weight(r.perturbative_weight);
+  HistoryData history;
+  history.collisions_per_particle = r.ncoll;
+  history.id_process = r.proc_id_origin;
+  history.process_type = r.proc_type_origin;
+  history.time_last_collision = r.time_last_collision;
+  history.p1 = PdgCode::from_decimal(r.pdg_mother1);
+  history.p2 = PdgCode::from_decimal(r.pdg_mother2);
+  data.set_history(std::move(history));
+  return data;
+}
+
+void MemoryOutput::at_eventstart(const Particles &particles,
+                                 const EventLabel &event_label,
+                                 const EventInfo &event) {
+  interaction_.event_number = event_label.event_number;
+  pass_particles(ParticleBlock::Stage::EventStart, particles, event_label,
+                 event, event.current_time);
+}
+
+void MemoryOutput::at_eventend(const Particles &particles,
+                               const EventLabel &event_label,
+                               const EventInfo &event) {
+  pass_particles(ParticleBlock::Stage::EventEnd, particles, event_label, event,
+                 event.current_time);
+}
+
+void MemoryOutput::at_intermediate_time(const Particles &particles,
+                                        const std::unique_ptr<Clock> &clock,
+                                        const DensityParameters &,
+                                        const EventLabel &event_label,
+                                        const EventInfo &event) {
+  pass_particles(ParticleBlock::Stage::Intermediate, particles, event_label,
+                 event, clock->current_time());
+}
+
+void MemoryOutput::at_interaction(const Action &action, const double density) {
+  if (fluidization_callback_ &&
+      (action.get_type() == ProcessType::Fluidization ||
+       action.get_type() == ProcessType::FluidizationNoRemoval)) {
+    for (const ParticleData &data : action.incoming_particles()) {
+      fluidization_callback_(record(data));
+    }
+  }
+  if (!interaction_callback_) {
+    return;
+  }
+  interaction_.type = action.get_type();
+  interaction_.time = action.time_of_execution();
+  interaction_.total_weight = action.get_total_weight();
+  interaction_.partial_weight = action.get_partial_weight();
+  interaction_.density = density;
+  interaction_.incoming.clear();
+  for (const ParticleData &data : action.incoming_particles()) {
+    interaction_.incoming.push_back(record(data));
+  }
+  interaction_.outgoing.clear();
+  for (const ParticleData &data : action.outgoing_particles()) {
+    interaction_.outgoing.push_back(record(data));
+  }
+  interaction_callback_(interaction_);
+}
+
+void MemoryOutput::pass_particles(ParticleBlock::Stage stage,
+                                  const Particles &particles,
+                                  const EventLabel &event_label,
+                                  const EventInfo &event, double time) {
+  if (!particles_callback_) {
+    return;
+  }
+  block_.stage = stage;
+  block_.event_label = event_label;
+  block_.time = time;
+  block_.impact_parameter = event.impact_parameter;
+  block_.empty_event = event.empty_event;
+  block_.particles.clear();
+  block_.particles.reserve(particles.size());
+  for (const ParticleData &data : particles) {
+    block_.particles.push_back(record(data));
+  }
+  particles_callback_(block_);
+}
+
+}  // namespace smash
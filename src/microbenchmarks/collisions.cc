@@ -0,0 +1,134 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <sstream>
+#include <vector>
+
+#include "microbenchmark.h"
+#include "smash/crosssections.h"
+#include "smash/scatteraction.h"
+#include "smash/scatteractionsfinder.h"
+
+using namespace smash;
+
+namespace {
+
+/// A pair of incoming particles and their center-of-mass energy
+struct Pair {
+  /// Type of the first particle
+  int a;
+  /// Type of the second particle
+  int b;
+  /// Center-of-mass energy [GeV]
+  double sqrt_s;
+};
+
+/// Representative pairs, selected by the argument of the benchmarks
+constexpr std::array<Pair, 4> pairs = {{{pdg::pi_p, pdg::p, 1.5},
+                                        {pdg::p, pdg::p, 2.5},
+                                        {pdg::K_m, pdg::p, 1.8},
+                                        {pdg::pi_p, pdg::pi_m, 0.8}}};
+
+/// Label the benchmark with the pair of its argument.
+void label(benchmark::State &state) {
+  const Pair &pair = pairs[state.range(0)];
+  std::ostringstream text;
+  text << ParticleType::find(pair.a).name()
+       << ParticleType::find(pair.b).name() << " at " << pair.sqrt_s << " GeV";
+  state.SetLabel(text.str());
+}
+
+}  // namespace
+
+/* The search for a collision of two particles, i.e. check_collision_two_part,
+ * reached through the search in neighboring cells. */
+static void check_collision_two_part(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  const Pair &pair = pairs[state.range(0)];
+  const ParticleList incoming =
+      Microbenchmark::colliding_pair(pair.a, pair.b, pair.sqrt_s);
+  const ParticleList search{incoming[0]}, neighbors{incoming[1]};
+  ExperimentParameters parameters = Test::default_parameters();
+  Configuration config{""};
+  const ScatterActionsFinder finder(config, parameters);
+  const std::vector<FourVector> beam_momentum;
+  for (auto _ : state) {
+    ActionList found = finder.find_actions_with_neighbors(
+        search, neighbors, 1., beam_momentum);
+    benchmark::DoNotOptimize(found);
+  }
+  label(state);
+}
+BENCHMARK(check_collision_two_part)->DenseRange(0, pairs.size() - 1);
+
+static void generate_collision_list(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  const Pair &pair = pairs[state.range(0)];
+  const ParticleList incoming =
+      Microbenchmark::colliding_pair(pair.a, pair.b, pair.sqrt_s);
+  const ScatterActionsFinderParameters finder_parameters =
+      Test::default_finder_parameters(-1., NNbarTreatment::NoAnnihilation,
+                                      Test::all_reactions_included(), false);
+  for (auto _ : state) {
+    const CrossSections xs(incoming, pair.sqrt_s, {});
+    CollisionBranchList branches =
+        xs.generate_collision_list(finder_parameters, nullptr);
+    benchmark::DoNotOptimize(branches);
+  }
+  label(state);
+}
+BENCHMARK(generate_collision_list)->DenseRange(0, pairs.size() - 1);
+
+/* The covariant collision time of all pairs of pions in a 5 fm cube, which is
+ * dominated by the products of four-vectors. */
+static void collision_time(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  Particles particles;
+  Microbenchmark::add_uniform_particles(particles, 100, pdg::pi_p, 5.);
+  const ParticleList list = particles.copy_to_vector();
+  ExperimentParameters parameters = Test::default_parameters();
+  Configuration config{""};
+  const ScatterActionsFinder finder(config, parameters);
+  const std::vector<FourVector> beam_momentum;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < list.size(); i++) {
+      for (std::size_t j = i + 1; j < list.size(); j++) {
+        benchmark::DoNotOptimize(
+            finder.collision_time(list[i], list[j], 1., beam_momentum));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * list.size() *
+                          (list.size() - 1) / 2);
+}
+BENCHMARK(collision_time);
+
+// The transverse distance of the same pairs, which boosts both particles
+static void transverse_distance_sqr(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  Particles particles;
+  Microbenchmark::add_uniform_particles(particles, 100, pdg::pi_p, 5.);
+  const ParticleList list = particles.copy_to_vector();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < list.size(); i++) {
+      for (std::size_t j = i + 1; j < list.size(); j++) {
+        benchmark::DoNotOptimize(
+            ScatterAction::transverse_distance_sqr(list[i], list[j]));
+        benchmark::DoNotOptimize(
+            ScatterAction::cov_transverse_distance_sqr(list[i], list[j]));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * list.size() *
+                          (list.size() - 1) / 2);
+}
+BENCHMARK(transverse_distance_sqr);
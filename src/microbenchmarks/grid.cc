@@ -0,0 +1,47 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "microbenchmark.h"
+#include "smash/grid.h"
+
+using namespace smash;
+
+/* Placing the pions of a 10 fm cube onto a new grid, for several numbers of
+ * pions. */
+static void grid_construction(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  Particles particles;
+  Microbenchmark::add_uniform_particles(
+      particles, static_cast<int>(state.range(0)), pdg::pi_p, 10.);
+  for (auto _ : state) {
+    Grid<GridOptions::Normal> grid(particles, 2.5, 0.1,
+                                   CellNumberLimitation::ParticleNumber);
+    benchmark::DoNotOptimize(grid);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(grid_construction)->RangeMultiplier(8)->Range(64, 32768);
+
+// Placing the pions onto a kept grid, as is done in every time step
+static void grid_rebuild(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  Particles particles;
+  Microbenchmark::add_uniform_particles(
+      particles, static_cast<int>(state.range(0)), pdg::pi_p, 10.);
+  Grid<GridOptions::Normal> grid(particles, 2.5, 0.1,
+                                 CellNumberLimitation::ParticleNumber);
+  for (auto _ : state) {
+    grid.rebuild(particles, 2.5, 0.1, CellNumberLimitation::ParticleNumber);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(grid_rebuild)->RangeMultiplier(8)->Range(64, 32768);
@@ -0,0 +1,77 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <vector>
+
+#include "microbenchmark.h"
+#include "smash/density.h"
+#include "smash/lattice.h"
+
+using namespace smash;
+
+namespace {
+
+/// Edge lengths of the lattices [fm]
+constexpr std::array<double, 3> lattice_sizes = {20., 20., 20.};
+/// Origin of the lattices [fm]
+constexpr std::array<double, 3> lattice_origin = {-10., -10., -10.};
+
+}  // namespace
+
+/* The Gaussian smearing of the baryon current of the protons of a 10 fm cube
+ * onto a lattice of 40^3 nodes, for several numbers of protons. */
+static void gaussian_smearing(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  std::vector<Particles> ensembles(1);
+  Microbenchmark::add_uniform_particles(
+      ensembles[0], static_cast<int>(state.range(0)), pdg::p, 10.);
+  const DensityParameters parameters(Test::default_parameters());
+  DensityLattice lattice(lattice_sizes, {40, 40, 40}, lattice_origin, false,
+                         LatticeUpdate::EveryTimestep);
+  const bool compute_gradient = state.range(1);
+  for (auto _ : state) {
+    update_lattice_accumulating_ensembles(
+        &lattice, LatticeUpdate::EveryTimestep, DensityType::Baryon,
+        parameters, ensembles, compute_gradient);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(gaussian_smearing)
+    ->ArgsProduct({{100, 1000}, {0, 1}})
+    ->ArgNames({"particles", "gradient"});
+
+// The finite difference four-gradient on lattices of several sizes
+static void compute_four_gradient_lattice(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  const int n = static_cast<int>(state.range(0));
+  const std::array<int, 3> n_cells = {n, n, n};
+  RectangularLattice<FourVector> old_lattice(
+      lattice_sizes, n_cells, lattice_origin, false,
+      LatticeUpdate::EveryTimestep);
+  RectangularLattice<FourVector> new_lattice(old_lattice);
+  for (std::size_t i = 0; i < new_lattice.size(); i++) {
+    old_lattice[i] = FourVector(random::uniform(0., 1.), 0., 0., 0.);
+    new_lattice[i] =
+        FourVector(random::uniform(0., 1.), random::uniform(0., 1.),
+                   random::uniform(0., 1.), random::uniform(0., 1.));
+  }
+  RectangularLattice<std::array<FourVector, 4>> gradient(
+      lattice_sizes, n_cells, lattice_origin, false,
+      LatticeUpdate::EveryTimestep);
+  for (auto _ : state) {
+    new_lattice.compute_four_gradient_lattice(old_lattice, 0.1, gradient);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * new_lattice.size());
+}
+BENCHMARK(compute_four_gradient_lattice)->Arg(20)->Arg(40)->Arg(80);
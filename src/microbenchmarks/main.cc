@@ -0,0 +1,36 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "microbenchmark.h"
+#include "smash/logging.h"
+
+using namespace smash;
+
+/*
+ * Runs the microbenchmarks of the kernels of SMASH, which are registered in the
+ * other files of this directory. Every benchmark starts from the same seed and
+ * all of them use the particles and decay modes shipped with SMASH. The usual
+ * options of Google Benchmark apply, e.g. --benchmark_filter=grid to run the
+ * benchmarks of the grid only.
+ */
+int main(int argc, char **argv) {
+  set_default_loglevel(einhard::WARN);
+  create_all_loggers(Configuration(""));
+  Test::create_actual_particletypes();
+  Test::create_actual_decaymodes();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_MICROBENCHMARKS_MICROBENCHMARK_H_
+#define SRC_MICROBENCHMARKS_MICROBENCHMARK_H_
+
+#include <cstdint>
+
+#include "setup.h"
+#include "smash/kinematics.h"
+#include "smash/particles.h"
+#include "smash/pdgcode.h"
+#include "smash/random.h"
+
+namespace smash {
+namespace Microbenchmark {
+
+/// The seed every benchmark starts from, such that runs can be compared
+constexpr int64_t seed = 4242;
+
+/**
+ * Add particles of one type with uniformly distributed positions in a cube
+ * centered at the origin and thermal-like momenta, as a typical input of the
+ * kernels of the time evolution.
+ *
+ * \param[out] particles The particles to which the new ones are added.
+ * \param[in] n Number of particles.
+ * \param[in] pdg Type of the particles.
+ * \param[in] length Edge length of the cube [fm].
+ */
+inline void add_uniform_particles(Particles &particles, int n, PdgCode pdg,
+                                  double length) {
+  const ParticleType &type = ParticleType::find(pdg);
+  const double half = 0.5 * length;
+  for (int i = 0; i < n; i++) {
+    ParticleData particle{type};
+    particle.set_4momentum(
+        type.mass(), ThreeVector(random::normal(0., 0.3),
+                                 random::normal(0., 0.3),
+                                 random::normal(0., 0.3)));
+    particle.set_4position(FourVector(0., random::uniform(-half, half),
+                                      random::uniform(-half, half),
+                                      random::uniform(-half, half)));
+    particles.insert(particle);
+  }
+}
+
+/**
+ * Two particles approaching each other head-on along the z axis in their
+ * center-of-mass frame.
+ *
+ * \param[in] a Type of the first particle.
+ * \param[in] b Type of the second particle.
+ * \param[in] sqrt_s Center-of-mass energy [GeV].
+ * \return The two particles, 0.1 fm apart.
+ */
+inline ParticleList colliding_pair(PdgCode a, PdgCode b, double sqrt_s) {
+  ParticleData p_a{ParticleType::find(a)}, p_b{ParticleType::find(b)};
+  const double m_a = p_a.pole_mass(), m_b = p_b.pole_mass();
+  const double p_cm = pCM(sqrt_s, m_a, m_b);
+  p_a.set_4momentum(m_a, ThreeVector(0., 0., p_cm));
+  p_b.set_4momentum(m_b, ThreeVector(0., 0., -p_cm));
+  p_a.set_4position(FourVector(0., 0., 0., -0.05));
+  p_b.set_4position(FourVector(0., 0., 0., 0.05));
+  p_a.set_id(0);
+  p_b.set_id(1);
+  return {p_a, p_b};
+}
+
+}  // namespace Microbenchmark
+}  // namespace smash
+
+#endif  // SRC_MICROBENCHMARKS_MICROBENCHMARK_H_
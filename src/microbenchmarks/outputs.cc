@@ -0,0 +1,78 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "microbenchmark.h"
+#include "smash/binaryoutput.h"
+#include "smash/oscaroutput.h"
+
+using namespace smash;
+
+namespace {
+
+/**
+ * Write the particles of a 10 fm cube at intermediate times. The files are
+ * written to a directory below the temporary one, which is removed afterwards.
+ *
+ * \param[in] state The state of the benchmark, its argument is the number of
+ *            particles.
+ * \param[in] create Creates the output in the given directory.
+ */
+template <typename F>
+void write_particles(benchmark::State &state, F &&create) {
+  random::set_seed(Microbenchmark::seed);
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "smash_microbench";
+  std::filesystem::create_directories(path);
+  Particles particles;
+  Microbenchmark::add_uniform_particles(
+      particles, static_cast<int>(state.range(0)), pdg::pi_p, 10.);
+  const DensityParameters density_parameters(Test::default_parameters());
+  const EventInfo event_info = Test::default_event_info();
+  {
+    OutputParameters output_parameters;
+    output_parameters.part_extended = false;
+    output_parameters.part_only_final = OutputOnlyFinal::No;
+    const std::unique_ptr<OutputInterface> output =
+        create(path, output_parameters);
+    output->at_eventstart(particles, {0, 0}, event_info);
+    for (auto _ : state) {
+      output->at_intermediate_time(particles, nullptr, density_parameters,
+                                   {0, 0}, event_info);
+    }
+    output->at_eventend(particles, {0, 0}, event_info);
+  }
+  std::filesystem::remove_all(path);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+static void binary_particles_output(benchmark::State &state) {
+  write_particles(state, [](const std::filesystem::path &path,
+                            const OutputParameters &output_parameters) {
+    return create_binary_output("Binary", "Particles", path,
+                                output_parameters);
+  });
+}
+BENCHMARK(binary_particles_output)->Arg(100)->Arg(10000);
+
+static void oscar_particles_output(benchmark::State &state) {
+  write_particles(state, [](const std::filesystem::path &path,
+                            const OutputParameters &output_parameters) {
+    return create_oscar_output("Oscar2013", "Particles", path,
+                               output_parameters);
+  });
+}
+BENCHMARK(oscar_particles_output)->Arg(100)->Arg(10000);
@@ -0,0 +1,38 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "microbenchmark.h"
+#include "smash/propagation.h"
+
+using namespace smash;
+
+/* Propagating the pions of a 10 fm cube on straight lines, for several
+ * numbers of pions. With the second argument, a tenth of them are initial
+ * nucleons moving with the beam momentum, as with frozen Fermi motion. */
+static void straight_line_propagation(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  const int n = static_cast<int>(state.range(0));
+  Particles particles;
+  Microbenchmark::add_uniform_particles(particles, n, pdg::pi_p, 10.);
+  const std::vector<FourVector> beam_momentum(
+      state.range(1) ? n / 10 : 0, FourVector(1.0, 0.0, 0.0, 0.5));
+  double time = 0.0;
+  for (auto _ : state) {
+    time += 0.1;
+    propagate_straight_line(&particles, time, beam_momentum);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(straight_line_propagation)
+    ->ArgsProduct({benchmark::CreateRange(64, 32768, 8), {0, 1}});
@@ -0,0 +1,223 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "microbenchmark.h"
+#include "smash/crosssections.h"
+#include "smash/density.h"
+#include "smash/fpenvironment.h"
+#include "smash/logging.h"
+#include "smash/scatteractionsfinder.h"
+#include "smash/stringprocess.h"
+#include "smash/workloadrecorder.h"
+
+using namespace smash;
+
+namespace {
+
+/// The recorded pairs as particles, with the ids 0 and 1
+std::vector<ParticleList> pair_particles(
+    const std::vector<WorkloadRecorder::Pair> &pairs) {
+  std::vector<ParticleList> result;
+  result.reserve(pairs.size());
+  for (const WorkloadRecorder::Pair &pair : pairs) {
+    result.push_back({pair.particles[0].to_particle_data(0),
+                      pair.particles[1].to_particle_data(1)});
+  }
+  return result;
+}
+
+/* The collision check of the recorded pairs with the default configuration of
+ * the collision term, i.e. the geometric criterion, reached through the search
+ * in neighboring cells like in collisions.cc. */
+void replay_check_collision_two_part(
+    benchmark::State &state, const std::vector<WorkloadRecorder::Pair> &pairs) {
+  random::set_seed(Microbenchmark::seed);
+  std::vector<ParticleList> search, neighbors;
+  for (const ParticleList &particles : pair_particles(pairs)) {
+    search.push_back({particles[0]});
+    neighbors.push_back({particles[1]});
+  }
+  ExperimentParameters parameters = Test::default_parameters();
+  Configuration config{""};
+  const ScatterActionsFinder finder(config, parameters);
+  const std::vector<FourVector> beam_momentum;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < pairs.size(); i++) {
+      ActionList found = finder.find_actions_with_neighbors(
+          search[i], neighbors[i], pairs[i].dt, beam_momentum);
+      benchmark::DoNotOptimize(found);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * pairs.size());
+}
+
+// The cross sections of all channels of the recorded pairs
+void replay_cross_sections(benchmark::State &state,
+                           const std::vector<WorkloadRecorder::Pair> &pairs) {
+  random::set_seed(Microbenchmark::seed);
+  const std::vector<ParticleList> incoming = pair_particles(pairs);
+  std::vector<double> sqrt_s;
+  for (const ParticleList &particles : incoming) {
+    sqrt_s.push_back((particles[0].momentum() + particles[1].momentum()).abs());
+  }
+  const ScatterActionsFinderParameters finder_parameters =
+      Test::default_finder_parameters(-1., NNbarTreatment::NoAnnihilation,
+                                      Test::all_reactions_included(), false);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < incoming.size(); i++) {
+      const CrossSections xs(incoming[i], sqrt_s[i], {});
+      CollisionBranchList branches =
+          xs.generate_collision_list(finder_parameters, nullptr);
+      benchmark::DoNotOptimize(branches);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * incoming.size());
+}
+
+/* The recorded lattice updates, each with the geometry of its lattice and its
+ * smearing parameters. */
+void replay_density(benchmark::State &state,
+                    const std::vector<WorkloadRecorder::Smearing> &smearings) {
+  random::set_seed(Microbenchmark::seed);
+  std::vector<std::vector<Particles>> ensembles;
+  std::vector<DensityParameters> parameters;
+  std::vector<std::unique_ptr<DensityLattice>> lattices;
+  int64_t n_particles = 0;
+  for (const WorkloadRecorder::Smearing &smearing : smearings) {
+    std::vector<Particles> &particles =
+        ensembles.emplace_back(smearing.ensembles.size());
+    for (std::size_t e = 0; e < smearing.ensembles.size(); e++) {
+      for (const WorkloadRecorder::Particle &particle :
+           smearing.ensembles[e]) {
+        particles[e].insert(particle.to_particle_data(-1));
+        n_particles++;
+      }
+    }
+    ExperimentParameters par = Test::default_parameters(
+        smearing.testparticles, 0.1, CollisionCriterion::Geometric, false,
+        NNbarTreatment::NoAnnihilation, Test::all_reactions_included(),
+        smearing.smearing_mode);
+    par.n_ensembles = smearing.ensembles.size();
+    par.derivatives_mode = smearing.derivatives_mode;
+    par.rho_derivatives_mode = smearing.rho_derivatives_mode;
+    par.gaussian_sigma = smearing.gaussian_sigma;
+    par.gauss_cutoff_in_sigma = smearing.gauss_cutoff_in_sigma;
+    par.discrete_weight = smearing.discrete_weight;
+    par.triangular_range = smearing.triangular_range;
+    par.only_participants = smearing.only_participants;
+    parameters.emplace_back(par);
+    lattices.push_back(std::make_unique<DensityLattice>(
+        smearing.lattice_sizes, smearing.n_cells, smearing.origin,
+        smearing.periodic, LatticeUpdate::EveryTimestep));
+  }
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < smearings.size(); i++) {
+      update_lattice_accumulating_ensembles(
+          lattices[i].get(), LatticeUpdate::EveryTimestep,
+          smearings[i].density_type, parameters[i], ensembles[i],
+          smearings[i].compute_gradient);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n_particles);
+}
+
+/* The recorded string excitations and their fragmentation, one attempt for
+ * each excitation. */
+void replay_string_process(
+    benchmark::State &state,
+    const std::vector<WorkloadRecorder::StringExcitation> &strings) {
+  random::set_seed(Microbenchmark::seed);
+  const std::unique_ptr<StringProcess> string_process =
+      Test::default_string_process_interface();
+  string_process->init_pythia_hadron_rndm();
+  std::vector<ParticleList> incoming;
+  for (const WorkloadRecorder::StringExcitation &string : strings) {
+    incoming.push_back({string.particles[0].to_particle_data(0),
+                        string.particles[1].to_particle_data(1)});
+  }
+  DisableFloatTraps guard;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < strings.size(); i++) {
+      string_process->init(incoming[i], 0.);
+      switch (strings[i].process) {
+        case ProcessType::StringSoftSingleDiffractiveAX:
+          benchmark::DoNotOptimize(string_process->next_SDiff(true));
+          break;
+        case ProcessType::StringSoftSingleDiffractiveXB:
+          benchmark::DoNotOptimize(string_process->next_SDiff(false));
+          break;
+        case ProcessType::StringSoftDoubleDiffractive:
+          benchmark::DoNotOptimize(string_process->next_DDiff());
+          break;
+        case ProcessType::StringSoftNonDiffractive:
+          benchmark::DoNotOptimize(string_process->next_NDiffSoft());
+          break;
+        case ProcessType::StringSoftAnnihilation:
+          benchmark::DoNotOptimize(string_process->next_BBbarAnn());
+          break;
+        case ProcessType::StringHard:
+          benchmark::DoNotOptimize(string_process->next_NDiffHard());
+          break;
+        default:
+          throw std::runtime_error("The workload has an unknown string.");
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+}  // namespace
+
+/*
+ * Replays the workload recorded by a run with Workload_Sampling, i.e. runs the
+ * kernels of SMASH on the recorded inputs. The workload is the first argument,
+ * the usual options of Google Benchmark apply to the remaining ones, e.g.
+ * --benchmark_filter=replay_density to run the smearing only. The particles
+ * and decay modes shipped with SMASH are used, which have to be those of the
+ * recorded run.
+ */
+int main(int argc, char **argv) {
+  set_default_loglevel(einhard::WARN);
+  create_all_loggers(Configuration(""));
+  benchmark::Initialize(&argc, argv);
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <workload.bin> [benchmark options]\n";
+    return 1;
+  }
+  Test::create_actual_particletypes();
+  Test::create_actual_decaymodes();
+  const WorkloadRecorder::Workload workload = WorkloadRecorder::read(argv[1]);
+  if (!workload.pairs.empty()) {
+    benchmark::RegisterBenchmark("replay_check_collision_two_part",
+                                 replay_check_collision_two_part,
+                                 workload.pairs);
+    benchmark::RegisterBenchmark("replay_cross_sections",
+                                 replay_cross_sections, workload.pairs);
+  }
+  if (!workload.smearings.empty()) {
+    benchmark::RegisterBenchmark("replay_density", replay_density,
+                                 workload.smearings);
+  }
+  if (!workload.strings.empty()) {
+    benchmark::RegisterBenchmark("replay_string_process",
+                                 replay_string_process, workload.strings);
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,28 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "microbenchmark.h"
+#include "smash/particletype.h"
+
+using namespace smash;
+
+/* The mass sampling of a Δ⁺⁺ produced together with a neutron, for several
+ * center-of-mass energies [MeV]. */
+static void sample_resonance_mass(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  const ParticleType &delta = ParticleType::find(pdg::Delta_pp);
+  const double mass_stable = ParticleType::find(pdg::n).mass();
+  const double sqrt_s = 1e-3 * state.range(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(delta.sample_resonance_mass(mass_stable, sqrt_s));
+  }
+}
+BENCHMARK(sample_resonance_mass)->Arg(2200)->Arg(3000)->Arg(10000);
@@ -0,0 +1,33 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "microbenchmark.h"
+#include "smash/stringprocess.h"
+
+using namespace smash;
+
+/* The soft non-diffractive string excitation and fragmentation of a proton
+ * pair, for several center-of-mass energies [GeV]. */
+static void next_NDiffSoft(benchmark::State &state) {
+  random::set_seed(Microbenchmark::seed);
+  const std::unique_ptr<StringProcess> string_process =
+      Test::default_string_process_interface();
+  string_process->init_pythia_hadron_rndm();
+  const ParticleList incoming = Microbenchmark::colliding_pair(
+      pdg::p, pdg::p, static_cast<double>(state.range(0)));
+  for (auto _ : state) {
+    string_process->init(incoming, 0.);
+    benchmark::DoNotOptimize(string_process->next_NDiffSoft());
+  }
+}
+BENCHMARK(next_NDiffSoft)->Arg(5)->Arg(10)->Arg(100);
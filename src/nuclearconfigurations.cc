@@ -0,0 +1,84 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/nuclearconfigurations.h"
+
+#include "smash/random.h"
+
+namespace smash {
+
+NuclearConfigurations::NuclearConfigurations(
+    Nucleus &projectile, Nucleus &target, bool fermi_momenta,
+    double v_projectile, double v_target, std::size_t batch_size,
+    std::uint64_t seed)
+    : projectile_(projectile),
+      target_(target),
+      fermi_momenta_(fermi_momenta),
+      v_projectile_(v_projectile),
+      v_target_(v_target),
+      batch_size_(batch_size),
+      seed_(seed),
+      position_(batch_size) {
+  launch();
+}
+
+NuclearConfigurations::~NuclearConfigurations() {
+  if (next_.valid()) {
+    next_.wait();
+  }
+}
+
+void NuclearConfigurations::take(std::vector<ParticleData> &projectile,
+                                 std::vector<ParticleData> &target) {
+  if (position_ == batch_size_) {
+    current_ = next_.get();
+    position_ = 0;
+    launch();
+  }
+  const std::size_t n_projectile = current_.projectile.size() / batch_size_;
+  const std::size_t n_target = current_.target.size() / batch_size_;
+  const auto projectile_begin =
+      current_.projectile.cbegin() + position_ * n_projectile;
+  const auto target_begin = current_.target.cbegin() + position_ * n_target;
+  projectile.assign(projectile_begin, projectile_begin + n_projectile);
+  target.assign(target_begin, target_begin + n_target);
+  position_++;
+}
+
+NuclearConfigurations::Batch NuclearConfigurations::generate(
+    std::uint64_t index) {
+  random::Engine stream = random::make_stream(
+      seed_, random::StreamKind::NuclearConfigurations, index);
+  const random::ScopedEngine batch_engine(stream);
+  Batch batch;
+  batch.projectile.reserve(batch_size_ * projectile_.size());
+  batch.target.reserve(batch_size_ * target_.size());
+  for (std::size_t i = 0; i < batch_size_; i++) {
+    projectile_.arrange_nucleons();
+    target_.arrange_nucleons();
+    if (fermi_momenta_) {
+      projectile_.generate_fermi_momenta();
+      target_.generate_fermi_momenta();
+    }
+    batch.projectile.insert(batch.projectile.end(), projectile_.cbegin(),
+                            projectile_.cend());
+    batch.target.insert(batch.target.end(), target_.cbegin(), target_.cend());
+  }
+  Nucleus::boost_nucleons(batch.projectile.begin(), batch.projectile.end(),
+                          v_projectile_);
+  Nucleus::boost_nucleons(batch.target.begin(), batch.target.end(), v_target_);
+  return batch;
+}
+
+void NuclearConfigurations::launch() {
+  next_ = std::async(std::launch::async, &NuclearConfigurations::generate,
+                     this, n_batches_++);
+}
+
+}  // namespace smash
@@ -0,0 +1,126 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/nucleondensitytable.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "smash/angles.h"
+#include "smash/constants.h"
+#include "smash/deformednucleus.h"
+#include "smash/random.h"
+
+namespace smash {
+
+std::map<NucleonDensityTable::Key, std::shared_ptr<const NucleonDensityTable>>
+    NucleonDensityTable::tables_;
+std::mutex NucleonDensityTable::tables_mutex_;
+
+NucleonDensityTable::Distribution::Distribution(
+    const std::vector<double> &density)
+    : cumulative_(density.size() + 1, 0.), guide_(density.size()) {
+  for (std::size_t i = 0; i < density.size(); i++) {
+    cumulative_[i + 1] = cumulative_[i] + density[i];
+  }
+  const double total = cumulative_.back();
+  for (double &c : cumulative_) {
+    c /= total;
+  }
+  // guide_[g] is the last point with a probability not above g / n.
+  const std::size_t n = guide_.size();
+  std::size_t i = 0;
+  for (std::size_t g = 0; g < n; g++) {
+    while (i + 1 < n && cumulative_[i + 1] <= static_cast<double>(g) / n) {
+      i++;
+    }
+    guide_[g] = i;
+  }
+}
+
+double NucleonDensityTable::Distribution::quantile(double u) const {
+  const std::size_t n = guide_.size();
+  std::size_t i = guide_[std::min(static_cast<std::size_t>(u * n), n - 1)];
+  while (i + 1 < n && cumulative_[i + 1] < u) {
+    i++;
+  }
+  const double step = cumulative_[i + 1] - cumulative_[i];
+  const double fraction =
+      step > 0. ? std::clamp((u - cumulative_[i]) / step, 0., 1.) : 0.;
+  return (i + fraction) / n;
+}
+
+NucleonDensityTable::NucleonDensityTable(double radius, double diffusiveness,
+                                         double beta2, double beta3,
+                                         double beta4, double r_max)
+    : r_max_(r_max) {
+  const bool deformed = beta2 != 0. || beta3 != 0. || beta4 != 0.;
+  const int n_cos = deformed ? n_cos_ : 1;
+  // The density of every radial interval is taken at its midpoint.
+  const double dr = r_max / n_radii_;
+  std::vector<double> density(n_radii_);
+  std::vector<double> weights(n_cos);
+  for (int k = 0; k < n_cos; k++) {
+    const double cosx = deformed ? -1. + 2. * k / (n_cos - 1) : 0.;
+    const double radius_k =
+        deformed ? radius * (1. + beta2 * y_l_m(2, 0, cosx, 0.) +
+                             beta3 * y_l_m(3, 0, cosx, 0.) +
+                             beta4 * y_l_m(4, 0, cosx, 0.))
+                 : radius;
+    weights[k] = 0.;
+    for (int i = 0; i < n_radii_; i++) {
+      const double r = (i + 0.5) * dr;
+      density[i] = r * r / (1. + std::exp((r - radius_k) / diffusiveness));
+      weights[k] += density[i];
+    }
+    radial_.emplace_back(density);
+  }
+  if (deformed) {
+    std::vector<double> cos_density(n_cos - 1);
+    for (int k = 0; k + 1 < n_cos; k++) {
+      cos_density[k] = 0.5 * (weights[k] + weights[k + 1]);
+    }
+    cos_.emplace(cos_density);
+  }
+}
+
+ThreeVector NucleonDensityTable::sample() const {
+  Angles direction;
+  std::size_t k = 0;
+  double f_cos = 0.;
+  if (cos_) {
+    const double t = cos_->quantile(random::canonical()) * (n_cos_ - 1);
+    k = std::min(static_cast<std::size_t>(t), radial_.size() - 2);
+    f_cos = t - k;
+    direction = Angles(random::uniform(0., twopi), 2. * t / (n_cos_ - 1) - 1.);
+  } else {
+    direction.distribute_isotropically();
+  }
+  const double u = random::canonical();
+  double x = radial_[k].quantile(u);
+  if (f_cos > 0.) {
+    x += f_cos * (radial_[k + 1].quantile(u) - x);
+  }
+  return direction.threevec() * (x * r_max_);
+}
+
+std::shared_ptr<const NucleonDensityTable> NucleonDensityTable::find(
+    double radius, double diffusiveness, double beta2, double beta3,
+    double beta4, double r_max) {
+  const Key key{radius, diffusiveness, beta2, beta3, beta4, r_max};
+  std::lock_guard lock(tables_mutex_);
+  auto &table = tables_[key];
+  if (!table) {
+    table = std::make_shared<const NucleonDensityTable>(
+        radius, diffusiveness, beta2, beta3, beta4, r_max);
+  }
+  return table;
+}
+
+}  // namespace smash
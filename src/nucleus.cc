@@ -247,6 +247,9 @@ ThreeVector Nucleus::distribute_nucleon() {
   if (almost_equal(nuclear_radius_, 0.)) {
     return smash::ThreeVector();
   }
+  if (density_table_) {
+    return density_table_->sample();
+  }
   double radius_scaled = nuclear_radius_ / diffusiveness_;
   double prob_range1 = 1.0;
   double prob_range2 = 3. / radius_scaled;
@@ -282,6 +285,18 @@ ThreeVector Nucleus::distribute_nucleon() {
   return dir.threevec() * position;
 }
 
+void Nucleus::set_tabulated_positions(bool tabulated) {
+  if (tabulated && !almost_equal(diffusiveness_, 0.) &&
+      !almost_equal(nuclear_radius_, 0.)) {
+    // The density is below 1e-13 of its maximum beyond 30 diffusivenesses.
+    density_table_ =
+        NucleonDensityTable::find(nuclear_radius_, diffusiveness_, 0., 0., 0.,
+                                  nuclear_radius_ + 30. * diffusiveness_);
+  } else {
+    density_table_ = nullptr;
+  }
+}
+
 double Nucleus::woods_saxon(double r) {
   return r * r / (std::exp((r - nuclear_radius_) / diffusiveness_) + 1);
 }
@@ -399,15 +414,14 @@ void Nucleus::rotate() {
     random_euler_angles();
   }
   if (euler_phi_ != 0.0 || euler_theta_ != 0.0 || euler_psi_ != 0.0) {
+    const EulerRotation rotation(euler_phi_, euler_theta_, euler_psi_);
     for (auto &particle : *this) {
       /* Rotate every vector by the euler angles phi, theta and psi.
        * This means applying the matrix for a rotation of phi around the z-axis,
        * followed by the matrix for a rotation of theta around the rotated
        * x-axis and the matrix for a rotation of psi around the rotated z-axis.
        */
-      ThreeVector three_pos = particle.position().threevec();
-      three_pos.rotate(euler_phi_, euler_theta_, euler_psi_);
-      particle.set_3position(three_pos);
+      particle.set_3position(rotation(particle.position().threevec()));
     }
   }
 }
@@ -473,7 +487,9 @@ void Nucleus::generate_fermi_momenta() {
   }
 }
 
-void Nucleus::boost(double beta_scalar) {
+void Nucleus::boost_nucleons(std::vector<ParticleData>::iterator first,
+                             std::vector<ParticleData>::iterator last,
+                             double beta_scalar) {
   double beta_squared = beta_scalar * beta_scalar;
   double one_over_gamma = std::sqrt(1.0 - beta_squared);
   double gamma = 1.0 / one_over_gamma;
@@ -484,7 +500,7 @@ void Nucleus::boost(double beta_scalar) {
    *       a system that moves with -beta. Now in this frame, it seems
    *       like p has been accelerated with +beta.
    *     ) */
-  for (auto i = begin(); i != end(); i++) {
+  for (auto i = first; i != last; i++) {
     /* a real Lorentz Transformation would leave the particles at
      * different times here, which we would then have to propagate back
      * to equal times. Since we know the result, we can simply multiply
@@ -517,9 +533,12 @@ void Nucleus::fill_from_list(const std::map<PdgCode, int> &particle_list,
   }
 }
 
-void Nucleus::shift(double z_offset, double x_offset, double simulation_time) {
+void Nucleus::shift_nucleons(std::vector<ParticleData>::iterator first,
+                             std::vector<ParticleData>::iterator last,
+                             double z_offset, double x_offset,
+                             double simulation_time) {
   // Move the nucleus in z and x directions, and set the time.
-  for (auto i = begin(); i != end(); i++) {
+  for (auto i = first; i != last; i++) {
     FourVector this_position = i->position();
     this_position.set_x3(this_position.x3() + z_offset);
     this_position.set_x1(this_position.x1() + x_offset);
@@ -862,13 +862,12 @@ void OscarOutput<Format, Contents>::at_intermediate_time(
 template <OscarOutputFormat Format, int Contents>
 void OscarOutput<Format, Contents>::write_particledata(
     const ParticleData &data) {
-  std::fprintf(file_.get(), "%s",
-               formatter_.single_particle_data(data).c_str());
+  write(formatter_.single_particle_data(data));
 }
 
 template <OscarOutputFormat Format, int Contents>
 void OscarOutput<Format, Contents>::write(const ToASCII::type &buffer) {
-  std::fprintf(file_.get(), "%s", buffer.c_str());
+  std::fwrite(buffer.data(), sizeof(char), buffer.size(), file_.get());
 }
 
 namespace {
@@ -12,13 +12,13 @@
 #include <cmath>
 #include <initializer_list>
 #include <iostream>
-#include <memory>
 #include <set>
 #include <vector>
 
 #include "smash/average.h"
 #include "smash/clebschgordan.h"
 #include "smash/constants.h"
+#include "smash/interpolation.h"
 #include "smash/kinematics.h"
 #include "smash/logging.h"
 #include "smash/lowess.h"
@@ -27,6 +27,110 @@
 
 namespace smash {
 
+namespace {
+
+/**
+ * \param[in] x, y Measured data, possibly with several values of y for one x.
+ * \param[in] span, iterations Parameters of the LOWESS smoothing.
+ * \return The linear interpolation of the data averaged for equal x and
+ *         smoothed.
+ */
+InterpolateDataLinear<double> smoothed_data(const std::vector<double>& x,
+                                            const std::vector<double>& y,
+                                            double span, size_t iterations) {
+  auto [dedup_x, dedup_y] = dedup_avg(x, y);
+  dedup_y = smooth(dedup_x, dedup_y, span, iterations);
+  return InterpolateDataLinear<double>(dedup_x, dedup_y);
+}
+
+/**
+ * \param[in] sqrts Values of \f$\sqrt{s}\f$.
+ * \return The values of \f$s\f$.
+ */
+std::vector<double> squared(const std::vector<double>& sqrts) {
+  std::vector<double> s = sqrts;
+  for (auto& i : s) {
+    i = i * i;
+  }
+  return s;
+}
+
+/**
+ * The interpolations of the measured cross sections. They are created once,
+ * when the program starts, and are not modified afterwards, such that the
+ * parametrizations can be evaluated concurrently without any check whether
+ * the interpolations exist.
+ */
+struct MeasuredCrossSections {
+  /// Interpolation of the PIPLUSPIMINUS_TOTAL data
+  InterpolateDataLinear<double> pipluspiminus_total =
+      smoothed_data(PIPLUSPIMINUS_TOT_SQRTS, PIPLUSPIMINUS_TOT_SIG, 0.01, 10);
+  /// Interpolation of the PIZEROPIZERO_TOTAL data
+  InterpolateDataLinear<double> pizeropizero_total =
+      smoothed_data(PIZEROPIZERO_TOT_SQRTS, PIZEROPIZERO_TOT_SIG, 0.01, 10);
+  /// Interpolation of the PIPLUSP_TOTAL data
+  InterpolateDataLinear<double> piplusp_total =
+      smoothed_data(PIPLUSP_TOT_SQRTS, PIPLUSP_TOT_SIG, 0.01, 10);
+  /// Interpolation of the PIPLUSP_ELASTIC data
+  InterpolateDataLinear<double> piplusp_elastic =
+      smoothed_data(PIPLUSP_ELASTIC_P_LAB, PIPLUSP_ELASTIC_SIG, 0.1, 5);
+  /// Interpolation of the PIPLUSP_ELASTIC_RES data
+  InterpolateDataSpline piplusp_elastic_res{squared(PIPLUSP_RES_SQRTS),
+                                            PIPLUSP_RES_SIG};
+  /// Interpolation of the PIPLUSP_SIGMAPLUSKPLUS data
+  InterpolateDataLinear<double> piplusp_sigmapluskplus = smoothed_data(
+      PIPLUSP_SIGMAPLUSKPLUS_P_LAB, PIPLUSP_SIGMAPLUSKPLUS_SIG, 0.2, 5);
+  /// Interpolation of the PIMINUSP_TOTAL data
+  InterpolateDataLinear<double> piminusp_total =
+      smoothed_data(PIMINUSP_TOT_SQRTS, PIMINUSP_TOT_SIG, 0.01, 6);
+  /// Interpolation of the PIMINUSP_ELASTIC data
+  InterpolateDataLinear<double> piminusp_elastic =
+      smoothed_data(PIMINUSP_ELASTIC_P_LAB, PIMINUSP_ELASTIC_SIG, 0.2, 6);
+  /// Interpolation of the PIMINUSP_ELASTIC_RES data
+  InterpolateDataSpline piminusp_elastic_res = [] {
+    auto [dedup_x, dedup_y] =
+        dedup_avg<double>(squared(PIMINUSP_RES_SQRTS), PIMINUSP_RES_SIG);
+    return InterpolateDataSpline(dedup_x, dedup_y);
+  }();
+  /// Interpolation of the PIMINUSP_LAMBDAK0 data
+  InterpolateDataLinear<double> piminusp_lambdak0 =
+      smoothed_data(PIMINUSP_LAMBDAK0_P_LAB, PIMINUSP_LAMBDAK0_SIG, 0.2, 6);
+  /// Interpolation of the PIMINUSP_SIGMAMINUSKPLUS data
+  InterpolateDataLinear<double> piminusp_sigmaminuskplus = smoothed_data(
+      PIMINUSP_SIGMAMINUSKPLUS_P_LAB, PIMINUSP_SIGMAMINUSKPLUS_SIG, 0.2, 6);
+  /// Interpolation of the PIMINUSP_SIGMA0K0 data
+  InterpolateDataLinear<double> piminusp_sigma0k0 = smoothed_data(
+      PIMINUSP_SIGMA0K0_RES_SQRTS, PIMINUSP_SIGMA0K0_RES_SIG, 0.2, 6);
+  /// Interpolation of the KPLUSP_TOTAL data
+  InterpolateDataLinear<double> kplusp_total =
+      smoothed_data(KPLUSP_TOT_PLAB, KPLUSP_TOT_SIG, 0.1, 5);
+  /// Interpolation of the KPLUSN_TOTAL data
+  InterpolateDataLinear<double> kplusn_total =
+      smoothed_data(KPLUSN_TOT_PLAB, KPLUSN_TOT_SIG, 0.05, 5);
+  /// Interpolation of the KMINUSP_TOTAL data
+  InterpolateDataLinear<double> kminusp_total =
+      smoothed_data(KMINUSP_TOT_PLAB, KMINUSP_TOT_SIG, 0.01, 5);
+  /// Interpolation of the KMINUSN_TOTAL data
+  InterpolateDataLinear<double> kminusn_total =
+      smoothed_data(KMINUSN_TOT_PLAB, KMINUSN_TOT_SIG, 0.05, 5);
+  /// Interpolation of the KMINUSP_ELASTIC data
+  InterpolateDataLinear<double> kminusp_elastic =
+      smoothed_data(KMINUSP_ELASTIC_P_LAB, KMINUSP_ELASTIC_SIG, 0.1, 5);
+  /// Interpolation of the KMINUSP_ELASTIC_RES data
+  InterpolateDataSpline kminusp_elastic_res = [] {
+    std::vector<double> x = KMINUSP_RES_SQRTS;
+    for (auto& i : x) {
+      i = plab_from_s(i * i, kaon_mass, nucleon_mass);
+    }
+    return InterpolateDataSpline(x, KMINUSP_RES_SIG);
+  }();
+};
+
+/// The interpolations of all measured cross sections
+const MeasuredCrossSections measured{};
+
+}  // unnamed namespace
+
 bool parametrization_exists(const PdgCode& pdg_a, const PdgCode& pdg_b) {
   const bool two_nucleons = pdg_a.is_nucleon() && pdg_b.is_nucleon();
   const bool nucleon_and_kaon = (pdg_a.is_nucleon() && pdg_b.is_kaon()) ||
@@ -111,46 +215,25 @@ double pipi_string_hard(double mandelstam_s) {
 }
 
 double pipluspiminus_total(double sqrts) {
-  if (pipluspiminus_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(PIPLUSPIMINUS_TOT_SQRTS, PIPLUSPIMINUS_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.01, 10);
-    pipluspiminus_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double last = *(PIPLUSPIMINUS_TOT_SQRTS.end() - 1);
   if (sqrts < last)
-    return (*pipluspiminus_total_interpolation)(sqrts);
+    return measured.pipluspiminus_total(sqrts);
   else
     return pipi_string_hard(sqrts * sqrts);
 }
 
 double pizeropizero_total(double sqrts) {
-  if (pizeropizero_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(PIZEROPIZERO_TOT_SQRTS, PIZEROPIZERO_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.01, 10);
-    pizeropizero_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double last = *(PIZEROPIZERO_TOT_SQRTS.end() - 1);
   if (sqrts < last)
-    return (*pizeropizero_total_interpolation)(sqrts);
+    return measured.pizeropizero_total(sqrts);
   else
     return pipi_string_hard(sqrts * sqrts);
 }
 
 double piplusp_total(double sqrts) {
-  if (piplusp_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(PIPLUSP_TOT_SQRTS, PIPLUSP_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.01, 10);
-    piplusp_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double last = *(PIPLUSP_TOT_SQRTS.end() - 1);
   if (sqrts < last)
-    return (*piplusp_total_interpolation)(sqrts);
+    return measured.piplusp_total(sqrts);
   else
     return piplusp_high_energy(sqrts * sqrts);
 }
@@ -161,15 +244,8 @@ double piplusp_total(double sqrts) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 static double piplusp_elastic_pdg(double mandelstam_s) {
-  if (piplusp_elastic_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(PIPLUSP_ELASTIC_P_LAB, PIPLUSP_ELASTIC_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
-    piplusp_elastic_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
-  return (*piplusp_elastic_interpolation)(p_lab);
+  return measured.piplusp_elastic(p_lab);
 }
 
 double piplusp_elastic_high_energy(double mandelstam_s, double m1, double m2) {
@@ -202,16 +278,7 @@ double piplusp_elastic(double mandelstam_s) {
   }
 
   // The elastic contributions from decays still need to be subtracted.
-  if (piplusp_elastic_res_interpolation == nullptr) {
-    std::vector<double> x = PIPLUSP_RES_SQRTS;
-    for (auto& i : x) {
-      i = i * i;
-    }
-    std::vector<double> y = PIPLUSP_RES_SIG;
-    piplusp_elastic_res_interpolation =
-        std::make_unique<InterpolateDataSpline>(x, y);
-  }
-  sigma -= (*piplusp_elastic_res_interpolation)(mandelstam_s);
+  sigma -= measured.piplusp_elastic_res(mandelstam_s);
   if (sigma < 0) {
     sigma = really_small;
   }
@@ -224,31 +291,17 @@ double piplusp_elastic(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 double piplusp_sigmapluskplus_pdg(double mandelstam_s) {
-  if (piplusp_sigmapluskplus_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] = dedup_avg<double>(PIPLUSP_SIGMAPLUSKPLUS_P_LAB,
-                                                PIPLUSP_SIGMAPLUSKPLUS_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 5);
-    piplusp_sigmapluskplus_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
   /* If p_lab is beyond the upper bound of the linear interpolation,
    * InterpolationDataLinear will return the value at the upper bound and this
    * is what we want here. */
-  return (*piplusp_sigmapluskplus_interpolation)(p_lab);
+  return measured.piplusp_sigmapluskplus(p_lab);
 }
 
 double piminusp_total(double sqrts) {
-  if (piminusp_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(PIMINUSP_TOT_SQRTS, PIMINUSP_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.01, 6);
-    piminusp_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double last = *(PIMINUSP_TOT_SQRTS.end() - 1);
   if (sqrts < last)
-    return (*piminusp_total_interpolation)(sqrts);
+    return measured.piminusp_total(sqrts);
   else
     return piminusp_high_energy(sqrts * sqrts);
 }
@@ -259,15 +312,8 @@ double piminusp_total(double sqrts) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 static double piminusp_elastic_pdg(double mandelstam_s) {
-  if (piminusp_elastic_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(PIMINUSP_ELASTIC_P_LAB, PIMINUSP_ELASTIC_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
-    piminusp_elastic_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
-  return (*piminusp_elastic_interpolation)(p_lab);
+  return measured.piminusp_elastic(p_lab);
 }
 
 double piminusp_elastic(double mandelstam_s) {
@@ -292,17 +338,7 @@ double piminusp_elastic(double mandelstam_s) {
               0.88);
   }
   // The elastic contributions from decays still need to be subtracted.
-  if (piminusp_elastic_res_interpolation == nullptr) {
-    std::vector<double> x = PIMINUSP_RES_SQRTS;
-    for (auto& i : x) {
-      i = i * i;
-    }
-    std::vector<double> y = PIMINUSP_RES_SIG;
-    auto [dedup_x, dedup_y] = dedup_avg(x, y);
-    piminusp_elastic_res_interpolation =
-        std::make_unique<InterpolateDataSpline>(dedup_x, dedup_y);
-  }
-  sigma -= (*piminusp_elastic_res_interpolation)(mandelstam_s);
+  sigma -= measured.piminusp_elastic_res(mandelstam_s);
   if (sigma < 0) {
     sigma = really_small;
   }
@@ -315,15 +351,8 @@ double piminusp_elastic(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 double piminusp_lambdak0_pdg(double mandelstam_s) {
-  if (piminusp_lambdak0_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(PIMINUSP_LAMBDAK0_P_LAB, PIMINUSP_LAMBDAK0_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
-    piminusp_lambdak0_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
-  return (*piminusp_lambdak0_interpolation)(p_lab);
+  return measured.piminusp_lambdak0(p_lab);
 }
 
 /* pi- p -> Sigma- K+ cross section parametrization, PDG data.
@@ -332,15 +361,8 @@ double piminusp_lambdak0_pdg(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 double piminusp_sigmaminuskplus_pdg(double mandelstam_s) {
-  if (piminusp_sigmaminuskplus_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] = dedup_avg<double>(PIMINUSP_SIGMAMINUSKPLUS_P_LAB,
-                                                PIMINUSP_SIGMAMINUSKPLUS_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
-    piminusp_sigmaminuskplus_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, pion_mass, nucleon_mass);
-  return (*piminusp_sigmaminuskplus_interpolation)(p_lab);
+  return measured.piminusp_sigmaminuskplus(p_lab);
 }
 
 /* pi- p -> Sigma0 K0 cross section parametrization, resonance contribution.
@@ -349,15 +371,8 @@ double piminusp_sigmaminuskplus_pdg(double mandelstam_s) {
  * cross section was given for one sqrts value, the corresponding cross sections
  * are averaged. */
 double piminusp_sigma0k0_res(double mandelstam_s) {
-  if (piminusp_sigma0k0_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] = dedup_avg<double>(PIMINUSP_SIGMA0K0_RES_SQRTS,
-                                                PIMINUSP_SIGMA0K0_RES_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.2, 6);
-    piminusp_sigma0k0_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double sqrts = std::sqrt(mandelstam_s);
-  return (*piminusp_sigma0k0_interpolation)(sqrts);
+  return measured.piminusp_sigma0k0(sqrts);
 }
 
 double pp_elastic(double mandelstam_s) {
@@ -485,52 +500,23 @@ double deuteron_nucleon_elastic(double mandelstam_s) {
 }
 
 double kplusp_total(double mandelstam_s) {
-  if (kplusp_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(KPLUSP_TOT_PLAB, KPLUSP_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
-    kplusp_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
-  return (*kplusp_total_interpolation)(p_lab);
+  return measured.kplusp_total(p_lab);
 }
 
 double kplusn_total(double mandelstam_s) {
-  if (kplusn_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(KPLUSN_TOT_PLAB, KPLUSN_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.05, 5);
-    kplusn_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
-  return (*kplusn_total_interpolation)(p_lab);
+  return measured.kplusn_total(p_lab);
 }
 
 double kminusp_total(double mandelstam_s) {
-  if (kminusp_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(KMINUSP_TOT_PLAB, KMINUSP_TOT_SIG);
-    // Parametrization data is pre-smoothed
-    dedup_y = smooth(dedup_x, dedup_y, 0.01, 5);
-    kminusp_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
-  return (*kminusp_total_interpolation)(p_lab);
+  return measured.kminusp_total(p_lab);
 }
 
 double kminusn_total(double mandelstam_s) {
-  if (kminusn_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(KMINUSN_TOT_PLAB, KMINUSN_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.05, 5);
-    kminusn_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
-  return (*kminusn_total_interpolation)(p_lab);
+  return measured.kminusn_total(p_lab);
 }
 
 double kplusp_elastic_background(double mandelstam_s) {
@@ -560,15 +546,8 @@ double kplusn_k0p(double mandelstam_s) {
  * cross section was given for one p_lab value, the corresponding cross sections
  * are averaged. */
 static double kminusp_elastic_pdg(double mandelstam_s) {
-  if (kminusp_elastic_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(KMINUSP_ELASTIC_P_LAB, KMINUSP_ELASTIC_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
-    kminusp_elastic_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
-  return (*kminusp_elastic_interpolation)(p_lab);
+  return measured.kminusp_elastic(p_lab);
 }
 
 double kminusp_elastic_background(double mandelstam_s) {
@@ -593,22 +572,13 @@ double kminusp_elastic_background(double mandelstam_s) {
     sigma = kminusp_elastic_pdg(mandelstam_s);
   }
   // The elastic contributions from decays still need to be subtracted.
-  if (kminusp_elastic_res_interpolation == nullptr) {
-    std::vector<double> x = KMINUSP_RES_SQRTS;
-    for (auto& i : x) {
-      i = plab_from_s(i * i, kaon_mass, nucleon_mass);
-    }
-    std::vector<double> y = KMINUSP_RES_SIG;
-    kminusp_elastic_res_interpolation =
-        std::make_unique<InterpolateDataSpline>(x, y);
-  }
   const auto old_sigma = sigma;
-  sigma -= (*kminusp_elastic_res_interpolation)(p_lab);
+  sigma -= measured.kminusp_elastic_res(p_lab);
   if (sigma < 0) {
     std::cout << "NEGATIVE SIGMA: sigma=" << sigma
               << ", sqrt(s)=" << std::sqrt(mandelstam_s)
               << ", sig_el_exp=" << old_sigma
-              << ", sig_el_res=" << (*kminusp_elastic_res_interpolation)(p_lab)
+              << ", sig_el_res=" << measured.kminusp_elastic_res(p_lab)
               << std::endl;
   }
   assert(sigma >= 0);
@@ -638,28 +608,14 @@ double kbar0n_elastic_background(double mandelstam_s) {
 }
 
 double kplusp_inelastic_background(double mandelstam_s) {
-  if (kplusp_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(KPLUSP_TOT_PLAB, KPLUSP_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.1, 5);
-    kplusp_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
-  return (*kplusp_total_interpolation)(p_lab)-kplusp_elastic_background(
+  return measured.kplusp_total(p_lab)-kplusp_elastic_background(
       mandelstam_s);
 }
 
 double kplusn_inelastic_background(double mandelstam_s) {
-  if (kplusn_total_interpolation == nullptr) {
-    auto [dedup_x, dedup_y] =
-        dedup_avg<double>(KPLUSN_TOT_PLAB, KPLUSN_TOT_SIG);
-    dedup_y = smooth(dedup_x, dedup_y, 0.05, 5);
-    kplusn_total_interpolation =
-        std::make_unique<InterpolateDataLinear<double>>(dedup_x, dedup_y);
-  }
   const double p_lab = plab_from_s(mandelstam_s, kaon_mass, nucleon_mass);
-  return (*kplusn_total_interpolation)(p_lab)-kplusn_elastic_background(
+  return measured.kplusn_total(p_lab)-kplusn_elastic_background(
              mandelstam_s) -
          kplusn_k0p(mandelstam_s);
 }
@@ -767,7 +723,7 @@ double KaonNucleonRatios::get_ratio(const ParticleType& a,
   return ratios_.at(key);
 }
 
-/*thread_local (see #3075)*/ KaonNucleonRatios kaon_nucleon_ratios;
+thread_local KaonNucleonRatios kaon_nucleon_ratios;
 
 double kminusp_kbar0n(double mandelstam_s) {
   constexpr double a0 = 100;   // mb GeV^2
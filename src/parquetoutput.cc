@@ -0,0 +1,243 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/parquetoutput.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+#include "arrow/util/compression.h"
+#include "parquet/exception.h"
+#include "parquet/properties.h"
+#include "smash/logging.h"
+#include "smash/particles.h"
+
+namespace smash {
+
+/*!\Userguide
+ * \page doxypage_output_parquet
+ * SMASH supports the columnar <a href="https://parquet.apache.org">Apache
+ * Parquet</a> format for the \c "Particles" content, if SMASH was built with
+ * the Apache Arrow C++ library including Parquet support. It is requested with
+ * the \c "Parquet" format and, like the \c "ASCII" and \c "Binary" formats,
+ * it writes the quantities given in the \ref key_output_particles_quantities_
+ * "Quantities" key:
+ * \verbatim
+     Output:
+       Particles:
+           Format:     ["Parquet"]
+           Quantities: ["pdg", "p0", "pz", "mt"]
+   \endverbatim
+ *
+ * The file \c particles.parquet holds one row for every particle of every
+ * particle block, i.e. of every initial, intermediate or final particle list
+ * as selected by \ref key_output_particles_only_final_ "Only_Final". The
+ * columns are
+ * \li \c event (int32): Number of the event, starting with 0.
+ * \li \c ensemble (int32): Number of the ensemble, starting with 0.
+ * \li \c block (int32): Number of the particle block of the event and ensemble,
+ *     starting with 0.
+ * \li one column for every quantity, in the order of the \c Quantities list.
+ *     Integer quantities are stored as int32 and all others as double, see
+ *     \ref doxypage_output_ascii for the list of quantities.
+ *
+ * The rows of \ref key_output_particles_events_per_row_group_
+ * "Events_Per_Row_Group" events are written as one row group, such that
+ * analyses can process the row groups in parallel. Integer columns, except for
+ * the particle ID, are dictionary encoded. This compresses the few distinct
+ * PDG codes very well. All columns are compressed with zstd, if the Arrow
+ * library supports it, and with snappy otherwise.
+ */
+
+/// The quantities which are written as integers
+static const std::set<std::string> integer_quantities = {
+    "pdg", "ID", "id", "charge", "ncoll", "proc_id_origin", "proc_type_origin",
+    "pdg_mother1", "pdg_mother2", "baryon_number", "strangeness", "0"};
+
+/// \return The compression supported by the Arrow library.
+static arrow::Compression::type parquet_compression() {
+  if (arrow::util::Codec::IsAvailable(arrow::Compression::ZSTD)) {
+    return arrow::Compression::ZSTD;
+  } else if (arrow::util::Codec::IsAvailable(arrow::Compression::SNAPPY)) {
+    return arrow::Compression::SNAPPY;
+  }
+  return arrow::Compression::UNCOMPRESSED;
+}
+
+ParquetOutput::ParquetOutput(const std::filesystem::path &path,
+                             const std::string &name,
+                             const OutputParameters &out_par)
+    : OutputInterface(name),
+      filename_(path / "particles.parquet"),
+      only_final_(out_par.part_only_final),
+      events_per_row_group_(out_par.part_events_per_row_group),
+      formatter_(out_par.quantities.at("Particles")) {
+  if (name != "Particles") {
+    throw std::invalid_argument("Parquet output not available for '" + name +
+                                "' content.");
+  }
+  if (events_per_row_group_ < 1) {
+    throw std::invalid_argument(
+        "The number of events per row group of the Parquet output has to be "
+        "positive.");
+  }
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  for (const char *column : {"event", "ensemble", "block"}) {
+    fields.push_back(arrow::field(column, arrow::int32()));
+    columns_.push_back(Column{true});
+  }
+  for (const std::string &quantity : out_par.quantities.at("Particles")) {
+    const bool is_integer = integer_quantities.count(quantity) > 0;
+    fields.push_back(arrow::field(
+        quantity, is_integer ? arrow::int32() : arrow::float64()));
+    columns_.push_back(Column{is_integer});
+  }
+  schema_ = arrow::schema(fields);
+
+  parquet::WriterProperties::Builder properties;
+  properties.disable_dictionary()->compression(parquet_compression());
+  for (std::size_t i = 0; i < fields.size(); i++) {
+    if (columns_[i].is_integer && fields[i]->name() != "ID" &&
+        fields[i]->name() != "id") {
+      properties.enable_dictionary(fields[i]->name());
+    }
+  }
+  filename_unfinished_ = filename_;
+  filename_unfinished_ += ".unfinished";
+  PARQUET_ASSIGN_OR_THROW(
+      file_, arrow::io::FileOutputStream::Open(filename_unfinished_.string()));
+  PARQUET_ASSIGN_OR_THROW(
+      writer_,
+      parquet::arrow::FileWriter::Open(*schema_, arrow::default_memory_pool(),
+                                       file_, properties.build()));
+}
+
+ParquetOutput::~ParquetOutput() {
+  try {
+    write_row_group();
+    PARQUET_THROW_NOT_OK(writer_->Close());
+    PARQUET_THROW_NOT_OK(file_->Close());
+    std::filesystem::rename(filename_unfinished_, filename_);
+  } catch (const std::exception &e) {
+    logg[LOutput].error("Finishing the Parquet output failed: ", e.what());
+  }
+}
+
+void ParquetOutput::at_eventstart(const Particles &particles,
+                                  const EventLabel &event_label,
+                                  const EventInfo &) {
+  const auto ensemble = static_cast<std::size_t>(event_label.ensemble_number);
+  if (next_block_.size() <= ensemble) {
+    next_block_.resize(ensemble + 1);
+  }
+  next_block_[ensemble] = 0;
+  if (only_final_ == OutputOnlyFinal::No) {
+    add_block(particles, event_label);
+  }
+}
+
+void ParquetOutput::at_eventend(const Particles &particles,
+                                const EventLabel &event_label,
+                                const EventInfo &event) {
+  if (!(event.empty_event && only_final_ == OutputOnlyFinal::IfNotEmpty)) {
+    add_block(particles, event_label);
+  }
+  // The event is complete, once its last ensemble ended
+  if (event_label.ensemble_number == event.n_ensembles - 1 &&
+      ++n_events_ >= events_per_row_group_) {
+    write_row_group();
+  }
+}
+
+void ParquetOutput::at_intermediate_time(const Particles &particles,
+                                         const std::unique_ptr<Clock> &,
+                                         const DensityParameters &,
+                                         const EventLabel &event_label,
+                                         const EventInfo &) {
+  if (only_final_ == OutputOnlyFinal::No) {
+    add_block(particles, event_label);
+  }
+}
+
+void ParquetOutput::add_block(const Particles &particles,
+                              const EventLabel &event_label) {
+  const auto ensemble = static_cast<std::size_t>(event_label.ensemble_number);
+  if (next_block_.size() <= ensemble) {
+    next_block_.resize(ensemble + 1);
+  }
+  const std::int32_t block = next_block_[ensemble]++;
+  const std::size_t n_particles = particles.size();
+  const std::vector<char> data = formatter_.particles_data_chunk(particles);
+  std::size_t row_size = 0;
+  for (std::size_t i = 3; i < columns_.size(); i++) {
+    row_size += columns_[i].is_integer ? sizeof(std::int32_t) : sizeof(double);
+  }
+  if (data.size() != n_particles * row_size) {
+    throw std::logic_error(
+        "The quantities of the Parquet output do not match the formatter.");
+  }
+  columns_[0].integers.insert(columns_[0].integers.end(), n_particles,
+                              event_label.event_number);
+  columns_[1].integers.insert(columns_[1].integers.end(), n_particles,
+                              event_label.ensemble_number);
+  columns_[2].integers.insert(columns_[2].integers.end(), n_particles, block);
+  // The formatter writes the quantities of every particle one after the other
+  const char *value = data.data();
+  for (std::size_t p = 0; p < n_particles; p++) {
+    for (std::size_t i = 3; i < columns_.size(); i++) {
+      Column &column = columns_[i];
+      if (column.is_integer) {
+        std::int32_t x;
+        std::memcpy(&x, value, sizeof(x));
+        column.integers.push_back(x);
+        value += sizeof(x);
+      } else {
+        double x;
+        std::memcpy(&x, value, sizeof(x));
+        column.doubles.push_back(x);
+        value += sizeof(x);
+      }
+    }
+  }
+  n_rows_ += static_cast<std::int64_t>(n_particles);
+}
+
+void ParquetOutput::write_row_group() {
+  n_events_ = 0;
+  if (n_rows_ == 0) {
+    return;
+  }
+  std::vector<std::shared_ptr<arrow::Array>> arrays;
+  for (Column &column : columns_) {
+    std::shared_ptr<arrow::Array> array;
+    if (column.is_integer) {
+      arrow::Int32Builder builder;
+      PARQUET_THROW_NOT_OK(builder.AppendValues(column.integers));
+      PARQUET_THROW_NOT_OK(builder.Finish(&array));
+      column.integers.clear();
+    } else {
+      arrow::DoubleBuilder builder;
+      PARQUET_THROW_NOT_OK(builder.AppendValues(column.doubles));
+      PARQUET_THROW_NOT_OK(builder.Finish(&array));
+      column.doubles.clear();
+    }
+    arrays.push_back(std::move(array));
+  }
+  const std::shared_ptr<arrow::Table> table =
+      arrow::Table::Make(schema_, arrays, n_rows_);
+  // A chunk size covering all rows makes the table one row group
+  PARQUET_THROW_NOT_OK(
+      writer_->WriteTable(*table, std::max<std::int64_t>(n_rows_, 1)));
+  n_rows_ = 0;
+}
+
+}  // namespace smash
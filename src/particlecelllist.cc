@@ -0,0 +1,122 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/particlecelllist.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "smash/constants.h"
+
+namespace smash {
+
+ParticleCellList::ParticleCellList(const ParticleList &particles,
+                                   double cutoff)
+    : particles_(particles),
+      min_position_({0., 0., 0.}),
+      index_factor_({0., 0., 0.}),
+      number_of_cells_({1, 1, 1}) {
+  if (!(cutoff > 0.)) {
+    throw std::invalid_argument(
+        "The cutoff of the particle cell list has to be positive.");
+  }
+  // The safety margin guarantees that rounding cannot move a particle closer
+  // than the cutoff to a cell which is not a neighbour
+  const double min_cell_length = cutoff * (1. + really_small);
+  std::array<double, 3> max_position = min_position_;
+  if (!particles_.empty()) {
+    const ThreeVector first_position = particles_.front().position().threevec();
+    for (int i = 0; i < 3; i++) {
+      min_position_[i] = max_position[i] = first_position[i];
+    }
+  }
+  for (const ParticleData &p : particles_) {
+    const ThreeVector pos = p.position().threevec();
+    for (int i = 0; i < 3; i++) {
+      min_position_[i] = std::min(min_position_[i], pos[i]);
+      max_position[i] = std::max(max_position[i], pos[i]);
+    }
+  }
+  const double max_cells = std::max(
+      1., std::floor(std::cbrt(static_cast<double>(particles_.size()))));
+  for (int i = 0; i < 3; i++) {
+    const double length = max_position[i] - min_position_[i];
+    const double n_cells =
+        std::min(max_cells, std::floor(length / min_cell_length));
+    if (n_cells < 1.) {
+      // All particles are in one cell, which is shorter than the cutoff
+      number_of_cells_[i] = 1;
+      index_factor_[i] = 1. / min_cell_length;
+    } else {
+      number_of_cells_[i] = static_cast<int>(n_cells);
+      index_factor_[i] = n_cells / length;
+    }
+  }
+
+  // Sort the particles into the cells, keeping their order within every cell
+  const std::size_t total_cells = cell_index(0, 0, number_of_cells_[2]);
+  std::vector<std::size_t> cell_of_particle;
+  cell_of_particle.reserve(particles_.size());
+  cell_start_.assign(total_cells + 1, 0);
+  for (const ParticleData &p : particles_) {
+    const ThreeVector pos = p.position().threevec();
+    std::array<int, 3> cell;
+    for (int i = 0; i < 3; i++) {
+      cell[i] = std::min(
+          number_of_cells_[i] - 1,
+          static_cast<int>((pos[i] - min_position_[i]) * index_factor_[i]));
+    }
+    cell_of_particle.push_back(cell_index(cell[0], cell[1], cell[2]));
+    cell_start_[cell_of_particle.back() + 1]++;
+  }
+  for (std::size_t cell = 0; cell < total_cells; cell++) {
+    cell_start_[cell + 1] += cell_start_[cell];
+  }
+  particle_indices_.resize(particles_.size());
+  std::vector<std::size_t> next_position(cell_start_.begin(),
+                                         cell_start_.end() - 1);
+  for (std::size_t i = 0; i < cell_of_particle.size(); i++) {
+    particle_indices_[next_position[cell_of_particle[i]]++] = i;
+  }
+}
+
+void ParticleCellList::find_candidates(const ThreeVector &r,
+                                       ParticleList &candidates) const {
+  candidates.clear();
+  std::array<int, 3> lower, upper;
+  for (int i = 0; i < 3; i++) {
+    const double cell =
+        std::floor((r[i] - min_position_[i]) * index_factor_[i]);
+    // Particles closer than the cutoff are at most one cell away
+    if (cell + 1. < 0. || cell - 1. > number_of_cells_[i] - 1) {
+      return;
+    }
+    lower[i] = std::max(0, static_cast<int>(cell) - 1);
+    upper[i] = std::min(number_of_cells_[i] - 1, static_cast<int>(cell) + 1);
+  }
+  std::vector<std::size_t> indices;
+  for (int iz = lower[2]; iz <= upper[2]; iz++) {
+    for (int iy = lower[1]; iy <= upper[1]; iy++) {
+      // The cells of a row along x are stored one after the other
+      indices.insert(
+          indices.end(),
+          particle_indices_.begin() + cell_start_[cell_index(lower[0], iy, iz)],
+          particle_indices_.begin() +
+              cell_start_[cell_index(upper[0], iy, iz) + 1]);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  candidates.reserve(indices.size());
+  for (const std::size_t i : indices) {
+    candidates.push_back(particles_[i]);
+  }
+}
+
+}  // namespace smash
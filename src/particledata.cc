@@ -40,7 +40,7 @@ void ParticleData::set_history(int ncoll, uint32_t pid, ProcessType pt,
     history_.time_last_collision = time_last_coll;
   }
   history_.id_process = pid;
-  history_.process_type = pt;
+  process_type_ = static_cast<uint8_t>(pt);
   switch (pt) {
     case ProcessType::Decay:
     case ProcessType::Wall:
@@ -153,12 +153,16 @@ double ParticleData::xsec_scaling_factor(double delta_time) const {
       scaling_factor = initial_xsec_scaling_factor_;
     } else {
       // particles are in the process of formation at the given time
+      const double formed_fraction =
+          (time_of_interest - begin_formation_time_) /
+          (formation_time_ - begin_formation_time_);
+      // The linear formation is common and std::pow(x, 1.) is exactly x
       scaling_factor =
           initial_xsec_scaling_factor_ +
           (1. - initial_xsec_scaling_factor_) *
-              std::pow((time_of_interest - begin_formation_time_) /
-                           (formation_time_ - begin_formation_time_),
-                       formation_power_);
+              (formation_power_ == 1.
+                   ? formed_fraction
+                   : std::pow(formed_fraction, formation_power_));
     }
   }
   return scaling_factor;
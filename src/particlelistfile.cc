@@ -0,0 +1,176 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/particlelistfile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace smash {
+
+ParticleListFile::ParticleListFile(const std::filesystem::path &path,
+                                   Format format) {
+  const int fd = open(path.native().c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open particle list file \"" +
+                             path.native() + "\".");
+  }
+  struct stat file_status;
+  if (fstat(fd, &file_status) != 0) {
+    close(fd);
+    throw std::runtime_error("Could not read size of particle list file \"" +
+                             path.native() + "\".");
+  }
+  size_ = static_cast<std::size_t>(file_status.st_size);
+  // An empty file cannot be mapped, but it has no events anyway
+  if (size_ > 0) {
+    void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Could not map particle list file \"" +
+                               path.native() + "\" into memory.");
+    }
+    data_ = static_cast<const char *>(mapping);
+    madvise(mapping, size_, MADV_SEQUENTIAL);
+  }
+  // The mapping stays valid after the file is closed
+  close(fd);
+
+  if (format == Format::ASCII) {
+    index_ascii_events();
+  } else {
+    try {
+      index_binary_events();
+    } catch (const std::runtime_error &e) {
+      throw std::runtime_error("Invalid binary particle list file \"" +
+                               path.native() + "\": " + e.what());
+    }
+  }
+}
+
+ParticleListFile::~ParticleListFile() {
+  if (data_) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+}
+
+void ParticleListFile::index_ascii_events() {
+  const std::string_view file{data_, size_};
+  std::size_t begin = 0, line_begin = 0;
+  int line_number = 1, first_line = 1;
+  while (line_begin < size_) {
+    const void *newline =
+        std::memchr(data_ + line_begin, '\n', size_ - line_begin);
+    const std::size_t line_end =
+        newline ? static_cast<const char *>(newline) - data_ : size_;
+    const std::string_view line =
+        file.substr(line_begin, line_end - line_begin);
+    line_begin = line_end + 1;
+    line_number++;
+    if (line.find(" end ") != std::string_view::npos) {
+      events_.push_back({file.substr(begin, line.data() - data_ - begin),
+                         first_line});
+      begin = line_begin;
+      first_line = line_number;
+    }
+  }
+  if (begin < size_ &&
+      file.find_first_not_of(" \t\r\n", begin) != std::string_view::npos) {
+    events_.push_back({file.substr(begin), first_line});
+  }
+}
+
+void ParticleListFile::index_binary_events() {
+  const std::string_view file{data_, size_};
+  std::size_t position = 0;
+  // Copy the next value of the file and step over it
+  auto read = [this, &position](auto &value) {
+    if (size_ - position < sizeof(value)) {
+      throw std::runtime_error("The file ends within a block.");
+    }
+    std::memcpy(&value, data_ + position, sizeof(value));
+    position += sizeof(value);
+  };
+  auto skip = [this, &position](std::uint64_t n_bytes) {
+    if (size_ - position < n_bytes) {
+      throw std::runtime_error("The file ends within a block.");
+    }
+    position += n_bytes;
+  };
+
+  char magic_number[4];
+  read(magic_number);
+  if (std::string_view(magic_number, sizeof(magic_number)) != "SMSH") {
+    throw std::runtime_error("It is not a SMASH binary file.");
+  }
+  std::uint16_t format_version;
+  read(format_version);
+  if (format_version != 10) {
+    throw std::runtime_error(
+        "Only uncompressed files of format version 10 can be read.");
+  }
+  read(format_variant_);
+  std::uint64_t line_size = 9 * sizeof(double) + 3 * sizeof(std::int32_t);
+  if (format_variant_ == 1) {
+    line_size += 3 * sizeof(double) + 7 * sizeof(std::int32_t);
+  } else if (format_variant_ != 0) {
+    throw std::runtime_error(
+        "Only OSCAR 2013 and extended OSCAR 2013 quantities can be read.");
+  }
+  std::uint32_t version_length;
+  read(version_length);
+  skip(version_length);
+
+  std::size_t begin = position;
+  while (position < size_) {
+    char block_type;
+    read(block_type);
+    if (block_type == 'p') {
+      std::int32_t event_number, ensemble_number;
+      std::uint32_t n_particles;
+      read(event_number);
+      read(ensemble_number);
+      read(n_particles);
+      skip(n_particles * line_size);
+    } else if (block_type == 'f') {
+      events_.push_back({file.substr(begin, position - 1 - begin), 0});
+      // Event and ensemble number, impact parameter and empty event flag
+      skip(2 * sizeof(std::int32_t) + sizeof(double) + sizeof(char));
+      begin = position;
+    } else {
+      throw std::runtime_error(
+          std::string("Unexpected block '") + block_type +
+          "', only particle and event end blocks can be read.");
+    }
+  }
+  if (begin < size_) {
+    events_.push_back({file.substr(begin), 0});
+  }
+}
+
+void ParticleListFile::prefetch(std::size_t i) const {
+  if (i >= events_.size() || events_[i].content.empty()) {
+    return;
+  }
+  // The advised range has to start at a page boundary
+  static const std::size_t page_size = sysconf(_SC_PAGESIZE);
+  const std::size_t begin = events_[i].content.data() - data_;
+  const std::size_t page_begin = begin - begin % page_size;
+  madvise(const_cast<char *>(data_) + page_begin,
+          begin + events_[i].content.size() - page_begin, MADV_WILLNEED);
+}
+
+}  // namespace smash
@@ -0,0 +1,269 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/particleliststream.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace smash {
+
+ParticleListStream::ParticleListStream(const std::string &source,
+                                       ParticleListFile::Format format,
+                                       std::size_t queue_size)
+    : source_(source), format_(format), queue_size_(queue_size) {
+  const std::string socket_prefix = "unix:";
+  if (source == "-") {
+    fd_ = STDIN_FILENO;
+  } else if (source.compare(0, socket_prefix.size(), socket_prefix) == 0) {
+    const std::string path = source.substr(socket_prefix.size());
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+      throw std::runtime_error("The socket path of particle list stream \"" +
+                               source + "\" is too long.");
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ >= 0 && connect(fd_, reinterpret_cast<sockaddr *>(&address),
+                            sizeof(address)) != 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+  } else {
+    // Opening a named pipe waits for its writer
+    fd_ = open(source.c_str(), O_RDONLY);
+  }
+  if (fd_ < 0) {
+    throw std::runtime_error("Could not open particle list stream \"" +
+                             source + "\".");
+  }
+  if (pipe(wake_pipe_) != 0) {
+    if (fd_ != STDIN_FILENO) {
+      close(fd_);
+    }
+    throw std::runtime_error("Could not create the pipe to stop reading \"" +
+                             source + "\".");
+  }
+  reader_ = std::thread(&ParticleListStream::read_events, this);
+}
+
+ParticleListStream::~ParticleListStream() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  changed_.notify_all();
+  // Wake up the reader if it waits for the source
+  const char wake = 0;
+  [[maybe_unused]] const ssize_t written = write(wake_pipe_[1], &wake, 1);
+  reader_.join();
+  close(wake_pipe_[0]);
+  close(wake_pipe_[1]);
+  if (fd_ != STDIN_FILENO) {
+    close(fd_);
+  }
+}
+
+std::optional<ParticleListStream::Event> ParticleListStream::next() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [this] { return !queue_.empty() || finished_; });
+  if (!queue_.empty()) {
+    Event event = std::move(queue_.front());
+    queue_.pop_front();
+    changed_.notify_all();
+    return event;
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  return std::nullopt;
+}
+
+void ParticleListStream::read_events() {
+  try {
+    if (format_ == ParticleListFile::Format::ASCII) {
+      read_ascii_events();
+    } else {
+      try {
+        read_binary_events();
+      } catch (const std::runtime_error &e) {
+        throw std::runtime_error("Invalid binary particle list stream \"" +
+                                 source_ + "\": " + e.what());
+      }
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_ = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+  }
+  changed_.notify_all();
+}
+
+void ParticleListStream::read_ascii_events() {
+  // The current event starts at the begin of the buffer
+  std::size_t line_begin = 0;
+  int line_number = 1, first_line = 1;
+  while (true) {
+    const std::size_t newline = buffer_.find('\n', line_begin);
+    const bool at_end = newline == std::string::npos && !read_chunk();
+    if (newline == std::string::npos && !at_end) {
+      continue;
+    }
+    const std::size_t line_end = at_end ? buffer_.size() : newline;
+    const std::string_view line(buffer_.data() + line_begin,
+                                line_end - line_begin);
+    line_number++;
+    if (line.find(" end ") != std::string_view::npos) {
+      push({buffer_.substr(0, line_begin), first_line});
+      buffer_.erase(0, std::min(line_end + 1, buffer_.size()));
+      line_begin = 0;
+      first_line = line_number;
+    } else {
+      line_begin = line_end + 1;
+    }
+    if (at_end) {
+      break;
+    }
+  }
+  if (buffer_.find_first_not_of(" \t\r\n") != std::string::npos) {
+    push({std::move(buffer_), first_line});
+  }
+}
+
+void ParticleListStream::read_binary_events() {
+  // Position of the next unread byte in the buffer
+  std::size_t position = 0;
+  auto skip = [this, &position](std::uint64_t n_bytes) {
+    if (!fill(position + n_bytes)) {
+      throw std::runtime_error("The stream ends within a block.");
+    }
+    position += n_bytes;
+  };
+  // Copy the next value of the stream and step over it
+  auto read = [this, &position, &skip](auto &value) {
+    skip(sizeof(value));
+    std::memcpy(&value, buffer_.data() + position - sizeof(value),
+                sizeof(value));
+  };
+
+  char magic_number[4];
+  read(magic_number);
+  if (std::string_view(magic_number, sizeof(magic_number)) != "SMSH") {
+    throw std::runtime_error("It is not a SMASH binary stream.");
+  }
+  std::uint16_t format_version;
+  read(format_version);
+  if (format_version != 10) {
+    throw std::runtime_error(
+        "Only uncompressed streams of format version 10 can be read.");
+  }
+  read(format_variant_);
+  std::uint64_t line_size = 9 * sizeof(double) + 3 * sizeof(std::int32_t);
+  if (format_variant_ == 1) {
+    line_size += 3 * sizeof(double) + 7 * sizeof(std::int32_t);
+  } else if (format_variant_ != 0) {
+    throw std::runtime_error(
+        "Only OSCAR 2013 and extended OSCAR 2013 quantities can be read.");
+  }
+  std::uint32_t version_length;
+  read(version_length);
+  skip(version_length);
+  // The current event starts at the begin of the buffer
+  buffer_.erase(0, position);
+  position = 0;
+
+  while (fill(position + 1)) {
+    char block_type;
+    read(block_type);
+    if (block_type == 'p') {
+      std::int32_t event_number, ensemble_number;
+      std::uint32_t n_particles;
+      read(event_number);
+      read(ensemble_number);
+      read(n_particles);
+      skip(n_particles * line_size);
+    } else if (block_type == 'f') {
+      push({buffer_.substr(0, position - 1), 0});
+      // Event and ensemble number, impact parameter and empty event flag
+      skip(2 * sizeof(std::int32_t) + sizeof(double) + sizeof(char));
+      buffer_.erase(0, position);
+      position = 0;
+    } else {
+      throw std::runtime_error(
+          std::string("Unexpected block '") + block_type +
+          "', only particle and event end blocks can be read.");
+    }
+  }
+  if (position > 0) {
+    buffer_.resize(position);
+    push({std::move(buffer_), 0});
+  }
+}
+
+bool ParticleListStream::read_chunk() {
+  constexpr std::size_t chunk_size = 1 << 16;
+  pollfd fds[2] = {{fd_, POLLIN, 0}, {wake_pipe_[0], POLLIN, 0}};
+  while (true) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Could not wait for particle list stream \"" +
+                               source_ + "\".");
+    }
+    if (fds[1].revents != 0) {
+      return false;
+    }
+    const std::size_t size = buffer_.size();
+    buffer_.resize(size + chunk_size);
+    const ssize_t n_read = ::read(fd_, buffer_.data() + size, chunk_size);
+    buffer_.resize(size + std::max<ssize_t>(n_read, 0));
+    if (n_read >= 0) {
+      return n_read > 0;
+    } else if (errno != EINTR && errno != EAGAIN) {
+      throw std::runtime_error("Could not read particle list stream \"" +
+                               source_ + "\".");
+    }
+  }
+}
+
+bool ParticleListStream::fill(std::size_t n_bytes) {
+  while (buffer_.size() < n_bytes) {
+    if (!read_chunk()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ParticleListStream::push(Event event) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock,
+                [this] { return stopped_ || queue_.size() < queue_size_; });
+  if (!stopped_) {
+    queue_.push_back(std::move(event));
+    changed_.notify_all();
+  }
+}
+
+}  // namespace smash
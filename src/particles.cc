@@ -9,17 +9,38 @@
 
 #include "smash/particles.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace smash {
 
-Particles::Particles() : data_(new ParticleData[data_capacity_]) {
+static_assert(std::is_trivially_destructible_v<ParticleData>,
+              "The storage of the particles is freed without destroying them.");
+
+Particles::Particles() : data_(allocate(data_capacity_)) {
   for (unsigned i = 0; i < data_capacity_; ++i) {
     data_[i].index_ = i;
   }
 }
 
+std::unique_ptr<ParticleData[], HugePages::Deleter> Particles::allocate(
+    unsigned capacity) {
+  auto *data = static_cast<ParticleData *>(
+      HugePages::allocate(capacity * sizeof(ParticleData)));
+  for (unsigned i = 0; i < capacity; ++i) {
+    new (data + i) ParticleData;
+  }
+  return std::unique_ptr<ParticleData[], HugePages::Deleter>(data);
+}
+
 inline void Particles::ensure_capacity(unsigned to_add) {
   if (data_size_ + to_add >= data_capacity_) {
     increase_capacity((data_capacity_ + to_add) * 2u);
@@ -29,8 +50,13 @@ inline void Particles::ensure_capacity(unsigned to_add) {
 
 void Particles::increase_capacity(unsigned new_capacity) {
   assert(new_capacity > data_capacity_);
+  reallocate(new_capacity);
+}
+
+void Particles::reallocate(unsigned new_capacity) {
+  assert(new_capacity > data_size_);
   data_capacity_ = new_capacity;
-  std::unique_ptr<ParticleData[]> new_memory(new ParticleData[data_capacity_]);
+  auto new_memory = allocate(data_capacity_);
   unsigned i = 0;
   for (; i < data_size_; ++i) {
     new_memory[i] = data_[i];
@@ -45,6 +71,7 @@ inline void Particles::copy_in(ParticleData &to, const ParticleData &from) {
   to.id_ = ++id_max_;
   to.type_ = from.type_;
   from.copy_to(to);
+  set_slot(to.id_, to.index_);
 }
 
 const ParticleData &Particles::insert(const ParticleData &p) {
@@ -72,6 +99,7 @@ void Particles::create(size_t number, PdgCode pdg) {
     data_[offset].id_ = ++id_max_;
     data_[offset].type_ = pd.type_;
     data_[offset].hole_ = false;
+    set_slot(id_max_, offset);
     --number;
   }
   if (number) {
@@ -81,6 +109,7 @@ void Particles::create(size_t number, PdgCode pdg) {
       pd.copy_to(*ptr);
       ptr->id_ = ++id_max_;
       ptr->type_ = pd.type_;
+      set_slot(id_max_, ptr->index_);
     }
     data_size_ += number;
   }
@@ -102,12 +131,14 @@ ParticleData &Particles::create(const PdgCode pdg) {
   pd.copy_to(*ptr);
   ptr->id_ = ++id_max_;
   ptr->type_ = pd.type_;
+  set_slot(id_max_, ptr->index_);
   return *ptr;
 }
 
 void Particles::remove(const ParticleData &p) {
   assert(is_valid(p));
   const unsigned index = p.index_;
+  set_slot(p.id(), no_slot);
   if (index == data_size_ - 1) {
     --data_size_;
   } else {
@@ -122,6 +153,7 @@ void Particles::replace(const ParticleList &to_remove, ParticleList &to_add) {
   for (; i < std::min(to_remove.size(), to_add.size()); ++i) {
     assert(is_valid(to_remove[i]));
     const auto index = to_remove[i].index_;
+    set_slot(to_remove[i].id(), no_slot);
     copy_in(data_[index], to_add[i]);
     to_add[i].id_ = data_[index].id_;
     to_add[i].index_ = index;
@@ -143,6 +175,168 @@ void Particles::reset() {
     data_[index].hole_ = false;
   }
   dirty_.clear();
+  slots_.clear();
+}
+
+void Particles::copy_from(const Particles &other) {
+  reset();
+  ensure_capacity(other.size());
+  for (const ParticleData &p : other) {
+    ParticleData &copy = data_[data_size_];
+    copy = p;
+    copy.index_ = data_size_;
+    ++data_size_;
+  }
+  id_max_ = other.id_max_;
+  refill_slots();
+}
+
+void Particles::copy_from(
+    const Particles &other,
+    const std::function<bool(const ParticleData &)> &keep) {
+  reset();
+  ensure_capacity(other.size());
+  for (const ParticleData &p : other) {
+    if (!keep(p)) {
+      continue;
+    }
+    ParticleData &copy = data_[data_size_];
+    copy = p;
+    copy.index_ = data_size_;
+    ++data_size_;
+  }
+  id_max_ = other.id_max_;
+  refill_slots();
+}
+
+void Particles::save(CheckpointWriter &checkpoint) const {
+  static_assert(std::is_trivially_copyable_v<ParticleData>,
+                "The particles are written to checkpoints as bytes.");
+  checkpoint.put(id_max_);
+  checkpoint.put(data_size_);
+  for (unsigned i = 0; i < data_size_; ++i) {
+    checkpoint.put(data_[i]);
+  }
+  checkpoint.put(dirty_);
+}
+
+void Particles::restore(CheckpointReader &checkpoint) {
+  reset();
+  checkpoint.get(id_max_);
+  const auto size = checkpoint.get<unsigned>();
+  ensure_capacity(size);
+  for (unsigned i = 0; i < size; ++i) {
+    checkpoint.get(data_[i]);
+  }
+  data_size_ = size;
+  checkpoint.get(dirty_);
+  refill_slots();
+}
+
+void Particles::refill_slots() {
+  slots_.assign(id_max_ + 1, no_slot);
+  for (unsigned i = 0; i < data_size_; ++i) {
+    if (!data_[i].hole_) {
+      set_slot(data_[i].id_, i);
+    }
+  }
+}
+
+void Particles::compact() {
+  if (dirty_.empty()) {
+    return;
+  }
+  unsigned size = 0;
+  for (unsigned i = 0; i < data_size_; ++i) {
+    if (data_[i].hole_) {
+      continue;
+    }
+    if (size != i) {
+      data_[size] = data_[i];
+      data_[size].index_ = size;
+      set_slot(data_[size].id_, size);
+    }
+    ++size;
+  }
+  // The freed entries are no holes, like all entries behind the last particle
+  for (unsigned i = size; i < data_size_; ++i) {
+    data_[i].hole_ = false;
+  }
+  data_size_ = size;
+  dirty_.clear();
+}
+
+void Particles::shrink_to_fit() {
+  compact();
+  // The storage always keeps an entry behind the last particle
+  if (data_size_ + 1u < data_capacity_) {
+    reallocate(data_size_ + 1u);
+  }
+  dirty_.shrink_to_fit();
+  slots_.shrink_to_fit();
+}
+
+void Particles::relocate() {
+  reallocate(data_capacity_);
+  std::vector<unsigned>(slots_).swap(slots_);
+}
+
+namespace {
+/**
+ * \return The given number of at most 10 bits with two zero bits inserted
+ * after every bit, such that three of them can be interleaved.
+ *
+ * \param[in] x The number to be spread.
+ */
+std::uint32_t spread_bits(std::uint32_t x) {
+  x = (x | (x << 16)) & 0x030000ff;
+  x = (x | (x << 8)) & 0x0300f00f;
+  x = (x | (x << 4)) & 0x030c30c3;
+  x = (x | (x << 2)) & 0x09249249;
+  return x;
+}
+}  // unnamed namespace
+
+void Particles::sort_along_morton_curve() {
+  compact();
+  if (data_size_ < 2) {
+    return;
+  }
+  constexpr unsigned n_intervals = 1u << 10;
+  std::array<double, 3> min, max;
+  min.fill(std::numeric_limits<double>::infinity());
+  max.fill(-std::numeric_limits<double>::infinity());
+  for (unsigned i = 0; i < data_size_; ++i) {
+    const ThreeVector r = data_[i].position().threevec();
+    for (int k = 0; k < 3; k++) {
+      min[k] = std::min(min[k], r[k]);
+      max[k] = std::max(max[k], r[k]);
+    }
+  }
+  std::array<double, 3> scale;
+  for (int k = 0; k < 3; k++) {
+    scale[k] = max[k] > min[k] ? n_intervals / (max[k] - min[k]) : 0.;
+  }
+  std::vector<std::pair<std::uint32_t, unsigned>> keys(data_size_);
+  for (unsigned i = 0; i < data_size_; ++i) {
+    const ThreeVector r = data_[i].position().threevec();
+    std::uint32_t key = 0;
+    for (int k = 0; k < 3; k++) {
+      const auto interval = std::min(
+          static_cast<std::uint32_t>((r[k] - min[k]) * scale[k]),
+          std::uint32_t{n_intervals - 1});
+      key |= spread_bits(interval) << k;
+    }
+    keys[i] = {key, i};
+  }
+  // Pairs with equal keys are ordered by their old index
+  std::sort(keys.begin(), keys.end());
+  const std::vector<ParticleData> old(&data_[0], &data_[data_size_]);
+  for (unsigned i = 0; i < data_size_; ++i) {
+    data_[i] = old[keys[i].second];
+    data_[i].index_ = i;
+    set_slot(data_[i].id_, i);
+  }
 }
 
 std::ostream &operator<<(std::ostream &out, const Particles &particles) {
@@ -12,9 +12,15 @@
 #include <assert.h>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "smash/clebschgordan_lookup.h"
 #include "smash/constants.h"
 #include "smash/decaymodes.h"
 #include "smash/distributions.h"
@@ -25,6 +31,7 @@
 #include "smash/isoparticletype.h"
 #include "smash/logging.h"
 #include "smash/potential_globals.h"
+#include "smash/resonancemasstable.h"
 #include "smash/stringfunctions.h"
 
 namespace smash {
@@ -46,6 +53,71 @@ ParticleTypePtrList anti_deltas_list;
 ParticleTypePtrList baryon_resonances_list;
 /// Global pointer to the Particle Type list of light nuclei
 ParticleTypePtrList light_nuclei_list;
+
+/// An entry of the hash table of the PDG codes of all types
+struct PdgCodeSlot {
+  /// The PDG code of the type
+  PdgCode code;
+  /// The index of the type in the type list, 0xffff if the slot is empty
+  std::uint16_t index = 0xffff;
+};
+/**
+ * Hash table with open addressing of the PDG codes of all types, built once
+ * with the type list. It has at least four times as many slots as there are
+ * types, such that a lookup rarely probes more than one slot.
+ */
+std::vector<PdgCodeSlot> pdgcode_table;
+/// Number of bits of the hash, i.e. the binary logarithm of the table size
+unsigned pdgcode_table_bits = 0;
+
+/**
+ * The possible resonances of all unordered pairs of types, see
+ * create_resonance_table. The resonances of the pair of the types with
+ * indices \f$j \le i\f$ are stored from offsets[i * (i + 1) / 2 + j] to the
+ * next offset.
+ */
+struct ResonanceTable {
+  /// Number of types, when the table was created
+  std::size_t n_types = 0;
+  /// Offsets of the resonances of the pairs, followed by the total number
+  std::vector<std::uint32_t> offsets;
+  /// The resonances of all pairs, one pair after the other
+  ParticleTypePtrList resonances;
+};
+/// The table of the possible resonances of all pairs of types
+ResonanceTable resonance_table;
+
+/**
+ * \return The first slot at which the given PDG code is looked for in the
+ * hash table.
+ *
+ * \param[in] pdgcode The PDG code to be looked up.
+ */
+std::size_t pdgcode_hash(PdgCode pdgcode) {
+  // Fibonacci hashing spreads the structured codes over the table
+  return (pdgcode.dump() * 0x9E3779B9u) >> (32 - pdgcode_table_bits);
+}
+
+/**
+ * Fill the hash table of the PDG codes with all types of the given list.
+ *
+ * \param[in] types The sorted list of all types without duplicates.
+ */
+void build_pdgcode_table(const ParticleTypeList &types) {
+  pdgcode_table_bits = 1;
+  while ((std::size_t{1} << pdgcode_table_bits) < 4 * types.size()) {
+    pdgcode_table_bits++;
+  }
+  pdgcode_table.assign(std::size_t{1} << pdgcode_table_bits, PdgCodeSlot{});
+  const std::size_t mask = pdgcode_table.size() - 1;
+  for (std::size_t i = 0; i < types.size(); i++) {
+    std::size_t slot = pdgcode_hash(types[i].pdgcode());
+    while (pdgcode_table[slot].index != 0xffff) {
+      slot = (slot + 1) & mask;
+    }
+    pdgcode_table[slot] = {types[i].pdgcode(), static_cast<std::uint16_t>(i)};
+  }
+}
 }  // unnamed namespace
 
 const ParticleTypeList &ParticleType::list_all() {
@@ -87,13 +159,18 @@ ParticleTypePtrList &ParticleType::list_light_nuclei() {
 }
 
 const ParticleTypePtr ParticleType::try_find(PdgCode pdgcode) {
-  const auto found = std::lower_bound(
-      all_particle_types->begin(), all_particle_types->end(), pdgcode,
-      [](const ParticleType &l, const PdgCode &r) { return l.pdgcode() < r; });
-  if (found == all_particle_types->end() || found->pdgcode() != pdgcode) {
-    return {};  // The default constructor creates an invalid pointer.
+  assert(!pdgcode_table.empty());
+  const std::size_t mask = pdgcode_table.size() - 1;
+  // The load factor of the table guarantees an empty slot to end the search
+  for (std::size_t slot = pdgcode_hash(pdgcode);; slot = (slot + 1) & mask) {
+    const PdgCodeSlot &entry = pdgcode_table[slot];
+    if (entry.index == 0xffff) {
+      return {};  // The default constructor creates an invalid pointer.
+    }
+    if (entry.code == pdgcode) {
+      return &(*all_particle_types)[entry.index];
+    }
   }
-  return &*found;
 }
 
 const ParticleType &ParticleType::find(PdgCode pdgcode) {
@@ -198,9 +275,7 @@ static std::string chargestr(int charge) {
 }
 
 void ParticleType::create_type_list(const std::string &input) {  // {{{
-  static ParticleTypeList type_list;
-  type_list.clear();  // in case LoadFailure was thrown and caught and we should
-                      // try again
+  ParticleTypeList type_list;
   for (const Line &line : line_parser(input)) {
     std::istringstream lineinput(line.text);
     std::string name;
@@ -297,6 +372,15 @@ void ParticleType::create_type_list(const std::string &input) {  // {{{
       }
     }
   }
+  create_type_list(std::move(type_list));
+} /*}}}*/
+
+void ParticleType::create_type_list(ParticleTypeList types) {
+  // The resonances are tabulated again with the decay modes of the new types
+  resonance_table = ResonanceTable();
+  static ParticleTypeList type_list;
+  type_list = std::move(types);  // in case LoadFailure was thrown and caught
+                                 // and we should try again
   type_list.shrink_to_fit();
 
   /* Sort the type list by PDG code. */
@@ -318,15 +402,20 @@ void ParticleType::create_type_list(const std::string &input) {  // {{{
   all_particle_types = &type_list;  // note that type_list is a function-local
                                     // static and thus will live on until after
                                     // main().
+  build_pdgcode_table(type_list);
 
   // create all isospin multiplets
   for (const auto &t : type_list) {
     IsoParticleType::create_multiplet(t);
   }
   // link the multiplets to the types
+  int max_isospin = 0;
   for (auto &t : type_list) {
     t.iso_multiplet_ = IsoParticleType::find(t);
+    max_isospin = std::max(max_isospin, t.isospin());
   }
+  // the isospins are known now, so their coefficients can be tabulated
+  ClebschGordan::create_table(max_isospin);
 
   // Create nucleons/anti-nucleons list
   if (IsoParticleType::exists("N")) {
@@ -360,7 +449,7 @@ void ParticleType::create_type_list(const std::string &input) {  // {{{
       light_nuclei_list.push_back(&type);
     }
   }
-} /*}}}*/
+}
 
 double ParticleType::min_mass_kinematic() const {
   if (unlikely(min_mass_kinematic_ < 0.)) {
@@ -443,9 +532,8 @@ double ParticleType::total_width(const double m) const {
     return w;
   }
   /* Loop over decay modes and sum up all partial widths. */
-  const auto &modes = decay_modes().decay_mode_list();
-  for (unsigned int i = 0; i < modes.size(); i++) {
-    w = w + partial_width(m, modes[i].get());
+  for (const DecayChannel &channel : decay_modes().channels()) {
+    w = w + channel.width(mass(), m);
   }
   if (w < width_cutoff) {
     return 0.;
@@ -469,17 +557,35 @@ void ParticleType::check_consistency() {
   }
 }
 
-bool ParticleType::wanted_decaymode(const DecayType &t,
-                                    WhichDecaymodes wh) const {
+void ParticleType::normalize_spectral_functions() {
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    ptype.norm_factor_ = -1.;
+  }
+  /* The widths of a resonance may depend on the spectral functions of its
+   * daughters, whose normalization is then computed on the fly. */
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    if (!ptype.is_stable() && ptype.norm_factor_ < 0.) {
+      ptype.norm_factor_ = ptype.compute_norm_factor();
+    }
+  }
+}
+
+/**
+ * \return Whether a decay mode is wanted, see ParticleType::wanted_decaymode.
+ *
+ * \param[in] is_dilepton Whether the decay mode is a dilepton decay.
+ * \param[in] wh enum that decides which decay modes are wanted.
+ */
+static bool is_wanted(bool is_dilepton, WhichDecaymodes wh) {
   switch (wh) {
     case WhichDecaymodes::All: {
       return true;
     }
     case WhichDecaymodes::Hadronic: {
-      return !t.is_dilepton_decay();
+      return !is_dilepton;
     }
     case WhichDecaymodes::Dileptons: {
-      return t.is_dilepton_decay();
+      return is_dilepton;
     }
     default:
       throw std::runtime_error(
@@ -487,10 +593,16 @@ bool ParticleType::wanted_decaymode(const DecayType &t,
   }
 }
 
-DecayBranchList ParticleType::get_partial_widths(const FourVector p,
-                                                 const ThreeVector x,
-                                                 WhichDecaymodes wh) const {
-  const auto &decay_mode_list = decay_modes().decay_mode_list();
+bool ParticleType::wanted_decaymode(const DecayType &t,
+                                    WhichDecaymodes wh) const {
+  return is_wanted(t.is_dilepton_decay(), wh);
+}
+
+template <typename F>
+void ParticleType::for_each_partial_width(const FourVector &p,
+                                          const ThreeVector &x,
+                                          WhichDecaymodes wh, F &&f) const {
+  const std::vector<DecayChannel> &channels = decay_modes().channels();
   /* Determine whether the decay is affected by the potentials. If it's
    * affected, read the values of the potentials at the position of the
    * particle */
@@ -502,36 +614,81 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
   if (UI3_lat_pointer != nullptr) {
     UI3_lat_pointer->value_at(x, UI3);
   }
+  const double m = p.abs();
   /* Loop over decay modes and calculate all partial widths. */
-  DecayBranchList partial;
-  partial.reserve(decay_mode_list.size());
-  for (unsigned int i = 0; i < decay_mode_list.size(); i++) {
+  for (std::size_t i = 0; i < channels.size(); i++) {
+    const DecayChannel &channel = channels[i];
     /* Calculate the sqare root s of the final state particles. */
-    const auto FinalTypes = decay_mode_list[i]->type().particle_types();
-    double scale_B = 0.0;
-    double scale_I3 = 0.0;
+    double sqrt_s = m;
     if (pot_pointer != nullptr) {
-      scale_B += pot_pointer->force_scale(*this).first;
-      scale_I3 += pot_pointer->force_scale(*this).second * isospin3_rel();
-      for (const auto &finaltype : FinalTypes) {
+      double scale_B = pot_pointer->force_scale(*this).first;
+      double scale_I3 = pot_pointer->force_scale(*this).second * isospin3_rel();
+      for (const auto &finaltype : channel.type->particle_types()) {
         scale_B -= pot_pointer->force_scale(*finaltype).first;
         scale_I3 -= pot_pointer->force_scale(*finaltype).second *
                     finaltype->isospin3_rel();
       }
+      sqrt_s = (p + UB * scale_B + UI3 * scale_I3).abs();
     }
-    double sqrt_s = (p + UB * scale_B + UI3 * scale_I3).abs();
-
-    const double w = partial_width(sqrt_s, decay_mode_list[i].get());
-    if (w > 0.) {
-      if (wanted_decaymode(decay_mode_list[i]->type(), wh)) {
-        partial.push_back(
-            std::make_unique<DecayBranch>(decay_mode_list[i]->type(), w));
-      }
+    const double w = channel.width(mass(), sqrt_s);
+    if (w > 0. && is_wanted(channel.is_dilepton, wh)) {
+      f(i, *channel.type, w);
     }
   }
+}
+
+DecayBranchList ParticleType::get_partial_widths(const FourVector p,
+                                                 const ThreeVector x,
+                                                 WhichDecaymodes wh) const {
+  DecayBranchList partial;
+  partial.reserve(decay_modes().decay_mode_list().size());
+  for_each_partial_width(
+      p, x, wh, [&](std::size_t, const DecayType &type, double w) {
+        partial.push_back(std::make_unique<DecayBranch>(type, w));
+      });
   return partial;
 }
 
+DecayBranchList ParticleType::get_partial_widths(const FourVector p,
+                                                 const ThreeVector x,
+                                                 WhichDecaymodes wh,
+                                                 size_t &n_open_modes) const {
+  DecayBranchList partial;
+  n_open_modes = 0;
+  for_each_partial_width(p, x, WhichDecaymodes::All,
+                         [&](std::size_t, const DecayType &type, double w) {
+                           n_open_modes++;
+                           if (wanted_decaymode(type, wh)) {
+                             partial.push_back(
+                                 std::make_unique<DecayBranch>(type, w));
+                           }
+                         });
+  return partial;
+}
+
+double ParticleType::get_partial_widths(const FourVector &p,
+                                        const ThreeVector &x,
+                                        WhichDecaymodes wh,
+                                        std::vector<double> &widths) const {
+  widths.assign(decay_modes().channels().size(), 0.);
+  double width = 0.;
+  for_each_partial_width(
+      p, x, wh, [&](std::size_t i, const DecayType &, double w) {
+        widths[i] = w;
+        width += w;
+      });
+  return width;
+}
+
+double ParticleType::get_total_width(const FourVector p, const ThreeVector x,
+                                     WhichDecaymodes wh) const {
+  // Summed in the same order as the weights of get_partial_widths
+  double width = 0.;
+  for_each_partial_width(
+      p, x, wh, [&](std::size_t, const DecayType &, double w) { width += w; });
+  return width;
+}
+
 double ParticleType::get_partial_width(const double m,
                                        const ParticleTypePtrList dlist) const {
   /* Get all decay modes. */
@@ -568,25 +725,29 @@ double ParticleType::get_partial_in_width(const double m,
 }
 
 double ParticleType::spectral_function(double m) const {
-  if (norm_factor_ < 0.) {
-    /* Initialize the normalization factor
-     * by integrating over the unnormalized spectral function. */
-    static /*thread_local (see #3075)*/ Integrator integrate;
-    const double width = width_at_pole();
-    const double m_pole = mass();
-    // We transform the integral using m = m_min + width_pole * tan(x), to
-    // make it definite and to avoid numerical issues.
-    const double x_min = std::atan((min_mass_kinematic() - m_pole) / width);
-    norm_factor_ = 1. / integrate(x_min, M_PI / 2., [&](double x) {
-                     const double tanx = std::tan(x);
-                     const double m_x = m_pole + width * tanx;
-                     const double jacobian = width * (1.0 + tanx * tanx);
-                     return spectral_function_no_norm(m_x) * jacobian;
-                   });
+  if (unlikely(norm_factor_ < 0.)) {
+    norm_factor_ = compute_norm_factor();
   }
   return norm_factor_ * spectral_function_no_norm(m);
 }
 
+double ParticleType::compute_norm_factor() const {
+  /* Initialize the normalization factor
+   * by integrating over the unnormalized spectral function. */
+  static thread_local Integrator integrate;
+  const double width = width_at_pole();
+  const double m_pole = mass();
+  // We transform the integral using m = m_min + width_pole * tan(x), to
+  // make it definite and to avoid numerical issues.
+  const double x_min = std::atan((min_mass_kinematic() - m_pole) / width);
+  return 1. / integrate(x_min, M_PI / 2., [&](double x) {
+           const double tanx = std::tan(x);
+           const double m_x = m_pole + width * tanx;
+           const double jacobian = width * (1.0 + tanx * tanx);
+           return spectral_function_no_norm(m_x) * jacobian;
+         });
+}
+
 double ParticleType::spectral_function_no_norm(double m) const {
   /* The spectral function is a relativistic Breit-Wigner function
    * with mass-dependent width. Here: without normalization factor. */
@@ -615,6 +776,13 @@ double ParticleType::spectral_function_simple(double m) const {
 double ParticleType::sample_resonance_mass(const double mass_stable,
                                            const double cms_energy,
                                            int L) const {
+  if (tabulated_mass_sampling_) {
+    const double mass_res = ResonanceMassTable::find(*this, mass_stable, L)
+                                .sample(cms_energy);
+    if (!std::isnan(mass_res)) {
+      return mass_res;
+    }
+  }
   /* largest possible mass: Use 'nextafter' to make sure it is not above the
    * physical limit by numerical error. */
   const double max_mass = std::nextafter(cms_energy - mass_stable, 0.);
@@ -768,63 +936,92 @@ std::ostream &operator<<(std::ostream &out, const ParticleType &type) {
              << ", spin:" << field<2> << pdg.spin() << "/2 ]";
 }
 
-/*
- * This is valid for two particles of the same species because the comparison
- * operator for smart pointers compares the pointed object. In this case, the
- * `std::set<ParticleTypePtr> incoming` will contain one element instead of two.
+/**
+ * Find the resonances which decay into the two given particles.
+ *
+ * \param[in] type_a first incoming particle.
+ * \param[in] type_b second incoming particle.
+ * \param[in] candidates The unstable types with the summed charge, baryon
+ *            number and strangeness of the incoming particles.
+ * \return list of possible resonances.
  */
-ParticleTypePtrList list_possible_resonances(const ParticleTypePtr type_a,
-                                             const ParticleTypePtr type_b) {
-  static std::map<std::set<ParticleTypePtr>, ParticleTypePtrList>
-      map_possible_resonances_of;
-  std::set<ParticleTypePtr> incoming{type_a, type_b};
+static ParticleTypePtrList find_possible_resonances(
+    const ParticleTypePtr type_a, const ParticleTypePtr type_b,
+    const ParticleTypePtrList &candidates) {
   const ParticleTypePtrList incoming_types = {type_a, type_b};
-  // Fill map if set is not yet present
-  if (map_possible_resonances_of.count(incoming) == 0) {
-    logg[LResonances].debug()
-        << "Filling map of compatible resonances for ptypes " << type_a->name()
-        << " " << type_b->name();
-    ParticleTypePtrList resonance_list{};
-    // The tests below are redundant as the decay modes already obey them, but
-    // they are quicker to check and so improve performance.
-    for (const ParticleType &resonance : ParticleType::list_all()) {
-      /* Not a resonance, go to next type of particle */
-      if (resonance.is_stable()) {
-        continue;
-      }
-      // Same resonance as in the beginning, ignore
-      if ((resonance.pdgcode() == type_a->pdgcode()) ||
-          (resonance.pdgcode() == type_b->pdgcode())) {
-        continue;
-      }
-      // Check for charge conservation.
-      if (resonance.charge() != type_a->charge() + type_b->charge()) {
-        continue;
-      }
-      // Check for baryon-number conservation.
-      if (resonance.baryon_number() !=
-          type_a->baryon_number() + type_b->baryon_number()) {
-        continue;
-      }
-      // Check for strangeness conservation.
-      if (resonance.strangeness() !=
-          type_a->strangeness() + type_b->strangeness()) {
-        continue;
+  ParticleTypePtrList resonance_list{};
+  for (const ParticleTypePtr resonance : candidates) {
+    // Same resonance as in the beginning, ignore
+    if ((resonance->pdgcode() == type_a->pdgcode()) ||
+        (resonance->pdgcode() == type_b->pdgcode())) {
+      continue;
+    }
+    const auto &decaymodes = resonance->decay_modes().decay_mode_list();
+    for (const auto &mode : decaymodes) {
+      if (mode->type().has_particles(incoming_types)) {
+        resonance_list.push_back(resonance);
+        break;
       }
-      const auto &decaymodes = resonance.decay_modes().decay_mode_list();
-      for (const auto &mode : decaymodes) {
-        if (mode->type().has_particles(incoming_types)) {
-          resonance_list.push_back(&resonance);
-          break;
+    }
+  }
+  // Here `resonance_list` can be empty, corresponding to the case where there
+  // are no possible resonances.
+  return resonance_list;
+}
+
+void create_resonance_table() {
+  /* Only resonances with the summed quantum numbers of a pair can decay into
+   * it, hence the candidates are grouped by charge, baryon number and
+   * strangeness, keeping the order of the types. */
+  const ParticleTypeList &types = ParticleType::list_all();
+  std::map<std::array<int, 3>, ParticleTypePtrList> candidates;
+  for (const ParticleType &resonance : types) {
+    if (!resonance.is_stable()) {
+      candidates[{resonance.charge(), resonance.baryon_number(),
+                  resonance.strangeness()}]
+          .push_back(&resonance);
+    }
+  }
+  ResonanceTable table;
+  table.n_types = types.size();
+  table.offsets.reserve(table.n_types * (table.n_types + 1) / 2 + 1);
+  table.offsets.push_back(0);
+  for (std::size_t i = 0; i < table.n_types; i++) {
+    for (std::size_t j = 0; j <= i; j++) {
+      const ParticleTypePtr type_a = &types[j], type_b = &types[i];
+      const auto found = candidates.find(
+          {type_a->charge() + type_b->charge(),
+           type_a->baryon_number() + type_b->baryon_number(),
+           type_a->strangeness() + type_b->strangeness()});
+      if (found != candidates.end()) {
+        for (const ParticleTypePtr resonance :
+             find_possible_resonances(type_a, type_b, found->second)) {
+          table.resonances.push_back(resonance);
         }
       }
+      table.offsets.push_back(
+          static_cast<std::uint32_t>(table.resonances.size()));
     }
-    // Here `resonance_list` can be empty, corresponding to the case where there
-    // are no possible resonances.
-    map_possible_resonances_of[incoming] = resonance_list;
   }
+  table.resonances.shrink_to_fit();
+  resonance_table = std::move(table);
+}
 
-  return map_possible_resonances_of[incoming];
+ParticleTypePtrSpan list_possible_resonances(const ParticleTypePtr type_a,
+                                             const ParticleTypePtr type_b) {
+  const ParticleTypeList &types = ParticleType::list_all();
+  if (resonance_table.n_types != types.size()) {
+    return {};
+  }
+  std::size_t i_a = std::addressof(*type_a) - std::addressof(types[0]),
+              i_b = std::addressof(*type_b) - std::addressof(types[0]);
+  if (i_a > i_b) {
+    std::swap(i_a, i_b);
+  }
+  const std::size_t pair = i_b * (i_b + 1) / 2 + i_a;
+  const std::uint32_t first = resonance_table.offsets[pair];
+  return {resonance_table.resonances.data() + first,
+          resonance_table.offsets[pair + 1] - first};
 }
 
 }  // namespace smash
@@ -9,6 +9,12 @@
 
 #include "smash/pauliblocking.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
 #include "smash/constants.h"
 #include "smash/input_keys.h"
 #include "smash/logging.h"
@@ -16,6 +22,31 @@
 namespace smash {
 static constexpr int LPauliBlocking = LogArea::PauliBlocking::id;
 
+/// Number of nodes of the occupancy lattice in every direction
+static constexpr std::int64_t lattice_nodes_per_direction = 1024;
+
+/**
+ * Find a corner of the cell of the occupancy lattice containing a point.
+ *
+ * \param[in] corner Bit d tells whether the upper node in direction d is
+ *            taken.
+ * \param[in] lower The lower node in every direction.
+ * \param[in] upper_weight The weight of the upper node in every direction.
+ * \return The key of the node and its weight for the point.
+ */
+static std::pair<std::uint64_t, double> lattice_corner(
+    unsigned corner, const std::array<std::int64_t, 6> &lower,
+    const std::array<double, 6> &upper_weight) {
+  std::uint64_t key = 0;
+  double w = 1.0;
+  for (int d = 0; d < 6; d++) {
+    const bool upper = (corner >> d) & 1u;
+    key = key * lattice_nodes_per_direction + lower[d] + upper;
+    w *= upper ? upper_weight[d] : 1.0 - upper_weight[d];
+  }
+  return {key, w};
+}
+
 PauliBlocker::PauliBlocker(Configuration conf,
                            const ExperimentParameters &param)
     : sig_(param.gaussian_sigma),
@@ -23,7 +54,9 @@ PauliBlocker::PauliBlocker(Configuration conf,
       rr_(conf.take(InputKeys::collTerm_pauliBlocking_spatialAveragingRadius)),
       rp_(conf.take(InputKeys::collTerm_pauliBlocking_momentumAveragingRadius)),
       ntest_(param.testparticles),
-      n_ensembles_(param.n_ensembles) {
+      n_ensembles_(param.n_ensembles),
+      occupancy_lattice_(
+          conf.take(InputKeys::collTerm_pauliBlocking_occupancyLattice)) {
   if (ntest_ * n_ensembles_ < 20) {
     logg[LPauliBlocking].warn(
         "Phase-space density calculation in Pauli blocking will not work "
@@ -39,6 +72,24 @@ PauliBlocker::PauliBlocker(Configuration conf,
   }
 
   init_weights_analytical();
+
+  /* Depositing onto the nodes and interpolating smears a particle with a
+   * variance of dx^2/3 in every direction. The nodes are spaced such that
+   * this matches the variance of the averaging sphere, which is smeared with
+   * the Gaussian in coordinate space. */
+  lattice_dr_ = std::sqrt(3. * (rr_ * rr_ / 5. + sig_ * sig_));
+  lattice_dp_ = std::sqrt(3. / 5.) * rp_;
+  if (occupancy_lattice_ && !(lattice_dr_ > 0. && lattice_dp_ > 0.)) {
+    throw std::invalid_argument(
+        "The occupancy lattice for Pauli blocking needs a positive "
+        "Momentum_Averaging_Radius.");
+  }
+  if (occupancy_lattice_) {
+    logg[LPauliBlocking].info(
+        "Interpolating the phase-space densities from a lattice with node "
+        "distances of ",
+        lattice_dr_, " fm and ", lattice_dp_, " GeV.");
+  }
 }
 
 PauliBlocker::~PauliBlocker() {}
@@ -49,46 +100,245 @@ double PauliBlocker::phasespace_dens(const ThreeVector &r, const ThreeVector &p,
                                      const ParticleList &disregard) const {
   double f = 0.0;
 
-  /* TODO(oliiny): looping over all particles is inefficient,
-   * I need only particles within rp_ radius in momentum and
-   * within rr_+rc_ in coordinate space. Some search algorithm might help. */
-  for (const Particles &particles : ensembles) {
-    for (const ParticleData &part : particles) {
-      // Only consider identical particles
-      if (part.pdgcode() != pdg) {
-        continue;
+  if (occupancy_lattice_ && indexed_ensembles_ == &ensembles) {
+    return lattice_phasespace_dens(r, p, pdg, disregard);
+  }
+  if (indexed_ensembles_ != &ensembles) {
+    for (const Particles &particles : ensembles) {
+      for (const ParticleData &part : particles) {
+        f += weight(part, r, p, pdg, disregard);
       }
-      // Only consider momenta in sphere of radius rp_ with center at p
-      const double pdist_sqr = (part.momentum().threevec() - p).sqr();
-      if (pdist_sqr > rp_ * rp_) {
-        continue;
+    }
+    return f / ntest_ / n_ensembles_;
+  }
+
+  /* Visit the cells which may contain a contributing particle. The particles
+   * are summed up in the order in which they are stored, such that the result
+   * is identical to the loop over all particles. */
+  const CellIndex first = cell_of(r - ThreeVector(1., 1., 1.) *
+                                          index_cell_size_),
+                  last = cell_of(r + ThreeVector(1., 1., 1.) *
+                                         index_cell_size_);
+  std::vector<const ParticleData *> candidates;
+  for (std::size_t i_ens = 0; i_ens < ensembles.size(); i_ens++) {
+    const Particles &particles = ensembles[i_ens];
+    const EnsembleIndex &index = index_[i_ens];
+    const auto species = index.cells.find(pdg);
+    if (species == index.cells.end()) {
+      continue;
+    }
+    candidates.clear();
+    CellIndex cell;
+    for (cell[0] = first[0]; cell[0] <= last[0]; cell[0]++) {
+      for (cell[1] = first[1]; cell[1] <= last[1]; cell[1]++) {
+        for (cell[2] = first[2]; cell[2] <= last[2]; cell[2]++) {
+          const auto found = species->second.find(cell);
+          if (found == species->second.end()) {
+            continue;
+          }
+          for (const std::size_t i_entry : found->second) {
+            const ParticleData &entry = index.entries[i_entry];
+            // Skip copies of removed or since updated particles
+            if (index.latest_entry.at(entry.id()) == i_entry &&
+                particles.is_valid(entry)) {
+              candidates.push_back(&particles.lookup(entry));
+            }
+          }
+        }
       }
-      const double rdist_sqr = (part.position().threevec() - r).sqr();
-      // Only consider coordinates in sphere of radius rr_+rc_ with center at r
-      if (rdist_sqr >= (rr_ + rc_) * (rr_ + rc_)) {
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              std::less<const ParticleData *>());
+    for (const ParticleData *part : candidates) {
+      f += weight(*part, r, p, pdg, disregard);
+    }
+  }  // loop over ensembles
+  return f / ntest_ / n_ensembles_;
+}
+
+double PauliBlocker::weight(const ParticleData &part, const ThreeVector &r,
+                            const ThreeVector &p, const PdgCode pdg,
+                            const ParticleList &disregard) const {
+  // Only consider identical particles
+  if (part.pdgcode() != pdg) {
+    return 0.0;
+  }
+  // Only consider momenta in sphere of radius rp_ with center at p
+  const double pdist_sqr = (part.momentum().threevec() - p).sqr();
+  if (pdist_sqr > rp_ * rp_) {
+    return 0.0;
+  }
+  const double rdist_sqr = (part.position().threevec() - r).sqr();
+  // Only consider coordinates in sphere of radius rr_+rc_ with center at r
+  if (rdist_sqr >= (rr_ + rc_) * (rr_ + rc_)) {
+    return 0.0;
+  }
+  // Do not count particles that should be disregarded.
+  for (const auto &disregard_part : disregard) {
+    if (part.id() == disregard_part.id()) {
+      return 0.0;
+    }
+  }
+  // 1st order interpolation using tabulated values
+  const double i_real = std::sqrt(rdist_sqr) / (rr_ + rc_) * weights_.size();
+  const size_t i = numeric_cast<size_t>(std::floor(i_real));
+  const double rest = i_real - i;
+  if (likely(i + 1 < weights_.size())) {
+    return weights_[i] * rest + weights_[i + 1] * (1. - rest);
+  }
+  return 0.0;
+}
+
+double PauliBlocker::lattice_phasespace_dens(
+    const ThreeVector &r, const ThreeVector &p, const PdgCode pdg,
+    const ParticleList &disregard) const {
+  const auto species = occupancy_.find(pdg);
+  std::array<std::int64_t, 6> lower;
+  std::array<double, 6> upper_weight;
+  if (species == occupancy_.end() ||
+      !lattice_nodes(r, p, lower, upper_weight)) {
+    return 0.0;
+  }
+  double occupancy = 0.0;
+  for (unsigned corner = 0; corner < 64; corner++) {
+    const auto [key, w] = lattice_corner(corner, lower, upper_weight);
+    const auto node = species->second.find(key);
+    if (node != species->second.end()) {
+      occupancy += w * node->second;
+    }
+  }
+  /* Remove the contribution of the disregarded particles, which are recognised
+   * by their momentum, since they have not changed it since they were
+   * deposited. Both the deposit and the interpolation factorize in the
+   * directions. */
+  for (const ParticleData &part : disregard) {
+    if (part.pdgcode() != pdg) {
+      continue;
+    }
+    const auto [first, last] = deposits_.equal_range(part.id());
+    for (auto deposit = first; deposit != last; ++deposit) {
+      if (deposit->second.pdg != pdg ||
+          !(deposit->second.p == part.momentum().threevec())) {
         continue;
       }
-      // Do not count particles that should be disregarded.
-      bool to_disregard = false;
-      for (const auto &disregard_part : disregard) {
-        if (part.id() == disregard_part.id()) {
-          to_disregard = true;
+      std::array<std::int64_t, 6> deposit_lower;
+      std::array<double, 6> deposit_upper_weight;
+      lattice_nodes(deposit->second.r, deposit->second.p, deposit_lower,
+                    deposit_upper_weight);
+      double overlap = 1.0;
+      for (int d = 0; d < 6; d++) {
+        const double weights[2] = {1.0 - upper_weight[d], upper_weight[d]},
+                     deposit_weights[2] = {1.0 - deposit_upper_weight[d],
+                                           deposit_upper_weight[d]};
+        double sum = 0.0;
+        for (int i = 0; i < 2; i++) {
+          for (int j = 0; j < 2; j++) {
+            if (lower[d] + i == deposit_lower[d] + j) {
+              sum += weights[i] * deposit_weights[j];
+            }
+          }
         }
+        overlap *= sum;
       }
-      if (to_disregard) {
-        continue;
-      }
-      // 1st order interpolation using tabulated values
-      const double i_real =
-          std::sqrt(rdist_sqr) / (rr_ + rc_) * weights_.size();
-      const size_t i = numeric_cast<size_t>(std::floor(i_real));
-      const double rest = i_real - i;
-      if (likely(i + 1 < weights_.size())) {
-        f += weights_[i] * rest + weights_[i + 1] * (1. - rest);
+      occupancy -= overlap;
+      break;
+    }
+  }
+  // Volume of the phase space of one node; Factor 2 stands for spin.
+  const double node_volume =
+      2 * std::pow(lattice_dr_ * lattice_dp_ / (2 * M_PI * hbarc), 3);
+  return std::max(occupancy, 0.0) / node_volume / ntest_ / n_ensembles_;
+}
+
+bool PauliBlocker::lattice_nodes(const ThreeVector &r, const ThreeVector &p,
+                                 std::array<std::int64_t, 6> &lower,
+                                 std::array<double, 6> &upper_weight) const {
+  // The lattice is centered at the origin of both spaces
+  constexpr double half_range = lattice_nodes_per_direction / 2;
+  for (int d = 0; d < 6; d++) {
+    const double x = d < 3 ? r[d] / lattice_dr_ : p[d - 3] / lattice_dp_;
+    const double x_lower = std::floor(x);
+    if (!(x_lower >= -half_range && x_lower + 1. < half_range)) {
+      return false;
+    }
+    lower[d] = static_cast<std::int64_t>(x_lower + half_range);
+    upper_weight[d] = x - x_lower;
+  }
+  return true;
+}
+
+void PauliBlocker::update_index(const std::vector<Particles> &ensembles,
+                                double max_displacement) {
+  if (occupancy_lattice_) {
+    indexed_ensembles_ = &ensembles;
+    occupancy_.clear();
+    deposits_.clear();
+    std::array<std::int64_t, 6> lower;
+    std::array<double, 6> upper_weight;
+    for (const Particles &particles : ensembles) {
+      for (const ParticleData &part : particles) {
+        const ThreeVector r = part.position().threevec(),
+                          p = part.momentum().threevec();
+        // Only the phase-space densities of baryons are needed
+        if (!part.is_baryon() || !lattice_nodes(r, p, lower, upper_weight)) {
+          continue;
+        }
+        auto &species = occupancy_[part.pdgcode()];
+        for (unsigned corner = 0; corner < 64; corner++) {
+          const auto [key, w] = lattice_corner(corner, lower, upper_weight);
+          species[key] += w;
+        }
+        deposits_.emplace(part.id(), Deposit{part.pdgcode(), r, p});
       }
-    }  // loop over particles in one ensemble
-  }    // loop over ensembles
-  return f / ntest_ / n_ensembles_;
+    }
+    return;
+  }
+  /* A particle contributing at a position is at most rr_ + rc_ away from it
+   * now, but it may have been farther away when it was added to the index.
+   * With cells of this size, only the adjacent cells have to be visited. */
+  index_cell_size_ = rr_ + rc_ + std::max(max_displacement, 0.0);
+  indexed_ensembles_ = &ensembles;
+  index_.clear();
+  index_.resize(ensembles.size());
+  for (std::size_t i_ens = 0; i_ens < ensembles.size(); i_ens++) {
+    index_[i_ens].entries.reserve(ensembles[i_ens].size());
+    for (const ParticleData &part : ensembles[i_ens]) {
+      add_entry(part, index_[i_ens]);
+    }
+  }
+}
+
+void PauliBlocker::add_to_index(const ParticleList &particles,
+                                int i_ensemble) {
+  if (!indexed_ensembles_ || occupancy_lattice_) {
+    return;
+  }
+  for (const ParticleData &part : particles) {
+    add_entry(part, index_.at(i_ensemble));
+  }
+}
+
+void PauliBlocker::clear_index() {
+  indexed_ensembles_ = nullptr;
+  index_.clear();
+  occupancy_.clear();
+  deposits_.clear();
+}
+
+PauliBlocker::CellIndex PauliBlocker::cell_of(const ThreeVector &r) const {
+  CellIndex cell;
+  for (int i = 0; i < 3; i++) {
+    cell[i] = static_cast<std::int64_t>(std::floor(r[i] / index_cell_size_));
+  }
+  return cell;
+}
+
+void PauliBlocker::add_entry(const ParticleData &part, EnsembleIndex &index) {
+  const std::size_t i_entry = index.entries.size();
+  index.entries.push_back(part);
+  index.latest_entry[part.id()] = i_entry;
+  index.cells[part.pdgcode()][cell_of(part.position().threevec())].push_back(
+      i_entry);
 }
 
 void PauliBlocker::init_weights_analytical() {
@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/performanceoutput.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+namespace smash {
+
+/*!\Userguide
+ * \page doxypage_output_performance
+ *
+ * The performance output (performance.jsonl) contains one line per event,
+ * which is a JSON object describing the computational work done in the event,
+ * summed over all ensembles. It is written at the end of every event, such
+ * that the health of many production jobs can be watched while they run. Its
+ * members are
+ * \li `event`: The number of the event.
+ * \li `wall_time`: The wall time of the event until its end output in
+ *     seconds.
+ * \li `performed`: The numbers of performed actions, keyed by the process
+ *     type, see \ref doxypage_output_process_types. Only process types with
+ *     performed actions are listed.
+ * \li `discarded`: The number of found actions, which were discarded, since
+ *     they had been invalidated by other actions before.
+ * \li `pauli_blocked`: The number of Pauli-blocked actions.
+ * \li `strings`: The number `count` of performed string fragmentations and
+ *     the time `time` spent in performing them in seconds.
+ * \li `mean_cell_occupancy`: The mean number of particles per cell of the
+ *     grids, on which the actions are searched, averaged over the time steps.
+ * \li `max_queued_actions`: The maximal number of entries of the action queue
+ *     of one ensemble, including invalidated actions not dropped yet.
+ * \li `phases`: The time `time` in seconds and the number of measurements
+ *     `calls` of the profiled phases of the event, as in the time profile of
+ *     \ref key_gen_profiling_ "Profiling". Nested phases are part of the time
+ *     of the outer phases as well. With \ref key_gen_hardware_counters_
+ *     "Hardware_Counters", the counts of the available events `cycles`,
+ *     `instructions`, `llc_misses`, `dtlb_misses` and `branch_misses` of
+ *     every phase follow its number of calls.
+ * \li `memory`: The memory in bytes used by the `particles` of all
+ *     ensembles, the action queues (`actions`), the `grids` and neighbor
+ *     indices, the `lattices` and the data kept by the `outputs` until they
+ *     are written, e.g. the copies buffered for concurrent events or for
+ *     asynchronous writing. For each, the `current` value of the latest
+ *     measurement and the `peak` value of the event are given. The memory is
+ *     measured once per time step, after the actions have been found. The
+ *     memory of the actions is estimated from their incoming particles.
+ *
+ * For example
+ * \code
+ * {"event": 0, "wall_time": 1.52, "performed": {"1": 2048, "2": 512, "5": 498},
+ * "discarded": 321, "pauli_blocked": 0, "strings": {"count": 0, "time": 0},
+ * "mean_cell_occupancy": 3.7, "max_queued_actions": 1840, "phases": {"scatter
+ * finder": {"time": 0.81, "calls": 16000}, "grid": {"time": 0.05, "calls":
+ * 200}}}
+ * \endcode
+ * where every object is written on a single line.
+ */
+
+PerformanceOutput::PerformanceOutput(const std::filesystem::path &path,
+                                     const std::string &name)
+    : OutputInterface(name), file_{path / "performance.jsonl", "w"} {}
+
+void PerformanceOutput::event_statistics_output(
+    const int event_number, const EventStatistics &statistics) {
+  std::ostringstream line;
+  line << "{\"event\": " << event_number
+       << ", \"wall_time\": " << statistics.wall_time << ", \"performed\": {";
+  for (std::size_t i = 0; i < statistics.performed.size(); i++) {
+    line << (i == 0 ? "" : ", ") << '"'
+         << static_cast<int>(statistics.performed[i].first)
+         << "\": " << statistics.performed[i].second;
+  }
+  line << "}, \"discarded\": " << statistics.discarded
+       << ", \"pauli_blocked\": " << statistics.pauli_blocked
+       << ", \"strings\": {\"count\": " << statistics.strings
+       << ", \"time\": " << statistics.string_time
+       << "}, \"mean_cell_occupancy\": " << statistics.mean_cell_occupancy
+       << ", \"max_queued_actions\": " << statistics.max_queued_actions
+       << ", \"phases\": {";
+  for (std::size_t i = 0; i < statistics.phases.size(); i++) {
+    const Profiler::Total &phase = statistics.phases[i];
+    line << (i == 0 ? "" : ", ") << std::quoted(phase.name)
+         << ": {\"time\": " << phase.seconds << ", \"calls\": " << phase.calls;
+    for (const auto &[event, count] : phase.counts) {
+      line << ", " << std::quoted(event) << ": " << count;
+    }
+    line << '}';
+  }
+  line << '}';
+  if (!statistics.memory.empty()) {
+    line << ", \"memory\": {";
+    for (std::size_t i = 0; i < statistics.memory.size(); i++) {
+      const MemoryUsage &usage = statistics.memory[i];
+      line << (i == 0 ? "" : ", ") << std::quoted(usage.subsystem)
+           << ": {\"current\": " << usage.current
+           << ", \"peak\": " << usage.peak << '}';
+    }
+    line << '}';
+  }
+  line << "}\n";
+  std::fputs(line.str().c_str(), file_.get());
+  std::fflush(file_.get());
+}
+
+}  // namespace smash
@@ -24,7 +24,9 @@ Potentials::Potentials(Configuration conf, const DensityParameters &param)
       use_momentum_dependence_(
           conf.has_section(InputSections::p_momentumDependence)),
       use_potentials_outside_lattice_(
-          conf.take(InputKeys::potentials_use_potentials_outside_lattice)) {
+          conf.take(InputKeys::potentials_use_potentials_outside_lattice)),
+      tabulate_density_functions_(
+          conf.take(InputKeys::potentials_tabulateDensityFunctions)) {
   if (use_skyrme_) {
     skyrme_a_ = conf.take(InputKeys::potentials_skyrme_skyrmeA);
     skyrme_b_ = conf.take(InputKeys::potentials_skyrme_skyrmeB);
@@ -66,10 +68,43 @@ Potentials::Potentials(Configuration conf, const DensityParameters &param)
       powers_.push_back(aux_powers[i]);
     }
   }
+  if (tabulate_density_functions_) {
+    if (use_skyrme_) {
+      skyrme_table_ = PowerSumTable({skyrme_b_}, {skyrme_tau_});
+      skyrme_derivative_table_ =
+          PowerSumTable({skyrme_b_ * skyrme_tau_}, {skyrme_tau_ - 1.});
+    }
+    if (symmetry_is_rhoB_dependent_) {
+      symmetry_S_table_ =
+          PowerSumTable({12.3, 20.0}, {2. / 3., symmetry_gamma_});
+      symmetry_S_derivative_table_ = PowerSumTable(
+          {8.2, 20.0 * symmetry_gamma_}, {-1. / 3., symmetry_gamma_ - 1.});
+    }
+    if (use_vdf_) {
+      std::vector<double> F1_coeffs, F1_powers, F2_powers;
+      for (int i = 0; i < number_of_terms(); i++) {
+        F1_coeffs.push_back(coeffs_[i] * (powers_[i] - 2.0));
+        F1_powers.push_back(powers_[i] - 3.0);
+        F2_powers.push_back(powers_[i] - 2.0);
+      }
+      vdf_F1_table_ = PowerSumTable(std::move(F1_coeffs), std::move(F1_powers));
+      vdf_F2_table_ = PowerSumTable(coeffs_, std::move(F2_powers));
+    }
+  }
 }
 
 Potentials::~Potentials() {}
 
+double Potentials::skyrme_pot(const double baryon_density) const {
+  if (!tabulate_density_functions_) {
+    return skyrme_pot(baryon_density, skyrme_a_, skyrme_b_, skyrme_tau_);
+  }
+  const double tmp = baryon_density / nuclear_density;
+  const int sgn = tmp > 0 ? 1 : -1;
+  return mev_to_gev * sgn *
+         (skyrme_a_ * std::abs(tmp) + skyrme_table_(std::abs(tmp)));
+}
+
 double Potentials::skyrme_pot(const double baryon_density, const double A,
                               const double B, const double tau) {
   const double tmp = baryon_density / nuclear_density;
@@ -82,7 +117,9 @@ double Potentials::skyrme_pot(const double baryon_density, const double A,
 }
 
 double Potentials::symmetry_S(const double baryon_density) const {
-  if (symmetry_is_rhoB_dependent_) {
+  if (symmetry_is_rhoB_dependent_ && tabulate_density_functions_) {
+    return symmetry_S_table_(baryon_density / nuclear_density);
+  } else if (symmetry_is_rhoB_dependent_) {
     return 12.3 * std::pow(baryon_density / nuclear_density, 2. / 3.) +
            20.0 * std::pow(baryon_density / nuclear_density, symmetry_gamma_);
   } else {
@@ -113,16 +150,20 @@ FourVector Potentials::vdf_pot(double rhoB, const FourVector jmuB_net) const {
   // F_2 is a multiplicative factor in front of the baryon current
   // in the VDF potential
   double F_2 = 0.0;
-  for (int i = 0; i < number_of_terms(); i++) {
-    F_2 += coeffs_[i] * std::pow(abs_rhoB, powers_[i] - 2.0) /
-           std::pow(saturation_density_, powers_[i] - 1.0);
+  if (tabulate_density_functions_) {
+    F_2 = vdf_F2_table_(abs_rhoB / saturation_density_) / saturation_density_;
+  } else {
+    for (int i = 0; i < number_of_terms(); i++) {
+      F_2 += coeffs_[i] * std::pow(abs_rhoB, powers_[i] - 2.0) /
+             std::pow(saturation_density_, powers_[i] - 1.0);
+    }
   }
   F_2 = F_2 * sgn;
   // Return in GeV
   return F_2 * jmuB_net;
 }
 
-double Potentials::potential(const ThreeVector &r, const ParticleList &plist,
+double Potentials::potential(const ThreeVector &r, const ParticlesView &plist,
                              const ParticleType &acts_on) const {
   double total_potential = 0.0;
   const bool compute_gradient = false;
@@ -170,11 +211,13 @@ std::pair<ThreeVector, ThreeVector> Potentials::skyrme_force(
   if (use_skyrme_) {
     const int sgn = rhoB > 0 ? 1 : -1;
     const double abs_rhoB = std::abs(rhoB);
-    const double dV_drho = sgn *
-                           (skyrme_a_ + skyrme_b_ * skyrme_tau_ *
-                                            std::pow(abs_rhoB / nuclear_density,
-                                                     skyrme_tau_ - 1)) *
-                           mev_to_gev / nuclear_density;
+    const double power_term =
+        tabulate_density_functions_
+            ? skyrme_derivative_table_(abs_rhoB / nuclear_density)
+            : skyrme_b_ * skyrme_tau_ *
+                  std::pow(abs_rhoB / nuclear_density, skyrme_tau_ - 1);
+    const double dV_drho =
+        sgn * (skyrme_a_ + power_term) * mev_to_gev / nuclear_density;
     E_component -= dV_drho * (grad_j0B + dvecjB_dt);
     B_component += dV_drho * curl_vecjB;
   }
@@ -214,18 +257,23 @@ std::pair<ThreeVector, ThreeVector> Potentials::vdf_force(
     // F_1 and F_2 are multiplicative factors in front of the baryon current
     // in the VDF potential
     double F_1 = 0.0;
-    for (int i = 0; i < number_of_terms(); i++) {
-      F_1 += coeffs_[i] * (powers_[i] - 2.0) *
-             std::pow(abs_rhoB, powers_[i] - 3.0) /
-             std::pow(saturation_density_, powers_[i] - 1.0);
-    }
-    F_1 = F_1 * sgn;
-
     double F_2 = 0.0;
-    for (int i = 0; i < number_of_terms(); i++) {
-      F_2 += coeffs_[i] * std::pow(abs_rhoB, powers_[i] - 2.0) /
-             std::pow(saturation_density_, powers_[i] - 1.0);
+    if (tabulate_density_functions_) {
+      const double y = abs_rhoB / saturation_density_;
+      F_1 = vdf_F1_table_(y) / (saturation_density_ * saturation_density_);
+      F_2 = vdf_F2_table_(y) / saturation_density_;
+    } else {
+      for (int i = 0; i < number_of_terms(); i++) {
+        F_1 += coeffs_[i] * (powers_[i] - 2.0) *
+               std::pow(abs_rhoB, powers_[i] - 3.0) /
+               std::pow(saturation_density_, powers_[i] - 1.0);
+      }
+      for (int i = 0; i < number_of_terms(); i++) {
+        F_2 += coeffs_[i] * std::pow(abs_rhoB, powers_[i] - 2.0) /
+               std::pow(saturation_density_, powers_[i] - 1.0);
+      }
     }
+    F_1 = F_1 * sgn;
     F_2 = F_2 * sgn;
 
     E_component -= (F_1 * (grad_rhoB * j0B + drhoB_dt * vecjB) +
@@ -260,9 +308,12 @@ double Potentials::dVsym_drhoI3(const double rhoB, const double rhoI3) const {
 double Potentials::dVsym_drhoB(const double rhoB, const double rhoI3) const {
   if (symmetry_is_rhoB_dependent_) {
     double rhoB_over_rho0 = rhoB / nuclear_density;
-    double term1 = 8.2 * std::pow(rhoB_over_rho0, -1. / 3.) / nuclear_density +
-                   20. * symmetry_gamma_ *
-                       std::pow(rhoB_over_rho0, symmetry_gamma_) / rhoB;
+    double term1 =
+        tabulate_density_functions_
+            ? symmetry_S_derivative_table_(rhoB_over_rho0) / nuclear_density
+            : 8.2 * std::pow(rhoB_over_rho0, -1. / 3.) / nuclear_density +
+                  20. * symmetry_gamma_ *
+                      std::pow(rhoB_over_rho0, symmetry_gamma_) / rhoB;
     double term2 = -2. * symmetry_S(rhoB) / rhoB;
     return mev_to_gev * (term1 + term2) * rhoI3 * rhoI3 / (rhoB * rhoB);
   } else {
@@ -271,7 +322,8 @@ double Potentials::dVsym_drhoB(const double rhoB, const double rhoI3) const {
 }
 
 std::tuple<ThreeVector, ThreeVector, ThreeVector, ThreeVector>
-Potentials::all_forces(const ThreeVector &r, const ParticleList &plist) const {
+Potentials::all_forces(const ThreeVector &r,
+                       const ParticlesView &plist) const {
   const bool compute_gradient = true;
   const bool smearing = true;
   auto F_skyrme_or_VDF =
@@ -0,0 +1,71 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/powersumtable.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace smash {
+
+PowerSumTable::PowerSumTable(std::vector<double> coeffs,
+                             std::vector<double> powers, double tolerance,
+                             int min_exponent, int max_exponent)
+    : coeffs_(std::move(coeffs)),
+      powers_(std::move(powers)),
+      min_exponent_(min_exponent),
+      max_exponent_(max_exponent) {
+  if (coeffs_.size() != powers_.size()) {
+    throw std::invalid_argument(
+        "PowerSumTable needs as many coefficients as exponents.");
+  }
+  const int n_intervals = max_exponent_ - min_exponent_;
+  // The number of steps stays a power of two, such that t < steps_ in the
+  // lookup also after rounding.
+  for (steps_ = 16; steps_ <= (1 << 16); steps_ *= 2) {
+    values_.resize(n_intervals * steps_ + 1);
+    // The k-th step above 2^e starts at 2^e (1 + k / steps_)
+    auto argument = [this](std::size_t i, double k_offset) {
+      const int exponent = min_exponent_ + static_cast<int>(i / steps_);
+      return std::ldexp(1. + (i % steps_ + k_offset) / steps_, exponent);
+    };
+    for (std::size_t i = 0; i < values_.size(); i++) {
+      values_[i] = exact(argument(i, 0.));
+    }
+    bool accurate = true;
+    for (std::size_t i = 0; accurate && i + 1 < values_.size(); i++) {
+      const double x = argument(i, 0.5);
+      const double interpolated = 0.5 * (values_[i] + values_[i + 1]);
+      accurate = std::abs(interpolated - exact(x)) <= tolerance * magnitude(x);
+    }
+    if (accurate) {
+      return;
+    }
+  }
+  throw std::invalid_argument(
+      "PowerSumTable cannot reach the requested tolerance.");
+}
+
+double PowerSumTable::exact(double x) const {
+  double sum = 0.;
+  for (std::size_t i = 0; i < coeffs_.size(); i++) {
+    sum += coeffs_[i] * std::pow(x, powers_[i]);
+  }
+  return sum;
+}
+
+double PowerSumTable::magnitude(double x) const {
+  double sum = 0.;
+  for (std::size_t i = 0; i < coeffs_.size(); i++) {
+    sum += std::abs(coeffs_[i] * std::pow(x, powers_[i]));
+  }
+  return sum;
+}
+
+}  // namespace smash
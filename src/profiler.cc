@@ -0,0 +1,185 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace smash {
+
+Profiler::Section Profiler::section(const std::string &name) {
+  for (Section i = 0; i < entries_.size(); i++) {
+    if (entries_[i].name == name) {
+      return i;
+    }
+  }
+  entries_.emplace_back(name);
+  return entries_.size() - 1;
+}
+
+bool Profiler::count_hardware_events() {
+  enabled_ = true;
+  counted_events_ = HardwareCounters::available();
+  count_hardware_ = std::any_of(counted_events_.begin(), counted_events_.end(),
+                                [](bool counted) { return counted; });
+  return count_hardware_;
+}
+
+void Profiler::add(Section section, Clock::duration duration) {
+  Entry &entry = entries_[section];
+  entry.event_ns.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+      std::memory_order_relaxed);
+  entry.event_calls.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::add_counts(Section section,
+                          const HardwareCounters::Counts &counts) {
+  Entry &entry = entries_[section];
+  for (std::size_t i = 0; i < counts.size(); i++) {
+    entry.event_counts[i].fetch_add(counts[i], std::memory_order_relaxed);
+  }
+}
+
+void Profiler::start_event() {
+  for (Entry &entry : entries_) {
+    entry.event_ns = 0;
+    entry.event_calls = 0;
+    for (std::atomic<int64_t> &count : entry.event_counts) {
+      count = 0;
+    }
+  }
+  event_start_ = Clock::now();
+}
+
+std::string Profiler::finish_event() {
+  const int64_t wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              Clock::now() - event_start_)
+                              .count();
+  std::deque<int64_t> times, calls;
+  for (Entry &entry : entries_) {
+    times.push_back(entry.event_ns);
+    calls.push_back(entry.event_calls);
+    entry.total_ns += times.back();
+    entry.total_calls += calls.back();
+    entry.event_ns = 0;
+    entry.event_calls = 0;
+    for (std::size_t i = 0; i < entry.total_counts.size(); i++) {
+      entry.total_counts[i] += entry.event_counts[i].exchange(0);
+    }
+  }
+  total_wall_ns_ += wall_ns;
+  n_events_++;
+  return report("Time profile of the event", wall_ns, times, calls);
+}
+
+void Profiler::add_totals(const Profiler &other) {
+  for (const Entry &entry : other.entries_) {
+    Entry &own = entries_[section(entry.name)];
+    own.total_ns += entry.total_ns;
+    own.total_calls += entry.total_calls;
+    for (std::size_t i = 0; i < own.total_counts.size(); i++) {
+      own.total_counts[i] += entry.total_counts[i];
+    }
+  }
+  total_wall_ns_ += other.total_wall_ns_;
+  n_events_ += other.n_events_;
+}
+
+std::string Profiler::total_report() const {
+  std::deque<int64_t> times, calls;
+  for (const Entry &entry : entries_) {
+    times.push_back(entry.total_ns);
+    calls.push_back(entry.total_calls);
+  }
+  return report("Time profile of " + std::to_string(n_events_) + " events",
+                total_wall_ns_, times, calls);
+}
+
+std::vector<Profiler::Total> Profiler::totals() const {
+  std::deque<int64_t> times, calls;
+  std::deque<HardwareCounters::Counts> counts;
+  for (const Entry &entry : entries_) {
+    times.push_back(entry.total_ns);
+    calls.push_back(entry.total_calls);
+    counts.push_back(entry.total_counts);
+  }
+  return list(times, calls, counts);
+}
+
+std::vector<Profiler::Total> Profiler::event_totals() const {
+  std::deque<int64_t> times, calls;
+  std::deque<HardwareCounters::Counts> counts;
+  for (const Entry &entry : entries_) {
+    times.push_back(entry.event_ns.load(std::memory_order_relaxed));
+    calls.push_back(entry.event_calls.load(std::memory_order_relaxed));
+    counts.emplace_back();
+    for (std::size_t i = 0; i < counts.back().size(); i++) {
+      counts.back()[i] = entry.event_counts[i].load(std::memory_order_relaxed);
+    }
+  }
+  return list(times, calls, counts);
+}
+
+std::vector<Profiler::Total> Profiler::list(
+    const std::deque<int64_t> &times, const std::deque<int64_t> &calls,
+    const std::deque<HardwareCounters::Counts> &counts) const {
+  std::vector<Total> result;
+  for (const Section i : measured_sections(times, calls)) {
+    result.push_back({entries_[i].name, 1e-9 * times[i], calls[i]});
+    if (count_hardware_) {
+      for (std::size_t event = 0; event < counted_events_.size(); event++) {
+        if (counted_events_[event]) {
+          result.back().counts.emplace_back(HardwareCounters::names[event],
+                                            counts[i][event]);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<Profiler::Section> Profiler::measured_sections(
+    const std::deque<int64_t> &times, const std::deque<int64_t> &calls) const {
+  std::vector<Section> measured;
+  for (Section i = 0; i < entries_.size(); i++) {
+    if (calls[i] > 0) {
+      measured.push_back(i);
+    }
+  }
+  std::stable_sort(measured.begin(), measured.end(),
+                   [&](Section a, Section b) { return times[a] > times[b]; });
+  return measured;
+}
+
+std::string Profiler::report(const std::string &title, int64_t wall_ns,
+                             const std::deque<int64_t> &times,
+                             const std::deque<int64_t> &calls) const {
+  const std::vector<Section> measured = measured_sections(times, calls);
+  std::size_t name_width = 0;
+  for (const Section i : measured) {
+    name_width = std::max(name_width, entries_[i].name.size());
+  }
+  std::ostringstream out;
+  out << title << " (wall time " << std::fixed << std::setprecision(3)
+      << 1e-9 * wall_ns << " s):";
+  for (const Section i : measured) {
+    out << "\n  " << std::left << std::setw(name_width) << entries_[i].name
+        << std::right << std::setw(12) << 1e-9 * times[i] << " s"
+        << std::setw(8) << std::setprecision(1)
+        << (wall_ns > 0 ? 100. * times[i] / wall_ns : 0.) << " %"
+        << std::setw(14) << calls[i] << " calls" << std::setprecision(3);
+  }
+  return out.str();
+}
+
+}  // namespace smash
@@ -9,10 +9,18 @@
 
 #include "smash/propagation.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
 #include "smash/boxmodus.h"
 #include "smash/collidermodus.h"
 #include "smash/listmodus.h"
 #include "smash/logging.h"
+#include "smash/particlecelllist.h"
 #include "smash/spheremodus.h"
 
 namespace smash {
@@ -41,182 +49,355 @@ double calc_hubble(double time, const ExpansionProperties &metric) {
   return h;
 }
 
+namespace {
+/**
+ * The positions and one more three-vector of a chunk of particles, stored
+ * component by component. The kernels below copy the particles of the chunk
+ * into the buffer, update all of them in a single loop without branches,
+ * which the compiler vectorizes, and copy the results back. The chunks are
+ * small enough for the buffer to stay in the cache.
+ */
+struct ComponentBuffer {
+  /// The number of particles in a chunk
+  static constexpr std::size_t capacity = 256;
+  /// The particles of the chunk
+  std::array<ParticleData *, capacity> particles;
+  /// The times of the positions
+  std::array<double, capacity> t;
+  /// The spatial components of the positions
+  std::array<double, capacity> x, y, z;
+  /// The components of the velocities or of the momenta
+  std::array<double, capacity> ux, uy, uz;
+
+  /**
+   * Copy the position and the second three-vector of a particle into the
+   * buffer.
+   *
+   * \param[in] i The position of the particle in the buffer.
+   * \param[in] data The particle.
+   * \param[in] u The second three-vector of the particle.
+   */
+  void set(std::size_t i, ParticleData &data, const ThreeVector &u) {
+    particles[i] = &data;
+    const FourVector &position = data.position();
+    t[i] = position.x0();
+    x[i] = position.x1();
+    y[i] = position.x2();
+    z[i] = position.x3();
+    ux[i] = u.x1();
+    uy[i] = u.x2();
+    uz[i] = u.x3();
+  }
+};
+
+/**
+ * Pass the particles chunk by chunk to a kernel.
+ *
+ * \param[in] particles The particles.
+ * \param[in] second The second three-vector of a particle, which is copied
+ *            into the buffer.
+ * \param[in] kernel The function processing the particles in the buffer,
+ *            called with the buffer and the number of particles in it.
+ */
+template <typename Second, typename Kernel>
+void for_each_chunk(Particles *particles, const Second &second,
+                    const Kernel &kernel) {
+  ComponentBuffer buffer;
+  std::size_t n = 0;
+  for (ParticleData &data : *particles) {
+    buffer.set(n++, data, second(data));
+    if (n == ComponentBuffer::capacity) {
+      kernel(buffer, n);
+      n = 0;
+    }
+  }
+  if (n > 0) {
+    kernel(buffer, n);
+  }
+}
+}  // namespace
+
 double propagate_straight_line(Particles *particles, double to_time,
                                const std::vector<FourVector> &beam_momentum) {
+  /* The initial nucleons, which move with the beam momentum, are found by
+   * their ids and propagated separately, see below. All other particles are
+   * propagated with their own velocities. */
+  std::vector<std::pair<ParticleData *, FourVector>> frozen;
+  for (int id = 0; id < static_cast<int>(beam_momentum.size()); id++) {
+    ParticleData *data = particles->find(id);
+    if (data != nullptr && data->collisions_per_particle() == 0) {
+      const double dt = to_time - data->position().x0();
+      FourVector position =
+          data->position() + FourVector(0.0, beam_momentum[id].velocity() * dt);
+      position.set_x0(to_time);
+      frozen.emplace_back(data, position);
+    }
+  }
+
   bool negative_dt_error = false;
   double dt = 0.0;
-  for (ParticleData &data : *particles) {
-    const double t0 = data.position().x0();
-    dt = to_time - t0;
-    if (dt < 0.0 && !negative_dt_error) {
-      // Print error message once, not for every particle
-      negative_dt_error = true;
-      logg[LPropagation].error("propagate_straight_line - negative dt = ", dt);
-    }
-    assert(dt >= 0.0);
-    /* "Frozen Fermi motion": Fermi momenta are only used for collisions,
-     * but not for propagation. This is done to avoid nucleus flying apart
-     * even if potentials are off. Initial nucleons before the first collision
-     * are propagated only according to beam momentum.
-     * Initial nucleons are distinguished by data.id() < the size of
-     * beam_momentum, which is by default zero except for the collider modus
-     * with the fermi motion == frozen.
-     * todo(m. mayer): improve this condition (see comment #11 issue #4213)*/
-    assert(data.id() >= 0);
-    const bool avoid_fermi_motion =
-        (static_cast<uint64_t>(data.id()) <
-         static_cast<uint64_t>(beam_momentum.size())) &&
-        (data.get_history().collisions_per_particle == 0);
-    ThreeVector v;
-    if (avoid_fermi_motion) {
-      const FourVector vbeam = beam_momentum[data.id()];
-      v = vbeam.velocity();
-    } else {
-      v = data.velocity();
-    }
-    const FourVector distance = FourVector(0.0, v * dt);
-    logg[LPropagation].debug("Particle ", data, " motion: ", distance);
-    FourVector position = data.position() + distance;
-    position.set_x0(to_time);
-    data.set_4position(position);
+  const auto velocity = [](const ParticleData &data) {
+    return data.velocity();
+  };
+  for_each_chunk(particles, velocity, [&](ComponentBuffer &b, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+      const double dt_i = to_time - b.t[i];
+      b.x[i] += b.ux[i] * dt_i;
+      b.y[i] += b.uy[i] * dt_i;
+      b.z[i] += b.uz[i] * dt_i;
+    }
+    for (std::size_t i = 0; i < n; i++) {
+      b.particles[i]->set_4position(
+          FourVector(to_time, b.x[i], b.y[i], b.z[i]));
+      if (b.t[i] > to_time && !negative_dt_error) {
+        // Print error message once, not for every particle
+        negative_dt_error = true;
+        logg[LPropagation].error("propagate_straight_line - negative dt = ",
+                                 to_time - b.t[i]);
+      }
+    }
+    dt = to_time - b.t[n - 1];
+  });
+  assert(!negative_dt_error);
+
+  for (const auto &[data, position] : frozen) {
+    data->set_4position(position);
   }
   return dt;
 }
 
+double propagate_straight_line(ParticleData *data, double to_time,
+                               const std::vector<FourVector> &beam_momentum) {
+  const double dt = to_time - data->position().x0();
+  assert(dt >= 0.0);
+  /* "Frozen Fermi motion": Fermi momenta are only used for collisions,
+   * but not for propagation. This is done to avoid nucleus flying apart
+   * even if potentials are off. Initial nucleons before the first collision
+   * are propagated only according to beam momentum.
+   * Initial nucleons are distinguished by data.id() < the size of
+   * beam_momentum, which is by default zero except for the collider modus
+   * with the fermi motion == frozen.
+   * todo(m. mayer): improve this condition (see comment #11 issue #4213)*/
+  assert(data->id() >= 0);
+  const bool avoid_fermi_motion =
+      (static_cast<uint64_t>(data->id()) <
+       static_cast<uint64_t>(beam_momentum.size())) &&
+      (data->collisions_per_particle() == 0);
+  ThreeVector v;
+  if (avoid_fermi_motion) {
+    const FourVector vbeam = beam_momentum[data->id()];
+    v = vbeam.velocity();
+  } else {
+    v = data->velocity();
+  }
+  const FourVector distance = FourVector(0.0, v * dt);
+  logg[LPropagation].debug("Particle ", *data, " motion: ", distance);
+  FourVector position = data->position() + distance;
+  position.set_x0(to_time);
+  data->set_4position(position);
+  return dt;
+}
+
 void backpropagate_straight_line(Particles *particles, double to_time) {
   bool positive_dt_error = false;
-  for (ParticleData &data : *particles) {
-    const double t = data.position().x0();
-    if (t < to_time && !positive_dt_error) {
-      // Print error message once, not for every particle
-      positive_dt_error = true;
-      logg[LPropagation].error(
-          to_time,
-          " in backpropagate_straight_line is after the earliest particle.");
-    }
-    assert(t >= to_time);
-    const double dt = to_time - t;
-    const ThreeVector r = data.position().threevec() + dt * data.velocity();
-    data.set_4position(FourVector(to_time, r));
-    data.set_formation_time(t);
-    data.set_cross_section_scaling_factor(0.0);
-  }
+  const auto velocity = [](const ParticleData &data) {
+    return data.velocity();
+  };
+  for_each_chunk(particles, velocity, [&](ComponentBuffer &b, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) {
+      const double dt = to_time - b.t[i];
+      b.x[i] += dt * b.ux[i];
+      b.y[i] += dt * b.uy[i];
+      b.z[i] += dt * b.uz[i];
+    }
+    for (std::size_t i = 0; i < n; i++) {
+      ParticleData &data = *b.particles[i];
+      data.set_4position(FourVector(to_time, b.x[i], b.y[i], b.z[i]));
+      data.set_formation_time(b.t[i]);
+      data.set_cross_section_scaling_factor(0.0);
+      if (b.t[i] < to_time && !positive_dt_error) {
+        // Print error message once, not for every particle
+        positive_dt_error = true;
+        logg[LPropagation].error(
+            to_time,
+            " in backpropagate_straight_line is after the earliest particle.");
+      }
+    }
+  });
+  assert(!positive_dt_error);
 }
 
 void expand_space_time(Particles *particles,
                        const ExperimentParameters &parameters,
                        const ExpansionProperties &metric) {
   const double dt = parameters.labclock->timestep_duration();
-  for (ParticleData &data : *particles) {
+  const double h = calc_hubble(parameters.labclock->current_time(), metric);
+  const auto momentum = [](const ParticleData &data) {
+    return data.momentum().threevec();
+  };
+  for_each_chunk(particles, momentum, [&](ComponentBuffer &b, std::size_t n) {
     // Momentum and position modification to ensure appropriate expansion
-    const double h = calc_hubble(parameters.labclock->current_time(), metric);
-    FourVector delta_mom = FourVector(0.0, h * data.momentum().threevec() * dt);
-    FourVector expan_dist =
-        FourVector(0.0, h * data.position().threevec() * dt);
-
-    logg[LPropagation].debug("Particle ", data,
-                             " expansion motion: ", expan_dist);
-    // New position and momentum
-    FourVector position = data.position() + expan_dist;
-    FourVector momentum = data.momentum() - delta_mom;
-
-    // set the new momentum and position variables
-    data.set_4position(position);
-    data.set_4momentum(momentum);
-    // force the on shell condition to ensure correct energy
-    data.set_4momentum(data.pole_mass(), data.momentum().threevec());
-  }
+    for (std::size_t i = 0; i < n; i++) {
+      b.x[i] += h * b.x[i] * dt;
+      b.y[i] += h * b.y[i] * dt;
+      b.z[i] += h * b.z[i] * dt;
+      b.ux[i] -= h * b.ux[i] * dt;
+      b.uy[i] -= h * b.uy[i] * dt;
+      b.uz[i] -= h * b.uz[i] * dt;
+    }
+    for (std::size_t i = 0; i < n; i++) {
+      ParticleData &data = *b.particles[i];
+      data.set_4position(FourVector(b.t[i], b.x[i], b.y[i], b.z[i]));
+      // force the on shell condition to ensure correct energy
+      data.set_4momentum(data.pole_mass(),
+                         ThreeVector(b.ux[i], b.uy[i], b.uz[i]));
+    }
+  });
 }
 
-void update_momenta(
+double update_momenta(
     std::vector<Particles> &ensembles, double dt, const Potentials &pot,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FB_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FI3_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *EM_lat,
-    DensityLattice *jB_lat) {
-  // Copy particles from ALL ensembles to a single list before propagation
-  // and calculate potentials from this list
+    DensityLattice *jB_lat, ThreadPool *thread_pool) {
+  /* Copy particles from ALL ensembles to a single list before propagation
+   * and calculate potentials from this list. The list is only read outside of
+   * the lattices and for momentum dependent potentials. The copy cannot be
+   * replaced by a view of the ensembles, because the momenta are updated in
+   * place while the potentials of the other particles are still evaluated. */
+  std::size_t n_particles = 0;
+  for (const Particles &particles : ensembles) {
+    n_particles += particles.size();
+  }
   ParticleList plist;
-  for (Particles &particles : ensembles) {
-    const ParticleList tmp = particles.copy_to_vector();
-    plist.insert(plist.end(), tmp.begin(), tmp.end());
+  if (pot.use_potentials_outside_lattice() || pot.use_momentum_dependence()) {
+    plist.reserve(n_particles);
+    for (const Particles &particles : ensembles) {
+      plist.insert(plist.end(), particles.begin(), particles.end());
+    }
+  }
+  // The view is created once instead of for every evaluation of the forces
+  const ParticlesView all_particles_before(plist);
+  /* Outside of the lattices, only the particles closer than the cutoff of the
+   * smearing contribute to the forces. They are looked up in a cell list,
+   * which returns them in the order of the copied list, such that the sums
+   * are the same as over all particles. */
+  std::optional<ParticleCellList> cell_list;
+  if (pot.use_potentials_outside_lattice()) {
+    cell_list.emplace(plist, pot.density_parameters().r_cut());
   }
 
   bool possibly_use_lattice =
       (pot.use_skyrme() ? (FB_lat != nullptr) : true) &&
       (pot.use_vdf() ? (FB_lat != nullptr) : true) &&
       (pot.use_symmetry() ? (FI3_lat != nullptr) : true);
-  std::pair<ThreeVector, ThreeVector> FB, FI3, EM_fields;
-  double min_time_scale = std::numeric_limits<double>::infinity();
 
-  for (Particles &particles : ensembles) {
-    for (ParticleData &data : particles) {
-      // Only baryons and nuclei will be affected by the potentials
-      if (!(data.is_baryon() || data.is_nucleus())) {
-        continue;
-      }
-      const auto scale = pot.force_scale(data.type());
-      const ThreeVector r = data.position().threevec();
-      /* Lattices can be used for calculation if 1-2 are fulfilled:
-       * 1) Required lattices are not nullptr - possibly_use_lattice
-       * 2) r is not out of required lattices */
-      const bool use_lattice =
-          possibly_use_lattice &&
-          (pot.use_skyrme() ? FB_lat->value_at(r, FB) : true) &&
-          (pot.use_vdf() ? FB_lat->value_at(r, FB) : true) &&
-          (pot.use_symmetry() ? FI3_lat->value_at(r, FI3) : true);
-      if (!use_lattice && !pot.use_potentials_outside_lattice()) {
-        continue;
-      }
-      if (!pot.use_skyrme() && !pot.use_vdf()) {
-        FB = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
-      }
-      if (!pot.use_symmetry()) {
-        FI3 = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
-      }
-      if (!use_lattice) {
-        const auto tmp = pot.all_forces(r, plist);
-        FB = std::make_pair(std::get<0>(tmp), std::get<1>(tmp));
-        FI3 = std::make_pair(std::get<2>(tmp), std::get<3>(tmp));
+  /* Update the momentum of a single particle and return the time scale of the
+   * change in momentum, which is infinite if the particle is not affected.
+   * Particles only depend on the copied list and the lattices, hence they can
+   * be updated in any order. */
+  auto update_particle = [&](ParticleData &data) {
+    constexpr double no_time_scale = std::numeric_limits<double>::infinity();
+    // Only baryons and nuclei will be affected by the potentials
+    if (!(data.is_baryon() || data.is_nucleus())) {
+      return no_time_scale;
+    }
+    std::pair<ThreeVector, ThreeVector> FB, FI3, EM_fields;
+    const auto scale = pot.force_scale(data.type());
+    const ThreeVector r = data.position().threevec();
+    /* Lattices can be used for calculation if 1-2 are fulfilled:
+     * 1) Required lattices are not nullptr - possibly_use_lattice
+     * 2) r is not out of required lattices */
+    const bool use_lattice =
+        possibly_use_lattice &&
+        (pot.use_skyrme() ? FB_lat->value_at(r, FB) : true) &&
+        (pot.use_vdf() ? FB_lat->value_at(r, FB) : true) &&
+        (pot.use_symmetry() ? FI3_lat->value_at(r, FI3) : true);
+    if (!use_lattice && !pot.use_potentials_outside_lattice()) {
+      return no_time_scale;
+    }
+    if (!pot.use_skyrme() && !pot.use_vdf()) {
+      FB = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
+    }
+    if (!pot.use_symmetry()) {
+      FI3 = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
+    }
+    if (!use_lattice) {
+      ParticleList neighbors;
+      cell_list->find_candidates(r, neighbors);
+      const auto tmp = pot.all_forces(r, neighbors);
+      FB = std::make_pair(std::get<0>(tmp), std::get<1>(tmp));
+      FI3 = std::make_pair(std::get<2>(tmp), std::get<3>(tmp));
+    }
+    ThreeVector force = std::invoke([&]() {
+      if (pot.use_momentum_dependence()) {
+        const ThreeVector energy_grad = pot.single_particle_energy_gradient(
+            jB_lat, data.position().threevec(), data.momentum().threevec(),
+            data.effective_mass(), all_particles_before);
+        return -energy_grad * scale.first +
+               scale.second * data.type().isospin3_rel() *
+                   (FI3.first +
+                    data.momentum().velocity().cross_product(FI3.second));
+      } else {
+        return scale.first *
+                   (FB.first +
+                    data.momentum().velocity().cross_product(FB.second)) +
+               scale.second * data.type().isospin3_rel() *
+                   (FI3.first +
+                    data.momentum().velocity().cross_product(FI3.second));
       }
-      ThreeVector force = std::invoke([&]() {
-        if (pot.use_momentum_dependence()) {
-          const ThreeVector energy_grad = pot.single_particle_energy_gradient(
-              jB_lat, data.position().threevec(), data.momentum().threevec(),
-              data.effective_mass(), plist);
-          return -energy_grad * scale.first +
-                 scale.second * data.type().isospin3_rel() *
-                     (FI3.first +
-                      data.momentum().velocity().cross_product(FI3.second));
-        } else {
-          return scale.first *
-                     (FB.first +
-                      data.momentum().velocity().cross_product(FB.second)) +
-                 scale.second * data.type().isospin3_rel() *
-                     (FI3.first +
-                      data.momentum().velocity().cross_product(FI3.second));
-        }
-      });
-      // Potentially add Lorentz force
-      if (pot.use_coulomb() && EM_lat->value_at(r, EM_fields)) {
-        // factor hbar*c to convert fields from 1/fm^2 to GeV/fm
-        force += hbarc * data.type().charge() * elementary_charge *
-                 (EM_fields.first +
-                  data.momentum().velocity().cross_product(EM_fields.second));
+    });
+    // Potentially add Lorentz force
+    if (pot.use_coulomb() && EM_lat->value_at(r, EM_fields)) {
+      // factor hbar*c to convert fields from 1/fm^2 to GeV/fm
+      force += hbarc * data.type().charge() * elementary_charge *
+               (EM_fields.first +
+                data.momentum().velocity().cross_product(EM_fields.second));
+    }
+    logg[LPropagation].debug("Update momenta: F [GeV/fm] = ", force);
+    data.set_4momentum(data.effective_mass(),
+                       data.momentum().threevec() + force * dt);
+
+    // calculate the time scale of the change in momentum
+    const double Force_abs = force.abs();
+    if (Force_abs < really_small) {
+      return no_time_scale;
+    }
+    return data.momentum().x0() / Force_abs;
+  };
+
+  double min_time_scale = std::numeric_limits<double>::infinity();
+  if (thread_pool == nullptr || thread_pool->size() < 2) {
+    for (Particles &particles : ensembles) {
+      for (ParticleData &data : particles) {
+        min_time_scale = std::min(min_time_scale, update_particle(data));
       }
-      logg[LPropagation].debug("Update momenta: F [GeV/fm] = ", force);
-      data.set_4momentum(data.effective_mass(),
-                         data.momentum().threevec() + force * dt);
-
-      // calculate the time scale of the change in momentum
-      const double Force_abs = force.abs();
-      if (Force_abs < really_small) {
-        continue;
+    }
+  } else {
+    /* Every thread updates a contiguous chunk of the particles. The minimum
+     * does not depend on the order, hence the result is the same as for the
+     * serial update. */
+    std::vector<ParticleData *> all_particles;
+    all_particles.reserve(n_particles);
+    for (Particles &particles : ensembles) {
+      for (ParticleData &data : particles) {
+        all_particles.push_back(&data);
       }
-      const double time_scale = data.momentum().x0() / Force_abs;
-      if (time_scale < min_time_scale) {
-        min_time_scale = time_scale;
+    }
+    const std::size_t n = all_particles.size();
+    const std::size_t n_chunks = thread_pool->size();
+    std::vector<double> min_time_scales(
+        n_chunks, std::numeric_limits<double>::infinity());
+    thread_pool->parallel_for(n_chunks, [&](std::size_t chunk) {
+      double &chunk_min = min_time_scales[chunk];
+      for (std::size_t i = chunk * n / n_chunks; i < (chunk + 1) * n / n_chunks;
+           i++) {
+        chunk_min = std::min(chunk_min, update_particle(*all_particles[i]));
       }
+    });
+    for (const double time_scale : min_time_scales) {
+      min_time_scale = std::min(min_time_scale, time_scale);
     }
   }
   // warn if the time step is too big
@@ -229,6 +410,7 @@ void update_momenta(
         << "In case of Triangular or Discrete smearing you may additionally "
         << "need to increase the number of ensembles or testparticles.";
   }
+  return min_time_scale;
 }
 
 }  // namespace smash
@@ -9,6 +9,7 @@
 
 #include "smash/quantumsampling.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <random>
@@ -210,7 +211,7 @@ double QuantumSampling::maximum_of_the_distribution(
  */
 QuantumSampling::QuantumSampling(
     const std::map<PdgCode, int> &initial_multiplicities, double volume,
-    double temperature)
+    double temperature, bool tabulate)
     : volume_(volume), temperature_(temperature) {
   /*
    * This is the precision which we expect from the solution; note that
@@ -236,6 +237,12 @@ QuantumSampling::QuantumSampling(
         spin_degeneracy, particle_mass, number_density, temperature_,
         quantum_statistics, solution_precision);
     effective_chemical_potentials_[pdg] = chemical_potential;
+    if (tabulate) {
+      // The maximum is only needed for the rejection sampling
+      momentum_quantiles_[pdg] = tabulate_quantiles(
+          particle_mass, chemical_potential, quantum_statistics);
+      continue;
+    }
     const double distribution_function_maximum = maximum_of_the_distribution(
         particle_mass, temperature_, chemical_potential, quantum_statistics,
         solution_precision);
@@ -254,21 +261,60 @@ QuantumSampling::QuantumSampling(
  * This sampler is the simplest implementation of sampling based on sampling
  * from a uniform distribution.
  */
+std::vector<double> QuantumSampling::tabulate_quantiles(
+    double mass, double effective_chemical_potential, double statistics) const {
+  // Cumulative distribution on a fine grid, integrated with the trapezoidal
+  // rule
+  const double dp = maximum_momentum_ / n_momentum_intervals_;
+  std::vector<double> cdf(n_momentum_intervals_ + 1, 0.0);
+  double previous_density = 0.0;
+  for (size_t i = 1; i <= n_momentum_intervals_; i++) {
+    const double p = dp * i;
+    const double density =
+        p * p *
+        juttner_distribution_func(p, mass, temperature_,
+                                  effective_chemical_potential, statistics);
+    cdf[i] = cdf[i - 1] + 0.5 * (previous_density + density);
+    previous_density = density;
+  }
+  // Invert it at equally spaced fractions, linearly within the grid intervals
+  std::vector<double> quantiles(n_quantiles_ + 1);
+  quantiles[0] = 0.0;
+  quantiles[n_quantiles_] = maximum_momentum_;
+  size_t i = 1;
+  for (size_t k = 1; k < n_quantiles_; k++) {
+    const double target = cdf.back() * k / n_quantiles_;
+    while (i < n_momentum_intervals_ && cdf[i] < target) {
+      i++;
+    }
+    const double dcdf = cdf[i] - cdf[i - 1];
+    const double fraction = dcdf > 0.0 ? (target - cdf[i - 1]) / dcdf : 0.0;
+    quantiles[k] = dp * (i - 1 + fraction);
+  }
+  return quantiles;
+}
+
 double QuantumSampling::sample(const PdgCode pdg) {
+  const auto quantiles = momentum_quantiles_.find(pdg);
+  if (quantiles != momentum_quantiles_.end()) {
+    const std::vector<double> &q = quantiles->second;
+    const double u = random::uniform(0.0, static_cast<double>(n_quantiles_));
+    const size_t k = std::min(static_cast<size_t>(u), n_quantiles_ - 1);
+    return q[k] + (u - k) * (q[k + 1] - q[k]);
+  }
   const ParticleType &ptype = ParticleType::find(pdg);
   const double mass = ptype.mass();
   const double mu = effective_chemical_potentials_.find(pdg)->second;
   const double distr_max = distribution_function_maximums_.find(pdg)->second;
   /*
-   * The variable maximum_momentum denotes the "far right" boundary of the
+   * The variable maximum_momentum_ denotes the "far right" boundary of the
    * sampled region; we assume that no particle has momentum larger than 10 GeV
    */
-  constexpr double maximum_momentum = 10.0;  // in [GeV]
   const double statistics = (pdg.spin() % 2 == 0) ? -1.0 : 1.0;
   double sampled_momentum = 0.0, sampled_ratio = 0.0;
 
   do {
-    sampled_momentum = random::uniform(0.0, maximum_momentum);
+    sampled_momentum = random::uniform(0.0, maximum_momentum_);
     double distribution_at_sampled_p =
         sampled_momentum * sampled_momentum *
         juttner_distribution_func(sampled_momentum, mass, temperature_, mu,
@@ -16,7 +16,7 @@
 
 namespace smash {
 static constexpr int LGrandcanThermalizer = LogArea::GrandcanThermalizer::id;
-/*thread_local (see #3075)*/ random::Engine random::engine;
+thread_local random::Engine random::engine;
 
 int64_t random::generate_63bit_seed() {
   std::random_device rd;
@@ -29,6 +29,15 @@ int64_t random::generate_63bit_seed() {
   return seed;
 }
 
+random::Engine random::make_stream(uint64_t seed, StreamKind kind,
+                                   uint64_t index) {
+  const auto low = [](uint64_t x) { return static_cast<uint32_t>(x); };
+  const auto high = [](uint64_t x) { return static_cast<uint32_t>(x >> 32); };
+  std::seed_seq sequence{low(seed),  high(seed),  static_cast<uint32_t>(kind),
+                         low(index), high(index)};
+  return Engine(sequence);
+}
+
 random::BesselSampler::BesselSampler(const double poisson_mean1,
                                      const double poisson_mean2,
                                      const int fixed_difference)
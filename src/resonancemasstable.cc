@@ -0,0 +1,119 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/resonancemasstable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+#include "smash/formfactors.h"
+#include "smash/kinematics.h"
+#include "smash/random.h"
+
+namespace smash {
+
+std::map<ResonanceMassTable::Key, std::unique_ptr<const ResonanceMassTable>>
+    ResonanceMassTable::tables_;
+std::shared_mutex ResonanceMassTable::tables_mutex_;
+
+ResonanceMassTable::ResonanceMassTable(const ParticleType &resonance,
+                                       double mass_stable, int L, int n_sqrts,
+                                       int n_quantiles)
+    : mass_stable_(mass_stable),
+      m_min_(resonance.min_mass_spectral()),
+      n_sqrts_(n_sqrts),
+      n_quantiles_(n_quantiles),
+      quantiles_(n_sqrts * (n_quantiles + 1)) {
+  const double threshold = m_min_ + mass_stable;
+  const double sqrts_max = std::max(resonance.mass(), m_min_) +
+                           10. * resonance.width_at_pole() + mass_stable;
+  const double dsqrts = (sqrts_max - threshold) / n_sqrts;
+  // The distribution at the threshold is degenerate, start one step above.
+  sqrts_min_ = threshold + dsqrts;
+  inv_dsqrts_ = 1. / dsqrts;
+
+  // The density is integrated with the midpoint rule on a finer mass grid.
+  const int n_masses = 4 * n_quantiles;
+  std::vector<double> cumulative(n_masses + 1);
+  for (int k = 0; k < n_sqrts; k++) {
+    const double sqrts = sqrts_min_ + k * dsqrts;
+    const double dm = (sqrts - mass_stable - m_min_) / n_masses;
+    cumulative[0] = 0.;
+    for (int i = 0; i < n_masses; i++) {
+      const double m = m_min_ + (i + 0.5) * dm;
+      const double pcm = pCM(sqrts, mass_stable, m);
+      cumulative[i + 1] = cumulative[i] + resonance.spectral_function(m) *
+                                               pcm *
+                                               blatt_weisskopf_sqr(pcm, L);
+    }
+    double *row = &quantiles_[k * (n_quantiles + 1)];
+    const double total = cumulative[n_masses];
+    if (!(total > 0.)) {
+      std::fill(row, row + n_quantiles + 1,
+                std::numeric_limits<double>::quiet_NaN());
+      continue;
+    }
+    // Invert the piecewise linear cumulative distribution.
+    int i = 0;
+    for (int j = 0; j <= n_quantiles; j++) {
+      const double target = total * j / n_quantiles;
+      while (i < n_masses - 1 && cumulative[i + 1] < target) {
+        i++;
+      }
+      const double step = cumulative[i + 1] - cumulative[i];
+      const double fraction =
+          step > 0. ? std::clamp((target - cumulative[i]) / step, 0., 1.) : 0.;
+      row[j] = (i + fraction) / n_masses;
+    }
+  }
+}
+
+double ResonanceMassTable::sample(double cms_energy) const {
+  const double t = std::max(0., (cms_energy - sqrts_min_) * inv_dsqrts_);
+  const auto k = static_cast<int>(t);
+  if (k >= n_sqrts_ - 1) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  const double f_sqrts = t - k;
+  const double u = random::canonical() * n_quantiles_;
+  const int j = std::min(static_cast<int>(u), n_quantiles_ - 1);
+  const double f_u = u - j;
+  const double *lower = &quantiles_[k * (n_quantiles_ + 1) + j];
+  const double *upper = lower + n_quantiles_ + 1;
+  const double x_lower = lower[0] + f_u * (lower[1] - lower[0]);
+  const double x_upper = upper[0] + f_u * (upper[1] - upper[0]);
+  const double x = x_lower + f_sqrts * (x_upper - x_lower);
+  // Same largest mass as for the rejection sampling
+  const double max_mass = std::nextafter(cms_energy - mass_stable_, 0.);
+  return std::min(m_min_ + x * (max_mass - m_min_), max_mass);
+}
+
+const ResonanceMassTable &ResonanceMassTable::find(
+    const ParticleType &resonance, double mass_stable, int L) {
+  const Key key{std::addressof(resonance), mass_stable, L};
+  {
+    std::shared_lock lock(tables_mutex_);
+    const auto found = tables_.find(key);
+    if (found != tables_.end()) {
+      return *found->second;
+    }
+  }
+  std::unique_lock lock(tables_mutex_);
+  auto &table = tables_[key];
+  if (!table) {
+    table = std::make_unique<const ResonanceMassTable>(resonance, mass_stable,
+                                                       L);
+  }
+  return *table;
+}
+
+}  // namespace smash
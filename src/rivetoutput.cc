@@ -10,6 +10,9 @@
 
 #include "smash/rivetoutput.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "Rivet/Rivet.hh"
 #include "Rivet/Tools/Logging.hh"
 
@@ -89,6 +92,16 @@ namespace smash {
         - MC_FSPARTICLES
  \endverbatim
  *
+ * \section rivet_output_user_guide_queue_ Asynchronous analyses
+ *
+ * By default, every event is analysed before SMASH continues with the next
+ * one. With several heavy analyses, this can take as long as the simulation
+ * of the event. With a positive \key Queue_Size, the converted events are
+ * instead copied into a queue, from which a separate thread passes them to
+ * Rivet in the same order, while SMASH simulates the next events. The queue
+ * holds at most \key Queue_Size events, which limits the memory used for
+ * them. The results are the same as without the queue.
+ *
  * The Rivet set-up can be configured using the \ref input_output_rivet_
  * "content specific \c Rivet section" in the configuration file.
  */
@@ -99,12 +112,32 @@ RivetOutput::RivetOutput(const std::filesystem::path& path, std::string name,
     : HepMcInterface(name, full_event),
       handler_(),
       filename_(path / (name + ".yoda")),
-      need_init_(true) {
+      need_init_(true),
+      queue_size_(std::max(rivet_par.queue_size, 0)) {
+  if (rivet_par.queue_size < 0) {
+    throw std::invalid_argument(
+        "The queue size of the Rivet output must not be negative.");
+  }
   handler_ = std::make_shared<Rivet::AnalysisHandler>();
   setup(rivet_par);
+  if (queue_size_ > 0) {
+    worker_ = std::thread(&RivetOutput::analyze_queued_events, this);
+  }
 }
 
 RivetOutput::~RivetOutput() {
+  if (worker_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    queue_changed_.notify_all();
+    worker_.join();
+    if (worker_exception_) {
+      logg[LOutput].error() << "The Rivet analyses failed, the results in "
+                            << filename_ << " are incomplete.\n";
+    }
+  }
   logg[LOutput].debug() << "Writing Rivet results to " << filename_ << "\n";
   analysis_handler_proxy()->finalize();
   analysis_handler_proxy()->writeData(filename_.string());
@@ -115,17 +148,61 @@ void RivetOutput::at_eventend(const Particles& particles,
                               const EventInfo& event) {
   HepMcInterface::at_eventend(particles, event_label, event);
 
+  logg[LOutput].debug() << "Analyzing event " << event_label.event_number
+                        << "\n";
+  if (queue_size_ == 0) {
+    analyze(event_);
+    return;
+  }
+  // The copy is made before waiting, while the worker may still be busy
+  auto copy = std::make_unique<HepMC3::GenEvent>(event_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_changed_.wait(lock, [this]() {
+    return queue_.size() < queue_size_ || worker_exception_;
+  });
+  if (worker_exception_) {
+    std::rethrow_exception(worker_exception_);
+  }
+  queue_.push_back(std::move(copy));
+  lock.unlock();
+  queue_changed_.notify_all();
+}
+
+void RivetOutput::analyze(const HepMC3::GenEvent& event) {
   // Initialize Rivet on first event
   if (need_init_) {
     logg[LOutput].debug() << "Initialising Rivet\n";
     need_init_ = false;
-    analysis_handler_proxy()->init(event_);
+    analysis_handler_proxy()->init(event);
   }
-
-  logg[LOutput].debug() << "Analyzing event " << event_label.event_number
-                        << "\n";
   // Let Rivet analyse the event
-  analysis_handler_proxy()->analyze(event_);
+  analysis_handler_proxy()->analyze(event);
+}
+
+void RivetOutput::analyze_queued_events() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queue_changed_.wait(lock, [this]() { return !queue_.empty() || stop_; });
+    if (queue_.empty()) {
+      return;
+    }
+    /* The event stays in the queue while it is analysed, such that at most
+     * queue_size_ events are kept besides the one being simulated. */
+    const HepMC3::GenEvent& event = *queue_.front();
+    lock.unlock();
+    try {
+      analyze(event);
+    } catch (...) {
+      lock.lock();
+      worker_exception_ = std::current_exception();
+      queue_.clear();
+      queue_changed_.notify_all();
+      return;
+    }
+    lock.lock();
+    queue_.pop_front();
+    queue_changed_.notify_all();
+  }
 }
 
 void RivetOutput::add_analysis(const std::string& name) {
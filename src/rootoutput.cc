@@ -9,7 +9,12 @@
 
 #include "smash/rootoutput.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
 #include "TFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 #include "smash/action.h"
 #include "smash/clock.h"
@@ -18,7 +23,7 @@
 
 namespace smash {
 
-const int RootOutput::max_buffer_size_ = 500000;
+const int RootOutput::initial_buffer_size_ = 1000;
 
 /*!\Userguide
  * \page doxypage_output_root
@@ -66,10 +71,8 @@ const int RootOutput::max_buffer_size_ = 500000;
  * px[npart] py[npart] pz[npart] E_kinetic_tot E_fields_tot E_tot
  * \endcode
  * All particles in a ROOT entry (output block) are at the same time and in the
- * same event. The maximal number of particles in one entry is limited to
- * 500000. This is done to limit the buffer size needed for ROOT output. If the
- * number of particles in one ROOT entry (output block) exceeds 500000, then
- * they are written in separate entries with the same \c tcounter and \c ev.
+ * same event. Every output block is written as one entry, however many
+ * particles it contains.
  *
  * Each ROOT entry (output block) contains TBranches with overall information
  * about the event and the output block:
@@ -274,115 +277,141 @@ RootOutput::RootOutput(const std::filesystem::path &path,
       particles_only_final_(out_par.part_only_final),
       part_extended_(out_par.part_extended),
       coll_extended_(out_par.coll_extended),
-      ic_extended_(out_par.ic_extended) {
+      ic_extended_(out_par.ic_extended),
+      basket_size_(out_par.root_basket_size),
+      auto_flush_(out_par.root_auto_flush) {
+  if (basket_size_ <= 0) {
+    throw std::invalid_argument(
+        "The basket size of the ROOT output has to be positive.");
+  }
+  // Implicit multithreading is a global setting of ROOT
+  if (out_par.root_threads > 0 && !ROOT::IsImplicitMTEnabled()) {
+    ROOT::EnableImplicitMT(out_par.root_threads);
+  }
   filename_unfinished_ = filename_;
   filename_unfinished_ += ".unfinished";
   root_out_file_ =
       std::make_unique<TFile>(filename_unfinished_.native().c_str(), "NEW");
+  if (out_par.root_compression) {
+    root_out_file_->SetCompressionSettings(*out_par.root_compression);
+  }
+  ensure_buffer_size(initial_buffer_size_);
   init_trees();
 }
 
+template <typename F>
+void RootOutput::for_each_particle_buffer(bool extended, F &&function) {
+  if (!extended) {
+    function("id", id_);
+    function("pdgcode", pdgcode_);
+    function("charge", charge_);
+    function("formation_time", formation_time_);
+    function("time_last_collision", time_last_collision_);
+
+    function("p0", p0_);
+    function("px", px_);
+    function("py", py_);
+    function("pz", pz_);
+
+    function("t", t_);
+    function("x", x_);
+    function("y", y_);
+    function("z", z_);
+  } else {
+    function("ncoll", coll_per_part_);
+    function("xsecfac", xsec_factor_);
+    function("proc_id_origin", proc_id_origin_);
+    function("proc_type_origin", proc_type_origin_);
+    function("pdg_mother1", pdg_mother1_);
+    function("pdg_mother2", pdg_mother2_);
+    function("baryon_number", baryon_number_);
+    function("strangeness", strangeness_);
+  }
+}
+
 void RootOutput::init_trees() {
+  // Add the branches of the per-particle buffers to the given tree
+  auto add_particle_branches = [this](TTree *tree, bool extended) {
+    for_each_particle_buffer(extended, [this, tree](const std::string &name,
+                                                    auto &buffer) {
+      using T = typename std::decay_t<decltype(buffer)>::value_type;
+      const std::string leaf_list =
+          name + (std::is_same_v<T, int> ? "[npart]/I" : "[npart]/D");
+      tree->Branch(name.c_str(), buffer.data(), leaf_list.c_str(),
+                   basket_size_);
+    });
+  };
+
   if (write_particles_ || write_initial_conditions_) {
     particles_tree_ = new TTree("particles", "particles");
 
-    particles_tree_->Branch("ev", &ev_, "ev/I");
-    particles_tree_->Branch("ens", &ens_, "ens/I");
-    particles_tree_->Branch("tcounter", &tcounter_, "tcounter/I");
-    particles_tree_->Branch("npart", &npart_, "npart/I");
-    particles_tree_->Branch("test_p", &test_p_, "test_p/I");
-    particles_tree_->Branch("modus_l", &modus_l_, "modus_l/D");
-    particles_tree_->Branch("current_t", &current_t_, "current_t/D");
-    particles_tree_->Branch("impact_b", &impact_b_, "impact_b/D");
-    particles_tree_->Branch("empty_event", &empty_event_, "empty_event/O");
-
-    particles_tree_->Branch("id", &id_[0], "id[npart]/I");
-    particles_tree_->Branch("pdgcode", &pdgcode_[0], "pdgcode[npart]/I");
-    particles_tree_->Branch("charge", &charge_[0], "charge[npart]/I");
-    particles_tree_->Branch("formation_time", &formation_time_[0],
-                            "formation_time[npart]/D");
-    particles_tree_->Branch("time_last_collision", &time_last_collision_[0],
-                            "time_last_collision[npart]/D");
-
-    particles_tree_->Branch("p0", &p0_[0], "p0[npart]/D");
-    particles_tree_->Branch("px", &px_[0], "px[npart]/D");
-    particles_tree_->Branch("py", &py_[0], "py[npart]/D");
-    particles_tree_->Branch("pz", &pz_[0], "pz[npart]/D");
-
-    particles_tree_->Branch("t", &t_[0], "t[npart]/D");
-    particles_tree_->Branch("x", &x_[0], "x[npart]/D");
-    particles_tree_->Branch("y", &y_[0], "y[npart]/D");
-    particles_tree_->Branch("z", &z_[0], "z[npart]/D");
+    particles_tree_->Branch("ev", &ev_, "ev/I", basket_size_);
+    particles_tree_->Branch("ens", &ens_, "ens/I", basket_size_);
+    particles_tree_->Branch("tcounter", &tcounter_, "tcounter/I",
+                            basket_size_);
+    particles_tree_->Branch("npart", &npart_, "npart/I", basket_size_);
+    particles_tree_->Branch("test_p", &test_p_, "test_p/I", basket_size_);
+    particles_tree_->Branch("modus_l", &modus_l_, "modus_l/D", basket_size_);
+    particles_tree_->Branch("current_t", &current_t_, "current_t/D",
+                            basket_size_);
+    particles_tree_->Branch("impact_b", &impact_b_, "impact_b/D",
+                            basket_size_);
+    particles_tree_->Branch("empty_event", &empty_event_, "empty_event/O",
+                            basket_size_);
+
+    add_particle_branches(particles_tree_, false);
 
     particles_tree_->Branch("E_kinetic_tot", &E_kinetic_tot_,
-                            "E_kinetic_tot/D");
-    particles_tree_->Branch("E_fields_tot", &E_fields_tot_, "E_fields_tot/D");
-    particles_tree_->Branch("E_tot", &E_tot_, "E_tot/D");
+                            "E_kinetic_tot/D", basket_size_);
+    particles_tree_->Branch("E_fields_tot", &E_fields_tot_, "E_fields_tot/D",
+                            basket_size_);
+    particles_tree_->Branch("E_tot", &E_tot_, "E_tot/D", basket_size_);
 
     if (part_extended_ || ic_extended_) {
-      particles_tree_->Branch("ncoll", &coll_per_part_[0], "ncoll[npart]/I");
-      particles_tree_->Branch("xsecfac", &xsec_factor_[0], "xsecfac[npart]/D");
-      particles_tree_->Branch("proc_id_origin", &proc_id_origin_[0],
-                              "proc_id_origin[npart]/I");
-      particles_tree_->Branch("proc_type_origin", &proc_type_origin_[0],
-                              "proc_type_origin[npart]/I");
-      particles_tree_->Branch("pdg_mother1", &pdg_mother1_[0],
-                              "pdg_mother1[npart]/I");
-      particles_tree_->Branch("pdg_mother2", &pdg_mother2_[0],
-                              "pdg_mother2[npart]/I");
-      particles_tree_->Branch("baryon_number", &baryon_number_[0],
-                              "baryon_number[npart]/I");
-      particles_tree_->Branch("strangeness", &strangeness_[0],
-                              "strangeness[npart]/I");
+      add_particle_branches(particles_tree_, true);
     }
+    particles_tree_->SetAutoFlush(auto_flush_);
   }
 
   if (write_collisions_) {
     collisions_tree_ = new TTree("collisions", "collisions");
 
-    collisions_tree_->Branch("ev", &ev_, "ev/I");
-    collisions_tree_->Branch("ens", &ens_, "ens/I");
-
-    collisions_tree_->Branch("nin", &nin_, "nin/I");
-    collisions_tree_->Branch("nout", &nout_, "nout/I");
-    collisions_tree_->Branch("npart", &npart_, "npart/I");
-    collisions_tree_->Branch("weight", &wgt_, "weight/D");
-    collisions_tree_->Branch("partial_weight", &par_wgt_, "partial_weight/D");
-
-    collisions_tree_->Branch("id", &id_[0], "id[npart]/I");
-    collisions_tree_->Branch("pdgcode", &pdgcode_[0], "pdgcode[npart]/I");
-    collisions_tree_->Branch("charge", &charge_[0], "charge[npart]/I");
-    collisions_tree_->Branch("formation_time", &formation_time_[0],
-                             "formation_time[npart]/D");
-    collisions_tree_->Branch("time_last_collision", &time_last_collision_[0],
-                             "time_last_collision[npart]/D");
-
-    collisions_tree_->Branch("p0", &p0_[0], "p0[npart]/D");
-    collisions_tree_->Branch("px", &px_[0], "px[npart]/D");
-    collisions_tree_->Branch("py", &py_[0], "py[npart]/D");
-    collisions_tree_->Branch("pz", &pz_[0], "pz[npart]/D");
-
-    collisions_tree_->Branch("t", &t_[0], "t[npart]/D");
-    collisions_tree_->Branch("x", &x_[0], "x[npart]/D");
-    collisions_tree_->Branch("y", &y_[0], "y[npart]/D");
-    collisions_tree_->Branch("z", &z_[0], "z[npart]/D");
+    collisions_tree_->Branch("ev", &ev_, "ev/I", basket_size_);
+    collisions_tree_->Branch("ens", &ens_, "ens/I", basket_size_);
+
+    collisions_tree_->Branch("nin", &nin_, "nin/I", basket_size_);
+    collisions_tree_->Branch("nout", &nout_, "nout/I", basket_size_);
+    collisions_tree_->Branch("npart", &npart_, "npart/I", basket_size_);
+    collisions_tree_->Branch("weight", &wgt_, "weight/D", basket_size_);
+    collisions_tree_->Branch("partial_weight", &par_wgt_, "partial_weight/D",
+                             basket_size_);
+
+    add_particle_branches(collisions_tree_, false);
 
     if (coll_extended_) {
-      collisions_tree_->Branch("ncoll", &coll_per_part_[0], "ncoll[npart]/I");
-      collisions_tree_->Branch("xsecfac", &xsec_factor_[0], "xsecfac[npart]/D");
-      collisions_tree_->Branch("proc_id_origin", &proc_id_origin_[0],
-                               "proc_id_origin[npart]/I");
-      collisions_tree_->Branch("proc_type_origin", &proc_type_origin_[0],
-                               "proc_type_origin[npart]/I");
-      collisions_tree_->Branch("pdg_mother1", &pdg_mother1_[0],
-                               "pdg_mother1[npart]/I");
-      collisions_tree_->Branch("pdg_mother2", &pdg_mother2_[0],
-                               "pdg_mother2[npart]/I");
-      collisions_tree_->Branch("baryon_number", &baryon_number_[0],
-                               "baryon_number[npart]/I");
-      collisions_tree_->Branch("strangeness", &strangeness_[0],
-                               "strangeness[npart]/I");
+      add_particle_branches(collisions_tree_, true);
     }
+    collisions_tree_->SetAutoFlush(auto_flush_);
+  }
+}
+
+void RootOutput::ensure_buffer_size(std::size_t n_particles) {
+  if (n_particles <= id_.size()) {
+    return;
+  }
+  const std::size_t new_size = std::max(n_particles, 2 * id_.size());
+  // The extended buffers are always sized, whether they are written or not
+  for (bool extended : {false, true}) {
+    for_each_particle_buffer(extended, [this, new_size](const std::string &name,
+                                                        auto &buffer) {
+      buffer.resize(new_size);
+      // The branches read from the reallocated buffers from now on
+      for (TTree *tree : {particles_tree_, collisions_tree_}) {
+        if (tree && tree->GetBranch(name.c_str())) {
+          tree->SetBranchAddress(name.c_str(), buffer.data());
+        }
+      }
+    });
   }
 }
 
@@ -496,6 +525,22 @@ void RootOutput::at_interaction(const Action &action,
   }
 }
 
+std::size_t RootOutput::memory_usage() const {
+  std::size_t bytes = 0;
+  for (const std::vector<int> *buffer :
+       {&id_, &pdgcode_, &charge_, &coll_per_part_, &proc_id_origin_,
+        &proc_type_origin_, &pdg_mother1_, &pdg_mother2_, &baryon_number_,
+        &strangeness_}) {
+    bytes += buffer->capacity() * sizeof(int);
+  }
+  for (const std::vector<double> *buffer :
+       {&formation_time_, &time_last_collision_, &p0_, &px_, &py_, &pz_, &t_,
+        &x_, &y_, &z_, &xsec_factor_}) {
+    bytes += buffer->capacity() * sizeof(double);
+  }
+  return bytes;
+}
+
 template <typename T>
 void RootOutput::particles_to_tree(T &particles) {
   int i = 0;
@@ -503,59 +548,39 @@ void RootOutput::particles_to_tree(T &particles) {
   ev_ = current_event_;
   ens_ = current_ensemble_;
   tcounter_ = output_counter_;
-  bool exceeded_buffer_message = true;
+  ensure_buffer_size(particles.size());
 
   for (const auto &p : particles) {
-    // Buffer full - flush to tree, else fill with particles
-    if (i >= max_buffer_size_) {
-      if (exceeded_buffer_message) {
-        logg[LOutput].warn()
-            << "\nThe number of particles N = " << particles.size()
-            << " exceeds the maximum buffer size B = " << max_buffer_size_
-            << ".\nceil(N/B) = "
-            << std::ceil(particles.size() /
-                         static_cast<double>(max_buffer_size_))
-            << " separate ROOT Tree entries will be created at this output."
-            << "\nMaximum buffer size (max_buffer_size_) can be changed in "
-            << "rootoutput.h\n\n";
-        exceeded_buffer_message = false;
-      }
-      npart_ = max_buffer_size_;
-      i = 0;
-      particles_tree_->Fill();
-    } else {
-      id_[i] = p.id();
-      pdgcode_[i] = p.pdgcode().get_decimal();
-      charge_[i] = p.type().charge();
-      formation_time_[i] = p.formation_time();
-      time_last_collision_[i] = p.get_history().time_last_collision;
+    id_[i] = p.id();
+    pdgcode_[i] = p.pdgcode().get_decimal();
+    charge_[i] = p.type().charge();
+    formation_time_[i] = p.formation_time();
+    time_last_collision_[i] = p.get_history().time_last_collision;
+
+    p0_[i] = p.momentum().x0();
+    px_[i] = p.momentum().x1();
+    py_[i] = p.momentum().x2();
+    pz_[i] = p.momentum().x3();
+
+    t_[i] = p.position().x0();
+    x_[i] = p.position().x1();
+    y_[i] = p.position().x2();
+    z_[i] = p.position().x3();
 
-      p0_[i] = p.momentum().x0();
-      px_[i] = p.momentum().x1();
-      py_[i] = p.momentum().x2();
-      pz_[i] = p.momentum().x3();
-
-      t_[i] = p.position().x0();
-      x_[i] = p.position().x1();
-      y_[i] = p.position().x2();
-      z_[i] = p.position().x3();
-
-      if (part_extended_ || ic_extended_) {
-        const auto h = p.get_history();
-        coll_per_part_[i] = h.collisions_per_particle;
-        xsec_factor_[i] = p.xsec_scaling_factor();
-        proc_id_origin_[i] = h.id_process;
-        proc_type_origin_[i] = static_cast<int>(h.process_type);
-        pdg_mother1_[i] = h.p1.get_decimal();
-        pdg_mother2_[i] = h.p2.get_decimal();
-        baryon_number_[i] = p.type().baryon_number();
-        strangeness_[i] = p.type().strangeness();
-      }
-
-      i++;
+    if (part_extended_ || ic_extended_) {
+      const auto h = p.get_history();
+      coll_per_part_[i] = h.collisions_per_particle;
+      xsec_factor_[i] = p.xsec_scaling_factor();
+      proc_id_origin_[i] = h.id_process;
+      proc_type_origin_[i] = static_cast<int>(h.process_type);
+      pdg_mother1_[i] = h.p1.get_decimal();
+      pdg_mother2_[i] = h.p2.get_decimal();
+      baryon_number_[i] = p.type().baryon_number();
+      strangeness_[i] = p.type().strangeness();
     }
+
+    i++;
   }
-  // Flush rest to tree
   if (i > 0) {
     npart_ = i;
     particles_tree_->Fill();
@@ -575,11 +600,7 @@ void RootOutput::collisions_to_tree(const ParticleList &incoming,
   par_wgt_ = partial_weight;
 
   int i = 0;
-
-  /* It is assumed that nin + nout < max_buffer_size_
-   * This is true for any possible reaction for current buffer size
-   * But if one wants initial/final particles written to collisions
-   * then implementation should be updated. */
+  ensure_buffer_size(npart_);
 
   for (const ParticleList &plist : {incoming, outgoing}) {
     for (const auto &p : plist) {
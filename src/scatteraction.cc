@@ -21,6 +21,8 @@
 #include "smash/pdgcode.h"
 #include "smash/pow.h"
 #include "smash/random.h"
+#include "smash/tabulation.h"
+#include "smash/workloadrecorder.h"
 
 namespace smash {
 static constexpr int LScatterAction = LogArea::ScatterAction::id;
@@ -56,6 +58,7 @@ void ScatterAction::add_collisions(CollisionBranchList pv) {
 
 void ScatterAction::generate_final_state() {
   logg[LScatterAction].debug("Incoming particles: ", incoming_particles_);
+  add_deferred_scatterings();
 
   const CollisionBranch *proc = choose_channel<CollisionBranch>(
       collision_channels_, is_total_parametrized_
@@ -279,7 +282,7 @@ ParticleTypePtr ScatterAction::try_find_pseudoresonance(
   }
 
   // If this list is empty, there are no possible pseudo-resonances.
-  ParticleTypePtrList list = list_possible_resonances(type_a, type_b);
+  const ParticleTypePtrSpan list = list_possible_resonances(type_a, type_b);
   if (std::empty(list)) {
     return {};
   }
@@ -304,6 +307,26 @@ ParticleTypePtr ScatterAction::try_find_pseudoresonance(
   }
 }
 
+void ScatterAction::add_all_scatterings_when_needed(
+    const ScatterActionsFinderParameters &finder_parameters) {
+  if (!is_total_parametrized_ || were_processes_added_ ||
+      deferred_finder_parameters_) {
+    throw std::logic_error(
+        "Adding scatterings later is only possible once for ScatterAction "
+        "instances with parametrized cross section.");
+  }
+  deferred_finder_parameters_ = &finder_parameters;
+}
+
+void ScatterAction::add_deferred_scatterings() {
+  if (deferred_finder_parameters_) {
+    const ScatterActionsFinderParameters &finder_parameters =
+        *deferred_finder_parameters_;
+    deferred_finder_parameters_ = nullptr;
+    add_all_scatterings(finder_parameters);
+  }
+}
+
 void ScatterAction::set_parametrized_total_cross_section(
     const ScatterActionsFinderParameters &finder_parameters) {
   CrossSections xs(incoming_particles_, sqrt_s(),
@@ -363,12 +386,14 @@ double ScatterAction::relative_velocity() const {
                             incoming_particles()[1].momentum().x0());
 }
 
-double ScatterAction::transverse_distance_sqr() const {
+double ScatterAction::transverse_distance_sqr(const ParticleData &in_part_a,
+                                              const ParticleData &in_part_b) {
   // local copy of particles (since we need to boost them)
-  ParticleData p_a = incoming_particles_[0];
-  ParticleData p_b = incoming_particles_[1];
+  ParticleData p_a = in_part_a;
+  ParticleData p_b = in_part_b;
   /* Boost particles to center-of-momentum frame. */
-  const ThreeVector velocity = beta_cm();
+  const ThreeVector velocity =
+      (in_part_a.momentum() + in_part_b.momentum()).velocity();
   p_a.boost(velocity);
   p_b.boost(velocity);
   const ThreeVector pos_diff =
@@ -376,7 +401,7 @@ double ScatterAction::transverse_distance_sqr() const {
   const ThreeVector mom_diff =
       p_a.momentum().threevec() - p_b.momentum().threevec();
 
-  logg[LScatterAction].debug("Particle ", incoming_particles_,
+  logg[LScatterAction].debug("Particle ", ParticleList{in_part_a, in_part_b},
                              " position difference [fm]: ", pos_diff,
                              ", momentum difference [GeV]: ", mom_diff);
 
@@ -399,11 +424,8 @@ double ScatterAction::transverse_distance_sqr() const {
   return result > 0.0 ? result : 0.0;
 }
 
-double ScatterAction::cov_transverse_distance_sqr() const {
-  // local copy of particles (since we need to boost them)
-  ParticleData p_a = incoming_particles_[0];
-  ParticleData p_b = incoming_particles_[1];
-
+double ScatterAction::cov_transverse_distance_sqr(const ParticleData &p_a,
+                                                  const ParticleData &p_b) {
   const FourVector delta_x = p_a.position() - p_b.position();
   const double mom_diff_sqr =
       (p_a.momentum().threevec() - p_b.momentum().threevec()).sqr();
@@ -440,6 +462,43 @@ static double high_energy_bpp(double plab) {
   return 7.6 + 0.66 * std::log(mandelstam_s);
 }
 
+/**
+ * Computes the B coefficients of the Cugnon parametrization of the angular
+ * distribution in elastic pp scattering below 2 GeV, see Cugnon_bpp.
+ *
+ * \param[in] plab Lab momentum in GeV.
+ *
+ * \return B coefficients of low-energy elastic proton-proton scatterings.
+ */
+static double low_energy_bpp(double plab) {
+  double p8 = pow_int(plab, 8);
+  return 5.5 * p8 / (7.7 + p8);
+}
+
+/**
+ * The smooth parts of the B coefficients of elastic pp scatterings,
+ * low_energy_bpp and high_energy_bpp, tabulated over the lab momentum, such
+ * that the tables do not interpolate across the kinks of the
+ * parametrizations. The absolute deviation from the formulas is below
+ * \f$10^{-6}\f$ GeV\f$^{-2}\f$.
+ */
+struct CugnonSlopes {
+  /// Largest tabulated lab momentum [GeV], above the formulas are evaluated
+  static constexpr double plab_max = 10.;
+  /// low_energy_bpp up to 2 GeV, in steps of 2 MeV
+  Tabulation low{0., 2., 1000, low_energy_bpp};
+  /// high_energy_bpp from 2 GeV up to plab_max, in steps of 5 MeV
+  Tabulation high{2., plab_max - 2., 1600, high_energy_bpp};
+};
+
+/**
+ * \return The tabulated slopes, which are created at the first call.
+ */
+static const CugnonSlopes &cugnon_slopes() {
+  static const CugnonSlopes slopes;
+  return slopes;
+}
+
 /**
  * Computes the B coefficients from the Cugnon parametrization of the angular
  * distribution in elastic pp scattering.
@@ -448,16 +507,20 @@ static double high_energy_bpp(double plab) {
  * Note: The original Cugnon parametrization is only applicable for
  * plab < 6 GeV and keeps rising above that.
  *
+ * The smooth parts are interpolated from CugnonSlopes.
+ *
  * \param[in] plab Lab momentum in GeV.
  *
  * \return Cugnon B coefficient for elastic proton-proton scatterings.
  */
 static double Cugnon_bpp(double plab) {
   if (plab < 2.) {
-    double p8 = pow_int(plab, 8);
-    return 5.5 * p8 / (7.7 + p8);
+    return cugnon_slopes().low.get_value_linear(plab);
   } else {
-    return std::min(high_energy_bpp(plab), 5.334 + 0.67 * (plab - 2.));
+    const double high = plab < CugnonSlopes::plab_max
+                            ? cugnon_slopes().high.get_value_linear(plab)
+                            : high_energy_bpp(plab);
+    return std::min(high, 5.334 + 0.67 * (plab - 2.));
   }
 }
 
@@ -671,8 +734,9 @@ void ScatterAction::resonance_formation() {
 /* This function generates the outgoing state when
  * ScatterAction::string_excitation() is used */
 
-void ScatterAction::create_string_final_state() {
-  outgoing_particles_ = string_process_->get_final_state();
+void ScatterAction::create_string_final_state(
+    const StringProcess &string_process) {
+  outgoing_particles_ = string_process.get_final_state();
   assign_formation_time_to_outgoing_particles();
   /* Check momentum difference for debugging */
   FourVector out_mom;
@@ -692,8 +756,16 @@ void ScatterAction::string_excitation() {
   // Disable floating point exception trap for Pythia
   {
     DisableFloatTraps guard;
-    /* initialize the string_process_ object for this particular collision */
-    string_process_->init(incoming_particles_, time_of_execution_);
+    // The string process may be shared by several threads
+    const StringProcess::Lease string_process = string_process_->checkout();
+    if (string_process_->is_concurrent()) {
+      string_process->init_pythia_hadron_rndm();
+    }
+    /* initialize the string_process object for this particular collision */
+    string_process->init(incoming_particles_, time_of_execution_);
+    if (WorkloadRecorder *recorder = WorkloadRecorder::active()) {
+      recorder->record_string(incoming_particles_, process_type_);
+    }
     /* implement collision */
     bool success = false;
     int ntry = 0;
@@ -703,26 +775,26 @@ void ScatterAction::string_excitation() {
       switch (process_type_) {
         case ProcessType::StringSoftSingleDiffractiveAX:
           /* single diffractive to A+X */
-          success = string_process_->next_SDiff(true);
+          success = string_process->next_SDiff(true);
           break;
         case ProcessType::StringSoftSingleDiffractiveXB:
           /* single diffractive to X+B */
-          success = string_process_->next_SDiff(false);
+          success = string_process->next_SDiff(false);
           break;
         case ProcessType::StringSoftDoubleDiffractive:
           /* double diffractive */
-          success = string_process_->next_DDiff();
+          success = string_process->next_DDiff();
           break;
         case ProcessType::StringSoftNonDiffractive:
           /* soft non-diffractive */
-          success = string_process_->next_NDiffSoft();
+          success = string_process->next_NDiffSoft();
           break;
         case ProcessType::StringSoftAnnihilation:
           /* soft BBbar 2 mesonic annihilation */
-          success = string_process_->next_BBbarAnn();
+          success = string_process->next_BBbarAnn();
           break;
         case ProcessType::StringHard:
-          success = string_process_->next_NDiffHard();
+          success = string_process->next_NDiffHard();
           break;
         default:
           logg[LPythia].error("Unknown string process required.");
@@ -753,14 +825,14 @@ void ScatterAction::string_excitation() {
       while (!success_newtry && ntry_new < ntry_max) {
         ntry_new++;
         if (is_BBbar_Pair) {
-          success_newtry = string_process_->next_BBbarAnn();
+          success_newtry = string_process->next_BBbarAnn();
         } else {
-          success_newtry = string_process_->next_DDiff();
+          success_newtry = string_process->next_DDiff();
         }
       }
 
       if (success_newtry) {
-        create_string_final_state();
+        create_string_final_state(*string_process);
       }
 
       if (!success_newtry) {
@@ -776,7 +848,7 @@ void ScatterAction::string_excitation() {
         elastic_scattering();
       }
     } else {
-      create_string_final_state();
+      create_string_final_state(*string_process);
     }
   }
 }
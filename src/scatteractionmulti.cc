@@ -11,13 +11,11 @@
 
 #include <map>
 
-#include "gsl/gsl_sf_ellint.h"
-
 #include "smash/crosssections.h"
 #include "smash/integrate.h"
 #include "smash/logging.h"
 #include "smash/parametrizations.h"
-#include "smash/pow.h"
+#include "smash/threebodyintegraltable.h"
 
 namespace smash {
 static constexpr int LScatterActionMulti = LogArea::ScatterActionMulti::id;
@@ -413,33 +411,16 @@ void ScatterActionMulti::generate_final_state() {
 }
 
 double ScatterActionMulti::calculate_I3(const double sqrts) const {
-  const double m1 = incoming_particles_[0].type().mass();
-  const double m2 = incoming_particles_[1].type().mass();
-  const double m3 = incoming_particles_[2].type().mass();
+  return three_body_integral(sqrts, incoming_particles_[0].type().mass(),
+                             incoming_particles_[1].type().mass(),
+                             incoming_particles_[2].type().mass());
+}
 
-  if (sqrts < m1 + m2 + m3) {
-    return 0.0;
-  }
-  const double x1 = (m1 - m2) * (m1 - m2), x2 = (m1 + m2) * (m1 + m2),
-               x3 = (sqrts - m3) * (sqrts - m3),
-               x4 = (sqrts + m3) * (sqrts + m3);
-  const double qmm = x3 - x1, qmp = x3 - x2, qpm = x4 - x1, qpp = x4 - x2;
-  const double kappa = std::sqrt(qpm * qmp / (qpp * qmm));
-  const double tmp = std::sqrt(qmm * qpp);
-  const double c1 =
-      4.0 * m1 * m2 * std::sqrt(qmm / qpp) * (x4 - m3 * sqrts + m1 * m2);
-  const double c2 = 0.5 * (m1 * m1 + m2 * m2 + m3 * m3 + sqrts * sqrts) * tmp;
-  const double c3 = 8 * m1 * m2 / tmp *
-                    ((m1 * m1 + m2 * m2) * (m3 * m3 + sqrts * sqrts) -
-                     2 * m1 * m1 * m2 * m2 - 2 * m3 * m3 * sqrts * sqrts);
-  const double c4 =
-      -8 * m1 * m2 / tmp * smash::pow_int(sqrts * sqrts - m3 * m3, 2);
-  const double res =
-      c1 * gsl_sf_ellint_Kcomp(kappa, GSL_PREC_DOUBLE) +
-      c2 * gsl_sf_ellint_Ecomp(kappa, GSL_PREC_DOUBLE) +
-      c3 * gsl_sf_ellint_Pcomp(kappa, -qmp / qmm, GSL_PREC_DOUBLE) +
-      c4 * gsl_sf_ellint_Pcomp(kappa, -x1 * qmp / (x2 * qmm), GSL_PREC_DOUBLE);
-  return res;
+double ScatterActionMulti::tabulated_I3(const double sqrts) const {
+  return ThreeBodyIntegralTable::find(incoming_particles_[0].type().mass(),
+                                      incoming_particles_[1].type().mass(),
+                                      incoming_particles_[2].type().mass())(
+      sqrts);
 }
 
 double ScatterActionMulti::probability_three_to_one(
@@ -454,7 +435,7 @@ double ScatterActionMulti::probability_three_to_one(
       sqrts, {&incoming_particles_[0].type(), &incoming_particles_[1].type(),
               &incoming_particles_[2].type()});
 
-  const double I_3 = calculate_I3(sqrts);
+  const double I_3 = tabulated_I3(sqrts);
   const double ph_sp_3 =
       1. / (8 * M_PI * M_PI * M_PI) * 1. / (16 * sqrts * sqrts) * I_3;
 
@@ -479,7 +460,7 @@ double ScatterActionMulti::probability_three_to_two(
       CrossSections::two_to_three_xs(type_out1, type_out2, sqrts) / gev2_mb;
   const double lamb = lambda_tilde(sqrts * sqrts, m4 * m4, m5 * m5);
 
-  const double I_3 = calculate_I3(sqrts);
+  const double I_3 = tabulated_I3(sqrts);
   const double ph_sp_3 =
       1. / (8 * M_PI * M_PI * M_PI) * 1. / (16 * sqrts * sqrts) * I_3;
 
@@ -23,6 +23,8 @@
 namespace smash {
 static constexpr int LScatterAction = LogArea::ScatterAction::id;
 
+bool ScatterActionPhoton::tabulated_cross_sections_ = false;
+
 ScatterActionPhoton::ScatterActionPhoton(
     const ParticleList &in, const double time, const int n_frac_photons,
     const double hadronic_cross_section_input,
@@ -89,14 +91,26 @@ ScatterActionPhoton::ReactionType ScatterActionPhoton::photon_reaction_type(
 }
 
 void ScatterActionPhoton::perform_photons(const OutputsList &outputs) {
-  for (int i = 0; i < number_of_fractional_photons_; i++) {
-    generate_final_state();
+  auto write_photon = [&]() {
     for (const auto &output : outputs) {
       if (output->is_photon_output()) {
         // we do not care about the local density
         output->at_interaction(*this, 0.0);
       }
     }
+  };
+  if (number_of_fractional_photons_ < 1) {
+    return;
+  }
+  // The first photon puts the pion first, which all others rely on
+  generate_final_state();
+  write_photon();
+  if (number_of_fractional_photons_ > 1) {
+    const Kinematics shared = kinematics(get_interaction_point());
+    for (int i = 1; i < number_of_fractional_photons_; i++) {
+      sample_photon(shared);
+      write_photon();
+    }
   }
 }
 
@@ -196,10 +210,7 @@ void ScatterActionPhoton::generate_final_state() {
         << "Problem in ScatterActionPhoton::generate_final_state().\n";
     throw std::runtime_error("");
   }
-  auto *proc = collision_processes_photons_[0].get();
-
-  outgoing_particles_ = proc->particle_list();
-  process_type_ = proc->get_type();
+  outgoing_particles_ = collision_processes_photons_[0]->particle_list();
 
   FourVector middle_point = get_interaction_point();
 
@@ -211,21 +222,49 @@ void ScatterActionPhoton::generate_final_state() {
   if (!incoming_particles_[0].pdgcode().is_pion()) {
     std::swap(incoming_particles_[0], incoming_particles_[1]);
   }
+  sample_photon(kinematics(middle_point));
+}
 
+ScatterActionPhoton::Kinematics ScatterActionPhoton::kinematics(
+    const FourVector &middle_point) const {
   // 2->2 inelastic scattering
-  // Sample the particle momenta in CM system
   const double m1 = incoming_particles_[0].effective_mass();
   const double m2 = incoming_particles_[1].effective_mass();
 
   const double &m_out = hadron_out_mass_;
 
-  const double s = mandelstam_s();
   const double sqrts = sqrt_s();
   std::array<double, 2> mandelstam_t = get_t_range(sqrts, m1, m2, m_out, 0.0);
-  const double t1 = mandelstam_t[1];
-  const double t2 = mandelstam_t[0];
-  const double pcm_in = cm_momentum();
-  const double pcm_out = pCM(sqrts, m_out, 0.0);
+  return {middle_point,
+          m1,
+          m2,
+          mandelstam_s(),
+          sqrts,
+          mandelstam_t[1],
+          mandelstam_t[0],
+          cm_momentum(),
+          pCM(sqrts, m_out, 0.0),
+          LorentzBoost(-total_momentum_of_outgoing_particles().velocity())};
+}
+
+void ScatterActionPhoton::sample_photon(const Kinematics &k) {
+  auto *proc = collision_processes_photons_[0].get();
+
+  outgoing_particles_ = proc->particle_list();
+  process_type_ = proc->get_type();
+
+  // Sample the particle momenta in CM system
+  const double m1 = k.m1;
+  const double m2 = k.m2;
+
+  const double &m_out = hadron_out_mass_;
+
+  const double s = k.s;
+  const double sqrts = k.sqrts;
+  const double t1 = k.t1;
+  const double t2 = k.t2;
+  const double pcm_in = k.pcm_in;
+  const double pcm_out = k.pcm_out;
 
   const double t = random::uniform(t1, t2);
 
@@ -253,9 +292,8 @@ void ScatterActionPhoton::generate_final_state() {
 
   // Set positions & boost to computational frame.
   for (ParticleData &new_particle : outgoing_particles_) {
-    new_particle.set_4position(middle_point);
-    new_particle.boost_momentum(
-        -total_momentum_of_outgoing_particles().velocity());
+    new_particle.set_4position(k.middle_point);
+    new_particle.boost_momentum(k.to_computational_frame);
   }
   // Set unpolarized spin vector for outgoing particles
   if (spin_interaction_type_ != SpinInteractionType::Off) {
@@ -354,8 +392,16 @@ CollisionBranchList ScatterActionPhoton::create_collision_branch() {
 }
 
 double ScatterActionPhoton::total_cross_section(MediatorType mediator) const {
+  return tabulated_cross_sections_
+             ? total_cross_section_by<ComputationMethod::Lookup>(mediator)
+             : total_cross_section_by<ComputationMethod::Analytic>(mediator);
+}
+
+template <ComputationMethod method>
+double ScatterActionPhoton::total_cross_section_by(
+    MediatorType mediator) const {
   CollisionBranchList process_list;
-  CrosssectionsPhoton<ComputationMethod::Analytic> xs_object;
+  CrosssectionsPhoton<method> xs_object;
 
   const double s = mandelstam_s();
   // the mass of the mediating particle depends on the channel. For an incoming
@@ -508,10 +554,21 @@ double ScatterActionPhoton::total_cross_section_w_ff(const double E_photon) {
 double ScatterActionPhoton::diff_cross_section(const double t,
                                                const double m_rho,
                                                MediatorType mediator) const {
+  return tabulated_cross_sections_
+             ? diff_cross_section_by<ComputationMethod::Lookup>(t, m_rho,
+                                                                mediator)
+             : diff_cross_section_by<ComputationMethod::Analytic>(t, m_rho,
+                                                                  mediator);
+}
+
+template <ComputationMethod method>
+double ScatterActionPhoton::diff_cross_section_by(const double t,
+                                                  const double m_rho,
+                                                  MediatorType mediator) const {
   const double s = mandelstam_s();
   double diff_xsection = 0.0;
 
-  CrosssectionsPhoton<ComputationMethod::Analytic> xs_object;
+  CrosssectionsPhoton<method> xs_object;
 
   switch (reac_) {
     case ReactionType::pi_p_pi_m_rho_z:
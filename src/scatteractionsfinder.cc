@@ -10,13 +10,25 @@
 #include "smash/scatteractionsfinder.h"
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "smash/constants.h"
+#include "smash/crosssections.h"
 #include "smash/decaymodes.h"
+#include "smash/kinematics.h"
 #include "smash/logging.h"
 #include "smash/parametrizations.h"
+#include "smash/particles.h"
+#include "smash/potential_globals.h"
 #include "smash/scatteraction.h"
 #include "smash/scatteractionmulti.h"
 #include "smash/scatteractionphoton.h"
@@ -24,6 +36,18 @@
 
 namespace smash {
 static constexpr int LFindScatter = LogArea::FindScatter::id;
+
+/**
+ * \return Whether the cross sections of the particle only depend on its type
+ * and \f$\sqrt{s}\f$, as for stable particles with their pole masses, such
+ * that they can be estimated with the cross section cache.
+ *
+ * \param[in] data The particle
+ */
+static bool has_tabulated_cross_sections(const ParticleData& data) {
+  return data.type().is_stable() &&
+         std::abs(data.effective_mass() - data.pole_mass()) <= really_small;
+}
 /*!\Userguide
  * \page doxypage_input_conf_ct_string_parameters
  *
@@ -36,8 +60,76 @@ ScatterActionsFinder::ScatterActionsFinder(
     : finder_parameters_(config, parameters),
       isotropic_(config.take(InputKeys::collTerm_isotropic)),
       box_length_(parameters.box_length),
+      lazy_wall_crossings_(parameters.lazy_wall_crossings &&
+                           parameters.box_length > 0.),
       string_formation_time_(
           config.take(InputKeys::collTerm_stringParam_formationTime)) {
+  const bool use_xs_cache = config.take(InputKeys::collTerm_crossSectionCache);
+  const double xs_cache_tolerance =
+      config.take(InputKeys::collTerm_crossSectionCacheTolerance);
+  if (use_xs_cache) {
+    xs_cache_ = std::make_unique<CrossSectionCache>(
+        xs_cache_tolerance,
+        [this](const ParticleType& type_a, const ParticleType& type_b,
+               double sqrts) {
+          return total_cross_section(type_a, type_b, sqrts);
+        },
+        [this](const ParticleType& type_a, const ParticleType& type_b,
+               const std::vector<double>& sqrts, std::vector<double>& xs) {
+          total_cross_sections(type_a, type_b, sqrts, xs);
+        },
+        CrossSectionCache::default_sqrts_spacing,
+        CrossSectionCache::default_number_of_nodes, true);
+    logg[LFindScatter].info(
+        "Rejecting candidate pairs with tabulated cross sections, tolerance ",
+        xs_cache_tolerance, ".");
+  }
+  const std::string xs_table =
+      config.take(InputKeys::collTerm_crossSectionTable);
+  if (!xs_table.empty() && !xs_cache_) {
+    throw std::invalid_argument(
+        "The cross section table needs the cross section cache.");
+  }
+  dynamic_cell_size_ = config.take(InputKeys::collTerm_dynamicCellSize);
+  dynamic_cell_size_safety_factor_ =
+      config.take(InputKeys::collTerm_dynamicCellSizeSafetyFactor);
+  if (dynamic_cell_size_ && !xs_cache_) {
+    throw std::invalid_argument(
+        "The dynamic cell size needs the cross section cache.");
+  }
+  if (!(dynamic_cell_size_safety_factor_ >= 1.)) {
+    throw std::invalid_argument(
+        "The safety factor of the dynamic cell size must be at least 1.");
+  }
+  stochastic_thinning_ = config.take(InputKeys::collTerm_stochasticThinning);
+  if (stochastic_thinning_ && !xs_cache_) {
+    throw std::invalid_argument(
+        "The stochastic thinning needs the cross section cache.");
+  }
+  // The pairs are checked without branching on the configuration of the run
+  auto pair_check = [this](auto criterion) {
+    constexpr CollisionCriterion crit = decltype(criterion)::value;
+    return finder_parameters_.allow_collisions_within_nucleus
+               ? &ScatterActionsFinder::check_pair<crit, true>
+               : &ScatterActionsFinder::check_pair<crit, false>;
+  };
+  switch (finder_parameters_.coll_crit) {
+    case CollisionCriterion::Geometric:
+      check_pair_ = pair_check(std::integral_constant<
+                               CollisionCriterion,
+                               CollisionCriterion::Geometric>{});
+      break;
+    case CollisionCriterion::Covariant:
+      check_pair_ = pair_check(std::integral_constant<
+                               CollisionCriterion,
+                               CollisionCriterion::Covariant>{});
+      break;
+    case CollisionCriterion::Stochastic:
+      check_pair_ = pair_check(std::integral_constant<
+                               CollisionCriterion,
+                               CollisionCriterion::Stochastic>{});
+      break;
+  }
   if (is_constant_elastic_isotropic()) {
     logg[LFindScatter].info(
         "Constant elastic isotropic cross-section mode:", " using ",
@@ -124,6 +216,33 @@ ScatterActionsFinder::ScatterActionsFinder(
         config.take(InputKeys::collTerm_stringParam_popcornRate),
         config.take(InputKeys::collTerm_stringParam_useMonashTune,
                     parameters.use_monash_tune_default.value()));
+    string_process_interface_->set_tabulate_diffractive(
+        config.take(InputKeys::collTerm_stringParam_tabulateDiffractive));
+    StringProcess::set_tabulated_lund_z(
+        config.take(InputKeys::collTerm_stringParam_tabulatedLundZ));
+    const std::vector<std::vector<PdgCode>> preinitialized_pairs =
+        config.take(InputKeys::collTerm_stringParam_preinitializedPairs);
+    const double preinitialization_sqrts =
+        config.take(InputKeys::collTerm_stringParam_preinitializationSqrts);
+    std::vector<std::pair<PdgCode, PdgCode>> pairs;
+    for (const std::vector<PdgCode> &pair : preinitialized_pairs) {
+      if (pair.size() != 2) {
+        throw std::invalid_argument(
+            "Every entry of \"Preinitialized_Pairs\" has to be a list of two "
+            "PDG codes.");
+      }
+      pairs.emplace_back(pair[0], pair[1]);
+    }
+    if (!pairs.empty()) {
+      string_process_interface_->preinitialize_hard_pythia(
+          pairs, preinitialization_sqrts);
+    }
+  }
+  // The tables are compared to the cross sections, which need the strings
+  if (!xs_table.empty()) {
+    const std::size_t n_tables = xs_cache_->read(xs_table);
+    logg[LFindScatter].info("Read the cross sections of ", n_tables,
+                            " pairs of particle types from ", xs_table, ".");
   }
 }
 
@@ -214,55 +333,192 @@ ScatterActionsFinderParameters::ScatterActionsFinderParameters(
   }
 }
 
-ActionPtr ScatterActionsFinder::check_collision_two_part(
-    const ParticleData& data_a, const ParticleData& data_b, double dt,
-    const std::vector<FourVector>& beam_momentum,
-    const double gcell_vol) const {
-  /* If the two particles
-   * 1) belong to one of the two colliding nuclei, and
-   * 2) both of them have never experienced any collisions,
-   * then the collisions between them are banned. */
-  if (!finder_parameters_.allow_collisions_within_nucleus) {
-    assert(data_a.id() >= 0);
-    assert(data_b.id() >= 0);
-    bool in_same_nucleus = (data_a.belongs_to() == BelongsTo::Projectile &&
-                            data_b.belongs_to() == BelongsTo::Projectile) ||
-                           (data_a.belongs_to() == BelongsTo::Target &&
-                            data_b.belongs_to() == BelongsTo::Target);
-    bool never_interacted_before =
-        data_a.get_history().collisions_per_particle == 0 &&
-        data_b.get_history().collisions_per_particle == 0;
-    if (in_same_nucleus && never_interacted_before) {
-      return nullptr;
-    }
+bool ScatterActionsFinder::is_total_parametrized(
+    const ParticleType& type_a, const ParticleType& type_b) const {
+  if (finder_parameters_.total_xs_strategy ==
+      TotalCrossSectionStrategy::TopDownMeasured) {
+    return parametrization_exists(type_a.pdgcode(), type_b.pdgcode());
   }
+  return finder_parameters_.total_xs_strategy ==
+         TotalCrossSectionStrategy::TopDown;
+}
 
-  // No grid or search in cell means no collision for stochastic criterion
-  if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic &&
-      gcell_vol < really_small) {
-    return nullptr;
+double ScatterActionsFinder::total_cross_section(const ParticleType& type_a,
+                                                 const ParticleType& type_b,
+                                                 double sqrts) const {
+  ParticleData data_a{type_a}, data_b{type_b};
+  const double p_cm = pCM(sqrts, type_a.mass(), type_b.mass());
+  data_a.set_4momentum(type_a.mass(), 0., 0., p_cm);
+  data_b.set_4momentum(type_b.mass(), 0., 0., -p_cm);
+  const bool incoming_parametrized = is_total_parametrized(type_a, type_b);
+  ScatterAction act(data_a, data_b, 0., isotropic_, string_formation_time_,
+                    box_length_, incoming_parametrized,
+                    finder_parameters_.spin_interaction_type);
+  if (finder_parameters_.strings_switch) {
+    act.set_string_interface(string_process_interface_.get());
   }
+  if (incoming_parametrized) {
+    act.set_parametrized_total_cross_section(finder_parameters_);
+  } else {
+    act.add_all_scatterings(finder_parameters_);
+  }
+  return act.cross_section();
+}
 
-  // Determine time of collision.
-  const double time_until_collision =
-      collision_time(data_a, data_b, dt, beam_momentum);
+void ScatterActionsFinder::total_cross_sections(
+    const ParticleType& type_a, const ParticleType& type_b,
+    const std::vector<double>& sqrts, std::vector<double>& xs) const {
+  if (is_total_parametrized(type_a, type_b)) {
+    xs = CrossSections::parametrized_total(type_a, type_b, sqrts,
+                                           finder_parameters_);
+    return;
+  }
+  // The partial cross sections depend on the channels open at every energy
+  xs.resize(sqrts.size());
+  for (std::size_t i = 0; i < sqrts.size(); i++) {
+    xs[i] = total_cross_section(type_a, type_b, sqrts[i]);
+  }
+}
 
-  // Check that collision happens in this timestep.
-  if (time_until_collision < 0. || time_until_collision >= dt) {
-    return nullptr;
+std::optional<double> ScatterActionsFinder::cross_section_upper_bound(
+    const ParticleData& data_a, const ParticleData& data_b,
+    double time_until_collision) const {
+  // Potentials change the thresholds of the cross sections
+  if (UB_lat_pointer != nullptr || UI3_lat_pointer != nullptr) {
+    return std::nullopt;
+  }
+  if (!has_tabulated_cross_sections(data_a) ||
+      !has_tabulated_cross_sections(data_b)) {
+    return std::nullopt;
+  }
+  const double sqrts = (data_a.momentum() + data_b.momentum()).abs();
+  const std::optional<double> xs_bound =
+      xs_cache_->upper_bound(data_a.type(), data_b.type(), sqrts);
+  if (!xs_bound) {
+    return std::nullopt;
   }
+  return *xs_bound * fm2_mb /
+         static_cast<double>(finder_parameters_.testparticles) *
+         data_a.xsec_scaling_factor(time_until_collision) *
+         data_b.xsec_scaling_factor(time_until_collision);
+}
 
-  // Determine which total cross section to use
-  bool incoming_parametrized = (finder_parameters_.total_xs_strategy ==
-                                TotalCrossSectionStrategy::TopDown);
-  if (finder_parameters_.total_xs_strategy ==
-      TotalCrossSectionStrategy::TopDownMeasured) {
-    const PdgCode& pdg_a = data_a.type().pdgcode();
-    const PdgCode& pdg_b = data_b.type().pdgcode();
-    incoming_parametrized = parametrization_exists(pdg_a, pdg_b);
+std::optional<double> ScatterActionsFinder::max_cross_section_bound(
+    const std::vector<const ParticleData*>& particles) const {
+  // Potentials change the thresholds of the cross sections
+  if (UB_lat_pointer != nullptr || UI3_lat_pointer != nullptr) {
+    return std::nullopt;
   }
+  // The largest values of the particles of one type
+  struct Extrema {
+    int count = 0;
+    double energy = 0.;
+    double momentum = 0.;
+    double xsec_scaling = 1.;
+  };
+  const ParticleTypeList& all_types = ParticleType::list_all();
+  std::vector<Extrema> extrema(all_types.size());
+  std::vector<std::size_t> present;
+  for (const ParticleData* data_ptr : particles) {
+    const ParticleData& data = *data_ptr;
+    if (!has_tabulated_cross_sections(data)) {
+      return std::nullopt;
+    }
+    // The types are stored contiguously in the list of all types
+    const std::size_t i = std::addressof(data.type()) - all_types.data();
+    Extrema& type_extrema = extrema[i];
+    if (type_extrema.count++ == 0) {
+      present.push_back(i);
+    }
+    type_extrema.energy = std::max(type_extrema.energy, data.momentum().x0());
+    type_extrema.momentum =
+        std::max(type_extrema.momentum, data.momentum().threevec().abs());
+    // The scaling factor approaches 1 from its initial value
+    type_extrema.xsec_scaling =
+        std::max(type_extrema.xsec_scaling, data.initial_xsec_scaling_factor());
+  }
+  double max_xs = 0.;
+  for (std::size_t k = 0; k < present.size(); k++) {
+    for (std::size_t l = k; l < present.size(); l++) {
+      const Extrema& a = extrema[present[k]];
+      const Extrema& b = extrema[present[l]];
+      if (k == l && a.count < 2) {
+        continue;
+      }
+      const ParticleType& type_a = all_types[present[k]];
+      const ParticleType& type_b = all_types[present[l]];
+      const double mass_a = type_a.mass(), mass_b = type_b.mass();
+      const double max_s = mass_a * mass_a + mass_b * mass_b +
+                           2. * (a.energy * b.energy + a.momentum * b.momentum);
+      const std::optional<double> xs_bound =
+          xs_cache_->upper_bound_up_to(type_a, type_b, std::sqrt(max_s));
+      if (!xs_bound) {
+        return std::nullopt;
+      }
+      max_xs = std::max(max_xs, *xs_bound * a.xsec_scaling * b.xsec_scaling);
+    }
+  }
+  return max_xs;
+}
 
-  // Create ScatterAction object.
+double ScatterActionsFinder::max_transverse_distance_sqr(
+    const Particles& particles) const {
+  const double maximum =
+      max_transverse_distance_sqr(finder_parameters_.testparticles);
+  if (!dynamic_cell_size_ || is_constant_elastic_isotropic()) {
+    return maximum;
+  }
+  std::vector<const ParticleData*> all_particles;
+  all_particles.reserve(particles.size());
+  for (const ParticleData& data : particles) {
+    all_particles.push_back(&data);
+  }
+  const std::optional<double> max_xs = max_cross_section_bound(all_particles);
+  if (!max_xs) {
+    return maximum;
+  }
+  return std::min(maximum, *max_xs * dynamic_cell_size_safety_factor_ /
+                               finder_parameters_.testparticles * fm2_mb *
+                               M_1_PI);
+}
+
+bool ScatterActionsFinder::is_banned_within_nucleus(
+    const ParticleData& data_a, const ParticleData& data_b) const {
+  /* If the two particles
+   * 1) belong to one of the two colliding nuclei, and
+   * 2) both of them have never experienced any collisions,
+   * then the collisions between them are banned. */
+  if (finder_parameters_.allow_collisions_within_nucleus) {
+    return false;
+  }
+  assert(data_a.id() >= 0);
+  assert(data_b.id() >= 0);
+  const BelongsTo nucleus = spectator_nucleus(data_a);
+  return nucleus != BelongsTo::Nothing && nucleus == spectator_nucleus(data_b);
+}
+
+bool ScatterActionsFinder::only_spectators_of_one_nucleus(
+    ParticleSpan search_list, ParticleSpan neighbors_list) const {
+  if (search_list.empty() ||
+      (finder_parameters_.coll_crit == CollisionCriterion::Stochastic &&
+       stochastic_thinning_)) {
+    return false;
+  }
+  const BelongsTo nucleus = spectator_nucleus(search_list[0]);
+  if (nucleus == BelongsTo::Nothing) {
+    return false;
+  }
+  auto is_spectator = [this, nucleus](const ParticleData& data) {
+    return spectator_nucleus(data) == nucleus;
+  };
+  return std::all_of(search_list.begin(), search_list.end(), is_spectator) &&
+         std::all_of(neighbors_list.begin(), neighbors_list.end(),
+                     is_spectator);
+}
+
+ScatterActionPtr ScatterActionsFinder::create_scatter_action(
+    const ParticleData& data_a, const ParticleData& data_b,
+    double time_until_collision, bool incoming_parametrized) const {
   ScatterActionPtr act = std::make_unique<ScatterAction>(
       data_a, data_b, time_until_collision, isotropic_, string_formation_time_,
       box_length_, incoming_parametrized,
@@ -276,72 +532,137 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
     act->set_string_interface(string_process_interface_.get());
   }
 
-  // Distance squared calculation not needed for stochastic criterion
-  const double distance_squared =
-      (finder_parameters_.coll_crit == CollisionCriterion::Geometric)
-          ? act->transverse_distance_sqr()
-      : (finder_parameters_.coll_crit == CollisionCriterion::Covariant)
-          ? act->cov_transverse_distance_sqr()
-          : 0.0;
-
-  // Don't calculate cross section if the particles are very far apart.
-  // Not needed for stochastic criterion because of cell structure.
-  if (finder_parameters_.coll_crit != CollisionCriterion::Stochastic &&
-      distance_squared >=
-          max_transverse_distance_sqr(finder_parameters_.testparticles)) {
-    return nullptr;
-  }
-
   if (incoming_parametrized) {
     act->set_parametrized_total_cross_section(finder_parameters_);
   } else {
     // Add various subprocesses.
     act->add_all_scatterings(finder_parameters_);
   }
+  return act;
+}
 
-  double xs = act->cross_section() * fm2_mb /
+double ScatterActionsFinder::scaled_cross_section(
+    const ScatterAction& act, double time_until_collision) const {
+  double xs = act.cross_section() * fm2_mb /
               static_cast<double>(finder_parameters_.testparticles);
 
   // Take cross section scaling factors into account
-  xs *= data_a.xsec_scaling_factor(time_until_collision);
-  xs *= data_b.xsec_scaling_factor(time_until_collision);
+  for (const ParticleData& data : act.incoming_particles()) {
+    xs *= data.xsec_scaling_factor(time_until_collision);
+  }
+  return xs;
+}
 
-  if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic) {
-    const double v_rel = act->relative_velocity();
-    /* Collision probability for 2-particle scattering, see
-     * \iref{Staudenmaier:2021lrg}. */
-    const double prob = xs * v_rel * dt / gcell_vol;
-
-    logg[LFindScatter].debug(
-        "Stochastic collison criterion parameters (2-particles):\nprob = ",
-        prob, ", xs = ", xs, ", v_rel = ", v_rel, ", dt = ", dt,
-        ", gcell_vol = ", gcell_vol,
-        ", testparticles = ", finder_parameters_.testparticles);
-
-    if (prob > 1.) {
-      std::stringstream err;
-      err << "Probability larger than 1 for stochastic rates. ( P_22 = " << prob
-          << " )\n"
-          << data_a.type().name() << data_b.type().name() << " with masses "
-          << data_a.momentum().abs() << " and " << data_b.momentum().abs()
-          << " at sqrts[GeV] = " << act->sqrt_s()
-          << " with xs[fm^2]/Ntest = " << xs
-          << "\nConsider using smaller timesteps.";
-      if (finder_parameters_.only_warn_for_high_prob) {
-        logg[LFindScatter].warn(err.str());
-      } else {
-        throw std::runtime_error(err.str());
-      }
+bool ScatterActionsFinder::stochastic_collision_sampled(
+    const ScatterAction& act, double xs, double dt, const double gcell_vol,
+    double random_no) const {
+  const double v_rel = act.relative_velocity();
+  /* Collision probability for 2-particle scattering, see
+   * \iref{Staudenmaier:2021lrg}. */
+  const double prob = xs * v_rel * dt / gcell_vol;
+
+  logg[LFindScatter].debug(
+      "Stochastic collison criterion parameters (2-particles):\nprob = ", prob,
+      ", xs = ", xs, ", v_rel = ", v_rel, ", dt = ", dt,
+      ", gcell_vol = ", gcell_vol,
+      ", testparticles = ", finder_parameters_.testparticles);
+
+  if (prob > 1.) {
+    const ParticleData& data_a = act.incoming_particles()[0];
+    const ParticleData& data_b = act.incoming_particles()[1];
+    std::stringstream err;
+    err << "Probability larger than 1 for stochastic rates. ( P_22 = " << prob
+        << " )\n"
+        << data_a.type().name() << data_b.type().name() << " with masses "
+        << data_a.momentum().abs() << " and " << data_b.momentum().abs()
+        << " at sqrts[GeV] = " << act.sqrt_s()
+        << " with xs[fm^2]/Ntest = " << xs
+        << "\nConsider using smaller timesteps.";
+    if (finder_parameters_.only_warn_for_high_prob) {
+      logg[LFindScatter].warn(err.str());
+    } else {
+      throw std::runtime_error(err.str());
+    }
+  }
+
+  // probability criterion
+  return random_no <= prob;
+}
+
+template <CollisionCriterion Criterion, bool WithinNucleus>
+ActionPtr ScatterActionsFinder::check_pair(
+    const ParticleData& data_a, const ParticleData& data_b, double dt,
+    const std::vector<FourVector>& beam_momentum,
+    const double gcell_vol) const {
+  if constexpr (!WithinNucleus) {
+    if (is_banned_within_nucleus(data_a, data_b)) {
+      return nullptr;
+    }
+  }
+
+  // No grid or search in cell means no collision for stochastic criterion
+  if constexpr (Criterion == CollisionCriterion::Stochastic) {
+    if (gcell_vol < really_small) {
+      return nullptr;
+    }
+  }
+
+  // Determine time of collision.
+  const double time_until_collision =
+      collision_time_with<Criterion>(data_a, data_b, dt, beam_momentum);
+
+  // Check that collision happens in this timestep.
+  if (time_until_collision < 0. || time_until_collision >= dt) {
+    return nullptr;
+  }
+
+  /* Distance squared calculation not needed for stochastic criterion. It is
+   * computed from the particles directly, such that no action is constructed
+   * for the many pairs which are too far apart. */
+  double distance_squared = 0.0;
+  if constexpr (Criterion == CollisionCriterion::Geometric) {
+    distance_squared = ScatterAction::transverse_distance_sqr(data_a, data_b);
+  } else if constexpr (Criterion == CollisionCriterion::Covariant) {
+    distance_squared =
+        ScatterAction::cov_transverse_distance_sqr(data_a, data_b);
+  }
+
+  // Don't calculate cross section if the particles are very far apart.
+  // Not needed for stochastic criterion because of cell structure.
+  if constexpr (Criterion != CollisionCriterion::Stochastic) {
+    if (distance_squared >=
+        max_transverse_distance_sqr(finder_parameters_.testparticles)) {
+      return nullptr;
     }
+  }
 
-    // probability criterion
-    double random_no = random::uniform(0., 1.);
-    if (random_no > prob) {
+  /* Reject the pairs which are too far apart to collide even with the cross
+   * section estimated from above, before all partial cross sections are
+   * evaluated for them. */
+  if (xs_cache_) {
+    const std::optional<double> xs_bound =
+        cross_section_upper_bound(data_a, data_b, time_until_collision);
+    if (xs_bound && distance_squared >= *xs_bound * M_1_PI) {
       return nullptr;
     }
+  }
+
+  // Determine which total cross section to use
+  const bool incoming_parametrized =
+      is_total_parametrized(data_a.type(), data_b.type());
+
+  // Create ScatterAction object.
+  ScatterActionPtr act = create_scatter_action(
+      data_a, data_b, time_until_collision, incoming_parametrized);
 
-  } else if (finder_parameters_.coll_crit == CollisionCriterion::Geometric ||
-             finder_parameters_.coll_crit == CollisionCriterion::Covariant) {
+  const double xs = scaled_cross_section(*act, time_until_collision);
+
+  if constexpr (Criterion == CollisionCriterion::Stochastic) {
+    if (!stochastic_collision_sampled(*act, xs, dt, gcell_vol,
+                                      random::uniform(0., 1.))) {
+      return nullptr;
+    }
+  } else {
     // just collided with this particle
     if (data_a.id_process() > 0 && data_a.id_process() == data_b.id_process()) {
       logg[LFindScatter].debug("Skipping collided particles at time ",
@@ -364,9 +685,10 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
                              "\n    ", data_a, "\n<-> ", data_b);
   }
 
-  // Include possible outgoing branches
+  /* Include possible outgoing branches, once the final state of the action
+   * is generated, since most found actions are never performed. */
   if (incoming_parametrized) {
-    act->add_all_scatterings(finder_parameters_);
+    act->add_all_scatterings_when_needed(finder_parameters_);
   }
 
   return act;
@@ -391,7 +713,7 @@ ActionPtr ScatterActionsFinder::check_collision_multi_part(
         });
     bool none_collided =
         std::all_of(plist.begin(), plist.end(), [&](const ParticleData& data) {
-          return data.get_history().collisions_per_particle == 0;
+          return data.collisions_per_particle() == 0;
         });
     if ((all_projectile || all_target) && none_collided) {
       return nullptr;
@@ -449,79 +771,424 @@ ActionPtr ScatterActionsFinder::check_collision_multi_part(
   return act;
 }
 
-ActionList ScatterActionsFinder::find_actions_in_cell(
-    const ParticleList& search_list, double dt, const double gcell_vol,
-    const std::vector<FourVector>& beam_momentum) const {
-  std::vector<ActionPtr> actions;
-  for (const ParticleData& p1 : search_list) {
-    for (const ParticleData& p2 : search_list) {
-      // Check for 2 particle scattering
-      if (p1.id() < p2.id()) {
-        ActionPtr act =
-            check_collision_two_part(p1, p2, dt, beam_momentum, gcell_vol);
-        if (act) {
-          actions.push_back(std::move(act));
+void ScatterActionsFinder::append_multi_particle_actions(
+    ParticleSpan search_list, double dt, const double gcell_vol,
+    ActionList& actions) const {
+  // Without a cell volume, no multi-particle reaction can happen
+  if (gcell_vol < really_small) {
+    return;
+  }
+  const MultiParticleReactionsBitSet& included =
+      finder_parameters_.included_multi;
+  const bool three_to_one =
+      included[IncludedMultiParticleReactions::Meson_3to1] == 1;
+  const bool three_to_two =
+      included[IncludedMultiParticleReactions::Deuteron_3to2] == 1;
+  const bool four_to_two =
+      included[IncludedMultiParticleReactions::A3_Nuclei_4to2] == 1;
+  const bool five_to_two =
+      included[IncludedMultiParticleReactions::NNbar_5to2] == 1;
+  /* Only pions and the eta form mesons, pions and (anti-)nucleons form
+   * (anti-)deuterons, and additionally (anti-)Lambdas form the A = 3 nuclei.
+   * NNbar is only produced from pions. */
+  std::vector<const ParticleData*> for_three, for_four, for_five;
+  for (const ParticleData& p : search_list) {
+    const PdgCode pdg = p.pdgcode();
+    const bool pion = pdg.is_pion(), nucleon = pdg.is_nucleon();
+    if ((three_to_one && (pion || pdg == pdg::eta)) ||
+        (three_to_two && (pion || nucleon))) {
+      for_three.push_back(&p);
+    }
+    if (four_to_two &&
+        (pion || nucleon || pdg == pdg::Lambda || pdg == -pdg::Lambda)) {
+      for_four.push_back(&p);
+    }
+    if (five_to_two && pion) {
+      for_five.push_back(&p);
+    }
+  }
+  auto by_id = [](const ParticleData* a, const ParticleData* b) {
+    return a->id() < b->id();
+  };
+  auto check = [&](const ParticleList& plist) {
+    ActionPtr act = check_collision_multi_part(plist, dt, gcell_vol);
+    if (act) {
+      actions.push_back(std::move(act));
+    }
+  };
+  std::sort(for_three.begin(), for_three.end(), by_id);
+  const std::size_t n3 = for_three.size();
+  for (std::size_t i = 0; i < n3; i++) {
+    for (std::size_t j = i + 1; j < n3; j++) {
+      for (std::size_t k = j + 1; k < n3; k++) {
+        check({*for_three[i], *for_three[j], *for_three[k]});
+      }
+    }
+  }
+  std::sort(for_four.begin(), for_four.end(), by_id);
+  const std::size_t n4 = for_four.size();
+  for (std::size_t i = 0; i < n4; i++) {
+    for (std::size_t j = i + 1; j < n4; j++) {
+      for (std::size_t k = j + 1; k < n4; k++) {
+        for (std::size_t l = k + 1; l < n4; l++) {
+          check({*for_four[i], *for_four[j], *for_four[k], *for_four[l]});
         }
       }
-      if (finder_parameters_.included_multi.any()) {
-        // Also, check for 3 particle scatterings with stochastic criterion
-        for (const ParticleData& p3 : search_list) {
-          if (finder_parameters_.included_multi
-                      [IncludedMultiParticleReactions::Deuteron_3to2] == 1 ||
-              finder_parameters_.included_multi
-                      [IncludedMultiParticleReactions::Meson_3to1] == 1) {
-            if (p1.id() < p2.id() && p2.id() < p3.id()) {
-              ActionPtr act =
-                  check_collision_multi_part({p1, p2, p3}, dt, gcell_vol);
-              if (act) {
-                actions.push_back(std::move(act));
-              }
-            }
+    }
+  }
+  std::sort(for_five.begin(), for_five.end(), by_id);
+  const std::size_t n5 = for_five.size();
+  for (std::size_t i = 0; i < n5; i++) {
+    for (std::size_t j = i + 1; j < n5; j++) {
+      for (std::size_t k = j + 1; k < n5; k++) {
+        for (std::size_t l = k + 1; l < n5; l++) {
+          for (std::size_t m = l + 1; m < n5; m++) {
+            // at the moment only pure pion 5-body reactions
+            check({*for_five[i], *for_five[j], *for_five[k], *for_five[l],
+                   *for_five[m]});
           }
-          for (const ParticleData& p4 : search_list) {
-            if (finder_parameters_.included_multi
-                    [IncludedMultiParticleReactions::A3_Nuclei_4to2]) {
-              if (p1.id() < p2.id() && p2.id() < p3.id() && p3.id() < p4.id()) {
-                ActionPtr act =
-                    check_collision_multi_part({p1, p2, p3, p4}, dt, gcell_vol);
-                if (act) {
-                  actions.push_back(std::move(act));
-                }
-              }
-            }
-            if (finder_parameters_.included_multi
-                        [IncludedMultiParticleReactions::NNbar_5to2] == 1 &&
-                search_list.size() >= 5) {
-              for (const ParticleData& p5 : search_list) {
-                if ((p1.id() < p2.id() && p2.id() < p3.id() &&
-                     p3.id() < p4.id() && p4.id() < p5.id()) &&
-                    (p1.is_pion() && p2.is_pion() && p3.is_pion() &&
-                     p4.is_pion() && p5.is_pion())) {
-                  // at the moment only pure pion 5-body reactions
-                  ActionPtr act = check_collision_multi_part(
-                      {p1, p2, p3, p4, p5}, dt, gcell_vol);
-                  if (act) {
-                    actions.push_back(std::move(act));
-                  }
-                }
-              }
-            }
+        }
+      }
+    }
+  }
+}
+
+void ScatterActionsFinder::store_geometric_partners(
+    ParticleSpan partners, const std::vector<FourVector>& beam_momentum,
+    GeometricPartners& stored, std::size_t first) const {
+  /* The kinematics are screened in single precision, with the positions
+   * relative to the first partner, such that they are small. */
+  const ThreeVector origin = partners[0].position().threevec();
+  /* Particles with invalid ids have no momentum in the search, they are left
+   * to check_collision_two_part, which rejects them. Pairs of spectators of
+   * the same nucleus are banned and skipped right away. */
+  for (std::size_t j = 0; j < partners.size(); j++) {
+    const ParticleData& data = partners[j];
+    const ThreeVector position = data.position().threevec() - origin;
+    const bool invalid = data.id() < 0;
+    const FourVector& momentum =
+        invalid ? data.momentum() : search_momentum(data, beam_momentum);
+    const std::size_t k = first + j;
+    stored.invalid[k] = invalid;
+    stored.nucleus[k] = invalid ? BelongsTo::Nothing : spectator_nucleus(data);
+    stored.x[k] = position.x1();
+    stored.y[k] = position.x2();
+    stored.z[k] = position.x3();
+    stored.px[k] = momentum.x1();
+    stored.py[k] = momentum.x2();
+    stored.pz[k] = momentum.x3();
+    stored.energy[k] = momentum.x0();
+  }
+}
+
+void ScatterActionsFinder::append_geometric_collisions(
+    ParticleSpan search_list, ParticleSpan partners, bool same_list,
+    double dt, const std::vector<FourVector>& beam_momentum,
+    ActionList& actions) const {
+  if (partners.empty()) {
+    return;
+  }
+  GeometricPartners stored;
+  stored.resize(partners.size());
+  store_geometric_partners(partners, beam_momentum, stored, 0);
+  append_geometric_collisions(search_list, partners, same_list, dt,
+                              beam_momentum, stored, 0, actions);
+}
+
+void ScatterActionsFinder::append_geometric_collisions(
+    ParticleSpan search_list, ParticleSpan partners, bool same_list,
+    double dt, const std::vector<FourVector>& beam_momentum,
+    const GeometricPartners& stored, std::size_t first,
+    ActionList& actions) const {
+  const std::size_t n = partners.size();
+  if (n == 0) {
+    return;
+  }
+  const ThreeVector origin = partners[0].position().threevec();
+  const float *x = &stored.x[first], *y = &stored.y[first],
+              *z = &stored.z[first], *px = &stored.px[first],
+              *py = &stored.py[first], *pz = &stored.pz[first],
+              *energy = &stored.energy[first];
+  const char* invalid = &stored.invalid[first];
+  const BelongsTo* nucleus = &stored.nucleus[first];
+  std::vector<char> candidate(n);
+  const float dt_single = dt;
+  for (const ParticleData& p1 : search_list) {
+    const ThreeVector position = p1.position().threevec() - origin;
+    const bool invalid_1 = p1.id() < 0;
+    const BelongsTo nucleus_1 =
+        invalid_1 ? BelongsTo::Nothing : spectator_nucleus(p1);
+    const FourVector& momentum =
+        invalid_1 ? p1.momentum() : search_momentum(p1, beam_momentum);
+    const float x1 = position.x1(), y1 = position.x2(), z1 = position.x3();
+    const float px1 = momentum.x1(), py1 = momentum.x2(), pz1 = momentum.x3(),
+                e1 = momentum.x0();
+    for (std::size_t j = 0; j < n; j++) {
+      const float ax = px1 * energy[j], bx = px[j] * e1, ay = py1 * energy[j],
+                  by = py[j] * e1, az = pz1 * energy[j], bz = pz[j] * e1;
+      const float dvx = ax - bx, dvy = ay - by, dvz = az - bz;
+      const float dx = x1 - x[j], dy = y1 - y[j], dz = z1 - z[j];
+      const float dv_sqr = dvx * dvx + dvy * dvy + dvz * dvz;
+      const float scale = e1 * energy[j] / dv_sqr;
+      const float time = -(dx * dvx + dy * dvy + dz * dvz) * scale;
+      // Bound the terms entering the collision time from above
+      const float size = std::abs(ax) + std::abs(bx) + std::abs(ay) +
+                         std::abs(by) + std::abs(az) + std::abs(bz);
+      const float reach = std::abs(x1) + std::abs(x[j]) + std::abs(y1) +
+                          std::abs(y[j]) + std::abs(z1) + std::abs(z[j]);
+      /* With velocities differing by at least 1% of the size, the collision
+       * time in single precision is off by less than 1e-3 of the bound of
+       * its terms. Almost equal velocities are left to the exact check. */
+      const float error = 1e-3f * reach * size * scale;
+      const bool same_nucleus =
+          nucleus_1 != BelongsTo::Nothing && nucleus_1 == nucleus[j];
+      candidate[j] = !same_nucleus &&
+                     (invalid_1 || invalid[j] ||
+                      dv_sqr < 1e-4f * size * size ||
+                      (time > -error && time < dt_single + error));
+    }
+    for (std::size_t j = 0; j < n; j++) {
+      const ParticleData& p2 = partners[j];
+      if (!candidate[j] || (same_list && p1.id() >= p2.id())) {
+        continue;
+      }
+      assert(p1.id() != p2.id());
+      ActionPtr act = check_collision_two_part(p1, p2, dt, beam_momentum);
+      if (act) {
+        actions.push_back(std::move(act));
+      }
+    }
+  }
+}
+
+void ScatterActionsFinder::append_stochastic_collisions(
+    ParticleSpan search_list, double dt, const double gcell_vol,
+    const std::vector<FourVector>& beam_momentum, ActionList& actions) const {
+  // No grid or search in cell means no collision for stochastic criterion
+  if (gcell_vol < really_small) {
+    return;
+  }
+  const std::size_t n = search_list.size();
+  /* With thinning, the pairs of particles with tabulated cross sections are
+   * sampled together and only the pairs involving other particles are checked
+   * one by one below. */
+  std::vector<bool> thinned(n, false);
+  if (stochastic_thinning_) {
+    std::vector<const ParticleData*> tabulated;
+    double fastest = 0., second_fastest = 0.;
+    for (std::size_t i = 0; i < n; i++) {
+      const ParticleData& data = search_list[i];
+      if (!has_tabulated_cross_sections(data)) {
+        continue;
+      }
+      tabulated.push_back(&data);
+      const double speed = data.velocity().abs();
+      if (speed > fastest) {
+        second_fastest = fastest;
+        fastest = speed;
+      } else if (speed > second_fastest) {
+        second_fastest = speed;
+      }
+    }
+    const std::optional<double> max_xs =
+        tabulated.size() < 2 ? std::nullopt
+                             : max_cross_section_bound(tabulated);
+    if (max_xs) {
+      const double prob_bound =
+          *max_xs * dynamic_cell_size_safety_factor_ * fm2_mb /
+          static_cast<double>(finder_parameters_.testparticles) *
+          (fastest + second_fastest) * dt / gcell_vol;
+      // Thinning does not pay off if almost every pair has to be checked
+      if (prob_bound < 1.) {
+        for (std::size_t i = 0; i < n; i++) {
+          thinned[i] = has_tabulated_cross_sections(search_list[i]);
+        }
+        append_thinned_stochastic_collisions(tabulated, prob_bound, dt,
+                                             gcell_vol, beam_momentum, actions);
+      }
+    }
+  }
+  /* The kinematics of the particles are stored component-wise, such that the
+   * relative velocities of one particle with all others in the cell are
+   * computed in a single loop without branches, which can be vectorized. */
+  std::vector<double> energy(n), px(n), py(n), pz(n), mass_sqr(n), v_rel(n);
+  for (std::size_t i = 0; i < n; i++) {
+    const FourVector& momentum = search_list[i].momentum();
+    energy[i] = momentum.x0();
+    px[i] = momentum.x1();
+    py[i] = momentum.x2();
+    pz[i] = momentum.x3();
+    const double mass = search_list[i].effective_mass();
+    mass_sqr[i] = mass * mass;
+  }
+  for (std::size_t a = 0; a < n; a++) {
+    if (thinned[a]) {
+      continue;
+    }
+    for (std::size_t b = 0; b < n; b++) {
+      const double e = energy[a] + energy[b], x = px[a] + px[b],
+                   y = py[a] + py[b], z = pz[a] + pz[b];
+      const double lamb = Action::lambda_tilde(e * e - x * x - y * y - z * z,
+                                               mass_sqr[a], mass_sqr[b]);
+      v_rel[b] = std::sqrt(lamb) / (2. * energy[a] * energy[b]);
+    }
+    const ParticleData& data_a = search_list[a];
+    for (std::size_t b = 0; b < n; b++) {
+      const ParticleData& data_b = search_list[b];
+      // The pairs with a thinned particle are only found from this side
+      if (thinned[b] && data_a.id() > data_b.id()) {
+        sample_stochastic_pair(data_b, data_a, v_rel[b], 1., dt, gcell_vol,
+                               beam_momentum, actions);
+      } else if (thinned[b] || data_a.id() < data_b.id()) {
+        sample_stochastic_pair(data_a, data_b, v_rel[b], 1., dt, gcell_vol,
+                               beam_momentum, actions);
+      }
+    }
+  }
+}
+
+void ScatterActionsFinder::append_thinned_stochastic_collisions(
+    const std::vector<const ParticleData*>& search_list, double prob_bound,
+    double dt, const double gcell_vol,
+    const std::vector<FourVector>& beam_momentum, ActionList& actions) const {
+  const std::size_t n = search_list.size();
+  if (n < 2 || prob_bound <= 0.) {
+    return;
+  }
+  const std::size_t n_pairs = n * (n - 1) / 2;
+  /* The pairs are numbered row by row, (0, 1), ..., (0, n - 1), (1, 2), ...,
+   * and the number of pairs until the next one with a random number below the
+   * bound is geometrically distributed. */
+  const double log_miss = std::log1p(-prob_bound);
+  std::size_t pair = 0;
+  std::size_t a = 0;
+  // Number of the first pair after the row of a
+  std::size_t row_end = n - 1;
+  while (true) {
+    const double skip =
+        std::floor(std::log(1. - random::uniform(0., 1.)) / log_miss);
+    if (skip >= static_cast<double>(n_pairs - pair)) {
+      return;
+    }
+    pair += static_cast<std::size_t>(skip);
+    while (pair >= row_end) {
+      a++;
+      row_end += n - 1 - a;
+    }
+    const std::size_t b = n - (row_end - pair);
+    pair++;
+    const ParticleData* data_a = search_list[a];
+    const ParticleData* data_b = search_list[b];
+    if (data_a->id() > data_b->id()) {
+      std::swap(data_a, data_b);
+    }
+    const double mass_a = data_a->effective_mass(),
+                 mass_b = data_b->effective_mass();
+    const FourVector& momentum_a = data_a->momentum();
+    const FourVector& momentum_b = data_b->momentum();
+    const double lamb = Action::lambda_tilde((momentum_a + momentum_b).sqr(),
+                                             mass_a * mass_a, mass_b * mass_b);
+    const double v_rel =
+        std::sqrt(lamb) / (2. * momentum_a.x0() * momentum_b.x0());
+    sample_stochastic_pair(*data_a, *data_b, v_rel, prob_bound, dt, gcell_vol,
+                           beam_momentum, actions);
+  }
+}
+
+void ScatterActionsFinder::sample_stochastic_pair(
+    const ParticleData& data_a, const ParticleData& data_b, double v_rel,
+    double prob_scale, double dt, const double gcell_vol,
+    const std::vector<FourVector>& beam_momentum, ActionList& actions) const {
+  if (is_banned_within_nucleus(data_a, data_b)) {
+    return;
+  }
+  const double time_until_collision =
+      collision_time_with<CollisionCriterion::Stochastic>(data_a, data_b, dt,
+                                                          beam_momentum);
+  if (time_until_collision < 0. || time_until_collision >= dt) {
+    return;
+  }
+  /* The random number for the probability criterion is drawn before the
+   * action is constructed, which does not draw any random numbers. Hence,
+   * without thinning, the sequence of random numbers is the same as in
+   * check_collision_two_part. A pair picked by thinning has a random number
+   * uniformly distributed below the bound of the probabilities. */
+  const double random_no = prob_scale * random::uniform(0., 1.);
+  const std::optional<double> xs_bound =
+      cross_section_upper_bound(data_a, data_b, time_until_collision);
+  if (xs_bound && random_no > *xs_bound * v_rel * dt / gcell_vol) {
+    return;
+  }
+  const bool incoming_parametrized =
+      is_total_parametrized(data_a.type(), data_b.type());
+  ScatterActionPtr act = create_scatter_action(
+      data_a, data_b, time_until_collision, incoming_parametrized);
+  const double xs = scaled_cross_section(*act, time_until_collision);
+  if (prob_scale < 1. && xs * v_rel * dt / gcell_vol > prob_scale) {
+    logg[LFindScatter].warn(
+        "The collision probability of ", data_a.type().name(),
+        data_b.type().name(), " at sqrts[GeV] = ", act->sqrt_s(),
+        " exceeds its bound for the stochastic thinning. Consider increasing "
+        "the Dynamic_Cell_Size_Safety_Factor.");
+  }
+  if (!stochastic_collision_sampled(*act, xs, dt, gcell_vol, random_no)) {
+    return;
+  }
+  if (incoming_parametrized) {
+    act->add_all_scatterings_when_needed(finder_parameters_);
+  }
+  actions.push_back(std::move(act));
+}
+
+ActionList ScatterActionsFinder::find_actions_in_cell(
+    ParticleSpan search_list, double dt, const double gcell_vol,
+    const std::vector<FourVector>& beam_momentum) const {
+  std::vector<ActionPtr> actions;
+  if (only_spectators_of_one_nucleus(search_list)) {
+    return actions;
+  }
+  if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic &&
+      xs_cache_) {
+    append_stochastic_collisions(search_list, dt, gcell_vol, beam_momentum,
+                                 actions);
+  } else if (finder_parameters_.coll_crit == CollisionCriterion::Geometric) {
+    append_geometric_collisions(search_list, search_list, true, dt,
+                                beam_momentum, actions);
+  } else {
+    for (const ParticleData& p1 : search_list) {
+      for (const ParticleData& p2 : search_list) {
+        // Check for 2 particle scattering
+        if (p1.id() < p2.id()) {
+          ActionPtr act =
+              check_collision_two_part(p1, p2, dt, beam_momentum, gcell_vol);
+          if (act) {
+            actions.push_back(std::move(act));
           }
         }
       }
     }
   }
+  // Also, check for multi-particle scatterings with stochastic criterion
+  if (finder_parameters_.included_multi.any()) {
+    append_multi_particle_actions(search_list, dt, gcell_vol, actions);
+  }
   return actions;
 }
 
 ActionList ScatterActionsFinder::find_actions_with_neighbors(
-    const ParticleList& search_list, const ParticleList& neighbors_list,
+    ParticleSpan search_list, ParticleSpan neighbors_list,
     double dt, const std::vector<FourVector>& beam_momentum) const {
   std::vector<ActionPtr> actions;
-  if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic) {
+  if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic ||
+      only_spectators_of_one_nucleus(search_list, neighbors_list)) {
     // Only search in cells
     return actions;
   }
+  if (finder_parameters_.coll_crit == CollisionCriterion::Geometric) {
+    append_geometric_collisions(search_list, neighbors_list, false, dt,
+                                beam_momentum, actions);
+    return actions;
+  }
   for (const ParticleData& p1 : search_list) {
     for (const ParticleData& p2 : neighbors_list) {
       assert(p1.id() != p2.id());
@@ -535,6 +1202,91 @@ ActionList ScatterActionsFinder::find_actions_with_neighbors(
   return actions;
 }
 
+void ScatterActionsFinder::find_actions_in_tile(
+    const CellTile& tile, double dt, double gcell_vol,
+    const std::vector<FourVector>& beam_momentum,
+    std::vector<ActionList>& found) const {
+  if (finder_parameters_.coll_crit != CollisionCriterion::Geometric) {
+    ActionFinderInterface::find_actions_in_tile(tile, dt, gcell_vol,
+                                                beam_momentum, found);
+    return;
+  }
+  const std::size_t n = tile.particles.size();
+  GeometricPartners stored;
+  stored.resize(n);
+  std::vector<char> is_stored(n, false);
+  const std::less<const ParticleData*> before;
+  for (std::size_t i = 0; i < tile.visits.size(); i++) {
+    const CellTile::Visit& visit = tile.visits[i];
+    const bool same_list = !visit.neighbors;
+    const ParticleSpan partners = same_list ? visit.search : *visit.neighbors;
+    if (same_list ? only_spectators_of_one_nucleus(visit.search)
+                  : only_spectators_of_one_nucleus(visit.search, partners)) {
+      continue;
+    }
+    /* Neighbor cells across the walls of a periodic grid may lie outside of
+     * the tile and are not stored. The partners are always a whole cell, such
+     * that marking its first particle as stored suffices. */
+    const bool in_tile = n > 0 && !partners.empty() &&
+                         !before(&partners[0], &tile.particles[0]) &&
+                         !before(&tile.particles[n - 1],
+                                 &partners[partners.size() - 1]);
+    if (in_tile) {
+      const std::size_t first = &partners[0] - &tile.particles[0];
+      if (!is_stored[first]) {
+        store_geometric_partners(partners, beam_momentum, stored, first);
+        is_stored[first] = true;
+      }
+      append_geometric_collisions(visit.search, partners, same_list, dt,
+                                  beam_momentum, stored, first, found[i]);
+    } else {
+      append_geometric_collisions(visit.search, partners, same_list, dt,
+                                  beam_momentum, found[i]);
+    }
+    if (same_list && finder_parameters_.included_multi.any()) {
+      append_multi_particle_actions(visit.search, dt, gcell_vol, found[i]);
+    }
+  }
+}
+
+ThreeVector ScatterActionsFinder::closest_image_shift(
+    const ParticleData& p1, const ParticleData& p2) const {
+  ThreeVector shift;
+  if (!lazy_wall_crossings_) {
+    return shift;
+  }
+  const ThreeVector r = p1.position().threevec() - p2.position().threevec();
+  for (int i = 0; i < 3; i++) {
+    shift[i] = box_length_ * std::round(r[i] / box_length_);
+  }
+  return shift;
+}
+
+void ScatterActionsFinder::append_collisions_with_surrounding_particle(
+    const ParticleList& search_list, const ParticleData& p2, double dt,
+    const std::vector<FourVector>& beam_momentum, ActionList& actions) const {
+  /* don't look for collisions if the particle from the surrounding list is
+   * also in the search list */
+  auto result =
+      std::find_if(search_list.begin(), search_list.end(),
+                   [&p2](const ParticleData& p) { return p.id() == p2.id(); });
+  if (result != search_list.end()) {
+    return;
+  }
+  for (const ParticleData& p1 : search_list) {
+    // Check if a collision is possible.
+    const ThreeVector shift = closest_image_shift(p1, p2);
+    ActionPtr act =
+        shift == ThreeVector()
+            ? check_collision_two_part(p1, p2, dt, beam_momentum)
+            : check_collision_two_part(p1, p2.translated(shift), dt,
+                                       beam_momentum);
+    if (act) {
+      actions.push_back(std::move(act));
+    }
+  }
+}
+
 ActionList ScatterActionsFinder::find_actions_with_surrounding_particles(
     const ParticleList& search_list, const Particles& surrounding_list,
     double dt, const std::vector<FourVector>& beam_momentum) const {
@@ -544,25 +1296,46 @@ ActionList ScatterActionsFinder::find_actions_with_surrounding_particles(
     return actions;
   }
   for (const ParticleData& p2 : surrounding_list) {
-    /* don't look for collisions if the particle from the surrounding list is
-     * also in the search list */
-    auto result = std::find_if(
-        search_list.begin(), search_list.end(),
-        [&p2](const ParticleData& p) { return p.id() == p2.id(); });
-    if (result != search_list.end()) {
-      continue;
-    }
-    for (const ParticleData& p1 : search_list) {
-      // Check if a collision is possible.
-      ActionPtr act = check_collision_two_part(p1, p2, dt, beam_momentum);
-      if (act) {
-        actions.push_back(std::move(act));
-      }
-    }
+    append_collisions_with_surrounding_particle(search_list, p2, dt,
+                                                beam_momentum, actions);
+  }
+  return actions;
+}
+
+ActionList ScatterActionsFinder::find_actions_with_surrounding_particles(
+    const ParticleList& search_list,
+    const std::vector<const ParticleData*>& surrounding_list, double dt,
+    const std::vector<FourVector>& beam_momentum) const {
+  std::vector<ActionPtr> actions;
+  if (finder_parameters_.coll_crit == CollisionCriterion::Stochastic) {
+    // Only search in cells
+    return actions;
+  }
+  for (const ParticleData* p2 : surrounding_list) {
+    append_collisions_with_surrounding_particle(search_list, *p2, dt,
+                                                beam_momentum, actions);
   }
   return actions;
 }
 
+void ScatterActionsFinder::dump_cross_section_table(
+    const std::filesystem::path& file, ThreadPool* pool) {
+  if (!xs_cache_) {
+    throw std::logic_error(
+        "The cross section table is written from the cross section cache.");
+  }
+  ParticleTypePtrList stable_hadrons;
+  for (const ParticleType& type : ParticleType::list_all()) {
+    if (type.is_hadron() && type.is_stable()) {
+      stable_hadrons.push_back(&type);
+    }
+  }
+  xs_cache_->tabulate(stable_hadrons, pool);
+  const std::size_t n_tables = xs_cache_->write(file);
+  logg[LFindScatter].info("Wrote the cross sections of ", n_tables,
+                          " pairs of particle types to ", file.string(), ".");
+}
+
 void ScatterActionsFinder::dump_reactions() const {
   constexpr double time = 0.0;
 
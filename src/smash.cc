@@ -7,24 +7,46 @@
  *
  */
 #include <getopt.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
 #include <filesystem>
+#include <future>
+#include <iomanip>
 #include <set>
 #include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 
+#include "smash/checkpoint.h"
+#include "smash/crosssectionsphoton.h"
 #include "smash/decaymodes.h"
 #include "smash/experiment.h"
 #include "smash/filelock.h"
+#include "smash/hadgas_eos.h"
+#include "smash/isoparticletype.h"
 #include "smash/random.h"
 #include "smash/scatteractionsfinder.h"
 #include "smash/setup_particles_decaymodes.h"
 #include "smash/sha256.h"
 #include "smash/stringfunctions.h"
+#include "smash/threadpool.h"
 /* build dependent variables */
 #include "smash/config.h"
 #include "smash/library.h"
 
+#ifdef SMASH_USE_MPI
+#include <mpi.h>
+#endif
+
 namespace smash {
 
 /*!\Userguide
@@ -108,6 +130,13 @@ namespace smash {
  *     Typically, this results in errors of less than 1 mb in the worst case.
  *     Also, contributions from strings are not considered, and the values are
  *     not rescaled to match the parametrized total cross section.
+ * <tr><td>`-t <file>` <td>`--cross-section-table <file>`
+ * <td>Tabulates the total cross sections of all pairs of stable hadrons in
+ *     the binary format of the cross section cache and writes them to the
+ *     given file, which can be read by later runs with \ref key_CT_cs_table_
+ *     "Cross_Section_Table". The pairs are shared by as many threads as given
+ *     by \ref key_gen_tabulation_threads_ "Tabulation_Threads", or by one
+ *     thread per CPU if the key is not given.
  * <tr><td>`-f` <td>`--force`
  * <td>Forces overwriting files in the output directory. Normally, if you
  *     specify an output directory with `-o`, the directory must be empty.
@@ -116,12 +145,86 @@ namespace smash {
  * <td>Don't cache integrals in form of tabulations on the disk. Usually, in
  *     order for future smash runs to save computational time, the tabulations
  *     folder is created next to the output directory and contains the results
- *     of integrals stored in many different files. Using this option, such a
- *     folder is not created.
+ *     of integrals stored in many different files, as well as the particle
+ *     types and decay modes built from the input files. Using this option,
+ *     such a folder is not created.
  * <tr><td>`-q` <td>`--quiet`
  * <td>Quiets the disclaimer for scenarios where no printout is wanted. To
  *     get no printout, you also need to disable logging from the config.
+ * <tr><td>`-b <file>` <td>`--benchmark <file>`
+ * <td>Runs the given scenario as a benchmark and writes the measured
+ *     performance as JSON to the given file. The formats of all output
+ *     contents are replaced by `None`, so that no output files are written,
+ *     all resonance integrals are tabulated before the run, the \ref
+ *     key_gen_randomseed_ "Randomseed" is fixed unless a non-negative one is
+ *     given and the \ref key_gen_profiling_ "Profiling" is switched on. The
+ *     JSON object holds the number of events and actions (without wall
+ *     crossings) per second of wall time of the run, the peak resident set
+ *     size of the process and the times of the profiled phases, with their
+ *     counts of hardware events if \ref key_gen_hardware_counters_
+ *     "Hardware_Counters" is switched on.
+ * <tr><td>`-R <file>` <td>`--restart <file>`
+ * <td>Continues an interrupted run from the given checkpoint, which has to be
+ *     written by the same build of SMASH with the same configuration, see
+ *     \ref key_gen_checkpoint_interval_ "Checkpoint_Interval". The outputs
+ *     of the continued run start at the checkpoint, hence a new output
+ *     directory should be given. Independently of this option, SMASH writes
+ *     a checkpoint to the output directory at the beginning of the next time
+ *     step, whenever it receives the `SIGUSR1` signal.
+ * <tr><td>`-j <socket>` <td>`--serve <socket>`
+ * <td>Runs SMASH as a server, which sets up the particle types, the decay
+ *     modes and the tabulations once and then runs one simulation for every
+ *     request received on the given local socket, see below.
  * </table>
+ *
+ * \par Serving many short runs
+ *
+ * Workflows running SMASH many times for a few events, e.g. as afterburner of
+ * a hydrodynamic simulation, spend most of the time in reading the
+ * configuration, the particles and decay modes, and in the tabulations. With
+ * \verbatim
+ smash -i config.yaml -j smash.sock &
+ \endverbatim
+ * SMASH does this once and then waits for requests on the Unix domain socket
+ * `smash.sock`. A request is the line `Run <output directory>` followed by
+ * YAML configuration values, which are merged into the configuration given on
+ * the command line, e.g. to point \ref key_ML_file_dir_
+ * "File_Directory" of the \ref doxypage_input_conf_modi_list "List" modus to
+ * the particles of the next event. It ends when the client shuts down its
+ * sending side of the connection. The runs are simulated one after the other
+ * and every request is answered with `Done` or with `Error:` and the error
+ * message, after which the connection is closed, e.g.
+ * \verbatim
+ printf 'Run hydro_0/smash\nModi: {List: {File_Directory: hydro_0}}' |
+     socat - UNIX-CONNECT:smash.sock
+ \endverbatim
+ * The request `Stop` stops the server. The particles and decay modes cannot be
+ * changed by a request. A negative \ref key_gen_randomseed_ "Randomseed"
+ * draws a new seed for every run.
+ *
+ * \par Distributing the events over MPI processes
+ *
+ * If SMASH is built with `-DTRY_USE_MPI=ON` and MPI is found, the events of a
+ * run can be distributed over several processes, e.g. with
+ * \verbatim
+ mpirun -n 64 smash -i config.yaml -o run
+ \endverbatim
+ * Every process sets up the experiment once and then takes small ranges of
+ * events from a counter kept by the first process, until all \ref
+ * key_gen_nevents_ "Nevents" are handed out. The random seeds are chained
+ * from event to event as in a run on one process, so every event is the same
+ * no matter which process simulates it. The first process caches the
+ * tabulations before the others start. Every process writes its outputs to
+ * its own directory `rank_<process>` in the output directory. With \ref
+ * key_output_particles_event_index_ "Event_Index", the binary outputs of all
+ * processes are merged into one indexed file, with the events in the order of
+ * their numbers, by the `smash_merge` executable:
+ * \verbatim
+ smash_merge -o run/particles_custom.bin run/rank_0/particles_custom.bin \
+     run/rank_1/particles_custom.bin ...
+ \endverbatim
+ * The events are only distributed for a fixed number of events, without \ref
+ * key_gen_forks_per_event_ "forks", concurrent events and checkpoints.
  */
 
 namespace {
@@ -170,6 +273,10 @@ void usage(const int rc, const std::string &progname) {
       "                          Masses are optional, by default pole masses"
       " are used.\n"
       "                          Note the required comma and no spaces.\n"
+      "  -t, --cross-section-table <file>\n"
+      "                          write the total cross sections of all pairs"
+      " of stable hadrons\n"
+      "                          as a binary table to file\n"
       "  -f, --force             force overwriting files in the output "
       "directory"
       "\n"
@@ -178,6 +285,13 @@ void usage(const int rc, const std::string &progname) {
       "                          relativistic hydro codes\n"
       "  -q, --quiet             Supress disclaimer print-out\n"
       "  -n, --no-cache          Don't cache integrals on disk\n"
+      "  -b, --benchmark <file>  run without outputs and with a fixed seed,\n"
+      "                          writing the performance as JSON to file\n"
+      "  -R, --restart <file>    continue an interrupted run from the given\n"
+      "                          checkpoint\n"
+      "  -j, --serve <socket>    run the simulations requested on the given\n"
+      "                          local socket, setting up the particles and\n"
+      "                          tabulations only once\n"
       "  -v, --version\n\n");
   std::exit(rc);
 }
@@ -356,6 +470,354 @@ void ignore_simulation_config_values(Configuration &configuration) {
   }
 }
 
+/// The random seed of benchmark runs, unless a non-negative one is given
+constexpr int64_t benchmark_seed = 4242;
+
+/**
+ * Prepares the configuration for a benchmark run: The formats of all output
+ * contents are replaced by "None" and their quantities are dropped, such that
+ * the contents are still known to the experiment but nothing is written. The
+ * profiling is switched on and the seed is fixed, unless a non-negative one is
+ * given.
+ *
+ * \param[inout] configuration The configuration of the run.
+ */
+void setup_benchmark_config(Configuration &configuration) {
+  if (configuration.has_section(InputSections::output)) {
+    Configuration output =
+        configuration.extract_sub_configuration(InputSections::output);
+    const std::vector<std::string> contents = output.list_upmost_nodes();
+    output.enclose_into_section(InputSections::output);
+    for (const std::string &content : contents) {
+      if (output.has_section({"Output", content})) {
+        output.set_value(InputKeys::get_output_format_key(content),
+                         std::vector<std::string>{"None"});
+      }
+    }
+    for (const auto &key : {InputKeys::output_particles_quantities,
+                            InputKeys::output_collisions_quantities,
+                            InputKeys::output_dileptons_quantities,
+                            InputKeys::output_photons_quantities,
+                            InputKeys::output_initialConditions_quantities}) {
+      if (output.has_value(key)) {
+        output.take(key);
+      }
+    }
+    configuration.merge_yaml(output.to_string());
+    output.clear();
+  }
+  configuration.set_value(InputKeys::gen_profiling, true);
+  if (configuration.read(InputKeys::gen_randomseed) < 0) {
+    configuration.set_value(InputKeys::gen_randomseed, benchmark_seed);
+  }
+}
+
+/// \return The peak resident set size of the process [kB].
+int64_t peak_resident_set_size() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  // The size is given in bytes on macOS and in kilobytes on Linux
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+/**
+ * Writes the performance of a benchmark run as JSON.
+ *
+ * \param[in] path The file to write to.
+ * \param[in] experiment The experiment that has been run.
+ * \param[in] wall_time The wall time of the run [s].
+ */
+void write_benchmark_report(const std::filesystem::path &path,
+                            const ExperimentBase &experiment,
+                            double wall_time) {
+  const Profiler &profiler = experiment.profiler();
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("The benchmark report cannot be written to \"" +
+                             path.native() + "\".");
+  }
+  /* Only the names of the sections are strings. They are made of letters,
+   * digits, spaces and brackets and so need no escaping. */
+  out << std::setprecision(9) << "{\n"
+      << "  \"version\": \"" << SMASH_VERSION << "\",\n"
+      << "  \"events\": " << profiler.n_events() << ",\n"
+      << "  \"actions\": " << experiment.actions_performed() << ",\n"
+      << "  \"wall_time\": " << wall_time << ",\n"
+      << "  \"events_per_second\": " << profiler.n_events() / wall_time
+      << ",\n"
+      << "  \"actions_per_second\": "
+      << experiment.actions_performed() / wall_time << ",\n"
+      << "  \"peak_rss_kB\": " << peak_resident_set_size() << ",\n"
+      << "  \"phases\": [";
+  const std::vector<Profiler::Total> totals = profiler.totals();
+  for (std::size_t i = 0; i < totals.size(); i++) {
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << totals[i].name
+        << "\", \"time\": " << totals[i].seconds
+        << ", \"calls\": " << totals[i].calls;
+    for (const auto &[event, count] : totals[i].counts) {
+      out << ", \"" << event << "\": " << count;
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+/**
+ * Keep a copy of the configuration that was used in the output directory,
+ * together with information about the SMASH build as a comment.
+ *
+ * \param[in] output_path The output directory.
+ * \param[in] configuration The configuration of the run.
+ */
+void write_configuration_copy(const std::filesystem::path &output_path,
+                              const Configuration &configuration) {
+  std::ofstream(output_path / "config.yaml")
+      << "# " << SMASH_VERSION << '\n'
+#ifdef GIT_BRANCH
+      << "# Branch   : " << GIT_BRANCH << '\n'
+#endif
+      << "# System   : " << CMAKE_SYSTEM << '\n'
+      << "# Compiler : " << CMAKE_CXX_COMPILER_ID << ' '
+      << CMAKE_CXX_COMPILER_VERSION << '\n'
+      << "# Build    : " << CMAKE_BUILD_TYPE << '\n'
+      << "# Date     : " << BUILD_DATE << '\n'
+      << configuration.to_string() << '\n';
+}
+
+/**
+ * Simulate the run of a request of the server mode.
+ *
+ * \param[in] request The output directory, optionally followed by a newline
+ *            and YAML configuration values.
+ * \param[in] base_config The configuration shared by all runs, from which
+ *            the particles, decay modes and tabulations have been taken.
+ * \param[in] force_overwrite Whether an existing output may be overwritten.
+ * \throw std::exception if the run fails.
+ */
+void run_request(const std::string &request, const std::string &base_config,
+                 bool force_overwrite) {
+  const std::size_t end_of_line = request.find('\n');
+  const std::filesystem::path output_path =
+      std::filesystem::absolute(request.substr(0, end_of_line));
+  Configuration configuration{base_config.c_str()};
+  if (end_of_line != std::string::npos &&
+      request.find_first_not_of(" \t\r\n", end_of_line) != std::string::npos) {
+    configuration.merge_yaml(request.substr(end_of_line + 1));
+  }
+  if (configuration.read(InputKeys::gen_randomseed) < 0) {
+    configuration.set_value(InputKeys::gen_randomseed,
+                            random::generate_63bit_seed());
+  }
+  ensure_path_is_valid(output_path);
+  const std::filesystem::path lock_path = output_path / "smash.lock";
+  FileLock lock(lock_path);
+  if (!lock.acquire()) {
+    throw std::runtime_error("Another instance of SMASH is already writing to "
+                             "the output directory " +
+                             output_path.native() + ".");
+  }
+  if (!force_overwrite &&
+      std::filesystem::exists(output_path / "config.yaml")) {
+    throw std::runtime_error("Output directory " + output_path.native() +
+                             " would get overwritten.");
+  }
+  write_configuration_copy(output_path, configuration);
+  auto experiment = ExperimentBase::create(configuration, output_path);
+  check_for_unused_config_values(configuration);
+  experiment->run();
+}
+
+/**
+ * Serve the runs requested on a Unix domain socket until the request `Stop`
+ * is received, see \ref doxypage_smash_invocation. Each connection carries
+ * one request, which is read until the client shuts down its sending side,
+ * and is answered before the connection is closed. The runs are simulated one
+ * after the other.
+ *
+ * \param[in] socket_path The path of the socket, which is removed at the end.
+ * \param[in] base_config The configuration shared by all runs.
+ * \param[in] force_overwrite Whether existing outputs may be overwritten.
+ * \throw std::runtime_error if the socket cannot be set up.
+ */
+void serve_runs(const std::filesystem::path &socket_path,
+                const std::string &base_config, bool force_overwrite) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socket_path.native().size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("The socket path " + socket_path.native() +
+                                " is too long.");
+  }
+  std::strncpy(address.sun_path, socket_path.c_str(),
+               sizeof(address.sun_path) - 1);
+  // A socket left behind by a previous server is replaced
+  if (std::filesystem::is_socket(socket_path)) {
+    std::filesystem::remove(socket_path);
+  }
+  const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0 ||
+      bind(server, reinterpret_cast<const sockaddr *>(&address),
+           sizeof(address)) != 0 ||
+      listen(server, SOMAXCONN) != 0) {
+    const std::string error = std::strerror(errno);
+    if (server >= 0) {
+      close(server);
+    }
+    throw std::runtime_error("The socket " + socket_path.native() +
+                             " cannot be set up: " + error);
+  }
+  // A client closing the connection early must not stop the server
+  std::signal(SIGPIPE, SIG_IGN);
+  logg[LMain].info("Serving runs on ", socket_path);
+  for (bool serving = true; serving;) {
+    const int client = accept(server, nullptr, nullptr);
+    if (client < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      close(server);
+      throw std::runtime_error(std::string("Accepting a request failed: ") +
+                               std::strerror(errno));
+    }
+    std::string request;
+    char buffer[4096];
+    ssize_t n_read;
+    while ((n_read = read(client, buffer, sizeof(buffer))) > 0) {
+      request.append(buffer, n_read);
+    }
+    std::string reply;
+    if (request.rfind("Stop", 0) == 0) {
+      serving = false;
+      reply = "Stopped\n";
+    } else if (request.rfind("Run ", 0) == 0) {
+      const std::string output_path = request.substr(4, request.find('\n') - 4);
+      logg[LMain].info("Starting the run in ", output_path);
+      try {
+        run_request(request.substr(4), base_config, force_overwrite);
+        reply = "Done\n";
+      } catch (std::exception &e) {
+        logg[LMain].error() << "The run failed with the following error:\n"
+                            << e.what();
+        reply = std::string("Error: ") + e.what() + "\n";
+      }
+    } else {
+      reply = "Error: Requests start with \"Run <output directory>\" or are "
+              "\"Stop\".\n";
+    }
+    for (std::size_t written = 0; written < reply.size();) {
+      const ssize_t n = write(client, reply.data() + written,
+                              reply.size() - written);
+      if (n <= 0) {
+        break;
+      }
+      written += n;
+    }
+    close(client);
+  }
+  close(server);
+  std::filesystem::remove(socket_path);
+}
+
+#ifdef SMASH_USE_MPI
+/**
+ * The MPI processes of a run whose events are distributed over them. The
+ * first process keeps the number of the next event to be handed out in an MPI
+ * window, which every process fetches and advances by one-sided
+ * communication. Hence, no process has to wait for another one to hand out
+ * events.
+ */
+class EventDistribution {
+ public:
+  /**
+   * Initialize MPI and the counter of the events.
+   *
+   * \param[inout] argc Number of arguments on the command line.
+   * \param[inout] argv Arguments on the command line, from which MPI may
+   *               remove its own.
+   */
+  EventDistribution(int *argc, char ***argv) {
+    MPI_Init(argc, argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+    MPI_Comm_size(MPI_COMM_WORLD, &size_);
+    MPI_Win_allocate(rank_ == 0 ? sizeof(int) : 0, sizeof(int), MPI_INFO_NULL,
+                     MPI_COMM_WORLD, &next_event_, &window_);
+    if (rank_ == 0) {
+      MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, window_);
+      *next_event_ = 0;
+      MPI_Win_unlock(0, window_);
+    }
+    barrier();
+  }
+
+  /// Cannot be copied
+  EventDistribution(const EventDistribution &) = delete;
+  /// Cannot be copied
+  EventDistribution &operator=(const EventDistribution &) = delete;
+
+  /// Free the counter and finalize MPI.
+  ~EventDistribution() {
+    MPI_Win_free(&window_);
+    MPI_Finalize();
+  }
+
+  /// \return The number of this process.
+  int rank() const { return rank_; }
+
+  /// \return The number of processes.
+  int size() const { return size_; }
+
+  /**
+   * Hand out the next range of events to this process.
+   *
+   * \param[in] n Number of events of a range.
+   * \param[in] n_events Number of events of the run.
+   * \return The range, which is empty once all events are handed out.
+   */
+  ExperimentBase::EventRange next_range(int n, int n_events) {
+    int first;
+    MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, window_);
+    MPI_Fetch_and_op(&n, &first, MPI_INT, 0, 0, MPI_SUM, window_);
+    MPI_Win_unlock(0, window_);
+    return {std::min(first, n_events), std::min(first + n, n_events)};
+  }
+
+  /**
+   * \param[in] value A value of the first process.
+   * \return The value of the first process on every process.
+   */
+  int64_t broadcast(int64_t value) {
+    MPI_Bcast(&value, 1, MPI_INT64_T, 0, MPI_COMM_WORLD);
+    return value;
+  }
+
+  /// Wait for all processes.
+  void barrier() { MPI_Barrier(MPI_COMM_WORLD); }
+
+  /**
+   * Terminate all processes, since the others would wait for a failed one.
+   *
+   * \param[in] rc Exit status.
+   */
+  [[noreturn]] void abort(int rc) {
+    MPI_Abort(MPI_COMM_WORLD, rc);
+    std::exit(rc);
+  }
+
+ private:
+  /// Number of this process
+  int rank_ = 0;
+  /// Number of processes
+  int size_ = 1;
+  /// The counter of the events, only allocated on the first process
+  int *next_event_ = nullptr;
+  /// The MPI window exposing the counter
+  MPI_Win window_;
+};
+#endif
+
 }  // unnamed namespace
 
 }  // namespace smash
@@ -387,12 +849,24 @@ int main(int argc, char *argv[]) {
       {"resonance", required_argument, 0, 'r'},
       {"cross-sections", required_argument, 0, 's'},
       {"cross-sections-fs", required_argument, 0, 'S'},
+      {"cross-section-table", required_argument, 0, 't'},
       {"dump-iSS", no_argument, 0, 'x'},
       {"version", no_argument, 0, 'v'},
       {"no-cache", no_argument, 0, 'n'},
       {"quiet", no_argument, 0, 'q'},
+      {"benchmark", required_argument, 0, 'b'},
+      {"restart", required_argument, 0, 'R'},
+      {"serve", required_argument, 0, 'j'},
       {nullptr, 0, 0, 0}};
 
+#ifdef SMASH_USE_MPI
+  EventDistribution distribution(&argc, &argv);
+  const int n_processes = distribution.size();
+  const int process = distribution.rank();
+#else
+  constexpr int n_processes = 1, process = 0;
+#endif
+
   // strip any path to progname
   const std::string progname =
       std::filesystem::path(argv[0]).filename().native();
@@ -411,10 +885,14 @@ int main(int argc, char *argv[]) {
     bool particles_dump_iSS_format = false;
     bool cache_integrals = true;
     bool suppress_disclaimer = false;
+    std::filesystem::path benchmark_report;
+    std::filesystem::path restart_checkpoint;
+    std::filesystem::path cross_section_table;
+    std::filesystem::path serve_socket;
 
     // parse command-line arguments
     int opt;
-    while ((opt = getopt_long(argc, argv, "c:d:e:fhi:m:p:o:lr:s:S:xvnq",
+    while ((opt = getopt_long(argc, argv, "b:c:d:e:fhi:j:m:p:o:lr:R:s:S:t:xvnq",
                               longopts, nullptr)) != -1) {
       switch (opt) {
         case 'c':
@@ -486,6 +964,18 @@ int main(int argc, char *argv[]) {
         case 'q':
           suppress_disclaimer = true;
           break;
+        case 'b':
+          benchmark_report = optarg;
+          break;
+        case 'R':
+          restart_checkpoint = optarg;
+          break;
+        case 't':
+          cross_section_table = optarg;
+          break;
+        case 'j':
+          serve_socket = optarg;
+          break;
         default:
           usage(EXIT_FAILURE, progname);
       }
@@ -498,7 +988,7 @@ int main(int argc, char *argv[]) {
       usage(EXIT_FAILURE, progname);
     }
 
-    if (!suppress_disclaimer) {
+    if (!suppress_disclaimer && process == 0) {
       print_disclaimer();
     }
 
@@ -508,11 +998,16 @@ int main(int argc, char *argv[]) {
     setup_default_float_traps();
 
     // Check output path
+    const std::filesystem::path common_output_path = output_path;
+    if (n_processes > 1) {
+      // Every process writes to its own directory
+      output_path /= "rank_" + std::to_string(process);
+    }
     ensure_path_is_valid(output_path);
     std::string tabulations_path;
     if (cache_integrals) {
-      tabulations_path = output_path.has_parent_path()
-                             ? output_path.parent_path().string()
+      tabulations_path = common_output_path.has_parent_path()
+                             ? common_output_path.parent_path().string()
                              : ".";
       tabulations_path += "/tabulations";
     } else {
@@ -634,6 +1129,25 @@ int main(int argc, char *argv[]) {
                                       plab);
       std::exit(EXIT_SUCCESS);
     }
+    if (!cross_section_table.empty()) {
+      // Unless given, the pairs are shared by all CPUs
+      const int n_threads =
+          configuration.has_value(InputKeys::gen_tabulationThreads)
+              ? configuration.read(InputKeys::gen_tabulationThreads)
+              : static_cast<int>(
+                    std::max(1u, std::thread::hardware_concurrency()));
+      initialize_particles_decays_and_tabulations(configuration, version,
+                                                  tabulations_path);
+      configuration.set_value(InputKeys::collTerm_crossSectionCache, true);
+      auto scat_finder = actions_finder_for_dump(configuration);
+
+      ignore_simulation_config_values(configuration);
+      check_for_unused_config_values(configuration);
+
+      ThreadPool pool(n_threads);
+      scat_finder.dump_cross_section_table(cross_section_table, &pool);
+      std::exit(EXIT_SUCCESS);
+    }
     if (modus) {
       configuration.set_value(InputKeys::gen_modus, std::string(modus));
     }
@@ -642,11 +1156,44 @@ int main(int argc, char *argv[]) {
                               std::abs(std::atof(end_time)));
     }
 
+    if (!serve_socket.empty()) {
+      if (n_processes > 1 || !benchmark_report.empty() ||
+          !restart_checkpoint.empty()) {
+        throw std::invalid_argument(
+            "The server mode runs on a single process and cannot be combined "
+            "with a benchmark or a restart.");
+      }
+      const auto hash = initialize_particles_decays_and_return_hash(
+          configuration, version, tabulations_path);
+      const int tabulation_threads =
+          configuration.take(InputKeys::gen_tabulationThreads);
+      const bool lazy_tabulations =
+          configuration.take(InputKeys::gen_lazyTabulations);
+      const bool shared_tabulations =
+          configuration.take(InputKeys::gen_sharedTabulations);
+      EosTable::set_cache(hash, tabulations_path);
+      CrosssectionsPhoton<ComputationMethod::Lookup>::set_cache(
+          hash, tabulations_path);
+      tabulate_resonance_integrals(hash, tabulations_path, tabulation_threads,
+                                   lazy_tabulations, shared_tabulations);
+      serve_runs(serve_socket, configuration.to_string(), force_overwrite);
+      configuration.clear();
+      std::exit(EXIT_SUCCESS);
+    }
+    if (!benchmark_report.empty()) {
+      setup_benchmark_config(configuration);
+    }
     int64_t seed = configuration.read(InputKeys::gen_randomseed);
     if (seed < 0) {
       configuration.set_value(InputKeys::gen_randomseed,
                               random::generate_63bit_seed());
     }
+#ifdef SMASH_USE_MPI
+    // The seeds of the events are chained from the one of the first process
+    configuration.set_value(
+        InputKeys::gen_randomseed,
+        distribution.broadcast(configuration.read(InputKeys::gen_randomseed)));
+#endif
 
     // Avoid overwriting SMASH output
     const std::filesystem::path lock_path = output_path / "smash.lock";
@@ -665,35 +1212,92 @@ int main(int argc, char *argv[]) {
           "directory, clean up, or tell SMASH to ignore existing files.");
     }
 
-    /* Keep a copy of the configuration that was used in the output directory
-     * also save information about SMASH build as a comment */
-    std::ofstream(output_path / "config.yaml")
-        << "# " << SMASH_VERSION << '\n'
-#ifdef GIT_BRANCH
-        << "# Branch   : " << GIT_BRANCH << '\n'
-#endif
-        << "# System   : " << CMAKE_SYSTEM << '\n'
-        << "# Compiler : " << CMAKE_CXX_COMPILER_ID << ' '
-        << CMAKE_CXX_COMPILER_VERSION << '\n'
-        << "# Build    : " << CMAKE_BUILD_TYPE << '\n'
-        << "# Date     : " << BUILD_DATE << '\n'
-        << configuration.to_string() << '\n';
+    write_configuration_copy(output_path, configuration);
 
-    const auto hash =
-        initialize_particles_decays_and_return_hash(configuration, version);
+#ifdef SMASH_USE_MPI
+    // The other processes read the tabulations cached by the first one
+    if (process > 0) {
+      distribution.barrier();
+    }
+#endif
+    const auto hash = initialize_particles_decays_and_return_hash(
+        configuration, version, tabulations_path);
+    const int tabulation_threads =
+        configuration.take(InputKeys::gen_tabulationThreads);
+    // A benchmark run measures the evolution only
+    const bool lazy_tabulations =
+        configuration.take(InputKeys::gen_lazyTabulations) &&
+        benchmark_report.empty();
+    const bool shared_tabulations =
+        configuration.take(InputKeys::gen_sharedTabulations);
+    // The table of the equation of state of a thermalizer and the photon
+    // cross sections are tabulated while the experiment is created
+    EosTable::set_cache(hash, tabulations_path);
+    CrosssectionsPhoton<ComputationMethod::Lookup>::set_cache(hash,
+                                                              tabulations_path);
 
+#ifdef SMASH_USE_MPI
+    const int nevents = configuration.has_value(InputKeys::gen_nevents)
+                            ? configuration.read(InputKeys::gen_nevents)
+                            : 0;
+#endif
+    /* The experiment does not need the resonance integrals to be created,
+     * hence they are read or tabulated in the background, while Pythia is
+     * initialized, the equation of state is tabulated and the outputs are
+     * opened. The lazily computed properties of the particle types are
+     * computed before, such that both only read them. */
+    IsoParticleType::prepare_concurrent_tabulation();
+    std::future<void> tabulation = std::async(std::launch::async, [&]() {
+      tabulate_resonance_integrals(hash, tabulations_path, tabulation_threads,
+                                   lazy_tabulations, shared_tabulations);
+    });
     // Create an experiment
     logg[LMain].trace(SMASH_SOURCE_LOCATION, " create Experiment");
     auto experiment = ExperimentBase::create(configuration, output_path);
     check_for_unused_config_values(configuration);
-    tabulate_resonance_integrals(hash, tabulations_path);
+    tabulation.get();
+#ifdef SMASH_USE_MPI
+    if (process == 0) {
+      distribution.barrier();
+    }
+#endif
+    if (!restart_checkpoint.empty()) {
+      experiment->restore_checkpoint(restart_checkpoint);
+    }
+    // A checkpoint is written at the next time step on SIGUSR1
+    std::signal(SIGUSR1, [](int) { request_checkpoint(); });
 
     // Run the experiment
     logg[LMain].trace(SMASH_SOURCE_LOCATION, " run the Experiment");
+    const auto run_start = std::chrono::steady_clock::now();
+#ifdef SMASH_USE_MPI
+    if (n_processes > 1) {
+      // Small ranges balance the load, since the events differ in duration
+      const int n = std::max(1, nevents / (8 * n_processes));
+      experiment->run_event_ranges(
+          [&]() { return distribution.next_range(n, nevents); });
+    } else {
+      experiment->run();
+    }
+#else
     experiment->run();
+#endif
+    if (!benchmark_report.empty()) {
+      const std::chrono::duration<double> run_time =
+          std::chrono::steady_clock::now() - run_start;
+      if (n_processes > 1) {
+        benchmark_report += "." + std::to_string(process);
+      }
+      write_benchmark_report(benchmark_report, *experiment, run_time.count());
+    }
   } catch (std::exception &e) {
     logg[LMain].fatal() << "SMASH failed with the following error:\n"
                         << e.what();
+#ifdef SMASH_USE_MPI
+    if (n_processes > 1) {
+      distribution.abort(EXIT_FAILURE);
+    }
+#endif
     return EXIT_FAILURE;
   }
 
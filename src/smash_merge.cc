@@ -0,0 +1,82 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+#include <getopt.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "smash/binarymerge.h"
+
+namespace {
+
+/**
+ * Print the usage information and exit.
+ *
+ * \param[in] rc Exit status.
+ * \param[in] progname Name of the executable.
+ */
+[[noreturn]] void usage(const int rc, const std::string &progname) {
+  std::printf("\nUsage: %s -o <file> <shard>...\n\n", progname.c_str());
+  std::printf(
+      "  -h, --help              usage information\n"
+      "  -o, --output <file>     merged binary output, its index is written\n"
+      "                          to <file>.idx\n"
+      "\n"
+      "Merges the shards of a binary output written by the event threads,\n"
+      "or the outputs of the processes of a distributed run, using their\n"
+      "event indices.\n\n");
+  std::exit(rc);
+}
+
+}  // unnamed namespace
+
+/**
+ * Main program of smash_merge.
+ *
+ * \param[in] argc Number of arguments on command-line
+ * \param[in] argv List of arguments on command-line
+ * \return Either 0 or EXIT_FAILURE.
+ */
+int main(int argc, char *argv[]) {
+  constexpr option longopts[] = {{"help", no_argument, 0, 'h'},
+                                 {"output", required_argument, 0, 'o'},
+                                 {nullptr, 0, 0, 0}};
+  const std::string progname =
+      std::filesystem::path(argv[0]).filename().native();
+  std::filesystem::path output;
+  int opt;
+  while ((opt = getopt_long(argc, argv, "ho:", longopts, nullptr)) != -1) {
+    switch (opt) {
+      case 'h':
+        usage(EXIT_SUCCESS, progname);
+      case 'o':
+        output = optarg;
+        break;
+      default:
+        usage(EXIT_FAILURE, progname);
+    }
+  }
+  if (output.empty() || optind == argc) {
+    usage(EXIT_FAILURE, progname);
+  }
+  const std::vector<std::filesystem::path> shards(argv + optind, argv + argc);
+  try {
+    const std::size_t n = smash::merge_binary_shards(shards, output);
+    std::printf("Merged %zu event end lines of %zu shards into %s.\n", n,
+                shards.size(), output.c_str());
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s: %s\n", progname.c_str(), e.what());
+    return EXIT_FAILURE;
+  }
+  return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/spectraoutput.h"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include "smash/config.h"
+#include "smash/particles.h"
+
+namespace smash {
+
+/*!\Userguide
+ * \page doxypage_output_spectra
+ *
+ * The spectra output (spectra.dat) contains histograms of the final particles
+ * of all events, which are filled while SMASH runs. The particle lists do not
+ * have to be written and analysed afterwards, if only these distributions are
+ * of interest. The species and binnings are chosen in the
+ * \ref input_output_content_specific_ "content-specific output options" of
+ * the Spectra content.
+ *
+ * The file is written once at the end of the run. It starts with a header
+ * \code
+ * # **smash_version** spectra output
+ * # **number of events** events
+ * \endcode
+ * where the number of events counts every ensemble separately. For every
+ * species, two blocks follow, each preceded by a header line naming the PDG
+ * code and the columns:
+ * \li The rapidity distribution, with the columns `y`, `dN/dy` and its
+ *     statistical error.
+ * \li The transverse momentum distribution of the particles with \f$|y|\f$
+ *     below the \ref key_output_spectra_midrapidity_cut_ "Midrapidity_Cut",
+ *     with the columns `pT [GeV]`, `dN/dpT [1/GeV]`, its statistical error,
+ *     and the flow coefficients \f$v_n = \langle\cos(n\phi)\rangle\f$ for
+ *     \f$n = 1, 2, 3\f$. The azimuthal angle \f$\phi\f$ is measured with
+ *     respect to the \f$x\f$ axis, i.e. the impact parameter direction in
+ *     collider modus.
+ *
+ * The columns refer to the bin centers. The distributions are normalised per
+ * event and bin width, and the errors are the Poisson errors of the counts.
+ * Particles outside the histogram intervals are not counted.
+ */
+
+/**
+ * \param[in] value The value to histogram.
+ * \param[in] range Interval of the histogram.
+ * \param[in] bins Number of bins of the histogram.
+ * \return The index of the bin of the value, -1 if outside the interval.
+ */
+static int bin_of(double value, const std::array<double, 2> &range, int bins) {
+  if (!(range[0] <= value && value < range[1])) {
+    return -1;
+  }
+  const int bin =
+      static_cast<int>((value - range[0]) / (range[1] - range[0]) * bins);
+  return bin < bins ? bin : bins - 1;
+}
+
+SpectraOutput::SpectraOutput(const std::filesystem::path &path,
+                             const std::string &name,
+                             const OutputParameters &out_par)
+    : OutputInterface(name),
+      file_{path / "spectra.dat", "w"},
+      par_(out_par.spectra_parameters) {
+  if (par_.rapidity_bins <= 0 || par_.pt_bins <= 0) {
+    throw std::invalid_argument(
+        "The numbers of bins of the Spectra output must be positive.");
+  }
+  if (!(par_.rapidity_range[0] < par_.rapidity_range[1]) ||
+      !(par_.pt_range[0] < par_.pt_range[1])) {
+    throw std::invalid_argument(
+        "The intervals of the Spectra output must not be empty.");
+  }
+  histograms_.resize(par_.pdg_codes.size());
+  for (Histograms &h : histograms_) {
+    h.dndy.assign(par_.rapidity_bins, 0.0);
+    h.dndpt.assign(par_.pt_bins, 0.0);
+    h.cos_nphi.assign(par_.pt_bins, {});
+  }
+}
+
+SpectraOutput::~SpectraOutput() { write(); }
+
+void SpectraOutput::at_eventend(const Particles &particles,
+                                const EventLabel & /*event_label*/,
+                                const EventInfo & /*event*/) {
+  ++n_blocks_;
+  for (const ParticleData &p : particles) {
+    std::size_t species = 0;
+    while (species < par_.pdg_codes.size() &&
+           par_.pdg_codes[species] != p.pdgcode()) {
+      ++species;
+    }
+    if (species == par_.pdg_codes.size()) {
+      continue;
+    }
+    Histograms &h = histograms_[species];
+    const double y = p.rapidity();
+    const int y_bin = bin_of(y, par_.rapidity_range, par_.rapidity_bins);
+    if (y_bin >= 0) {
+      h.dndy[y_bin] += 1.0;
+    }
+    if (!(std::abs(y) < par_.midrapidity_cut)) {
+      continue;
+    }
+    const FourVector &mom = p.momentum();
+    const double pt = std::sqrt(mom.x1() * mom.x1() + mom.x2() * mom.x2());
+    const int pt_bin = bin_of(pt, par_.pt_range, par_.pt_bins);
+    if (pt_bin < 0) {
+      continue;
+    }
+    h.dndpt[pt_bin] += 1.0;
+    const double phi = std::atan2(mom.x2(), mom.x1());
+    for (int n = 1; n <= number_of_harmonics; n++) {
+      h.cos_nphi[pt_bin][n - 1] += std::cos(n * phi);
+    }
+  }
+}
+
+void SpectraOutput::write() {
+  std::FILE *f = file_.get();
+  const double n_events = n_blocks_ > 0 ? n_blocks_ : 1;
+  const double dy =
+      (par_.rapidity_range[1] - par_.rapidity_range[0]) / par_.rapidity_bins;
+  const double dpt = (par_.pt_range[1] - par_.pt_range[0]) / par_.pt_bins;
+  std::fprintf(f, "# %s spectra output\n", SMASH_VERSION);
+  std::fprintf(f, "# %d events\n", n_blocks_);
+  for (std::size_t species = 0; species < histograms_.size(); species++) {
+    const Histograms &h = histograms_[species];
+    const std::string pdg = par_.pdg_codes[species].string();
+    std::fprintf(f, "# %s y dN/dy error\n", pdg.c_str());
+    for (int i = 0; i < par_.rapidity_bins; i++) {
+      const double norm = n_events * dy;
+      std::fprintf(f, "%g %g %g\n", par_.rapidity_range[0] + (i + 0.5) * dy,
+                   h.dndy[i] / norm, std::sqrt(h.dndy[i]) / norm);
+    }
+    std::fprintf(f, "# %s |y|<%g pT[GeV] dN/dpT[1/GeV] error v1 v2 v3\n",
+                 pdg.c_str(), par_.midrapidity_cut);
+    for (int i = 0; i < par_.pt_bins; i++) {
+      const double norm = n_events * dpt;
+      const double count = h.dndpt[i];
+      std::fprintf(f, "%g %g %g", par_.pt_range[0] + (i + 0.5) * dpt,
+                   count / norm, std::sqrt(count) / norm);
+      for (int n = 0; n < number_of_harmonics; n++) {
+        std::fprintf(f, " %g", count > 0 ? h.cos_nphi[i][n] / count : 0.0);
+      }
+      std::fprintf(f, "\n");
+    }
+  }
+}
+
+}  // namespace smash
@@ -9,6 +9,7 @@
 
 #include "smash/spheremodus.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -49,6 +50,15 @@ SphereModus::SphereModus(Configuration modus_config,
           modus_config.take(InputKeys::modi_sphere_heavyFlavorMultiplier)),
       account_for_resonance_widths_(
           modus_config.take(InputKeys::modi_sphere_accountResonanceWidths)),
+      thermal_mass_sampler_(
+          modus_config.take(InputKeys::modi_sphere_tabulateThermalMasses)
+              ? std::make_optional<ThermalMassSampler>(1.0 /
+                                                       sphere_temperature_)
+              : std::nullopt),
+      tabulate_quantum_momenta_(
+          modus_config.take(InputKeys::modi_sphere_tabulateQuantumMomenta)),
+      tabulate_thermal_momenta_(
+          modus_config.take(InputKeys::modi_sphere_tabulateThermalMomenta)),
       init_multipl_(use_thermal_
                         ? std::map<PdgCode, int>()
                         : modus_config.take(
@@ -93,6 +103,15 @@ SphereModus::SphereModus(Configuration modus_config,
   if (radial_velocity_exponent_ < 0.0) {
     throw std::invalid_argument("Flow velocity exponent cannot be negative!");
   }
+  const int n_sampling_threads =
+      modus_config.take(InputKeys::modi_sphere_samplingThreads);
+  if (n_sampling_threads < 0) {
+    throw std::invalid_argument(
+        "The number of sampling threads cannot be negative.");
+  }
+  if (n_sampling_threads > 0) {
+    sampling_thread_pool_ = std::make_unique<ThreadPool>(n_sampling_threads);
+  }
 }
 
 /* console output on startup of sphere specific parameters */
@@ -156,6 +175,7 @@ double SphereModus::initial_conditions(Particles *particles,
   const double T = this->sphere_temperature_;
   const double V = 4.0 / 3.0 * M_PI * radius_ * radius_ * radius_;
   /* Create NUMBER OF PARTICLES according to configuration */
+  std::vector<int> multiplicities;
   if (use_thermal_) {
     if (average_multipl_.empty()) {
       for (const ParticleType &ptype : ParticleType::list_all()) {
@@ -176,6 +196,7 @@ double SphereModus::initial_conditions(Particles *particles,
     for (const auto &mult : average_multipl_) {
       const int thermal_mult_int = random::poisson(mult.second);
       particles->create(thermal_mult_int, mult.first);
+      multiplicities.push_back(thermal_mult_int);
       nb_init += mult.second * mult.first.baryon_number();
       ns_init += mult.second * mult.first.strangeness();
       nq_init += mult.second * mult.first.charge();
@@ -188,66 +209,46 @@ double SphereModus::initial_conditions(Particles *particles,
   } else {
     for (const auto &p : init_multipl_) {
       particles->create(p.second * parameters.testparticles, p.first);
+      multiplicities.push_back(p.second * parameters.testparticles);
       logg[LSphere].debug("Particle ", p.first, " initial multiplicity ",
                           p.second);
     }
   }
-  std::unique_ptr<QuantumSampling> quantum_sampling;
-  if (this->init_distr_ == SphereInitialCondition::ThermalMomentaQuantum) {
-    quantum_sampling = std::make_unique<QuantumSampling>(init_multipl_, V, T);
+  // The sampler only depends on fixed parameters and is reused in all events
+  if (this->init_distr_ == SphereInitialCondition::ThermalMomentaQuantum &&
+      !quantum_sampling_) {
+    quantum_sampling_ = std::make_unique<QuantumSampling>(
+        init_multipl_, V, T, tabulate_quantum_momenta_);
+  }
+  if (tabulate_thermal_momenta_ && !account_for_resonance_widths_ &&
+      (init_distr_ == SphereInitialCondition::ThermalMomentaBoltzmann ||
+       init_distr_ == SphereInitialCondition::IC_Massive) &&
+      !thermal_momentum_sampler_) {
+    // One table per species
+    thermal_momentum_sampler_ = std::make_unique<ThermalMomentumSampler>(
+        init_distr_ == SphereInitialCondition::IC_Massive
+            ? ThermalMomentumSampler::Distribution::NonEquilibriumMass
+            : ThermalMomentumSampler::Distribution::Thermal,
+        std::max<std::size_t>(multiplicities.size(), 1));
   }
   /* loop over particle data to fill in momentum and position information */
-  for (ParticleData &data : *particles) {
-    Angles phitheta;
-    /* thermal momentum according Maxwell-Boltzmann distribution */
-    double momentum_radial = 0.0, mass = data.pole_mass();
-    /* assign momentum_radial according to requested distribution */
-    switch (init_distr_) {
-      case (SphereInitialCondition::IC_ES):
-        momentum_radial = sample_momenta_IC_ES(T);
-        break;
-      case (SphereInitialCondition::IC_1M):
-        momentum_radial = sample_momenta_1M_IC(T, mass);
-        break;
-      case (SphereInitialCondition::IC_2M):
-        momentum_radial = sample_momenta_2M_IC(T, mass);
-        break;
-      case (SphereInitialCondition::IC_Massive):
-        momentum_radial = sample_momenta_non_eq_mass(T, mass);
-        break;
-      case (SphereInitialCondition::ThermalMomentaBoltzmann):
-      default:
-        mass = (!account_for_resonance_widths_)
-                   ? data.type().mass()
-                   : HadronGasEos::sample_mass_thermal(data.type(), 1.0 / T);
-        momentum_radial = sample_momenta_from_thermal(T, mass);
-        break;
-      case (SphereInitialCondition::ThermalMomentaQuantum):
-        /*
-         * **********************************************************************
-         * Sampling the thermal momentum according Bose/Fermi/Boltzmann
-         * distribution.
-         * We take the pole mass as the mass.
-         * **********************************************************************
-         */
-        mass = data.type().mass();
-        momentum_radial = quantum_sampling->sample(data.pdgcode());
-        break;
+  if (sampling_thread_pool_) {
+    if (thermal_mass_sampler_ && account_for_resonance_widths_ &&
+        init_distr_ == SphereInitialCondition::ThermalMomentaBoltzmann) {
+      for (const ParticleData &data : *particles) {
+        thermal_mass_sampler_->prepare(data.type());
+      }
+    }
+    sample_species_concurrently(
+        particles, multiplicities, *sampling_thread_pool_,
+        [this](ParticleData &data) { sample_phase_space(data); });
+  } else {
+    for (ParticleData &data : *particles) {
+      sample_phase_space(data);
     }
-    phitheta.distribute_isotropically();
-    logg[LSphere].debug(data.type().name(), "(id ", data.id(),
-                        ") radial momentum ", momentum_radial, ", direction",
-                        phitheta);
-    data.set_4momentum(mass, phitheta.threevec() * momentum_radial);
+  }
+  for (const ParticleData &data : *particles) {
     momentum_total += data.momentum();
-    /* uniform sampling in a sphere with radius r */
-    double position_radial;
-    position_radial = std::cbrt(random::canonical()) * radius_;
-    Angles pos_phitheta;
-    pos_phitheta.distribute_isotropically();
-    data.set_4position(
-        FourVector(start_time_, pos_phitheta.threevec() * position_radial));
-    data.set_formation_time(start_time_);
   }
 
   /* Boost in radial direction with an underlying velocity field of the form
@@ -312,4 +313,65 @@ double SphereModus::initial_conditions(Particles *particles,
                         << momentum_total;
   return start_time_;
 }
+
+void SphereModus::sample_phase_space(ParticleData &data) {
+  const double T = this->sphere_temperature_;
+  Angles phitheta;
+  /* thermal momentum according Maxwell-Boltzmann distribution */
+  double momentum_radial = 0.0, mass = data.pole_mass();
+  /* assign momentum_radial according to requested distribution */
+  switch (init_distr_) {
+    case (SphereInitialCondition::IC_ES):
+      momentum_radial = sample_momenta_IC_ES(T);
+      break;
+    case (SphereInitialCondition::IC_1M):
+      momentum_radial = sample_momenta_1M_IC(T, mass);
+      break;
+    case (SphereInitialCondition::IC_2M):
+      momentum_radial = sample_momenta_2M_IC(T, mass);
+      break;
+    case (SphereInitialCondition::IC_Massive):
+      momentum_radial = thermal_momentum_sampler_
+                            ? thermal_momentum_sampler_->sample(T, mass)
+                            : sample_momenta_non_eq_mass(T, mass);
+      break;
+    case (SphereInitialCondition::ThermalMomentaBoltzmann):
+    default:
+      if (!account_for_resonance_widths_) {
+        mass = data.type().mass();
+      } else if (thermal_mass_sampler_) {
+        mass = thermal_mass_sampler_->sample(data.type());
+      } else {
+        mass = HadronGasEos::sample_mass_thermal(data.type(), 1.0 / T);
+      }
+      momentum_radial = thermal_momentum_sampler_
+                            ? thermal_momentum_sampler_->sample(T, mass)
+                            : sample_momenta_from_thermal(T, mass);
+      break;
+    case (SphereInitialCondition::ThermalMomentaQuantum):
+      /*
+       * **********************************************************************
+       * Sampling the thermal momentum according Bose/Fermi/Boltzmann
+       * distribution.
+       * We take the pole mass as the mass.
+       * **********************************************************************
+       */
+      mass = data.type().mass();
+      momentum_radial = quantum_sampling_->sample(data.pdgcode());
+      break;
+  }
+  phitheta.distribute_isotropically();
+  logg[LSphere].debug(data.type().name(), "(id ", data.id(),
+                      ") radial momentum ", momentum_radial, ", direction",
+                      phitheta);
+  data.set_4momentum(mass, phitheta.threevec() * momentum_radial);
+  /* uniform sampling in a sphere with radius r */
+  double position_radial;
+  position_radial = std::cbrt(random::canonical()) * radius_;
+  Angles pos_phitheta;
+  pos_phitheta.distribute_isotropically();
+  data.set_4position(
+      FourVector(start_time_, pos_phitheta.threevec() * position_radial));
+  data.set_formation_time(start_time_);
+}
 }  // namespace smash
@@ -139,10 +139,22 @@ std::string to_string(TimeStepMode mode) {
       return "None";
     case TimeStepMode::Fixed:
       return "Fixed";
+    case TimeStepMode::Adaptive:
+      return "Adaptive";
   }
   throw_unhandled_enum("TimeStepMode", static_cast<int>(mode));
 }
 
+std::string to_string(ActionQueue queue) {
+  switch (queue) {
+    case ActionQueue::BinaryHeap:
+      return "BinaryHeap";
+    case ActionQueue::Calendar:
+      return "Calendar";
+  }
+  throw_unhandled_enum("ActionQueue", static_cast<int>(queue));
+}
+
 std::string to_string(BoxInitialCondition cond) {
   switch (cond) {
     case BoxInitialCondition::ThermalMomentaBoltzmann:
@@ -9,10 +9,14 @@
 
 #include "smash/stringprocess.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <string>
 
 #include "smash/angles.h"
 #include "smash/kinematics.h"
+#include "smash/lundztable.h"
 #include "smash/pow.h"
 #include "smash/random.h"
 
@@ -84,6 +88,186 @@ StringProcess::StringProcess(
   }
 
   final_state_.clear();
+
+  for (std::atomic<const DiffractiveTable *> &slot : diffractive_slots_) {
+    slot.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+std::array<double, 3> StringProcess::shared_cross_sections_diffractive(
+    int pdg_a, int pdg_b, double sqrt_s) {
+  if (!tabulate_diffractive_) {
+    return checkout()->cross_sections_diffractive(pdg_a, pdg_b, sqrt_s);
+  }
+  const DiffractiveTable &table = diffractive_table(pdg_a, pdg_b);
+  // Below the threshold, the cross sections are those at the threshold
+  const double x =
+      std::max(0., std::log(sqrt_s / table.first_sqrts) /
+                       diffractive_log_sqrts_spacing_);
+  if (x >= diffractive_table_size_ - 1) {
+    return checkout()->cross_sections_diffractive(pdg_a, pdg_b, sqrt_s);
+  }
+  const int i = static_cast<int>(x);
+  const double w = x - i;
+  std::array<double, 3> xs;
+  for (int k = 0; k < 3; k++) {
+    xs[k] = (1. - w) * table.nodes[i][k] + w * table.nodes[i + 1][k];
+  }
+  return xs;
+}
+
+int StringProcess::pythia_id_index(int pdg) {
+  // The decimal PDG ids of the (anti)proton, (anti)neutron, pions and e-/e+
+  switch (pdg) {
+    case 2212:
+      return 0;
+    case -2212:
+      return 1;
+    case 2112:
+      return 2;
+    case -2112:
+      return 3;
+    case 211:
+      return 4;
+    case -211:
+      return 5;
+    case 11:
+      return 6;
+    case -11:
+      return 7;
+    default:
+      throw std::invalid_argument("PDG id " + std::to_string(pdg) +
+                                  " is not used in PYTHIA.");
+  }
+}
+
+const StringProcess::DiffractiveTable &StringProcess::diffractive_table(
+    int pdg_a, int pdg_b) {
+  std::atomic<const DiffractiveTable *> &slot =
+      diffractive_slots_[pythia_id_index(pdg_a) * n_pythia_ids_ +
+                         pythia_id_index(pdg_b)];
+  const DiffractiveTable *found = slot.load(std::memory_order_acquire);
+  if (found) {
+    return *found;
+  }
+  std::lock_guard<std::mutex> lock(diffractive_mutex_);
+  // Another thread may have created the table in the meantime
+  found = slot.load(std::memory_order_relaxed);
+  if (found) {
+    return *found;
+  }
+  const Lease process = checkout();
+  auto created = std::make_unique<DiffractiveTable>();
+  created->first_sqrts = process->diffractive_threshold(pdg_a, pdg_b);
+  created->nodes.reserve(diffractive_table_size_);
+  for (int i = 0; i < diffractive_table_size_; i++) {
+    const double sqrts =
+        created->first_sqrts * std::exp(i * diffractive_log_sqrts_spacing_);
+    created->nodes.push_back(
+        process->cross_sections_diffractive(pdg_a, pdg_b, sqrts));
+  }
+  diffractive_tables_.push_back(std::move(created));
+  slot.store(diffractive_tables_.back().get(), std::memory_order_release);
+  return *diffractive_tables_.back();
+}
+
+StringProcess::Lease StringProcess::checkout() {
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (!checked_out_) {
+      checked_out_ = true;
+      return Lease(*this, *this);
+    }
+    if (!idle_spares_.empty()) {
+      StringProcess *spare = idle_spares_.back();
+      idle_spares_.pop_back();
+      return Lease(*this, *spare);
+    }
+  }
+  // The initialization of PYTHIA is slow, hence it is done without the lock
+  auto spare = std::make_unique<StringProcess>(
+      kappa_tension_string_, time_formation_const_, pow_fgluon_beta_,
+      pmin_gluon_lightcone_, pow_fquark_alpha_, pow_fquark_beta_,
+      strange_supp_, diquark_supp_, sigma_qperp_, stringz_a_leading_,
+      stringz_b_leading_, stringz_a_produce_, stringz_b_produce_,
+      string_sigma_T_, soft_t_form_, mass_dependent_formation_times_,
+      prob_proton_to_d_uu_, separate_fragment_baryon_, popcorn_rate_,
+      use_monash_tune_);
+  StringProcess &process = *spare;
+  if (!preinitialized_pairs_.empty()) {
+    spare->preinitialized_pairs_ = preinitialized_pairs_;
+    spare->preinitialization_sqrts_ = preinitialization_sqrts_;
+    for (const std::pair<int, int> &idAB : preinitialized_pairs_) {
+      spare->hard_pythia(idAB, preinitialization_sqrts_);
+    }
+  }
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  spares_.push_back(std::move(spare));
+  return Lease(*this, process);
+}
+
+void StringProcess::release(StringProcess *process) {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  if (process == this) {
+    checked_out_ = false;
+  } else {
+    idle_spares_.push_back(process);
+  }
+}
+
+void StringProcess::preinitialize_hard_pythia(
+    const std::vector<std::pair<PdgCode, PdgCode>> &pairs, double sqrts) {
+  for (std::pair<PdgCode, PdgCode> pair : pairs) {
+    const int id_a = pdg_map_for_pythia(pair.first),
+              id_b = pdg_map_for_pythia(pair.second);
+    for (const std::pair<int, int> &idAB :
+         {std::pair<int, int>{id_a, id_b}, std::pair<int, int>{id_b, id_a}}) {
+      if (std::find(preinitialized_pairs_.begin(), preinitialized_pairs_.end(),
+                    idAB) == preinitialized_pairs_.end()) {
+        preinitialized_pairs_.push_back(idAB);
+      }
+    }
+  }
+  preinitialization_sqrts_ = sqrts;
+  for (const std::pair<int, int> &idAB : preinitialized_pairs_) {
+    hard_pythia(idAB, sqrts);
+  }
+}
+
+Pythia8::Pythia &StringProcess::hard_pythia(const std::pair<int, int> &idAB,
+                                            double sqrts) {
+  std::unique_ptr<Pythia8::Pythia> &pythia = hard_map_[idAB];
+  if (pythia) {
+    return *pythia;
+  }
+  if (!hard_template_) {
+    hard_template_ = std::make_unique<Pythia8::Pythia>(PYTHIA_XML_DIR, false);
+    hard_template_->readString("SoftQCD:nonDiffractive = on");
+    hard_template_->readString("MultipartonInteractions:pTmin = 1.5");
+    hard_template_->readString("HadronLevel:all = off");
+
+    common_setup_pythia(hard_template_.get(), strange_supp_, diquark_supp_,
+                        popcorn_rate_, stringz_a_produce_, stringz_b_produce_,
+                        string_sigma_T_);
+
+    hard_template_->settings.flag("Beams:allowVariableEnergy", true);
+  }
+  // Copying the databases is much faster than reading the XML files again
+  pythia = std::make_unique<Pythia8::Pythia>(
+      hard_template_->settings, hard_template_->particleData, false);
+
+  pythia->settings.mode("Beams:idA", idAB.first);
+  pythia->settings.mode("Beams:idB", idAB.second);
+  pythia->settings.parm("Beams:eCM", sqrts);
+
+  logg[LPythia].debug("Pythia object initialized with ", idAB.first, " + ",
+                      idAB.second, " at CM energy [GeV] ", sqrts);
+
+  if (!pythia->init()) {
+    hard_map_.erase(idAB);
+    throw std::runtime_error("Pythia failed to initialize.");
+  }
+  return *pythia;
 }
 
 void StringProcess::common_setup_pythia(Pythia8::Pythia *pythia_in,
@@ -171,8 +355,10 @@ int StringProcess::append_final_state(ParticleList &intermediate_particles,
   assign_all_scaling_factors(bstring, intermediate_particles, evecLong,
                              additional_xsec_supp_);
 
-  // Velocity three-vector to perform Lorentz boost.
-  const ThreeVector vstring = uString.velocity();
+  // Lorentz boosts from the rest frame of the string to the center of mass
+  // frame and from there to the lab frame
+  const LorentzBoost from_string_frame(-uString.velocity());
+  const LorentzBoost to_lab_frame(-vcomAB_);
 
   // compute the formation times of hadrons
   for (int i = 0; i < nfrag; i++) {
@@ -180,7 +366,7 @@ int StringProcess::append_final_state(ParticleList &intermediate_particles,
     double gamma = 1. / intermediate_particles[i].inverse_gamma();
     // boost 4-momentum into the center of mass frame
     FourVector momentum =
-        intermediate_particles[i].momentum().lorentz_boost(-vstring);
+        from_string_frame(intermediate_particles[i].momentum());
     intermediate_particles[i].set_4momentum(momentum);
 
     if (mass_dependent_formation_times_) {
@@ -191,13 +377,12 @@ int StringProcess::append_final_state(ParticleList &intermediate_particles,
       FourVector fragment_position = FourVector(t_prod, t_prod * velocity);
       /* boost formation position into the center of mass frame
        * and then into the lab frame */
-      fragment_position = fragment_position.lorentz_boost(-vstring);
-      fragment_position = fragment_position.lorentz_boost(-vcomAB_);
+      fragment_position = to_lab_frame(from_string_frame(fragment_position));
       intermediate_particles[i].set_slow_formation_times(
           time_collision_,
           soft_t_form_ * fragment_position.x0() + time_collision_);
     } else {
-      ThreeVector v_calc = momentum.lorentz_boost(-vcomAB_).velocity();
+      ThreeVector v_calc = to_lab_frame(momentum).velocity();
       double gamma_factor = 1.0 / std::sqrt(1 - (v_calc).sqr());
       intermediate_particles[i].set_slow_formation_times(
           time_collision_,
@@ -299,16 +484,14 @@ bool StringProcess::next_SDiff(bool is_AB_to_AX) {
   const FourVector prs = pnull.lorentz_boost(ustrXcom.velocity());
   ThreeVector evec = prs.threevec() / prs.threevec().abs();
   // perform fragmentation and add particles to final_state.
-  ParticleList new_intermediate_particles;
   int nfrag = fragment_string(idqX1, idqX2, massX, evec, true, false,
-                              new_intermediate_particles);
+                              intermediate_particles_);
   if (nfrag < 1) {
     NpartString_[0] = 0;
     return false;
   }
 
-  NpartString_[0] =
-      append_final_state(new_intermediate_particles, ustrXcom, evec);
+  NpartString_[0] = append_final_state(intermediate_particles_, ustrXcom, evec);
 
   NpartString_[1] = 1;
   PdgCode hadron_code = is_AB_to_AX ? PDGcodes_[0] : PDGcodes_[1];
@@ -368,21 +551,19 @@ bool StringProcess::make_final_state_2strings(
   const std::array<FourVector, 2> ustr_com = {pstr_com[0] / m_str[0],
                                               pstr_com[1] / m_str[1]};
   for (int i = 0; i < 2; i++) {
-    ParticleList new_intermediate_particles;
-
     // determine direction in which string i is stretched.
     ThreeVector evec = evec_str[i];
     // perform fragmentation and add particles to final_state.
     int nfrag = fragment_string(quarks[i][0], quarks[i][1], m_str[i], evec,
                                 flip_string_ends, separate_fragment_baryon,
-                                new_intermediate_particles);
+                                intermediate_particles_);
     if (nfrag <= 0) {
       NpartString_[i] = 0;
       return false;
     }
 
     NpartString_[i] =
-        append_final_state(new_intermediate_particles, ustr_com[i], evec);
+        append_final_state(intermediate_particles_, ustr_com[i], evec);
     assert(nfrag == NpartString_[i]);
   }
   if ((NpartString_[0] > 0) && (NpartString_[1] > 0)) {
@@ -565,30 +746,7 @@ bool StringProcess::next_NDiffHard() {
 
   // If an entry for the calculated particle IDs does not exist, create one and
   // initialize it accordingly
-  if (hard_map_.count(idAB) == 0) {
-    hard_map_[idAB] = std::make_unique<Pythia8::Pythia>(PYTHIA_XML_DIR, false);
-    hard_map_[idAB]->readString("SoftQCD:nonDiffractive = on");
-    hard_map_[idAB]->readString("MultipartonInteractions:pTmin = 1.5");
-    hard_map_[idAB]->readString("HadronLevel:all = off");
-
-    common_setup_pythia(hard_map_[idAB].get(), strange_supp_, diquark_supp_,
-                        popcorn_rate_, stringz_a_produce_, stringz_b_produce_,
-                        string_sigma_T_);
-
-    hard_map_[idAB]->settings.flag("Beams:allowVariableEnergy", true);
-
-    hard_map_[idAB]->settings.mode("Beams:idA", idAB.first);
-    hard_map_[idAB]->settings.mode("Beams:idB", idAB.second);
-    hard_map_[idAB]->settings.parm("Beams:eCM", sqrtsAB_);
-
-    logg[LPythia].debug("Pythia object initialized with ", pdg_for_pythia[0],
-                        " + ", pdg_for_pythia[1], " at CM energy [GeV] ",
-                        sqrtsAB_);
-
-    if (!hard_map_[idAB]->init()) {
-      throw std::runtime_error("Pythia failed to initialize.");
-    }
-  }
+  hard_pythia(idAB, sqrtsAB_);
 
   const int seed_new = random::uniform_int(1, maximum_rndm_seed_in_pythia);
   hard_map_[idAB]->rndm.init(seed_new);
@@ -609,8 +767,7 @@ bool StringProcess::next_NDiffHard() {
     return false;
   }
 
-  ParticleList new_intermediate_particles;
-  ParticleList new_non_hadron_particles;
+  non_hadron_particles_.clear();
 
   Pythia8::Vec4 pSum = 0.;
   event_intermediate_.reset();
@@ -667,7 +824,7 @@ bool StringProcess::next_NDiffHard() {
       FourVector momentum = reorient(event_intermediate_[ipart], evecBasisAB_);
       logg[LPythia].debug("4-momentum from Pythia: ", momentum);
       bool found_ptype =
-          append_intermediate_list(pdgid, momentum, new_non_hadron_particles);
+          append_intermediate_list(pdgid, momentum, non_hadron_particles_);
       if (!found_ptype) {
         logg[LPythia].warn("PDG ID ", pdgid,
                            " does not exist in ParticleType - start over.");
@@ -709,7 +866,7 @@ bool StringProcess::next_NDiffHard() {
     hadronize_success = pythia_hadron_->forceHadronLevel(false);
     logg[LPythia].debug("Pythia hadronized, success = ", hadronize_success);
 
-    new_intermediate_particles.clear();
+    intermediate_particles_.clear();
     if (hadronize_success) {
       for (int i = 0; i < event_hadron.size(); i++) {
         if (event_hadron[i].isFinal()) {
@@ -733,10 +890,10 @@ bool StringProcess::next_NDiffHard() {
           bool found_ptype = false;
           if (event_hadron[i].isHadron()) {
             found_ptype = append_intermediate_list(pythia_id, momentum,
-                                                   new_intermediate_particles);
+                                                   intermediate_particles_);
           } else {
             found_ptype = append_intermediate_list(pythia_id, momentum,
-                                                   new_non_hadron_particles);
+                                                   non_hadron_particles_);
           }
           if (!found_ptype) {
             logg[LPythia].warn("PDG ID ", pythia_id,
@@ -755,7 +912,7 @@ bool StringProcess::next_NDiffHard() {
 
     FourVector uString = FourVector(1., 0., 0., 0.);
     ThreeVector evec = find_forward_string ? evecBasisAB_[0] : -evecBasisAB_[0];
-    int nfrag = append_final_state(new_intermediate_particles, uString, evec);
+    int nfrag = append_final_state(intermediate_particles_, uString, evec);
     NpartFinal_ += nfrag;
 
     find_forward_string = !find_forward_string;
@@ -763,7 +920,7 @@ bool StringProcess::next_NDiffHard() {
 
   if (hadronize_success) {
     // add the final state particles, which are not hadron.
-    for (ParticleData data : new_non_hadron_particles) {
+    for (ParticleData data : non_hadron_particles_) {
       data.set_cross_section_scaling_factor(1.);
       data.set_formation_time(time_collision_);
       final_state_.push_back(data);
@@ -968,6 +1125,7 @@ bool StringProcess::splitting_gluon_qqbar(
         /* find the most forward or backward gluon
          * depending on which incoming hadron is found to be an issue. */
         int iforward = 1;
+        double y_gluon_forward = event_intermediate[iforward].y();
         for (int ip = 2; ip < event_intermediate.size(); ip++) {
           if (!event_intermediate[ip].isFinal() ||
               !event_intermediate[ip].isGluon()) {
@@ -975,10 +1133,10 @@ bool StringProcess::splitting_gluon_qqbar(
           }
 
           const double y_gluon_current = event_intermediate[ip].y();
-          const double y_gluon_forward = event_intermediate[iforward].y();
           if ((ih_mod == 0 && y_gluon_current > y_gluon_forward) ||
               (ih_mod == 1 && y_gluon_current < y_gluon_forward)) {
             iforward = ip;
+            y_gluon_forward = y_gluon_current;
           }
         }
 
@@ -1372,7 +1530,8 @@ void StringProcess::compose_string_junction(bool &find_forward_string,
    * to make a color-neutral anti-baryonic configuration. */
   const int kind = event_intermediate.kindJunction(0);
   bool sign_color = kind % 2 == 1;
-  std::vector<int> col;  // color or anti-color indices of the junction legs
+  std::vector<int> &col = junction_legs_;  // color indices of the legs
+  col.clear();
   for (int j = 0; j < 3; j++) {
     col.push_back(event_intermediate.colJunction(0, j));
   }
@@ -1394,7 +1553,8 @@ void StringProcess::compose_string_junction(bool &find_forward_string,
        * look over junctions and find connected ones. */
       logg[LPythia].debug("  still has leg(s) unfinished.");
       sign_color = !sign_color;
-      std::vector<int> junction_to_move;
+      std::vector<int> &junction_to_move = junctions_to_move_;
+      junction_to_move.clear();
       for (int i = 0; i < event_intermediate.sizeJunction(); i++) {
         const int kind_new = event_intermediate.kindJunction(i);
         /* If the original junction is associated with positive baryon number,
@@ -1618,18 +1778,16 @@ bool StringProcess::next_BBbarAnn() {
   }
   // Fragment two strings
   for (int i = 0; i < 2; i++) {
-    ParticleList new_intermediate_particles;
-
     ThreeVector evec = pcom_[i].threevec() / pcom_[i].threevec().abs();
     const int nfrag =
         fragment_string(remaining_quarks[i], remaining_antiquarks[i], mstr[i],
-                        evec, true, false, new_intermediate_particles);
+                        evec, true, false, intermediate_particles_);
     if (nfrag <= 0) {
       NpartString_[i] = 0;
       return false;
     }
     NpartString_[i] =
-        append_final_state(new_intermediate_particles, ustrcom[i], evec);
+        append_final_state(intermediate_particles_, ustrcom[i], evec);
   }
   NpartFinal_ = NpartString_[0] + NpartString_[1];
   return true;
@@ -2851,6 +3009,12 @@ bool StringProcess::make_lightcone_final_two(
 }
 
 double StringProcess::sample_zLund(double a, double b, double mTrn) {
+  if (tabulated_lund_z_) {
+    const double xfrac = LundZTable::find(a).sample(b * mTrn * mTrn);
+    if (!std::isnan(xfrac)) {
+      return xfrac;
+    }
+  }
   // the lightcone momentum fraction x
   double xfrac = 0.;
   bool xfrac_accepted = false;
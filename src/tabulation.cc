@@ -17,11 +17,14 @@ Tabulation::Tabulation(double x_min, double range, size_t num,
   if (num < 2) {
     throw std::runtime_error("Tabulation needs at least two values");
   }
-  values_.resize(num + 1);
+  auto values = std::make_shared<std::vector<double>>(num + 1);
   const double dx = range / num;
   for (size_t i = 0; i <= num; i++) {
-    values_[i] = f(x_min_ + i * dx);
+    (*values)[i] = f(x_min_ + i * dx);
   }
+  values_ = values->data();
+  n_values_ = values->size();
+  storage_ = std::move(values);
 }
 
 double Tabulation::get_value_step(double x) const {
@@ -30,8 +33,8 @@ double Tabulation::get_value_step(double x) const {
   }
   const unsigned int n =
       numeric_cast<unsigned int>(std::floor((x - x_min_) * inv_dx_ + 0.5));
-  if (n >= values_.size()) {
-    return values_.back();
+  if (n >= n_values_) {
+    return values_[n_values_ - 1];
   } else {
     return values_[n];
   }
@@ -45,12 +48,12 @@ double Tabulation::get_value_linear(double x, Extrapolation extrapol) const {
     return 0.0;
   }
   if (extrapol == Extrapolation::Const && x > x_max_) {
-    return values_.back();
+    return values_[n_values_ - 1];
   }
   const double index_double = (x - x_min_) * inv_dx_;
   // here n is the lower index
   const size_t n =
-      std::min(static_cast<size_t>(index_double), values_.size() - 2);
+      std::min(static_cast<size_t>(index_double), n_values_ - 2);
   const double r = index_double - n;
   return values_[n] + (values_[n + 1] - values_[n]) * r;
 }
@@ -110,13 +113,13 @@ static size_t sread_size(std::ifstream& stream) {
  * Write binary representation to stream.
  *
  * \param stream Output stream.
- * \param x Value to be written.
+ * \param x Values to be written.
+ * \param n Number of values.
  */
-static void swrite(std::ofstream& stream, const std::vector<double> x) {
-  swrite(stream, x.size());
-  if (x.size() > 0) {
-    stream.write(reinterpret_cast<const char*>(x.data()),
-                 sizeof(x[0]) * x.size());
+static void swrite(std::ofstream& stream, const double* x, size_t n) {
+  swrite(stream, n);
+  if (n > 0) {
+    stream.write(reinterpret_cast<const char*>(x), sizeof(x[0]) * n);
   }
 }
 
@@ -163,7 +166,7 @@ void Tabulation::write(std::ofstream& stream, sha256::Hash hash) const {
   swrite(stream, x_min_);
   swrite(stream, x_max_);
   swrite(stream, inv_dx_);
-  swrite(stream, values_);
+  swrite(stream, values_, n_values_);
 }
 
 Tabulation Tabulation::from_file(std::ifstream& stream, sha256::Hash hash) {
@@ -175,7 +178,10 @@ Tabulation Tabulation::from_file(std::ifstream& stream, sha256::Hash hash) {
   t.x_min_ = sread_double(stream);
   t.x_max_ = sread_double(stream);
   t.inv_dx_ = sread_double(stream);
-  t.values_ = sread_vector(stream);
+  auto values = std::make_shared<std::vector<double>>(sread_vector(stream));
+  t.values_ = values->data();
+  t.n_values_ = values->size();
+  t.storage_ = std::move(values);
   return t;
 }
 
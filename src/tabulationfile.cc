@@ -0,0 +1,183 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/tabulationfile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "smash/file.h"
+
+namespace smash {
+
+namespace {
+
+/// Magic number at the start of the file
+constexpr char magic[4] = {'S', 'M', 'T', 'B'};
+/// Version of the layout of the file
+constexpr std::uint32_t format_version = 1;
+/// Alignment of the arrays of values in bytes
+constexpr std::uint64_t alignment = 64;
+/// Size of the header: magic number, version, hash and number of entries
+constexpr std::uint64_t header_size = 4 + 4 + sizeof(sha256::Hash) + 8;
+
+/**
+ * \param[in] n A number of bytes.
+ * \return The smallest multiple of the alignment, which is not below \p n.
+ */
+constexpr std::uint64_t aligned(std::uint64_t n) {
+  return (n + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Copy a value from the mapped file, checking that it lies in the file.
+ *
+ * \param[in] data The mapped file.
+ * \param[in] size Size of the file.
+ * \param[inout] position Position of the value, it is moved past the value.
+ * \param[out] value The value.
+ * \return Whether the value lies in the file.
+ */
+template <typename T>
+bool get(const char *data, std::size_t size, std::size_t &position, T &value) {
+  if (size - position < sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&value, data + position, sizeof(T));
+  position += sizeof(T);
+  return true;
+}
+
+/**
+ * \param[in] file The file.
+ * \param[in] value The value to be written.
+ */
+template <typename T>
+void put(FILE *file, const T &value) {
+  std::fwrite(&value, sizeof(T), 1, file);
+}
+
+}  // unnamed namespace
+
+std::unique_ptr<TabulationFile> TabulationFile::open(
+    const std::filesystem::path &path, const sha256::Hash &hash) {
+  const int fd = ::open(path.native().c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat file_status;
+  if (fstat(fd, &file_status) != 0 || file_status.st_size < 1) {
+    close(fd);
+    return nullptr;
+  }
+  const auto size = static_cast<std::size_t>(file_status.st_size);
+  void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after the file is closed
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+  auto file = std::make_unique<TabulationFile>();
+  file->mapping_ = std::shared_ptr<const char>(
+      static_cast<const char *>(mapping),
+      [size](const char *data) { munmap(const_cast<char *>(data), size); });
+
+  const char *data = file->mapping_.get();
+  std::size_t position = 0;
+  char file_magic[4];
+  std::uint32_t version;
+  sha256::Hash file_hash;
+  std::uint64_t n_entries;
+  if (!get(data, size, position, file_magic) ||
+      std::memcmp(file_magic, magic, 4) != 0 ||
+      !get(data, size, position, version) || version != format_version ||
+      !get(data, size, position, file_hash) || file_hash != hash ||
+      !get(data, size, position, n_entries)) {
+    return nullptr;
+  }
+  for (std::uint64_t i = 0; i < n_entries; i++) {
+    std::uint32_t name_length;
+    if (!get(data, size, position, name_length) ||
+        size - position < name_length) {
+      return nullptr;
+    }
+    std::string name(data + position, name_length);
+    position += name_length;
+    std::uint64_t offset, n_values;
+    Entry entry;
+    if (!get(data, size, position, offset) ||
+        !get(data, size, position, n_values) ||
+        !get(data, size, position, entry.x_min) ||
+        !get(data, size, position, entry.x_max) ||
+        !get(data, size, position, entry.inv_dx) || offset % alignment != 0 ||
+        n_values < 2 || offset > size ||
+        (size - offset) / sizeof(double) < n_values) {
+      return nullptr;
+    }
+    entry.offset = offset;
+    entry.n_values = n_values;
+    file->entries_.emplace(std::move(name), entry);
+  }
+  return file;
+}
+
+void TabulationFile::write(
+    const std::filesystem::path &path, const sha256::Hash &hash,
+    const std::vector<std::pair<std::string, const Tabulation *>>
+        &tabulations) {
+  std::uint64_t directory_size = header_size;
+  for (const auto &named : tabulations) {
+    directory_size += 4 + named.first.size() + 2 * 8 + 3 * sizeof(double);
+  }
+  RenamingFilePtr renaming_file(path, "wb");
+  FILE *out = renaming_file.get();
+  std::fwrite(magic, 1, 4, out);
+  put(out, format_version);
+  put(out, hash);
+  put(out, static_cast<std::uint64_t>(tabulations.size()));
+  std::uint64_t offset = aligned(directory_size);
+  for (const auto &[name, tabulation] : tabulations) {
+    put(out, static_cast<std::uint32_t>(name.size()));
+    std::fwrite(name.data(), 1, name.size(), out);
+    put(out, offset);
+    put(out, static_cast<std::uint64_t>(tabulation->n_values_));
+    put(out, tabulation->x_min_);
+    put(out, tabulation->x_max_);
+    put(out, tabulation->inv_dx_);
+    offset = aligned(offset + tabulation->n_values_ * sizeof(double));
+  }
+  const char padding[alignment] = {};
+  std::uint64_t position = directory_size;
+  for (const auto &named : tabulations) {
+    const Tabulation &tabulation = *named.second;
+    std::fwrite(padding, 1, aligned(position) - position, out);
+    std::fwrite(tabulation.values_, sizeof(double), tabulation.n_values_, out);
+    position = aligned(position) + tabulation.n_values_ * sizeof(double);
+  }
+}
+
+Tabulation TabulationFile::find(const std::string &name) const {
+  const auto found = entries_.find(name);
+  if (found == entries_.end()) {
+    return Tabulation();
+  }
+  const Entry &entry = found->second;
+  return Tabulation(
+      mapping_,
+      reinterpret_cast<const double *>(mapping_.get() + entry.offset),
+      entry.n_values, entry.x_min, entry.x_max, entry.inv_dx);
+}
+
+}  // namespace smash
@@ -0,0 +1,98 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/taskgraph.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace smash {
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> task,
+                                 const std::vector<TaskId> &dependencies) {
+  const TaskId id = nodes_.size();
+  for (const TaskId dependency : dependencies) {
+    if (dependency >= id) {
+      throw std::invalid_argument(
+          "A task can only depend on tasks added before it.");
+    }
+  }
+  Node &node = nodes_.emplace_back();
+  node.task = std::move(task);
+  node.n_dependencies = dependencies.size();
+  for (const TaskId dependency : dependencies) {
+    nodes_[dependency].dependents.push_back(id);
+  }
+  return id;
+}
+
+void TaskGraph::run(ThreadPool *pool) const {
+  if (pool == nullptr || pool->size() < 2) {
+    for (const Node &node : nodes_) {
+      node.task();
+    }
+    return;
+  }
+  std::mutex mutex;
+  // Signals the threads that a task became ready or that all are completed
+  std::condition_variable task_ready;
+  std::vector<std::size_t> missing(nodes_.size());
+  std::deque<TaskId> ready;
+  for (TaskId id = 0; id < nodes_.size(); id++) {
+    missing[id] = nodes_[id].n_dependencies;
+    if (missing[id] == 0) {
+      ready.push_back(id);
+    }
+  }
+  std::size_t n_completed = 0;
+  std::exception_ptr first_exception = nullptr;
+  pool->parallel_for(pool->size(), [&](std::size_t) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      task_ready.wait(lock, [&]() {
+        return !ready.empty() || n_completed == nodes_.size();
+      });
+      if (ready.empty()) {
+        return;
+      }
+      const TaskId id = ready.front();
+      ready.pop_front();
+      const bool skip = first_exception != nullptr;
+      lock.unlock();
+      std::exception_ptr exception = nullptr;
+      if (!skip) {
+        try {
+          nodes_[id].task();
+        } catch (...) {
+          exception = std::current_exception();
+        }
+      }
+      lock.lock();
+      if (exception && !first_exception) {
+        first_exception = exception;
+      }
+      n_completed++;
+      for (const TaskId dependent : nodes_[id].dependents) {
+        if (--missing[dependent] == 0) {
+          ready.push_back(dependent);
+        }
+      }
+      task_ready.notify_all();
+    }
+  });
+  if (first_exception) {
+    std::rethrow_exception(first_exception);
+  }
+}
+
+}  // namespace smash
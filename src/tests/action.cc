@@ -58,6 +58,19 @@ TEST(finite_momenta) {
   VERIFY(act.transverse_distance_sqr() >= 0.);
 }
 
+// the distances do not depend on the construction of an action
+TEST(distances_without_action) {
+  const auto a =
+      Test::smashon(Position{1., 1., 1., 1.}, Momentum{0.3, 0.1, 0.2, -0.1});
+  const auto b =
+      Test::smashon(Position{1., 2., 1.5, 1.}, Momentum{0.4, -0.2, 0.1, 0.3});
+  ScatterAction act(a, b, 0.);
+  COMPARE(ScatterAction::transverse_distance_sqr(a, b),
+          act.transverse_distance_sqr());
+  COMPARE(ScatterAction::cov_transverse_distance_sqr(a, b),
+          act.cov_transverse_distance_sqr());
+}
+
 TEST(phasespace_five_body) {
   // Sample 5-body phase space repeatly and check if the average angles of one
   // of the outgoing particles matches an isotropic distribution
@@ -12,9 +12,12 @@
 #include "smash/actions.h"
 
 #include <algorithm>
+#include <stdexcept>
+#include <vector>
 
 #include "setup.h"
 #include "smash/decayaction.h"
+#include "smash/random.h"
 
 using namespace smash;
 
@@ -65,3 +68,154 @@ TEST(construct_and_insert) {
 
   VERIFY(actions.is_empty());
 }
+
+namespace {
+/// A decay of a smashon with the given id at the given time.
+ActionPtr decay_at(int id, double time) {
+  ParticleData smashon = Test::smashon(Test::Position{0., 0., 0., 0.}, id);
+  return std::make_unique<DecayAction>(smashon, time);
+}
+
+/// The ids of the decaying particles, in the order in which they are popped.
+std::vector<int> pop_all(Actions &actions) {
+  std::vector<int> ids;
+  while (!actions.is_empty()) {
+    ids.push_back(actions.pop()->incoming_particles()[0].id());
+  }
+  return ids;
+}
+}  // namespace
+
+TEST(equal_times_in_order_of_insertion) {
+  for (const ActionQueue queue :
+       {ActionQueue::BinaryHeap, ActionQueue::Calendar}) {
+    ActionList initial;
+    for (int id = 0; id < 5; id++) {
+      initial.push_back(decay_at(id, 1.));
+    }
+    Actions actions(std::move(initial), queue);
+    actions.insert(decay_at(5, 0.5));
+    actions.insert(decay_at(6, 1.));
+    COMPARE(actions.size(), 7u);
+    COMPARE(actions.earliest_time(), 0.5);
+    COMPARE(pop_all(actions), (std::vector<int>{5, 0, 1, 2, 3, 4, 6}));
+  }
+}
+
+TEST(calendar_pops_like_heap) {
+  std::vector<int> heap_ids, calendar_ids;
+  int id = 0;
+  double now = 0.;
+  // Few distinct times, such that many actions share their time
+  auto random_time = [&]() { return now + random::uniform_int(0, 40) * 0.05; };
+  ActionList initial_heap, initial_calendar;
+  for (int i = 0; i < 200; i++, id++) {
+    const double time = random_time();
+    initial_heap.push_back(decay_at(id, time));
+    initial_calendar.push_back(decay_at(id, time));
+  }
+  Actions heap(std::move(initial_heap), ActionQueue::BinaryHeap);
+  Actions calendar(std::move(initial_calendar), ActionQueue::Calendar);
+  VERIFY(calendar.queue() == ActionQueue::Calendar);
+  while (!heap.is_empty()) {
+    COMPARE(calendar.size(), heap.size());
+    COMPARE(calendar.earliest_time(), heap.earliest_time());
+    now = heap.earliest_time();
+    heap_ids.push_back(heap.pop()->incoming_particles()[0].id());
+    calendar_ids.push_back(calendar.pop()->incoming_particles()[0].id());
+    // Mimic new actions found for the outgoing particles of an action
+    if (id < 1000) {
+      const int n_new = random::uniform_int(0, 3);
+      ActionList new_heap, new_calendar;
+      for (int i = 0; i < n_new; i++, id++) {
+        const double time = random_time();
+        new_heap.push_back(decay_at(id, time));
+        new_calendar.push_back(decay_at(id, time));
+      }
+      heap.insert(std::move(new_heap));
+      calendar.insert(std::move(new_calendar));
+    }
+  }
+  VERIFY(calendar.is_empty());
+  COMPARE(calendar_ids, heap_ids);
+  COMPARE(heap_ids.size(), static_cast<std::size_t>(id));
+}
+
+TEST(move_leaves_empty) {
+  ActionList list;
+  list.push_back(decay_at(0, 1.));
+  Actions calendar(std::move(list), ActionQueue::Calendar);
+  Actions moved(std::move(calendar));
+  VERIFY(calendar.is_empty());
+  COMPARE(moved.size(), 1u);
+  // Emptied queues can be filled again
+  moved.pop();
+  moved.insert(decay_at(1, 3.));
+  moved.insert(decay_at(2, 2.));
+  COMPARE(pop_all(moved), (std::vector<int>{2, 1}));
+}
+
+TEST_CATCH(pop_empty_calendar, std::runtime_error) {
+  Actions actions(ActionQueue::Calendar);
+  actions.pop();
+}
+
+TEST(invalidated_actions_are_removed) {
+  for (const ActionQueue queue :
+       {ActionQueue::BinaryHeap, ActionQueue::Calendar}) {
+    Particles particles;
+    const ParticleData first = particles.insert(Test::smashon());
+    const ParticleData second = particles.insert(Test::smashon());
+    ActionList list;
+    list.push_back(std::make_unique<DecayAction>(first, 1.));
+    list.push_back(std::make_unique<DecayAction>(second, 3.));
+    list.push_back(std::make_unique<DecayAction>(first, 2.));
+    Actions actions(std::move(list), queue);
+    COMPARE(actions.peak_occupancy(), 3u);
+    ActionPtr performed = actions.pop();
+    COMPARE(performed->incoming_particles()[0].id(), first.id());
+    // Nothing happened to the particles yet
+    COMPARE(actions.invalidate(performed->incoming_particles(), particles), 0u);
+    COMPARE(actions.size(), 2u);
+    particles.remove(first);
+    COMPARE(actions.invalidate(performed->incoming_particles(), particles), 1u);
+    COMPARE(actions.size(), 1u);
+    COMPARE(actions.earliest_time(), 3.);
+    COMPARE(actions.pop()->incoming_particles()[0].id(), second.id());
+    VERIFY(actions.is_empty());
+    COMPARE(actions.peak_occupancy(), 3u);
+  }
+}
+
+TEST(shrink_keeps_the_order) {
+  for (const ActionQueue queue :
+       {ActionQueue::BinaryHeap, ActionQueue::Calendar}) {
+    Particles particles;
+    ParticleList removed;
+    ActionList list;
+    for (int i = 0; i < 200; i++) {
+      const ParticleData p = particles.insert(Test::smashon());
+      list.push_back(std::make_unique<DecayAction>(p, 1. + (i * 37) % 200));
+      if (i % 2 == 0) {
+        removed.push_back(p);
+      }
+    }
+    Actions actions(std::move(list), queue);
+    for (const ParticleData &p : removed) {
+      particles.remove(p);
+    }
+    // Too few removed actions are not dropped by invalidate()
+    COMPARE(actions.invalidate(removed, particles), 100u);
+    const std::size_t before = actions.memory_usage();
+    actions.shrink();
+    VERIFY(actions.memory_usage() < before);
+    COMPARE(actions.size(), 100u);
+    double previous = 0.;
+    while (!actions.is_empty()) {
+      const ActionPtr action = actions.pop();
+      VERIFY(action->time_of_execution() > previous);
+      VERIFY(action->incoming_particles()[0].id() % 2 == 1);
+      previous = action->time_of_execution();
+    }
+  }
+}
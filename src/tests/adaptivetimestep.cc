@@ -0,0 +1,66 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/adaptivetimestep.h"
+
+#include <stdexcept>
+
+using namespace smash;
+
+namespace {
+AdaptiveTimeStepParameters default_parameters() {
+  return {0.01, 1.0, 2.0, 0.1, 0.1, 0.1};
+}
+}  // namespace
+
+TEST_CATCH(minimum_above_maximum, std::invalid_argument) {
+  AdaptiveTimeStepParameters parameters = default_parameters();
+  parameters.min_timestep = 2.0;
+  AdaptiveTimeStep rule(parameters);
+}
+
+TEST_CATCH(growth_factor_below_one, std::invalid_argument) {
+  AdaptiveTimeStepParameters parameters = default_parameters();
+  parameters.max_growth_factor = 0.5;
+  AdaptiveTimeStep rule(parameters);
+}
+
+TEST(quiet_step_grows_by_factor) {
+  const AdaptiveTimeStep rule(default_parameters());
+  COMPARE(rule.next_timestep(0.1, TimeStepObservation{}), 0.2);
+  // The maximum is not exceeded
+  COMPARE(rule.next_timestep(0.8, TimeStepObservation{}), 1.0);
+}
+
+TEST(shrinks_with_interaction_rate) {
+  const AdaptiveTimeStep rule(default_parameters());
+  TimeStepObservation observed;
+  observed.n_particles = 100;
+  // 0.4 interactions per particle, 4 times the target
+  observed.n_interactions = 40;
+  FUZZY_COMPARE(rule.next_timestep(0.2, observed), 0.05);
+  // Few interactions let the step grow, but not beyond the growth factor
+  observed.n_interactions = 1;
+  FUZZY_COMPARE(rule.next_timestep(0.2, observed), 0.4);
+}
+
+TEST(density_change_and_potentials) {
+  const AdaptiveTimeStep rule(default_parameters());
+  TimeStepObservation observed;
+  observed.relative_density_change = 0.2;
+  FUZZY_COMPARE(rule.next_timestep(0.2, observed), 0.1);
+  observed.relative_density_change = 0.;
+  observed.min_time_scale = 0.5;
+  FUZZY_COMPARE(rule.next_timestep(0.2, observed), 0.05);
+  // The minimum is not undercut
+  observed.min_time_scale = 0.01;
+  COMPARE(rule.next_timestep(0.2, observed), 0.01);
+}
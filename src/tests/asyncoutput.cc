@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/asyncoutput.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "setup.h"
+#include "smash/freeforallaction.h"
+
+using namespace smash;
+
+namespace {
+/// A minimal output remembering the interactions it received.
+class InteractionCollector : public OutputInterface {
+ public:
+  explicit InteractionCollector(std::string name)
+      : OutputInterface(std::move(name)) {}
+  void at_interaction(const Action &action, const double density) override {
+    times.push_back(action.time_of_execution());
+    densities.push_back(density);
+  }
+  void at_eventstart(const Particles &, const EventLabel &label,
+                     const EventInfo &) override {
+    if (label.event_number < 0) {
+      throw std::runtime_error("Invalid event number.");
+    }
+    event_numbers.push_back(label.event_number);
+  }
+  std::vector<double> times{}, densities{};
+  std::vector<int> event_numbers{};
+};
+}  // namespace
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST_CATCH(zero_capacity, std::invalid_argument) { OutputWriter writer(0); }
+
+TEST(flags_are_mirrored) {
+  OutputWriter writer;
+  VERIFY(AsyncOutput(std::make_unique<InteractionCollector>("Dileptons"),
+                     writer)
+             .is_dilepton_output());
+  VERIFY(AsyncOutput(std::make_unique<InteractionCollector>("Photons"), writer)
+             .is_photon_output());
+  const AsyncOutput collisions(
+      std::make_unique<InteractionCollector>("Collisions"), writer);
+  VERIFY(!collisions.is_dilepton_output());
+  VERIFY(!collisions.is_photon_output());
+  VERIFY(!collisions.is_IC_output());
+}
+
+TEST(interactions_are_written_in_order) {
+  // A single pending call forces the caller to wait for the writer
+  OutputWriter writer(1);
+  auto owned_target = std::make_unique<InteractionCollector>("Collisions");
+  const InteractionCollector &target = *owned_target;
+  AsyncOutput output(std::move(owned_target), writer);
+  const ParticleList two_smashons = {Test::smashon(1), Test::smashon(2)};
+  std::vector<double> times, densities;
+  for (int i = 0; i < 100; i++) {
+    // The output must not depend on the lifetime of the original actions
+    FreeforallAction action(ParticleList{}, two_smashons, 0.5 * i);
+    output.at_interaction(action, 0.01 * i);
+    times.push_back(0.5 * i);
+    densities.push_back(0.01 * i);
+  }
+  COMPARE(output.size(), 0u);
+  writer.wait();
+  COMPARE(target.times, times);
+  COMPARE(target.densities, densities);
+}
+
+TEST(outputs_share_the_writer) {
+  OutputWriter writer;
+  auto owned_first = std::make_unique<InteractionCollector>("Particles");
+  auto owned_second = std::make_unique<InteractionCollector>("Collisions");
+  const InteractionCollector &first = *owned_first;
+  const InteractionCollector &second = *owned_second;
+  {
+    AsyncOutput first_output(std::move(owned_first), writer);
+    AsyncOutput second_output(std::move(owned_second), writer);
+    const Particles particles;
+    for (int event = 0; event < 10; event++) {
+      first_output.at_eventstart(particles, {event, 0}, EventInfo{});
+      second_output.at_eventstart(particles, {2 * event, 0}, EventInfo{});
+    }
+    // The outputs wait for their calls when they are destroyed
+  }
+  COMPARE(first.event_numbers.size(), 10u);
+  COMPARE(second.event_numbers.size(), 10u);
+  for (int event = 0; event < 10; event++) {
+    COMPARE(first.event_numbers[event], event);
+    COMPARE(second.event_numbers[event], 2 * event);
+  }
+}
+
+TEST(exceptions_are_rethrown) {
+  OutputWriter writer;
+  auto owned_target = std::make_unique<InteractionCollector>("Particles");
+  const InteractionCollector &target = *owned_target;
+  AsyncOutput output(std::move(owned_target), writer);
+  const Particles particles;
+  output.at_eventstart(particles, {0, 0}, EventInfo{});
+  output.at_eventstart(particles, {-1, 0}, EventInfo{});
+  bool thrown = false;
+  try {
+    writer.wait();
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+  COMPARE(target.event_numbers, std::vector<int>{0});
+  // The exception is passed on only once, the writer keeps working
+  output.at_eventstart(particles, {1, 0}, EventInfo{});
+  writer.wait();
+  COMPARE(target.event_numbers, (std::vector<int>{0, 1}));
+}
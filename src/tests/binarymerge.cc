@@ -0,0 +1,91 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/binarymerge.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "setup.h"
+#include "smash/binaryoutput.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) / "merge";
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST(init_particletypes) { Test::create_smashon_particletypes(); }
+
+/* Write the given events with the same particles to the binary particles
+ * output, which is a shard if the number is not negative. */
+static void write_events(const std::vector<int> &event_numbers, int shard) {
+  const auto particles = Test::create_particles(3, [] {
+    return Test::smashon(Test::Position{0.0, 1.0, 2.0, 3.0},
+                         Test::Momentum{1.0, 0.1, 0.2, 0.3});
+  });
+  OutputParameters output_par = OutputParameters();
+  output_par.part_only_final = OutputOnlyFinal::No;
+  output_par.part_event_index = true;
+  output_par.quantities["Particles"] = {};
+  auto output = create_binary_output("Oscar2013_bin", "Particles",
+                                     testoutputpath, output_par, shard);
+  for (int event_number : event_numbers) {
+    const EventInfo event = Test::default_event_info(0.5 * event_number);
+    for (int ensemble = 0; ensemble < 2; ensemble++) {
+      output->at_eventstart(*particles, {event_number, ensemble}, event);
+      output->at_eventend(*particles, {event_number, ensemble}, event);
+    }
+  }
+}
+
+static std::string content_of(const std::filesystem::path &file) {
+  std::ifstream input(file, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(input)),
+                     std::istreambuf_iterator<char>());
+}
+
+TEST(merged_shards_equal_serial_output) {
+  write_events({0, 1, 2, 3}, -1);
+  write_events({0, 2}, 0);
+  write_events({1, 3}, 1);
+  const std::filesystem::path serial =
+      testoutputpath / "particles_oscar2013.bin";
+  const std::vector<std::filesystem::path> shards{
+      testoutputpath / "particles_oscar2013.1.bin",
+      testoutputpath / "particles_oscar2013.0.bin"};
+  VERIFY(std::filesystem::exists(shards[0]));
+  const std::filesystem::path merged = testoutputpath / "merged.bin";
+  COMPARE(merge_binary_shards(shards, merged), 8u);
+  VERIFY(content_of(merged) == content_of(serial));
+  VERIFY(content_of(testoutputpath / "merged.bin.idx") ==
+         content_of(testoutputpath / "particles_oscar2013.bin.idx"));
+}
+
+TEST_CATCH(event_in_two_shards, std::runtime_error) {
+  merge_binary_shards({testoutputpath / "particles_oscar2013.bin",
+                       testoutputpath / "particles_oscar2013.0.bin"},
+                      testoutputpath / "duplicate.bin");
+}
+
+TEST_CATCH(shard_without_index, std::runtime_error) {
+  std::filesystem::remove(testoutputpath / "particles_oscar2013.1.bin.idx");
+  merge_binary_shards({testoutputpath / "particles_oscar2013.1.bin"},
+                      testoutputpath / "unindexed.bin");
+}
@@ -12,14 +12,20 @@
 #include "smash/binaryoutput.h"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
+#ifdef SMASH_USE_ZSTD
+#include <zstd.h>
+#endif
+
 #include "setup.h"
 #include "smash/clock.h"
 #include "smash/config.h"
@@ -27,6 +33,7 @@
 #include "smash/fluidizationaction.h"
 #include "smash/outputinterface.h"
 #include "smash/processbranch.h"
+#include "smash/random.h"
 #include "smash/scatteraction.h"
 #include "smash/scatteractionsfinderparameters.h"
 
@@ -651,3 +658,236 @@ TEST(custom) {
 
   VERIFY(std::filesystem::remove(particleoutputpath));
 }
+
+/* Write two events with the initial and final particles to a particles output
+ * with the given compression level and return the content of the file. If
+ * requested, the content of the event index is returned as well. */
+static std::vector<char> write_two_events(
+    const std::filesystem::path &path, int compression_level,
+    std::vector<char> *index_content = nullptr) {
+  std::filesystem::create_directories(path);
+  const auto particles =
+      Test::create_particles(5, [] { return Test::smashon_random(); });
+  EventInfo event = Test::default_event_info(1.5, false);
+  {
+    OutputParameters output_par = OutputParameters();
+    output_par.part_only_final = OutputOnlyFinal::No;
+    output_par.part_compression = compression_level;
+    output_par.part_event_index = index_content != nullptr;
+    output_par.quantities["Particles"] = {};
+    auto bin_output = create_binary_output("Oscar2013_bin", "Particles", path,
+                                           output_par);
+    for (int event_number = 0; event_number < 2; event_number++) {
+      bin_output->at_eventstart(*particles, {event_number, 0}, event);
+      bin_output->at_eventend(*particles, {event_number, 0}, event);
+    }
+  }
+  const std::filesystem::path file = path / "particles_oscar2013.bin";
+  std::ifstream input(file, std::ios::binary);
+  std::vector<char> content((std::istreambuf_iterator<char>(input)),
+                            std::istreambuf_iterator<char>());
+  input.close();
+  VERIFY(std::filesystem::remove(file));
+  if (index_content) {
+    std::filesystem::path index_file = file;
+    index_file += ".idx";
+    std::ifstream index_input(index_file, std::ios::binary);
+    index_content->assign(std::istreambuf_iterator<char>(index_input),
+                          std::istreambuf_iterator<char>());
+    index_input.close();
+    VERIFY(std::filesystem::remove(index_file));
+  }
+  return content;
+}
+
+TEST(event_index) {
+  std::vector<char> index;
+  const std::vector<char> content =
+      write_two_events(testoutputpath / "indexed", 0, &index);
+  constexpr std::size_t record_size = 33;
+  COMPARE(index.size(), 8 + 2 * record_size);
+  COMPARE(std::string(index.data(), 4), "SMIX");
+  std::array<std::uint16_t, 2> versions;
+  std::memcpy(versions.data(), &index[4], sizeof(versions));
+  COMPARE(versions[0], 1);
+  COMPARE(versions[1], current_format_version);
+  const std::size_t header_size = 12 + std::strlen(SMASH_VERSION);
+  std::uint64_t expected_offset = header_size;
+  for (std::int32_t event_number = 0; event_number < 2; event_number++) {
+    const char *record = &index[8 + event_number * record_size];
+    std::array<std::int32_t, 2> label;
+    std::array<std::uint64_t, 2> range;
+    double impact_parameter;
+    std::memcpy(label.data(), record, sizeof(label));
+    std::memcpy(range.data(), record + 8, sizeof(range));
+    std::memcpy(&impact_parameter, record + 24, sizeof(double));
+    COMPARE(label[0], event_number);
+    COMPARE(label[1], 0);
+    COMPARE(range[0], expected_offset);
+    COMPARE(impact_parameter, 1.5);
+    COMPARE(record[32], 0);
+    // The event starts with a particle block of the same event
+    COMPARE(content[range[0]], 'p');
+    std::int32_t block_event;
+    std::memcpy(&block_event, &content[range[0] + 1], sizeof(block_event));
+    COMPARE(block_event, event_number);
+    expected_offset += range[1];
+  }
+  COMPARE(expected_offset, content.size());
+}
+
+TEST(initial_conditions_slabs) {
+  const std::filesystem::path path = testoutputpath / "slabs";
+  std::filesystem::create_directories(path);
+  // The particles cross the hypersurface in the slabs 0, 0, 1 and 3
+  const std::vector<double> times = {0.2, 0.7, 1.5, 3.2};
+  std::vector<ActionPtr> actions;
+  for (const double t : times) {
+    ParticleData p = Test::smashon_random();
+    p.set_4position(FourVector(t, 0.1, 0.2, 0.3));
+    actions.push_back(std::make_unique<FluidizationAction>(p, p, 0.0));
+  }
+  EventInfo event = Test::default_event_info(0.0, false);
+  {
+    OutputParameters output_par = OutputParameters();
+    output_par.ic_slab_width = 1.0;
+    auto bin_output = create_binary_output("Oscar2013_bin",
+                                           "Initial_Conditions", path,
+                                           output_par);
+    bin_output->at_eventstart(Particles(), {3, 0}, event);
+    for (const ActionPtr &action : actions) {
+      bin_output->at_interaction(*action, 0.0);
+    }
+    // The last slab is completed by a later intermediate output
+    const std::unique_ptr<Clock> clock =
+        std::make_unique<UniformClock>(5.0, 1.0, 10.0);
+    DensityParameters dens_par(Test::default_parameters());
+    bin_output->at_intermediate_time(Particles(), clock, dens_par, {3, 0},
+                                     event);
+    bin_output->at_eventend(Particles(), {3, 0}, event);
+  }
+  auto read_and_remove = [](const std::filesystem::path &file) {
+    std::ifstream input(file, std::ios::binary);
+    std::vector<char> content((std::istreambuf_iterator<char>(input)),
+                              std::istreambuf_iterator<char>());
+    input.close();
+    VERIFY(std::filesystem::remove(file));
+    return content;
+  };
+  const std::vector<char> content =
+      read_and_remove(path / "SMASH_IC_oscar2013.bin");
+  const std::vector<char> index =
+      read_and_remove(path / "SMASH_IC_oscar2013.bin.slabs");
+
+  COMPARE(std::string(index.data(), 4), "SMSL");
+  std::uint16_t index_version;
+  double slab_width;
+  std::memcpy(&index_version, &index[4], sizeof(index_version));
+  std::memcpy(&slab_width, &index[6], sizeof(slab_width));
+  COMPARE(index_version, 1);
+  COMPARE(slab_width, 1.0);
+  constexpr std::size_t header_size = 14, record_size = 44;
+  constexpr std::size_t particle_line_size = 9 * 8 + 3 * 4;
+  COMPARE(index.size(), header_size + 3 * record_size);
+  const std::array<std::uint32_t, 3> expected_n = {2, 1, 1};
+  const std::array<double, 3> expected_begin = {0.0, 1.0, 3.0};
+  std::uint64_t expected_offset = 12 + std::strlen(SMASH_VERSION);
+  std::size_t particle = 0;
+  for (std::size_t slab = 0; slab < 3; slab++) {
+    const char *record = &index[header_size + slab * record_size];
+    std::array<std::int32_t, 2> label;
+    std::uint32_t n_particles;
+    std::array<double, 2> range;
+    std::array<std::uint64_t, 2> block;
+    std::memcpy(label.data(), record, sizeof(label));
+    std::memcpy(&n_particles, record + 8, sizeof(n_particles));
+    std::memcpy(range.data(), record + 12, sizeof(range));
+    std::memcpy(block.data(), record + 28, sizeof(block));
+    COMPARE(label[0], 3);
+    COMPARE(label[1], 0);
+    COMPARE(n_particles, expected_n[slab]);
+    COMPARE(range[0], expected_begin[slab]);
+    COMPARE(range[1], expected_begin[slab] + 1.0);
+    COMPARE(block[0], expected_offset);
+    COMPARE(block[1], 5 + n_particles * particle_line_size);
+    // Every slab is one particle block with the particles in their order
+    COMPARE(content[block[0]], 'p');
+    std::uint32_t n_lines;
+    std::memcpy(&n_lines, &content[block[0] + 1], sizeof(n_lines));
+    COMPARE(n_lines, n_particles);
+    for (std::uint32_t i = 0; i < n_particles; i++) {
+      double t;
+      std::memcpy(&t, &content[block[0] + 5 + i * particle_line_size],
+                  sizeof(t));
+      COMPARE(t, times[particle++]);
+    }
+    expected_offset += block[1];
+  }
+  // Only the event end line follows the slabs
+  COMPARE(content[expected_offset], 'f');
+  COMPARE(content.size(), expected_offset + 1 + 2 * 4 + 8 + 1);
+}
+
+TEST_CATCH(negative_slab_width, std::invalid_argument) {
+  OutputParameters output_par = OutputParameters();
+  output_par.ic_slab_width = -1.0;
+  create_binary_output("Oscar2013_bin", "Initial_Conditions",
+                       testoutputpath / "slabs", output_par);
+}
+
+#ifdef SMASH_USE_ZSTD
+TEST(compressed_frames_contain_the_uncompressed_blocks) {
+  // The same random particles are used for both outputs
+  random::set_seed(11);
+  const std::vector<char> plain =
+      write_two_events(testoutputpath / "uncompressed", 0);
+  random::set_seed(11);
+  const std::vector<char> compressed =
+      write_two_events(testoutputpath / "compressed", 3);
+  // The headers only differ by the format version
+  const std::size_t header_size = 12 + std::strlen(SMASH_VERSION);
+  VERIFY(compressed.size() > header_size);
+  std::uint16_t version;
+  std::memcpy(&version, &compressed[4], sizeof(version));
+  COMPARE(version, 11);
+  COMPARE(std::memcmp(&compressed[6], &plain[6], header_size - 6), 0);
+  // Every event is one frame and the frames contain the blocks
+  std::vector<char> blocks(plain.begin(), plain.begin() + header_size);
+  std::size_t position = header_size;
+  int n_frames = 0;
+  while (position < compressed.size()) {
+    std::array<std::uint32_t, 2> sizes;
+    std::memcpy(sizes.data(), &compressed[position], sizeof(sizes));
+    position += sizeof(sizes);
+    std::vector<char> frame(sizes[1]);
+    COMPARE(ZSTD_decompress(frame.data(), frame.size(), &compressed[position],
+                            sizes[0]),
+            sizes[1]);
+    VERIFY(frame[0] == 'p');
+    VERIFY(frame[frame.size() - 2 * sizeof(std::int32_t) - sizeof(double) -
+                 2] == 'f');
+    blocks.insert(blocks.end(), frame.begin(), frame.end());
+    position += sizes[0];
+    n_frames++;
+  }
+  COMPARE(position, compressed.size());
+  COMPARE(n_frames, 2);
+  VERIFY(blocks == plain);
+}
+
+TEST_CATCH(invalid_compression_level, std::invalid_argument) {
+  write_two_events(testoutputpath / "compressed", ZSTD_maxCLevel() + 1);
+}
+#else
+TEST_CATCH(compression_unavailable, std::invalid_argument) {
+  write_two_events(testoutputpath / "compressed", 3);
+}
+#endif
+
+TEST_CATCH(delta_encoding_needs_oscar_quantities, std::invalid_argument) {
+  OutputParameters output_par = OutputParameters();
+  output_par.part_only_final = OutputOnlyFinal::No;
+  output_par.part_delta_encoding = true;
+  output_par.quantities["Particles"] = {"t", "x", "pdg"};
+  create_binary_output("Binary", "Particles", testoutputpath, output_par);
+}
@@ -0,0 +1,357 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/binaryreader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "setup.h"
+#include "smash/binaryoutput.h"
+#include "smash/clock.h"
+#include "smash/wallcrossingaction.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) / "reader";
+
+static const std::filesystem::path collisions_file =
+    testoutputpath / "collisions_oscar2013.bin";
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST(init_particletypes) { Test::create_smashon_particletypes(); }
+
+/* Write events with the initial particles, a wall crossing and the final
+ * particles to the collisions output and return the particles. */
+static ParticleList write_collisions(int n_events, bool event_index) {
+  Particles particles;
+  particles.insert(Test::smashon_random());
+  particles.insert(Test::smashon_random());
+  {
+    OutputParameters output_par = OutputParameters();
+    output_par.coll_printstartend = true;
+    output_par.coll_event_index = event_index;
+    output_par.quantities["Collisions"] = {};
+    auto output = create_binary_output("Oscar2013_bin", "Collisions",
+                                       testoutputpath, output_par);
+    for (int event_number = 0; event_number < n_events; event_number++) {
+      const EventInfo event = Test::default_event_info(0.5 * event_number);
+      output->at_eventstart(particles, {event_number, 0}, event);
+      ParticleData crossed = particles.front();
+      crossed.set_4position(FourVector(1.0, 2.0, 3.0, 4.0));
+      output->at_interaction(WallcrossingAction(particles.front(), crossed),
+                             0.25);
+      output->at_eventend(particles, {event_number, 0}, event);
+    }
+  }
+  return particles.copy_to_vector();
+}
+
+static void compare_particle(const BinaryReader::Particle &line,
+                             const ParticleData &p) {
+  COMPARE(line.t(), p.position().x0());
+  COMPARE(line.z(), p.position().x3());
+  COMPARE(line.mass(), p.effective_mass());
+  COMPARE(line.px(), p.momentum().x1());
+  COMPARE(line.pdg(), p.pdgcode().get_decimal());
+  COMPARE(line.id(), p.id());
+  COMPARE(line.charge(), p.type().charge());
+}
+
+static void compare_collisions(const BinaryReader &reader,
+                               const ParticleList &particles, int n_events) {
+  COMPARE(reader.format_version(), 10);
+  COMPARE(reader.format_variant(), 0);
+  COMPARE(reader.smash_version(), SMASH_VERSION);
+  COMPARE(reader.line_size(), BinaryReader::oscar2013_line_size);
+  COMPARE(reader.size(), static_cast<std::size_t>(n_events));
+  int event_number = 0;
+  for (const BinaryReader::Event &event : reader) {
+    COMPARE(event.event_number(), event_number);
+    COMPARE(event.ensemble_number(), 0);
+    COMPARE(event.impact_parameter(), 0.5 * event_number);
+    VERIFY(!event.empty());
+    std::vector<char> types;
+    for (const BinaryReader::Block &block : event) {
+      types.push_back(block.type);
+      if (block.type == 'p') {
+        COMPARE(block.event_number, event_number);
+        COMPARE(block.particles.size(), particles.size());
+        int i = 0;
+        for (BinaryReader::Particle line : block.particles) {
+          compare_particle(line, particles[i++]);
+        }
+      } else {
+        COMPARE(block.density, 0.25);
+        COMPARE(block.process_type,
+                static_cast<std::uint32_t>(ProcessType::Wall));
+        COMPARE(block.incoming().size(), 1u);
+        COMPARE(block.outgoing().size(), 1u);
+        compare_particle(block.incoming()[0], particles[0]);
+        COMPARE(block.outgoing()[0].t(), 1.0);
+        COMPARE(block.outgoing()[0].x(), 2.0);
+      }
+    }
+    COMPARE(types, (std::vector<char>{'p', 'i', 'p'}));
+    event_number++;
+  }
+}
+
+TEST(read_blocks) {
+  const ParticleList particles = write_collisions(3, false);
+  const BinaryReader reader(collisions_file);
+  VERIFY(!reader.indexed());
+  compare_collisions(reader, particles, 3);
+}
+
+TEST(read_blocks_from_event_index) {
+  const ParticleList particles = write_collisions(3, true);
+  const BinaryReader reader(collisions_file);
+  VERIFY(reader.indexed());
+  compare_collisions(reader, particles, 3);
+  std::filesystem::path index_file = collisions_file;
+  index_file += ".idx";
+  VERIFY(std::filesystem::remove(index_file));
+}
+
+TEST(events_in_parallel) {
+  write_collisions(20, false);
+  const BinaryReader reader(collisions_file);
+  std::vector<int> n_blocks(reader.size(), 0);
+  std::atomic<int> n_events{0};
+  ThreadPool pool(4);
+  reader.for_each_event(pool, [&](std::size_t i,
+                                  const BinaryReader::Event &event) {
+    for (auto it = event.begin(); it != event.end(); ++it) {
+      n_blocks[i]++;
+    }
+    n_events += event.event_number() == static_cast<int>(i);
+  });
+  COMPARE(n_events.load(), 20);
+  COMPARE(n_blocks, std::vector<int>(20, 3));
+}
+
+TEST(incomplete_event_is_left_out) {
+  write_collisions(2, false);
+  // Cut the file within the event end line of the last event
+  std::filesystem::resize_file(collisions_file,
+                               std::filesystem::file_size(collisions_file) - 5);
+  const BinaryReader reader(collisions_file);
+  COMPARE(reader.size(), 1u);
+  COMPARE(reader[0].event_number(), 0);
+}
+
+TEST(custom_quantities) {
+  const auto particles =
+      Test::create_particles(3, [] { return Test::smashon_random(); });
+  OutputParameters output_par = OutputParameters();
+  output_par.part_only_final = OutputOnlyFinal::Yes;
+  output_par.quantities["Particles"] = {"t", "pdg"};
+  {
+    auto output = create_binary_output("Binary", "Particles", testoutputpath,
+                                       output_par);
+    output->at_eventstart(*particles, {0, 0}, Test::default_event_info());
+    output->at_eventend(*particles, {0, 0}, Test::default_event_info());
+  }
+  const std::filesystem::path file = testoutputpath / "particles_custom.bin";
+  const BinaryReader reader(file, sizeof(double) + sizeof(std::int32_t));
+  COMPARE(reader.format_variant(), 2);
+  COMPARE(reader.size(), 1u);
+  const BinaryReader::Block block = *reader[0].begin();
+  COMPARE(block.particles.size(), 3u);
+  int i = 0;
+  for (const ParticleData &p : *particles) {
+    COMPARE(block.particles[i].t(), p.position().x0());
+    COMPARE(block.particles[i].get<std::int32_t>(8),
+            p.pdgcode().get_decimal());
+    i++;
+  }
+}
+
+TEST_CATCH(custom_quantities_need_line_size, std::invalid_argument) {
+  BinaryReader reader(testoutputpath / "particles_custom.bin");
+}
+
+TEST_CATCH(not_a_binary_file, std::runtime_error) {
+  const std::filesystem::path file = testoutputpath / "not_binary.txt";
+  std::ofstream(file) << "This is not a SMASH binary file.\n";
+  BinaryReader reader(file);
+}
+
+/* Move the particles on straight lines in several steps, such that their
+ * positions differ from a single step by rounding errors. */
+static void free_stream(Particles &particles, double to_time) {
+  for (int step = 0; step < 10; step++) {
+    for (ParticleData &p : particles) {
+      const double dt = (to_time - p.position().x0()) / (10 - step);
+      const ThreeVector v = p.momentum().threevec() / p.momentum().x0();
+      p.set_4position(p.position() + FourVector(dt, v * dt));
+    }
+  }
+}
+
+static void compare_state(const BinaryReader::ParticleState &state,
+                          const ParticleList &particles) {
+  const BinaryReader::Particles lines = state.particles();
+  COMPARE(lines.size(), particles.size());
+  for (BinaryReader::Particle line : lines) {
+    const auto found = std::find_if(
+        particles.begin(), particles.end(),
+        [&line](const ParticleData &p) { return p.id() == line.id(); });
+    VERIFY(found != particles.end());
+    const ParticleData &p = *found;
+    COMPARE(line.t(), p.position().x0());
+    COMPARE_ABSOLUTE_ERROR(line.x(), p.position().x1(), 1e-9);
+    COMPARE_ABSOLUTE_ERROR(line.z(), p.position().x3(), 1e-9);
+    COMPARE(line.pz(), p.momentum().x3());
+    COMPARE(line.pdg(), p.pdgcode().get_decimal());
+  }
+}
+
+TEST(delta_blocks_reconstruct_particles) {
+  Particles particles;
+  for (int i = 0; i < 4; i++) {
+    particles.insert(Test::smashon_random());
+  }
+  OutputParameters output_par = OutputParameters();
+  output_par.part_only_final = OutputOnlyFinal::No;
+  output_par.part_delta_encoding = true;
+  output_par.quantities["Particles"] = {};
+  const EventInfo event = Test::default_event_info();
+  DensityParameters dens_par(Test::default_parameters());
+  std::vector<ParticleList> expected;
+  std::vector<std::size_t> n_lines;
+  {
+    auto output = create_binary_output("Oscar2013_bin", "Particles",
+                                       testoutputpath, output_par);
+    output->at_eventstart(particles, {0, 0}, event);
+    // Only free streaming
+    free_stream(particles, 1.0);
+    std::unique_ptr<Clock> clock =
+        std::make_unique<UniformClock>(1.0, 0.1, 10.0);
+    output->at_intermediate_time(particles, clock, dens_par, {0, 0}, event);
+    expected.push_back(particles.copy_to_vector());
+    n_lines.push_back(0);
+    // One particle is removed, one is added and one is kicked
+    free_stream(particles, 2.0);
+    particles.remove(particles.front());
+    ParticleData added = Test::smashon_random();
+    added.set_4position(FourVector(2.0, 0.1, 0.2, 0.3));
+    particles.insert(added);
+    ParticleData &kicked = *std::next(particles.begin());
+    kicked.set_4momentum(kicked.effective_mass(), 0.1, 0.2, 0.3);
+    clock = std::make_unique<UniformClock>(2.0, 0.1, 10.0);
+    output->at_intermediate_time(particles, clock, dens_par, {0, 0}, event);
+    expected.push_back(particles.copy_to_vector());
+    n_lines.push_back(2);
+    output->at_eventend(particles, {0, 0}, event);
+  }
+  const BinaryReader reader(testoutputpath / "particles_oscar2013.bin");
+  COMPARE(reader.size(), 1u);
+  BinaryReader::ParticleState state(reader.line_size());
+  std::vector<char> types;
+  std::size_t n_deltas = 0;
+  for (const BinaryReader::Block &block : reader[0]) {
+    types.push_back(block.type);
+    state.apply(block);
+    if (block.type == 'd') {
+      COMPARE(block.time, n_deltas + 1.0);
+      COMPARE(block.particles.size(), n_lines[n_deltas]);
+      COMPARE(block.n_removed, n_deltas);
+      compare_state(state, expected[n_deltas]);
+      n_deltas++;
+    }
+  }
+  COMPARE(types, (std::vector<char>{'p', 'd', 'd', 'p'}));
+  compare_state(state, particles.copy_to_vector());
+}
+
+TEST(referenced_incoming_particles_are_reconstructed) {
+  Particles particles;
+  particles.insert(Test::smashon_random());
+  particles.insert(Test::smashon_random());
+  OutputParameters output_par = OutputParameters();
+  output_par.coll_printstartend = true;
+  output_par.coll_reference_incoming = true;
+  output_par.quantities["Collisions"] = {};
+  const EventInfo event = Test::default_event_info();
+  std::vector<ParticleList> incoming;
+  {
+    auto output = create_binary_output("Oscar2013_bin", "Collisions",
+                                       testoutputpath, output_par);
+    output->at_eventstart(particles, {0, 0}, event);
+    // Referenced from the initial particles
+    ParticleData first = particles.front();
+    ParticleData crossed = first;
+    crossed.set_4position(FourVector(first.position().x0(), 2.0, 3.0, 4.0));
+    output->at_interaction(WallcrossingAction(first, crossed), 0.25);
+    incoming.push_back({first});
+    // Referenced from the outgoing particle after free streaming
+    const ThreeVector v =
+        crossed.momentum().threevec() / crossed.momentum().x0();
+    ParticleData streamed = crossed;
+    streamed.set_4position(crossed.position() + FourVector(1.5, v * 1.5));
+    output->at_interaction(WallcrossingAction(streamed, streamed), 0.25);
+    incoming.push_back({streamed});
+    // Not referenced after a change of the momentum
+    ParticleData kicked = streamed;
+    kicked.set_4momentum(kicked.effective_mass(), 0.1, 0.2, 0.3);
+    output->at_interaction(WallcrossingAction(kicked, kicked), 0.25);
+    incoming.push_back({kicked});
+    output->at_eventend(particles, {0, 0}, event);
+  }
+  const BinaryReader reader(testoutputpath / "collisions_oscar2013.bin");
+  COMPARE(reader.size(), 1u);
+  BinaryReader::CollisionState state(reader.line_size());
+  std::vector<char> types;
+  std::vector<std::uint32_t> n_lines;
+  std::size_t n_interactions = 0;
+  for (const BinaryReader::Block &block : reader[0]) {
+    types.push_back(block.type);
+    state.apply(block);
+    if (block.type != 'r') {
+      continue;
+    }
+    n_lines.push_back(block.n_incoming);
+    COMPARE(block.n_incoming_ids, 1u);
+    COMPARE(block.density, 0.25);
+    const ParticleData &p = incoming[n_interactions++][0];
+    COMPARE(block.incoming_id(0), p.id());
+    COMPARE(block.time, p.position().x0());
+    const BinaryReader::Particles reconstructed = state.incoming();
+    COMPARE(reconstructed.size(), 1u);
+    COMPARE(reconstructed[0].id(), p.id());
+    COMPARE(reconstructed[0].t(), p.position().x0());
+    COMPARE_ABSOLUTE_ERROR(reconstructed[0].x(), p.position().x1(), 1e-9);
+    COMPARE_ABSOLUTE_ERROR(reconstructed[0].z(), p.position().x3(), 1e-9);
+    COMPARE(reconstructed[0].px(), p.momentum().x1());
+    COMPARE(reconstructed[0].pdg(), p.pdgcode().get_decimal());
+  }
+  COMPARE(types, (std::vector<char>{'p', 'r', 'r', 'r', 'p'}));
+  COMPARE(n_lines, (std::vector<std::uint32_t>{0, 0, 1}));
+}
+
+TEST_CATCH(referenced_incoming_particles_need_oscar_quantities,
+           std::invalid_argument) {
+  OutputParameters output_par = OutputParameters();
+  output_par.coll_reference_incoming = true;
+  output_par.quantities["Collisions"] = {"t", "x", "pdg"};
+  create_binary_output("Binary", "Collisions", testoutputpath, output_par);
+}
@@ -0,0 +1,119 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/blockpool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "smash/threadpool.h"
+
+using namespace smash;
+
+namespace {
+/// A polymorphic object taken from the pool
+struct Base : public PoolAllocated {
+  virtual ~Base() = default;
+  int value = 1;
+};
+/// A larger object, which has to be given back with its own size
+struct Derived : public Base {
+  double payload[20] = {};
+};
+}  // namespace
+
+TEST(freed_blocks_are_reused) {
+  void *first = BlockPool::allocate(100);
+  BlockPool::deallocate(first, 100);
+  // The same size class is served from the freed block
+  void *second = BlockPool::allocate(97);
+  COMPARE(second, first);
+  void *third = BlockPool::allocate(100);
+  VERIFY(third != second);
+  BlockPool::deallocate(second, 97);
+  BlockPool::deallocate(third, 100);
+}
+
+TEST(blocks_are_aligned_and_disjoint) {
+  std::vector<char *> blocks;
+  for (std::size_t size = 1; size <= BlockPool::max_block_size + 100;
+       size += 7) {
+    char *block = static_cast<char *>(BlockPool::allocate(size));
+    COMPARE(reinterpret_cast<std::uintptr_t>(block) % BlockPool::alignment,
+            0u);
+    std::memset(block, static_cast<int>(size % 256), size);
+    blocks.push_back(block);
+  }
+  std::size_t size = 1;
+  for (char *block : blocks) {
+    COMPARE(static_cast<int>(static_cast<unsigned char>(block[size - 1])),
+            static_cast<int>(size % 256));
+    BlockPool::deallocate(block, size);
+    size += 7;
+  }
+}
+
+TEST(derived_objects_are_given_back) {
+  std::vector<std::unique_ptr<Base>> objects;
+  for (int i = 0; i < 1000; i++) {
+    if (i % 2) {
+      objects.push_back(std::make_unique<Derived>());
+    } else {
+      objects.push_back(std::make_unique<Base>());
+    }
+  }
+  const Base *last = objects.back().get();
+  objects.clear();
+  // The last freed block of the size is the first to be reused
+  std::unique_ptr<Base> reused = std::make_unique<Derived>();
+  COMPARE(reused.get(), last);
+  COMPARE(reused->value, 1);
+}
+
+TEST(blocks_freed_by_other_threads) {
+  constexpr std::size_t n = 400;
+  std::vector<std::unique_ptr<Base>> objects(n);
+  ThreadPool pool(4);
+  // Objects allocated on the workers and freed on this thread, and vice versa
+  pool.parallel_for(n, [&](std::size_t i) {
+    objects[i] = std::make_unique<Derived>();
+    objects[i]->value = static_cast<int>(i);
+  });
+  for (std::size_t i = 0; i < n; i++) {
+    COMPARE(objects[i]->value, static_cast<int>(i));
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    objects[i] = std::make_unique<Base>();
+  }
+  pool.parallel_for(n, [&](std::size_t i) { objects[i].reset(); });
+}
+
+TEST(small_containers_use_the_pool) {
+  const int *first_storage = nullptr;
+  {
+    std::vector<int, PoolAllocator<int>> numbers{1, 2, 3};
+    first_storage = numbers.data();
+  }
+  // The storage of the destroyed vector is reused for one of the same size
+  std::vector<int, PoolAllocator<int>> numbers{4, 5, 6};
+  COMPARE(numbers.data(), first_storage);
+  // Containers larger than the largest block grow as usual
+  for (int i = 0; i < 1000; i++) {
+    numbers.push_back(i);
+  }
+  COMPARE(numbers.size(), 1003u);
+  COMPARE(numbers[2], 6);
+  COMPARE(numbers.back(), 999);
+  // Allocators of different element types are interchangeable
+  VERIFY(PoolAllocator<int>() == PoolAllocator<double>());
+}
@@ -0,0 +1,209 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/bufferedoutput.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "setup.h"
+#include "smash/clock.h"
+#include "smash/density.h"
+#include "smash/freeforallaction.h"
+
+using namespace smash;
+
+namespace {
+/// A minimal output remembering the interactions it received.
+class InteractionCollector : public OutputInterface {
+ public:
+  explicit InteractionCollector(std::string name)
+      : OutputInterface(std::move(name)) {}
+  void at_interaction(const Action &action, const double density) override {
+    n_incoming.push_back(action.incoming_particles().size());
+    n_outgoing.push_back(action.outgoing_particles().size());
+    times.push_back(action.time_of_execution());
+    types.push_back(action.get_type());
+    densities.push_back(density);
+  }
+  void at_eventstart(const Particles &particles, const EventLabel &label,
+                     const EventInfo &) override {
+    event_numbers.push_back(label.event_number);
+    for (const ParticleData &p : particles) {
+      ids.push_back(p.id());
+    }
+  }
+  void at_intermediate_time(const Particles &,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &, const EventLabel &,
+                            const EventInfo &) override {
+    times.push_back(clock->current_time());
+  }
+  OutputHooksBitSet subscribed_hooks() const override { return hooks; }
+  OutputHooksBitSet hooks = OutputHooksBitSet().set();
+  std::vector<std::size_t> n_incoming{}, n_outgoing{};
+  std::vector<double> times{}, densities{};
+  std::vector<ProcessType> types{};
+  std::vector<int> event_numbers{}, ids{};
+};
+
+/// A minimal output keeping the shared copies of the interactions.
+class RecordKeeper : public OutputInterface {
+ public:
+  RecordKeeper() : OutputInterface("Collisions") {}
+  bool keeps_interactions() const override { return true; }
+  void at_recorded_interaction(
+      const std::shared_ptr<const RecordedAction> &action,
+      const double) override {
+    actions.push_back(action);
+  }
+  std::vector<std::shared_ptr<const RecordedAction>> actions{};
+};
+}  // namespace
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST(flags_are_mirrored) {
+  InteractionCollector collisions("Collisions"), dileptons("Dileptons"),
+      photons("Photons"), initial_conditions("SMASH_IC");
+  const BufferedOutput collisions_buffer(collisions);
+  VERIFY(!collisions_buffer.is_dilepton_output());
+  VERIFY(!collisions_buffer.is_photon_output());
+  VERIFY(!collisions_buffer.is_IC_output());
+  VERIFY(BufferedOutput(dileptons).is_dilepton_output());
+  VERIFY(BufferedOutput(photons).is_photon_output());
+  VERIFY(BufferedOutput(initial_conditions).is_IC_output());
+}
+
+TEST(subscribed_hooks_are_mirrored) {
+  InteractionCollector collisions("Collisions");
+  const BufferedOutput buffer(collisions);
+  COMPARE(buffer.subscribed_hooks(), OutputHooksBitSet().set());
+  collisions.hooks = OutputHooksBitSet().set(InteractionHooks);
+  COMPARE(buffer.subscribed_hooks(), collisions.hooks);
+}
+
+TEST(interactions_are_passed_in_order_on_flush) {
+  InteractionCollector target("Collisions");
+  BufferedOutput buffer(target);
+  const ParticleList two_smashons = {Test::smashon(1), Test::smashon(2)};
+  {
+    // The buffer must not depend on the lifetime of the original actions
+    FreeforallAction add(ParticleList{}, two_smashons, 1.5);
+    FreeforallAction remove(two_smashons, ParticleList{}, 2.5);
+    remove.generate_final_state();
+    buffer.at_interaction(add, 0.1);
+    buffer.at_interaction(remove, 0.2);
+  }
+  COMPARE(buffer.size(), 2u);
+  COMPARE(target.times.size(), 0u);
+  buffer.flush();
+  COMPARE(buffer.size(), 0u);
+  COMPARE(target.n_incoming, (std::vector<std::size_t>{0, 2}));
+  COMPARE(target.n_outgoing, (std::vector<std::size_t>{2, 0}));
+  COMPARE(target.times, (std::vector<double>{1.5, 2.5}));
+  COMPARE(target.densities, (std::vector<double>{0.1, 0.2}));
+  VERIFY(target.types[0] == ProcessType::Freeforall);
+  VERIFY(target.types[1] == ProcessType::Freeforall);
+  // Flushing an empty buffer does nothing
+  buffer.flush();
+  COMPARE(target.times.size(), 2u);
+}
+
+TEST(recorded_interactions_are_shared) {
+  RecordKeeper target;
+  BufferedOutput inner(target);
+  BufferedOutput outer(inner);
+  InteractionCollector collector("Collisions");
+  BufferedOutput other(collector);
+  FreeforallAction action(ParticleList{Test::smashon(1)}, ParticleList{}, 0.5);
+  const auto recorded = std::make_shared<const RecordedAction>(action);
+  outer.at_recorded_interaction(recorded, 0.1);
+  other.at_recorded_interaction(recorded, 0.1);
+  outer.flush();
+  inner.flush();
+  other.flush();
+  COMPARE(target.actions.size(), 1u);
+  VERIFY(target.actions[0] == recorded);
+  COMPARE(collector.times, std::vector<double>{0.5});
+}
+
+TEST(copies_are_counted_until_released) {
+  RecordKeeper target;
+  BufferedOutput buffer(target);
+  COMPARE(buffer.memory_usage(), 0u);
+  Particles particles;
+  particles.create(100, 0x661);
+  buffer.at_eventstart(particles, {0, 0}, EventInfo{});
+  VERIFY(buffer.memory_usage() >= 100 * sizeof(ParticleData));
+  FreeforallAction action(ParticleList{Test::smashon(1)}, ParticleList{}, 0.5);
+  buffer.at_interaction(action, 0.);
+  const std::size_t with_action = buffer.memory_usage();
+  buffer.flush();
+  // The target keeps the interaction
+  VERIFY(buffer.memory_usage() > 0u);
+  VERIFY(buffer.memory_usage() < with_action);
+  target.actions.clear();
+  COMPARE(buffer.memory_usage(), 0u);
+}
+
+TEST(weights_are_recorded) {
+  const ParticleData smashon = Test::smashon(1);
+  FreeforallAction action(ParticleList{smashon}, ParticleList{}, 0.);
+  const RecordedAction recorded(action);
+  COMPARE(recorded.get_total_weight(), action.get_total_weight());
+  COMPARE(recorded.get_partial_weight(), action.get_partial_weight());
+  COMPARE(recorded.incoming_particles().size(), 1u);
+  COMPARE(recorded.incoming_particles()[0].id(), 1);
+}
+
+TEST(event_calls_are_copied) {
+  InteractionCollector target("Particles");
+  BufferedOutput buffer(target);
+  Particles particles;
+  particles.insert(Test::smashon());
+  const ParticleData second = particles.insert(Test::smashon());
+  particles.insert(Test::smashon());
+  particles.remove(second);
+  const EventInfo event{};
+  buffer.at_eventstart(particles, {3, 0}, event);
+  const std::unique_ptr<Clock> clock =
+      std::make_unique<UniformClock>(2.5, 0.1, 10.);
+  const ExperimentParameters parameters = Test::default_parameters();
+  buffer.at_intermediate_time(particles, clock, DensityParameters(parameters),
+                              {3, 0}, event);
+  // Neither the particles nor the clock are needed for the flush
+  particles.reset();
+  clock->reset(7.0, false);
+  COMPARE(buffer.size(), 2u);
+  buffer.flush();
+  COMPARE(target.event_numbers, std::vector<int>{3});
+  COMPARE(target.ids, (std::vector<int>{0, 2}));
+  COMPARE(target.times, std::vector<double>{2.5});
+}
+
+TEST(taken_calls_are_flushed_later) {
+  InteractionCollector target("Particles");
+  BufferedOutput buffer(target);
+  Particles particles;
+  particles.insert(Test::smashon());
+  const EventInfo event{};
+  buffer.at_eventstart(particles, {0, 0}, event);
+  const BufferedOutput::Calls first_event = buffer.take_calls();
+  COMPARE(buffer.size(), 0u);
+  buffer.at_eventstart(particles, {1, 0}, event);
+  // The calls of the second event are written first
+  buffer.flush();
+  buffer.flush(first_event);
+  COMPARE(target.event_numbers, (std::vector<int>{1, 0}));
+}
@@ -0,0 +1,117 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/checkpoint.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "setup.h"
+#include "smash/clock.h"
+#include "smash/particles.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) / "checkpoint";
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST(write_and_read_values) {
+  std::filesystem::create_directories(testoutputpath);
+  const auto file = testoutputpath / "values.bin";
+  CheckpointWriter writer;
+  writer.put(42);
+  writer.put(std::string("smash"));
+  writer.put(std::vector<double>{1.5, -2.5});
+  writer.put(FourVector(1., 2., 3., 4.));
+  writer.write(file);
+  VERIFY(!std::filesystem::exists(testoutputpath / "values.bin.partial"));
+
+  CheckpointReader reader(file);
+  COMPARE(reader.get<int>(), 42);
+  COMPARE(reader.get<std::string>(), "smash");
+  COMPARE(reader.get<std::vector<double>>(), (std::vector<double>{1.5, -2.5}));
+  VERIFY(!reader.at_end());
+  COMPARE(reader.get<FourVector>(), FourVector(1., 2., 3., 4.));
+  VERIFY(reader.at_end());
+}
+
+TEST_CATCH(read_beyond_end, std::runtime_error) {
+  std::filesystem::create_directories(testoutputpath);
+  const auto file = testoutputpath / "short.bin";
+  CheckpointWriter writer;
+  writer.put(std::int32_t{1});
+  writer.write(file);
+  CheckpointReader reader(file);
+  reader.get<std::int64_t>();
+}
+
+TEST_CATCH(read_missing_file, std::runtime_error) {
+  CheckpointReader reader(testoutputpath / "missing.bin");
+}
+
+TEST(restore_particles_with_holes) {
+  std::filesystem::create_directories(testoutputpath);
+  const auto file = testoutputpath / "particles.bin";
+  Particles particles;
+  particles.create(6, 0x661);
+  const ParticleList list = particles.copy_to_vector();
+  particles.remove(list[1]);
+  particles.remove(list[4]);
+  CheckpointWriter writer;
+  particles.save(writer);
+  writer.write(file);
+
+  Particles restored;
+  restored.create(2, 0x661);
+  CheckpointReader reader(file);
+  restored.restore(reader);
+  VERIFY(reader.at_end());
+  COMPARE(restored.size(), particles.size());
+  COMPARE(restored.copy_to_vector(), particles.copy_to_vector());
+  VERIFY(restored.find(1) == nullptr);
+  COMPARE(restored.find(5)->id(), 5);
+  // The holes are filled in the same order
+  restored.insert(Test::smashon());
+  particles.insert(Test::smashon());
+  const ParticleList restored_list = restored.copy_to_vector();
+  const ParticleList original_list = particles.copy_to_vector();
+  for (std::size_t i = 0; i < original_list.size(); ++i) {
+    COMPARE(restored_list[i].id(), original_list[i].id());
+  }
+}
+
+TEST(restore_clocks) {
+  std::filesystem::create_directories(testoutputpath);
+  const auto file = testoutputpath / "clocks.bin";
+  UniformClock uniform(0.5, 0.2, 10.);
+  ++uniform;
+  ++uniform;
+  CustomClock custom({1., 2., 3.});
+  custom.reset(0.5, true);
+  ++custom;
+  CheckpointWriter writer;
+  uniform.save(writer);
+  custom.save(writer);
+  writer.write(file);
+
+  UniformClock restored_uniform(0., 1., 5.);
+  CustomClock restored_custom({5.});
+  CheckpointReader reader(file);
+  restored_uniform.restore(reader);
+  restored_custom.restore(reader);
+  COMPARE(restored_uniform.current_time(), uniform.current_time());
+  COMPARE(restored_uniform.next_time(), uniform.next_time());
+  COMPARE(restored_custom.current_time(), 1.);
+  COMPARE(restored_custom.next_time(), 2.);
+}
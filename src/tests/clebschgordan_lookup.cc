@@ -154,8 +154,8 @@ TEST(tabulate) {
    * to copy from a file than from the terminal).
    */
 #if 0
-  std::cerr << "\nstd::unordered_map<ThreeSpins, double, "
-               "smash::ThreeSpinHash> CG_coefficients =\n{\n";
+  std::cerr << "\nstatic constexpr TabulatedCoefficient "
+               "tabulated_coefficients[] =\n{\n";
   const auto double_digits = std::numeric_limits<double>::max_digits10;
   for (auto i = 0u; i < keys.size(); i++) {
     std::cerr << "  {" << keys[i] << ", " << std::setprecision(double_digits)
@@ -164,3 +164,37 @@ TEST(tabulate) {
   std::cerr << "};\n\n";
 #endif
 }
+
+TEST(dense_table) {
+  // Up to isospin 3 (times 2) of two particles and beyond the table
+  const int L = 7;
+  std::vector<double> before{};
+  for (auto l1 = 0; l1 <= L; l1++) {
+    for (auto l2 = 0; l2 <= L; l2++) {
+      for (auto l3 = 0; l3 <= L; l3++) {
+        for (auto m1 = -l1 - 2; m1 <= l1 + 2; m1++) {
+          for (auto m2 = -l2; m2 <= l2; m2 += 2) {
+            before.push_back(
+                ClebschGordan::coefficient(l1, l2, l3, m1, m2, m1 + m2));
+          }
+        }
+      }
+    }
+  }
+  ClebschGordan::create_table(3);
+  // The dense table gives the identical coefficients.
+  auto i = 0u;
+  for (auto l1 = 0; l1 <= L; l1++) {
+    for (auto l2 = 0; l2 <= L; l2++) {
+      for (auto l3 = 0; l3 <= L; l3++) {
+        for (auto m1 = -l1 - 2; m1 <= l1 + 2; m1++) {
+          for (auto m2 = -l2; m2 <= l2; m2 += 2) {
+            COMPARE(ClebschGordan::coefficient(l1, l2, l3, m1, m2, m1 + m2),
+                    before[i++]);
+          }
+        }
+      }
+    }
+  }
+  COMPARE(ClebschGordan::coefficient(1, 1, 2, 1, 1, 0), 0.);
+}
@@ -0,0 +1,413 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/crosssectioncache.h"
+
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+#include "smash/clebschgordan_lookup.h"
+#include "smash/threadpool.h"
+
+using namespace smash;
+
+namespace {
+/// A cross section with a threshold and a slow rise [mb]
+double some_cross_section(double sqrts) {
+  return (sqrts < 1.2 ? 10. : 30.) + 5. * std::sin(3. * sqrts);
+}
+
+/**
+ * A cross section conserving isospin [mb], which differs for every total
+ * isospin of the pair
+ */
+double isospin_cross_section(const ParticleType &a, const ParticleType &b,
+                             double sqrts) {
+  double xs = 0.;
+  for (int isospin = std::abs(a.isospin() - b.isospin());
+       isospin <= a.isospin() + b.isospin(); isospin += 2) {
+    const double cg = ClebschGordan::coefficient(
+        a.isospin(), b.isospin(), isospin, a.isospin3(), b.isospin3(),
+        a.isospin3() + b.isospin3());
+    xs += cg * cg * (1. + isospin) * some_cross_section(sqrts + 0.1 * isospin);
+  }
+  return xs;
+}
+
+/// The types of the pions and nucleons
+ParticleTypePtrList pions_and_nucleons() {
+  return {&ParticleType::find(0x211), &ParticleType::find(0x111),
+          &ParticleType::find(-0x211), &ParticleType::find(0x2212),
+          &ParticleType::find(0x2112)};
+}
+}  // namespace
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "π  0.138   7.7e-9    -      111      211\n"
+      "N  0.938   0         +      2112     2212\n");
+}
+
+TEST_CATCH(negative_tolerance, std::invalid_argument) {
+  CrossSectionCache cache(-0.1, [](const ParticleType &, const ParticleType &,
+                                   double) { return 0.; });
+}
+
+TEST_CATCH(no_spacing, std::invalid_argument) {
+  auto zero = [](const ParticleType &, const ParticleType &, double) {
+    return 0.;
+  };
+  CrossSectionCache cache(0.1, zero, 0.);
+}
+
+TEST(bound_from_above_within_range) {
+  const ParticleType &pion = ParticleType::find(0x211);
+  const ParticleType &proton = ParticleType::find(0x2212);
+  constexpr double spacing = 0.01, tolerance = 0.02;
+  constexpr std::size_t n_nodes = 200;
+  std::atomic<int> evaluations{0};
+  CrossSectionCache cache(
+      tolerance,
+      [&](const ParticleType &a, const ParticleType &b, double sqrts) {
+        evaluations++;
+        // The pair is always evaluated in the same order
+        VERIFY(!(&b < &a));
+        return some_cross_section(sqrts);
+      },
+      spacing, n_nodes);
+  COMPARE(cache.tolerance(), tolerance);
+  const double first = pion.mass() + proton.mass() + spacing;
+  const double last = first + (n_nodes - 1) * spacing;
+  // Outside of the nodes nothing is tabulated
+  VERIFY(!cache.upper_bound(pion, proton, first - 0.5 * spacing).has_value());
+  VERIFY(!cache.upper_bound(pion, proton, last).has_value());
+  COMPARE(evaluations.load(), 0);
+
+  for (double sqrts = first; sqrts < last; sqrts += 0.1 * spacing) {
+    const auto bound = cache.upper_bound(pion, proton, sqrts);
+    VERIFY(bound.has_value());
+    VERIFY(*bound >= some_cross_section(sqrts)) << sqrts;
+    VERIFY(*bound <= (1. + tolerance) * 36.) << sqrts;
+    const auto swapped = cache.upper_bound(proton, pion, sqrts);
+    VERIFY(swapped.has_value());
+    COMPARE(*swapped, *bound);
+  }
+  // Every node has been evaluated exactly once
+  COMPARE(evaluations.load(), static_cast<int>(n_nodes));
+}
+
+TEST(concurrent_lookups_match_serial) {
+  const ParticleType &pion = ParticleType::find(0x211);
+  const ParticleType &neutron = ParticleType::find(0x2112);
+  auto evaluate = [](const ParticleType &, const ParticleType &,
+                     double sqrts) { return some_cross_section(sqrts); };
+  const CrossSectionCache serial_cache(0.05, evaluate),
+      shared_cache(0.05, evaluate);
+  constexpr std::size_t n = 2000;
+  std::vector<double> serial(n), concurrent(n);
+  auto sqrts_of = [&](std::size_t i) {
+    return pion.mass() + neutron.mass() + 0.002 + 0.0023 * i;
+  };
+  for (std::size_t i = 0; i < n; i++) {
+    serial[i] = serial_cache.upper_bound(pion, neutron, sqrts_of(i)).value();
+  }
+  ThreadPool pool(4);
+  pool.parallel_for(n, [&](std::size_t i) {
+    concurrent[i] =
+        shared_cache.upper_bound(neutron, pion, sqrts_of(i)).value();
+  });
+  for (std::size_t i = 0; i < n; i++) {
+    COMPARE(concurrent[i], serial[i]) << i;
+  }
+}
+
+TEST(bound_up_to_covers_lower_energies) {
+  const ParticleType &pion = ParticleType::find(0x211);
+  const ParticleType &proton = ParticleType::find(0x2212);
+  constexpr double spacing = 0.01, tolerance = 0.02;
+  constexpr std::size_t n_nodes = 200;
+  const CrossSectionCache cache(
+      tolerance,
+      [](const ParticleType &, const ParticleType &, double sqrts) {
+        return some_cross_section(sqrts);
+      },
+      spacing, n_nodes);
+  const double first = pion.mass() + proton.mass() + spacing;
+  const double last = first + (n_nodes - 1) * spacing;
+  VERIFY(!cache.upper_bound_up_to(pion, proton, first - spacing).has_value());
+  VERIFY(!cache.upper_bound_up_to(pion, proton, last).has_value());
+  double previous = 0.;
+  for (double sqrts = first; sqrts < last; sqrts += 0.1 * spacing) {
+    const auto bound = cache.upper_bound_up_to(proton, pion, sqrts);
+    VERIFY(bound.has_value());
+    // The bound never decreases and covers every bound below
+    VERIFY(*bound >= previous) << sqrts;
+    VERIFY(*bound >= cache.upper_bound(pion, proton, sqrts).value()) << sqrts;
+    previous = *bound;
+  }
+  VERIFY(previous <= (1. + tolerance) * 36.);
+}
+
+TEST(tabulate_with_batch_evaluator) {
+  const ParticleType &pion = ParticleType::find(0x211);
+  const ParticleType &proton = ParticleType::find(0x2212);
+  constexpr double spacing = 0.01, tolerance = 0.02;
+  constexpr std::size_t n_nodes = 200;
+  auto evaluate = [](const ParticleType &, const ParticleType &,
+                     double sqrts) { return some_cross_section(sqrts); };
+  int n_batches = 0;
+  CrossSectionCache batch_cache(
+      tolerance,
+      [](const ParticleType &, const ParticleType &, double) {
+        FAIL() << "Tabulated nodes are evaluated in batches";
+        return 0.;
+      },
+      [&](const ParticleType &a, const ParticleType &b,
+          const std::vector<double> &sqrts, std::vector<double> &xs) {
+        n_batches++;
+        VERIFY(!(&b < &a));
+        COMPARE(xs.size(), sqrts.size());
+        for (std::size_t i = 0; i < sqrts.size(); i++) {
+          xs[i] = some_cross_section(sqrts[i]);
+        }
+      },
+      spacing, n_nodes);
+  const CrossSectionCache single_cache(tolerance, evaluate, spacing, n_nodes);
+  batch_cache.tabulate({&proton, &pion}, nullptr);
+  // One batch for each of the pairs pion-pion, pion-proton and proton-proton
+  COMPARE(n_batches, 3);
+  // Tabulating again evaluates nothing
+  batch_cache.tabulate({&pion, &proton}, nullptr);
+  COMPARE(n_batches, 3);
+  const double first = pion.mass() + proton.mass() + spacing;
+  for (std::size_t i = 0; i + 1 < n_nodes; i++) {
+    const double sqrts = first + (i + 0.5) * spacing;
+    COMPARE(batch_cache.upper_bound(proton, pion, sqrts).value(),
+            single_cache.upper_bound(pion, proton, sqrts).value())
+        << sqrts;
+  }
+}
+
+TEST(write_and_read_tables) {
+  const ParticleType &pion = ParticleType::find(0x211);
+  const ParticleType &proton = ParticleType::find(0x2212);
+  constexpr double spacing = 0.01;
+  constexpr std::size_t n_nodes = 200;
+  std::atomic<int> evaluations{0};
+  auto evaluate = [&](const ParticleType &, const ParticleType &,
+                      double sqrts) {
+    evaluations++;
+    return some_cross_section(sqrts);
+  };
+  CrossSectionCache written(0.05, evaluate, spacing, n_nodes);
+  ThreadPool pool(2);
+  written.tabulate({&pion, &proton}, &pool);
+  // Three pairs of two types
+  COMPARE(evaluations.load(), static_cast<int>(3 * n_nodes));
+
+  const auto path = std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) /
+                    "crosssectioncache" / "table.bin";
+  std::filesystem::create_directories(path.parent_path());
+  COMPARE(written.write(path), 3u);
+
+  evaluations = 0;
+  CrossSectionCache read(0.05, evaluate, spacing, n_nodes);
+  COMPARE(read.read(path), 3u);
+  // Only a few nodes of every pair are compared
+  VERIFY(evaluations.load() <= 3 * 5);
+  const int compared = evaluations.load();
+  const double first = pion.mass() + proton.mass() + spacing;
+  for (double sqrts = first; sqrts < first + (n_nodes - 1) * spacing;
+       sqrts += 0.3 * spacing) {
+    COMPARE(read.upper_bound(proton, pion, sqrts).value(),
+            written.upper_bound(pion, proton, sqrts).value())
+        << sqrts;
+  }
+  COMPARE(evaluations.load(), compared);
+
+  // Other cross sections or nodes are rejected
+  CrossSectionCache other_xs(
+      0.05,
+      [](const ParticleType &, const ParticleType &, double sqrts) {
+        return 2. * some_cross_section(sqrts);
+      },
+      spacing, n_nodes);
+  bool rejected = false;
+  try {
+    other_xs.read(path);
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  VERIFY(rejected);
+  CrossSectionCache other_nodes(0.05, evaluate, 0.5 * spacing, n_nodes);
+  rejected = false;
+  try {
+    other_nodes.read(path);
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  VERIFY(rejected);
+}
+
+TEST_CATCH(read_missing_table, std::runtime_error) {
+  CrossSectionCache cache(0.05, [](const ParticleType &, const ParticleType &,
+                                   double) { return 0.; });
+  cache.read(std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) /
+             "crosssectioncache" / "missing.bin");
+}
+
+TEST(isospin_reduced_tables_reconstruct_members) {
+  constexpr double spacing = 0.01, tolerance = 0.02;
+  constexpr std::size_t n_nodes = 1000;
+  std::atomic<int> evaluations{0};
+  auto evaluate = [&](const ParticleType &a, const ParticleType &b,
+                      double sqrts) {
+    evaluations++;
+    VERIFY(!(&b < &a));
+    return isospin_cross_section(a, b, sqrts);
+  };
+  const CrossSectionCache per_types(tolerance, evaluate, spacing, n_nodes);
+  CrossSectionCache reduced(tolerance, evaluate, spacing, n_nodes, true);
+  const ParticleTypePtrList types = pions_and_nucleons();
+  reduced.tabulate(types, nullptr);
+  /* The tables of pion-pion, pion-nucleon and nucleon-nucleon with 3, 2 and
+   * 2 total isospins instead of 15 pairs of types, besides the nodes at which
+   * the isospin is checked */
+  VERIFY(evaluations.load() < static_cast<int>(8 * n_nodes));
+  const int tabulated = evaluations.load();
+  for (const ParticleTypePtr a : types) {
+    for (const ParticleTypePtr b : types) {
+      VERIFY(reduced.is_isospin_reduced(*a, *b));
+      const double first = a->mass() + b->mass() + spacing;
+      for (double sqrts = first; sqrts < first + (n_nodes - 1) * spacing;
+           sqrts += 0.7 * spacing) {
+        const double expected = per_types.upper_bound(*a, *b, sqrts).value();
+        const double bound = reduced.upper_bound(*a, *b, sqrts).value();
+        VERIFY(std::abs(bound - expected) <= 1e-12 * expected)
+            << a->name() << " " << b->name() << " " << sqrts;
+        VERIFY(bound >= isospin_cross_section(*a, *b, sqrts)) << sqrts;
+      }
+    }
+  }
+  COMPARE(evaluations.load() - tabulated, 15 * static_cast<int>(n_nodes));
+}
+
+TEST(tabulate_isospin_reduced_with_batch_evaluator) {
+  constexpr double spacing = 0.01;
+  constexpr std::size_t n_nodes = 200;
+  auto evaluate = [](const ParticleType &a, const ParticleType &b,
+                     double sqrts) {
+    return isospin_cross_section(a, b, sqrts);
+  };
+  int n_batches = 0;
+  CrossSectionCache batch_cache(
+      0.05, evaluate,
+      [&](const ParticleType &a, const ParticleType &b,
+          const std::vector<double> &sqrts, std::vector<double> &xs) {
+        n_batches++;
+        VERIFY(!(&b < &a));
+        for (std::size_t i = 0; i < sqrts.size(); i++) {
+          xs[i] = isospin_cross_section(a, b, sqrts[i]);
+        }
+      },
+      spacing, n_nodes, true);
+  const CrossSectionCache single_cache(0.05, evaluate, spacing, n_nodes, true);
+  const ParticleTypePtrList types = pions_and_nucleons();
+  batch_cache.tabulate(types, nullptr);
+  // One batch for every total isospin of the three pairs of multiplets
+  COMPARE(n_batches, 3 + 2 + 2);
+  for (const ParticleTypePtr a : types) {
+    for (const ParticleTypePtr b : types) {
+      const double first = a->mass() + b->mass() + spacing;
+      for (std::size_t i = 0; i + 1 < n_nodes; i++) {
+        const double sqrts = first + (i + 0.5) * spacing;
+        COMPARE(batch_cache.upper_bound(*a, *b, sqrts).value(),
+                single_cache.upper_bound(*a, *b, sqrts).value())
+            << sqrts;
+      }
+    }
+  }
+}
+
+TEST(isospin_violation_keeps_tables_of_types) {
+  constexpr double spacing = 0.01;
+  constexpr std::size_t n_nodes = 200;
+  // Neutral pions and nucleons interact differently from charged ones
+  auto evaluate = [](const ParticleType &a, const ParticleType &b,
+                     double sqrts) {
+    return some_cross_section(sqrts) *
+           (1. + 0.1 * a.charge() * a.charge() * b.charge() * b.charge());
+  };
+  const CrossSectionCache per_types(0.05, evaluate, spacing, n_nodes);
+  const CrossSectionCache reduced(0.05, evaluate, spacing, n_nodes, true);
+  const ParticleType &pi_plus = ParticleType::find(0x211);
+  const ParticleType &proton = ParticleType::find(0x2212);
+  VERIFY(!reduced.is_isospin_reduced(pi_plus, proton));
+  // Also the neutral members keep their tables, like all pions and nucleons
+  VERIFY(!reduced.is_isospin_reduced(ParticleType::find(0x111),
+                                     ParticleType::find(0x2112)));
+  const double first = pi_plus.mass() + proton.mass() + spacing;
+  for (double sqrts = first; sqrts < first + (n_nodes - 1) * spacing;
+       sqrts += 0.7 * spacing) {
+    COMPARE(reduced.upper_bound(proton, pi_plus, sqrts).value(),
+            per_types.upper_bound(pi_plus, proton, sqrts).value());
+  }
+}
+
+TEST(write_and_read_isospin_reduced_tables) {
+  constexpr double spacing = 0.01;
+  constexpr std::size_t n_nodes = 200;
+  auto evaluate = [](const ParticleType &a, const ParticleType &b,
+                     double sqrts) {
+    return isospin_cross_section(a, b, sqrts);
+  };
+  CrossSectionCache written(0.05, evaluate, spacing, n_nodes, true);
+  const ParticleTypePtrList types = pions_and_nucleons();
+  ThreadPool pool(2);
+  written.tabulate(types, &pool);
+  const auto path = std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) /
+                    "crosssectioncache" / "reduced.bin";
+  std::filesystem::create_directories(path.parent_path());
+  // A table for every pair of types
+  COMPARE(written.write(path), 15u);
+
+  // The tables are readable with and without reducing the isospin
+  for (const bool reduce : {false, true}) {
+    std::atomic<int> evaluations{0};
+    CrossSectionCache read(
+        0.05,
+        [&](const ParticleType &a, const ParticleType &b, double sqrts) {
+          evaluations++;
+          return isospin_cross_section(a, b, sqrts);
+        },
+        spacing, n_nodes, reduce);
+    COMPARE(read.read(path), 15u);
+    const int compared = evaluations.load();
+    for (const ParticleTypePtr a : types) {
+      for (const ParticleTypePtr b : types) {
+        const double first = a->mass() + b->mass() + spacing;
+        for (double sqrts = first; sqrts < first + (n_nodes - 1) * spacing;
+             sqrts += 0.3 * spacing) {
+          const double expected = written.upper_bound(*a, *b, sqrts).value();
+          const double bound = read.upper_bound(*a, *b, sqrts).value();
+          VERIFY(std::abs(bound - expected) <= 1e-12 * expected)
+              << reduce << " " << sqrts;
+        }
+      }
+    }
+    // Nothing is evaluated besides the checks of the tables read
+    COMPARE(evaluations.load(), compared) << reduce;
+  }
+}
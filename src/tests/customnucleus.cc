@@ -0,0 +1,66 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/customnucleus.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) / "customnucleus";
+
+TEST(binary_cache) {
+  std::filesystem::create_directories(testoutputpath);
+  const auto list = testoutputpath / "nuclei.txt";
+  const auto cache = CustomNucleusCache::cache_path(list);
+  std::filesystem::remove(cache);
+  {
+    std::ofstream out(list);
+    // The last line without a line break is never read from the list.
+    out << "0.5 -1.0 2.0 1 1\n-0.25 0.0 1.5 0 0\n1.0 1.0 1.0 0 1\n2 2 2 1 1";
+  }
+  for (int pass = 0; pass < 2; pass++) {
+    // The first pass builds the cache, the second one maps it.
+    CustomNucleusCache nucleons(list);
+    VERIFY(std::filesystem::exists(cache));
+    COMPARE(nucleons.size(), 3u);
+    COMPARE(nucleons[0].x, 0.5);
+    COMPARE(nucleons[0].y, -1.0);
+    COMPARE(nucleons[0].z, 2.0);
+    VERIFY(nucleons[0].spinprojection);
+    VERIFY(nucleons[0].isospin);
+    COMPARE(nucleons[1].x, -0.25);
+    VERIFY(!nucleons[1].spinprojection);
+    VERIFY(!nucleons[1].isospin);
+    // Sequential reading starts over at the end of the list.
+    for (int i = 0; i < 4; i++) {
+      COMPARE(nucleons.next().x, nucleons[i % 3].x);
+    }
+  }
+
+  // A changed list is parsed again.
+  {
+    std::ofstream out(list);
+    out << "3.0 0.0 0.0 0 0\n";
+  }
+  CustomNucleusCache nucleons(list);
+  COMPARE(nucleons.size(), 1u);
+  COMPARE(nucleons[0].x, 3.0);
+}
+
+TEST_CATCH(empty_list, std::runtime_error) {
+  std::filesystem::create_directories(testoutputpath);
+  const auto list = testoutputpath / "empty.txt";
+  std::ofstream(list).close();
+  CustomNucleusCache nucleons(list);
+}
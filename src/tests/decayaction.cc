@@ -14,6 +14,8 @@
 #include <typeinfo>
 
 #include "setup.h"
+#include "smash/decayactionsfinder.h"
+#include "smash/decaychanneltable.h"
 #include "smash/decaymodes.h"
 
 using namespace smash;
@@ -125,3 +127,75 @@ TEST(create_decayaction) {
   const auto act = std::make_unique<DecayAction>(H, time_of_execution);
   std::cout << *act << std::endl;
 }
+
+TEST(channel_table) {
+  // η3 decays only into η2 η1, which are stable
+  const ParticleType &A3 = ParticleType::find(0x30661);
+  VERIFY(DecayChannelTable(A3, WhichDecaymodes::All).is_mass_independent());
+
+  ParticleData H{ParticleType::find(0x50661)};
+  H.set_4momentum(4.0, 0., 0., 0.);
+  const DecayChannelTable table(H.type(), WhichDecaymodes::All);
+  VERIFY(!table.is_mass_independent());
+  const DecayBranchList H_decays = H.type().get_partial_widths(
+      H.momentum(), H.position().threevec(), WhichDecaymodes::All);
+  double total_width = 0.;
+  for (const auto &mode : H_decays) {
+    total_width += mode->weight();
+  }
+  constexpr int n_samples = 100000;
+  std::vector<int> counts(H_decays.size(), 0);
+  for (int i = 0; i < n_samples; i++) {
+    const DecayBranch *branch = table.sample(H.effective_mass(), H_decays);
+    VERIFY(branch != nullptr);
+    for (std::size_t j = 0; j < H_decays.size(); j++) {
+      counts[j] += branch == H_decays[j].get();
+    }
+  }
+  // The semistable decay is too rare to be compared.
+  for (std::size_t j = 1; j < H_decays.size(); j++) {
+    COMPARE_RELATIVE_ERROR(static_cast<double>(counts[j]) / n_samples,
+                           H_decays[j]->weight() / total_width, 2.e-2);
+  }
+  // Masses beyond the pole mass plus ten widths are not tabulated.
+  VERIFY(table.sample(10., H_decays) == nullptr);
+}
+
+TEST(presampled_decay_times) {
+  ParticleData H{ParticleType::find(0x50661), 1};
+  H.set_4momentum(4.0, ThreeVector(1.0, 0.0, 0.0));
+  H.set_4position(FourVector(2.0, 0.0, 0.0, 0.0));
+  const ParticleList list{H};
+  const DecayActionsFinder finder(1.0, false, false);
+  DecayTimes decay_times;
+  {
+    const DecayTimes::Scoped scoped(&decay_times);
+    VERIFY(finder.find_actions_in_cell(list, 0.0, 0.0, {}).empty());
+  }
+  COMPARE(decay_times.size(), 1u);
+  const std::optional<double> time = decay_times.find(H);
+  VERIFY(time.has_value());
+  VERIFY(*time >= 2.0);
+  // The decay time is found again in the time step it falls into
+  {
+    const DecayTimes::Scoped scoped(&decay_times);
+    ActionList actions =
+        finder.find_actions_in_cell(list, *time - 2.0 + 0.1, 0.0, {});
+    COMPARE(actions.size(), 1u);
+    COMPARE_ABSOLUTE_ERROR(actions[0]->time_of_execution(), *time, 1e-12);
+  }
+  COMPARE(decay_times.find(H), time);
+  // Without installed decay times, nothing is remembered
+  VERIFY(DecayTimes::current() == nullptr);
+  finder.find_actions_in_cell(list, 0.0, 0.0, {});
+  COMPARE(decay_times.size(), 1u);
+  // Another momentum needs another decay time
+  ParticleData kicked = H;
+  kicked.set_4momentum(4.0, ThreeVector(0.0, 1.0, 0.0));
+  VERIFY(!decay_times.find(kicked).has_value());
+  // Decay times which have passed are forgotten
+  decay_times.forget_before(*time);
+  COMPARE(decay_times.size(), 1u);
+  decay_times.forget_before(*time + 1.0);
+  COMPARE(decay_times.size(), 0u);
+}
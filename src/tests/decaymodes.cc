@@ -237,6 +237,51 @@ TEST(load_decaymodes_3body) {
   }
 }
 
+TEST(channels_match_decay_modes) {
+  DecayModes::load_decaymodes(decays_input);
+  std::vector<double> widths;
+  for (const ParticleType &type : ParticleType::list_all()) {
+    const auto &modelist = type.decay_modes().decay_mode_list();
+    const auto &channels = type.decay_modes().channels();
+    COMPARE(channels.size(), modelist.size()) << type.name();
+    for (std::size_t i = 0; i < channels.size(); i++) {
+      COMPARE(channels[i].type, &modelist[i]->type());
+      COMPARE(channels[i].threshold, modelist[i]->threshold());
+      COMPARE(channels[i].is_dilepton, modelist[i]->type().is_dilepton_decay());
+    }
+    if (channels.empty()) {
+      continue;
+    }
+    // The widths are the same as evaluated from the decay branches
+    for (double m = 0.; m < 3.; m += 0.01) {
+      double total = 0.;
+      for (std::size_t i = 0; i < channels.size(); i++) {
+        const double width = type.partial_width(m, modelist[i].get());
+        COMPARE(channels[i].width(type.mass(), m), width) << type.name();
+        total = total + width;
+      }
+      COMPARE(type.total_width(m), total < ParticleType::width_cutoff ? 0. : total);
+      const FourVector p(std::sqrt(m * m + 0.04), 0.2, 0., 0.);
+      const DecayBranchList branches = type.get_partial_widths(
+          p, ThreeVector(), WhichDecaymodes::Hadronic);
+      COMPARE(type.get_partial_widths(p, ThreeVector(),
+                                      WhichDecaymodes::Hadronic, widths),
+              type.get_total_width(p, ThreeVector(),
+                                   WhichDecaymodes::Hadronic));
+      COMPARE(widths.size(), channels.size());
+      std::size_t k = 0;
+      for (std::size_t i = 0; i < channels.size(); i++) {
+        if (widths[i] > 0.) {
+          COMPARE(&branches[k]->type(), channels[i].type);
+          COMPARE(branches[k]->weight(), widths[i]);
+          k++;
+        }
+      }
+      COMPARE(k, branches.size());
+    }
+  }
+}
+
 TEST_CATCH(add_no_particles, DecayModes::InvalidDecay) {
   DecayModes m;
   m.add_mode(&ParticleType::find(0x113), 1., 0, {});
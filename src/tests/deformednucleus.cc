@@ -12,6 +12,7 @@
 #include "smash/deformednucleus.h"
 
 #include <map>
+#include <utility>
 #include <vector>
 
 #include "setup.h"
@@ -282,3 +283,27 @@ TEST(nucleon_density_norm) {
                            allowed_errors[index]);
   }
 }
+
+TEST(tabulated_positions) {
+  DeformedNucleus dnucleus(small_list, 1);
+  dnucleus.set_nuclear_radius(6.86);
+  dnucleus.set_diffusiveness(0.556);
+  dnucleus.set_beta_2(0.28);
+  dnucleus.set_beta_4(0.093);
+  // Moments of the positions sampled by rejection and from the tables
+  const auto moments = [&dnucleus](bool tabulated) {
+    dnucleus.set_tabulated_positions(tabulated);
+    constexpr int n_samples = 1000000;
+    double r2 = 0., z2 = 0.;
+    for (int i = 0; i < n_samples; i++) {
+      const ThreeVector pos = dnucleus.distribute_nucleon();
+      r2 += pos.sqr() / n_samples;
+      z2 += pos.x3() * pos.x3() / n_samples;
+    }
+    return std::make_pair(r2, z2);
+  };
+  const auto rejection = moments(false);
+  const auto tabulated = moments(true);
+  COMPARE_RELATIVE_ERROR(tabulated.first, rejection.first, 1.e-2);
+  COMPARE_RELATIVE_ERROR(tabulated.second, rejection.second, 1.e-2);
+}
@@ -13,6 +13,7 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
 
 #include "setup.h"
 #include "smash/boxmodus.h"
@@ -185,6 +186,367 @@ TEST(smearing_factor_normalization) {
   COMPARE_RELATIVE_ERROR(int_rho_r_d3r, 1.0, 3.e-6);
 }
 
+TEST(concurrent_smearing_matches_serial) {
+  const std::array<double, 3> l = {10., 10., 10.};
+  const std::array<int, 3> n = {20, 20, 20};
+  const std::array<double, 3> origin = {-5., -5., -5.};
+  std::vector<Particles> ensembles(2);
+  for (Particles &particles : ensembles) {
+    for (int i = 0; i < 50; i++) {
+      ParticleData proton = create_proton();
+      proton.set_4momentum(0.938, ThreeVector(random::uniform(-1., 1.),
+                                              random::uniform(-1., 1.),
+                                              random::uniform(-1., 1.)));
+      proton.set_4position(FourVector(0., random::uniform(-4., 4.),
+                                      random::uniform(-4., 4.),
+                                      random::uniform(-4., 4.)));
+      particles.insert(proton);
+    }
+  }
+  std::vector<std::unique_ptr<ThreadPool>> pools;
+  for (const int n_threads : {2, 3, 5}) {
+    pools.push_back(std::make_unique<ThreadPool>(n_threads));
+  }
+  for (const bool periodic : {false, true}) {
+    DensityLattice serial(l, n, origin, periodic,
+                          LatticeUpdate::EveryTimestep);
+    DensityLattice concurrent(serial);
+    for (const SmearingMode mode :
+         {SmearingMode::CovariantGaussian, SmearingMode::Discrete,
+          SmearingMode::Triangular}) {
+      const DensityParameters dens_par(smash::Test::default_parameters(
+          1, 0.1, CollisionCriterion::Geometric, false,
+          NNbarTreatment::NoAnnihilation,
+          smash::Test::all_reactions_included(), mode));
+      update_lattice_accumulating_ensembles(
+          &serial, LatticeUpdate::EveryTimestep, DensityType::Baryon,
+          dens_par, ensembles, true);
+      double total = 0.;
+      for (std::size_t i = 0; i < serial.size(); i++) {
+        total += serial[i].rho();
+      }
+      VERIFY(total > 0.);
+      // The sums at the nodes do not depend on the number of threads
+      for (const auto &pool : pools) {
+        update_lattice_accumulating_ensembles(
+            &concurrent, LatticeUpdate::EveryTimestep, DensityType::Baryon,
+            dens_par, ensembles, true, pool.get());
+        for (std::size_t i = 0; i < serial.size(); i++) {
+          for (int mu = 0; mu < 4; mu++) {
+            COMPARE(concurrent[i].jmu_net()[mu], serial[i].jmu_net()[mu])
+                << "node " << i << ", " << pool->size() << " threads";
+          }
+          COMPARE(concurrent[i].grad_j0()[0], serial[i].grad_j0()[0])
+              << "node " << i << ", " << pool->size() << " threads";
+        }
+      }
+    }
+  }
+}
+
+TEST(fused_smearing_matches_separate) {
+  const std::array<double, 3> l = {10., 10., 10.};
+  const std::array<int, 3> n = {20, 20, 20};
+  const std::array<double, 3> origin = {-5., -5., -5.};
+  DensityLattice baryon(l, n, origin, false, LatticeUpdate::EveryTimestep);
+  DensityLattice isospin(baryon), fused_baryon(baryon), fused_isospin(baryon);
+  std::vector<Particles> ensembles(2);
+  for (Particles &particles : ensembles) {
+    for (int i = 0; i < 50; i++) {
+      // protons and neutrons contribute with opposite isospin
+      ParticleData nucleon{ParticleType::find(i % 2 ? 0x2212 : 0x2112)};
+      nucleon.set_4momentum(0.938, ThreeVector(random::uniform(-1., 1.),
+                                               random::uniform(-1., 1.),
+                                               random::uniform(-1., 1.)));
+      nucleon.set_4position(FourVector(0., random::uniform(-4., 4.),
+                                       random::uniform(-4., 4.),
+                                       random::uniform(-4., 4.)));
+      particles.insert(nucleon);
+    }
+  }
+  ThreadPool pool(3);
+  for (ThreadPool *thread_pool : {static_cast<ThreadPool *>(nullptr), &pool}) {
+    for (const SmearingMode mode :
+         {SmearingMode::CovariantGaussian, SmearingMode::Discrete,
+          SmearingMode::Triangular}) {
+      const DensityParameters dens_par(smash::Test::default_parameters(
+          1, 0.1, CollisionCriterion::Geometric, false,
+          NNbarTreatment::NoAnnihilation,
+          smash::Test::all_reactions_included(), mode));
+      update_lattice_accumulating_ensembles(
+          &baryon, LatticeUpdate::EveryTimestep, DensityType::Baryon,
+          dens_par, ensembles, true, thread_pool);
+      update_lattice_accumulating_ensembles(
+          &isospin, LatticeUpdate::EveryTimestep,
+          DensityType::BaryonicIsospin, dens_par, ensembles, true,
+          thread_pool);
+      update_lattices(std::array<DensityLattice *, 2>{&fused_baryon,
+                                                      &fused_isospin},
+                      nullptr, nullptr, nullptr, LatticeUpdate::EveryTimestep,
+                      {DensityType::Baryon, DensityType::BaryonicIsospin},
+                      dens_par, ensembles, 0.1, true, thread_pool);
+      // The fused update gives exactly the same lattices
+      for (std::size_t i = 0; i < baryon.size(); i++) {
+        for (int mu = 0; mu < 4; mu++) {
+          COMPARE(fused_baryon[i].jmu_net()[mu], baryon[i].jmu_net()[mu])
+              << "node " << i;
+          COMPARE(fused_isospin[i].jmu_net()[mu], isospin[i].jmu_net()[mu])
+              << "node " << i;
+        }
+        COMPARE(fused_baryon[i].grad_j0()[0], baryon[i].grad_j0()[0])
+            << "node " << i;
+        COMPARE(fused_isospin[i].grad_j0()[0], isospin[i].grad_j0()[0])
+            << "node " << i;
+      }
+    }
+  }
+}
+
+TEST(incremental_update_matches_full_update) {
+  const std::array<double, 3> l = {10., 10., 10.};
+  const std::array<int, 3> n = {20, 20, 20};
+  const std::array<double, 3> origin = {-5., -5., -5.};
+  auto random_position = []() {
+    return FourVector(0., random::uniform(-4., 4.), random::uniform(-4., 4.),
+                      random::uniform(-4., 4.));
+  };
+  for (const SmearingMode mode :
+       {SmearingMode::CovariantGaussian, SmearingMode::Discrete,
+        SmearingMode::Triangular}) {
+    const DensityParameters dens_par(smash::Test::default_parameters(
+        1, 0.1, CollisionCriterion::Geometric, false,
+        NNbarTreatment::NoAnnihilation, smash::Test::all_reactions_included(),
+        mode));
+    std::vector<Particles> ensembles(2);
+    for (Particles &particles : ensembles) {
+      for (int i = 0; i < 40; i++) {
+        // antiprotons contribute to the current of negative charges
+        ParticleData nucleon{ParticleType::find(i % 4 ? 0x2212 : -0x2212)};
+        nucleon.set_4momentum(0.938, ThreeVector(random::uniform(-1., 1.),
+                                                 random::uniform(-1., 1.),
+                                                 random::uniform(-1., 1.)));
+        nucleon.set_4position(random_position());
+        particles.insert(nucleon);
+      }
+    }
+    DensityLattice full(l, n, origin, false, LatticeUpdate::EveryTimestep);
+    DensityLattice incremental(full);
+    SmearedParticles smeared(0.05, 2);
+    for (int step = 0; step < 4; step++) {
+      if (step > 0) {
+        // a few particles move, one is gone and one is new per ensemble
+        for (Particles &particles : ensembles) {
+          int i = 0;
+          for (ParticleData &part : particles) {
+            if (i++ % 7 == 0) {
+              part.set_4position(random_position());
+            }
+          }
+          particles.remove(particles.front());
+          ParticleData proton = create_proton();
+          proton.set_4momentum(0.938, 0., 0., 0.5);
+          proton.set_4position(random_position());
+          particles.insert(proton);
+        }
+      }
+      update_lattice_accumulating_ensembles(
+          &full, LatticeUpdate::EveryTimestep, DensityType::Baryon, dens_par,
+          ensembles, true);
+      update_lattice_accumulating_ensembles(
+          &incremental, LatticeUpdate::EveryTimestep, DensityType::Baryon,
+          dens_par, ensembles, true, nullptr, &smeared);
+      for (std::size_t i = 0; i < full.size(); i++) {
+        for (int mu = 0; mu < 4; mu++) {
+          COMPARE_ABSOLUTE_ERROR(incremental[i].jmu_net()[mu],
+                                 full[i].jmu_net()[mu], 1e-12)
+              << "node " << i << ", step " << step;
+        }
+        COMPARE_ABSOLUTE_ERROR(incremental[i].rho(), full[i].rho(), 1e-12)
+            << "node " << i << ", step " << step;
+        COMPARE_ABSOLUTE_ERROR(incremental[i].grad_j0()[0],
+                               full[i].grad_j0()[0], 1e-12)
+            << "node " << i << ", step " << step;
+      }
+    }
+  }
+}
+
+TEST(smeared_particles_find_changes) {
+  std::vector<Particles> ensembles(1);
+  for (int i = 0; i < 10; i++) {
+    ParticleData proton = create_proton();
+    proton.set_4momentum(0.938, 0., 0., 0.);
+    ensembles[0].insert(proton);
+  }
+  SmearedParticles smeared(0.1, 5);
+  // Nothing is remembered yet
+  VERIFY(!smeared.find_changes(ensembles));
+  smeared.remember(ensembles);
+  VERIFY(smeared.find_changes(ensembles));
+  COMPARE(smeared.removed().size(), 0u);
+  COMPARE(smeared.added().size(), 0u);
+  smeared.remember_changes();
+  auto it = ensembles[0].begin();
+  // below the tolerance
+  it->set_4position(FourVector(0., 0.05, 0., 0.));
+  // above the tolerance
+  (++it)->set_4position(FourVector(0., 0.5, 0., 0.));
+  // collided elastically
+  (++it)->set_history(1, 1, ProcessType::Elastic, 0., {});
+  // gone
+  ensembles[0].remove(*(++it));
+  // new
+  ensembles[0].insert(create_antiproton());
+  VERIFY(smeared.find_changes(ensembles));
+  COMPARE(smeared.removed().size(), 3u);
+  COMPARE(smeared.added().size(), 3u);
+  smeared.remember_changes();
+  VERIFY(smeared.find_changes(ensembles));
+  COMPARE(smeared.removed().size(), 0u);
+  COMPARE(smeared.added().size(), 0u);
+  // Too many changes
+  for (ParticleData &part : ensembles[0]) {
+    part.set_4position(FourVector(0., 1., 1., 1.));
+  }
+  VERIFY(!smeared.find_changes(ensembles));
+  smeared.clear();
+  VERIFY(!smeared.find_changes(ensembles));
+}
+
+TEST(lattice_smearing_matches_smearing_factor) {
+  const std::array<double, 3> l = {6., 6., 6.};
+  const std::array<int, 3> n = {12, 12, 12};
+  const std::array<double, 3> origin = {-3., -3., -3.};
+  DensityLattice lattice(l, n, origin, false, LatticeUpdate::EveryTimestep);
+  DensityLattice expected(lattice);
+  std::vector<Particles> ensembles(1);
+  ParticleData proton = create_proton();
+  proton.set_4momentum(0.938, ThreeVector(0.3, -0.5, 0.8));
+  proton.set_4position(FourVector(0., 0.2, -0.3, 0.1));
+  const ParticleData &part = ensembles[0].insert(proton);
+  const DensityParameters dens_par(smash::Test::default_parameters());
+  update_lattice_accumulating_ensembles(&lattice, LatticeUpdate::EveryTimestep,
+                                        DensityType::Baryon, dens_par,
+                                        ensembles, true);
+  // The kernel gives the same result as the smearing factor at every node
+  const double m_inv = 1.0 / part.momentum().abs();
+  const double norm = dens_par.norm_factor_sf();
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    const ThreeVector r = expected.cell_center(i);
+    const auto sf = unnormalized_smearing_factor(
+        part.position().threevec() - r, part.momentum(), m_inv, dens_par, true);
+    expected[i].add_particle(part, sf.first * norm);
+    expected[i].add_particle_for_derivatives(part, 1., sf.second * norm);
+  }
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    for (int mu = 0; mu < 4; mu++) {
+      COMPARE(lattice[i].jmu_net()[mu], expected[i].jmu_net()[mu]);
+      for (int nu = 0; nu < 4; nu++) {
+        COMPARE(lattice[i].djmu_dxnu()[nu][mu], expected[i].djmu_dxnu()[nu][mu])
+            << "node " << i;
+      }
+    }
+  }
+}
+
+TEST(lattice_currents_match_current_eckart) {
+  const std::array<double, 3> l = {8., 8., 8.};
+  const std::array<int, 3> n = {8, 8, 8};
+  const std::array<double, 3> origin = {-4., -4., -4.};
+  DensityLattice charge(l, n, origin, false, LatticeUpdate::AtOutput);
+  DensityLattice baryon(charge), strangeness(charge);
+  std::vector<Particles> ensembles(2);
+  for (Particles &particles : ensembles) {
+    for (const PdgCode pdg : {0x2212, -0x2212, 0x2112, 0x211, -0x211}) {
+      for (int i = 0; i < 10; i++) {
+        ParticleData part{ParticleType::find(pdg)};
+        part.set_4momentum(part.pole_mass(),
+                           ThreeVector(random::uniform(-1., 1.),
+                                       random::uniform(-1., 1.),
+                                       random::uniform(-1., 1.)));
+        part.set_4position(FourVector(0., random::uniform(-5., 5.),
+                                      random::uniform(-5., 5.),
+                                      random::uniform(-5., 5.)));
+        particles.insert(part);
+      }
+    }
+  }
+  const DensityParameters dens_par(smash::Test::default_parameters());
+  update_lattices_accumulating_ensembles<DensityOnLattice, 3>(
+      {&charge, &baryon, &strangeness}, LatticeUpdate::AtOutput,
+      {DensityType::Charge, DensityType::Baryon, DensityType::Strangeness},
+      dens_par, ensembles, false);
+  // The smeared currents are the ones summed at every node
+  for (std::size_t i = 0; i < charge.size(); i++) {
+    const ThreeVector r = charge.cell_center(i);
+    FourVector jQ, jB, jS;
+    for (const Particles &particles : ensembles) {
+      jQ += std::get<1>(current_eckart(r, particles, dens_par,
+                                       DensityType::Charge, false, true));
+      jB += std::get<1>(current_eckart(r, particles, dens_par,
+                                       DensityType::Baryon, false, true));
+      jS += std::get<1>(current_eckart(r, particles, dens_par,
+                                       DensityType::Strangeness, false, true));
+    }
+    for (int mu = 0; mu < 4; mu++) {
+      COMPARE_ABSOLUTE_ERROR(charge[i].jmu_net()[mu], jQ[mu], 1.e-12)
+          << "node " << i;
+      COMPARE_ABSOLUTE_ERROR(baryon[i].jmu_net()[mu], jB[mu], 1.e-12)
+          << "node " << i;
+      COMPARE(strangeness[i].jmu_net()[mu], jS[mu]) << "node " << i;
+    }
+  }
+}
+
+TEST(triangular_smearing_matches_direct_weights) {
+  const std::array<double, 3> l = {6., 6., 6.};
+  const std::array<int, 3> n = {12, 12, 12};
+  const std::array<double, 3> origin = {-3., -3., -3.};
+  DensityLattice lattice(l, n, origin, false, LatticeUpdate::EveryTimestep);
+  DensityLattice expected(lattice);
+  std::vector<Particles> ensembles(1);
+  ParticleData proton = create_proton();
+  proton.set_4momentum(0.938, ThreeVector(0.3, -0.5, 0.8));
+  proton.set_4position(FourVector(0., 0.2, -0.3, 0.1));
+  const ParticleData &part = ensembles[0].insert(proton);
+  const DensityParameters dens_par(smash::Test::default_parameters(
+      1, 0.1, CollisionCriterion::Geometric, false,
+      NNbarTreatment::NoAnnihilation, smash::Test::all_reactions_included(),
+      SmearingMode::Triangular));
+  update_lattice_accumulating_ensembles(&lattice, LatticeUpdate::EveryTimestep,
+                                        DensityType::Baryon, dens_par,
+                                        ensembles, false);
+  // Every node within the range gets the product of the weights along the axes
+  const ThreeVector pos = part.position().threevec();
+  std::array<double, 3> radius;
+  double prefactor = 1.0;
+  for (int k = 0; k < 3; k++) {
+    radius[k] = dens_par.triangular_range() * lattice.cell_sizes()[k];
+    prefactor *= radius[k] * radius[k];
+  }
+  prefactor = 1.0 / prefactor;
+  int nodes_with_weight = 0;
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    const ThreeVector r = expected.cell_center(i);
+    std::array<double, 3> weights;
+    for (int k = 0; k < 3; k++) {
+      weights[k] = radius[k] - std::abs(r[k] - pos[k]);
+    }
+    if (weights[0] > 0. && weights[1] > 0. && weights[2] > 0.) {
+      expected[i].add_particle(
+          part, prefactor * weights[0] * weights[1] * weights[2]);
+      nodes_with_weight++;
+    }
+  }
+  VERIFY(nodes_with_weight > 0);
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    for (int mu = 0; mu < 4; mu++) {
+      FUZZY_COMPARE(lattice[i].jmu_net()[mu], expected[i].jmu_net()[mu])
+          << "node " << i;
+    }
+  }
+}
+
 TEST(smearing_factor_rcut_correction) {
   FUZZY_COMPARE(smearing_factor_rcut_correction(3.0), 0.97070911346511177);
   FUZZY_COMPARE(smearing_factor_rcut_correction(4.0), 0.99886601571021467);
@@ -10,6 +10,7 @@
 #include "vir/test.h"  // This include has to be first
 
 #include "smash/distributions.h"
+#include "smash/random.h"
 
 using namespace smash;
 
@@ -52,3 +53,38 @@ TEST(cauchy) {
   COMPARE_ABSOLUTE_ERROR(breit_wigner_nonrel(m0 - gamma / 2., m0, gamma),
                          peak_value, 1e-6);
 }
+
+TEST(tabulated_thermal_momenta) {
+  random::set_seed(11);
+  // Massless particles, for which the mean momenta are known analytically
+  const double T = 0.2;
+  ThermalMomentumSampler thermal(ThermalMomentumSampler::Distribution::Thermal);
+  ThermalMomentumSampler non_eq(
+      ThermalMomentumSampler::Distribution::NonEquilibriumMass, 1);
+  std::vector<double> momenta(100000);
+  thermal.sample(T, 0.0, momenta);
+  double mean = 0.0;
+  for (double p : momenta) {
+    VERIFY(p >= 0.0);
+    mean += p;
+  }
+  COMPARE_RELATIVE_ERROR(mean / momenta.size(), 3 * T, 0.01);
+  non_eq.sample(T, 0.0, momenta);
+  mean = 0.0;
+  for (double p : momenta) {
+    mean += p;
+  }
+  COMPARE_RELATIVE_ERROR(mean / momenta.size(), 4 * T, 0.01);
+  // Heavy particles, compared to the rejection sampling
+  double mean_tabulated = 0.0, mean_rejection = 0.0;
+  for (std::size_t i = 0; i < momenta.size(); i++) {
+    mean_tabulated += thermal.sample(0.1, 0.938);
+    mean_rejection += sample_momenta_from_thermal(0.1, 0.938);
+  }
+  COMPARE_RELATIVE_ERROR(mean_tabulated, mean_rejection, 0.01);
+  // Alternate between two pairs, which do not fit into the cache together
+  for (int i = 0; i < 10; i++) {
+    VERIFY(non_eq.sample(2 * T, 0.0) <= 80. * T + 1e-12);
+    VERIFY(non_eq.sample(T, 0.0) <= 40. * T + 1e-12);
+  }
+}
@@ -12,6 +12,7 @@
 #include "smash/energymomentumtensor.h"
 
 #include <cstdint>
+#include <vector>
 
 #include "smash/fourvector.h"
 
@@ -171,3 +172,29 @@ TEST(Landau_frame_values) {
   FUZZY_COMPARE(TL[8], 10.787129594442447275);
   FUZZY_COMPARE(TL[9], 39.94209073898776673);
 }
+
+TEST(Landau_frames_of_many_tensors) {
+  // More tensors than are treated together, including an empty one
+  std::vector<EnergyMomentumTensor> tensors(100);
+  for (std::size_t i = 1; i < tensors.size(); i++) {
+    const double x = 0.01 * i;
+    tensors[i].add_particle(FourVector(1.0, 0.1, 0.2, 0.3));
+    tensors[i].add_particle(FourVector(2.0 + x, 0.3, -x, 0.4));
+    tensors[i].add_particle(FourVector(3.0, 1.3, 0.3, 1.7 - x));
+  }
+  const std::vector<FourVector> u =
+      EnergyMomentumTensor::landau_frame_4velocities(tensors.data(),
+                                                     tensors.size());
+  COMPARE(u.size(), tensors.size());
+  COMPARE(u[0], FourVector(1., 0., 0., 0.));
+  for (std::size_t i = 0; i < tensors.size(); i++) {
+    for (int mu = 0; mu < 4; mu++) {
+      COMPARE_ABSOLUTE_ERROR(u[i][mu], tensors[i].landau_frame_4velocity()[mu],
+                             1.e-15);
+    }
+    const EnergyMomentumTensor Tmn_L = tensors[i].boosted(u[i]);
+    for (std::size_t j = 1; j < 4; j++) {
+      COMPARE_ABSOLUTE_ERROR(Tmn_L[j], 0.0, 1.e-14);
+    }
+  }
+}
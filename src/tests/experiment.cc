@@ -10,9 +10,13 @@
 #include "vir/test.h"  // This include has to be first
 
 #include <filesystem>
+#include <memory>
+#include <vector>
 
 #include "setup.h"
+#include "smash/boxmodus.h"
 #include "smash/collidermodus.h"
+#include "smash/memoryoutput.h"
 
 using namespace smash;
 
@@ -223,6 +227,50 @@ TEST(add_and_remove_particles) {
   VERIFY(exp->first_ensemble()->size() == 1);
 }
 
+TEST(reuse_experiment_with_given_particles) {
+  auto config = get_collider_configuration();
+  auto exp = std::make_unique<Experiment<ColliderModus>>(config, ".");
+  ParticleData pion_plus{ParticleType::find(pdg::pi_p)};
+  pion_plus.set_4momentum(pion_plus.pole_mass(), 0.1, 0.0, 0.0);
+  pion_plus.set_4position(FourVector(0.5, 0.0, 0.0, 0.0));
+  ParticleData omega{ParticleType::find(pdg::omega)};
+  omega.set_4momentum(omega.pole_mass(), 0.0, 0.0, 0.0);
+  omega.set_4position(FourVector(0.2, 1.0, 0.0, 0.0));
+  for (int event = 0; event < 2; event++) {
+    exp->initialize_new_event(ParticleList{pion_plus, omega});
+    // The event starts at the earliest given particle
+    VERIFY(exp->first_ensemble()->size() == 2);
+    for (const ParticleData &p : *exp->first_ensemble()) {
+      COMPARE(p.position().x0(), 0.2);
+    }
+    exp->run_time_evolution(1.);
+    exp->final_output();
+    exp->increase_event_number();
+  }
+  exp->initialize_new_event(ParticleList{});
+  VERIFY(exp->first_ensemble()->size() == 0);
+}
+
+TEST(add_and_remove_particle_records) {
+  auto config = get_collider_configuration();
+  auto exp = std::make_unique<Experiment<ColliderModus>>(config, ".");
+  ParticleData pion_plus{ParticleType::find(pdg::pi_p)};
+  pion_plus.set_4momentum(pion_plus.pole_mass(), 0.0, 0.0, 0.0);
+  pion_plus.set_4position(FourVector(0.0, 0.0, 0.0, 0.0));
+  ParticleRecord unknown = MemoryOutput::record(pion_plus);
+  unknown.pdg = 16;  // tau neutrino, not a SMASH particle
+  exp->run_time_evolution(
+      1., std::vector<ParticleRecord>{MemoryOutput::record(pion_plus), unknown},
+      std::vector<ParticleRecord>{});
+  std::vector<ParticleRecord> records;
+  exp->fill_particle_records(records);
+  COMPARE(records.size(), 1u);
+  COMPARE(records[0].pdg, 211);
+  exp->run_time_evolution(1., std::vector<ParticleRecord>{}, records);
+  exp->fill_particle_records(records);
+  VERIFY(records.empty());
+}
+
 TEST_CATCH(remove_particle_twice, std::logic_error) {
   // Set up collider experiment without setting up initial state (no Au-Au)
   auto config = get_collider_configuration();
@@ -237,3 +285,173 @@ TEST_CATCH(remove_particle_twice, std::logic_error) {
   // Try to remove the eta twice
   exp->run_time_evolution(1., ParticleList{}, ParticleList{eta, eta});
 }
+
+TEST(add_memory_output) {
+  auto config = get_collider_configuration();
+  auto exp = std::make_unique<Experiment<ColliderModus>>(config, ".");
+  std::vector<int> pdg_codes;
+  exp->add_output(std::make_unique<MemoryOutput>([&](const ParticleBlock &b) {
+    if (b.stage == ParticleBlock::Stage::EventEnd) {
+      for (const ParticleRecord &r : b.particles) {
+        pdg_codes.push_back(r.pdg);
+      }
+    }
+  }));
+  ParticleData pion_plus{ParticleType::find(pdg::pi_p)};
+  pion_plus.set_4momentum(pion_plus.pole_mass(), 0.0, 0.0, 0.0);
+  exp->run_time_evolution(1., ParticleList{pion_plus}, ParticleList{});
+  exp->final_output();
+  COMPARE(pdg_codes, std::vector<int>{211});
+}
+
+TEST(fork_events) {
+  auto config = get_collider_configuration();
+  config.set_value(InputKeys::gen_endTime, 3.0);
+  config.set_value(InputKeys::gen_nevents, 3);
+  config.set_value(InputKeys::gen_forksPerEvent, 3);
+  config.set_value(InputKeys::gen_forkTime, 1.0);
+  auto exp = std::make_unique<Experiment<ColliderModus>>(config, ".");
+  std::vector<ParticleBlock> starts;
+  exp->add_output(std::make_unique<MemoryOutput>([&](const ParticleBlock &b) {
+    if (b.stage == ParticleBlock::Stage::EventStart) {
+      starts.push_back(b);
+    }
+  }));
+  exp->run();
+  COMPARE(starts.size(), 3u);
+  VERIFY(starts[0].time < 1.0);
+  // The forks continue from the same snapshot of the first event
+  for (int i = 1; i < 3; i++) {
+    COMPARE(starts[i].event_label.event_number, i);
+    VERIFY(starts[i].time >= 1.0);
+    COMPARE(starts[i].time, starts[1].time);
+    COMPARE(starts[i].impact_parameter, starts[0].impact_parameter);
+    COMPARE(starts[i].particles.size(), starts[1].particles.size());
+  }
+}
+
+TEST_CATCH(fork_after_end_time, std::invalid_argument) {
+  auto config = get_collider_configuration();
+  config.set_value(InputKeys::gen_forksPerEvent, 2);
+  config.set_value(InputKeys::gen_forkTime, 30.0);
+  Experiment<ColliderModus> exp(config, ".");
+}
+
+/// A box of three events with few pions
+static Configuration get_small_box_configuration() {
+  auto config = get_common_configuration();
+  config.set_value(InputKeys::gen_modus, "Box");
+  config.set_value(InputKeys::gen_endTime, 5.0);
+  config.set_value(InputKeys::gen_nevents, 3);
+  config.merge_yaml(R"(
+    Modi:
+      Box:
+        Initial_Condition: "thermal momenta"
+        Length: 5.0
+        Temperature: 0.2
+        Start_Time: 0.0
+        Init_Multiplicities: {211: 50, 111: 50, -211: 50}
+  )");
+  return config;
+}
+
+/// Append the final positions of the particles of the block, if any
+static void add_final_positions(const ParticleBlock &b,
+                                std::vector<double> &positions) {
+  if (b.stage == ParticleBlock::Stage::EventEnd) {
+    for (const ParticleRecord &r : b.particles) {
+      positions.insert(positions.end(), {r.x, r.y, r.z});
+    }
+  }
+}
+
+TEST(prepare_next_event) {
+  // Final positions of all events, with and without preparation ahead
+  const auto final_positions = [](bool prepare) {
+    auto config = get_small_box_configuration();
+    config.set_value(InputKeys::gen_prepareNextEvent, prepare);
+    auto exp = std::make_unique<Experiment<BoxModus>>(config, ".");
+    std::vector<double> positions;
+    exp->add_output(std::make_unique<MemoryOutput>(
+        [&](const ParticleBlock &b) { add_final_positions(b, positions); }));
+    exp->run();
+    return positions;
+  };
+  const std::vector<double> serial = final_positions(false);
+  VERIFY(!serial.empty());
+  COMPARE(final_positions(true), serial);
+}
+
+TEST(dynamic_cell_size) {
+  // Final positions of all events, with cells sized from the particles or not
+  const auto final_positions = [](bool dynamic) {
+    auto config = get_small_box_configuration();
+    config.set_value(InputKeys::collTerm_crossSectionCache, true);
+    config.set_value(InputKeys::collTerm_dynamicCellSize, dynamic);
+    auto exp = std::make_unique<Experiment<BoxModus>>(config, ".");
+    std::vector<double> positions;
+    exp->add_output(std::make_unique<MemoryOutput>(
+        [&](const ParticleBlock &b) { add_final_positions(b, positions); }));
+    exp->run();
+    return positions;
+  };
+  const std::vector<double> fixed = final_positions(false);
+  VERIFY(!fixed.empty());
+  COMPARE(final_positions(true), fixed);
+}
+
+TEST_CATCH(dynamic_cell_size_without_cache, std::invalid_argument) {
+  auto config = get_small_box_configuration();
+  config.set_value(InputKeys::collTerm_dynamicCellSize, true);
+  Experiment<BoxModus> exp(config, ".");
+}
+
+TEST(final_decays_with_grid_threads) {
+  // Final positions of all events, including the decays at the end
+  const auto final_positions = [](int n_threads) {
+    auto config = get_small_box_configuration();
+    config.set_value(InputKeys::gen_gridThreads, n_threads);
+    auto exp = std::make_unique<Experiment<BoxModus>>(config, ".");
+    std::vector<double> positions;
+    exp->add_output(std::make_unique<MemoryOutput>(
+        [&](const ParticleBlock &b) { add_final_positions(b, positions); }));
+    exp->run();
+    return positions;
+  };
+  const std::vector<double> two_threads = final_positions(2);
+  VERIFY(!two_threads.empty());
+  COMPARE(final_positions(3), two_threads);
+}
+
+TEST(run_event_ranges) {
+  // Final positions of the last event, after all events or only that one
+  std::vector<double> all, last;
+  {
+    auto config = get_small_box_configuration();
+    Experiment<BoxModus> exp(config, ".");
+    exp.add_output(std::make_unique<MemoryOutput>([&](const ParticleBlock &b) {
+      if (b.event_label.event_number == 2) {
+        add_final_positions(b, all);
+      }
+    }));
+    exp.run();
+  }
+  auto config = get_small_box_configuration();
+  Experiment<BoxModus> exp(config, ".");
+  std::vector<ExperimentBase::EventRange> ranges{{0, 0}, {2, 5}};
+  exp.add_output(std::make_unique<MemoryOutput>(
+      [&](const ParticleBlock &b) { add_final_positions(b, last); }));
+  exp.run_event_ranges([&]() {
+    const auto range = ranges.back();
+    ranges.pop_back();
+    return range;
+  });
+  VERIFY(!all.empty());
+  COMPARE(last, all);
+}
+
+TEST_CATCH(add_null_output, std::invalid_argument) {
+  auto config = get_collider_configuration();
+  auto exp = std::make_unique<Experiment<ColliderModus>>(config, ".");
+  exp->add_output(nullptr);
+}
@@ -11,6 +11,10 @@
 
 #include "smash/filelock.h"
 
+#include <chrono>
+#include <memory>
+#include <thread>
+
 #include "setup.h"
 
 using namespace smash;
@@ -44,3 +48,34 @@ TEST(lock_is_denied) {
   }
   VERIFY(!std::filesystem::exists(lockpath));
 }
+
+TEST(lock_is_waited_for) {
+  const std::filesystem::path lockpath = testoutputpath / "lock";
+  auto lock1 = std::make_unique<FileLock>(lockpath);
+  VERIFY(lock1->acquire());
+  // Release the lock while the second one is waiting for it
+  std::thread releasing([&lock1]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    lock1.reset();
+  });
+  {
+    FileLock lock2(lockpath);
+    VERIFY(lock2.acquire_or_wait());
+    releasing.join();
+    VERIFY(std::filesystem::exists(lockpath));
+  }
+  VERIFY(!std::filesystem::exists(lockpath));
+}
+
+TEST(stale_lock_is_not_waited_for) {
+  const std::filesystem::path lockpath = testoutputpath / "lock";
+  {
+    FileLock lock1(lockpath);
+    FileLock lock2(lockpath);
+    VERIFY(lock1.acquire());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    VERIFY(!lock2.acquire_or_wait(std::chrono::seconds(1)));
+    VERIFY(std::filesystem::exists(lockpath));
+  }
+  VERIFY(!std::filesystem::exists(lockpath));
+}
@@ -0,0 +1,89 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/filteredoutput.h"
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "setup.h"
+#include "smash/freeforallaction.h"
+#include "smash/memoryoutput.h"
+
+using namespace smash;
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+static ParticleData smashon_with_pz(double pz) {
+  return Test::smashon(
+      Test::Momentum{std::sqrt(Test::smashon_mass * Test::smashon_mass +
+                               0.09 + pz * pz),
+                     0.3, 0.0, pz});
+}
+
+TEST(particles_are_selected) {
+  std::vector<int> ids;
+  OutputFilterParameters filter;
+  filter.rapidity_range = {{-0.5, 0.5}};
+  FilteredOutput output(
+      std::make_unique<MemoryOutput>([&](const ParticleBlock &block) {
+        for (const ParticleRecord &r : block.particles) {
+          ids.push_back(r.id);
+        }
+      }),
+      "Particles", filter);
+  Particles particles;
+  particles.insert(smashon_with_pz(0.0));
+  particles.insert(smashon_with_pz(10.0));
+  particles.insert(smashon_with_pz(-0.1));
+  output.at_eventend(particles, {0, 0}, Test::default_event_info());
+  COMPARE(ids, (std::vector<int>{0, 2}));
+}
+
+TEST(selection_of_particles) {
+  OutputFilterParameters filter;
+  filter.pdg_codes = {pdg::p};
+  FilteredOutput by_species(nullptr, "Particles", filter);
+  VERIFY(!by_species.selects(Test::smashon()));
+  filter.pdg_codes = {PdgCode(0x661)};
+  filter.pt_range = {{0.0, 0.2}};
+  FilteredOutput by_pt(nullptr, "Particles", filter);
+  VERIFY(!by_pt.selects(smashon_with_pz(0.0)));
+  VERIFY(by_pt.selects(Test::smashon()));
+}
+
+TEST(selection_of_interactions) {
+  std::size_t n_interactions = 0;
+  OutputFilterParameters filter;
+  filter.rapidity_range = {{-0.5, 0.5}};
+  auto count = [&](const InteractionRecord &) { ++n_interactions; };
+  FilteredOutput output(
+      std::make_unique<MemoryOutput>(MemoryOutput::ParticlesCallback{}, count),
+      "Collisions", filter);
+  const FreeforallAction selected({smashon_with_pz(10.0)},
+                                  {smashon_with_pz(0.0)}, 0.0);
+  const FreeforallAction rejected({smashon_with_pz(10.0)},
+                                  {smashon_with_pz(-10.0)}, 0.0);
+  output.at_interaction(selected, 0.0);
+  output.at_interaction(rejected, 0.0);
+  COMPARE(n_interactions, 1u);
+  filter.process_types = {static_cast<int>(ProcessType::Decay)};
+  FilteredOutput by_type(nullptr, "Collisions", filter);
+  VERIFY(!by_type.selects(selected));
+}
+
+TEST_CATCH(empty_range, std::invalid_argument) {
+  OutputFilterParameters filter;
+  filter.pt_range = {{1.0, 0.5}};
+  FilteredOutput output(nullptr, "Particles", filter);
+}
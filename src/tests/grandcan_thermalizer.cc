@@ -92,6 +92,36 @@ TEST(rest_frame_transformation) {
       node.nq(), eos.net_charge_density(T, mub, mus, muq) * gamma, tolerance);
 }
 
+TEST(separate_solver) {
+  // The table is only allocated when it is compiled
+  EosTable::table_element element;
+  EosTable(0.1, 0.1, 0.1, 10, 10, 10).get(element, 0.5, 0.1, 0.1);
+  COMPARE(element.p, -1.0);
+  COMPARE(element.T, -1.0);
+
+  Particles P;
+  ExperimentParameters par = smash::Test::default_parameters();
+  par.box_length = 10.0;
+  BoxModus b = create_box_for_tests(par);
+  b.initial_conditions(&P, par);
+  ThermLatticeNode node = ThermLatticeNode();
+  const double L = par.box_length;
+  for (auto& part : P) {
+    node.add_particle(part, 1.0 / (L * L * L));
+  }
+  ThermLatticeNode node_with_solver = node;
+  HadronGasEos eos = HadronGasEos(false, false);
+  HadronGasEos solver = HadronGasEos(false, false);
+  node.compute_rest_frame_quantities(eos);
+  node_with_solver.compute_rest_frame_quantities(eos, solver);
+  COMPARE(node_with_solver.T(), node.T());
+  COMPARE(node_with_solver.mub(), node.mub());
+  COMPARE(node_with_solver.mus(), node.mus());
+  COMPARE(node_with_solver.muq(), node.muq());
+  COMPARE(node_with_solver.p(), node.p());
+  COMPARE(node_with_solver.v(), node.v());
+}
+
 // Disabled because runtime exceeds maximum test runtime.
 // It can however be executed if the hadron gas EoS table is pre-compiled. To do
 // so, run SMASH once enabling the grandcanonical thermalizer (instructions can
@@ -11,11 +11,16 @@
 
 #include "smash/grid.h"
 
+#include <algorithm>
+#include <functional>
 #include <set>
+#include <stdexcept>
 #include <unordered_set>
+#include <vector>
 
 #include "setup.h"
 #include "smash/logging.h"
+#include "smash/threadpool.h"
 
 using namespace smash;
 
@@ -158,7 +163,7 @@ TEST(grid_construction) {
       auto idsIt = param.ids.begin();
       auto neighbors = param.neighbors;
       grid.iterate_cells(
-          [&](const ParticleList &search) {
+          [&](ParticleSpan search) {
             auto ids = *idsIt++;
             for (const auto &p : search) {
               COMPARE(ids.erase(p.id()), 1u)
@@ -166,7 +171,7 @@ TEST(grid_construction) {
             }
             COMPARE(ids.size(), 0u);
           },
-          [&](const ParticleList &search, const ParticleList &n) {
+          [&](ParticleSpan search, ParticleSpan n) {
             for (const auto &p : search) {
               for (const auto &p2 : n) {
                 COMPARE(neighbors.erase({std::min(p.id(), p2.id()),
@@ -223,7 +228,7 @@ TEST(periodic_grid) {
       std::vector<std::pair<ParticleData, ParticleData>> neighbor_pairs;
 
       grid.iterate_cells(
-          [&](const ParticleList &search) {
+          [&](ParticleSpan search) {
             for (const ParticleData &p : search) {
               {
                 const auto it = find(list, p);
@@ -244,13 +249,13 @@ TEST(periodic_grid) {
                   const auto it = find(neighbor_pairs, pair);
                   COMPARE(it, neighbor_pairs.end())
                       << "\np: " << p << "\nq: " << q << '\n'
-                      << detailed(search);
+                      << detailed(ParticleList(search.begin(), search.end()));
                   neighbor_pairs.emplace_back(std::move(pair));
                 }
               }
             }
           },
-          [&](const ParticleList &search, const ParticleList &neighbors) {
+          [&](ParticleSpan search, ParticleSpan neighbors) {
             // for each particle in neighbors, find the same particle in list
             for (const ParticleData &p : neighbors) {
               const auto it = find(list, p);
@@ -469,3 +474,265 @@ TEST(max_positions_normal_grid) {
   Grid<GridOptions::Normal> grid2(list, testparticles, 1.0,
                                   CellNumberLimitation::None);
 }
+
+/* Records the callbacks of a grid iteration, such that different iterations
+ * can be compared. Each call adds the ids and the x coordinates of the involved
+ * particles, which are translated for wrapped cells of a periodic grid. */
+static void record(ParticleSpan particles, std::vector<double> &calls) {
+  calls.push_back(-1.);
+  for (const ParticleData &p : particles) {
+    calls.push_back(p.id());
+    calls.push_back(p.position().x1());
+  }
+}
+
+template <GridOptions Options>
+static void compare_rows_with_cells(const Grid<Options> &grid) {
+  std::vector<double> serial;
+  grid.iterate_cells(
+      [&](ParticleSpan search) { record(search, serial); },
+      [&](ParticleSpan search, ParticleSpan neighbors) {
+        record(search, serial);
+        record(neighbors, serial);
+      });
+  std::vector<std::vector<double>> rows(grid.number_of_rows());
+  ThreadPool pool(3);
+  pool.parallel_for(rows.size(), [&](std::size_t row) {
+    grid.iterate_cells_in_row(
+        row, [&](ParticleSpan search) { record(search, rows[row]); },
+        [&](ParticleSpan search, ParticleSpan neighbors) {
+          record(search, rows[row]);
+          record(neighbors, rows[row]);
+        });
+  });
+  std::vector<double> concurrent;
+  for (const std::vector<double> &calls : rows) {
+    concurrent.insert(concurrent.end(), calls.begin(), calls.end());
+  }
+  COMPARE(concurrent, serial);
+}
+
+TEST(rows_reproduce_iteration_over_cells) {
+  using Test::Position;
+  constexpr double length = 10;
+  auto random_value = random::make_uniform_distribution(0., 9.99);
+  Particles list;
+  // Fix the extent of the particles for the normal grid
+  list.insert(Test::smashon(Position{0., 0., 0., 0.}));
+  list.insert(Test::smashon(Position{0., 9.99, 9.99, 9.99}));
+  for (int n = 200; n; --n) {
+    list.insert(Test::smashon(
+        Position{0., random_value(), random_value(), random_value()}));
+  }
+  // Cells of at least 1.9 fm yield 5x5x5 cells for both kinds of grids
+  const Grid<GridOptions::Normal> grid(list, 1.9, timestep,
+                                       CellNumberLimitation::None);
+  COMPARE(grid.number_of_rows(), 25u);
+  compare_rows_with_cells(grid);
+  const Grid<GridOptions::PeriodicBoundaries> periodic_grid(
+      make_pair(std::array<double, 3>{0, 0, 0},
+                std::array<double, 3>{length, length, length}),
+      list, 1.9, timestep, CellNumberLimitation::None);
+  COMPARE(periodic_grid.number_of_rows(), 25u);
+  compare_rows_with_cells(periodic_grid);
+}
+
+template <GridOptions Options>
+static std::vector<double> iteration_over_cells(const Grid<Options> &grid) {
+  std::vector<double> calls;
+  grid.iterate_cells(
+      [&](ParticleSpan search) { record(search, calls); },
+      [&](ParticleSpan search, ParticleSpan neighbors) {
+        record(search, calls);
+        record(neighbors, calls);
+      });
+  return calls;
+}
+
+template <GridOptions Options>
+static void compare_tiles_with_cells(const Grid<Options> &grid,
+                                     std::size_t max_particles) {
+  std::vector<double> tiled;
+  grid.iterate_tiles(max_particles, [&](const CellTile &tile) {
+    for (const CellTile::Visit &visit : tile.visits) {
+      // The search cells are part of the tile, unlike translated copies
+      VERIFY(visit.neighbors || visit.search.empty() ||
+             (&visit.search[0] >= &tile.particles[0] &&
+              &visit.search[visit.search.size() - 1] <=
+                  &tile.particles[tile.particles.size() - 1]));
+      record(visit.search, tiled);
+      if (visit.neighbors) {
+        record(*visit.neighbors, tiled);
+      }
+    }
+  });
+  COMPARE(tiled, iteration_over_cells(grid)) << "max_particles = "
+                                             << max_particles;
+}
+
+TEST(tiles_reproduce_iteration_over_cells) {
+  using Test::Position;
+  constexpr double length = 10;
+  auto random_value = random::make_uniform_distribution(0., 9.99);
+  Particles list;
+  // Fix the extent of the particles for the normal grid
+  list.insert(Test::smashon(Position{0., 0., 0., 0.}));
+  list.insert(Test::smashon(Position{0., 9.99, 9.99, 9.99}));
+  for (int n = 200; n; --n) {
+    list.insert(Test::smashon(
+        Position{0., random_value(), random_value(), random_value()}));
+  }
+  const Grid<GridOptions::Normal> grid(list, 1.9, timestep,
+                                       CellNumberLimitation::None);
+  const Grid<GridOptions::PeriodicBoundaries> periodic_grid(
+      make_pair(std::array<double, 3>{0, 0, 0},
+                std::array<double, 3>{length, length, length}),
+      list, 1.9, timestep, CellNumberLimitation::None);
+  // From one row per tile to all rows in one tile
+  for (const std::size_t max_particles : {1u, 40u, 100u, 1000u}) {
+    compare_tiles_with_cells(grid, max_particles);
+    compare_tiles_with_cells(periodic_grid, max_particles);
+  }
+}
+
+TEST(rebuilt_grid_equals_new_grid) {
+  using Test::Position;
+  constexpr double length = 10;
+  auto random_value = random::make_uniform_distribution(0., 9.99);
+  Particles first, second;
+  for (int n = 300; n; --n) {
+    first.insert(Test::smashon(
+        Position{0., random_value(), random_value(), random_value()}));
+  }
+  for (int n = 50; n; --n) {
+    second.insert(Test::smashon(
+        Position{0., random_value(), random_value(), 0.5 * random_value()}));
+  }
+  Grid<GridOptions::Normal> grid(first, 1.9, timestep,
+                                 CellNumberLimitation::None);
+  grid.rebuild(second, 1.9, timestep, CellNumberLimitation::None);
+  const Grid<GridOptions::Normal> new_grid(second, 1.9, timestep,
+                                           CellNumberLimitation::None);
+  COMPARE(grid.cell_volume(), new_grid.cell_volume());
+  COMPARE(grid.number_of_rows(), new_grid.number_of_rows());
+  COMPARE(iteration_over_cells(grid), iteration_over_cells(new_grid));
+  // A grid with a single cell can be rebuilt as well
+  grid.rebuild(first, 1.9, timestep, CellNumberLimitation::None, false,
+               CellSizeStrategy::Largest);
+  COMPARE(grid.number_of_rows(), 1u);
+  COMPARE(iteration_over_cells(grid).size(), 2 * first.size() + 1);
+
+  const auto min_and_length = make_pair(
+      std::array<double, 3>{0, 0, 0},
+      std::array<double, 3>{length, length, length});
+  Grid<GridOptions::PeriodicBoundaries> periodic_grid(
+      min_and_length, first, 1.9, timestep, CellNumberLimitation::None);
+  periodic_grid.rebuild(min_and_length, second, 1.9, timestep,
+                        CellNumberLimitation::None);
+  const Grid<GridOptions::PeriodicBoundaries> new_periodic_grid(
+      min_and_length, second, 1.9, timestep, CellNumberLimitation::None);
+  COMPARE(periodic_grid.cell_volume(), new_periodic_grid.cell_volume());
+  COMPARE(iteration_over_cells(periodic_grid),
+          iteration_over_cells(new_periodic_grid));
+}
+
+TEST_CATCH(neighbor_index_without_cell_length, std::invalid_argument) {
+  NeighborIndex index;
+  index.build(Particles(), 0.);
+}
+
+TEST(neighbor_index_finds_close_particles) {
+  using Test::Position;
+  constexpr double cell_length = 1.5;
+  auto random_value = random::make_uniform_distribution(0., 9.99);
+  Particles list;
+  const ParticleData center =
+      list.insert(Test::smashon(Position{0., 5., 5., 5.}));
+  for (int n = 300; n; --n) {
+    list.insert(Test::smashon(
+        Position{0., random_value(), random_value(), random_value()}));
+  }
+  const ParticleData far_away =
+      list.insert(Test::smashon(Position{0., 9.9, 9.9, 9.9}));
+  NeighborIndex index;
+  VERIFY(!index.is_built());
+  VERIFY(index.neighbors(list, {center}).empty());
+  index.build(list, cell_length);
+  VERIFY(index.is_built());
+
+  // A removed particle must not be found anymore
+  const ParticleData *close = nullptr;
+  for (const ParticleData &p : list) {
+    if (p.id() != center.id() &&
+        (p.position() - center.position()).threevec().abs() < 1.) {
+      close = &p;
+      break;
+    }
+  }
+  VERIFY(close != nullptr);
+  const ParticleData removed = *close;
+  list.remove(removed);
+  // A particle moved close to the center is found once it is added again
+  ParticleList moved = {far_away}, moved_state = {far_away};
+  moved_state[0].set_4position(FourVector(0., 5.5, 5., 5.));
+  list.update(moved, moved_state, false);
+  index.add(moved_state);
+
+  const std::vector<const ParticleData *> neighbors =
+      index.neighbors(list, {center});
+  VERIFY(std::is_sorted(neighbors.begin(), neighbors.end(),
+                        std::less<const ParticleData *>()));
+  std::unordered_set<int> found_ids;
+  for (const ParticleData *p : neighbors) {
+    VERIFY(list.is_valid(*p));
+    VERIFY(found_ids.insert(p->id()).second) << "particle found twice";
+  }
+  VERIFY(found_ids.count(center.id()) == 1);
+  VERIFY(found_ids.count(far_away.id()) == 1);
+  VERIFY(found_ids.count(removed.id()) == 0);
+  for (const ParticleData &p : list) {
+    if ((p.position() - center.position()).threevec().abs() < cell_length) {
+      VERIFY(found_ids.count(p.id()) == 1) << p;
+    }
+  }
+
+  index.clear();
+  VERIFY(!index.is_built());
+  index.add({center});
+  VERIFY(index.neighbors(list, {center}).empty());
+}
+
+TEST(periodic_neighbor_index_wraps_around) {
+  using Test::Position;
+  constexpr double period = 10.;
+  Particles list;
+  const ParticleData near_lower_wall =
+      list.insert(Test::smashon(Position{0., 0.1, 5., 5.}));
+  const ParticleData near_upper_wall =
+      list.insert(Test::smashon(Position{0., 9.9, 5., 5.}));
+  const ParticleData beyond_upper_wall =
+      list.insert(Test::smashon(Position{0., 10.2, 5., 9.95}));
+  const ParticleData middle =
+      list.insert(Test::smashon(Position{0., 5., 5., 5.}));
+  auto found_ids = [&](const NeighborIndex &index) {
+    std::unordered_set<int> ids;
+    for (const ParticleData *p : index.neighbors(list, {near_lower_wall})) {
+      VERIFY(ids.insert(p->id()).second) << "particle found twice";
+    }
+    return ids;
+  };
+
+  NeighborIndex index;
+  index.build(list, 1.5);
+  VERIFY(found_ids(index).count(near_upper_wall.id()) == 0);
+  // The cells are enlarged to a length of 10/6, which divides the period
+  index.build(list, 1.5, period);
+  const std::unordered_set<int> ids = found_ids(index);
+  VERIFY(ids.count(near_lower_wall.id()) == 1);
+  VERIFY(ids.count(near_upper_wall.id()) == 1);
+  VERIFY(ids.count(beyond_upper_wall.id()) == 0);
+  VERIFY(ids.count(middle.id()) == 0);
+  // With two cells along every axis, all cells are neighbors of each other
+  index.build(list, 4., period);
+  COMPARE(found_ids(index).size(), 4u);
+}
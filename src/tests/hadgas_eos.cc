@@ -11,8 +11,14 @@
 
 #include "smash/hadgas_eos.h"
 
+#include <array>
+#include <filesystem>
+#include <iterator>
+
 #include "setup.h"
 #include "smash/constants.h"
+#include "smash/sha256.h"
+#include "smash/threadpool.h"
 
 using namespace smash;
 
@@ -88,6 +94,32 @@ TEST(solve_EoS_substitute) {
   COMPARE_ABSOLUTE_ERROR(sol[3], muq, 1.e-4);
 }
 
+TEST(solve_EoS_warm_start) {
+  const double mub = 0.2;
+  const double muq = 0.1;
+  const double mus = 0.0;
+  const double T = 0.30;
+  const double e = HadronGasEos::energy_density(T, mub, mus, muq);
+  const double nb = HadronGasEos::net_baryon_density(T, mub, mus, muq);
+  const double ns = HadronGasEos::net_strange_density(T, mub, mus, muq);
+  const double nq = HadronGasEos::net_charge_density(T, mub, mus, muq);
+  HadronGasEos eos = HadronGasEos(false, false);
+  // Without a previous solution, the usual initial approximation is used
+  const std::array<double, 4> cold_start = eos.solve_eos(e, nb, ns, nq);
+  const std::array<double, 4> no_previous =
+      eos.solve_eos_warm_start(e, nb, ns, nq, {0.0, 0.0, 0.0, 0.0});
+  for (int i = 0; i < 4; i++) {
+    COMPARE(no_previous[i], cold_start[i]);
+  }
+  // Starting from the solution of a slightly different state
+  const std::array<double, 4> warm_start =
+      eos.solve_eos_warm_start(e, nb, ns, nq, {0.31, 0.21, 0.01, 0.09});
+  COMPARE_ABSOLUTE_ERROR(warm_start[0], T, 1.e-4);
+  COMPARE_ABSOLUTE_ERROR(warm_start[1], mub, 1.e-4);
+  COMPARE_ABSOLUTE_ERROR(warm_start[2], mus, 1.e-4);
+  COMPARE_ABSOLUTE_ERROR(warm_start[3], muq, 1.e-4);
+}
+
 TEST(EoS_table) {
   // make a small table of EoS
   HadronGasEos eos = HadronGasEos(false, false);
@@ -103,9 +135,57 @@ TEST(EoS_table) {
       HadronGasEos::net_baryon_density(x.T, x.mub, x.mus, x.muq), my_nb, 1.e-2);
   COMPARE_ABSOLUTE_ERROR(
       HadronGasEos::net_charge_density(x.T, x.mub, x.mus, x.muq), my_nq, 1.e-2);
+  // A batch of points gives the same values as single points, also outside
+  const std::array<double, 3> e = {my_e, 0.25, 10.0};
+  const std::array<double, 3> nb = {my_nb, 0.01, 0.0};
+  const std::array<double, 3> nq = {my_nq, 0.02, 0.0};
+  std::array<EosTable::table_element, 3> batch;
+  table.get(e.size(), e.data(), nb.data(), nq.data(), batch.data());
+  for (size_t i = 0; i < e.size(); i++) {
+    table.get(x, e[i], nb[i], nq[i]);
+    COMPARE(batch[i].p, x.p);
+    COMPARE(batch[i].T, x.T);
+    COMPARE(batch[i].mub, x.mub);
+    COMPARE(batch[i].mus, x.mus);
+    COMPARE(batch[i].muq, x.muq);
+  }
+  COMPARE(batch[2].p, -1.0);
   remove("small_test_table_eos.dat");
 }
 
+TEST(EoS_table_parallel_and_cached) {
+  HadronGasEos eos = HadronGasEos(false, false);
+  EosTable serial_table = EosTable(0.1, 0.05, 0.05, 5, 5, 5);
+  serial_table.compile_table(eos, "serial_test_table_eos.dat");
+  // Rows computed on different threads give the same table
+  ThreadPool pool(3);
+  EosTable parallel_table = EosTable(0.1, 0.05, 0.05, 5, 5, 5);
+  parallel_table.compile_table(eos, "parallel_test_table_eos.dat", &pool);
+  for (double e = 0.05; e < 0.4; e += 0.07) {
+    EosTable::table_element x, y;
+    serial_table.get(x, e, 0.03, 0.02);
+    parallel_table.get(y, e, 0.03, 0.02);
+    COMPARE(y.p, x.p);
+    COMPARE(y.T, x.T);
+    COMPARE(y.mub, x.mub);
+    COMPARE(y.mus, x.mus);
+    COMPARE(y.muq, x.muq);
+  }
+  remove("serial_test_table_eos.dat");
+  remove("parallel_test_table_eos.dat");
+
+  // Without a file name, the table is stored in the tabulations directory
+  const std::filesystem::path dir = "test_eos_tabulations";
+  EosTable::set_cache(sha256::calculate(nullptr, 0), dir);
+  EosTable cached_table = EosTable(0.1, 0.05, 0.05, 5, 5, 5);
+  cached_table.compile_table(eos);
+  COMPARE(std::distance(std::filesystem::directory_iterator(dir),
+                        std::filesystem::directory_iterator()),
+          1);
+  EosTable::set_cache(sha256::Hash(), "");
+  std::filesystem::remove_all(dir);
+}
+
 /*
 TEST(make_test_table) {
   // To switch on these tests, comment out the previous ones.
@@ -55,3 +55,21 @@ TEST(sample_mass_thermal) {
       },
       "mass_sampling.dat");
 }
+
+TEST(sample_mass_thermal_tabulated) {
+  const ParticleType& rhop = ParticleType::find(0x213);
+  const double T = 0.15;
+  ThermalMassSampler sampler(1.0 / T);
+  COMPARE(sampler.sample(ParticleType::find(0x211)), 0.138);
+
+  const double dm = 0.01;
+  Histogram1d hist(dm);
+  constexpr int N_TEST = 1E5;  // number of samples
+  hist.populate(N_TEST, [&]() { return sampler.sample(rhop); });
+  hist.test(
+      [&](double m) {
+        return rhop.spectral_function(m) * m * m * gsl_sf_bessel_Kn(2, m / T) *
+               HadronGasEos::partial_density(rhop, T, 0.0, 0.0, 0.0);
+      },
+      "mass_sampling_tabulated.dat");
+}
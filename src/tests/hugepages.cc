@@ -0,0 +1,87 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/hugepages.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "setup.h"
+#include "smash/lattice.h"
+#include "smash/particles.h"
+
+using namespace smash;
+
+TEST(small_arrays_are_not_mapped) {
+  HugePages::set_enabled(true);
+  void *block = HugePages::allocate(1000);
+  std::memset(block, 1, 1000);
+  COMPARE(HugePages::mapped_bytes(), 0u);
+  HugePages::deallocate(block);
+  HugePages::set_enabled(false);
+}
+
+TEST(large_arrays_are_mapped_if_enabled) {
+  const std::size_t size = 3 * HugePages::page_size / 2;
+  void *unmapped = HugePages::allocate(size);
+  COMPARE(HugePages::mapped_bytes(), 0u);
+  HugePages::set_enabled(true);
+  void *block = HugePages::allocate(size);
+#ifdef __linux__
+  // Rounded up to whole huge pages
+  COMPARE(HugePages::mapped_bytes(), 2 * HugePages::page_size);
+  COMPARE(reinterpret_cast<std::uintptr_t>(block) % HugePages::page_size, 0u);
+#endif
+  std::memset(block, 1, size);
+  HugePages::deallocate(block);
+  HugePages::deallocate(unmapped);
+  COMPARE(HugePages::mapped_bytes(), 0u);
+  HugePages::set_enabled(false);
+}
+
+TEST(particles_in_huge_pages) {
+  Test::create_smashon_particletypes();
+  HugePages::set_enabled(true);
+  Particles particles;
+  // Enough particles for the storage to grow beyond a huge page
+  const int n = 2 * HugePages::page_size / sizeof(ParticleData);
+  for (int i = 0; i < n; i++) {
+    particles.insert(Test::smashon_random());
+  }
+  COMPARE(particles.size(), static_cast<std::size_t>(n));
+#ifdef __linux__
+  VERIFY(HugePages::mapped_bytes() > 0);
+#endif
+  int expected_id = 0;
+  for (const ParticleData &p : particles) {
+    COMPARE(p.id(), expected_id++);
+  }
+  HugePages::set_enabled(false);
+}
+
+TEST(lattice_in_huge_pages) {
+  HugePages::set_enabled(true);
+  {
+    RectangularLattice<FourVector> lattice({10., 10., 10.}, {80, 80, 80},
+                                           {0., 0., 0.}, false,
+                                           LatticeUpdate::EveryTimestep);
+#ifdef __linux__
+    VERIFY(HugePages::mapped_bytes() >= lattice.size() * sizeof(FourVector));
+#endif
+    lattice[lattice.size() - 1] = FourVector(1., 2., 3., 4.);
+    RectangularLattice<FourVector> copy(lattice);
+    COMPARE(copy[copy.size() - 1], FourVector(1., 2., 3., 4.));
+    COMPARE(copy[0], FourVector());
+  }
+  COMPARE(HugePages::mapped_bytes(), 0u);
+  HugePages::set_enabled(false);
+}
@@ -88,3 +88,31 @@ TEST(hypersurface_crossing_action) {
     COMPARE(action->outgoing_particles().size(), 0u);
   }
 }
+
+TEST(particles_outside_proper_time_band) {
+  // Already beyond the hypersurface
+  ParticleData a{ParticleType::find(0x2212)};
+  a.set_4position(Position{2.0, 0., 0., 0.5});
+  a.set_4momentum(Momentum{1.386, 0., 0., -0.9});
+
+  // Cannot reach the hypersurface within the time step
+  ParticleData b{ParticleType::find(0x2212)};
+  b.set_4position(Position{0.1, 0., 0., 0.});
+  b.set_4momentum(Momentum{1.386, 0., 0., 0.9});
+
+  // Outside of the light cone and still too far away in z
+  ParticleData c{ParticleType::find(0x2212)};
+  c.set_4position(Position{0.5, 0., 0., 0.8});
+  c.set_4momentum(Momentum{1.386, 0., 0., -0.9});
+
+  // Crosses the hypersurface
+  ParticleData d{ParticleType::find(0x2212)};
+  d.set_4position(Position{0.5, 0., 0., 0.35});
+  d.set_4momentum(Momentum{1.386, 0., 0., -0.9});
+
+  const ParticleList part_list = {a, b, c, d};
+  HyperSurfaceCrossActionsFinder finder(0.5, 0.0, 0.0);
+  ActionList actions = finder.find_actions_in_cell(part_list, 0.1, 0.0, {});
+  COMPARE(actions.size(), 1u);
+  COMPARE(actions[0]->incoming_particles()[0].position(), d.position());
+}
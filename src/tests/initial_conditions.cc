@@ -60,6 +60,36 @@ TEST(initialize_box) {
   COMPARE_ABSOLUTE_ERROR(momentum.x3(), 0.0, 1e-12);
 }
 
+TEST(initialize_box_sampling_threads) {
+  ExperimentParameters par = Test::default_parameters();
+  par.box_length = 5.0;
+  // The particles do not depend on the number of threads
+  std::vector<ParticleList> sampled;
+  for (const int n_threads : {1, 4}) {
+    Configuration config{R"(
+      Modi:
+        Box:
+          Initial_Condition: "thermal momenta"
+          Length: 5.0
+          Temperature: 0.3
+          Start_Time: 0.0
+          Init_Multiplicities:
+            661: 300
+    )"};
+    config.set_value(InputKeys::modi_box_samplingThreads, n_threads);
+    BoxModus b(std::move(config), par);
+    random::set_seed(5);
+    Particles P;
+    COMPARE(b.initial_conditions(&P, par), 0.);
+    COMPARE(P.size(), 300u);
+    sampled.push_back(P.copy_to_vector());
+  }
+  for (std::size_t i = 0; i < sampled[0].size(); i++) {
+    COMPARE(sampled[0][i].momentum(), sampled[1][i].momentum());
+    COMPARE(sampled[0][i].position(), sampled[1][i].position());
+  }
+}
+
 TEST(initialize_collider_normal) {
   Configuration config{R"(
     Modi:
@@ -92,6 +122,37 @@ TEST(initialize_collider_normal) {
   // all other things can only be tested with statistics.
 }
 
+TEST(initialize_collider_pregenerated) {
+  Configuration config{R"(
+    Modi:
+      Collider:
+        Sqrtsnn: 1.6
+        Projectile:
+          Particles: {661: 1}
+        Target:
+          Particles: {661: 8}
+        Initial_Distance: 0
+        Impact:
+          Value: 0
+        Pregenerated_Configurations: 3
+  )"};
+  ColliderModus n(std::move(config), Test::default_parameters());
+  // More events than configurations in a batch
+  for (int event = 0; event < 7; event++) {
+    Particles P;
+    COMPARE(n.initial_conditions(&P, Test::default_parameters()), 0.);
+    COMPARE(P.size(), 9u);
+    for (auto p : P) {
+      COMPARE_RELATIVE_ERROR(p.velocity().sqr(), 0.75, 1e-6);
+      COMPARE_RELATIVE_ERROR(p.momentum().sqr(), 0.16, 1e-6);
+      COMPARE(p.position().x0(), 0.0);
+      COMPARE_RELATIVE_ERROR(p.momentum().x0(), 0.8, 1e-6);
+      COMPARE_RELATIVE_ERROR(std::abs(p.momentum().x3()), std::sqrt(0.48),
+                             1e-6);
+    }
+  }
+}
+
 TEST_CATCH(initialize_collider_low_energy, ModusDefault::InvalidEnergy) {
   Configuration config{R"(
     Modi:
@@ -11,6 +11,7 @@
 
 #include "smash/interpolation.h"
 
+#include <algorithm>
 #include <vector>
 
 using namespace smash;
@@ -70,6 +71,29 @@ TEST(find_index) {
   COMPARE(find_index(data, 10.0), 5ul);
 }
 
+TEST(interpolate_data_linear_buckets) {
+  // Unevenly spaced samples, some of them much closer than the others
+  const std::vector<double> x = {0.0, 0.3, 0.30001, 0.5, 1.7, 1.70002, 2.0};
+  const std::vector<double> y = {1.0, 2.0, 0.5, 3.0, -1.0, 4.0, 2.0};
+  InterpolateDataLinear<double> f(x, y);
+  std::vector<InterpolateLinear<double>> segments;
+  for (size_t i = 0; i + 1 < x.size(); i++) {
+    segments.emplace_back(x[i], y[i], x[i + 1], y[i + 1]);
+  }
+  std::vector<double> points = {-1.0, 3.0};
+  for (double p = -0.1; p < 2.1; p += 0.001) {
+    points.push_back(p);
+  }
+  points.insert(points.end(), x.begin(), x.end());
+  const std::vector<double> values = f(points);
+  for (size_t k = 0; k < points.size(); k++) {
+    // The same linear interpolation as found by the binary search is used.
+    const size_t i = std::min(find_index(x, points[k]), segments.size() - 1);
+    COMPARE(f(points[k]), segments[i](points[k])) << points[k];
+    COMPARE(values[k], f(points[k]));
+  }
+}
+
 TEST(interpolate_data_spline) {
   std::vector<double> x = {1, 2, 3, 4, 5, 6, 7, 8, 9};
   std::vector<double> y = x;
@@ -11,6 +11,7 @@
 
 #include "smash/interpolation2D.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "setup.h"
@@ -86,3 +87,44 @@ TEST(extrapolate_constant) {
   FUZZY_COMPARE((*interp)(2, 0.8), (*interp)(2, 1));
   FUZZY_COMPARE((*interp)(5, 16), (*interp)(5, 12));
 }
+
+TEST(grid_axis_interval) {
+  // piecewise uniform like the bremsstrahlung grid in sqrt(s)
+  const std::vector<double> x = {0.3, 0.31, 0.32, 0.33, 0.37, 0.4, 0.43, 0.46};
+  const GridAxis axis(x);
+  // the interval found by a binary search
+  const auto search = [&x](double xi) -> std::size_t {
+    const auto above = std::upper_bound(x.begin(), x.end(), xi);
+    return std::min<std::size_t>(above - x.begin() - 1, x.size() - 2);
+  };
+  for (double xi = 0.3; xi <= 0.46; xi += 0.0007) {
+    COMPARE(axis.interval(xi), search(xi)) << xi;
+  }
+  for (std::size_t i = 0; i + 1 < x.size(); i++) {
+    COMPARE(axis.interval(x[i]), i);
+  }
+  COMPARE(axis.interval(x.back()), x.size() - 2);
+}
+
+TEST_CATCH(grid_axis_not_increasing, std::runtime_error) {
+  const GridAxis axis({1., 2., 2., 3.});
+}
+
+TEST(interpolate_grid_lookup) {
+  std::vector<double> x = {1, 2, 3, 4, 5};
+  std::vector<double> y = {1, 4, 8, 12};
+  std::vector<double> z = {1, 3, 0, 5, 0, 7, 3, 8, 9, 1,
+                           2, 5, 4, 5, 6, 1, 4, 7, 9, 2};
+  const InterpolateData2DSpline gsl(x, y, z);
+  const InterpolateData2DSpline grid(x, y, z, true);
+
+  // The same spline up to rounding, also for the constant extrapolation
+  for (double xi = 0.5; xi < 5.5; xi += 0.13) {
+    for (double yi = 0.5; yi < 13.; yi += 0.29) {
+      COMPARE_ABSOLUTE_ERROR(grid(xi, yi), gsl(xi, yi), 1e-12)
+          << xi << ", " << yi;
+    }
+  }
+  FUZZY_COMPARE(grid(2, 4), 3.0);
+  FUZZY_COMPARE(grid(5, 12), 2.0);
+}
@@ -12,6 +12,8 @@
 #include "setup.h"
 #include "smash/action.h"
 #include "smash/crosssections.h"
+#include "smash/integrate.h"
+#include "smash/isoparticletype.h"
 #include "smash/scatteraction.h"
 
 using namespace smash;
@@ -33,7 +35,28 @@ TEST(init_particle_types) {
   ParticleType::check_consistency();
   sha256::Hash hash;
   hash.fill(0);
-  IsoParticleType::tabulate_integrals(hash, "");
+  // The integrals are tabulated concurrently, as with Tabulation_Threads > 1.
+  ThreadPool thread_pool(2);
+  IsoParticleType::tabulate_integrals(hash, "", &thread_pool);
+}
+
+TEST(parallel_tabulation) {
+  // Every integral is tabulated as by a serial tabulation.
+  const IsoParticleType &delta = IsoParticleType::find("Δ");
+  const IsoParticleType &nucleon = IsoParticleType::find("N");
+  const IsoParticleType &pion = IsoParticleType::find("π");
+  Integrator integrate;
+  const Tabulation NR = spectral_integral_semistable(
+      integrate, *delta.get_states()[0], *nucleon.get_states()[0], 2.0);
+  const Tabulation piR = spectral_integral_semistable(
+      integrate, *delta.get_states()[0], *pion.get_states()[0], 2.0);
+  IsoParticleType &delta_multiplet = *delta.get_states()[0]->iso_multiplet();
+  for (const double sqrts : {2.2, 2.5, 3.1}) {
+    COMPARE(delta_multiplet.get_integral_NR(sqrts),
+            NR.get_value_linear(sqrts));
+    COMPARE(delta_multiplet.get_integral_piR(sqrts),
+            piR.get_value_linear(sqrts));
+  }
 }
 
 static ScatterAction *set_up_action(const ParticleData &proj,
@@ -11,6 +11,8 @@
 
 #include "smash/lattice.h"
 
+#include <vector>
+
 #include "smash/fourvector.h"
 
 using namespace smash;
@@ -50,6 +52,27 @@ TEST(reset) {
   }
 }
 
+TEST(reset_and_resize) {
+  auto lattice = create_lattice(false);
+  for (auto &node : *lattice) {
+    node = FourVector(1.0, 0.0, 0.0, 0.0);
+  }
+  lattice->reset_and_resize(std::array<double, 3>{5., 3., 4.},
+                            std::array<double, 3>{-1., 2., 0.},
+                            std::array<int, 3>{2, 4, 6});
+  COMPARE(lattice->size(), 48u);
+  COMPARE(lattice->cell_sizes()[0], 2.5);
+  COMPARE(lattice->cell_sizes()[1], 0.75);
+  COMPARE(lattice->cell_sizes()[2], 2. / 3.);
+  COMPARE(lattice->origin()[0], -1.);
+  COMPARE(lattice->n_tiles(), 1u);
+  for (const auto &node : *lattice) {
+    COMPARE(node, FourVector());
+  }
+  // The last node is at the far corner of the resized lattice
+  COMPARE(lattice->cell_center(47), ThreeVector(2.75, 4.625, 11. / 3.));
+}
+
 TEST(out_of_bounds) {
   auto lattice1 = create_lattice(true);
   // For periodic lattice nothing is out of bounds
@@ -71,6 +94,17 @@ TEST(out_of_bounds) {
   VERIFY(lattice2->out_of_bounds(999, 666, 999999));
 }
 
+TEST(node_at) {
+  auto lattice = create_lattice(false);
+  const ThreeVector r = lattice->cell_center(1, 3, 2);
+  VERIFY(lattice->node_at(r) == &lattice->node(1, 3, 2));
+  VERIFY(lattice->node_at(r + ThreeVector(0.1, 0., 0.)) ==
+         &lattice->node(1, 3, 2));
+  VERIFY(lattice->node_at(lattice->cell_center(0, 3, 2)) !=
+         lattice->node_at(r));
+  VERIFY(lattice->node_at(ThreeVector(-1., 0., 0.)) == nullptr);
+}
+
 TEST(cell_center) {
   auto lattice = create_lattice(true);
   COMPARE(lattice->cell_center(0, 0, 0).x1(), 1.25);
@@ -805,6 +839,90 @@ TEST(iterate_in_cube) {
       });
 }
 
+TEST(occupied_tiles) {
+  const std::array<double, 3> l = {20., 20., 10.};
+  const std::array<int, 3> n = {20, 20, 10};
+  const std::array<double, 3> origin = {0., 0., 0.};
+  RectangularLattice<double> lattice(l, n, origin, false,
+                                     LatticeUpdate::EveryTimestep);
+  // 3 x 3 x 2 tiles, the last ones along each direction are incomplete
+  COMPARE(lattice.n_tiles(), 18u);
+  for (std::size_t tile = 0; tile < lattice.n_tiles(); tile++) {
+    VERIFY(!lattice.tile_occupied(tile));
+  }
+  // The cube covers the cells 4 to 8 in x and y and 0 to 2 in z
+  lattice.iterate_in_cube(ThreeVector(7., 7., 1.), 2.5,
+                          [](double &node, int, int, int) { node = 1.0; });
+  std::vector<bool> expected(lattice.n_tiles(), false);
+  expected[0] = expected[1] = expected[3] = expected[4] = true;
+  double sum_of_occupied = 0.;
+  std::size_t nodes_in_tiles = 0;
+  for (std::size_t tile = 0; tile < lattice.n_tiles(); tile++) {
+    COMPARE(lattice.tile_occupied(tile), expected[tile]) << "tile " << tile;
+    lattice.iterate_tile(tile, [&](double &node, std::size_t index) {
+      COMPARE(&node, &lattice[index]);
+      nodes_in_tiles++;
+      if (expected[tile]) {
+        sum_of_occupied += node;
+      }
+    });
+  }
+  // Every node belongs to exactly one tile and all marked nodes are occupied
+  COMPARE(nodes_in_tiles, lattice.size());
+  COMPARE(sum_of_occupied, 5. * 5. * 3.);
+  RectangularLattice<double> copy(lattice);
+  VERIFY(copy.tile_occupied(4));
+  lattice.reset();
+  VERIFY(!lattice.tile_occupied(4));
+
+  // Periodic lattices mark whole directions if the range wraps around them
+  RectangularLattice<double> periodic(l, n, origin, true,
+                                      LatticeUpdate::EveryTimestep);
+  periodic.iterate_nearest_neighbors(ThreeVector(0.5, 10.5, 0.5),
+                                     [](double &, int, int) {});
+  for (std::size_t tile = 0; tile < periodic.n_tiles(); tile++) {
+    // tiles with ty = 1 and any tx, tz
+    COMPARE(periodic.tile_occupied(tile), (tile / 3) % 3 == 1)
+        << "tile " << tile;
+  }
+}
+
+TEST(iterate_in_layers) {
+  const std::array<double, 3> l = {20., 20., 20.};
+  const std::array<int, 3> n = {20, 20, 20};
+  const std::array<double, 3> origin = {0., 0., 0.};
+  for (const bool periodic : {false, true}) {
+    RectangularLattice<double> lattice(l, n, origin, periodic,
+                                       LatticeUpdate::EveryTimestep);
+    // The cube covers the cells 3 to 11 along z, of which 8 to 11 are iterated
+    const LatticeLayers layers{8, 16};
+    int n_iterated = 0;
+    lattice.iterate_in_cube(ThreeVector(10., 10., 8.), 4.5, layers,
+                            [&](double &node, int, int, int iz) {
+                              VERIFY(layers.contain(iz)) << iz;
+                              node += 1.0;
+                              n_iterated++;
+                            });
+    COMPARE(n_iterated, 9 * 9 * 4);
+    // Only the tiles with tz = 1 are occupied
+    for (std::size_t tile = 0; tile < lattice.n_tiles(); tile++) {
+      COMPARE(lattice.tile_occupied(tile), tile >= 9 && tile < 18 &&
+                                               tile % 3 != 2 &&
+                                               (tile / 3) % 3 != 2)
+          << "tile " << tile;
+    }
+    // The neighbor below the center cell is in another layer
+    n_iterated = 0;
+    lattice.iterate_nearest_neighbors(
+        ThreeVector(10.5, 10.5, 8.5), layers,
+        [&](double &, int index, int) {
+          VERIFY(layers.contain(index / 400)) << index;
+          n_iterated++;
+        });
+    COMPARE(n_iterated, 6);
+  }
+}
+
 TEST(iterate_in_rectangle) {
   // 1) Lattice is not periodic
   auto lattice = create_lattice(false);
@@ -0,0 +1,56 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/decaymodes.h"
+#include "smash/integrate.h"
+#include "smash/isoparticletype.h"
+#include "smash/tabulation.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "π  0.138 0.0   - 211 111\n"
+      "N  0.938 0.0   + 2212 2112\n"
+      "Δ  1.232 0.117 + 2224 2214 2114 1114\n");
+  DecayModes::load_decaymodes(
+      "Δ          \n"
+      "1.  1  N π \n");
+  ParticleType::check_consistency();
+  sha256::Hash hash;
+  hash.fill(0);
+  IsoParticleType::tabulate_integrals(hash, "", nullptr, true);
+}
+
+TEST(integrals_on_first_use) {
+  const IsoParticleType &delta = IsoParticleType::find("Δ");
+  const IsoParticleType &nucleon = IsoParticleType::find("N");
+  Integrator integrate;
+  const Tabulation NR = spectral_integral_semistable(
+      integrate, *delta.get_states()[0], *nucleon.get_states()[0], 2.0);
+  IsoParticleType &delta_multiplet = *delta.get_states()[0]->iso_multiplet();
+  IsoParticleType &anti_delta_multiplet =
+      *delta.get_states()[0]->get_antiparticle()->iso_multiplet();
+  for (const double sqrts : {2.2, 2.5, 3.1}) {
+    COMPARE(delta_multiplet.get_integral_NR(sqrts),
+            NR.get_value_linear(sqrts));
+    // The anti-multiplet shares the tabulation.
+    COMPARE(anti_delta_multiplet.get_integral_NR(sqrts),
+            NR.get_value_linear(sqrts));
+  }
+}
+
+TEST_CATCH(missing_particle, IsoParticleType::ParticleNotFoundFailure) {
+  // Without kaons, there is no integral for the RK cross sections.
+  IsoParticleType &delta = *ParticleType::find(0x2224).iso_multiplet();
+  delta.get_integral_RK(2.);
+}
@@ -11,10 +11,12 @@
 
 #include "smash/listmodus.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <string>
 
 #include "setup.h"
+#include "smash/binaryoutput.h"
 #include "smash/oscaroutput.h"
 #include "smash/particles.h"
 
@@ -504,6 +506,107 @@ TEST(multiple_events_in_file) {
   }
 }
 
+TEST(multiple_events_in_binary_file) {
+  OutputParameters out_par = OutputParameters();
+  out_par.part_only_final = OutputOnlyFinal::Yes;
+  out_par.quantities["Particles"] = OutputDefaultQuantities::oscar2013;
+  constexpr int max_events = 2;
+  constexpr int particles_per_event = 10;
+  std::vector<ParticleList> init_particles;
+  {
+    std::unique_ptr<OutputInterface> binary_output = create_binary_output(
+        "Binary", "Particles", testoutputpath, out_par);
+    VERIFY(bool(binary_output));
+    for (int event = 0; event < max_events; event++) {
+      Particles particles;
+      for (int i = 0; i < particles_per_event; i++) {
+        particles.insert(Test::smashon_random());
+      }
+      init_particles.push_back(particles.copy_to_vector());
+      EventInfo default_event_info = Test::default_event_info(2.34, false);
+      binary_output->at_eventend(particles, {event, 0}, default_event_info);
+    }
+  }
+  std::filesystem::rename(testoutputpath / "particles_oscar2013.bin",
+                          testoutputpath / "binary_event0");
+  Configuration config{R"(
+    Modi:
+      List:
+        File_Directory: ToBeSet
+        Filename: binary_event0
+        File_Format: Binary
+    )"};
+  config.set_value(InputKeys::modi_list_fileDirectory, testoutputpath.string());
+  ListModus list_modus(std::move(config), parameters);
+
+  for (int cur_event = 0; cur_event < max_events; cur_event++) {
+    Particles particles_read;
+    list_modus.initial_conditions(&particles_read, parameters);
+
+    // Scroll particles back to the earliest time, as list modus should do
+    double earliest_t = 1.e8;
+    for (const auto &particle : init_particles[cur_event]) {
+      earliest_t = std::min(earliest_t, particle.position().x0());
+    }
+    COMPARE(particles_read.size(), init_particles[cur_event].size());
+    const ParticleList p_fin = particles_read.copy_to_vector();
+    for (size_t i = 0; i < p_fin.size(); i++) {
+      const ParticleData &a = init_particles[cur_event][i];
+      const ParticleData &b = p_fin[i];
+      const FourVector u(1.0, a.velocity());
+      // The binary file holds the exact momenta
+      COMPARE(a.momentum(), b.momentum());
+      compare_fourvector(a.position() + u * (earliest_t - a.position().x0()),
+                         b.position());
+      COMPARE(a.pdgcode(), b.pdgcode());
+    }
+  }
+}
+
+/// \return A list modus reading the events of the given stream.
+static ListModus create_list_modus_with_stream_for_test(
+    const std::filesystem::path &path) {
+  Configuration config{R"(
+    Modi:
+      List:
+        Stream: ToBeSet
+    )"};
+  config.set_value(InputKeys::modi_list_stream, path.string());
+  return ListModus(std::move(config), parameters);
+}
+
+TEST(multiple_events_in_stream) {
+  OutputParameters out_par = OutputParameters();
+  out_par.part_only_final = OutputOnlyFinal::Yes;
+  out_par.part_extended = false;
+  constexpr int max_events = 3;
+  std::vector<ParticleList> init_particles;
+  const std::filesystem::path path =
+      create_particlefile(out_par, 0, init_particles, 10, max_events);
+  ListModus list_modus = create_list_modus_with_stream_for_test(path);
+
+  for (int cur_event = 0; cur_event < max_events; cur_event++) {
+    Particles particles_read;
+    list_modus.initial_conditions(&particles_read, parameters);
+    COMPARE(particles_read.size(), init_particles[cur_event].size());
+    const ParticleList p_fin = particles_read.copy_to_vector();
+    for (size_t i = 0; i < p_fin.size(); i++) {
+      compare_fourvector(init_particles[cur_event][i].momentum(),
+                         p_fin[i].momentum());
+      COMPARE(init_particles[cur_event][i].pdgcode(), p_fin[i].pdgcode());
+    }
+  }
+  // The stream has ended
+  bool thrown = false;
+  try {
+    Particles particles_read;
+    list_modus.initial_conditions(&particles_read, parameters);
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+}
+
 TEST(try_create_particle_func) {
   ListModus list_modus = create_list_modus_for_test();
   Particles particles;
@@ -589,6 +692,7 @@ TEST(try_create_particle_with_spin_func) {
       0.,
       false,
       -1.0,
+      false,
       200.0,
       2.5,
       1.0,
@@ -658,3 +762,14 @@ TEST_CATCH(create_particles_at_same_position, ListModus::InvalidEvents) {
   create_particle_file_with_multiple_particles_at_same_position(out_par);
   ListModus list_modus = create_list_modus_with_single_file_for_test();
 }
+
+TEST_CATCH(create_particles_at_same_position_in_stream,
+           ListModus::InvalidEvents) {
+  const OutputParameters out_par = OutputParameters();
+  create_particle_file_with_multiple_particles_at_same_position(out_par);
+  ListModus list_modus =
+      create_list_modus_with_stream_for_test(testoutputpath / "event0");
+  // The events of a stream are checked when they are read
+  Particles particles;
+  list_modus.initial_conditions(&particles, parameters);
+}
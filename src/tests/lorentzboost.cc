@@ -10,6 +10,8 @@
 #include "smash/angles.h"
 #include "smash/fourvector.h"
 
+#include <vector>
+
 using namespace smash;
 
 constexpr double accuracy = 4e-9;
@@ -89,3 +91,24 @@ TEST(back_and_forth) {
     }
   }
 }
+
+// a shared boost gives the same vectors as boosting them one by one
+TEST(shared_boost) {
+  for (int i = 0; i < 1000; i++) {
+    ThreeVector velocity = random_velocity();
+    std::vector<FourVector> vectors;
+    for (int j = 0; j < 10; j++) {
+      vectors.emplace_back(cos_like(), cos_like(), cos_like(), cos_like());
+    }
+    std::vector<FourVector> boosted = vectors;
+    const LorentzBoost boost(velocity);
+    boost.apply(boosted.begin(), boosted.end());
+    for (std::size_t j = 0; j < vectors.size(); j++) {
+      const FourVector single = vectors[j].lorentz_boost(velocity);
+      COMPARE(boosted[j].x0(), single.x0()) << " at loop " << i << "*" << j;
+      COMPARE(boosted[j].x1(), single.x1()) << " at loop " << i << "*" << j;
+      COMPARE(boosted[j].x2(), single.x2()) << " at loop " << i << "*" << j;
+      COMPARE(boosted[j].x3(), single.x3()) << " at loop " << i << "*" << j;
+    }
+  }
+}
@@ -38,7 +38,9 @@ TEST(init_decay_modes) {
       "1.  1  π ρ \n");
 }
 
-TEST(omega_decay) {
+/* Sample the ρ masses in ω decays at rest and compare them to the spectral
+ * function times the phase space. */
+static void test_omega_decay() {
   // set up omega decay action
   const ParticleType &type_omega = ParticleType::find(0x223);
   ParticleData omega{type_omega};
@@ -100,3 +102,11 @@ TEST(omega_decay) {
                     //,"masses_rho_charged.dat"
   );
 }
+
+TEST(omega_decay) { test_omega_decay(); }
+
+TEST(omega_decay_tabulated) {
+  ParticleType::set_tabulated_mass_sampling(true);
+  test_omega_decay();
+  ParticleType::set_tabulated_mass_sampling(false);
+}
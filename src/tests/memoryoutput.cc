@@ -0,0 +1,119 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/memoryoutput.h"
+
+#include <vector>
+
+#include "setup.h"
+#include "smash/fluidizationaction.h"
+#include "smash/freeforallaction.h"
+#include "smash/particles.h"
+
+using namespace smash;
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST(record_of_particle) {
+  const ParticleData p =
+      Test::smashon(Test::Position{1., 2., 3., 4.},
+                    Test::Momentum{Test::smashon_mass + 0.5, 0.1, 0.2, 0.3}, 7);
+  const ParticleRecord r = MemoryOutput::record(p);
+  COMPARE(r.t, 1.);
+  COMPARE(r.x, 2.);
+  COMPARE(r.y, 3.);
+  COMPARE(r.z, 4.);
+  COMPARE(r.p0, Test::smashon_mass + 0.5);
+  COMPARE(r.px, 0.1);
+  COMPARE(r.py, 0.2);
+  COMPARE(r.pz, 0.3);
+  COMPARE(r.mass, p.effective_mass());
+  COMPARE(r.formation_time, 1.);
+  COMPARE(r.id, 7);
+  COMPARE(r.pdg, 0x661);
+  COMPARE(r.ncoll, 0);
+}
+
+TEST(particle_of_record) {
+  ParticleData p =
+      Test::smashon(Test::Position{1., 2., 3., 4.},
+                    Test::Momentum{Test::smashon_mass + 0.5, 0.1, 0.2, 0.3}, 7);
+  p.set_perturbative_weight(0.5);
+  const ParticleData q = MemoryOutput::particle(MemoryOutput::record(p));
+  COMPARE(q.id(), 7);
+  COMPARE(q.pdgcode(), p.pdgcode());
+  COMPARE(q.position(), p.position());
+  COMPARE(q.momentum(), p.momentum());
+  COMPARE(q.formation_time(), p.formation_time());
+  COMPARE(q.perturbative_weight(), 0.5);
+}
+
+TEST(particles_are_passed) {
+  std::vector<ParticleBlock::Stage> stages;
+  std::vector<std::size_t> sizes;
+  std::vector<int> ids;
+  MemoryOutput output([&](const ParticleBlock &block) {
+    stages.push_back(block.stage);
+    sizes.push_back(block.particles.size());
+    for (const ParticleRecord &r : block.particles) {
+      ids.push_back(r.id);
+    }
+  });
+  Particles particles;
+  particles.insert(Test::smashon());
+  particles.insert(Test::smashon());
+  EventInfo event = Test::default_event_info();
+  output.at_eventstart(particles, {0, 0}, event);
+  particles.insert(Test::smashon());
+  output.at_eventend(particles, {0, 0}, event);
+  COMPARE(stages, (std::vector<ParticleBlock::Stage>{
+                      ParticleBlock::Stage::EventStart,
+                      ParticleBlock::Stage::EventEnd}));
+  COMPARE(sizes, (std::vector<std::size_t>{2, 3}));
+  COMPARE(ids, (std::vector<int>{0, 1, 0, 1, 2}));
+}
+
+TEST(interactions_are_passed) {
+  std::vector<InteractionRecord> interactions;
+  MemoryOutput output(
+      {}, [&](const InteractionRecord &interaction) {
+        interactions.push_back(interaction);
+      });
+  const Particles particles;
+  output.at_eventstart(particles, {3, 0}, Test::default_event_info());
+  const FreeforallAction action({Test::smashon(1)},
+                                {Test::smashon(2), Test::smashon(3)}, 0.5);
+  output.at_interaction(action, 0.25);
+  COMPARE(interactions.size(), 1u);
+  const InteractionRecord &interaction = interactions[0];
+  COMPARE(interaction.event_number, 3);
+  COMPARE(interaction.time, 0.5);
+  COMPARE(interaction.density, 0.25);
+  COMPARE(interaction.incoming.size(), 1u);
+  COMPARE(interaction.incoming[0].id, 1);
+  COMPARE(interaction.outgoing.size(), 2u);
+  COMPARE(interaction.outgoing[1].id, 3);
+}
+
+TEST(fluidized_particles_are_passed) {
+  std::vector<int> fluidized_ids;
+  int n_interactions = 0;
+  MemoryOutput output({}, [&](const InteractionRecord &) { n_interactions++; });
+  output.set_fluidization_callback(
+      [&](const ParticleRecord &r) { fluidized_ids.push_back(r.id); });
+  const FluidizationAction fluidization(Test::smashon(4), Test::smashon(4),
+                                        0.);
+  output.at_interaction(fluidization, 0.);
+  const FreeforallAction other({Test::smashon(5)}, {}, 0.);
+  output.at_interaction(other, 0.);
+  COMPARE(fluidized_ids, std::vector<int>{4});
+  COMPARE(n_interactions, 2);
+}
@@ -179,7 +179,9 @@ TEST(shift_z) {
 }
 
 // test the woods-saxon distribution at various discrete points:
-TEST(woods_saxon) {
+/* Compare the sampled radii to the Woods-Saxon distribution, sampling them
+ * by rejection or from the tabulated distribution. */
+static void test_woods_saxon(bool tabulated) {
   // this is where we store the distribution.
   std::map<int, int> histogram{};
   // binning width for the distribution:
@@ -191,6 +193,7 @@ TEST(woods_saxon) {
   double diffusiveness = 0.545;
   projectile.set_nuclear_radius(R);
   projectile.set_diffusiveness(diffusiveness);
+  projectile.set_tabulated_positions(tabulated);
   // this is the number of times we access the distribution.
   constexpr int N_TEST = 10000000;
   // fill the histogram
@@ -223,6 +226,10 @@ TEST(woods_saxon) {
   }
 }
 
+TEST(woods_saxon) { test_woods_saxon(false); }
+
+TEST(woods_saxon_tabulated) { test_woods_saxon(true); }
+
 TEST(Fermi_motion) {
   std::map<PdgCode, int> myfunnylist = {{0x2212, 22},  // protons
                                         {0x2112, 35},  // neutrons
@@ -252,6 +252,9 @@ TEST(final2013_format) {
         create_oscar_output("Oscar2013", "Particles", testoutputpath, out_par);
     VERIFY(bool(osc2013final));
     VERIFY(std::filesystem::exists(outputfilepath_unfinished));
+    // Only the final particles are written
+    COMPARE(osc2013final->subscribed_hooks(),
+            OutputHooksBitSet().set(EventHooks));
     /* Initial state output (note that this should not do anything!) */
     osc2013final->at_eventstart(particles, event_id, event);
     /* As with initial state output, this should not do anything */
@@ -457,6 +460,8 @@ TEST(initial_conditions_2013_format) {
         "Oscar2013", "Initial_Conditions", testoutputpath, out_par);
     VERIFY(bool(osc2013full));
     VERIFY(std::filesystem::exists(outputfilepath_unfinished));
+    COMPARE(osc2013full->subscribed_hooks(),
+            OutputHooksBitSet().set(EventHooks).set(InteractionHooks));
 
     osc2013full->at_eventstart(particles, event_id, event);
     action->perform(&particles, 1);
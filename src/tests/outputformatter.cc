@@ -11,6 +11,9 @@
 
 #include "smash/outputformatter.h"
 
+#include <cstdio>
+#include <string>
+
 #include "setup.h"
 
 using namespace smash;
@@ -29,6 +32,19 @@ TEST(ASCII_converter) {
   VERIFY(converter.as_string("smash") == smash_str);
 }
 
+TEST(ASCII_converter_matches_printf) {
+  ToASCII converter;
+  // The numbers have to be formatted exactly as with the %g conversion
+  for (const double x : {0.0, -0.0, 1.0, -2.5, 1.0 / 3.0, 123456.7, 1234567.0,
+                         1e-5, -3.2e-12, 6.02214076e23, 0x1p-1074}) {
+    char expected[32];
+    std::snprintf(expected, sizeof(expected), "%.6g", x);
+    COMPARE(converter.as_double(x), std::string{expected}) << x;
+    std::snprintf(expected, sizeof(expected), "%.9g", x);
+    COMPARE(converter.as_precise_double(x), std::string{expected}) << x;
+  }
+}
+
 TEST_CATCH(empty_quantities, std::invalid_argument) {
   std::vector<std::string> empty{};
   OutputFormatter<ToASCII> formatter(empty);
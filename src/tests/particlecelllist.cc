@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/particlecelllist.h"
+
+#include <stdexcept>
+
+#include "setup.h"
+#include "smash/random.h"
+
+using namespace smash;
+using Test::Position;
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST_CATCH(zero_cutoff, std::invalid_argument) {
+  const ParticleList particles = {Test::smashon(0)};
+  ParticleCellList cells(particles, 0.);
+}
+
+TEST(empty_list) {
+  const ParticleList particles{};
+  const ParticleCellList cells(particles, 2.);
+  ParticleList candidates = {Test::smashon(0)};
+  cells.find_candidates(ThreeVector(1., 2., 3.), candidates);
+  COMPARE(candidates.size(), 0u);
+}
+
+TEST(few_particles_share_one_cell) {
+  const ParticleList particles = {
+      Test::smashon(Position{0., -100., 0., 0.}, 0),
+      Test::smashon(Position{0., 100., 0., 0.}, 1)};
+  const ParticleCellList cells(particles, 2.);
+  COMPARE(cells.number_of_cells(), (std::array<int, 3>{1, 1, 1}));
+  ParticleList candidates;
+  cells.find_candidates(ThreeVector(0., 0., 0.), candidates);
+  COMPARE(candidates.size(), 2u);
+  // Points further away than one cell have no candidates
+  cells.find_candidates(ThreeVector(0., 0., 5.), candidates);
+  COMPARE(candidates.size(), 0u);
+}
+
+TEST(candidates_contain_close_particles_in_order) {
+  constexpr double cutoff = 2.2;
+  auto coordinate = random::make_uniform_distribution(-20., 20.);
+  ParticleList particles;
+  for (int i = 0; i < 2000; i++) {
+    particles.push_back(Test::smashon(
+        Position{0., coordinate(), coordinate(), 0.3 * coordinate()}, i));
+  }
+  const ParticleCellList cells(particles, cutoff);
+  for (int i = 0; i < 3; i++) {
+    VERIFY(cells.number_of_cells()[i] > 1);
+  }
+  auto query = random::make_uniform_distribution(-25., 25.);
+  ParticleList candidates;
+  std::size_t total_candidates = 0;
+  for (int n = 0; n < 200; n++) {
+    const ThreeVector r(query(), query(), 0.3 * query());
+    cells.find_candidates(r, candidates);
+    total_candidates += candidates.size();
+    for (std::size_t i = 1; i < candidates.size(); i++) {
+      VERIFY(candidates[i - 1].id() < candidates[i].id());
+    }
+    std::size_t j = 0;
+    for (const ParticleData &p : particles) {
+      if ((p.position().threevec() - r).abs() > cutoff) {
+        continue;
+      }
+      while (j < candidates.size() && candidates[j].id() < p.id()) {
+        j++;
+      }
+      VERIFY(j < candidates.size()) << p.id() << " not found near " << r;
+      COMPARE(candidates[j].id(), p.id());
+      COMPARE(candidates[j].position(), p.position());
+    }
+  }
+  // Only a small fraction of the particles are candidates on average
+  VERIFY(total_candidates < 200 * particles.size() / 4);
+}
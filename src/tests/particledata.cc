@@ -211,3 +211,85 @@ TEST(unpolarized_particle_initialization) {
   VERIFY(mean_polarization.x2() < tolerance);
   VERIFY(mean_polarization.x3() < tolerance);
 }
+
+TEST(span_of_particle_list) {
+  ParticleList list;
+  for (int i = 0; i < 4; i++) {
+    list.emplace_back(ParticleType::find(smash::pdg::p), i);
+  }
+  const ParticleSpan all = list;
+  COMPARE(all.size(), 4u);
+  VERIFY(!all.empty());
+  COMPARE(all[2].id(), 2);
+  const ParticleSpan middle(list.data() + 1, 2);
+  std::vector<int> ids;
+  for (const ParticleData &p : middle) {
+    ids.push_back(p.id());
+  }
+  COMPARE(ids, (std::vector<int>{1, 2}));
+  VERIFY(ParticleSpan().empty());
+}
+
+TEST(compact_layout) {
+  /* The ids, type, flags and the last process type share the first 16 bytes
+   * and leave no gap, the rest of the history takes 24 bytes. */
+  COMPARE(sizeof(ParticleData),
+          16 + 3 * sizeof(FourVector) + 5 * sizeof(double) + 24);
+  VERIFY(sizeof(ParticleData) < 16 + 3 * sizeof(FourVector) +
+                                    5 * sizeof(double) + sizeof(HistoryData));
+  ParticleData p{ParticleType::find(smash::pdg::p)};
+  p.set_belongs_to(BelongsTo::Target);
+  const ParticleData q = p;
+  VERIFY(q.belongs_to() == BelongsTo::Target);
+}
+
+TEST(history_round_trip) {
+  ParticleData p{ParticleType::find(0x211)};
+  const HistoryData initial = p.get_history();
+  COMPARE(initial.collisions_per_particle, 0);
+  COMPARE(initial.id_process, 0);
+  VERIFY(initial.process_type == ProcessType::None);
+  VERIFY(std::isnan(initial.time_last_collision));
+  HistoryData history;
+  history.collisions_per_particle = 7;
+  history.id_process = 123456;
+  history.process_type = ProcessType::Freeforall;
+  history.time_last_collision = 4.5;
+  history.p1 = 0x2212;
+  history.p2 = -0x211;
+  p.set_history(HistoryData(history));
+  const ParticleData q = p;
+  const HistoryData read = q.get_history();
+  COMPARE(read.collisions_per_particle, 7);
+  COMPARE(q.collisions_per_particle(), 7);
+  COMPARE(read.id_process, 123456);
+  COMPARE(q.id_process(), 123456u);
+  VERIFY(read.process_type == ProcessType::Freeforall);
+  COMPARE(read.time_last_collision, 4.5);
+  COMPARE(read.p1, PdgCode(0x2212));
+  COMPARE(read.p2, PdgCode(-0x211));
+  // Decays store their parent and replace the process type
+  ParticleData parent{ParticleType::find(0x111)};
+  p.set_history(8, 12, ProcessType::Decay, 5.0, ParticleList{parent});
+  VERIFY(p.get_history().process_type == ProcessType::Decay);
+  COMPARE(p.get_history().p1, PdgCode(0x111));
+  COMPARE(p.get_history().p2, PdgCode(0x0));
+}
+
+TEST(cached_velocity) {
+  ParticleData p{ParticleType::find(0x211)};
+  // The velocity is the same as computed from the momentum, bit by bit
+  p.set_4momentum(FourVector(1.3, 0.2, -0.7, 0.9));
+  COMPARE(p.velocity(), p.momentum().velocity());
+  p.set_4momentum(0.138, ThreeVector(0.1, 0.4, -2.1));
+  COMPARE(p.velocity(), p.momentum().velocity());
+  p.set_4momentum(0.138, 0.3, 0.2, 0.1);
+  COMPARE(p.velocity(), p.momentum().velocity());
+  p.set_3momentum(ThreeVector(0.5, 0.5, 0.5));
+  COMPARE(p.velocity(), p.momentum().velocity());
+  p.boost_momentum(ThreeVector(0.1, 0.2, 0.3));
+  COMPARE(p.velocity(), p.momentum().velocity());
+  // Copies keep the cached value
+  const ParticleData q = p;
+  COMPARE(q.velocity(), p.momentum().velocity());
+}
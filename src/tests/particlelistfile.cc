@@ -0,0 +1,163 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/particlelistfile.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+/// Write the given text to a file in the test output directory.
+static std::filesystem::path write_file(const std::string &name,
+                                        const std::string &content) {
+  const std::filesystem::path path = testoutputpath / name;
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+  return path;
+}
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST_CATCH(missing_file, std::runtime_error) {
+  ParticleListFile file(testoutputpath / "does_not_exist");
+}
+
+TEST(empty_file) {
+  const ParticleListFile file(write_file("empty", ""));
+  COMPARE(file.size(), 0u);
+  // Prefetching an event which does not exist does nothing
+  file.prefetch(0);
+}
+
+TEST(oscar_events) {
+  const ParticleListFile file(
+      write_file("oscar", "#!OSCAR2013 particle_lists\n"
+                          "# event 0 out 2\n"
+                          "1 2 3\n"
+                          "4 5 6\n"
+                          "# event 0 end 0 impact   2.340\n"
+                          "# event 1 out 0\n"
+                          "# event 1 end 0 impact   2.340\n"));
+  COMPARE(file.size(), 2u);
+  COMPARE(std::string(file[0].content),
+          "#!OSCAR2013 particle_lists\n# event 0 out 2\n1 2 3\n4 5 6\n");
+  COMPARE(file[0].first_line, 1);
+  COMPARE(std::string(file[1].content), "# event 1 out 0\n");
+  COMPARE(file[1].first_line, 6);
+  file.prefetch(1);
+}
+
+TEST(file_without_event_end) {
+  // A short file without event end line and final newline is one event
+  const ParticleListFile file(write_file("single", "1 2 3\n4 5 6"));
+  COMPARE(file.size(), 1u);
+  COMPARE(std::string(file[0].content), "1 2 3\n4 5 6");
+  COMPARE(file[0].first_line, 1);
+}
+
+TEST(trailing_whitespace_is_no_event) {
+  const ParticleListFile file(
+      write_file("trailing", "1 2 3\n# event 0 end 0\n \n\n"));
+  COMPARE(file.size(), 1u);
+  COMPARE(std::string(file[0].content), "1 2 3\n");
+}
+
+/// Append the bytes of a value to a string.
+template <typename T>
+static void append(std::string &bytes, T value) {
+  bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/// \return The header of a binary file with the given format variant.
+static std::string binary_header(std::uint16_t format_variant) {
+  std::string bytes = "SMSH";
+  append<std::uint16_t>(bytes, 10);
+  append<std::uint16_t>(bytes, format_variant);
+  append<std::uint32_t>(bytes, 5);
+  bytes += "3.4.0";
+  return bytes;
+}
+
+/// Append a particle block with the given number of particle lines.
+static void append_particle_block(std::string &bytes, std::uint32_t n_lines,
+                                  std::size_t line_size) {
+  bytes += 'p';
+  append<std::int32_t>(bytes, 0);
+  append<std::int32_t>(bytes, 0);
+  append<std::uint32_t>(bytes, n_lines);
+  bytes.append(n_lines * line_size, '\0');
+}
+
+/// Append an event end block.
+static void append_event_end(std::string &bytes) {
+  bytes += 'f';
+  append<std::int32_t>(bytes, 0);
+  append<std::int32_t>(bytes, 0);
+  append<double>(bytes, 0.0);
+  bytes += '\0';
+}
+
+TEST(binary_events) {
+  constexpr std::size_t line_size = 136;  // extended OSCAR 2013
+  std::string bytes = binary_header(1);
+  const std::size_t first_event = bytes.size();
+  append_particle_block(bytes, 2, line_size);
+  append_particle_block(bytes, 1, line_size);
+  const std::size_t first_event_end = bytes.size();
+  append_event_end(bytes);
+  const std::size_t second_event = bytes.size();
+  append_particle_block(bytes, 3, line_size);
+  const ParticleListFile file(write_file("binary", bytes),
+                              ParticleListFile::Format::Binary);
+  COMPARE(file.format_variant(), 1u);
+  COMPARE(file.size(), 2u);
+  COMPARE(std::string(file[0].content),
+          bytes.substr(first_event, first_event_end - first_event));
+  // The blocks after the last event end block are one more event
+  COMPARE(std::string(file[1].content), bytes.substr(second_event));
+}
+
+TEST_CATCH(binary_file_with_wrong_magic_number, std::runtime_error) {
+  std::string bytes = binary_header(0);
+  bytes[0] = 'X';
+  ParticleListFile file(write_file("binary", bytes),
+                        ParticleListFile::Format::Binary);
+}
+
+TEST_CATCH(binary_file_with_custom_quantities, std::runtime_error) {
+  ParticleListFile file(write_file("binary", binary_header(2)),
+                        ParticleListFile::Format::Binary);
+}
+
+TEST_CATCH(truncated_binary_file, std::runtime_error) {
+  std::string bytes = binary_header(0);
+  append_particle_block(bytes, 2, 84);
+  bytes.pop_back();
+  ParticleListFile file(write_file("binary", bytes),
+                        ParticleListFile::Format::Binary);
+}
+
+TEST_CATCH(binary_file_with_interactions, std::runtime_error) {
+  std::string bytes = binary_header(0);
+  bytes += 'i';
+  ParticleListFile file(write_file("binary", bytes),
+                        ParticleListFile::Format::Binary);
+}
@@ -0,0 +1,201 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/particleliststream.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+/// Write the given bytes to a file descriptor and close it.
+static void write_and_close(int fd, const std::string &bytes) {
+  std::size_t written = 0;
+  while (written < bytes.size()) {
+    const ssize_t n = write(fd, bytes.data() + written, bytes.size() - written);
+    if (n <= 0) {
+      break;
+    }
+    written += n;
+  }
+  close(fd);
+}
+
+/// \return A named pipe in the test output directory.
+static std::string make_pipe(const std::string &name) {
+  const std::filesystem::path path = testoutputpath / name;
+  std::filesystem::remove(path);
+  VERIFY(mkfifo(path.c_str(), 0600) == 0);
+  return path.native();
+}
+
+/// Append the bytes of a value to a string.
+template <typename T>
+static void append(std::string &bytes, T value) {
+  bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/// \return The header of a binary stream with the given format variant.
+static std::string binary_header(std::uint16_t format_variant) {
+  std::string bytes = "SMSH";
+  append<std::uint16_t>(bytes, 10);
+  append<std::uint16_t>(bytes, format_variant);
+  append<std::uint32_t>(bytes, 5);
+  bytes += "3.4.0";
+  return bytes;
+}
+
+/// Append a particle block with the given number of particle lines.
+static void append_particle_block(std::string &bytes, std::uint32_t n_lines,
+                                  std::size_t line_size) {
+  bytes += 'p';
+  append<std::int32_t>(bytes, 0);
+  append<std::int32_t>(bytes, 0);
+  append<std::uint32_t>(bytes, n_lines);
+  bytes.append(n_lines * line_size, '\0');
+}
+
+/// Append an event end block.
+static void append_event_end(std::string &bytes) {
+  bytes += 'f';
+  append<std::int32_t>(bytes, 0);
+  append<std::int32_t>(bytes, 0);
+  append<double>(bytes, 0.0);
+  bytes += '\0';
+}
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST_CATCH(missing_source, std::runtime_error) {
+  ParticleListStream stream((testoutputpath / "does_not_exist").native(),
+                            ParticleListFile::Format::ASCII);
+}
+
+TEST(oscar_events_from_named_pipe) {
+  const std::string path = make_pipe("oscar_pipe");
+  // More events than fit into the queue, written in pieces
+  std::string text = "#!OSCAR2013 particle_lists\n";
+  for (int event = 0; event < 10; event++) {
+    text += "# event " + std::to_string(event) + " out 1\n1 2 3\n";
+    text += "# event " + std::to_string(event) + " end 0 impact   2.340\n";
+  }
+  text += "4 5 6";
+  std::thread writer([&path, &text] {
+    const int fd = open(path.c_str(), O_WRONLY);
+    for (std::size_t i = 0; i < text.size(); i += 7) {
+      VERIFY(write(fd, text.data() + i, std::min<std::size_t>(
+                                             7, text.size() - i)) > 0);
+    }
+    close(fd);
+  });
+  ParticleListStream stream(path, ParticleListFile::Format::ASCII, 2);
+  auto event = stream.next();
+  VERIFY(event.has_value());
+  COMPARE(event->content,
+          "#!OSCAR2013 particle_lists\n# event 0 out 1\n1 2 3\n");
+  COMPARE(event->first_line, 1);
+  for (int i = 1; i < 10; i++) {
+    event = stream.next();
+    VERIFY(event.has_value());
+    COMPARE(event->content, "# event " + std::to_string(i) + " out 1\n1 2 3\n");
+    COMPARE(event->first_line, 3 * i + 2);
+  }
+  // The text after the last event end line is one more event
+  event = stream.next();
+  VERIFY(event.has_value());
+  COMPARE(event->content, "4 5 6");
+  COMPARE(event->first_line, 32);
+  VERIFY(!stream.next().has_value());
+  writer.join();
+}
+
+TEST(binary_events_from_socket) {
+  const std::filesystem::path path = testoutputpath / "binary_socket";
+  std::filesystem::remove(path);
+  const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  VERIFY(bind(server, reinterpret_cast<sockaddr *>(&address),
+              sizeof(address)) == 0);
+  VERIFY(listen(server, 1) == 0);
+
+  constexpr std::size_t line_size = 84;  // OSCAR 2013
+  std::string bytes = binary_header(0);
+  const std::size_t first_event = bytes.size();
+  append_particle_block(bytes, 2, line_size);
+  const std::size_t first_event_end = bytes.size();
+  append_event_end(bytes);
+  const std::size_t second_event = bytes.size();
+  append_particle_block(bytes, 3, line_size);
+  std::thread writer([server, &bytes] {
+    write_and_close(accept(server, nullptr, nullptr), bytes);
+  });
+  ParticleListStream stream("unix:" + path.native(),
+                            ParticleListFile::Format::Binary);
+  auto event = stream.next();
+  VERIFY(event.has_value());
+  COMPARE(stream.format_variant(), 0u);
+  COMPARE(event->content,
+          bytes.substr(first_event, first_event_end - first_event));
+  // The blocks after the last event end block are one more event
+  event = stream.next();
+  VERIFY(event.has_value());
+  COMPARE(event->content, bytes.substr(second_event));
+  VERIFY(!stream.next().has_value());
+  writer.join();
+  close(server);
+}
+
+TEST_CATCH(truncated_binary_stream, std::runtime_error) {
+  std::string bytes = binary_header(1);
+  append_particle_block(bytes, 2, 136);
+  bytes.pop_back();
+  const std::filesystem::path path = testoutputpath / "truncated";
+  std::ofstream(path, std::ios::binary) << bytes;
+  ParticleListStream stream(path.native(), ParticleListFile::Format::Binary);
+  stream.next();
+}
+
+TEST(stop_while_waiting_for_writer) {
+  const std::string path = make_pipe("idle_pipe");
+  std::promise<void> stopped;
+  std::thread writer([&path, done = stopped.get_future()] {
+    // Keep the pipe open without writing anything until the stream stopped
+    const int fd = open(path.c_str(), O_WRONLY);
+    done.wait();
+    close(fd);
+  });
+  {
+    ParticleListStream stream(path, ParticleListFile::Format::ASCII);
+  }
+  stopped.set_value();
+  writer.join();
+}
@@ -11,6 +11,8 @@
 
 #include "smash/particles.h"
 
+#include <vector>
+
 #include "setup.h"
 #include "smash/particledata.h"
 #include "smash/pdgcode.h"
@@ -298,6 +300,164 @@ TEST(copy_to_vector) {
   }
 }
 
+TEST(copy_from) {
+  Particles original;
+  original.create(100, 0x661);
+  const ParticleList particles = original.copy_to_vector();
+  original.remove(particles[5]);
+  original.remove(particles[99]);
+  Particles copy;
+  copy.create(3, 0x111);
+  copy.copy_from(original);
+  COMPARE(copy.size(), 98u);
+  auto it = copy.begin();
+  for (const ParticleData &p : original) {
+    COMPARE(it->id(), p.id());
+    COMPARE(it->pdgcode(), p.pdgcode());
+    VERIFY(copy.is_valid(*it));
+    ++it;
+  }
+  // The id counter is copied as well
+  COMPARE(copy.insert(Test::smashon()).id(), 100);
+}
+
+TEST(view_of_ensembles) {
+  std::vector<Particles> ensembles(4);
+  ensembles[0].create(5, 0x661);
+  ensembles[2].create(4, 0x111);
+  ensembles[3].create(2, 0x211);
+  const ParticleList first = ensembles[0].copy_to_vector();
+  ensembles[0].remove(first[0]);
+  ensembles[0].remove(first[2]);
+  const ParticleList third = ensembles[2].copy_to_vector();
+  ensembles[2].remove(third[1]);
+  ensembles[2].remove(third[3]);
+  std::vector<int> expected_ids;
+  for (const Particles &particles : ensembles) {
+    for (const ParticleData &p : particles) {
+      expected_ids.push_back(p.id());
+    }
+  }
+  const ParticlesView view(ensembles);
+  COMPARE(view.size(), 7u);
+  std::vector<int> ids;
+  for (const ParticleData &p : view) {
+    ids.push_back(p.id());
+  }
+  COMPARE(ids, expected_ids);
+  // Views of a single container visit the same particles as the container
+  COMPARE(ParticlesView(ensembles[2]).size(), 2u);
+  COMPARE(ParticlesView(ensembles[2]).begin()->id(), third[0].id());
+  COMPARE(ParticlesView(first).size(), 5u);
+  VERIFY(ParticlesView(ensembles[1]).empty());
+  VERIFY(ParticlesView(ensembles[1]).begin() ==
+         ParticlesView(ensembles[1]).end());
+  VERIFY(ParticlesView(ParticleList{}).begin() ==
+         ParticlesView(ParticleList{}).end());
+}
+
+TEST(compact) {
+  Particles p;
+  p.create(10, 0x661);
+  COMPARE(p.hole_fraction(), 0.);
+  const ParticleList before = p.copy_to_vector();
+  for (int i : {3, 4, 8}) {
+    p.remove(before[i]);
+  }
+  COMPARE(p.hole_fraction(), 0.3);
+  p.compact();
+  COMPARE(p.hole_fraction(), 0.);
+  COMPARE(p.size(), 7u);
+  std::vector<int> ids;
+  for (const ParticleData &x : p) {
+    ids.push_back(x.id());
+    VERIFY(p.is_valid(x));
+  }
+  COMPARE(ids, (std::vector<int>{0, 1, 2, 5, 6, 7, 9}));
+  // Only the particles behind the first hole were moved
+  VERIFY(p.is_valid(before[1]));
+  VERIFY(!p.is_valid(before[9]));
+  // New particles are appended behind the existing ones
+  COMPARE(p.insert(Test::smashon()).id(), 10);
+  COMPARE(p.back().id(), 10);
+  COMPARE(p.size(), 8u);
+  // Compacting without holes does nothing
+  p.compact();
+  COMPARE(p.size(), 8u);
+  COMPARE(p.front().id(), 0);
+}
+
+TEST(shrink_to_fit) {
+  Particles p;
+  p.create(1000, 0x661);
+  const ParticleList before = p.copy_to_vector();
+  for (std::size_t i = 0; i < before.size(); i++) {
+    if (i % 10 != 0) {
+      p.remove(before[i]);
+    }
+  }
+  const std::size_t allocated = p.memory_usage();
+  p.shrink_to_fit();
+  VERIFY(p.memory_usage() < allocated / 5);
+  COMPARE(p.hole_fraction(), 0.);
+  COMPARE(p.size(), 100u);
+  int id = 0;
+  for (const ParticleData &x : p) {
+    COMPARE(x.id(), id);
+    id += 10;
+  }
+  // Particles can be added again
+  COMPARE(p.insert(Test::smashon()).id(), 1000);
+  COMPARE(p.size(), 101u);
+}
+
+TEST(sort_along_morton_curve) {
+  Particles p;
+  p.insert(Test::smashon(Test::Position{0., 1., 1., 1.}));
+  p.insert(Test::smashon(Test::Position{0., 0., 0., 0.}));
+  p.insert(Test::smashon(Test::Position{0., 1., 0., 0.}));
+  const ParticleData removed =
+      p.insert(Test::smashon(Test::Position{0., 0.5, 0.5, 0.5}));
+  p.insert(Test::smashon(Test::Position{0., 0., 1., 0.}));
+  p.insert(Test::smashon(Test::Position{0., 0., 0., 0.}));
+  p.remove(removed);
+  p.sort_along_morton_curve();
+  COMPARE(p.size(), 5u);
+  COMPARE(p.hole_fraction(), 0.);
+  std::vector<int> ids;
+  for (const ParticleData &x : p) {
+    ids.push_back(x.id());
+    VERIFY(p.is_valid(x));
+  }
+  // Particles at the same position keep their order
+  COMPARE(ids, (std::vector<int>{1, 5, 2, 4, 0}));
+}
+
+TEST(find_by_id) {
+  Particles p;
+  p.create(10, 0x661);
+  const ParticleList before = p.copy_to_vector();
+  p.remove(before[3]);
+  p.remove(before[9]);
+  VERIFY(p.find(3) == nullptr);
+  VERIFY(p.find(9) == nullptr);
+  VERIFY(p.find(10) == nullptr);
+  VERIFY(p.find(-1) == nullptr);
+  // A hole is refilled with a new id
+  const ParticleData &inserted = p.insert(Test::smashon());
+  COMPARE(p.find(10), &inserted);
+  p.sort_along_morton_curve();
+  for (const ParticleData &x : p) {
+    COMPARE(p.find(x.id()), &x);
+  }
+  Particles copy;
+  copy.copy_from(p, [](const ParticleData &x) { return x.id() % 2 == 0; });
+  COMPARE(copy.find(4)->id(), 4);
+  VERIFY(copy.find(5) == nullptr);
+  p.reset();
+  VERIFY(p.find(0) == nullptr);
+}
+
 TEST(exceed_capacity) {
   Particles p;
   p.create(50, 0x661);
@@ -272,3 +272,15 @@ TEST(exists) {
 
   VERIFY(!ParticleType::exists(0x667));  // ttbar
 }
+
+TEST(try_find) {
+  for (const ParticleType &type : ParticleType::list_all()) {
+    const ParticleTypePtr found = ParticleType::try_find(type.pdgcode());
+    VERIFY(found);
+    COMPARE(&*found, &type);
+  }
+  VERIFY(!ParticleType::try_find(0x667));    // ttbar
+  VERIFY(!ParticleType::try_find(0x10211));  // a0(1450)+
+  VERIFY(!ParticleType::try_find(0x3322));   // Xi0
+  VERIFY(!ParticleType::try_find(-0x3322));  // anti-Xi0
+}
@@ -11,6 +11,7 @@
 
 #include "smash/pauliblocking.h"
 
+#include <cmath>
 #include <filesystem>
 
 #include "setup.h"
@@ -115,3 +116,173 @@ TEST(phase_space_density_nucleus) {
     std::cout << 0.5 / 100 * i << "  " << f << std::endl;
   }
 }
+
+TEST(indexed_phase_space_density_matches_all_particles) {
+  std::map<PdgCode, int> list = {{0x2212, 79}, {0x2112, 118}};
+  const int Ntest = 20;
+  std::vector<Particles> ensembles(2);
+  for (Particles &particles : ensembles) {
+    Nucleus Au(list, Ntest);
+    Au.set_parameters_automatic();
+    Au.arrange_nucleons();
+    Au.generate_fermi_momenta();
+    Au.copy_particles(&particles);
+  }
+  ExperimentParameters param = smash::Test::default_parameters(Ntest);
+  param.n_ensembles = 2;
+  PauliBlocker all_particles(get_pauli_blocking_conf(), param);
+  PauliBlocker indexed(get_pauli_blocking_conf(), param);
+  const double max_displacement = 1.0;
+  indexed.update_index(ensembles, max_displacement);
+
+  const PdgCode proton = 0x2212;
+  const ParticleList disregard = {*ensembles[0].begin()};
+  auto compare_densities = [&]() {
+    for (int i = -10; i <= 10; i++) {
+      const ThreeVector r(0.7 * i, 0.3 * i, -0.5 * i);
+      for (int j = 0; j < 10; j++) {
+        const ThreeVector p(0.0, 0.01 * j, 0.02 * j);
+        for (const PdgCode pdg : {proton, PdgCode(0x2112)}) {
+          COMPARE(indexed.phasespace_dens(r, p, ensembles, pdg, disregard),
+                  all_particles.phasespace_dens(r, p, ensembles, pdg,
+                                                disregard));
+        }
+      }
+    }
+  };
+  compare_densities();
+
+  // Particles may move up to the given displacement
+  for (Particles &particles : ensembles) {
+    for (ParticleData &part : particles) {
+      const FourVector v = part.momentum() / part.momentum().x0();
+      part.set_4position(part.position() + v * max_displacement);
+    }
+  }
+  compare_densities();
+
+  // Particles changed by actions are found through the update of the index
+  Particles &particles = ensembles[1];
+  ParticleList removed = {*particles.begin()};
+  ParticleList replaced = {*(++particles.begin())};
+  ParticleData moved = *(++(++particles.begin()));
+  moved.set_4position(FourVector(0., 0.1, 0.2, 0.3));
+  ParticleList added = {ParticleData{ParticleType::find(proton)},
+                        ParticleData{ParticleType::find(proton)}};
+  added[0].set_4position(FourVector(0., 0.5, 0., 0.));
+  added[1].set_4position(FourVector(0., -6.0, 0., 0.));
+  added[1].set_4momentum(0.938, 0.0, 0.0, 0.01);
+  particles.replace(removed, added);
+  particles.remove(replaced[0]);
+  const ParticleList updated = {
+      particles.update_particle(particles.lookup(moved), moved)};
+  indexed.add_to_index(added, 1);
+  indexed.add_to_index(updated, 1);
+  compare_densities();
+
+  // Without index all particles are visited again
+  indexed.clear_index();
+  particles.insert(added[0]);
+  compare_densities();
+}
+
+static Configuration get_occupancy_lattice_conf() {
+  Configuration conf = get_pauli_blocking_conf();
+  conf.set_value(InputKeys::collTerm_pauliBlocking_occupancyLattice, true);
+  return conf;
+}
+
+/* Fills a sphere of nuclear matter, where the phase-space density of the
+   protons is 1 within their Fermi sphere. */
+static void fill_proton_sphere(Particles &particles, int ntest) {
+  const double radius = 7.0, proton_density = 0.08;
+  const double p_fermi =
+      std::cbrt(3 * M_PI * M_PI * proton_density) * hbarc;
+  const int n = proton_density * 4. / 3. * M_PI * std::pow(radius, 3) * ntest;
+  for (int i = 0; i < n; i++) {
+    ThreeVector r, p;
+    do {
+      r = ThreeVector(random::uniform(-radius, radius),
+                      random::uniform(-radius, radius),
+                      random::uniform(-radius, radius));
+    } while (r.abs() > radius);
+    do {
+      p = ThreeVector(random::uniform(-p_fermi, p_fermi),
+                      random::uniform(-p_fermi, p_fermi),
+                      random::uniform(-p_fermi, p_fermi));
+    } while (p.abs() > p_fermi);
+    ParticleData proton{ParticleType::find(0x2212)};
+    proton.set_4position(FourVector(0., r));
+    proton.set_4momentum(nucleon_mass, p);
+    particles.insert(proton);
+  }
+}
+
+TEST(occupancy_lattice_approximates_phase_space_density) {
+  const int Ntest = 40;
+  std::vector<Particles> ensembles(2);
+  for (Particles &particles : ensembles) {
+    fill_proton_sphere(particles, Ntest);
+  }
+  ExperimentParameters param = smash::Test::default_parameters(Ntest);
+  param.n_ensembles = 2;
+  PauliBlocker all_particles(get_pauli_blocking_conf(), param);
+  PauliBlocker lattice(get_occupancy_lattice_conf(), param);
+  lattice.update_index(ensembles, 1.0);
+
+  // Both estimates fluctuate, hence they are averaged inside of the sphere
+  const PdgCode proton = 0x2212;
+  const ParticleList disregard;
+  double f_all = 0.0, f_lattice = 0.0;
+  for (int ix = -2; ix <= 2; ix++) {
+    for (int iy = -2; iy <= 2; iy++) {
+      for (int iz = -2; iz <= 2; iz++) {
+        const ThreeVector r(1.3 * ix, 1.3 * iy, 1.3 * iz);
+        for (int j = 0; j < 10; j++) {
+          const ThreeVector p(0.017 * j * (j % 3 - 1), 0.011 * j, -0.013 * j);
+          f_all += all_particles.phasespace_dens(r, p, ensembles, proton,
+                                                 disregard);
+          f_lattice +=
+              lattice.phasespace_dens(r, p, ensembles, proton, disregard);
+        }
+      }
+    }
+  }
+  COMPARE_RELATIVE_ERROR(f_lattice, f_all, 0.1);
+  // Outside of the sphere and for other species nothing is found
+  COMPARE(lattice.phasespace_dens(ThreeVector(20., 0., 0.), ThreeVector(),
+                                  ensembles, proton, disregard),
+          0.0);
+  COMPARE(lattice.phasespace_dens(ThreeVector(), ThreeVector(), ensembles,
+                                  0x2112, disregard),
+          0.0);
+
+  // Without lattice all particles are visited again
+  lattice.clear_index();
+  const ThreeVector r(0.5, 0.2, 0.1), p(0.0, 0.05, 0.0);
+  COMPARE(lattice.phasespace_dens(r, p, ensembles, proton, disregard),
+          all_particles.phasespace_dens(r, p, ensembles, proton, disregard));
+}
+
+TEST(occupancy_lattice_disregards_particles) {
+  ExperimentParameters param = smash::Test::default_parameters();
+  PauliBlocker lattice(get_occupancy_lattice_conf(), param);
+  std::vector<Particles> ensembles(1);
+  ParticleData proton{ParticleType::find(0x2212)};
+  proton.set_4position(FourVector(0., 0.3, -0.2, 1.1));
+  proton.set_4momentum(nucleon_mass, 0.01, 0.02, -0.03);
+  ensembles[0].insert(proton);
+  lattice.update_index(ensembles, 1.0);
+
+  const ParticleData &deposited = *ensembles[0].begin();
+  const ThreeVector r(0.4, -0.1, 0.9), p(0.0, 0.03, -0.02);
+  VERIFY(lattice.phasespace_dens(r, p, ensembles, 0x2212, {}) > 0.0);
+  COMPARE_ABSOLUTE_ERROR(
+      lattice.phasespace_dens(r, p, ensembles, 0x2212, {deposited}), 0.0,
+      1e-12);
+  // The particle is recognised after it moved
+  ParticleData moved = deposited;
+  moved.set_4position(FourVector(0.5, 0.8, 0.2, 1.0));
+  COMPARE_ABSOLUTE_ERROR(
+      lattice.phasespace_dens(r, p, ensembles, 0x2212, {moved}), 0.0, 1e-12);
+}
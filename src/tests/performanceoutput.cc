@@ -0,0 +1,69 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/performanceoutput.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "smash/bufferedoutput.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST(statistics_are_written_per_event) {
+  EventStatistics statistics;
+  statistics.wall_time = 0.5;
+  statistics.performed = {{ProcessType::Elastic, 12},
+                          {ProcessType::StringHard, 2}};
+  statistics.discarded = 3;
+  statistics.strings = 2;
+  statistics.string_time = 0.25;
+  statistics.mean_cell_occupancy = 1.5;
+  statistics.max_queued_actions = 40;
+  statistics.phases = {{"grid", 0.125, 10}, {"\"quoted\" phase", 0.0625, 1}};
+  {
+    PerformanceOutput output(testoutputpath, "Performance");
+    output.event_statistics_output(0, statistics);
+    // Concurrent events pass their statistics on through buffers
+    BufferedOutput buffer(output);
+    EventStatistics measured;
+    measured.memory = {{"particles", 64, 128}};
+    buffer.event_statistics_output(1, measured);
+    buffer.flush();
+  }
+  std::ifstream file(testoutputpath / "performance.jsonl");
+  std::string line;
+  std::getline(file, line);
+  COMPARE(line,
+          "{\"event\": 0, \"wall_time\": 0.5, \"performed\": {\"1\": 12, "
+          "\"46\": 2}, \"discarded\": 3, \"pauli_blocked\": 0, \"strings\": "
+          "{\"count\": 2, \"time\": 0.25}, \"mean_cell_occupancy\": 1.5, "
+          "\"max_queued_actions\": 40, \"phases\": {\"grid\": {\"time\": "
+          "0.125, \"calls\": 10}, \"\\\"quoted\\\" phase\": {\"time\": "
+          "0.0625, \"calls\": 1}}}");
+  std::getline(file, line);
+  COMPARE(line,
+          "{\"event\": 1, \"wall_time\": 0, \"performed\": {}, \"discarded\": "
+          "0, \"pauli_blocked\": 0, \"strings\": {\"count\": 0, \"time\": 0}, "
+          "\"mean_cell_occupancy\": 0, \"max_queued_actions\": 0, \"phases\": "
+          "{}, \"memory\": {\"particles\": {\"current\": 64, \"peak\": "
+          "128}}}");
+  VERIFY(!std::getline(file, line));
+}
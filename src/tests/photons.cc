@@ -10,11 +10,54 @@
 #include "setup.h"
 #include "smash/bremsstrahlungaction.h"
 #include "smash/crosssectionsphoton.h"
+#include "smash/outputinterface.h"
 #include "smash/scatteractionphoton.h"
 
 using namespace smash;
 using smash::Test::Momentum;
 
+namespace {
+/// A photon output remembering the weights and momenta of the final states.
+class PhotonCollector : public OutputInterface {
+ public:
+  PhotonCollector() : OutputInterface("Photons") {}
+  void at_interaction(const Action &action, const double) override {
+    weights.push_back(action.get_total_weight());
+    for (const ParticleData &p : action.outgoing_particles()) {
+      momenta.push_back(p.momentum());
+    }
+  }
+  std::vector<double> weights{};
+  std::vector<FourVector> momenta{};
+};
+
+/**
+ * Write the fractional photons of an action at once and compare them to the
+ * ones created one after the other with the same random numbers.
+ */
+template <typename A, typename Perform>
+void compare_fractional_photons(const ParticleList &in, int n_photons,
+                                Perform perform) {
+  OutputsList outputs;
+  outputs.push_back(std::make_unique<PhotonCollector>());
+  random::set_seed(3);
+  A at_once(in, 0.05, n_photons, 5.0);
+  at_once.add_single_process();
+  perform(at_once, outputs);
+  random::set_seed(3);
+  A one_by_one(in, 0.05, n_photons, 5.0);
+  one_by_one.add_single_process();
+  PhotonCollector expected;
+  for (int i = 0; i < n_photons; i++) {
+    one_by_one.generate_final_state();
+    expected.at_interaction(one_by_one, 0.0);
+  }
+  const auto &collected = static_cast<const PhotonCollector &>(*outputs[0]);
+  COMPARE(collected.weights, expected.weights);
+  COMPARE(collected.momenta, expected.momenta);
+}
+}  // namespace
+
 TEST(init_particle_types) {
   // enable debugging output
   create_all_loggers(Configuration(""));
@@ -73,6 +116,26 @@ TEST(binary_scatterings_pi_rho0_pi_gamma_Nfrac_1) {
   COMPARE_RELATIVE_ERROR(tot_weight2, 0.000722419008, 0.08);
 }
 
+TEST(fractional_photons_share_kinematics) {
+  const ParticleType &type_pi = ParticleType::find(0x211);
+  ParticleData pi{type_pi};
+  pi.set_4momentum(type_pi.mass(), ThreeVector(0.1, 0., 2.));
+  const ParticleType &type_rho0 = ParticleType::find(0x113);
+  ParticleData rho0{type_rho0};
+  rho0.set_4momentum(type_rho0.mass(), ThreeVector(0., 0.3, -2.));
+  ParticleData pim{ParticleType::find(-0x211)};
+  pim.set_4momentum(type_pi.mass(), ThreeVector(0., 0.3, -2.));
+  // The incoming pion is put first by the first photon
+  compare_fractional_photons<ScatterActionPhoton>(
+      {rho0, pi}, 5, [](ScatterActionPhoton &act, const OutputsList &outputs) {
+        act.perform_photons(outputs);
+      });
+  compare_fractional_photons<BremsstrahlungAction>(
+      {pi, pim}, 5, [](BremsstrahlungAction &act, const OutputsList &outputs) {
+        act.perform_bremsstrahlung(outputs);
+      });
+}
+
 TEST(binary_scatterings_photon_and_hadron_reaction_type_function) {
   /*
    *creates possible photon reactions and also some that
@@ -252,6 +315,43 @@ TEST(binary_scatterings_diff_cross_sections) {
   COMPARE_ABSOLUTE_ERROR(diff_cross4, 0.6907271, 1e-5);
 }
 
+TEST_CATCH(tabulated_cross_sections_accuracy, std::invalid_argument) {
+  CrosssectionsPhoton<ComputationMethod::Lookup>::create_tables(0.);
+}
+
+TEST(tabulated_cross_sections) {
+  using Analytic = CrosssectionsPhoton<ComputationMethod::Analytic>;
+  using Lookup = CrosssectionsPhoton<ComputationMethod::Lookup>;
+  Lookup::create_tables(0.01);
+  // The interpolation is accurate at the points, at which the analytic
+  // formulas are tested.
+  COMPARE_RELATIVE_ERROR(Lookup::xs_pi_pi_rho0(0.996, 0.776),
+                         Analytic::xs_pi_pi_rho0(0.996, 0.776), 1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_pi_pi0_rho(1.12, 0.9),
+                         Analytic::xs_pi_pi0_rho(1.12, 0.9), 1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_pi_rho0_pi(1.224, 0.776),
+                         Analytic::xs_pi_rho0_pi(1.224, 0.776), 1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_pi0_rho0_pi0(2.979, 0.776),
+                         Analytic::xs_pi0_rho0_pi0(2.979, 0.776), 1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_pi0_rho_pi(1.103, 0.776),
+                         Analytic::xs_pi0_rho_pi(1.103, 0.776), 1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_pi_rho_pi0(1.351, 0.9),
+                         Analytic::xs_pi_rho_pi0(1.351, 0.9), 1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_diff_pi_pi_rho0(1., -0.367612, 0.6),
+                         Analytic::xs_diff_pi_pi_rho0(1., -0.367612, 0.6),
+                         1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_diff_pi_pi0_rho(2., -0.5, 0.776),
+                         Analytic::xs_diff_pi_pi0_rho(2., -0.5, 0.776), 1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_diff_pi_rho0_pi(2., -0.5, 0.776),
+                         Analytic::xs_diff_pi_rho0_pi(2., -0.5, 0.776), 1e-2);
+  COMPARE_RELATIVE_ERROR(Lookup::xs_diff_pi0_rho0_pi0(1., -0.248786, 0.776),
+                         Analytic::xs_diff_pi0_rho0_pi0(1., -0.248786, 0.776),
+                         1e-2);
+  // Above the tables the analytic formulas are used.
+  COMPARE(Lookup::xs_pi_pi_rho0(12.25, 0.776),
+          Analytic::xs_pi_pi_rho0(12.25, 0.776));
+}
+
 ////
 // Test photon production in Bremsstrahlung processes
 ////
@@ -176,7 +176,7 @@ TEST(propagation_in_test_potential) {
         : Potentials(Configuration{""}, param), U0_(U0), d_(d), B0_(B0) {}
 
     std::tuple<ThreeVector, ThreeVector, ThreeVector, ThreeVector> all_forces(
-        const ThreeVector& r, const ParticleList&) const override {
+        const ThreeVector& r, const ParticlesView&) const override {
       const double tmp = std::exp(r.x1() / d_);
       return std::make_tuple(
           ThreeVector(U0_ / d_ * tmp / ((1.0 + tmp) * (1.0 + tmp)), 0.0, 0.0),
@@ -332,6 +332,47 @@ TEST(ensembles_vs_testparticles) {
   VERIFY(a == b) << a << " " << b;
 }
 
+TEST(concurrent_momentum_update_matches_serial) {
+  auto random_value = random::make_uniform_distribution(-2.0, +2.0);
+  const int n_ensembles = 3;
+  std::vector<Particles> serial(n_ensembles), concurrent(n_ensembles);
+  for (int i = 0; i < n_ensembles; i++) {
+    for (int id = 0; id < 20; id++) {
+      ParticleData p{ParticleType::find(0x2212)};
+      p.set_4position(
+          {random_value(), random_value(), random_value(), random_value()});
+      p.set_4momentum(smash::nucleon_mass,
+                      {random_value(), random_value(), random_value()});
+      serial[i].insert(p);
+    }
+    // Pions are not affected by the potentials
+    serial[i].insert(ParticleData{ParticleType::find(0x211)});
+    concurrent[i].copy_from(serial[i]);
+  }
+  Configuration conf{R"(
+    Potentials:
+      Skyrme:
+          Skyrme_A: -209.2
+          Skyrme_B: 156.4
+          Skyrme_Tau: 1.35
+  )"};
+  ExperimentParameters param = smash::Test::default_parameters();
+  param.n_ensembles = n_ensembles;
+  const Potentials pot(std::move(conf), param);
+  update_momenta(serial, 0.1, pot, nullptr, nullptr, nullptr, nullptr);
+  ThreadPool pool(4);
+  update_momenta(concurrent, 0.1, pot, nullptr, nullptr, nullptr, nullptr,
+                 &pool);
+  for (int i = 0; i < n_ensembles; i++) {
+    auto it = concurrent[i].begin();
+    for (const ParticleData &p : serial[i]) {
+      VERIFY(p.momentum() == it->momentum())
+          << p.momentum() << " " << it->momentum();
+      ++it;
+    }
+  }
+}
+
 /*
  * Compare the calculation of the energy gradient in the calculation frame using
  * single_particle_energy_gradient to the gradient of the Skyrme potential
@@ -455,6 +496,7 @@ static ExperimentParameters default_parameters_vdf(
       0.,     // low energy sigma_NN cut-off
       false,  // potential_affect_threshold
       -1.0,   // box_length
+      false,  // lazy wall crossings
       200.0,  // max. cross section
       2.5,    // fixed min. cell length
       1.0,    // cross section scaling
@@ -1055,3 +1097,72 @@ TEST(spinodal_dilute) {
       << "Mean-field energy did not increase enough. This means that spinodal "
          "decomposition has probably not happened";
 }
+
+TEST(tabulated_density_functions) {
+  const std::string conf_skyrme{R"(
+    Potentials:
+      Skyrme:
+          Skyrme_A: -209.2
+          Skyrme_B: 156.4
+          Skyrme_Tau: 1.35
+      Symmetry:
+          S_Pot: 18.0
+          gamma: 0.7
+  )"};
+  const std::string conf_vdf{R"(
+    Potentials:
+      VDF:
+        Sat_rhoB: 0.16
+        Powers: [2.0, 2.35, 3.1, 5.3]
+        Coeffs: [-209.2, 150.6, -10.3, 1.4]
+  )"};
+  const std::string tabulate{R"(
+      Tabulate_Density_Functions: true
+  )"};
+  ExperimentParameters param = Test::default_parameters();
+  const Potentials skyrme(Configuration{conf_skyrme.c_str()}, param),
+      skyrme_tab(Configuration{(conf_skyrme + tabulate).c_str()}, param),
+      vdf(Configuration{conf_vdf.c_str()}, param),
+      vdf_tab(Configuration{(conf_vdf + tabulate).c_str()}, param);
+  const ThreeVector a(0.1, -0.2, 0.3), b(-0.3, 0.1, 0.2), c(0.2, 0.3, -0.1);
+  auto compare_vectors = [](const ThreeVector &tab, const ThreeVector &exact,
+                            double tolerance) {
+    for (int i = 0; i < 3; i++) {
+      COMPARE_ABSOLUTE_ERROR(tab[i], exact[i], tolerance);
+    }
+  };
+  for (double x : {1e-3, 0.02, 0.3, 0.97, 1.0, 2.3, 4.5, 10.0}) {
+    // The interpolation error is relative to the powers of the density
+    const double tolerance = 1e-5 * (1. + x * x * x * x);
+    for (int sign : {1, -1}) {
+      const double rhoB = sign * x * nuclear_density;
+      COMPARE_ABSOLUTE_ERROR(skyrme_tab.skyrme_pot(rhoB),
+                             skyrme.skyrme_pot(rhoB), tolerance);
+      const auto F_skyrme_tab = skyrme_tab.skyrme_force(rhoB, a, b, c),
+                 F_skyrme = skyrme.skyrme_force(rhoB, a, b, c);
+      compare_vectors(F_skyrme_tab.first, F_skyrme.first, tolerance);
+      compare_vectors(F_skyrme_tab.second, F_skyrme.second, tolerance);
+      const FourVector jmuB(rhoB, 0.2 * rhoB, 0., -0.1 * rhoB);
+      const FourVector U_tab = vdf_tab.vdf_pot(rhoB, jmuB),
+                       U = vdf.vdf_pot(rhoB, jmuB);
+      for (int i = 0; i < 4; i++) {
+        COMPARE_ABSOLUTE_ERROR(U_tab[i], U[i], tolerance);
+      }
+      const auto F_vdf_tab =
+                     vdf_tab.vdf_force(rhoB, 0.1, a, b, rhoB, c, a, b, c),
+                 F_vdf = vdf.vdf_force(rhoB, 0.1, a, b, rhoB, c, a, b, c);
+      compare_vectors(F_vdf_tab.first, F_vdf.first, tolerance);
+      compare_vectors(F_vdf_tab.second, F_vdf.second, tolerance);
+    }
+    const double rhoB = x * nuclear_density, rhoI3 = -0.2 * rhoB;
+    COMPARE_ABSOLUTE_ERROR(skyrme_tab.symmetry_S(rhoB), skyrme.symmetry_S(rhoB),
+                           1e3 * tolerance);
+    COMPARE_ABSOLUTE_ERROR(skyrme_tab.symmetry_pot(rhoI3, rhoB),
+                           skyrme.symmetry_pot(rhoI3, rhoB), tolerance);
+    const auto F_sym_tab =
+                   skyrme_tab.symmetry_force(rhoI3, a, b, c, rhoB, c, b, a),
+               F_sym = skyrme.symmetry_force(rhoI3, a, b, c, rhoB, c, b, a);
+    compare_vectors(F_sym_tab.first, F_sym.first, tolerance);
+    compare_vectors(F_sym_tab.second, F_sym.second, tolerance);
+  }
+}
@@ -0,0 +1,138 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/profiler.h"
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "smash/threadpool.h"
+
+using namespace smash;
+
+TEST(sections_are_found_by_name) {
+  Profiler profiler(true);
+  const Profiler::Section a = profiler.section("a");
+  const Profiler::Section b = profiler.section("b");
+  VERIFY(a != b);
+  COMPARE(profiler.section("a"), a);
+  COMPARE(profiler.section("b"), b);
+}
+
+TEST(disabled_profiler_measures_nothing) {
+  Profiler profiler;
+  VERIFY(!profiler.enabled());
+  const Profiler::Section section = profiler.section("search");
+  profiler.start_event();
+  { const auto measured = profiler.measure(section); }
+  const std::string report = profiler.finish_event();
+  COMPARE(report.find("search"), std::string::npos) << report;
+}
+
+TEST(calls_are_counted) {
+  Profiler profiler(true);
+  const Profiler::Section search = profiler.section("search");
+  profiler.section("unused");
+  const Profiler::Section other = profiler.section("other");
+  profiler.start_event();
+  ThreadPool pool(4);
+  pool.parallel_for(100, [&](std::size_t) {
+    const auto measured = profiler.measure(search);
+  });
+  {
+    Profiler::Scope measured(profiler, search);
+    measured.reassign(other);
+  }
+  const std::string report = profiler.finish_event();
+  VERIFY(report.find("search") != std::string::npos) << report;
+  VERIFY(report.find(" 100 calls") != std::string::npos) << report;
+  VERIFY(report.find(" 1 calls") != std::string::npos) << report;
+  COMPARE(report.find("unused"), std::string::npos) << report;
+}
+
+TEST(totals_are_added) {
+  Profiler primary(true), worker(true);
+  const Profiler::Section search = primary.section("search");
+  worker.section("output");
+  const Profiler::Section worker_search = worker.section("search");
+  for (Profiler *profiler : {&primary, &worker}) {
+    profiler->start_event();
+    for (int i = 0; i < 3; i++) {
+      const auto measured = profiler->measure(
+          profiler == &primary ? search : worker_search);
+    }
+    profiler->finish_event();
+  }
+  primary.add_totals(worker);
+  const std::string report = primary.total_report();
+  VERIFY(report.find("Time profile of 2 events") != std::string::npos)
+      << report;
+  VERIFY(report.find(" 6 calls") != std::string::npos) << report;
+}
+
+TEST(totals_are_listed) {
+  Profiler profiler(true);
+  const Profiler::Section search = profiler.section("search");
+  profiler.section("unused");
+  profiler.start_event();
+  profiler.add(search, std::chrono::milliseconds(2));
+  profiler.add(search, std::chrono::milliseconds(3));
+  profiler.finish_event();
+  COMPARE(profiler.n_events(), 1);
+  const std::vector<Profiler::Total> totals = profiler.totals();
+  COMPARE(totals.size(), 1u);
+  COMPARE(totals[0].name, "search");
+  FUZZY_COMPARE(totals[0].seconds, 0.005);
+  COMPARE(totals[0].calls, 2);
+  VERIFY(profiler.total_wall_time() >= 0.);
+}
+
+TEST(hardware_counts_are_listed) {
+  Profiler profiler(false);
+  const bool counted = profiler.count_hardware_events();
+  VERIFY(profiler.enabled());
+  const Profiler::Section search = profiler.section("search");
+  profiler.start_event();
+  {
+    const auto measured = profiler.measure(search);
+    volatile double sum = 0.;
+    for (int i = 0; i < 100000; i++) {
+      sum = sum + i;
+    }
+  }
+  HardwareCounters::Counts counts{};
+  counts[HardwareCounters::Instructions] = 1000;
+  profiler.add_counts(search, counts);
+  profiler.finish_event();
+  const std::vector<Profiler::Total> totals = profiler.totals();
+  COMPARE(totals.size(), 1u);
+  if (!counted) {
+    // Without access to the counters only the times are measured
+    VERIFY(totals[0].counts.empty());
+    return;
+  }
+  const std::array<bool, HardwareCounters::NEvents> available =
+      HardwareCounters::available();
+  std::size_t n_available = 0;
+  for (bool event : available) {
+    n_available += event;
+  }
+  COMPARE(totals[0].counts.size(), n_available);
+  for (const auto &[event, count] : totals[0].counts) {
+    VERIFY(count >= 0) << event;
+    if (event == "instructions") {
+      // The loop retires more than the added instructions
+      VERIFY(count > 100000) << count;
+    }
+  }
+}
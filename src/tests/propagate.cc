@@ -76,6 +76,71 @@ TEST(propagate_default_no_potentials) {
           FourVector(1.0, 0.2 - 0.3 / 0.51, 0.0, 4.8 + 0.4 / 0.51));
 }
 
+TEST(propagate_single_particles) {
+  auto Pdef = create_box_particles();
+  auto Psingle = create_box_particles();
+  propagate_straight_line(Pdef.get(), 1.0, {});
+  // Propagate the particles separately in different steps
+  int n_steps = 1;
+  for (ParticleData &data : *Psingle) {
+    for (int step = 1; step <= n_steps; step++) {
+      const double to_time = static_cast<double>(step) / n_steps;
+      const double t0 = data.position().x0();
+      COMPARE(propagate_straight_line(&data, to_time, {}), to_time - t0);
+    }
+    n_steps++;
+  }
+  auto it = Psingle->begin();
+  for (const ParticleData &data : *Pdef) {
+    COMPARE(it->position().x0(), 1.0);
+    COMPARE_ABSOLUTE_ERROR(it->position().threevec().x1(),
+                           data.position().threevec().x1(), 1e-14);
+    COMPARE_ABSOLUTE_ERROR(it->position().threevec().x2(),
+                           data.position().threevec().x2(), 1e-14);
+    COMPARE_ABSOLUTE_ERROR(it->position().threevec().x3(),
+                           data.position().threevec().x3(), 1e-14);
+    COMPARE(it->momentum(), data.momentum());
+    ++it;
+  }
+}
+
+TEST(propagate_frozen_fermi_motion) {
+  auto P = create_box_particles();
+  // The first two particles move with the beam momentum
+  const std::vector<FourVector> beam_momentum{FourVector(2.0, 0.0, 0.0, 1.0),
+                                              FourVector(5.0, 3.0, 0.0, 0.0)};
+  propagate_straight_line(P.get(), 1.0, beam_momentum);
+  auto it = P->begin();
+  COMPARE(it->position(), FourVector(1.0, 0.6, 0.7, 0.8 + 0.5));
+  ++it;
+  COMPARE(it->position(), FourVector(1.0, 0.7 + 0.6, 0.8, 0.9));
+  ++it;
+  COMPARE(it->position(),
+          FourVector(1., 0.1 + 0.1 / std::sqrt(1.14),
+                     0.2 + 0.2 / std::sqrt(1.14), 0.3 - 0.3 / std::sqrt(1.14)));
+}
+
+TEST(backpropagate_many_particles) {
+  // More particles than are propagated at once
+  int n_created = 0;
+  auto P = Test::create_particles(1000, [&n_created]() {
+    const int i = n_created++;
+    return Test::smashon(Position{1.0 + 0.001 * i, 0.01 * i, 0.0, 0.0},
+                         Momentum{2.0, 1.0, 0.0, 0.0});
+  });
+  backpropagate_straight_line(P.get(), 0.5);
+  int i = 0;
+  for (const ParticleData &data : *P) {
+    const double t = 1.0 + 0.001 * i;
+    COMPARE(data.position().x0(), 0.5);
+    COMPARE_ABSOLUTE_ERROR(data.position().x1(), 0.01 * i - 0.5 * (t - 0.5),
+                           1e-14);
+    COMPARE(data.formation_time(), t);
+    COMPARE(data.xsec_scaling_factor(), 0.0);
+    i++;
+  }
+}
+
 TEST(hubble) {
   // setting up some exeplary metrics with simple b_ for
   // easy analytic values. All ExpansionModes are tested.
@@ -92,6 +92,20 @@ TEST(difference) {
   COMPARE(diff, A - H);
 }
 
+TEST(add_difference) {
+  FourVector P(1, 2, 3, 4);
+  FourVector Q(2, 3, 4, 4);
+  QuantumNumbers A(P, 5, 6, 7, 8, 9, 0);
+  QuantumNumbers H(Q, 5, 6, 1, -8, 12358, -15);
+  QuantumNumbers sum = A;
+  sum += H - A;
+  COMPARE(sum, H);
+  QuantumNumbers total;
+  total += A;
+  total += H;
+  COMPARE(total, QuantumNumbers(P + Q, 10, 12, 8, 0, 12367, -15));
+}
+
 TEST(report_deviations) {
   FourVector P(1, 2, 3, 4);
   FourVector Q(2, 3, 4, 4);
@@ -185,3 +185,28 @@ TEST(sample_fermi_distribution) {
       },
       "quantum_sampling.dat");
 }
+
+TEST(sample_tabulated_fermi_distribution) {
+  PdgCode proton(0x2212);
+  const int number_of_protons = 50;
+  std::map<PdgCode, int> init_mult = {{proton, number_of_protons}};
+  const double V = 50.0,  // fm^3
+      T = 0.01;           // GeV
+  ChemicalPotentialSolver mu_solver;
+  QuantumSampling sampler(init_mult, V, T, true);
+
+  const double dmomentum = 0.01;  // GeV
+  Histogram1d hist(dmomentum);
+  constexpr int N_TEST = 1E6;  // number of samples
+  hist.populate(N_TEST, [&]() { return sampler.sample(proton); });
+  const double g = proton.spin_degeneracy(),
+               m = ParticleType::find(proton).mass(),
+               n = number_of_protons / V * hbarc * hbarc * hbarc, stat = 1.0,
+               mu = mu_solver.effective_chemical_potential(g, m, n, T, stat,
+                                                           1.e-6);
+  hist.test(
+      [&](double p) {
+        return p * p / (std::exp((std::sqrt(p * p + m * m) - mu) / T) + 1.0);
+      },
+      "quantum_sampling_tabulated.dat");
+}
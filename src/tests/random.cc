@@ -24,6 +24,45 @@ TEST(set_random_seed) {
   std::printf("random number seed: %" PRId64 "\n", seed);
 }
 
+TEST(streams_are_reproducible) {
+  random::Engine first =
+      random::make_stream(42, random::StreamKind::Ensemble, 3);
+  random::Engine second =
+      random::make_stream(42, random::StreamKind::Ensemble, 3);
+  for (int i = 0; i < 100; i++) {
+    COMPARE(first(), second());
+  }
+}
+
+TEST(streams_are_distinct) {
+  const auto first_value = [](uint64_t seed, random::StreamKind kind,
+                              uint64_t index) {
+    return random::make_stream(seed, kind, index)();
+  };
+  const auto reference = first_value(42, random::StreamKind::Ensemble, 0);
+  VERIFY(first_value(43, random::StreamKind::Ensemble, 0) != reference);
+  VERIFY(first_value(42, random::StreamKind::GridRow, 0) != reference);
+  VERIFY(first_value(42, random::StreamKind::Ensemble, 1) != reference);
+  // Also the upper 32 bits of the index are used
+  VERIFY(first_value(42, random::StreamKind::Ensemble, uint64_t(1) << 32) !=
+         reference);
+}
+
+TEST(scoped_engine) {
+  random::set_seed(1);
+  const random::Engine::result_type expected_outside = random::Engine(1)();
+  random::Engine stream =
+      random::make_stream(1, random::StreamKind::GridRow, 0);
+  random::Engine copy = stream;
+  {
+    const random::ScopedEngine scoped(stream);
+    COMPARE(random::advance(), copy());
+  }
+  // The thread's engine is restored and the stream has advanced
+  COMPARE(random::advance(), expected_outside);
+  COMPARE(stream(), copy());
+}
+
 int tst_cnt = 0;  // test_counter
 
 // set this to true, in order to generate output files for debugging
@@ -53,6 +92,26 @@ void test_distribution(int n_test, double dx, Chi get_chi,
 
 constexpr int N_TEST = 1E7;  // number of samples
 
+TEST(alias_dist) {
+  const std::vector<double> weights = {1., 0., 3., 6.};
+  const random::alias_dist dist(weights);
+  COMPARE(dist.size(), 4u);
+  constexpr int n_samples = 1000000;
+  std::vector<int> counts(weights.size(), 0);
+  for (int i = 0; i < n_samples; i++) {
+    counts[dist()]++;
+  }
+  COMPARE(counts[1], 0);
+  for (std::size_t i : {0, 2, 3}) {
+    COMPARE_RELATIVE_ERROR(static_cast<double>(counts[i]) / n_samples,
+                           weights[i] / 10., 1.e-2);
+  }
+}
+
+TEST_CATCH(alias_dist_without_weight, std::invalid_argument) {
+  random::alias_dist({0., 0.});
+}
+
 TEST(canonical) {
   test_distribution(
       N_TEST, 0.0001, []() { return random::canonical(); },
@@ -12,13 +12,16 @@
 #include "smash/scatteraction.h"
 
 #include <algorithm>
+#include <stdexcept>
 
 #include "Pythia8/Pythia.h"
 
 #include "setup.h"
 #include "smash/angles.h"
+#include "smash/crosssections.h"
 #include "smash/random.h"
 #include "smash/scatteractionmulti.h"
+#include "smash/scatteractionsfinder.h"
 
 using namespace smash;
 using smash::Test::Momentum;
@@ -531,6 +534,42 @@ TEST_CATCH(add_branches_only_once, std::logic_error) {
   act_bottomup->add_all_scatterings(finder_parameters_bottomup);
 }
 
+TEST_CATCH(add_branches_later_bottomup, std::logic_error) {
+  ParticleData particle{ParticleType::find(0x111)};  // pi0
+  ScatterActionPtr act_bottomup = std::make_unique<ScatterAction>(
+      particle, particle, 0.1, false, 1.0, -1.0, false);
+  const auto finder_parameters_bottomup = Test::default_finder_parameters();
+  act_bottomup->add_all_scatterings_when_needed(finder_parameters_bottomup);
+}
+
+TEST(branches_added_when_needed) {
+  ParticleData p1{ParticleType::find(0x2212)}, p2{ParticleType::find(0x2212)};
+  p1.set_4position(pos_a);
+  p2.set_4position(pos_b);
+  p1.set_4momentum(p1.pole_mass(), 1.2, 0., 0.);
+  p2.set_4momentum(p2.pole_mass(), -1.2, 0., 0.);
+  const auto finder_parameters_topdown = Test::default_finder_parameters(
+      -1., NNbarTreatment::NoAnnihilation, Test::all_reactions_included(),
+      false, false, true, TotalCrossSectionStrategy::TopDown);
+  ScatterAction now(p1, p2, 0.1, false, 1.0, -1.0, true),
+      later(p1, p2, 0.1, false, 1.0, -1.0, true);
+  now.set_parametrized_total_cross_section(finder_parameters_topdown);
+  later.set_parametrized_total_cross_section(finder_parameters_topdown);
+  now.add_all_scatterings(finder_parameters_topdown);
+  later.add_all_scatterings_when_needed(finder_parameters_topdown);
+  // The total cross section is known before the branches are added
+  COMPARE(later.cross_section(), now.cross_section());
+  const CollisionBranchList &now_channels = now.collision_channels();
+  const CollisionBranchList &later_channels = later.collision_channels();
+  COMPARE(later_channels.size(), now_channels.size());
+  for (std::size_t i = 0; i < now_channels.size(); i++) {
+    COMPARE(later_channels[i]->weight(), now_channels[i]->weight());
+    VERIFY(later_channels[i]->get_type() == now_channels[i]->get_type());
+  }
+  // The branches are only added once
+  COMPARE(later.collision_channels().size(), now_channels.size());
+}
+
 TEST(top_down_sum_matches_parametrization) {
   const auto& all_types = ParticleType::list_all();
   int ntypes = all_types.size();
@@ -581,3 +620,175 @@ TEST(top_down_sum_matches_parametrization) {
     }
   }
 }
+
+TEST(stochastic_collisions_with_cross_section_cache) {
+  // Positive pions only scatter elastically, with the given cross section
+  const ParticleType &type_pip = ParticleType::find(0x211);
+  ParticleList search_list;
+  for (int i = 0; i < 6; i++) {
+    ParticleData pion{type_pip, i};
+    pion.set_4position(Position{0., 1., 0.1 * i, 1.});
+    pion.set_4momentum(type_pip.mass(), 0.1 * i, 0.3 - 0.1 * i, 0.);
+    search_list.push_back(pion);
+  }
+  const double grid_cell_vol = 2.0;
+  const double dt = 0.1;
+  ExperimentParameters exp_par =
+      Test::default_parameters(1, dt, CollisionCriterion::Stochastic);
+  Configuration direct_config{R"(
+    Collision_Term:
+      Elastic_Cross_Section: 10.0
+  )"};
+  ScatterActionsFinder direct_finder(direct_config, exp_par);
+  Configuration cache_config{R"(
+    Collision_Term:
+      Elastic_Cross_Section: 10.0
+      Cross_Section_Cache: True
+  )"};
+  ScatterActionsFinder cache_finder(cache_config, exp_par);
+
+  /* The constant cross section is always within the tolerance of the cache,
+   * such that the same collisions are found with the same random numbers,
+   * although most pairs are rejected without constructing their actions. */
+  constexpr int N_samples = 10000;
+  std::vector<int> direct_ids, cache_ids;
+  for (auto [finder, ids] : {std::pair{&direct_finder, &direct_ids},
+                             std::pair{&cache_finder, &cache_ids}}) {
+    random::set_seed(42);
+    for (int i = 0; i < N_samples; i++) {
+      for (const ActionPtr &action :
+           finder->find_actions_in_cell(search_list, dt, grid_cell_vol, {})) {
+        ids->push_back(i);
+        ids->push_back(action->incoming_particles()[0].id());
+        ids->push_back(action->incoming_particles()[1].id());
+      }
+    }
+  }
+  VERIFY(direct_ids.size() > 0u);
+  COMPARE(cache_ids, direct_ids);
+}
+
+TEST(stochastic_collisions_with_thinning) {
+  const ParticleType &type_pip = ParticleType::find(0x211);
+  ParticleList search_list;
+  for (int i = 0; i < 12; i++) {
+    ParticleData pion{type_pip, i};
+    pion.set_4position(Position{0., 1., 0.1 * i, 1.});
+    pion.set_4momentum(type_pip.mass(), 0.05 * i, 0.3 - 0.05 * i, 0.02 * i);
+    search_list.push_back(pion);
+  }
+  const double grid_cell_vol = 2.0;
+  const double dt = 0.1;
+  const double elastic_parameter = 10.0;  // in mb
+  ExperimentParameters exp_par =
+      Test::default_parameters(1, dt, CollisionCriterion::Stochastic);
+  Configuration config{R"(
+    Collision_Term:
+      Elastic_Cross_Section: 10.0
+      Cross_Section_Cache: True
+      Stochastic_Thinning: True
+  )"};
+  ScatterActionsFinder finder(config, exp_par);
+
+  // The expected number of collisions is the sum of the probabilities
+  double expected = 0.;
+  for (std::size_t a = 0; a < search_list.size(); a++) {
+    for (std::size_t b = a + 1; b < search_list.size(); b++) {
+      const FourVector &p_a = search_list[a].momentum();
+      const FourVector &p_b = search_list[b].momentum();
+      const double m_sqr = type_pip.mass() * type_pip.mass();
+      const double lamb = Action::lambda_tilde((p_a + p_b).sqr(), m_sqr, m_sqr);
+      const double v_rel = std::sqrt(lamb) / (2. * p_a.x0() * p_b.x0());
+      expected += elastic_parameter * fm2_mb * v_rel * dt / grid_cell_vol;
+    }
+  }
+  constexpr int N_samples = 100000;
+  int found_actions = 0;
+  for (int i = 0; i < N_samples; i++) {
+    found_actions +=
+        finder.find_actions_in_cell(search_list, dt, grid_cell_vol, {}).size();
+  }
+  COMPARE_RELATIVE_ERROR(
+      static_cast<double>(found_actions) / static_cast<double>(N_samples),
+      expected, 0.03);
+}
+
+TEST_CATCH(stochastic_thinning_needs_cache, std::invalid_argument) {
+  ExperimentParameters exp_par =
+      Test::default_parameters(1, 0.1, CollisionCriterion::Stochastic);
+  Configuration config{R"(
+    Collision_Term:
+      Stochastic_Thinning: True
+  )"};
+  ScatterActionsFinder finder(config, exp_par);
+}
+
+TEST(tabulated_interaction_profiles) {
+  const auto &all_types = ParticleType::list_all();
+  const int ntypes = all_types.size();
+  const ScatterActionsFinderParameters finder_params =
+      Test::default_finder_parameters(-10., NNbarTreatment::Resonances,
+                                      Test::all_reactions_included(), false);
+  random::set_seed(random::generate_63bit_seed());
+  for (int i = 0; i < 42; i++) {
+    ParticleData p1{all_types[random::uniform_int(0, ntypes - 1)]};
+    ParticleData p2{all_types[random::uniform_int(0, ntypes - 1)]};
+    p1.set_4position(pos_a);
+    p2.set_4position(pos_b);
+    p1.set_4momentum(p1.pole_mass(), 3., 0., 0.);
+    p2.set_4momentum(p2.pole_mass(), -3., 0., 0.);
+    const ParticleList incoming{p1, p2};
+    const double sqrt_s = (p1.momentum() + p2.momentum()).abs();
+
+    const auto weights = [&]() {
+      std::vector<double> w;
+      const CrossSections xs(incoming, sqrt_s, {});
+      for (const CollisionBranchPtr &branch :
+           xs.generate_collision_list(finder_params, nullptr)) {
+        w.push_back(branch->weight());
+      }
+      return w;
+    };
+    // The same processes are found with and without the table
+    CrossSections::clear_interaction_profiles();
+    const std::vector<double> computed = weights();
+    CrossSections::create_interaction_profiles();
+    COMPARE(weights(), computed)
+        << "Colliding " << p1.pdgcode() << " with " << p2.pdgcode();
+  }
+  CrossSections::clear_interaction_profiles();
+}
+
+TEST(batch_cross_sections_match_single_ones) {
+  const auto &all_types = ParticleType::list_all();
+  const int ntypes = all_types.size();
+  const ScatterActionsFinderParameters finder_params =
+      Test::default_finder_parameters(-10., NNbarTreatment::Resonances,
+                                      Test::all_reactions_included(), false);
+  random::set_seed(random::generate_63bit_seed());
+  for (int i = 0; i < 42; i++) {
+    const ParticleType &type_a = all_types[random::uniform_int(0, ntypes - 1)];
+    const ParticleType &type_b = all_types[random::uniform_int(0, ntypes - 1)];
+    ParticleData p1{type_a}, p2{type_b};
+    p1.set_4momentum(type_a.mass(), 0., 0., 0.);
+    p2.set_4momentum(type_b.mass(), 0., 0., 0.);
+    const ParticleList incoming{p1, p2};
+    std::vector<double> sqrts;
+    for (const double above_threshold : {0.01, 0.3, 1., 3., 20.}) {
+      sqrts.push_back(type_a.mass() + type_b.mass() + above_threshold);
+    }
+    const std::vector<double> total =
+        CrossSections::parametrized_total(type_a, type_b, sqrts, finder_params);
+    const std::vector<double> elastic =
+        CrossSections::elastic(type_a, type_b, sqrts, finder_params);
+    COMPARE(total.size(), sqrts.size());
+    COMPARE(elastic.size(), sqrts.size());
+    for (std::size_t k = 0; k < sqrts.size(); k++) {
+      const CrossSections xs(incoming, sqrts[k], {});
+      COMPARE(total[k], xs.parametrized_total(finder_params))
+          << type_a.name() << " + " << type_b.name() << " at " << sqrts[k];
+      COMPARE(elastic[k], xs.elastic(finder_params)->weight())
+          << type_a.name() << " + " << type_b.name() << " at " << sqrts[k];
+    }
+  }
+}
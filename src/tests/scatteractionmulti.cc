@@ -141,6 +141,35 @@ TEST(deuteron_three_to_two) {
          ProcessType::MultiParticleThreeToTwo);
 }
 
+TEST(no_three_body_reactions_without_pions_or_nucleons) {
+  /* The multi-particle search in cells only combines pions, etas and
+   * (anti-)nucleons for the 3-body reactions, hence no reaction must be
+   * possible if any other particle is involved. */
+  Momentum some_momentum{1.1, 1.0, 0., 0.};
+  ParticleData pip{ParticleType::find(0x211)};  // pi+
+  pip.set_4momentum(some_momentum);
+  ParticleData pim{ParticleType::find(-0x211)};  // pi-
+  pim.set_4momentum(some_momentum);
+  ParticleData p{ParticleType::find(0x2212)};  // p
+  p.set_4momentum(some_momentum);
+  ParticleData n{ParticleType::find(0x2112)};  // n
+  n.set_4momentum(some_momentum);
+  ParticleData omega{ParticleType::find(0x223)};  // omega
+  omega.set_4momentum(some_momentum);
+  ParticleData lambda{ParticleType::find(0x3122)};  // Lambda
+  lambda.set_4momentum(some_momentum);
+
+  const MultiParticleReactionsBitSet incl_all_multi_set =
+      MultiParticleReactionsBitSet().set();
+  for (const ParticleList& incoming :
+       {ParticleList{pip, pim, omega}, ParticleList{omega, p, n},
+        ParticleList{pip, p, lambda}, ParticleList{lambda, p, n}}) {
+    ScatterActionMulti act(incoming, 0.05);
+    act.add_possible_reactions(0.1, 8.0, incl_all_multi_set);
+    COMPARE(act.reaction_channels().size(), 0u) << incoming;
+  }
+}
+
 TEST(threebody_integral_I3) {
   // Make sure incoming particles got their masses set
   // calculate_I3 uses effective mass , not type mass
@@ -165,6 +194,28 @@ TEST(threebody_integral_I3) {
   }
 }
 
+TEST(threebody_integral_I3_tabulated) {
+  ParticleData p{ParticleType::find(0x2212)};  // p
+  ParticleData n{ParticleType::find(0x2112)};  // n
+  ParticleData pip{ParticleType::find(0x211)};  // pi+
+  for (const ParticleList &incoming :
+       {ParticleList{pip, p, n}, ParticleList{p, n, pip},
+        ParticleList{pip, pip, pip}}) {
+    ScatterActionMulti act(incoming, 0.0);
+    double threshold = 0.;
+    for (const ParticleData &data : incoming) {
+      threshold += data.type().mass();
+    }
+    COMPARE(act.tabulated_I3(threshold - 0.1), 0.);
+    // Including energies close to the threshold and above the tabulation
+    for (double delta = 1e-3; delta < 12.; delta *= 1.1) {
+      COMPARE_RELATIVE_ERROR(act.tabulated_I3(threshold + delta),
+                             act.calculate_I3(threshold + delta), 1e-4)
+          << incoming << " at " << delta;
+    }
+  }
+}
+
 TEST(phi4_parametrization) {
   ParticleData N{ParticleType::find(0x2212)};   // p
   ParticleData pi{ParticleType::find(0x211)};   // pi+
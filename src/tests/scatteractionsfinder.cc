@@ -246,6 +246,47 @@ TEST(find_next_action) {
   FUZZY_COMPARE(action->time_of_execution(), collision_time);
 }
 
+TEST(find_next_action_through_lazy_wall) {
+  // let two particles collide head-on through the wall at x = 0
+  constexpr double box_length = 10.0;
+  constexpr double energy = 1.0;
+  constexpr double delta_x = 0.2;
+  constexpr double v = 0.5;
+  Particles particles;
+  particles.insert(Test::smashon(Test::Momentum{energy, energy * v, 0., 0.},
+                                 Test::Position{0., box_length - 0.1, 1., 1.}));
+  particles.insert(Test::smashon(Test::Momentum{energy, -energy * v, 0., 0.},
+                                 Test::Position{0., 0.1, 1., 1.}));
+
+  constexpr double radius = 0.11;  // in fm
+  constexpr double elastic_parameter =
+      radius * radius * M_PI / fm2_mb;  // in mb
+  ExperimentParameters exp_par = Test::default_parameters();
+  exp_par.box_length = box_length;
+  ParticleList particle_list = particles.copy_to_vector();
+  particle_list.pop_back();
+  {
+    // Without lazy wall crossings, the particles are a box length apart
+    Configuration config = create_configuration_for_tests(elastic_parameter);
+    ScatterActionsFinder finder(config, exp_par);
+    COMPARE(finder
+                .find_actions_with_surrounding_particles(particle_list,
+                                                         particles, 1., {})
+                .size(),
+            0u);
+  }
+  exp_par.lazy_wall_crossings = true;
+  Configuration config = create_configuration_for_tests(elastic_parameter);
+  ScatterActionsFinder finder(config, exp_par);
+  ActionList action_list = finder.find_actions_with_surrounding_particles(
+      particle_list, particles, 1., {});
+  COMPARE(action_list.size(), 1u);
+  FUZZY_COMPARE(action_list[0]->time_of_execution(), 0.5 * delta_x / v);
+  // The collision happens on the wall, between the periodic images
+  const FourVector interaction_point = action_list[0]->get_interaction_point();
+  COMPARE_ABSOLUTE_ERROR(interaction_point.x1(), box_length, 1e-12);
+}
+
 TEST(increasing_scaling_factors) {
   constexpr double energy = 1.;
   constexpr double v = 0.5;
@@ -276,14 +317,14 @@ TEST(increasing_scaling_factors) {
   ExperimentParameters exp_par = Test::default_parameters();
   ScatterActionsFinder finder(config, exp_par);
   COMPARE(finder
-              .find_actions_in_cell({p_a, p_b}, 2. * delta_t_coll,
+              .find_actions_in_cell(ParticleList{p_a, p_b}, 2. * delta_t_coll,
                                     grid_cell_vol, {})
               .size(),
           1u);
   // For a Power smaller than alpha, the particles should not collide.
   ParticleData::formation_power_ = alpha + 0.1;
   COMPARE(finder
-              .find_actions_in_cell({p_a, p_b}, 2. * delta_t_coll,
+              .find_actions_in_cell(ParticleList{p_a, p_b}, 2. * delta_t_coll,
                                     grid_cell_vol, {})
               .size(),
           0u);
@@ -341,3 +382,105 @@ TEST(check_stochastic_collision) {
   // compare probability to the probability of finding an action
   COMPARE_RELATIVE_ERROR(ratio_found, prob, 0.05);
 }
+
+TEST(geometric_collisions_preselected_by_time) {
+  // Many particles, some of them at rest and some with equal velocities
+  Particles p;
+  random::set_seed(7);
+  for (int i = 0; i < 200; i++) {
+    const double px = i % 10 == 0 ? 0. : random::uniform(-0.5, 0.5);
+    const double py = i % 20 == 1 ? 0.3 : random::uniform(-0.5, 0.5);
+    const double pz = i % 20 == 1 ? 0. : random::uniform(-0.5, 0.5);
+    p.insert(Test::smashon(
+        Test::Momentum{std::sqrt(0.123 * 0.123 + px * px + py * py + pz * pz),
+                       px, py, pz},
+        Test::Position{0., random::uniform(0., 3.), random::uniform(0., 3.),
+                       random::uniform(0., 3.)}));
+  }
+  const double elastic_parameter = 20.0;  // in mb
+  ExperimentParameters exp_par = Test::default_parameters();
+  Configuration config = create_configuration_for_tests(elastic_parameter);
+  ScatterActionsFinder finder(config, exp_par);
+  const ParticleList all = p.copy_to_vector();
+  const ParticleSpan cell(all.data(), 120);
+  const ParticleSpan neighbors(all.data() + 120, all.size() - 120);
+  const double dt = 0.3;
+  // The same pairs in the same order as checking the pairs one by one
+  auto incoming_ids = [](const ActionList &actions) {
+    std::vector<std::pair<int, int>> ids;
+    for (const ActionPtr &action : actions) {
+      ids.emplace_back(action->incoming_particles()[0].id(),
+                       action->incoming_particles()[1].id());
+    }
+    return ids;
+  };
+  /* A pair collides if it approaches within the time step and if the pair
+   * alone collides, where nothing can be missed by checking them together. */
+  auto check_pair = [&](const ParticleData &p1, const ParticleData &p2,
+                        ActionList &actions) {
+    const double time = finder.collision_time(p1, p2, dt, {});
+    if (time >= 0. && time < dt) {
+      for (ActionPtr &act :
+           finder.find_actions_in_cell(ParticleList{p1, p2}, dt, 0., {})) {
+        actions.push_back(std::move(act));
+      }
+    }
+  };
+  ActionList expected;
+  for (const ParticleData &p1 : cell) {
+    for (const ParticleData &p2 : cell) {
+      if (p1.id() < p2.id()) {
+        check_pair(p1, p2, expected);
+      }
+    }
+  }
+  VERIFY(!expected.empty());
+  COMPARE(incoming_ids(finder.find_actions_in_cell(cell, dt, 0., {})),
+          incoming_ids(expected));
+  expected.clear();
+  for (const ParticleData &p1 : cell) {
+    for (const ParticleData &p2 : neighbors) {
+      check_pair(p1, p2, expected);
+    }
+  }
+  VERIFY(!expected.empty());
+  COMPARE(incoming_ids(finder.find_actions_with_neighbors(cell, neighbors, dt,
+                                                          {})),
+          incoming_ids(expected));
+}
+
+TEST(spectators_of_one_nucleus_are_skipped) {
+  // Particles approaching each other, all of them untouched projectile nucleons
+  ParticleList cell;
+  random::set_seed(11);
+  for (int i = 0; i < 40; i++) {
+    const double px = random::uniform(-0.5, 0.5);
+    ParticleData data = Test::smashon(
+        Test::Momentum{std::sqrt(0.123 * 0.123 + px * px), px, 0., 0.},
+        Test::Position{0., random::uniform(0., 1.), random::uniform(0., 0.1),
+                       random::uniform(0., 0.1)});
+    data.set_id(i);
+    data.set_belongs_to(BelongsTo::Projectile);
+    cell.push_back(data);
+  }
+  const double elastic_parameter = 20.0;  // in mb
+  ExperimentParameters exp_par = Test::default_parameters();
+  Configuration config = create_configuration_for_tests(elastic_parameter);
+  ScatterActionsFinder finder(config, exp_par);
+  const double dt = 0.5;
+  COMPARE(finder.find_actions_in_cell(cell, dt, 0., {}).size(), 0u);
+  const ParticleSpan first(cell.data(), 20);
+  const ParticleSpan second(cell.data() + 20, 20);
+  COMPARE(finder.find_actions_with_neighbors(first, second, dt, {}).size(),
+          0u);
+  // Only pairs with one target nucleon collide
+  for (int i = 0; i < 40; i += 2) {
+    cell[i].set_belongs_to(BelongsTo::Target);
+  }
+  const ActionList actions = finder.find_actions_in_cell(cell, dt, 0., {});
+  VERIFY(!actions.empty());
+  for (const ActionPtr &action : actions) {
+    VERIFY(action->incoming_particles()[0].belongs_to() !=
+           action->incoming_particles()[1].belongs_to());
+  }
+}
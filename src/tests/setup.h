@@ -234,7 +234,8 @@ inline ExperimentParameters default_parameters(
     CollisionCriterion criterion = CollisionCriterion::Geometric,
     bool strings = false,
     NNbarTreatment nnbar_treatment = NNbarTreatment::NoAnnihilation,
-    ReactionsBitSet included_2to2 = all_reactions_included()) {
+    ReactionsBitSet included_2to2 = all_reactions_included(),
+    SmearingMode smearing = SmearingMode::CovariantGaussian) {
   return ExperimentParameters{
       std::make_unique<UniformClock>(0., dt, 300.0),  // labclock
       std::make_unique<UniformClock>(0., 1., 300.0),  // outputclock
@@ -243,7 +244,7 @@ inline ExperimentParameters default_parameters(
       DerivativesMode::CovariantGaussian,             // derivatives mode
       RestFrameDensityDerivativesMode::Off,  // rest frame derivatives mode
       FieldDerivativesMode::ChainRule,       // field derivatives mode
-      SmearingMode::CovariantGaussian,       // smearing mode
+      smearing,                              // smearing mode
       1.0,                                   // Gaussian smearing width
       4.0,                                   // Gaussian smearing cut-off
       0.333333,                              // discrete smearing weight
@@ -258,6 +259,7 @@ inline ExperimentParameters default_parameters(
       0.,     // low energy sigma_NN cut-off
       false,  // potential_affect_threshold
       -1.0,   // box_length
+      false,  // lazy wall crossings
       200.0,  // max. cross section
       2.5,    // fixed min. cell length
       1.0,    // cross section scaling
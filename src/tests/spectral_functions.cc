@@ -9,12 +9,15 @@
 
 #include "vir/test.h"  // This include has to be first
 
+#include <vector>
+
 #include "histogram.h"
 #include "setup.h"
 #include "smash/formfactors.h"
 #include "smash/integrate.h"
 #include "smash/kinematics.h"
 #include "smash/stringfunctions.h"
+#include "smash/threadpool.h"
 
 using namespace smash;
 
@@ -91,3 +94,48 @@ TEST(mass_sampling) {
     return res.spectral_function(m) * pcm * bw;
   });
 }
+
+TEST(concurrent_evaluation_matches_serial) {
+  std::vector<ParticleTypePtr> resonances;
+  for (const ParticleType &type : ParticleType::list_all()) {
+    if (!type.is_stable()) {
+      resonances.push_back(&type);
+    }
+  }
+  auto evaluate = [&](std::size_t i) {
+    const ParticleType &type = *resonances[i];
+    return type.spectral_function(type.mass() + 0.5 * type.width_at_pole());
+  };
+  std::vector<double> serial(resonances.size()), parallel(resonances.size());
+  for (std::size_t i = 0; i < resonances.size(); i++) {
+    serial[i] = evaluate(i);
+  }
+  ThreadPool pool(4);
+  pool.parallel_for(resonances.size(),
+                    [&](std::size_t i) { parallel[i] = evaluate(i); });
+  for (std::size_t i = 0; i < resonances.size(); i++) {
+    COMPARE(parallel[i], serial[i]) << resonances[i]->name();
+  }
+}
+
+TEST(normalization_follows_decay_modes) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "π       0.138   7.7e-9  -     111     211\n"
+      "ρ       0.776   0.149   -     113     213\n"
+      "e⁻      0.000511 0 + 11\n");
+  Integrator integrate;
+  const ParticleType &rho = ParticleType::find(0x113);
+  auto normalization = [&]() {
+    return integrate(0., 1., [&](double t) {
+      return rho.spectral_function(rho.min_mass_kinematic() + (1 - t) / t) /
+             (t * t);
+    });
+  };
+  for (const std::string decays :
+       {"ρ\n1. 1 π π\n", "ρ\n0.5 1 π π\n0.5 0 e⁻ e⁺\n"}) {
+    DecayModes::load_decaymodes(decays);
+    const auto result = normalization();
+    COMPARE_ABSOLUTE_ERROR(result.value(), 1., 5 * result.error()) << decays;
+  }
+}
@@ -0,0 +1,79 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/spectraoutput.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "setup.h"
+#include "smash/config.h"
+#include "smash/particles.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+static ParticleData smashon(double px, double py, double pz) {
+  return Test::smashon(Test::Momentum{
+      std::sqrt(Test::smashon_mass * Test::smashon_mass + px * px + py * py +
+                pz * pz),
+      px, py, pz});
+}
+
+TEST(histograms_are_filled) {
+  OutputParameters out_par;
+  out_par.spectra_parameters.pdg_codes = {PdgCode(0x661)};
+  out_par.spectra_parameters.rapidity_range = {{-1.0, 1.0}};
+  out_par.spectra_parameters.rapidity_bins = 2;
+  out_par.spectra_parameters.pt_range = {{0.0, 1.0}};
+  out_par.spectra_parameters.pt_bins = 2;
+  {
+    SpectraOutput output(testoutputpath, "Spectra", out_par);
+    Particles particles;
+    particles.insert(smashon(0.2, 0.0, 0.0));
+    particles.insert(smashon(0.0, 0.7, 0.0));
+    particles.insert(smashon(0.7, 0.0, 100.0));
+    output.at_eventend(particles, {0, 0}, Test::default_event_info());
+    output.at_eventend(particles, {1, 0}, Test::default_event_info());
+    COMPARE(output.number_of_blocks(), 2);
+    const SpectraOutput::Histograms &h = output.histograms(0);
+    COMPARE(h.dndy[0], 0.);
+    COMPARE(h.dndy[1], 4.);
+    COMPARE(h.dndpt[0], 2.);
+    COMPARE(h.dndpt[1], 2.);
+    COMPARE(h.cos_nphi[0][0], 2.);
+    FUZZY_COMPARE(h.cos_nphi[1][1], -2.);
+  }
+  std::ifstream file(testoutputpath / "spectra.dat");
+  std::string line;
+  std::getline(file, line);
+  COMPARE(line, "# " SMASH_VERSION " spectra output");
+  std::getline(file, line);
+  COMPARE(line, "# 2 events");
+}
+
+TEST_CATCH(no_bins, std::invalid_argument) {
+  OutputParameters out_par;
+  out_par.spectra_parameters.pt_bins = 0;
+  SpectraOutput output(testoutputpath, "Spectra", out_par);
+}
@@ -372,6 +372,20 @@ TEST(string_zlund) {
       [](double x) { return 1 / x * (1. - x) * exp(-1. / x); });
 }
 
+TEST(string_zlund_tabulated) {
+  StringProcess::set_tabulated_lund_z(true);
+  test_distribution(
+      1e7, 0.0001, []() { return StringProcess::sample_zLund(1, 1, 1); },
+      [](double x) { return 1 / x * (1. - x) * exp(-1. / x); });
+  // Leading baryons with a steep rise towards z = 1
+  test_distribution(
+      1e7, 0.0001, []() { return StringProcess::sample_zLund(0.2, 2., 1.3); },
+      [](double x) {
+        return 1 / x * std::pow(1. - x, 0.2) * exp(-2. * 1.3 * 1.3 / x);
+      });
+  StringProcess::set_tabulated_lund_z(false);
+}
+
 TEST(string_incoming_lightcone_momenta) {
   std::unique_ptr<StringProcess> sp = dummy_string_process();
 
@@ -757,3 +771,66 @@ TEST(string_scaling_factors) {
   COMPARE(outgoing[3].initial_xsec_scaling_factor(), coherence_factor / 3.);
   VERIFY(outgoing[3] == c);
 }
+
+TEST(checkout_hands_out_exclusive_instances) {
+  std::unique_ptr<StringProcess> sp = dummy_string_process();
+  const StringProcess *first = nullptr, *second = nullptr;
+  {
+    const StringProcess::Lease lease_a = sp->checkout();
+    const StringProcess::Lease lease_b = sp->checkout();
+    first = &*lease_a;
+    second = &*lease_b;
+    VERIFY(first == sp.get());
+    VERIFY(second != sp.get());
+    // The spare instance has the same parameters
+    const auto xs_a = lease_a->cross_sections_diffractive(2212, 2212, 10.);
+    const auto xs_b = lease_b->cross_sections_diffractive(2212, 2212, 10.);
+    for (int i = 0; i < 3; i++) {
+      COMPARE(xs_a[i], xs_b[i]);
+    }
+  }
+  // Returned instances are handed out again instead of creating new ones
+  const StringProcess::Lease lease_a = sp->checkout();
+  const StringProcess::Lease lease_b = sp->checkout();
+  VERIFY(&*lease_a == first);
+  VERIFY(&*lease_b == second);
+}
+
+TEST(preinitialize_hard_pythia) {
+  std::unique_ptr<StringProcess> sp = dummy_string_process();
+  // The Delta++ is mapped onto the proton, hence one PYTHIA object serves both
+  sp->preinitialize_hard_pythia({{PdgCode(pdg::p), PdgCode(pdg::Delta_pp)},
+                                 {PdgCode(pdg::p), PdgCode(pdg::pi_m)}},
+                                10.);
+  // The spare instance creates the objects as well
+  const StringProcess::Lease lease_a = sp->checkout();
+  const StringProcess::Lease lease_b = sp->checkout();
+  VERIFY(&*lease_b != sp.get());
+}
+
+TEST_CATCH(preinitialize_hard_pythia_photon, std::runtime_error) {
+  std::unique_ptr<StringProcess> sp = dummy_string_process();
+  sp->preinitialize_hard_pythia({{PdgCode(pdg::photon), PdgCode(pdg::p)}},
+                                10.);
+}
+
+TEST(tabulated_cross_sections_diffractive) {
+  std::unique_ptr<StringProcess> sp = dummy_string_process();
+  std::unique_ptr<StringProcess> direct = dummy_string_process();
+  sp->set_tabulate_diffractive(true);
+  for (const std::pair<int, int> &pair :
+       {std::pair<int, int>{2212, 2212}, std::pair<int, int>{2212, -211},
+        std::pair<int, int>{211, -2112}}) {
+    // Below the threshold, at the nodes, between them and above the table
+    for (const double sqrts : {1., 4., 4.0123, 17.5, 200., 5.e4}) {
+      const auto xs_tab = sp->shared_cross_sections_diffractive(
+          pair.first, pair.second, sqrts);
+      const auto xs =
+          direct->cross_sections_diffractive(pair.first, pair.second, sqrts);
+      for (int i = 0; i < 3; i++) {
+        COMPARE_RELATIVE_ERROR(xs_tab[i], xs[i], 1.e-4)
+            << pair.first << " " << pair.second << " at " << sqrts << " GeV";
+      }
+    }
+  }
+}
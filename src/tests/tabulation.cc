@@ -11,6 +11,10 @@
 
 #include "smash/tabulation.h"
 
+#include <filesystem>
+
+#include "smash/tabulationfile.h"
+
 using namespace smash;
 
 TEST(empty) {
@@ -89,3 +93,40 @@ TEST(quadratic) {
   // check extrapolated values
   COMPARE_ABSOLUTE_ERROR(tab.get_value_linear(3.), 7.8, error);
 }
+
+TEST(shared_file) {
+  const auto path = std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) /
+                    "tabulation" / "shared.bin";
+  std::filesystem::create_directories(path.parent_path());
+  sha256::Context context;
+  context.update("tabulations");
+  const sha256::Hash hash = context.finalize();
+  const Tabulation square(-2., 4., 20, [](double x) { return x * x; });
+  const Tabulation line(0., 10., 7, [](double x) { return x; });
+  TabulationFile::write(path, hash, {{"square", &square}, {"line", &line}});
+
+  Tabulation mapped;
+  {
+    const auto file = TabulationFile::open(path, hash);
+    VERIFY(file != nullptr);
+    COMPARE(file->size(), 2u);
+    VERIFY(file->find("missing").is_empty());
+    mapped = file->find("square");
+    const Tabulation mapped_line = file->find("line");
+    VERIFY(!mapped_line.is_empty());
+    COMPARE(mapped_line.get_value_linear(3.3), line.get_value_linear(3.3));
+  }
+  // The tabulation keeps the mapping alive.
+  VERIFY(!mapped.is_empty());
+  for (double x = -3.; x < 5.; x += 0.1) {
+    COMPARE(mapped.get_value_step(x), square.get_value_step(x));
+    COMPARE(mapped.get_value_linear(x), square.get_value_linear(x));
+  }
+
+  // A file of other particle properties is not used.
+  sha256::Hash other_hash = hash;
+  other_hash[0]++;
+  VERIFY(TabulationFile::open(path, other_hash) == nullptr);
+  VERIFY(TabulationFile::open(path.parent_path() / "missing.bin", hash) ==
+         nullptr);
+}
@@ -0,0 +1,87 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/taskgraph.h"
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace smash;
+
+TEST_CATCH(depend_on_later_task, std::invalid_argument) {
+  TaskGraph graph;
+  graph.add([]() {}, {0});
+}
+
+TEST(serial_in_order_of_adding) {
+  TaskGraph graph;
+  std::vector<int> order;
+  for (int i = 0; i < 5; i++) {
+    graph.add([&order, i]() { order.push_back(i); });
+  }
+  COMPARE(graph.size(), 5u);
+  graph.run(nullptr);
+  COMPARE(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(dependencies_are_completed_first) {
+  // Chains of three tasks, where the last one of each chain also waits for
+  // the first one of the previous chain
+  constexpr std::size_t n_chains = 50;
+  TaskGraph graph;
+  std::vector<std::atomic<int>> step(n_chains);
+  std::atomic<int> violations{0};
+  std::vector<TaskGraph::TaskId> first_of_chain;
+  for (std::size_t c = 0; c < n_chains; c++) {
+    const auto first = graph.add([&, c]() { step[c]++; });
+    const auto second = graph.add(
+        [&, c]() { violations += step[c].fetch_add(1) != 1; }, {first});
+    std::vector<TaskGraph::TaskId> dependencies{second};
+    if (c > 0) {
+      dependencies.push_back(first_of_chain[c - 1]);
+    }
+    graph.add(
+        [&, c]() {
+          violations += step[c].fetch_add(1) != 2;
+          violations += c > 0 && step[c - 1].load() == 0;
+        },
+        dependencies);
+    first_of_chain.push_back(first);
+  }
+  ThreadPool pool(4);
+  graph.run(&pool);
+  COMPARE(violations.load(), 0);
+  for (std::size_t c = 0; c < n_chains; c++) {
+    COMPARE(step[c].load(), 3) << "chain " << c;
+  }
+  // The graph can be run again
+  graph.run(&pool);
+  COMPARE(step[0].load(), 6);
+}
+
+TEST(exception_skips_the_remaining_tasks) {
+  TaskGraph graph;
+  std::atomic<int> counter{0};
+  const auto failing =
+      graph.add([]() { throw std::runtime_error("task failed"); });
+  graph.add([&]() { counter++; }, {failing});
+  ThreadPool pool(2);
+  bool caught = false;
+  try {
+    graph.run(&pool);
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+  VERIFY(caught);
+  COMPARE(counter.load(), 0);
+}
@@ -0,0 +1,107 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/threadpool.h"
+
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace smash;
+
+TEST_CATCH(no_threads, std::invalid_argument) { ThreadPool pool(0); }
+
+TEST(size) {
+  ThreadPool pool(3);
+  COMPARE(pool.size(), 3);
+}
+
+TEST(all_tasks_executed_once) {
+  ThreadPool pool(4);
+  constexpr std::size_t n = 1000;
+  std::vector<int> executed(n, 0);
+  pool.parallel_for(n, [&](std::size_t i) { executed[i]++; });
+  for (std::size_t i = 0; i < n; i++) {
+    COMPARE(executed[i], 1) << "task " << i;
+  }
+}
+
+TEST(pool_is_reusable) {
+  ThreadPool pool(2);
+  std::atomic<int> counter{0};
+  for (int batch = 0; batch < 50; batch++) {
+    pool.parallel_for(10, [&](std::size_t) { counter++; });
+    COMPARE(counter.load(), 10 * (batch + 1));
+  }
+  pool.parallel_for(0, [&](std::size_t) { counter++; });
+  COMPARE(counter.load(), 500);
+}
+
+TEST(per_index_results_are_reproducible) {
+  std::vector<double> serial(100), parallel(100);
+  auto task = [](std::size_t i) { return std::sqrt(static_cast<double>(i)); };
+  for (std::size_t i = 0; i < serial.size(); i++) {
+    serial[i] = task(i);
+  }
+  ThreadPool pool(5);
+  pool.parallel_for(parallel.size(),
+                    [&](std::size_t i) { parallel[i] = task(i); });
+  COMPARE(std::accumulate(parallel.begin(), parallel.end(), 0.),
+          std::accumulate(serial.begin(), serial.end(), 0.));
+}
+
+TEST(exception_is_propagated) {
+  ThreadPool pool(3);
+  std::atomic<int> counter{0};
+  bool caught = false;
+  try {
+    pool.parallel_for(20, [&](std::size_t i) {
+      counter++;
+      if (i == 7) {
+        throw std::runtime_error("task failed");
+      }
+    });
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+  VERIFY(caught);
+  // All tasks have been processed in spite of the failure
+  COMPARE(counter.load(), 20);
+  // and the pool can still be used afterwards
+  pool.parallel_for(5, [&](std::size_t) { counter++; });
+  COMPARE(counter.load(), 25);
+}
+
+TEST(pinned_workers_take_the_same_indices) {
+  ThreadPool pool(3, true);
+  VERIFY(pool.pinned());
+  constexpr std::size_t n = 10;
+  std::vector<std::thread::id> first(n), second(n);
+  pool.parallel_for(n, [&](std::size_t i) {
+    first[i] = std::this_thread::get_id();
+  });
+  pool.parallel_for(n, [&](std::size_t i) {
+    second[i] = std::this_thread::get_id();
+  });
+  for (std::size_t i = 0; i < n; i++) {
+    COMPARE(second[i], first[i]) << "task " << i;
+    COMPARE(first[i], first[i % 3]) << "task " << i;
+  }
+  VERIFY(first[0] != first[1]);
+  VERIFY(first[1] != first[2]);
+  // Fewer tasks than workers are executed as well
+  std::atomic<int> counter{0};
+  pool.parallel_for(2, [&](std::size_t) { counter++; });
+  COMPARE(counter.load(), 2);
+}
@@ -11,6 +11,8 @@
 
 #include "smash/threevector.h"
 
+#include <vector>
+
 using namespace smash;
 
 TEST(assign) {
@@ -177,6 +179,16 @@ TEST(rotations) {
   COMPARE_ABSOLUTE_ERROR(Z.x1(), Zfixed.x1(), 1.e-15);
   COMPARE_ABSOLUTE_ERROR(Z.x2(), Zfixed.x2(), 1.e-15);
   COMPARE_ABSOLUTE_ERROR(Z.x3(), Zfixed.x3(), 1.e-15);
+  // a shared rotation gives the same vectors as rotating them one by one
+  const std::vector<ThreeVector> vectors = {Zfixed, R, ThreeVector(-1, 0.5, 0)};
+  std::vector<ThreeVector> rotated = vectors;
+  const EulerRotation rotation(M_PI / 3, M_PI / 4, M_PI / 5);
+  rotation.apply(rotated.begin(), rotated.end());
+  for (std::size_t i = 0; i < vectors.size(); i++) {
+    ThreeVector single = vectors[i];
+    single.rotate(M_PI / 3, M_PI / 4, M_PI / 5);
+    COMPARE(rotated[i], single);
+  }
 }
 
 TEST(compares) {
@@ -0,0 +1,96 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/tracerecorder.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "smash/profiler.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+static std::string read_file(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST_CATCH(no_capacity, std::invalid_argument) { TraceRecorder trace(0); }
+
+TEST(oldest_spans_are_overwritten) {
+  const std::string a = "a", b = "b", c = "c";
+  TraceRecorder trace(2);
+  const auto start = TraceRecorder::Clock::now();
+  for (const std::string *name : {&a, &b, &c}) {
+    trace.record(*name, start, start, -1);
+  }
+  COMPARE(trace.size(), 2u);
+  COMPARE(trace.n_recorded(), 3u);
+  const std::filesystem::path path = testoutputpath / "overwritten.json";
+  trace.write(path);
+  const std::string content = read_file(path);
+  VERIFY(content.find("\"a\"") == std::string::npos);
+  VERIFY(content.find("\"b\"") != std::string::npos);
+  VERIFY(content.find("\"c\"") != std::string::npos);
+}
+
+TEST(spans_are_written_as_complete_events) {
+  const std::string name = "\"quoted\" phase";
+  TraceRecorder trace(4);
+  const auto start = TraceRecorder::Clock::now();
+  trace.record(name, start + std::chrono::microseconds(5),
+               start + std::chrono::microseconds(7), 3);
+  std::thread([&]() { trace.record(name, start, start, -1); }).join();
+  const std::filesystem::path path = testoutputpath / "trace.json";
+  trace.write(path);
+  const std::string content = read_file(path);
+  // The spans are ordered by their start, every thread has its own row
+  const std::size_t other = content.find("\"tid\": 1");
+  const std::size_t first = content.find("\"tid\": 0");
+  VERIFY(other != std::string::npos);
+  VERIFY(first != std::string::npos);
+  VERIFY(other < first);
+  VERIFY(content.find("{\"name\": \"\\\"quoted\\\" phase\", \"ph\": \"X\"") !=
+         std::string::npos);
+  VERIFY(content.find("\"dur\": 2.000, \"args\": {\"ensemble\": 3}}") !=
+         std::string::npos);
+  COMPARE(content.substr(0, 43),
+          "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  COMPARE(content.substr(content.size() - 5), "}\n]}\n");
+}
+
+TEST(profiler_records_its_scopes) {
+  TraceRecorder trace(8);
+  Profiler profiler;
+  const Profiler::Section section = profiler.section("measured");
+  profiler.record_to(&trace);
+  VERIFY(profiler.enabled());
+  {
+    const auto measured = profiler.measure(section, 1);
+    const auto nested = profiler.measure(section);
+  }
+  COMPARE(trace.n_recorded(), 2u);
+}
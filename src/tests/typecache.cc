@@ -0,0 +1,99 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/typecache.h"
+
+#include <filesystem>
+#include <string>
+
+#include "smash/decaymodes.h"
+#include "smash/particletype.h"
+
+using namespace smash;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH) / "typecache";
+
+/* A σ decaying into two neutral pions, sorted by PDG code like the types of
+ * ParticleType::list_all. */
+static TypeCache sigma_cache() {
+  TypeCache cache;
+  cache.types = {{"π⁰", 0.138, 0.0, false, "111", -1.},
+                 {"σ", 0.5, 0.4, true, "661", 1.25}};
+  cache.decays = {{1, 0, {0, 0}}};
+  cache.modes = {{}, {{0, 1.}}};
+  return cache;
+}
+
+static void compare_caches(const TypeCache &a, const TypeCache &b) {
+  COMPARE(a.types.size(), b.types.size());
+  for (std::size_t i = 0; i < a.types.size(); i++) {
+    COMPARE(a.types[i].name, b.types[i].name);
+    COMPARE(a.types[i].mass, b.types[i].mass);
+    COMPARE(a.types[i].width, b.types[i].width);
+    COMPARE(a.types[i].positive_parity, b.types[i].positive_parity);
+    COMPARE(a.types[i].pdgcode, b.types[i].pdgcode);
+    COMPARE(a.types[i].norm_factor, b.types[i].norm_factor);
+  }
+  COMPARE(a.decays.size(), b.decays.size());
+  for (std::size_t i = 0; i < a.decays.size(); i++) {
+    COMPARE(a.decays[i].mother, b.decays[i].mother);
+    COMPARE(a.decays[i].angular_momentum, b.decays[i].angular_momentum);
+    COMPARE(a.decays[i].daughters, b.decays[i].daughters);
+  }
+  COMPARE(a.modes.size(), b.modes.size());
+  for (std::size_t i = 0; i < a.modes.size(); i++) {
+    COMPARE(a.modes[i].size(), b.modes[i].size());
+    for (std::size_t j = 0; j < a.modes[i].size(); j++) {
+      COMPARE(a.modes[i][j].decay, b.modes[i][j].decay);
+      COMPARE(a.modes[i][j].weight, b.modes[i][j].weight);
+    }
+  }
+}
+
+TEST(create_tables) {
+  sigma_cache().create_tables();
+  const ParticleType &sigma = ParticleType::find(0x661);
+  COMPARE(sigma.name(), "σ");
+  COMPARE(sigma.mass(), 0.5);
+  COMPARE(sigma.width_at_pole(), 0.4);
+  COMPARE(sigma.parity(), Parity::Pos);
+  VERIFY(sigma.iso_multiplet() != nullptr);
+  const auto &modes = sigma.decay_modes().decay_mode_list();
+  COMPARE(modes.size(), 1u);
+  COMPARE(modes[0]->weight(), 1.);
+  COMPARE(modes[0]->particle_types().size(), 2u);
+  COMPARE(modes[0]->particle_types()[0]->pdgcode(), 0x111);
+  VERIFY(ParticleType::find(0x111).decay_modes().is_empty());
+  // The tables give back the cache they were created from.
+  compare_caches(TypeCache::from_tables(), sigma_cache());
+}
+
+TEST(write_and_read) {
+  std::filesystem::create_directories(testoutputpath);
+  const auto file = testoutputpath / "particle_types.bin";
+  sha256::Context context;
+  context.update("particles and decay modes");
+  const sha256::Hash hash = context.finalize();
+  sigma_cache().write(file, hash);
+  const auto cache = TypeCache::read(file, hash);
+  VERIFY(cache.has_value());
+  compare_caches(*cache, sigma_cache());
+
+  // A cache of other particles or decay modes is not used.
+  sha256::Hash other_hash = hash;
+  other_hash[0]++;
+  VERIFY(!TypeCache::read(file, other_hash).has_value());
+  VERIFY(!TypeCache::read(testoutputpath / "missing.bin", hash).has_value());
+  // Neither is a truncated one.
+  std::filesystem::resize_file(file, std::filesystem::file_size(file) - 1);
+  VERIFY(!TypeCache::read(file, hash).has_value());
+}
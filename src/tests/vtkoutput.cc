@@ -12,8 +12,13 @@
 #include "smash/vtkoutput.h"
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
 #include <vector>
 
 #include "setup.h"
@@ -296,3 +301,47 @@ TEST(vtkoutputfile) {
   VERIFY(std::filesystem::remove(outputfilepath));
   VERIFY(std::filesystem::remove(outputfile2path));
 }
+
+TEST(binary_vtkoutputfile) {
+  Particles particles;
+  const int number_of_particles = 3;
+  for (int i = 0; i < number_of_particles; i++) {
+    particles.insert(Test::smashon_random());
+  }
+  OutputParameters out_par = OutputParameters();
+  VtkOutput vtkop(testoutputpath, "Particles", out_par, true);
+  const EventLabel event_id = {1, 0};
+  vtkop.at_eventstart(particles, event_id, Test::default_event_info());
+  const std::filesystem::path outputfilepath =
+      testoutputpath / "pos_ev00001_ens00000_tstep00000.vtu";
+  VERIFY(std::filesystem::exists(outputfilepath));
+  std::ifstream outputfile(outputfilepath, std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(outputfile)),
+                            std::istreambuf_iterator<char>());
+  COMPARE(content.substr(0, 5), "<?xml");
+  VERIFY(content.find("<UnstructuredGrid>") != std::string::npos);
+  VERIFY(content.find("Name=\"momentum\"") != std::string::npos);
+  /* The positions are the first appended array. */
+  const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+  const std::size_t start = content.find(marker) + marker.size();
+  std::uint64_t size;
+  std::memcpy(&size, content.data() + start, sizeof(size));
+  COMPARE(size, 3 * sizeof(double) * number_of_particles);
+  const char *positions = content.data() + start + sizeof(size);
+  for (const auto &pd : particles) {
+    std::array<double, 3> x;
+    std::memcpy(x.data(), positions, sizeof(x));
+    positions += sizeof(x);
+    COMPARE(x[0], pd.position().x1());
+    COMPARE(x[1], pd.position().x2());
+    COMPARE(x[2], pd.position().x3());
+  }
+  outputfile.close();
+  VERIFY(std::filesystem::remove(outputfilepath));
+}
+
+TEST_CATCH(invalid_compression_level, std::invalid_argument) {
+  OutputParameters out_par = OutputParameters();
+  out_par.td_compression = 10;
+  VtkOutput vtkop(testoutputpath, "Thermodynamics", out_par, true);
+}
@@ -9,8 +9,11 @@
 
 #include "vir/test.h"  // This include has to be first
 
+#include <algorithm>
+
 #include "setup.h"
 #include "smash/integrate.h"
+#include "smash/processbranch.h"
 
 using namespace smash;
 
@@ -136,3 +139,61 @@ TEST(photon_widths) {
   COMPARE_ABSOLUTE_ERROR(phi.get_partial_width(phi.mass(), {&pi0, &photon}),
                          5.4068538571729e-6, err);
 }
+
+TEST(total_width_sums_partial_widths) {
+  for (const ParticleType &type : ParticleType::list_all()) {
+    if (type.is_stable()) {
+      continue;
+    }
+    for (const double factor : {0.8, 1.0, 1.3}) {
+      const FourVector momentum(type.mass() * factor, 0., 0., 0.);
+      for (const WhichDecaymodes wh :
+           {WhichDecaymodes::All, WhichDecaymodes::Hadronic,
+            WhichDecaymodes::Dileptons}) {
+        // The sums have to agree exactly, not only up to rounding
+        COMPARE(type.get_total_width(momentum, ThreeVector(), wh),
+                total_weight<DecayBranch>(
+                    type.get_partial_widths(momentum, ThreeVector(), wh)))
+            << type.name() << " at mass " << momentum.x0();
+      }
+    }
+  }
+}
+
+TEST(partial_widths_with_open_modes) {
+  for (const ParticleType &type : ParticleType::list_all()) {
+    if (type.is_stable()) {
+      continue;
+    }
+    for (const double factor : {0.8, 1.0, 1.3}) {
+      const FourVector momentum(type.mass() * factor, 0., 0., 0.);
+      size_t n_open_modes;
+      const DecayBranchList dileptons = type.get_partial_widths(
+          momentum, ThreeVector(), WhichDecaymodes::Dileptons, n_open_modes);
+      COMPARE(n_open_modes,
+              type.get_partial_widths(momentum, ThreeVector(),
+                                      WhichDecaymodes::All)
+                  .size());
+      COMPARE(total_weight<DecayBranch>(dileptons),
+              type.get_total_width(momentum, ThreeVector(),
+                                   WhichDecaymodes::Dileptons));
+    }
+  }
+}
+
+TEST(possible_resonances_of_pairs) {
+  const ParticleTypePtr pip = &ParticleType::find(0x211);
+  const ParticleTypePtr proton = &ParticleType::find(0x2212);
+  const ParticleTypePtrSpan resonances = list_possible_resonances(proton, pip);
+  // The list is shared by both orders of the types
+  COMPARE(list_possible_resonances(pip, proton).begin(), resonances.begin());
+  COMPARE(list_possible_resonances(pip, proton).size(), resonances.size());
+  VERIFY(std::find(resonances.begin(), resonances.end(),
+                   &ParticleType::find(0x2224)) != resonances.end());
+  for (const ParticleTypePtr resonance : resonances) {
+    COMPARE(resonance->charge(), 2);
+    COMPARE(resonance->baryon_number(), 1);
+  }
+  // Two positive pions cannot form a resonance
+  VERIFY(list_possible_resonances(pip, pip).empty());
+}
@@ -0,0 +1,123 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "vir/test.h"  // This include has to be first
+
+#include "smash/workloadrecorder.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "setup.h"
+#include "smash/density.h"
+
+using namespace smash;
+using smash::Test::Momentum;
+using smash::Test::Position;
+
+static const std::filesystem::path testoutputpath =
+    std::filesystem::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  std::filesystem::create_directories(testoutputpath);
+  VERIFY(std::filesystem::exists(testoutputpath));
+}
+
+TEST(create_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST_CATCH(no_interval, std::invalid_argument) {
+  WorkloadRecorder recorder(testoutputpath / "no_interval.bin", 0);
+}
+
+TEST_CATCH(not_a_workload, std::runtime_error) {
+  const std::filesystem::path path = testoutputpath / "not_a_workload.bin";
+  std::ofstream(path, std::ios::binary) << "SMSH";
+  WorkloadRecorder::read(path);
+}
+
+TEST(every_nth_pair_is_recorded) {
+  const std::filesystem::path path = testoutputpath / "pairs.bin";
+  {
+    WorkloadRecorder recorder(path, 2);
+    for (int i = 0; i < 5; i++) {
+      const ParticleData a = Test::smashon(
+          Position{0., 0., 0., 0.}, Momentum{1., 0., 0., 0.1 * i}, 0);
+      const ParticleData b = Test::smashon(
+          Position{0., 1., 0., 0.}, Momentum{1., 0., 0., -0.1 * i}, 1);
+      recorder.record_pair(a, b, 0.1, 0.5);
+    }
+    COMPARE(recorder.n_recorded()[WorkloadRecorder::Pairs], 3u);
+  }
+  const WorkloadRecorder::Workload workload = WorkloadRecorder::read(path);
+  COMPARE(workload.pairs.size(), 3u);
+  VERIFY(workload.smearings.empty());
+  VERIFY(workload.strings.empty());
+  for (int i = 0; i < 3; i++) {
+    const WorkloadRecorder::Pair &pair = workload.pairs[i];
+    COMPARE(pair.particles[0].pdgcode, Test::smashon().pdgcode());
+    COMPARE(pair.particles[0].momentum, FourVector(1., 0., 0., 0.2 * i));
+    COMPARE(pair.particles[1].position, FourVector(0., 1., 0., 0.));
+    COMPARE(pair.dt, 0.1);
+    COMPARE(pair.gcell_vol, 0.5);
+  }
+  const ParticleData replayed =
+      workload.pairs[1].particles[1].to_particle_data(7);
+  COMPARE(replayed.id(), 7);
+  COMPARE(replayed.momentum(), FourVector(1., 0., 0., -0.2));
+}
+
+TEST(strings_and_lattice_updates_are_recorded) {
+  const std::filesystem::path path = testoutputpath / "mixed.bin";
+  std::vector<Particles> ensembles(2);
+  ensembles[0].insert(
+      Test::smashon(Position{0., 0.5, 0., 0.}, Momentum{1., 0.1, 0., 0.}));
+  ensembles[1].insert(
+      Test::smashon(Position{0., 0., 1., 0.}, Momentum{1., 0., 0.2, 0.}));
+  ensembles[1].insert(
+      Test::smashon(Position{0., 0., 0., 1.}, Momentum{1., 0., 0., 0.3}));
+  const ParticleList incoming = {ensembles[1].front(), ensembles[1].back()};
+  const DensityParameters par(Test::default_parameters(2));
+  DensityLattice lattice({10., 10., 10.}, {5, 5, 5}, {-5., -5., -5.}, false,
+                         LatticeUpdate::EveryTimestep);
+  {
+    WorkloadRecorder recorder(path, 1);
+    WorkloadRecorder::set_active(&recorder);
+    VERIFY(WorkloadRecorder::active() == &recorder);
+    recorder.record_string(incoming, ProcessType::StringHard);
+    update_lattice_accumulating_ensembles(
+        &lattice, LatticeUpdate::EveryTimestep, DensityType::Hadron, par,
+        ensembles, true);
+  }
+  // The recorder stops recording when it is destroyed
+  VERIFY(WorkloadRecorder::active() == nullptr);
+
+  const WorkloadRecorder::Workload workload = WorkloadRecorder::read(path);
+  VERIFY(workload.pairs.empty());
+  COMPARE(workload.strings.size(), 1u);
+  COMPARE(workload.strings[0].process, ProcessType::StringHard);
+  COMPARE(workload.strings[0].particles[1].position,
+          FourVector(0., 0., 0., 1.));
+  COMPARE(workload.smearings.size(), 1u);
+  const WorkloadRecorder::Smearing &smearing = workload.smearings[0];
+  VERIFY(smearing.n_cells == lattice.n_cells());
+  VERIFY(smearing.origin == lattice.origin());
+  VERIFY(!smearing.periodic);
+  COMPARE(smearing.density_type, DensityType::Hadron);
+  VERIFY(smearing.compute_gradient);
+  COMPARE(smearing.testparticles, 2);
+  VERIFY(smearing.smearing_mode == par.smearing());
+  FUZZY_COMPARE(smearing.gaussian_sigma, 1.);
+  FUZZY_COMPARE(smearing.gauss_cutoff_in_sigma, 4.);
+  COMPARE(smearing.ensembles.size(), 2u);
+  COMPARE(smearing.ensembles[0].size(), 1u);
+  COMPARE(smearing.ensembles[1].size(), 2u);
+  COMPARE(smearing.ensembles[1][0].momentum, FourVector(1., 0., 0.2, 0.));
+}
@@ -12,6 +12,7 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <vector>
 
 #include "smash/clock.h"
 #include "smash/config.h"
@@ -42,6 +43,7 @@ namespace smash {
  * It is possible to print the output in:
  * - ASCII format (option "Lattice_ASCII")
  * - Binary format (option "Lattice_Binary")
+ * - HDF5 format (option "Lattice_HDF5"), if SMASH was built with HDF5
  *
  * For example:
  *\verbatim
@@ -174,6 +176,24 @@ namespace smash {
    "number of charges"; multiply the electric current by the
    elementary charge \f$\sqrt{4 \pi \alpha_{EM}} \f$ for charge units.
  *
+ * **HDF5 files**
+ *
+ * The "Lattice_HDF5" format writes one file `<quantity>_<event>.h5` per
+ * quantity and event, with the same file name stem as the other formats. The
+ * header is stored in the attributes `version`, `quantity_id`, `quantity`,
+ * `nodes`, `spacing` and `origin` of the root group. The payload is stored in
+ * two datasets, which grow by one entry at each output time:
+ * - `time`: the output times, with the shape (number of timesteps)
+ * - `data`: the values, with the shape (number of timesteps, nz, ny, nx) for
+ *   densities, (number of timesteps, 10, nz, ny, nx) for the energy-momentum
+ *   tensors, (number of timesteps, nz, ny, nx, 3) for the Landau velocity and
+ *   (number of timesteps, nz, ny, nx, 12) for the currents.
+ *
+ * The values are ordered as in the binary files, so that the data of a
+ * timestep is one chunk of the dataset, which can be read on its own. The
+ * chunks are compressed with deflate, if a
+ * \ref key_output_thermo_compression_level_ "Compression_Level" is given.
+ *
  * Please, have a look also at \ref input_output_thermodynamics_ for additional
  * information about the computation of the various Thermodynamics quantities.
  */
@@ -184,13 +204,14 @@ const double_t ThermodynamicLatticeOutput::version = 1.0;
 ThermodynamicLatticeOutput::ThermodynamicLatticeOutput(
     const std::filesystem::path &path, const std::string &name,
     const OutputParameters &out_par, const bool enable_ascii,
-    const bool enable_binary)
+    const bool enable_binary, const bool enable_hdf5)
     : OutputInterface(name),
       out_par_(out_par),
       base_path_(std::move(path)),
       enable_ascii_(enable_ascii),
-      enable_binary_(enable_binary) {
-  if (enable_ascii_ || enable_binary_) {
+      enable_binary_(enable_binary),
+      enable_hdf5_(enable_hdf5) {
+  if (enable_ascii_ || enable_binary_ || enable_hdf5_) {
     enable_output_ = true;
   } else {
     enable_output_ = false;
@@ -328,6 +349,7 @@ void ThermodynamicLatticeOutput::at_eventstart(
       write_therm_lattice_binary_header(fp, tq);
     }
   }
+  open_hdf5_file(tq, varname, event_number);
 }
 
 void ThermodynamicLatticeOutput::at_eventstart(
@@ -453,12 +475,14 @@ void ThermodynamicLatticeOutput::at_eventstart(
     }
     write_therm_lattice_binary_header(fp, tq);
   }
+  open_hdf5_file(tq, varname, event_number);
 }
 
 void ThermodynamicLatticeOutput::at_eventend(const ThermodynamicQuantity tq) {
   if (!enable_output_) {
     return;
   }
+  output_hdf5_files_.erase(tq);
   if (tq == ThermodynamicQuantity::EckartDensity) {
     if (enable_ascii_) {
       output_ascii_files_[ThermodynamicQuantity::EckartDensity]->close();
@@ -522,6 +546,10 @@ void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
     assert(sizeof(ctime) == sizeof(double));
     fp->write(reinterpret_cast<char *>(&ctime), sizeof(ctime));
   }
+  Hdf5LatticeFile *h5 =
+      enable_hdf5_
+          ? output_hdf5_files_.at(ThermodynamicQuantity::EckartDensity).get()
+          : nullptr;
   lattice.iterate_sublattice(
       {0, 0, 0}, dim, [&](DensityOnLattice &node, int ix, int, int) {
         if (enable_ascii_) {
@@ -534,7 +562,13 @@ void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
           result = node.rho();
           fp->write(reinterpret_cast<char *>(&result), sizeof(double));
         }
+        if (h5) {
+          h5->add(node.rho());
+        }
       });
+  if (h5) {
+    h5->write_frame(ctime);
+  }
 }
 
 void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
@@ -560,22 +594,56 @@ void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
     assert(sizeof(ctime) == sizeof(double));
     fp->write(reinterpret_cast<char *>(&ctime), sizeof(ctime));
   }
+  Hdf5LatticeFile *h5 =
+      enable_hdf5_ ? output_hdf5_files_.at(ThermodynamicQuantity::j_QBS).get()
+                   : nullptr;
+  const auto sum_currents_at = [&](const ThreeVector &position) {
+    jQ.reset();
+    jB.reset();
+    jS.reset();
+    for (const Particles &particles : ensembles) {
+      jQ += std::get<1>(current_eckart(position, particles, dens_param,
+                                       DensityType::Charge, compute_gradient,
+                                       out_par_.td_smearing));
+      jB += std::get<1>(current_eckart(position, particles, dens_param,
+                                       DensityType::Baryon, compute_gradient,
+                                       out_par_.td_smearing));
+      jS += std::get<1>(current_eckart(position, particles, dens_param,
+                                       DensityType::Strangeness,
+                                       compute_gradient, out_par_.td_smearing));
+    }
+  };
+  /* With the covariant Gaussian smearing, the currents at the nodes are the
+   * ones smeared onto lattices of the same geometry, which are filled in one
+   * pass over the particles instead of one pass per node. A periodic lattice
+   * would also smear the particles across its boundaries, hence the currents
+   * are summed at every node then. Without smearing, the currents are the same
+   * at all nodes. */
+  const bool smear_onto_lattices =
+      out_par_.td_smearing && !lattice.periodic() &&
+      dens_param.smearing() == SmearingMode::CovariantGaussian;
+  std::vector<RectangularLattice<DensityOnLattice>> currents;
+  if (smear_onto_lattices) {
+    currents.reserve(3);
+    for (int k = 0; k < 3; k++) {
+      currents.emplace_back(lattice);
+    }
+    update_lattices_accumulating_ensembles<DensityOnLattice, 3>(
+        {&currents[0], &currents[1], &currents[2]}, lattice.when_update(),
+        {DensityType::Charge, DensityType::Baryon, DensityType::Strangeness},
+        dens_param, ensembles, compute_gradient);
+  } else if (!out_par_.td_smearing) {
+    sum_currents_at(lattice.cell_center(0, 0, 0));
+  }
   lattice.iterate_sublattice(
-      {0, 0, 0}, dim, [&](DensityOnLattice &, int ix, int iy, int iz) {
-        const ThreeVector position = lattice.cell_center(ix, iy, iz);
-        jQ.reset();
-        jB.reset();
-        jS.reset();
-        for (const Particles &particles : ensembles) {
-          jQ += std::get<1>(current_eckart(
-              position, particles, dens_param, DensityType::Charge,
-              compute_gradient, out_par_.td_smearing));
-          jB += std::get<1>(current_eckart(
-              position, particles, dens_param, DensityType::Baryon,
-              compute_gradient, out_par_.td_smearing));
-          jS += std::get<1>(current_eckart(
-              position, particles, dens_param, DensityType::Strangeness,
-              compute_gradient, out_par_.td_smearing));
+      {0, 0, 0}, dim, [&](DensityOnLattice &node, int ix, int iy, int iz) {
+        if (smear_onto_lattices) {
+          const std::size_t index = &node - &lattice[0];
+          jQ = currents[0][index].jmu_net();
+          jB = currents[1][index].jmu_net();
+          jS = currents[2][index].jmu_net();
+        } else if (out_par_.td_smearing) {
+          sum_currents_at(lattice.cell_center(ix, iy, iz));
         }
         if (enable_ascii_) {
           *fp << jQ[0];
@@ -604,7 +672,17 @@ void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
             fp->write(reinterpret_cast<char *>(&result), sizeof(double));
           }
         }
+        if (h5) {
+          for (const FourVector *j : {&jQ, &jB, &jS}) {
+            for (int l = 0; l < 4; l++) {
+              h5->add((*j)[l]);
+            }
+          }
+        }
       });
+  if (h5) {
+    h5->write_frame(ctime);
+  }
 }
 
 void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
@@ -651,6 +729,14 @@ void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
     assert(sizeof(ctime) == sizeof(double));
     fp->write(reinterpret_cast<char *>(&ctime), sizeof(double));
   }
+  Hdf5LatticeFile *h5 = nullptr;
+  if (enable_hdf5_) {
+    auto file = output_hdf5_files_.find(tq);
+    if (file == output_hdf5_files_.end()) {
+      return;
+    }
+    h5 = file->second.get();
+  }
   switch (tq) {
     case ThermodynamicQuantity::Tmn:
       for (int i = 0; i < 4; i++) {
@@ -668,52 +754,77 @@ void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
                   result = node[EnergyMomentumTensor::tmn_index(i, j)];
                   fp->write(reinterpret_cast<char *>(&result), sizeof(double));
                 }
+                if (h5) {
+                  h5->add(node[EnergyMomentumTensor::tmn_index(i, j)]);
+                }
               });
         }
       }
       break;
-    case ThermodynamicQuantity::TmnLandau:
+    case ThermodynamicQuantity::TmnLandau: {
+      // The Landau frames of all nodes are found at once
+      const std::vector<FourVector> u =
+          EnergyMomentumTensor::landau_frame_4velocities(&lattice[0],
+                                                         lattice.size());
+      std::vector<EnergyMomentumTensor> Tmn_L;
+      Tmn_L.reserve(lattice.size());
+      for (std::size_t node = 0; node < lattice.size(); node++) {
+        Tmn_L.push_back(lattice.begin()[node].boosted(u[node]));
+      }
       for (int i = 0; i < 4; i++) {
         for (int j = i; j < 4; j++) {
           lattice.iterate_sublattice(
               {0, 0, 0}, dim,
               [&](EnergyMomentumTensor &node, int ix, int, int) {
+                const EnergyMomentumTensor &node_L =
+                    Tmn_L[&node - &*lattice.begin()];
+                const double Tij_L =
+                    node_L[EnergyMomentumTensor::tmn_index(i, j)];
                 if (enable_ascii_) {
-                  const FourVector u = node.landau_frame_4velocity();
-                  const EnergyMomentumTensor Tmn_L = node.boosted(u);
-                  *fp << Tmn_L[EnergyMomentumTensor::tmn_index(i, j)] << " ";
+                  *fp << Tij_L << " ";
                   if (ix == dim[0] - 1) {
                     *fp << "\n";
                   }
                 }
                 if (enable_binary_) {
-                  const FourVector u = node.landau_frame_4velocity();
-                  const EnergyMomentumTensor Tmn_L = node.boosted(u);
-                  result = Tmn_L[EnergyMomentumTensor::tmn_index(i, j)];
+                  result = Tij_L;
                   fp->write(reinterpret_cast<char *>(&result), sizeof(double));
                 }
+                if (h5) {
+                  h5->add(Tij_L);
+                }
               });
         }
       }
       break;
-    case ThermodynamicQuantity::LandauVelocity:
+    }
+    case ThermodynamicQuantity::LandauVelocity: {
+      const std::vector<FourVector> u =
+          EnergyMomentumTensor::landau_frame_4velocities(&lattice[0],
+                                                         lattice.size());
       lattice.iterate_sublattice(
           {0, 0, 0}, dim, [&](EnergyMomentumTensor &node, int, int, int) {
+            ThreeVector v = -u[&node - &*lattice.begin()].velocity();
             if (enable_ascii_) {
-              const FourVector u = node.landau_frame_4velocity();
-              const ThreeVector v = -u.velocity();
               *fp << v.x1() << " " << v.x2() << " " << v.x3() << "\n";
             }
             if (enable_binary_) {
-              const FourVector u = node.landau_frame_4velocity();
-              ThreeVector v = -u.velocity();
               fp->write(reinterpret_cast<char *>(&v), 3 * sizeof(double));
             }
+            if (h5) {
+              h5->add(v.x1());
+              h5->add(v.x2());
+              h5->add(v.x3());
+            }
           });
       break;
+    }
     default:
       return;
   }
+  if (h5) {
+    h5->write_frame(ctime);
+  }
 }
 
 int ThermodynamicLatticeOutput::to_int(const ThermodynamicQuantity &tq) {
@@ -739,15 +850,46 @@ std::string ThermodynamicLatticeOutput::make_filename(const std::string &descr,
                                                       const int event_number,
                                                       const char type) {
   char suffix[13];
-  assert((type == 'a') || (type == 'b'));
+  assert((type == 'a') || (type == 'b') || (type == 'h'));
   if (type == 'a') {
     snprintf(suffix, sizeof(suffix), "_%07i.dat", event_number);
+  } else if (type == 'h') {
+    snprintf(suffix, sizeof(suffix), "_%07i.h5", event_number);
   } else {
     snprintf(suffix, sizeof(suffix), "_%07i.bin", event_number);
   }
   return base_path_.string() + std::string("/") + descr + std::string(suffix);
 }
 
+void ThermodynamicLatticeOutput::open_hdf5_file(const ThermodynamicQuantity tq,
+                                                const std::string &varname,
+                                                const int event_number) {
+  if (!enable_hdf5_) {
+    return;
+  }
+  const std::size_t nx = nodes_[0], ny = nodes_[1], nz = nodes_[2];
+  std::vector<std::size_t> frame_shape;
+  switch (tq) {
+    case ThermodynamicQuantity::EckartDensity:
+      frame_shape = {nz, ny, nx};
+      break;
+    case ThermodynamicQuantity::Tmn:
+    case ThermodynamicQuantity::TmnLandau:
+      frame_shape = {10, nz, ny, nx};
+      break;
+    case ThermodynamicQuantity::LandauVelocity:
+      frame_shape = {nz, ny, nx, 3};
+      break;
+    case ThermodynamicQuantity::j_QBS:
+      frame_shape = {nz, ny, nx, 12};
+      break;
+  }
+  const std::string filename = make_filename(varname, event_number, 'h');
+  output_hdf5_files_[tq] = std::make_unique<Hdf5LatticeFile>(
+      filename, to_string(tq), to_int(tq), version, nodes_, sizes_, origin_,
+      frame_shape, out_par_.td_compression);
+}
+
 std::string ThermodynamicLatticeOutput::make_varname(
     const ThermodynamicQuantity tq, const DensityType dens_type) {
   return std::string(to_string(dens_type)) + std::string("_") +
@@ -199,7 +199,7 @@ void ThermodynamicOutput::at_intermediate_time(
       for (const auto &p : particles) {
         if (dens_param.only_participants()) {
           // if this condition holds, the hadron is a spectator and we skip it
-          if (p.get_history().collisions_per_particle == 0) {
+          if (p.collisions_per_particle() == 0) {
             continue;
           }
         }
@@ -0,0 +1,141 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/threadpool.h"
+
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace smash {
+
+namespace {
+/**
+ * \return The CPUs the process may run on, in increasing order. It is empty if
+ * they cannot be determined.
+ */
+std::vector<int> allowed_cpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+/**
+ * Bind the calling thread to the given CPU. Failures are ignored, since they
+ * only affect the performance.
+ *
+ * \param[in] cpu The CPU.
+ */
+void pin_to_cpu([[maybe_unused]] int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+}  // unnamed namespace
+
+ThreadPool::ThreadPool(int n_threads, bool pinned) : pinned_(pinned) {
+  if (n_threads < 1) {
+    throw std::invalid_argument(
+        "A thread pool needs at least one worker thread.");
+  }
+  const std::vector<int> cpus = pinned ? allowed_cpus() : std::vector<int>{};
+  next_task_of_worker_.assign(n_threads, 0);
+  workers_.reserve(n_threads);
+  for (int i = 0; i < n_threads; i++) {
+    // Spread the threads evenly over the CPUs
+    const int cpu = cpus.empty() ? -1 : cpus[i * cpus.size() / n_threads];
+    workers_.emplace_back([this, i, cpu]() { work(i, cpu); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_available_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallel_for(std::size_t n,
+                              const std::function<void(std::size_t)> &task) {
+  if (n == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_ = &task;
+  n_tasks_ = n;
+  next_task_ = 0;
+  for (std::size_t worker = 0; worker < workers_.size(); worker++) {
+    next_task_of_worker_[worker] = worker;
+  }
+  pending_tasks_ = n;
+  first_exception_ = nullptr;
+  work_available_.notify_all();
+  work_done_.wait(lock, [this]() { return pending_tasks_ == 0; });
+  task_ = nullptr;
+  n_tasks_ = 0;
+  if (first_exception_) {
+    std::rethrow_exception(first_exception_);
+  }
+}
+
+void ThreadPool::work(std::size_t worker, int cpu) {
+  if (cpu >= 0) {
+    pin_to_cpu(cpu);
+  }
+  // Pinned workers always take the same indices
+  std::size_t &next_task = pinned_ ? next_task_of_worker_[worker] : next_task_;
+  const std::size_t stride = pinned_ ? next_task_of_worker_.size() : 1;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_available_.wait(
+        lock, [this, &next_task]() { return stop_ || next_task < n_tasks_; });
+    if (stop_) {
+      return;
+    }
+    const std::size_t index = next_task;
+    next_task += stride;
+    const auto &task = *task_;
+    lock.unlock();
+    std::exception_ptr exception = nullptr;
+    try {
+      task(index);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    lock.lock();
+    if (exception && !first_exception_) {
+      first_exception_ = exception;
+    }
+    if (--pending_tasks_ == 0) {
+      work_done_.notify_one();
+    }
+  }
+}
+
+}  // namespace smash
@@ -0,0 +1,105 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/threebodyintegraltable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "gsl/gsl_sf_ellint.h"
+
+#include "smash/pow.h"
+
+namespace smash {
+
+double three_body_integral(double sqrts, double m1, double m2, double m3) {
+  if (sqrts < m1 + m2 + m3) {
+    return 0.0;
+  }
+  const double x1 = (m1 - m2) * (m1 - m2), x2 = (m1 + m2) * (m1 + m2),
+               x3 = (sqrts - m3) * (sqrts - m3),
+               x4 = (sqrts + m3) * (sqrts + m3);
+  const double qmm = x3 - x1, qmp = x3 - x2, qpm = x4 - x1, qpp = x4 - x2;
+  const double kappa = std::sqrt(qpm * qmp / (qpp * qmm));
+  const double tmp = std::sqrt(qmm * qpp);
+  const double c1 =
+      4.0 * m1 * m2 * std::sqrt(qmm / qpp) * (x4 - m3 * sqrts + m1 * m2);
+  const double c2 = 0.5 * (m1 * m1 + m2 * m2 + m3 * m3 + sqrts * sqrts) * tmp;
+  const double c3 = 8 * m1 * m2 / tmp *
+                    ((m1 * m1 + m2 * m2) * (m3 * m3 + sqrts * sqrts) -
+                     2 * m1 * m1 * m2 * m2 - 2 * m3 * m3 * sqrts * sqrts);
+  const double c4 =
+      -8 * m1 * m2 / tmp * smash::pow_int(sqrts * sqrts - m3 * m3, 2);
+  const double res =
+      c1 * gsl_sf_ellint_Kcomp(kappa, GSL_PREC_DOUBLE) +
+      c2 * gsl_sf_ellint_Ecomp(kappa, GSL_PREC_DOUBLE) +
+      c3 * gsl_sf_ellint_Pcomp(kappa, -qmp / qmm, GSL_PREC_DOUBLE) +
+      c4 * gsl_sf_ellint_Pcomp(kappa, -x1 * qmp / (x2 * qmm), GSL_PREC_DOUBLE);
+  return res;
+}
+
+std::map<ThreeBodyIntegralTable::Key,
+         std::unique_ptr<const ThreeBodyIntegralTable>>
+    ThreeBodyIntegralTable::tables_;
+std::shared_mutex ThreeBodyIntegralTable::tables_mutex_;
+
+ThreeBodyIntegralTable::ThreeBodyIntegralTable(double m1, double m2,
+                                               double m3, int n_values,
+                                               double delta_max)
+    : masses_{m1, m2, m3},
+      threshold_(m1 + m2 + m3),
+      delta_max_(delta_max),
+      inv_delta_(n_values / delta_max),
+      values_(n_values + 1) {
+  const double step = delta_max / n_values;
+  for (int i = 1; i <= n_values; i++) {
+    const double delta = i * step;
+    values_[i] =
+        three_body_integral(threshold_ + delta, m1, m2, m3) / (delta * delta);
+  }
+  values_[0] = 3. * values_[1] - 3. * values_[2] + values_[3];
+}
+
+double ThreeBodyIntegralTable::operator()(double sqrts) const {
+  const double delta = sqrts - threshold_;
+  if (!(delta > 0.)) {
+    return 0.;
+  }
+  if (delta >= delta_max_) {
+    return three_body_integral(sqrts, masses_[0], masses_[1], masses_[2]);
+  }
+  const double t = delta * inv_delta_;
+  // Rounding may put the largest kinetic energies onto the last value.
+  const std::size_t k =
+      std::min(static_cast<std::size_t>(t), values_.size() - 2);
+  const double f = t - k;
+  return (values_[k] + f * (values_[k + 1] - values_[k])) * delta * delta;
+}
+
+const ThreeBodyIntegralTable &ThreeBodyIntegralTable::find(double m1,
+                                                           double m2,
+                                                           double m3) {
+  const Key key{m1, m2, m3};
+  {
+    std::shared_lock lock(tables_mutex_);
+    const auto found = tables_.find(key);
+    if (found != tables_.end()) {
+      return *found->second;
+    }
+  }
+  std::unique_lock lock(tables_mutex_);
+  auto &table = tables_[key];
+  if (!table) {
+    table = std::make_unique<const ThreeBodyIntegralTable>(m1, m2, m3);
+  }
+  return *table;
+}
+
+}  // namespace smash
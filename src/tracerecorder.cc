@@ -0,0 +1,108 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/tracerecorder.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace smash {
+
+/*!\Userguide
+ * \page doxypage_output_trace
+ *
+ * The trace (trace.json) shows the timeline of the profiled phases of the run,
+ * if \ref key_gen_trace_events_ "Trace_Events" is positive. It is written in
+ * the Trace Event Format at the end of the run and can be opened with the
+ * Chrome tracing viewer (chrome://tracing) or with https://ui.perfetto.dev.
+ * Every thread evolving ensembles or events has its own row, such that load
+ * imbalance among the ensembles and stalls, e.g. in the outputs, can be seen.
+ *
+ * Every span is a complete event with the name of the phase, e.g. a finder,
+ * the propagation, a process type or an output, see \ref key_gen_profiling_
+ * "Profiling". The spans of the phases of an ensemble carry its number as the
+ * argument `ensemble`. Phases may be nested, e.g. the propagation and the
+ * actions are part of the timestepless propagation of an ensemble. The string
+ * fragmentations by Pythia are the spans of the string process types.
+ *
+ * Only the latest spans are kept, up to the given number, such that the trace
+ * of a long run shows its end.
+ */
+
+TraceRecorder::TraceRecorder(std::size_t capacity) : capacity_(capacity) {
+  if (capacity == 0) {
+    throw std::invalid_argument("A trace has to keep at least one span.");
+  }
+}
+
+void TraceRecorder::record(const std::string &name, Clock::time_point start,
+                           Clock::time_point end, int ensemble) {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  const int64_t start_ns = duration_cast<nanoseconds>(start - origin_).count();
+  const int64_t duration_ns = duration_cast<nanoseconds>(end - start).count();
+  const std::thread::id id = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(mutex_);
+  const int thread =
+      threads_.emplace(id, static_cast<int>(threads_.size())).first->second;
+  const Span span{&name, start_ns, duration_ns, thread, ensemble};
+  if (spans_.size() < capacity_) {
+    spans_.push_back(span);
+  } else {
+    spans_[n_recorded_ % capacity_] = span;
+  }
+  n_recorded_++;
+}
+
+std::size_t TraceRecorder::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return spans_.size();
+}
+
+uint64_t TraceRecorder::n_recorded() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return n_recorded_;
+}
+
+void TraceRecorder::write(const std::filesystem::path &path) const {
+  std::vector<Span> spans;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans = spans_;
+  }
+  std::stable_sort(spans.begin(), spans.end(),
+                   [](const Span &a, const Span &b) {
+                     return a.start_ns < b.start_ns;
+                   });
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("The trace cannot be written to \"" +
+                             path.native() + "\".");
+  }
+  // The times of the format are given in microseconds
+  out << std::fixed << std::setprecision(3)
+      << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (std::size_t i = 0; i < spans.size(); i++) {
+    const Span &span = spans[i];
+    // std::quoted escapes quotes and backslashes as JSON does
+    out << (i == 0 ? "\n" : ",\n") << "{\"name\": " << std::quoted(*span.name)
+        << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << span.thread
+        << ", \"ts\": " << 1e-3 * span.start_ns
+        << ", \"dur\": " << 1e-3 * span.duration_ns;
+    if (span.ensemble >= 0) {
+      out << ", \"args\": {\"ensemble\": " << span.ensemble << '}';
+    }
+    out << '}';
+  }
+  out << "\n]}\n";
+}
+
+}  // namespace smash
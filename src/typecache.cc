@@ -0,0 +1,283 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/typecache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "smash/decaymodes.h"
+#include "smash/decaytype.h"
+#include "smash/file.h"
+#include "smash/particletype.h"
+
+namespace smash {
+
+namespace {
+
+/// Magic number at the start of the cache
+constexpr char magic[4] = {'S', 'M', 'T', 'C'};
+/// Version of the layout of the cache
+constexpr std::uint32_t format_version = 1;
+
+/**
+ * Sequential reader of the bytes of a cache, which checks that no value is
+ * read beyond the end.
+ */
+class Reader {
+ public:
+  /**
+   * \param[in] data The bytes of the cache, they have to outlive the reader.
+   */
+  explicit Reader(const std::string &data) : data_(data) {}
+
+  /**
+   * \param[out] value The next value.
+   * \return Whether the value could be read.
+   */
+  template <typename T>
+  bool get(T &value) {
+    if (data_.size() - position_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_.data() + position_, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+
+  /**
+   * \param[out] value The next string, preceded by its length.
+   * \return Whether the string could be read.
+   */
+  bool get(std::string &value) {
+    std::uint32_t length;
+    if (!get(length) || data_.size() - position_ < length) {
+      return false;
+    }
+    value.assign(data_, position_, length);
+    position_ += length;
+    return true;
+  }
+
+  /// \return Whether all bytes were read.
+  bool at_end() const { return position_ == data_.size(); }
+
+ private:
+  /// The bytes of the cache
+  const std::string &data_;
+  /// Position of the next value
+  std::size_t position_ = 0;
+};
+
+/**
+ * \param[in] file The file.
+ * \param[in] value The value to be written.
+ */
+template <typename T>
+void put(FILE *file, const T &value) {
+  std::fwrite(&value, sizeof(T), 1, file);
+}
+
+/**
+ * \param[in] file The file.
+ * \param[in] value The string to be written, preceded by its length.
+ */
+void put(FILE *file, const std::string &value) {
+  put(file, static_cast<std::uint32_t>(value.size()));
+  std::fwrite(value.data(), 1, value.size(), file);
+}
+
+/**
+ * \param[in] type A particle type.
+ * \return The position of the type in ParticleType::list_all.
+ */
+std::uint32_t index_of(const ParticleType &type) {
+  return static_cast<std::uint32_t>(
+      std::addressof(type) - std::addressof(ParticleType::list_all()[0]));
+}
+
+}  // unnamed namespace
+
+TypeCache TypeCache::from_tables() {
+  TypeCache cache;
+  const auto &particles = ParticleType::list_all();
+  std::map<const DecayType *, std::uint32_t> decay_index;
+  for (const auto &decay : DecayModes::list_all_decay_types()) {
+    const auto index = static_cast<std::uint32_t>(cache.decays.size());
+    decay_index.emplace(decay.get(), index);
+    std::vector<std::uint32_t> daughters;
+    for (const auto &daughter : decay->particle_types()) {
+      daughters.push_back(index_of(*daughter));
+    }
+    cache.decays.push_back({0, decay->angular_momentum(), daughters});
+  }
+  // The mother matters only for the types, which are specific to one mother.
+  std::vector<bool> has_mother(cache.decays.size(), false);
+  for (const ParticleType &type : particles) {
+    cache.types.push_back({type.name(), type.mass(), type.width_at_pole(),
+                           type.parity() == Parity::Pos,
+                           type.pdgcode().string(), type.norm_factor_});
+    cache.modes.emplace_back();
+    for (const auto &mode : type.decay_modes().decay_mode_list()) {
+      const std::uint32_t index = decay_index.at(&mode->type());
+      if (!has_mother[index]) {
+        cache.decays[index].mother = index_of(type);
+        has_mother[index] = true;
+      }
+      cache.modes.back().push_back({index, mode->weight()});
+    }
+  }
+  return cache;
+}
+
+std::optional<TypeCache> TypeCache::read(const std::filesystem::path &file,
+                                         const sha256::Hash &hash) {
+  std::ifstream in(file, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+  // The cache is small, it is read at once and decoded from memory.
+  std::string data(std::filesystem::file_size(file), '\0');
+  if (!in.read(data.data(), data.size())) {
+    return std::nullopt;
+  }
+  Reader reader(data);
+  char file_magic[4];
+  std::uint32_t version;
+  sha256::Hash file_hash;
+  if (!reader.get(file_magic) || std::memcmp(file_magic, magic, 4) != 0 ||
+      !reader.get(version) || version != format_version ||
+      !reader.get(file_hash) || file_hash != hash) {
+    return std::nullopt;
+  }
+
+  TypeCache cache;
+  std::uint32_t n_types, n_decays;
+  if (!reader.get(n_types)) {
+    return std::nullopt;
+  }
+  cache.types.resize(n_types);
+  for (Type &t : cache.types) {
+    if (!reader.get(t.name) || !reader.get(t.mass) || !reader.get(t.width) ||
+        !reader.get(t.positive_parity) || !reader.get(t.pdgcode) ||
+        !reader.get(t.norm_factor)) {
+      return std::nullopt;
+    }
+  }
+  if (!reader.get(n_decays)) {
+    return std::nullopt;
+  }
+  cache.decays.resize(n_decays);
+  for (Decay &d : cache.decays) {
+    std::uint8_t n_daughters;
+    if (!reader.get(d.mother) || !reader.get(d.angular_momentum) ||
+        !reader.get(n_daughters) || d.mother >= n_types ||
+        (n_daughters != 2 && n_daughters != 3)) {
+      return std::nullopt;
+    }
+    d.daughters.resize(n_daughters);
+    for (std::uint32_t &daughter : d.daughters) {
+      if (!reader.get(daughter) || daughter >= n_types) {
+        return std::nullopt;
+      }
+    }
+  }
+  cache.modes.resize(n_types);
+  for (auto &modes : cache.modes) {
+    std::uint32_t n_modes;
+    if (!reader.get(n_modes)) {
+      return std::nullopt;
+    }
+    modes.resize(n_modes);
+    for (Mode &m : modes) {
+      if (!reader.get(m.decay) || !reader.get(m.weight) ||
+          m.decay >= n_decays) {
+        return std::nullopt;
+      }
+    }
+  }
+  if (!reader.at_end()) {
+    return std::nullopt;
+  }
+  return cache;
+}
+
+void TypeCache::write(const std::filesystem::path &file,
+                      const sha256::Hash &hash) const {
+  RenamingFilePtr renaming_file(file, "wb");
+  FILE *out = renaming_file.get();
+  std::fwrite(magic, 1, 4, out);
+  put(out, format_version);
+  put(out, hash);
+  put(out, static_cast<std::uint32_t>(types.size()));
+  for (const Type &t : types) {
+    put(out, t.name);
+    put(out, t.mass);
+    put(out, t.width);
+    put(out, t.positive_parity);
+    put(out, t.pdgcode);
+    put(out, t.norm_factor);
+  }
+  put(out, static_cast<std::uint32_t>(decays.size()));
+  for (const Decay &d : decays) {
+    put(out, d.mother);
+    put(out, d.angular_momentum);
+    put(out, static_cast<std::uint8_t>(d.daughters.size()));
+    for (std::uint32_t daughter : d.daughters) {
+      put(out, daughter);
+    }
+  }
+  for (const auto &type_modes : modes) {
+    put(out, static_cast<std::uint32_t>(type_modes.size()));
+    for (const Mode &m : type_modes) {
+      put(out, m.decay);
+      put(out, m.weight);
+    }
+  }
+}
+
+void TypeCache::create_tables() const {
+  ParticleTypeList type_list;
+  type_list.reserve(types.size());
+  for (const Type &t : types) {
+    type_list.emplace_back(t.name, t.mass, t.width,
+                           t.positive_parity ? Parity::Pos : Parity::Neg,
+                           PdgCode(t.pdgcode));
+  }
+  ParticleType::create_type_list(std::move(type_list));
+
+  const auto &particles = ParticleType::list_all();
+  DecayModes::reset_decaymodes();
+  std::vector<DecayType *> decay_types;
+  decay_types.reserve(decays.size());
+  for (const Decay &d : decays) {
+    ParticleTypePtrList daughters;
+    for (std::uint32_t daughter : d.daughters) {
+      daughters.push_back(&particles[daughter]);
+    }
+    decay_types.push_back(DecayModes::create_decay_type(
+        &particles[d.mother], daughters, d.angular_momentum));
+  }
+  std::vector<DecayModes> &decay_modes = *DecayModes::all_decay_modes;
+  for (std::size_t i = 0; i < modes.size(); i++) {
+    for (const Mode &m : modes[i]) {
+      decay_modes[i].decay_modes_.push_back(
+          std::make_unique<DecayBranch>(*decay_types[m.decay], m.weight));
+    }
+    particles[i].norm_factor_ = types[i].norm_factor;
+  }
+  DecayModes::create_channel_tables();
+  create_resonance_table();
+}
+
+}  // namespace smash
@@ -9,10 +9,20 @@
 
 #include "smash/vtkoutput.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#ifdef SMASH_USE_ZLIB
+#include <zlib.h>
+#endif
+
 #include "smash/clock.h"
 #include "smash/config.h"
 #include "smash/file.h"
@@ -22,15 +32,32 @@
 namespace smash {
 
 VtkOutput::VtkOutput(const std::filesystem::path &path, const std::string &name,
-                     const OutputParameters &out_par)
+                     const OutputParameters &out_par, bool binary)
     : OutputInterface(name),
       base_path_(std::move(path)),
       is_thermodynamics_output_(name == "Thermodynamics"),
-      is_fields_output_(name == "Fields") {
+      is_fields_output_(name == "Fields"),
+      binary_(binary),
+      compression_level_(binary && is_thermodynamics_output_
+                             ? out_par.td_compression
+                             : 0),
+      open_mode_(binary ? std::ios::out | std::ios::binary : std::ios::out) {
   if (out_par.part_extended) {
     logg[LOutput].warn()
         << "Creating VTK output: There is no extended VTK format.";
   }
+  if (compression_level_ < 0 || compression_level_ > 9) {
+    throw std::invalid_argument(
+        "The compression level of the VTK_Binary output must be between 0 "
+        "and 9.");
+  }
+#ifndef SMASH_USE_ZLIB
+  if (compression_level_ > 0) {
+    throw std::invalid_argument(
+        "Compressed VTK_Binary output requested, but zlib support not "
+        "compiled in.");
+  }
+#endif
 }
 
 VtkOutput::~VtkOutput() {}
@@ -60,6 +87,13 @@ VtkOutput::~VtkOutput() {}
  *
  * There is also a possibility to print a lattice with thermodynamical
  * quantities to VTK files, see \ref doxypage_output_vtk_lattice.
+ *
+ * With the `VTK_Binary` format, the same quantities are written to XML VTK
+ * files of an unstructured grid, named
+ * `pos_ev<event>_ens<ensemble>_tstep<timestep_counter>.vtu`.
+ * Their arrays are appended to the file as raw binary data, which is much
+ * faster to write and read than text and keeps the full precision. ParaView
+ * opens these files as well.
  **/
 
 void VtkOutput::at_eventstart(const Particles &particles,
@@ -98,6 +132,10 @@ void VtkOutput::at_intermediate_time(const Particles &particles,
 }
 
 void VtkOutput::write(const Particles &particles) {
+  if (binary_) {
+    write_binary(particles);
+    return;
+  }
   char filename[64];
   snprintf(filename, sizeof(filename), "pos_ev%05i_ens%05i_tstep%05i.vtk",
            current_event_, current_ensemble_,
@@ -152,7 +190,7 @@ void VtkOutput::write(const Particles &particles) {
   std::fprintf(file_.get(), "SCALARS N_coll int 1\n");
   std::fprintf(file_.get(), "LOOKUP_TABLE default\n");
   for (const auto &p : particles) {
-    std::fprintf(file_.get(), "%i\n", p.get_history().collisions_per_particle);
+    std::fprintf(file_.get(), "%i\n", p.collisions_per_particle());
   }
   std::fprintf(file_.get(), "SCALARS particle_ID int 1\n");
   std::fprintf(file_.get(), "LOOKUP_TABLE default\n");
@@ -176,18 +214,197 @@ void VtkOutput::write(const Particles &particles) {
   }
 }
 
+void VtkOutput::write_binary(const Particles &particles) {
+  char filename[64];
+  snprintf(filename, sizeof(filename), "pos_ev%05i_ens%05i_tstep%05i.vtu",
+           current_event_, current_ensemble_,
+           vtk_output_counter_[counter_key()]);
+  std::ofstream file(base_path_ / filename, open_mode_);
+  const std::size_t n = particles.size();
+  std::vector<double> positions, momenta, xsec_factors, masses;
+  std::vector<std::int32_t> pdg_codes, is_formed, n_coll, ids, baryon_numbers,
+      strangeness;
+  positions.reserve(3 * n);
+  momenta.reserve(3 * n);
+  const double current_time = particles.time();
+  for (const auto &p : particles) {
+    const ThreeVector r = p.position().threevec();
+    const ThreeVector mom = p.momentum().threevec();
+    positions.insert(positions.end(), {r.x1(), r.x2(), r.x3()});
+    momenta.insert(momenta.end(), {mom.x1(), mom.x2(), mom.x3()});
+    xsec_factors.push_back(p.xsec_scaling_factor());
+    masses.push_back(p.effective_mass());
+    pdg_codes.push_back(p.pdgcode().get_decimal());
+    is_formed.push_back(p.formation_time() > current_time ? 0 : 1);
+    n_coll.push_back(p.collisions_per_particle());
+    ids.push_back(p.id());
+    baryon_numbers.push_back(p.pdgcode().baryon_number());
+    strangeness.push_back(p.pdgcode().strangeness());
+  }
+  // Every particle is a cell of the type VTK_VERTEX
+  std::vector<std::int64_t> connectivity(n), offsets(n);
+  std::iota(connectivity.begin(), connectivity.end(), 0);
+  std::iota(offsets.begin(), offsets.end(), 1);
+  const std::vector<std::uint8_t> types(n, 1);
+
+  arrays_.clear();
+  add_array("Points", "Points", 3, positions);
+  add_array("Cells", "connectivity", 1, connectivity);
+  add_array("Cells", "offsets", 1, offsets);
+  add_array("Cells", "types", 1, types);
+  add_array("PointData", "pdg_codes", 1, pdg_codes);
+  add_array("PointData", "is_formed", 1, is_formed);
+  add_array("PointData", "cross_section_scaling_factor", 1, xsec_factors);
+  add_array("PointData", "mass", 1, masses);
+  add_array("PointData", "N_coll", 1, n_coll);
+  add_array("PointData", "particle_ID", 1, ids);
+  add_array("PointData", "baryon_number", 1, baryon_numbers);
+  add_array("PointData", "strangeness", 1, strangeness);
+  add_array("PointData", "momentum", 3, momenta);
+  write_appended(file, "UnstructuredGrid", "",
+                 "NumberOfPoints=\"" + std::to_string(n) +
+                     "\" NumberOfCells=\"" + std::to_string(n) + "\"");
+}
+
+/**
+ * \tparam V Type of the values of an array.
+ * \return The name of the type in XML VTK files.
+ */
+template <typename V>
+static const char *vtk_type_name() {
+  if constexpr (std::is_same_v<V, double>) {
+    return "Float64";
+  } else if constexpr (std::is_same_v<V, std::int32_t>) {
+    return "Int32";
+  } else if constexpr (std::is_same_v<V, std::int64_t>) {
+    return "Int64";
+  } else {
+    static_assert(std::is_same_v<V, std::uint8_t>);
+    return "UInt8";
+  }
+}
+
+template <typename V>
+void VtkOutput::add_array(const std::string &section, const std::string &name,
+                          int components, const std::vector<V> &values) {
+  const char *begin = reinterpret_cast<const char *>(values.data());
+  arrays_.push_back({section, name, vtk_type_name<V>(), components,
+                     std::vector<char>(begin, begin + values.size() *
+                                                          sizeof(V))});
+}
+
+std::vector<char> VtkOutput::encode(const AppendedArray &array) const {
+  std::vector<char> encoded;
+  auto append_header = [&encoded](std::uint64_t value) {
+    const char *begin = reinterpret_cast<const char *>(&value);
+    encoded.insert(encoded.end(), begin, begin + sizeof(value));
+  };
+  const std::size_t size = array.bytes.size();
+  if (compression_level_ == 0) {
+    append_header(size);
+    encoded.insert(encoded.end(), array.bytes.begin(), array.bytes.end());
+    return encoded;
+  }
+#ifdef SMASH_USE_ZLIB
+  /* The data is compressed in blocks, which are preceded by the number of
+   * blocks, the uncompressed size of a block and of the last block (0 if it
+   * is complete) and the compressed sizes of all blocks. */
+  constexpr std::size_t block_size = 1 << 20;
+  const std::size_t n_blocks = (size + block_size - 1) / block_size;
+  std::vector<std::uint64_t> header{n_blocks, block_size, size % block_size};
+  std::vector<char> blocks;
+  for (std::size_t b = 0; b < n_blocks; b++) {
+    const uLong source_size = std::min(block_size, size - b * block_size);
+    uLongf compressed_size = compressBound(source_size);
+    const std::size_t start = blocks.size();
+    blocks.resize(start + compressed_size);
+    if (compress2(reinterpret_cast<Bytef *>(blocks.data() + start),
+                  &compressed_size,
+                  reinterpret_cast<const Bytef *>(array.bytes.data() +
+                                                  b * block_size),
+                  source_size, compression_level_) != Z_OK) {
+      throw std::runtime_error("Compression of the VTK_Binary output failed.");
+    }
+    blocks.resize(start + compressed_size);
+    header.push_back(compressed_size);
+  }
+  for (const std::uint64_t value : header) {
+    append_header(value);
+  }
+  encoded.insert(encoded.end(), blocks.begin(), blocks.end());
+#endif
+  return encoded;
+}
+
+void VtkOutput::write_appended(std::ofstream &file, const std::string &type,
+                               const std::string &dataset_attributes,
+                               const std::string &piece_attributes) {
+  std::vector<std::vector<char>> encoded;
+  encoded.reserve(arrays_.size());
+  for (const AppendedArray &array : arrays_) {
+    encoded.push_back(encode(array));
+  }
+#ifdef LITTLE_ENDIAN_ARCHITECTURE
+  const char *byte_order = "LittleEndian";
+#else
+  const char *byte_order = "BigEndian";
+#endif
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"" << type << "\" version=\"1.0\" byte_order=\""
+       << byte_order << "\" header_type=\"UInt64\"";
+  if (compression_level_ > 0) {
+    file << " compressor=\"vtkZLibDataCompressor\"";
+  }
+  file << ">\n"
+       << "<!-- Generated by SMASH " << SMASH_VERSION << " -->\n"
+       << "<" << type << dataset_attributes << ">\n"
+       << "<Piece " << piece_attributes << ">\n";
+  std::size_t offset = 0;
+  for (std::size_t i = 0; i < arrays_.size(); i++) {
+    const AppendedArray &array = arrays_[i];
+    if (i == 0 || array.section != arrays_[i - 1].section) {
+      file << "<" << array.section << ">\n";
+    }
+    file << "<DataArray type=\"" << array.type << "\" Name=\"" << array.name
+         << "\" NumberOfComponents=\"" << array.components
+         << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+    offset += encoded[i].size();
+    if (i + 1 == arrays_.size() || array.section != arrays_[i + 1].section) {
+      file << "</" << array.section << ">\n";
+    }
+  }
+  file << "</Piece>\n"
+       << "</" << type << ">\n"
+       << "<AppendedData encoding=\"raw\">\n_";
+  for (const std::vector<char> &bytes : encoded) {
+    file.write(bytes.data(), bytes.size());
+  }
+  file << "\n</AppendedData>\n"
+       << "</VTKFile>\n";
+  arrays_.clear();
+}
+
 /*!\Userguide
  * \page doxypage_output_vtk_lattice
  * Density on the lattice can be printed out in the VTK format of structured
  * grid. At every output time step a new VTK file is created. The name format is
  * `<density_type>_<density_name>_<event_number>_tstep<timestep_counter>.vtk`.
  * Files can be opened directly with <a href="http://paraview.org">ParaView</a>.
+ *
+ * With the `VTK_Binary` format, XML VTK image data files with the suffix
+ * `.vti` are written instead, whose arrays are appended as raw binary data.
+ * For the Thermodynamics content, they are compressed with zlib, if a
+ * \ref key_output_thermo_compression_level_ "Compression_Level" is given.
  */
 
 template <typename T>
 void VtkOutput::write_vtk_header(std::ofstream &file,
                                  RectangularLattice<T> &lattice,
                                  const std::string &description) {
+  if (binary_) {
+    arrays_.clear();
+    return;
+  }
   const auto dim = lattice.n_cells();
   const auto cs = lattice.cell_sizes();
   const auto orig = lattice.origin();
@@ -205,11 +422,20 @@ template <typename T, typename F>
 void VtkOutput::write_vtk_scalar(std::ofstream &file,
                                  RectangularLattice<T> &lattice,
                                  const std::string &varname, F &&get_quantity) {
+  const auto dim = lattice.n_cells();
+  if (binary_) {
+    std::vector<double> values;
+    values.reserve(lattice.size());
+    lattice.iterate_sublattice({0, 0, 0}, dim, [&](T &node, int, int, int) {
+      values.push_back(get_quantity(node));
+    });
+    add_array("PointData", varname, 1, values);
+    return;
+  }
   file << "SCALARS " << varname << " double 1\n"
        << "LOOKUP_TABLE default\n";
   file << std::setprecision(3);
   file << std::fixed;
-  const auto dim = lattice.n_cells();
   lattice.iterate_sublattice({0, 0, 0}, dim, [&](T &node, int ix, int, int) {
     const double f_from_node = get_quantity(node);
     file << f_from_node << " ";
@@ -223,20 +449,48 @@ template <typename T, typename F>
 void VtkOutput::write_vtk_vector(std::ofstream &file,
                                  RectangularLattice<T> &lattice,
                                  const std::string &varname, F &&get_quantity) {
+  const auto dim = lattice.n_cells();
+  if (binary_) {
+    std::vector<double> values;
+    values.reserve(3 * lattice.size());
+    lattice.iterate_sublattice({0, 0, 0}, dim, [&](T &node, int, int, int) {
+      const ThreeVector v = get_quantity(node);
+      values.insert(values.end(), {v.x1(), v.x2(), v.x3()});
+    });
+    add_array("PointData", varname, 3, values);
+    return;
+  }
   file << "VECTORS " << varname << " double\n";
   file << std::setprecision(3);
   file << std::fixed;
-  const auto dim = lattice.n_cells();
   lattice.iterate_sublattice({0, 0, 0}, dim, [&](T &node, int, int, int) {
     const ThreeVector v = get_quantity(node);
     file << v.x1() << " " << v.x2() << " " << v.x3() << "\n";
   });
 }
 
+template <typename T>
+void VtkOutput::finish_vtk_file(std::ofstream &file,
+                                RectangularLattice<T> &lattice) {
+  if (!binary_) {
+    return;
+  }
+  const auto dim = lattice.n_cells();
+  const auto cs = lattice.cell_sizes();
+  const auto orig = lattice.origin();
+  std::ostringstream extent, attributes;
+  extent << "Extent=\"0 " << dim[0] - 1 << " 0 " << dim[1] - 1 << " 0 "
+         << dim[2] - 1 << "\"";
+  attributes << " Whole" << extent.str() << " Origin=\"" << orig[0] << " "
+             << orig[1] << " " << orig[2] << "\" Spacing=\"" << cs[0] << " "
+             << cs[1] << " " << cs[2] << "\"";
+  write_appended(file, "ImageData", attributes.str(), extent.str());
+}
+
 std::string VtkOutput::make_filename(const std::string &descr, int counter) {
   char suffix[22];
-  snprintf(suffix, sizeof(suffix), "_%05i_tstep%05i.vtk", current_event_,
-           counter);
+  snprintf(suffix, sizeof(suffix), "_%05i_tstep%05i.%s", current_event_,
+           counter, binary_ ? "vti" : "vtk");
   return base_path_.string() + std::string("/") + descr + std::string(suffix);
 }
 
@@ -254,10 +508,11 @@ void VtkOutput::thermodynamics_output(
   }
   std::ofstream file;
   const std::string varname = make_varname(tq, dens_type);
-  file.open(make_filename(varname, vtk_density_output_counter_), std::ios::out);
+  file.open(make_filename(varname, vtk_density_output_counter_), open_mode_);
   write_vtk_header(file, lattice, varname);
   write_vtk_scalar(file, lattice, varname,
                    [&](DensityOnLattice &node) { return node.rho(); });
+  finish_vtk_file(file, lattice);
   vtk_density_output_counter_++;
 }
 
@@ -285,7 +540,7 @@ void VtkOutput::thermodynamics_output(
   const std::string varname = make_varname(tq, dens_type);
 
   if (tq == ThermodynamicQuantity::Tmn) {
-    file.open(make_filename(varname, vtk_tmn_output_counter_++), std::ios::out);
+    file.open(make_filename(varname, vtk_tmn_output_counter_++), open_mode_);
     write_vtk_header(file, Tmn_lattice, varname);
     for (int i = 0; i < 4; i++) {
       for (int j = i; j < 4; j++) {
@@ -298,29 +553,41 @@ void VtkOutput::thermodynamics_output(
     }
   } else if (tq == ThermodynamicQuantity::TmnLandau) {
     file.open(make_filename(varname, vtk_tmn_landau_output_counter_++),
-              std::ios::out);
+              open_mode_);
     write_vtk_header(file, Tmn_lattice, varname);
+    // The Landau frames of all nodes are found at once
+    const std::vector<FourVector> u =
+        EnergyMomentumTensor::landau_frame_4velocities(&Tmn_lattice[0],
+                                                       Tmn_lattice.size());
+    std::vector<EnergyMomentumTensor> Tmn_L;
+    Tmn_L.reserve(Tmn_lattice.size());
+    for (std::size_t node = 0; node < Tmn_lattice.size(); node++) {
+      Tmn_L.push_back(Tmn_lattice.begin()[node].boosted(u[node]));
+    }
     for (int i = 0; i < 4; i++) {
       for (int j = i; j < 4; j++) {
         write_vtk_scalar(file, Tmn_lattice,
                          varname + std::to_string(i) + std::to_string(j),
                          [&](EnergyMomentumTensor &node) {
-                           const FourVector u = node.landau_frame_4velocity();
-                           const EnergyMomentumTensor Tmn_L = node.boosted(u);
-                           return Tmn_L[EnergyMomentumTensor::tmn_index(i, j)];
+                           const EnergyMomentumTensor &node_L =
+                               Tmn_L[&node - &*Tmn_lattice.begin()];
+                           return node_L[EnergyMomentumTensor::tmn_index(i, j)];
                          });
       }
     }
   } else {
     file.open(make_filename(varname, vtk_v_landau_output_counter_++),
-              std::ios::out);
+              open_mode_);
     write_vtk_header(file, Tmn_lattice, varname);
+    const std::vector<FourVector> u =
+        EnergyMomentumTensor::landau_frame_4velocities(&Tmn_lattice[0],
+                                                       Tmn_lattice.size());
     write_vtk_vector(file, Tmn_lattice, varname,
                      [&](EnergyMomentumTensor &node) {
-                       const FourVector u = node.landau_frame_4velocity();
-                       return -u.velocity();
+                       return -u[&node - &*Tmn_lattice.begin()].velocity();
                      });
   }
+  finish_vtk_file(file, Tmn_lattice);
 }
 
 void VtkOutput::fields_output(
@@ -330,17 +597,19 @@ void VtkOutput::fields_output(
     return;
   }
   std::ofstream file1;
-  file1.open(make_filename(name1, vtk_fields_output_counter_), std::ios::out);
+  file1.open(make_filename(name1, vtk_fields_output_counter_), open_mode_);
   write_vtk_header(file1, lat, name1);
   write_vtk_vector(
       file1, lat, name1,
       [&](std::pair<ThreeVector, ThreeVector> &node) { return node.first; });
+  finish_vtk_file(file1, lat);
   std::ofstream file2;
-  file2.open(make_filename(name2, vtk_fields_output_counter_), std::ios::out);
+  file2.open(make_filename(name2, vtk_fields_output_counter_), open_mode_);
   write_vtk_header(file2, lat, name2);
   write_vtk_vector(
       file2, lat, name2,
       [&](std::pair<ThreeVector, ThreeVector> &node) { return node.second; });
+  finish_vtk_file(file2, lat);
   vtk_fields_output_counter_++;
 }
 
@@ -350,7 +619,7 @@ void VtkOutput::thermodynamics_output(const GrandCanThermalizer &gct) {
   }
   std::ofstream file;
   file.open(make_filename("fluidization_td", vtk_fluidization_counter_++),
-            std::ios::out);
+            open_mode_);
   write_vtk_header(file, gct.lattice(), "fluidization_td");
   write_vtk_scalar(file, gct.lattice(), "e",
                    [&](ThermLatticeNode &node) { return node.e(); });
@@ -364,6 +633,7 @@ void VtkOutput::thermodynamics_output(const GrandCanThermalizer &gct) {
                    [&](ThermLatticeNode &node) { return node.mub(); });
   write_vtk_scalar(file, gct.lattice(), "mus",
                    [&](ThermLatticeNode &node) { return node.mus(); });
+  finish_vtk_file(file, gct.lattice());
 }
 
 }  // namespace smash
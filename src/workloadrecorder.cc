@@ -0,0 +1,248 @@
+/*
+ *
+ *    Copyright (c) 2026
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/workloadrecorder.h"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "smash/particletype.h"
+
+namespace smash {
+
+/*!\Userguide
+ * \page doxypage_output_workload
+ *
+ * The workload (workload.bin) holds the inputs of the hot kernels of the run,
+ * if \ref key_gen_workload_sampling_ "Workload_Sampling" is positive: the
+ * pairs of particles checked for a collision, the particles smeared onto the
+ * density lattices and the pairs of particles exciting strings. Every n-th
+ * input of each kind is recorded with the types and the kinematics of the
+ * particles, as well as the geometry of the lattice and the smearing
+ * parameters for the lattice updates.
+ *
+ * The \c smash_replay executable, which is built with the microbenchmarks,
+ * runs the collision check, the cross sections, the smearing and the string
+ * fragmentation on the recorded inputs, such that optimizations of these
+ * kernels can be measured with the species and energies of production events
+ * without running the full simulation:
+ * \verbatim
+   smash_replay data/0/workload.bin --benchmark_filter=replay_cross_sections
+ \endverbatim
+ * Only the inputs of the kernels are recorded, not the configuration. The
+ * collision check and the cross sections are replayed with the default
+ * configuration of the collision term.
+ *
+ * The file is written in the native byte order and is meant to be replayed on
+ * the machine it was recorded on, with the particles and decay modes of the
+ * run.
+ */
+
+std::atomic<WorkloadRecorder *> WorkloadRecorder::active_{nullptr};
+
+ParticleData WorkloadRecorder::Particle::to_particle_data(int id) const {
+  ParticleData data{ParticleType::find(pdgcode)};
+  data.set_4position(position);
+  data.set_4momentum(momentum);
+  data.set_id(id);
+  return data;
+}
+
+WorkloadRecorder::WorkloadRecorder(const std::filesystem::path &path,
+                                   int interval)
+    : interval_(interval), file_(path, std::ios::binary) {
+  if (interval <= 0) {
+    throw std::invalid_argument(
+        "The workload has to be sampled with a positive interval.");
+  }
+  if (!file_) {
+    throw std::runtime_error("Could not write the workload to " +
+                             path.string() + ".");
+  }
+  file_.write("SMWL", 4);
+  write(format_version);
+}
+
+WorkloadRecorder::~WorkloadRecorder() {
+  WorkloadRecorder *recorder = this;
+  active_.compare_exchange_strong(recorder, nullptr);
+}
+
+void WorkloadRecorder::record_pair(const ParticleData &data_a,
+                                   const ParticleData &data_b, double dt,
+                                   double gcell_vol) {
+  if (!sample(Pairs)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  write('c');
+  write(Particle::of(data_a));
+  write(Particle::of(data_b));
+  write(dt);
+  write(gcell_vol);
+  n_recorded_[Pairs]++;
+}
+
+void WorkloadRecorder::record_string(const ParticleList &incoming,
+                                     ProcessType process) {
+  if (incoming.size() != 2 || !sample(Strings)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  write('s');
+  write(Particle::of(incoming[0]));
+  write(Particle::of(incoming[1]));
+  write(static_cast<std::int32_t>(process));
+  n_recorded_[Strings]++;
+}
+
+void WorkloadRecorder::record(const Smearing &smearing) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  write('l');
+  write(smearing.lattice_sizes);
+  for (int n : smearing.n_cells) {
+    write(static_cast<std::int32_t>(n));
+  }
+  write(smearing.origin);
+  write(static_cast<char>(smearing.periodic));
+  write(static_cast<std::int32_t>(smearing.density_type));
+  write(static_cast<char>(smearing.compute_gradient));
+  write(smearing.gaussian_sigma);
+  write(smearing.gauss_cutoff_in_sigma);
+  write(static_cast<std::int32_t>(smearing.testparticles));
+  write(static_cast<std::int32_t>(smearing.derivatives_mode));
+  write(static_cast<std::int32_t>(smearing.rho_derivatives_mode));
+  write(static_cast<std::int32_t>(smearing.smearing_mode));
+  write(smearing.discrete_weight);
+  write(smearing.triangular_range);
+  write(static_cast<char>(smearing.only_participants));
+  write(static_cast<std::uint32_t>(smearing.ensembles.size()));
+  for (const std::vector<Particle> &ensemble : smearing.ensembles) {
+    write(static_cast<std::uint32_t>(ensemble.size()));
+    for (const Particle &particle : ensemble) {
+      write(particle);
+    }
+  }
+  n_recorded_[Smearings]++;
+}
+
+std::array<uint64_t, WorkloadRecorder::NKinds> WorkloadRecorder::n_recorded()
+    const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return n_recorded_;
+}
+
+void WorkloadRecorder::flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  file_.flush();
+}
+
+void WorkloadRecorder::write(const Particle &particle) {
+  write(static_cast<std::int32_t>(particle.pdgcode.get_decimal()));
+  write(particle.position);
+  write(particle.momentum);
+}
+
+WorkloadRecorder::Workload WorkloadRecorder::read(
+    const std::filesystem::path &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Could not read the workload " + path.string() +
+                             ".");
+  }
+  auto read = [&file, &path](auto &value) {
+    if (!file.read(reinterpret_cast<char *>(&value), sizeof(value))) {
+      throw std::runtime_error("The workload " + path.string() +
+                               " ends within a record.");
+    }
+  };
+  auto read_int = [&read]() {
+    std::int32_t value;
+    read(value);
+    return value;
+  };
+  auto read_bool = [&read]() {
+    char value;
+    read(value);
+    return value != 0;
+  };
+  auto read_particle = [&read, &read_int]() {
+    Particle particle;
+    particle.pdgcode = PdgCode::from_decimal(read_int());
+    read(particle.position);
+    read(particle.momentum);
+    return particle;
+  };
+
+  char magic_number[4];
+  read(magic_number);
+  std::uint16_t version;
+  read(version);
+  if (std::string_view(magic_number, sizeof(magic_number)) != "SMWL" ||
+      version != format_version) {
+    throw std::runtime_error(path.string() + " is not a workload of version " +
+                             std::to_string(format_version) + ".");
+  }
+  Workload workload;
+  char kind;
+  while (file.read(&kind, 1)) {
+    if (kind == 'c') {
+      Pair pair;
+      pair.particles = {read_particle(), read_particle()};
+      read(pair.dt);
+      read(pair.gcell_vol);
+      workload.pairs.push_back(pair);
+    } else if (kind == 's') {
+      StringExcitation string;
+      string.particles = {read_particle(), read_particle()};
+      string.process = static_cast<ProcessType>(read_int());
+      workload.strings.push_back(string);
+    } else if (kind == 'l') {
+      Smearing smearing;
+      read(smearing.lattice_sizes);
+      for (int &n : smearing.n_cells) {
+        n = read_int();
+      }
+      read(smearing.origin);
+      smearing.periodic = read_bool();
+      smearing.density_type = static_cast<DensityType>(read_int());
+      smearing.compute_gradient = read_bool();
+      read(smearing.gaussian_sigma);
+      read(smearing.gauss_cutoff_in_sigma);
+      smearing.testparticles = read_int();
+      smearing.derivatives_mode = static_cast<DerivativesMode>(read_int());
+      smearing.rho_derivatives_mode =
+          static_cast<RestFrameDensityDerivativesMode>(read_int());
+      smearing.smearing_mode = static_cast<SmearingMode>(read_int());
+      read(smearing.discrete_weight);
+      read(smearing.triangular_range);
+      smearing.only_participants = read_bool();
+      std::uint32_t n_ensembles;
+      read(n_ensembles);
+      smearing.ensembles.resize(n_ensembles);
+      for (std::vector<Particle> &ensemble : smearing.ensembles) {
+        std::uint32_t n_particles;
+        read(n_particles);
+        ensemble.reserve(n_particles);
+        for (std::uint32_t i = 0; i < n_particles; i++) {
+          ensemble.push_back(read_particle());
+        }
+      }
+      workload.smearings.push_back(std::move(smearing));
+    } else {
+      throw std::runtime_error(std::string("Unexpected record '") + kind +
+                               "' in the workload " + path.string() + ".");
+    }
+  }
+  return workload;
+}
+
+}  // namespace smash